@@ -12,6 +12,7 @@
 set(MILVUS_THIRDPARTY_DEPENDENCIES
 
         GTest
+        GBenchmark
         MySQLPP
         Prometheus
         SQLite
@@ -38,6 +39,8 @@ endforeach ()
 macro(build_dependency DEPENDENCY_NAME)
     if ("${DEPENDENCY_NAME}" STREQUAL "GTest")
         build_gtest()
+    elseif ("${DEPENDENCY_NAME}" STREQUAL "GBenchmark")
+        build_gbenchmark()
     elseif ("${DEPENDENCY_NAME}" STREQUAL "MySQLPP")
         build_mysqlpp()
     elseif ("${DEPENDENCY_NAME}" STREQUAL "Prometheus")
@@ -242,6 +245,12 @@ else ()
 endif ()
 set(GTEST_MD5 "2e6fbeb6a91310a16efe181886c59596")
 
+if (DEFINED ENV{MILVUS_GBENCHMARK_URL})
+    set(GBENCHMARK_SOURCE_URL "$ENV{MILVUS_GBENCHMARK_URL}")
+else ()
+    set(GBENCHMARK_SOURCE_URL "https://github.com/google/benchmark/archive/${GBENCHMARK_VERSION}.tar.gz")
+endif ()
+
 if (DEFINED ENV{MILVUS_MYSQLPP_URL})
     set(MYSQLPP_SOURCE_URL "$ENV{MILVUS_MYSQLPP_URL}")
 else ()
@@ -425,6 +434,56 @@ if (MILVUS_BUILD_TESTS)
     include_directories(SYSTEM ${GTEST_INCLUDE_DIR})
 endif ()
 
+# ----------------------------------------------------------------------
+# Google benchmark
+
+macro(build_gbenchmark)
+    message(STATUS "Building google benchmark-${GBENCHMARK_VERSION} from source")
+    set(GBENCHMARK_PREFIX "${CMAKE_CURRENT_BINARY_DIR}/gbenchmark_ep-prefix/src/gbenchmark_ep")
+    set(GBENCHMARK_INCLUDE_DIR "${GBENCHMARK_PREFIX}/include")
+    set(GBENCHMARK_STATIC_LIB
+            "${GBENCHMARK_PREFIX}/lib/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark${CMAKE_STATIC_LIBRARY_SUFFIX}")
+
+    set(GBENCHMARK_CMAKE_ARGS
+            ${EP_COMMON_CMAKE_ARGS}
+            "-DCMAKE_INSTALL_PREFIX=${GBENCHMARK_PREFIX}"
+            "-DCMAKE_INSTALL_LIBDIR=lib"
+            -DCMAKE_CXX_FLAGS=${EP_CXX_FLAGS}
+            -DCMAKE_BUILD_TYPE=Release
+            -DBENCHMARK_ENABLE_TESTING=OFF
+            -DBENCHMARK_ENABLE_GTEST_TESTS=OFF)
+
+    ExternalProject_Add(gbenchmark_ep
+            URL
+            ${GBENCHMARK_SOURCE_URL}
+            BUILD_COMMAND
+            ${MAKE}
+            ${MAKE_BUILD_ARGS}
+            BUILD_BYPRODUCTS
+            ${GBENCHMARK_STATIC_LIB}
+            CMAKE_ARGS
+            ${GBENCHMARK_CMAKE_ARGS}
+            ${EP_LOG_OPTIONS})
+
+    # The include directory must exist before it is referenced by a target.
+    file(MAKE_DIRECTORY "${GBENCHMARK_INCLUDE_DIR}")
+
+    add_library(benchmark STATIC IMPORTED)
+    set_target_properties(benchmark
+            PROPERTIES IMPORTED_LOCATION "${GBENCHMARK_STATIC_LIB}"
+            INTERFACE_INCLUDE_DIRECTORIES "${GBENCHMARK_INCLUDE_DIR}")
+
+    add_dependencies(benchmark gbenchmark_ep)
+
+endmacro()
+
+if (MILVUS_BUILD_BENCHMARKS)
+    resolve_dependency(GBenchmark)
+
+    get_target_property(GBENCHMARK_INCLUDE_DIR benchmark INTERFACE_INCLUDE_DIRECTORIES)
+    include_directories(SYSTEM ${GBENCHMARK_INCLUDE_DIR})
+endif ()
+
 # ----------------------------------------------------------------------
 # MySQL++
 
@@ -11,20 +11,49 @@
 
 #pragma once
 
+#include "FrequencySketch.h"
 #include "LRU.h"
 #include "utils/Log.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace cache {
 
+constexpr uint64_t CACHE_SHARD_NUM = 16;
+
+enum class CachePolicy {
+    // evict the least recently used items
+    LRU,
+    // evict as LRU, but a new item is only kept when it is accessed more often than the item it would evict
+    TINY_LFU,
+};
+
+// limits of a group of items, e.g. the index files of a table
+struct CacheQuota {
+    // bytes of the group never evicted, no matter how full the cache is
+    int64_t reserved = 0;
+    // bytes the group can take at most, 0 means no limit
+    int64_t max = 0;
+    // items of the group are never evicted, they are only erased explicitly
+    bool pinned = false;
+};
+
 template <typename ItemObj>
 class Cache {
  public:
+    // called with key, group and size of an item evicted to make room, not of an item erased explicitly
+    using EvictCallback = std::function<void(const std::string&, const std::string&, int64_t)>;
+
     // mem_capacity, units:GB
     Cache(int64_t capacity_gb, uint64_t cache_max_count);
     ~Cache() = default;
@@ -54,6 +83,26 @@ class Cache {
         freemem_percent_ = percent;
     }
 
+    // time to load an item again after it is evicted: latency(ms) + size / bandwidth(bytes per ms)
+    void
+    set_reload_cost(double latency, double bandwidth) {
+        reload_latency_ = latency;
+        reload_bandwidth_ = bandwidth;
+    }
+
+    void
+    set_evict_callback(const EvictCallback& callback) {
+        evict_callback_ = callback;
+    }
+
+    CachePolicy
+    policy() const {
+        return policy_;
+    }
+
+    void
+    set_policy(CachePolicy policy);
+
     size_t
     size() const;
 
@@ -63,12 +112,30 @@ class Cache {
     ItemObj
     get(const std::string& key);
 
+    // group: the item is limited by quota of the group, if any
     void
-    insert(const std::string& key, const ItemObj& item);
+    insert(const std::string& key, const ItemObj& item, const std::string& group = "");
 
     void
     erase(const std::string& key);
 
+    // evict items not protected by quotas until size bytes are freed, return bytes freed
+    int64_t
+    release(int64_t size);
+
+    // keys with their hit counts, most hit first
+    std::vector<std::pair<std::string, uint64_t>>
+    hot_keys() const;
+
+    void
+    set_quota(const std::string& group, const CacheQuota& quota);
+
+    void
+    remove_quota(const std::string& group);
+
+    int64_t
+    group_usage(const std::string& group) const;
+
     void
     print();
 
@@ -76,16 +143,83 @@ class Cache {
     clear();
 
  private:
+    struct Entry {
+        ItemObj item;
+        // last access, by a logical clock of the cache
+        mutable uint64_t tick;
+        mutable uint64_t hits;
+        std::string group;
+    };
+
+    /*
+     * Keys are spread among shards by hash, each shard has its own lru and lock,
+     * capacity and usage are counted for the whole cache;
+     */
+    struct Shard {
+        explicit Shard(uint64_t max_count) : lru(max_count), max_count(max_count) {
+        }
+
+        LRU<std::string, Entry> lru;
+        uint64_t max_count;
+        std::mutex mutex;
+    };
+
+    Shard&
+    shard(const std::string& key) {
+        return *shards_[std::hash<std::string>()(key) % shards_.size()];
+    }
+
+    // keep_key is just inserted and never freed
+    void
+    free_memory(const std::string& keep_key);
+
+    // pick the item to evict among shard tails except keep_key, return false if nothing found
+    bool
+    pick_victim(const std::string& keep_key, std::string& key);
+
+    // pick the least recently used item of group except keep_key, return false if nothing found
+    bool
+    pick_group_victim(const std::string& group, const std::string& keep_key, std::string& key);
+
+    // free items of group until its usage is within quota max
     void
-    free_memory();
+    free_group_memory(const std::string& group, const std::string& keep_key);
+
+    // return size of erased item, 0 if key not exists, evicted: report it to evict callback
+    int64_t
+    erase_item(const std::string& key, bool evicted = false);
+
+    void
+    on_evict(const std::string& key, const std::string& group, int64_t size);
+
+    // pinned items and items within reserved size of their group
+    bool
+    is_protected(const Entry& entry) const;
+
+    bool
+    is_protected(const std::string& key);
+
+    void
+    add_group_usage(const std::string& group, int64_t delta);
 
  private:
-    int64_t usage_;
-    int64_t capacity_;
+    std::atomic<int64_t> usage_;
+    std::atomic<int64_t> capacity_;
     double freemem_percent_;
-
-    LRU<std::string, ItemObj> lru_;
-    mutable std::mutex mutex_;
+    double reload_latency_ = 0.0;
+    double reload_bandwidth_ = 1.0;
+    std::atomic<CachePolicy> policy_;
+    FrequencySketch sketch_;
+    EvictCallback evict_callback_;
+
+    std::atomic<uint64_t> tick_{0};
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::mutex free_mutex_;
+
+    // locked after shard mutex, never before
+    mutable std::mutex quota_mutex_;
+    std::unordered_map<std::string, CacheQuota> quotas_;
+    std::unordered_map<std::string, int64_t> group_usage_;
 };
 
 }  // namespace cache
@@ -16,8 +16,12 @@ constexpr double DEFAULT_THRESHHOLD_PERCENT = 0.85;
 
 template <typename ItemObj>
 Cache<ItemObj>::Cache(int64_t capacity, uint64_t cache_max_count)
-    : usage_(0), capacity_(capacity), freemem_percent_(DEFAULT_THRESHHOLD_PERCENT), lru_(cache_max_count) {
+    : usage_(0), capacity_(capacity), freemem_percent_(DEFAULT_THRESHHOLD_PERCENT), policy_(CachePolicy::LRU) {
     //    AGENT_LOG_DEBUG << "Construct Cache with capacity " << std::to_string(mem_capacity)
+    uint64_t shard_max_count = std::max<uint64_t>((cache_max_count + CACHE_SHARD_NUM - 1) / CACHE_SHARD_NUM, 1);
+    for (uint64_t i = 0; i < CACHE_SHARD_NUM; ++i) {
+        shards_.emplace_back(std::make_unique<Shard>(shard_max_count));
+    }
 }
 
 template <typename ItemObj>
@@ -25,158 +29,447 @@ void
 Cache<ItemObj>::set_capacity(int64_t capacity) {
     if (capacity > 0) {
         capacity_ = capacity;
-        free_memory();
+        free_memory("");
+    }
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::set_policy(CachePolicy policy) {
+    if (policy != policy_) {
+        sketch_.Clear();
+        policy_ = policy;
     }
 }
 
 template <typename ItemObj>
 size_t
 Cache<ItemObj>::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.size();
+    size_t count = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        count += shard->lru.size();
+    }
+    return count;
 }
 
 template <typename ItemObj>
 bool
 Cache<ItemObj>::exists(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.exists(key);
+    Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.lru.exists(key);
 }
 
 template <typename ItemObj>
 ItemObj
 Cache<ItemObj>::get(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
+    if (policy_ == CachePolicy::TINY_LFU) {
+        // misses are counted too, an item loaded after a miss is admitted by how often it was asked for
+        sketch_.Increment(std::hash<std::string>()(key));
+    }
+
+    Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.lru.exists(key)) {
         return nullptr;
     }
 
-    return lru_.get(key);
+    const Entry& entry = s.lru.get(key);
+    entry.tick = ++tick_;
+    ++entry.hits;
+    return entry.item;
 }
 
 template <typename ItemObj>
 void
-Cache<ItemObj>::insert(const std::string& key, const ItemObj& item) {
+Cache<ItemObj>::insert(const std::string& key, const ItemObj& item, const std::string& group) {
     if (item == nullptr) {
         return;
     }
 
+    if (!group.empty()) {
+        std::lock_guard<std::mutex> lock(quota_mutex_);
+        auto iter = quotas_.find(group);
+        if (iter != quotas_.end() && iter->second.max > 0 && item->Size() > iter->second.max) {
+            SERVER_LOG_DEBUG << "Item " << key << " size: " << item->Size() << " bytes exceeds quota of group "
+                             << group << ": " << iter->second.max << " bytes";
+            return;
+        }
+    }
+
     //    if(item->size() > capacity_) {
     //        SERVER_LOG_ERROR << "Item size " << item->size()
     //                        << " is too large to insert into cache, capacity " << capacity_;
     //        return;
     //    }
 
-    // calculate usage
+    // insert new item and calculate usage
+    std::string evicted_key, evicted_group;
+    int64_t evicted_size = 0;
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        Shard& s = shard(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
 
         // if key already exist, subtract old item size
-        if (lru_.exists(key)) {
-            const ItemObj& old_item = lru_.get(key);
-            usage_ -= old_item->Size();
+        uint64_t hits = 0;
+        if (s.lru.exists(key)) {
+            const Entry& old_entry = s.lru.get(key);
+            usage_ -= old_entry.item->Size();
+            add_group_usage(old_entry.group, -old_entry.item->Size());
+            hits = old_entry.hits;
+        } else if (s.lru.size() >= s.max_count) {
+            // shard is full, lru would drop its tail silently, release it here to keep usage right
+            auto tail = s.lru.rbegin();
+            evicted_key = tail->first;
+            evicted_group = tail->second.group;
+            evicted_size = tail->second.item->Size();
+            usage_ -= evicted_size;
+            add_group_usage(evicted_group, -evicted_size);
+            s.lru.erase(evicted_key);
         }
 
         // plus new item size
         usage_ += item->Size();
+        add_group_usage(group, item->Size());
+        s.lru.put(key, Entry{item, ++tick_, hits, group});
+        SERVER_LOG_DEBUG << "Insert " << key << " size: " << item->Size() << " bytes into cache, usage: " << usage_
+                         << " bytes," << " capacity: " << capacity_ << " bytes";
+    }
+
+    if (!evicted_key.empty()) {
+        on_evict(evicted_key, evicted_group, evicted_size);
     }
 
+    // a group above its quota frees its own items first
+    free_group_memory(group, key);
+
     // if usage exceed capacity, free some items
     if (usage_ > capacity_) {
         SERVER_LOG_DEBUG << "Current usage " << usage_ << " exceeds cache capacity " << capacity_
                          << ", start free memory";
-        free_memory();
+        free_memory(key);
     }
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::erase(const std::string& key) {
+    erase_item(key);
+}
 
-    // insert new item
+template <typename ItemObj>
+int64_t
+Cache<ItemObj>::erase_item(const std::string& key, bool evicted) {
+    std::string group;
+    int64_t size = 0;
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        Shard& s = shard(key);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!s.lru.exists(key)) {
+            return 0;
+        }
 
-        lru_.put(key, item);
-        SERVER_LOG_DEBUG << "Insert " << key << " size: " << item->Size() << " bytes into cache, usage: " << usage_
+        const Entry& entry = s.lru.get(key);
+        group = entry.group;
+        size = entry.item->Size();
+        usage_ -= size;
+        add_group_usage(group, -size);
+
+        SERVER_LOG_DEBUG << "Erase " << key << " size: " << size << " bytes from cache, usage: " << usage_
                          << " bytes," << " capacity: " << capacity_ << " bytes";
+
+        s.lru.erase(key);
+    }
+
+    if (evicted) {
+        on_evict(key, group, size);
     }
+    return size;
 }
 
 template <typename ItemObj>
 void
-Cache<ItemObj>::erase(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
-        return;
+Cache<ItemObj>::on_evict(const std::string& key, const std::string& group, int64_t size) {
+    if (evict_callback_) {
+        evict_callback_(key, group, size);
     }
-
-    const ItemObj& old_item = lru_.get(key);
-    usage_ -= old_item->Size();
-
-    SERVER_LOG_DEBUG << "Erase " << key << " size: " << old_item->Size() << " bytes from cache, usage: " << usage_
-                     << " bytes," << " capacity: " << capacity_ << " bytes";
-
-    lru_.erase(key);
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    lru_.clear();
-    usage_ = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto it = shard->lru.begin(); it != shard->lru.end(); ++it) {
+            usage_ -= it->second.item->Size();
+        }
+        shard->lru.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(quota_mutex_);
+        group_usage_.clear();
+    }
     SERVER_LOG_DEBUG << "Clear cache !";
 }
 
+template <typename ItemObj>
+int64_t
+Cache<ItemObj>::release(int64_t size) {
+    std::lock_guard<std::mutex> free_lock(free_mutex_);
+    int64_t released_size = 0;
+    std::string victim;
+    while (released_size < size && pick_victim("", victim)) {
+        released_size += erase_item(victim, true);
+    }
+
+    SERVER_LOG_DEBUG << "released memory size: " << released_size << " of " << size << " asked";
+    return released_size;
+}
+
 /* free memory space when CACHE occupation exceed its capacity */
 template <typename ItemObj>
 void
-Cache<ItemObj>::free_memory() {
+Cache<ItemObj>::free_memory(const std::string& keep_key) {
+    // one thread frees memory at a time, lookups on shards go on meanwhile
+    std::lock_guard<std::mutex> free_lock(free_mutex_);
     if (usage_ <= capacity_)
         return;
 
+    // usage above capacity is freed at once, then only one more item is freed towards the threshold,
+    // so a full cache drains gradually instead of dropping many segments in one insert and reloading them
     int64_t threshhold = capacity_ * freemem_percent_;
-    int64_t delta_size = usage_ - threshhold;
-    if (delta_size <= 0) {
-        delta_size = 1;  // ensure at least one item erased
-    }
+    bool step_below_capacity = false;
+
+    // with tinylfu policy, the new item must be accessed more often than the items it evicts, unless its quota
+    // protects it
+    std::string candidate = keep_key;
+    bool admission = (policy_ == CachePolicy::TINY_LFU && !candidate.empty() && !is_protected(candidate));
 
-    std::set<std::string> key_array;
     int64_t released_size = 0;
+    while (usage_ > threshhold) {
+        if (usage_ <= capacity_) {
+            if (step_below_capacity) {
+                break;
+            }
+            step_below_capacity = true;
+        }
+
+        std::string victim;
+        if (!pick_victim(candidate, victim)) {
+            // all other items are protected by quotas, the new item is not kept unless it is protected too
+            if (usage_ > capacity_ && !candidate.empty() && !is_protected(candidate)) {
+                SERVER_LOG_DEBUG << "Reject " << candidate << ", other items are protected by quotas";
+                released_size += erase_item(candidate, true);
+            }
+            break;
+        }
+
+        if (admission && sketch_.Frequency(std::hash<std::string>()(candidate)) <=
+                             sketch_.Frequency(std::hash<std::string>()(victim))) {
+            SERVER_LOG_DEBUG << "Reject " << candidate << ", less frequently accessed than " << victim;
+            released_size += erase_item(candidate, true);
+            candidate.clear();
+            admission = false;
+            if (usage_ <= capacity_) {
+                break;
+            }
+            continue;
+        }
 
+        released_size += erase_item(victim, true);
+    }
+
+    SERVER_LOG_DEBUG << "released memory size: " << released_size;
+
+    print();
+}
+
+template <typename ItemObj>
+bool
+Cache<ItemObj>::pick_victim(const std::string& keep_key, std::string& key) {
+    /*
+     * Tails are the least recently used items of shards. Among them, evict the one with most
+     * idle time * size / reload cost: large items are cheaper to reload per byte because of the
+     * fixed latency, items of the same size are evicted in LRU order.
+     */
+    bool found = false;
+    double max_score = -1.0;
+    uint64_t now = tick_;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        // protected items are skipped, the least recently used one of the rest stands for the shard
+        auto tail = shard->lru.rbegin();
+        while (tail != shard->lru.rend() && (tail->first == keep_key || is_protected(tail->second))) {
+            ++tail;
+        }
+        if (tail == shard->lru.rend()) {
+            continue;
+        }
+
+        double size = tail->second.item->Size();
+        double idle = (now > tail->second.tick) ? (now - tail->second.tick) : 0;
+        double cost = reload_latency_ + size / reload_bandwidth_;
+        double score = (cost > 0) ? (idle + 1) * size / cost : (idle + 1);
+        if (score > max_score) {
+            max_score = score;
+            key = tail->first;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+template <typename ItemObj>
+bool
+Cache<ItemObj>::pick_group_victim(const std::string& group, const std::string& keep_key, std::string& key) {
+    // items of a pinned group are only erased explicitly, even above the max of the group
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(quota_mutex_);
+        auto iter = quotas_.find(group);
+        if (iter != quotas_.end() && iter->second.pinned) {
+            return false;
+        }
+    }
+
+    bool found = false;
+    uint64_t min_tick = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto it = shard->lru.begin(); it != shard->lru.end(); ++it) {
+            if (it->second.group != group || it->first == keep_key) {
+                continue;
+            }
+            if (!found || it->second.tick < min_tick) {
+                min_tick = it->second.tick;
+                key = it->first;
+                found = true;
+            }
+        }
+    }
 
-        auto it = lru_.rbegin();
-        while (it != lru_.rend() && released_size < delta_size) {
-            auto& key = it->first;
-            auto& obj_ptr = it->second;
+    return found;
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::free_group_memory(const std::string& group, const std::string& keep_key) {
+    if (group.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> free_lock(free_mutex_);
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(quota_mutex_);
+            auto iter = quotas_.find(group);
+            auto usage_iter = group_usage_.find(group);
+            if (iter == quotas_.end() || iter->second.max <= 0 || usage_iter == group_usage_.end() ||
+                usage_iter->second <= iter->second.max) {
+                return;
+            }
+        }
 
-            key_array.emplace(key);
-            released_size += obj_ptr->Size();
-            ++it;
+        std::string victim;
+        if (!pick_group_victim(group, keep_key, victim)) {
+            return;
         }
+        erase_item(victim, true);
     }
+}
 
-    SERVER_LOG_DEBUG << "to be released memory size: " << released_size;
+template <typename ItemObj>
+bool
+Cache<ItemObj>::is_protected(const Entry& entry) const {
+    if (entry.group.empty()) {
+        return false;
+    }
 
-    for (auto& key : key_array) {
-        erase(key);
+    std::lock_guard<std::mutex> lock(quota_mutex_);
+    auto iter = quotas_.find(entry.group);
+    if (iter == quotas_.end()) {
+        return false;
     }
 
-    print();
+    auto usage_iter = group_usage_.find(entry.group);
+    int64_t usage = (usage_iter == group_usage_.end()) ? 0 : usage_iter->second;
+    return iter->second.pinned || usage - entry.item->Size() < iter->second.reserved;
+}
+
+template <typename ItemObj>
+bool
+Cache<ItemObj>::is_protected(const std::string& key) {
+    Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.lru.exists(key) && is_protected(s.lru.get(key));
 }
 
 template <typename ItemObj>
 void
-Cache<ItemObj>::print() {
-    size_t cache_count = 0;
+Cache<ItemObj>::add_group_usage(const std::string& group, int64_t delta) {
+    if (group.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(quota_mutex_);
+    auto& usage = group_usage_[group];
+    usage += delta;
+    if (usage <= 0) {
+        group_usage_.erase(group);
+    }
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::set_quota(const std::string& group, const CacheQuota& quota) {
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_count = lru_.size();
-#if 0
-        for (auto it = lru_.begin(); it != lru_.end(); ++it) {
-            SERVER_LOG_DEBUG << it->first;
+        std::lock_guard<std::mutex> lock(quota_mutex_);
+        quotas_[group] = quota;
+    }
+
+    // a lowered max takes effect at once
+    free_group_memory(group, "");
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::remove_quota(const std::string& group) {
+    std::lock_guard<std::mutex> lock(quota_mutex_);
+    quotas_.erase(group);
+}
+
+template <typename ItemObj>
+int64_t
+Cache<ItemObj>::group_usage(const std::string& group) const {
+    std::lock_guard<std::mutex> lock(quota_mutex_);
+    auto iter = group_usage_.find(group);
+    return (iter == group_usage_.end()) ? 0 : iter->second;
+}
+
+template <typename ItemObj>
+std::vector<std::pair<std::string, uint64_t>>
+Cache<ItemObj>::hot_keys() const {
+    std::vector<std::pair<std::string, uint64_t>> keys;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto it = shard->lru.begin(); it != shard->lru.end(); ++it) {
+            keys.emplace_back(it->first, it->second.hits);
         }
-#endif
     }
 
+    std::stable_sort(keys.begin(), keys.end(),
+                     [](const std::pair<std::string, uint64_t>& a, const std::pair<std::string, uint64_t>& b) {
+                         return a.second > b.second;
+                     });
+    return keys;
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::print() {
+    size_t cache_count = size();
+
     SERVER_LOG_DEBUG << "[Cache item count]: " << cache_count;
     SERVER_LOG_DEBUG << "[Cache usage]: " << usage_ << " bytes";
     SERVER_LOG_DEBUG << "[Cache capacity]: " << capacity_ << " bytes";
@@ -15,8 +15,11 @@
 #include "metrics/Metrics.h"
 #include "utils/Log.h"
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace cache {
@@ -36,6 +39,10 @@ class CacheMgr {
     virtual void
     InsertItem(const std::string& key, const ItemObj& data);
 
+    // the item is limited by quota of the group, see SetQuota
+    void
+    InsertItem(const std::string& key, const ItemObj& data, const std::string& group);
+
     virtual void
     EraseItem(const std::string& key);
 
@@ -54,7 +61,48 @@ class CacheMgr {
     void
     SetCapacity(int64_t capacity);
 
+    // evict items to free size bytes for other users of the memory, return bytes freed
+    int64_t
+    ReleaseMemory(int64_t size);
+
+    // lookups since start, a hit finds the item in cache
+    uint64_t
+    HitCount() const {
+        return hit_count_;
+    }
+
+    uint64_t
+    MissCount() const {
+        return miss_count_;
+    }
+
+    // keys with their hit counts, most hit first
+    std::vector<std::pair<std::string, uint64_t>>
+    HotItems() const;
+
+    // policy: "lru" or "tinylfu"
+    void
+    SetPolicy(const std::string& policy);
+
+    void
+    SetQuota(const std::string& group, const CacheQuota& quota);
+
+    void
+    RemoveQuota(const std::string& group);
+
+    int64_t
+    GroupUsage(const std::string& group) const;
+
+    const std::string&
+    Name() const {
+        return name_;
+    }
+
  protected:
+    // name: label of the cache in metrics, e.g. "cpu", "gpu0", items evicted are reported with it
+    void
+    SetName(const std::string& name);
+
     CacheMgr();
 
     virtual ~CacheMgr();
@@ -62,6 +110,9 @@ class CacheMgr {
  protected:
     using CachePtr = std::shared_ptr<Cache<ItemObj>>;
     CachePtr cache_;
+    std::string name_;
+    std::atomic<uint64_t> hit_count_{0};
+    std::atomic<uint64_t> miss_count_{0};
 };
 
 }  // namespace cache
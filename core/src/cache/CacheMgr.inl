@@ -50,18 +50,26 @@ CacheMgr<ItemObj>::GetItem(const std::string& key) {
         return nullptr;
     }
     server::Metrics::GetInstance().CacheAccessTotalIncrement();
-    return cache_->get(key);
+    auto item = cache_->get(key);
+    ++(item != nullptr ? hit_count_ : miss_count_);
+    return item;
 }
 
 template <typename ItemObj>
 void
 CacheMgr<ItemObj>::InsertItem(const std::string& key, const ItemObj& data) {
+    InsertItem(key, data, "");
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::InsertItem(const std::string& key, const ItemObj& data, const std::string& group) {
     if (cache_ == nullptr) {
         SERVER_LOG_ERROR << "Cache doesn't exist";
         return;
     }
 
-    cache_->insert(key, data);
+    cache_->insert(key, data, group);
     server::Metrics::GetInstance().CacheAccessTotalIncrement();
 }
 
@@ -131,5 +139,79 @@ CacheMgr<ItemObj>::SetCapacity(int64_t capacity) {
     cache_->set_capacity(capacity);
 }
 
+template <typename ItemObj>
+int64_t
+CacheMgr<ItemObj>::ReleaseMemory(int64_t size) {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return 0;
+    }
+    return cache_->release(size);
+}
+
+template <typename ItemObj>
+std::vector<std::pair<std::string, uint64_t>>
+CacheMgr<ItemObj>::HotItems() const {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return {};
+    }
+
+    return cache_->hot_keys();
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::SetPolicy(const std::string& policy) {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return;
+    }
+    cache_->set_policy((policy == "tinylfu") ? CachePolicy::TINY_LFU : CachePolicy::LRU);
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::SetQuota(const std::string& group, const CacheQuota& quota) {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return;
+    }
+    cache_->set_quota(group, quota);
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::RemoveQuota(const std::string& group) {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return;
+    }
+    cache_->remove_quota(group);
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::SetName(const std::string& name) {
+    name_ = name;
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return;
+    }
+    cache_->set_evict_callback([name](const std::string& key, const std::string& group, int64_t size) {
+        server::Metrics::GetInstance().CacheEvictTotalIncrement(name, group, size);
+    });
+}
+
+template <typename ItemObj>
+int64_t
+CacheMgr<ItemObj>::GroupUsage(const std::string& group) const {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return 0;
+    }
+    return cache_->group_usage(group);
+}
+
 }  // namespace cache
 }  // namespace milvus
@@ -11,9 +11,11 @@
 
 #include "cache/CpuCacheMgr.h"
 #include "server/Config.h"
+#include "utils/LargeBuffer.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
+#include <string>
 #include <utility>
 
 namespace milvus {
@@ -21,7 +23,11 @@ namespace cache {
 
 namespace {
 constexpr int64_t unit = 1024 * 1024 * 1024;
-}
+
+// an evicted index is read from disk again
+constexpr double DISK_READ_LATENCY = 10.0;     // ms, open and deserialize an index file
+constexpr double DISK_READ_BANDWIDTH = 5.0e5;  // bytes per ms
+}  // namespace
 
 CpuCacheMgr::CpuCacheMgr() {
     // All config values have been checked in Config::ValidateConfig()
@@ -35,6 +41,22 @@ CpuCacheMgr::CpuCacheMgr() {
     float cpu_cache_threshold;
     config.GetCacheConfigCpuCacheThreshold(cpu_cache_threshold);
     cache_->set_freemem_percent(cpu_cache_threshold);
+    cache_->set_reload_cost(DISK_READ_LATENCY, DISK_READ_BANDWIDTH);
+
+    std::string cpu_cache_policy;
+    config.GetCacheConfigCpuCachePolicy(cpu_cache_policy);
+    SetPolicy(cpu_cache_policy);
+    SetName("cpu");
+
+    std::string cpu_cache_huge_page;
+    config.GetCacheConfigCpuCacheHugePage(cpu_cache_huge_page);
+    SetHugePage(cpu_cache_huge_page);
+
+    // memory of evicted indexes goes back to the os, so the resident size follows the cache usage
+    cache_->set_evict_callback([](const std::string& key, const std::string& group, int64_t size) {
+        server::Metrics::GetInstance().CacheEvictTotalIncrement("cpu", group, size);
+        ReleaseFreeMemory(size);
+    });
 }
 
 CpuCacheMgr*
@@ -49,5 +71,16 @@ CpuCacheMgr::GetIndex(const std::string& key) {
     return obj;
 }
 
+void
+CpuCacheMgr::SetHugePage(const std::string& huge_page) {
+    if (huge_page == "hugetlb") {
+        SetHugePageMode(HugePageMode::HUGETLB);
+    } else if (huge_page == "thp") {
+        SetHugePageMode(HugePageMode::THP);
+    } else {
+        SetHugePageMode(HugePageMode::OFF);
+    }
+}
+
 }  // namespace cache
 }  // namespace milvus
@@ -31,6 +31,10 @@ class CpuCacheMgr : public CacheMgr<DataObjPtr> {
 
     DataObjPtr
     GetIndex(const std::string& key);
+
+    // off, thp or hugetlb, pages backing the indexes cached from now on
+    void
+    SetHugePage(const std::string& huge_page);
 };
 
 }  // namespace cache
@@ -0,0 +1,146 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/DiskCacheMgr.h"
+#include "server/Config.h"
+#include "storage/s3/S3ClientWrapper.h"
+#include "utils/Log.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <functional>
+
+namespace milvus {
+namespace cache {
+
+namespace {
+constexpr int64_t unit = 1024 * 1024 * 1024;
+constexpr const char* COPY_SUFFIX = ".s3cache";
+
+bool
+IsCopyName(const std::string& name) {
+    std::string suffix(COPY_SUFFIX);
+    return name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+}  // namespace
+
+DiskCacheMgr::DiskCacheMgr() {
+    // All config values have been checked in Config::ValidateConfig()
+    server::Config& config = server::Config::GetInstance();
+
+    int64_t disk_cache_cap = 0;
+    config.GetStorageConfigS3CacheCapacity(disk_cache_cap);
+    config.GetStorageConfigS3CachePath(path_);
+    if (path_.empty()) {
+        disk_cache_cap = 0;
+    }
+
+    if (disk_cache_cap > 0) {
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(path_, ec);
+        if (ec) {
+            SERVER_LOG_ERROR << "Failed to create s3 cache path " << path_ << ": " << ec.message();
+            disk_cache_cap = 0;
+        } else {
+            // copies left by last run are not indexed, drop them
+            boost::filesystem::directory_iterator end_iter;
+            for (boost::filesystem::directory_iterator iter(path_, ec); !ec && iter != end_iter; iter.increment(ec)) {
+                auto name = iter->path().filename().string();
+                if (boost::filesystem::is_regular_file(iter->path()) && IsCopyName(name)) {
+                    boost::system::error_code remove_ec;
+                    boost::filesystem::remove(iter->path(), remove_ec);
+                }
+            }
+        }
+    }
+
+    cache_ = std::make_shared<Cache<DataObjPtr>>(disk_cache_cap * unit, 1UL << 32);
+}
+
+DiskCacheMgr*
+DiskCacheMgr::GetInstance() {
+    static DiskCacheMgr s_mgr;
+    return &s_mgr;
+}
+
+bool
+DiskCacheMgr::Enabled() const {
+    return CacheCapacity() > 0;
+}
+
+DiskFileObjPtr
+DiskCacheMgr::GetFile(const std::string& key) {
+    if (!Enabled()) {
+        return nullptr;
+    }
+
+    return std::static_pointer_cast<DiskFileObj>(GetItem(key));
+}
+
+void
+DiskCacheMgr::InsertFile(const std::string& key, const std::string& content) {
+    if (!Enabled() || (int64_t)content.size() > CacheCapacity()) {
+        return;
+    }
+
+    std::string file_path = NewCopyPath(key);
+    std::ofstream fs(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    fs.write(content.data(), content.size());
+    fs.close();
+
+    auto obj = std::make_shared<DiskFileObj>(file_path, content.size());
+    if (!fs.good()) {
+        SERVER_LOG_ERROR << "Failed to write s3 cache file " << file_path;
+        return;
+    }
+    InsertItem(key, obj);
+}
+
+void
+DiskCacheMgr::FetchFile(const std::string& key) {
+    if (!Enabled() || ItemExists(key)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(fetch_mutex_);
+        if (!fetching_.insert(key).second) {
+            return;
+        }
+    }
+
+    // the object is streamed to the file, it is never held in memory whole
+    std::string file_path = NewCopyPath(key);
+    storage::S3ClientWrapper::GetInstance().GetObjectFileAsync(
+        key, file_path, [this, key, file_path](const Status& status) {
+            boost::system::error_code ec;
+            auto size = static_cast<int64_t>(boost::filesystem::file_size(file_path, ec));
+            if (status.ok() && !ec && size <= CacheCapacity()) {
+                InsertItem(key, std::make_shared<DiskFileObj>(file_path, size));
+            } else {
+                SERVER_LOG_WARNING << "Failed to fetch s3 file " << key
+                                   << " to cache: " << (status.ok() ? "no room" : status.message());
+                std::remove(file_path.c_str());
+            }
+
+            std::lock_guard<std::mutex> lock(fetch_mutex_);
+            fetching_.erase(key);
+        });
+}
+
+std::string
+DiskCacheMgr::NewCopyPath(const std::string& key) {
+    // a new name for each copy, so removing a replaced copy never touches the current one
+    return path_ + "/" + std::to_string(std::hash<std::string>()(key)) + "_" + std::to_string(file_seq_++) +
+           COPY_SUFFIX;
+}
+
+}  // namespace cache
+}  // namespace milvus
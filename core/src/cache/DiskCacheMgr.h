@@ -0,0 +1,95 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CacheMgr.h"
+#include "DataObj.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace milvus {
+namespace cache {
+
+// local copy of a file fetched from s3, the copy is removed once it is evicted and no longer read
+class DiskFileObj : public DataObj {
+ public:
+    DiskFileObj(std::string path, int64_t size) : path_(std::move(path)), size_(size) {
+    }
+
+    ~DiskFileObj() {
+        std::remove(path_.c_str());
+    }
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+
+    const std::string&
+    Path() const {
+        return path_;
+    }
+
+ private:
+    std::string path_;
+    int64_t size_;
+};
+
+using DiskFileObjPtr = std::shared_ptr<DiskFileObj>;
+
+/*
+ * Cache tier on local disk between CpuCacheMgr and s3, index files downloaded from s3 are kept in
+ * storage_config.s3_cache_path, so loading them again costs a local read instead of a network fetch;
+ */
+class DiskCacheMgr : public CacheMgr<DataObjPtr> {
+ private:
+    DiskCacheMgr();
+
+ public:
+    static DiskCacheMgr*
+    GetInstance();
+
+    // disk cache is disabled when path is empty or capacity is 0
+    bool
+    Enabled() const;
+
+    // hold the returned object while reading the file
+    DiskFileObjPtr
+    GetFile(const std::string& key);
+
+    void
+    InsertFile(const std::string& key, const std::string& content);
+
+    // download the file from s3 in the background unless it is cached or downloading already
+    void
+    FetchFile(const std::string& key);
+
+ private:
+    std::string
+    NewCopyPath(const std::string& key);
+
+ private:
+    std::string path_;
+    std::atomic<uint64_t> file_seq_{0};
+
+    std::mutex fetch_mutex_;
+    std::unordered_set<std::string> fetching_;
+};
+
+}  // namespace cache
+}  // namespace milvus
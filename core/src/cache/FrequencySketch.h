@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace milvus {
+namespace cache {
+
+/*
+ * Approximate access frequency of keys, a count-min sketch of small saturating counters.
+ * All counters are halved after every sample_size accesses, so older popularity fades out.
+ */
+class FrequencySketch {
+ public:
+    explicit FrequencySketch(uint64_t width = 4096)
+        : width_(width), sample_size_(width * 10), counters_(width * DEPTH), additions_(0) {
+    }
+
+    void
+    Increment(uint64_t hash) {
+        for (uint64_t row = 0; row < DEPTH; ++row) {
+            auto& counter = counters_[index(hash, row)];
+            uint8_t count = counter.load(std::memory_order_relaxed);
+            while (count < MAX_COUNT && !counter.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+            }
+        }
+
+        if (++additions_ == sample_size_) {
+            for (auto& counter : counters_) {
+                counter.store(counter.load(std::memory_order_relaxed) >> 1, std::memory_order_relaxed);
+            }
+            additions_ -= sample_size_ / 2;
+        }
+    }
+
+    uint8_t
+    Frequency(uint64_t hash) const {
+        uint8_t frequency = MAX_COUNT;
+        for (uint64_t row = 0; row < DEPTH; ++row) {
+            uint8_t count = counters_[index(hash, row)].load(std::memory_order_relaxed);
+            frequency = (count < frequency) ? count : frequency;
+        }
+        return frequency;
+    }
+
+    void
+    Clear() {
+        for (auto& counter : counters_) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        additions_ = 0;
+    }
+
+ private:
+    uint64_t
+    index(uint64_t hash, uint64_t row) const {
+        // one hash per row derived from the key hash
+        uint64_t h = (hash ^ (row * 0xC2B2AE3D27D4EB4FULL)) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 29;
+        return row * width_ + h % width_;
+    }
+
+ private:
+    static constexpr uint64_t DEPTH = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
+
+    uint64_t width_;
+    uint64_t sample_size_;
+    std::vector<std::atomic<uint8_t>> counters_;
+    std::atomic<uint64_t> additions_;
+};
+
+}  // namespace cache
+}  // namespace milvus
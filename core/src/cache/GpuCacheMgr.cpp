@@ -15,6 +15,7 @@
 
 #include <fiu-local.h>
 #include <sstream>
+#include <string>
 #include <utility>
 
 namespace milvus {
@@ -26,7 +27,14 @@ std::unordered_map<uint64_t, GpuCacheMgrPtr> GpuCacheMgr::instance_;
 
 namespace {
 constexpr int64_t G_BYTE = 1024 * 1024 * 1024;
-}
+
+// an evicted index is copied from cpu to gpu again
+constexpr double COPY_LATENCY = 1.0;      // ms
+constexpr double COPY_BANDWIDTH = 6.0e6;  // bytes per ms
+
+// share of the capacity quantizers keep whatever index copies need room, beyond it the least used are evicted
+constexpr double QUANTIZER_RESERVED_SHARE = 0.125;
+}  // namespace
 
 GpuCacheMgr::GpuCacheMgr() {
     // All config values have been checked in Config::ValidateConfig()
@@ -49,6 +57,15 @@ GpuCacheMgr::GpuCacheMgr() {
     float gpu_mem_threshold;
     config.GetGpuResourceConfigCacheThreshold(gpu_mem_threshold);
     cache_->set_freemem_percent(gpu_mem_threshold);
+    cache_->set_reload_cost(COPY_LATENCY, COPY_BANDWIDTH);
+
+    std::string gpu_cache_policy;
+    config.GetGpuResourceConfigCachePolicy(gpu_cache_policy);
+    SetPolicy(gpu_cache_policy);
+
+    CacheQuota quantizer_quota;
+    quantizer_quota.reserved = static_cast<int64_t>(cap * QUANTIZER_RESERVED_SHARE);
+    SetQuota(GPU_QUANTIZER_GROUP, quantizer_quota);
 }
 
 GpuCacheMgr::~GpuCacheMgr() {
@@ -58,16 +75,14 @@ GpuCacheMgr::~GpuCacheMgr() {
 
 GpuCacheMgr*
 GpuCacheMgr::GetInstance(uint64_t gpu_id) {
+    // devices are initialized in parallel, the map is never looked up out of the lock
+    std::lock_guard<std::mutex> lock(mutex_);
     if (instance_.find(gpu_id) == instance_.end()) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (instance_.find(gpu_id) == instance_.end()) {
-            instance_.insert(std::pair<uint64_t, GpuCacheMgrPtr>(gpu_id, std::make_shared<GpuCacheMgr>()));
-        }
-        return instance_[gpu_id].get();
-    } else {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return instance_[gpu_id].get();
+        auto mgr = std::make_shared<GpuCacheMgr>();
+        mgr->SetName("gpu" + std::to_string(gpu_id));
+        instance_.insert(std::pair<uint64_t, GpuCacheMgrPtr>(gpu_id, mgr));
     }
+    return instance_[gpu_id].get();
 }
 
 DataObjPtr
@@ -78,8 +93,13 @@ GpuCacheMgr::GetIndex(const std::string& key) {
 
 void
 GpuCacheMgr::InsertItem(const std::string& key, const milvus::cache::DataObjPtr& data) {
+    InsertItem(key, data, "");
+}
+
+void
+GpuCacheMgr::InsertItem(const std::string& key, const milvus::cache::DataObjPtr& data, const std::string& group) {
     if (gpu_enable_) {
-        CacheMgr<DataObjPtr>::InsertItem(key, data);
+        CacheMgr<DataObjPtr>::InsertItem(key, data, group);
     }
 }
 
@@ -20,6 +20,9 @@ namespace milvus {
 namespace cache {
 
 #ifdef MILVUS_GPU_VERSION
+// group of the coarse quantizers of hybrid indexes, searched by every query of their tables
+constexpr const char* GPU_QUANTIZER_GROUP = "quantizer";
+
 class GpuCacheMgr;
 using GpuCacheMgrPtr = std::shared_ptr<GpuCacheMgr>;
 
@@ -38,6 +41,9 @@ class GpuCacheMgr : public CacheMgr<DataObjPtr> {
     void
     InsertItem(const std::string& key, const DataObjPtr& data);
 
+    void
+    InsertItem(const std::string& key, const DataObjPtr& data, const std::string& group);
+
  private:
     bool gpu_enable_ = true;
     std::string identity_;
@@ -0,0 +1,143 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/GpuMemoryArbiter.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace milvus {
+namespace cache {
+
+namespace {
+constexpr std::chrono::milliseconds RECHECK_INTERVAL(100);
+}  // namespace
+
+GpuMemoryArbiter&
+GpuMemoryArbiter::GetInstance() {
+    static GpuMemoryArbiter instance;
+    return instance;
+}
+
+void
+GpuMemoryArbiter::AddDevice(int64_t device_id, int64_t budget, int64_t fixed, CacheMgr<DataObjPtr>* cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Device& device = devices_[device_id];
+    device.budget = budget;
+    device.fixed = fixed;
+    device.cache = cache;
+
+    // the cache alone would fill the whole device otherwise, leaving nothing to loads and builds in flight
+    int64_t room = std::max<int64_t>(budget - fixed, 0);
+    if (cache != nullptr && cache->CacheCapacity() > room) {
+        SERVER_LOG_WARNING << "Capacity of cache " << cache->Name() << ": " << cache->CacheCapacity()
+                           << " bytes exceeds memory left on gpu" << device_id << ", cut to " << room << " bytes";
+        cache->SetCapacity(room);
+    }
+    SERVER_LOG_DEBUG << "Gpu" << device_id << " memory budget: " << budget << " bytes, fixed: " << fixed << " bytes";
+}
+
+void
+GpuMemoryArbiter::RemoveDevice(int64_t device_id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        devices_.erase(device_id);
+    }
+    released_.notify_all();
+}
+
+int64_t
+GpuMemoryArbiter::Used(const Device& device) const {
+    int64_t cached = device.cache != nullptr ? device.cache->CacheUsage() : 0;
+    return device.fixed + device.reserved + cached;
+}
+
+bool
+GpuMemoryArbiter::Reserve(int64_t device_id, int64_t size, int64_t wait_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        auto iter = devices_.find(device_id);
+        if (iter == devices_.end()) {
+            return true;
+        }
+
+        Device& device = iter->second;
+        if (size > device.budget - device.fixed) {
+            SERVER_LOG_ERROR << "Reserve " << size << " bytes on gpu" << device_id << ": more than the device holds";
+            return false;
+        }
+
+        int64_t lack = Used(device) + size - device.budget;
+        if (lack > 0 && device.cache != nullptr) {
+            lack -= device.cache->ReleaseMemory(lack);
+        }
+        if (lack <= 0) {
+            device.reserved += size;
+            return true;
+        }
+
+        // the rest is held by reservations in flight and protected cache items
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            SERVER_LOG_WARNING << "Reserve " << size << " bytes on gpu" << device_id << ": " << lack
+                               << " bytes short after waiting " << wait_ms << " ms";
+            return false;
+        }
+        // cache items erased meanwhile don't notify, check again now and then
+        released_.wait_until(lock, std::min(deadline, now + RECHECK_INTERVAL));
+    }
+}
+
+void
+GpuMemoryArbiter::Release(int64_t device_id, int64_t size) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = devices_.find(device_id);
+        if (iter == devices_.end()) {
+            return;
+        }
+        iter->second.reserved = std::max<int64_t>(iter->second.reserved - size, 0);
+    }
+    released_.notify_all();
+}
+
+int64_t
+GpuMemoryArbiter::Available(int64_t device_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = devices_.find(device_id);
+    if (iter == devices_.end()) {
+        return -1;
+    }
+    return std::max<int64_t>(iter->second.budget - Used(iter->second), 0);
+}
+
+int64_t
+GpuMemoryArbiter::Reserved(int64_t device_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = devices_.find(device_id);
+    return iter == devices_.end() ? 0 : iter->second.reserved;
+}
+
+GpuMemoryReservation::GpuMemoryReservation(int64_t device_id, int64_t size, int64_t wait_ms)
+    : device_id_(device_id), size_(size) {
+    ok_ = GpuMemoryArbiter::GetInstance().Reserve(device_id, size, wait_ms);
+}
+
+GpuMemoryReservation::~GpuMemoryReservation() {
+    if (ok_) {
+        GpuMemoryArbiter::GetInstance().Release(device_id_, size_);
+    }
+}
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,104 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CacheMgr.h"
+#include "DataObj.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace milvus {
+namespace cache {
+
+/*
+ * Accounts the memory of each gpu: the fixed part held by faiss resources, the cached indexes and the
+ * reservations of loads and builds in flight. Memory is reserved before it is allocated on the device,
+ * a reservation which doesn't fit evicts cached items first, then waits for other reservations to be
+ * released, so tasks are deferred instead of running into cuda out of memory;
+ */
+class GpuMemoryArbiter {
+ public:
+    static GpuMemoryArbiter&
+    GetInstance();
+
+    // budget: bytes of the device the server may use; fixed: bytes held for the whole run, e.g. temp memory
+    // of faiss resources; cache: indexes cached on the device, its capacity is cut to fit the budget
+    void
+    AddDevice(int64_t device_id, int64_t budget, int64_t fixed, CacheMgr<DataObjPtr>* cache);
+
+    void
+    RemoveDevice(int64_t device_id);
+
+    // wait_ms: time to wait for others to release their reservations, return false if there is still no room;
+    // devices not added have no limit
+    bool
+    Reserve(int64_t device_id, int64_t size, int64_t wait_ms = 0);
+
+    void
+    Release(int64_t device_id, int64_t size);
+
+    // bytes neither reserved nor cached, -1 for devices not added
+    int64_t
+    Available(int64_t device_id);
+
+    int64_t
+    Reserved(int64_t device_id);
+
+ private:
+    GpuMemoryArbiter() = default;
+
+    struct Device {
+        int64_t budget = 0;
+        int64_t fixed = 0;
+        int64_t reserved = 0;
+        CacheMgr<DataObjPtr>* cache = nullptr;
+    };
+
+    int64_t
+    Used(const Device& device) const;
+
+ private:
+    std::mutex mutex_;
+    std::condition_variable released_;
+    std::unordered_map<int64_t, Device> devices_;
+};
+
+// memory reserved on a gpu while the object lives
+class GpuMemoryReservation {
+ public:
+    GpuMemoryReservation(int64_t device_id, int64_t size, int64_t wait_ms = 0);
+
+    ~GpuMemoryReservation();
+
+    GpuMemoryReservation(const GpuMemoryReservation&) = delete;
+    GpuMemoryReservation&
+    operator=(const GpuMemoryReservation&) = delete;
+
+    bool
+    ok() const {
+        return ok_;
+    }
+
+ private:
+    int64_t device_id_;
+    int64_t size_;
+    bool ok_;
+};
+
+using GpuMemoryReservationPtr = std::shared_ptr<GpuMemoryReservation>;
+
+}  // namespace cache
+}  // namespace milvus
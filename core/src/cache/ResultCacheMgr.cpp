@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/ResultCacheMgr.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+#include <functional>
+
+namespace milvus {
+namespace cache {
+
+namespace {
+constexpr int64_t unit = 1024 * 1024;
+}
+
+ResultCacheMgr::ResultCacheMgr() {
+    // All config values have been checked in Config::ValidateConfig()
+    server::Config& config = server::Config::GetInstance();
+
+    int64_t result_cache_cap;
+    config.GetCacheConfigResultCacheCapacity(result_cache_cap);
+    int64_t cap = result_cache_cap * unit;
+    cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32);
+}
+
+ResultCacheMgr*
+ResultCacheMgr::GetInstance() {
+    static ResultCacheMgr s_mgr;
+    return &s_mgr;
+}
+
+bool
+ResultCacheMgr::Enabled() const {
+    return CacheCapacity() > 0;
+}
+
+bool
+ResultCacheMgr::GetResult(const std::string& signature, engine::ResultIds& ids, engine::ResultDistances& distances) {
+    if (!Enabled()) {
+        return false;
+    }
+
+    auto obj = std::static_pointer_cast<QueryResultObj>(GetItem(GenKey(signature)));
+    if (obj == nullptr || obj->Signature() != signature) {
+        return false;
+    }
+
+    ids = obj->Ids();
+    distances = obj->Distances();
+    return true;
+}
+
+void
+ResultCacheMgr::InsertResult(const std::string& signature, const engine::ResultIds& ids,
+                             const engine::ResultDistances& distances) {
+    if (!Enabled()) {
+        return;
+    }
+
+    auto obj = std::make_shared<QueryResultObj>(signature, ids, distances);
+    if (obj->Size() > CacheCapacity()) {
+        // a result larger than the whole cache would only evict everything else
+        return;
+    }
+    InsertItem(GenKey(signature), obj);
+}
+
+std::string
+ResultCacheMgr::GenKey(const std::string& signature) {
+    return std::to_string(std::hash<std::string>()(signature));
+}
+
+}  // namespace cache
+}  // namespace milvus
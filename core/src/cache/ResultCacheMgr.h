@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CacheMgr.h"
+#include "DataObj.h"
+#include "db/Types.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace milvus {
+namespace cache {
+
+// topk result of a query, the signature is kept to verify a hit against hash collision
+class QueryResultObj : public DataObj {
+ public:
+    QueryResultObj(std::string signature, engine::ResultIds ids, engine::ResultDistances distances)
+        : signature_(std::move(signature)), ids_(std::move(ids)), distances_(std::move(distances)) {
+    }
+
+    int64_t
+    Size() override {
+        return signature_.size() + ids_.size() * sizeof(int64_t) + distances_.size() * sizeof(float);
+    }
+
+    const std::string&
+    Signature() const {
+        return signature_;
+    }
+
+    const engine::ResultIds&
+    Ids() const {
+        return ids_;
+    }
+
+    const engine::ResultDistances&
+    Distances() const {
+        return distances_;
+    }
+
+ private:
+    std::string signature_;
+    engine::ResultIds ids_;
+    engine::ResultDistances distances_;
+};
+
+using QueryResultObjPtr = std::shared_ptr<QueryResultObj>;
+
+class ResultCacheMgr : public CacheMgr<DataObjPtr> {
+ private:
+    ResultCacheMgr();
+
+ public:
+    static ResultCacheMgr*
+    GetInstance();
+
+    // result cache is disabled when capacity is 0
+    bool
+    Enabled() const;
+
+    // signature must identify both the query and the table files it runs on, any file change leads to a miss
+    bool
+    GetResult(const std::string& signature, engine::ResultIds& ids, engine::ResultDistances& distances);
+
+    void
+    InsertResult(const std::string& signature, const engine::ResultIds& ids,
+                 const engine::ResultDistances& distances);
+
+ private:
+    static std::string
+    GenKey(const std::string& signature);
+};
+
+}  // namespace cache
+}  // namespace milvus
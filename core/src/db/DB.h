@@ -15,9 +15,11 @@
 #include <string>
 #include <vector>
 
+#include "IndexAdvisor.h"
 #include "Options.h"
 #include "Types.h"
 #include "meta/Meta.h"
+#include "meta/MetaChangeFeed.h"
 #include "server/context/Context.h"
 #include "utils/Status.h"
 
@@ -61,6 +63,15 @@ class DB {
     virtual Status
     PreloadTable(const std::string& table_id) = 0;
 
+    // files loaded of the tables preloaded since start, one line per table
+    virtual Status
+    GetPreloadProgress(std::string& result) = 0;
+
+    // cpu cache bytes reserved for files of a table(or partition), max 0 means no limit,
+    // files of a pinned table are never evicted
+    virtual Status
+    SetTableCacheQuota(const std::string& table_id, int64_t reserved, int64_t max, bool pinned) = 0;
+
     virtual Status
     UpdateTableFlag(const std::string& table_id, int64_t flag) = 0;
 
@@ -80,6 +91,19 @@ class DB {
     virtual Status
     InsertVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) = 0;
 
+    // write vectors into table files directly, bypassing insert buffer, for initial loading of huge data
+    virtual Status
+    BulkLoad(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) = 0;
+
+    // vectors of the ids are no longer returned by searches of the table(and its partitions), their files are
+    // rewritten without them by later merges
+    virtual Status
+    DeleteByID(const std::string& table_id, const IDNumbers& vector_ids) = 0;
+
+    // vector of the id in the table(and its partitions), vector_count_ is 0 if there is none
+    virtual Status
+    GetVectorByID(const std::string& table_id, const IDNumber& vector_id, VectorsData& vector) = 0;
+
     virtual Status
     Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
           const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
@@ -95,12 +119,71 @@ class DB {
                   const std::vector<std::string>& file_ids, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
                   const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) = 0;
 
+    // vectors within radius of the queries in the table(or the partitions of tags), hits of a query are the
+    // max_results nearest of them at most, padded with id -1; float vectors of IDMAP and IVF files only
+    virtual Status
+    QueryByRange(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                 const std::vector<std::string>& partition_tags, float radius, uint64_t max_results, uint64_t nprobe,
+                 const VectorsData& vectors, const meta::DatesT& dates, ResultIds& result_ids,
+                 ResultDistances& result_distances) = 0;
+
+    // brute force search on raw files and insert buffer of the table(or the partitions of tags), the ground truth
+    // to measure recall of indexes, files aren't cached
+    virtual Status
+    QueryExact(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+               const std::vector<std::string>& partition_tags, uint64_t k, const VectorsData& vectors,
+               ResultIds& result_ids, ResultDistances& result_distances) = 0;
+
+    // files a search of the table(or the partitions of tags) runs on, for clients sending SearchInFiles of them
+    // to the nodes owning them, buffered vectors are not in any file
+    virtual Status
+    GetSearchFiles(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                   meta::TableFilesSchema& files) = 0;
+
+    // changes of meta made by the writable node, files no longer searched are dropped from cache and new ones owned
+    // by this node are loaded ahead of searches, incomplete changes refresh every table
+    virtual Status
+    ApplyMetaChanges(const std::vector<meta::MetaChange>& changes, bool complete) = 0;
+
     virtual Status
     Size(uint64_t& result) = 0;
 
+    // serialize buffered vectors of the tables(and their partitions) right now, all tables if table_ids is empty
+    virtual Status
+    Flush(const std::vector<std::string>& table_ids) = 0;
+
+    // files of the table(and its partitions) linked to path with a dump of their meta, the files are those of one
+    // moment after the buffered vectors are flushed, path must not hold an export yet
+    virtual Status
+    ExportTable(const std::string& table_id, const std::string& path) = 0;
+
+    // create a table of the export at path, its files are registered as they are without a rebuild, the exported
+    // name is taken if table_id is empty
+    virtual Status
+    ImportTable(const std::string& path, const std::string& table_id) = 0;
+
     virtual Status
     CreateIndex(const std::string& table_id, const TableIndex& index) = 0;
 
+    // update the index and return at once, files are built in background until all of them are indexed,
+    // a creation left by a restart goes on after it
+    virtual Status
+    CreateIndexAsync(const std::string& table_id, const TableIndex& index) = 0;
+
+    // indexed rows, rate and remaining time of the index creations since start, one line per table
+    virtual Status
+    GetIndexProgress(std::string& result) = 0;
+
+    // rows of the table(and its partitions) in index files, and those plus the rows yet to be built, small raw files
+    // which are never built are not counted
+    virtual Status
+    GetIndexRowCount(const std::string& table_id, uint64_t& indexed_rows, uint64_t& total_rows) = 0;
+
+    // index type, nlist and nprobe reaching the target recall at topk fastest, tried on vectors sampled from the
+    // raw files of the table(and its partitions)
+    virtual Status
+    AdviseIndex(const std::string& table_id, double target_recall, int64_t topk, IndexAdvice& advice) = 0;
+
     virtual Status
     DescribeIndex(const std::string& table_id, TableIndex& index) = 0;
 
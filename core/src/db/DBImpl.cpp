@@ -16,28 +16,60 @@
 #include <algorithm>
 #include <boost/filesystem.hpp>
 #include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <regex>
 #include <set>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
+#include "IDGenerator.h"
+#include "IndexAdvisor.h"
+#include "MergePolicy.h"
+#include "SearchEffortController.h"
+#include "SegmentOwnership.h"
 #include "Utils.h"
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
+#include "cache/ResultCacheMgr.h"
 #include "engine/EngineFactory.h"
+#include "engine/ExecutionEngineImpl.h"
+#include "engine/SegmentAttrs.h"
+#include "engine/SegmentIdIndex.h"
+#include "engine/SegmentSummary.h"
+#include "engine/SegmentTimeRange.h"
+#include "engine/SegmentTombstone.h"
 #include "insert/MemMenagerFactory.h"
 #include "meta/MetaConsts.h"
 #include "meta/MetaFactory.h"
 #include "meta/SqliteMetaImpl.h"
+#include "meta/SnapshotMetaImpl.h"
 #include "metrics/Metrics.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
 #include "scheduler/job/SearchJob.h"
+#include "scheduler/optimizer/SearchCostEstimator.h"
+#include "scheduler/task/SearchTask.h"
+#include "storage/IORateLimiter.h"
+#include "utils/CommonUtil.h"
+#include "utils/Json.h"
 #include "utils/Log.h"
 #include "utils/StringHelpFunctions.h"
 #include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#ifdef MILVUS_GPU_VERSION
+#include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
+#endif
 
 namespace milvus {
 namespace engine {
@@ -47,9 +79,50 @@ namespace {
 constexpr uint64_t METRIC_ACTION_INTERVAL = 1;
 constexpr uint64_t COMPACT_ACTION_INTERVAL = 1;
 constexpr uint64_t INDEX_ACTION_INTERVAL = 1;
+constexpr uint64_t CLEANUP_ACTION_INTERVAL = 1;
+constexpr uint64_t FLUSH_CHECK_INTERVAL_MS = 100;  // flush policies are checked more often than other tasks
 
 static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown!");
 
+static const char* ID_HIGH_WATER_FILE = "id_high_water";
+
+// locations and hit counts of cached files, to load the hottest of them again after restart
+static const char* CACHE_MANIFEST_FILE = "cache_manifest";
+constexpr uint64_t CACHE_MANIFEST_INTERVAL = 60;  // seconds
+constexpr uint64_t CACHE_WARMUP_THREAD_NUM = 4;
+
+// cache quotas of tables, set at runtime and kept across restart
+static const char* CACHE_QUOTA_FILE = "cache_quota";
+
+// bounds cost nq * files * dimension, a large batch rarely prunes any file
+constexpr uint64_t SUMMARY_PRUNE_MAX_NQ = 64;
+// tolerate float rounding of the distances returned by faiss
+constexpr double SUMMARY_BOUND_SLACK = 1e-4;
+
+// files compressed to pq codes in a round of compaction, the builds of other files wait meanwhile
+constexpr uint64_t ARCHIVE_FILES_PER_ROUND = 4;
+// pq codebooks have 2^8 centroids, fewer vectors can't train them
+constexpr int64_t ARCHIVE_MIN_ROWS = 256;
+
+// meta of an export, written last so a path holding it holds a complete export
+static const char* EXPORT_META_FILE = "meta.json";
+constexpr uint64_t EXPORT_THREAD_NUM = 8;
+
+// vectors an index advice is tried on, enough for a stable recall, few enough to build a graph in seconds
+constexpr int64_t ADVISE_SAMPLE_ROWS = 20000;
+
+// an index of another type replaces the old one segment by segment, the old one searched meanwhile; an idmap has no
+// index files to keep, and a change of nlist alone can't tell the old files from the new ones
+bool
+IsReplaceableIndex(const TableIndex& old_index, const TableIndex& new_index) {
+    auto no_index = [](int32_t engine_type) {
+        return engine_type == static_cast<int32_t>(EngineType::FAISS_IDMAP) ||
+               engine_type == static_cast<int32_t>(EngineType::FAISS_BIN_IDMAP);
+    };
+    return old_index.engine_type_ != new_index.engine_type_ && !no_index(old_index.engine_type_) &&
+           !no_index(new_index.engine_type_);
+}
+
 void
 TraverseFiles(const meta::DatePartionedTableFilesSchema& date_files, meta::TableFilesSchema& files_array) {
     for (auto& day_files : date_files) {
@@ -59,12 +132,253 @@ TraverseFiles(const meta::DatePartionedTableFilesSchema& date_files, meta::Table
     }
 }
 
+// files of vectors all inserted out of the time ranges of a search are not searched
+void
+PruneFilesByTime(const TimeRanges& time_ranges, meta::TableFilesSchema& files) {
+    if (time_ranges.empty()) {
+        return;
+    }
+
+    auto pruned = [&](const meta::TableFileSchema& file) {
+        auto time_range = SegmentTimeRangeMgr::GetInstance().GetTimeRange(file.location_);
+        return time_range != nullptr && !time_range->Overlaps(time_ranges);
+    };
+    size_t count = files.size();
+    files.erase(std::remove_if(files.begin(), files.end(), pruned), files.end());
+    if (files.size() < count) {
+        ENGINE_LOG_DEBUG << count - files.size() << " files are out of the time ranges of search";
+    }
+}
+
+void
+SplitFilesBySummary(const meta::TableFilesSchema& files, uint64_t k, const VectorsData& vectors,
+                    meta::TableFilesSchema& first_files, meta::TableFilesSchema& rest_files,
+                    std::vector<std::vector<double>>& rest_bounds) {
+    first_files.clear();
+    rest_files.clear();
+    rest_bounds.clear();
+
+    uint64_t nq = vectors.vector_count_;
+    MetricType metric_type = files.empty() ? MetricType::L2 : static_cast<MetricType>(files.front().metric_type_);
+    if (files.size() <= 1 || vectors.float_data_.empty() || nq > SUMMARY_PRUNE_MAX_NQ ||
+        (metric_type != MetricType::L2 && metric_type != MetricType::IP)) {
+        first_files = files;
+        return;
+    }
+
+    // files without summary are always searched first
+    uint16_t dimension = files.front().dimension_;
+    std::vector<bool> selected(files.size(), false);
+    std::vector<size_t> summarized;
+    std::vector<std::vector<double>> bounds;
+    for (size_t i = 0; i < files.size(); i++) {
+        auto summary = SegmentSummaryMgr::GetInstance().GetSummary(files[i].location_);
+        if (summary == nullptr || summary->Dimension() != dimension) {
+            selected[i] = true;
+            continue;
+        }
+
+        std::vector<double> file_bounds(nq);
+        for (uint64_t q = 0; q < nq; q++) {
+            file_bounds[q] = summary->Bound(vectors.float_data_.data() + q * dimension, metric_type);
+        }
+        summarized.push_back(i);
+        bounds.emplace_back(std::move(file_bounds));
+    }
+
+    // for each query, files with the best bounds are selected until they hold k vectors
+    bool ascending = (metric_type != MetricType::IP);
+    std::vector<size_t> order(summarized.size());
+    for (uint64_t q = 0; q < nq; q++) {
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return ascending ? bounds[a][q] < bounds[b][q] : bounds[a][q] > bounds[b][q];
+        });
+
+        uint64_t row_count = 0;
+        for (size_t j = 0; j < order.size() && row_count < k; j++) {
+            selected[summarized[order[j]]] = true;
+            row_count += files[summarized[order[j]]].row_count_;
+        }
+    }
+
+    for (size_t i = 0; i < files.size(); i++) {
+        if (selected[i]) {
+            first_files.push_back(files[i]);
+        }
+    }
+    for (size_t j = 0; j < summarized.size(); j++) {
+        if (!selected[summarized[j]]) {
+            rest_files.push_back(files[summarized[j]]);
+            rest_bounds.emplace_back(std::move(bounds[j]));
+        }
+    }
+}
+
+void
+PruneFilesBySummary(const meta::TableFilesSchema& files, const std::vector<std::vector<double>>& bounds, uint64_t k,
+                    uint64_t nq, bool ascending, const ResultIds& result_ids, const ResultDistances& result_distances,
+                    meta::TableFilesSchema& search_files) {
+    search_files.clear();
+
+    // k-th result of each query is the threshold, nothing is pruned unless every query has k results
+    size_t result_k = (nq == 0) ? 0 : result_ids.size() / nq;
+    std::vector<double> thresholds(nq);
+    for (uint64_t q = 0; q < nq; q++) {
+        size_t kth = q * result_k + k - 1;
+        if (result_k < k || result_ids[kth] < 0) {
+            search_files = files;
+            return;
+        }
+        thresholds[q] = result_distances[kth];
+    }
+
+    // a file is pruned only if its bound can't beat the threshold of any query
+    for (size_t i = 0; i < files.size(); i++) {
+        bool prune = true;
+        for (uint64_t q = 0; q < nq && prune; q++) {
+            double slack = SUMMARY_BOUND_SLACK * (1.0 + std::abs(thresholds[q]));
+            prune = ascending ? (bounds[i][q] > thresholds[q] + slack) : (bounds[i][q] < thresholds[q] - slack);
+        }
+        if (!prune) {
+            search_files.push_back(files[i]);
+        }
+    }
+}
+
+Status
+RunSearchJob(const scheduler::SearchJobPtr& job, const meta::TableFilesSchema& files, ResultIds& result_ids,
+             ResultDistances& result_distances) {
+    result_ids.clear();
+    result_distances.clear();
+    if (files.empty()) {
+        return Status::OK();
+    }
+
+    for (auto& file : files) {
+        scheduler::TableFileSchemaPtr file_ptr = std::make_shared<meta::TableFileSchema>(file);
+        job->AddIndexFile(file_ptr);
+    }
+
+    // put search job to scheduler and wait result
+    scheduler::JobMgrInst::GetInstance()->Put(job);
+    job->WaitResult();
+    if (!job->GetStatus().ok()) {
+        return job->GetStatus();
+    }
+
+    // the job is dropped here, its merged topk is taken without copy
+    result_ids = std::move(job->GetResultIds());
+    result_distances = std::move(job->GetResultDistances());
+    return Status::OK();
+}
+
+Status
+SearchFiles(const std::shared_ptr<server::Context>& context, const meta::TableFilesSchema& files, uint64_t k,
+            uint64_t nprobe, const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) {
+    auto job = std::make_shared<scheduler::SearchJob>(context, k, nprobe, vectors);
+    return RunSearchJob(job, files, result_ids, result_distances);
+}
+
+// hits out of radius are dropped from a sorted result, they are at the tail of each query and padded as a range
+// search pads its results
+void
+DropOutOfRange(float radius, bool ascending, ResultIds& result_ids, ResultDistances& result_distances) {
+    float pad = ascending ? std::numeric_limits<float>::max() : std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < result_ids.size(); i++) {
+        if (ascending ? result_distances[i] >= radius : result_distances[i] <= radius) {
+            result_ids[i] = -1;
+            result_distances[i] = pad;
+        }
+    }
+}
+
+template <typename T>
+void
+AppendSignature(std::string& signature, const T& value) {
+    signature.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// identify a query together with the state of files it runs on, a file added, merged, indexed or removed
+// changes the signature, so do vectors deleted from a file, a cached result is never served for a changed table
+std::string
+GenQuerySignature(const std::string& table_id, const meta::TableFilesSchema& files, uint64_t k, uint64_t nprobe,
+                  const VectorsData& vectors) {
+    std::vector<const meta::TableFileSchema*> sorted_files;
+    for (auto& file : files) {
+        sorted_files.push_back(&file);
+    }
+    std::sort(sorted_files.begin(), sorted_files.end(),
+              [](const meta::TableFileSchema* l, const meta::TableFileSchema* r) { return l->id_ < r->id_; });
+
+    std::string signature = table_id;
+    signature.push_back('\0');
+    AppendSignature(signature, k);
+    AppendSignature(signature, nprobe);
+    for (auto file : sorted_files) {
+        AppendSignature(signature, file->id_);
+        AppendSignature(signature, file->file_type_);
+        AppendSignature(signature, file->row_count_);
+        AppendSignature(signature, file->file_size_);
+        AppendSignature(signature, file->updated_time_);
+        auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(file->location_);
+        size_t deleted_count = (tombstone == nullptr) ? 0 : tombstone->Count();
+        AppendSignature(signature, deleted_count);
+    }
+    AppendSignature(signature, vectors.vector_count_);
+    signature.append(reinterpret_cast<const char*>(vectors.float_data_.data()),
+                     vectors.float_data_.size() * sizeof(float));
+    signature.append(reinterpret_cast<const char*>(vectors.binary_data_.data()), vectors.binary_data_.size());
+    for (auto& predicate : vectors.predicates_) {
+        signature.append(predicate.name_);
+        signature.push_back('\0');
+        AppendSignature(signature, predicate.op_);
+        AppendSignature(signature, predicate.values_.size());
+        signature.append(reinterpret_cast<const char*>(predicate.values_.data()),
+                         predicate.values_.size() * sizeof(double));
+    }
+    return signature;
+}
+
+// until its index is built a file is scanned by every query reaching it, the files costing searches most are
+// the ones searched often and the large ones, they are built first
+void
+SortByBuildPriority(meta::TableFilesSchema& files) {
+    auto& estimator = scheduler::SearchCostEstimator::GetInstance();
+    std::vector<std::pair<double, size_t>> priorities;
+    priorities.reserve(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        double cost = (1.0 + estimator.Hotness(files[i].id_)) * files[i].row_count_;
+        priorities.emplace_back(cost, i);
+    }
+    std::stable_sort(priorities.begin(), priorities.end(),
+                     [](const std::pair<double, size_t>& l, const std::pair<double, size_t>& r) {
+                         return l.first > r.first;
+                     });
+
+    meta::TableFilesSchema sorted_files;
+    sorted_files.reserve(files.size());
+    for (auto& priority : priorities) {
+        sorted_files.emplace_back(std::move(files[priority.second]));
+    }
+    files.swap(sorted_files);
+}
+
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options)
-    : options_(options), initialized_(false), compact_thread_pool_(1, 1), index_thread_pool_(1, 1) {
+    : options_(options),
+      initialized_(false),
+      compact_thread_pool_(1, 1),
+      merge_thread_pool_(std::max<size_t>(options.merge_thread_num_, 1)),
+      index_thread_pool_(1, 1),
+      clean_thread_pool_(1, 1) {
     meta_ptr_ = MetaFactory::Build(options.meta_, options.mode_);
     mem_mgr_ = MemManagerFactory::Build(meta_ptr_, options_);
+    id_generator_ = std::make_shared<AtomicIDGenerator>(options_.meta_.path_ + "/" + ID_HIGH_WATER_FILE);
+    if (options_.wal_enable_ && options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
+        wal_mgr_ = std::make_shared<wal::WalManager>(options_.wal_path_);
+    }
     Start();
 }
 
@@ -82,6 +396,22 @@ DBImpl::Start() {
     }
 
     // ENGINE_LOG_TRACE << "DB service start";
+    auto status = id_generator_->Init();
+    if (!status.ok()) {
+        return status;
+    }
+
+    // un-flushed inserts must be recovered before accepting new requests
+    if (wal_mgr_ != nullptr) {
+        status = RecoverFromWal();
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    // quotas protect files of tables before any of them is loaded
+    LoadCacheQuotas();
+
     initialized_.store(true, std::memory_order_release);
 
     // for distribute version, some nodes are read only
@@ -90,6 +420,8 @@ DBImpl::Start() {
         bg_timer_thread_ = std::thread(&DBImpl::BackgroundTimerTask, this);
     }
 
+    bg_warmup_thread_ = std::thread(&DBImpl::BackgroundCacheWarmUp, this);
+
     return Status::OK();
 }
 
@@ -105,7 +437,15 @@ DBImpl::Stop() {
     SyncMemData(sync_table_ids);
 
     // wait compaction/buildindex finish
-    bg_timer_thread_.join();
+    if (bg_timer_thread_.joinable()) {
+        bg_timer_thread_.join();
+    }
+
+    // warm up stops loading files once shutdown
+    if (bg_warmup_thread_.joinable()) {
+        bg_warmup_thread_.join();
+    }
+    SaveCacheManifest();
 
     if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
         meta_ptr_->CleanUpShadowFiles();
@@ -137,6 +477,10 @@ DBImpl::DropTable(const std::string& table_id, const meta::DatesT& dates) {
         return SHUTDOWN_ERROR;
     }
 
+    if (dates.empty()) {
+        std::lock_guard<std::mutex> lock(index_progress_mutex_);
+        index_progresses_.erase(table_id);
+    }
     return DropTableRecursively(table_id, dates);
 }
 
@@ -186,32 +530,35 @@ DBImpl::PreloadTable(const std::string& table_id) {
         return SHUTDOWN_ERROR;
     }
 
-    // step 1: get all table files from parent table
+    // step 1: get all table files from parent table and partition tables
+    std::set<std::string> table_ids = {table_id};
+    std::vector<meta::TableSchema> partition_array;
+    auto status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    for (auto& schema : partition_array) {
+        table_ids.insert(schema.table_id_);
+    }
+
     meta::DatesT dates;
-    std::vector<size_t> ids;
     meta::TableFilesSchema files_array;
-    auto status = GetFilesToSearch(table_id, ids, dates, files_array);
+    status = GetFilesToSearch(table_ids, dates, files_array);
     if (!status.ok()) {
         return status;
     }
 
-    // step 2: get files from partition tables
-    std::vector<meta::TableSchema> partition_array;
-    status = meta_ptr_->ShowPartitions(table_id, partition_array);
-    for (auto& schema : partition_array) {
-        status = GetFilesToSearch(schema.table_id_, ids, dates, files_array);
-    }
-
     int64_t size = 0;
     int64_t cache_total = cache::CpuCacheMgr::GetInstance()->CacheCapacity();
     int64_t cache_usage = cache::CpuCacheMgr::GetInstance()->CacheUsage();
     int64_t available_size = cache_total - cache_usage;
 
-    // step 3: load file one by one
-    ENGINE_LOG_DEBUG << "Begin pre-load table:" + table_id + ", totally " << files_array.size()
-                     << " files need to be pre-loaded";
-    TimeRecorderAuto rc("Pre-load table:" + table_id);
+    // step 3: pick files in order until cache would overflow
+    status = Status::OK();
+    std::vector<ExecutionEnginePtr> engines;
     for (auto& file : files_array) {
+        // files owned by other readonly nodes are preloaded there
+        if (!SegmentOwnership::GetInstance().Owns(file.id_)) {
+            continue;
+        }
+
         ExecutionEnginePtr engine = EngineFactory::Build(file.dimension_, file.location_, (EngineType)file.engine_type_,
                                                          (MetricType)file.metric_type_, file.nlist_);
         fiu_do_on("DBImpl.PreloadTable.null_engine", engine = nullptr);
@@ -224,24 +571,114 @@ DBImpl::PreloadTable(const std::string& table_id) {
         fiu_do_on("DBImpl.PreloadTable.exceed_cache", size = available_size + 1);
         if (size > available_size) {
             ENGINE_LOG_DEBUG << "Pre-load canceled since cache almost full";
-            return Status(SERVER_CACHE_FULL, "Cache is full");
-        } else {
-            try {
-                fiu_do_on("DBImpl.PreloadTable.engine_throw_exception", throw std::exception());
-                std::string msg = "Pre-loaded file: " + file.file_id_ + " size: " + std::to_string(file.file_size_);
-                TimeRecorderAuto rc_1(msg);
-                engine->Load(true);
-            } catch (std::exception& ex) {
-                std::string msg = "Pre-load table encounter exception: " + std::string(ex.what());
-                ENGINE_LOG_ERROR << msg;
-                return Status(DB_ERROR, msg);
-            }
+            status = Status(SERVER_CACHE_FULL, "Cache is full");
+            size -= engine->PhysicalSize();
+            break;
+        }
+        engines.push_back(engine);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(preload_mutex_);
+        auto& state = preload_states_[table_id];
+        state = PreloadState();
+        state.total_files_ = engines.size();
+        state.total_size_ = size;
+    }
+
+    // step 4: load files in parallel, bounded by disk bandwidth rather than a single reader
+    ENGINE_LOG_DEBUG << "Begin pre-load table:" + table_id + ", totally " << engines.size()
+                     << " files need to be pre-loaded";
+    TimeRecorderAuto rc("Pre-load table:" + table_id);
+    size_t thread_num = std::min<size_t>(options_.preload_thread_num_, engines.size());
+    std::vector<std::future<Status>> results;
+    {
+        ThreadPool pool(std::max<size_t>(thread_num, 1), std::max<size_t>(engines.size(), 1));
+        for (auto& engine : engines) {
+            results.emplace_back(pool.enqueue([this, engine, &table_id]() -> Status {
+                try {
+                    fiu_do_on("DBImpl.PreloadTable.engine_throw_exception", throw std::exception());
+                    std::string msg = "Pre-loaded file: " + engine->GetLocation() +
+                                      " size: " + std::to_string(engine->PhysicalSize());
+                    TimeRecorderAuto rc_1(msg);
+                    engine->Load(true);
+                } catch (std::exception& ex) {
+                    std::string msg = "Pre-load table encounter exception: " + std::string(ex.what());
+                    ENGINE_LOG_ERROR << msg;
+                    return Status(DB_ERROR, msg);
+                }
+
+                std::lock_guard<std::mutex> lock(preload_mutex_);
+                auto& state = preload_states_[table_id];
+                state.loaded_files_++;
+                state.loaded_size_ += engine->PhysicalSize();
+                return Status::OK();
+            }));
+        }
+    }
+
+    for (auto& result : results) {
+        auto load_status = result.get();
+        if (!load_status.ok()) {
+            status = load_status;
         }
     }
 
+    std::lock_guard<std::mutex> lock(preload_mutex_);
+    preload_states_[table_id].finished_ = true;
+
+    return status;
+}
+
+Status
+DBImpl::GetPreloadProgress(std::string& result) {
+    std::lock_guard<std::mutex> lock(preload_mutex_);
+    result.clear();
+    for (auto& pair : preload_states_) {
+        auto& state = pair.second;
+        result += pair.first + ": " + std::to_string(state.loaded_files_) + "/" + std::to_string(state.total_files_) +
+                  " files, " + std::to_string(state.loaded_size_) + "/" + std::to_string(state.total_size_) +
+                  " bytes, " + (state.finished_ ? "finished" : "loading") + "\n";
+    }
+
     return Status::OK();
 }
 
+Status
+DBImpl::SetTableCacheQuota(const std::string& table_id, int64_t reserved, int64_t max, bool pinned) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    if (reserved < 0 || max < 0 || (max > 0 && reserved > max)) {
+        return Status(DB_ERROR, "Invalid cache quota, reserved size must not exceed max size");
+    }
+
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cache_quota_mutex_);
+        if (reserved == 0 && max == 0 && !pinned) {
+            cache_quotas_.erase(table_id);
+            cache::CpuCacheMgr::GetInstance()->RemoveQuota(table_id);
+        } else {
+            cache::CacheQuota quota;
+            quota.reserved = reserved;
+            quota.max = max;
+            quota.pinned = pinned;
+            cache_quotas_[table_id] = quota;
+            cache::CpuCacheMgr::GetInstance()->SetQuota(table_id, quota);
+        }
+    }
+
+    return SaveCacheQuotas();
+}
+
 Status
 DBImpl::UpdateTableFlag(const std::string& table_id, int64_t flag) {
     if (!initialized_.load(std::memory_order_acquire)) {
@@ -278,6 +715,10 @@ DBImpl::DropPartition(const std::string& partition_name) {
 
     auto status = mem_mgr_->EraseMemVector(partition_name);  // not allow insert
     status = meta_ptr_->DropPartition(partition_name);       // soft delete table
+    if (wal_mgr_ != nullptr) {
+        // records of the dropped partition needn't be replayed
+        wal_mgr_->Checkpoint(wal_mgr_->GetAppliedLsn(), {partition_name});
+    }
 
     // scheduler will determine when to delete table files
     auto nres = scheduler::ResMgrInst::GetInstance()->GetNumOfComputeResource();
@@ -334,251 +775,1723 @@ DBImpl::InsertVectors(const std::string& table_id, const std::string& partition_
 
     // insert vectors into target table
     milvus::server::CollectInsertMetrics metrics(vectors.vector_count_, status);
+
+    // generate ids and insert time before logging, so that replay produce the same ones
+    if (vectors.id_array_.empty()) {
+        id_generator_->GetNextIDNumbers(vectors.vector_count_, vectors.id_array_);
+    }
+    vectors.insert_time_us_ = utils::GetMicroSecTimeStamp();
+
+    if (wal_mgr_ == nullptr) {
+        status = mem_mgr_->InsertVectors(target_table_name, vectors);
+        return status;
+    }
+
+    // the request is acknowledged once the record is durable in wal, no need to wait for serialization
+    uint64_t lsn = 0;
+    status = wal_mgr_->Append(target_table_name, vectors, lsn);
+    if (!status.ok()) {
+        return status;
+    }
+
     status = mem_mgr_->InsertVectors(target_table_name, vectors);
+    if (status.ok()) {
+        wal_mgr_->MarkApplied(lsn);
+    } else {
+        wal_mgr_->Discard(target_table_name, lsn);
+    }
 
     return status;
 }
 
 Status
-DBImpl::CreateIndex(const std::string& table_id, const TableIndex& index) {
+DBImpl::BulkLoad(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) {
     if (!initialized_.load(std::memory_order_acquire)) {
         return SHUTDOWN_ERROR;
     }
 
-    // serialize memory data
-    std::set<std::string> sync_table_ids;
-    auto status = SyncMemData(sync_table_ids);
-
-    {
-        std::unique_lock<std::mutex> lock(build_index_mutex_);
-
-        // step 1: check index difference
-        TableIndex old_index;
-        status = DescribeIndex(table_id, old_index);
+    Status status;
+    std::string target_table_name = table_id;
+    if (!partition_tag.empty()) {
+        status = meta_ptr_->GetPartitionName(table_id, partition_tag, target_table_name);
         if (!status.ok()) {
-            ENGINE_LOG_ERROR << "Failed to get table index info for table: " << table_id;
+            ENGINE_LOG_ERROR << status.message();
             return status;
         }
+    }
 
-        // step 2: update index info
-        TableIndex new_index = index;
-        new_index.metric_type_ = old_index.metric_type_;  // dont change metric type, it was defined by CreateTable
-        if (!utils::IsSameIndex(old_index, new_index)) {
-            status = UpdateTableIndexRecursively(table_id, new_index);
-            if (!status.ok()) {
-                return status;
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = target_table_name;
+    status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    milvus::server::CollectInsertMetrics metrics(vectors.vector_count_, status);
+    if (vectors.id_array_.empty()) {
+        id_generator_->GetNextIDNumbers(vectors.vector_count_, vectors.id_array_);
+    }
+
+    // each file is filled up to index_file_size, so that no merge is needed before building index
+    bool is_binary = !vectors.binary_data_.empty();
+    uint64_t single_vector_size = is_binary ? table_schema.dimension_ / 8 : table_schema.dimension_ * sizeof(float);
+    single_vector_size = std::max<uint64_t>(1, single_vector_size);
+    uint64_t segment_rows = std::max<uint64_t>(1, table_schema.index_file_size_ / single_vector_size);
+
+    meta::TableFilesSchema files;
+    for (uint64_t offset = 0; offset < vectors.vector_count_; offset += segment_rows) {
+        meta::TableFileSchema file_schema;
+        file_schema.table_id_ = target_table_name;
+        status = meta_ptr_->CreateTableFile(file_schema);
+        if (!status.ok()) {
+            break;
+        }
+        files.push_back(file_schema);
+    }
+
+    // files are serialized in parallel, and registered to meta in one batch
+    if (status.ok()) {
+        TimeRecorderAuto rc("Bulk load " + std::to_string(vectors.vector_count_) + " vectors into " +
+                            std::to_string(files.size()) + " files");
+        uint64_t thread_num = std::min<uint64_t>(files.size(), std::thread::hardware_concurrency());
+        thread_num = std::max<uint64_t>(1, thread_num);
+        ThreadPool pool(thread_num, files.size());
+        std::vector<std::future<Status>> results;
+        for (size_t i = 0; i < files.size(); ++i) {
+            uint64_t offset = i * segment_rows;
+            uint64_t count = std::min(segment_rows, vectors.vector_count_ - offset);
+            results.emplace_back(pool.enqueue(&DBImpl::SerializeBulkFile, this, std::ref(files[i]),
+                                              std::cref(vectors), offset, count));
+        }
+        for (auto& result : results) {
+            auto file_status = result.get();
+            if (!file_status.ok()) {
+                status = file_status;
             }
         }
     }
 
-    // step 3: let merge file thread finish
-    // to avoid duplicate data bug
-    WaitMergeFileFinish();
+    if (status.ok()) {
+        status = meta_ptr_->UpdateTableFiles(files);
+    }
 
-    // step 4: wait and build index
-    status = index_failed_checker_.CleanFailedIndexFileOfTable(table_id);
-    status = BuildTableIndexRecursively(table_id, index);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to bulk load vectors: " << status.message();
+        for (auto& file : files) {
+            file.file_type_ = meta::TableFileSchema::TO_DELETE;
+        }
+        meta_ptr_->UpdateTableFiles(files);
+    }
 
     return status;
 }
 
 Status
-DBImpl::DescribeIndex(const std::string& table_id, TableIndex& index) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
-    }
+DBImpl::SerializeBulkFile(meta::TableFileSchema& file_schema, const VectorsData& vectors, uint64_t offset,
+                          uint64_t count) {
+    try {
+        ExecutionEnginePtr engine =
+            EngineFactory::Build(file_schema.dimension_, file_schema.location_, (EngineType)file_schema.engine_type_,
+                                 (MetricType)file_schema.metric_type_, file_schema.nlist_);
+        engine->Reserve(count);
+
+        Status status;
+        const IDNumber* ids = vectors.id_array_.data() + offset;
+        if (!vectors.float_data_.empty()) {
+            status = engine->AddWithIds(count, vectors.float_data_.data() + offset * file_schema.dimension_, ids);
+        } else {
+            status = engine->AddWithIds(count, vectors.binary_data_.data() + offset * file_schema.dimension_ / 8, ids);
+        }
+        if (!status.ok()) {
+            return status;
+        }
 
-    return meta_ptr_->DescribeTableIndex(table_id, index);
-}
+        status = engine->Serialize();
+        if (!status.ok()) {
+            return status;
+        }
 
-Status
-DBImpl::DropIndex(const std::string& table_id) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
-    }
+        if (!vectors.attrs_.empty()) {
+            SegmentAttrs attrs;
+            attrs.Append(ids, count, vectors.attrs_, offset);
+            status = attrs.Write(file_schema.location_);
+            if (!status.ok()) {
+                return status;
+            }
+        }
 
-    ENGINE_LOG_DEBUG << "Drop index for table: " << table_id;
-    return DropTableIndexRecursively(table_id);
-}
+        SegmentTimeRange time_range;
+        time_range.Extend(utils::GetMicroSecTimeStamp());
+        status = time_range.Write(file_schema.location_);
+        if (!status.ok()) {
+            return status;
+        }
 
-Status
-DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
-              const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-              ResultIds& result_ids, ResultDistances& result_distances) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
+        file_schema.file_size_ = engine->PhysicalSize();
+        file_schema.row_count_ = engine->Count();
+        if (file_schema.engine_type_ != (int)EngineType::FAISS_IDMAP &&
+            file_schema.engine_type_ != (int)EngineType::FAISS_BIN_IDMAP &&
+            file_schema.file_size_ >= file_schema.index_file_size_) {
+            file_schema.file_type_ = meta::TableFileSchema::TO_INDEX;
+        } else {
+            file_schema.file_type_ = meta::TableFileSchema::RAW;
+        }
+    } catch (std::exception& ex) {
+        std::string msg = "Failed to serialize bulk file " + file_schema.file_id_ + ": " + ex.what();
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
     }
 
-    meta::DatesT dates = {utils::GetDate()};
-    Status result = Query(context, table_id, partition_tags, k, nprobe, vectors, dates, result_ids, result_distances);
-    return result;
+    return Status::OK();
 }
 
 Status
-DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
-              const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-              const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) {
-    auto query_ctx = context->Child("Query");
-
+DBImpl::DeleteByID(const std::string& table_id, const IDNumbers& vector_ids) {
     if (!initialized_.load(std::memory_order_acquire)) {
         return SHUTDOWN_ERROR;
     }
 
-    ENGINE_LOG_DEBUG << "Query by dates for table: " << table_id << " date range count: " << dates.size();
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+    if (vector_ids.empty()) {
+        return Status::OK();
+    }
+
+    // buffered vectors are written to files first, they are deleted from there
+    status = Flush({table_id});
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<std::string> table_ids = {table_id};
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    for (auto& schema : partition_array) {
+        table_ids.push_back(schema.table_id_);
+    }
+
+    std::unordered_set<IDNumber> id_set(vector_ids.begin(), vector_ids.end());
+    std::vector<int> file_types = {meta::TableFileSchema::RAW, meta::TableFileSchema::TO_INDEX,
+                                   meta::TableFileSchema::INDEX, meta::TableFileSchema::BACKUP,
+                                   meta::TableFileSchema::ARCHIVE};
+    auto list_files = [&](meta::TableFilesSchema& files) -> Status {
+        files.clear();
+        for (auto& id : table_ids) {
+            meta::TableFilesSchema table_files;
+            auto status = meta_ptr_->FilesByType(id, file_types, table_files);
+            if (!status.ok()) {
+                return status;
+            }
+            for (auto& file : table_files) {
+                utils::GetTableFilePath(options_.meta_, file);
+                files.push_back(file);
+            }
+        }
+        return Status::OK();
+    };
+
+    // ids to delete which may be in the file, those out of its id range aren't
+    auto file_vector_ids = [&](const meta::TableFileSchema& file) {
+        IDNumbers ids = vector_ids;
+        if (auto summary = SegmentSummaryMgr::GetInstance().GetSummary(file.location_)) {
+            ids.erase(std::remove_if(ids.begin(), ids.end(), [&](IDNumber id) { return !summary->MayContain(id); }),
+                      ids.end());
+        }
+        return ids;
+    };
+
+    // only the vectors found in a raw file count in its deleted part, its raw ids are read for them
+    auto raw_deleted_ids = [&](const meta::TableFileSchema& file, std::vector<int64_t>& deleted_ids) -> Status {
+        auto engine = EngineFactory::Build(table_schema.dimension_, file.location_, (EngineType)file.engine_type_,
+                                           (MetricType)table_schema.metric_type_, table_schema.nlist_);
+        std::vector<int64_t> file_ids;
+        auto status = engine->Load(false);
+        if (status.ok()) {
+            status = engine->GetRawIds(file_ids);
+        }
+        for (auto file_id : file_ids) {
+            if (id_set.find(file_id) != id_set.end()) {
+                deleted_ids.push_back(file_id);
+            }
+        }
+        return status;
+    };
+
+    // raw files are read before the delete lock is taken, so deletes don't wait for each other's disk reads, a
+    // file is never changed in place, what is read of it holds as long as it is listed
+    auto is_raw = [](const meta::TableFileSchema& file) {
+        return file.file_type_ != meta::TableFileSchema::INDEX && file.file_type_ != meta::TableFileSchema::ARCHIVE;
+    };
+    meta::TableFilesSchema files;
+    status = list_files(files);
+    if (!status.ok()) {
+        return status;
+    }
+    std::unordered_map<std::string, std::vector<int64_t>> raw_deleted;
+    for (auto& file : files) {
+        if (!is_raw(file) || file_vector_ids(file).empty()) {
+            continue;
+        }
+        std::vector<int64_t> deleted_ids;
+        if (raw_deleted_ids(file, deleted_ids).ok()) {
+            raw_deleted[file.location_] = std::move(deleted_ids);
+        }
+    }
+
+    // files merged or built meanwhile are listed again under the lock, only new raw files are read then
+    auto& tombstone_mgr = SegmentTombstoneMgr::GetInstance();
+    std::lock_guard<std::mutex> lock(tombstone_mgr.DeleteMutex());
+    status = list_files(files);
+    if (!status.ok()) {
+        return status;
+    }
+    for (auto& file : files) {
+        auto ids = file_vector_ids(file);
+        if (ids.empty()) {
+            continue;
+        }
+
+        if (!is_raw(file)) {
+            // an index keeps no raw ids to look the vectors up, all of them are deleted from it
+            status = tombstone_mgr.Delete(file.location_, ids);
+        } else {
+            std::vector<int64_t> deleted_ids;
+            auto iter = raw_deleted.find(file.location_);
+            if (iter != raw_deleted.end()) {
+                deleted_ids = std::move(iter->second);
+            } else {
+                status = raw_deleted_ids(file, deleted_ids);
+            }
+            if (status.ok() && !deleted_ids.empty()) {
+                status = tombstone_mgr.Delete(file.location_, deleted_ids);
+            }
+        }
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to delete vectors from file " << file.file_id_ << ": " << status.message();
+            return status;
+        }
+    }
+
+    ENGINE_LOG_DEBUG << "Delete " << vector_ids.size() << " vectors from table " << table_id;
+    return Status::OK();
+}
+
+Status
+DBImpl::GetVectorByID(const std::string& table_id, const IDNumber& vector_id, VectorsData& vector) {
+    vector.vector_count_ = 0;
+    vector.float_data_.clear();
+    vector.binary_data_.clear();
+    vector.id_array_.clear();
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // buffered vectors are written to files first, they are read from there
+    status = Flush({table_id});
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<std::string> table_ids = {table_id};
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    for (auto& schema : partition_array) {
+        table_ids.push_back(schema.table_id_);
+    }
+
+    // an index file is built from a raw file kept as backup, the raw vectors are read from that one
+    std::vector<int> file_types = {meta::TableFileSchema::RAW, meta::TableFileSchema::TO_INDEX,
+                                   meta::TableFileSchema::BACKUP};
+    bool is_binary = server::ValidationUtil::IsBinaryMetricType(table_schema.metric_type_);
+    for (auto& id : table_ids) {
+        meta::TableFilesSchema files;
+        status = meta_ptr_->FilesByType(id, file_types, files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        for (auto& file : files) {
+            utils::GetTableFilePath(options_.meta_, file);
+            auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(file.location_);
+            if (tombstone != nullptr && tombstone->IsDeleted(vector_id)) {
+                continue;
+            }
+            auto summary = SegmentSummaryMgr::GetInstance().GetSummary(file.location_);
+            if (summary != nullptr && !summary->MayContain(vector_id)) {
+                continue;
+            }
+
+            ExecutionEnginePtr engine = nullptr;
+            auto load_engine = [&]() -> Status {
+                engine = EngineFactory::Build(table_schema.dimension_, file.location_, (EngineType)file.engine_type_,
+                                              (MetricType)table_schema.metric_type_, table_schema.nlist_);
+                return engine->Load(false);
+            };
+
+            // a file written before id indexes has one built at its first lookup
+            auto id_index = SegmentIdIndexMgr::GetInstance().GetIdIndex(file.location_);
+            if (id_index == nullptr) {
+                std::vector<int64_t> file_ids;
+                status = load_engine();
+                if (status.ok()) {
+                    status = engine->GetRawIds(file_ids);
+                }
+                if (!status.ok()) {
+                    ENGINE_LOG_WARNING << "Failed to read ids of file " << file.file_id_ << ": " << status.message();
+                    continue;
+                }
+                if (file_ids.empty()) {
+                    continue;
+                }
+
+                id_index = std::make_shared<SegmentIdIndex>();
+                status = SegmentIdIndex::Build(file_ids.data(), file_ids.size(), *id_index);
+                if (!status.ok()) {
+                    return status;
+                }
+                if (!id_index->Write(file.location_).ok()) {
+                    ENGINE_LOG_WARNING << "Failed to write segment id index of " << file.location_;
+                }
+                SegmentIdIndexMgr::GetInstance().PutIdIndex(file.location_, id_index);
+            }
+
+            auto offset = id_index->Find(vector_id);
+            if (offset < 0) {
+                continue;
+            }
+            if (engine == nullptr) {
+                status = load_engine();
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+
+            if (is_binary) {
+                vector.binary_data_.resize(table_schema.dimension_ / 8);
+                status = engine->GetRawVector(offset, vector.binary_data_.data());
+            } else {
+                vector.float_data_.resize(table_schema.dimension_);
+                status = engine->GetRawVector(offset, vector.float_data_.data());
+            }
+            if (!status.ok()) {
+                vector.float_data_.clear();
+                vector.binary_data_.clear();
+                return status;
+            }
+            vector.vector_count_ = 1;
+            vector.id_array_.push_back(vector_id);
+            return Status::OK();
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::CreateIndex(const std::string& table_id, const TableIndex& index) {
+    auto status = CreateIndexAsync(table_id, index);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // step 4: let merge file thread finish
+    // to avoid duplicate data bug
+    WaitMergeFileFinish();
+
+    // step 5: wait and build index
+    status = BuildTableIndexRecursively(table_id, index);
+    if (index.engine_type_ != (int)EngineType::FAISS_IDMAP) {
+        FinishIndexProgress(table_id, status);
+    }
+
+    return status;
+}
+
+Status
+DBImpl::CreateIndexAsync(const std::string& table_id, const TableIndex& index) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    // serialize memory data
+    std::set<std::string> sync_table_ids;
+    auto status = SyncMemData(sync_table_ids);
+
+    {
+        std::unique_lock<std::mutex> lock(build_index_mutex_);
+
+        // step 1: check index difference
+        TableIndex old_index;
+        status = DescribeIndex(table_id, old_index);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to get table index info for table: " << table_id;
+            return status;
+        }
+
+        // step 2: update index info
+        TableIndex new_index = index;
+        new_index.metric_type_ = old_index.metric_type_;  // dont change metric type, it was defined by CreateTable
+        if (!utils::IsSameIndex(old_index, new_index)) {
+            if (IsReplaceableIndex(old_index, new_index) && CanReplaceIndexRecursively(table_id, new_index)) {
+                status = ReplaceTableIndexRecursively(table_id, new_index);
+            } else {
+                status = UpdateTableIndexRecursively(table_id, new_index);
+            }
+            if (!status.ok()) {
+                return status;
+            }
+        }
+
+        // step 3: mark the creation in meta, background build goes on with it until all files are built
+        if (index.engine_type_ != (int)EngineType::FAISS_IDMAP) {
+            status = SetIndexPending(table_id, true);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+    }
+
+    index_failed_checker_.CleanFailedIndexFileOfTable(table_id);
+    if (index.engine_type_ != (int)EngineType::FAISS_IDMAP) {
+        StartIndexProgress(table_id);
+        StartBuildIndexTask(true);
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::GetIndexProgress(std::string& result) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    std::map<std::string, IndexProgress> progresses;
+    {
+        std::lock_guard<std::mutex> lock(index_progress_mutex_);
+        progresses = index_progresses_;
+    }
+
+    result.clear();
+    auto now = std::chrono::steady_clock::now();
+    for (auto& pair : progresses) {
+        auto& progress = pair.second;
+        uint64_t indexed_rows = 0, rows_to_build = 0, files_to_build = 0;
+        auto status = CountIndexRowsRecursively(pair.first, indexed_rows, rows_to_build, files_to_build);
+        if (!status.ok()) {
+            continue;  // dropped table
+        }
+
+        uint64_t total_rows = indexed_rows + rows_to_build;
+        double percent = (total_rows == 0) ? 100.0 : 100.0 * indexed_rows / total_rows;
+        double seconds = std::chrono::duration<double>(now - progress.start_time_).count();
+        double built_rows = (indexed_rows > progress.start_indexed_rows_)
+                                ? static_cast<double>(indexed_rows - progress.start_indexed_rows_)
+                                : 0.0;
+        double rate = (seconds > 0) ? built_rows / seconds : 0.0;
+
+        std::string line = pair.first + ": " + std::to_string(indexed_rows) + "/" + std::to_string(total_rows) +
+                           " rows, " + std::to_string(static_cast<int64_t>(percent)) + "%, " +
+                           std::to_string(static_cast<int64_t>(rate)) + " rows/s, ";
+        if (progress.finished_) {
+            line += progress.error_.empty() ? "finished" : "failed: " + progress.error_;
+        } else {
+            line += "eta ";
+            line += (rate > 0) ? std::to_string(static_cast<int64_t>(rows_to_build / rate)) + "s" : "unknown";
+            line += ", building";
+        }
+        result += line + "\n";
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::GetIndexRowCount(const std::string& table_id, uint64_t& indexed_rows, uint64_t& total_rows) {
+    indexed_rows = 0;
+    total_rows = 0;
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    uint64_t rows_to_build = 0, files_to_build = 0;
+    auto status = CountIndexRowsRecursively(table_id, indexed_rows, rows_to_build, files_to_build);
+    if (!status.ok()) {
+        return status;
+    }
+
+    total_rows = indexed_rows + rows_to_build;
+    return Status::OK();
+}
+
+Status
+DBImpl::AdviseIndex(const std::string& table_id, double target_recall, int64_t topk, IndexAdvice& advice) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+    if (server::ValidationUtil::IsBinaryMetricType(table_schema.metric_type_)) {
+        return Status(DB_ERROR, "Index advice is only supported by float vectors");
+    }
+
+    // buffered vectors are written to files first, they are sampled from there
+    status = Flush({table_id});
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<std::string> table_ids = {table_id};
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    for (auto& schema : partition_array) {
+        table_ids.push_back(schema.table_id_);
+    }
+
+    // vectors are sampled from raw files, an index file is built from a raw file kept as backup
+    std::vector<int> file_types = {meta::TableFileSchema::RAW, meta::TableFileSchema::TO_INDEX,
+                                   meta::TableFileSchema::BACKUP};
+    meta::TableFilesSchema files;
+    int64_t total_rows = 0;
+    for (auto& id : table_ids) {
+        meta::TableFilesSchema table_files;
+        status = meta_ptr_->FilesByType(id, file_types, table_files);
+        if (!status.ok()) {
+            return status;
+        }
+        for (auto& file : table_files) {
+            total_rows += file.row_count_;
+            files.push_back(file);
+        }
+    }
+    if (total_rows <= 0) {
+        return Status(DB_ERROR, "No raw vectors of table " + table_id + " to sample");
+    }
+
+    // files are picked at random until they hold rows enough for the sample, the others are never loaded
+    std::shuffle(files.begin(), files.end(), std::mt19937(std::random_device()()));
+    int64_t sample_file_rows = 0;
+    size_t sample_file_count = 0;
+    while (sample_file_count < files.size() && sample_file_rows < ADVISE_SAMPLE_ROWS) {
+        sample_file_rows += files[sample_file_count++].row_count_;
+    }
+    files.resize(sample_file_count);
+
+    // each picked file gives its share of the sample, picked evenly over its rows
+    int64_t dimension = table_schema.dimension_;
+    std::vector<float> samples;
+    samples.reserve(std::min(sample_file_rows, ADVISE_SAMPLE_ROWS) * dimension);
+    for (auto& file : files) {
+        int64_t quota = (file.row_count_ * ADVISE_SAMPLE_ROWS + sample_file_rows - 1) / sample_file_rows;
+        if (quota <= 0) {
+            continue;
+        }
+        utils::GetTableFilePath(options_.meta_, file);
+        auto engine = EngineFactory::Build(dimension, file.location_, (EngineType)file.engine_type_,
+                                           (MetricType)table_schema.metric_type_, table_schema.nlist_);
+        status = engine->Load(false);
+        if (!status.ok()) {
+            ENGINE_LOG_WARNING << "Failed to sample file " << file.file_id_ << ": " << status.message();
+            continue;
+        }
+        int64_t count = engine->Count();
+        quota = std::min(quota, count);
+        for (int64_t i = 0; i < quota; i++) {
+            samples.resize(samples.size() + dimension);
+            status = engine->GetRawVector(i * count / quota, samples.data() + samples.size() - dimension);
+            if (!status.ok()) {
+                samples.resize(samples.size() - dimension);
+                break;
+            }
+        }
+    }
+
+    // a segment holds the rows of an index file size, or all of them in a smaller table
+    int64_t segment_rows = table_schema.index_file_size_ / (dimension * sizeof(float));
+    segment_rows = std::max<int64_t>(1, std::min(segment_rows, total_rows));
+    IndexAdvisor advisor(dimension, (MetricType)table_schema.metric_type_, segment_rows);
+    return advisor.Advise(samples, target_recall, topk, advice);
+}
+
+Status
+DBImpl::DescribeIndex(const std::string& table_id, TableIndex& index) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    return meta_ptr_->DescribeTableIndex(table_id, index);
+}
+
+Status
+DBImpl::DropIndex(const std::string& table_id) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    ENGINE_LOG_DEBUG << "Drop index for table: " << table_id;
+    {
+        std::lock_guard<std::mutex> lock(index_progress_mutex_);
+        index_progresses_.erase(table_id);
+    }
+    return DropTableIndexRecursively(table_id);
+}
+
+Status
+DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+              const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
+              ResultIds& result_ids, ResultDistances& result_distances) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::DatesT dates = {utils::GetDate()};
+    Status result = Query(context, table_id, partition_tags, k, nprobe, vectors, dates, result_ids, result_distances);
+    return result;
+}
+
+Status
+DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+              const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
+              const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) {
+    auto query_ctx = context->Child("Query");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    ENGINE_LOG_DEBUG << "Query by dates for table: " << table_id << " date range count: " << dates.size();
+
+    // files listed from now on are not deleted under the search, whatever merge soft-deletes them
+    OngoingFileChecker::SearchEpoch search_epoch(ongoing_files_checker_);
+
+    auto meta_metrics = std::make_shared<server::CollectSearchPhaseMetrics>("meta", table_id, 0);
 
     Status status;
+    std::set<std::string> search_table_ids;
+    if (partition_tags.empty()) {
+        // no partition tag specified, means search in whole table
+        // get all table files from parent table
+        search_table_ids.insert(table_id);
+
+        std::vector<meta::TableSchema> partition_array;
+        status = meta_ptr_->ShowPartitions(table_id, partition_array);
+        for (auto& schema : partition_array) {
+            search_table_ids.insert(schema.table_id_);
+        }
+    } else {
+        // get files from specified partitions
+        GetPartitionsByTags(table_id, partition_tags, search_table_ids);
+    }
+
+    // vectors in insert buffer are snapshotted before table files, so that a file under serialization
+    // is found either in memory or in meta
+    std::vector<MemTableFilePtr> mem_table_files;
+    mem_mgr_->GetMemTableFiles(search_table_ids, mem_table_files);
+
+    // files of all partitions are collected by one meta query, instead of one per partition
+    meta::TableFilesSchema files_array;
+    status = GetFilesToSearch(search_table_ids, dates, files_array);
+    PruneFilesByTime(vectors.time_ranges_, files_array);
+    if (!files_array.empty()) {
+        meta_metrics->SetIndexType(files_array.front().engine_type_);
+    }
+    meta_metrics = nullptr;
+    if (!status.ok() && partition_tags.empty()) {
+        return status;
+    }
+
+    // an identical query on unchanged files is answered by result cache without scheduling any search task,
+    // buffered vectors are not tracked by meta, so the cache is bypassed while there is any
+    auto result_cache = cache::ResultCacheMgr::GetInstance();
+    std::string signature;
+    if (result_cache->Enabled() && mem_table_files.empty()) {
+        signature = GenQuerySignature(table_id, files_array, k, nprobe, vectors);
+        if (result_cache->GetResult(signature, result_ids, result_distances)) {
+            ENGINE_LOG_DEBUG << "Query result of table " << table_id << " is found in result cache";
+            query_ctx->GetTraceContext()->GetSpan()->Finish();
+            return Status::OK();
+        }
+    }
+
+    // a degraded result is not cached, it would be returned even after the load is gone
+    uint64_t search_nprobe =
+        SearchEffortController::GetInstance().AdjustNprobe(table_id, vectors.vector_count_, nprobe);
+
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+    status = QueryAsync(query_ctx, table_id, files_array, k, search_nprobe, vectors, result_ids, result_distances);
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+
+    if (status.ok()) {
+        status = QueryMemTableFiles(query_ctx, mem_table_files, files_array, dates, k, vectors, result_ids,
+                                    result_distances);
+    }
+
+    if (status.ok() && !signature.empty() && search_nprobe == nprobe) {
+        result_cache->InsertResult(signature, result_ids, result_distances);
+    }
+
+    query_ctx->GetTraceContext()->GetSpan()->Finish();
+
+    return status;
+}
+
+Status
+DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                      const std::vector<std::string>& file_ids, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
+                      const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) {
+    auto query_ctx = context->Child("Query by file id");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    ENGINE_LOG_DEBUG << "Query by file ids for table: " << table_id << " date range count: " << dates.size();
+
+    OngoingFileChecker::SearchEpoch search_epoch(ongoing_files_checker_);
+
+    // get specified files
     std::vector<size_t> ids;
+    for (auto& id : file_ids) {
+        meta::TableFileSchema table_file;
+        table_file.table_id_ = table_id;
+        std::string::size_type sz;
+        ids.push_back(std::stoul(id, &sz));
+    }
+
+    meta::TableFilesSchema files_array;
+    auto status = GetFilesToSearch(table_id, ids, dates, files_array);
+    if (!status.ok()) {
+        return status;
+    }
+
+    fiu_do_on("DBImpl.QueryByFileID.empty_files_array", files_array.clear());
+    if (files_array.empty()) {
+        return Status(DB_ERROR, "Invalid file id");
+    }
+    PruneFilesByTime(vectors.time_ranges_, files_array);
+
+    uint64_t search_nprobe =
+        SearchEffortController::GetInstance().AdjustNprobe(table_id, vectors.vector_count_, nprobe);
+
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+    status = QueryAsync(query_ctx, table_id, files_array, k, search_nprobe, vectors, result_ids, result_distances);
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+
+    query_ctx->GetTraceContext()->GetSpan()->Finish();
+
+    return status;
+}
+
+Status
+DBImpl::QueryByRange(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                     const std::vector<std::string>& partition_tags, float radius, uint64_t max_results,
+                     uint64_t nprobe, const VectorsData& vectors, const meta::DatesT& dates, ResultIds& result_ids,
+                     ResultDistances& result_distances) {
+    auto query_ctx = context->Child("Query by range");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+    if (vectors.float_data_.empty()) {
+        return Status(DB_ERROR, "Range search of binary vectors is not supported");
+    }
+
+    ENGINE_LOG_DEBUG << "Query by range for table: " << table_id << " radius: " << radius;
+
+    OngoingFileChecker::SearchEpoch search_epoch(ongoing_files_checker_);
+
+    std::set<std::string> search_table_ids;
+    if (partition_tags.empty()) {
+        search_table_ids.insert(table_id);
+        std::vector<meta::TableSchema> partition_array;
+        status = meta_ptr_->ShowPartitions(table_id, partition_array);
+        for (auto& schema : partition_array) {
+            search_table_ids.insert(schema.table_id_);
+        }
+    } else {
+        GetPartitionsByTags(table_id, partition_tags, search_table_ids);
+    }
+
+    std::vector<MemTableFilePtr> mem_table_files;
+    mem_mgr_->GetMemTableFiles(search_table_ids, mem_table_files);
+
     meta::TableFilesSchema files_array;
+    status = GetFilesToSearch(search_table_ids, dates, files_array);
+    if (!status.ok() && partition_tags.empty()) {
+        return status;
+    }
+    PruneFilesByTime(vectors.time_ranges_, files_array);
+
+    // every file is searched, there is no topk to prune files by summary, and the result isn't cached
+    auto job = std::make_shared<scheduler::SearchJob>(query_ctx, max_results, nprobe, vectors);
+    job->SetRadius(radius);
+    status = RunSearchJob(job, files_array, result_ids, result_distances);
+
+    // the insert buffer is searched by brute force topk, the hits of it within radius are its range result
+    if (status.ok()) {
+        status = QueryMemTableFiles(query_ctx, mem_table_files, files_array, dates, max_results, vectors, result_ids,
+                                    result_distances);
+    }
+    if (status.ok()) {
+        bool ascending = (table_schema.metric_type_ != static_cast<int>(MetricType::IP));
+        DropOutOfRange(radius, ascending, result_ids, result_distances);
+    }
+
+    query_ctx->GetTraceContext()->GetSpan()->Finish();
+
+    return status;
+}
+
+Status
+DBImpl::QueryExact(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                   const std::vector<std::string>& partition_tags, uint64_t k, const VectorsData& vectors,
+                   ResultIds& result_ids, ResultDistances& result_distances) {
+    result_ids.clear();
+    result_distances.clear();
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::set<std::string> search_table_ids;
+    if (partition_tags.empty()) {
+        search_table_ids.insert(table_id);
+        std::vector<meta::TableSchema> partition_array;
+        status = meta_ptr_->ShowPartitions(table_id, partition_array);
+        for (auto& schema : partition_array) {
+            search_table_ids.insert(schema.table_id_);
+        }
+    } else {
+        GetPartitionsByTags(table_id, partition_tags, search_table_ids);
+    }
+
+    OngoingFileChecker::SearchEpoch search_epoch(ongoing_files_checker_);
+    std::vector<MemTableFilePtr> mem_table_files;
+    mem_mgr_->GetMemTableFiles(search_table_ids, mem_table_files);
+
+    // an index file is built from a raw file kept as backup, the raw vectors are searched there
+    std::vector<int> file_types = {meta::TableFileSchema::RAW, meta::TableFileSchema::TO_INDEX,
+                                   meta::TableFileSchema::BACKUP};
+    bool is_binary = server::ValidationUtil::IsBinaryMetricType(table_schema.metric_type_);
+    auto engine_type = is_binary ? EngineType::FAISS_BIN_IDMAP : EngineType::FAISS_IDMAP;
+    bool ascending = (table_schema.metric_type_ != static_cast<int>(MetricType::IP));
+    uint64_t nq = vectors.vector_count_;
+
+    meta::TableFilesSchema searched_files;
+    for (auto& id : search_table_ids) {
+        meta::TableFilesSchema files;
+        status = meta_ptr_->FilesByType(id, file_types, files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        for (auto& file : files) {
+            utils::GetTableFilePath(options_.meta_, file);
+            auto engine = EngineFactory::Build(table_schema.dimension_, file.location_, engine_type,
+                                               (MetricType)table_schema.metric_type_, table_schema.nlist_);
+            status = engine->Load(false);
+            if (!status.ok()) {
+                // a backup file may be removed by a merge since it is listed
+                ENGINE_LOG_WARNING << "Failed to load file " << file.file_id_ << " to search: " << status.message();
+                continue;
+            }
+
+            ResultIds file_ids(nq * k);
+            ResultDistances file_distances(nq * k);
+            if (is_binary) {
+                status = engine->Search(nq, vectors.binary_data_.data(), k, 0, file_distances.data(), file_ids.data(),
+                                        false);
+            } else {
+                status = engine->Search(nq, vectors.float_data_.data(), k, 0, file_distances.data(), file_ids.data(),
+                                        false);
+            }
+            if (!status.ok()) {
+                return status;
+            }
+
+            uint64_t file_k = std::min<uint64_t>(k, engine->Count());
+            if (file_k > 0) {
+                scheduler::XSearchTask::MergeTopkToResultSet(file_ids, file_distances, file_k, nq, k, ascending,
+                                                             result_ids, result_distances);
+            }
+            searched_files.push_back(file);
+        }
+    }
+
+    return QueryMemTableFiles(context, mem_table_files, searched_files, {}, k, vectors, result_ids, result_distances);
+}
+
+Status
+DBImpl::GetSearchFiles(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                       meta::TableFilesSchema& files) {
+    files.clear();
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
 
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::set<std::string> search_table_ids;
     if (partition_tags.empty()) {
-        // no partition tag specified, means search in whole table
-        // get all table files from parent table
-        status = GetFilesToSearch(table_id, ids, dates, files_array);
+        search_table_ids.insert(table_id);
+        std::vector<meta::TableSchema> partition_array;
+        status = meta_ptr_->ShowPartitions(table_id, partition_array);
+        for (auto& schema : partition_array) {
+            search_table_ids.insert(schema.table_id_);
+        }
+    } else {
+        GetPartitionsByTags(table_id, partition_tags, search_table_ids);
+    }
+    if (search_table_ids.empty()) {
+        return Status::OK();
+    }
+
+    // same date as Query, so the files are exactly those a Search of the table runs on
+    meta::DatesT dates = {utils::GetDate()};
+    return GetFilesToSearch(search_table_ids, dates, files);
+}
+
+Status
+DBImpl::ApplyMetaChanges(const std::vector<meta::MetaChange>& changes, bool complete) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    auto snapshot_meta = std::dynamic_pointer_cast<meta::SnapshotMetaImpl>(meta_ptr_);
+    if (!complete) {
+        if (snapshot_meta != nullptr) {
+            snapshot_meta->Refresh("");
+        }
+        return Status::OK();
+    }
+
+    // step 1: searches see the files of the writable node from now on, files replaced are dropped from cache
+    auto cache = cache::CpuCacheMgr::GetInstance();
+    std::map<std::string, std::vector<size_t>> added_files;
+    for (auto& change : changes) {
+        if (snapshot_meta != nullptr) {
+            snapshot_meta->Refresh(change.table_id_);
+        }
+        for (auto& location : change.removed_) {
+            cache->EraseItem(location);
+        }
+        if (!change.added_.empty()) {
+            auto& ids = added_files[change.table_id_];
+            ids.insert(ids.end(), change.added_.begin(), change.added_.end());
+        }
+    }
+
+    // step 2: new files owned by this node are loaded while cache has room, they never evict others
+    for (auto& table_files : added_files) {
+        meta::TableFilesSchema files;
+        auto status = meta_ptr_->GetTableFiles(table_files.first, table_files.second, files);
+        if (!status.ok()) {
+            // e.g. the table is dropped meanwhile
+            continue;
+        }
+
+        for (auto& file : files) {
+            if (!initialized_.load(std::memory_order_acquire)) {
+                return Status::OK();
+            }
+            if ((file.file_type_ != meta::TableFileSchema::RAW && file.file_type_ != meta::TableFileSchema::TO_INDEX &&
+                 file.file_type_ != meta::TableFileSchema::INDEX &&
+                 file.file_type_ != meta::TableFileSchema::ARCHIVE) ||
+                !SegmentOwnership::GetInstance().Owns(file.id_) || cache->ItemExists(file.location_) ||
+                cache->CacheUsage() + static_cast<int64_t>(file.file_size_) > cache->CacheCapacity()) {
+                continue;
+            }
+
+            ExecutionEnginePtr engine = EngineFactory::Build(file.dimension_, file.location_,
+                                                             (EngineType)file.engine_type_,
+                                                             (MetricType)file.metric_type_, file.nlist_);
+            if (engine == nullptr) {
+                continue;
+            }
+            status = engine->Load(true);
+            if (!status.ok()) {
+                ENGINE_LOG_WARNING << "Failed to load new file " << file.file_id_ << ": " << status.message();
+            }
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::Size(uint64_t& result) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    return meta_ptr_->Size(result);
+}
+
+Status
+DBImpl::Flush(const std::vector<std::string>& table_ids) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    std::set<std::string> sync_table_ids;
+    if (table_ids.empty()) {
+        return SyncMemData(sync_table_ids);
+    }
+
+    std::set<std::string> target_table_ids;
+    for (auto& table_id : table_ids) {
+        meta::TableSchema table_schema;
+        table_schema.table_id_ = table_id;
+        auto status = meta_ptr_->DescribeTable(table_schema);
         if (!status.ok()) {
             return status;
         }
+        target_table_ids.insert(table_id);
 
         std::vector<meta::TableSchema> partition_array;
         status = meta_ptr_->ShowPartitions(table_id, partition_array);
         for (auto& schema : partition_array) {
-            status = GetFilesToSearch(schema.table_id_, ids, dates, files_array);
+            target_table_ids.insert(schema.table_id_);
+        }
+    }
+
+    return SyncMemData(target_table_ids, sync_table_ids);
+}
+
+Status
+DBImpl::ExportTable(const std::string& table_id, const std::string& path) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+    if (!table_schema.owner_table_.empty()) {
+        return Status(DB_ERROR, "A partition is exported along with its table: " + table_schema.owner_table_);
+    }
+    if (boost::filesystem::exists(path + "/" + EXPORT_META_FILE)) {
+        return Status(DB_ERROR, "Path already holds an export: " + path);
+    }
+    status = server::CommonUtil::CreateDirectory(path);
+    if (!status.ok()) {
+        return status;
+    }
+
+    status = Flush({table_id});
+    if (!status.ok()) {
+        return status;
+    }
+
+    TableIndex index;
+    status = DescribeIndex(table_id, index);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // a file soft deleted while the export runs stays on disk until the export is done
+    OngoingFileChecker::SearchEpoch search_epoch(ongoing_files_checker_);
+    std::vector<std::pair<std::string, std::string>> tags = {{table_id, ""}};
+    for (auto& schema : partition_array) {
+        tags.emplace_back(schema.table_id_, schema.partition_tag_);
+    }
+
+    json dump;
+    dump["table"] = {
+        {"table_id", table_id},
+        {"dimension", table_schema.dimension_},
+        {"index_file_size", table_schema.index_file_size_ / ONE_MB},
+        {"metric_type", table_schema.metric_type_},
+        {"engine_type", index.engine_type_},
+        {"nlist", index.nlist_},
+    };
+    dump["partitions"] = json::array();
+    dump["files"] = json::array();
+    meta::TableFilesSchema files;
+    for (auto& pair : tags) {
+        if (!pair.second.empty()) {
+            dump["partitions"].push_back(pair.second);
         }
-    } else {
-        // get files from specified partitions
-        std::set<std::string> partition_name_array;
-        GetPartitionsByTags(table_id, partition_tags, partition_name_array);
 
-        for (auto& partition_name : partition_name_array) {
-            status = GetFilesToSearch(partition_name, ids, dates, files_array);
+        // the files of a table are listed at once, the files of a merge or a build are switched to at once
+        meta::TableFilesSchema table_files;
+        status = meta_ptr_->FilesByType(pair.first,
+                                        {meta::TableFileSchema::RAW, meta::TableFileSchema::TO_INDEX,
+                                         meta::TableFileSchema::INDEX, meta::TableFileSchema::BACKUP,
+                                         meta::TableFileSchema::ARCHIVE},
+                                        table_files);
+        if (!status.ok()) {
+            return status;
+        }
+        for (auto& file : table_files) {
+            utils::GetTableFilePath(options_.meta_, file);
+            dump["files"].push_back({
+                {"file_id", file.file_id_},
+                {"partition_tag", pair.second},
+                {"file_type", file.file_type_},
+                {"engine_type", file.engine_type_},
+                {"date", file.date_},
+                {"file_size", file.file_size_},
+                {"row_count", file.row_count_},
+            });
+            files.push_back(file);
         }
     }
+    ongoing_files_checker_.MarkOngoingFiles(files);
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(query_ctx, table_id, files_array, k, nprobe, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+    {
+        // the deletes of all files are taken at one moment, later ones are appended to the tombstones in place
+        auto& tombstone_mgr = SegmentTombstoneMgr::GetInstance();
+        std::lock_guard<std::mutex> lock(tombstone_mgr.DeleteMutex());
+        for (auto& file : files) {
+            auto tombstone = tombstone_mgr.GetTombstone(file.location_);
+            // left by an export failed before
+            boost::filesystem::remove(SegmentTombstone::GetTombstonePath(path + "/" + file.file_id_));
+            if (status.ok() && tombstone != nullptr) {
+                status = SegmentTombstone::Append(path + "/" + file.file_id_, tombstone->Ids());
+            }
+        }
+    }
 
-    query_ctx->GetTraceContext()->GetSpan()->Finish();
+    if (status.ok()) {
+        TimeRecorderAuto rc("Export " + std::to_string(files.size()) + " files of table " + table_id);
+        ThreadPool pool(std::max<size_t>(std::min<size_t>(files.size(), EXPORT_THREAD_NUM), 1),
+                        std::max<size_t>(files.size(), 1));
+        std::vector<std::future<Status>> results;
+        for (auto& file : files) {
+            results.emplace_back(pool.enqueue(utils::ExportTableFilePath, file.location_, path + "/" + file.file_id_));
+        }
+        for (auto& result : results) {
+            auto file_status = result.get();
+            if (!file_status.ok()) {
+                status = file_status;
+            }
+        }
+    }
+    ongoing_files_checker_.UnmarkOngoingFiles(files);
 
+    if (status.ok()) {
+        std::ofstream meta_file(path + "/" + EXPORT_META_FILE, std::ios::out | std::ios::trunc);
+        meta_file << dump.dump();
+        if (!meta_file.good()) {
+            status = Status(DB_ERROR, "Failed to write export meta to " + path);
+        }
+    }
     return status;
 }
 
 Status
-DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std::string& table_id,
-                      const std::vector<std::string>& file_ids, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-                      const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) {
-    auto query_ctx = context->Child("Query by file id");
-
+DBImpl::ImportTable(const std::string& path, const std::string& table_id) {
     if (!initialized_.load(std::memory_order_acquire)) {
         return SHUTDOWN_ERROR;
     }
 
-    ENGINE_LOG_DEBUG << "Query by file ids for table: " << table_id << " date range count: " << dates.size();
+    json dump;
+    try {
+        std::ifstream meta_file(path + "/" + EXPORT_META_FILE, std::ios::in);
+        if (!meta_file.is_open()) {
+            return Status(DB_ERROR, "No complete export at " + path);
+        }
+        meta_file >> dump;
+    } catch (std::exception& ex) {
+        return Status(DB_ERROR, "Invalid export meta at " + path + ": " + ex.what());
+    }
+
+    meta::TableSchema table_schema;
+    meta::TableFilesSchema files;
+    std::vector<std::string> export_file_ids;
+    bool table_created = false;
+    // a failed import leaves nothing behind, the table, its partitions and the files registered so far are dropped
+    auto drop_imported = [&](const Status& status) {
+        if (table_created) {
+            auto drop_status = DropTable(table_schema.table_id_, meta::DatesT());
+            if (!drop_status.ok()) {
+                ENGINE_LOG_ERROR << "Failed to drop table " << table_schema.table_id_
+                                 << " of failed import: " << drop_status.message();
+            }
+        }
+        return status;
+    };
+    try {
+        auto& table = dump["table"];
+        table_schema.table_id_ = table_id.empty() ? table["table_id"].get<std::string>() : table_id;
+        table_schema.dimension_ = table["dimension"].get<uint16_t>();
+        table_schema.index_file_size_ = table["index_file_size"].get<int64_t>();
+        table_schema.metric_type_ = table["metric_type"].get<int32_t>();
+        auto status = CreateTable(table_schema);
+        if (!status.ok()) {
+            return status;
+        }
+        table_created = true;
+
+        std::unordered_map<std::string, std::string> tag_tables = {{"", table_schema.table_id_}};
+        for (auto& tag : dump["partitions"]) {
+            status = CreatePartition(table_schema.table_id_, "", tag.get<std::string>());
+            if (status.ok()) {
+                status = meta_ptr_->GetPartitionName(table_schema.table_id_, tag.get<std::string>(),
+                                                     tag_tables[tag.get<std::string>()]);
+            }
+            if (!status.ok()) {
+                return drop_imported(status);
+            }
+        }
 
-    // get specified files
-    std::vector<size_t> ids;
-    for (auto& id : file_ids) {
-        meta::TableFileSchema table_file;
-        table_file.table_id_ = table_id;
-        std::string::size_type sz;
-        ids.push_back(std::stoul(id, &sz));
+        // the files are registered as they were built, with the index they were built with
+        TableIndex index;
+        index.engine_type_ = table["engine_type"].get<int32_t>();
+        index.nlist_ = table["nlist"].get<int32_t>();
+        index.metric_type_ = table_schema.metric_type_;
+        status = ReplaceTableIndexRecursively(table_schema.table_id_, index);
+        if (!status.ok()) {
+            return drop_imported(status);
+        }
+
+        for (auto& export_file : dump["files"]) {
+            meta::TableFileSchema file;
+            file.table_id_ = tag_tables.at(export_file["partition_tag"].get<std::string>());
+            file.date_ = export_file["date"].get<meta::DateT>();
+            file.file_type_ = meta::TableFileSchema::NEW;
+            status = meta_ptr_->CreateTableFile(file);
+            if (!status.ok()) {
+                break;
+            }
+            file.file_type_ = export_file["file_type"].get<int32_t>();
+            file.engine_type_ = export_file["engine_type"].get<int32_t>();
+            file.file_size_ = export_file["file_size"].get<size_t>();
+            file.row_count_ = export_file["row_count"].get<size_t>();
+            files.push_back(file);
+            export_file_ids.push_back(export_file["file_id"].get<std::string>());
+        }
+        if (!status.ok()) {
+            return drop_imported(status);
+        }
+    } catch (std::exception& ex) {
+        return drop_imported(Status(DB_ERROR, "Invalid export meta at " + path + ": " + ex.what()));
+    }
+
+    // an index file names the backup file it was built from, which has a new file id now
+    std::unordered_map<std::string, std::string> file_ids;
+    for (size_t i = 0; i < files.size(); ++i) {
+        file_ids[export_file_ids[i]] = files[i].file_id_;
+    }
+    auto import_file = [&](size_t i) -> Status {
+        auto& file = files[i];
+        std::string export_path = path + "/" + export_file_ids[i];
+        auto status = utils::ImportTableFilePath(export_path, file.location_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // the origin may be a link to the one of the export, it is written anew instead of in place
+        std::string origin_file_id;
+        if (utils::ReadIndexOrigin(export_path, origin_file_id).ok()) {
+            boost::filesystem::remove(utils::GetIndexOriginPath(file.location_));
+            auto iter = file_ids.find(origin_file_id);
+            if (iter != file_ids.end()) {
+                status = utils::WriteIndexOrigin(file.location_, iter->second);
+            }
+        }
+
+        std::vector<int64_t> deleted_ids;
+        if (status.ok() && SegmentTombstone::Read(export_path, deleted_ids).ok() && !deleted_ids.empty()) {
+            status = SegmentTombstone::Append(file.location_, deleted_ids);
+        }
+        return status;
+    };
+
+    Status status;
+    {
+        TimeRecorderAuto rc("Import " + std::to_string(files.size()) + " files of table " + table_schema.table_id_);
+        ThreadPool pool(std::max<size_t>(std::min<size_t>(files.size(), EXPORT_THREAD_NUM), 1),
+                        std::max<size_t>(files.size(), 1));
+        std::vector<std::future<Status>> results;
+        for (size_t i = 0; i < files.size(); ++i) {
+            results.emplace_back(pool.enqueue(import_file, i));
+        }
+        for (auto& result : results) {
+            auto file_status = result.get();
+            if (!file_status.ok()) {
+                status = file_status;
+            }
+        }
+    }
+
+    if (status.ok()) {
+        status = meta_ptr_->UpdateTableFiles(files);
+    }
+    if (!status.ok()) {
+        return drop_imported(status);
+    }
+    return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// internal methods
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Status
+DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                   const meta::TableFilesSchema& files, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
+                   ResultIds& result_ids, ResultDistances& result_distances) {
+    auto query_async_ctx = context->Child("Query Async");
+
+    server::CollectQueryMetrics metrics(vectors.vector_count_);
+
+    TimeRecorder rc("");
+
+    // step 1: split files, the ones likely holding topk are searched first, the others may be pruned later;
+    // the files are kept from clean up by the search epoch of the caller
+    ENGINE_LOG_DEBUG << "Engine query begin, index file count: " << files.size();
+    meta::TableFilesSchema first_files, rest_files;
+    std::vector<std::vector<double>> rest_bounds;
+    SplitFilesBySummary(files, k, vectors, first_files, rest_files, rest_bounds);
+
+    // step 2: search the first files
+    auto status = SearchFiles(query_async_ctx, first_files, k, nprobe, vectors, result_ids, result_distances);
+
+    // step 3: search the rest files whose summary can't prove they miss the topk of every query, the proof holds for
+    // the original vectors, a quantized file may lose a result within its quantization error
+    if (status.ok() && !rest_files.empty()) {
+        bool ascending = (files.front().metric_type_ != static_cast<int>(MetricType::IP));
+        uint64_t nq = vectors.vector_count_;
+        meta::TableFilesSchema search_files;
+        PruneFilesBySummary(rest_files, rest_bounds, k, nq, ascending, result_ids, result_distances, search_files);
+        ENGINE_LOG_DEBUG << "Segment summary prunes " << rest_files.size() - search_files.size() << " of "
+                         << files.size() << " index files";
+
+        ResultIds rest_ids;
+        ResultDistances rest_distances;
+        status = SearchFiles(query_async_ctx, search_files, k, nprobe, vectors, rest_ids, rest_distances);
+        if (status.ok() && !rest_ids.empty()) {
+            size_t rest_k = rest_ids.size() / nq;
+            if (rest_k < k) {
+                // merge expects the source at a stride of k
+                ResultIds ids(nq * k, -1);
+                ResultDistances distances(nq * k, 0.0);
+                for (uint64_t i = 0; i < nq; i++) {
+                    std::copy_n(rest_ids.begin() + i * rest_k, rest_k, ids.begin() + i * k);
+                    std::copy_n(rest_distances.begin() + i * rest_k, rest_k, distances.begin() + i * k);
+                }
+                rest_ids.swap(ids);
+                rest_distances.swap(distances);
+            }
+            scheduler::XSearchTask::MergeTopkToResultSet(rest_ids, rest_distances, rest_k, nq, k, ascending,
+                                                         result_ids, result_distances);
+        }
     }
 
-    meta::TableFilesSchema files_array;
-    auto status = GetFilesToSearch(table_id, ids, dates, files_array);
     if (!status.ok()) {
         return status;
     }
 
-    fiu_do_on("DBImpl.QueryByFileID.empty_files_array", files_array.clear());
-    if (files_array.empty()) {
-        return Status(DB_ERROR, "Invalid file id");
+    double cost = rc.ElapseFromBegin("Engine query totally cost");
+    if (!files.empty()) {
+        SearchEffortController::GetInstance().UpdateCost(table_id, vectors.vector_count_, nprobe, cost);
+        storage::IORateLimiter::GetInstance().ReportSearchLatency(cost);
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(query_ctx, table_id, files_array, k, nprobe, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+    query_async_ctx->GetTraceContext()->GetSpan()->Finish();
 
-    query_ctx->GetTraceContext()->GetSpan()->Finish();
+    return Status::OK();
+}
+
+Status
+DBImpl::QueryMemTableFiles(const std::shared_ptr<server::Context>& context,
+                           const std::vector<MemTableFilePtr>& mem_table_files, const meta::TableFilesSchema& files,
+                           const meta::DatesT& dates, uint64_t k, const VectorsData& vectors, ResultIds& result_ids,
+                           ResultDistances& result_distances) {
+    if (mem_table_files.empty()) {
+        return Status::OK();
+    }
+
+    TimeRecorder rc("Query insert buffer");
+
+    // the file may have been serialized since the snapshot, it is searched as a table file then
+    std::set<size_t> searched_file_ids;
+    for (auto& file : files) {
+        searched_file_ids.insert(file.id_);
+    }
+
+    uint64_t nq = vectors.vector_count_;
+    for (auto& mem_table_file : mem_table_files) {
+        const meta::TableFileSchema& file_schema = mem_table_file->GetTableFileSchema();
+        if (searched_file_ids.find(file_schema.id_) != searched_file_ids.end()) {
+            continue;
+        }
+        if (!dates.empty() && std::find(dates.begin(), dates.end(), file_schema.date_) == dates.end()) {
+            continue;
+        }
+        if (!mem_table_file->GetTimeRange().Overlaps(vectors.time_ranges_)) {
+            continue;
+        }
+
+        ResultIds file_ids;
+        ResultDistances file_distances;
+        size_t file_k = 0;
+        auto status = mem_table_file->Search(vectors, k, file_ids, file_distances, file_k);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // similarity of IP is reduced descending, distances of other metrics ascending
+        bool ascending = (file_schema.metric_type_ != static_cast<int>(MetricType::IP));
+        scheduler::XSearchTask::MergeTopkToResultSet(file_ids, file_distances, file_k, nq, k, ascending, result_ids,
+                                                     result_distances);
+        context->GetQueryCost()->segments_searched_++;
+    }
+
+    double span = rc.ElapseFromBegin("Query insert buffer totally cost");
+    context->GetQueryCost()->cpu_time_us_ += static_cast<int64_t>(span);
+    return Status::OK();
+}
+
+void
+DBImpl::BackgroundTimerTask() {
+    Status status;
+    server::SystemInfo::GetInstance().Init();
+    while (true) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            WaitMergeFileFinish();
+            WaitBuildIndexFinish();
+            WaitCleanUpFinish();
+
+            ENGINE_LOG_DEBUG << "DB background thread exit";
+            break;
+        }
+
+        for (uint64_t i = 0; i < 1000 / FLUSH_CHECK_INTERVAL_MS; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(FLUSH_CHECK_INTERVAL_MS));
+            if (!initialized_.load(std::memory_order_acquire)) {
+                break;
+            }
+            StartFlushTask();
+        }
+
+        StartMetricTask();
+        StartCompactionTask();
+        StartCleanUpTask();
+        StartBuildIndexTask();
+        StartCacheManifestTask();
+    }
+}
+
+void
+DBImpl::StartCacheManifestTask() {
+    static uint64_t manifest_clock_tick = 0;
+    ++manifest_clock_tick;
+    if (manifest_clock_tick % CACHE_MANIFEST_INTERVAL != 0) {
+        return;
+    }
 
-    return status;
+    SaveCacheManifest();
 }
 
 Status
-DBImpl::Size(uint64_t& result) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
+DBImpl::SaveCacheManifest() {
+    auto hot_items = cache::CpuCacheMgr::GetInstance()->HotItems();
+    if (hot_items.empty()) {
+        // keep the last manifest, cache may be not warmed up yet
+        return Status::OK();
     }
 
-    return meta_ptr_->Size(result);
+    // write a temp file and rename it, a crash never leaves a partial manifest
+    std::string manifest_path = options_.meta_.path_ + "/" + CACHE_MANIFEST_FILE;
+    std::string temp_path = manifest_path + ".tmp";
+    std::ofstream fs(temp_path, std::ios::out | std::ios::trunc);
+    for (auto& item : hot_items) {
+        fs << item.second << " " << item.first << "\n";
+    }
+    fs.close();
+
+    if (!fs.good() || std::rename(temp_path.c_str(), manifest_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        std::string msg = "Failed to save cache manifest " + manifest_path;
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+
+    return Status::OK();
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// internal methods
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 Status
-DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, const std::string& table_id,
-                   const meta::TableFilesSchema& files, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-                   ResultIds& result_ids, ResultDistances& result_distances) {
-    auto query_async_ctx = context->Child("Query Async");
+DBImpl::SaveCacheQuotas() {
+    std::string quota_path = options_.meta_.path_ + "/" + CACHE_QUOTA_FILE;
+    std::string temp_path = quota_path + ".tmp";
+    std::ofstream fs(temp_path, std::ios::out | std::ios::trunc);
+    {
+        std::lock_guard<std::mutex> lock(cache_quota_mutex_);
+        for (auto& pair : cache_quotas_) {
+            auto& quota = pair.second;
+            fs << pair.first << " " << quota.reserved << " " << quota.max << " " << quota.pinned << "\n";
+        }
+    }
+    fs.close();
 
-    server::CollectQueryMetrics metrics(vectors.vector_count_);
+    if (!fs.good() || std::rename(temp_path.c_str(), quota_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        std::string msg = "Failed to save cache quota " + quota_path;
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
 
-    TimeRecorder rc("");
+    return Status::OK();
+}
 
-    // step 1: construct search job
-    auto status = ongoing_files_checker_.MarkOngoingFiles(files);
+void
+DBImpl::LoadCacheQuotas() {
+    std::string quota_path = options_.meta_.path_ + "/" + CACHE_QUOTA_FILE;
+    std::ifstream fs(quota_path);
+    std::string table_id;
+    cache::CacheQuota quota;
+    std::lock_guard<std::mutex> lock(cache_quota_mutex_);
+    while (fs >> table_id >> quota.reserved >> quota.max >> quota.pinned) {
+        cache_quotas_[table_id] = quota;
+        cache::CpuCacheMgr::GetInstance()->SetQuota(table_id, quota);
+    }
+}
 
-    ENGINE_LOG_DEBUG << "Engine query begin, index file count: " << files.size();
-    scheduler::SearchJobPtr job = std::make_shared<scheduler::SearchJob>(query_async_ctx, k, nprobe, vectors);
-    for (auto& file : files) {
-        scheduler::TableFileSchemaPtr file_ptr = std::make_shared<meta::TableFileSchema>(file);
-        job->AddIndexFile(file_ptr);
+void
+DBImpl::BackgroundCacheWarmUp() {
+    // locations in manifest are sorted by hit count, hottest first
+    std::string manifest_path = options_.meta_.path_ + "/" + CACHE_MANIFEST_FILE;
+    std::ifstream fs(manifest_path);
+    std::vector<std::string> locations;
+    uint64_t hits = 0;
+    std::string location;
+    while (fs >> hits >> location) {
+        locations.emplace_back(location);
+    }
+    if (locations.empty()) {
+        return;
     }
 
-    // step 2: put search job to scheduler and wait result
-    scheduler::JobMgrInst::GetInstance()->Put(job);
-    job->WaitResult();
+    // only files still to be searched are loaded, partitions are listed as tables
+    std::vector<meta::TableSchema> table_array;
+    auto status = meta_ptr_->AllTables(table_array);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Cache warm up failed to get tables: " << status.message();
+        return;
+    }
 
-    status = ongoing_files_checker_.UnmarkOngoingFiles(files);
-    if (!job->GetStatus().ok()) {
-        return job->GetStatus();
+    std::set<std::string> table_ids;
+    for (auto& table : table_array) {
+        table_ids.insert(table.table_id_);
     }
 
-    // step 3: construct results
-    result_ids = job->GetResultIds();
-    result_distances = job->GetResultDistances();
-    rc.ElapseFromBegin("Engine query totally cost");
+    meta::DatesT dates;
+    meta::TableFilesSchema files_array;
+    GetFilesToSearch(table_ids, dates, files_array);
+    std::unordered_map<std::string, meta::TableFileSchema> files_map;
+    for (auto& file : files_array) {
+        // files owned by other readonly nodes are cached there
+        if (!SegmentOwnership::GetInstance().Owns(file.id_)) {
+            continue;
+        }
+        files_map.insert(std::make_pair(file.location_, file));
+    }
 
-    query_async_ctx->GetTraceContext()->GetSpan()->Finish();
+    int64_t cache_total = cache::CpuCacheMgr::GetInstance()->CacheCapacity();
+    int64_t cache_usage = cache::CpuCacheMgr::GetInstance()->CacheUsage();
+    int64_t available_size = cache_total - cache_usage;
 
-    return Status::OK();
-}
+    TimeRecorderAuto rc("Cache warm up");
+    ThreadPool warmup_pool(CACHE_WARMUP_THREAD_NUM, locations.size());
+    std::vector<std::future<void>> results;
+    int64_t size = 0;
+    for (auto& file_location : locations) {
+        auto iter = files_map.find(file_location);
+        if (iter == files_map.end()) {
+            continue;
+        }
 
-void
-DBImpl::BackgroundTimerTask() {
-    Status status;
-    server::SystemInfo::GetInstance().Init();
-    while (true) {
-        if (!initialized_.load(std::memory_order_acquire)) {
-            WaitMergeFileFinish();
-            WaitBuildIndexFinish();
+        auto& file = iter->second;
+        ExecutionEnginePtr engine = EngineFactory::Build(file.dimension_, file.location_, (EngineType)file.engine_type_,
+                                                         (MetricType)file.metric_type_, file.nlist_);
+        if (engine == nullptr) {
+            continue;
+        }
 
-            ENGINE_LOG_DEBUG << "DB background thread exit";
+        size += engine->PhysicalSize();
+        if (size > available_size) {
             break;
         }
 
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        results.emplace_back(warmup_pool.enqueue([this, engine]() {
+            if (!initialized_.load(std::memory_order_acquire)) {
+                return;
+            }
+            try {
+                engine->Load(true);
+            } catch (std::exception& ex) {
+                ENGINE_LOG_ERROR << "Cache warm up encounter exception: " << ex.what();
+            }
+        }));
+    }
 
-        StartMetricTask();
-        StartCompactionTask();
-        StartBuildIndexTask();
+    for (auto& result : results) {
+        result.wait();
     }
+    ENGINE_LOG_DEBUG << "Cache warm up loaded " << results.size() << " of " << locations.size() << " files";
 }
 
 void
 DBImpl::WaitMergeFileFinish() {
-    std::lock_guard<std::mutex> lck(compact_result_mutex_);
-    for (auto& iter : compact_thread_results_) {
+    {
+        std::lock_guard<std::mutex> lck(compact_result_mutex_);
+        for (auto& iter : compact_thread_results_) {
+            iter.wait();
+        }
+    }
+
+    // merges clear their files from merging_file_ids_ when done, don't wait for them with the lock held
+    std::list<std::future<void>> merge_results;
+    {
+        std::lock_guard<std::mutex> lck(merge_result_mutex_);
+        merge_results.swap(merge_thread_results_);
+    }
+    for (auto& iter : merge_results) {
         iter.wait();
     }
 }
@@ -591,6 +2504,14 @@ DBImpl::WaitBuildIndexFinish() {
     }
 }
 
+void
+DBImpl::WaitCleanUpFinish() {
+    std::lock_guard<std::mutex> lck(clean_result_mutex_);
+    for (auto& iter : clean_thread_results_) {
+        iter.wait();
+    }
+}
+
 void
 DBImpl::StartMetricTask() {
     static uint64_t metric_clock_tick = 0;
@@ -621,6 +2542,23 @@ DBImpl::StartMetricTask() {
     server::Metrics::GetInstance().GPUMemoryUsageGaugeSet();
     server::Metrics::GetInstance().OctetsSet();
 
+    for (auto& resource : scheduler::ResMgrInst::GetInstance()->GetAllResources()) {
+        auto& task_table = resource->task_table();
+        server::Metrics::GetInstance().TaskTableQueueDepthSet(
+            resource->name(), "start", task_table.NumOfState(scheduler::TaskTableItemState::START));
+        server::Metrics::GetInstance().TaskTableQueueDepthSet(
+            resource->name(), "loaded", task_table.NumOfState(scheduler::TaskTableItemState::LOADED));
+        server::Metrics::GetInstance().TaskTableQueueDepthSet(
+            resource->name(), "executing", task_table.NumOfState(scheduler::TaskTableItemState::EXECUTING));
+#ifdef MILVUS_GPU_VERSION
+        if (resource->type() == scheduler::ResourceType::GPU) {
+            auto device_id = resource->device_id();
+            auto overflow = knowhere::FaissGpuResourceMgr::GetInstance().GetTempMemOverflow(device_id);
+            server::Metrics::GetInstance().GpuTempMemoryOverflowGaugeSet("gpu" + std::to_string(device_id), overflow);
+        }
+#endif
+    }
+
     server::Metrics::GetInstance().CPUCoreUsagePercentSet();
     server::Metrics::GetInstance().GPUTemperature();
     server::Metrics::GetInstance().CPUTemperature();
@@ -630,8 +2568,15 @@ DBImpl::StartMetricTask() {
 Status
 DBImpl::SyncMemData(std::set<std::string>& sync_table_ids) {
     std::lock_guard<std::mutex> lck(mem_serialize_mutex_);
+
+    // records up to this lsn are in memory, they will be persisted by the serialization below
+    uint64_t applied_lsn = 0;
+    if (wal_mgr_ != nullptr) {
+        applied_lsn = wal_mgr_->GetAppliedLsn();
+    }
+
     std::set<std::string> temp_table_ids;
-    mem_mgr_->Serialize(temp_table_ids);
+    auto status = mem_mgr_->Serialize(temp_table_ids);
     for (auto& id : temp_table_ids) {
         sync_table_ids.insert(id);
     }
@@ -639,8 +2584,86 @@ DBImpl::SyncMemData(std::set<std::string>& sync_table_ids) {
     if (!temp_table_ids.empty()) {
         SERVER_LOG_DEBUG << "Insert cache serialized";
     }
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to serialize insert cache: " << status.message();
+    }
 
-    return Status::OK();
+    if (wal_mgr_ != nullptr) {
+        // records of a table failed to serialize are kept in the wal, only the persisted tables are checkpointed
+        auto wal_status =
+            status.ok() ? wal_mgr_->Checkpoint(applied_lsn) : wal_mgr_->Checkpoint(applied_lsn, temp_table_ids);
+        if (!wal_status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to checkpoint wal: " << wal_status.message();
+        }
+    }
+
+    return status;
+}
+
+Status
+DBImpl::SyncMemData(const std::set<std::string>& target_table_ids, std::set<std::string>& sync_table_ids) {
+    std::lock_guard<std::mutex> lck(mem_serialize_mutex_);
+
+    uint64_t applied_lsn = 0;
+    if (wal_mgr_ != nullptr) {
+        applied_lsn = wal_mgr_->GetAppliedLsn();
+    }
+
+    std::set<std::string> temp_table_ids;
+    auto status = mem_mgr_->SerializeTables(target_table_ids, temp_table_ids);
+    for (auto& id : temp_table_ids) {
+        sync_table_ids.insert(id);
+    }
+
+    if (wal_mgr_ != nullptr) {
+        std::set<std::string> checkpoint_table_ids;
+        if (status.ok()) {
+            checkpoint_table_ids = target_table_ids;
+        } else {
+            ENGINE_LOG_ERROR << "Failed to serialize insert cache: " << status.message();
+            for (auto& id : target_table_ids) {
+                if (temp_table_ids.find(id) != temp_table_ids.end()) {
+                    checkpoint_table_ids.insert(id);
+                }
+            }
+        }
+        auto wal_status = wal_mgr_->Checkpoint(applied_lsn, checkpoint_table_ids);
+        if (!wal_status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to checkpoint wal: " << wal_status.message();
+        }
+    }
+
+    return status;
+}
+
+void
+DBImpl::StartFlushTask() {
+    // insert buffer is full, inserts are blocked until all tables are serialized
+    if (mem_mgr_->GetCurrentMem() >= options_.insert_buffer_size_) {
+        SyncMemData(compact_table_ids_);
+        return;
+    }
+
+    std::set<std::string> flush_table_ids;
+    mem_mgr_->GetTablesToFlush(flush_table_ids);
+    if (!flush_table_ids.empty()) {
+        SyncMemData(flush_table_ids, compact_table_ids_);
+    }
+}
+
+Status
+DBImpl::RecoverFromWal() {
+    auto status = wal_mgr_->Init();
+    if (!status.ok()) {
+        return status;
+    }
+
+    wal::ReplayHandler handler = [&](const std::string& table_id, VectorsData& vectors) -> Status {
+        return mem_mgr_->InsertVectors(table_id, vectors);
+    };
+
+    TimeRecorderAuto rc("Recover from wal");
+    return wal_mgr_->Replay(handler);
 }
 
 void
@@ -651,8 +2674,7 @@ DBImpl::StartCompactionTask() {
         return;
     }
 
-    // serialize memory data
-    SyncMemData(compact_table_ids_);
+    // memory data is serialized by StartFlushTask() according to flush policies
 
     // compactiong has been finished?
     {
@@ -704,18 +2726,42 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::DateT& date, const m
         return status;
     }
 
+    // the new file is kept from clean up until it is written, so is the folder of the table if it is dropped
+    ongoing_files_checker_.MarkOngoingFile(table_file);
+
     // step 2: merge files
     ExecutionEnginePtr index =
         EngineFactory::Build(table_file.dimension_, table_file.location_, (EngineType)table_file.engine_type_,
                              (MetricType)table_file.metric_type_, table_file.nlist_);
 
+    // room for all rows up front, the merged vectors aren't copied to a larger buffer as they grow
+    int64_t row_count = 0;
+    for (auto& file : files) {
+        row_count += file.row_count_;
+    }
+    index->Reserve(row_count);
+
     meta::TableFilesSchema updated;
     int64_t index_size = 0;
+    std::vector<std::pair<std::string, size_t>> merged_deleted_counts;
+    SegmentAttrs merged_attrs;  // attributes of deleted vectors are kept, no search matches them
+    SegmentTimeRange merged_time_range;
+    bool time_known = true;  // a file of unknown insert time makes the merged one unknown too
 
     for (auto& file : files) {
         server::CollectMergeFilesMetrics metrics;
 
+        auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(file.location_);
+        merged_deleted_counts.emplace_back(file.location_, (tombstone == nullptr) ? 0 : tombstone->Count());
         index->Merge(file.location_);
+        if (auto attrs = SegmentAttrsMgr::GetInstance().GetAttrs(file.location_)) {
+            merged_attrs.Append(*attrs);
+        }
+        if (auto time_range = SegmentTimeRangeMgr::GetInstance().GetTimeRange(file.location_)) {
+            merged_time_range.Extend(*time_range);
+        } else {
+            time_known = false;
+        }
         auto file_schema = file;
         file_schema.file_type_ = meta::TableFileSchema::TO_DELETE;
         updated.push_back(file_schema);
@@ -726,53 +2772,270 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::DateT& date, const m
         }
     }
 
-    // step 3: serialize to disk
+    // vectors of the files are all deleted, nothing is left to write
+    if (index->Count() == 0) {
+        std::lock_guard<std::mutex> lock(SegmentTombstoneMgr::GetInstance().DeleteMutex());
+        table_file.file_type_ = meta::TableFileSchema::TO_DELETE;
+        updated.push_back(table_file);
+        ENGINE_LOG_DEBUG << "All vectors of merged files are deleted, mark file: " << table_file.file_id_
+                         << " to to_delete";
+        status = meta_ptr_->UpdateTableFiles(updated);
+        ongoing_files_checker_.UnmarkOngoingFile(table_file);
+        return status;
+    }
+
+    // step 3: serialize to disk
+    try {
+        status = index->Serialize();
+        if (status.ok() && merged_attrs.Count() > 0) {
+            status = merged_attrs.Write(table_file.location_);
+        }
+        if (status.ok() && time_known && !merged_time_range.Empty()) {
+            status = merged_time_range.Write(table_file.location_);
+        }
+        fiu_do_on("DBImpl.MergeFiles.Serialize_ThrowException", throw std::exception());
+        fiu_do_on("DBImpl.MergeFiles.Serialize_ErrorStatus", status = Status(DB_ERROR, ""));
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << status.message();
+        }
+    } catch (std::exception& ex) {
+        std::string msg = "Serialize merged index encounter exception: " + std::string(ex.what());
+        ENGINE_LOG_ERROR << msg;
+        status = Status(DB_ERROR, msg);
+    }
+
+    if (!status.ok()) {
+        // if failed to serialize merge file to disk
+        // typical error: out of disk space, out of memory or permition denied
+        table_file.file_type_ = meta::TableFileSchema::TO_DELETE;
+        status = meta_ptr_->UpdateTableFile(table_file);
+        ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << table_file.file_id_ << " to to_delete";
+
+        ENGINE_LOG_ERROR << "Failed to persist merged file: " << table_file.location_
+                         << ", possible out of disk space or memory";
+
+        ongoing_files_checker_.UnmarkOngoingFile(table_file);
+        return status;
+    }
+
+    // step 4: update table files state
+    // if index type isn't IDMAP, set file type to TO_INDEX if file size execeed index_file_size
+    // else set file type to RAW, no need to build index
+    if (table_file.engine_type_ != (int)EngineType::FAISS_IDMAP) {
+        table_file.file_type_ = (index->PhysicalSize() >= table_file.index_file_size_) ? meta::TableFileSchema::TO_INDEX
+                                                                                       : meta::TableFileSchema::RAW;
+    } else {
+        table_file.file_type_ = meta::TableFileSchema::RAW;
+    }
+    table_file.file_size_ = index->PhysicalSize();
+    table_file.row_count_ = index->Count();
+    updated.push_back(table_file);
+    {
+        // vectors deleted from the merged files while they were merged are deleted from the new one, no deletion
+        // comes in between until the new file replaces them
+        std::lock_guard<std::mutex> lock(SegmentTombstoneMgr::GetInstance().DeleteMutex());
+        std::vector<int64_t> deleted_ids;
+        for (auto& pair : merged_deleted_counts) {
+            auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(pair.first);
+            if (tombstone != nullptr && tombstone->Count() > pair.second) {
+                deleted_ids.insert(deleted_ids.end(), tombstone->Ids().begin() + pair.second, tombstone->Ids().end());
+            }
+        }
+        if (!deleted_ids.empty()) {
+            status = SegmentTombstoneMgr::GetInstance().Delete(table_file.location_, deleted_ids);
+        }
+        if (status.ok()) {
+            status = meta_ptr_->UpdateTableFiles(updated);
+        }
+    }
+    ongoing_files_checker_.UnmarkOngoingFile(table_file);
+    if (status.ok()) {
+        for (auto& pair : merged_deleted_counts) {
+            utils::RemoveIngestIndex(pair.first);
+        }
+    }
+    ENGINE_LOG_DEBUG << "New merged file " << table_file.file_id_ << " of size " << index->PhysicalSize() << " bytes";
+
+    if (options_.insert_cache_immediately_) {
+        index->Cache();
+    }
+
+    return status;
+}
+
+void
+DBImpl::CompressArchiveFiles() {
+    auto& archive_conf = options_.meta_.archive_conf_;
+    auto criterias = archive_conf.GetCriterias();
+    auto days = criterias.find(ARCHIVE_CONF_DAYS);
+    if (archive_conf.GetType() != ARCHIVE_TYPE_COMPRESS || days == criterias.end() || days->second <= 0) {
+        return;
+    }
+    int64_t archive_before = utils::GetMicroSecTimeStamp() - days->second * meta::DAY * meta::US_PS;
+
+    std::vector<meta::TableSchema> tables;
+    meta_ptr_->AllTables(tables);
+    uint64_t compressed = 0;
+    for (auto& table_schema : tables) {
+        // pq codes are of float vectors only
+        if (server::ValidationUtil::IsBinaryMetricType(table_schema.metric_type_)) {
+            continue;
+        }
+
+        meta::TableFilesSchema files;
+        auto status = meta_ptr_->FilesByType(table_schema.table_id_,
+                                             {meta::TableFileSchema::RAW, meta::TableFileSchema::INDEX,
+                                              meta::TableFileSchema::BACKUP},
+                                             files);
+        if (!status.ok()) {
+            continue;
+        }
+
+        std::unordered_map<std::string, meta::TableFileSchema*> backups;
+        for (auto& file : files) {
+            file.dimension_ = table_schema.dimension_;
+            file.index_file_size_ = table_schema.index_file_size_;
+            file.nlist_ = table_schema.nlist_;
+            file.metric_type_ = table_schema.metric_type_;
+            utils::GetTableFilePath(options_.meta_, file);
+            if (file.file_type_ == meta::TableFileSchema::BACKUP) {
+                backups[file.file_id_] = &file;
+            }
+        }
+
+        // a file waiting to be built is compressed once it is an index file, the vectors of an index file are
+        // read from the backup file it was built from
+        for (auto& file : files) {
+            if (file.created_on_ >= archive_before || file.file_type_ == meta::TableFileSchema::BACKUP ||
+                file.row_count_ < ARCHIVE_MIN_ROWS) {
+                continue;
+            }
+
+            // a file being merged or built is replaced by the merge or build, it is compressed in a later round
+            {
+                std::lock_guard<std::mutex> lck(merge_result_mutex_);
+                if (merging_file_ids_.find(file.id_) != merging_file_ids_.end()) {
+                    continue;
+                }
+            }
+            if (ongoing_files_checker_.IsIgnored(file)) {
+                continue;
+            }
+
+            const meta::TableFileSchema* raw_file = &file;
+            if (file.file_type_ == meta::TableFileSchema::INDEX) {
+                std::string origin_file_id;
+                auto iter = backups.end();
+                if (utils::ReadIndexOrigin(file.location_, origin_file_id).ok()) {
+                    iter = backups.find(origin_file_id);
+                }
+                if (iter == backups.end()) {
+                    continue;
+                }
+                raw_file = iter->second;
+            }
+
+            status = CompressArchiveFile(table_schema, file, *raw_file);
+            if (!status.ok()) {
+                ENGINE_LOG_ERROR << "Failed to compress archive file " << file.file_id_ << ": " << status.message();
+            } else {
+                ++compressed;
+            }
+            if (compressed >= ARCHIVE_FILES_PER_ROUND || !initialized_.load(std::memory_order_acquire)) {
+                return;
+            }
+        }
+    }
+}
+
+Status
+DBImpl::CompressArchiveFile(const meta::TableSchema& table_schema, const meta::TableFileSchema& file,
+                            const meta::TableFileSchema& raw_file) {
+    // a build would make an index file of the raw file, a rebuild would replace the index file
+    std::lock_guard<std::mutex> build_lock(build_index_mutex_);
+
+    auto engine = EngineFactory::Build(raw_file.dimension_, raw_file.location_, (EngineType)raw_file.engine_type_,
+                                       (MetricType)table_schema.metric_type_, table_schema.nlist_);
+    auto status = engine->Load(false);
+    if (!status.ok()) {
+        return status;
+    }
+
+    meta::TableFileSchema archive_file;
+    archive_file.table_id_ = file.table_id_;
+    archive_file.date_ = file.date_;
+    archive_file.file_type_ = meta::TableFileSchema::NEW_INDEX;
+    status = meta_ptr_->CreateTableFile(archive_file);
+    if (!status.ok()) {
+        return status;
+    }
+
+    ExecutionEnginePtr index;
     try {
-        status = index->Serialize();
-        fiu_do_on("DBImpl.MergeFiles.Serialize_ThrowException", throw std::exception());
-        fiu_do_on("DBImpl.MergeFiles.Serialize_ErrorStatus", status = Status(DB_ERROR, ""));
-        if (!status.ok()) {
-            ENGINE_LOG_ERROR << status.message();
+        status = utils::CreateArchiveFilePath(options_.meta_, archive_file);
+        if (status.ok()) {
+            index = engine->BuildIndex(archive_file.location_, EngineType::FAISS_PQ);
+            status = (index == nullptr) ? Status(DB_ERROR, "Failed to build pq codes") : index->Serialize();
+        }
+
+        // attributes and insert time go along, the summary of the raw vectors still bounds the codes
+        auto attrs = SegmentAttrsMgr::GetInstance().GetAttrs(file.location_);
+        if (status.ok() && attrs != nullptr) {
+            status = attrs->Write(archive_file.location_);
+        }
+        auto time_range = SegmentTimeRangeMgr::GetInstance().GetTimeRange(file.location_);
+        if (status.ok() && time_range != nullptr) {
+            status = time_range->Write(archive_file.location_);
+        }
+        auto summary = SegmentSummaryMgr::GetInstance().GetSummary(raw_file.location_);
+        if (status.ok() && summary != nullptr) {
+            status = summary->Write(archive_file.location_);
         }
     } catch (std::exception& ex) {
-        std::string msg = "Serialize merged index encounter exception: " + std::string(ex.what());
-        ENGINE_LOG_ERROR << msg;
-        status = Status(DB_ERROR, msg);
+        status = Status(DB_ERROR, ex.what());
     }
-
     if (!status.ok()) {
-        // if failed to serialize merge file to disk
-        // typical error: out of disk space, out of memory or permition denied
-        table_file.file_type_ = meta::TableFileSchema::TO_DELETE;
-        status = meta_ptr_->UpdateTableFile(table_file);
-        ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << table_file.file_id_ << " to to_delete";
-
-        ENGINE_LOG_ERROR << "Failed to persist merged file: " << table_file.location_
-                         << ", possible out of disk space or memory";
-
+        archive_file.file_type_ = meta::TableFileSchema::TO_DELETE;
+        meta_ptr_->UpdateTableFile(archive_file);
         return status;
     }
 
-    // step 4: update table files state
-    // if index type isn't IDMAP, set file type to TO_INDEX if file size execeed index_file_size
-    // else set file type to RAW, no need to build index
-    if (table_file.engine_type_ != (int)EngineType::FAISS_IDMAP) {
-        table_file.file_type_ = (index->PhysicalSize() >= table_file.index_file_size_) ? meta::TableFileSchema::TO_INDEX
-                                                                                       : meta::TableFileSchema::RAW;
-    } else {
-        table_file.file_type_ = meta::TableFileSchema::RAW;
+    archive_file.file_type_ = meta::TableFileSchema::ARCHIVE;
+    archive_file.engine_type_ = static_cast<int32_t>(EngineType::FAISS_PQ);
+    archive_file.file_size_ = index->PhysicalSize();
+    archive_file.row_count_ = index->Count();
+    meta::TableFilesSchema update_files = {archive_file, file};
+    update_files.back().file_type_ = meta::TableFileSchema::TO_DELETE;
+    if (raw_file.id_ != file.id_) {
+        update_files.push_back(raw_file);
+        update_files.back().file_type_ = meta::TableFileSchema::TO_DELETE;
     }
-    table_file.file_size_ = index->PhysicalSize();
-    table_file.row_count_ = index->Count();
-    updated.push_back(table_file);
-    status = meta_ptr_->UpdateTableFiles(updated);
-    ENGINE_LOG_DEBUG << "New merged file " << table_file.file_id_ << " of size " << index->PhysicalSize() << " bytes";
 
-    if (options_.insert_cache_immediately_) {
-        index->Cache();
+    {
+        // the codes are of all vectors of the raw file, the ones deleted from either file are deleted from them
+        auto& tombstone_mgr = SegmentTombstoneMgr::GetInstance();
+        std::lock_guard<std::mutex> lock(tombstone_mgr.DeleteMutex());
+        for (auto& location : {raw_file.location_, file.location_}) {
+            auto tombstone = tombstone_mgr.GetTombstone(location);
+            if (status.ok() && tombstone != nullptr) {
+                status = tombstone_mgr.Delete(archive_file.location_, tombstone->Ids());
+            }
+        }
+        if (status.ok()) {
+            status = meta_ptr_->UpdateTableFiles(update_files);
+        }
+    }
+    if (!status.ok()) {
+        archive_file.file_type_ = meta::TableFileSchema::TO_DELETE;
+        meta_ptr_->UpdateTableFile(archive_file);
+        return status;
     }
 
-    return status;
+    cache::CpuCacheMgr::GetInstance()->EraseItem(file.location_);
+    cache::CpuCacheMgr::GetInstance()->EraseItem(raw_file.location_);
+    ENGINE_LOG_DEBUG << "Archive file " << archive_file.file_id_ << " of " << archive_file.file_size_
+                     << " bytes compressed from file " << file.file_id_ << " of " << raw_file.file_size_ << " bytes";
+    return Status::OK();
 }
 
 Status
@@ -784,26 +3047,91 @@ DBImpl::BackgroundMergeFiles(const std::string& table_id) {
         return status;
     }
 
+    size_t raw_file_count = 0;
     for (auto& kv : raw_files) {
-        meta::TableFilesSchema& files = kv.second;
-        if (files.size() < options_.merge_trigger_number_) {
-            ENGINE_LOG_TRACE << "Files number not greater equal than merge trigger number, skip merge action";
-            continue;
-        }
-
-        status = ongoing_files_checker_.MarkOngoingFiles(files);
-        MergeFiles(table_id, kv.first, kv.second);
-        status = ongoing_files_checker_.UnmarkOngoingFiles(files);
+        raw_file_count += kv.second.size();
+    }
+    server::Metrics::GetInstance().PendingFilesGaugeSet(table_id, "raw", raw_file_count);
 
+    TieredMergePolicy policy(options_.merge_trigger_number_, options_.merge_max_fan_in_);
+    for (auto& kv : raw_files) {
         if (!initialized_.load(std::memory_order_acquire)) {
             ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action for table: " << table_id;
             break;
         }
+
+        // files still being merged by an earlier round stay out of new merges
+        meta::TableFilesSchema files;
+        std::vector<meta::TableFilesSchema> groups;
+        {
+            std::lock_guard<std::mutex> lck(merge_result_mutex_);
+            for (auto& file : kv.second) {
+                if (merging_file_ids_.find(file.id_) == merging_file_ids_.end()) {
+                    files.push_back(file);
+                }
+            }
+            groups = policy.Pick(files);
+
+            // a file left out of the picked groups is merged on its own when much of it is deleted
+            std::set<size_t> picked_file_ids;
+            for (auto& group : groups) {
+                for (auto& file : group) {
+                    picked_file_ids.insert(file.id_);
+                }
+            }
+            for (auto& file : files) {
+                if (picked_file_ids.find(file.id_) != picked_file_ids.end() || file.row_count_ == 0) {
+                    continue;
+                }
+                auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(file.location_);
+                if (tombstone != nullptr && tombstone->Count() >= options_.delete_compact_ratio_ * file.row_count_) {
+                    groups.push_back({file});
+                }
+            }
+
+            for (auto& group : groups) {
+                for (auto& file : group) {
+                    merging_file_ids_.insert(file.id_);
+                }
+            }
+
+            merge_thread_results_.remove_if([](std::future<void>& result) {
+                return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            });
+        }
+        if (groups.empty()) {
+            ENGINE_LOG_TRACE << "No tier has enough files to merge, skip merge action";
+            continue;
+        }
+
+        for (auto& group : groups) {
+            ongoing_files_checker_.MarkOngoingFiles(group);
+            auto result = merge_thread_pool_.enqueue(&DBImpl::BackgroundMergeGroup, this, table_id, kv.first, group);
+            std::lock_guard<std::mutex> lck(merge_result_mutex_);
+            merge_thread_results_.push_back(std::move(result));
+        }
     }
 
     return Status::OK();
 }
 
+void
+DBImpl::BackgroundMergeGroup(const std::string& table_id, const meta::DateT& date,
+                             const meta::TableFilesSchema& files) {
+    storage::BackgroundIOScope background_io;
+    if (initialized_.load(std::memory_order_acquire)) {
+        MergeFiles(table_id, date, files);
+    } else {
+        ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action for table: " << table_id;
+    }
+    ongoing_files_checker_.UnmarkOngoingFiles(files);
+
+    std::lock_guard<std::mutex> lck(merge_result_mutex_);
+    for (auto& file : files) {
+        merging_file_ids_.erase(file.id_);
+    }
+}
+
 void
 DBImpl::BackgroundCompaction(std::set<std::string> table_ids) {
     // ENGINE_LOG_TRACE << " Background compaction thread start";
@@ -821,18 +3149,41 @@ DBImpl::BackgroundCompaction(std::set<std::string> table_ids) {
         }
     }
 
+    CompressArchiveFiles();
     meta_ptr_->Archive();
 
-    {
-        uint64_t ttl = 10 * meta::SECOND;  // default: file will be hard-deleted few seconds after soft-deleted
-        if (options_.mode_ == DBOptions::MODE::CLUSTER_WRITABLE) {
-            ttl = meta::HOUR;
+    // ENGINE_LOG_TRACE << " Background compaction thread exit";
+}
+
+void
+DBImpl::StartCleanUpTask() {
+    static uint64_t clean_clock_tick = 0;
+    ++clean_clock_tick;
+    if (clean_clock_tick % CLEANUP_ACTION_INTERVAL != 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lck(clean_result_mutex_);
+    if (!clean_thread_results_.empty()) {
+        std::chrono::milliseconds span(10);
+        if (clean_thread_results_.back().wait_for(span) != std::future_status::ready) {
+            return;  // the last one is still deleting files
         }
+        clean_thread_results_.pop_back();
+    }
 
-        meta_ptr_->CleanUpFilesWithTTL(ttl, &ongoing_files_checker_);
+    clean_thread_results_.push_back(clean_thread_pool_.enqueue(&DBImpl::BackgroundCleanUp, this));
+}
+
+void
+DBImpl::BackgroundCleanUp() {
+    uint64_t ttl = 10 * meta::SECOND;  // default: file will be hard-deleted few seconds after soft-deleted
+    if (options_.mode_ == DBOptions::MODE::CLUSTER_WRITABLE) {
+        ttl = meta::HOUR;
     }
 
-    // ENGINE_LOG_TRACE << " Background compaction thread exit";
+    storage::BackgroundIOScope background_io;
+    meta_ptr_->CleanUpFilesWithTTL(ttl, &ongoing_files_checker_);
 }
 
 void
@@ -866,9 +3217,44 @@ DBImpl::StartBuildIndexTask(bool force) {
 void
 DBImpl::BackgroundBuildIndex() {
     std::unique_lock<std::mutex> lock(build_index_mutex_);
+    std::vector<std::string> pending_tables;
+    QueuePendingIndexFiles(pending_tables);
+
     meta::TableFilesSchema to_index_files;
     meta_ptr_->FilesToIndex(to_index_files);
+
+    // segments of pending tables still searched through an index of an older type are rebuilt from their backups
+    std::map<size_t, meta::TableFileSchema> replaced_files;
+    for (auto& table_id : pending_tables) {
+        std::vector<meta::TableSchema> schemas;
+        meta_ptr_->ShowPartitions(table_id, schemas);
+        schemas.emplace_back();
+        schemas.back().table_id_ = table_id;
+        for (auto& schema : schemas) {
+            if (meta_ptr_->DescribeTable(schema).ok()) {
+                GetFilesToReplaceIndex(schema, to_index_files, replaced_files);
+            }
+        }
+    }
+
     Status status = index_failed_checker_.IgnoreFailedIndexFiles(to_index_files);
+    SortByBuildPriority(to_index_files);
+
+    // backlog by table, tables drained since the last round are reported as empty
+    std::map<std::string, int64_t> to_index_counts;
+    for (auto& table_id : to_index_tables_) {
+        to_index_counts[table_id] = 0;
+    }
+    for (auto& file : to_index_files) {
+        ++to_index_counts[file.table_id_];
+    }
+    to_index_tables_.clear();
+    for (auto& kv : to_index_counts) {
+        server::Metrics::GetInstance().PendingFilesGaugeSet(kv.first, "to_index", kv.second);
+        if (kv.second > 0) {
+            to_index_tables_.insert(kv.first);
+        }
+    }
 
     if (!to_index_files.empty()) {
         ENGINE_LOG_DEBUG << "Background build index thread begin";
@@ -876,10 +3262,17 @@ DBImpl::BackgroundBuildIndex() {
 
         // step 2: put build index task to scheduler
         std::vector<std::pair<scheduler::BuildIndexJobPtr, scheduler::TableFileSchemaPtr>> job2file_map;
+        int64_t now = utils::GetMicroSecTimeStamp();
         for (auto& file : to_index_files) {
+            server::Metrics::GetInstance().BuildIndexWaitHistogramObserve(now - file.created_on_);
             scheduler::BuildIndexJobPtr job = std::make_shared<scheduler::BuildIndexJob>(meta_ptr_, options_);
             scheduler::TableFileSchemaPtr file_ptr = std::make_shared<meta::TableFileSchema>(file);
-            job->AddToIndexFiles(file_ptr);
+            auto replaced = replaced_files.find(file.id_);
+            if (replaced != replaced_files.end()) {
+                job->AddToIndexFiles(file_ptr, std::make_shared<meta::TableFileSchema>(replaced->second));
+            } else {
+                job->AddToIndexFiles(file_ptr);
+            }
             scheduler::JobMgrInst::GetInstance()->Put(job);
             job2file_map.push_back(std::make_pair(job, file_ptr));
         }
@@ -900,10 +3293,21 @@ DBImpl::BackgroundBuildIndex() {
                 index_failed_checker_.MarkSucceedIndexFile(file_schema);
             }
             status = ongoing_files_checker_.UnmarkOngoingFile(file_schema);
+            server::Metrics::GetInstance().PendingFilesGaugeSet(file_schema.table_id_, "to_index",
+                                                                --to_index_counts[file_schema.table_id_]);
         }
 
         ENGINE_LOG_DEBUG << "Background build index thread finished";
     }
+
+    // a pending creation is done once no file of the table is left to build
+    for (auto& table_id : pending_tables) {
+        uint64_t indexed_rows = 0, rows_to_build = 0, files_to_build = 0;
+        auto count_status = CountIndexRowsRecursively(table_id, indexed_rows, rows_to_build, files_to_build);
+        if (count_status.ok() && files_to_build == 0) {
+            FinishIndexProgress(table_id, Status::OK());
+        }
+    }
 }
 
 Status
@@ -922,6 +3326,14 @@ DBImpl::GetFilesToBuildIndex(const std::string& table_id, const std::vector<int>
         }
     }
 
+    // backup files of segments whose index is of an older type are built too
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    if (status.ok() && meta_ptr_->DescribeTable(table_schema).ok()) {
+        std::map<size_t, meta::TableFileSchema> replaced_files;
+        GetFilesToReplaceIndex(table_schema, files, replaced_files);
+    }
+
     return Status::OK();
 }
 
@@ -940,6 +3352,22 @@ DBImpl::GetFilesToSearch(const std::string& table_id, const std::vector<size_t>&
     return Status::OK();
 }
 
+Status
+DBImpl::GetFilesToSearch(const std::set<std::string>& table_ids, const meta::DatesT& dates,
+                         meta::TableFilesSchema& files) {
+    ENGINE_LOG_DEBUG << "Collect files from " << table_ids.size() << " tables";
+
+    meta::DatePartionedTableFilesSchema date_files;
+    auto status =
+        meta_ptr_->FilesToSearch(std::vector<std::string>(table_ids.begin(), table_ids.end()), dates, date_files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    TraverseFiles(date_files, files);
+    return Status::OK();
+}
+
 Status
 DBImpl::GetPartitionsByTags(const std::string& table_id, const std::vector<std::string>& partition_tags,
                             std::set<std::string>& partition_name_array) {
@@ -951,8 +3379,12 @@ DBImpl::GetPartitionsByTags(const std::string& table_id, const std::vector<std::
         // for example: " ab cd " is treated as "ab cd"
         std::string valid_tag = tag;
         server::StringHelpFunctions::TrimStringBlank(valid_tag);
+
+        // the pattern is compiled once for all partitions, a tag that is no valid regex matches by equality only
+        auto pattern = server::StringHelpFunctions::CompileRegex(valid_tag);
         for (auto& schema : partition_array) {
-            if (server::StringHelpFunctions::IsRegexMatch(schema.partition_tag_, valid_tag)) {
+            if (schema.partition_tag_ == valid_tag ||
+                (pattern != nullptr && std::regex_match(schema.partition_tag_, *pattern))) {
                 partition_name_array.insert(schema.table_id_);
             }
         }
@@ -970,7 +3402,12 @@ DBImpl::DropTableRecursively(const std::string& table_id, const meta::DatesT& da
     if (dates.empty()) {
         status = mem_mgr_->EraseMemVector(table_id);  // not allow insert
         status = meta_ptr_->DropTable(table_id);      // soft delete table
+        if (wal_mgr_ != nullptr) {
+            // records of the dropped table needn't be replayed
+            wal_mgr_->Checkpoint(wal_mgr_->GetAppliedLsn(), {table_id});
+        }
         index_failed_checker_.CleanFailedIndexFileOfTable(table_id);
+        ExecutionEngineImpl::DropTableModels(table_id);
 
         // scheduler will determine when to delete table files
         auto nres = scheduler::ResMgrInst::GetInstance()->GetNumOfComputeResource();
@@ -1018,6 +3455,106 @@ DBImpl::UpdateTableIndexRecursively(const std::string& table_id, const TableInde
     return Status::OK();
 }
 
+Status
+DBImpl::ReplaceTableIndexRecursively(const std::string& table_id, const TableIndex& index) {
+    // unlike an update, the index files and their backup files are kept as they are
+    auto status = meta_ptr_->UpdateTableIndex(table_id, index);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to update table index info for table: " << table_id;
+        return status;
+    }
+    ExecutionEngineImpl::DropTableModels(table_id);
+
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    for (auto& schema : partition_array) {
+        status = ReplaceTableIndexRecursively(schema.table_id_, index);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    ENGINE_LOG_DEBUG << "Index of table " << table_id << " is replaced segment by segment";
+    return Status::OK();
+}
+
+bool
+DBImpl::CanReplaceIndexRecursively(const std::string& table_id, const TableIndex& index) {
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    if (!meta_ptr_->DescribeTable(table_schema).ok()) {
+        return false;
+    }
+
+    // every index file of the old type has to be found a backup file
+    table_schema.engine_type_ = index.engine_type_;
+    meta::TableFilesSchema backup_files;
+    std::map<size_t, meta::TableFileSchema> replaced_files;
+    auto status = GetFilesToReplaceIndex(table_schema, backup_files, replaced_files);
+    if (!status.ok()) {
+        ENGINE_LOG_DEBUG << "Index of table " << table_id << " is dropped before rebuilt: " << status.message();
+        return false;
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    meta_ptr_->ShowPartitions(table_id, partition_array);
+    for (auto& schema : partition_array) {
+        if (!CanReplaceIndexRecursively(schema.table_id_, index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status
+DBImpl::GetFilesToReplaceIndex(const meta::TableSchema& table_schema, meta::TableFilesSchema& backup_files,
+                               std::map<size_t, meta::TableFileSchema>& replaced_files) {
+    meta::TableFilesSchema files;
+    auto status = meta_ptr_->FilesByType(table_schema.table_id_,
+                                         {meta::TableFileSchema::INDEX, meta::TableFileSchema::BACKUP}, files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::unordered_map<std::string, meta::TableFileSchema*> backups;
+    for (auto& file : files) {
+        file.dimension_ = table_schema.dimension_;
+        file.index_file_size_ = table_schema.index_file_size_;
+        file.nlist_ = table_schema.nlist_;
+        file.metric_type_ = table_schema.metric_type_;
+        utils::GetTableFilePath(options_.meta_, file);
+        if (file.file_type_ == meta::TableFileSchema::BACKUP) {
+            backups[file.file_id_] = &file;
+        }
+    }
+
+    uint64_t orphan_count = 0;
+    for (auto& file : files) {
+        if (file.file_type_ != meta::TableFileSchema::INDEX || file.engine_type_ == table_schema.engine_type_) {
+            continue;
+        }
+
+        // an index file built before origins were kept has no backup file known
+        std::string origin_file_id;
+        auto iter = backups.end();
+        if (utils::ReadIndexOrigin(file.location_, origin_file_id).ok()) {
+            iter = backups.find(origin_file_id);
+        }
+        if (iter == backups.end()) {
+            ++orphan_count;
+            continue;
+        }
+        backup_files.push_back(*iter->second);
+        replaced_files[iter->second->id_] = file;
+    }
+
+    if (orphan_count > 0) {
+        return Status(DB_ERROR, std::to_string(orphan_count) + " index files of table " + table_schema.table_id_ +
+                                    " have no backup file");
+    }
+    return Status::OK();
+}
+
 Status
 DBImpl::BuildTableIndexRecursively(const std::string& table_id, const TableIndex& index) {
     // for IDMAP type, only wait all NEW file converted to RAW file
@@ -1087,6 +3624,19 @@ DBImpl::DropTableIndexRecursively(const std::string& table_id) {
     if (!status.ok()) {
         return status;
     }
+    status = SetIndexPending(table_id, false);
+    if (!status.ok()) {
+        return status;
+    }
+    ExecutionEngineImpl::DropTableModels(table_id);
+
+    // indexes built on flush go with the table index they were built for
+    meta::TableFilesSchema raw_files;
+    status = meta_ptr_->FilesByType(table_id, {meta::TableFileSchema::RAW, meta::TableFileSchema::TO_INDEX}, raw_files);
+    for (auto& file : raw_files) {
+        utils::GetTableFilePath(options_.meta_, file);
+        utils::RemoveIngestIndex(file.location_);
+    }
 
     // drop partition index
     std::vector<meta::TableSchema> partition_array;
@@ -1103,6 +3653,179 @@ DBImpl::DropTableIndexRecursively(const std::string& table_id) {
     return Status::OK();
 }
 
+Status
+DBImpl::CountIndexRowsRecursively(const std::string& table_id, uint64_t& indexed_rows, uint64_t& rows_to_build,
+                                  uint64_t& files_to_build) {
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // new files of the insert buffer come all the time, only the ones of merges are waited for
+    std::vector<int> file_types = {
+        static_cast<int32_t>(meta::TableFileSchema::NEW_MERGE),
+        static_cast<int32_t>(meta::TableFileSchema::RAW),
+        static_cast<int32_t>(meta::TableFileSchema::TO_INDEX),
+        static_cast<int32_t>(meta::TableFileSchema::INDEX),
+    };
+    meta::TableFilesSchema files;
+    status = meta_ptr_->FilesByType(table_id, file_types, files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // files failed too many times are given up, small raw files are never built
+    index_failed_checker_.IgnoreFailedIndexFiles(files);
+
+    // a segment still searched through an index of an older type is yet to be built
+    meta::TableFilesSchema backup_files;
+    std::map<size_t, meta::TableFileSchema> replaced_files;
+    GetFilesToReplaceIndex(table_schema, backup_files, replaced_files);
+    index_failed_checker_.IgnoreFailedIndexFiles(backup_files);
+    std::set<size_t> replaced_ids;
+    for (auto& file : backup_files) {
+        replaced_ids.insert(replaced_files[file.id_].id_);
+        rows_to_build += file.row_count_;
+        ++files_to_build;
+    }
+
+    for (auto& file : files) {
+        if (file.file_type_ == meta::TableFileSchema::INDEX) {
+            if (replaced_ids.find(file.id_) == replaced_ids.end()) {
+                indexed_rows += file.row_count_;
+            }
+        } else if (file.file_type_ == meta::TableFileSchema::NEW_MERGE) {
+            ++files_to_build;
+        } else if (file.file_type_ == meta::TableFileSchema::TO_INDEX ||
+                   file.row_count_ >= meta::BUILD_INDEX_THRESHOLD) {
+            rows_to_build += file.row_count_;
+            ++files_to_build;
+        }
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    for (auto& schema : partition_array) {
+        status = CountIndexRowsRecursively(schema.table_id_, indexed_rows, rows_to_build, files_to_build);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::SetIndexPending(const std::string& table_id, bool pending) {
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    int64_t flag = pending ? (table_schema.flag_ | meta::FLAG_MASK_INDEX_PENDING)
+                           : (table_schema.flag_ & ~meta::FLAG_MASK_INDEX_PENDING);
+    if (flag == table_schema.flag_) {
+        return Status::OK();
+    }
+    return meta_ptr_->UpdateTableFlag(table_id, flag);
+}
+
+void
+DBImpl::QueuePendingIndexFiles(std::vector<std::string>& table_ids) {
+    table_ids.clear();
+    std::vector<meta::TableSchema> tables;
+    meta_ptr_->AllTables(tables);
+    for (auto& table : tables) {
+        if ((table.flag_ & meta::FLAG_MASK_INDEX_PENDING) == 0) {
+            continue;
+        }
+
+        // a file set to be built while it is merged would be searched twice, once built and once merged
+        std::vector<meta::TableSchema> partition_array;
+        meta_ptr_->ShowPartitions(table.table_id_, partition_array);
+        bool merging = HasMergingFiles(table.table_id_);
+        for (auto& schema : partition_array) {
+            merging = merging || HasMergingFiles(schema.table_id_);
+        }
+        if (merging) {
+            ENGINE_LOG_DEBUG << "Files of table " << table.table_id_ << " are being merged, build index later";
+            continue;
+        }
+
+        table_ids.push_back(table.table_id_);
+        meta_ptr_->UpdateTableFilesToIndex(table.table_id_);
+        for (auto& schema : partition_array) {
+            meta_ptr_->UpdateTableFilesToIndex(schema.table_id_);
+        }
+
+        // a creation left by a restart is measured from now
+        StartIndexProgress(table.table_id_);
+    }
+}
+
+bool
+DBImpl::HasMergingFiles(const std::string& table_id) {
+    meta::TableFilesSchema raw_files;
+    meta_ptr_->FilesByType(table_id, {meta::TableFileSchema::RAW}, raw_files);
+
+    std::lock_guard<std::mutex> lck(merge_result_mutex_);
+    for (auto& file : raw_files) {
+        if (merging_file_ids_.find(file.id_) != merging_file_ids_.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+DBImpl::StartIndexProgress(const std::string& table_id) {
+    {
+        std::lock_guard<std::mutex> lock(index_progress_mutex_);
+        auto iter = index_progresses_.find(table_id);
+        if (iter != index_progresses_.end() && !iter->second.finished_) {
+            return;
+        }
+    }
+
+    uint64_t indexed_rows = 0, rows_to_build = 0, files_to_build = 0;
+    CountIndexRowsRecursively(table_id, indexed_rows, rows_to_build, files_to_build);
+
+    std::lock_guard<std::mutex> lock(index_progress_mutex_);
+    IndexProgress progress;
+    progress.start_time_ = std::chrono::steady_clock::now();
+    progress.start_indexed_rows_ = indexed_rows;
+    index_progresses_[table_id] = progress;
+}
+
+void
+DBImpl::FinishIndexProgress(const std::string& table_id, const Status& status) {
+    auto set_status = SetIndexPending(table_id, false);
+    if (!set_status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to finish index creation of table " << table_id << ": " << set_status.message();
+    }
+
+    std::string err_msg = status.ok() ? "" : status.message();
+    if (err_msg.empty()) {
+        index_failed_checker_.GetErrMsgForTable(table_id, err_msg);
+    }
+
+    // a table or index dropped during the creation has its progress dropped too
+    std::lock_guard<std::mutex> lock(index_progress_mutex_);
+    auto iter = index_progresses_.find(table_id);
+    if (iter == index_progresses_.end()) {
+        return;
+    }
+    auto& progress = iter->second;
+    progress.finished_ = true;
+    progress.error_ = err_msg;
+    ENGINE_LOG_DEBUG << "Index creation of table " << table_id << " finished" << (err_msg.empty() ? "" : ": ")
+                     << err_msg;
+}
+
 Status
 DBImpl::GetTableRowCountRecursively(const std::string& table_id, uint64_t& row_count) {
     row_count = 0;
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <map>
@@ -23,10 +24,13 @@
 #include <vector>
 
 #include "DB.h"
+#include "cache/Cache.h"
+#include "db/IDGenerator.h"
 #include "db/IndexFailedChecker.h"
 #include "db/OngoingFileChecker.h"
 #include "db/Types.h"
 #include "db/insert/MemManager.h"
+#include "db/wal/WalManager.h"
 #include "utils/ThreadPool.h"
 
 namespace milvus {
@@ -66,6 +70,12 @@ class DBImpl : public DB {
     Status
     PreloadTable(const std::string& table_id) override;
 
+    Status
+    GetPreloadProgress(std::string& result) override;
+
+    Status
+    SetTableCacheQuota(const std::string& table_id, int64_t reserved, int64_t max, bool pinned) override;
+
     Status
     UpdateTableFlag(const std::string& table_id, int64_t flag);
 
@@ -88,9 +98,30 @@ class DBImpl : public DB {
     Status
     InsertVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) override;
 
+    Status
+    BulkLoad(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) override;
+
+    Status
+    DeleteByID(const std::string& table_id, const IDNumbers& vector_ids) override;
+
+    Status
+    GetVectorByID(const std::string& table_id, const IDNumber& vector_id, VectorsData& vector) override;
+
     Status
     CreateIndex(const std::string& table_id, const TableIndex& index) override;
 
+    Status
+    CreateIndexAsync(const std::string& table_id, const TableIndex& index) override;
+
+    Status
+    GetIndexProgress(std::string& result) override;
+
+    Status
+    GetIndexRowCount(const std::string& table_id, uint64_t& indexed_rows, uint64_t& total_rows) override;
+
+    Status
+    AdviseIndex(const std::string& table_id, double target_recall, int64_t topk, IndexAdvice& advice) override;
+
     Status
     DescribeIndex(const std::string& table_id, TableIndex& index) override;
 
@@ -112,34 +143,101 @@ class DBImpl : public DB {
                   const std::vector<std::string>& file_ids, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
                   const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) override;
 
+    Status
+    QueryByRange(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                 const std::vector<std::string>& partition_tags, float radius, uint64_t max_results, uint64_t nprobe,
+                 const VectorsData& vectors, const meta::DatesT& dates, ResultIds& result_ids,
+                 ResultDistances& result_distances) override;
+
+    Status
+    QueryExact(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+               const std::vector<std::string>& partition_tags, uint64_t k, const VectorsData& vectors,
+               ResultIds& result_ids, ResultDistances& result_distances) override;
+
+    Status
+    GetSearchFiles(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                   meta::TableFilesSchema& files) override;
+
+    Status
+    ApplyMetaChanges(const std::vector<meta::MetaChange>& changes, bool complete) override;
+
     Status
     Size(uint64_t& result) override;
 
+    Status
+    Flush(const std::vector<std::string>& table_ids) override;
+
+    Status
+    ExportTable(const std::string& table_id, const std::string& path) override;
+
+    Status
+    ImportTable(const std::string& path, const std::string& table_id) override;
+
  private:
     Status
     QueryAsync(const std::shared_ptr<server::Context>& context, const std::string& table_id,
                const meta::TableFilesSchema& files, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
                ResultIds& result_ids, ResultDistances& result_distances);
 
+    Status
+    QueryMemTableFiles(const std::shared_ptr<server::Context>& context,
+                       const std::vector<MemTableFilePtr>& mem_table_files, const meta::TableFilesSchema& files,
+                       const meta::DatesT& dates, uint64_t k, const VectorsData& vectors, ResultIds& result_ids,
+                       ResultDistances& result_distances);
+
     void
     BackgroundTimerTask();
     void
     WaitMergeFileFinish();
     void
     WaitBuildIndexFinish();
+    void
+    WaitCleanUpFinish();
 
     void
     StartMetricTask();
 
+    void
+    StartFlushTask();
+
     void
     StartCompactionTask();
+
+    void
+    StartCacheManifestTask();
+    Status
+    SaveCacheManifest();
+    void
+    BackgroundCacheWarmUp();
+
+    Status
+    SaveCacheQuotas();
+    void
+    LoadCacheQuotas();
+
     Status
     MergeFiles(const std::string& table_id, const meta::DateT& date, const meta::TableFilesSchema& files);
     Status
     BackgroundMergeFiles(const std::string& table_id);
     void
+    BackgroundMergeGroup(const std::string& table_id, const meta::DateT& date, const meta::TableFilesSchema& files);
+    void
     BackgroundCompaction(std::set<std::string> table_ids);
 
+    // with the compress archive type, files past the archive days are kept as pq codes, their raw vectors dropped
+    void
+    CompressArchiveFiles();
+
+    // file is the one searched, raw_file the one its vectors are read from, an index file is built from its backup
+    Status
+    CompressArchiveFile(const meta::TableSchema& table_schema, const meta::TableFileSchema& file,
+                        const meta::TableFileSchema& raw_file);
+
+    void
+    StartCleanUpTask();
+    void
+    BackgroundCleanUp();
+
     void
     StartBuildIndexTask(bool force = false);
     void
@@ -148,6 +246,15 @@ class DBImpl : public DB {
     Status
     SyncMemData(std::set<std::string>& sync_table_ids);
 
+    Status
+    SyncMemData(const std::set<std::string>& target_table_ids, std::set<std::string>& sync_table_ids);
+
+    Status
+    RecoverFromWal();
+
+    Status
+    SerializeBulkFile(meta::TableFileSchema& file_schema, const VectorsData& vectors, uint64_t offset, uint64_t count);
+
     Status
     GetFilesToBuildIndex(const std::string& table_id, const std::vector<int>& file_types,
                          meta::TableFilesSchema& files);
@@ -156,6 +263,10 @@ class DBImpl : public DB {
     GetFilesToSearch(const std::string& table_id, const std::vector<size_t>& file_ids, const meta::DatesT& dates,
                      meta::TableFilesSchema& files);
 
+    // files of several tables by one meta query, e.g. a table and all its partitions
+    Status
+    GetFilesToSearch(const std::set<std::string>& table_ids, const meta::DatesT& dates, meta::TableFilesSchema& files);
+
     Status
     GetPartitionsByTags(const std::string& table_id, const std::vector<std::string>& partition_tags,
                         std::set<std::string>& partition_name_array);
@@ -166,12 +277,51 @@ class DBImpl : public DB {
     Status
     UpdateTableIndexRecursively(const std::string& table_id, const TableIndex& index);
 
+    // the table index is changed with the index files kept, each is searched until its segment is rebuilt from the
+    // backup file
+    Status
+    ReplaceTableIndexRecursively(const std::string& table_id, const TableIndex& index);
+
+    bool
+    CanReplaceIndexRecursively(const std::string& table_id, const TableIndex& index);
+
+    // backup files of the segments whose index file is of another type than the table index, each mapped to the
+    // index file it replaces once built; fails if an index file has no backup file to be rebuilt from
+    Status
+    GetFilesToReplaceIndex(const meta::TableSchema& table_schema, meta::TableFilesSchema& backup_files,
+                           std::map<size_t, meta::TableFileSchema>& replaced_files);
+
     Status
     BuildTableIndexRecursively(const std::string& table_id, const TableIndex& index);
 
     Status
     DropTableIndexRecursively(const std::string& table_id);
 
+    // rows in index files and rows of files to be built, of the table and its partitions, files_to_build counts
+    // the files being merged too
+    Status
+    CountIndexRowsRecursively(const std::string& table_id, uint64_t& indexed_rows, uint64_t& rows_to_build,
+                              uint64_t& files_to_build);
+
+    // index creation of the table is kept in meta until all its files are built
+    Status
+    SetIndexPending(const std::string& table_id, bool pending);
+
+    // raw files of the tables with an index creation pending are set to be built, return the tables,
+    // a table with raw files being merged is left to a later round
+    void
+    QueuePendingIndexFiles(std::vector<std::string>& table_ids);
+
+    bool
+    HasMergingFiles(const std::string& table_id);
+
+    // rate of a creation is measured from its start, a creation going on already is left as it is
+    void
+    StartIndexProgress(const std::string& table_id);
+
+    void
+    FinishIndexProgress(const std::string& table_id, const Status& status);
+
     Status
     GetTableRowCountRecursively(const std::string& table_id, uint64_t& row_count);
 
@@ -181,21 +331,60 @@ class DBImpl : public DB {
     std::atomic<bool> initialized_;
 
     std::thread bg_timer_thread_;
+    std::thread bg_warmup_thread_;
 
     meta::MetaPtr meta_ptr_;
     MemManagerPtr mem_mgr_;
     std::mutex mem_serialize_mutex_;
 
+    std::shared_ptr<AtomicIDGenerator> id_generator_;
+
+    wal::WalManagerPtr wal_mgr_;
+
     ThreadPool compact_thread_pool_;
     std::mutex compact_result_mutex_;
     std::list<std::future<void>> compact_thread_results_;
     std::set<std::string> compact_table_ids_;
 
+    // merges picked by the compaction thread run here, a large one doesn't hold up those of other tables and dates
+    ThreadPool merge_thread_pool_;
+    std::mutex merge_result_mutex_;
+    std::list<std::future<void>> merge_thread_results_;
+    std::set<size_t> merging_file_ids_;
+
     ThreadPool index_thread_pool_;
     std::mutex index_result_mutex_;
     std::list<std::future<void>> index_thread_results_;
 
+    // expired files are deleted by a worker of their own, a large drop doesn't hold up merging
+    ThreadPool clean_thread_pool_;
+    std::mutex clean_result_mutex_;
+    std::list<std::future<void>> clean_thread_results_;
+
     std::mutex build_index_mutex_;
+    std::set<std::string> to_index_tables_;  // tables with a to_index backlog in the last round, build_index_mutex_
+
+    struct PreloadState {
+        uint64_t total_files_ = 0;
+        uint64_t loaded_files_ = 0;
+        int64_t total_size_ = 0;
+        int64_t loaded_size_ = 0;
+        bool finished_ = false;
+    };
+    std::mutex preload_mutex_;
+    std::map<std::string, PreloadState> preload_states_;
+
+    struct IndexProgress {
+        std::chrono::steady_clock::time_point start_time_;
+        uint64_t start_indexed_rows_ = 0;
+        bool finished_ = false;
+        std::string error_;
+    };
+    std::mutex index_progress_mutex_;
+    std::map<std::string, IndexProgress> index_progresses_;
+
+    std::mutex cache_quota_mutex_;
+    std::map<std::string, cache::CacheQuota> cache_quotas_;
 
     IndexFailedChecker index_failed_checker_;
     OngoingFileChecker ongoing_files_checker_;
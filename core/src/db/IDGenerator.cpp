@@ -10,11 +10,16 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/IDGenerator.h"
+#include "utils/Log.h"
 
 #include <assert.h>
 #include <fiu-local.h>
+#include <stdio.h>
+#include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <iostream>
+#include <numeric>
 
 namespace milvus {
 namespace engine {
@@ -56,5 +61,80 @@ SimpleIDGenerator::GetNextIDNumbers(size_t n, IDNumbers& ids) {
     NextIDNumbers(n, ids);
 }
 
+constexpr size_t AtomicIDGenerator::MAX_IDS_PER_MICRO;
+constexpr IDNumber AtomicIDGenerator::HIGH_WATER_STEP;
+
+AtomicIDGenerator::AtomicIDGenerator(const std::string& high_water_path)
+    : high_water_path_(high_water_path), next_id_(0), high_water_(0) {
+}
+
+Status
+AtomicIDGenerator::Init() {
+    IDNumber high_water = 0;
+    std::ifstream file(high_water_path_);
+    if (file.is_open()) {
+        file >> high_water;
+    }
+
+    // ids generated by clock before are all below current time
+    auto now = std::chrono::system_clock::now();
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+    IDNumber seed = std::max<IDNumber>(micros * MAX_IDS_PER_MICRO, high_water);
+
+    next_id_.store(seed);
+    high_water_.store(seed);
+    ENGINE_LOG_DEBUG << "Id generator starts from " << seed << ", persisted high water: " << high_water;
+    return Status::OK();
+}
+
+IDNumber
+AtomicIDGenerator::GetNextIDNumber() {
+    return ReserveIDNumbers(1);
+}
+
+void
+AtomicIDGenerator::GetNextIDNumbers(size_t n, IDNumbers& ids) {
+    ids.resize(n);
+    std::iota(ids.begin(), ids.end(), ReserveIDNumbers(n));
+}
+
+IDNumber
+AtomicIDGenerator::ReserveIDNumbers(size_t n) {
+    IDNumber first = next_id_.fetch_add(n);
+    IDNumber end = first + n;
+    if (end <= high_water_.load()) {
+        return first;
+    }
+
+    // the range crosses the mark, move it ahead before anyone uses the range
+    std::lock_guard<std::mutex> lock(high_water_mutex_);
+    if (end > high_water_.load()) {
+        IDNumber high_water = end + HIGH_WATER_STEP;
+        auto status = PersistHighWater(high_water);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << status.message();
+        }
+        high_water_.store(high_water);
+    }
+    return first;
+}
+
+Status
+AtomicIDGenerator::PersistHighWater(IDNumber high_water) {
+    std::string temp_path = high_water_path_ + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::out | std::ios::trunc);
+        file << high_water;
+        file.close();
+        if (file.fail()) {
+            return Status(DB_ERROR, "Failed to write id high water mark: " + temp_path);
+        }
+    }
+    if (rename(temp_path.c_str(), high_water_path_.c_str()) != 0) {
+        return Status(DB_ERROR, "Failed to rename id high water mark: " + high_water_path_);
+    }
+    return Status::OK();
+}
+
 }  // namespace engine
 }  // namespace milvus
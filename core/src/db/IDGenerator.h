@@ -12,8 +12,12 @@
 #pragma once
 
 #include "Types.h"
+#include "utils/Status.h"
 
+#include <atomic>
 #include <cstddef>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace milvus {
@@ -47,5 +51,42 @@ class SimpleIDGenerator : public IDGenerator {
     static constexpr size_t MAX_IDS_PER_MICRO = 1000;
 };  // SimpleIDGenerator
 
+// Hand out id ranges from an atomic counter, a batch of any size costs one fetch_add.
+//
+// The counter starts above both the clock based ids of SimpleIDGenerator and a high water mark persisted
+// in a file. The mark is moved ahead in big steps before any id beyond it is returned, so ids are never
+// reused after restart even if the clock steps back.
+class AtomicIDGenerator : public IDGenerator {
+ public:
+    explicit AtomicIDGenerator(const std::string& high_water_path);
+    ~AtomicIDGenerator() override = default;
+
+    // read the persisted high water mark and seed the counter
+    Status
+    Init();
+
+    IDNumber
+    GetNextIDNumber() override;
+
+    void
+    GetNextIDNumbers(size_t n, IDNumbers& ids) override;
+
+    // reserve n consecutive ids, return the first one
+    IDNumber
+    ReserveIDNumbers(size_t n);
+
+ private:
+    Status
+    PersistHighWater(IDNumber high_water);
+
+    static constexpr size_t MAX_IDS_PER_MICRO = 1000;
+    static constexpr IDNumber HIGH_WATER_STEP = 100000000;
+
+    const std::string high_water_path_;
+    std::atomic<IDNumber> next_id_;
+    std::atomic<IDNumber> high_water_;  // ids below it are persisted as used
+    std::mutex high_water_mutex_;
+};  // AtomicIDGenerator
+
 }  // namespace engine
 }  // namespace milvus
@@ -0,0 +1,331 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/IndexAdvisor.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "utils/Log.h"
+#include "wrapper/ConfAdapter.h"
+#include "wrapper/ConfAdapterMgr.h"
+#include "wrapper/VecIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <unordered_set>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+// queries held out of the sample, the rest is what the candidates are built on
+constexpr int64_t ADVISE_QUERY_ROWS = 100;
+constexpr int64_t ADVISE_MIN_BASE_ROWS = 1000;
+
+// nlist of a file of a million rows, about 4 to 16 times its square root, files of other sizes get lists of as many
+// rows; the last is the default nlist of a table
+const std::vector<int64_t> NLISTS = {4096, 8192, 16384};
+constexpr int64_t DEFAULT_NLIST = 16384;
+
+const std::vector<int64_t> HNSW_EFS = {16, 32, 64, 128, 256, 512};
+
+// a configuration this much slower than the fastest one is still taken if it is smaller
+constexpr double LATENCY_TOLERANCE = 1.1;
+
+double
+ElapsedUs(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+knowhere::METRICTYPE
+KnowhereMetric(MetricType metric_type) {
+    return (metric_type == MetricType::IP) ? knowhere::METRICTYPE::IP : knowhere::METRICTYPE::L2;
+}
+
+}  // namespace
+
+IndexAdvisor::IndexAdvisor(int64_t dimension, MetricType metric_type, int64_t segment_rows)
+    : dimension_(dimension), metric_type_(metric_type), segment_rows_(std::max<int64_t>(segment_rows, 1)) {
+}
+
+Status
+IndexAdvisor::Advise(const std::vector<float>& samples, double target_recall, int64_t topk, IndexAdvice& advice) {
+    if (metric_type_ != MetricType::L2 && metric_type_ != MetricType::IP) {
+        return Status(DB_ERROR, "Index advice is only supported by float vectors");
+    }
+    if (target_recall <= 0.0 || target_recall > 1.0) {
+        return Status(DB_ERROR, "Target recall should be in (0, 1]");
+    }
+    if (dimension_ <= 0 || topk <= 0 || samples.size() % dimension_ != 0) {
+        return Status(DB_ERROR, "Invalid samples to advise an index");
+    }
+
+    int64_t rows = samples.size() / dimension_;
+    nq_ = std::min(ADVISE_QUERY_ROWS, rows / 10);
+    base_rows_ = rows - nq_;
+    if (base_rows_ < ADVISE_MIN_BASE_ROWS) {
+        return Status(DB_ERROR, "Too few vectors to advise an index: " + std::to_string(rows));
+    }
+    target_recall_ = target_recall;
+    topk_ = std::min(topk, base_rows_);
+
+    // queries are spread over the sample, which is taken file by file
+    base_.clear();
+    queries_.clear();
+    base_.reserve(base_rows_ * dimension_);
+    queries_.reserve(nq_ * dimension_);
+    int64_t query_step = rows / nq_;
+    for (int64_t i = 0; i < rows; i++) {
+        auto& to = (i % query_step == 0 && i / query_step < nq_) ? queries_ : base_;
+        to.insert(to.end(), samples.begin() + i * dimension_, samples.begin() + (i + 1) * dimension_);
+    }
+    base_ids_.resize(base_rows_);
+    for (int64_t i = 0; i < base_rows_; i++) {
+        base_ids_[i] = i;
+    }
+
+    advice = IndexAdvice();
+    advice.target_recall_ = target_recall_;
+    advice.segment_rows_ = segment_rows_;
+    advice.sample_rows_ = rows;
+
+    // the brute force search gives the exact results, and is the fallback reaching any recall
+    IndexTrial exact;
+    exact.engine_type_ = EngineType::FAISS_IDMAP;
+    exact.nlist_ = DEFAULT_NLIST;
+    exact.recall_ = 1.0;
+    exact.reached_ = true;
+    {
+        auto index = GetVecIndexFactory(IndexType::FAISS_IDMAP);
+        TempMetaConf temp_conf;
+        temp_conf.dim = dimension_;
+        temp_conf.k = topk_;
+        temp_conf.metric_type = KnowhereMetric(metric_type_);
+        auto adapter = AdapterMgr::GetInstance().GetAdapter(IndexType::FAISS_IDMAP);
+        auto status = index->BuildAll(base_rows_, base_.data(), base_ids_.data(), adapter->Match(temp_conf));
+        if (!status.ok()) {
+            return status;
+        }
+
+        std::vector<float> distances(nq_ * topk_);
+        truth_.resize(nq_ * topk_);
+        auto start = std::chrono::steady_clock::now();
+        status = index->Search(nq_, queries_.data(), distances.data(), truth_.data(),
+                               adapter->MatchSearch(temp_conf, IndexType::FAISS_IDMAP));
+        if (!status.ok()) {
+            return status;
+        }
+        exact_query_us_ = ElapsedUs(start) / nq_ * segment_rows_ / base_rows_;
+    }
+    exact.query_us_ = exact_query_us_;
+    exact.memory_ = Memory(EngineType::FAISS_IDMAP, 0);
+    advice.trials_.push_back(exact);
+
+    // candidates matched to the same nlist of a segment are tried once
+    std::unordered_set<int64_t> segment_nlists;
+    for (auto engine_type : {EngineType::FAISS_IVFFLAT, EngineType::FAISS_IVFSQ8}) {
+        segment_nlists.clear();
+        for (int64_t nlist : NLISTS) {
+            if (!segment_nlists.insert(SegmentNlist(nlist)).second) {
+                continue;
+            }
+            IndexTrial trial;
+            auto status = TryIvf(engine_type, nlist, trial);
+            if (!status.ok()) {
+                ENGINE_LOG_WARNING << "Index advice failed to try type " << (int)engine_type << " nlist " << nlist
+                                   << ": " << status.message();
+                continue;
+            }
+            advice.trials_.push_back(trial);
+        }
+    }
+
+    IndexTrial hnsw;
+    auto status = TryHnsw(hnsw);
+    if (status.ok()) {
+        advice.trials_.push_back(hnsw);
+    } else {
+        ENGINE_LOG_WARNING << "Index advice failed to try HNSW: " << status.message();
+    }
+
+    double fastest = exact.query_us_;
+    for (auto& trial : advice.trials_) {
+        if (trial.reached_) {
+            fastest = std::min(fastest, trial.query_us_);
+        }
+    }
+    advice.best_ = exact;
+    for (auto& trial : advice.trials_) {
+        if (trial.reached_ && trial.query_us_ <= fastest * LATENCY_TOLERANCE &&
+            (advice.best_.query_us_ > fastest * LATENCY_TOLERANCE || trial.memory_ < advice.best_.memory_)) {
+            advice.best_ = trial;
+        }
+    }
+
+    ENGINE_LOG_DEBUG << "Index advice of " << advice.trials_.size() << " trials: type "
+                     << (int)advice.best_.engine_type_ << " nlist " << advice.best_.nlist_ << " nprobe "
+                     << advice.best_.nprobe_ << " recall " << advice.best_.recall_;
+    return Status::OK();
+}
+
+int64_t
+IndexAdvisor::SegmentNlist(int64_t nlist) const {
+    TempMetaConf temp_conf;
+    temp_conf.dim = dimension_;
+    temp_conf.size = segment_rows_;
+    temp_conf.nlist = nlist;
+    auto conf = AdapterMgr::GetInstance().GetAdapter(IndexType::FAISS_IVFFLAT_CPU)->Match(temp_conf);
+    return std::max<int64_t>(1, std::static_pointer_cast<knowhere::IVFCfg>(conf)->nlist);
+}
+
+Status
+IndexAdvisor::TryIvf(EngineType engine_type, int64_t nlist, IndexTrial& trial) {
+    auto index_type =
+        (engine_type == EngineType::FAISS_IVFSQ8) ? IndexType::FAISS_IVFSQ8_CPU : IndexType::FAISS_IVFFLAT_CPU;
+    auto index = GetVecIndexFactory(index_type);
+    if (index == nullptr) {
+        return Status(DB_ERROR, "Unsupported index type");
+    }
+
+    // the lists of the sample hold as many rows as those of a segment, so the fraction probed is the same
+    int64_t segment_nlist = SegmentNlist(nlist);
+    int64_t sample_nlist = std::max<int64_t>(1, segment_nlist * base_rows_ / segment_rows_);
+    sample_nlist = std::min(sample_nlist, base_rows_);
+
+    TempMetaConf temp_conf;
+    temp_conf.dim = dimension_;
+    temp_conf.size = base_rows_;
+    temp_conf.metric_type = KnowhereMetric(metric_type_);
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(index_type);
+    auto conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(adapter->Match(temp_conf));
+    if (conf == nullptr) {
+        return Status(DB_ERROR, "Unexpected config of ivf index");
+    }
+    conf->nlist = sample_nlist;
+    auto status = index->BuildAll(base_rows_, base_.data(), base_ids_.data(), conf);
+    if (!status.ok()) {
+        return status;
+    }
+
+    trial.engine_type_ = engine_type;
+    trial.nlist_ = nlist;
+    trial.memory_ = Memory(engine_type, segment_nlist);
+
+    std::vector<float> distances(nq_ * topk_);
+    std::vector<int64_t> ids(nq_ * topk_);
+    for (int64_t nprobe = 1;; nprobe = std::min(nprobe * 2, sample_nlist)) {
+        TempMetaConf search_conf;
+        search_conf.k = topk_;
+        search_conf.nprobe = nprobe;
+        auto start = std::chrono::steady_clock::now();
+        status = index->Search(nq_, queries_.data(), distances.data(), ids.data(),
+                               adapter->MatchSearch(search_conf, index_type));
+        if (!status.ok()) {
+            return status;
+        }
+        trial.query_us_ = ElapsedUs(start) / nq_ * segment_rows_ / base_rows_;
+        trial.recall_ = Recall(ids);
+        trial.nprobe_ = std::min(segment_nlist, (nprobe * segment_nlist + sample_nlist - 1) / sample_nlist);
+        if (trial.recall_ >= target_recall_) {
+            trial.reached_ = true;
+            break;
+        }
+        if (nprobe >= sample_nlist) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+Status
+IndexAdvisor::TryHnsw(IndexTrial& trial) {
+    auto index = GetVecIndexFactory(IndexType::HNSW);
+    if (index == nullptr) {
+        return Status(DB_ERROR, "Unsupported index type");
+    }
+
+    TempMetaConf temp_conf;
+    temp_conf.dim = dimension_;
+    temp_conf.metric_type = KnowhereMetric(metric_type_);
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(IndexType::HNSW);
+    auto conf = std::dynamic_pointer_cast<knowhere::HNSWCfg>(adapter->Match(temp_conf));
+    if (conf == nullptr) {
+        return Status(DB_ERROR, "Unexpected config of hnsw index");
+    }
+    auto status = index->BuildAll(base_rows_, base_.data(), base_ids_.data(), conf);
+    if (!status.ok()) {
+        return status;
+    }
+
+    trial.engine_type_ = EngineType::HNSW;
+    trial.nlist_ = DEFAULT_NLIST;
+    // vectors, ids and the links of the bottom layer, upper layers are small
+    trial.memory_ = segment_rows_ * (dimension_ * sizeof(float) + sizeof(int64_t) + 2 * conf->M * sizeof(int32_t));
+
+    // a graph search visits about log(rows) nodes, rather than a fixed part of them
+    double scale = std::log(std::max<int64_t>(segment_rows_, 2)) / std::log(std::max<int64_t>(base_rows_, 2));
+    std::vector<float> distances(nq_ * topk_);
+    std::vector<int64_t> ids(nq_ * topk_);
+    for (int64_t ef : HNSW_EFS) {
+        if (ef < topk_ && ef != HNSW_EFS.back()) {
+            continue;
+        }
+        TempMetaConf search_conf;
+        search_conf.k = topk_;
+        search_conf.nprobe = ef;
+        auto start = std::chrono::steady_clock::now();
+        status = index->Search(nq_, queries_.data(), distances.data(), ids.data(),
+                               adapter->MatchSearch(search_conf, IndexType::HNSW));
+        if (!status.ok()) {
+            return status;
+        }
+        trial.query_us_ = ElapsedUs(start) / nq_ * scale;
+        trial.recall_ = Recall(ids);
+        trial.nprobe_ = ef;
+        if (trial.recall_ >= target_recall_) {
+            trial.reached_ = true;
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+double
+IndexAdvisor::Recall(const std::vector<int64_t>& ids) const {
+    int64_t found = 0, total = 0;
+    for (int64_t i = 0; i < nq_; i++) {
+        auto begin = truth_.begin() + i * topk_;
+        std::unordered_set<int64_t> expected(begin, begin + topk_);
+        expected.erase(-1);
+        total += expected.size();
+        for (int64_t j = 0; j < topk_; j++) {
+            found += expected.count(ids[i * topk_ + j]);
+        }
+    }
+    return total > 0 ? static_cast<double>(found) / total : 1.0;
+}
+
+int64_t
+IndexAdvisor::Memory(EngineType engine_type, int64_t segment_nlist) const {
+    int64_t centroids = segment_nlist * dimension_ * sizeof(float);
+    switch (engine_type) {
+        case EngineType::FAISS_IVFFLAT:
+            return segment_rows_ * (dimension_ * sizeof(float) + sizeof(int64_t)) + centroids;
+        case EngineType::FAISS_IVFSQ8:
+            return segment_rows_ * (dimension_ + sizeof(int64_t)) + centroids;
+        default:
+            return segment_rows_ * (dimension_ * sizeof(float) + sizeof(int64_t));
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
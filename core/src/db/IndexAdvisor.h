@@ -0,0 +1,92 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/engine/ExecutionEngine.h"
+#include "utils/Status.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// one index configuration tried by IndexAdvisor, nlist and nprobe are those of a full segment
+struct IndexTrial {
+    EngineType engine_type_ = EngineType::INVALID;
+    int64_t nlist_ = 0;        // passed to CreateIndex, unused by types without lists
+    int64_t nprobe_ = 0;       // least one reaching the target recall, ef of HNSW, 0 for an exhaustive search
+    double recall_ = 0.0;      // at nprobe, or at the largest nprobe tried if none reaches the target
+    double query_us_ = 0.0;    // estimated per query on a full segment
+    int64_t memory_ = 0;       // estimated bytes of a full segment
+    bool reached_ = false;
+};
+
+struct IndexAdvice {
+    double target_recall_ = 0.0;
+    int64_t segment_rows_ = 0;
+    int64_t sample_rows_ = 0;
+    IndexTrial best_;
+    std::vector<IndexTrial> trials_;
+};
+
+/*
+ * Pick the index type, nlist and nprobe of a table by trials on vectors sampled from it.
+ * Each candidate is built on the sample and searched by queries held out of it, and its recall is measured against
+ * a brute force search. An ivf index is tried with as many rows per list as a full segment has, so the fraction of
+ * lists to probe carries over to the segment. Latency measured on the sample is scaled by the rows of a segment.
+ * The best configuration reaches the target recall at the least latency, and a smaller one is preferred if it is
+ * nearly as fast.
+ */
+class IndexAdvisor {
+ public:
+    IndexAdvisor(int64_t dimension, MetricType metric_type, int64_t segment_rows);
+
+    // samples are float rows of the table, topk is the k the recall is measured at
+    Status
+    Advise(const std::vector<float>& samples, double target_recall, int64_t topk, IndexAdvice& advice);
+
+ private:
+    // nlist a segment is built with for the nlist passed to CreateIndex, small segments get fewer lists
+    int64_t
+    SegmentNlist(int64_t nlist) const;
+
+    Status
+    TryIvf(EngineType engine_type, int64_t nlist, IndexTrial& trial);
+
+    Status
+    TryHnsw(IndexTrial& trial);
+
+    double
+    Recall(const std::vector<int64_t>& ids) const;
+
+    int64_t
+    Memory(EngineType engine_type, int64_t segment_nlist) const;
+
+ private:
+    int64_t dimension_;
+    MetricType metric_type_;
+    int64_t segment_rows_;
+
+    double target_recall_ = 0.0;
+    int64_t topk_ = 0;
+    int64_t base_rows_ = 0;
+    int64_t nq_ = 0;
+    std::vector<float> base_;
+    std::vector<float> queries_;
+    std::vector<int64_t> base_ids_;
+    std::vector<int64_t> truth_;  // ids found by the brute force search, topk_ per query
+    double exact_query_us_ = 0.0;
+};
+
+}  // namespace engine
+}  // namespace milvus
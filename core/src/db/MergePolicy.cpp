@@ -0,0 +1,72 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/MergePolicy.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace engine {
+
+TieredMergePolicy::TieredMergePolicy(uint64_t trigger_number, uint64_t max_fan_in, uint64_t tier_ratio,
+                                     uint64_t min_tier_size)
+    : trigger_number_(std::max<uint64_t>(trigger_number, 2)),
+      max_fan_in_(std::max<uint64_t>(max_fan_in, 2)),
+      tier_ratio_(std::max<uint64_t>(tier_ratio, 1)),
+      min_tier_size_(min_tier_size) {
+}
+
+std::vector<meta::TableFilesSchema>
+TieredMergePolicy::Pick(const meta::TableFilesSchema& files) const {
+    meta::TableFilesSchema sorted_files = files;
+    std::stable_sort(sorted_files.begin(), sorted_files.end(),
+                     [](const meta::TableFileSchema& a, const meta::TableFileSchema& b) {
+                         return a.file_size_ < b.file_size_;
+                     });
+
+    std::vector<meta::TableFilesSchema> groups;
+    size_t tier_begin = 0;
+    while (tier_begin < sorted_files.size()) {
+        uint64_t tier_limit = std::max<uint64_t>(sorted_files[tier_begin].file_size_, min_tier_size_) * tier_ratio_;
+        size_t tier_end = tier_begin;
+        while (tier_end < sorted_files.size() && sorted_files[tier_end].file_size_ <= tier_limit) {
+            ++tier_end;
+        }
+
+        // a tier with too few files waits for more, a group closed by fan-in or size is merged anyway
+        meta::TableFilesSchema group;
+        uint64_t group_size = 0;
+        if (tier_end - tier_begin >= trigger_number_) {
+            for (size_t i = tier_begin; i < tier_end; ++i) {
+                auto& file = sorted_files[i];
+                group.push_back(file);
+                group_size += file.file_size_;
+                if (group.size() >= max_fan_in_ || group_size >= (uint64_t)file.index_file_size_) {
+                    if (group.size() >= 2) {
+                        groups.emplace_back(std::move(group));
+                    }
+                    group.clear();
+                    group_size = 0;
+                }
+            }
+            if (group.size() >= trigger_number_) {
+                groups.emplace_back(std::move(group));
+            }
+        }
+
+        tier_begin = tier_end;
+    }
+
+    return groups;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Constants.h"
+#include "db/meta/MetaTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Size-tiered merge: files of a similar size are merged with each other, so a small flushed file is never
+ * rewritten together with a large merged one again and again. A tier holds the files at most tier_ratio times
+ * the size of its smallest file, files under min_tier_size all fall into the first tier. A merge takes at most
+ * max_fan_in files, and stops once the merged size reaches the index file size of the table.
+ */
+class TieredMergePolicy {
+ public:
+    TieredMergePolicy(uint64_t trigger_number, uint64_t max_fan_in, uint64_t tier_ratio = 4,
+                      uint64_t min_tier_size = 16 * ONE_MB);
+
+    // files: raw files of one table and date; return the groups of files to be merged, each into one file
+    std::vector<meta::TableFilesSchema>
+    Pick(const meta::TableFilesSchema& files) const;
+
+ private:
+    uint64_t trigger_number_;
+    uint64_t max_fan_in_;
+    uint64_t tier_ratio_;
+    uint64_t min_tier_size_;
+};
+
+}  // namespace engine
+}  // namespace milvus
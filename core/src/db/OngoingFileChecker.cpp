@@ -10,13 +10,78 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/OngoingFileChecker.h"
+#include "db/Utils.h"
 #include "utils/Log.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 namespace milvus {
 namespace engine {
 
+OngoingFileChecker::SearchEpoch::SearchEpoch(OngoingFileChecker& checker)
+    : checker_(checker), epoch_(utils::GetMicroSecTimeStamp()) {
+    slot_ = checker_.EnterSearchEpoch(epoch_);
+}
+
+OngoingFileChecker::SearchEpoch::~SearchEpoch() {
+    checker_.LeaveSearchEpoch(epoch_, slot_);
+}
+
+OngoingFileChecker::OngoingFileChecker() {
+    for (auto& slot : epoch_slots_) {
+        slot.store(0);
+    }
+}
+
+int64_t
+OngoingFileChecker::EnterSearchEpoch(int64_t epoch) {
+    uint64_t start = next_slot_.fetch_add(1, std::memory_order_relaxed);
+    for (int64_t i = 0; i < EPOCH_SLOTS; ++i) {
+        int64_t slot = (start + i) % EPOCH_SLOTS;
+        int64_t expected = 0;
+        if (epoch_slots_[slot].compare_exchange_strong(expected, epoch)) {
+            return slot;
+        }
+    }
+
+    std::lock_guard<std::mutex> lck(overflow_mutex_);
+    overflow_epochs_.insert(epoch);
+    return -1;
+}
+
+void
+OngoingFileChecker::LeaveSearchEpoch(int64_t epoch, int64_t slot) {
+    if (slot >= 0) {
+        epoch_slots_[slot].store(0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lck(overflow_mutex_);
+    auto iter = overflow_epochs_.find(epoch);
+    if (iter != overflow_epochs_.end()) {
+        overflow_epochs_.erase(iter);
+    }
+}
+
+int64_t
+OngoingFileChecker::OldestSearchEpoch() {
+    int64_t oldest = std::numeric_limits<int64_t>::max();
+    for (auto& slot : epoch_slots_) {
+        int64_t epoch = slot.load();
+        if (epoch > 0) {
+            oldest = std::min(oldest, epoch);
+        }
+    }
+
+    std::lock_guard<std::mutex> lck(overflow_mutex_);
+    if (!overflow_epochs_.empty()) {
+        oldest = std::min(oldest, *overflow_epochs_.begin());
+    }
+    return oldest;
+}
+
 Status
 OngoingFileChecker::MarkOngoingFile(const meta::TableFileSchema& table_file) {
     std::lock_guard<std::mutex> lck(mutex_);
@@ -53,6 +118,11 @@ OngoingFileChecker::UnmarkOngoingFiles(const meta::TableFilesSchema& table_files
 
 bool
 OngoingFileChecker::IsIgnored(const meta::TableFileSchema& schema) {
+    // a search entered before the file is soft-deleted may have listed it
+    if (schema.updated_time_ >= OldestSearchEpoch()) {
+        return true;
+    }
+
     std::lock_guard<std::mutex> lck(mutex_);
 
     auto iter = ongoing_files_.find(schema.table_id_);
@@ -68,6 +138,12 @@ OngoingFileChecker::IsIgnored(const meta::TableFileSchema& schema) {
     }
 }
 
+bool
+OngoingFileChecker::IsTableIgnored(const std::string& table_id) {
+    std::lock_guard<std::mutex> lck(mutex_);
+    return ongoing_files_.find(table_id) != ongoing_files_.end();
+}
+
 Status
 OngoingFileChecker::MarkOngoingFileNoLock(const meta::TableFileSchema& table_file) {
     if (table_file.table_id_.empty() || table_file.file_id_.empty()) {
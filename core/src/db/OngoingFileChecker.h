@@ -15,6 +15,8 @@
 #include "meta/Meta.h"
 #include "utils/Status.h"
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <set>
@@ -23,8 +25,36 @@
 namespace milvus {
 namespace engine {
 
+// Files in use are kept from clean up in two ways:
+// a search enters an epoch, the time it starts, before listing its files and leaves it when done, a file soft-deleted
+// at or after the oldest epoch still entered may be read by that search and is kept, no file needs to be marked;
+// merges and index builds, which run long on a few files, mark the files they read one by one.
 class OngoingFileChecker : public meta::Meta::CleanUpFilter {
  public:
+    // entered for the lifetime of the object, taken by a search before its files are listed
+    class SearchEpoch {
+     public:
+        explicit SearchEpoch(OngoingFileChecker& checker);
+
+        ~SearchEpoch();
+
+        SearchEpoch(const SearchEpoch&) = delete;
+
+        SearchEpoch&
+        operator=(const SearchEpoch&) = delete;
+
+     private:
+        OngoingFileChecker& checker_;
+        int64_t epoch_;
+        int64_t slot_;
+    };
+
+    OngoingFileChecker();
+
+    // start time of the oldest search still running, INT64_MAX if there is none
+    int64_t
+    OldestSearchEpoch();
+
     Status
     MarkOngoingFile(const meta::TableFileSchema& table_file);
 
@@ -40,6 +70,10 @@ class OngoingFileChecker : public meta::Meta::CleanUpFilter {
     bool
     IsIgnored(const meta::TableFileSchema& schema) override;
 
+    // a table is in use while any of its files is marked
+    bool
+    IsTableIgnored(const std::string& table_id) override;
+
  private:
     Status
     MarkOngoingFileNoLock(const meta::TableFileSchema& table_file);
@@ -47,7 +81,21 @@ class OngoingFileChecker : public meta::Meta::CleanUpFilter {
     Status
     UnmarkOngoingFileNoLock(const meta::TableFileSchema& table_file);
 
+    int64_t
+    EnterSearchEpoch(int64_t epoch);
+
+    void
+    LeaveSearchEpoch(int64_t epoch, int64_t slot);
+
  private:
+    // epochs of running searches, a search takes a free slot without any lock, 0 for free slots;
+    // searches finding no free slot are kept in overflow_epochs_
+    static constexpr int64_t EPOCH_SLOTS = 256;
+    std::array<std::atomic<int64_t>, EPOCH_SLOTS> epoch_slots_;
+    std::atomic<uint64_t> next_slot_{0};
+    std::mutex overflow_mutex_;
+    std::multiset<int64_t> overflow_epochs_;
+
     std::mutex mutex_;
     Table2FileRef ongoing_files_;  // table id mapping to (file id mapping to ongoing ref-count)
 };
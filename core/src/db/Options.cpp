@@ -80,7 +80,7 @@ ArchiveConf::ParseCritirias(const std::string& criterias) {
 
 void
 ArchiveConf::ParseType(const std::string& type) {
-    if (type != "delete" && type != "swap") {
+    if (type != "delete" && type != "swap" && type != ARCHIVE_TYPE_COMPRESS) {
         std::string msg = "Invalid argument: type='" + type + "'";
         throw InvalidArgumentException(msg);
     }
@@ -25,6 +25,8 @@ class Env;
 
 static const char* ARCHIVE_CONF_DISK = "disk";
 static const char* ARCHIVE_CONF_DAYS = "days";
+// files past the days criteria are compressed to pq codes instead of deleted
+static const char* ARCHIVE_TYPE_COMPRESS = "compress";
 
 struct ArchiveConf {
     using CriteriaT = std::map<std::string, int64_t>;
@@ -61,6 +63,13 @@ struct DBMetaOptions {
     ArchiveConf archive_conf_ = ArchiveConf("delete");
 };  // DBMetaOptions
 
+// A table is flushed once any enabled limit is reached, 0 disables the limit.
+// Small limits make inserted vectors searchable sooner, large ones keep segments big for bulk loading.
+struct FlushPolicy {
+    uint64_t max_buffer_size_ = 0;  // bytes buffered in memory
+    int64_t max_age_ms_ = 1000;     // age of the oldest buffered vector
+};  // FlushPolicy
+
 struct DBOptions {
     typedef enum { SINGLE = 0, CLUSTER_READONLY, CLUSTER_WRITABLE } MODE;
 
@@ -70,6 +79,19 @@ struct DBOptions {
 
     size_t insert_buffer_size_ = 4 * ONE_GB;
     bool insert_cache_immediately_ = false;
+    size_t flush_thread_num_ = 4;    // tables are serialized in parallel by these threads
+    size_t preload_thread_num_ = 4;  // files of a preloaded table are loaded in parallel by these threads
+    size_t merge_thread_num_ = 2;    // files of different tables and dates are merged in parallel by these threads
+    size_t merge_max_fan_in_ = 16;   // most files merged into one at a time
+
+    // a raw file is merged on its own once this part of its vectors is deleted
+    double delete_compact_ratio_ = 0.2;
+
+    FlushPolicy flush_policy_;                                 // applied to tables without their own policy
+    std::map<std::string, FlushPolicy> table_flush_policies_;  // table id -> policy
+
+    bool wal_enable_ = false;
+    std::string wal_path_;
 };  // Options
 
 }  // namespace engine
@@ -0,0 +1,109 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/SearchEffortController.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+// weight of the latest query in the cost model, a small one filters out the noise of single queries
+constexpr double COST_SMOOTH_FACTOR = 0.2;
+
+}  // namespace
+
+SearchEffortController::SearchEffortController() {
+    server::Config& config = server::Config::GetInstance();
+    int64_t budget_ms = 0;
+    config.GetEngineConfigSearchLatencyBudget(budget_ms);
+    budget_ms_ = budget_ms;
+}
+
+SearchEffortController&
+SearchEffortController::GetInstance() {
+    static SearchEffortController controller;
+    return controller;
+}
+
+void
+SearchEffortController::SetLatencyBudget(int64_t budget_ms) {
+    budget_ms_ = std::max<int64_t>(budget_ms, 0);
+}
+
+int64_t
+SearchEffortController::LatencyBudget() const {
+    return budget_ms_;
+}
+
+bool
+SearchEffortController::Enabled() const {
+    return budget_ms_ > 0;
+}
+
+uint64_t
+SearchEffortController::AdjustNprobe(const std::string& table_id, uint64_t nq, uint64_t nprobe) {
+    if (!Enabled() || nq == 0 || nprobe <= 1) {
+        return nprobe;
+    }
+
+    double probe_cost_us = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = probe_cost_us_.find(table_id);
+        if (iter == probe_cost_us_.end()) {
+            // no cost learned yet, search as requested
+            return nprobe;
+        }
+        probe_cost_us = iter->second;
+    }
+
+    if (probe_cost_us <= 0.0) {
+        return nprobe;
+    }
+
+    double affordable = static_cast<double>(budget_ms_) * 1000 / (probe_cost_us * nq);
+    uint64_t adjusted = std::min(nprobe, std::max<uint64_t>(1, static_cast<uint64_t>(affordable)));
+    if (adjusted < nprobe) {
+        ENGINE_LOG_DEBUG << "Search of table " << table_id << " degrades nprobe from " << nprobe << " to "
+                         << adjusted << " to fit latency budget " << budget_ms_ << " ms";
+    }
+    return adjusted;
+}
+
+void
+SearchEffortController::UpdateCost(const std::string& table_id, uint64_t nq, uint64_t nprobe, double cost_us) {
+    if (!Enabled() || nq == 0 || nprobe == 0 || cost_us <= 0.0) {
+        return;
+    }
+
+    double probe_cost_us = cost_us / (nq * nprobe);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = probe_cost_us_.find(table_id);
+    if (iter == probe_cost_us_.end()) {
+        probe_cost_us_.insert(std::make_pair(table_id, probe_cost_us));
+    } else {
+        iter->second = COST_SMOOTH_FACTOR * probe_cost_us + (1 - COST_SMOOTH_FACTOR) * iter->second;
+    }
+}
+
+void
+SearchEffortController::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    probe_cost_us_.clear();
+}
+
+}  // namespace engine
+}  // namespace milvus
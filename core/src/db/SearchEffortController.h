@@ -0,0 +1,63 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace milvus {
+namespace engine {
+
+// Pick the search effort (nprobe) of a query so that it is expected to finish within the latency budget.
+// The cost of a table is modeled as the search time per query per probe, it is learned from the cost of recent
+// queries, so the nprobe goes down when the server is under load and recovers once the load is gone.
+class SearchEffortController {
+ public:
+    static SearchEffortController&
+    GetInstance();
+
+    // budget in milliseconds, 0 disables the controller
+    void
+    SetLatencyBudget(int64_t budget_ms);
+
+    int64_t
+    LatencyBudget() const;
+
+    bool
+    Enabled() const;
+
+    // return the nprobe to search with, it never exceeds the requested one
+    uint64_t
+    AdjustNprobe(const std::string& table_id, uint64_t nq, uint64_t nprobe);
+
+    // feed back the cost of a finished query, in microseconds
+    void
+    UpdateCost(const std::string& table_id, uint64_t nq, uint64_t nprobe, double cost_us);
+
+    void
+    Reset();
+
+ private:
+    SearchEffortController();
+
+ private:
+    std::atomic<int64_t> budget_ms_{0};
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, double> probe_cost_us_;  // table id mapping to cost per query per probe
+};  // SearchEffortController
+
+}  // namespace engine
+}  // namespace milvus
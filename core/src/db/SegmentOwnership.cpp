@@ -0,0 +1,77 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/SegmentOwnership.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+SegmentOwnership::SegmentOwnership() {
+    server::Config& config = server::Config::GetInstance();
+    std::string mode;
+    config.GetServerConfigDeployMode(mode);
+    if (mode != "cluster_readonly") {
+        return;
+    }
+
+    std::vector<std::string> nodes;
+    std::string node;
+    config.GetServerConfigReadonlyNodes(nodes);
+    config.GetServerConfigNodeIp(node);
+    SetRing(nodes, node);
+}
+
+SegmentOwnership&
+SegmentOwnership::GetInstance() {
+    static SegmentOwnership ownership;
+    return ownership;
+}
+
+void
+SegmentOwnership::SetRing(const std::vector<std::string>& nodes, const std::string& node) {
+    std::shared_ptr<server::HashRing> ring;
+    if (!nodes.empty() && !node.empty()) {
+        ring = std::make_shared<server::HashRing>(nodes);
+        ENGINE_LOG_INFO << "Node " << node << " caches the files it owns among " << nodes.size() << " readonly nodes";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_ = ring;
+    node_ = node;
+}
+
+bool
+SegmentOwnership::Enabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_ != nullptr;
+}
+
+bool
+SegmentOwnership::Owns(size_t file_id) const {
+    std::shared_ptr<server::HashRing> ring;
+    std::string node;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ring_ == nullptr) {
+            return true;
+        }
+        ring = ring_;
+        node = node_;
+    }
+
+    // same key the routers hash a file with
+    return ring->GetNode(std::to_string(file_id)) == node;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/HashRing.h"
+
+namespace milvus {
+namespace engine {
+
+// Readonly nodes sharing meta and storage split the table files by the hash ring mishards routes searches with,
+// a node only caches the files it owns, so the cache of the cluster adds up instead of every node holding the
+// same hot files. A file not owned is still searched when a search asks for it, it is just not cached.
+class SegmentOwnership {
+ public:
+    static SegmentOwnership&
+    GetInstance();
+
+    // an empty node list or node disables the ownership, then this node owns every file
+    void
+    SetRing(const std::vector<std::string>& nodes, const std::string& node);
+
+    bool
+    Enabled() const;
+
+    bool
+    Owns(size_t file_id) const;
+
+ private:
+    SegmentOwnership();
+
+ private:
+    mutable std::mutex mutex_;
+    std::shared_ptr<server::HashRing> ring_;
+    std::string node_;
+};  // SegmentOwnership
+
+}  // namespace engine
+}  // namespace milvus
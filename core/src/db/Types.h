@@ -37,11 +37,56 @@ struct TableIndex {
     int32_t metric_type_ = (int)MetricType::L2;
 };
 
+// scalar attribute of the vectors, one value per vector in their order
+struct AttrColumn {
+    enum class Type { INT64, DOUBLE };
+
+    Type type_ = Type::INT64;
+    std::vector<int64_t> int_values_;
+    std::vector<double> double_values_;
+
+    size_t
+    Size() const {
+        return (type_ == Type::INT64) ? int_values_.size() : double_values_.size();
+    }
+
+    double
+    Value(size_t i) const {
+        return (type_ == Type::INT64) ? static_cast<double>(int_values_[i]) : double_values_[i];
+    }
+};
+
+using AttrColumns = std::map<std::string, AttrColumn>;
+
+// condition on an attribute, IN matches any of the values and the others compare with the first one
+struct AttrPredicate {
+    enum class Op { EQ, NE, LT, LE, GT, GE, IN };
+
+    std::string name_;
+    Op op_ = Op::EQ;
+    std::vector<double> values_;
+};
+
+// a vector matches when it matches all of them
+using AttrPredicates = std::vector<AttrPredicate>;
+
+// insert time range of a search, [start, end) in microseconds
+struct TimeRange {
+    int64_t start_us_ = 0;
+    int64_t end_us_ = 0;
+};
+
+using TimeRanges = std::vector<TimeRange>;
+
 struct VectorsData {
     uint64_t vector_count_ = 0;
     std::vector<float> float_data_;
     std::vector<uint8_t> binary_data_;
     IDNumbers id_array_;
+    AttrColumns attrs_;           // attributes of inserted vectors
+    int64_t insert_time_us_ = 0;  // when the vectors were inserted, 0 if unknown
+    AttrPredicates predicates_;   // attribute filter of a search
+    TimeRanges time_ranges_;      // a search skips files inserted out of them, all files are searched if empty
 };
 
 using File2ErrArray = std::map<std::string, std::vector<std::string>>;
@@ -10,16 +10,29 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/Utils.h"
+#include "cache/CpuCacheMgr.h"
+#include "db/engine/ExecutionEngine.h"
+#include "db/engine/SegmentAttrs.h"
+#include "db/engine/SegmentIdIndex.h"
+#include "db/engine/SegmentSummary.h"
+#include "db/engine/SegmentTimeRange.h"
+#include "db/engine/SegmentTombstone.h"
 #include "server/Config.h"
+#include "storage/IORateLimiter.h"
 #include "storage/s3/S3ClientWrapper.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
+#include "utils/ThreadPool.h"
 
 #include <fiu-local.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <chrono>
+#include <deque>
+#include <fstream>
 #include <mutex>
 #include <regex>
+#include <unordered_map>
 #include <vector>
 
 namespace milvus {
@@ -29,9 +42,56 @@ namespace utils {
 namespace {
 
 const char* TABLES_FOLDER = "/tables/";
+const char* DISK_INDEX_SUFFIX = ".disk";
+const char* INGEST_INDEX_SUFFIX = ".ingest";
+const char* INDEX_ORIGIN_SUFFIX = ".origin";
 
-uint64_t index_file_counter = 0;
-std::mutex index_file_counter_mutex;
+// threads deleting the files of a clean up, a file system unlinks large files slowly, one at a time leaves the disks
+// idle when a table of thousands of files is dropped
+constexpr size_t DELETE_FILE_THREAD_NUM = 8;
+
+// files placed on a path count as its load for a while, they are being written meanwhile
+constexpr int64_t PLACEMENT_WINDOW_US = 10 * 1000 * 1000;
+
+std::mutex placement_mutex;
+std::unordered_map<std::string, std::deque<int64_t>> path_placements;
+
+// files next to a table file, all written once except the tombstone
+const std::vector<std::string (*)(const std::string&)> SIDE_FILE_PATHS = {
+    SegmentSummary::GetSummaryPath, GetDiskIndexPath, GetIngestIndexPath, GetIndexOriginPath,
+    SegmentAttrs::GetAttrsPath, SegmentTimeRange::GetTimeRangePath, SegmentIdIndex::GetIdIndexPath};
+
+// a hard link shares the blocks of a file written once, taking no time and no space
+Status
+LinkOrCopyFile(const std::string& from, const std::string& to) {
+    boost::system::error_code err;
+    boost::filesystem::remove(to, err);
+    boost::filesystem::create_hard_link(from, to, err);
+    if (!err) {
+        return Status::OK();
+    }
+    boost::filesystem::copy_file(from, to, err);
+    if (err) {
+        return Status(DB_ERROR, "Failed to copy " + from + " to " + to + ": " + err.message());
+    }
+    return Status::OK();
+}
+
+Status
+LinkOrCopySideFiles(const std::string& from_location, const std::string& to_location) {
+    for (auto& get_path : SIDE_FILE_PATHS) {
+        std::string from = get_path(from_location);
+        boost::system::error_code err;
+        if (!boost::filesystem::exists(from, err)) {
+            continue;
+        }
+        auto status = LinkOrCopyFile(from, get_path(to_location));
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
 
 static std::string
 ConstructParentFolder(const std::string& db_path, const meta::TableFileSchema& table_file) {
@@ -40,30 +100,53 @@ ConstructParentFolder(const std::string& db_path, const meta::TableFileSchema& t
     return partition_path;
 }
 
+/*
+ * Files are striped across the primary path and the secondary ones, which are usually on disks of their
+ * own: a new file goes to the path with room for a whole segment which took the fewest files lately,
+ * then to the one with the most free space, so writes and loads spread over all the disks;
+ */
 static std::string
 GetTableFileParentFolder(const DBMetaOptions& options, const meta::TableFileSchema& table_file) {
-    uint64_t path_count = options.slave_paths_.size() + 1;
-    std::string target_path = options.path_;
-    uint64_t index = 0;
-
-    if (meta::TableFileSchema::NEW_INDEX == table_file.file_type_) {
-        // index file is large file and to be persisted permanently
-        // we need to distribute index files to each db_path averagely
-        // round robin according to a file counter
-        std::lock_guard<std::mutex> lock(index_file_counter_mutex);
-        index = index_file_counter % path_count;
-        ++index_file_counter;
-    } else {
-        // for other type files, they could be merged or deleted
-        // so we round robin according to their file id
-        index = table_file.id_ % path_count;
+    if (options.slave_paths_.empty()) {
+        return ConstructParentFolder(options.path_, table_file);
     }
 
-    if (index > 0) {
-        target_path = options.slave_paths_[index - 1];
+    std::vector<std::string> paths = {options.path_};
+    paths.insert(paths.end(), options.slave_paths_.begin(), options.slave_paths_.end());
+
+    // files of a table grow up to its index file size
+    uint64_t need = std::max<uint64_t>(table_file.file_size_, table_file.index_file_size_);
+    int64_t now = GetMicroSecTimeStamp();
+
+    std::lock_guard<std::mutex> lock(placement_mutex);
+    size_t best = 0;
+    bool best_fits = false;
+    size_t best_load = 0;
+    uint64_t best_available = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        boost::system::error_code ec;
+        auto space = boost::filesystem::space(paths[i], ec);
+        uint64_t available = ec ? 0 : space.available;
+        fiu_do_on("GetTableFileParentFolder.primary_full", available = (i == 0) ? 0 : available);
+
+        auto& placements = path_placements[paths[i]];
+        while (!placements.empty() && placements.front() + PLACEMENT_WINDOW_US < now) {
+            placements.pop_front();
+        }
+
+        bool fits = available >= need;
+        size_t load = placements.size();
+        if (i == 0 || (fits && !best_fits) ||
+            (fits == best_fits && (load < best_load || (load == best_load && available > best_available)))) {
+            best = i;
+            best_fits = fits;
+            best_load = load;
+            best_available = available;
+        }
     }
+    path_placements[paths[best]].push_back(now);
 
-    return ConstructParentFolder(target_path, table_file);
+    return ConstructParentFolder(paths[best], table_file);
 }
 
 }  // namespace
@@ -148,14 +231,29 @@ CreateTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_f
     return Status::OK();
 }
 
+Status
+CreateArchiveFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file) {
+    if (options.slave_paths_.empty() || server::Config::GetInstance().GetSnapshot()->s3_enable_) {
+        return Status::OK();
+    }
+
+    std::string parent_path = ConstructParentFolder(options.slave_paths_.back(), table_file);
+    auto status = server::CommonUtil::CreateDirectory(parent_path);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << status.message();
+        return status;
+    }
+
+    table_file.location_ = parent_path + "/" + table_file.file_id_;
+    return Status::OK();
+}
+
 Status
 GetTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file) {
     std::string parent_path = ConstructParentFolder(options.path_, table_file);
     std::string file_path = parent_path + "/" + table_file.file_id_;
 
-    bool s3_enable = false;
-    server::Config& config = server::Config::GetInstance();
-    config.GetStorageConfigS3Enable(s3_enable);
+    bool s3_enable = server::Config::GetInstance().GetSnapshot()->s3_enable_;
     fiu_do_on("GetTableFilePath.enable_s3", s3_enable = true);
     if (s3_enable) {
         /* need not check file existence */
@@ -188,10 +286,168 @@ GetTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file
 Status
 DeleteTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file) {
     utils::GetTableFilePath(options, table_file);
+    storage::IORateLimiter::GetInstance().Request(storage::DELETE_FILE_IO_COST);
     boost::filesystem::remove(table_file.location_);
+    boost::filesystem::remove(SegmentSummary::GetSummaryPath(table_file.location_));
+    boost::filesystem::remove(GetDiskIndexPath(table_file.location_));
+    boost::filesystem::remove(GetIngestIndexPath(table_file.location_));
+    boost::filesystem::remove(GetIndexOriginPath(table_file.location_));
+    boost::filesystem::remove(SegmentTombstone::GetTombstonePath(table_file.location_));
+    boost::filesystem::remove(SegmentAttrs::GetAttrsPath(table_file.location_));
+    boost::filesystem::remove(SegmentTimeRange::GetTimeRangePath(table_file.location_));
+    boost::filesystem::remove(SegmentIdIndex::GetIdIndexPath(table_file.location_));
+    SegmentSummaryMgr::GetInstance().EraseSummary(table_file.location_);
+    SegmentTombstoneMgr::GetInstance().EraseTombstone(table_file.location_);
+    SegmentAttrsMgr::GetInstance().EraseAttrs(table_file.location_);
+    SegmentTimeRangeMgr::GetInstance().EraseTimeRange(table_file.location_);
+    SegmentIdIndexMgr::GetInstance().EraseIdIndex(table_file.location_);
     return Status::OK();
 }
 
+Status
+DeleteTableFilePaths(const DBMetaOptions& options, meta::TableFilesSchema& table_files) {
+    if (table_files.size() <= 1) {
+        for (auto& table_file : table_files) {
+            DeleteTableFilePath(options, table_file);
+        }
+        return Status::OK();
+    }
+
+    static ThreadPool s_delete_pool(DELETE_FILE_THREAD_NUM);
+    std::vector<std::future<Status>> results;
+    results.reserve(table_files.size());
+    for (auto& table_file : table_files) {
+        results.emplace_back(
+            s_delete_pool.enqueue([&options, &table_file]() { return DeleteTableFilePath(options, table_file); }));
+    }
+
+    // the files are referenced by the tasks, all of them are waited for whatever the result
+    Status status;
+    for (auto& result : results) {
+        try {
+            auto file_status = result.get();
+            if (!file_status.ok()) {
+                status = file_status;
+            }
+        } catch (std::exception& ex) {
+            status = Status(DB_ERROR, std::string("Failed to delete table file: ") + ex.what());
+        }
+    }
+    return status;
+}
+
+Status
+ExportTableFilePath(const std::string& location, const std::string& path) {
+    Status status;
+    if (server::Config::GetInstance().GetSnapshot()->s3_enable_) {
+        status = storage::S3ClientWrapper::GetInstance().GetObjectFile(location, path);
+    } else {
+        status = LinkOrCopyFile(location, path);
+    }
+    if (!status.ok()) {
+        return status;
+    }
+    return LinkOrCopySideFiles(location, path);
+}
+
+Status
+ImportTableFilePath(const std::string& path, const std::string& location) {
+    Status status;
+    if (server::Config::GetInstance().GetSnapshot()->s3_enable_) {
+        status = storage::S3ClientWrapper::GetInstance().PutObjectFile(location, path);
+    } else {
+        status = LinkOrCopyFile(path, location);
+    }
+    if (!status.ok()) {
+        return status;
+    }
+    return LinkOrCopySideFiles(path, location);
+}
+
+std::string
+GetDiskIndexPath(const std::string& location) {
+    return location + DISK_INDEX_SUFFIX;
+}
+
+std::string
+GetIngestIndexPath(const std::string& location) {
+    return location + INGEST_INDEX_SUFFIX;
+}
+
+std::string
+GetIndexOriginPath(const std::string& location) {
+    return location + INDEX_ORIGIN_SUFFIX;
+}
+
+Status
+WriteIndexOrigin(const std::string& location, const std::string& origin_file_id) {
+    std::string path = GetIndexOriginPath(location);
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return Status(DB_ERROR, "Failed to open index origin: " + path);
+    }
+
+    file << origin_file_id;
+    if (!file.good()) {
+        return Status(DB_ERROR, "Failed to write index origin: " + path);
+    }
+    return Status::OK();
+}
+
+Status
+ReadIndexOrigin(const std::string& location, std::string& origin_file_id) {
+    std::string path = GetIndexOriginPath(location);
+    std::ifstream file(path, std::ios::in);
+    if (!file.is_open()) {
+        return Status(DB_NOT_FOUND, "Index origin not found: " + path);
+    }
+
+    file >> origin_file_id;
+    if (origin_file_id.empty()) {
+        return Status(DB_ERROR, "Invalid index origin: " + path);
+    }
+    return Status::OK();
+}
+
+bool
+HasIngestIndex(const meta::TableFileSchema& table_file) {
+    if (table_file.file_type_ != meta::TableFileSchema::RAW &&
+        table_file.file_type_ != meta::TableFileSchema::TO_INDEX) {
+        return false;
+    }
+    if (table_file.engine_type_ == (int)EngineType::FAISS_IDMAP ||
+        table_file.engine_type_ == (int)EngineType::FAISS_BIN_IDMAP) {
+        return false;
+    }
+    boost::system::error_code err;
+    return boost::filesystem::exists(GetIngestIndexPath(table_file.location_), err);
+}
+
+void
+RemoveIngestIndex(const std::string& location) {
+    auto path = GetIngestIndexPath(location);
+    cache::CpuCacheMgr::GetInstance()->EraseItem(path);
+    boost::system::error_code err;
+    boost::filesystem::remove(path, err);
+}
+
+std::string
+GetTableIdByLocation(const std::string& location) {
+    // location is <db path>/tables/<table id>/<date>/<file id>
+    std::string folder(TABLES_FOLDER);
+    auto pos = location.rfind(folder);
+    if (pos == std::string::npos) {
+        return "";
+    }
+
+    auto begin = pos + folder.size();
+    auto end = location.find('/', begin);
+    if (end == std::string::npos) {
+        return "";
+    }
+    return location.substr(begin, end - begin);
+}
+
 bool
 IsSameIndex(const TableIndex& index1, const TableIndex& index2) {
     return index1.engine_type_ == index2.engine_type_ && index1.nlist_ == index2.nlist_ &&
@@ -37,6 +37,57 @@ GetTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file
 Status
 DeleteTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file);
 
+// delete the files of a batch by a few threads at once, every delete is still charged to the io rate limiter
+Status
+DeleteTableFilePaths(const DBMetaOptions& options, meta::TableFilesSchema& table_files);
+
+// a file archived as pq codes goes to the last secondary path, the storage for cold data; it stays where
+// CreateTableFilePath put it without secondary paths, or with s3 where all files are kept alike
+Status
+CreateArchiveFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file);
+
+// link the file at location and the files next to it to path, a copy is made across file systems, a file kept on s3
+// is downloaded; the tombstone is left out, ids are appended to it in place and are taken under the delete mutex
+Status
+ExportTableFilePath(const std::string& location, const std::string& path);
+
+// the reverse of ExportTableFilePath, the file at path and the files next to it go to location, which
+// CreateTableFilePath made
+Status
+ImportTableFilePath(const std::string& path, const std::string& location);
+
+// file next to the index file at location, keeping the graph and full vectors of a DISKANN index
+std::string
+GetDiskIndexPath(const std::string& location);
+
+// file next to a raw file at location, keeping the index built for it on flush with the model trained for the table
+std::string
+GetIngestIndexPath(const std::string& location);
+
+// file next to an index file at location, keeping the file id of the raw file it is built from, so a segment is
+// rebuilt from its raw file when the table index changes
+std::string
+GetIndexOriginPath(const std::string& location);
+
+Status
+WriteIndexOrigin(const std::string& location, const std::string& origin_file_id);
+
+Status
+ReadIndexOrigin(const std::string& location, std::string& origin_file_id);
+
+// a raw file with an index built on flush is searched through that index instead of its raw vectors
+bool
+HasIngestIndex(const meta::TableFileSchema& table_file);
+
+// the index built on flush for the raw file at location is dropped with its cache entry once the raw file is
+// replaced by a merged or indexed file
+void
+RemoveIngestIndex(const std::string& location);
+
+// table(or partition) id of a table file location, empty if location is not under a table path
+std::string
+GetTableIdByLocation(const std::string& location);
+
 bool
 IsSameIndex(const TableIndex& index1, const TableIndex& index2);
 
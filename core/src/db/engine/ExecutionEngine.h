@@ -17,9 +17,30 @@
 
 #include "utils/Status.h"
 
+#ifdef MILVUS_GPU_VERSION
+#include <cuda.h>
+#endif
+
+namespace knowhere {
+class IDFilter;
+struct CoarseAssignment;
+}  // namespace knowhere
+
 namespace milvus {
 namespace engine {
 
+using IDFilterPtr = std::shared_ptr<knowhere::IDFilter>;
+using CoarseAssignmentPtr = std::shared_ptr<knowhere::CoarseAssignment>;
+
+#ifdef MILVUS_GPU_VERSION
+// the most results of a query faiss selects on a gpu
+#if CUDA_VERSION > 9000
+constexpr int64_t GPU_MAX_TOPK = 2048;
+#else
+constexpr int64_t GPU_MAX_TOPK = 1024;
+#endif
+#endif
+
 // TODO(linxj): replace with VecIndex::IndexType
 enum class EngineType {
     INVALID = 0,
@@ -34,7 +55,13 @@ enum class EngineType {
     FAISS_BIN_IDMAP,
     FAISS_BIN_IVFFLAT,
     HNSW,
-    MAX_VALUE = HNSW,
+    HNSW_SQ8,
+    FAISS_PQ_REFINE,
+    FAISS_IVFFP16,
+    FAISS_FLAT_FP16,
+    FAISS_PQ_FASTSCAN,
+    DISKANN,
+    MAX_VALUE = DISKANN,
 };
 
 enum class MetricType {
@@ -54,6 +81,25 @@ class ExecutionEngine {
     virtual Status
     AddWithIds(int64_t n, const uint8_t* xdata, const int64_t* xids) = 0;
 
+    // reserve memory of raw index for n vectors
+    virtual Status
+    Reserve(int64_t n) = 0;
+
+    // exchange raw data of float raw index with the given buffers
+    virtual Status
+    SwapRawData(std::vector<float>& vectors, std::vector<int64_t>& ids) = 0;
+
+    // ids of the vectors of raw index, deleted ones included
+    virtual Status
+    GetRawIds(std::vector<int64_t>& ids) const = 0;
+
+    // copy the vector at offset of raw index to data
+    virtual Status
+    GetRawVector(int64_t offset, float* data) const = 0;
+
+    virtual Status
+    GetRawVector(int64_t offset, uint8_t* data) const = 0;
+
     virtual size_t
     Count() const = 0;
 
@@ -87,16 +133,38 @@ class ExecutionEngine {
     virtual Status
     Merge(const std::string& location) = 0;
 
+    // only the ids accepted by filter are returned, if it is given, vectors deleted from the file never are
+    // coarse, if it is given, holds the lists of the queries found by a file with the same quantizer fingerprint
+    // rows [row_begin, row_end) are searched if row_end isn't negative, by a flat index on cpu only
     virtual Status
-    Search(int64_t n, const float* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels, bool hybrid) = 0;
+    Search(int64_t n, const float* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels, bool hybrid,
+           const IDFilterPtr& filter = nullptr, const CoarseAssignmentPtr& coarse = nullptr, int64_t row_begin = 0,
+           int64_t row_end = -1) = 0;
 
     virtual Status
     Search(int64_t n, const uint8_t* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels,
            bool hybrid) = 0;
 
+    // return at most max_results neighbors within radius for each query, missing ones are marked by label -1
+    virtual Status
+    SearchByRange(int64_t n, const float* data, float radius, int64_t max_results, int64_t nprobe, float* distances,
+                  int64_t* labels) = 0;
+
+    // same for the files whose ivf lists are split by the same centroids, 0 if the file can't share them
+    virtual uint64_t
+    QuantizerFingerprint() = 0;
+
+    // lists the queries probe with nprobe, coarse is nullptr if the file can't compute them
+    virtual Status
+    CoarseAssign(int64_t n, const float* data, int64_t nprobe, CoarseAssignmentPtr& coarse) = 0;
+
     virtual std::shared_ptr<ExecutionEngine>
     BuildIndex(const std::string& location, EngineType engine_type) = 0;
 
+    // build with the model an earlier build trained for the table, nullptr if the table has no such model
+    virtual std::shared_ptr<ExecutionEngine>
+    BuildIndexByTableModel(const std::string& location, EngineType engine_type) = 0;
+
     virtual Status
     Cache() = 0;
 
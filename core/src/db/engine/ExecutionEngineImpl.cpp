@@ -12,13 +12,26 @@
 #include "db/engine/ExecutionEngineImpl.h"
 
 #include <fiu-local.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
+#include "db/Utils.h"
+#include "db/engine/LoadingIndexMgr.h"
+#include "db/engine/SegmentIdIndex.h"
+#include "db/engine/SegmentSummary.h"
+#include "db/engine/SegmentTombstone.h"
 #include "knowhere/common/Config.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "metrics/Metrics.h"
 #include "scheduler/Utils.h"
 #include "server/Config.h"
@@ -69,6 +82,159 @@ IsBinaryIndexType(IndexType type) {
     return type == IndexType::FAISS_BIN_IDMAP || type == IndexType::FAISS_BIN_IVFLAT_CPU;
 }
 
+// nprobe of a search is meant for a file of the table nlist, a file matched to fewer or more lists probes as large
+// a part of them; indexes not reporting their lists are probed as asked
+int64_t
+MatchFileNprobe(int64_t nprobe, int64_t table_nlist, int64_t file_nlist) {
+    if (nprobe <= 0 || table_nlist <= 0 || file_nlist <= 0) {
+        return nprobe;
+    }
+    int64_t matched = (nprobe * file_nlist + table_nlist - 1) / table_nlist;
+    return std::min(std::max<int64_t>(matched, 1), file_nlist);
+}
+
+// rows of a raw file left after its deleted vectors are dropped, row_size is in elements of T
+template <typename T>
+void
+DropDeleted(const SegmentTombstone& tombstone, int64_t count, size_t row_size, const T* vectors, const int64_t* ids,
+            std::vector<T>& kept_vectors, std::vector<int64_t>& kept_ids) {
+    kept_vectors.reserve(count * row_size);
+    kept_ids.reserve(count);
+    for (int64_t i = 0; i < count; i++) {
+        if (!tombstone.IsDeleted(ids[i])) {
+            kept_vectors.insert(kept_vectors.end(), vectors + i * row_size, vectors + (i + 1) * row_size);
+            kept_ids.push_back(ids[i]);
+        }
+    }
+}
+
+// rejected vectors an index didn't skip itself are taken out of the topk of each query, the rest move up,
+// the tail is padded the way faiss pads a topk it can't fill
+template <typename Rejected>
+void
+RemoveRejected(int64_t n, int64_t k, MetricType metric_type, float* distances, int64_t* labels, Rejected rejected) {
+    float padding = (metric_type == MetricType::IP) ? -std::numeric_limits<float>::max()
+                                                    : std::numeric_limits<float>::max();
+    for (int64_t i = 0; i < n; i++) {
+        int64_t kept = 0;
+        for (int64_t j = 0; j < k; j++) {
+            auto label = labels[i * k + j];
+            if (label >= 0 && rejected(label)) {
+                continue;
+            }
+            labels[i * k + kept] = label;
+            distances[i * k + kept] = distances[i * k + j];
+            kept++;
+        }
+        for (; kept < k; kept++) {
+            labels[i * k + kept] = -1;
+            distances[i * k + kept] = padding;
+        }
+    }
+}
+
+void
+RemoveDeleted(const SegmentTombstone& tombstone, int64_t n, int64_t k, MetricType metric_type, float* distances,
+              int64_t* labels) {
+    RemoveRejected(n, k, metric_type, distances, labels, [&](int64_t id) { return tombstone.IsDeleted(id); });
+}
+
+// ivf types whose trained model may be cached and shared by the files of a table
+bool
+IsSharedModelType(EngineType engine_type) {
+    if (engine_type == EngineType::FAISS_IVFSQ8H) {
+        return true;
+    }
+    if (engine_type != EngineType::FAISS_IVFFLAT && engine_type != EngineType::FAISS_IVFSQ8 &&
+        engine_type != EngineType::FAISS_PQ && engine_type != EngineType::FAISS_PQ_REFINE &&
+        engine_type != EngineType::FAISS_IVFFP16 && engine_type != EngineType::FAISS_PQ_FASTSCAN) {
+        return false;
+    }
+
+    return server::Config::GetInstance().GetSnapshot()->reuse_trained_model_;
+}
+
+// an index built on flush is searched in place of its raw file, vectors deleted from the raw file are the ones
+// it skips
+std::string
+RawFileLocation(const std::string& location) {
+    static const std::string suffix = utils::GetIngestIndexPath("");
+    if (location.size() > suffix.size() &&
+        location.compare(location.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        return location.substr(0, location.size() - suffix.size());
+    }
+    return location;
+}
+
+#ifdef MILVUS_GPU_VERSION
+// a copy to gpu waits this long for memory held by others before it fails
+constexpr int64_t GPU_RESERVE_WAIT_MS = 10000;
+
+// a large ivf index file is split among all search gpus, one search of it runs on every device
+std::vector<int64_t>
+GetShardDevices(EngineType engine_type, int64_t row_count) {
+    std::vector<int64_t> devices;
+    if (engine_type != EngineType::FAISS_IVFFLAT && engine_type != EngineType::FAISS_IVFSQ8 &&
+        engine_type != EngineType::FAISS_PQ) {
+        return devices;
+    }
+
+    auto config = server::Config::GetInstance().GetSnapshot();
+    int64_t threshold = config->shard_row_threshold_;
+    if (threshold <= 0 || row_count < threshold || config->search_gpus_.size() < 2) {
+        return devices;
+    }
+
+    devices = config->search_gpus_;
+    return devices;
+}
+
+// a large ivf index file is built on all build gpus at once, the model is trained on the gpu the file was copied
+// to and every gpu adds a part of the vectors
+std::vector<int64_t>
+GetBuildDevices(EngineType engine_type, int64_t row_count) {
+    std::vector<int64_t> devices;
+    if (engine_type != EngineType::FAISS_IVFFLAT && engine_type != EngineType::FAISS_IVFSQ8 &&
+        engine_type != EngineType::FAISS_PQ) {
+        return devices;
+    }
+
+    auto config = server::Config::GetInstance().GetSnapshot();
+    int64_t threshold = config->parallel_build_row_threshold_;
+    if (threshold <= 0 || row_count < threshold || config->build_gpus_.size() < 2) {
+        return devices;
+    }
+
+    devices = config->build_gpus_;
+    return devices;
+}
+#endif
+
+// generation of the trained models of each table, it is a part of their cache keys, so a table recreated with the
+// same name or an index created again is never built with a model trained for the old one
+std::mutex model_generation_mutex;
+std::unordered_map<std::string, uint64_t> model_generations;
+
+uint64_t
+TableModelGeneration(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(model_generation_mutex);
+    auto iter = model_generations.find(table_id);
+    return (iter == model_generations.end()) ? 0 : iter->second;
+}
+
+// index files whose vectors are rotated, known once they are built or loaded, the scheduler places their searches
+// on cpu as they can't be copied to gpu
+std::mutex rotated_index_mutex;
+std::unordered_set<std::string> rotated_indexes;
+
+void
+MarkRotatedIndex(const std::string& location, const VecIndexPtr& index) {
+    if (index != nullptr && index->Rotated()) {
+        std::lock_guard<std::mutex> lock(rotated_index_mutex);
+        rotated_indexes.insert(location);
+    }
+}
+
 }  // namespace
 
 class CachedQuantizer : public cache::DataObj {
@@ -90,6 +256,51 @@ class CachedQuantizer : public cache::DataObj {
     knowhere::QuantizerPtr data_;
 };
 
+#ifdef MILVUS_GPU_VERSION
+// part of an index split among gpus, held by the cache of each device it lives on and charged with the bytes of that
+// device, the index is freed once every device has dropped its part
+class CachedIndexShard : public cache::DataObj {
+ public:
+    CachedIndexShard(VecIndexPtr index, int64_t size) : index_(std::move(index)), size_(size) {
+    }
+
+    VecIndexPtr
+    Index() {
+        return index_;
+    }
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+
+ private:
+    VecIndexPtr index_;
+    int64_t size_;
+};
+#endif
+
+// trained model shared by index files of a table built with the same parameters
+class CachedIndexModel : public cache::DataObj {
+ public:
+    CachedIndexModel(knowhere::IndexModelPtr data, int64_t size) : data_(std::move(data)), size_(size) {
+    }
+
+    knowhere::IndexModelPtr
+    Data() {
+        return data_;
+    }
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+
+ private:
+    knowhere::IndexModelPtr data_;
+    int64_t size_;
+};
+
 ExecutionEngineImpl::ExecutionEngineImpl(uint16_t dimension, const std::string& location, EngineType index_type,
                                          MetricType metric_type, int32_t nlist)
     : location_(location), dim_(dimension), index_type_(index_type), metric_type_(metric_type), nlist_(nlist) {
@@ -131,9 +342,7 @@ ExecutionEngineImpl::ExecutionEngineImpl(VecIndexPtr index, const std::string& l
 VecIndexPtr
 ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
 #ifdef MILVUS_GPU_VERSION
-    server::Config& config = server::Config::GetInstance();
-    bool gpu_resource_enable = true;
-    config.GetGpuResourceConfigEnable(gpu_resource_enable);
+    bool gpu_resource_enable = server::Config::GetInstance().GetSnapshot()->gpu_enable_;
     fiu_do_on("ExecutionEngineImpl.CreatetVecIndex.gpu_res_disabled", gpu_resource_enable = false);
 #endif
 
@@ -199,6 +408,30 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
             index = GetVecIndexFactory(IndexType::HNSW);
             break;
         }
+        case EngineType::HNSW_SQ8: {
+            index = GetVecIndexFactory(IndexType::HNSW_SQ8);
+            break;
+        }
+        case EngineType::FAISS_PQ_REFINE: {
+            index = GetVecIndexFactory(IndexType::FAISS_IVFPQ_REFINE);
+            break;
+        }
+        case EngineType::FAISS_PQ_FASTSCAN: {
+            index = GetVecIndexFactory(IndexType::FAISS_IVFPQ_FASTSCAN);
+            break;
+        }
+        case EngineType::DISKANN: {
+            index = GetVecIndexFactory(IndexType::DISKANN);
+            break;
+        }
+        case EngineType::FAISS_IVFFP16: {
+            index = GetVecIndexFactory(IndexType::FAISS_IVFFP16_CPU);
+            break;
+        }
+        case EngineType::FAISS_FLAT_FP16: {
+            index = GetVecIndexFactory(IndexType::FAISS_FLAT_FP16);
+            break;
+        }
         case EngineType::FAISS_BIN_IDMAP: {
             index = GetVecIndexFactory(IndexType::FAISS_BIN_IDMAP);
             break;
@@ -215,75 +448,74 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
     return index;
 }
 
-void
-ExecutionEngineImpl::HybridLoad() const {
+knowhere::QuantizerPtr
+ExecutionEngineImpl::HybridQuantizer() const {
     if (index_type_ != EngineType::FAISS_IVFSQ8H) {
-        return;
+        return nullptr;
     }
 
     if (index_->GetType() == IndexType::FAISS_IDMAP) {
         ENGINE_LOG_WARNING << "HybridLoad with type FAISS_IDMAP, ignore";
-        return;
+        return nullptr;
     }
 
 #ifdef MILVUS_GPU_VERSION
-    const std::string key = location_ + ".quantizer";
-
-    server::Config& config = server::Config::GetInstance();
-    std::vector<int64_t> gpus;
-    Status s = config.GetGpuResourceConfigSearchResources(gpus);
-    if (!s.ok()) {
-        ENGINE_LOG_ERROR << s.message();
-        return;
+    // files trained from the same model have the same quantizer, only one copy of it is cached per gpu
+    uint64_t fingerprint = index_->QuantizerFingerprint();
+    const std::string key =
+        (fingerprint != 0) ? "quantizer_" + std::to_string(fingerprint) : location_ + ".quantizer";
+
+    auto config = server::Config::GetInstance().GetSnapshot();
+    const std::vector<int64_t>& gpus = config->search_gpus_;
+    if (gpus.empty()) {
+        ENGINE_LOG_ERROR << "No gpu to load quantizer to, gpu_resource_config.enable may be false";
+        return nullptr;
     }
 
     // cache hit
-    {
-        const int64_t NOT_FOUND = -1;
-        int64_t device_id = NOT_FOUND;
-        knowhere::QuantizerPtr quantizer = nullptr;
-
-        for (auto& gpu : gpus) {
-            auto cache = cache::GpuCacheMgr::GetInstance(gpu);
-            if (auto cached_quantizer = cache->GetIndex(key)) {
-                device_id = gpu;
-                quantizer = std::static_pointer_cast<CachedQuantizer>(cached_quantizer)->Data();
-            }
-        }
-
-        if (device_id != NOT_FOUND) {
-            index_->SetQuantizer(quantizer);
-            return;
+    for (auto& gpu : gpus) {
+        auto cache = cache::GpuCacheMgr::GetInstance(gpu);
+        if (auto cached_quantizer = cache->GetIndex(key)) {
+            return std::static_pointer_cast<CachedQuantizer>(cached_quantizer)->Data();
         }
     }
 
     // cache miss
-    {
-        std::vector<int64_t> all_free_mem;
-        for (auto& gpu : gpus) {
-            auto cache = cache::GpuCacheMgr::GetInstance(gpu);
-            auto free_mem = cache->CacheCapacity() - cache->CacheUsage();
-            all_free_mem.push_back(free_mem);
-        }
+    std::vector<int64_t> all_free_mem;
+    for (auto& gpu : gpus) {
+        auto cache = cache::GpuCacheMgr::GetInstance(gpu);
+        auto free_mem = cache->CacheCapacity() - cache->CacheUsage();
+        all_free_mem.push_back(free_mem);
+    }
 
-        auto max_e = std::max_element(all_free_mem.begin(), all_free_mem.end());
-        auto best_index = std::distance(all_free_mem.begin(), max_e);
-        auto best_device_id = gpus[best_index];
+    auto max_e = std::max_element(all_free_mem.begin(), all_free_mem.end());
+    auto best_index = std::distance(all_free_mem.begin(), max_e);
+    auto best_device_id = gpus[best_index];
 
-        auto quantizer_conf = std::make_shared<knowhere::QuantizerCfg>();
-        quantizer_conf->mode = 1;
-        quantizer_conf->gpu_id = best_device_id;
-        auto quantizer = index_->LoadQuantizer(quantizer_conf);
-        if (quantizer == nullptr) {
-            ENGINE_LOG_ERROR << "quantizer is nullptr";
-        }
-        index_->SetQuantizer(quantizer);
-        auto cache_quantizer = std::make_shared<CachedQuantizer>(quantizer);
-        cache::GpuCacheMgr::GetInstance(best_device_id)->InsertItem(key, cache_quantizer);
+    auto quantizer_conf = std::make_shared<knowhere::QuantizerCfg>();
+    quantizer_conf->mode = 1;
+    quantizer_conf->gpu_id = best_device_id;
+    auto quantizer = index_->LoadQuantizer(quantizer_conf);
+    if (quantizer == nullptr) {
+        ENGINE_LOG_ERROR << "quantizer is nullptr";
+        return nullptr;
     }
+    // kept in the group of quantizers, they stay resident while index copies come and go
+    auto cache_quantizer = std::make_shared<CachedQuantizer>(quantizer);
+    cache::GpuCacheMgr::GetInstance(best_device_id)->InsertItem(key, cache_quantizer, cache::GPU_QUANTIZER_GROUP);
+    return quantizer;
+#else
+    return nullptr;
 #endif
 }
 
+void
+ExecutionEngineImpl::HybridLoad() const {
+    if (auto quantizer = HybridQuantizer()) {
+        index_->SetQuantizer(quantizer);
+    }
+}
+
 void
 ExecutionEngineImpl::HybridUnset() const {
     if (index_type_ != EngineType::FAISS_IVFSQ8H) {
@@ -307,6 +539,69 @@ ExecutionEngineImpl::AddWithIds(int64_t n, const uint8_t* xdata, const int64_t*
     return status;
 }
 
+Status
+ExecutionEngineImpl::Reserve(int64_t n) {
+    if (auto bf_index = std::dynamic_pointer_cast<BFIndex>(index_)) {
+        return bf_index->Reserve(n);
+    } else if (auto bf_bin_index = std::dynamic_pointer_cast<BinBFIndex>(index_)) {
+        return bf_bin_index->Reserve(n);
+    }
+
+    return Status(DB_ERROR, "Reserve is only supported by raw index");
+}
+
+Status
+ExecutionEngineImpl::SwapRawData(std::vector<float>& vectors, std::vector<int64_t>& ids) {
+    if (auto bf_index = std::dynamic_pointer_cast<BFIndex>(index_)) {
+        return bf_index->SwapRawData(vectors, ids);
+    }
+
+    return Status(DB_ERROR, "SwapRawData is only supported by float raw index");
+}
+
+Status
+ExecutionEngineImpl::GetRawIds(std::vector<int64_t>& ids) const {
+    if (auto bf_index = std::dynamic_pointer_cast<BFIndex>(index_)) {
+        ids.assign(bf_index->GetRawIds(), bf_index->GetRawIds() + bf_index->Count());
+        return Status::OK();
+    } else if (auto bf_bin_index = std::dynamic_pointer_cast<BinBFIndex>(index_)) {
+        ids.assign(bf_bin_index->GetRawIds(), bf_bin_index->GetRawIds() + bf_bin_index->Count());
+        return Status::OK();
+    }
+
+    return Status(DB_ERROR, "GetRawIds is only supported by raw index");
+}
+
+Status
+ExecutionEngineImpl::GetRawVector(int64_t offset, float* data) const {
+    auto bf_index = std::dynamic_pointer_cast<BFIndex>(index_);
+    if (bf_index == nullptr) {
+        return Status(DB_ERROR, "GetRawVector is only supported by float raw index");
+    }
+    if (offset < 0 || offset >= bf_index->Count()) {
+        return Status(DB_ERROR, "Offset " + std::to_string(offset) + " out of raw index");
+    }
+
+    auto dimension = bf_index->Dimension();
+    memcpy(data, bf_index->GetRawVectors() + offset * dimension, dimension * sizeof(float));
+    return Status::OK();
+}
+
+Status
+ExecutionEngineImpl::GetRawVector(int64_t offset, uint8_t* data) const {
+    auto bf_bin_index = std::dynamic_pointer_cast<BinBFIndex>(index_);
+    if (bf_bin_index == nullptr) {
+        return Status(DB_ERROR, "GetRawVector is only supported by binary raw index");
+    }
+    if (offset < 0 || offset >= bf_bin_index->Count()) {
+        return Status(DB_ERROR, "Offset " + std::to_string(offset) + " out of raw index");
+    }
+
+    auto row_size = bf_bin_index->Dimension() / 8;
+    memcpy(data, bf_bin_index->GetRawVectors() + offset * row_size, row_size);
+    return Status::OK();
+}
+
 size_t
 ExecutionEngineImpl::Count() const {
     if (index_ == nullptr) {
@@ -353,24 +648,91 @@ ExecutionEngineImpl::Serialize() {
         status = Status(DB_ERROR, msg);
     }
 
+    if (status.ok()) {
+        WriteSummary(location_);
+        WriteIdIndex(location_);
+    }
+
     return status;
 }
 
+void
+ExecutionEngineImpl::WriteSummary(const std::string& location) const {
+    if (metric_type_ != MetricType::L2 && metric_type_ != MetricType::IP) {
+        return;
+    }
+
+    auto bf_index = std::dynamic_pointer_cast<BFIndex>(index_);
+    if (bf_index == nullptr || bf_index->Count() <= 0) {
+        return;
+    }
+
+    // summary is optional, search doesn't prune the file without it
+    auto summary = std::make_shared<SegmentSummary>();
+    auto status = SegmentSummary::Build(bf_index->GetRawVectors(), bf_index->GetRawIds(), bf_index->Count(),
+                                        Dimension(), *summary);
+    if (status.ok()) {
+        status = summary->Write(location);
+    }
+    if (status.ok()) {
+        SegmentSummaryMgr::GetInstance().PutSummary(location, summary);
+    } else {
+        ENGINE_LOG_WARNING << "Failed to write segment summary of " << location << ": " << status.message();
+    }
+}
+
+void
+ExecutionEngineImpl::WriteIdIndex(const std::string& location) const {
+    std::vector<int64_t> ids;
+    if (!GetRawIds(ids).ok() || ids.empty()) {
+        return;
+    }
+
+    // id index is optional, a lookup by id builds it from the file without it
+    auto id_index = std::make_shared<SegmentIdIndex>();
+    auto status = SegmentIdIndex::Build(ids.data(), ids.size(), *id_index);
+    if (status.ok()) {
+        status = id_index->Write(location);
+    }
+    if (status.ok()) {
+        SegmentIdIndexMgr::GetInstance().PutIdIndex(location, id_index);
+    } else {
+        ENGINE_LOG_WARNING << "Failed to write segment id index of " << location << ": " << status.message();
+    }
+}
+
 Status
 ExecutionEngineImpl::Load(bool to_cache) {
-    index_ = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location_));
+    auto cpu_cache = cache::CpuCacheMgr::GetInstance();
+    std::string table_id = utils::GetTableIdByLocation(location_);
+    index_ = std::static_pointer_cast<VecIndex>(cpu_cache->GetIndex(location_));
     bool already_in_cache = (index_ != nullptr);
-    if (!already_in_cache) {
+    if (already_in_cache) {
+        server::Metrics::GetInstance().CacheHitTotalIncrement(cpu_cache->Name(), table_id);
+    } else {
+        server::Metrics::GetInstance().CacheMissTotalIncrement(cpu_cache->Name(), table_id);
         try {
-            double physical_size = PhysicalSize();
-            server::CollectExecutionEngineMetrics metrics(physical_size);
-            index_ = read_index(location_);
+            // a build task or another search holding the file uncached shares it instead of reading it again
+            bool read_from_disk = false;
+            index_ = LoadingIndexMgr::GetInstance().Load(location_, [&]() {
+                read_from_disk = true;
+                double physical_size = PhysicalSize();
+                server::CollectExecutionEngineMetrics metrics(physical_size);
+                server::CollectCacheLoadMetrics load_metrics(cpu_cache->Name(), table_id, physical_size);
+                return read_index(location_);
+            });
             if (index_ == nullptr) {
                 std::string msg = "Failed to load index from " + location_;
                 ENGINE_LOG_ERROR << msg;
                 return Status(DB_ERROR, msg);
-            } else {
+            } else if (read_from_disk) {
                 ENGINE_LOG_DEBUG << "Disk io from: " << location_;
+                // a raw file written before summaries were kept, or whose summary failed, gets it once loaded
+                if (SegmentSummaryMgr::GetInstance().GetSummary(location_) == nullptr) {
+                    WriteSummary(location_);
+                }
+            } else {
+                ENGINE_LOG_DEBUG << "Share loaded index of: " << location_;
             }
         } catch (std::exception& e) {
             ENGINE_LOG_ERROR << e.what();
@@ -378,6 +740,8 @@ ExecutionEngineImpl::Load(bool to_cache) {
         }
     }
 
+    MarkRotatedIndex(location_, index_);
+
     if (!already_in_cache && to_cache) {
         Cache();
     }
@@ -441,19 +805,76 @@ ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
 #endif
 
 #ifdef MILVUS_GPU_VERSION
-    auto index = std::static_pointer_cast<VecIndex>(cache::GpuCacheMgr::GetInstance(device_id)->GetIndex(location_));
+    auto gpu_cache = cache::GpuCacheMgr::GetInstance(device_id);
+    std::string table_id = utils::GetTableIdByLocation(location_);
+    auto cached = gpu_cache->GetIndex(location_);
+    auto index = std::static_pointer_cast<VecIndex>(cached);
+    if (auto shard = std::dynamic_pointer_cast<CachedIndexShard>(cached)) {
+        index = shard->Index();
+    }
     bool already_in_cache = (index != nullptr);
+    std::vector<cache::GpuMemoryReservationPtr> reservations;
+    std::vector<int64_t> copy_devices = {static_cast<int64_t>(device_id)};
+    int64_t copy_bytes = 0;
     if (already_in_cache) {
+        server::Metrics::GetInstance().CacheHitTotalIncrement(gpu_cache->Name(), table_id);
         index_ = index;
     } else {
+        server::Metrics::GetInstance().CacheMissTotalIncrement(gpu_cache->Name(), table_id);
         if (index_ == nullptr) {
             ENGINE_LOG_ERROR << "ExecutionEngineImpl: index is null, failed to copy to gpu";
             return Status(DB_ERROR, "index is null");
         }
 
+        // placed on gpu before the file was known to be rotated, it is searched where it is
+        if (index_->Rotated()) {
+            MarkRotatedIndex(location_, index_);
+            ENGINE_LOG_DEBUG << "Rotated index " << location_ << " stays on cpu";
+            return Status::OK();
+        }
+
+        // memory is reserved before cuda allocates it, the reservations end once the index is in the gpu cache
+        auto shard_devices = GetShardDevices(index_type_, index_->Count());
+        std::vector<int64_t> reserve_devices = {static_cast<int64_t>(device_id)};
+        if (!shard_devices.empty()) {
+            reserve_devices = shard_devices;
+        }
+        for (auto gpu : reserve_devices) {
+            auto reservation = std::make_shared<cache::GpuMemoryReservation>(
+                gpu, index_->Size() / reserve_devices.size(), GPU_RESERVE_WAIT_MS);
+            if (!reservation->ok()) {
+                std::string msg = "out of memory: no room for the index on gpu" + std::to_string(gpu);
+                ENGINE_LOG_ERROR << msg;
+                return Status(DB_ERROR, msg);
+            }
+            reservations.push_back(reservation);
+        }
+
         try {
-            index_ = index_->CopyToGpu(device_id);
-            ENGINE_LOG_DEBUG << "CPU to GPU" << device_id;
+            server::CollectCacheLoadMetrics load_metrics(gpu_cache->Name(), table_id, index_->Size());
+            auto copy_start = std::chrono::steady_clock::now();
+            copy_bytes = index_->Size();
+            VecIndexPtr shards = nullptr;
+            if (!shard_devices.empty()) {
+                shards = index_->CopyToGpuShards(shard_devices);
+            }
+
+            if (shards != nullptr) {
+                index_ = shards;
+                copy_devices = shard_devices;
+                ENGINE_LOG_DEBUG << "CPU to GPU shards on " << shard_devices.size() << " devices";
+            } else {
+                index_ = index_->CopyToGpu(device_id);
+                ENGINE_LOG_DEBUG << "CPU to GPU" << device_id;
+            }
+
+            // shards are copied together, each device is charged its part of the bytes and the whole time
+            auto copy_span = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - copy_start);
+            for (auto gpu : copy_devices) {
+                server::Metrics::GetInstance().GpuTransferIncrement(
+                    "gpu" + std::to_string(gpu), static_cast<double>(copy_bytes) / copy_devices.size(),
+                    copy_span.count());
+            }
         } catch (std::exception& e) {
             ENGINE_LOG_ERROR << e.what();
             return Status(DB_ERROR, e.what());
@@ -461,7 +882,16 @@ ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
     }
 
     if (!already_in_cache) {
-        GpuCache(device_id);
+        if (copy_devices.size() > 1) {
+            // vector i is on shard i % n, every device holds an equal part of the index
+            for (auto gpu : copy_devices) {
+                auto shard = std::make_shared<CachedIndexShard>(index_, copy_bytes / copy_devices.size());
+                cache::GpuCacheMgr::GetInstance(gpu)->InsertItem(location_, shard,
+                                                                 utils::GetTableIdByLocation(location_));
+            }
+        } else {
+            GpuCache(device_id);
+        }
     }
 #endif
 
@@ -471,11 +901,15 @@ ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
 Status
 ExecutionEngineImpl::CopyToIndexFileToGpu(uint64_t device_id) {
 #ifdef MILVUS_GPU_VERSION
-    // the ToIndexData is only a placeholder, cpu-copy-to-gpu action is performed in
+    // vectors are copied to gpu by BuildIndex, the memory of the index built there is reserved until it is done
     gpu_num_ = device_id;
-    auto to_index_data = std::make_shared<ToIndexData>(PhysicalSize());
-    cache::DataObjPtr obj = std::static_pointer_cast<cache::DataObj>(to_index_data);
-    milvus::cache::GpuCacheMgr::GetInstance(device_id)->InsertItem(location_ + "_placeholder", obj);
+    auto reservation = std::make_shared<cache::GpuMemoryReservation>(device_id, PhysicalSize(), GPU_RESERVE_WAIT_MS);
+    if (!reservation->ok()) {
+        std::string msg = "out of memory: no room to build the index on gpu" + std::to_string(device_id);
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+    gpu_reservation_ = reservation;
 #endif
     return Status::OK();
 }
@@ -544,8 +978,21 @@ ExecutionEngineImpl::Merge(const std::string& location) {
         return Status(DB_ERROR, "index is null");
     }
 
+    // vectors deleted from the file are left out of the merged one
+    auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(location);
     if (auto file_index = std::dynamic_pointer_cast<BFIndex>(to_merge)) {
-        auto status = index_->Add(file_index->Count(), file_index->GetRawVectors(), file_index->GetRawIds());
+        int64_t count = file_index->Count();
+        const float* vectors = file_index->GetRawVectors();
+        const int64_t* ids = file_index->GetRawIds();
+        std::vector<float> kept_vectors;
+        std::vector<int64_t> kept_ids;
+        if (tombstone != nullptr) {
+            DropDeleted(*tombstone, count, file_index->Dimension(), vectors, ids, kept_vectors, kept_ids);
+            count = kept_ids.size();
+            vectors = kept_vectors.data();
+            ids = kept_ids.data();
+        }
+        auto status = index_->Add(count, vectors, ids);
         if (!status.ok()) {
             ENGINE_LOG_ERROR << "Failed to merge: " << location << " to: " << location_;
         } else {
@@ -553,7 +1000,18 @@ ExecutionEngineImpl::Merge(const std::string& location) {
         }
         return status;
     } else if (auto bin_index = std::dynamic_pointer_cast<BinBFIndex>(to_merge)) {
-        auto status = index_->Add(bin_index->Count(), bin_index->GetRawVectors(), bin_index->GetRawIds());
+        int64_t count = bin_index->Count();
+        const uint8_t* vectors = bin_index->GetRawVectors();
+        const int64_t* ids = bin_index->GetRawIds();
+        std::vector<uint8_t> kept_vectors;
+        std::vector<int64_t> kept_ids;
+        if (tombstone != nullptr) {
+            DropDeleted(*tombstone, count, bin_index->Dimension() / 8, vectors, ids, kept_vectors, kept_ids);
+            count = kept_ids.size();
+            vectors = kept_vectors.data();
+            ids = kept_ids.data();
+        }
+        auto status = index_->Add(count, vectors, ids);
         if (!status.ok()) {
             ENGINE_LOG_ERROR << "Failed to merge: " << location << " to: " << location_;
         } else {
@@ -565,8 +1023,30 @@ ExecutionEngineImpl::Merge(const std::string& location) {
     }
 }
 
+void
+ExecutionEngineImpl::DropTableModels(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(model_generation_mutex);
+    ++model_generations[table_id];
+}
+
+bool
+ExecutionEngineImpl::IsRotatedIndex(const std::string& location) {
+    std::lock_guard<std::mutex> lock(rotated_index_mutex);
+    return rotated_indexes.find(location) != rotated_indexes.end();
+}
+
 ExecutionEnginePtr
 ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_type) {
+    return DoBuildIndex(location, engine_type, false);
+}
+
+ExecutionEnginePtr
+ExecutionEngineImpl::BuildIndexByTableModel(const std::string& location, EngineType engine_type) {
+    return DoBuildIndex(location, engine_type, true);
+}
+
+ExecutionEnginePtr
+ExecutionEngineImpl::DoBuildIndex(const std::string& location, EngineType engine_type, bool by_table_model) {
     ENGINE_LOG_DEBUG << "Build index file: " << location << " from: " << location_;
 
     auto from_index = std::dynamic_pointer_cast<BFIndex>(index_);
@@ -591,9 +1071,72 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
         throw Exception(DB_ERROR, status.message());
     }
 
+    auto config = server::Config::GetInstance().GetSnapshot();
+    if (config->train_sample_ratio_ < 1.0) {
+        temp_conf.train_size = static_cast<int64_t>(Count() * config->train_sample_ratio_);
+    }
+    temp_conf.quantizer_rotation = config->quantizer_rotation_;
+
+    // graph of DISKANN is read from a local file next to the index file, which isn't uploaded to s3
+    if (engine_type == EngineType::DISKANN) {
+        if (config->s3_enable_) {
+            throw Exception(DB_ERROR, "DISKANN index needs local storage, it is not supported with s3");
+        }
+        temp_conf.disk_path = utils::GetDiskIndexPath(location);
+    }
+
     auto adapter = AdapterMgr::GetInstance().GetAdapter(to_index->GetType());
     auto conf = adapter->Match(temp_conf);
 
+    // IVFSQ8H files of a table are trained once, later files reuse the model and so share one quantizer on gpu
+    // other ivf files do the same when reuse_trained_model is on, building them only adds vectors to the lists
+    // nlist of the model is the one matched for the file size, the latest model is kept for the table as well,
+    // a file too small to match that nlist is built with it by BuildIndexByTableModel
+    std::string model_key, table_model_key;
+    auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf);
+    if (IsSharedModelType(engine_type) && ivf_conf != nullptr) {
+        std::string table_id = utils::GetTableIdByLocation(location);
+        std::string key_prefix = table_id + ".model_" + std::to_string(TableModelGeneration(table_id)) + "_" +
+                                 std::to_string((int)engine_type) + "_" + std::to_string(temp_conf.dim) + "_";
+        model_key = key_prefix + std::to_string(ivf_conf->nlist) + "_" + std::to_string((int)metric_type_);
+        table_model_key = key_prefix + "table_" + std::to_string(nlist_) + "_" + std::to_string((int)metric_type_);
+        auto cache = cache::CpuCacheMgr::GetInstance();
+        auto cached_model = cache->GetItem(model_key);
+        if (cached_model == nullptr && by_table_model) {
+            cached_model = cache->GetItem(table_model_key);
+        }
+        if (cached_model != nullptr) {
+            to_index->SetTrainedModel(std::static_pointer_cast<CachedIndexModel>(cached_model)->Data());
+        }
+    }
+    if (by_table_model && to_index->TrainedModel() == nullptr) {
+        return nullptr;
+    }
+
+#ifdef MILVUS_GPU_VERSION
+    // the part of the vectors other gpus add is reserved there, a gpu without room is left out of the build
+    std::vector<cache::GpuMemoryReservationPtr> build_reservations;
+    auto build_devices = GetBuildDevices(engine_type, Count());
+    if (!build_devices.empty()) {
+        std::vector<int64_t> devices;
+        for (auto gpu : build_devices) {
+            if (gpu == gpu_num_) {
+                devices.push_back(gpu);
+                continue;
+            }
+            auto reservation =
+                std::make_shared<cache::GpuMemoryReservation>(gpu, PhysicalSize() / build_devices.size());
+            if (reservation->ok()) {
+                devices.push_back(gpu);
+                build_reservations.push_back(reservation);
+            } else {
+                ENGINE_LOG_WARNING << "No room on gpu" << gpu << " to build part of index file: " << location;
+            }
+        }
+        to_index->SetBuildDevices(devices);
+    }
+#endif
+
     if (from_index) {
         status = to_index->BuildAll(Count(), from_index->GetRawVectors(), from_index->GetRawIds(), conf);
     } else if (bin_from_index) {
@@ -603,13 +1146,43 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
         throw Exception(DB_ERROR, status.message());
     }
 
+#ifdef MILVUS_GPU_VERSION
+    // the index is still on the gpu it was built on, searching there takes it from the cache instead of copying
+    // the written file back
+    auto device_index = to_index->TakeDeviceIndex();
+    if (device_index != nullptr) {
+        auto& search_gpus = config->search_gpus_;
+        if (std::find(search_gpus.begin(), search_gpus.end(), gpu_num_) != search_gpus.end()) {
+            cache::GpuCacheMgr::GetInstance(gpu_num_)->InsertItem(location, device_index,
+                                                                  utils::GetTableIdByLocation(location));
+            ENGINE_LOG_DEBUG << "Keep index file: " << location << " on gpu" << gpu_num_ << " after build";
+        }
+    }
+#endif
+
+    auto trained_model = to_index->TrainedModel();
+    if (!model_key.empty() && trained_model != nullptr) {
+        int64_t model_size = temp_conf.dim * ivf_conf->nlist * sizeof(float);
+        auto cached_model = std::make_shared<CachedIndexModel>(trained_model, model_size);
+        cache::CpuCacheMgr::GetInstance()->InsertItem(model_key, cached_model);
+        cache::CpuCacheMgr::GetInstance()->InsertItem(table_model_key, cached_model);
+    }
+    // the cache holds it now, the built index doesn't need to
+    to_index->SetTrainedModel(nullptr);
+    gpu_reservation_ = nullptr;
+
+    MarkRotatedIndex(location, to_index);
     ENGINE_LOG_DEBUG << "Finish build index file: " << location << " size: " << to_index->Size();
+    if (!by_table_model) {
+        WriteSummary(location);
+    }
     return std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, nlist_);
 }
 
 Status
 ExecutionEngineImpl::Search(int64_t n, const float* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels,
-                            bool hybrid) {
+                            bool hybrid, const IDFilterPtr& filter, const CoarseAssignmentPtr& coarse,
+                            int64_t row_begin, int64_t row_end) {
 #if 0
     if (index_type_ == EngineType::FAISS_IVFSQ8H) {
         if (!hybrid) {
@@ -670,28 +1243,170 @@ ExecutionEngineImpl::Search(int64_t n, const float* data, int64_t k, int64_t npr
         return Status(DB_ERROR, "index is null");
     }
 
+    // a part of the rows is searched by a flat index on cpu only, another index would return all of them
+    if (row_end >= 0 && (index_->GetType() != IndexType::FAISS_IDMAP || index_->GetDeviceId() >= 0)) {
+        ENGINE_LOG_ERROR << "ExecutionEngineImpl: row range search on index type " << (int)index_->GetType();
+        return Status(DB_ERROR, "Row range search is supported by flat index on cpu only");
+    }
+
+    // sptag and gpu indexes can't skip ids while scanning, their topk is filtered afterwards
+    bool filterable = (index_type_ != EngineType::SPTAG_KDT && index_type_ != EngineType::SPTAG_BKT &&
+                       index_->GetDeviceId() < 0);
+
+    // deleted vectors are skipped while scanning unless the caller filters ids of its own
+    auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(RawFileLocation(location_));
+
     ENGINE_LOG_DEBUG << "Search Params: [k]  " << k << " [nprobe] " << nprobe;
 
+    // a gpu selects at most GPU_MAX_TOPK results of a query, LargeTopkPass places such searches on cpu,
+    // a larger topk reaching a gpu anyway is completed afterwards
+    int64_t index_k = k;
+#ifdef MILVUS_GPU_VERSION
+    if (index_->GetDeviceId() >= 0 && k > GPU_MAX_TOPK) {
+        index_k = GPU_MAX_TOPK;
+    }
+#endif
+
     // TODO(linxj): remove here. Get conf from function
     TempMetaConf temp_conf;
-    temp_conf.k = k;
-    temp_conf.nprobe = nprobe;
+    temp_conf.k = index_k;
+    temp_conf.nprobe = MatchFileNprobe(nprobe, nlist_, index_->Nlist());
 
     auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
     auto conf = adapter->MatchSearch(temp_conf, index_->GetType());
+    if (filterable) {
+        conf->filter = (filter == nullptr && tombstone != nullptr) ? tombstone->Filter() : filter;
+    }
+    if (auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf)) {
+        ivf_conf->coarse = coarse;
+    }
+    conf->row_begin = row_begin;
+    conf->row_end = row_end;
 
-    if (hybrid) {
+    // lists already assigned for the job are scanned on cpu, the shared index isn't switched to a gpu quantizer
+    bool swap_quantizer = hybrid && coarse == nullptr;
+    if (swap_quantizer) {
         HybridLoad();
     }
 
     auto status = index_->Search(n, data, distances, labels, conf);
 
-    if (hybrid) {
+    if (swap_quantizer) {
         HybridUnset();
     }
 
+    if (status.ok() && index_k < k) {
+        status = CompleteTopk(n, data, k, index_k, nprobe, distances, labels);
+    }
     if (!status.ok()) {
         ENGINE_LOG_ERROR << "Search error:" << status.message();
+        return status;
+    }
+    if (filter != nullptr && !filterable) {
+        RemoveRejected(n, k, metric_type_, distances, labels, [&](int64_t id) { return !filter->is_member(id); });
+    }
+    if (tombstone != nullptr) {
+        RemoveDeleted(*tombstone, n, k, metric_type_, distances, labels);
+    }
+    return status;
+}
+
+Status
+ExecutionEngineImpl::CompleteTopk(int64_t n, const float* data, int64_t k, int64_t found_k, int64_t nprobe,
+                                  float* distances, int64_t* labels) {
+    // rows of found_k results are spread to rows of k, the last first so none is overwritten before it moves
+    float padding = (metric_type_ == MetricType::IP) ? -std::numeric_limits<float>::max()
+                                                     : std::numeric_limits<float>::max();
+    std::vector<int64_t> rest;
+    for (int64_t i = n - 1; i >= 0; i--) {
+        memmove(labels + i * k, labels + i * found_k, found_k * sizeof(int64_t));
+        memmove(distances + i * k, distances + i * found_k, found_k * sizeof(float));
+        std::fill(labels + i * k + found_k, labels + (i + 1) * k, -1);
+        std::fill(distances + i * k + found_k, distances + (i + 1) * k, padding);
+
+        // a query with fewer than found_k results has all of them already
+        if (labels[i * k + found_k - 1] >= 0) {
+            rest.push_back(i);
+        }
+    }
+    if (rest.empty()) {
+        return Status::OK();
+    }
+
+    // the other queries are searched again by the index on cpu, the results found on gpu are its first ones
+    // the copy is cached, so following searches don't copy the index back again
+    auto cpu_index = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location_));
+    if (cpu_index == nullptr) {
+        cpu_index = index_->CopyToCpu();
+        if (cpu_index != nullptr) {
+            cache::DataObjPtr obj = std::static_pointer_cast<cache::DataObj>(cpu_index);
+            cache::CpuCacheMgr::GetInstance()->InsertItem(location_, obj, utils::GetTableIdByLocation(location_));
+        }
+    }
+    if (cpu_index == nullptr) {
+        return Status(DB_ERROR, "no index on cpu to complete topk " + std::to_string(k));
+    }
+
+    auto dim = index_->Dimension();
+    std::vector<float> queries(rest.size() * dim);
+    for (size_t r = 0; r < rest.size(); r++) {
+        memcpy(queries.data() + r * dim, data + rest[r] * dim, dim * sizeof(float));
+    }
+
+    TempMetaConf temp_conf;
+    temp_conf.k = k;
+    temp_conf.nprobe = MatchFileNprobe(nprobe, nlist_, cpu_index->Nlist());
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(cpu_index->GetType());
+    auto conf = adapter->MatchSearch(temp_conf, cpu_index->GetType());
+
+    std::vector<float> rest_distances(rest.size() * k);
+    std::vector<int64_t> rest_labels(rest.size() * k);
+    auto status = cpu_index->Search(rest.size(), queries.data(), rest_distances.data(), rest_labels.data(), conf);
+    if (!status.ok()) {
+        return status;
+    }
+    for (size_t r = 0; r < rest.size(); r++) {
+        memcpy(labels + rest[r] * k, rest_labels.data() + r * k, k * sizeof(int64_t));
+        memcpy(distances + rest[r] * k, rest_distances.data() + r * k, k * sizeof(float));
+    }
+
+    ENGINE_LOG_DEBUG << "Topk " << k << " of " << rest.size() << " of " << n << " queries completed on cpu";
+    return Status::OK();
+}
+
+uint64_t
+ExecutionEngineImpl::QuantizerFingerprint() {
+    if (index_ == nullptr) {
+        return 0;
+    }
+    return index_->QuantizerFingerprint();
+}
+
+Status
+ExecutionEngineImpl::CoarseAssign(int64_t n, const float* data, int64_t nprobe, CoarseAssignmentPtr& coarse) {
+    coarse = nullptr;
+    if (index_ == nullptr) {
+        ENGINE_LOG_ERROR << "ExecutionEngineImpl: index is null, failed to assign queries";
+        return Status(DB_ERROR, "index is null");
+    }
+
+    // the nprobe matched for search, so the lists are the ones the search would probe
+    TempMetaConf temp_conf;
+    temp_conf.k = 1;
+    temp_conf.nprobe = MatchFileNprobe(nprobe, nlist_, index_->Nlist());
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
+    auto conf = adapter->MatchSearch(temp_conf, index_->GetType());
+
+    // a hybrid index on cpu has its lists assigned by the quantizer resident on a gpu, the scan stays on cpu
+    knowhere::QuantizerPtr quantizer = nullptr;
+    if (index_->GetDeviceId() < 0) {
+        quantizer = HybridQuantizer();
+    }
+
+    auto status = (quantizer != nullptr) ? index_->CoarseAssign(n, data, conf, quantizer, coarse)
+                                         : index_->CoarseAssign(n, data, conf, coarse);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Coarse assign error:" << status.message();
     }
     return status;
 }
@@ -704,6 +1419,9 @@ ExecutionEngineImpl::Search(int64_t n, const uint8_t* data, int64_t k, int64_t n
         return Status(DB_ERROR, "index is null");
     }
 
+    // binary indexes take no filter, deleted vectors are only taken out of their results
+    auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(RawFileLocation(location_));
+
     ENGINE_LOG_DEBUG << "Search Params: [k]  " << k << " [nprobe] " << nprobe;
 
     // TODO(linxj): remove here. Get conf from function
@@ -726,14 +1444,47 @@ ExecutionEngineImpl::Search(int64_t n, const uint8_t* data, int64_t k, int64_t n
 
     if (!status.ok()) {
         ENGINE_LOG_ERROR << "Search error:" << status.message();
+    } else if (tombstone != nullptr) {
+        RemoveDeleted(*tombstone, n, k, metric_type_, distances, labels);
+    }
+    return status;
+}
+
+Status
+ExecutionEngineImpl::SearchByRange(int64_t n, const float* data, float radius, int64_t max_results, int64_t nprobe,
+                                   float* distances, int64_t* labels) {
+    if (index_ == nullptr) {
+        ENGINE_LOG_ERROR << "ExecutionEngineImpl: index is null, failed to search";
+        return Status(DB_ERROR, "index is null");
+    }
+
+    ENGINE_LOG_DEBUG << "Range search Params: [radius] " << radius << " [max_results] " << max_results
+                     << " [nprobe] " << nprobe;
+
+    TempMetaConf temp_conf;
+    temp_conf.k = max_results;
+    temp_conf.nprobe = MatchFileNprobe(nprobe, nlist_, index_->Nlist());
+
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
+    auto conf = adapter->MatchSearch(temp_conf, index_->GetType());
+
+    auto status = index_->RangeSearch(n, data, radius, distances, labels, conf);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Range search error:" << status.message();
+    } else if (auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(RawFileLocation(location_))) {
+        RemoveDeleted(*tombstone, n, max_results, metric_type_, distances, labels);
     }
     return status;
 }
 
 Status
 ExecutionEngineImpl::Cache() {
+    if (index_ != nullptr) {
+        index_->AdviseHugePages();
+    }
     cache::DataObjPtr obj = std::static_pointer_cast<cache::DataObj>(index_);
-    milvus::cache::CpuCacheMgr::GetInstance()->InsertItem(location_, obj);
+    // files of a table share the cache quota of the table
+    milvus::cache::CpuCacheMgr::GetInstance()->InsertItem(location_, obj, utils::GetTableIdByLocation(location_));
 
     return Status::OK();
 }
@@ -742,7 +1493,7 @@ Status
 ExecutionEngineImpl::GpuCache(uint64_t gpu_id) {
 #ifdef MILVUS_GPU_VERSION
     cache::DataObjPtr obj = std::static_pointer_cast<cache::DataObj>(index_);
-    milvus::cache::GpuCacheMgr::GetInstance(gpu_id)->InsertItem(location_, obj);
+    milvus::cache::GpuCacheMgr::GetInstance(gpu_id)->InsertItem(location_, obj, utils::GetTableIdByLocation(location_));
 #endif
     return Status::OK();
 }
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "ExecutionEngine.h"
+#include "cache/GpuMemoryArbiter.h"
 #include "wrapper/VecIndex.h"
 
 #include <memory>
@@ -34,6 +35,21 @@ class ExecutionEngineImpl : public ExecutionEngine {
     Status
     AddWithIds(int64_t n, const uint8_t* xdata, const int64_t* xids) override;
 
+    Status
+    Reserve(int64_t n) override;
+
+    Status
+    SwapRawData(std::vector<float>& vectors, std::vector<int64_t>& ids) override;
+
+    Status
+    GetRawIds(std::vector<int64_t>& ids) const override;
+
+    Status
+    GetRawVector(int64_t offset, float* data) const override;
+
+    Status
+    GetRawVector(int64_t offset, uint8_t* data) const override;
+
     size_t
     Count() const override;
 
@@ -69,15 +85,29 @@ class ExecutionEngineImpl : public ExecutionEngine {
 
     Status
     Search(int64_t n, const float* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels,
-           bool hybrid = false) override;
+           bool hybrid = false, const IDFilterPtr& filter = nullptr, const CoarseAssignmentPtr& coarse = nullptr,
+           int64_t row_begin = 0, int64_t row_end = -1) override;
 
     Status
     Search(int64_t n, const uint8_t* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels,
            bool hybrid = false) override;
 
+    Status
+    SearchByRange(int64_t n, const float* data, float radius, int64_t max_results, int64_t nprobe, float* distances,
+                  int64_t* labels) override;
+
+    uint64_t
+    QuantizerFingerprint() override;
+
+    Status
+    CoarseAssign(int64_t n, const float* data, int64_t nprobe, CoarseAssignmentPtr& coarse) override;
+
     ExecutionEnginePtr
     BuildIndex(const std::string& location, EngineType engine_type) override;
 
+    ExecutionEnginePtr
+    BuildIndexByTableModel(const std::string& location, EngineType engine_type) override;
+
     Status
     Cache() override;
 
@@ -102,6 +132,16 @@ class ExecutionEngineImpl : public ExecutionEngine {
         return location_;
     }
 
+    // trained models cached for the table are no longer used by builds, call it when the table or its index is
+    // dropped or a new index is created, the models left in cache are evicted in time
+    static void
+    DropTableModels(const std::string& table_id);
+
+    // the index file rotates its vectors before quantizing them, so it is searched on cpu; a file is known once it
+    // has been built or loaded by this process
+    static bool
+    IsRotatedIndex(const std::string& location);
+
  private:
     VecIndexPtr
     CreatetVecIndex(EngineType type);
@@ -109,12 +149,33 @@ class ExecutionEngineImpl : public ExecutionEngine {
     VecIndexPtr
     Load(const std::string& location);
 
+    ExecutionEnginePtr
+    DoBuildIndex(const std::string& location, EngineType engine_type, bool by_table_model);
+
+    // results of a search with found_k per query are made k per query, queries that may have more than found_k
+    // are searched again by the index on cpu
+    Status
+    CompleteTopk(int64_t n, const float* data, int64_t k, int64_t found_k, int64_t nprobe, float* distances,
+                 int64_t* labels);
+
+    // quantizer of a hybrid index on a gpu, loaded and cached once per model; nullptr for other types or no gpu
+    knowhere::QuantizerPtr
+    HybridQuantizer() const;
+
     void
     HybridLoad() const;
 
     void
     HybridUnset() const;
 
+    // write summary of the raw float vectors beside the index file at location
+    void
+    WriteSummary(const std::string& location) const;
+
+    // write id index of raw index beside the file at location
+    void
+    WriteIdIndex(const std::string& location) const;
+
  protected:
     VecIndexPtr index_ = nullptr;
     EngineType index_type_;
@@ -125,6 +186,9 @@ class ExecutionEngineImpl : public ExecutionEngine {
 
     int64_t nlist_ = 0;
     int64_t gpu_num_ = 0;
+
+    // memory taken on gpu_num_ by the index built there
+    cache::GpuMemoryReservationPtr gpu_reservation_;
 };
 
 }  // namespace engine
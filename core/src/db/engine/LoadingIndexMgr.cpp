@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/LoadingIndexMgr.h"
+
+namespace milvus {
+namespace engine {
+
+LoadingIndexMgr&
+LoadingIndexMgr::GetInstance() {
+    static LoadingIndexMgr s_mgr;
+    return s_mgr;
+}
+
+VecIndexPtr
+LoadingIndexMgr::Load(const std::string& location, const std::function<VecIndexPtr()>& read) {
+    LoadSlotPtr slot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        DropReleasedSlots();
+        auto& entry = slots_[location];
+        if (entry == nullptr) {
+            entry = std::make_shared<LoadSlot>();
+        }
+        slot = entry;
+    }
+
+    // a second loader waits for the first read rather than reading the file in parallel
+    std::lock_guard<std::mutex> lock(slot->mutex_);
+    auto index = slot->index_.lock();
+    if (index == nullptr) {
+        index = read();
+        slot->index_ = index;
+    }
+    return index;
+}
+
+void
+LoadingIndexMgr::DropReleasedSlots() {
+    for (auto iter = slots_.begin(); iter != slots_.end();) {
+        if (iter->second.use_count() == 1 && iter->second->index_.expired()) {
+            iter = slots_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
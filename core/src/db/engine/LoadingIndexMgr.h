@@ -0,0 +1,56 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "wrapper/VecIndex.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace milvus {
+namespace engine {
+
+// A file read from disk without being cached, typically the raw file of a build task, stays reachable here for as
+// long as an engine holds it. A search of the same file in the meantime takes it instead of reading it again, and
+// engines loading one file at the same time wait for a single read.
+class LoadingIndexMgr {
+ public:
+    static LoadingIndexMgr&
+    GetInstance();
+
+    // index of location held by any engine, or the one read returns; read is called by one caller at a time
+    VecIndexPtr
+    Load(const std::string& location, const std::function<VecIndexPtr()>& read);
+
+ private:
+    LoadingIndexMgr() = default;
+
+    struct LoadSlot {
+        std::mutex mutex_;
+        std::weak_ptr<VecIndex> index_;
+    };
+    using LoadSlotPtr = std::shared_ptr<LoadSlot>;
+
+    // slots nobody holds an index of or waits on are dropped, mutex_ is held by the caller
+    void
+    DropReleasedSlots();
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, LoadSlotPtr> slots_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,276 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/SegmentAttrs.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+constexpr size_t MAX_CACHED_ATTRS = 1024;
+constexpr const char* ATTRS_SUFFIX = ".attrs";
+
+namespace {
+
+void
+ToDouble(AttrColumn& column) {
+    if (column.type_ == AttrColumn::Type::DOUBLE) {
+        return;
+    }
+    column.double_values_.assign(column.int_values_.begin(), column.int_values_.end());
+    std::vector<int64_t>().swap(column.int_values_);
+    column.type_ = AttrColumn::Type::DOUBLE;
+}
+
+bool
+Matches(const AttrPredicate& predicate, double value) {
+    if (std::isnan(value) || predicate.values_.empty()) {
+        return false;
+    }
+
+    double operand = predicate.values_.front();
+    switch (predicate.op_) {
+        case AttrPredicate::Op::EQ:
+            return value == operand;
+        case AttrPredicate::Op::NE:
+            return value != operand;
+        case AttrPredicate::Op::LT:
+            return value < operand;
+        case AttrPredicate::Op::LE:
+            return value <= operand;
+        case AttrPredicate::Op::GT:
+            return value > operand;
+        case AttrPredicate::Op::GE:
+            return value >= operand;
+        case AttrPredicate::Op::IN:
+            return std::find(predicate.values_.begin(), predicate.values_.end(), value) != predicate.values_.end();
+    }
+    return false;
+}
+
+}  // namespace
+
+void
+SegmentAttrs::Append(const int64_t* ids, int64_t count, const AttrColumns& columns, int64_t offset) {
+    if (count <= 0) {
+        return;
+    }
+
+    size_t rows = ids_.size();
+    for (auto& pair : columns) {
+        auto& from = pair.second;
+        auto& column = columns_[pair.first];
+        // a column new to the file has no value for the vectors before
+        if (column.Size() < rows || column.type_ != from.type_) {
+            ToDouble(column);
+            column.double_values_.resize(rows, std::numeric_limits<double>::quiet_NaN());
+        }
+
+        if (column.type_ == AttrColumn::Type::INT64) {
+            column.int_values_.insert(column.int_values_.end(), from.int_values_.begin() + offset,
+                                      from.int_values_.begin() + offset + count);
+        } else {
+            for (int64_t i = 0; i < count; i++) {
+                column.double_values_.push_back(from.Value(offset + i));
+            }
+        }
+    }
+    ids_.insert(ids_.end(), ids, ids + count);
+
+    // nor do the vectors for the columns they lack
+    for (auto& pair : columns_) {
+        if (pair.second.Size() < ids_.size()) {
+            ToDouble(pair.second);
+            pair.second.double_values_.resize(ids_.size(), std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+}
+
+void
+SegmentAttrs::Append(const SegmentAttrs& other) {
+    Append(other.ids_.data(), other.Count(), other.columns_, 0);
+}
+
+void
+SegmentAttrs::Match(const AttrPredicates& predicates, const SegmentTombstone* tombstone,
+                    std::vector<bool>& rows) const {
+    rows.assign(ids_.size(), true);
+    for (auto& predicate : predicates) {
+        auto iter = columns_.find(predicate.name_);
+        if (iter == columns_.end()) {
+            rows.assign(ids_.size(), false);
+            return;
+        }
+
+        auto& column = iter->second;
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i] && !Matches(predicate, column.Value(i))) {
+                rows[i] = false;
+            }
+        }
+    }
+
+    if (tombstone != nullptr) {
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i] && tombstone->IsDeleted(ids_[i])) {
+                rows[i] = false;
+            }
+        }
+    }
+}
+
+void
+SegmentAttrs::MatchIds(const AttrPredicates& predicates, const SegmentTombstone* tombstone,
+                       std::vector<int64_t>& ids) const {
+    std::vector<bool> rows;
+    Match(predicates, tombstone, rows);
+    for (size_t i = 0; i < rows.size(); i++) {
+        if (rows[i]) {
+            ids.push_back(ids_[i]);
+        }
+    }
+}
+
+// layout: | row count (uint64) | ids | column count (uint32) |
+//         | name length (uint16) | name | type (uint8) | values (8 bytes each) | ... for each column
+Status
+SegmentAttrs::Write(const std::string& location) const {
+    std::string path = GetAttrsPath(location);
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return Status(DB_ERROR, "Failed to open segment attributes: " + path);
+    }
+
+    uint64_t rows = ids_.size();
+    uint32_t column_count = columns_.size();
+    file.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    file.write(reinterpret_cast<const char*>(ids_.data()), rows * sizeof(int64_t));
+    file.write(reinterpret_cast<const char*>(&column_count), sizeof(column_count));
+    for (auto& pair : columns_) {
+        uint16_t name_length = pair.first.size();
+        uint8_t type = static_cast<uint8_t>(pair.second.type_);
+        file.write(reinterpret_cast<const char*>(&name_length), sizeof(name_length));
+        file.write(pair.first.data(), name_length);
+        file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+        if (pair.second.type_ == AttrColumn::Type::INT64) {
+            file.write(reinterpret_cast<const char*>(pair.second.int_values_.data()), rows * sizeof(int64_t));
+        } else {
+            file.write(reinterpret_cast<const char*>(pair.second.double_values_.data()), rows * sizeof(double));
+        }
+    }
+    if (!file.good()) {
+        return Status(DB_ERROR, "Failed to write segment attributes: " + path);
+    }
+
+    return Status::OK();
+}
+
+Status
+SegmentAttrs::Read(const std::string& location) {
+    ids_.clear();
+    columns_.clear();
+    std::string path = GetAttrsPath(location);
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return Status(DB_NOT_FOUND, "Segment attributes not found: " + path);
+    }
+
+    uint64_t rows = 0;
+    uint32_t column_count = 0;
+    file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+    if (file.good()) {
+        ids_.resize(rows);
+        file.read(reinterpret_cast<char*>(ids_.data()), rows * sizeof(int64_t));
+        file.read(reinterpret_cast<char*>(&column_count), sizeof(column_count));
+    }
+    for (uint32_t i = 0; i < column_count && file.good(); i++) {
+        uint16_t name_length = 0;
+        uint8_t type = 0;
+        file.read(reinterpret_cast<char*>(&name_length), sizeof(name_length));
+        std::string name(name_length, '\0');
+        file.read(&name[0], name_length);
+        file.read(reinterpret_cast<char*>(&type), sizeof(type));
+
+        auto& column = columns_[name];
+        column.type_ = static_cast<AttrColumn::Type>(type);
+        if (column.type_ == AttrColumn::Type::INT64) {
+            column.int_values_.resize(rows);
+            file.read(reinterpret_cast<char*>(column.int_values_.data()), rows * sizeof(int64_t));
+        } else {
+            column.double_values_.resize(rows);
+            file.read(reinterpret_cast<char*>(column.double_values_.data()), rows * sizeof(double));
+        }
+    }
+    if (!file.good()) {
+        ids_.clear();
+        columns_.clear();
+        return Status(DB_ERROR, "Invalid segment attributes: " + path);
+    }
+
+    return Status::OK();
+}
+
+std::string
+SegmentAttrs::GetAttrsPath(const std::string& location) {
+    return location + ATTRS_SUFFIX;
+}
+
+SegmentAttrsMgr::SegmentAttrsMgr() : attrs_(MAX_CACHED_ATTRS) {
+}
+
+SegmentAttrsMgr&
+SegmentAttrsMgr::GetInstance() {
+    static SegmentAttrsMgr s_mgr;
+    return s_mgr;
+}
+
+SegmentAttrsPtr
+SegmentAttrsMgr::GetAttrs(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (attrs_.exists(location)) {
+        return attrs_.get(location);
+    }
+
+    auto attrs = std::make_shared<SegmentAttrs>();
+    if (!attrs->Read(location).ok()) {
+        attrs = nullptr;
+    }
+    attrs_.put(location, attrs);
+    return attrs;
+}
+
+void
+SegmentAttrsMgr::EraseAttrs(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    attrs_.erase(location);
+}
+
+IDFilterPtr
+SegmentAttrsMgr::Filter(const std::vector<std::string>& locations, const AttrPredicates& predicates) {
+    std::vector<int64_t> ids;
+    for (auto& location : locations) {
+        auto attrs = GetAttrs(location);
+        if (attrs != nullptr) {
+            auto tombstone = SegmentTombstoneMgr::GetInstance().GetTombstone(location);
+            attrs->MatchIds(predicates, tombstone.get(), ids);
+        }
+    }
+    return std::make_shared<knowhere::IDFilter>(ids, false);
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,106 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/LRU.h"
+#include "db/Types.h"
+#include "db/engine/ExecutionEngine.h"
+#include "db/engine/SegmentTombstone.h"
+#include "utils/Status.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// Scalar attributes of the vectors in a table file, column by column in the order of their ids, stored beside the
+// file. A filtered search evaluates its predicates over the columns into a whitelist of ids before any distance is
+// computed, rather than over-fetching the topk and dropping what doesn't match. A vector inserted without an
+// attribute has NaN for it and matches no predicate on it.
+class SegmentAttrs {
+ public:
+    int64_t
+    Count() const {
+        return ids_.size();
+    }
+
+    const std::vector<int64_t>&
+    Ids() const {
+        return ids_;
+    }
+
+    const AttrColumns&
+    Columns() const {
+        return columns_;
+    }
+
+    // attributes of count vectors, from row offset of the columns; an int column is turned to double when it is
+    // given doubles or has to be padded
+    void
+    Append(const int64_t* ids, int64_t count, const AttrColumns& columns, int64_t offset);
+
+    void
+    Append(const SegmentAttrs& other);
+
+    // bitset of the rows matching all the predicates, rows of deleted vectors never match
+    void
+    Match(const AttrPredicates& predicates, const SegmentTombstone* tombstone, std::vector<bool>& rows) const;
+
+    // ids of the matched rows are appended
+    void
+    MatchIds(const AttrPredicates& predicates, const SegmentTombstone* tombstone, std::vector<int64_t>& ids) const;
+
+    Status
+    Write(const std::string& location) const;
+
+    Status
+    Read(const std::string& location);
+
+    static std::string
+    GetAttrsPath(const std::string& location);
+
+ private:
+    std::vector<int64_t> ids_;
+    AttrColumns columns_;
+};
+
+using SegmentAttrsPtr = std::shared_ptr<const SegmentAttrs>;
+
+// keep attributes read from disk, a file without attributes is cached as nullptr
+class SegmentAttrsMgr {
+ public:
+    static SegmentAttrsMgr&
+    GetInstance();
+
+    SegmentAttrsPtr
+    GetAttrs(const std::string& location);
+
+    void
+    EraseAttrs(const std::string& location);
+
+    // whitelist of the vectors in the files matching the predicates, for ExecutionEngine::Search
+    IDFilterPtr
+    Filter(const std::vector<std::string>& locations, const AttrPredicates& predicates);
+
+ private:
+    SegmentAttrsMgr();
+
+ private:
+    std::mutex mutex_;
+    cache::LRU<std::string, SegmentAttrsPtr> attrs_;
+};
+
+}  // namespace engine
+}  // namespace milvus
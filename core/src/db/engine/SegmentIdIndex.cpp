@@ -0,0 +1,143 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/SegmentIdIndex.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+namespace milvus {
+namespace engine {
+
+// an id index takes 12 bytes per vector, only those of recently looked up files are kept
+constexpr size_t MAX_CACHED_ID_INDEX = 256;
+constexpr const char* ID_INDEX_SUFFIX = ".ids";
+
+Status
+SegmentIdIndex::Build(const int64_t* ids, int64_t count, SegmentIdIndex& id_index) {
+    if (ids == nullptr || count <= 0) {
+        return Status(DB_ERROR, "No id to build segment id index");
+    }
+    if (count > std::numeric_limits<uint32_t>::max()) {
+        return Status(DB_ERROR, "Too many ids to build segment id index");
+    }
+
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [ids](uint32_t l, uint32_t r) { return ids[l] < ids[r]; });
+
+    id_index.ids_.resize(count);
+    for (int64_t i = 0; i < count; i++) {
+        id_index.ids_[i] = ids[order[i]];
+    }
+    id_index.offsets_.swap(order);
+    return Status::OK();
+}
+
+Status
+SegmentIdIndex::Write(const std::string& location) const {
+    std::string path = GetIdIndexPath(location);
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return Status(DB_ERROR, "Failed to open segment id index: " + path);
+    }
+
+    uint64_t count = ids_.size();
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(ids_.data()), count * sizeof(int64_t));
+    file.write(reinterpret_cast<const char*>(offsets_.data()), count * sizeof(uint32_t));
+    if (!file.good()) {
+        return Status(DB_ERROR, "Failed to write segment id index: " + path);
+    }
+
+    return Status::OK();
+}
+
+Status
+SegmentIdIndex::Read(const std::string& location) {
+    std::string path = GetIdIndexPath(location);
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return Status(DB_NOT_FOUND, "Segment id index not found: " + path);
+    }
+
+    uint64_t count = 0;
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file.good() || count == 0 || count > std::numeric_limits<uint32_t>::max()) {
+        return Status(DB_ERROR, "Invalid segment id index: " + path);
+    }
+    ids_.resize(count);
+    offsets_.resize(count);
+    file.read(reinterpret_cast<char*>(ids_.data()), count * sizeof(int64_t));
+    file.read(reinterpret_cast<char*>(offsets_.data()), count * sizeof(uint32_t));
+    if (!file.good()) {
+        ids_.clear();
+        offsets_.clear();
+        return Status(DB_ERROR, "Invalid segment id index: " + path);
+    }
+
+    return Status::OK();
+}
+
+int64_t
+SegmentIdIndex::Find(int64_t id) const {
+    auto iter = std::lower_bound(ids_.begin(), ids_.end(), id);
+    if (iter == ids_.end() || *iter != id) {
+        return -1;
+    }
+    return offsets_[iter - ids_.begin()];
+}
+
+std::string
+SegmentIdIndex::GetIdIndexPath(const std::string& location) {
+    return location + ID_INDEX_SUFFIX;
+}
+
+SegmentIdIndexMgr::SegmentIdIndexMgr() : id_indexes_(MAX_CACHED_ID_INDEX) {
+}
+
+SegmentIdIndexMgr&
+SegmentIdIndexMgr::GetInstance() {
+    static SegmentIdIndexMgr s_mgr;
+    return s_mgr;
+}
+
+SegmentIdIndexPtr
+SegmentIdIndexMgr::GetIdIndex(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id_indexes_.exists(location)) {
+        return id_indexes_.get(location);
+    }
+
+    auto id_index = std::make_shared<SegmentIdIndex>();
+    if (!id_index->Read(location).ok()) {
+        id_index = nullptr;
+    }
+    id_indexes_.put(location, id_index);
+    return id_index;
+}
+
+void
+SegmentIdIndexMgr::PutIdIndex(const std::string& location, const SegmentIdIndexPtr& id_index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    id_indexes_.put(location, id_index);
+}
+
+void
+SegmentIdIndexMgr::EraseIdIndex(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    id_indexes_.erase(location);
+}
+
+}  // namespace engine
+}  // namespace milvus
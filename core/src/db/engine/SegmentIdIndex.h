@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/LRU.h"
+#include "utils/Status.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// Sorted ids of a raw table file with the offsets of their vectors, written beside the file, so a lookup by id
+// finds the file holding the vector and its row without reading the vectors of other files.
+class SegmentIdIndex {
+ public:
+    static Status
+    Build(const int64_t* ids, int64_t count, SegmentIdIndex& id_index);
+
+    Status
+    Write(const std::string& location) const;
+
+    Status
+    Read(const std::string& location);
+
+    // offset of the vector in the file, -1 if the file doesn't hold it
+    int64_t
+    Find(int64_t id) const;
+
+    size_t
+    Count() const {
+        return ids_.size();
+    }
+
+    static std::string
+    GetIdIndexPath(const std::string& location);
+
+ private:
+    std::vector<int64_t> ids_;
+    std::vector<uint32_t> offsets_;
+};
+
+using SegmentIdIndexPtr = std::shared_ptr<SegmentIdIndex>;
+
+// keep id indexes read from disk, a file without one is cached as nullptr until one is put for it
+class SegmentIdIndexMgr {
+ public:
+    static SegmentIdIndexMgr&
+    GetInstance();
+
+    SegmentIdIndexPtr
+    GetIdIndex(const std::string& location);
+
+    void
+    PutIdIndex(const std::string& location, const SegmentIdIndexPtr& id_index);
+
+    void
+    EraseIdIndex(const std::string& location);
+
+ private:
+    SegmentIdIndexMgr();
+
+ private:
+    std::mutex mutex_;
+    cache::LRU<std::string, SegmentIdIndexPtr> id_indexes_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,193 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/SegmentSummary.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace milvus {
+namespace engine {
+
+constexpr size_t MAX_CACHED_SUMMARY = 100000;
+constexpr const char* SUMMARY_SUFFIX = ".summary";
+
+Status
+SegmentSummary::Build(const float* vectors, const int64_t* ids, int64_t count, uint16_t dimension,
+                      SegmentSummary& summary) {
+    if (vectors == nullptr || ids == nullptr || count <= 0 || dimension == 0) {
+        return Status(DB_ERROR, "No vector to build segment summary");
+    }
+
+    std::vector<double> sum(dimension, 0.0);
+    for (int64_t i = 0; i < count; i++) {
+        const float* vector = vectors + i * dimension;
+        for (uint16_t j = 0; j < dimension; j++) {
+            sum[j] += vector[j];
+        }
+    }
+
+    summary.centroid_.resize(dimension);
+    for (uint16_t j = 0; j < dimension; j++) {
+        summary.centroid_[j] = static_cast<float>(sum[j] / count);
+    }
+
+    double max_distance = 0.0;
+    double min_norm = std::numeric_limits<double>::max(), max_norm = 0.0;
+    for (int64_t i = 0; i < count; i++) {
+        const float* vector = vectors + i * dimension;
+        double distance = 0.0, norm = 0.0;
+        for (uint16_t j = 0; j < dimension; j++) {
+            double diff = vector[j] - summary.centroid_[j];
+            distance += diff * diff;
+            norm += static_cast<double>(vector[j]) * vector[j];
+        }
+        max_distance = std::max(max_distance, distance);
+        min_norm = std::min(min_norm, norm);
+        max_norm = std::max(max_norm, norm);
+    }
+    summary.radius_ = std::sqrt(max_distance);
+    summary.min_norm_ = std::sqrt(min_norm);
+    summary.max_norm_ = std::sqrt(max_norm);
+
+    auto id_range = std::minmax_element(ids, ids + count);
+    summary.min_id_ = *id_range.first;
+    summary.max_id_ = *id_range.second;
+
+    return Status::OK();
+}
+
+Status
+SegmentSummary::Write(const std::string& location) const {
+    std::string path = GetSummaryPath(location);
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return Status(DB_ERROR, "Failed to open segment summary: " + path);
+    }
+
+    uint16_t dimension = Dimension();
+    file.write(reinterpret_cast<const char*>(&dimension), sizeof(dimension));
+    file.write(reinterpret_cast<const char*>(&radius_), sizeof(radius_));
+    file.write(reinterpret_cast<const char*>(centroid_.data()), dimension * sizeof(float));
+    file.write(reinterpret_cast<const char*>(&min_norm_), sizeof(min_norm_));
+    file.write(reinterpret_cast<const char*>(&max_norm_), sizeof(max_norm_));
+    file.write(reinterpret_cast<const char*>(&min_id_), sizeof(min_id_));
+    file.write(reinterpret_cast<const char*>(&max_id_), sizeof(max_id_));
+    if (!file.good()) {
+        return Status(DB_ERROR, "Failed to write segment summary: " + path);
+    }
+
+    return Status::OK();
+}
+
+Status
+SegmentSummary::Read(const std::string& location) {
+    std::string path = GetSummaryPath(location);
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return Status(DB_NOT_FOUND, "Segment summary not found: " + path);
+    }
+
+    uint16_t dimension = 0;
+    file.read(reinterpret_cast<char*>(&dimension), sizeof(dimension));
+    file.read(reinterpret_cast<char*>(&radius_), sizeof(radius_));
+    centroid_.resize(dimension);
+    file.read(reinterpret_cast<char*>(centroid_.data()), dimension * sizeof(float));
+    if (!file.good() || dimension == 0) {
+        centroid_.clear();
+        return Status(DB_ERROR, "Invalid segment summary: " + path);
+    }
+
+    // ranges follow the centroid, a summary written before them ends here
+    double min_norm = 0.0, max_norm = 0.0;
+    int64_t min_id = 0, max_id = 0;
+    file.read(reinterpret_cast<char*>(&min_norm), sizeof(min_norm));
+    file.read(reinterpret_cast<char*>(&max_norm), sizeof(max_norm));
+    file.read(reinterpret_cast<char*>(&min_id), sizeof(min_id));
+    file.read(reinterpret_cast<char*>(&max_id), sizeof(max_id));
+    if (file.good()) {
+        min_norm_ = min_norm;
+        max_norm_ = max_norm;
+        min_id_ = min_id;
+        max_id_ = max_id;
+    }
+
+    return Status::OK();
+}
+
+double
+SegmentSummary::Bound(const float* query, MetricType metric_type) const {
+    double distance = 0.0, product = 0.0, norm = 0.0;
+    for (size_t j = 0; j < centroid_.size(); j++) {
+        double diff = query[j] - centroid_[j];
+        distance += diff * diff;
+        product += static_cast<double>(query[j]) * centroid_[j];
+        norm += static_cast<double>(query[j]) * query[j];
+    }
+
+    double query_norm = std::sqrt(norm);
+    if (metric_type == MetricType::IP) {
+        // Cauchy-Schwarz: <q, x> = <q, c> + <q, x - c> <= <q, c> + |q| * radius, and <q, x> <= |q| * |x|
+        return std::min(product + query_norm * radius_, query_norm * max_norm_);
+    }
+
+    // triangle inequality: |q - x| >= |q - c| - radius and |q - x| >= ||q| - |x||, faiss L2 distance is squared
+    double lower = std::max(0.0, std::sqrt(distance) - radius_);
+    lower = std::max(lower, query_norm - max_norm_);
+    lower = std::max(lower, min_norm_ - query_norm);
+    return lower * lower;
+}
+
+std::string
+SegmentSummary::GetSummaryPath(const std::string& location) {
+    return location + SUMMARY_SUFFIX;
+}
+
+SegmentSummaryMgr::SegmentSummaryMgr() : summaries_(MAX_CACHED_SUMMARY) {
+}
+
+SegmentSummaryMgr&
+SegmentSummaryMgr::GetInstance() {
+    static SegmentSummaryMgr s_mgr;
+    return s_mgr;
+}
+
+SegmentSummaryPtr
+SegmentSummaryMgr::GetSummary(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (summaries_.exists(location)) {
+        return summaries_.get(location);
+    }
+
+    auto summary = std::make_shared<SegmentSummary>();
+    if (!summary->Read(location).ok()) {
+        summary = nullptr;
+    }
+    summaries_.put(location, summary);
+    return summary;
+}
+
+void
+SegmentSummaryMgr::PutSummary(const std::string& location, const SegmentSummaryPtr& summary) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    summaries_.put(location, summary);
+}
+
+void
+SegmentSummaryMgr::EraseSummary(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    summaries_.erase(location);
+}
+
+}  // namespace engine
+}  // namespace milvus
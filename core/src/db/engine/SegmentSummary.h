@@ -0,0 +1,119 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/LRU.h"
+#include "db/engine/ExecutionEngine.h"
+#include "utils/Status.h"
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// Centroid, radius, norm range and id range of the float vectors in a table file. The summary is stored beside
+// the file and lets a search skip the file when no vector in it can enter the topk result, and a lookup by id skip
+// the file when the id is out of its range. Row count and deleted count of the file are in meta and its tombstone.
+// Bounds are taken on the original vectors, so skipping is exact for raw and IVFFLAT files only. An SQ8 or PQ file
+// reports quantized distances, and a vector of a skipped file could have entered the topk by its quantization error.
+class SegmentSummary {
+ public:
+    static Status
+    Build(const float* vectors, const int64_t* ids, int64_t count, uint16_t dimension, SegmentSummary& summary);
+
+    Status
+    Write(const std::string& location) const;
+
+    Status
+    Read(const std::string& location);
+
+    // lower bound of L2 distance, or upper bound of inner product, between the query and any vector of the file
+    double
+    Bound(const float* query, MetricType metric_type) const;
+
+    // false if the id is surely not in the file
+    bool
+    MayContain(int64_t id) const {
+        return id >= min_id_ && id <= max_id_;
+    }
+
+    int64_t
+    MinId() const {
+        return min_id_;
+    }
+
+    int64_t
+    MaxId() const {
+        return max_id_;
+    }
+
+    double
+    MinNorm() const {
+        return min_norm_;
+    }
+
+    double
+    MaxNorm() const {
+        return max_norm_;
+    }
+
+    uint16_t
+    Dimension() const {
+        return static_cast<uint16_t>(centroid_.size());
+    }
+
+    static std::string
+    GetSummaryPath(const std::string& location);
+
+ private:
+    std::vector<float> centroid_;
+    double radius_ = 0.0;  // max L2 distance from the centroid to a vector of the file
+
+    // a summary written before the ranges were kept bounds nothing by them
+    double min_norm_ = 0.0;
+    double max_norm_ = std::numeric_limits<double>::max();
+    int64_t min_id_ = std::numeric_limits<int64_t>::min();
+    int64_t max_id_ = std::numeric_limits<int64_t>::max();
+};
+
+using SegmentSummaryPtr = std::shared_ptr<SegmentSummary>;
+
+// keep summaries read from disk, a file without summary is cached as nullptr
+class SegmentSummaryMgr {
+ public:
+    static SegmentSummaryMgr&
+    GetInstance();
+
+    SegmentSummaryPtr
+    GetSummary(const std::string& location);
+
+    // replace the cached summary, a file cached without summary gets the one built later
+    void
+    PutSummary(const std::string& location, const SegmentSummaryPtr& summary);
+
+    void
+    EraseSummary(const std::string& location);
+
+ private:
+    SegmentSummaryMgr();
+
+ private:
+    std::mutex mutex_;
+    cache::LRU<std::string, SegmentSummaryPtr> summaries_;
+};
+
+}  // namespace engine
+}  // namespace milvus
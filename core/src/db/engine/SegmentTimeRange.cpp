@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/SegmentTimeRange.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace milvus {
+namespace engine {
+
+constexpr size_t MAX_CACHED_TIME_RANGE = 100000;
+constexpr const char* TIME_RANGE_SUFFIX = ".time";
+
+void
+SegmentTimeRange::Extend(int64_t time_us) {
+    min_us_ = std::min(min_us_, time_us);
+    max_us_ = std::max(max_us_, time_us);
+}
+
+void
+SegmentTimeRange::Extend(const SegmentTimeRange& other) {
+    min_us_ = std::min(min_us_, other.min_us_);
+    max_us_ = std::max(max_us_, other.max_us_);
+}
+
+bool
+SegmentTimeRange::Overlaps(const TimeRanges& ranges) const {
+    if (ranges.empty()) {
+        return true;
+    }
+
+    for (auto& range : ranges) {
+        // ranges are [start, end), insert time of the file is [min, max]
+        if (min_us_ < range.end_us_ && max_us_ >= range.start_us_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Status
+SegmentTimeRange::Write(const std::string& location) const {
+    std::string path = GetTimeRangePath(location);
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return Status(DB_ERROR, "Failed to open segment time range: " + path);
+    }
+
+    file.write(reinterpret_cast<const char*>(&min_us_), sizeof(min_us_));
+    file.write(reinterpret_cast<const char*>(&max_us_), sizeof(max_us_));
+    if (!file.good()) {
+        return Status(DB_ERROR, "Failed to write segment time range: " + path);
+    }
+
+    return Status::OK();
+}
+
+Status
+SegmentTimeRange::Read(const std::string& location) {
+    std::string path = GetTimeRangePath(location);
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return Status(DB_NOT_FOUND, "Segment time range not found: " + path);
+    }
+
+    int64_t min_us = 0, max_us = 0;
+    file.read(reinterpret_cast<char*>(&min_us), sizeof(min_us));
+    file.read(reinterpret_cast<char*>(&max_us), sizeof(max_us));
+    if (!file.good() || min_us > max_us) {
+        return Status(DB_ERROR, "Invalid segment time range: " + path);
+    }
+
+    min_us_ = min_us;
+    max_us_ = max_us;
+    return Status::OK();
+}
+
+std::string
+SegmentTimeRange::GetTimeRangePath(const std::string& location) {
+    return location + TIME_RANGE_SUFFIX;
+}
+
+SegmentTimeRangeMgr::SegmentTimeRangeMgr() : time_ranges_(MAX_CACHED_TIME_RANGE) {
+}
+
+SegmentTimeRangeMgr&
+SegmentTimeRangeMgr::GetInstance() {
+    static SegmentTimeRangeMgr s_mgr;
+    return s_mgr;
+}
+
+SegmentTimeRangePtr
+SegmentTimeRangeMgr::GetTimeRange(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (time_ranges_.exists(location)) {
+        return time_ranges_.get(location);
+    }
+
+    auto time_range = std::make_shared<SegmentTimeRange>();
+    if (!time_range->Read(location).ok()) {
+        time_range = nullptr;
+    }
+    time_ranges_.put(location, time_range);
+    return time_range;
+}
+
+void
+SegmentTimeRangeMgr::EraseTimeRange(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    time_ranges_.erase(location);
+}
+
+}  // namespace engine
+}  // namespace milvus
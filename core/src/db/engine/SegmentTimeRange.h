@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/LRU.h"
+#include "db/Types.h"
+#include "utils/Status.h"
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace engine {
+
+// Insert time of the first and the last vector of a table file, in microseconds, stored beside the file. Dates
+// select files by the day they were created, a search limited to time ranges within a day skips the files whose
+// vectors were all inserted out of them. A file without insert time is always searched.
+class SegmentTimeRange {
+ public:
+    bool
+    Empty() const {
+        return min_us_ > max_us_;
+    }
+
+    int64_t
+    MinTime() const {
+        return min_us_;
+    }
+
+    int64_t
+    MaxTime() const {
+        return max_us_;
+    }
+
+    void
+    Extend(int64_t time_us);
+
+    void
+    Extend(const SegmentTimeRange& other);
+
+    // true if any vector of the file may be inserted in one of the ranges, or no range is given
+    bool
+    Overlaps(const TimeRanges& ranges) const;
+
+    Status
+    Write(const std::string& location) const;
+
+    Status
+    Read(const std::string& location);
+
+    static std::string
+    GetTimeRangePath(const std::string& location);
+
+ private:
+    int64_t min_us_ = std::numeric_limits<int64_t>::max();
+    int64_t max_us_ = std::numeric_limits<int64_t>::min();
+};
+
+using SegmentTimeRangePtr = std::shared_ptr<SegmentTimeRange>;
+
+// keep insert time ranges read from disk, a file without one is cached as nullptr
+class SegmentTimeRangeMgr {
+ public:
+    static SegmentTimeRangeMgr&
+    GetInstance();
+
+    SegmentTimeRangePtr
+    GetTimeRange(const std::string& location);
+
+    void
+    EraseTimeRange(const std::string& location);
+
+ private:
+    SegmentTimeRangeMgr();
+
+ private:
+    std::mutex mutex_;
+    cache::LRU<std::string, SegmentTimeRangePtr> time_ranges_;
+};
+
+}  // namespace engine
+}  // namespace milvus
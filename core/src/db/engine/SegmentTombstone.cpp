@@ -0,0 +1,156 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/SegmentTombstone.h"
+#include "utils/Log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+constexpr size_t MAX_CACHED_TOMBSTONE = 100000;
+constexpr const char* TOMBSTONE_SUFFIX = ".del";
+
+SegmentTombstone::SegmentTombstone(std::vector<int64_t> ids)
+    : ids_(std::move(ids)), filter_(std::make_shared<knowhere::IDFilter>(ids_, true)) {
+}
+
+Status
+SegmentTombstone::Read(const std::string& location, std::vector<int64_t>& ids) {
+    ids.clear();
+    std::string path = GetTombstonePath(location);
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return Status(DB_NOT_FOUND, "Segment tombstone not found: " + path);
+    }
+
+    std::string buf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    // an id torn by a crash was never acknowledged as deleted
+    ids.resize(buf.size() / sizeof(int64_t));
+    memcpy(ids.data(), buf.data(), ids.size() * sizeof(int64_t));
+    return Status::OK();
+}
+
+Status
+SegmentTombstone::Append(const std::string& location, const std::vector<int64_t>& ids) {
+    std::string path = GetTombstonePath(location);
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return Status(DB_ERROR, "Failed to open segment tombstone " + path + ": " + strerror(errno));
+    }
+
+    // a torn id left by an earlier crash would shift the ids appended after it
+    auto size = ::lseek(fd, 0, SEEK_END);
+    if (size > 0 && size % sizeof(int64_t) != 0 && ::ftruncate(fd, size - size % sizeof(int64_t)) != 0) {
+        ::close(fd);
+        return Status(DB_ERROR, "Failed to truncate segment tombstone " + path + ": " + strerror(errno));
+    }
+
+    auto data = reinterpret_cast<const char*>(ids.data());
+    size_t length = ids.size() * sizeof(int64_t), written = 0;
+    while (written < length) {
+        auto ret = ::write(fd, data + written, length - written);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ::close(fd);
+            return Status(DB_ERROR, "Failed to write segment tombstone " + path + ": " + strerror(errno));
+        }
+        written += ret;
+    }
+    if (::fdatasync(fd) != 0) {
+        ::close(fd);
+        return Status(DB_ERROR, "Failed to sync segment tombstone " + path + ": " + strerror(errno));
+    }
+    ::close(fd);
+    return Status::OK();
+}
+
+std::string
+SegmentTombstone::GetTombstonePath(const std::string& location) {
+    return location + TOMBSTONE_SUFFIX;
+}
+
+SegmentTombstoneMgr::SegmentTombstoneMgr() : tombstones_(MAX_CACHED_TOMBSTONE) {
+}
+
+SegmentTombstoneMgr&
+SegmentTombstoneMgr::GetInstance() {
+    static SegmentTombstoneMgr s_mgr;
+    return s_mgr;
+}
+
+SegmentTombstonePtr
+SegmentTombstoneMgr::GetTombstone(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tombstones_.exists(location)) {
+        return tombstones_.get(location);
+    }
+
+    SegmentTombstonePtr tombstone = nullptr;
+    std::vector<int64_t> ids;
+    if (SegmentTombstone::Read(location, ids).ok() && !ids.empty()) {
+        tombstone = std::make_shared<SegmentTombstone>(std::move(ids));
+    }
+    tombstones_.put(location, tombstone);
+    return tombstone;
+}
+
+Status
+SegmentTombstoneMgr::Delete(const std::string& location, const std::vector<int64_t>& ids) {
+    auto tombstone = GetTombstone(location);
+
+    std::vector<int64_t> deleted;
+    std::unordered_set<int64_t> seen;
+    for (auto id : ids) {
+        if ((tombstone == nullptr || !tombstone->IsDeleted(id)) && seen.insert(id).second) {
+            deleted.push_back(id);
+        }
+    }
+    if (deleted.empty()) {
+        return Status::OK();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto status = SegmentTombstone::Append(location, deleted);
+    if (!status.ok()) {
+        // ids written partially are on disk but not in memory, a reread finds them
+        tombstones_.erase(location);
+        return status;
+    }
+
+    std::vector<int64_t> all_ids;
+    if (tombstone != nullptr) {
+        all_ids = tombstone->Ids();
+    }
+    all_ids.insert(all_ids.end(), deleted.begin(), deleted.end());
+    tombstones_.put(location, std::make_shared<SegmentTombstone>(std::move(all_ids)));
+    ENGINE_LOG_DEBUG << "Delete " << deleted.size() << " vectors from " << location;
+    return Status::OK();
+}
+
+void
+SegmentTombstoneMgr::EraseTombstone(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tombstones_.erase(location);
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,106 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/LRU.h"
+#include "db/engine/ExecutionEngine.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
+#include "utils/Status.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// Ids of the vectors deleted from a table file, appended to a file beside it. A search of the file skips them,
+// a merge drops them and the file is compacted once they are a large part of it. A tombstone is never changed,
+// deleting more ids makes a new one.
+class SegmentTombstone {
+ public:
+    explicit SegmentTombstone(std::vector<int64_t> ids);
+
+    // in the order they were deleted
+    const std::vector<int64_t>&
+    Ids() const {
+        return ids_;
+    }
+
+    size_t
+    Count() const {
+        return ids_.size();
+    }
+
+    bool
+    IsDeleted(int64_t id) const {
+        return !filter_->is_member(id);
+    }
+
+    // blacklist of the deleted ids for ExecutionEngine::Search
+    const IDFilterPtr&
+    Filter() const {
+        return filter_;
+    }
+
+    static Status
+    Read(const std::string& location, std::vector<int64_t>& ids);
+
+    // ids are synced to disk before it returns
+    static Status
+    Append(const std::string& location, const std::vector<int64_t>& ids);
+
+    static std::string
+    GetTombstonePath(const std::string& location);
+
+ private:
+    std::vector<int64_t> ids_;
+    IDFilterPtr filter_;
+};
+
+using SegmentTombstonePtr = std::shared_ptr<const SegmentTombstone>;
+
+// keep tombstones read from disk, a file without deleted vectors is cached as nullptr;
+// ids are only deleted under DeleteMutex(), a file replacing others holds it to take over the ids deleted from them
+// while it was written
+class SegmentTombstoneMgr {
+ public:
+    static SegmentTombstoneMgr&
+    GetInstance();
+
+    SegmentTombstonePtr
+    GetTombstone(const std::string& location);
+
+    // ids already deleted from the file are skipped
+    Status
+    Delete(const std::string& location, const std::vector<int64_t>& ids);
+
+    void
+    EraseTombstone(const std::string& location);
+
+    std::mutex&
+    DeleteMutex() {
+        return delete_mutex_;
+    }
+
+ private:
+    SegmentTombstoneMgr();
+
+ private:
+    std::mutex mutex_;
+    std::mutex delete_mutex_;
+    cache::LRU<std::string, SegmentTombstonePtr> tombstones_;
+};
+
+}  // namespace engine
+}  // namespace milvus
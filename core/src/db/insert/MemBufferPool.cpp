@@ -0,0 +1,79 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/insert/MemBufferPool.h"
+
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+MemBufferPool&
+MemBufferPool::GetInstance() {
+    static MemBufferPool pool;
+    return pool;
+}
+
+uint64_t
+MemBufferPool::BufferMem(const std::vector<float>& vectors, const IDNumbers& ids) {
+    return vectors.capacity() * sizeof(float) + ids.capacity() * sizeof(IDNumber);
+}
+
+bool
+MemBufferPool::Acquire(uint64_t count, uint16_t dimension, std::vector<float>& vectors, IDNumbers& ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto iter = buffers_.begin(); iter != buffers_.end(); ++iter) {
+        if (iter->vectors_.capacity() >= count * dimension && iter->ids_.capacity() >= count) {
+            pooled_mem_ -= BufferMem(iter->vectors_, iter->ids_);
+            vectors.swap(iter->vectors_);
+            ids.swap(iter->ids_);
+            buffers_.erase(iter);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+MemBufferPool::Release(std::vector<float>& vectors, IDNumbers& ids) {
+    // clear() keeps the capacity
+    vectors.clear();
+    ids.clear();
+
+    uint64_t mem = BufferMem(vectors, ids);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mem == 0 || pooled_mem_ + mem > MAX_POOLED_BUFFER_MEM) {
+        return;
+    }
+
+    Buffer buffer;
+    buffer.vectors_.swap(vectors);
+    buffer.ids_.swap(ids);
+    buffers_.emplace_back(std::move(buffer));
+    pooled_mem_ += mem;
+}
+
+void
+MemBufferPool::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.clear();
+    pooled_mem_ = 0;
+}
+
+uint64_t
+MemBufferPool::PooledMem() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pooled_mem_;
+}
+
+}  // namespace engine
+}  // namespace milvus
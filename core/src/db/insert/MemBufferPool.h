@@ -0,0 +1,66 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Constants.h"
+#include "db/Types.h"
+
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// memory held by the pool is not accounted by insert buffer, keep it small
+constexpr uint64_t MAX_POOLED_BUFFER_MEM = 2 * MAX_TABLE_FILE_MEM;
+
+// Recycle raw data buffers of serialized mem table files.
+// A recycled buffer is already paged in, reusing it avoids page faults and reallocation during heavy ingestion.
+class MemBufferPool {
+ public:
+    static MemBufferPool&
+    GetInstance();
+
+    // take a buffer which can hold count vectors of the dimension, return false if no one is available
+    bool
+    Acquire(uint64_t count, uint16_t dimension, std::vector<float>& vectors, IDNumbers& ids);
+
+    // give back the buffers, they are dropped if the pool is full
+    void
+    Release(std::vector<float>& vectors, IDNumbers& ids);
+
+    void
+    Clear();
+
+    uint64_t
+    PooledMem();
+
+ private:
+    MemBufferPool() = default;
+
+    struct Buffer {
+        std::vector<float> vectors_;
+        IDNumbers ids_;
+    };
+
+    static uint64_t
+    BufferMem(const std::vector<float>& vectors, const IDNumbers& ids);
+
+ private:
+    std::mutex mutex_;
+    std::list<Buffer> buffers_;
+    uint64_t pooled_mem_ = 0;
+};  // MemBufferPool
+
+}  // namespace engine
+}  // namespace milvus
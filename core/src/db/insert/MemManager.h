@@ -12,11 +12,13 @@
 #pragma once
 
 #include "db/Types.h"
+#include "db/insert/MemTableFile.h"
 #include "utils/Status.h"
 
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace engine {
@@ -26,12 +28,26 @@ class MemManager {
     virtual Status
     InsertVectors(const std::string& table_id, VectorsData& vectors) = 0;
 
+    // table_ids returns tables whose data is persisted, a table failed to serialize is kept in memory to be
+    // serialized again by the next call, and the error is returned
     virtual Status
     Serialize(std::set<std::string>& table_ids) = 0;
 
+    // serialize the target tables only, table_ids returns tables which had data to serialize and persisted it
+    virtual Status
+    SerializeTables(const std::set<std::string>& target_table_ids, std::set<std::string>& table_ids) = 0;
+
+    // tables whose buffered data reaches the limit of flush policy
+    virtual Status
+    GetTablesToFlush(std::set<std::string>& table_ids) = 0;
+
     virtual Status
     EraseMemVector(const std::string& table_id) = 0;
 
+    // snapshot of files holding buffered vectors of the tables, including those under serialization
+    virtual Status
+    GetMemTableFiles(const std::set<std::string>& table_ids, std::vector<MemTableFilePtr>& mem_table_files) = 0;
+
     virtual size_t
     GetCurrentMutableMem() = 0;
 
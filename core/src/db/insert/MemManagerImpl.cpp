@@ -12,88 +12,230 @@
 #include "db/insert/MemManagerImpl.h"
 #include "VectorSource.h"
 #include "db/Constants.h"
+#include "metrics/Metrics.h"
 #include "utils/Log.h"
 
-#include <thread>
+#include <chrono>
+#include <unordered_set>
 
 namespace milvus {
 namespace engine {
 
+MemManagerImpl::MemShard&
+MemManagerImpl::GetShard(const std::string& table_id) {
+    return shards_[std::hash<std::string>()(table_id) % MEM_SHARD_NUM];
+}
+
 MemTablePtr
 MemManagerImpl::GetMemByTable(const std::string& table_id) {
-    auto memIt = mem_id_map_.find(table_id);
-    if (memIt != mem_id_map_.end()) {
+    MemShard& shard = GetShard(table_id);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    auto memIt = shard.mem_id_map_.find(table_id);
+    if (memIt != shard.mem_id_map_.end()) {
         return memIt->second;
     }
 
-    mem_id_map_[table_id] = std::make_shared<MemTable>(table_id, meta_, options_);
-    return mem_id_map_[table_id];
+    auto mem = std::make_shared<MemTable>(table_id, meta_, options_);
+    shard.mem_id_map_[table_id] = mem;
+    return mem;
 }
 
 Status
 MemManagerImpl::InsertVectors(const std::string& table_id, VectorsData& vectors) {
-    while (GetCurrentMem() > options_.insert_buffer_size_) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    // backpressure: writers wait for flushes to release buffer memory instead of polling every shard
+    if (GetCurrentMem() > options_.insert_buffer_size_) {
+        std::unique_lock<std::mutex> lock(buffer_mutex_);
+        buffer_cv_.wait(lock, [this] { return GetCurrentMem() <= options_.insert_buffer_size_; });
     }
 
-    std::unique_lock<std::mutex> lock(mutex_);
-
     return InsertVectorsNoLock(table_id, vectors);
 }
 
 Status
 MemManagerImpl::InsertVectorsNoLock(const std::string& table_id, VectorsData& vectors) {
-    MemTablePtr mem = GetMemByTable(table_id);
     VectorSourcePtr source = std::make_shared<VectorSource>(vectors);
 
-    auto status = mem->Add(source);
+    Status status;
+    MemTablePtr mem;
+    while (true) {
+        // the MemTable is locked by itself, only the shard lookup is guarded by shard lock
+        mem = GetMemByTable(table_id);
+        status = mem->Add(source);
+
+        // the table was moved to immutable list by serialization in the meantime, retry with a new one
+        if (status.ok() || !mem->IsImmutable()) {
+            break;
+        }
+    }
+
     if (status.ok()) {
         if (vectors.id_array_.empty()) {
-            vectors.id_array_ = source->GetVectorIds();
+            vectors.id_array_.swap(source->GetVectorIds());
         }
+        server::Metrics::GetInstance().InsertBufferBytesGaugeSet(table_id, mem->GetCurrentMem());
     }
     return status;
 }
 
 Status
 MemManagerImpl::ToImmutable() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    MemIdMap temp_map;
-    for (auto& kv : mem_id_map_) {
-        if (kv.second->Empty()) {
-            // empty table, no need to serialize
-            temp_map.insert(kv);
-        } else {
-            immu_mem_list_.push_back(kv.second);
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        MemIdMap temp_map;
+        MemList temp_list;
+        for (auto& kv : shard.mem_id_map_) {
+            if (kv.second->ToImmutable()) {
+                temp_list.push_back(kv.second);
+            } else {
+                // empty table, no need to serialize
+                temp_map.insert(kv);
+            }
+        }
+
+        // a table is moved to immutable list before leaving the shard, so that searches always find it
+        {
+            std::lock_guard<std::mutex> immu_lock(immu_mutex_);
+            immu_mem_list_.insert(immu_mem_list_.end(), temp_list.begin(), temp_list.end());
+        }
+        shard.mem_id_map_.swap(temp_map);
+    }
+
+    return Status::OK();
+}
+
+Status
+MemManagerImpl::ToImmutable(const std::set<std::string>& table_ids) {
+    for (auto& table_id : table_ids) {
+        MemShard& shard = GetShard(table_id);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        auto mem_iter = shard.mem_id_map_.find(table_id);
+        if (mem_iter != shard.mem_id_map_.end() && mem_iter->second->ToImmutable()) {
+            {
+                std::lock_guard<std::mutex> immu_lock(immu_mutex_);
+                immu_mem_list_.push_back(mem_iter->second);
+            }
+            shard.mem_id_map_.erase(mem_iter);
         }
     }
 
-    mem_id_map_.swap(temp_map);
     return Status::OK();
 }
 
 Status
 MemManagerImpl::Serialize(std::set<std::string>& table_ids) {
+    std::unique_lock<std::mutex> lock(serialization_mtx_);
     ToImmutable();
+    return SerializeImmutable(table_ids);
+}
+
+Status
+MemManagerImpl::SerializeTables(const std::set<std::string>& target_table_ids, std::set<std::string>& table_ids) {
     std::unique_lock<std::mutex> lock(serialization_mtx_);
+    ToImmutable(target_table_ids);
+    return SerializeImmutable(table_ids);
+}
+
+Status
+MemManagerImpl::SerializeImmutable(std::set<std::string>& table_ids) {
+    // immu_mem_list_ is only locked for a short while, so that inserts checking buffer size are not blocked
+    MemList serialize_list;
+    {
+        std::lock_guard<std::mutex> immu_lock(immu_mutex_);
+        serialize_list = immu_mem_list_;
+    }
+
+    // tables are flushed in parallel, each one writes its files and updates meta independently
     table_ids.clear();
-    for (auto& mem : immu_mem_list_) {
-        mem->Serialize();
+    std::vector<std::future<Status>> flush_results;
+    for (auto& mem : serialize_list) {
+        flush_results.emplace_back(flush_thread_pool_.enqueue([mem]() {
+            auto start = std::chrono::steady_clock::now();
+            auto status = mem->Serialize();
+            auto span = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+            server::Metrics::GetInstance().FlushDurationHistogramObserve(mem->GetTableId(), span.count());
+            return status;
+        }));
         table_ids.insert(mem->GetTableId());
     }
-    immu_mem_list_.clear();
+
+    // a table failed to serialize stays immutable with the files not written yet, they are written by the next
+    // serialization, its wal records are not checkpointed meanwhile
+    Status status;
+    std::unordered_set<MemTablePtr> serialized;
+    std::set<std::string> failed_table_ids;
+    for (size_t i = 0; i < flush_results.size(); ++i) {
+        auto mem_status = flush_results[i].get();
+        if (mem_status.ok()) {
+            serialized.insert(serialize_list[i]);
+        } else {
+            status = mem_status;
+            failed_table_ids.insert(serialize_list[i]->GetTableId());
+        }
+    }
+    for (auto& table_id : failed_table_ids) {
+        table_ids.erase(table_id);
+    }
+
+    {
+        std::lock_guard<std::mutex> immu_lock(immu_mutex_);
+        MemList temp_list;
+        for (auto& mem : immu_mem_list_) {
+            if (serialized.find(mem) == serialized.end()) {
+                temp_list.push_back(mem);
+            }
+        }
+        immu_mem_list_.swap(temp_list);
+    }
+    NotifyBufferReleased();
+
+    // what is left buffered for a flushed table was inserted after it turned immutable
+    for (auto& table_id : table_ids) {
+        MemShard& shard = GetShard(table_id);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        auto mem_iter = shard.mem_id_map_.find(table_id);
+        size_t buffered = (mem_iter != shard.mem_id_map_.end()) ? mem_iter->second->GetCurrentMem() : 0;
+        server::Metrics::GetInstance().InsertBufferBytesGaugeSet(table_id, buffered);
+    }
+    return status;
+}
+
+Status
+MemManagerImpl::GetTablesToFlush(std::set<std::string>& table_ids) {
+    table_ids.clear();
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        for (auto& kv : shard.mem_id_map_) {
+            const FlushPolicy& policy = GetFlushPolicy(kv.first);
+            MemTablePtr& mem = kv.second;
+            if ((policy.max_buffer_size_ > 0 && mem->GetCurrentMem() >= policy.max_buffer_size_) ||
+                (policy.max_age_ms_ > 0 && mem->GetBufferedAge() >= policy.max_age_ms_)) {
+                table_ids.insert(kv.first);
+            }
+        }
+    }
     return Status::OK();
 }
 
+const FlushPolicy&
+MemManagerImpl::GetFlushPolicy(const std::string& table_id) const {
+    auto iter = options_.table_flush_policies_.find(table_id);
+    if (iter != options_.table_flush_policies_.end()) {
+        return iter->second;
+    }
+    return options_.flush_policy_;
+}
+
 Status
 MemManagerImpl::EraseMemVector(const std::string& table_id) {
     {  // erase MemVector from rapid-insert cache
-        std::unique_lock<std::mutex> lock(mutex_);
-        mem_id_map_.erase(table_id);
+        MemShard& shard = GetShard(table_id);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        shard.mem_id_map_.erase(table_id);
     }
 
     {  // erase MemVector from serialize cache
         std::unique_lock<std::mutex> lock(serialization_mtx_);
+        std::lock_guard<std::mutex> immu_lock(immu_mutex_);
         MemList temp_list;
         for (auto& mem : immu_mem_list_) {
             if (mem->GetTableId() != table_id) {
@@ -103,16 +245,50 @@ MemManagerImpl::EraseMemVector(const std::string& table_id) {
         immu_mem_list_.swap(temp_list);
     }
 
+    NotifyBufferReleased();
+    server::Metrics::GetInstance().InsertBufferBytesGaugeSet(table_id, 0);
+    return Status::OK();
+}
+
+void
+MemManagerImpl::NotifyBufferReleased() {
+    // take the lock so that a writer between its check and wait doesn't miss the wakeup
+    { std::lock_guard<std::mutex> lock(buffer_mutex_); }
+    buffer_cv_.notify_all();
+}
+
+Status
+MemManagerImpl::GetMemTableFiles(const std::set<std::string>& table_ids,
+                                 std::vector<MemTableFilePtr>& mem_table_files) {
+    mem_table_files.clear();
+    for (auto& table_id : table_ids) {
+        MemShard& shard = GetShard(table_id);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        auto mem_iter = shard.mem_id_map_.find(table_id);
+        if (mem_iter != shard.mem_id_map_.end()) {
+            mem_iter->second->GetMemTableFiles(mem_table_files);
+        }
+    }
+
+    // serialized files are removed from the mem table only after meta is updated
+    std::lock_guard<std::mutex> lock(immu_mutex_);
+    for (auto& mem : immu_mem_list_) {
+        if (table_ids.find(mem->GetTableId()) != table_ids.end()) {
+            mem->GetMemTableFiles(mem_table_files);
+        }
+    }
+
     return Status::OK();
 }
 
 size_t
 MemManagerImpl::GetCurrentMutableMem() {
     size_t total_mem = 0;
-    std::unique_lock<std::mutex> lock(mutex_);
-    for (auto& kv : mem_id_map_) {
-        auto memTable = kv.second;
-        total_mem += memTable->GetCurrentMem();
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        for (auto& kv : shard.mem_id_map_) {
+            total_mem += kv.second->GetCurrentMem();
+        }
     }
     return total_mem;
 }
@@ -120,7 +296,7 @@ MemManagerImpl::GetCurrentMutableMem() {
 size_t
 MemManagerImpl::GetCurrentImmutableMem() {
     size_t total_mem = 0;
-    std::unique_lock<std::mutex> lock(serialization_mtx_);
+    std::lock_guard<std::mutex> lock(immu_mutex_);
     for (auto& mem_table : immu_mem_list_) {
         total_mem += mem_table->GetCurrentMem();
     }
@@ -16,7 +16,11 @@
 #include "db/meta/Meta.h"
 #include "server/Config.h"
 #include "utils/Status.h"
+#include "utils/ThreadPool.h"
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
 #include <ctime>
 #include <map>
 #include <memory>
@@ -32,7 +36,8 @@ class MemManagerImpl : public MemManager {
  public:
     using Ptr = std::shared_ptr<MemManagerImpl>;
 
-    MemManagerImpl(const meta::MetaPtr& meta, const DBOptions& options) : meta_(meta), options_(options) {
+    MemManagerImpl(const meta::MetaPtr& meta, const DBOptions& options)
+        : meta_(meta), options_(options), flush_thread_pool_(std::max<size_t>(options.flush_thread_num_, 1)) {
         server::Config& config = server::Config::GetInstance();
         config.GenUniqueIdentityID("MemManagerImpl", identity_);
 
@@ -42,6 +47,7 @@ class MemManagerImpl : public MemManager {
             auto status = config.GetCacheConfigInsertBufferSize(buffer_size);
             if (status.ok()) {
                 options_.insert_buffer_size_ = buffer_size * ONE_GB;
+                NotifyBufferReleased();
             }
 
             return status;
@@ -61,9 +67,18 @@ class MemManagerImpl : public MemManager {
     Status
     Serialize(std::set<std::string>& table_ids) override;
 
+    Status
+    SerializeTables(const std::set<std::string>& target_table_ids, std::set<std::string>& table_ids) override;
+
+    Status
+    GetTablesToFlush(std::set<std::string>& table_ids) override;
+
     Status
     EraseMemVector(const std::string& table_id) override;
 
+    Status
+    GetMemTableFiles(const std::set<std::string>& table_ids, std::vector<MemTableFilePtr>& mem_table_files) override;
+
     size_t
     GetCurrentMutableMem() override;
 
@@ -74,6 +89,19 @@ class MemManagerImpl : public MemManager {
     GetCurrentMem() override;
 
  private:
+    using MemIdMap = std::map<std::string, MemTablePtr>;
+    using MemList = std::vector<MemTablePtr>;
+
+    // mutable tables are sharded by table id, so that inserts into different tables don't contend on one lock
+    static constexpr size_t MEM_SHARD_NUM = 32;
+    struct MemShard {
+        std::mutex mutex_;
+        MemIdMap mem_id_map_;
+    };
+
+    MemShard&
+    GetShard(const std::string& table_id);
+
     MemTablePtr
     GetMemByTable(const std::string& table_id);
 
@@ -82,15 +110,28 @@ class MemManagerImpl : public MemManager {
     Status
     ToImmutable();
 
-    using MemIdMap = std::map<std::string, MemTablePtr>;
-    using MemList = std::vector<MemTablePtr>;
+    Status
+    ToImmutable(const std::set<std::string>& table_ids);
+
+    Status
+    SerializeImmutable(std::set<std::string>& table_ids);
+
+    const FlushPolicy&
+    GetFlushPolicy(const std::string& table_id) const;
+
+    void
+    NotifyBufferReleased();
+
     std::string identity_;
-    MemIdMap mem_id_map_;
+    std::array<MemShard, MEM_SHARD_NUM> shards_;
     MemList immu_mem_list_;
     meta::MetaPtr meta_;
     DBOptions options_;
-    std::mutex mutex_;
-    std::mutex serialization_mtx_;
+    ThreadPool flush_thread_pool_;
+    std::mutex immu_mutex_;         // protect immu_mem_list_
+    std::mutex serialization_mtx_;  // only one serialization at a time
+    std::mutex buffer_mutex_;       // protect waiting on buffer_cv_
+    std::condition_variable buffer_cv_;
 };  // NewMemManager
 
 }  // namespace engine
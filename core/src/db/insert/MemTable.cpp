@@ -19,11 +19,20 @@ namespace milvus {
 namespace engine {
 
 MemTable::MemTable(const std::string& table_id, const meta::MetaPtr& meta, const DBOptions& options)
-    : table_id_(table_id), meta_(meta), options_(options) {
+    : table_id_(table_id), meta_(meta), options_(options), current_mem_(0) {
 }
 
 Status
 MemTable::Add(VectorSourcePtr& source) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (immutable_) {
+        return Status(DB_ERROR, "Mem table " + table_id_ + " is immutable");
+    }
+
+    if (mem_table_file_list_.empty()) {
+        first_add_time_ = std::chrono::steady_clock::now();
+    }
+
     while (!source->AllAdded()) {
         MemTableFilePtr current_mem_table_file;
         if (!mem_table_file_list_.empty()) {
@@ -36,9 +45,12 @@ MemTable::Add(VectorSourcePtr& source) {
             status = new_mem_table_file->Add(source);
             if (status.ok()) {
                 mem_table_file_list_.emplace_back(new_mem_table_file);
+                current_mem_ += new_mem_table_file->GetCurrentMem();
             }
         } else {
+            size_t mem_before = current_mem_table_file->GetCurrentMem();
             status = current_mem_table_file->Add(source);
+            current_mem_ += current_mem_table_file->GetCurrentMem() - mem_before;
         }
 
         if (!status.ok()) {
@@ -52,11 +64,19 @@ MemTable::Add(VectorSourcePtr& source) {
 
 void
 MemTable::GetCurrentMemTableFile(MemTableFilePtr& mem_table_file) {
+    std::lock_guard<std::mutex> lock(mutex_);
     mem_table_file = mem_table_file_list_.back();
 }
 
+void
+MemTable::GetMemTableFiles(MemTableFileList& mem_table_files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mem_table_files.insert(mem_table_files.end(), mem_table_file_list_.begin(), mem_table_file_list_.end());
+}
+
 size_t
 MemTable::GetTableFileCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
     return mem_table_file_list_.size();
 }
 
@@ -70,6 +90,7 @@ MemTable::Serialize() {
             return Status(DB_ERROR, err_msg);
         }
         std::lock_guard<std::mutex> lock(mutex_);
+        current_mem_ -= (*mem_table_file)->GetCurrentMem();
         mem_table_file = mem_table_file_list_.erase(mem_table_file);
     }
     return Status::OK();
@@ -77,9 +98,28 @@ MemTable::Serialize() {
 
 bool
 MemTable::Empty() {
+    std::lock_guard<std::mutex> lock(mutex_);
     return mem_table_file_list_.empty();
 }
 
+bool
+MemTable::ToImmutable() {
+    // wait for the in-flight Add() to finish
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mem_table_file_list_.empty()) {
+        return false;
+    }
+
+    immutable_ = true;
+    return true;
+}
+
+bool
+MemTable::IsImmutable() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return immutable_;
+}
+
 const std::string&
 MemTable::GetTableId() const {
     return table_id_;
@@ -87,12 +127,19 @@ MemTable::GetTableId() const {
 
 size_t
 MemTable::GetCurrentMem() {
+    // no lock here, it is called on every insert to check buffer size
+    return current_mem_.load();
+}
+
+int64_t
+MemTable::GetBufferedAge() {
     std::lock_guard<std::mutex> lock(mutex_);
-    size_t total_mem = 0;
-    for (auto& mem_table_file : mem_table_file_list_) {
-        total_mem += mem_table_file->GetCurrentMem();
+    if (mem_table_file_list_.empty()) {
+        return 0;
     }
-    return total_mem;
+
+    auto age = std::chrono::steady_clock::now() - first_add_time_;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(age).count();
 }
 
 }  // namespace engine
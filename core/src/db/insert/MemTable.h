@@ -15,6 +15,8 @@
 #include "VectorSource.h"
 #include "utils/Status.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -35,6 +37,10 @@ class MemTable {
     void
     GetCurrentMemTableFile(MemTableFilePtr& mem_table_file);
 
+    // snapshot of files holding buffered vectors
+    void
+    GetMemTableFiles(MemTableFileList& mem_table_files);
+
     size_t
     GetTableFileCount();
 
@@ -44,12 +50,23 @@ class MemTable {
     bool
     Empty();
 
+    // stop accepting new vectors, return false if the table is empty and no need to serialize
+    bool
+    ToImmutable();
+
+    bool
+    IsImmutable();
+
     const std::string&
     GetTableId() const;
 
     size_t
     GetCurrentMem();
 
+    // milliseconds since the oldest buffered vector was added, 0 if the table is empty
+    int64_t
+    GetBufferedAge();
+
  private:
     const std::string table_id_;
 
@@ -60,6 +77,9 @@ class MemTable {
     DBOptions options_;
 
     std::mutex mutex_;
+    std::atomic<size_t> current_mem_;
+    std::chrono::steady_clock::time_point first_add_time_;
+    bool immutable_ = false;
 };  // MemTable
 
 using MemTablePtr = std::shared_ptr<MemTable>;
@@ -11,11 +11,18 @@
 
 #include "db/insert/MemTableFile.h"
 #include "db/Constants.h"
+#include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/insert/MemBufferPool.h"
 #include "metrics/Metrics.h"
 #include "utils/Log.h"
+#include "utils/ValidationUtil.h"
 
+#include <fiu-local.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
 
 namespace milvus {
@@ -29,9 +36,62 @@ MemTableFile::MemTableFile(const std::string& table_id, const meta::MetaPtr& met
         execution_engine_ = EngineFactory::Build(
             table_file_schema_.dimension_, table_file_schema_.location_, (EngineType)table_file_schema_.engine_type_,
             (MetricType)table_file_schema_.metric_type_, table_file_schema_.nlist_);
+        ReserveBuffer();
     }
 }
 
+MemTableFile::~MemTableFile() {
+    if (recyclable_) {
+        RecycleBuffer();
+    }
+}
+
+void
+MemTableFile::ReserveBuffer() {
+    // the file is filled up to MAX_TABLE_FILE_MEM, reserve the whole capacity up front
+    // so that the raw index doesn't reallocate and copy its buffer while vectors are appended
+    uint64_t single_vector_mem_size = IsBinary() ? table_file_schema_.dimension_ / 8
+                                                 : table_file_schema_.dimension_ * FLOAT_TYPE_SIZE;
+    if (single_vector_mem_size == 0) {
+        return;
+    }
+    uint64_t capacity = MAX_TABLE_FILE_MEM / single_vector_mem_size;
+
+    Status status;
+    std::vector<float> vectors;
+    IDNumbers ids;
+    if (!IsBinary() && MemBufferPool::GetInstance().Acquire(capacity, table_file_schema_.dimension_, vectors, ids)) {
+        status = execution_engine_->SwapRawData(vectors, ids);
+    } else {
+        status = execution_engine_->Reserve(capacity);
+    }
+
+    if (!status.ok()) {
+        // not fatal, the index grows on demand
+        ENGINE_LOG_WARNING << "Failed to reserve memory for table file " << table_file_schema_.file_id_ << ": "
+                           << status.message();
+    }
+}
+
+void
+MemTableFile::RecycleBuffer() {
+    if (IsBinary()) {
+        return;
+    }
+
+    std::vector<float> vectors;
+    IDNumbers ids;
+    auto status = execution_engine_->SwapRawData(vectors, ids);
+    if (status.ok()) {
+        MemBufferPool::GetInstance().Release(vectors, ids);
+    }
+}
+
+bool
+MemTableFile::IsBinary() const {
+    return server::ValidationUtil::IsBinaryMetricType(table_file_schema_.metric_type_);
+}
+
 Status
 MemTableFile::CreateTableFile() {
     meta::TableFileSchema table_file_schema;
@@ -61,9 +121,16 @@ MemTableFile::Add(VectorSourcePtr& source) {
     if (mem_left >= single_vector_mem_size) {
         size_t num_vectors_to_add = std::ceil(mem_left / single_vector_mem_size);
         size_t num_vectors_added;
-        auto status = source->Add(execution_engine_, table_file_schema_, num_vectors_to_add, num_vectors_added);
+        std::unique_lock<std::shared_mutex> lock(engine_mutex_);
+        auto status =
+            source->Add(execution_engine_, table_file_schema_, num_vectors_to_add, num_vectors_added, &attrs_);
         if (status.ok()) {
             current_mem_ += (num_vectors_added * single_vector_mem_size);
+            if (source->GetInsertTime() > 0) {
+                time_range_.Extend(source->GetInsertTime());
+            } else {
+                time_unknown_ = true;
+            }
         }
         return status;
     }
@@ -91,7 +158,12 @@ MemTableFile::Serialize() {
     size_t size = GetCurrentMem();
     server::CollectSerializeMetrics metrics(size);
 
-    execution_engine_->Serialize();
+    auto status = execution_engine_->Serialize();
+    fiu_do_on("MemTableFile.Serialize.serialize_fail", status = Status(DB_ERROR, ""));
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to serialize file " << table_file_schema_.file_id_ << ": " << status.message();
+        return status;
+    }
     table_file_schema_.file_size_ = execution_engine_->PhysicalSize();
     table_file_schema_.row_count_ = execution_engine_->Count();
 
@@ -105,17 +177,134 @@ MemTableFile::Serialize() {
         table_file_schema_.file_type_ = meta::TableFileSchema::RAW;
     }
 
-    auto status = meta_->UpdateTableFile(table_file_schema_);
+    // a small file waits for merges before its index is built, until then it is searched through an index built
+    // now with the model trained for the table, which is in place before the file is visible to searches
+    if (table_file_schema_.file_type_ == meta::TableFileSchema::RAW) {
+        BuildIngestIndex();
+    }
+
+    // attributes are on disk before the file is visible to filtered searches
+    if (attrs_.Count() > 0) {
+        status = attrs_.Write(table_file_schema_.location_);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to write attributes of file " << table_file_schema_.file_id_ << ": "
+                             << status.message();
+            return status;
+        }
+    }
+
+    // without its insert time the file is searched by any time range, not worth failing the serialization
+    if (!time_unknown_ && !time_range_.Empty()) {
+        auto time_status = time_range_.Write(table_file_schema_.location_);
+        if (!time_status.ok()) {
+            ENGINE_LOG_WARNING << "Failed to write insert time of file " << table_file_schema_.file_id_ << ": "
+                               << time_status.message();
+        }
+    }
+
+    status = meta_->UpdateTableFile(table_file_schema_);
 
     ENGINE_LOG_DEBUG << "New " << ((table_file_schema_.file_type_ == meta::TableFileSchema::RAW) ? "raw" : "to_index")
                      << " file " << table_file_schema_.file_id_ << " of size " << size << " bytes";
 
     if (options_.insert_cache_immediately_) {
         execution_engine_->Cache();
+    } else if (status.ok()) {
+        // a search may have taken the file before it turned up in meta, the buffer goes along with the last holder
+        recyclable_ = true;
     }
 
     return status;
 }
 
+void
+MemTableFile::BuildIngestIndex() {
+    auto engine_type = (EngineType)table_file_schema_.engine_type_;
+    if (engine_type == EngineType::FAISS_IDMAP || engine_type == EngineType::FAISS_BIN_IDMAP) {
+        return;
+    }
+
+    auto location = utils::GetIngestIndexPath(table_file_schema_.location_);
+    try {
+        auto index = execution_engine_->BuildIndexByTableModel(location, engine_type);
+        if (index == nullptr) {
+            return;  // no model trained for the table yet
+        }
+
+        auto status = index->Serialize();
+        if (!status.ok()) {
+            ENGINE_LOG_WARNING << "Failed to serialize ingest index of file " << table_file_schema_.file_id_ << ": "
+                               << status.message();
+            boost::filesystem::remove(location);
+            return;
+        }
+        ENGINE_LOG_DEBUG << "Build ingest index of file " << table_file_schema_.file_id_;
+    } catch (std::exception& ex) {
+        // the raw file is still searched without the index
+        ENGINE_LOG_WARNING << "Failed to build ingest index of file " << table_file_schema_.file_id_ << ": "
+                           << ex.what();
+        boost::filesystem::remove(location);
+    }
+}
+
+Status
+MemTableFile::Search(const VectorsData& vectors, int64_t k, ResultIds& result_ids, ResultDistances& result_distances,
+                     size_t& result_k) {
+    result_k = 0;
+    if (execution_engine_ == nullptr) {
+        return Status::OK();
+    }
+
+    std::shared_lock<std::shared_mutex> lock(engine_mutex_);
+    int64_t count = execution_engine_->Count();
+    if (count <= 0) {
+        return Status::OK();
+    }
+
+    uint64_t nq = vectors.vector_count_;
+    result_ids.resize(nq * k);
+    result_distances.resize(nq * k);
+
+    IDFilterPtr filter = nullptr;
+    if (!vectors.predicates_.empty()) {
+        std::vector<int64_t> ids;
+        attrs_.MatchIds(vectors.predicates_, nullptr, ids);
+        filter = std::make_shared<knowhere::IDFilter>(ids, false);
+    }
+
+    // raw data is always kept by IDMAP before index is built, nprobe is meaningless
+    Status status;
+    if (!vectors.float_data_.empty()) {
+        status = execution_engine_->Search(nq, vectors.float_data_.data(), k, 0, result_distances.data(),
+                                           result_ids.data(), false, filter);
+    } else if (!vectors.binary_data_.empty()) {
+        status = execution_engine_->Search(nq, vectors.binary_data_.data(), k, 0, result_distances.data(),
+                                           result_ids.data(), false);
+    }
+
+    if (status.ok()) {
+        result_k = std::min(count, k);
+    }
+    return status;
+}
+
+const meta::TableFileSchema&
+MemTableFile::GetTableFileSchema() const {
+    return table_file_schema_;
+}
+
+SegmentTimeRange
+MemTableFile::GetTimeRange() {
+    std::shared_lock<std::shared_mutex> lock(engine_mutex_);
+    if (time_unknown_) {
+        // searched by any time range, like a file without insert time on disk
+        SegmentTimeRange all_time;
+        all_time.Extend(std::numeric_limits<int64_t>::min());
+        all_time.Extend(std::numeric_limits<int64_t>::max());
+        return all_time;
+    }
+    return time_range_;
+}
+
 }  // namespace engine
 }  // namespace milvus
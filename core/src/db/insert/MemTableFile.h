@@ -13,10 +13,13 @@
 
 #include "VectorSource.h"
 #include "db/engine/ExecutionEngine.h"
+#include "db/engine/SegmentAttrs.h"
+#include "db/engine/SegmentTimeRange.h"
 #include "db/meta/Meta.h"
 #include "utils/Status.h"
 
 #include <memory>
+#include <shared_mutex>
 #include <string>
 
 namespace milvus {
@@ -26,6 +29,9 @@ class MemTableFile {
  public:
     MemTableFile(const std::string& table_id, const meta::MetaPtr& meta, const DBOptions& options);
 
+    // the buffer of a serialized file is recycled only here, a search holding the file still finds its vectors
+    ~MemTableFile();
+
     Status
     Add(VectorSourcePtr& source);
 
@@ -41,18 +47,49 @@ class MemTableFile {
     Status
     Serialize();
 
+    // brute-force search buffered vectors, result_k returns the number of valid results for each query;
+    // vectors out of the attribute predicates of the search are skipped
+    Status
+    Search(const VectorsData& vectors, int64_t k, ResultIds& result_ids, ResultDistances& result_distances,
+           size_t& result_k);
+
+    const meta::TableFileSchema&
+    GetTableFileSchema() const;
+
+    // insert time of the buffered vectors
+    SegmentTimeRange
+    GetTimeRange();
+
  private:
     Status
     CreateTableFile();
 
+    void
+    ReserveBuffer();
+
+    void
+    RecycleBuffer();
+
+    // index the serialized raw file with the model trained for the table, if one is cached
+    void
+    BuildIngestIndex();
+
+    bool
+    IsBinary() const;
+
  private:
     const std::string table_id_;
     meta::TableFileSchema table_file_schema_;
     meta::MetaPtr meta_;
     DBOptions options_;
     size_t current_mem_;
+    bool recyclable_ = false;  // data is on disk, the buffer can be reused by next table file
 
     ExecutionEnginePtr execution_engine_;
+    SegmentAttrs attrs_;              // attributes of the buffered vectors, guarded by engine_mutex_ too
+    SegmentTimeRange time_range_;     // guarded by engine_mutex_ too
+    bool time_unknown_ = false;       // some vectors were replayed from a record without insert time
+    std::shared_mutex engine_mutex_;  // searches share the engine, appending vectors is exclusive
 };  // MemTableFile
 
 using MemTableFilePtr = std::shared_ptr<MemTableFile>;
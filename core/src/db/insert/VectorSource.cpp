@@ -25,38 +25,43 @@ VectorSource::VectorSource(VectorsData& vectors)
 
 Status
 VectorSource::Add(const ExecutionEnginePtr& execution_engine, const meta::TableFileSchema& table_file_schema,
-                  const size_t& num_vectors_to_add, size_t& num_vectors_added) {
+                  const size_t& num_vectors_to_add, size_t& num_vectors_added, SegmentAttrs* attrs) {
     uint64_t n = vectors_.vector_count_;
     server::CollectAddMetrics metrics(n, table_file_schema.dimension_);
 
     num_vectors_added =
         current_num_vectors_added + num_vectors_to_add <= n ? num_vectors_to_add : n - current_num_vectors_added;
+    // user provided ids are passed to engine in place, only generated ids need a buffer
     IDNumbers vector_ids_to_add;
-    if (vectors_.id_array_.empty()) {
+    const IDNumber* ids = nullptr;
+    bool generate_ids = vectors_.id_array_.empty();
+    if (generate_ids) {
         id_generator_->GetNextIDNumbers(num_vectors_added, vector_ids_to_add);
+        ids = vector_ids_to_add.data();
     } else {
-        vector_ids_to_add.resize(num_vectors_added);
-        for (int pos = current_num_vectors_added; pos < current_num_vectors_added + num_vectors_added; pos++) {
-            vector_ids_to_add[pos - current_num_vectors_added] = vectors_.id_array_[pos];
-        }
+        ids = vectors_.id_array_.data() + current_num_vectors_added;
     }
 
     Status status;
     if (!vectors_.float_data_.empty()) {
         status = execution_engine->AddWithIds(
             num_vectors_added, vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_,
-            vector_ids_to_add.data());
+            ids);
     } else if (!vectors_.binary_data_.empty()) {
         status = execution_engine->AddWithIds(
             num_vectors_added,
             vectors_.binary_data_.data() + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_),
-            vector_ids_to_add.data());
+            ids);
     }
 
     if (status.ok()) {
+        if (attrs != nullptr && !vectors_.attrs_.empty()) {
+            attrs->Append(ids, num_vectors_added, vectors_.attrs_, current_num_vectors_added);
+        }
         current_num_vectors_added += num_vectors_added;
-        vector_ids_.insert(vector_ids_.end(), std::make_move_iterator(vector_ids_to_add.begin()),
-                           std::make_move_iterator(vector_ids_to_add.end()));
+        if (generate_ids) {
+            vector_ids_.insert(vector_ids_.end(), vector_ids_to_add.begin(), vector_ids_to_add.end());
+        }
     } else {
         ENGINE_LOG_ERROR << "VectorSource::Add failed: " + status.ToString();
     }
@@ -85,10 +90,15 @@ VectorSource::AllAdded() {
     return (current_num_vectors_added == vectors_.vector_count_);
 }
 
-IDNumbers
+IDNumbers&
 VectorSource::GetVectorIds() {
     return vector_ids_;
 }
 
+int64_t
+VectorSource::GetInsertTime() const {
+    return vectors_.insert_time_us_;
+}
+
 }  // namespace engine
 }  // namespace milvus
@@ -13,6 +13,7 @@
 
 #include "db/IDGenerator.h"
 #include "db/engine/ExecutionEngine.h"
+#include "db/engine/SegmentAttrs.h"
 #include "db/meta/Meta.h"
 #include "utils/Status.h"
 
@@ -25,9 +26,10 @@ class VectorSource {
  public:
     explicit VectorSource(VectorsData& vectors);
 
+    // attributes of the added vectors are appended to attrs, if given
     Status
     Add(const ExecutionEnginePtr& execution_engine, const meta::TableFileSchema& table_file_schema,
-        const size_t& num_vectors_to_add, size_t& num_vectors_added);
+        const size_t& num_vectors_to_add, size_t& num_vectors_added, SegmentAttrs* attrs = nullptr);
 
     size_t
     GetNumVectorsAdded();
@@ -38,9 +40,14 @@ class VectorSource {
     bool
     AllAdded();
 
-    IDNumbers
+    // ids generated for the vectors, empty if user provided ids
+    IDNumbers&
     GetVectorIds();
 
+    // insert time of the vectors in microseconds, 0 if unknown
+    int64_t
+    GetInsertTime() const;
+
  private:
     VectorsData& vectors_;
     IDNumbers vector_ids_;
@@ -0,0 +1,1515 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/meta/KVMetaImpl.h"
+#include "MetaConsts.h"
+#include "db/IDGenerator.h"
+#include "db/Utils.h"
+#include "metrics/Metrics.h"
+#include "utils/CommonUtil.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
+
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <fiu-local.h>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+namespace {
+
+const char TABLES_PREFIX[] = "tables/";
+const char FILES_PREFIX[] = "files/";
+const char TABLE_SEQUENCE[] = "sequences/table";
+const char FILE_SEQUENCE[] = "sequences/file";
+const uint8_t RECORD_VERSION = 1;
+
+Status
+HandleException(const std::string& desc, const char* what = nullptr) {
+    if (what == nullptr) {
+        ENGINE_LOG_ERROR << desc;
+        return Status(DB_META_TRANSACTION_FAILED, desc);
+    } else {
+        std::string msg = desc + ":" + what;
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_META_TRANSACTION_FAILED, msg);
+    }
+}
+
+std::string
+TableKey(const std::string& table_id) {
+    return TABLES_PREFIX + table_id;
+}
+
+std::string
+FilesPrefix(const std::string& table_id) {
+    return FILES_PREFIX + table_id + "/";
+}
+
+// ids are zero padded, files of a table are scanned in the order they were created
+std::string
+FileKey(const std::string& table_id, size_t id) {
+    std::stringstream ss;
+    ss << FilesPrefix(table_id) << std::setw(20) << std::setfill('0') << id;
+    return ss.str();
+}
+
+class Encoder {
+ public:
+    Encoder() {
+        buf_.push_back(RECORD_VERSION);
+    }
+
+    Encoder&
+    Int(int64_t value) {
+        buf_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        return *this;
+    }
+
+    Encoder&
+    Str(const std::string& value) {
+        Int(value.size());
+        buf_.append(value);
+        return *this;
+    }
+
+    const std::string&
+    Data() const {
+        return buf_;
+    }
+
+ private:
+    std::string buf_;
+};
+
+class Decoder {
+ public:
+    explicit Decoder(const std::string& buf) : buf_(buf) {
+        if (buf_.empty() || static_cast<uint8_t>(buf_[0]) != RECORD_VERSION) {
+            throw std::runtime_error("unknown meta record version");
+        }
+        offset_ = 1;
+    }
+
+    int64_t
+    Int() {
+        int64_t value = 0;
+        if (offset_ + sizeof(value) > buf_.size()) {
+            throw std::runtime_error("truncated meta record");
+        }
+        memcpy(&value, buf_.data() + offset_, sizeof(value));
+        offset_ += sizeof(value);
+        return value;
+    }
+
+    std::string
+    Str() {
+        auto size = static_cast<size_t>(Int());
+        if (offset_ + size > buf_.size()) {
+            throw std::runtime_error("truncated meta record");
+        }
+        std::string value = buf_.substr(offset_, size);
+        offset_ += size;
+        return value;
+    }
+
+ private:
+    const std::string& buf_;
+    size_t offset_ = 0;
+};
+
+std::string
+EncodeTable(const TableSchema& table) {
+    Encoder encoder;
+    encoder.Int(table.id_)
+        .Str(table.table_id_)
+        .Int(table.state_)
+        .Int(table.dimension_)
+        .Int(table.created_on_)
+        .Int(table.flag_)
+        .Int(table.index_file_size_)
+        .Int(table.engine_type_)
+        .Int(table.nlist_)
+        .Int(table.metric_type_)
+        .Str(table.owner_table_)
+        .Str(table.partition_tag_)
+        .Str(table.version_);
+    return encoder.Data();
+}
+
+void
+DecodeTable(const std::string& value, TableSchema& table) {
+    Decoder decoder(value);
+    table.id_ = decoder.Int();
+    table.table_id_ = decoder.Str();
+    table.state_ = decoder.Int();
+    table.dimension_ = decoder.Int();
+    table.created_on_ = decoder.Int();
+    table.flag_ = decoder.Int();
+    table.index_file_size_ = decoder.Int();
+    table.engine_type_ = decoder.Int();
+    table.nlist_ = decoder.Int();
+    table.metric_type_ = decoder.Int();
+    table.owner_table_ = decoder.Str();
+    table.partition_tag_ = decoder.Str();
+    table.version_ = decoder.Str();
+}
+
+// dimension, index file size, nlist and metric type are taken from the table, like other metas do
+std::string
+EncodeFile(const TableFileSchema& file) {
+    Encoder encoder;
+    encoder.Int(file.id_)
+        .Str(file.table_id_)
+        .Int(file.engine_type_)
+        .Str(file.file_id_)
+        .Int(file.file_type_)
+        .Int(file.file_size_)
+        .Int(file.row_count_)
+        .Int(file.updated_time_)
+        .Int(file.created_on_)
+        .Int(file.date_);
+    return encoder.Data();
+}
+
+void
+DecodeFile(const std::string& value, TableFileSchema& file) {
+    Decoder decoder(value);
+    file.id_ = decoder.Int();
+    file.table_id_ = decoder.Str();
+    file.engine_type_ = decoder.Int();
+    file.file_id_ = decoder.Str();
+    file.file_type_ = decoder.Int();
+    file.file_size_ = decoder.Int();
+    file.row_count_ = decoder.Int();
+    file.updated_time_ = decoder.Int();
+    file.created_on_ = decoder.Int();
+    file.date_ = decoder.Int();
+}
+
+void
+CopyTableFields(const TableSchema& table, TableFileSchema& file) {
+    file.dimension_ = table.dimension_;
+    file.index_file_size_ = table.index_file_size_;
+    file.nlist_ = table.nlist_;
+    file.metric_type_ = table.metric_type_;
+}
+
+bool
+IsSearchable(const TableFileSchema& file) {
+    return file.file_type_ == (int)TableFileSchema::RAW || file.file_type_ == (int)TableFileSchema::TO_INDEX ||
+           file.file_type_ == (int)TableFileSchema::INDEX || file.file_type_ == (int)TableFileSchema::ARCHIVE;
+}
+
+}  // namespace
+
+KVMetaImpl::KVMetaImpl(const DBMetaOptions& options) : options_(options) {
+    Initialize();
+}
+
+KVMetaImpl::~KVMetaImpl() {
+}
+
+Status
+KVMetaImpl::NextTableId(std::string& table_id) {
+    std::lock_guard<std::mutex> lock(genid_mutex_);  // avoid duplicated id
+    std::stringstream ss;
+    SimpleIDGenerator g;
+    ss << g.GetNextIDNumber();
+    table_id = ss.str();
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::NextFileId(std::string& file_id) {
+    std::lock_guard<std::mutex> lock(genid_mutex_);  // avoid duplicated id
+    std::stringstream ss;
+    SimpleIDGenerator g;
+    ss << g.GetNextIDNumber();
+    file_id = ss.str();
+    return Status::OK();
+}
+
+size_t
+KVMetaImpl::NextSequence(const std::string& key, KVStore::WriteBatch& batch) {
+    size_t next = 1;
+    std::string value;
+    if (store_->Get(key, value).ok()) {
+        next = std::stoull(value) + 1;
+    }
+    batch.Put(key, std::to_string(next));
+    return next;
+}
+
+Status
+KVMetaImpl::Initialize() {
+    if (!boost::filesystem::is_directory(options_.path_)) {
+        auto ret = boost::filesystem::create_directory(options_.path_);
+        fiu_do_on("KVMetaImpl.Initialize.fail_create_directory", ret = false);
+        if (!ret) {
+            std::string msg = "Failed to create db directory " + options_.path_;
+            ENGINE_LOG_ERROR << msg;
+            throw Exception(DB_INVALID_PATH, msg);
+        }
+    }
+
+    store_ = std::make_unique<KVStore>(options_.path_ + "/meta.kv");
+    auto status = store_->Open();
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << status.message();
+        throw Exception(DB_INCOMPATIB_META, status.message());
+    }
+
+    CleanUpShadowFiles();
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::LoadTable(const std::string& table_id, TableSchema& table_schema) {
+    std::string value;
+    auto status = store_->Get(TableKey(table_id), value);
+    if (!status.ok()) {
+        return Status(DB_NOT_FOUND, "Table " + table_id + " not found");
+    }
+    DecodeTable(value, table_schema);
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::LoadTables(std::vector<TableSchema>& table_schemas) {
+    KVStore::KVPairs pairs;
+    auto status = store_->Scan(TABLES_PREFIX, pairs);
+    if (!status.ok()) {
+        return status;
+    }
+    for (auto& pair : pairs) {
+        TableSchema table_schema;
+        DecodeTable(pair.second, table_schema);
+        table_schemas.emplace_back(table_schema);
+    }
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::LoadFiles(const std::string& table_id, TableFilesSchema& files) {
+    KVStore::KVPairs pairs;
+    auto status = store_->Scan(table_id.empty() ? std::string(FILES_PREFIX) : FilesPrefix(table_id), pairs);
+    if (!status.ok()) {
+        return status;
+    }
+    for (auto& pair : pairs) {
+        TableFileSchema file_schema;
+        DecodeFile(pair.second, file_schema);
+        files.emplace_back(file_schema);
+    }
+    return Status::OK();
+}
+
+void
+KVMetaImpl::PutTable(const TableSchema& table_schema, KVStore::WriteBatch& batch) {
+    batch.Put(TableKey(table_schema.table_id_), EncodeTable(table_schema));
+}
+
+void
+KVMetaImpl::PutFile(const TableFileSchema& file_schema, KVStore::WriteBatch& batch) {
+    batch.Put(FileKey(file_schema.table_id_, file_schema.id_), EncodeFile(file_schema));
+}
+
+Status
+KVMetaImpl::CreateTable(TableSchema& table_schema) {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        if (table_schema.table_id_ == "") {
+            NextTableId(table_schema.table_id_);
+        } else {
+            fiu_do_on("KVMetaImpl.CreateTable.throw_exception", throw std::exception());
+            TableSchema exist_schema;
+            if (LoadTable(table_schema.table_id_, exist_schema).ok()) {
+                if (TableSchema::TO_DELETE == exist_schema.state_) {
+                    return Status(DB_ERROR, "Table already exists and it is in delete state, please wait a second");
+                } else {
+                    return Status(DB_ALREADY_EXIST, "Table already exists");
+                }
+            }
+        }
+
+        KVStore::WriteBatch batch;
+        table_schema.id_ = NextSequence(TABLE_SEQUENCE, batch);
+        table_schema.created_on_ = utils::GetMicroSecTimeStamp();
+        PutTable(table_schema, batch);
+        auto status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("Encounter exception when create table", status.message().c_str());
+        }
+
+        ENGINE_LOG_DEBUG << "Successfully create table: " << table_schema.table_id_;
+
+        return utils::CreateTablePath(options_, table_schema.table_id_);
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when create table", e.what());
+    }
+}
+
+Status
+KVMetaImpl::DescribeTable(TableSchema& table_schema) {
+    try {
+        server::MetricCollector metric;
+        fiu_do_on("KVMetaImpl.DescribeTable.throw_exception", throw std::exception());
+
+        TableSchema exist_schema;
+        auto status = LoadTable(table_schema.table_id_, exist_schema);
+        if (!status.ok() || exist_schema.state_ == (int)TableSchema::TO_DELETE) {
+            return Status(DB_NOT_FOUND, "Table " + table_schema.table_id_ + " not found");
+        }
+        table_schema = exist_schema;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when describe table", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::HasTable(const std::string& table_id, bool& has_or_not) {
+    has_or_not = false;
+
+    try {
+        server::MetricCollector metric;
+        TableSchema table_schema;
+        if (LoadTable(table_id, table_schema).ok()) {
+            has_or_not = (table_schema.state_ != (int)TableSchema::TO_DELETE);
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when lookup table", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::AllTables(std::vector<TableSchema>& table_schema_array) {
+    try {
+        server::MetricCollector metric;
+        std::vector<TableSchema> tables;
+        auto status = LoadTables(tables);
+        if (!status.ok()) {
+            return status;
+        }
+        for (auto& table : tables) {
+            if (table.state_ != (int)TableSchema::TO_DELETE) {
+                table_schema_array.emplace_back(table);
+            }
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when lookup all tables", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::DropTable(const std::string& table_id) {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        // soft delete table
+        TableSchema table_schema;
+        if (LoadTable(table_id, table_schema).ok() && table_schema.state_ != (int)TableSchema::TO_DELETE) {
+            table_schema.state_ = (int)TableSchema::TO_DELETE;
+            auto status = store_->Put(TableKey(table_id), EncodeTable(table_schema));
+            if (!status.ok()) {
+                return HandleException("Encounter exception when delete table", status.message().c_str());
+            }
+        }
+
+        ENGINE_LOG_DEBUG << "Successfully delete table, table id = " << table_id;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when delete table", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::DeleteTableFiles(const std::string& table_id) {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        // soft delete table files
+        TableFilesSchema files;
+        auto status = LoadFiles(table_id, files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        KVStore::WriteBatch batch;
+        auto now = utils::GetMicroSecTimeStamp();
+        for (auto& file : files) {
+            if (file.file_type_ != (int)TableFileSchema::TO_DELETE) {
+                file.file_type_ = (int)TableFileSchema::TO_DELETE;
+                file.updated_time_ = now;
+                PutFile(file, batch);
+            }
+        }
+        status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("Encounter exception when delete table files", status.message().c_str());
+        }
+
+        ENGINE_LOG_DEBUG << "Successfully delete table files, table id = " << table_id;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when delete table files", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::CreateTableFile(TableFileSchema& file_schema) {
+    if (file_schema.date_ == EmptyDate) {
+        file_schema.date_ = utils::GetDate();
+    }
+    TableSchema table_schema;
+    table_schema.table_id_ = file_schema.table_id_;
+    auto status = DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    try {
+        server::MetricCollector metric;
+
+        NextFileId(file_schema.file_id_);
+        file_schema.dimension_ = table_schema.dimension_;
+        file_schema.file_size_ = 0;
+        file_schema.row_count_ = 0;
+        file_schema.created_on_ = utils::GetMicroSecTimeStamp();
+        file_schema.updated_time_ = file_schema.created_on_;
+        file_schema.index_file_size_ = table_schema.index_file_size_;
+        file_schema.engine_type_ = table_schema.engine_type_;
+        file_schema.nlist_ = table_schema.nlist_;
+        file_schema.metric_type_ = table_schema.metric_type_;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        KVStore::WriteBatch batch;
+        file_schema.id_ = NextSequence(FILE_SEQUENCE, batch);
+        PutFile(file_schema, batch);
+        status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("Encounter exception when create table file", status.message().c_str());
+        }
+
+        ENGINE_LOG_DEBUG << "Successfully create table file, file id = " << file_schema.file_id_;
+        return utils::CreateTableFilePath(options_, file_schema);
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when create table file", e.what());
+    }
+}
+
+Status
+KVMetaImpl::DropDataByDate(const std::string& table_id, const DatesT& dates) {
+    if (dates.empty()) {
+        return Status::OK();
+    }
+
+    TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    try {
+        std::set<DateT> date_set(dates.begin(), dates.end());
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        TableFilesSchema files;
+        status = LoadFiles(table_id, files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        KVStore::WriteBatch batch;
+        auto now = utils::GetMicroSecTimeStamp();
+        for (auto& file : files) {
+            if (date_set.find(file.date_) != date_set.end()) {
+                file.file_type_ = (int)TableFileSchema::TO_DELETE;
+                file.updated_time_ = now;
+                PutFile(file, batch);
+            }
+        }
+        status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("Encounter exception when drop partition", status.message().c_str());
+        }
+
+        ENGINE_LOG_DEBUG << "Successfully drop data by date, table id = " << table_schema.table_id_;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when drop partition", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::GetTableFiles(const std::string& table_id, const std::vector<size_t>& ids,
+                          TableFilesSchema& table_files) {
+    try {
+        table_files.clear();
+
+        TableSchema table_schema;
+        table_schema.table_id_ = table_id;
+        auto status = DescribeTable(table_schema);
+        if (!status.ok()) {
+            return status;
+        }
+
+        std::set<size_t> id_set(ids.begin(), ids.end());
+        for (auto id : id_set) {
+            std::string value;
+            if (!store_->Get(FileKey(table_id, id), value).ok()) {
+                continue;
+            }
+
+            TableFileSchema file_schema;
+            DecodeFile(value, file_schema);
+            if (file_schema.file_type_ == (int)TableFileSchema::TO_DELETE) {
+                continue;
+            }
+            CopyTableFields(table_schema, file_schema);
+            utils::GetTableFilePath(options_, file_schema);
+            table_files.emplace_back(file_schema);
+        }
+
+        ENGINE_LOG_DEBUG << "Get table files by id";
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when lookup table files", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::UpdateTableFlag(const std::string& table_id, int64_t flag) {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        TableSchema table_schema;
+        if (LoadTable(table_id, table_schema).ok()) {
+            table_schema.flag_ = flag;
+            auto status = store_->Put(TableKey(table_id), EncodeTable(table_schema));
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        ENGINE_LOG_DEBUG << "Successfully update table flag, table id = " << table_id;
+    } catch (std::exception& e) {
+        std::string msg = "Encounter exception when update table flag: table_id = " + table_id;
+        return HandleException(msg, e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
+    TableFilesSchema files = {file_schema};
+    auto status = UpdateTableFiles(files);
+    file_schema = files.front();
+    return status;
+}
+
+Status
+KVMetaImpl::UpdateTableFiles(TableFilesSchema& files) {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        // if the table has been deleted, the files are marked as TO_DELETE, clean thread will delete them later
+        std::map<std::string, bool> has_tables;
+        KVStore::WriteBatch batch;
+        for (auto& file : files) {
+            if (has_tables.find(file.table_id_) == has_tables.end()) {
+                TableSchema table_schema;
+                has_tables[file.table_id_] =
+                    LoadTable(file.table_id_, table_schema).ok() && table_schema.state_ != (int)TableSchema::TO_DELETE;
+            }
+
+            // a file already removed by clean up is not brought back
+            std::string value;
+            if (!store_->Get(FileKey(file.table_id_, file.id_), value).ok()) {
+                continue;
+            }
+
+            if (!has_tables[file.table_id_]) {
+                file.file_type_ = TableFileSchema::TO_DELETE;
+            }
+            file.updated_time_ = utils::GetMicroSecTimeStamp();
+            PutFile(file, batch);
+        }
+
+        auto status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("Encounter exception when update table files", status.message().c_str());
+        }
+
+        ENGINE_LOG_DEBUG << "Update " << files.size() << " table files";
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when update table files", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::UpdateTableIndex(const std::string& table_id, const TableIndex& index) {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        TableSchema table_schema;
+        if (!LoadTable(table_id, table_schema).ok() || table_schema.state_ == (int)TableSchema::TO_DELETE) {
+            return Status(DB_NOT_FOUND, "Table " + table_id + " not found");
+        }
+
+        KVStore::WriteBatch batch;
+        table_schema.engine_type_ = index.engine_type_;
+        table_schema.nlist_ = index.nlist_;
+        table_schema.metric_type_ = index.metric_type_;
+        PutTable(table_schema, batch);
+
+        // backup files stay backups, their index files are dropped or replaced by the caller
+        auto status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("Encounter exception when update table index", status.message().c_str());
+        }
+
+        ENGINE_LOG_DEBUG << "Successfully update table index, table id = " << table_id;
+    } catch (std::exception& e) {
+        std::string msg = "Encounter exception when update table index: table_id = " + table_id;
+        return HandleException(msg, e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::UpdateTableFilesToIndex(const std::string& table_id) {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        TableFilesSchema files;
+        auto status = LoadFiles(table_id, files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        KVStore::WriteBatch batch;
+        for (auto& file : files) {
+            if (file.file_type_ == (int)TableFileSchema::RAW && file.row_count_ >= meta::BUILD_INDEX_THRESHOLD) {
+                file.file_type_ = (int)TableFileSchema::TO_INDEX;
+                PutFile(file, batch);
+            }
+        }
+        status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("Encounter exception when update table files to to_index",
+                                   status.message().c_str());
+        }
+
+        ENGINE_LOG_DEBUG << "Update files to to_index, table id = " << table_id;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when update table files to to_index", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::DescribeTableIndex(const std::string& table_id, TableIndex& index) {
+    TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    index.engine_type_ = table_schema.engine_type_;
+    index.nlist_ = table_schema.nlist_;
+    index.metric_type_ = table_schema.metric_type_;
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::DropTableIndex(const std::string& table_id) {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        TableFilesSchema files;
+        auto status = LoadFiles(table_id, files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // soft delete index files, set all backup file to raw
+        KVStore::WriteBatch batch;
+        auto now = utils::GetMicroSecTimeStamp();
+        for (auto& file : files) {
+            if (file.file_type_ == (int)TableFileSchema::INDEX) {
+                file.file_type_ = (int)TableFileSchema::TO_DELETE;
+            } else if (file.file_type_ == (int)TableFileSchema::BACKUP) {
+                file.file_type_ = (int)TableFileSchema::RAW;
+            } else {
+                continue;
+            }
+            file.updated_time_ = now;
+            PutFile(file, batch);
+        }
+
+        // set table index type to raw
+        TableSchema table_schema;
+        if (LoadTable(table_id, table_schema).ok()) {
+            table_schema.engine_type_ = DEFAULT_ENGINE_TYPE;
+            table_schema.nlist_ = DEFAULT_NLIST;
+            PutTable(table_schema, batch);
+        }
+
+        status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("Encounter exception when delete table index files", status.message().c_str());
+        }
+
+        ENGINE_LOG_DEBUG << "Successfully drop table index, table id = " << table_id;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when delete table index files", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::CreatePartition(const std::string& table_id, const std::string& partition_name, const std::string& tag) {
+    server::MetricCollector metric;
+
+    TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // not allow create partition under partition
+    if (!table_schema.owner_table_.empty()) {
+        return Status(DB_ERROR, "Nested partition is not allowed");
+    }
+
+    // trim side-blank of tag, only compare valid characters
+    // for example: " ab cd " is treated as "ab cd"
+    std::string valid_tag = tag;
+    server::StringHelpFunctions::TrimStringBlank(valid_tag);
+
+    // not allow duplicated partition
+    std::string exist_partition;
+    GetPartitionName(table_id, valid_tag, exist_partition);
+    if (!exist_partition.empty()) {
+        return Status(DB_ERROR, "Duplicate partition is not allowed");
+    }
+
+    if (partition_name == "") {
+        // generate unique partition name
+        NextTableId(table_schema.table_id_);
+    } else {
+        table_schema.table_id_ = partition_name;
+    }
+
+    table_schema.id_ = -1;
+    table_schema.flag_ = 0;
+    table_schema.created_on_ = utils::GetMicroSecTimeStamp();
+    table_schema.owner_table_ = table_id;
+    table_schema.partition_tag_ = valid_tag;
+
+    status = CreateTable(table_schema);
+    if (status.code() == DB_ALREADY_EXIST) {
+        return Status(DB_ALREADY_EXIST, "Partition already exists");
+    }
+
+    return status;
+}
+
+Status
+KVMetaImpl::DropPartition(const std::string& partition_name) {
+    return DropTable(partition_name);
+}
+
+Status
+KVMetaImpl::ShowPartitions(const std::string& table_id, std::vector<meta::TableSchema>& partition_schema_array) {
+    try {
+        server::MetricCollector metric;
+
+        std::vector<TableSchema> tables;
+        auto status = LoadTables(tables);
+        if (!status.ok()) {
+            return status;
+        }
+        for (auto& table : tables) {
+            if (table.owner_table_ == table_id && table.state_ != (int)TableSchema::TO_DELETE) {
+                partition_schema_array.emplace_back(table);
+            }
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when show partitions", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::GetPartitionName(const std::string& table_id, const std::string& tag, std::string& partition_name) {
+    // trim side-blank of tag, only compare valid characters
+    // for example: " ab cd " is treated as "ab cd"
+    std::string valid_tag = tag;
+    server::StringHelpFunctions::TrimStringBlank(valid_tag);
+
+    std::vector<TableSchema> partitions;
+    auto status = ShowPartitions(table_id, partitions);
+    if (!status.ok()) {
+        return status;
+    }
+    for (auto& partition : partitions) {
+        if (partition.partition_tag_ == valid_tag) {
+            partition_name = partition.table_id_;
+            return Status::OK();
+        }
+    }
+
+    return Status(DB_NOT_FOUND, "Table " + table_id + "'s partition " + valid_tag + " not found");
+}
+
+Status
+KVMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
+                          DatePartionedTableFilesSchema& files) {
+    files.clear();
+    server::MetricCollector metric;
+
+    try {
+        fiu_do_on("KVMetaImpl.FilesToSearch.throw_exception", throw std::exception());
+
+        TableSchema table_schema;
+        table_schema.table_id_ = table_id;
+        auto status = DescribeTable(table_schema);
+        if (!status.ok()) {
+            return status;
+        }
+
+        TableFilesSchema table_files;
+        status = LoadFiles(table_id, table_files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        std::set<size_t> id_set(ids.begin(), ids.end());
+        std::set<DateT> date_set(dates.begin(), dates.end());
+        Status ret;
+        size_t file_count = 0;
+        for (auto& table_file : table_files) {
+            if (!IsSearchable(table_file) || (!id_set.empty() && id_set.find(table_file.id_) == id_set.end()) ||
+                (!date_set.empty() && date_set.find(table_file.date_) == date_set.end())) {
+                continue;
+            }
+
+            CopyTableFields(table_schema, table_file);
+            auto status = utils::GetTableFilePath(options_, table_file);
+            if (!status.ok()) {
+                ret = status;
+            }
+            files[table_file.date_].push_back(table_file);
+            ++file_count;
+        }
+        if (files.empty()) {
+            ENGINE_LOG_ERROR << "No file to search for table: " << table_id;
+        }
+
+        if (file_count > 0) {
+            ENGINE_LOG_DEBUG << "Collect " << file_count << " to-search files";
+        }
+        return ret;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when iterate index files", e.what());
+    }
+}
+
+Status
+KVMetaImpl::FilesToSearch(const std::vector<std::string>& table_ids, const DatesT& dates,
+                          DatePartionedTableFilesSchema& files) {
+    files.clear();
+    if (table_ids.empty()) {
+        return Status::OK();
+    }
+
+    server::MetricCollector metric;
+
+    try {
+        fiu_do_on("KVMetaImpl.FilesToSearch.throw_exception", throw std::exception());
+
+        // each table is one prefix scan, tables not found are skipped
+        std::set<DateT> date_set(dates.begin(), dates.end());
+        Status ret;
+        size_t table_count = 0, file_count = 0;
+        for (auto& table_id : table_ids) {
+            TableSchema table_schema;
+            table_schema.table_id_ = table_id;
+            if (!DescribeTable(table_schema).ok()) {
+                continue;
+            }
+            ++table_count;
+
+            TableFilesSchema table_files;
+            auto status = LoadFiles(table_id, table_files);
+            if (!status.ok()) {
+                return status;
+            }
+            for (auto& table_file : table_files) {
+                if (!IsSearchable(table_file) ||
+                    (!date_set.empty() && date_set.find(table_file.date_) == date_set.end())) {
+                    continue;
+                }
+
+                CopyTableFields(table_schema, table_file);
+                status = utils::GetTableFilePath(options_, table_file);
+                if (!status.ok()) {
+                    ret = status;
+                }
+                files[table_file.date_].push_back(table_file);
+                ++file_count;
+            }
+        }
+        if (table_count == 0) {
+            return Status(DB_NOT_FOUND, "Table " + table_ids.front() + " not found");
+        }
+
+        if (file_count > 0) {
+            ENGINE_LOG_DEBUG << "Collect " << file_count << " to-search files of " << table_count << " tables";
+        }
+        return ret;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when iterate index files", e.what());
+    }
+}
+
+Status
+KVMetaImpl::FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) {
+    files.clear();
+
+    try {
+        server::MetricCollector metric;
+
+        // check table existence
+        TableSchema table_schema;
+        table_schema.table_id_ = table_id;
+        auto status = DescribeTable(table_schema);
+        if (!status.ok()) {
+            return status;
+        }
+
+        TableFilesSchema table_files;
+        status = LoadFiles(table_id, table_files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // larger files first, like other metas order them
+        std::stable_sort(table_files.begin(), table_files.end(),
+                         [](const TableFileSchema& a, const TableFileSchema& b) { return a.file_size_ > b.file_size_; });
+
+        Status result;
+        int64_t to_merge_files = 0;
+        for (auto& table_file : table_files) {
+            if (table_file.file_type_ != (int)TableFileSchema::RAW ||
+                table_file.file_size_ >= table_schema.index_file_size_) {
+                continue;  // skip large file
+            }
+
+            CopyTableFields(table_schema, table_file);
+            auto status = utils::GetTableFilePath(options_, table_file);
+            if (!status.ok()) {
+                result = status;
+            }
+
+            files[table_file.date_].push_back(table_file);
+            ++to_merge_files;
+        }
+
+        if (to_merge_files > 0) {
+            ENGINE_LOG_TRACE << "Collect " << to_merge_files << " to-merge files";
+        }
+        return result;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when iterate merge files", e.what());
+    }
+}
+
+Status
+KVMetaImpl::FilesToIndex(TableFilesSchema& files) {
+    files.clear();
+
+    try {
+        server::MetricCollector metric;
+
+        TableFilesSchema table_files;
+        auto status = LoadFiles("", table_files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        std::map<std::string, TableSchema> groups;
+        Status ret;
+        for (auto& table_file : table_files) {
+            if (table_file.file_type_ != (int)TableFileSchema::TO_INDEX) {
+                continue;
+            }
+
+            auto status = utils::GetTableFilePath(options_, table_file);
+            if (!status.ok()) {
+                ret = status;
+            }
+            auto groupItr = groups.find(table_file.table_id_);
+            if (groupItr == groups.end()) {
+                TableSchema table_schema;
+                table_schema.table_id_ = table_file.table_id_;
+                auto status = DescribeTable(table_schema);
+                if (!status.ok()) {
+                    return status;
+                }
+                groupItr = groups.insert(std::make_pair(table_file.table_id_, table_schema)).first;
+            }
+            CopyTableFields(groupItr->second, table_file);
+            files.push_back(table_file);
+        }
+
+        if (files.size() > 0) {
+            ENGINE_LOG_DEBUG << "Collect " << files.size() << " to-index files";
+        }
+        return ret;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when iterate raw files", e.what());
+    }
+}
+
+Status
+KVMetaImpl::FilesByType(const std::string& table_id, const std::vector<int>& file_types,
+                        TableFilesSchema& table_files) {
+    if (file_types.empty()) {
+        return Status(DB_ERROR, "file types array is empty");
+    }
+
+    try {
+        table_files.clear();
+
+        TableFilesSchema files;
+        auto status = LoadFiles(table_id, files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        std::set<int> type_set(file_types.begin(), file_types.end());
+        std::map<int, int> type_count;
+        for (auto& file : files) {
+            if (type_set.find(file.file_type_) != type_set.end()) {
+                ++type_count[file.file_type_];
+                table_files.emplace_back(file);
+            }
+        }
+
+        if (!table_files.empty()) {
+            std::string msg = "Get table files by type.";
+            for (auto& count : type_count) {
+                msg += " type " + std::to_string(count.first) + " files:" + std::to_string(count.second);
+            }
+            ENGINE_LOG_DEBUG << msg;
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when check non index files", e.what());
+    }
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::Archive() {
+    auto& criterias = options_.archive_conf_.GetCriterias();
+    if (criterias.size() == 0) {
+        return Status::OK();
+    }
+
+    for (auto kv : criterias) {
+        auto& criteria = kv.first;
+        auto& limit = kv.second;
+        // files past the days are compressed by the db instead when the archive type is compress
+        bool compress = (options_.archive_conf_.GetType() == engine::ARCHIVE_TYPE_COMPRESS);
+        if (criteria == engine::ARCHIVE_CONF_DAYS && !compress) {
+            int64_t usecs = limit * DAY * US_PS;
+            int64_t now = utils::GetMicroSecTimeStamp();
+            try {
+                std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+                TableFilesSchema files;
+                auto status = LoadFiles("", files);
+                if (!status.ok()) {
+                    return status;
+                }
+
+                KVStore::WriteBatch batch;
+                for (auto& file : files) {
+                    if (file.created_on_ < now - usecs && file.file_type_ != (int)TableFileSchema::TO_DELETE) {
+                        file.file_type_ = (int)TableFileSchema::TO_DELETE;
+                        PutFile(file, batch);
+                    }
+                }
+                status = store_->Write(batch);
+                if (!status.ok()) {
+                    return HandleException("Encounter exception when update table files", status.message().c_str());
+                }
+            } catch (std::exception& e) {
+                return HandleException("Encounter exception when update table files", e.what());
+            }
+
+            ENGINE_LOG_DEBUG << "Archive old files";
+        }
+        if (criteria == engine::ARCHIVE_CONF_DISK) {
+            uint64_t sum = 0;
+            Size(sum);
+
+            int64_t to_delete = (int64_t)sum - limit * G;
+            DiscardFiles(to_delete);
+
+            ENGINE_LOG_DEBUG << "Archive files to free disk";
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::Size(uint64_t& result) {
+    result = 0;
+    try {
+        TableFilesSchema files;
+        auto status = LoadFiles("", files);
+        if (!status.ok()) {
+            return status;
+        }
+        for (auto& file : files) {
+            if (file.file_type_ != (int)TableFileSchema::TO_DELETE) {
+                result += file.file_size_;
+            }
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when calculte db size", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::DiscardFiles(int64_t to_discard_size) {
+    if (to_discard_size <= 0) {
+        return Status::OK();
+    }
+
+    ENGINE_LOG_DEBUG << "About to discard size=" << to_discard_size;
+
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        TableFilesSchema files;
+        auto status = LoadFiles("", files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // oldest files first
+        std::sort(files.begin(), files.end(),
+                  [](const TableFileSchema& a, const TableFileSchema& b) { return a.id_ < b.id_; });
+
+        KVStore::WriteBatch batch;
+        auto now = utils::GetMicroSecTimeStamp();
+        for (auto& file : files) {
+            if (to_discard_size <= 0) {
+                break;
+            }
+            if (file.file_type_ == (int)TableFileSchema::TO_DELETE) {
+                continue;
+            }
+            ENGINE_LOG_DEBUG << "Discard table_file.id=" << file.file_id_ << " table_file.size=" << file.file_size_;
+            to_discard_size -= file.file_size_;
+            file.file_type_ = (int)TableFileSchema::TO_DELETE;
+            file.updated_time_ = now;
+            PutFile(file, batch);
+        }
+
+        status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("DiscardFiles error: meta write failed", status.message().c_str());
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when discard table file", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::CleanUpShadowFiles() {
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        TableFilesSchema files;
+        auto status = LoadFiles("", files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        KVStore::WriteBatch batch;
+        int64_t clean_files = 0;
+        for (auto& file : files) {
+            if (file.file_type_ == (int)TableFileSchema::NEW || file.file_type_ == (int)TableFileSchema::NEW_INDEX ||
+                file.file_type_ == (int)TableFileSchema::NEW_MERGE) {
+                batch.Delete(FileKey(file.table_id_, file.id_));
+                ++clean_files;
+            }
+        }
+
+        status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("CleanUp error: meta write failed", status.message().c_str());
+        }
+
+        if (clean_files > 0) {
+            ENGINE_LOG_DEBUG << "Clean " << clean_files << " files";
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when clean table file", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
+    auto now = utils::GetMicroSecTimeStamp();
+    std::set<std::string> table_ids;
+
+    // remove to_delete files
+    try {
+        server::MetricCollector metric;
+
+        TableFilesSchema files;
+        auto status = LoadFiles("", files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // like sqlite meta, disk files are deleted without the lock and their keys removed in short batches
+        const size_t batch_size = 64;
+        int64_t clean_files = 0;
+        KVStore::WriteBatch batch;
+        TableFilesSchema batch_files;
+        auto commit_batch = [&]() {
+            // delete files of the batch from disk storage at once, then their keys
+            utils::DeleteTableFilePaths(options_, batch_files);
+            for (auto& file : batch_files) {
+                ENGINE_LOG_DEBUG << "Remove file id:" << file.file_id_ << " location:" << file.location_;
+                table_ids.insert(file.table_id_);
+                batch.Delete(FileKey(file.table_id_, file.id_));
+            }
+
+            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            auto status = store_->Write(batch);
+            if (status.ok()) {
+                clean_files += batch_files.size();
+            }
+            batch = KVStore::WriteBatch();
+            batch_files.clear();
+            return status;
+        };
+        for (auto& table_file : files) {
+            bool expired = (table_file.file_type_ == (int)TableFileSchema::TO_DELETE ||
+                            table_file.file_type_ == (int)TableFileSchema::BACKUP) &&
+                           table_file.updated_time_ < now - (int64_t)(seconds * US_PS);
+            if (expired) {
+                // check if the file can be deleted
+                if (filter && filter->IsIgnored(table_file)) {
+                    ENGINE_LOG_DEBUG << "File:" << table_file.file_id_
+                                     << " currently is in use, not able to delete now";
+                    continue;  // ignore this file, don't delete it
+                }
+
+                // erase from cache, must do this before file deleted,
+                // because GetTableFilePath won't able to generate file path after the file is deleted
+                utils::GetTableFilePath(options_, table_file);
+                server::CommonUtil::EraseFromCache(table_file.location_);
+
+                if (table_file.file_type_ == (int)TableFileSchema::TO_DELETE) {
+                    batch_files.push_back(table_file);
+                }
+            }
+
+            if (batch_files.size() >= batch_size) {
+                status = commit_batch();
+                if (!status.ok()) {
+                    return HandleException("CleanUpFilesWithTTL error: meta write failed", status.message().c_str());
+                }
+            }
+        }
+        status = commit_batch();
+        if (!status.ok()) {
+            return HandleException("CleanUpFilesWithTTL error: meta write failed", status.message().c_str());
+        }
+
+        if (clean_files > 0) {
+            ENGINE_LOG_DEBUG << "Clean " << clean_files << " files expired in " << seconds << " seconds";
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when clean table files", e.what());
+    }
+
+    // remove to_delete tables
+    try {
+        server::MetricCollector metric;
+
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        std::vector<TableSchema> tables;
+        auto status = LoadTables(tables);
+        if (!status.ok()) {
+            return status;
+        }
+
+        KVStore::WriteBatch batch;
+        int64_t remove_tables = 0;
+        for (auto& table : tables) {
+            if (table.state_ == (int)TableSchema::TO_DELETE) {
+                utils::DeleteTablePath(options_, table.table_id_, false);  // only delete empty folder
+                batch.Delete(TableKey(table.table_id_));
+                ++remove_tables;
+            }
+        }
+        status = store_->Write(batch);
+        if (!status.ok()) {
+            return HandleException("CleanUpFilesWithTTL error: meta write failed", status.message().c_str());
+        }
+
+        if (remove_tables > 0) {
+            ENGINE_LOG_DEBUG << "Remove " << remove_tables << " tables from meta";
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when clean table files", e.what());
+    }
+
+    // remove deleted table folder
+    // don't remove table folder until all its files has been deleted
+    try {
+        server::MetricCollector metric;
+
+        int64_t remove_tables = 0;
+        for (auto& table_id : table_ids) {
+            // merges of the table still write into the folder, it is removed by a later clean up
+            if (filter && filter->IsTableIgnored(table_id)) {
+                continue;
+            }
+            KVStore::KVPairs pairs;
+            store_->Scan(FilesPrefix(table_id), pairs);
+            if (pairs.empty()) {
+                utils::DeleteTablePath(options_, table_id);
+                ++remove_tables;
+            }
+        }
+
+        if (remove_tables) {
+            ENGINE_LOG_DEBUG << "Remove " << remove_tables << " tables folder";
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when delete table folder", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+KVMetaImpl::DropAll() {
+    ENGINE_LOG_DEBUG << "Drop all kv meta";
+
+    return store_->Clear();
+}
+
+Status
+KVMetaImpl::Count(const std::string& table_id, uint64_t& result) {
+    try {
+        server::MetricCollector metric;
+
+        TableSchema table_schema;
+        table_schema.table_id_ = table_id;
+        auto status = DescribeTable(table_schema);
+        if (!status.ok()) {
+            return status;
+        }
+
+        TableFilesSchema files;
+        status = LoadFiles(table_id, files);
+        if (!status.ok()) {
+            return status;
+        }
+
+        result = 0;
+        for (auto& file : files) {
+            if (IsSearchable(file)) {
+                result += file.row_count_;
+            }
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when calculate table file size", e.what());
+    }
+    return Status::OK();
+}
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,172 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "KVStore.h"
+#include "Meta.h"
+#include "db/Options.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+/*
+ * Meta of a single server kept in an embedded key-value store, no sql engine in between.
+ * A table is one key "tables/<table_id>", its files are keys under "files/<table_id>/", so the files
+ * of a table are one prefix scan and a file update is one write.
+ */
+class KVMetaImpl : public Meta {
+ public:
+    explicit KVMetaImpl(const DBMetaOptions& options);
+    ~KVMetaImpl();
+
+    Status
+    CreateTable(TableSchema& table_schema) override;
+
+    Status
+    DescribeTable(TableSchema& table_schema) override;
+
+    Status
+    HasTable(const std::string& table_id, bool& has_or_not) override;
+
+    Status
+    AllTables(std::vector<TableSchema>& table_schema_array) override;
+
+    Status
+    DropTable(const std::string& table_id) override;
+
+    Status
+    DeleteTableFiles(const std::string& table_id) override;
+
+    Status
+    CreateTableFile(TableFileSchema& file_schema) override;
+
+    Status
+    DropDataByDate(const std::string& table_id, const DatesT& dates) override;
+
+    Status
+    GetTableFiles(const std::string& table_id, const std::vector<size_t>& ids, TableFilesSchema& table_files) override;
+
+    Status
+    UpdateTableIndex(const std::string& table_id, const TableIndex& index) override;
+
+    Status
+    UpdateTableFlag(const std::string& table_id, int64_t flag) override;
+
+    Status
+    UpdateTableFile(TableFileSchema& file_schema) override;
+
+    Status
+    UpdateTableFilesToIndex(const std::string& table_id) override;
+
+    Status
+    UpdateTableFiles(TableFilesSchema& files) override;
+
+    Status
+    DescribeTableIndex(const std::string& table_id, TableIndex& index) override;
+
+    Status
+    DropTableIndex(const std::string& table_id) override;
+
+    Status
+    CreatePartition(const std::string& table_id, const std::string& partition_name, const std::string& tag) override;
+
+    Status
+    DropPartition(const std::string& partition_name) override;
+
+    Status
+    ShowPartitions(const std::string& table_id, std::vector<meta::TableSchema>& partition_schema_array) override;
+
+    Status
+    GetPartitionName(const std::string& table_id, const std::string& tag, std::string& partition_name) override;
+
+    Status
+    FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
+                  DatePartionedTableFilesSchema& files) override;
+
+    Status
+    FilesToSearch(const std::vector<std::string>& table_ids, const DatesT& dates,
+                  DatePartionedTableFilesSchema& files) override;
+
+    Status
+    FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) override;
+
+    Status
+    FilesToIndex(TableFilesSchema&) override;
+
+    Status
+    FilesByType(const std::string& table_id, const std::vector<int>& file_types,
+                TableFilesSchema& table_files) override;
+
+    Status
+    Size(uint64_t& result) override;
+
+    Status
+    Archive() override;
+
+    Status
+    CleanUpShadowFiles() override;
+
+    Status
+    CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter = nullptr) override;
+
+    Status
+    DropAll() override;
+
+    Status
+    Count(const std::string& table_id, uint64_t& result) override;
+
+ private:
+    Status
+    NextFileId(std::string& file_id);
+    Status
+    NextTableId(std::string& table_id);
+    Status
+    DiscardFiles(int64_t to_discard_size);
+
+    Status
+    Initialize();
+
+    // row id of a new table or file, the counter is written in the batch creating it
+    size_t
+    NextSequence(const std::string& key, KVStore::WriteBatch& batch);
+
+    // tables in delete state are loaded too, it is up to the caller to skip them
+    Status
+    LoadTable(const std::string& table_id, TableSchema& table_schema);
+    Status
+    LoadTables(std::vector<TableSchema>& table_schemas);
+
+    // files of a table, or of all tables if table_id is empty
+    Status
+    LoadFiles(const std::string& table_id, TableFilesSchema& files);
+
+    void
+    PutTable(const TableSchema& table_schema, KVStore::WriteBatch& batch);
+    void
+    PutFile(const TableFileSchema& file_schema, KVStore::WriteBatch& batch);
+
+ private:
+    const DBMetaOptions options_;
+    std::unique_ptr<KVStore> store_;
+    std::mutex meta_mutex_;
+    std::mutex genid_mutex_;
+};  // KVMetaImpl
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,475 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/meta/KVStore.h"
+#include "utils/Log.h"
+
+#include <fcntl.h>
+#include <fiu-local.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+namespace {
+
+constexpr uint64_t COMPACT_MIN_LOG_SIZE = 4 * 1024 * 1024;
+constexpr uint64_t SNAPSHOT_RECORD_SIZE = 1024 * 1024;
+constexpr size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+// FNV-1a, enough to tell a torn record from a complete one
+uint32_t
+Checksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void
+AppendUint32(std::string& buf, uint32_t value) {
+    buf.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+bool
+ReadUint32(const std::string& buf, size_t& offset, uint32_t& value) {
+    if (offset + sizeof(value) > buf.size()) {
+        return false;
+    }
+    memcpy(&value, buf.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return true;
+}
+
+bool
+ReadString(const std::string& buf, size_t& offset, std::string& value) {
+    uint32_t size = 0;
+    if (!ReadUint32(buf, offset, size) || offset + size > buf.size()) {
+        return false;
+    }
+    value.assign(buf.data() + offset, size);
+    offset += size;
+    return true;
+}
+
+void
+AppendOp(std::string& payload, bool put, const std::string& key, const std::string& value) {
+    payload.push_back(put ? 1 : 0);
+    AppendUint32(payload, key.size());
+    payload.append(key);
+    AppendUint32(payload, value.size());
+    payload.append(value);
+}
+
+std::string
+MakeRecord(const std::string& payload, uint32_t op_count) {
+    std::string body;
+    AppendUint32(body, op_count);
+    body.append(payload);
+
+    std::string record;
+    AppendUint32(record, body.size());
+    AppendUint32(record, Checksum(body.data(), body.size()));
+    record.append(body);
+    return record;
+}
+
+Status
+WriteAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        auto ret = ::write(fd, data.data() + written, data.size() - written);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return Status(DB_ERROR, std::string("Failed to write meta log: ") + strerror(errno));
+        }
+        written += ret;
+    }
+    if (::fdatasync(fd) != 0) {
+        return Status(DB_ERROR, std::string("Failed to sync meta log: ") + strerror(errno));
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+KVStore::KVStore(const std::string& path) : path_(path) {
+}
+
+KVStore::~KVStore() {
+    if (compact_thread_.joinable()) {
+        compact_thread_.join();
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+Status
+KVStore::Open() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto status = Replay();
+    if (!status.ok()) {
+        return status;
+    }
+
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd_ < 0) {
+        return Status(DB_ERROR, "Failed to open meta log " + path_ + ": " + strerror(errno));
+    }
+    if (::ftruncate(fd_, log_size_) != 0) {
+        return Status(DB_ERROR, "Failed to truncate meta log " + path_ + ": " + strerror(errno));
+    }
+
+    ENGINE_LOG_DEBUG << "Open meta log " << path_ << ": " << data_.size() << " keys, " << log_size_ << " bytes";
+    return Status::OK();
+}
+
+Status
+KVStore::Replay() {
+    std::ifstream in(path_, std::ios::binary);
+    if (!in) {
+        return Status::OK();  // new store
+    }
+    std::string buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    size_t offset = 0;
+    while (offset + RECORD_HEADER_SIZE <= buf.size()) {
+        size_t pos = offset;
+        uint32_t body_size = 0, checksum = 0;
+        ReadUint32(buf, pos, body_size);
+        ReadUint32(buf, pos, checksum);
+        if (pos + body_size > buf.size() || Checksum(buf.data() + pos, body_size) != checksum) {
+            break;
+        }
+
+        std::string body = buf.substr(pos, body_size);
+        size_t body_pos = 0;
+        uint32_t op_count = 0;
+        bool valid = ReadUint32(body, body_pos, op_count);
+        for (uint32_t i = 0; valid && i < op_count; ++i) {
+            if (body_pos >= body.size()) {
+                valid = false;
+                break;
+            }
+            bool put = body[body_pos++] != 0;
+            std::string key, value;
+            valid = ReadString(body, body_pos, key) && ReadString(body, body_pos, value);
+            if (!valid) {
+                break;
+            }
+
+            auto iter = data_.find(key);
+            if (iter != data_.end()) {
+                live_size_ -= iter->first.size() + iter->second.size();
+            }
+            if (put) {
+                live_size_ += key.size() + value.size();
+                data_[key] = std::move(value);
+            } else if (iter != data_.end()) {
+                data_.erase(iter);
+            }
+        }
+        if (!valid) {
+            return Status(DB_ERROR, "Meta log " + path_ + " is corrupted");
+        }
+        offset = pos + body_size;
+    }
+
+    // a record written partially by a crash was never acknowledged, it is cut off
+    if (offset < buf.size()) {
+        ENGINE_LOG_WARNING << "Drop " << buf.size() - offset << " bytes of incomplete record at the end of meta log "
+                           << path_;
+    }
+    log_size_ = offset;
+    return Status::OK();
+}
+
+Status
+KVStore::Get(const std::string& key, std::string& value) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto iter = data_.find(key);
+    if (iter == data_.end()) {
+        return Status(DB_NOT_FOUND, "Key " + key + " not found");
+    }
+    value = iter->second;
+    return Status::OK();
+}
+
+Status
+KVStore::Scan(const std::string& prefix, KVPairs& pairs) {
+    pairs.clear();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (auto iter = data_.lower_bound(prefix); iter != data_.end(); ++iter) {
+        if (iter->first.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+        pairs.emplace_back(iter->first, iter->second);
+    }
+    return Status::OK();
+}
+
+Status
+KVStore::Put(const std::string& key, const std::string& value) {
+    WriteBatch batch;
+    batch.Put(key, value);
+    return Write(batch);
+}
+
+Status
+KVStore::Delete(const std::string& key) {
+    WriteBatch batch;
+    batch.Delete(key);
+    return Write(batch);
+}
+
+Status
+KVStore::Write(const WriteBatch& batch) {
+    if (batch.Empty()) {
+        return Status::OK();
+    }
+
+    std::string payload;
+    for (auto& op : batch.ops_) {
+        AppendOp(payload, op.second.first, op.first, op.second.second);
+    }
+
+    Status status;
+    bool done = false;
+    std::unique_lock<std::mutex> lock(log_mutex_);
+    pending_writes_.push_back(PendingWrite{&batch, MakeRecord(payload, batch.ops_.size()), &status, &done});
+
+    // group commit: whoever finds no sync in progress logs all pending writes on behalf of the others
+    while (!done) {
+        if (syncing_) {
+            log_cv_.wait(lock);
+            continue;
+        }
+
+        syncing_ = true;
+        std::vector<PendingWrite> group;
+        group.swap(pending_writes_);
+
+        lock.unlock();
+        Status group_status;
+        bool compact = CommitGroup(group, group_status);
+        lock.lock();
+
+        syncing_ = false;
+        if (group_status.ok() && compacting_) {
+            for (auto& write : group) {
+                compact_tail_.append(write.record_);
+            }
+        }
+        for (auto& write : group) {
+            *write.status_ = group_status;
+            *write.done_ = true;
+        }
+
+        // file states change all the time, most records of an old log are overwritten or deleted keys
+        if (compact && !compacting_) {
+            compacting_ = true;
+            if (compact_thread_.joinable()) {
+                compact_thread_.join();
+            }
+            compact_thread_ = std::thread([this] {
+                auto status = Compact();
+                if (!status.ok()) {
+                    ENGINE_LOG_WARNING << "Failed to compact meta log " << path_ << ": " << status.message();
+                }
+            });
+        }
+        log_cv_.notify_all();
+    }
+
+    return status;
+}
+
+bool
+KVStore::CommitGroup(std::vector<PendingWrite>& group, Status& status) {
+    std::string records;
+    for (auto& write : group) {
+        records.append(write.record_);
+    }
+    status = AppendLog(records);
+    if (!status.ok()) {
+        return false;
+    }
+
+    // readers wait for the in-memory update only, the log is already synced
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (auto& write : group) {
+        for (auto& op : write.batch_->ops_) {
+            auto iter = data_.find(op.first);
+            if (iter != data_.end()) {
+                live_size_ -= iter->first.size() + iter->second.size();
+            }
+            if (op.second.first) {
+                live_size_ += op.first.size() + op.second.second.size();
+                data_[op.first] = op.second.second;
+            } else if (iter != data_.end()) {
+                data_.erase(iter);
+            }
+        }
+    }
+    return log_size_ > COMPACT_MIN_LOG_SIZE && log_size_ > 2 * live_size_;
+}
+
+Status
+KVStore::AppendLog(const std::string& record) {
+    if (fd_ < 0) {
+        return Status(DB_ERROR, "Meta log " + path_ + " is not open");
+    }
+    if (failed_) {
+        return Status(DB_ERROR, "Meta log " + path_ + " failed, writes are refused");
+    }
+
+    std::string data = record;
+    fiu_do_on("KVStore.AppendLog.torn_write", data.resize(record.size() / 2));
+    auto status = WriteAll(fd_, data);
+    fiu_do_on("KVStore.AppendLog.torn_write", status = Status(DB_ERROR, "Torn write of meta log"));
+    if (!status.ok()) {
+        // replay stops at a torn record, the records appended after it would be lost, so it is cut off at once,
+        // the data in memory is left untouched
+        if (::ftruncate(fd_, log_size_) != 0 || ::fdatasync(fd_) != 0) {
+            ENGINE_LOG_ERROR << "Failed to cut torn record off meta log " << path_ << ": " << strerror(errno);
+            failed_ = true;
+        }
+        return status;
+    }
+    log_size_ += record.size();
+    return Status::OK();
+}
+
+Status
+KVStore::Compact() {
+    // the snapshot is taken while no group is logged, writes queue up meanwhile but reads go on
+    std::unique_lock<std::mutex> lock(log_mutex_);
+    log_cv_.wait(lock, [this] { return !syncing_; });
+    syncing_ = true;
+    compact_tail_.clear();
+    lock.unlock();
+
+    // live keys are written in records of limited size, any of them is applied on its own on replay
+    std::string snapshot, payload;
+    uint32_t op_count = 0;
+    {
+        std::shared_lock<std::shared_mutex> data_lock(mutex_);
+        for (auto& pair : data_) {
+            AppendOp(payload, true, pair.first, pair.second);
+            ++op_count;
+            if (payload.size() >= SNAPSHOT_RECORD_SIZE) {
+                snapshot.append(MakeRecord(payload, op_count));
+                payload.clear();
+                op_count = 0;
+            }
+        }
+    }
+    if (op_count > 0) {
+        snapshot.append(MakeRecord(payload, op_count));
+    }
+
+    lock.lock();
+    syncing_ = false;
+    log_cv_.notify_all();
+    lock.unlock();
+
+    // writes go on to the old log while the snapshot is written
+    std::string tmp_path = path_ + ".tmp";
+    // kept open as the new log once renamed, no reopen that could fail is needed
+    int tmp_fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    Status status;
+    if (tmp_fd < 0) {
+        status = Status(DB_ERROR, "Failed to create " + tmp_path + ": " + strerror(errno));
+    } else {
+        status = WriteAll(tmp_fd, snapshot);
+    }
+
+    // the records logged since the snapshot go to the new log too, no write is logged until the rename
+    lock.lock();
+    log_cv_.wait(lock, [this] { return !syncing_; });
+    syncing_ = true;
+    std::string tail;
+    tail.swap(compact_tail_);
+    lock.unlock();
+
+    if (status.ok() && !tail.empty()) {
+        status = WriteAll(tmp_fd, tail);
+    }
+    if (status.ok() && ::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+        status = Status(DB_ERROR, "Failed to replace " + path_ + ": " + strerror(errno));
+    }
+    if (!status.ok()) {
+        if (tmp_fd >= 0) {
+            ::close(tmp_fd);
+            ::unlink(tmp_path.c_str());
+        }
+    } else {
+        ::close(fd_);
+        fd_ = tmp_fd;
+
+        // the rename is durable only once the directory is synced, until then a crash may bring the old log back
+        // without the records appended to the new one
+        auto dir_pos = path_.rfind('/');
+        std::string dir = (dir_pos == std::string::npos) ? "." : path_.substr(0, std::max<size_t>(dir_pos, 1));
+        int dir_fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+        if (dir_fd < 0 || ::fsync(dir_fd) != 0) {
+            failed_ = true;
+            status = Status(DB_ERROR, "Failed to sync directory of meta log " + path_ + ": " + strerror(errno));
+        }
+        if (dir_fd >= 0) {
+            ::close(dir_fd);
+        }
+        if (status.ok()) {
+            ENGINE_LOG_DEBUG << "Compact meta log " << path_ << " from " << log_size_ << " to "
+                             << snapshot.size() + tail.size() << " bytes";
+            log_size_ = snapshot.size() + tail.size();
+        }
+    }
+
+    lock.lock();
+    syncing_ = false;
+    compacting_ = false;
+    log_cv_.notify_all();
+    return status;
+}
+
+Status
+KVStore::Clear() {
+    std::unique_lock<std::mutex> log_lock(log_mutex_);
+    log_cv_.wait(log_lock, [this] { return !syncing_ && !compacting_; });
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    data_.clear();
+    live_size_ = 0;
+    if (fd_ >= 0 && ::ftruncate(fd_, 0) != 0) {
+        return Status(DB_ERROR, "Failed to truncate meta log " + path_ + ": " + strerror(errno));
+    }
+    log_size_ = 0;
+    failed_ = false;
+    return Status::OK();
+}
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,137 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "utils/Status.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+/*
+ * Embedded ordered key-value store: all keys are kept sorted in memory, every write is appended to a log file
+ * and synced before it is applied, so a crash loses no acknowledged write. Concurrent writes are logged by one
+ * of the writers under a single fdatasync. The log is replayed on open, a torn record at its tail is dropped,
+ * and it is rewritten as a snapshot of live keys in background once mostly garbage.
+ */
+class KVStore {
+ public:
+    // writes applied together, logged as one record so that none or all of them survive a crash
+    class WriteBatch {
+     public:
+        void
+        Put(const std::string& key, const std::string& value) {
+            ops_.emplace_back(key, std::make_pair(true, value));
+        }
+
+        void
+        Delete(const std::string& key) {
+            ops_.emplace_back(key, std::make_pair(false, std::string()));
+        }
+
+        bool
+        Empty() const {
+            return ops_.empty();
+        }
+
+     private:
+        friend class KVStore;
+        std::vector<std::pair<std::string, std::pair<bool, std::string>>> ops_;
+    };
+
+    using KVPairs = std::vector<std::pair<std::string, std::string>>;
+
+    explicit KVStore(const std::string& path);
+
+    ~KVStore();
+
+    Status
+    Open();
+
+    // DB_NOT_FOUND if the key doesn't exist
+    Status
+    Get(const std::string& key, std::string& value);
+
+    // all pairs whose key starts with prefix, in key order
+    Status
+    Scan(const std::string& prefix, KVPairs& pairs);
+
+    Status
+    Put(const std::string& key, const std::string& value);
+
+    Status
+    Delete(const std::string& key);
+
+    Status
+    Write(const WriteBatch& batch);
+
+    // drop all keys and the log
+    Status
+    Clear();
+
+ private:
+    struct PendingWrite {
+        const WriteBatch* batch_;
+        std::string record_;
+        Status* status_;
+        bool* done_;
+    };
+
+    Status
+    Replay();
+
+    // log and apply a group of writes, true if the log should be compacted then
+    bool
+    CommitGroup(std::vector<PendingWrite>& group, Status& status);
+
+    Status
+    AppendLog(const std::string& record);
+
+    Status
+    Compact();
+
+ private:
+    const std::string path_;
+    int fd_ = -1;
+    uint64_t log_size_ = 0;
+    uint64_t live_size_ = 0;
+    // a torn record couldn't be cut off, or a compacted log may not survive a crash, writes are refused
+    bool failed_ = false;
+
+    // guards data_ only, no file I/O is done under it
+    std::shared_mutex mutex_;
+    std::map<std::string, std::string> data_;
+
+    // the log is written by whoever sets syncing_, fd_, the sizes and failed_ are touched by it only
+    std::mutex log_mutex_;
+    std::condition_variable log_cv_;
+    std::vector<PendingWrite> pending_writes_;
+    bool syncing_ = false;
+
+    // records logged while the snapshot is written, they are appended to it before it replaces the log
+    bool compacting_ = false;
+    std::string compact_tail_;
+    std::thread compact_thread_;
+};  // KVStore
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
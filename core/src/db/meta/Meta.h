@@ -34,6 +34,12 @@ class Meta {
      public:
         virtual bool
         IsIgnored(const TableFileSchema& schema) = 0;
+
+        // folder of a dropped table is kept while a merge or an index build may still write into it
+        virtual bool
+        IsTableIgnored(const std::string& table_id) {
+            return false;
+        }
     };
 
  public:
@@ -103,6 +109,12 @@ class Meta {
     FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
                   DatePartionedTableFilesSchema& files) = 0;
 
+    // files to search of several tables in one query, e.g. a table and its partitions; tables not found are
+    // skipped, DB_NOT_FOUND if none is found
+    virtual Status
+    FilesToSearch(const std::vector<std::string>& table_ids, const DatesT& dates,
+                  DatePartionedTableFilesSchema& files) = 0;
+
     virtual Status
     FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) = 0;
 
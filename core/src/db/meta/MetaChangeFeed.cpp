@@ -0,0 +1,161 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/meta/MetaChangeFeed.h"
+#include "db/Utils.h"
+#include "utils/StringHelpFunctions.h"
+
+#include <sstream>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+namespace {
+
+// readonly nodes poll several times a second, a few thousand changes cover a long pause of them
+constexpr size_t MAX_KEPT_CHANGES = 4096;
+
+template <typename T>
+std::string
+JoinList(const std::vector<T>& list) {
+    if (list.empty()) {
+        return "-";
+    }
+
+    std::stringstream ss;
+    for (size_t i = 0; i < list.size(); ++i) {
+        ss << (i == 0 ? "" : ",") << list[i];
+    }
+    return ss.str();
+}
+
+std::vector<std::string>
+SplitList(const std::string& text) {
+    std::vector<std::string> list;
+    if (text != "-") {
+        server::StringHelpFunctions::SplitStringByDelimeter(text, ",", list);
+    }
+    return list;
+}
+
+}  // namespace
+
+MetaChangeFeed::MetaChangeFeed() : epoch_(utils::GetMicroSecTimeStamp()) {
+}
+
+MetaChangeFeed&
+MetaChangeFeed::GetInstance() {
+    static MetaChangeFeed feed;
+    return feed;
+}
+
+void
+MetaChangeFeed::Publish(const std::string& table_id, std::vector<size_t> added, std::vector<std::string> removed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MetaChange change;
+    change.version_ = ++version_;
+    change.table_id_ = table_id;
+    change.added_ = std::move(added);
+    change.removed_ = std::move(removed);
+    changes_.emplace_back(std::move(change));
+    while (changes_.size() > MAX_KEPT_CHANGES) {
+        changes_.pop_front();
+    }
+}
+
+uint64_t
+MetaChangeFeed::Epoch() const {
+    return epoch_;
+}
+
+uint64_t
+MetaChangeFeed::Version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+bool
+MetaChangeFeed::ChangesSince(uint64_t epoch, uint64_t version, std::vector<MetaChange>& changes) const {
+    changes.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (epoch != epoch_ || version > version_) {
+        return false;
+    }
+
+    // versions are consecutive, the first kept one tells whether any change after the version is gone
+    if (version < version_ && (changes_.empty() || changes_.front().version_ > version + 1)) {
+        return false;
+    }
+
+    for (auto& change : changes_) {
+        if (change.version_ > version) {
+            changes.push_back(change);
+        }
+    }
+    return true;
+}
+
+std::string
+MetaChangeFeed::Encode(uint64_t epoch, uint64_t version, bool complete, const std::vector<MetaChange>& changes) {
+    std::stringstream ss;
+    ss << epoch << " " << version << " " << (complete ? 1 : 0) << "\n";
+    for (auto& change : changes) {
+        ss << (change.table_id_.empty() ? "*" : change.table_id_) << " " << JoinList(change.added_) << " "
+           << JoinList(change.removed_) << "\n";
+    }
+    return ss.str();
+}
+
+bool
+MetaChangeFeed::Decode(const std::string& text, uint64_t& epoch, uint64_t& version, bool& complete,
+                       std::vector<MetaChange>& changes) {
+    changes.clear();
+    std::stringstream ss(text);
+    std::string line;
+    std::vector<std::string> fields;
+    if (!std::getline(ss, line)) {
+        return false;
+    }
+    server::StringHelpFunctions::SplitStringByDelimeter(line, " ", fields);
+    if (fields.size() != 3) {
+        return false;
+    }
+
+    try {
+        epoch = std::stoull(fields[0]);
+        version = std::stoull(fields[1]);
+        complete = (fields[2] != "0");
+        while (std::getline(ss, line)) {
+            fields.clear();
+            server::StringHelpFunctions::SplitStringByDelimeter(line, " ", fields);
+            if (fields.size() != 3) {
+                return false;
+            }
+
+            MetaChange change;
+            change.table_id_ = (fields[0] == "*") ? "" : fields[0];
+            for (auto& id : SplitList(fields[1])) {
+                change.added_.push_back(std::stoul(id));
+            }
+            change.removed_ = SplitList(fields[2]);
+            changes.emplace_back(std::move(change));
+        }
+    } catch (std::exception& e) {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
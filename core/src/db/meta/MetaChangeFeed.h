@@ -0,0 +1,80 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+// a write to meta seen by the writable node
+struct MetaChange {
+    uint64_t version_ = 0;
+    // empty if every table may have changed
+    std::string table_id_;
+    // ids of files that became searchable
+    std::vector<size_t> added_;
+    // locations of files no longer searched
+    std::vector<std::string> removed_;
+};
+
+/*
+ * Writes to meta of the writable node are numbered and kept for a while, readonly nodes sharing the meta fetch the
+ * changes after the version they have seen instead of finding them by polling meta; The epoch changes when the
+ * writable node restarts, changes of another epoch or dropped ones can't be followed, everything is reloaded then;
+ */
+class MetaChangeFeed {
+ public:
+    static MetaChangeFeed&
+    GetInstance();
+
+    void
+    Publish(const std::string& table_id, std::vector<size_t> added, std::vector<std::string> removed);
+
+    uint64_t
+    Epoch() const;
+
+    uint64_t
+    Version() const;
+
+    // changes after the version of the epoch, false if some of them are gone
+    bool
+    ChangesSince(uint64_t epoch, uint64_t version, std::vector<MetaChange>& changes) const;
+
+    // text sent to readonly nodes: "epoch version complete" then a line "table_id added removed" per change,
+    // "*" stands for every table and "-" for nothing
+    static std::string
+    Encode(uint64_t epoch, uint64_t version, bool complete, const std::vector<MetaChange>& changes);
+
+    static bool
+    Decode(const std::string& text, uint64_t& epoch, uint64_t& version, bool& complete,
+           std::vector<MetaChange>& changes);
+
+ private:
+    MetaChangeFeed();
+
+ private:
+    uint64_t epoch_ = 0;
+
+    mutable std::mutex mutex_;
+    uint64_t version_ = 0;
+    std::deque<MetaChange> changes_;
+};  // MetaChangeFeed
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -10,7 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/meta/MetaFactory.h"
+#include "KVMetaImpl.h"
 #include "MySQLMetaImpl.h"
+#include "SnapshotMetaImpl.h"
 #include "SqliteMetaImpl.h"
 #include "db/Utils.h"
 #include "utils/Exception.h"
@@ -56,13 +58,19 @@ MetaFactory::Build(const DBMetaOptions& metaOptions, const int& mode) {
 
     if (strcasecmp(uri_info.dialect_.c_str(), "mysql") == 0) {
         ENGINE_LOG_INFO << "Using MySQL";
-        return std::make_shared<meta::MySQLMetaImpl>(metaOptions, mode);
+        auto meta = std::make_shared<meta::MySQLMetaImpl>(metaOptions, mode);
+        return std::make_shared<meta::SnapshotMetaImpl>(meta, mode);
     } else if (strcasecmp(uri_info.dialect_.c_str(), "sqlite") == 0) {
         ENGINE_LOG_INFO << "Using SQLite";
-        return std::make_shared<meta::SqliteMetaImpl>(metaOptions);
+        auto meta = std::make_shared<meta::SqliteMetaImpl>(metaOptions);
+        return std::make_shared<meta::SnapshotMetaImpl>(meta, mode);
+    } else if (strcasecmp(uri_info.dialect_.c_str(), "kv") == 0) {
+        ENGINE_LOG_INFO << "Using embedded key-value meta";
+        auto meta = std::make_shared<meta::KVMetaImpl>(metaOptions);
+        return std::make_shared<meta::SnapshotMetaImpl>(meta, mode);
     } else {
         ENGINE_LOG_ERROR << "Invalid dialect in URI: dialect = " << uri_info.dialect_;
-        throw InvalidArgumentException("URI dialect is not mysql / sqlite");
+        throw InvalidArgumentException("URI dialect is not mysql / sqlite / kv");
     }
 }
 
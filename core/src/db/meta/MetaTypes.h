@@ -32,6 +32,7 @@ constexpr char CURRENT_VERSION[] = MILVUS_VERSION;
 
 constexpr int64_t FLAG_MASK_NO_USERID = 0x1;
 constexpr int64_t FLAG_MASK_HAS_USERID = 0x1 << 1;
+constexpr int64_t FLAG_MASK_INDEX_PENDING = 0x1 << 2;  // index creation not finished yet
 
 using DateT = int;
 const DateT EmptyDate = -1;
@@ -68,6 +69,7 @@ struct TableFileSchema {
         NEW_MERGE,
         NEW_INDEX,
         BACKUP,
+        ARCHIVE,  // a segment past the archive days kept as pq codes only, see DBImpl::CompressArchiveFiles
     } FILE_TYPE;
 
     size_t id_ = 0;
@@ -23,24 +23,40 @@ namespace meta {
 // we keep our own count; ConnectionPool::size() isn't the same!
 mysqlpp::Connection*
 MySQLConnectionPool::grab() {
-    while (conns_in_use_ > max_pool_size_) {
-        sleep(1);
+    {
+        // woken up by the release of a connection instead of polling every second
+        std::unique_lock<std::mutex> lock(conns_mutex_);
+        conns_released_.wait(lock, [&] { return conns_in_use_ < max_pool_size_; });
+        ++conns_in_use_;
     }
 
-    ++conns_in_use_;
-    return mysqlpp::ConnectionPool::grab();
+    try {
+        return mysqlpp::ConnectionPool::grab();
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(conns_mutex_);
+            --conns_in_use_;
+        }
+        conns_released_.notify_one();
+        throw;
+    }
 }
 
 // Other half of in-use conn count limit
 void
 MySQLConnectionPool::release(const mysqlpp::Connection* pc) {
     mysqlpp::ConnectionPool::release(pc);
-    if (conns_in_use_ <= 0) {
-        ENGINE_LOG_WARNING << "MySQLConnetionPool::release: conns_in_use_ is less than zero.  conns_in_use_ = "
-                           << conns_in_use_;
-    } else {
+
+    {
+        std::lock_guard<std::mutex> lock(conns_mutex_);
+        if (conns_in_use_ <= 0) {
+            ENGINE_LOG_WARNING << "MySQLConnetionPool::release: conns_in_use_ is less than zero.  conns_in_use_ = "
+                               << conns_in_use_;
+            return;
+        }
         --conns_in_use_;
     }
+    conns_released_.notify_one();
 }
 
 //    int MySQLConnectionPool::getConnectionsInUse() {
@@ -12,7 +12,8 @@
 #include <mysql++/mysql++.h>
 
 #include <unistd.h>
-#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 
 #include "utils/Log.h"
@@ -33,7 +34,8 @@ class MySQLConnectionPool : public mysqlpp::ConnectionPool {
           port_(port),
           max_pool_size_(maxPoolSize) {
         conns_in_use_ = 0;
-        max_idle_time_ = 10;  // 10 seconds
+        // connections of busy nodes are reused instead of being reconnected after a short idle gap
+        max_idle_time_ = 60;  // 60 seconds
     }
 
     // The destructor.  We _must_ call ConnectionPool::clear() here,
@@ -69,7 +71,9 @@ class MySQLConnectionPool : public mysqlpp::ConnectionPool {
 
  private:
     // Number of connections currently in use
-    std::atomic<int> conns_in_use_;
+    int conns_in_use_;
+    std::mutex conns_mutex_;
+    std::condition_variable conns_released_;
 
     // Our connection parameters
     std::string db_, user_, password_, server_;
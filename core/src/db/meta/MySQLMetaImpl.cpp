@@ -24,6 +24,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
@@ -162,6 +163,33 @@ static const MetaSchema TABLEFILES_SCHEMA(META_TABLEFILES, {
                                                                MetaField("date", "INT", "DEFAULT -1 NOT NULL"),
                                                            });
 
+const char* TABLEFILES_TABLE_ID_INDEX = "idx_table_files_table_id";
+
+// statements of the calls made for every search and every flushed file, they are built once and parsed into
+// template queries, the params are quoted by mysql++
+const std::string SEARCHABLE_FILE_TYPES = std::to_string(TableFileSchema::RAW) + ", " +
+                                          std::to_string(TableFileSchema::TO_INDEX) + ", " +
+                                          std::to_string(TableFileSchema::INDEX) + ", " +
+                                          std::to_string(TableFileSchema::ARCHIVE);
+
+const std::string TABLE_STATE_STATEMENT = std::string("SELECT state FROM ") + META_TABLES + " WHERE table_id = %0q;";
+
+const std::string UPDATE_TABLE_FILE_STATEMENT =
+    std::string("UPDATE ") + META_TABLEFILES +
+    " SET table_id = %0q, engine_type = %1, file_id = %2q, file_type = %3, file_size = %4, row_count = %5,"
+    " updated_time = %6, created_on = %7, date = %8 WHERE id = %9;";
+
+const std::string COUNT_STATEMENT = std::string("SELECT COALESCE(SUM(row_count), 0) AS total FROM ") +
+                                    META_TABLEFILES + " WHERE table_id = %0q AND file_type IN (" +
+                                    SEARCHABLE_FILE_TYPES + ");";
+
+// the table is joined to save a DescribeTable, it is described only if no file is found
+const std::string FILES_TO_SEARCH_STATEMENT =
+    std::string("SELECT f.id, f.table_id, f.engine_type, f.file_id, f.file_type, f.file_size, f.row_count, f.date,") +
+    " t.dimension, t.index_file_size, t.nlist, t.metric_type FROM " + META_TABLEFILES + " f JOIN " + META_TABLES +
+    " t ON f.table_id = t.table_id WHERE f.table_id = %0q AND t.state <> " + std::to_string(TableSchema::TO_DELETE) +
+    " AND f.file_type IN (" + SEARCHABLE_FILE_TYPES + ")";
+
 }  // namespace
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -273,8 +301,10 @@ MySQLMetaImpl::Initialize() {
     }
 
     // step 3: connect mysql
+    // meta is called by search, build and flush threads at once, a pool of few connections queues them up on
+    // small machines
     int thread_hint = std::thread::hardware_concurrency();
-    int max_pool_size = (thread_hint == 0) ? 8 : thread_hint;
+    int max_pool_size = std::max(thread_hint, 8);
     unsigned int port = 0;
     if (!uri_info.port_.empty()) {
         port = std::stoi(uri_info.port_);
@@ -339,6 +369,23 @@ MySQLMetaImpl::Initialize() {
         throw Exception(DB_META_TRANSACTION_FAILED, msg);
     }
 
+    // step 9: index files by table, they are looked up for every search, mysql has no 'IF NOT EXISTS' for it
+    // searches still work without it, only slower
+    try {
+        InitializeQuery << "SHOW INDEX FROM " << TABLEFILES_SCHEMA.name() << " WHERE Key_name = " << mysqlpp::quote
+                        << TABLEFILES_TABLE_ID_INDEX << ";";
+        if (InitializeQuery.store().num_rows() == 0) {
+            InitializeQuery << "CREATE INDEX " << TABLEFILES_TABLE_ID_INDEX << " ON " << TABLEFILES_SCHEMA.name()
+                            << " (table_id, file_type);";
+
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::Initialize: " << InitializeQuery.str();
+
+            InitializeQuery.exec();
+        }
+    } catch (std::exception& e) {
+        ENGINE_LOG_WARNING << "Failed to create index of meta table 'TableFiles' in MySQL: " << e.what();
+    }
+
     return Status::OK();
 }
 
@@ -941,16 +988,14 @@ MySQLMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
                 return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
             }
 
-            mysqlpp::Query updateTableFileQuery = connectionPtr->query();
-
             // if the table has been deleted, just mark the table file as TO_DELETE
             // clean thread will delete the file later
-            updateTableFileQuery << "SELECT state FROM " << META_TABLES << " WHERE table_id = " << mysqlpp::quote
-                                 << file_schema.table_id_ << ";";
+            mysqlpp::Query tableStateQuery = connectionPtr->query(TABLE_STATE_STATEMENT);
+            tableStateQuery.parse();
 
-            ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFile: " << updateTableFileQuery.str();
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFile: " << tableStateQuery.str(file_schema.table_id_);
 
-            mysqlpp::StoreQueryResult res = updateTableFileQuery.store();
+            mysqlpp::StoreQueryResult res = tableStateQuery.store(file_schema.table_id_);
 
             if (res.num_rows() == 1) {
                 int state = res[0]["state"];
@@ -961,27 +1006,19 @@ MySQLMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
                 file_schema.file_type_ = TableFileSchema::TO_DELETE;
             }
 
-            std::string id = std::to_string(file_schema.id_);
-            std::string table_id = file_schema.table_id_;
-            std::string engine_type = std::to_string(file_schema.engine_type_);
-            std::string file_id = file_schema.file_id_;
-            std::string file_type = std::to_string(file_schema.file_type_);
-            std::string file_size = std::to_string(file_schema.file_size_);
-            std::string row_count = std::to_string(file_schema.row_count_);
-            std::string updated_time = std::to_string(file_schema.updated_time_);
-            std::string created_on = std::to_string(file_schema.created_on_);
-            std::string date = std::to_string(file_schema.date_);
+            mysqlpp::Query updateTableFileQuery = connectionPtr->query(UPDATE_TABLE_FILE_STATEMENT);
+            updateTableFileQuery.parse();
 
-            updateTableFileQuery << "UPDATE " << META_TABLEFILES << " SET table_id = " << mysqlpp::quote << table_id
-                                 << " ,engine_type = " << engine_type << " ,file_id = " << mysqlpp::quote << file_id
-                                 << " ,file_type = " << file_type << " ,file_size = " << file_size
-                                 << " ,row_count = " << row_count << " ,updated_time = " << updated_time
-                                 << " ,created_on = " << created_on << " ,date = " << date << " WHERE id = " << id
-                                 << ";";
+            mysqlpp::SQLQueryParms params(&updateTableFileQuery);
+            params << file_schema.table_id_ << std::to_string(file_schema.engine_type_) << file_schema.file_id_
+                   << std::to_string(file_schema.file_type_) << std::to_string(file_schema.file_size_)
+                   << std::to_string(file_schema.row_count_) << std::to_string(file_schema.updated_time_)
+                   << std::to_string(file_schema.created_on_) << std::to_string(file_schema.date_)
+                   << std::to_string(file_schema.id_);
 
-            ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFile: " << updateTableFileQuery.str();
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFile: " << updateTableFileQuery.str(params);
 
-            if (!updateTableFileQuery.exec()) {
+            if (!updateTableFileQuery.execute(params)) {
                 ENGINE_LOG_DEBUG << "table_id= " << file_schema.table_id_ << " file_id=" << file_schema.file_id_;
                 return HandleException("QUERY ERROR WHEN UPDATING TABLE FILE", updateTableFileQuery.error());
             }
@@ -1282,9 +1319,13 @@ MySQLMetaImpl::ShowPartitions(const std::string& table_id, std::vector<meta::Tab
                 return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
             }
 
+            // all partitions are described in one query, a table may have thousands of them
             mysqlpp::Query allPartitionsQuery = connectionPtr->query();
-            allPartitionsQuery << "SELECT table_id FROM " << META_TABLES << " WHERE owner_table = " << mysqlpp::quote
-                               << table_id << " AND state <> " << std::to_string(TableSchema::TO_DELETE) << ";";
+            allPartitionsQuery
+                << "SELECT id, table_id, state, dimension, created_on, flag, index_file_size, engine_type, nlist"
+                << " ,metric_type, owner_table, partition_tag, version FROM " << META_TABLES
+                << " WHERE owner_table = " << mysqlpp::quote << table_id
+                << " AND state <> " << std::to_string(TableSchema::TO_DELETE) << ";";
 
             ENGINE_LOG_DEBUG << "MySQLMetaImpl::AllTables: " << allPartitionsQuery.str();
 
@@ -1293,8 +1334,19 @@ MySQLMetaImpl::ShowPartitions(const std::string& table_id, std::vector<meta::Tab
 
         for (auto& resRow : res) {
             meta::TableSchema partition_schema;
+            partition_schema.id_ = resRow["id"];  // implicit conversion
             resRow["table_id"].to_string(partition_schema.table_id_);
-            DescribeTable(partition_schema);
+            partition_schema.state_ = resRow["state"];
+            partition_schema.dimension_ = resRow["dimension"];
+            partition_schema.created_on_ = resRow["created_on"];
+            partition_schema.flag_ = resRow["flag"];
+            partition_schema.index_file_size_ = resRow["index_file_size"];
+            partition_schema.engine_type_ = resRow["engine_type"];
+            partition_schema.nlist_ = resRow["nlist"];
+            partition_schema.metric_type_ = resRow["metric_type"];
+            resRow["owner_table"].to_string(partition_schema.owner_table_);
+            resRow["partition_tag"].to_string(partition_schema.partition_tag_);
+            resRow["version"].to_string(partition_schema.version_);
             partition_schema_array.emplace_back(partition_schema);
         }
     } catch (std::exception& e) {
@@ -1366,47 +1418,37 @@ MySQLMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size
                 return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
             }
 
-            mysqlpp::Query filesToSearchQuery = connectionPtr->query();
-            filesToSearchQuery << "SELECT id, table_id, engine_type, file_id, file_type, file_size, row_count, date"
-                               << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << table_id;
-
+            std::string statement = FILES_TO_SEARCH_STATEMENT;
             if (!dates.empty()) {
-                std::stringstream partitionListSS;
+                std::string dateList;
                 for (auto& date : dates) {
-                    partitionListSS << std::to_string(date) << ", ";
+                    dateList += (dateList.empty() ? "" : ", ") + std::to_string(date);
                 }
-                std::string partitionListStr = partitionListSS.str();
-
-                partitionListStr = partitionListStr.substr(0, partitionListStr.size() - 2);  // remove the last ", "
-                filesToSearchQuery << " AND date IN (" << partitionListStr << ")";
+                statement += " AND f.date IN (" + dateList + ")";
             }
 
             if (!ids.empty()) {
-                std::stringstream idSS;
+                std::string idList;
                 for (auto& id : ids) {
-                    idSS << "id = " << std::to_string(id) << " OR ";
+                    idList += (idList.empty() ? "" : ", ") + std::to_string(id);
                 }
-                std::string idStr = idSS.str();
-                idStr = idStr.substr(0, idStr.size() - 4);  // remove the last " OR "
-
-                filesToSearchQuery << " AND (" << idStr << ")";
+                statement += " AND f.id IN (" + idList + ")";
             }
-            // End
-            filesToSearchQuery << " AND"
-                               << " (file_type = " << std::to_string(TableFileSchema::RAW)
-                               << " OR file_type = " << std::to_string(TableFileSchema::TO_INDEX)
-                               << " OR file_type = " << std::to_string(TableFileSchema::INDEX) << ");";
+            statement += ";";
 
-            ENGINE_LOG_DEBUG << "MySQLMetaImpl::FilesToSearch: " << filesToSearchQuery.str();
+            mysqlpp::Query filesToSearchQuery = connectionPtr->query(statement);
+            filesToSearchQuery.parse();
 
-            res = filesToSearchQuery.store();
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::FilesToSearch: " << filesToSearchQuery.str(table_id);
+
+            res = filesToSearchQuery.store(table_id);
         }  // Scoped Connection
 
-        TableSchema table_schema;
-        table_schema.table_id_ = table_id;
-        auto status = DescribeTable(table_schema);
-        if (!status.ok()) {
-            return status;
+        if (res.num_rows() == 0) {
+            // tell an empty table from one not found
+            TableSchema table_schema;
+            table_schema.table_id_ = table_id;
+            return DescribeTable(table_schema);
         }
 
         Status ret;
@@ -1414,16 +1456,16 @@ MySQLMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size
         for (auto& resRow : res) {
             table_file.id_ = resRow["id"];  // implicit conversion
             resRow["table_id"].to_string(table_file.table_id_);
-            table_file.index_file_size_ = table_schema.index_file_size_;
+            table_file.index_file_size_ = resRow["index_file_size"];
             table_file.engine_type_ = resRow["engine_type"];
-            table_file.nlist_ = table_schema.nlist_;
-            table_file.metric_type_ = table_schema.metric_type_;
+            table_file.nlist_ = resRow["nlist"];
+            table_file.metric_type_ = resRow["metric_type"];
             resRow["file_id"].to_string(table_file.file_id_);
             table_file.file_type_ = resRow["file_type"];
             table_file.file_size_ = resRow["file_size"];
             table_file.row_count_ = resRow["row_count"];
             table_file.date_ = resRow["date"];
-            table_file.dimension_ = table_schema.dimension_;
+            table_file.dimension_ = resRow["dimension"];
 
             auto status = utils::GetTableFilePath(options_, table_file);
             if (!status.ok()) {
@@ -1447,6 +1489,96 @@ MySQLMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size
     }
 }
 
+Status
+MySQLMetaImpl::FilesToSearch(const std::vector<std::string>& table_ids, const DatesT& dates,
+                             DatePartionedTableFilesSchema& files) {
+    files.clear();
+    if (table_ids.empty()) {
+        return Status::OK();
+    }
+
+    try {
+        server::MetricCollector metric;
+        mysqlpp::StoreQueryResult res;
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.FilesToSearch.null_connection", is_null_connection = true);
+            fiu_do_on("MySQLMetaImpl.FilesToSearch.throw_exception", throw std::exception(););
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            // files of all the tables are fetched by one query on the table_id index, instead of one per table
+            mysqlpp::Query filesToSearchQuery = connectionPtr->query();
+            filesToSearchQuery
+                << "SELECT f.id, f.table_id, f.engine_type, f.file_id, f.file_type, f.file_size, f.row_count, f.date,"
+                << " t.dimension, t.index_file_size, t.nlist, t.metric_type FROM " << META_TABLEFILES << " f JOIN "
+                << META_TABLES << " t ON f.table_id = t.table_id WHERE f.table_id IN (";
+            for (size_t i = 0; i < table_ids.size(); ++i) {
+                filesToSearchQuery << (i == 0 ? "" : ", ") << mysqlpp::quote << table_ids[i];
+            }
+            filesToSearchQuery << ") AND t.state <> " << std::to_string(TableSchema::TO_DELETE)
+                               << " AND f.file_type IN (" << SEARCHABLE_FILE_TYPES << ")";
+
+            if (!dates.empty()) {
+                std::string dateList;
+                for (auto& date : dates) {
+                    dateList += (dateList.empty() ? "" : ", ") + std::to_string(date);
+                }
+                filesToSearchQuery << " AND f.date IN (" << dateList << ")";
+            }
+            filesToSearchQuery << ";";
+
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::FilesToSearch: " << filesToSearchQuery.str();
+
+            res = filesToSearchQuery.store();
+        }  // Scoped Connection
+
+        if (res.num_rows() == 0) {
+            // tell tables without files from tables not found
+            for (auto& table_id : table_ids) {
+                bool has_table = false;
+                auto status = HasTable(table_id, has_table);
+                if (!status.ok() || has_table) {
+                    return status;
+                }
+            }
+            return Status(DB_NOT_FOUND, "Table " + table_ids.front() + " not found");
+        }
+
+        Status ret;
+        TableFileSchema table_file;
+        for (auto& resRow : res) {
+            table_file.id_ = resRow["id"];  // implicit conversion
+            resRow["table_id"].to_string(table_file.table_id_);
+            table_file.index_file_size_ = resRow["index_file_size"];
+            table_file.engine_type_ = resRow["engine_type"];
+            table_file.nlist_ = resRow["nlist"];
+            table_file.metric_type_ = resRow["metric_type"];
+            resRow["file_id"].to_string(table_file.file_id_);
+            table_file.file_type_ = resRow["file_type"];
+            table_file.file_size_ = resRow["file_size"];
+            table_file.row_count_ = resRow["row_count"];
+            table_file.date_ = resRow["date"];
+            table_file.dimension_ = resRow["dimension"];
+
+            auto status = utils::GetTableFilePath(options_, table_file);
+            if (!status.ok()) {
+                ret = status;
+            }
+
+            files[table_file.date_].push_back(table_file);
+        }
+
+        ENGINE_LOG_DEBUG << "Collect " << res.size() << " to-search files of " << table_ids.size() << " tables";
+        return ret;
+    } catch (std::exception& e) {
+        return HandleException("GENERAL ERROR WHEN FINDING TABLE FILES TO SEARCH", e.what());
+    }
+}
+
 Status
 MySQLMetaImpl::FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) {
     files.clear();
@@ -1737,7 +1869,9 @@ MySQLMetaImpl::Archive() {
     for (auto& kv : criterias) {
         auto& criteria = kv.first;
         auto& limit = kv.second;
-        if (criteria == engine::ARCHIVE_CONF_DAYS) {
+        // files past the days are compressed by the db instead when the archive type is compress
+        bool compress = (options_.archive_conf_.GetType() == engine::ARCHIVE_TYPE_COMPRESS);
+        if (criteria == engine::ARCHIVE_CONF_DAYS && !compress) {
             size_t usecs = limit * DAY * US_PS;
             int64_t now = utils::GetMicroSecTimeStamp();
 
@@ -1886,7 +2020,7 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
             }
 
             mysqlpp::Query query = connectionPtr->query();
-            query << "SELECT id, table_id, file_id, file_type, date"
+            query << "SELECT id, table_id, file_id, file_type, date, updated_time"
                   << " FROM " << META_TABLEFILES << " WHERE file_type IN ("
                   << std::to_string(TableFileSchema::TO_DELETE) << "," << std::to_string(TableFileSchema::BACKUP) << ")"
                   << " AND updated_time < " << std::to_string(now - seconds * US_PS) << ";";
@@ -1896,7 +2030,7 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
             mysqlpp::StoreQueryResult res = query.store();
 
             TableFileSchema table_file;
-            std::vector<std::string> idsToDelete;
+            TableFilesSchema files_to_delete;
 
             int64_t clean_files = 0;
             for (auto& resRow : res) {
@@ -1905,6 +2039,7 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
                 resRow["file_id"].to_string(table_file.file_id_);
                 table_file.date_ = resRow["date"];
                 table_file.file_type_ = resRow["file_type"];
+                table_file.updated_time_ = resRow["updated_time"];
 
                 // check if the file can be deleted
                 if (filter && filter->IsIgnored(table_file)) {
@@ -1919,33 +2054,37 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
                 server::CommonUtil::EraseFromCache(table_file.location_);
 
                 if (table_file.file_type_ == (int)TableFileSchema::TO_DELETE) {
-                    // delete file from disk storage
-                    utils::DeleteTableFilePath(options_, table_file);
-                    ENGINE_LOG_DEBUG << "Remove file id:" << table_file.id_ << " location:" << table_file.location_;
-
-                    idsToDelete.emplace_back(std::to_string(table_file.id_));
-                    table_ids.insert(table_file.table_id_);
-
-                    ++clean_files;
+                    files_to_delete.push_back(table_file);
                 }
             }
 
-            // delete file from meta
-            if (!idsToDelete.empty()) {
+            // files are deleted from disk storage a batch at once, then their rows by one statement per batch,
+            // a single statement of all rows grows too large for a dropped table of thousands of files
+            const size_t batch_size = 1000;
+            for (size_t i = 0; i < files_to_delete.size(); i += batch_size) {
+                auto batch_end = std::min(i + batch_size, files_to_delete.size());
+                TableFilesSchema batch_files(files_to_delete.begin() + i, files_to_delete.begin() + batch_end);
+                utils::DeleteTableFilePaths(options_, batch_files);
+
                 std::stringstream idsToDeleteSS;
-                for (auto& id : idsToDelete) {
-                    idsToDeleteSS << "id = " << id << " OR ";
+                for (auto& file : batch_files) {
+                    ENGINE_LOG_DEBUG << "Remove file id:" << file.id_ << " location:" << file.location_;
+                    table_ids.insert(file.table_id_);
+                    if (idsToDeleteSS.tellp() > 0) {
+                        idsToDeleteSS << ",";
+                    }
+                    idsToDeleteSS << file.id_;
                 }
 
-                std::string idsToDeleteStr = idsToDeleteSS.str();
-                idsToDeleteStr = idsToDeleteStr.substr(0, idsToDeleteStr.size() - 4);  // remove the last " OR "
-                query << "DELETE FROM " << META_TABLEFILES << " WHERE " << idsToDeleteStr << ";";
+                // delete file from meta
+                query << "DELETE FROM " << META_TABLEFILES << " WHERE id IN (" << idsToDeleteSS.str() << ");";
 
                 ENGINE_LOG_DEBUG << "MySQLMetaImpl::CleanUpFilesWithTTL: " << query.str();
 
                 if (!query.exec()) {
                     return HandleException("QUERY ERROR WHEN CLEANING UP FILES WITH TTL", query.error());
                 }
+                clean_files += batch_files.size();
             }
 
             if (clean_files > 0) {
@@ -2028,6 +2167,10 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
             }
 
             for (auto& table_id : table_ids) {
+                // merges of the table still write into the folder, it is removed by a later clean up
+                if (filter && filter->IsTableIgnored(table_id)) {
+                    continue;
+                }
                 mysqlpp::Query query = connectionPtr->query();
                 query << "SELECT file_id"
                       << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << table_id << ";";
@@ -2076,22 +2219,18 @@ MySQLMetaImpl::Count(const std::string& table_id, uint64_t& result) {
                 return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
             }
 
-            mysqlpp::Query countQuery = connectionPtr->query();
-            countQuery << "SELECT row_count"
-                       << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << table_id
-                       << " AND (file_type = " << std::to_string(TableFileSchema::RAW)
-                       << " OR file_type = " << std::to_string(TableFileSchema::TO_INDEX)
-                       << " OR file_type = " << std::to_string(TableFileSchema::INDEX) << ");";
+            // rows are summed by the server instead of sending the row count of every file
+            mysqlpp::Query countQuery = connectionPtr->query(COUNT_STATEMENT);
+            countQuery.parse();
 
-            ENGINE_LOG_DEBUG << "MySQLMetaImpl::Count: " << countQuery.str();
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::Count: " << countQuery.str(table_id);
 
-            res = countQuery.store();
+            res = countQuery.store(table_id);
         }  // Scoped Connection
 
         result = 0;
-        for (auto& resRow : res) {
-            size_t size = resRow["row_count"];
-            result += size;
+        if (res.num_rows() == 1) {
+            result = res[0]["total"];
         }
     } catch (std::exception& e) {
         return HandleException("GENERAL ERROR WHEN RETRIEVING COUNT", e.what());
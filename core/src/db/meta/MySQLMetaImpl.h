@@ -94,6 +94,10 @@ class MySQLMetaImpl : public Meta {
     FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
                   DatePartionedTableFilesSchema& files) override;
 
+    Status
+    FilesToSearch(const std::vector<std::string>& table_ids, const DatesT& dates,
+                  DatePartionedTableFilesSchema& files) override;
+
     Status
     FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) override;
 
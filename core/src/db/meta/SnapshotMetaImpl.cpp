@@ -0,0 +1,398 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/meta/SnapshotMetaImpl.h"
+#include "db/Options.h"
+#include "db/meta/MetaChangeFeed.h"
+#include "utils/Log.h"
+
+#include <fiu-local.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+namespace {
+// files of readonly nodes are flushed and merged by the writable one, it runs at a similar pace
+constexpr std::chrono::milliseconds READONLY_SNAPSHOT_TTL(1000);
+}  // namespace
+
+SnapshotMetaImpl::SnapshotMetaImpl(MetaPtr meta, const int& mode)
+    : meta_(std::move(meta)),
+      ttl_(mode == DBOptions::MODE::CLUSTER_READONLY ? READONLY_SNAPSHOT_TTL : std::chrono::milliseconds(0)),
+      publish_changes_(mode == DBOptions::MODE::CLUSTER_WRITABLE) {
+}
+
+void
+SnapshotMetaImpl::Refresh(const std::string& table_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (table_id.empty()) {
+        snapshots_.clear();
+        ++global_version_;
+    } else {
+        snapshots_.erase(table_id);
+        ++versions_[table_id];
+    }
+}
+
+void
+SnapshotMetaImpl::Invalidate(const std::string& table_id) {
+    Refresh(table_id);
+    if (publish_changes_) {
+        MetaChangeFeed::GetInstance().Publish(table_id, {}, {});
+    }
+}
+
+void
+SnapshotMetaImpl::InvalidateAll() {
+    Refresh("");
+    if (publish_changes_) {
+        MetaChangeFeed::GetInstance().Publish("", {}, {});
+    }
+}
+
+void
+SnapshotMetaImpl::InvalidateFiles(const TableFilesSchema& files) {
+    std::map<std::string, std::pair<std::vector<size_t>, std::vector<std::string>>> table_changes;
+    for (auto& file : files) {
+        auto& change = table_changes[file.table_id_];
+        if (file.file_type_ == TableFileSchema::RAW || file.file_type_ == TableFileSchema::TO_INDEX ||
+            file.file_type_ == TableFileSchema::INDEX || file.file_type_ == TableFileSchema::ARCHIVE) {
+            change.first.push_back(file.id_);
+        } else if ((file.file_type_ == TableFileSchema::TO_DELETE || file.file_type_ == TableFileSchema::BACKUP) &&
+                   !file.location_.empty()) {
+            change.second.push_back(file.location_);
+        }
+    }
+
+    for (auto& change : table_changes) {
+        Refresh(change.first);
+        if (publish_changes_) {
+            MetaChangeFeed::GetInstance().Publish(change.first, std::move(change.second.first),
+                                                  std::move(change.second.second));
+        }
+    }
+}
+
+Status
+SnapshotMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
+                                DatePartionedTableFilesSchema& files) {
+    std::shared_ptr<const TableFilesSchema> table_files;
+    uint64_t version = 0, global_version = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto iter = snapshots_.find(table_id);
+        fiu_do_on("SnapshotMetaImpl.FilesToSearch.skip_snapshot", iter = snapshots_.end());
+        if (iter != snapshots_.end() &&
+            (ttl_.count() == 0 || Clock::now() - iter->second.load_time_ < ttl_)) {
+            table_files = iter->second.files_;
+        } else {
+            auto version_iter = versions_.find(table_id);
+            version = (version_iter != versions_.end()) ? version_iter->second : 0;
+            global_version = global_version_;
+        }
+    }
+
+    if (table_files == nullptr) {
+        DatePartionedTableFilesSchema all_files;
+        auto load_time = Clock::now();
+        auto status = meta_->FilesToSearch(table_id, std::vector<size_t>(), DatesT(), all_files);
+        if (!status.ok()) {
+            // e.g. a file isn't found on disk, it is searched again the next time
+            files.clear();
+            return meta_->FilesToSearch(table_id, ids, dates, files);
+        }
+
+        auto loaded = std::make_shared<TableFilesSchema>();
+        for (auto& date_files : all_files) {
+            loaded->insert(loaded->end(), date_files.second.begin(), date_files.second.end());
+        }
+        table_files = loaded;
+
+        // a write finished meanwhile may not be seen by the files loaded
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto version_iter = versions_.find(table_id);
+        if (((version_iter != versions_.end()) ? version_iter->second : 0) == version &&
+            global_version_ == global_version) {
+            snapshots_[table_id] = Snapshot{table_files, load_time};
+        }
+    }
+
+    std::set<size_t> id_set(ids.begin(), ids.end());
+    std::set<DateT> date_set(dates.begin(), dates.end());
+    files.clear();
+    for (auto& file : *table_files) {
+        if ((id_set.empty() || id_set.find(file.id_) != id_set.end()) &&
+            (date_set.empty() || date_set.find(file.date_) != date_set.end())) {
+            files[file.date_].push_back(file);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+SnapshotMetaImpl::FilesToSearch(const std::vector<std::string>& table_ids, const DatesT& dates,
+                                DatePartionedTableFilesSchema& files) {
+    std::vector<std::shared_ptr<const TableFilesSchema>> snapshot_files;
+    std::vector<std::string> missed_ids;
+    std::unordered_map<std::string, uint64_t> missed_versions;
+    uint64_t global_version = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (auto& table_id : table_ids) {
+            auto iter = snapshots_.find(table_id);
+            fiu_do_on("SnapshotMetaImpl.FilesToSearch.skip_snapshot", iter = snapshots_.end());
+            if (iter != snapshots_.end() &&
+                (ttl_.count() == 0 || Clock::now() - iter->second.load_time_ < ttl_)) {
+                snapshot_files.push_back(iter->second.files_);
+            } else {
+                auto version_iter = versions_.find(table_id);
+                missed_versions[table_id] = (version_iter != versions_.end()) ? version_iter->second : 0;
+                missed_ids.push_back(table_id);
+            }
+        }
+        global_version = global_version_;
+    }
+
+    files.clear();
+    if (!missed_ids.empty()) {
+        // tables not cached are loaded by one query, then snapshotted one by one
+        DatePartionedTableFilesSchema missed_files;
+        auto load_time = Clock::now();
+        auto status = meta_->FilesToSearch(missed_ids, DatesT(), missed_files);
+        if (!status.ok() && (status.code() != DB_NOT_FOUND || snapshot_files.empty())) {
+            // e.g. a file isn't found on disk, they are searched again the next time
+            return meta_->FilesToSearch(table_ids, dates, files);
+        }
+
+        if (status.ok()) {
+            std::unordered_map<std::string, std::shared_ptr<TableFilesSchema>> loaded;
+            for (auto& date_files : missed_files) {
+                for (auto& file : date_files.second) {
+                    auto& table_files = loaded[file.table_id_];
+                    if (table_files == nullptr) {
+                        table_files = std::make_shared<TableFilesSchema>();
+                    }
+                    table_files->push_back(file);
+                }
+            }
+
+            // tables without files aren't snapshotted, they may not exist
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            for (auto& table_files : loaded) {
+                snapshot_files.push_back(table_files.second);
+                auto version_iter = versions_.find(table_files.first);
+                if (((version_iter != versions_.end()) ? version_iter->second : 0) ==
+                        missed_versions[table_files.first] &&
+                    global_version_ == global_version) {
+                    snapshots_[table_files.first] = Snapshot{table_files.second, load_time};
+                }
+            }
+        }
+    }
+
+    std::set<DateT> date_set(dates.begin(), dates.end());
+    for (auto& table_files : snapshot_files) {
+        for (auto& file : *table_files) {
+            if (date_set.empty() || date_set.find(file.date_) != date_set.end()) {
+                files[file.date_].push_back(file);
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status
+SnapshotMetaImpl::CreateTable(TableSchema& table_schema) {
+    auto status = meta_->CreateTable(table_schema);
+    Invalidate(table_schema.table_id_);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::DescribeTable(TableSchema& table_schema) {
+    return meta_->DescribeTable(table_schema);
+}
+
+Status
+SnapshotMetaImpl::HasTable(const std::string& table_id, bool& has_or_not) {
+    return meta_->HasTable(table_id, has_or_not);
+}
+
+Status
+SnapshotMetaImpl::AllTables(std::vector<TableSchema>& table_schema_array) {
+    return meta_->AllTables(table_schema_array);
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFlag(const std::string& table_id, int64_t flag) {
+    return meta_->UpdateTableFlag(table_id, flag);
+}
+
+Status
+SnapshotMetaImpl::DropTable(const std::string& table_id) {
+    auto status = meta_->DropTable(table_id);
+    Invalidate(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::DeleteTableFiles(const std::string& table_id) {
+    auto status = meta_->DeleteTableFiles(table_id);
+    Invalidate(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::CreateTableFile(TableFileSchema& file_schema) {
+    // new files aren't searched until they are updated
+    return meta_->CreateTableFile(file_schema);
+}
+
+Status
+SnapshotMetaImpl::DropDataByDate(const std::string& table_id, const DatesT& dates) {
+    auto status = meta_->DropDataByDate(table_id, dates);
+    Invalidate(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::GetTableFiles(const std::string& table_id, const std::vector<size_t>& ids,
+                                TableFilesSchema& table_files) {
+    return meta_->GetTableFiles(table_id, ids, table_files);
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
+    auto status = meta_->UpdateTableFile(file_schema);
+    InvalidateFiles({file_schema});
+    return status;
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFiles(TableFilesSchema& files) {
+    auto status = meta_->UpdateTableFiles(files);
+    InvalidateFiles(files);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::UpdateTableIndex(const std::string& table_id, const TableIndex& index) {
+    auto status = meta_->UpdateTableIndex(table_id, index);
+    Invalidate(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFilesToIndex(const std::string& table_id) {
+    auto status = meta_->UpdateTableFilesToIndex(table_id);
+    Invalidate(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::DescribeTableIndex(const std::string& table_id, TableIndex& index) {
+    return meta_->DescribeTableIndex(table_id, index);
+}
+
+Status
+SnapshotMetaImpl::DropTableIndex(const std::string& table_id) {
+    auto status = meta_->DropTableIndex(table_id);
+    Invalidate(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::CreatePartition(const std::string& table_id, const std::string& partition_name,
+                                  const std::string& tag) {
+    auto status = meta_->CreatePartition(table_id, partition_name, tag);
+    InvalidateAll();
+    return status;
+}
+
+Status
+SnapshotMetaImpl::DropPartition(const std::string& partition_name) {
+    auto status = meta_->DropPartition(partition_name);
+    Invalidate(partition_name);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::ShowPartitions(const std::string& table_id, std::vector<meta::TableSchema>& partition_schema_array) {
+    return meta_->ShowPartitions(table_id, partition_schema_array);
+}
+
+Status
+SnapshotMetaImpl::GetPartitionName(const std::string& table_id, const std::string& tag, std::string& partition_name) {
+    return meta_->GetPartitionName(table_id, tag, partition_name);
+}
+
+Status
+SnapshotMetaImpl::FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) {
+    return meta_->FilesToMerge(table_id, files);
+}
+
+Status
+SnapshotMetaImpl::FilesToIndex(TableFilesSchema& files) {
+    return meta_->FilesToIndex(files);
+}
+
+Status
+SnapshotMetaImpl::FilesByType(const std::string& table_id, const std::vector<int>& file_types,
+                              TableFilesSchema& table_files) {
+    return meta_->FilesByType(table_id, file_types, table_files);
+}
+
+Status
+SnapshotMetaImpl::Size(uint64_t& result) {
+    return meta_->Size(result);
+}
+
+Status
+SnapshotMetaImpl::Archive() {
+    auto status = meta_->Archive();
+    InvalidateAll();
+    return status;
+}
+
+Status
+SnapshotMetaImpl::CleanUpShadowFiles() {
+    auto status = meta_->CleanUpShadowFiles();
+    InvalidateAll();
+    return status;
+}
+
+Status
+SnapshotMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
+    // only files marked to_delete are removed, they aren't searched
+    return meta_->CleanUpFilesWithTTL(seconds, filter);
+}
+
+Status
+SnapshotMetaImpl::DropAll() {
+    auto status = meta_->DropAll();
+    InvalidateAll();
+    return status;
+}
+
+Status
+SnapshotMetaImpl::Count(const std::string& table_id, uint64_t& result) {
+    return meta_->Count(table_id, result);
+}
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
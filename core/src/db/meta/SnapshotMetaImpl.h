@@ -0,0 +1,171 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "Meta.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+/*
+ * Serves FilesToSearch from an in-memory snapshot of the searchable files of each table instead of a
+ * query per search, everything else goes to the meta it wraps; A snapshot is loaded on the first search
+ * of a table and dropped by every write to the table through this meta, a version of the table keeps a
+ * snapshot loaded during a write from being kept; Files of readonly nodes are written by other nodes,
+ * their snapshots also expire after a while, or are refreshed once the writable node tells a change; Writes of
+ * the writable node are published to the MetaChangeFeed for readonly nodes;
+ */
+class SnapshotMetaImpl : public Meta {
+ public:
+    SnapshotMetaImpl(MetaPtr meta, const int& mode);
+
+    Status
+    CreateTable(TableSchema& table_schema) override;
+
+    Status
+    DescribeTable(TableSchema& table_schema) override;
+
+    Status
+    HasTable(const std::string& table_id, bool& has_or_not) override;
+
+    Status
+    AllTables(std::vector<TableSchema>& table_schema_array) override;
+
+    Status
+    UpdateTableFlag(const std::string& table_id, int64_t flag) override;
+
+    Status
+    DropTable(const std::string& table_id) override;
+
+    Status
+    DeleteTableFiles(const std::string& table_id) override;
+
+    Status
+    CreateTableFile(TableFileSchema& file_schema) override;
+
+    Status
+    DropDataByDate(const std::string& table_id, const DatesT& dates) override;
+
+    Status
+    GetTableFiles(const std::string& table_id, const std::vector<size_t>& ids, TableFilesSchema& table_files) override;
+
+    Status
+    UpdateTableFile(TableFileSchema& file_schema) override;
+
+    Status
+    UpdateTableFiles(TableFilesSchema& files) override;
+
+    Status
+    UpdateTableIndex(const std::string& table_id, const TableIndex& index) override;
+
+    Status
+    UpdateTableFilesToIndex(const std::string& table_id) override;
+
+    Status
+    DescribeTableIndex(const std::string& table_id, TableIndex& index) override;
+
+    Status
+    DropTableIndex(const std::string& table_id) override;
+
+    Status
+    CreatePartition(const std::string& table_id, const std::string& partition_name, const std::string& tag) override;
+
+    Status
+    DropPartition(const std::string& partition_name) override;
+
+    Status
+    ShowPartitions(const std::string& table_id, std::vector<meta::TableSchema>& partition_schema_array) override;
+
+    Status
+    GetPartitionName(const std::string& table_id, const std::string& tag, std::string& partition_name) override;
+
+    Status
+    FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
+                  DatePartionedTableFilesSchema& files) override;
+
+    Status
+    FilesToSearch(const std::vector<std::string>& table_ids, const DatesT& dates,
+                  DatePartionedTableFilesSchema& files) override;
+
+    Status
+    FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) override;
+
+    Status
+    FilesToIndex(TableFilesSchema&) override;
+
+    Status
+    FilesByType(const std::string& table_id, const std::vector<int>& file_types,
+                TableFilesSchema& table_files) override;
+
+    Status
+    Size(uint64_t& result) override;
+
+    Status
+    Archive() override;
+
+    Status
+    CleanUpShadowFiles() override;
+
+    Status
+    CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter = nullptr) override;
+
+    Status
+    DropAll() override;
+
+    Status
+    Count(const std::string& table_id, uint64_t& result) override;
+
+    // drop the snapshot of a table written by another node, empty table id for all tables
+    void
+    Refresh(const std::string& table_id);
+
+ private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Snapshot {
+        std::shared_ptr<const TableFilesSchema> files_;
+        Clock::time_point load_time_;
+    };
+
+    // called once a write to the table is done
+    void
+    Invalidate(const std::string& table_id);
+    void
+    InvalidateAll();
+    void
+    InvalidateFiles(const TableFilesSchema& files);
+
+ private:
+    MetaPtr meta_;
+    // 0 if snapshots don't expire
+    std::chrono::milliseconds ttl_;
+    bool publish_changes_;
+
+    std::shared_mutex mutex_;
+    std::unordered_map<std::string, Snapshot> snapshots_;
+    std::unordered_map<std::string, uint64_t> versions_;
+    // bumped by writes to every table
+    uint64_t global_version_ = 0;
+};
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -22,6 +22,7 @@
 #include <sqlite_orm.h>
 #include <unistd.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
@@ -56,6 +57,8 @@ HandleException(const std::string& desc, const char* what = nullptr) {
 inline auto
 StoragePrototype(const std::string& path) {
     return make_storage(path,
+                        // files of a table, or of a table and its partitions, are looked up for every search
+                        make_index("idx_table_files_table_id", &TableFileSchema::table_id_),
                         make_table(META_TABLES,
                                    make_column("id", &TableSchema::id_, primary_key()),
                                    make_column("table_id", &TableSchema::table_id_, unique()),
@@ -535,76 +538,123 @@ SqliteMetaImpl::UpdateTableFlag(const std::string& table_id, int64_t flag) {
 
 Status
 SqliteMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
-    file_schema.updated_time_ = utils::GetMicroSecTimeStamp();
     try {
-        server::MetricCollector metric;
         fiu_do_on("SqliteMetaImpl.UpdateTableFile.throw_exception", throw std::exception());
+    } catch (std::exception& e) {
+        std::string msg = "Exception update table file: table_id = " + file_schema.table_id_
+                          + " file_id = " + file_schema.file_id_;
+        return HandleException(msg, e.what());
+    }
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+    return GroupUpdateTableFiles({&file_schema});
+}
+
+Status
+SqliteMetaImpl::UpdateTableFiles(TableFilesSchema& files) {
+    try {
+        fiu_do_on("SqliteMetaImpl.UpdateTableFiles.throw_exception", throw std::exception());
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when update table files", e.what());
+    }
+
+    std::vector<TableFileSchema*> file_ptrs;
+    for (auto& file : files) {
+        file_ptrs.push_back(&file);
+    }
+    return GroupUpdateTableFiles(file_ptrs);
+}
 
-        auto tables = ConnectorPtr->select(columns(&TableSchema::state_),
-                                           where(c(&TableSchema::table_id_) == file_schema.table_id_));
+Status
+SqliteMetaImpl::GroupUpdateTableFiles(const std::vector<TableFileSchema*>& files) {
+    if (files.empty()) {
+        return Status::OK();
+    }
 
-        //if the table has been deleted, just mark the table file as TO_DELETE
-        //clean thread will delete the file later
-        if (tables.size() < 1 || std::get<0>(tables[0]) == (int)TableSchema::TO_DELETE) {
-            file_schema.file_type_ = TableFileSchema::TO_DELETE;
+    // flushes, merges and builds update files all the time, each transaction syncs the meta file,
+    // so whoever finds no commit in progress commits the requests queued meanwhile at once
+    FileUpdateRequest request;
+    request.files_ = files;
+    std::unique_lock<std::mutex> lock(update_mutex_);
+    update_requests_.push_back(&request);
+    while (!request.done_) {
+        if (updating_) {
+            update_cv_.wait(lock);
+            continue;
         }
 
-        ConnectorPtr->update(file_schema);
+        updating_ = true;
+        std::vector<FileUpdateRequest*> requests;
+        requests.swap(update_requests_);
+        lock.unlock();
+        auto status = CommitFileUpdates(requests);
+        if (status.ok() || requests.size() == 1) {
+            for (auto& committed : requests) {
+                committed->status_ = status;
+            }
+        } else {
+            // one bad update fails the whole transaction, each request is committed alone so only its caller fails
+            ENGINE_LOG_WARNING << "Group update of " << requests.size() << " requests failed, commit them one by one";
+            for (auto& committed : requests) {
+                committed->status_ = CommitFileUpdates({committed});
+            }
+        }
+        lock.lock();
 
-        ENGINE_LOG_DEBUG << "Update single table file, file id = " << file_schema.file_id_;
-    } catch (std::exception& e) {
-        std::string msg = "Exception update table file: table_id = " + file_schema.table_id_
-                          + " file_id = " + file_schema.file_id_;
-        return HandleException(msg, e.what());
+        for (auto& committed : requests) {
+            committed->done_ = true;
+        }
+        updating_ = false;
+        update_cv_.notify_all();
     }
-    return Status::OK();
+    return request.status_;
 }
 
 Status
-SqliteMetaImpl::UpdateTableFiles(TableFilesSchema& files) {
+SqliteMetaImpl::CommitFileUpdates(const std::vector<FileUpdateRequest*>& requests) {
+    size_t file_count = 0;
     try {
         server::MetricCollector metric;
-        fiu_do_on("SqliteMetaImpl.UpdateTableFiles.throw_exception", throw std::exception());
 
         //multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
+        //if the table has been deleted, the files are marked as TO_DELETE, clean thread will delete them later
         std::map<std::string, bool> has_tables;
-        for (auto& file : files) {
-            if (has_tables.find(file.table_id_) != has_tables.end()) {
-                continue;
-            }
-            auto tables = ConnectorPtr->select(columns(&TableSchema::id_),
-                                               where(c(&TableSchema::table_id_) == file.table_id_
-                                                     and c(&TableSchema::state_) != (int)TableSchema::TO_DELETE));
-            if (tables.size() >= 1) {
-                has_tables[file.table_id_] = true;
-            } else {
-                has_tables[file.table_id_] = false;
+        for (auto& request : requests) {
+            for (auto& file : request->files_) {
+                if (has_tables.find(file->table_id_) != has_tables.end()) {
+                    continue;
+                }
+                auto tables = ConnectorPtr->select(columns(&TableSchema::id_),
+                                                   where(c(&TableSchema::table_id_) == file->table_id_
+                                                         and c(&TableSchema::state_) != (int)TableSchema::TO_DELETE));
+                has_tables[file->table_id_] = (tables.size() >= 1);
             }
         }
 
+        // files are updated in the order the requests came, a file updated twice keeps the later one
         auto commited = ConnectorPtr->transaction([&]() mutable {
-            for (auto& file : files) {
-                if (!has_tables[file.table_id_]) {
-                    file.file_type_ = TableFileSchema::TO_DELETE;
+            for (auto& request : requests) {
+                for (auto& file : request->files_) {
+                    if (!has_tables[file->table_id_]) {
+                        file->file_type_ = TableFileSchema::TO_DELETE;
+                    }
+
+                    file->updated_time_ = utils::GetMicroSecTimeStamp();
+                    ConnectorPtr->update(*file);
+                    ++file_count;
                 }
-
-                file.updated_time_ = utils::GetMicroSecTimeStamp();
-                ConnectorPtr->update(file);
             }
             return true;
         });
         fiu_do_on("SqliteMetaImpl.UpdateTableFiles.fail_commited", commited = false);
+        fiu_do_on("SqliteMetaImpl.UpdateTableFiles.fail_group", commited = commited && requests.size() == 1);
 
         if (!commited) {
             return HandleException("UpdateTableFiles error: sqlite transaction failed");
         }
 
-        ENGINE_LOG_DEBUG << "Update " << files.size() << " table files";
+        ENGINE_LOG_DEBUG << "Update " << file_count << " table files of " << requests.size() << " requests";
     } catch (std::exception& e) {
         return HandleException("Encounter exception when update table files", e.what());
     }
@@ -653,15 +703,7 @@ SqliteMetaImpl::UpdateTableIndex(const std::string& table_id, const TableIndex&
             return Status(DB_NOT_FOUND, "Table " + table_id + " not found");
         }
 
-        //set all backup file to raw
-        ConnectorPtr->update_all(
-            set(
-                c(&TableFileSchema::file_type_) = (int)TableFileSchema::RAW,
-                c(&TableFileSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
-            where(
-                c(&TableFileSchema::table_id_) == table_id and
-                c(&TableFileSchema::file_type_) == (int)TableFileSchema::BACKUP));
-
+        // backup files stay backups, their index files are dropped or replaced by the caller
         ENGINE_LOG_DEBUG << "Successfully update table index, table id = " << table_id;
     } catch (std::exception& e) {
         std::string msg = "Encounter exception when update table index: table_id = " + table_id;
@@ -827,14 +869,37 @@ SqliteMetaImpl::ShowPartitions(const std::string& table_id, std::vector<meta::Ta
         server::MetricCollector metric;
         fiu_do_on("SqliteMetaImpl.ShowPartitions.throw_exception", throw std::exception());
 
-        auto partitions = ConnectorPtr->select(columns(&TableSchema::table_id_),
+        // all partitions are described in one query, a table may have thousands of them
+        auto partitions = ConnectorPtr->select(columns(&TableSchema::id_,
+                                                       &TableSchema::table_id_,
+                                                       &TableSchema::state_,
+                                                       &TableSchema::dimension_,
+                                                       &TableSchema::created_on_,
+                                                       &TableSchema::flag_,
+                                                       &TableSchema::index_file_size_,
+                                                       &TableSchema::engine_type_,
+                                                       &TableSchema::nlist_,
+                                                       &TableSchema::metric_type_,
+                                                       &TableSchema::owner_table_,
+                                                       &TableSchema::partition_tag_,
+                                                       &TableSchema::version_),
                                                where(c(&TableSchema::owner_table_) == table_id
                                                      and c(&TableSchema::state_) != (int)TableSchema::TO_DELETE));
-        for (size_t i = 0; i < partitions.size(); ++i) {
-            std::string partition_name = std::get<0>(partitions[i]);
+        for (auto& partition : partitions) {
             meta::TableSchema partition_schema;
-            partition_schema.table_id_ = partition_name;
-            DescribeTable(partition_schema);
+            partition_schema.id_ = std::get<0>(partition);
+            partition_schema.table_id_ = std::get<1>(partition);
+            partition_schema.state_ = std::get<2>(partition);
+            partition_schema.dimension_ = std::get<3>(partition);
+            partition_schema.created_on_ = std::get<4>(partition);
+            partition_schema.flag_ = std::get<5>(partition);
+            partition_schema.index_file_size_ = std::get<6>(partition);
+            partition_schema.engine_type_ = std::get<7>(partition);
+            partition_schema.nlist_ = std::get<8>(partition);
+            partition_schema.metric_type_ = std::get<9>(partition);
+            partition_schema.owner_table_ = std::get<10>(partition);
+            partition_schema.partition_tag_ = std::get<11>(partition);
+            partition_schema.version_ = std::get<12>(partition);
             partition_schema_array.emplace_back(partition_schema);
         }
     } catch (std::exception& e) {
@@ -890,7 +955,7 @@ SqliteMetaImpl::FilesToSearch(const std::string& table_id,
         auto match_tableid = c(&TableFileSchema::table_id_) == table_id;
 
         std::vector<int> file_types = {(int)TableFileSchema::RAW, (int)TableFileSchema::TO_INDEX,
-                                       (int)TableFileSchema::INDEX};
+                                       (int)TableFileSchema::INDEX, (int)TableFileSchema::ARCHIVE};
         auto match_type = in(&TableFileSchema::file_type_, file_types);
 
         TableSchema table_schema;
@@ -990,6 +1055,105 @@ SqliteMetaImpl::FilesToSearch(const std::string& table_id,
     }
 }
 
+Status
+SqliteMetaImpl::FilesToSearch(const std::vector<std::string>& table_ids,
+                              const DatesT& dates,
+                              DatePartionedTableFilesSchema& files) {
+    files.clear();
+    if (table_ids.empty()) {
+        return Status::OK();
+    }
+
+    server::MetricCollector metric;
+
+    try {
+        fiu_do_on("SqliteMetaImpl.FilesToSearch.throw_exception", throw std::exception());
+
+        // sqlite_orm 'in' statement cannot handle too many elements, see FilesToSearch of a single table,
+        // so the tables are queried in batches, still far fewer queries than one per partition
+        const size_t batch_size = 30;
+        std::map<std::string, TableSchema> table_schemas;
+        std::vector<std::vector<std::string>> split_ids;
+        for (size_t i = 0; i < table_ids.size(); i += batch_size) {
+            std::vector<std::string> batch_ids(table_ids.begin() + i,
+                                               table_ids.begin() + std::min(i + batch_size, table_ids.size()));
+            auto tables = ConnectorPtr->select(columns(&TableSchema::table_id_,
+                                                       &TableSchema::dimension_,
+                                                       &TableSchema::index_file_size_,
+                                                       &TableSchema::nlist_,
+                                                       &TableSchema::metric_type_),
+                                               where(in(&TableSchema::table_id_, batch_ids)
+                                                     and c(&TableSchema::state_) != (int)TableSchema::TO_DELETE));
+            batch_ids.clear();
+            for (auto& table : tables) {
+                TableSchema& table_schema = table_schemas[std::get<0>(table)];
+                table_schema.table_id_ = std::get<0>(table);
+                table_schema.dimension_ = std::get<1>(table);
+                table_schema.index_file_size_ = std::get<2>(table);
+                table_schema.nlist_ = std::get<3>(table);
+                table_schema.metric_type_ = std::get<4>(table);
+                batch_ids.push_back(table_schema.table_id_);
+            }
+            if (!batch_ids.empty()) {
+                split_ids.emplace_back(std::move(batch_ids));
+            }
+        }
+        if (table_schemas.empty()) {
+            return Status(DB_NOT_FOUND, "Table " + table_ids.front() + " not found");
+        }
+
+        std::set<DateT> date_set(dates.begin(), dates.end());
+        std::vector<int> file_types = {(int)TableFileSchema::RAW, (int)TableFileSchema::TO_INDEX,
+                                       (int)TableFileSchema::INDEX, (int)TableFileSchema::ARCHIVE};
+        Status ret;
+        size_t file_count = 0;
+        for (auto& batch_ids : split_ids) {
+            auto selected = ConnectorPtr->select(
+                columns(&TableFileSchema::id_, &TableFileSchema::table_id_, &TableFileSchema::file_id_,
+                        &TableFileSchema::file_type_, &TableFileSchema::file_size_, &TableFileSchema::row_count_,
+                        &TableFileSchema::date_, &TableFileSchema::engine_type_),
+                where(in(&TableFileSchema::table_id_, batch_ids) and in(&TableFileSchema::file_type_, file_types)));
+
+            TableFileSchema table_file;
+            for (auto& file : selected) {
+                table_file.date_ = std::get<6>(file);
+                if (!date_set.empty() && date_set.find(table_file.date_) == date_set.end()) {
+                    continue;
+                }
+
+                auto& table_schema = table_schemas[std::get<1>(file)];
+                table_file.id_ = std::get<0>(file);
+                table_file.table_id_ = std::get<1>(file);
+                table_file.file_id_ = std::get<2>(file);
+                table_file.file_type_ = std::get<3>(file);
+                table_file.file_size_ = std::get<4>(file);
+                table_file.row_count_ = std::get<5>(file);
+                table_file.engine_type_ = std::get<7>(file);
+                table_file.dimension_ = table_schema.dimension_;
+                table_file.index_file_size_ = table_schema.index_file_size_;
+                table_file.nlist_ = table_schema.nlist_;
+                table_file.metric_type_ = table_schema.metric_type_;
+
+                auto status = utils::GetTableFilePath(options_, table_file);
+                if (!status.ok()) {
+                    ret = status;
+                }
+
+                files[table_file.date_].push_back(table_file);
+                ++file_count;
+            }
+        }
+
+        if (file_count > 0) {
+            ENGINE_LOG_DEBUG << "Collect " << file_count << " to-search files of " << table_schemas.size()
+                             << " tables";
+        }
+        return ret;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when iterate index files", e.what());
+    }
+}
+
 Status
 SqliteMetaImpl::FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) {
     files.clear();
@@ -1237,7 +1401,9 @@ SqliteMetaImpl::Archive() {
     for (auto kv : criterias) {
         auto& criteria = kv.first;
         auto& limit = kv.second;
-        if (criteria == engine::ARCHIVE_CONF_DAYS) {
+        // files past the days are compressed by the db instead when the archive type is compress
+        bool compress = (options_.archive_conf_.GetType() == engine::ARCHIVE_TYPE_COMPRESS);
+        if (criteria == engine::ARCHIVE_CONF_DAYS && !compress) {
             int64_t usecs = limit * DAY * US_PS;
             int64_t now = utils::GetMicroSecTimeStamp();
             try {
@@ -1349,30 +1515,44 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
             (int)TableFileSchema::BACKUP,
         };
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-
         // collect files to be deleted
-        auto files = ConnectorPtr->select(columns(&TableFileSchema::id_,
-                                                  &TableFileSchema::table_id_,
-                                                  &TableFileSchema::file_id_,
-                                                  &TableFileSchema::file_type_,
-                                                  &TableFileSchema::date_),
-                                          where(
-                                              in(&TableFileSchema::file_type_, file_types)
-                                              and
-                                              c(&TableFileSchema::updated_time_)
-                                              < now - seconds * US_PS));
-
+        auto files = [&]() {
+            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
+            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            return ConnectorPtr->select(columns(&TableFileSchema::id_,
+                                                &TableFileSchema::table_id_,
+                                                &TableFileSchema::file_id_,
+                                                &TableFileSchema::file_type_,
+                                                &TableFileSchema::date_,
+                                                &TableFileSchema::updated_time_),
+                                        where(
+                                            in(&TableFileSchema::file_type_, file_types)
+                                            and
+                                            c(&TableFileSchema::updated_time_)
+                                            < now - seconds * US_PS));
+        }();
+
+        // files are deleted in batches, disk files without the lock, then their rows in a short transaction,
+        // so that a large drop doesn't keep other meta calls waiting; rows of files deleted before a crash
+        // are removed by the next clean up
+        const size_t batch_size = 64;
         int64_t clean_files = 0;
-        auto commited = ConnectorPtr->transaction([&]() mutable {
+        bool commited = true;
+        fiu_do_on("SqliteMetaImpl.CleanUpFilesWithTTL.RemoveFile_FailCommited", commited = false);
+        std::vector<size_t> batch_ids;
+        TableFilesSchema batch_files;
+        for (size_t i = 0; commited && i < files.size(); i += batch_size) {
+            batch_ids.clear();
+            batch_files.clear();
             TableFileSchema table_file;
-            for (auto& file : files) {
+            for (size_t j = i; j < std::min(i + batch_size, files.size()); ++j) {
+                auto& file = files[j];
                 table_file.id_ = std::get<0>(file);
                 table_file.table_id_ = std::get<1>(file);
                 table_file.file_id_ = std::get<2>(file);
                 table_file.file_type_ = std::get<3>(file);
                 table_file.date_ = std::get<4>(file);
+                table_file.updated_time_ = std::get<5>(file);
 
                 // check if the file can be deleted
                 if (filter && filter->IsIgnored(table_file)) {
@@ -1387,22 +1567,34 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
                 server::CommonUtil::EraseFromCache(table_file.location_);
 
                 if (table_file.file_type_ == (int)TableFileSchema::TO_DELETE) {
-                    // delete file from meta
-                    ConnectorPtr->remove<TableFileSchema>(table_file.id_);
+                    batch_files.push_back(table_file);
+                }
+            }
 
-                    // delete file from disk storage
-                    utils::DeleteTableFilePath(options_, table_file);
+            if (batch_files.empty()) {
+                continue;
+            }
 
-                    ENGINE_LOG_DEBUG << "Remove file id:" << table_file.file_id_ << " location:"
-                                     << table_file.location_;
-                    table_ids.insert(table_file.table_id_);
+            // delete files of the batch from disk storage at once
+            utils::DeleteTableFilePaths(options_, batch_files);
+            for (auto& file : batch_files) {
+                ENGINE_LOG_DEBUG << "Remove file id:" << file.file_id_ << " location:" << file.location_;
+                table_ids.insert(file.table_id_);
+                batch_ids.push_back(file.id_);
+            }
 
-                    ++clean_files;
+            // delete files from meta
+            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            commited = ConnectorPtr->transaction([&]() mutable {
+                for (auto id : batch_ids) {
+                    ConnectorPtr->remove<TableFileSchema>(id);
                 }
+                return true;
+            });
+            if (commited) {
+                clean_files += batch_ids.size();
             }
-            return true;
-        });
-        fiu_do_on("SqliteMetaImpl.CleanUpFilesWithTTL.RemoveFile_FailCommited", commited = false);
+        }
 
         if (!commited) {
             return HandleException("CleanUpFilesWithTTL error: sqlite transaction failed");
@@ -1455,6 +1647,10 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
 
         int64_t remove_tables = 0;
         for (auto& table_id : table_ids) {
+            // merges of the table still write into the folder, it is removed by a later clean up
+            if (filter && filter->IsTableIgnored(table_id)) {
+                continue;
+            }
             auto selected = ConnectorPtr->select(columns(&TableFileSchema::file_id_),
                                                  where(c(&TableFileSchema::table_id_) == table_id));
             if (selected.size() == 0) {
@@ -1481,7 +1677,7 @@ SqliteMetaImpl::Count(const std::string& table_id, uint64_t& result) {
         server::MetricCollector metric;
 
         std::vector<int> file_types = {(int)TableFileSchema::RAW, (int)TableFileSchema::TO_INDEX,
-                                       (int)TableFileSchema::INDEX};
+                                       (int)TableFileSchema::INDEX, (int)TableFileSchema::ARCHIVE};
         auto selected = ConnectorPtr->select(
             columns(&TableFileSchema::row_count_),
             where(in(&TableFileSchema::file_type_, file_types) and c(&TableFileSchema::table_id_) == table_id));
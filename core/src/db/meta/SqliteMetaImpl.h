@@ -14,6 +14,7 @@
 #include "Meta.h"
 #include "db/Options.h"
 
+#include <condition_variable>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -94,6 +95,10 @@ class SqliteMetaImpl : public Meta {
     FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
                   DatePartionedTableFilesSchema& files) override;
 
+    Status
+    FilesToSearch(const std::vector<std::string>& table_ids, const DatesT& dates,
+                  DatePartionedTableFilesSchema& files) override;
+
     Status
     FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) override;
 
@@ -135,10 +140,27 @@ class SqliteMetaImpl : public Meta {
     Status
     Initialize();
 
+    // files of concurrent callers are updated in a group, by one of them in a single transaction
+    struct FileUpdateRequest {
+        std::vector<TableFileSchema*> files_;
+        Status status_;
+        bool done_ = false;
+    };
+
+    Status
+    GroupUpdateTableFiles(const std::vector<TableFileSchema*>& files);
+    Status
+    CommitFileUpdates(const std::vector<FileUpdateRequest*>& requests);
+
  private:
     const DBMetaOptions options_;
     std::mutex meta_mutex_;
     std::mutex genid_mutex_;
+
+    std::mutex update_mutex_;
+    std::condition_variable update_cv_;
+    std::vector<FileUpdateRequest*> update_requests_;
+    bool updating_ = false;
 };  // DBMetaImpl
 
 }  // namespace meta
@@ -0,0 +1,712 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/wal/WalManager.h"
+#include "utils/CommonUtil.h"
+#include "utils/Log.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <fiu-local.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+namespace wal {
+
+namespace {
+
+// record layout:
+//   header:  | payload size (uint32) | payload crc32 (uint32) | lsn (uint64) |
+//   payload: | data type (uint8) | table id length (uint16) | table id | vector count (uint64) |
+//            | id count (uint64) | ids | data bytes (uint64) | data |
+//            optional attributes, one value per vector:
+//            | attr count (uint32) | name length (uint16) | name | type (uint8) | values (8 bytes each) | ... |
+//            optional insert time, after the attributes, attr count may be 0:
+//            | insert time in microseconds (int64) |
+constexpr size_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+constexpr size_t RECORD_LSN_OFFSET = sizeof(uint32_t) + sizeof(uint32_t);
+
+constexpr uint8_t DATA_TYPE_FLOAT = 0;
+constexpr uint8_t DATA_TYPE_BINARY = 1;
+
+const char* SEGMENT_SUFFIX = ".wal";
+const char* CHECKPOINT_FILE = "checkpoint";
+
+template <typename T>
+void
+AppendValue(std::string& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool
+ReadValue(const char*& ptr, const char* end, T& value) {
+    if (ptr + sizeof(T) > end) {
+        return false;
+    }
+    memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return true;
+}
+
+uint32_t
+Crc32(const char* data, size_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+void
+EncodeRecord(const std::string& table_id, const VectorsData& vectors, std::string& record) {
+    uint8_t data_type = vectors.float_data_.empty() ? DATA_TYPE_BINARY : DATA_TYPE_FLOAT;
+    const char* data = nullptr;
+    uint64_t data_bytes = 0;
+    if (data_type == DATA_TYPE_FLOAT) {
+        data = reinterpret_cast<const char*>(vectors.float_data_.data());
+        data_bytes = vectors.float_data_.size() * sizeof(float);
+    } else {
+        data = reinterpret_cast<const char*>(vectors.binary_data_.data());
+        data_bytes = vectors.binary_data_.size();
+    }
+
+    uint64_t id_count = vectors.id_array_.size();
+    size_t reserved_size = sizeof(uint8_t) + sizeof(uint16_t) + table_id.size() + sizeof(uint64_t) +
+                           sizeof(uint64_t) + id_count * sizeof(IDNumber) + sizeof(uint64_t) + data_bytes;
+    bool has_tail = !vectors.attrs_.empty() || vectors.insert_time_us_ > 0;
+    if (has_tail) {
+        reserved_size += sizeof(uint32_t) + sizeof(int64_t);
+        for (auto& pair : vectors.attrs_) {
+            reserved_size += sizeof(uint16_t) + pair.first.size() + sizeof(uint8_t) + pair.second.Size() * 8;
+        }
+    }
+
+    record.clear();
+    record.reserve(RECORD_HEADER_SIZE + reserved_size);
+    record.resize(RECORD_HEADER_SIZE);  // header is filled after payload
+
+    AppendValue(record, data_type);
+    AppendValue(record, static_cast<uint16_t>(table_id.size()));
+    record.append(table_id);
+    AppendValue(record, vectors.vector_count_);
+    AppendValue(record, id_count);
+    record.append(reinterpret_cast<const char*>(vectors.id_array_.data()), id_count * sizeof(IDNumber));
+    AppendValue(record, data_bytes);
+    record.append(data, data_bytes);
+
+    // a record without attributes and insert time ends with the data, as written before they were logged
+    if (has_tail) {
+        AppendValue(record, static_cast<uint32_t>(vectors.attrs_.size()));
+        for (auto& pair : vectors.attrs_) {
+            AppendValue(record, static_cast<uint16_t>(pair.first.size()));
+            record.append(pair.first);
+            AppendValue(record, static_cast<uint8_t>(pair.second.type_));
+            if (pair.second.type_ == AttrColumn::Type::INT64) {
+                record.append(reinterpret_cast<const char*>(pair.second.int_values_.data()),
+                              pair.second.int_values_.size() * sizeof(int64_t));
+            } else {
+                record.append(reinterpret_cast<const char*>(pair.second.double_values_.data()),
+                              pair.second.double_values_.size() * sizeof(double));
+            }
+        }
+        if (vectors.insert_time_us_ > 0) {
+            AppendValue(record, vectors.insert_time_us_);
+        }
+    }
+    size_t payload_size = record.size() - RECORD_HEADER_SIZE;
+
+    uint32_t size = static_cast<uint32_t>(payload_size);
+    uint32_t crc = Crc32(record.data() + RECORD_HEADER_SIZE, payload_size);
+    memcpy(&record[0], &size, sizeof(size));
+    memcpy(&record[sizeof(uint32_t)], &crc, sizeof(crc));
+}
+
+bool
+DecodePayload(const char* ptr, const char* end, std::string& table_id, VectorsData& vectors) {
+    uint8_t data_type = 0;
+    uint16_t table_id_size = 0;
+    if (!ReadValue(ptr, end, data_type) || !ReadValue(ptr, end, table_id_size) || ptr + table_id_size > end) {
+        return false;
+    }
+    table_id.assign(ptr, table_id_size);
+    ptr += table_id_size;
+
+    uint64_t id_count = 0;
+    if (!ReadValue(ptr, end, vectors.vector_count_) || !ReadValue(ptr, end, id_count) ||
+        ptr + id_count * sizeof(IDNumber) > end) {
+        return false;
+    }
+    vectors.id_array_.resize(id_count);
+    memcpy(vectors.id_array_.data(), ptr, id_count * sizeof(IDNumber));
+    ptr += id_count * sizeof(IDNumber);
+
+    uint64_t data_bytes = 0;
+    if (!ReadValue(ptr, end, data_bytes) || ptr + data_bytes > end) {
+        return false;
+    }
+    if (data_type == DATA_TYPE_FLOAT) {
+        vectors.float_data_.resize(data_bytes / sizeof(float));
+        memcpy(vectors.float_data_.data(), ptr, data_bytes);
+    } else {
+        vectors.binary_data_.resize(data_bytes);
+        memcpy(vectors.binary_data_.data(), ptr, data_bytes);
+    }
+    ptr += data_bytes;
+
+    if (ptr == end) {
+        return true;
+    }
+    uint32_t attr_count = 0;
+    if (!ReadValue(ptr, end, attr_count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < attr_count; i++) {
+        uint16_t name_size = 0;
+        uint8_t type = 0;
+        if (!ReadValue(ptr, end, name_size) || ptr + name_size > end) {
+            return false;
+        }
+        std::string name(ptr, name_size);
+        ptr += name_size;
+        uint64_t values_bytes = vectors.vector_count_ * 8;
+        if (!ReadValue(ptr, end, type) || ptr + values_bytes > end) {
+            return false;
+        }
+
+        auto& column = vectors.attrs_[name];
+        column.type_ = static_cast<AttrColumn::Type>(type);
+        if (column.type_ == AttrColumn::Type::INT64) {
+            column.int_values_.resize(vectors.vector_count_);
+            memcpy(column.int_values_.data(), ptr, values_bytes);
+        } else {
+            column.double_values_.resize(vectors.vector_count_);
+            memcpy(column.double_values_.data(), ptr, values_bytes);
+        }
+        ptr += values_bytes;
+    }
+
+    // records logged before insert time have none, their vectors are searched by any time range
+    if (ptr != end && !ReadValue(ptr, end, vectors.insert_time_us_)) {
+        return false;
+    }
+    return ptr == end;
+}
+
+}  // namespace
+
+WalManager::WalManager(const std::string& wal_path, uint64_t segment_size)
+    : wal_path_(wal_path), segment_size_(segment_size) {
+}
+
+WalManager::~WalManager() {
+    CloseSegment();
+}
+
+Status
+WalManager::Init() {
+    auto status = server::CommonUtil::CreateDirectory(wal_path_);
+    if (!status.ok()) {
+        std::string msg = "Failed to create wal directory: " + wal_path_;
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_INVALID_PATH, msg);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    CloseSegment();
+    segments_.clear();
+    inflight_lsns_.clear();
+    failed_batches_.clear();
+    pending_buffer_.clear();
+    unflushed_lsns_.clear();
+
+    // checkpoint layout: global flushed lsn, followed by "table_id lsn" lines of tables flushed ahead of it
+    flushed_lsn_ = 0;
+    table_flushed_lsns_.clear();
+    std::ifstream checkpoint(CheckpointPath());
+    if (checkpoint.is_open()) {
+        checkpoint >> flushed_lsn_;
+        std::string table_id;
+        uint64_t table_lsn = 0;
+        while (checkpoint >> table_id >> table_lsn) {
+            table_flushed_lsns_[table_id] = table_lsn;
+        }
+    }
+
+    boost::filesystem::directory_iterator end_iter;
+    for (boost::filesystem::directory_iterator iter(wal_path_); iter != end_iter; ++iter) {
+        auto& path = iter->path();
+        if (!boost::filesystem::is_regular_file(path) || path.extension().string() != SEGMENT_SUFFIX) {
+            continue;
+        }
+        try {
+            uint64_t first_lsn = std::stoull(path.stem().string());
+            segments_[first_lsn] = path.string();
+        } catch (...) {
+            ENGINE_LOG_WARNING << "Ignore unknown wal file: " << path.string();
+        }
+    }
+
+    last_lsn_ = flushed_lsn_;
+    synced_lsn_ = flushed_lsn_;
+    ENGINE_LOG_DEBUG << "Wal initialized at " << wal_path_ << ", flushed lsn: " << flushed_lsn_ << ", "
+                     << segments_.size() << " segments found";
+    return Status::OK();
+}
+
+Status
+WalManager::Replay(const ReplayHandler& handler) {
+    std::map<uint64_t, std::string> segments;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        segments = segments_;
+    }
+
+    uint64_t replayed = 0;
+    for (auto& pair : segments) {
+        auto status = ReplaySegment(pair.second, handler, replayed);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    synced_lsn_ = last_lsn_;
+    if (replayed > 0) {
+        ENGINE_LOG_INFO << "Wal replayed " << replayed << " records, last lsn: " << last_lsn_;
+    }
+    return Status::OK();
+}
+
+Status
+WalManager::ReplaySegment(const std::string& path, const ReplayHandler& handler, uint64_t& replayed) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        std::string msg = "Failed to open wal segment: " + path;
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+
+    std::vector<char> payload;
+    uint64_t prev_lsn = 0;
+    while (true) {
+        char header[RECORD_HEADER_SIZE];
+        if (!file.read(header, RECORD_HEADER_SIZE)) {
+            break;
+        }
+
+        uint32_t size = 0, crc = 0;
+        uint64_t lsn = 0;
+        memcpy(&size, header, sizeof(size));
+        memcpy(&crc, header + sizeof(uint32_t), sizeof(crc));
+        memcpy(&lsn, header + RECORD_LSN_OFFSET, sizeof(lsn));
+
+        payload.resize(size);
+        if (!file.read(payload.data(), size) || Crc32(payload.data(), size) != crc || lsn <= prev_lsn) {
+            // torn write at the tail of segment, the record was never acknowledged
+            ENGINE_LOG_WARNING << "Wal segment " << path << " truncated after lsn " << prev_lsn;
+            break;
+        }
+        prev_lsn = lsn;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last_lsn_ = std::max(last_lsn_, lsn);
+        }
+        if (lsn <= flushed_lsn_) {
+            continue;
+        }
+
+        std::string table_id;
+        VectorsData vectors;
+        if (!DecodePayload(payload.data(), payload.data() + size, table_id, vectors)) {
+            ENGINE_LOG_WARNING << "Wal record " << lsn << " is damaged, skip it";
+            continue;
+        }
+
+        auto table_iter = table_flushed_lsns_.find(table_id);
+        if (table_iter != table_flushed_lsns_.end() && lsn <= table_iter->second) {
+            continue;
+        }
+
+        auto status = handler(table_id, vectors);
+        if (status.ok()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            unflushed_lsns_[table_id].push_back(lsn);
+        } else {
+            // typically the table has been dropped
+            ENGINE_LOG_WARNING << "Failed to replay wal record " << lsn << " of table " << table_id << ": "
+                               << status.message();
+        }
+        ++replayed;
+    }
+
+    return Status::OK();
+}
+
+Status
+WalManager::Append(const std::string& table_id, const VectorsData& vectors, uint64_t& lsn) {
+    std::string record;
+    EncodeRecord(table_id, vectors, record);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    lsn = ++last_lsn_;
+    memcpy(&record[RECORD_LSN_OFFSET], &lsn, sizeof(lsn));
+    if (pending_buffer_.empty()) {
+        pending_first_lsn_ = lsn;
+    }
+    pending_buffer_.append(record);
+    inflight_lsns_.insert(lsn);
+    unflushed_lsns_[table_id].push_back(lsn);
+
+    // group commit: whoever finds no sync in progress writes all pending records
+    while (synced_lsn_ < lsn && !IsFailed(lsn)) {
+        if (syncing_) {
+            cv_.wait(lock);
+            continue;
+        }
+
+        syncing_ = true;
+        std::string batch;
+        batch.swap(pending_buffer_);
+        uint64_t first_lsn = pending_first_lsn_;
+        uint64_t batch_lsn = last_lsn_;
+
+        lock.unlock();
+        auto status = WriteAndSync(batch, first_lsn);
+        lock.lock();
+
+        syncing_ = false;
+        if (status.ok()) {
+            synced_lsn_ = batch_lsn;
+        } else {
+            // records of this batch are not acknowledged, fail all of them
+            failed_batches_[first_lsn] = batch_lsn;
+            sync_status_ = status;
+        }
+        cv_.notify_all();
+    }
+
+    if (IsFailed(lsn)) {
+        inflight_lsns_.erase(lsn);
+        EraseUnflushedLsn(table_id, lsn);
+        return sync_status_;
+    }
+
+    return Status::OK();
+}
+
+bool
+WalManager::IsFailed(uint64_t lsn) const {
+    auto iter = failed_batches_.upper_bound(lsn);
+    if (iter == failed_batches_.begin()) {
+        return false;
+    }
+    --iter;
+    return lsn <= iter->second;
+}
+
+void
+WalManager::MarkApplied(uint64_t lsn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inflight_lsns_.erase(lsn);
+}
+
+void
+WalManager::Discard(const std::string& table_id, uint64_t lsn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inflight_lsns_.erase(lsn);
+    EraseUnflushedLsn(table_id, lsn);
+}
+
+void
+WalManager::EraseUnflushedLsn(const std::string& table_id, uint64_t lsn) {
+    auto iter = unflushed_lsns_.find(table_id);
+    if (iter != unflushed_lsns_.end()) {
+        auto& lsns = iter->second;
+        lsns.erase(std::remove(lsns.begin(), lsns.end(), lsn), lsns.end());
+    }
+}
+
+uint64_t
+WalManager::GetAppliedLsn() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (inflight_lsns_.empty()) {
+        return last_lsn_;
+    }
+    return *inflight_lsns_.begin() - 1;
+}
+
+Status
+WalManager::Checkpoint(uint64_t lsn) {
+    std::lock_guard<std::mutex> checkpoint_lock(checkpoint_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& pair : unflushed_lsns_) {
+            PopFlushedLsns(pair.second, lsn);
+        }
+    }
+
+    return AdvanceCheckpoint(false);
+}
+
+Status
+WalManager::Checkpoint(uint64_t lsn, const std::set<std::string>& table_ids) {
+    std::lock_guard<std::mutex> checkpoint_lock(checkpoint_mutex_);
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& table_id : table_ids) {
+            auto iter = unflushed_lsns_.find(table_id);
+            if (iter != unflushed_lsns_.end()) {
+                PopFlushedLsns(iter->second, lsn);
+            }
+
+            uint64_t& table_lsn = table_flushed_lsns_[table_id];
+            if (lsn > table_lsn) {
+                table_lsn = lsn;
+                changed = true;
+            }
+        }
+    }
+
+    return AdvanceCheckpoint(changed);
+}
+
+void
+WalManager::PopFlushedLsns(std::deque<uint64_t>& lsns, uint64_t lsn) {
+    while (!lsns.empty() && lsns.front() <= lsn) {
+        lsns.pop_front();
+    }
+}
+
+Status
+WalManager::AdvanceCheckpoint(bool force_write) {
+    // every record before the oldest un-flushed one of any table is durable in table files
+    uint64_t flushed_lsn = 0;
+    std::map<std::string, uint64_t> table_flushed_lsns;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flushed_lsn = last_lsn_;
+        for (auto& pair : unflushed_lsns_) {
+            if (!pair.second.empty()) {
+                flushed_lsn = std::min(flushed_lsn, pair.second.front() - 1);
+            }
+        }
+        flushed_lsn = std::max(flushed_lsn, flushed_lsn_);
+
+        for (auto& pair : table_flushed_lsns_) {
+            if (pair.second > flushed_lsn) {
+                table_flushed_lsns.insert(pair);
+            }
+        }
+
+        if (flushed_lsn == flushed_lsn_ && !force_write) {
+            return Status::OK();
+        }
+    }
+
+    auto status = WriteCheckpoint(flushed_lsn, table_flushed_lsns);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // a segment is obsolete when all of its records are flushed, current segment is never removed
+    std::vector<std::string> obsolete_files;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flushed_lsn_ = flushed_lsn;
+        table_flushed_lsns_.swap(table_flushed_lsns);
+        while (!failed_batches_.empty() && failed_batches_.begin()->second <= flushed_lsn) {
+            failed_batches_.erase(failed_batches_.begin());
+        }
+
+        auto iter = segments_.begin();
+        while (iter != segments_.end()) {
+            auto next = std::next(iter);
+            if (next == segments_.end() || next->first - 1 > flushed_lsn) {
+                break;
+            }
+            obsolete_files.push_back(iter->second);
+            iter = segments_.erase(iter);
+        }
+    }
+
+    for (auto& file : obsolete_files) {
+        boost::system::error_code ec;
+        boost::filesystem::remove(file, ec);
+        ENGINE_LOG_DEBUG << "Remove obsolete wal segment: " << file;
+    }
+
+    return Status::OK();
+}
+
+Status
+WalManager::WriteCheckpoint(uint64_t flushed_lsn, const std::map<std::string, uint64_t>& table_flushed_lsns) {
+    // write to a temp file and rename, the checkpoint is never half written
+    std::string path = CheckpointPath();
+    std::string temp_path = path + ".tmp";
+    std::string content = std::to_string(flushed_lsn) + "\n";
+    for (auto& pair : table_flushed_lsns) {
+        content += pair.first + " " + std::to_string(pair.second) + "\n";
+    }
+
+    int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool failed = (fd < 0);
+    const char* ptr = content.data();
+    size_t left = content.size();
+    while (!failed && left > 0) {
+        ssize_t written = write(fd, ptr, left);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            failed = true;
+            break;
+        }
+        ptr += written;
+        left -= written;
+    }
+    // the content must be on disk before the rename, or a crash may leave an empty checkpoint behind it
+    failed = failed || fsync(fd) != 0;
+    std::string msg = failed ? "Failed to write wal checkpoint " + temp_path + ": " + strerror(errno) : "";
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (failed) {
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+    if (rename(temp_path.c_str(), path.c_str()) != 0) {
+        msg = "Failed to rename wal checkpoint: " + std::string(strerror(errno));
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+
+    // segments are removed once the checkpoint is written, the rename must be durable before that
+    return SyncDirectory();
+}
+
+Status
+WalManager::SyncDirectory() const {
+    int dir_fd = open(wal_path_.c_str(), O_RDONLY | O_DIRECTORY);
+    bool failed = (dir_fd < 0 || fsync(dir_fd) != 0);
+    fiu_do_on("WalManager.SyncDirectory.fail", failed = true);
+    std::string msg = failed ? "Failed to sync wal directory " + wal_path_ + ": " + strerror(errno) : "";
+    if (dir_fd >= 0) {
+        close(dir_fd);
+    }
+    if (failed) {
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+    return Status::OK();
+}
+
+Status
+WalManager::WriteAndSync(const std::string& batch, uint64_t first_lsn) {
+    if (current_fd_ < 0) {
+        auto status = OpenSegment(first_lsn);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    const char* ptr = batch.data();
+    size_t left = batch.size();
+    bool failed = false;
+    fiu_do_on("WalManager.WriteAndSync.write_fail", failed = true);
+    while (left > 0 && !failed) {
+        ssize_t written = write(current_fd_, ptr, left);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            failed = true;
+            break;
+        }
+        ptr += written;
+        left -= written;
+    }
+
+    if (failed || fdatasync(current_fd_) != 0) {
+        std::string msg = "Failed to write wal segment: " + std::string(strerror(errno));
+        ENGINE_LOG_ERROR << msg;
+        // the tail of current segment may be damaged, following records go to a new segment
+        CloseSegment();
+        return Status(DB_ERROR, msg);
+    }
+
+    current_size_ += batch.size();
+    if (current_size_ >= segment_size_) {
+        CloseSegment();
+    }
+
+    return Status::OK();
+}
+
+Status
+WalManager::OpenSegment(uint64_t first_lsn) {
+    std::string path = SegmentPath(first_lsn);
+    // an existing file with the same name holds nothing but a torn record, it is safe to overwrite it
+    current_fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (current_fd_ < 0) {
+        std::string msg = "Failed to create wal segment " + path + ": " + std::string(strerror(errno));
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+    current_size_ = 0;
+
+    // records synced to a segment whose name is not durable yet would be lost with it on a crash
+    auto status = SyncDirectory();
+    if (!status.ok()) {
+        CloseSegment();
+        return status;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    segments_[first_lsn] = path;
+    return Status::OK();
+}
+
+void
+WalManager::CloseSegment() {
+    if (current_fd_ >= 0) {
+        close(current_fd_);
+        current_fd_ = -1;
+    }
+    current_size_ = 0;
+}
+
+std::string
+WalManager::SegmentPath(uint64_t first_lsn) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%020" PRIu64, first_lsn);
+    return wal_path_ + "/" + name + SEGMENT_SUFFIX;
+}
+
+std::string
+WalManager::CheckpointPath() const {
+    return wal_path_ + "/" + CHECKPOINT_FILE;
+}
+
+}  // namespace wal
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,154 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+#include "utils/Status.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace milvus {
+namespace engine {
+namespace wal {
+
+constexpr uint64_t WAL_SEGMENT_SIZE = 64UL * 1024 * 1024;
+
+// callback used to re-apply un-flushed records when server restart
+using ReplayHandler = std::function<Status(const std::string& table_id, VectorsData& vectors)>;
+
+// Sequential, group-committed write-ahead log for inserted vectors.
+//
+// Every record gets a monotonic lsn. Concurrent Append() calls are batched: the first waiter writes and fsyncs
+// all pending records on behalf of the others, so durability costs one fdatasync per batch instead of one per
+// request. Once the insert buffer is serialized, Checkpoint() persists the flushed lsn and removes log segments
+// which are no longer needed for recovery. Tables may be flushed individually, the log is then truncated up to
+// the oldest record some table still holds in memory.
+class WalManager {
+ public:
+    explicit WalManager(const std::string& wal_path, uint64_t segment_size = WAL_SEGMENT_SIZE);
+    ~WalManager();
+
+    // open log directory and read the checkpoint
+    Status
+    Init();
+
+    // re-apply records which are not covered by the last checkpoint, must be called before any Append()
+    Status
+    Replay(const ReplayHandler& handler);
+
+    // return after the record is durable on disk
+    // vectors.id_array_ must be filled, so that replay produce the same ids
+    Status
+    Append(const std::string& table_id, const VectorsData& vectors, uint64_t& lsn);
+
+    // record has been inserted into memory (or failed to be inserted), it is up to flush now
+    void
+    MarkApplied(uint64_t lsn);
+
+    // record failed to be inserted into memory, nothing will be flushed for it
+    void
+    Discard(const std::string& table_id, uint64_t lsn);
+
+    // all records whose lsn is not greater than the returned value have been inserted into memory
+    uint64_t
+    GetAppliedLsn();
+
+    // data of all tables up to lsn has been serialized, records before it are not required any more
+    Status
+    Checkpoint(uint64_t lsn);
+
+    // only the given tables are serialized up to lsn, their records are skipped by replay,
+    // a log segment is removed once every table has flushed its records
+    Status
+    Checkpoint(uint64_t lsn, const std::set<std::string>& table_ids);
+
+    uint64_t
+    GetFlushedLsn() const {
+        return flushed_lsn_;
+    }
+
+ private:
+    Status
+    WriteAndSync(const std::string& batch, uint64_t first_lsn);
+
+    bool
+    IsFailed(uint64_t lsn) const;
+
+    Status
+    OpenSegment(uint64_t first_lsn);
+
+    void
+    CloseSegment();
+
+    void
+    EraseUnflushedLsn(const std::string& table_id, uint64_t lsn);
+
+    static void
+    PopFlushedLsns(std::deque<uint64_t>& lsns, uint64_t lsn);
+
+    Status
+    AdvanceCheckpoint(bool force_write);
+
+    Status
+    WriteCheckpoint(uint64_t flushed_lsn, const std::map<std::string, uint64_t>& table_flushed_lsns);
+
+    Status
+    SyncDirectory() const;
+
+    Status
+    ReplaySegment(const std::string& path, const ReplayHandler& handler, uint64_t& replayed);
+
+    std::string
+    SegmentPath(uint64_t first_lsn) const;
+
+    std::string
+    CheckpointPath() const;
+
+ private:
+    const std::string wal_path_;
+    const uint64_t segment_size_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::mutex checkpoint_mutex_;  // only one checkpoint is written at a time
+
+    uint64_t last_lsn_ = 0;
+    uint64_t synced_lsn_ = 0;
+    uint64_t flushed_lsn_ = 0;
+    std::map<std::string, uint64_t> table_flushed_lsns_;  // tables flushed ahead of flushed_lsn_
+
+    std::string pending_buffer_;
+    uint64_t pending_first_lsn_ = 0;
+    bool syncing_ = false;
+    Status sync_status_;
+    std::map<uint64_t, uint64_t> failed_batches_;  // first lsn -> last lsn of batches failed to write
+
+    std::set<uint64_t> inflight_lsns_;
+    std::map<std::string, std::deque<uint64_t>> unflushed_lsns_;  // table id -> lsns not covered by checkpoint
+    std::map<uint64_t, std::string> segments_;  // first lsn -> file path
+
+    int current_fd_ = -1;
+    uint64_t current_size_ = 0;
+};  // WalManager
+
+using WalManagerPtr = std::shared_ptr<WalManager>;
+
+}  // namespace wal
+}  // namespace engine
+}  // namespace milvus
@@ -38,6 +38,11 @@ static const char* MilvusService_method_names[] = {
   "/milvus.grpc.MilvusService/Cmd",
   "/milvus.grpc.MilvusService/DeleteByDate",
   "/milvus.grpc.MilvusService/PreloadTable",
+  "/milvus.grpc.MilvusService/InsertStream",
+  "/milvus.grpc.MilvusService/SearchStream",
+  "/milvus.grpc.MilvusService/SearchByRange",
+  "/milvus.grpc.MilvusService/BulkInsert",
+  "/milvus.grpc.MilvusService/GetVectorByID",
 };
 
 std::unique_ptr< MilvusService::Stub> MilvusService::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -65,6 +70,11 @@ MilvusService::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& chan
   , rpcmethod_Cmd_(MilvusService_method_names[15], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_DeleteByDate_(MilvusService_method_names[16], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_PreloadTable_(MilvusService_method_names[17], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_InsertStream_(MilvusService_method_names[18], ::grpc::internal::RpcMethod::CLIENT_STREAMING, channel)
+  , rpcmethod_SearchStream_(MilvusService_method_names[19], ::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_SearchByRange_(MilvusService_method_names[20], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_BulkInsert_(MilvusService_method_names[21], ::grpc::internal::RpcMethod::CLIENT_STREAMING, channel)
+  , rpcmethod_GetVectorByID_(MilvusService_method_names[22], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   {}
 
 ::grpc::Status MilvusService::Stub::CreateTable(::grpc::ClientContext* context, const ::milvus::grpc::TableSchema& request, ::milvus::grpc::Status* response) {
@@ -571,6 +581,110 @@ void MilvusService::Stub::experimental_async::PreloadTable(::grpc::ClientContext
   return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::milvus::grpc::Status>::Create(channel_.get(), cq, rpcmethod_PreloadTable_, context, request, false);
 }
 
+::grpc::ClientWriter< ::milvus::grpc::InsertParam>* MilvusService::Stub::InsertStreamRaw(::grpc::ClientContext* context, ::milvus::grpc::VectorIds* response) {
+  return ::grpc_impl::internal::ClientWriterFactory< ::milvus::grpc::InsertParam>::Create(channel_.get(), rpcmethod_InsertStream_, context, response);
+}
+
+void MilvusService::Stub::experimental_async::InsertStream(::grpc::ClientContext* context, ::milvus::grpc::VectorIds* response, ::grpc::experimental::ClientWriteReactor< ::milvus::grpc::InsertParam>* reactor) {
+  ::grpc_impl::internal::ClientCallbackWriterFactory< ::milvus::grpc::InsertParam>::Create(stub_->channel_.get(), stub_->rpcmethod_InsertStream_, context, response, reactor);
+}
+
+::grpc::ClientAsyncWriter< ::milvus::grpc::InsertParam>* MilvusService::Stub::AsyncInsertStreamRaw(::grpc::ClientContext* context, ::milvus::grpc::VectorIds* response, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc_impl::internal::ClientAsyncWriterFactory< ::milvus::grpc::InsertParam>::Create(channel_.get(), cq, rpcmethod_InsertStream_, context, response, true, tag);
+}
+
+::grpc::ClientAsyncWriter< ::milvus::grpc::InsertParam>* MilvusService::Stub::PrepareAsyncInsertStreamRaw(::grpc::ClientContext* context, ::milvus::grpc::VectorIds* response, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncWriterFactory< ::milvus::grpc::InsertParam>::Create(channel_.get(), cq, rpcmethod_InsertStream_, context, response, false, nullptr);
+}
+
+::grpc::ClientReader< ::milvus::grpc::TopKQueryResult>* MilvusService::Stub::SearchStreamRaw(::grpc::ClientContext* context, const ::milvus::grpc::SearchParam& request) {
+  return ::grpc_impl::internal::ClientReaderFactory< ::milvus::grpc::TopKQueryResult>::Create(channel_.get(), rpcmethod_SearchStream_, context, request);
+}
+
+void MilvusService::Stub::experimental_async::SearchStream(::grpc::ClientContext* context, ::milvus::grpc::SearchParam* request, ::grpc::experimental::ClientReadReactor< ::milvus::grpc::TopKQueryResult>* reactor) {
+  ::grpc_impl::internal::ClientCallbackReaderFactory< ::milvus::grpc::TopKQueryResult>::Create(stub_->channel_.get(), stub_->rpcmethod_SearchStream_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::milvus::grpc::TopKQueryResult>* MilvusService::Stub::AsyncSearchStreamRaw(::grpc::ClientContext* context, const ::milvus::grpc::SearchParam& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc_impl::internal::ClientAsyncReaderFactory< ::milvus::grpc::TopKQueryResult>::Create(channel_.get(), cq, rpcmethod_SearchStream_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::milvus::grpc::TopKQueryResult>* MilvusService::Stub::PrepareAsyncSearchStreamRaw(::grpc::ClientContext* context, const ::milvus::grpc::SearchParam& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncReaderFactory< ::milvus::grpc::TopKQueryResult>::Create(channel_.get(), cq, rpcmethod_SearchStream_, context, request, false, nullptr);
+}
+
+::grpc::Status MilvusService::Stub::SearchByRange(::grpc::ClientContext* context, const ::milvus::grpc::RangeSearchParam& request, ::milvus::grpc::TopKQueryResult* response) {
+  return ::grpc::internal::BlockingUnaryCall(channel_.get(), rpcmethod_SearchByRange_, context, request, response);
+}
+
+void MilvusService::Stub::experimental_async::SearchByRange(::grpc::ClientContext* context, const ::milvus::grpc::RangeSearchParam* request, ::milvus::grpc::TopKQueryResult* response, std::function<void(::grpc::Status)> f) {
+  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_SearchByRange_, context, request, response, std::move(f));
+}
+
+void MilvusService::Stub::experimental_async::SearchByRange(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::milvus::grpc::TopKQueryResult* response, std::function<void(::grpc::Status)> f) {
+  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_SearchByRange_, context, request, response, std::move(f));
+}
+
+void MilvusService::Stub::experimental_async::SearchByRange(::grpc::ClientContext* context, const ::milvus::grpc::RangeSearchParam* request, ::milvus::grpc::TopKQueryResult* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
+  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_SearchByRange_, context, request, response, reactor);
+}
+
+void MilvusService::Stub::experimental_async::SearchByRange(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::milvus::grpc::TopKQueryResult* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
+  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_SearchByRange_, context, request, response, reactor);
+}
+
+::grpc::ClientAsyncResponseReader< ::milvus::grpc::TopKQueryResult>* MilvusService::Stub::AsyncSearchByRangeRaw(::grpc::ClientContext* context, const ::milvus::grpc::RangeSearchParam& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::milvus::grpc::TopKQueryResult>::Create(channel_.get(), cq, rpcmethod_SearchByRange_, context, request, true);
+}
+
+::grpc::ClientAsyncResponseReader< ::milvus::grpc::TopKQueryResult>* MilvusService::Stub::PrepareAsyncSearchByRangeRaw(::grpc::ClientContext* context, const ::milvus::grpc::RangeSearchParam& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::milvus::grpc::TopKQueryResult>::Create(channel_.get(), cq, rpcmethod_SearchByRange_, context, request, false);
+}
+
+::grpc::ClientWriter< ::milvus::grpc::InsertParam>* MilvusService::Stub::BulkInsertRaw(::grpc::ClientContext* context, ::milvus::grpc::VectorIds* response) {
+  return ::grpc_impl::internal::ClientWriterFactory< ::milvus::grpc::InsertParam>::Create(channel_.get(), rpcmethod_BulkInsert_, context, response);
+}
+
+void MilvusService::Stub::experimental_async::BulkInsert(::grpc::ClientContext* context, ::milvus::grpc::VectorIds* response, ::grpc::experimental::ClientWriteReactor< ::milvus::grpc::InsertParam>* reactor) {
+  ::grpc_impl::internal::ClientCallbackWriterFactory< ::milvus::grpc::InsertParam>::Create(stub_->channel_.get(), stub_->rpcmethod_BulkInsert_, context, response, reactor);
+}
+
+::grpc::ClientAsyncWriter< ::milvus::grpc::InsertParam>* MilvusService::Stub::AsyncBulkInsertRaw(::grpc::ClientContext* context, ::milvus::grpc::VectorIds* response, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc_impl::internal::ClientAsyncWriterFactory< ::milvus::grpc::InsertParam>::Create(channel_.get(), cq, rpcmethod_BulkInsert_, context, response, true, tag);
+}
+
+::grpc::ClientAsyncWriter< ::milvus::grpc::InsertParam>* MilvusService::Stub::PrepareAsyncBulkInsertRaw(::grpc::ClientContext* context, ::milvus::grpc::VectorIds* response, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncWriterFactory< ::milvus::grpc::InsertParam>::Create(channel_.get(), cq, rpcmethod_BulkInsert_, context, response, false, nullptr);
+}
+
+::grpc::Status MilvusService::Stub::GetVectorByID(::grpc::ClientContext* context, const ::milvus::grpc::VectorIdentity& request, ::milvus::grpc::VectorData* response) {
+  return ::grpc::internal::BlockingUnaryCall(channel_.get(), rpcmethod_GetVectorByID_, context, request, response);
+}
+
+void MilvusService::Stub::experimental_async::GetVectorByID(::grpc::ClientContext* context, const ::milvus::grpc::VectorIdentity* request, ::milvus::grpc::VectorData* response, std::function<void(::grpc::Status)> f) {
+  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_GetVectorByID_, context, request, response, std::move(f));
+}
+
+void MilvusService::Stub::experimental_async::GetVectorByID(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::milvus::grpc::VectorData* response, std::function<void(::grpc::Status)> f) {
+  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_GetVectorByID_, context, request, response, std::move(f));
+}
+
+void MilvusService::Stub::experimental_async::GetVectorByID(::grpc::ClientContext* context, const ::milvus::grpc::VectorIdentity* request, ::milvus::grpc::VectorData* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
+  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_GetVectorByID_, context, request, response, reactor);
+}
+
+void MilvusService::Stub::experimental_async::GetVectorByID(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::milvus::grpc::VectorData* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
+  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_GetVectorByID_, context, request, response, reactor);
+}
+
+::grpc::ClientAsyncResponseReader< ::milvus::grpc::VectorData>* MilvusService::Stub::AsyncGetVectorByIDRaw(::grpc::ClientContext* context, const ::milvus::grpc::VectorIdentity& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::milvus::grpc::VectorData>::Create(channel_.get(), cq, rpcmethod_GetVectorByID_, context, request, true);
+}
+
+::grpc::ClientAsyncResponseReader< ::milvus::grpc::VectorData>* MilvusService::Stub::PrepareAsyncGetVectorByIDRaw(::grpc::ClientContext* context, const ::milvus::grpc::VectorIdentity& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::milvus::grpc::VectorData>::Create(channel_.get(), cq, rpcmethod_GetVectorByID_, context, request, false);
+}
+
 MilvusService::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       MilvusService_method_names[0],
@@ -662,6 +776,31 @@ MilvusService::Service::Service() {
       ::grpc::internal::RpcMethod::NORMAL_RPC,
       new ::grpc::internal::RpcMethodHandler< MilvusService::Service, ::milvus::grpc::TableName, ::milvus::grpc::Status>(
           std::mem_fn(&MilvusService::Service::PreloadTable), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      MilvusService_method_names[18],
+      ::grpc::internal::RpcMethod::CLIENT_STREAMING,
+      new ::grpc::internal::ClientStreamingHandler< MilvusService::Service, ::milvus::grpc::InsertParam, ::milvus::grpc::VectorIds>(
+          std::mem_fn(&MilvusService::Service::InsertStream), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      MilvusService_method_names[19],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< MilvusService::Service, ::milvus::grpc::SearchParam, ::milvus::grpc::TopKQueryResult>(
+          std::mem_fn(&MilvusService::Service::SearchStream), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      MilvusService_method_names[20],
+      ::grpc::internal::RpcMethod::NORMAL_RPC,
+      new ::grpc::internal::RpcMethodHandler< MilvusService::Service, ::milvus::grpc::RangeSearchParam, ::milvus::grpc::TopKQueryResult>(
+          std::mem_fn(&MilvusService::Service::SearchByRange), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      MilvusService_method_names[21],
+      ::grpc::internal::RpcMethod::CLIENT_STREAMING,
+      new ::grpc::internal::ClientStreamingHandler< MilvusService::Service, ::milvus::grpc::InsertParam, ::milvus::grpc::VectorIds>(
+          std::mem_fn(&MilvusService::Service::BulkInsert), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      MilvusService_method_names[22],
+      ::grpc::internal::RpcMethod::NORMAL_RPC,
+      new ::grpc::internal::RpcMethodHandler< MilvusService::Service, ::milvus::grpc::VectorIdentity, ::milvus::grpc::VectorData>(
+          std::mem_fn(&MilvusService::Service::GetVectorByID), this)));
 }
 
 MilvusService::Service::~Service() {
@@ -793,6 +932,41 @@ MilvusService::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status MilvusService::Service::InsertStream(::grpc::ServerContext* context, ::grpc::ServerReader< ::milvus::grpc::InsertParam>* reader, ::milvus::grpc::VectorIds* response) {
+  (void) context;
+  (void) reader;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status MilvusService::Service::SearchStream(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request, ::grpc::ServerWriter< ::milvus::grpc::TopKQueryResult>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status MilvusService::Service::SearchByRange(::grpc::ServerContext* context, const ::milvus::grpc::RangeSearchParam* request, ::milvus::grpc::TopKQueryResult* response) {
+  (void) context;
+  (void) request;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status MilvusService::Service::BulkInsert(::grpc::ServerContext* context, ::grpc::ServerReader< ::milvus::grpc::InsertParam>* reader, ::milvus::grpc::VectorIds* response) {
+  (void) context;
+  (void) reader;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status MilvusService::Service::GetVectorByID(::grpc::ServerContext* context, const ::milvus::grpc::VectorIdentity* request, ::milvus::grpc::VectorData* response) {
+  (void) context;
+  (void) request;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace milvus
 }  // namespace grpc
@@ -103,6 +103,18 @@ class DeleteByDateParamDefaultTypeInternal {
  public:
   ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<DeleteByDateParam> _instance;
 } _DeleteByDateParam_default_instance_;
+class RangeSearchParamDefaultTypeInternal {
+ public:
+  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<RangeSearchParam> _instance;
+} _RangeSearchParam_default_instance_;
+class VectorIdentityDefaultTypeInternal {
+ public:
+  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<VectorIdentity> _instance;
+} _VectorIdentity_default_instance_;
+class VectorDataDefaultTypeInternal {
+ public:
+  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<VectorData> _instance;
+} _VectorData_default_instance_;
 }  // namespace grpc
 }  // namespace milvus
 static void InitDefaultsscc_info_BoolReply_milvus_2eproto() {
@@ -252,6 +264,21 @@ static void InitDefaultsscc_info_Range_milvus_2eproto() {
 ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_Range_milvus_2eproto =
     {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, InitDefaultsscc_info_Range_milvus_2eproto}, {}};
 
+static void InitDefaultsscc_info_RangeSearchParam_milvus_2eproto() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::milvus::grpc::_RangeSearchParam_default_instance_;
+    new (ptr) ::milvus::grpc::RangeSearchParam();
+    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::milvus::grpc::RangeSearchParam::InitAsDefaultInstance();
+}
+
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<1> scc_info_RangeSearchParam_milvus_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 1, InitDefaultsscc_info_RangeSearchParam_milvus_2eproto}, {
+      &scc_info_SearchParam_milvus_2eproto.base,}};
+
 static void InitDefaultsscc_info_RowRecord_milvus_2eproto() {
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 
@@ -386,6 +413,36 @@ static void InitDefaultsscc_info_TopKQueryResult_milvus_2eproto() {
     {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 1, InitDefaultsscc_info_TopKQueryResult_milvus_2eproto}, {
       &scc_info_Status_status_2eproto.base,}};
 
+static void InitDefaultsscc_info_VectorData_milvus_2eproto() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::milvus::grpc::_VectorData_default_instance_;
+    new (ptr) ::milvus::grpc::VectorData();
+    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::milvus::grpc::VectorData::InitAsDefaultInstance();
+}
+
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<2> scc_info_VectorData_milvus_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 2, InitDefaultsscc_info_VectorData_milvus_2eproto}, {
+      &scc_info_Status_status_2eproto.base,
+      &scc_info_RowRecord_milvus_2eproto.base,}};
+
+static void InitDefaultsscc_info_VectorIdentity_milvus_2eproto() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::milvus::grpc::_VectorIdentity_default_instance_;
+    new (ptr) ::milvus::grpc::VectorIdentity();
+    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::milvus::grpc::VectorIdentity::InitAsDefaultInstance();
+}
+
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_VectorIdentity_milvus_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, InitDefaultsscc_info_VectorIdentity_milvus_2eproto}, {}};
+
 static void InitDefaultsscc_info_VectorIds_milvus_2eproto() {
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 
@@ -401,7 +458,7 @@ static void InitDefaultsscc_info_VectorIds_milvus_2eproto() {
     {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 1, InitDefaultsscc_info_VectorIds_milvus_2eproto}, {
       &scc_info_Status_status_2eproto.base,}};
 
-static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_milvus_2eproto[20];
+static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_milvus_2eproto[23];
 static constexpr ::PROTOBUF_NAMESPACE_ID::EnumDescriptor const** file_level_enum_descriptors_milvus_2eproto = nullptr;
 static constexpr ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor const** file_level_service_descriptors_milvus_2eproto = nullptr;
 
@@ -549,6 +606,8 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_milvus_2eproto::offsets[] PROT
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::IndexParam, status_),
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::IndexParam, table_name_),
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::IndexParam, index_),
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::IndexParam, indexed_row_count_),
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::IndexParam, total_row_count_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::DeleteByDateParam, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -556,6 +615,27 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_milvus_2eproto::offsets[] PROT
   ~0u,  // no _weak_field_map_
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::DeleteByDateParam, range_),
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::DeleteByDateParam, table_name_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::RangeSearchParam, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::RangeSearchParam, search_param_),
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::RangeSearchParam, radius_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::VectorIdentity, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::VectorIdentity, table_name_),
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::VectorIdentity, id_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::VectorData, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::VectorData, status_),
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::VectorData, vector_data_),
 };
 static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::milvus::grpc::TableName)},
@@ -577,7 +657,10 @@ static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOB
   { 122, -1, sizeof(::milvus::grpc::Command)},
   { 128, -1, sizeof(::milvus::grpc::Index)},
   { 135, -1, sizeof(::milvus::grpc::IndexParam)},
-  { 143, -1, sizeof(::milvus::grpc::DeleteByDateParam)},
+  { 145, -1, sizeof(::milvus::grpc::DeleteByDateParam)},
+  { 152, -1, sizeof(::milvus::grpc::RangeSearchParam)},
+  { 159, -1, sizeof(::milvus::grpc::VectorIdentity)},
+  { 166, -1, sizeof(::milvus::grpc::VectorData)},
 };
 
 static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
@@ -601,6 +684,9 @@ static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] =
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::milvus::grpc::_Index_default_instance_),
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::milvus::grpc::_IndexParam_default_instance_),
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::milvus::grpc::_DeleteByDateParam_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::milvus::grpc::_RangeSearchParam_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::milvus::grpc::_VectorIdentity_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::milvus::grpc::_VectorData_default_instance_),
 };
 
 const char descriptor_table_protodef_milvus_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
@@ -641,47 +727,63 @@ const char descriptor_table_protodef_milvus_2eproto[] PROTOBUF_SECTION_VARIABLE(
   "TableRowCount\022#\n\006status\030\001 \001(\0132\023.milvus.g"
   "rpc.Status\022\027\n\017table_row_count\030\002 \001(\003\"\026\n\007C"
   "ommand\022\013\n\003cmd\030\001 \001(\t\"*\n\005Index\022\022\n\nindex_ty"
-  "pe\030\001 \001(\005\022\r\n\005nlist\030\002 \001(\005\"h\n\nIndexParam\022#\n"
-  "\006status\030\001 \001(\0132\023.milvus.grpc.Status\022\022\n\nta"
-  "ble_name\030\002 \001(\t\022!\n\005index\030\003 \001(\0132\022.milvus.g"
-  "rpc.Index\"J\n\021DeleteByDateParam\022!\n\005range\030"
-  "\001 \001(\0132\022.milvus.grpc.Range\022\022\n\ntable_name\030"
-  "\002 \001(\t2\272\t\n\rMilvusService\022>\n\013CreateTable\022\030"
-  ".milvus.grpc.TableSchema\032\023.milvus.grpc.S"
-  "tatus\"\000\022<\n\010HasTable\022\026.milvus.grpc.TableN"
-  "ame\032\026.milvus.grpc.BoolReply\"\000\022C\n\rDescrib"
-  "eTable\022\026.milvus.grpc.TableName\032\030.milvus."
-  "grpc.TableSchema\"\000\022B\n\nCountTable\022\026.milvu"
-  "s.grpc.TableName\032\032.milvus.grpc.TableRowC"
-  "ount\"\000\022@\n\nShowTables\022\024.milvus.grpc.Comma"
-  "nd\032\032.milvus.grpc.TableNameList\"\000\022:\n\tDrop"
-  "Table\022\026.milvus.grpc.TableName\032\023.milvus.g"
-  "rpc.Status\"\000\022=\n\013CreateIndex\022\027.milvus.grp"
-  "c.IndexParam\032\023.milvus.grpc.Status\"\000\022B\n\rD"
-  "escribeIndex\022\026.milvus.grpc.TableName\032\027.m"
-  "ilvus.grpc.IndexParam\"\000\022:\n\tDropIndex\022\026.m"
-  "ilvus.grpc.TableName\032\023.milvus.grpc.Statu"
-  "s\"\000\022E\n\017CreatePartition\022\033.milvus.grpc.Par"
-  "titionParam\032\023.milvus.grpc.Status\"\000\022F\n\016Sh"
-  "owPartitions\022\026.milvus.grpc.TableName\032\032.m"
-  "ilvus.grpc.PartitionList\"\000\022C\n\rDropPartit"
-  "ion\022\033.milvus.grpc.PartitionParam\032\023.milvu"
-  "s.grpc.Status\"\000\022<\n\006Insert\022\030.milvus.grpc."
-  "InsertParam\032\026.milvus.grpc.VectorIds\"\000\022B\n"
-  "\006Search\022\030.milvus.grpc.SearchParam\032\034.milv"
-  "us.grpc.TopKQueryResult\"\000\022P\n\rSearchInFil"
-  "es\022\037.milvus.grpc.SearchInFilesParam\032\034.mi"
-  "lvus.grpc.TopKQueryResult\"\000\0227\n\003Cmd\022\024.mil"
-  "vus.grpc.Command\032\030.milvus.grpc.StringRep"
-  "ly\"\000\022E\n\014DeleteByDate\022\036.milvus.grpc.Delet"
-  "eByDateParam\032\023.milvus.grpc.Status\"\000\022=\n\014P"
-  "reloadTable\022\026.milvus.grpc.TableName\032\023.mi"
-  "lvus.grpc.Status\"\000b\006proto3"
+  "pe\030\001 \001(\005\022\r\n\005nlist\030\002 \001(\005\"\234\001\n\nIndexParam\022#"
+  "\n\006status\030\001 \001(\0132\023.milvus.grpc.Status\022\022\n\nt"
+  "able_name\030\002 \001(\t\022!\n\005index\030\003 \001(\0132\022.milvus."
+  "grpc.Index\022\031\n\021indexed_row_count\030\004 \001(\003\022\027\n"
+  "\017total_row_count\030\005 \001(\003\"J\n\021DeleteByDatePa"
+  "ram\022!\n\005range\030\001 \001(\0132\022.milvus.grpc.Range\022\022"
+  "\n\ntable_name\030\002 \001(\t\"R\n\020RangeSearchParam\022."
+  "\n\014search_param\030\001 \001(\0132\030.milvus.grpc.Searc"
+  "hParam\022\016\n\006radius\030\002 \001(\002\"0\n\016VectorIdentity"
+  "\022\022\n\ntable_name\030\001 \001(\t\022\n\n\002id\030\002 \001(\003\"^\n\nVect"
+  "orData\022#\n\006status\030\001 \001(\0132\023.milvus.grpc.Sta"
+  "tus\022+\n\013vector_data\030\002 \001(\0132\026.milvus.grpc.R"
+  "owRecord2\251\014\n\rMilvusService\022>\n\013CreateTabl"
+  "e\022\030.milvus.grpc.TableSchema\032\023.milvus.grp"
+  "c.Status\"\000\022<\n\010HasTable\022\026.milvus.grpc.Tab"
+  "leName\032\026.milvus.grpc.BoolReply\"\000\022C\n\rDesc"
+  "ribeTable\022\026.milvus.grpc.TableName\032\030.milv"
+  "us.grpc.TableSchema\"\000\022B\n\nCountTable\022\026.mi"
+  "lvus.grpc.TableName\032\032.milvus.grpc.TableR"
+  "owCount\"\000\022@\n\nShowTables\022\024.milvus.grpc.Co"
+  "mmand\032\032.milvus.grpc.TableNameList\"\000\022:\n\tD"
+  "ropTable\022\026.milvus.grpc.TableName\032\023.milvu"
+  "s.grpc.Status\"\000\022=\n\013CreateIndex\022\027.milvus."
+  "grpc.IndexParam\032\023.milvus.grpc.Status\"\000\022B"
+  "\n\rDescribeIndex\022\026.milvus.grpc.TableName\032"
+  "\027.milvus.grpc.IndexParam\"\000\022:\n\tDropIndex\022"
+  "\026.milvus.grpc.TableName\032\023.milvus.grpc.St"
+  "atus\"\000\022E\n\017CreatePartition\022\033.milvus.grpc."
+  "PartitionParam\032\023.milvus.grpc.Status\"\000\022F\n"
+  "\016ShowPartitions\022\026.milvus.grpc.TableName\032"
+  "\032.milvus.grpc.PartitionList\"\000\022C\n\rDropPar"
+  "tition\022\033.milvus.grpc.PartitionParam\032\023.mi"
+  "lvus.grpc.Status\"\000\022<\n\006Insert\022\030.milvus.gr"
+  "pc.InsertParam\032\026.milvus.grpc.VectorIds\"\000"
+  "\022B\n\006Search\022\030.milvus.grpc.SearchParam\032\034.m"
+  "ilvus.grpc.TopKQueryResult\"\000\022P\n\rSearchIn"
+  "Files\022\037.milvus.grpc.SearchInFilesParam\032\034"
+  ".milvus.grpc.TopKQueryResult\"\000\0227\n\003Cmd\022\024."
+  "milvus.grpc.Command\032\030.milvus.grpc.String"
+  "Reply\"\000\022E\n\014DeleteByDate\022\036.milvus.grpc.De"
+  "leteByDateParam\032\023.milvus.grpc.Status\"\000\022="
+  "\n\014PreloadTable\022\026.milvus.grpc.TableName\032\023"
+  ".milvus.grpc.Status\"\000\022D\n\014InsertStream\022\030."
+  "milvus.grpc.InsertParam\032\026.milvus.grpc.Ve"
+  "ctorIds\"\000(\001\022J\n\014SearchStream\022\030.milvus.grp"
+  "c.SearchParam\032\034.milvus.grpc.TopKQueryRes"
+  "ult\"\0000\001\022N\n\rSearchByRange\022\035.milvus.grpc.R"
+  "angeSearchParam\032\034.milvus.grpc.TopKQueryR"
+  "esult\"\000\022B\n\nBulkInsert\022\030.milvus.grpc.Inse"
+  "rtParam\032\026.milvus.grpc.VectorIds\"\000(\001\022G\n\rG"
+  "etVectorByID\022\033.milvus.grpc.VectorIdentit"
+  "y\032\027.milvus.grpc.VectorData\"\000b\006proto3"
   ;
 static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_milvus_2eproto_deps[1] = {
   &::descriptor_table_status_2eproto,
 };
-static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_milvus_2eproto_sccs[20] = {
+static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_milvus_2eproto_sccs[23] = {
   &scc_info_BoolReply_milvus_2eproto.base,
   &scc_info_Command_milvus_2eproto.base,
   &scc_info_DeleteByDateParam_milvus_2eproto.base,
@@ -692,6 +794,7 @@ static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_mil
   &scc_info_PartitionName_milvus_2eproto.base,
   &scc_info_PartitionParam_milvus_2eproto.base,
   &scc_info_Range_milvus_2eproto.base,
+  &scc_info_RangeSearchParam_milvus_2eproto.base,
   &scc_info_RowRecord_milvus_2eproto.base,
   &scc_info_SearchInFilesParam_milvus_2eproto.base,
   &scc_info_SearchParam_milvus_2eproto.base,
@@ -701,15 +804,17 @@ static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_mil
   &scc_info_TableRowCount_milvus_2eproto.base,
   &scc_info_TableSchema_milvus_2eproto.base,
   &scc_info_TopKQueryResult_milvus_2eproto.base,
+  &scc_info_VectorData_milvus_2eproto.base,
+  &scc_info_VectorIdentity_milvus_2eproto.base,
   &scc_info_VectorIds_milvus_2eproto.base,
 };
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_milvus_2eproto_once;
 static bool descriptor_table_milvus_2eproto_initialized = false;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_milvus_2eproto = {
-  &descriptor_table_milvus_2eproto_initialized, descriptor_table_protodef_milvus_2eproto, "milvus.proto", 2906,
-  &descriptor_table_milvus_2eproto_once, descriptor_table_milvus_2eproto_sccs, descriptor_table_milvus_2eproto_deps, 20, 1,
+  &descriptor_table_milvus_2eproto_initialized, descriptor_table_protodef_milvus_2eproto, "milvus.proto", 3556,
+  &descriptor_table_milvus_2eproto_once, descriptor_table_milvus_2eproto_sccs, descriptor_table_milvus_2eproto_deps, 23, 1,
   schemas, file_default_instances, TableStruct_milvus_2eproto::offsets,
-  file_level_metadata_milvus_2eproto, 20, file_level_enum_descriptors_milvus_2eproto, file_level_service_descriptors_milvus_2eproto,
+  file_level_metadata_milvus_2eproto, 23, file_level_enum_descriptors_milvus_2eproto, file_level_service_descriptors_milvus_2eproto,
 };
 
 // Force running AddDescriptors() at dynamic initialization time.
@@ -7120,6 +7225,9 @@ IndexParam::IndexParam(const IndexParam& from)
   } else {
     index_ = nullptr;
   }
+  ::memcpy(&indexed_row_count_, &from.indexed_row_count_,
+    static_cast<size_t>(reinterpret_cast<char*>(&total_row_count_) -
+    reinterpret_cast<char*>(&indexed_row_count_)) + sizeof(total_row_count_));
   // @@protoc_insertion_point(copy_constructor:milvus.grpc.IndexParam)
 }
 
@@ -7127,8 +7235,8 @@ void IndexParam::SharedCtor() {
   ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_IndexParam_milvus_2eproto.base);
   table_name_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   ::memset(&status_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&index_) -
-      reinterpret_cast<char*>(&status_)) + sizeof(index_));
+      reinterpret_cast<char*>(&total_row_count_) -
+      reinterpret_cast<char*>(&status_)) + sizeof(total_row_count_));
 }
 
 IndexParam::~IndexParam() {
@@ -7166,6 +7274,9 @@ void IndexParam::Clear() {
     delete index_;
   }
   index_ = nullptr;
+  ::memset(&indexed_row_count_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&total_row_count_) -
+      reinterpret_cast<char*>(&indexed_row_count_)) + sizeof(total_row_count_));
   _internal_metadata_.Clear();
 }
 
@@ -7198,6 +7309,20 @@ const char* IndexParam::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID:
           CHK_(ptr);
         } else goto handle_unusual;
         continue;
+      // int64 indexed_row_count = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 32)) {
+          indexed_row_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // int64 total_row_count = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 40)) {
+          total_row_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
       default: {
       handle_unusual:
         if ((tag & 7) == 4 || tag == 0) {
@@ -7265,6 +7390,32 @@ bool IndexParam::MergePartialFromCodedStream(
         break;
       }
 
+      // int64 indexed_row_count = 4;
+      case 4: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (32 & 0xFF)) {
+
+          DO_((::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadPrimitive<
+                   ::PROTOBUF_NAMESPACE_ID::int64, ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_INT64>(
+                 input, &indexed_row_count_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // int64 total_row_count = 5;
+      case 5: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (40 & 0xFF)) {
+
+          DO_((::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadPrimitive<
+                   ::PROTOBUF_NAMESPACE_ID::int64, ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_INT64>(
+                 input, &total_row_count_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -7314,6 +7465,16 @@ void IndexParam::SerializeWithCachedSizes(
       3, _Internal::index(this), output);
   }
 
+  // int64 indexed_row_count = 4;
+  if (this->indexed_row_count() != 0) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64(4, this->indexed_row_count(), output);
+  }
+
+  // int64 total_row_count = 5;
+  if (this->total_row_count() != 0) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64(5, this->total_row_count(), output);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFields(
         _internal_metadata_.unknown_fields(), output);
@@ -7352,6 +7513,16 @@ void IndexParam::SerializeWithCachedSizes(
         3, _Internal::index(this), target);
   }
 
+  // int64 indexed_row_count = 4;
+  if (this->indexed_row_count() != 0) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(4, this->indexed_row_count(), target);
+  }
+
+  // int64 total_row_count = 5;
+  if (this->total_row_count() != 0) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(5, this->total_row_count(), target);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target);
@@ -7394,6 +7565,20 @@ size_t IndexParam::ByteSizeLong() const {
         *index_);
   }
 
+  // int64 indexed_row_count = 4;
+  if (this->indexed_row_count() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
+        this->indexed_row_count());
+  }
+
+  // int64 total_row_count = 5;
+  if (this->total_row_count() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
+        this->total_row_count());
+  }
+
   int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
   SetCachedSize(cached_size);
   return total_size;
@@ -7431,6 +7616,12 @@ void IndexParam::MergeFrom(const IndexParam& from) {
   if (from.has_index()) {
     mutable_index()->::milvus::grpc::Index::MergeFrom(from.index());
   }
+  if (from.indexed_row_count() != 0) {
+    set_indexed_row_count(from.indexed_row_count());
+  }
+  if (from.total_row_count() != 0) {
+    set_total_row_count(from.total_row_count());
+  }
 }
 
 void IndexParam::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
@@ -7458,6 +7649,8 @@ void IndexParam::InternalSwap(IndexParam* other) {
     GetArenaNoVirtual());
   swap(status_, other->status_);
   swap(index_, other->index_);
+  swap(indexed_row_count_, other->indexed_row_count_);
+  swap(total_row_count_, other->total_row_count_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata IndexParam::GetMetadata() const {
@@ -7794,48 +7987,1003 @@ void DeleteByDateParam::InternalSwap(DeleteByDateParam* other) {
 }
 
 
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace grpc
-}  // namespace milvus
-PROTOBUF_NAMESPACE_OPEN
-template<> PROTOBUF_NOINLINE ::milvus::grpc::TableName* Arena::CreateMaybeMessage< ::milvus::grpc::TableName >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::TableName >(arena);
+// ===================================================================
+
+void RangeSearchParam::InitAsDefaultInstance() {
+  ::milvus::grpc::_RangeSearchParam_default_instance_._instance.get_mutable()->search_param_ = const_cast< ::milvus::grpc::SearchParam*>(
+      ::milvus::grpc::SearchParam::internal_default_instance());
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::PartitionName* Arena::CreateMaybeMessage< ::milvus::grpc::PartitionName >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::PartitionName >(arena);
+class RangeSearchParam::_Internal {
+ public:
+  static const ::milvus::grpc::SearchParam& search_param(const RangeSearchParam* msg);
+};
+
+const ::milvus::grpc::SearchParam&
+RangeSearchParam::_Internal::search_param(const RangeSearchParam* msg) {
+  return *msg->search_param_;
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::TableNameList* Arena::CreateMaybeMessage< ::milvus::grpc::TableNameList >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::TableNameList >(arena);
+RangeSearchParam::RangeSearchParam()
+  : ::PROTOBUF_NAMESPACE_ID::Message(), _internal_metadata_(nullptr) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:milvus.grpc.RangeSearchParam)
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::TableSchema* Arena::CreateMaybeMessage< ::milvus::grpc::TableSchema >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::TableSchema >(arena);
+RangeSearchParam::RangeSearchParam(const RangeSearchParam& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message(),
+      _internal_metadata_(nullptr) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  if (from.has_search_param()) {
+    search_param_ = new ::milvus::grpc::SearchParam(*from.search_param_);
+  } else {
+    search_param_ = nullptr;
+  }
+  radius_ = from.radius_;
+  // @@protoc_insertion_point(copy_constructor:milvus.grpc.RangeSearchParam)
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::PartitionParam* Arena::CreateMaybeMessage< ::milvus::grpc::PartitionParam >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::PartitionParam >(arena);
+
+void RangeSearchParam::SharedCtor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_RangeSearchParam_milvus_2eproto.base);
+  ::memset(&search_param_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&radius_) -
+      reinterpret_cast<char*>(&search_param_)) + sizeof(radius_));
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::PartitionList* Arena::CreateMaybeMessage< ::milvus::grpc::PartitionList >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::PartitionList >(arena);
+
+RangeSearchParam::~RangeSearchParam() {
+  // @@protoc_insertion_point(destructor:milvus.grpc.RangeSearchParam)
+  SharedDtor();
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::Range* Arena::CreateMaybeMessage< ::milvus::grpc::Range >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::Range >(arena);
+
+void RangeSearchParam::SharedDtor() {
+  if (this != internal_default_instance()) delete search_param_;
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::RowRecord* Arena::CreateMaybeMessage< ::milvus::grpc::RowRecord >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::RowRecord >(arena);
+
+void RangeSearchParam::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::InsertParam* Arena::CreateMaybeMessage< ::milvus::grpc::InsertParam >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::InsertParam >(arena);
+const RangeSearchParam& RangeSearchParam::default_instance() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_RangeSearchParam_milvus_2eproto.base);
+  return *internal_default_instance();
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::VectorIds* Arena::CreateMaybeMessage< ::milvus::grpc::VectorIds >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::VectorIds >(arena);
+
+
+void RangeSearchParam::Clear() {
+// @@protoc_insertion_point(message_clear_start:milvus.grpc.RangeSearchParam)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  if (GetArenaNoVirtual() == nullptr && search_param_ != nullptr) {
+    delete search_param_;
+  }
+  search_param_ = nullptr;
+  radius_ = 0;
+  _internal_metadata_.Clear();
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::SearchParam* Arena::CreateMaybeMessage< ::milvus::grpc::SearchParam >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::SearchParam >(arena);
+
+#if GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+const char* RangeSearchParam::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // .milvus.grpc.SearchParam search_param = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+          ptr = ctx->ParseMessage(mutable_search_param(), ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // float radius = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 21)) {
+          radius_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag, &_internal_metadata_, ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::SearchInFilesParam* Arena::CreateMaybeMessage< ::milvus::grpc::SearchInFilesParam >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::SearchInFilesParam >(arena);
+#else  // GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+bool RangeSearchParam::MergePartialFromCodedStream(
+    ::PROTOBUF_NAMESPACE_ID::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!PROTOBUF_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+  // @@protoc_insertion_point(parse_start:milvus.grpc.RangeSearchParam)
+  for (;;) {
+    ::std::pair<::PROTOBUF_NAMESPACE_ID::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // .milvus.grpc.SearchParam search_param = 1;
+      case 1: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (10 & 0xFF)) {
+          DO_(::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadMessage(
+               input, mutable_search_param()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // float radius = 2;
+      case 2: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (21 & 0xFF)) {
+
+          DO_((::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadPrimitive<
+                   float, ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, &radius_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:milvus.grpc.RangeSearchParam)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:milvus.grpc.RangeSearchParam)
+  return false;
+#undef DO_
 }
-template<> PROTOBUF_NOINLINE ::milvus::grpc::TopKQueryResult* Arena::CreateMaybeMessage< ::milvus::grpc::TopKQueryResult >(Arena* arena) {
-  return Arena::CreateInternal< ::milvus::grpc::TopKQueryResult >(arena);
+#endif  // GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+
+void RangeSearchParam::SerializeWithCachedSizes(
+    ::PROTOBUF_NAMESPACE_ID::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:milvus.grpc.RangeSearchParam)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .milvus.grpc.SearchParam search_param = 1;
+  if (this->has_search_param()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, _Internal::search_param(this), output);
+  }
+
+  // float radius = 2;
+  if (!(this->radius() <= 0 && this->radius() >= 0)) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteFloat(2, this->radius(), output);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFields(
+        _internal_metadata_.unknown_fields(), output);
+  }
+  // @@protoc_insertion_point(serialize_end:milvus.grpc.RangeSearchParam)
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* RangeSearchParam::InternalSerializeWithCachedSizesToArray(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:milvus.grpc.RangeSearchParam)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .milvus.grpc.SearchParam search_param = 1;
+  if (this->has_search_param()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        1, _Internal::search_param(this), target);
+  }
+
+  // float radius = 2;
+  if (!(this->radius() <= 0 && this->radius() >= 0)) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteFloatToArray(2, this->radius(), target);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:milvus.grpc.RangeSearchParam)
+  return target;
+}
+
+size_t RangeSearchParam::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:milvus.grpc.RangeSearchParam)
+  size_t total_size = 0;
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::ComputeUnknownFieldsSize(
+        _internal_metadata_.unknown_fields());
+  }
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // .milvus.grpc.SearchParam search_param = 1;
+  if (this->has_search_param()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *search_param_);
+  }
+
+  // float radius = 2;
+  if (!(this->radius() <= 0 && this->radius() >= 0)) {
+    total_size += 1 + 4;
+  }
+
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void RangeSearchParam::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:milvus.grpc.RangeSearchParam)
+  GOOGLE_DCHECK_NE(&from, this);
+  const RangeSearchParam* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<RangeSearchParam>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:milvus.grpc.RangeSearchParam)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:milvus.grpc.RangeSearchParam)
+    MergeFrom(*source);
+  }
+}
+
+void RangeSearchParam::MergeFrom(const RangeSearchParam& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:milvus.grpc.RangeSearchParam)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.has_search_param()) {
+    mutable_search_param()->::milvus::grpc::SearchParam::MergeFrom(from.search_param());
+  }
+  if (!(from.radius() <= 0 && from.radius() >= 0)) {
+    set_radius(from.radius());
+  }
+}
+
+void RangeSearchParam::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:milvus.grpc.RangeSearchParam)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void RangeSearchParam::CopyFrom(const RangeSearchParam& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:milvus.grpc.RangeSearchParam)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool RangeSearchParam::IsInitialized() const {
+  return true;
+}
+
+void RangeSearchParam::InternalSwap(RangeSearchParam* other) {
+  using std::swap;
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(search_param_, other->search_param_);
+  swap(radius_, other->radius_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata RangeSearchParam::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+void VectorIdentity::InitAsDefaultInstance() {
+}
+class VectorIdentity::_Internal {
+ public:
+};
+
+VectorIdentity::VectorIdentity()
+  : ::PROTOBUF_NAMESPACE_ID::Message(), _internal_metadata_(nullptr) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:milvus.grpc.VectorIdentity)
+}
+VectorIdentity::VectorIdentity(const VectorIdentity& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message(),
+      _internal_metadata_(nullptr) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  table_name_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  if (!from.table_name().empty()) {
+    table_name_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.table_name_);
+  }
+  id_ = from.id_;
+  // @@protoc_insertion_point(copy_constructor:milvus.grpc.VectorIdentity)
+}
+
+void VectorIdentity::SharedCtor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_VectorIdentity_milvus_2eproto.base);
+  table_name_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  id_ = PROTOBUF_LONGLONG(0);
+}
+
+VectorIdentity::~VectorIdentity() {
+  // @@protoc_insertion_point(destructor:milvus.grpc.VectorIdentity)
+  SharedDtor();
+}
+
+void VectorIdentity::SharedDtor() {
+  table_name_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+
+void VectorIdentity::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const VectorIdentity& VectorIdentity::default_instance() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_VectorIdentity_milvus_2eproto.base);
+  return *internal_default_instance();
+}
+
+
+void VectorIdentity::Clear() {
+// @@protoc_insertion_point(message_clear_start:milvus.grpc.VectorIdentity)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  table_name_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  id_ = PROTOBUF_LONGLONG(0);
+  _internal_metadata_.Clear();
+}
+
+#if GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+const char* VectorIdentity::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // string table_name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParserUTF8(mutable_table_name(), ptr, ctx, "milvus.grpc.VectorIdentity.table_name");
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // int64 id = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 16)) {
+          id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag, &_internal_metadata_, ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+#else  // GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+bool VectorIdentity::MergePartialFromCodedStream(
+    ::PROTOBUF_NAMESPACE_ID::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!PROTOBUF_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+  // @@protoc_insertion_point(parse_start:milvus.grpc.VectorIdentity)
+  for (;;) {
+    ::std::pair<::PROTOBUF_NAMESPACE_ID::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // string table_name = 1;
+      case 1: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (10 & 0xFF)) {
+          DO_(::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadString(
+                input, this->mutable_table_name()));
+          DO_(::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+            this->table_name().data(), static_cast<int>(this->table_name().length()),
+            ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::PARSE,
+            "milvus.grpc.VectorIdentity.table_name"));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // int64 id = 2;
+      case 2: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (16 & 0xFF)) {
+
+          DO_((::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadPrimitive<
+                   ::PROTOBUF_NAMESPACE_ID::int64, ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_INT64>(
+                 input, &id_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:milvus.grpc.VectorIdentity)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:milvus.grpc.VectorIdentity)
+  return false;
+#undef DO_
+}
+#endif  // GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+
+void VectorIdentity::SerializeWithCachedSizes(
+    ::PROTOBUF_NAMESPACE_ID::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:milvus.grpc.VectorIdentity)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string table_name = 1;
+  if (this->table_name().size() > 0) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->table_name().data(), static_cast<int>(this->table_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "milvus.grpc.VectorIdentity.table_name");
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteStringMaybeAliased(
+      1, this->table_name(), output);
+  }
+
+  // int64 id = 2;
+  if (this->id() != 0) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64(2, this->id(), output);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFields(
+        _internal_metadata_.unknown_fields(), output);
+  }
+  // @@protoc_insertion_point(serialize_end:milvus.grpc.VectorIdentity)
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* VectorIdentity::InternalSerializeWithCachedSizesToArray(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:milvus.grpc.VectorIdentity)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string table_name = 1;
+  if (this->table_name().size() > 0) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->table_name().data(), static_cast<int>(this->table_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "milvus.grpc.VectorIdentity.table_name");
+    target =
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteStringToArray(
+        1, this->table_name(), target);
+  }
+
+  // int64 id = 2;
+  if (this->id() != 0) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64ToArray(2, this->id(), target);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:milvus.grpc.VectorIdentity)
+  return target;
+}
+
+size_t VectorIdentity::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:milvus.grpc.VectorIdentity)
+  size_t total_size = 0;
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::ComputeUnknownFieldsSize(
+        _internal_metadata_.unknown_fields());
+  }
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // string table_name = 1;
+  if (this->table_name().size() > 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->table_name());
+  }
+
+  // int64 id = 2;
+  if (this->id() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int64Size(
+        this->id());
+  }
+
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void VectorIdentity::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:milvus.grpc.VectorIdentity)
+  GOOGLE_DCHECK_NE(&from, this);
+  const VectorIdentity* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<VectorIdentity>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:milvus.grpc.VectorIdentity)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:milvus.grpc.VectorIdentity)
+    MergeFrom(*source);
+  }
+}
+
+void VectorIdentity::MergeFrom(const VectorIdentity& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:milvus.grpc.VectorIdentity)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.table_name().size() > 0) {
+
+    table_name_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.table_name_);
+  }
+  if (from.id() != 0) {
+    set_id(from.id());
+  }
+}
+
+void VectorIdentity::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:milvus.grpc.VectorIdentity)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void VectorIdentity::CopyFrom(const VectorIdentity& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:milvus.grpc.VectorIdentity)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool VectorIdentity::IsInitialized() const {
+  return true;
+}
+
+void VectorIdentity::InternalSwap(VectorIdentity* other) {
+  using std::swap;
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  table_name_.Swap(&other->table_name_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
+    GetArenaNoVirtual());
+  swap(id_, other->id_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata VectorIdentity::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+void VectorData::InitAsDefaultInstance() {
+  ::milvus::grpc::_VectorData_default_instance_._instance.get_mutable()->status_ = const_cast< ::milvus::grpc::Status*>(
+      ::milvus::grpc::Status::internal_default_instance());
+  ::milvus::grpc::_VectorData_default_instance_._instance.get_mutable()->vector_data_ = const_cast< ::milvus::grpc::RowRecord*>(
+      ::milvus::grpc::RowRecord::internal_default_instance());
+}
+class VectorData::_Internal {
+ public:
+  static const ::milvus::grpc::Status& status(const VectorData* msg);
+  static const ::milvus::grpc::RowRecord& vector_data(const VectorData* msg);
+};
+
+const ::milvus::grpc::Status&
+VectorData::_Internal::status(const VectorData* msg) {
+  return *msg->status_;
+}
+const ::milvus::grpc::RowRecord&
+VectorData::_Internal::vector_data(const VectorData* msg) {
+  return *msg->vector_data_;
+}
+void VectorData::clear_status() {
+  if (GetArenaNoVirtual() == nullptr && status_ != nullptr) {
+    delete status_;
+  }
+  status_ = nullptr;
+}
+VectorData::VectorData()
+  : ::PROTOBUF_NAMESPACE_ID::Message(), _internal_metadata_(nullptr) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:milvus.grpc.VectorData)
+}
+VectorData::VectorData(const VectorData& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message(),
+      _internal_metadata_(nullptr) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  if (from.has_status()) {
+    status_ = new ::milvus::grpc::Status(*from.status_);
+  } else {
+    status_ = nullptr;
+  }
+  if (from.has_vector_data()) {
+    vector_data_ = new ::milvus::grpc::RowRecord(*from.vector_data_);
+  } else {
+    vector_data_ = nullptr;
+  }
+  // @@protoc_insertion_point(copy_constructor:milvus.grpc.VectorData)
+}
+
+void VectorData::SharedCtor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_VectorData_milvus_2eproto.base);
+  ::memset(&status_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&vector_data_) -
+      reinterpret_cast<char*>(&status_)) + sizeof(vector_data_));
+}
+
+VectorData::~VectorData() {
+  // @@protoc_insertion_point(destructor:milvus.grpc.VectorData)
+  SharedDtor();
+}
+
+void VectorData::SharedDtor() {
+  if (this != internal_default_instance()) delete status_;
+  if (this != internal_default_instance()) delete vector_data_;
+}
+
+void VectorData::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const VectorData& VectorData::default_instance() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_VectorData_milvus_2eproto.base);
+  return *internal_default_instance();
+}
+
+
+void VectorData::Clear() {
+// @@protoc_insertion_point(message_clear_start:milvus.grpc.VectorData)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  if (GetArenaNoVirtual() == nullptr && status_ != nullptr) {
+    delete status_;
+  }
+  status_ = nullptr;
+  if (GetArenaNoVirtual() == nullptr && vector_data_ != nullptr) {
+    delete vector_data_;
+  }
+  vector_data_ = nullptr;
+  _internal_metadata_.Clear();
+}
+
+#if GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+const char* VectorData::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // .milvus.grpc.Status status = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+          ptr = ctx->ParseMessage(mutable_status(), ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // .milvus.grpc.RowRecord vector_data = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 18)) {
+          ptr = ctx->ParseMessage(mutable_vector_data(), ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag, &_internal_metadata_, ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+#else  // GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+bool VectorData::MergePartialFromCodedStream(
+    ::PROTOBUF_NAMESPACE_ID::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!PROTOBUF_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+  // @@protoc_insertion_point(parse_start:milvus.grpc.VectorData)
+  for (;;) {
+    ::std::pair<::PROTOBUF_NAMESPACE_ID::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // .milvus.grpc.Status status = 1;
+      case 1: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (10 & 0xFF)) {
+          DO_(::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadMessage(
+               input, mutable_status()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // .milvus.grpc.RowRecord vector_data = 2;
+      case 2: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (18 & 0xFF)) {
+          DO_(::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadMessage(
+               input, mutable_vector_data()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:milvus.grpc.VectorData)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:milvus.grpc.VectorData)
+  return false;
+#undef DO_
+}
+#endif  // GOOGLE_PROTOBUF_ENABLE_EXPERIMENTAL_PARSER
+
+void VectorData::SerializeWithCachedSizes(
+    ::PROTOBUF_NAMESPACE_ID::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:milvus.grpc.VectorData)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .milvus.grpc.Status status = 1;
+  if (this->has_status()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, _Internal::status(this), output);
+  }
+
+  // .milvus.grpc.RowRecord vector_data = 2;
+  if (this->has_vector_data()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteMessageMaybeToArray(
+      2, _Internal::vector_data(this), output);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFields(
+        _internal_metadata_.unknown_fields(), output);
+  }
+  // @@protoc_insertion_point(serialize_end:milvus.grpc.VectorData)
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* VectorData::InternalSerializeWithCachedSizesToArray(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:milvus.grpc.VectorData)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .milvus.grpc.Status status = 1;
+  if (this->has_status()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        1, _Internal::status(this), target);
+  }
+
+  // .milvus.grpc.RowRecord vector_data = 2;
+  if (this->has_vector_data()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        2, _Internal::vector_data(this), target);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:milvus.grpc.VectorData)
+  return target;
+}
+
+size_t VectorData::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:milvus.grpc.VectorData)
+  size_t total_size = 0;
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::ComputeUnknownFieldsSize(
+        _internal_metadata_.unknown_fields());
+  }
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // .milvus.grpc.Status status = 1;
+  if (this->has_status()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *status_);
+  }
+
+  // .milvus.grpc.RowRecord vector_data = 2;
+  if (this->has_vector_data()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *vector_data_);
+  }
+
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void VectorData::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:milvus.grpc.VectorData)
+  GOOGLE_DCHECK_NE(&from, this);
+  const VectorData* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<VectorData>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:milvus.grpc.VectorData)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:milvus.grpc.VectorData)
+    MergeFrom(*source);
+  }
+}
+
+void VectorData::MergeFrom(const VectorData& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:milvus.grpc.VectorData)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.has_status()) {
+    mutable_status()->::milvus::grpc::Status::MergeFrom(from.status());
+  }
+  if (from.has_vector_data()) {
+    mutable_vector_data()->::milvus::grpc::RowRecord::MergeFrom(from.vector_data());
+  }
+}
+
+void VectorData::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:milvus.grpc.VectorData)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void VectorData::CopyFrom(const VectorData& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:milvus.grpc.VectorData)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool VectorData::IsInitialized() const {
+  return true;
+}
+
+void VectorData::InternalSwap(VectorData* other) {
+  using std::swap;
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(status_, other->status_);
+  swap(vector_data_, other->vector_data_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata VectorData::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace grpc
+}  // namespace milvus
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::milvus::grpc::TableName* Arena::CreateMaybeMessage< ::milvus::grpc::TableName >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::TableName >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::PartitionName* Arena::CreateMaybeMessage< ::milvus::grpc::PartitionName >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::PartitionName >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::TableNameList* Arena::CreateMaybeMessage< ::milvus::grpc::TableNameList >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::TableNameList >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::TableSchema* Arena::CreateMaybeMessage< ::milvus::grpc::TableSchema >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::TableSchema >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::PartitionParam* Arena::CreateMaybeMessage< ::milvus::grpc::PartitionParam >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::PartitionParam >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::PartitionList* Arena::CreateMaybeMessage< ::milvus::grpc::PartitionList >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::PartitionList >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::Range* Arena::CreateMaybeMessage< ::milvus::grpc::Range >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::Range >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::RowRecord* Arena::CreateMaybeMessage< ::milvus::grpc::RowRecord >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::RowRecord >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::InsertParam* Arena::CreateMaybeMessage< ::milvus::grpc::InsertParam >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::InsertParam >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::VectorIds* Arena::CreateMaybeMessage< ::milvus::grpc::VectorIds >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::VectorIds >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::SearchParam* Arena::CreateMaybeMessage< ::milvus::grpc::SearchParam >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::SearchParam >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::SearchInFilesParam* Arena::CreateMaybeMessage< ::milvus::grpc::SearchInFilesParam >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::SearchInFilesParam >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::TopKQueryResult* Arena::CreateMaybeMessage< ::milvus::grpc::TopKQueryResult >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::TopKQueryResult >(arena);
 }
 template<> PROTOBUF_NOINLINE ::milvus::grpc::StringReply* Arena::CreateMaybeMessage< ::milvus::grpc::StringReply >(Arena* arena) {
   return Arena::CreateInternal< ::milvus::grpc::StringReply >(arena);
@@ -7858,6 +9006,15 @@ template<> PROTOBUF_NOINLINE ::milvus::grpc::IndexParam* Arena::CreateMaybeMessa
 template<> PROTOBUF_NOINLINE ::milvus::grpc::DeleteByDateParam* Arena::CreateMaybeMessage< ::milvus::grpc::DeleteByDateParam >(Arena* arena) {
   return Arena::CreateInternal< ::milvus::grpc::DeleteByDateParam >(arena);
 }
+template<> PROTOBUF_NOINLINE ::milvus::grpc::RangeSearchParam* Arena::CreateMaybeMessage< ::milvus::grpc::RangeSearchParam >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::RangeSearchParam >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::VectorIdentity* Arena::CreateMaybeMessage< ::milvus::grpc::VectorIdentity >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::VectorIdentity >(arena);
+}
+template<> PROTOBUF_NOINLINE ::milvus::grpc::VectorData* Arena::CreateMaybeMessage< ::milvus::grpc::VectorData >(Arena* arena) {
+  return Arena::CreateInternal< ::milvus::grpc::VectorData >(arena);
+}
 PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
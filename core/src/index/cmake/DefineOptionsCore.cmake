@@ -81,6 +81,8 @@ define_option(KNOWHERE_WITH_FAISS_GPU_VERSION "Build with FAISS GPU version" ON)
 
 define_option(FAISS_WITH_MKL "Build FAISS with MKL" OFF)
 
+define_option(FAISS_WITH_AVX512 "Build FAISS binary distances with AVX-512 VPOPCNTDQ" OFF)
+
 #----------------------------------------------------------------------
 set_option_category("Test and benchmark")
 
@@ -434,10 +434,16 @@ macro(build_faiss)
     set(FAISS_STATIC_LIB
             "${FAISS_PREFIX}/lib/${CMAKE_STATIC_LIBRARY_PREFIX}faiss${CMAKE_STATIC_LIBRARY_SUFFIX}")
 
+    set(FAISS_CXX_FLAGS "${EP_CXX_FLAGS} -mavx2 -mf16c -O3")
+    if (FAISS_WITH_AVX512)
+        # Hamming and Jaccard kernels of 512 and 1024 bit codes use VPOPCNTQ
+        set(FAISS_CXX_FLAGS "${FAISS_CXX_FLAGS} -mavx512f -mavx512vpopcntdq")
+    endif ()
+
     set(FAISS_CONFIGURE_ARGS
             "--prefix=${FAISS_PREFIX}"
             "CFLAGS=${EP_C_FLAGS}"
-            "CXXFLAGS=${EP_CXX_FLAGS} -mavx2 -mf16c -O3"
+            "CXXFLAGS=${FAISS_CXX_FLAGS}"
             --without-python)
 
     if (FAISS_WITH_MKL)
@@ -19,16 +19,20 @@ ConvertToMetadataSet(const DatasetPtr& dataset) {
     auto elems = dataset->Get<int64_t>(meta::ROWS);
     auto p_data = dataset->Get<const int64_t*>(meta::IDS);
 
-    auto p_offset = (int64_t*)malloc(sizeof(int64_t) * elems);
-    for (auto i = 0; i <= elems; ++i) p_offset[i] = i * 8;
+    // MemMetadataSet reads elems + 1 offsets, the last one is the end of the ids
+    size_t offset_size = sizeof(int64_t) * (elems + 1);
+    auto p_offset_bytes = new std::uint8_t[offset_size];
+    auto p_offset = reinterpret_cast<int64_t*>(p_offset_bytes);
+    for (auto i = 0; i <= elems; ++i) p_offset[i] = i * sizeof(int64_t);
 
     std::shared_ptr<SPTAG::MetadataSet> metaset(
         new SPTAG::MemMetadataSet(SPTAG::ByteArray((std::uint8_t*)p_data, elems * sizeof(int64_t), false),
-                                  SPTAG::ByteArray((std::uint8_t*)p_offset, elems * sizeof(int64_t), true), elems));
+                                  SPTAG::ByteArray(p_offset_bytes, offset_size, true), elems));
 
     return metaset;
 }
 
+// the vector set refers to the tensor of the dataset, SPTAG copies it once into its own aligned storage
 std::shared_ptr<SPTAG::VectorSet>
 ConvertToVectorSet(const DatasetPtr& dataset) {
     GETTENSOR(dataset);
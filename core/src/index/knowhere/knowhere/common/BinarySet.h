@@ -25,6 +25,9 @@ struct Binary {
     ID id;
     std::shared_ptr<uint8_t> data;
     int64_t size = 0;
+    // data is mapped from a file, the index may leave it there to be paged in as it's searched;
+    // cleared by the loader if the index copied it after all
+    bool lazy = false;
 };
 using BinaryPtr = std::shared_ptr<Binary>;
 
@@ -34,11 +34,17 @@ constexpr int64_t DEFAULT_DIM = INVALID_VALUE;
 constexpr int64_t DEFAULT_GPUID = INVALID_VALUE;
 constexpr METRICTYPE DEFAULT_TYPE = METRICTYPE::INVALID;
 
+class IDFilter;
+using IDFilterPtr = std::shared_ptr<IDFilter>;
+
 struct Cfg {
     METRICTYPE metric_type = DEFAULT_TYPE;
     int64_t k = DEFAULT_K;
     int64_t gpu_id = DEFAULT_GPUID;
     int64_t d = DEFAULT_DIM;
+    IDFilterPtr filter = nullptr;  // search only, restrict the result to the ids accepted by the filter
+    int64_t row_begin = 0;         // search only, first row of a flat index searched
+    int64_t row_end = -1;          // search only, end of the rows of a flat index searched, all rows if negative
 
     Cfg(const int64_t& dim, const int64_t& k, const int64_t& gpu_id, METRICTYPE type)
         : metric_type(type), k(k), gpu_id(gpu_id), d(dim) {
@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/impl/FaissException.h>
+#include <faiss/index_io.h>
+
+#include <memory>
+#include <utility>
+
+#include "knowhere/adapter/VectorAdapter.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/index/preprocessor/Rotation.h"
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
+
+namespace knowhere {
+
+namespace {
+
+// keeps the rotated vectors alive as long as the dataset pointing to them
+constexpr const char* ROTATED_BUFFER = "rotated_buffer";
+
+}  // namespace
+
+RotationPreprocessor::RotationPreprocessor(std::shared_ptr<faiss::LinearTransform> transform)
+    : transform_(std::move(transform)) {
+}
+
+std::shared_ptr<RotationPreprocessor>
+RotationPreprocessor::Train(ROTATIONTYPE type, int64_t rows, int64_t dim, const float* data, int64_t m) {
+    std::shared_ptr<faiss::LinearTransform> transform;
+    try {
+        switch (type) {
+            case ROTATIONTYPE::OPQ: {
+                if (m <= 0 || dim % m != 0) {
+                    KNOWHERE_THROW_MSG("OPQ rotation needs the dimension to be a multiple of the pq subvectors");
+                }
+                transform = std::make_shared<faiss::OPQMatrix>(dim, m);
+                break;
+            }
+            case ROTATIONTYPE::PCA: {
+                auto pca = std::make_shared<faiss::PCAMatrix>(dim, dim);
+                pca->have_bias = false;  // not centered, a translation would change inner products
+                transform = pca;
+                break;
+            }
+            default:
+                KNOWHERE_THROW_MSG("rotation type not supported");
+        }
+        transform->train(rows, data);
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+
+    KNOWHERE_LOG_DEBUG << "Rotation " << int(type) << " trained with " << rows << " rows";
+    return std::make_shared<RotationPreprocessor>(transform);
+}
+
+DatasetPtr
+RotationPreprocessor::Preprocess(const DatasetPtr& input) {
+    GETTENSOR(input)
+    if (dim != transform_->d_in) {
+        KNOWHERE_THROW_MSG("dimension of the vectors doesn't match the rotation");
+    }
+
+    std::shared_ptr<float> rotated(new float[rows * dim], std::default_delete<float[]>());
+    transform_->apply_noalloc(rows, p_data, rotated.get());
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::ROWS, rows);
+    ret_ds->Set(meta::DIM, dim);
+    ret_ds->Set(meta::TENSOR, (const float*)rotated.get());
+    if (input->data().count(meta::IDS) != 0) {
+        ret_ds->Set(meta::IDS, input->Get<const int64_t*>(meta::IDS));
+    }
+    ret_ds->Set(ROTATED_BUFFER, rotated);
+    return ret_ds;
+}
+
+BinaryPtr
+RotationPreprocessor::Serialize() const {
+    try {
+        MemoryIOWriter writer;
+        faiss::write_VectorTransform(transform_.get(), &writer);
+
+        auto binary = std::make_shared<Binary>();
+        binary->data.reset(writer.data_);
+        binary->size = writer.rp;
+        return binary;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+std::shared_ptr<RotationPreprocessor>
+RotationPreprocessor::Load(const BinaryPtr& binary) {
+    MemoryIOReader reader;
+    reader.total = binary->size;
+    reader.data_ = binary->data.get();
+
+    std::shared_ptr<faiss::LinearTransform> transform;
+    try {
+        auto vt = faiss::read_VectorTransform(&reader);
+        transform.reset(dynamic_cast<faiss::LinearTransform*>(vt));
+        if (transform == nullptr) {
+            delete vt;
+            KNOWHERE_THROW_MSG("rotation binary doesn't hold a linear transform");
+        }
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+    return std::make_shared<RotationPreprocessor>(transform);
+}
+
+}  // namespace knowhere
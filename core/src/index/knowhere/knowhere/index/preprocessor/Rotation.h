@@ -0,0 +1,53 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <faiss/VectorTransform.h>
+
+#include <memory>
+
+#include "knowhere/common/BinarySet.h"
+#include "knowhere/index/preprocessor/Preprocessor.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace knowhere {
+
+/*
+ * Orthonormal rotation of the vectors, OPQ or PCA without dimension reduction and without centering. Distances
+ * and inner products of rotated vectors are those of the raw vectors, so the results of a rotated index can be
+ * merged with the ones of other indexes.
+ */
+class RotationPreprocessor : public Preprocessor {
+ public:
+    explicit RotationPreprocessor(std::shared_ptr<faiss::LinearTransform> transform);
+
+    // train a rotation of dim dimension vectors, m is the number of pq subvectors the OPQ rotation balances
+    static std::shared_ptr<RotationPreprocessor>
+    Train(ROTATIONTYPE type, int64_t rows, int64_t dim, const float* data, int64_t m);
+
+    // the returned dataset owns the rotated vectors, the ids are shared with the input
+    DatasetPtr
+    Preprocess(const DatasetPtr& input) override;
+
+    BinaryPtr
+    Serialize() const;
+
+    static std::shared_ptr<RotationPreprocessor>
+    Load(const BinaryPtr& binary);
+
+ private:
+    std::shared_ptr<faiss::LinearTransform> transform_;
+};
+
+using RotationPreprocessorPtr = std::shared_ptr<RotationPreprocessor>;
+
+}  // namespace knowhere
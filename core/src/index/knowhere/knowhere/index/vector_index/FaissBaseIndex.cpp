@@ -11,8 +11,12 @@
 
 #include <faiss/index_io.h>
 #include <fiu-local.h>
+#include <algorithm>
+#include <limits>
 #include <utility>
+#include <vector>
 
+#include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/FaissBaseIndex.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
@@ -53,11 +57,26 @@ FaissBaseIndex::LoadImpl(const BinarySet& index_binary) {
     reader.total = binary->size;
     reader.data_ = binary->data.get();
 
-    faiss::Index* index = faiss::read_index(&reader);
+    int io_flags = 0;
+#ifdef CUSTOMIZATION
+    // the lists are sealed at once, codes stay in the binary, which the lists hold after it leaves the set
+    reader.owner = binary->data;
+    io_flags = faiss::IO_FLAG_READONLY_LISTS;
+#endif
+    faiss::Index* index = faiss::read_index(&reader, io_flags);
 
     index_.reset(index);
 
     SealImpl();
+
+#ifdef CUSTOMIZATION
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index);
+    if (binary->lazy && (ivf_index == nullptr || !faiss::make_lists_lazy(ivf_index->invlists))) {
+        binary->lazy = false;
+    }
+#else
+    binary->lazy = false;
+#endif
 }
 
 void
@@ -74,4 +93,44 @@ FaissBaseIndex::SealImpl() {
 #endif
 }
 
+DatasetPtr
+FaissBaseIndex::GenRangeResult(const faiss::RangeSearchResult& result, int64_t max_results, bool ascending) {
+    auto elems = result.nq * max_results;
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * elems);
+    auto p_dist = (float*)malloc(sizeof(float) * elems);
+
+    std::vector<size_t> order;
+    for (size_t i = 0; i < result.nq; ++i) {
+        auto begin = result.lims[i];
+        auto count = result.lims[i + 1] - begin;
+        order.resize(count);
+        for (size_t j = 0; j < count; ++j) {
+            order[j] = begin + j;
+        }
+
+        // faiss doesn't sort range results, only the kept part needs to be ordered
+        auto keep = std::min(count, (size_t)max_results);
+        auto compare = [&](size_t l, size_t r) {
+            return ascending ? result.distances[l] < result.distances[r] : result.distances[l] > result.distances[r];
+        };
+        std::partial_sort(order.begin(), order.begin() + keep, order.end(), compare);
+
+        auto row_id = p_id + i * max_results;
+        auto row_dist = p_dist + i * max_results;
+        for (size_t j = 0; j < keep; ++j) {
+            row_id[j] = result.labels[order[j]];
+            row_dist[j] = result.distances[order[j]];
+        }
+        for (auto j = (int64_t)keep; j < max_results; ++j) {
+            row_id[j] = -1;
+            row_dist[j] = ascending ? std::numeric_limits<float>::max() : std::numeric_limits<float>::lowest();
+        }
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
 }  // namespace knowhere
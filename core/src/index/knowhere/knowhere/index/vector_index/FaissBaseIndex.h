@@ -14,8 +14,10 @@
 #include <memory>
 
 #include <faiss/Index.h>
+#include <faiss/impl/AuxIndexStructures.h>
 
 #include "knowhere/common/BinarySet.h"
+#include "knowhere/common/Dataset.h"
 
 namespace knowhere {
 
@@ -32,6 +34,10 @@ class FaissBaseIndex {
     virtual void
     SealImpl();
 
+    // keep the nearest max_results hits of each query, rows are padded with -1 to max_results
+    static DatasetPtr
+    GenRangeResult(const faiss::RangeSearchResult& result, int64_t max_results, bool ascending);
+
  public:
     std::shared_ptr<faiss::Index> index_ = nullptr;
 };
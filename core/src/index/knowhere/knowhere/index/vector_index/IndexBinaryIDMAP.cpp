@@ -13,6 +13,7 @@
 #include <faiss/MetaIndexes.h>
 
 #include <faiss/index_factory.h>
+#include <faiss/index_io.h>
 
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
@@ -30,6 +31,20 @@ BinaryIDMAP::Serialize() {
     return SerializeImpl();
 }
 
+void
+BinaryIDMAP::SerializeTo(faiss::IOWriter* writer) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    try {
+        faiss::write_index_binary(index_.get(), writer);
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 void
 BinaryIDMAP::Load(const BinarySet& index_binary) {
     std::lock_guard<std::mutex> lk(mutex_);
@@ -132,6 +147,19 @@ BinaryIDMAP::GetRawIds() {
     }
 }
 
+void
+BinaryIDMAP::Reserve(int64_t n) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto file_index = dynamic_cast<faiss::IndexBinaryIDMap*>(index_.get());
+    auto flat_index = (file_index == nullptr) ? nullptr : dynamic_cast<faiss::IndexBinaryFlat*>(file_index->index);
+    if (flat_index == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    flat_index->xb.reserve(n * flat_index->code_size);
+    file_index->id_map.reserve(n);
+}
+
 void
 BinaryIDMAP::Seal() {
     // do nothing
@@ -16,6 +16,8 @@
 #include <utility>
 #include <vector>
 
+#include <faiss/impl/io.h>
+
 #include "FaissBaseBinaryIndex.h"
 #include "VectorIndex.h"
 
@@ -32,6 +34,10 @@ class BinaryIDMAP : public VectorIndex, public FaissBaseBinaryIndex {
     BinarySet
     Serialize() override;
 
+    // write the serialized index straight to writer, there is no copy of it in memory as by Serialize()
+    void
+    SerializeTo(faiss::IOWriter* writer);
+
     void
     Load(const BinarySet& index_binary) override;
 
@@ -59,6 +65,10 @@ class BinaryIDMAP : public VectorIndex, public FaissBaseBinaryIndex {
     const int64_t*
     GetRawIds();
 
+    // reserve memory for n vectors, avoid reallocation when vectors are added incrementally
+    void
+    Reserve(int64_t n);
+
  protected:
     virtual void
     search_impl(int64_t n, const uint8_t* data, int64_t k, float* distances, int64_t* labels, const Config& cfg);
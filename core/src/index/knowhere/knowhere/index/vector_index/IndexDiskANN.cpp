@@ -0,0 +1,684 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/IndexDiskANN.h"
+
+#include <aio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <faiss/index_io.h>
+#include <faiss/utils/distances.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+#include <utility>
+
+#include "knowhere/adapter/VectorAdapter.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
+
+namespace knowhere {
+
+namespace {
+
+constexpr uint64_t DISKANN_MAGIC = 0x4e4e414b534944;  // "DISKANN"
+constexpr int64_t PQ_TRAIN_SIZE = 65536;
+constexpr size_t WRITE_BATCH = 1 << 20;
+
+struct Candidate {
+    float distance;
+    uint32_t id;
+    bool expanded;
+};
+
+// the nearest candidates met by a search, at most capacity of them sorted by distance
+class CandidateList {
+ public:
+    explicit CandidateList(size_t capacity) : capacity_(capacity) {
+        list_.reserve(capacity + 1);
+    }
+
+    void
+    Insert(float distance, uint32_t id) {
+        if (list_.size() >= capacity_ && distance >= list_.back().distance) {
+            return;
+        }
+        auto pos = std::upper_bound(list_.begin(), list_.end(), distance,
+                                    [](float d, const Candidate& c) { return d < c.distance; });
+        list_.insert(pos, Candidate{distance, id, false});
+        if (list_.size() > capacity_) {
+            list_.pop_back();
+        }
+    }
+
+    // the nearest candidate not expanded yet, marked as expanded, -1 if there is none
+    int64_t
+    PopUnexpanded() {
+        for (auto& candidate : list_) {
+            if (!candidate.expanded) {
+                candidate.expanded = true;
+                return candidate.id;
+            }
+        }
+        return -1;
+    }
+
+ private:
+    size_t capacity_;
+    std::vector<Candidate> list_;
+};
+
+struct AlignedFree {
+    void
+    operator()(void* ptr) const {
+        free(ptr);
+    }
+};
+using AlignedBuffer = std::unique_ptr<uint8_t, AlignedFree>;
+
+AlignedBuffer
+AllocAligned(size_t size) {
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, IndexDiskANN::SECTOR_SIZE, size) != 0) {
+        KNOWHERE_THROW_MSG("DiskANN failed to allocate aligned buffer");
+    }
+    return AlignedBuffer(static_cast<uint8_t*>(ptr));
+}
+
+void
+WriteAll(int fd, const uint8_t* data, size_t size, const std::string& path) {
+    while (size > 0) {
+        auto written = ::write(fd, data, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            KNOWHERE_THROW_MSG("DiskANN failed to write " + path + ": " + strerror(errno));
+        }
+        data += written;
+        size -= written;
+    }
+}
+
+// the neighbors kept of candidates for node p: going from the nearest one, a candidate is dropped if some kept
+// neighbor is closer to it than p by a factor of alpha, compared as squared l2 with alpha2 = alpha * alpha
+std::vector<uint32_t>
+RobustPrune(const float* data, int64_t dim, uint32_t p, const std::vector<uint32_t>& candidates, float alpha2,
+            size_t max_degree) {
+    auto distance = faiss::fvec_L2sqr_kernel(dim);
+    const float* xp = data + p * dim;
+
+    std::vector<std::pair<float, uint32_t>> pool;
+    pool.reserve(candidates.size());
+    for (auto c : candidates) {
+        if (c != p) {
+            pool.emplace_back(distance(xp, data + c * dim, dim), c);
+        }
+    }
+    // duplicates have the same distance, so sorting makes them neighbors
+    std::sort(pool.begin(), pool.end());
+    pool.erase(std::unique(pool.begin(), pool.end()), pool.end());
+
+    std::vector<uint32_t> result;
+    std::vector<bool> occluded(pool.size(), false);
+    for (size_t i = 0; i < pool.size() && result.size() < max_degree; i++) {
+        if (occluded[i]) {
+            continue;
+        }
+        result.push_back(pool[i].second);
+        const float* xi = data + pool[i].second * dim;
+        for (size_t j = i + 1; j < pool.size(); j++) {
+            if (!occluded[j] && alpha2 * distance(xi, data + pool[j].second * dim, dim) <= pool[j].first) {
+                occluded[j] = true;
+            }
+        }
+    }
+    return result;
+}
+
+// the nodes expanded by a greedy search of query from start, the graph changes meanwhile so neighbor lists are
+// copied under the locks of nodes
+void
+GreedySearch(const float* data, int64_t dim, const std::vector<std::vector<uint32_t>>& graph,
+             std::vector<std::mutex>& locks, uint32_t start, const float* query, size_t list_size,
+             std::vector<uint32_t>& expanded) {
+    auto distance = faiss::fvec_L2sqr_kernel(dim);
+    CandidateList list(list_size);
+    std::unordered_set<uint32_t> visited;
+    list.Insert(distance(query, data + start * dim, dim), start);
+    visited.insert(start);
+
+    std::vector<uint32_t> neighbors;
+    int64_t p;
+    while ((p = list.PopUnexpanded()) >= 0) {
+        expanded.push_back(p);
+        {
+            std::lock_guard<std::mutex> lk(locks[p]);
+            neighbors = graph[p];
+        }
+        for (auto n : neighbors) {
+            if (visited.insert(n).second) {
+                list.Insert(distance(query, data + n * dim, dim), n);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+IndexDiskANN::~IndexDiskANN() {
+    CloseDisk();
+}
+
+BinarySet
+IndexDiskANN::Serialize() {
+    if (!pq_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    try {
+        // the path of disk file at build follows the meta, a loader giving DISKANN_DISK_PATH overrides it
+        size_t meta_size = sizeof(Meta) + disk_path_.size();
+        std::shared_ptr<uint8_t> meta(new uint8_t[meta_size], std::default_delete<uint8_t[]>());
+        memcpy(meta.get(), &meta_, sizeof(Meta));
+        memcpy(meta.get() + sizeof(Meta), disk_path_.data(), disk_path_.size());
+
+        MemoryIOWriter writer;
+        faiss::write_ProductQuantizer(pq_.get(), &writer);
+        std::shared_ptr<uint8_t> pq_data(writer.data_, std::default_delete<uint8_t[]>());
+
+        BinarySet res_set;
+        res_set.Append("DISKANN_META", meta, meta_size);
+        res_set.Append("DISKANN_PQ", pq_data, writer.rp);
+        res_set.Append("DISKANN_CODES", codes_);
+        return res_set;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+IndexDiskANN::Load(const BinarySet& index_binary) {
+    try {
+        auto& binaries = index_binary.binary_map_;
+        if (binaries.count("DISKANN_META") == 0 || binaries.count("DISKANN_PQ") == 0 ||
+            binaries.count("DISKANN_CODES") == 0) {
+            KNOWHERE_THROW_MSG("DiskANN index is incomplete");
+        }
+
+        auto meta = index_binary.GetByName("DISKANN_META");
+        if (meta == nullptr || meta->size < static_cast<int64_t>(sizeof(Meta))) {
+            KNOWHERE_THROW_MSG("DiskANN meta is broken");
+        }
+        memcpy(&meta_, meta->data.get(), sizeof(Meta));
+        disk_path_.assign(reinterpret_cast<const char*>(meta->data.get()) + sizeof(Meta), meta->size - sizeof(Meta));
+
+        // the disk file goes along with the index file, which may be moved or linked into another table
+        if (binaries.count(DISK_PATH_BINARY_NAME) != 0) {
+            auto path = index_binary.GetByName(DISK_PATH_BINARY_NAME);
+            disk_path_.assign(reinterpret_cast<const char*>(path->data.get()), path->size);
+        }
+
+        auto pq_binary = index_binary.GetByName("DISKANN_PQ");
+        if (pq_binary == nullptr || pq_binary->data == nullptr) {
+            KNOWHERE_THROW_MSG("DiskANN pq is broken");
+        }
+        MemoryIOReader reader;
+        reader.total = pq_binary->size;
+        reader.data_ = pq_binary->data.get();
+        pq_.reset(faiss::read_ProductQuantizer(&reader));
+
+        // the codes are used where they are, a mapped index file is not copied
+        codes_ = index_binary.GetByName("DISKANN_CODES");
+        if (codes_ == nullptr || codes_->size != meta_.ntotal * static_cast<int64_t>(pq_->code_size)) {
+            KNOWHERE_THROW_MSG("DiskANN codes are broken");
+        }
+
+        OpenDisk();
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+IndexModelPtr
+IndexDiskANN::Train(const DatasetPtr& dataset, const Config& config) {
+    auto build_cfg = std::dynamic_pointer_cast<DiskANNCfg>(config);
+    if (build_cfg == nullptr) {
+        KNOWHERE_THROW_MSG("DiskANN needs a DiskANNCfg to build");
+    }
+    build_cfg->CheckValid();  // throw exception
+    if (build_cfg->disk_path.empty()) {
+        KNOWHERE_THROW_MSG("DiskANN needs a disk_path to write the graph");
+    }
+    build_cfg_ = build_cfg;
+    return nullptr;
+}
+
+void
+IndexDiskANN::Add(const DatasetPtr& dataset, const Config& config) {
+    if (!build_cfg_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    if (pq_) {
+        KNOWHERE_THROW_MSG("DiskANN graph is built of all vectors at once, it can't be added to");
+    }
+
+    GETTENSOR(dataset)
+    auto p_ids = dataset->Get<const int64_t*>(meta::IDS);
+    if (rows <= 0 || rows > std::numeric_limits<uint32_t>::max()) {
+        KNOWHERE_THROW_MSG("DiskANN row count is out of range");
+    }
+
+    meta_.dim = dim;
+    meta_.ntotal = rows;
+    meta_.max_degree = std::min<int64_t>(build_cfg_->max_degree, rows - 1);
+    meta_.beam_width = build_cfg_->beam_width;
+    meta_.default_search_list = build_cfg_->search_list > 0 ? build_cfg_->search_list : build_cfg_->build_list;
+    auto graph = BuildGraph(p_data, rows);
+
+    // codes of 8 bits pq, the training set is tiled when there are less vectors than centroids
+    auto pq = std::make_shared<faiss::ProductQuantizer>(dim, build_cfg_->pq_m, 8);
+    int64_t train_rows = std::max<int64_t>(std::min(rows, PQ_TRAIN_SIZE), pq->ksub);
+    std::vector<float> train_data(train_rows * dim);
+    std::mt19937 rng(rows);
+    for (int64_t i = 0; i < train_rows; i++) {
+        int64_t from = (rows > PQ_TRAIN_SIZE) ? rng() % rows : i % rows;
+        memcpy(train_data.data() + i * dim, p_data + from * dim, dim * sizeof(float));
+    }
+    pq->train(train_rows, train_data.data());
+
+    auto codes = std::make_shared<Binary>();
+    codes->size = rows * pq->code_size;
+    codes->data = std::shared_ptr<uint8_t>(new uint8_t[codes->size], std::default_delete<uint8_t[]>());
+    pq->compute_codes(p_data, codes->data.get(), rows);
+
+    disk_path_ = build_cfg_->disk_path;
+    WriteDisk(p_data, p_ids, graph);
+    OpenDisk();
+    codes_ = codes;
+    pq_ = pq;
+}
+
+std::vector<std::vector<uint32_t>>
+IndexDiskANN::BuildGraph(const float* data, int64_t rows) {
+    int64_t dim = meta_.dim;
+    size_t max_degree = meta_.max_degree;
+    size_t build_list = build_cfg_->build_list;
+    auto distance = faiss::fvec_L2sqr_kernel(dim);
+
+    // the medoid is the entry of every search, the vector nearest to the centroid
+    std::vector<float> centroid(dim, 0);
+    for (int64_t i = 0; i < rows; i++) {
+        for (int64_t j = 0; j < dim; j++) {
+            centroid[j] += data[i * dim + j];
+        }
+    }
+    for (auto& v : centroid) {
+        v /= rows;
+    }
+    float nearest = std::numeric_limits<float>::max();
+    for (int64_t i = 0; i < rows; i++) {
+        float dis = distance(centroid.data(), data + i * dim, dim);
+        if (dis < nearest) {
+            nearest = dis;
+            meta_.medoid = i;
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> graph(rows);
+    std::vector<std::mutex> locks(rows);
+#pragma omp parallel for
+    for (int64_t i = 0; i < rows; i++) {
+        std::mt19937 rng(i);
+        std::unordered_set<uint32_t> picked;
+        while (picked.size() < max_degree) {
+            uint32_t n = rng() % rows;
+            if (n != i) {
+                picked.insert(n);
+            }
+        }
+        graph[i].assign(picked.begin(), picked.end());
+    }
+
+    std::vector<uint32_t> order(rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(rows));
+
+    // the first pass prunes with alpha 1 for a sparse graph, the second one adds the long edges of alpha
+    for (float alpha : {1.0f, build_cfg_->alpha}) {
+        float alpha2 = alpha * alpha;
+#pragma omp parallel for schedule(dynamic, 64)
+        for (int64_t k = 0; k < rows; k++) {
+            uint32_t p = order[k];
+            std::vector<uint32_t> candidates;
+            GreedySearch(data, dim, graph, locks, meta_.medoid, data + p * dim, build_list, candidates);
+            {
+                std::lock_guard<std::mutex> lk(locks[p]);
+                candidates.insert(candidates.end(), graph[p].begin(), graph[p].end());
+            }
+            auto neighbors = RobustPrune(data, dim, p, candidates, alpha2, max_degree);
+            {
+                std::lock_guard<std::mutex> lk(locks[p]);
+                graph[p] = neighbors;
+            }
+
+            // reverse edges, a full neighbor list is pruned again
+            for (auto n : neighbors) {
+                std::lock_guard<std::mutex> lk(locks[n]);
+                auto& list = graph[n];
+                if (std::find(list.begin(), list.end(), p) != list.end()) {
+                    continue;
+                }
+                if (list.size() < max_degree) {
+                    list.push_back(p);
+                } else {
+                    std::vector<uint32_t> reverse(list);
+                    reverse.push_back(p);
+                    list = RobustPrune(data, dim, n, reverse, alpha2, max_degree);
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+void
+IndexDiskANN::WriteDisk(const float* data, const int64_t* ids, const std::vector<std::vector<uint32_t>>& graph) {
+    int64_t dim = meta_.dim;
+    meta_.node_size = dim * sizeof(float) + sizeof(int64_t) + sizeof(uint32_t) + meta_.max_degree * sizeof(uint32_t);
+    if (meta_.node_size <= static_cast<int64_t>(SECTOR_SIZE)) {
+        meta_.nodes_per_sector = SECTOR_SIZE / meta_.node_size;
+        meta_.sectors_per_node = 1;
+    } else {
+        meta_.nodes_per_sector = 0;
+        meta_.sectors_per_node = (meta_.node_size + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    }
+
+    int fd = ::open(disk_path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        KNOWHERE_THROW_MSG("DiskANN failed to create " + disk_path_ + ": " + strerror(errno));
+    }
+
+    try {
+        std::vector<uint8_t> header(SECTOR_SIZE, 0);
+        memcpy(header.data(), &DISKANN_MAGIC, sizeof(DISKANN_MAGIC));
+        memcpy(header.data() + sizeof(DISKANN_MAGIC), &meta_, sizeof(Meta));
+        WriteAll(fd, header.data(), header.size(), disk_path_);
+
+        // nodes are put in blocks, a sector of nodes_per_sector nodes or the sectors of one node
+        size_t block_size = meta_.sectors_per_node * SECTOR_SIZE;
+        int64_t nodes_per_block = std::max<int64_t>(meta_.nodes_per_sector, 1);
+        int64_t blocks = (meta_.ntotal + nodes_per_block - 1) / nodes_per_block;
+        int64_t blocks_per_batch = std::max<int64_t>(WRITE_BATCH / block_size, 1);
+
+        std::vector<uint8_t> batch(blocks_per_batch * block_size);
+        for (int64_t first = 0; first < blocks; first += blocks_per_batch) {
+            int64_t count = std::min(blocks_per_batch, blocks - first);
+            std::fill(batch.begin(), batch.end(), 0);
+            for (int64_t b = 0; b < count; b++) {
+                for (int64_t j = 0; j < nodes_per_block; j++) {
+                    int64_t node = (first + b) * nodes_per_block + j;
+                    if (node >= meta_.ntotal) {
+                        break;
+                    }
+                    uint8_t* dst = batch.data() + b * block_size + j * meta_.node_size;
+                    uint32_t degree = graph[node].size();
+                    memcpy(dst, data + node * dim, dim * sizeof(float));
+                    dst += dim * sizeof(float);
+                    memcpy(dst, ids + node, sizeof(int64_t));
+                    dst += sizeof(int64_t);
+                    memcpy(dst, &degree, sizeof(uint32_t));
+                    dst += sizeof(uint32_t);
+                    memcpy(dst, graph[node].data(), degree * sizeof(uint32_t));
+                }
+            }
+            WriteAll(fd, batch.data(), count * block_size, disk_path_);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+
+    if (::fsync(fd) != 0 || ::close(fd) != 0) {
+        KNOWHERE_THROW_MSG("DiskANN failed to flush " + disk_path_ + ": " + strerror(errno));
+    }
+}
+
+void
+IndexDiskANN::OpenDisk() {
+    CloseDisk();
+
+    // reads bypass the page cache, the file system may not support it
+    fd_ = ::open(disk_path_.c_str(), O_RDONLY | O_DIRECT);
+    if (fd_ < 0) {
+        fd_ = ::open(disk_path_.c_str(), O_RDONLY);
+    }
+    if (fd_ < 0) {
+        KNOWHERE_THROW_MSG("DiskANN failed to open " + disk_path_ + ": " + strerror(errno));
+    }
+
+    auto header = AllocAligned(SECTOR_SIZE);
+    Meta meta;
+    uint64_t magic = 0;
+    if (::pread(fd_, header.get(), SECTOR_SIZE, 0) != static_cast<ssize_t>(SECTOR_SIZE)) {
+        CloseDisk();
+        KNOWHERE_THROW_MSG("DiskANN failed to read header of " + disk_path_);
+    }
+    memcpy(&magic, header.get(), sizeof(magic));
+    memcpy(&meta, header.get() + sizeof(magic), sizeof(Meta));
+    if (magic != DISKANN_MAGIC || meta.ntotal != meta_.ntotal || meta.dim != meta_.dim ||
+        meta.node_size != meta_.node_size) {
+        CloseDisk();
+        KNOWHERE_THROW_MSG("DiskANN file " + disk_path_ + " doesn't match the index");
+    }
+}
+
+void
+IndexDiskANN::CloseDisk() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+uint64_t
+IndexDiskANN::NodeOffset(int64_t node) const {
+    if (meta_.nodes_per_sector > 0) {
+        return (1 + node / meta_.nodes_per_sector) * SECTOR_SIZE;
+    }
+    return (1 + node * meta_.sectors_per_node) * SECTOR_SIZE;
+}
+
+DatasetPtr
+IndexDiskANN::Search(const DatasetPtr& dataset, const Config& config) {
+    if (!pq_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    GETTENSOR(dataset)
+
+    int64_t k = config->k;
+    auto search_cfg = std::dynamic_pointer_cast<DiskANNCfg>(config);
+    int64_t list_size = meta_.default_search_list;
+    int64_t beam_width = meta_.beam_width;
+    if (search_cfg != nullptr) {
+        list_size = search_cfg->search_list > 0 ? search_cfg->search_list : list_size;
+        beam_width = search_cfg->beam_width > 0 ? search_cfg->beam_width : beam_width;
+    }
+    list_size = std::max(list_size, k);
+
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * k * rows);
+    auto p_dist = (float*)malloc(sizeof(float) * k * rows);
+
+    size_t read_size = meta_.sectors_per_node * SECTOR_SIZE;
+    auto distance = faiss::fvec_L2sqr_kernel(dim);
+    const uint8_t* codes = codes_->data.get();
+    size_t M = pq_->M;
+    size_t ksub = pq_->ksub;
+    const IDFilter* filter = config->filter.get();
+
+    std::atomic<bool> failed(false);
+    std::string error;
+    std::mutex error_mutex;
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < rows; i++) {
+        if (failed) {
+            continue;
+        }
+        try {
+            const float* query = p_data + i * dim;
+            std::vector<float> table(M * ksub);
+            pq_->compute_distance_table(query, table.data());
+            auto pq_distance = [&](uint32_t node) {
+                const uint8_t* code = codes + node * M;
+                float dis = 0;
+                for (size_t m = 0; m < M; m++) {
+                    dis += table[m * ksub + code[m]];
+                }
+                return dis;
+            };
+
+            CandidateList list(list_size);
+            std::unordered_set<uint32_t> visited;
+            list.Insert(pq_distance(meta_.medoid), meta_.medoid);
+            visited.insert(meta_.medoid);
+
+            auto buffer = AllocAligned(beam_width * read_size);
+            std::vector<aiocb> requests(beam_width);
+            std::vector<uint32_t> frontier;
+            std::vector<std::pair<float, int64_t>> results;
+
+            while (true) {
+                frontier.clear();
+                int64_t p;
+                while (frontier.size() < static_cast<size_t>(beam_width) && (p = list.PopUnexpanded()) >= 0) {
+                    frontier.push_back(p);
+                }
+                if (frontier.empty()) {
+                    break;
+                }
+
+                // the nodes of a step are read together, every one is waited for even if a later request failed
+                size_t submitted = 0;
+                int read_errno = 0;
+                for (; submitted < frontier.size(); submitted++) {
+                    auto& request = requests[submitted];
+                    memset(&request, 0, sizeof(aiocb));
+                    request.aio_fildes = fd_;
+                    request.aio_offset = NodeOffset(frontier[submitted]);
+                    request.aio_buf = buffer.get() + submitted * read_size;
+                    request.aio_nbytes = read_size;
+                    if (aio_read(&request) != 0) {
+                        read_errno = errno;
+                        break;
+                    }
+                }
+                for (size_t j = 0; j < submitted; j++) {
+                    const aiocb* pending = &requests[j];
+                    int status;
+                    while ((status = aio_error(pending)) == EINPROGRESS) {
+                        aio_suspend(&pending, 1, nullptr);
+                    }
+                    auto bytes = aio_return(&requests[j]);
+                    if (read_errno == 0 && (status != 0 || bytes != static_cast<ssize_t>(read_size))) {
+                        read_errno = (status != 0) ? status : EIO;
+                    }
+                }
+                if (read_errno != 0) {
+                    KNOWHERE_THROW_MSG("DiskANN failed to read " + disk_path_ + ": " + strerror(read_errno));
+                }
+
+                for (size_t j = 0; j < frontier.size(); j++) {
+                    const uint8_t* node = buffer.get() + j * read_size;
+                    if (meta_.nodes_per_sector > 0) {
+                        node += (frontier[j] % meta_.nodes_per_sector) * meta_.node_size;
+                    }
+                    const float* vector = reinterpret_cast<const float*>(node);
+                    int64_t id;
+                    uint32_t degree;
+                    memcpy(&id, node + dim * sizeof(float), sizeof(int64_t));
+                    memcpy(&degree, node + dim * sizeof(float) + sizeof(int64_t), sizeof(uint32_t));
+                    const uint8_t* neighbors = node + dim * sizeof(float) + sizeof(int64_t) + sizeof(uint32_t);
+
+                    // the full vector is at hand, filtered nodes are still walked through
+                    if (filter == nullptr || filter->is_member(id)) {
+                        results.emplace_back(distance(query, vector, dim), id);
+                    }
+                    for (uint32_t n = 0; n < degree; n++) {
+                        uint32_t neighbor;
+                        memcpy(&neighbor, neighbors + n * sizeof(uint32_t), sizeof(uint32_t));
+                        if (visited.insert(neighbor).second) {
+                            list.Insert(pq_distance(neighbor), neighbor);
+                        }
+                    }
+                }
+            }
+
+            size_t found = std::min<size_t>(results.size(), k);
+            std::partial_sort(results.begin(), results.begin() + found, results.end());
+            float* dist = p_dist + i * k;
+            int64_t* ids = p_id + i * k;
+            for (size_t j = 0; j < static_cast<size_t>(k); j++) {
+                dist[j] = (j < found) ? results[j].first : -1;
+                ids[j] = (j < found) ? results[j].second : -1;
+            }
+        } catch (std::exception& e) {
+            std::lock_guard<std::mutex> lk(error_mutex);
+            error = e.what();
+            failed = true;
+        }
+    }
+
+    if (failed) {
+        free(p_id);
+        free(p_dist);
+        KNOWHERE_THROW_MSG(error);
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+IndexDiskANN::Seal() {
+    // do nothing
+}
+
+int64_t
+IndexDiskANN::Count() {
+    if (!pq_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return meta_.ntotal;
+}
+
+int64_t
+IndexDiskANN::Dimension() {
+    if (!pq_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return meta_.dim;
+}
+
+}  // namespace knowhere
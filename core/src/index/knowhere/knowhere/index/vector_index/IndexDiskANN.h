@@ -0,0 +1,110 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <faiss/impl/ProductQuantizer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "knowhere/index/vector_index/VectorIndex.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace knowhere {
+
+/*
+ * Graph index kept on disk, after DiskANN. Full vectors, ids and neighbor lists of the nodes are written in 4KB
+ * sectors of a file, only pq codes of the vectors stay in memory. A search walks the graph by pq distances, reading
+ * beam_width nodes from the file with async io every step, and reranks the visited nodes with their full vectors.
+ *
+ * Layout of the file: sector 0 is the header, then every node is
+ *     [float vector of dim][int64 id][uint32 degree][uint32 neighbors of max_degree]
+ * nodes of a sector never cross its boundary, a node larger than a sector takes several whole ones.
+ */
+class IndexDiskANN : public VectorIndex {
+ public:
+    IndexDiskANN() = default;
+
+    // indexes are held by shared_ptr made of the concrete type, which closes the file
+    ~IndexDiskANN();
+
+    BinarySet
+    Serialize() override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    DatasetPtr
+    Search(const DatasetPtr& dataset, const Config& config) override;
+
+    IndexModelPtr
+    Train(const DatasetPtr& dataset, const Config& config) override;
+
+    // the graph is built of all vectors at once, a second add throws
+    void
+    Add(const DatasetPtr& dataset, const Config& config) override;
+
+    void
+    Seal() override;
+
+    int64_t
+    Count() override;
+
+    int64_t
+    Dimension() override;
+
+ public:
+    static constexpr size_t SECTOR_SIZE = 4096;
+    // binary a loader may add, the path of the disk file where the index is loaded from
+    static constexpr const char* DISK_PATH_BINARY_NAME = "DISKANN_DISK_PATH";
+
+    struct Meta {
+        int64_t dim = 0;
+        int64_t ntotal = 0;
+        int64_t max_degree = 0;
+        int64_t medoid = 0;
+        int64_t node_size = 0;
+        int64_t nodes_per_sector = 0;    // 0 if a node takes more than one sector
+        int64_t sectors_per_node = 0;    // sectors read for one node
+        int64_t default_search_list = 0;
+        int64_t beam_width = 0;
+    };
+
+ protected:
+    // graph of vamana, built in memory before it is written to disk
+    std::vector<std::vector<uint32_t>>
+    BuildGraph(const float* data, int64_t rows);
+
+    void
+    WriteDisk(const float* data, const int64_t* ids, const std::vector<std::vector<uint32_t>>& graph);
+
+    void
+    OpenDisk();
+
+    void
+    CloseDisk();
+
+    uint64_t
+    NodeOffset(int64_t node) const;
+
+ protected:
+    DiskANNConfig build_cfg_;
+    Meta meta_;
+    std::string disk_path_;
+    int fd_ = -1;
+
+    std::shared_ptr<faiss::ProductQuantizer> pq_;
+    BinaryPtr codes_;  // ntotal * pq_->code_size bytes, may point into the mapped index file
+};
+
+}  // namespace knowhere
@@ -118,6 +118,12 @@ GPUIDMAP::GetRawIds() {
 
 void
 GPUIDMAP::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) {
+    if (cfg && cfg->filter) {
+        KNOWHERE_THROW_MSG("filtered search is not supported by gpu index");
+    }
+    if (cfg && cfg->row_end >= 0) {
+        KNOWHERE_THROW_MSG("row range search is not supported by gpu index");
+    }
     ResScope rs(res_, gpu_id_);
     index_->search(n, (float*)data, k, distances, labels);
 }
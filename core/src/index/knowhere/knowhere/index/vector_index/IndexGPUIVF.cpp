@@ -36,6 +36,9 @@ GPUIVF::Train(const DatasetPtr& dataset, const Config& config) {
 
     GETTENSOR(dataset)
 
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
+
     auto temp_resource = FaissGpuResourceMgr::GetInstance().GetRes(gpu_id_);
     if (temp_resource != nullptr) {
         ResScope rs(temp_resource, gpu_id_, true);
@@ -43,7 +46,7 @@ GPUIVF::Train(const DatasetPtr& dataset, const Config& config) {
         idx_config.device = gpu_id_;
         faiss::gpu::GpuIndexIVFFlat device_index(temp_resource->faiss_res.get(), dim, build_cfg->nlist,
                                                  GetMetricType(build_cfg->metric_type), idx_config);
-        device_index.train(rows, (float*)p_data);
+        device_index.train(train_rows, (float*)p_data);
 
         std::shared_ptr<faiss::Index> host_index = nullptr;
         host_index.reset(faiss::gpu::index_gpu_to_cpu(&device_index));
@@ -127,6 +130,9 @@ GPUIVF::search_impl(int64_t n, const float* data, int64_t k, float* distances, i
     auto device_index = std::dynamic_pointer_cast<faiss::gpu::GpuIndexIVF>(index_);
     fiu_do_on("GPUIVF.search_impl.invald_index", device_index = nullptr);
     if (device_index) {
+        if (cfg->filter) {
+            KNOWHERE_THROW_MSG("filtered search is not supported by gpu index");
+        }
         auto search_cfg = std::dynamic_pointer_cast<IVFCfg>(cfg);
         device_index->nprobe = search_cfg->nprobe;
         // assert(device_index->getNumProbes() == search_cfg->nprobe);
@@ -165,6 +171,13 @@ GPUIVF::CopyGpuToGpu(const int64_t& device_id, const Config& config) {
     return std::static_pointer_cast<IVF>(host_index)->CopyCpuToGpu(device_id, config);
 }
 
+int64_t
+GPUIVF::Nlist() {
+    // a hybrid index keeps its lists on cpu
+    auto device_index = dynamic_cast<faiss::gpu::GpuIndexIVF*>(index_.get());
+    return (device_index == nullptr) ? IVF::Nlist() : device_index->getNumLists();
+}
+
 void
 GPUIVF::Add(const DatasetPtr& dataset, const Config& config) {
     if (auto spt = res_.lock()) {
@@ -69,6 +69,9 @@ class GPUIVF : public IVF, public GPUIndex {
     VectorIndexPtr
     CopyGpuToGpu(const int64_t& device_id, const Config& config) override;
 
+    int64_t
+    Nlist() override;
+
     //    VectorIndexPtr
     //    Clone() final;
 
@@ -33,13 +33,16 @@ GPUIVFPQ::Train(const DatasetPtr& dataset, const Config& config) {
 
     GETTENSOR(dataset)
 
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
+
     auto temp_resource = FaissGpuResourceMgr::GetInstance().GetRes(gpu_id_);
     if (temp_resource != nullptr) {
         ResScope rs(temp_resource, gpu_id_, true);
         auto device_index = new faiss::gpu::GpuIndexIVFPQ(temp_resource->faiss_res.get(), dim, build_cfg->nlist,
                                                           build_cfg->m, build_cfg->nbits,
                                                           GetMetricType(build_cfg->metric_type));  // IP not support
-        device_index->train(rows, (float*)p_data);
+        device_index->train(train_rows, (float*)p_data);
         std::shared_ptr<faiss::Index> host_index = nullptr;
         host_index.reset(faiss::gpu::index_gpu_to_cpu(device_index));
         return std::make_shared<IVFIndexModel>(host_index);
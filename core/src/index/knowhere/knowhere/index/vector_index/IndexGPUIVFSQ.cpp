@@ -13,6 +13,7 @@
 #include <faiss/index_factory.h>
 
 #include <memory>
+#include <string>
 
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
@@ -31,16 +32,19 @@ GPUIVFSQ::Train(const DatasetPtr& dataset, const Config& config) {
 
     GETTENSOR(dataset)
 
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
+
     std::stringstream index_type;
     index_type << "IVF" << build_cfg->nlist << ","
-               << "SQ" << build_cfg->nbits;
+               << "SQ" << (build_cfg->nbits == SQ_FP16_NBITS ? "fp16" : std::to_string(build_cfg->nbits));
     auto build_index = faiss::index_factory(dim, index_type.str().c_str(), GetMetricType(build_cfg->metric_type));
 
     auto temp_resource = FaissGpuResourceMgr::GetInstance().GetRes(gpu_id_);
     if (temp_resource != nullptr) {
         ResScope rs(temp_resource, gpu_id_, true);
         auto device_index = faiss::gpu::index_cpu_to_gpu(temp_resource->faiss_res.get(), gpu_id_, build_index);
-        device_index->train(rows, (float*)p_data);
+        device_index->train(train_rows, (float*)p_data);
 
         std::shared_ptr<faiss::Index> host_index = nullptr;
         host_index.reset(faiss::gpu::index_gpu_to_cpu(device_index));
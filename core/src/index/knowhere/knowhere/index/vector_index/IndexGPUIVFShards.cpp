@@ -0,0 +1,98 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexScalarQuantizer.h>
+#include <faiss/IndexShards.h>
+#include <faiss/gpu/GpuCloner.h>
+#include <faiss/gpu/GpuIndexIVF.h>
+#include <fiu-local.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexGPUIVFShards.h"
+#include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFSQ.h"
+
+namespace knowhere {
+
+GPUIVFShards::GPUIVFShards(std::shared_ptr<faiss::Index> index, const std::vector<int64_t>& device_ids,
+                           std::vector<ResPtr>& resources)
+    : GPUIVF(std::move(index), device_ids.front(), resources.front()), device_ids_(device_ids) {
+    for (auto& res : resources) {
+        resources_.emplace_back(res);
+    }
+}
+
+void
+GPUIVFShards::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                          const Config& cfg) {
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    auto shards = std::dynamic_pointer_cast<faiss::IndexShards>(index_);
+    fiu_do_on("GPUIVFShards.search_impl.invald_index", shards = nullptr);
+    if (shards == nullptr) {
+        KNOWHERE_THROW_MSG("Not a IndexShards type.");
+    }
+    if (cfg->filter) {
+        KNOWHERE_THROW_MSG("filtered search is not supported by gpu index");
+    }
+
+    auto search_cfg = std::dynamic_pointer_cast<IVFCfg>(cfg);
+    for (int i = 0; i < shards->count(); ++i) {
+        if (auto device_index = dynamic_cast<faiss::gpu::GpuIndexIVF*>(shards->at(i))) {
+            device_index->nprobe = search_cfg->nprobe;
+        }
+    }
+
+    // own all devices of the shards, in ascending device order so shards never wait for each other in a circle
+    std::vector<std::unique_ptr<ResScope>> scopes;
+    for (size_t i = 0; i < device_ids_.size(); ++i) {
+        scopes.emplace_back(new ResScope(resources_[i], device_ids_[i]));
+    }
+    shards->search(n, (float*)data, k, distances, labels);
+}
+
+VectorIndexPtr
+GPUIVFShards::CopyGpuToCpu(const Config& config) {
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    // shards are merged back into one index
+    std::shared_ptr<faiss::Index> host_index;
+    host_index.reset(faiss::gpu::index_gpu_to_cpu(index_.get()));
+    if (dynamic_cast<faiss::IndexIVFScalarQuantizer*>(host_index.get())) {
+        return std::make_shared<IVFSQ>(host_index);
+    } else if (dynamic_cast<faiss::IndexIVFPQ*>(host_index.get())) {
+        return std::make_shared<IVFPQ>(host_index);
+    }
+    return std::make_shared<IVF>(host_index);
+}
+
+VectorIndexPtr
+GPUIVFShards::CopyGpuToGpu(const int64_t& device_id, const Config& config) {
+    auto host_index = CopyGpuToCpu(config);
+    return std::static_pointer_cast<IVF>(host_index)->CopyCpuToGpu(device_id, config);
+}
+
+int64_t
+GPUIVFShards::Nlist() {
+    auto shards = std::dynamic_pointer_cast<faiss::IndexShards>(index_);
+    if (shards == nullptr || shards->count() == 0) {
+        return 0;
+    }
+    auto device_index = dynamic_cast<faiss::gpu::GpuIndexIVF*>(shards->at(0));
+    return (device_index == nullptr) ? 0 : device_index->getNumLists();
+}
+
+}  // namespace knowhere
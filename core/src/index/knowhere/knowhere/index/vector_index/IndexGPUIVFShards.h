@@ -0,0 +1,54 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "knowhere/index/vector_index/IndexGPUIVF.h"
+
+namespace knowhere {
+
+/*
+ * An ivf index whose vectors are split among several gpus;
+ * Every device searches its part with the same centroids, results are merged by faiss::IndexShards;
+ */
+class GPUIVFShards : public GPUIVF {
+ public:
+    GPUIVFShards(std::shared_ptr<faiss::Index> index, const std::vector<int64_t>& device_ids,
+                 std::vector<ResPtr>& resources);
+
+    VectorIndexPtr
+    CopyGpuToCpu(const Config& config) override;
+
+    VectorIndexPtr
+    CopyGpuToGpu(const int64_t& device_id, const Config& config) override;
+
+    // every shard holds all lists, for a part of the vectors
+    int64_t
+    Nlist() override;
+
+    const std::vector<int64_t>&
+    GetGpuDevices() const {
+        return device_ids_;
+    }
+
+ protected:
+    void
+    search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) override;
+
+ private:
+    std::vector<int64_t> device_ids_;
+    std::vector<ResWPtr> resources_;
+};
+
+}  // namespace knowhere
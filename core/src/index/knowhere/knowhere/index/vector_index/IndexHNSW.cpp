@@ -13,7 +13,6 @@
 
 #include <algorithm>
 #include <cassert>
-#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -24,9 +23,28 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
 
 namespace knowhere {
 
+namespace {
+
+class HNSWIDFilter : public hnswlib::BaseFilterFunctor {
+ public:
+    explicit HNSWIDFilter(const IDFilter& filter) : filter_(filter) {
+    }
+
+    bool
+    operator()(hnswlib::labeltype id) const override {
+        return filter_.is_member(id);
+    }
+
+ private:
+    const IDFilter& filter_;
+};
+
+}  // namespace
+
 BinarySet
 IndexHNSW::Serialize() {
     if (!index_) {
@@ -34,13 +52,18 @@ IndexHNSW::Serialize() {
     }
 
     try {
+        std::shared_lock<std::shared_mutex> lk(resize_mutex_);
+
+        // the buffer is allocated once with the exact size, the writer never grows and copies it
         MemoryIOWriter writer;
+        writer.total = index_->serializedSize();
+        writer.data_ = new uint8_t[writer.total];
         index_->saveIndex(writer);
         auto data = std::make_shared<uint8_t>();
         data.reset(writer.data_);
 
         BinarySet res_set;
-        res_set.Append("HNSW", data, writer.total);
+        res_set.Append("HNSW", data, writer.rp);
         return res_set;
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
@@ -78,22 +101,41 @@ IndexHNSW::Search(const DatasetPtr& dataset, const Config& config) {
 
     using P = std::pair<float, int64_t>;
     auto compare = [](P& v1, P& v2) { return v1.first < v2.first; };
+    std::shared_ptr<HNSWIDFilter> filter;
+    if (config->filter) {
+        filter = std::make_shared<HNSWIDFilter>(*config->filter);
+    }
+
+    // ef of the search config bounds the candidate list of this request, 0 keeps the default of index
+    size_t ef = 0;
+    auto search_cfg = std::dynamic_pointer_cast<HNSWCfg>(config);
+    if (search_cfg != nullptr && search_cfg->ef > 0) {
+        ef = search_cfg->ef;
+    }
+
+    // the ip spaces of hnswlib give 1 - <q, x>, returned as the inner product like faiss does, so results of
+    // hnsw files merge with the others in descending order and the vectors don't need to be normalized
+    bool is_ip = (index_->metric_type_ == 1 || index_->metric_type_ == 3);
+
+    // searches go on while points are added, but not while the index is resized
+    std::shared_lock<std::shared_mutex> resize_lk(resize_mutex_);
 #pragma omp parallel for
     for (unsigned int i = 0; i < rows; ++i) {
         const float* single_query = p_data + i * dim;
-        std::vector<std::pair<float, int64_t>> ret = index_->searchKnn(single_query, config->k, compare);
-        while (ret.size() < config->k) {
-            ret.push_back(std::make_pair(-1, -1));
+        std::vector<std::pair<float, int64_t>> ret =
+            index_->searchKnn(single_query, config->k, compare, filter.get(), ef);
+
+        float* dist = p_dist + i * config->k;
+        int64_t* ids = p_id + i * config->k;
+        size_t j = 0;
+        for (; j < ret.size() && j < config->k; j++) {
+            dist[j] = is_ip ? 1.0f - ret[j].first : ret[j].first;
+            ids[j] = ret[j].second;
+        }
+        for (; j < config->k; j++) {
+            dist[j] = -1;
+            ids[j] = -1;
         }
-        std::vector<float> dist;
-        std::vector<int64_t> ids;
-        std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
-                       [](const std::pair<float, int64_t>& e) { return e.first; });
-        std::transform(ret.begin(), ret.end(), std::back_inserter(ids),
-                       [](const std::pair<float, int64_t>& e) { return e.second; });
-
-        memcpy(p_dist + i * config->k, dist.data(), dist_size);
-        memcpy(p_id + i * config->k, ids.data(), id_size);
     }
 
     auto ret_ds = std::make_shared<Dataset>();
@@ -128,17 +170,35 @@ IndexHNSW::Add(const DatasetPtr& dataset, const Config& config) {
         KNOWHERE_THROW_MSG("index not initialize");
     }
 
-    std::lock_guard<std::mutex> lk(mutex_);
-
     GETTENSOR(dataset)
     auto p_ids = dataset->Get<const int64_t*>(meta::IDS);
+    AddPoints((const uint8_t*)p_data, dim * sizeof(float), p_ids, rows);
+}
+
+void
+IndexHNSW::AddPoints(const uint8_t* points, size_t point_size, const int64_t* ids, int64_t rows) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (rows <= 0) {
+        return;
+    }
+
+    // capacity was sized by rows of train, late inserts grow it, doubled to keep resizes rare
+    size_t need = index_->cur_element_count + rows;
+    if (need > index_->max_elements_) {
+        std::unique_lock<std::shared_mutex> resize_lk(resize_mutex_);
+        index_->resizeIndex(std::max(need, index_->max_elements_ * 2));
+    }
 
-    for (int i = 0; i < 1; i++) {
-        index_->addPoint((void*)(p_data + dim * i), p_ids[i]);
+    std::shared_lock<std::shared_mutex> resize_lk(resize_mutex_);
+    int64_t start = 0;
+    if (index_->cur_element_count == 0) {
+        // the first point is the entry point of graph, others link to it
+        index_->addPoint((const void*)points, ids[0]);
+        start = 1;
     }
 #pragma omp parallel for
-    for (int i = 1; i < rows; i++) {
-        index_->addPoint((void*)(p_data + dim * i), p_ids[i]);
+    for (int64_t i = start; i < rows; i++) {
+        index_->addPoint((const void*)(points + point_size * i), ids[i]);
     }
 }
 
@@ -155,6 +215,16 @@ IndexHNSW::Count() {
     return index_->cur_element_count;
 }
 
+std::vector<std::pair<const void*, size_t>>
+IndexHNSW::MemoryRanges() {
+    // level 0 holds the vectors and their links, upper levels are small
+    std::shared_lock<std::shared_mutex> lock(resize_mutex_);
+    if (!index_) {
+        return {};
+    }
+    return {{index_->data_level0_memory_, index_->max_elements_ * index_->size_data_per_element_}};
+}
+
 int64_t
 IndexHNSW::Dimension() {
     if (!index_) {
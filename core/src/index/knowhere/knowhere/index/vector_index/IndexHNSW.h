@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 
 #include "hnswlib/hnswlib.h"
 
@@ -55,8 +56,17 @@ class IndexHNSW : public VectorIndex {
     int64_t
     Dimension() override;
 
- private:
+    std::vector<std::pair<const void*, size_t>>
+    MemoryRanges() override;
+
+ protected:
+    // points are laid out as the space of index_ stores them, point_size bytes each
+    void
+    AddPoints(const uint8_t* points, size_t point_size, const int64_t* ids, int64_t rows);
+
+    // mutex_ serializes adds, resize_mutex_ keeps searches and serialize off the index while it is resized
     std::mutex mutex_;
+    std::shared_mutex resize_mutex_;
     std::shared_ptr<hnswlib::HierarchicalNSW<float>> index_;
 };
 
@@ -0,0 +1,125 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/IndexHNSWSQ8.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "hnswlib/hnswalg.h"
+#include "hnswlib/space_sq8.h"
+#include "knowhere/adapter/VectorAdapter.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace knowhere {
+
+namespace {
+
+// layout of the "HNSW_SQ8" binary: metric type, then vmin and vmax of every dimension
+constexpr const char* SQ8_BINARY_NAME = "HNSW_SQ8";
+
+}  // namespace
+
+BinarySet
+IndexHNSWSQ8::Serialize() {
+    auto res_set = IndexHNSW::Serialize();
+
+    try {
+        auto& vmin = space_->vmin();
+        auto& vmax = space_->vmax();
+        int64_t metric = space_->is_ip() ? 1 : 0;
+        size_t length = sizeof(metric) + (vmin.size() + vmax.size()) * sizeof(float);
+
+        MemoryIOWriter writer;
+        writer.total = length;
+        writer.data_ = new uint8_t[length];
+        writer(&metric, sizeof(metric), 1);
+        writer(vmin.data(), sizeof(float), vmin.size());
+        writer(vmax.data(), sizeof(float), vmax.size());
+        auto data = std::make_shared<uint8_t>();
+        data.reset(writer.data_);
+
+        res_set.Append(SQ8_BINARY_NAME, data, writer.rp);
+        return res_set;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+IndexHNSWSQ8::Load(const BinarySet& index_binary) {
+    try {
+        auto trained = index_binary.GetByName(SQ8_BINARY_NAME);
+        if (trained == nullptr || trained->size < sizeof(int64_t)) {
+            KNOWHERE_THROW_MSG("quantizer of HNSW_SQ8 is missing");
+        }
+        int64_t metric = 0;
+        memcpy(&metric, trained->data.get(), sizeof(metric));
+        size_t dim = (trained->size - sizeof(metric)) / (2 * sizeof(float));
+        auto vmin = (const float*)(trained->data.get() + sizeof(metric));
+        auto space = new hnswlib::SQ8Space(dim, metric == 1, vmin, vmin + dim);
+
+        auto binary = index_binary.GetByName("HNSW");
+        MemoryIOReader reader;
+        reader.total = binary->size;
+        reader.data_ = binary->data.get();
+
+        index_ = std::make_shared<hnswlib::HierarchicalNSW<float>>(space);
+        index_->loadIndex(reader, 0, space);
+        space_ = space;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+IndexModelPtr
+IndexHNSWSQ8::Train(const DatasetPtr& dataset, const Config& config) {
+    auto build_cfg = std::dynamic_pointer_cast<HNSWCfg>(config);
+    if (build_cfg == nullptr) {
+        KNOWHERE_THROW_MSG("HNSW_SQ8 needs a HNSW build config");
+    }
+    build_cfg->CheckValid();  // throw exception
+    if (config->metric_type != METRICTYPE::L2 && config->metric_type != METRICTYPE::IP) {
+        KNOWHERE_THROW_MSG("HNSW_SQ8 only supports L2 and IP metric");
+    }
+
+    GETTENSOR(dataset)
+
+    std::vector<float> vmin, vmax;
+    hnswlib::SQ8Space::train(p_data, rows, dim, vmin, vmax);
+    space_ = new hnswlib::SQ8Space(dim, config->metric_type == METRICTYPE::IP, vmin.data(), vmax.data());
+    index_ = std::make_shared<hnswlib::HierarchicalNSW<float>>(space_, rows, build_cfg->M, build_cfg->ef);
+
+    return nullptr;
+}
+
+void
+IndexHNSWSQ8::Add(const DatasetPtr& dataset, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    GETTENSOR(dataset)
+    auto p_ids = dataset->Get<const int64_t*>(meta::IDS);
+
+    // vectors out of the trained range are clamped to it
+    std::vector<uint8_t> codes(rows * dim);
+#pragma omp parallel for
+    for (int64_t i = 0; i < rows; i++) {
+        space_->encode(p_data + i * dim, codes.data() + i * dim);
+    }
+    AddPoints(codes.data(), dim, p_ids, rows);
+}
+
+}  // namespace knowhere
@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "IndexHNSW.h"
+
+namespace knowhere {
+
+/*
+ * HNSW graph whose nodes hold 8 bit scalar quantized codes instead of float vectors, the range of
+ * every dimension is trained from the train dataset. Queries stay float and are compared with the
+ * decoded codes.
+ */
+class IndexHNSWSQ8 : public IndexHNSW {
+ public:
+    BinarySet
+    Serialize() override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    IndexModelPtr
+    Train(const DatasetPtr& dataset, const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset, const Config& config) override;
+
+ private:
+    // owned by index_
+    hnswlib::SQ8Space* space_ = nullptr;
+};
+
+}  // namespace knowhere
@@ -16,6 +16,8 @@
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
+#include <faiss/utils/Heap.h>
+#include <faiss/utils/distances.h>
 
 #ifdef MILVUS_GPU_VERSION
 
@@ -23,12 +25,14 @@
 
 #endif
 
+#include <algorithm>
 #include <vector>
 
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
 
 #ifdef MILVUS_GPU_VERSION
 
@@ -49,6 +53,20 @@ IDMAP::Serialize() {
     return SerializeImpl();
 }
 
+void
+IDMAP::SerializeTo(faiss::IOWriter* writer) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    try {
+        faiss::write_index(index_.get(), writer);
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 void
 IDMAP::Load(const BinarySet& index_binary) {
     std::lock_guard<std::mutex> lk(mutex_);
@@ -68,7 +86,7 @@ IDMAP::Search(const DatasetPtr& dataset, const Config& config) {
     auto p_id = (int64_t*)malloc(p_id_size);
     auto p_dist = (float*)malloc(p_dist_size);
 
-    search_impl(rows, (float*)p_data, config->k, p_dist, p_id, Config());
+    search_impl(rows, (float*)p_data, config->k, p_dist, p_id, config);
 
     auto ret_ds = std::make_shared<Dataset>();
     ret_ds->Set(meta::IDS, p_id);
@@ -76,11 +94,122 @@ IDMAP::Search(const DatasetPtr& dataset, const Config& config) {
     return ret_ds;
 }
 
+DatasetPtr
+IDMAP::RangeSearch(const DatasetPtr& dataset, float radius, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GETTENSOR(dataset)
+
+    try {
+        faiss::RangeSearchResult result(rows);
+        index_->range_search(rows, (float*)p_data, radius, &result);
+        return GenRangeResult(result, config->k, index_->metric_type == faiss::METRIC_L2);
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 void
 IDMAP::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) {
+    int64_t row_begin = 0, row_end = index_->ntotal;
+    bool ranged = cfg && cfg->row_end >= 0;
+    if (ranged) {
+        row_begin = std::max<int64_t>(cfg->row_begin, 0);
+        row_end = std::min<int64_t>(cfg->row_end, index_->ntotal);
+    }
+
+    if (cfg && cfg->filter) {
+        filtered_search_impl(n, data, k, distances, labels, *cfg->filter, row_begin, row_end);
+        return;
+    }
+    if (ranged) {
+        ranged_search_impl(n, data, k, distances, labels, row_begin, row_end);
+        return;
+    }
     index_->search(n, (float*)data, k, distances, labels);
 }
 
+void
+IDMAP::filtered_search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                            const IDFilter& filter, int64_t row_begin, int64_t row_end) {
+    auto file_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto flat_index = (file_index == nullptr) ? nullptr : dynamic_cast<faiss::IndexFlat*>(file_index->index);
+    if (flat_index == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    // filter is evaluated once per vector rather than once per query and vector
+    std::vector<int64_t> offsets;
+    for (int64_t i = row_begin; i < row_end; i++) {
+        if (filter.is_member(file_index->id_map[i])) {
+            offsets.push_back(i);
+        }
+    }
+
+    int64_t dim = index_->d;
+    const float* xb = flat_index->xb.data();
+    bool is_ip = (index_->metric_type == faiss::METRIC_INNER_PRODUCT);
+    auto distance = is_ip ? faiss::fvec_inner_product_kernel(dim) : faiss::fvec_L2sqr_kernel(dim);
+#pragma omp parallel for
+    for (int64_t i = 0; i < n; i++) {
+        const float* xq = data + i * dim;
+        float* simi = distances + i * k;
+        int64_t* idxi = labels + i * k;
+        if (is_ip) {
+            faiss::minheap_heapify(k, simi, idxi);
+            for (auto offset : offsets) {
+                float dis = distance(xq, xb + offset * dim, dim);
+                if (dis > simi[0]) {
+                    faiss::minheap_pop(k, simi, idxi);
+                    faiss::minheap_push(k, simi, idxi, dis, file_index->id_map[offset]);
+                }
+            }
+            faiss::minheap_reorder(k, simi, idxi);
+        } else {
+            faiss::maxheap_heapify(k, simi, idxi);
+            for (auto offset : offsets) {
+                float dis = distance(xq, xb + offset * dim, dim);
+                if (dis < simi[0]) {
+                    faiss::maxheap_pop(k, simi, idxi);
+                    faiss::maxheap_push(k, simi, idxi, dis, file_index->id_map[offset]);
+                }
+            }
+            faiss::maxheap_reorder(k, simi, idxi);
+        }
+    }
+}
+
+void
+IDMAP::ranged_search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                          int64_t row_begin, int64_t row_end) {
+    auto file_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto flat_index = (file_index == nullptr) ? nullptr : dynamic_cast<faiss::IndexFlat*>(file_index->index);
+    if (flat_index == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    int64_t dim = index_->d;
+    const float* xb = flat_index->xb.data() + row_begin * dim;
+    size_t ny = std::max<int64_t>(row_end - row_begin, 0);
+    if (index_->metric_type == faiss::METRIC_INNER_PRODUCT) {
+        faiss::float_minheap_array_t res = {size_t(n), size_t(k), labels, distances};
+        faiss::knn_inner_product(data, xb, dim, n, ny, &res);
+    } else if (index_->metric_type == faiss::METRIC_L2) {
+        faiss::float_maxheap_array_t res = {size_t(n), size_t(k), labels, distances};
+        faiss::knn_L2sqr(data, xb, dim, n, ny, &res);
+    } else {
+        KNOWHERE_THROW_MSG("row range search supports L2 and IP only");
+    }
+
+    // labels are offsets from row_begin
+    for (int64_t i = 0; i < n * k; i++) {
+        if (labels[i] >= 0) {
+            labels[i] = file_index->id_map[row_begin + labels[i]];
+        }
+    }
+}
+
 void
 IDMAP::Add(const DatasetPtr& dataset, const Config& config) {
     if (!index_) {
@@ -121,6 +250,19 @@ IDMAP::Dimension() {
     return index_->d;
 }
 
+std::vector<std::pair<const void*, size_t>>
+IDMAP::MemoryRanges() {
+    std::vector<std::pair<const void*, size_t>> ranges;
+    auto file_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    if (file_index != nullptr) {
+        auto flat_index = dynamic_cast<faiss::IndexFlat*>(file_index->index);
+        if (flat_index != nullptr) {
+            ranges.emplace_back(flat_index->xb.data(), flat_index->xb.size() * sizeof(float));
+        }
+    }
+    return ranges;
+}
+
 const float*
 IDMAP::GetRawVectors() {
     try {
@@ -142,6 +284,37 @@ IDMAP::GetRawIds() {
     }
 }
 
+void
+IDMAP::Reserve(int64_t n) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto file_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto flat_index = (file_index == nullptr) ? nullptr : dynamic_cast<faiss::IndexFlat*>(file_index->index);
+    if (flat_index == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    flat_index->xb.reserve(n * index_->d);
+    file_index->id_map.reserve(n);
+}
+
+void
+IDMAP::SwapRawData(std::vector<float>& xb, std::vector<int64_t>& ids) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto file_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto flat_index = (file_index == nullptr) ? nullptr : dynamic_cast<faiss::IndexFlat*>(file_index->index);
+    if (flat_index == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    if (xb.size() != ids.size() * index_->d) {
+        KNOWHERE_THROW_MSG("vectors size doesn't match ids size");
+    }
+
+    flat_index->xb.swap(xb);
+    file_index->id_map.swap(ids);
+    flat_index->ntotal = file_index->id_map.size();
+    file_index->ntotal = file_index->id_map.size();
+}
+
 void
 IDMAP::Train(const Config& config) {
     config->CheckValid();
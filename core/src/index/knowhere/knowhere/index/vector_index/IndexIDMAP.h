@@ -13,8 +13,11 @@
 
 #include "IndexIVF.h"
 
+#include <faiss/impl/io.h>
+
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace knowhere {
 
@@ -29,6 +32,10 @@ class IDMAP : public VectorIndex, public FaissBaseIndex {
     BinarySet
     Serialize() override;
 
+    // write the serialized index straight to writer, there is no copy of it in memory as by Serialize()
+    void
+    SerializeTo(faiss::IOWriter* writer);
+
     void
     Load(const BinarySet& index_binary) override;
 
@@ -38,6 +45,9 @@ class IDMAP : public VectorIndex, public FaissBaseIndex {
     DatasetPtr
     Search(const DatasetPtr& dataset, const Config& config) override;
 
+    DatasetPtr
+    RangeSearch(const DatasetPtr& dataset, float radius, const Config& config) override;
+
     int64_t
     Count() override;
 
@@ -47,6 +57,9 @@ class IDMAP : public VectorIndex, public FaissBaseIndex {
     int64_t
     Dimension() override;
 
+    std::vector<std::pair<const void*, size_t>>
+    MemoryRanges() override;
+
     void
     Add(const DatasetPtr& dataset, const Config& config) override;
 
@@ -64,10 +77,28 @@ class IDMAP : public VectorIndex, public FaissBaseIndex {
     virtual const int64_t*
     GetRawIds();
 
+    // reserve memory for n vectors, avoid reallocation when vectors are added incrementally
+    void
+    Reserve(int64_t n);
+
+    // exchange raw vectors and ids with the given buffers, used to recycle memory of insert buffer
+    void
+    SwapRawData(std::vector<float>& xb, std::vector<int64_t>& ids);
+
  protected:
     virtual void
     search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg);
 
+    // brute force search over the vectors of rows [row_begin, row_end) accepted by the filter
+    void
+    filtered_search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                         const IDFilter& filter, int64_t row_begin, int64_t row_end);
+
+    // brute force search over the vectors of rows [row_begin, row_end)
+    void
+    ranged_search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                       int64_t row_begin, int64_t row_end);
+
  protected:
     std::mutex mutex_;
 };
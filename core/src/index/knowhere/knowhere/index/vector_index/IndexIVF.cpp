@@ -15,30 +15,49 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexScalarQuantizer.h>
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
+#include <faiss/utils/random.h>
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuAutoTune.h>
 #include <faiss/gpu/GpuCloner.h>
 #endif
 
 #include <fiu-local.h>
+#include <omp.h>
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
+#include "knowhere/index/preprocessor/Rotation.h"
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/IndexGPUIVF.h"
+#include "knowhere/index/vector_index/IndexGPUIVFShards.h"
 #endif
 #include "knowhere/index/vector_index/IndexIVF.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
 
 namespace knowhere {
 
+namespace {
+
+constexpr const char* ROTATION_BINARY_NAME = "ROTATION";
+// residuals shared by the files of a job are kept for small batches only, 64MB
+constexpr int64_t MAX_SHARED_RESIDUAL_FLOATS = 16 * 1024 * 1024;
+// lists of a query are scanned by parallel threads if it probes at least this many lists per query
+constexpr int64_t PROBE_PARALLEL_RATIO = 2;
+
+}  // namespace
+
 using stdclock = std::chrono::high_resolution_clock;
 
 IndexModelPtr
@@ -48,15 +67,19 @@ IVF::Train(const DatasetPtr& dataset, const Config& config) {
         build_cfg->CheckValid();  // throw exception
     }
 
-    GETTENSOR(dataset)
+    auto input = Preprocess(dataset);
+    GETTENSOR(input)
+
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
 
     faiss::Index* coarse_quantizer = new faiss::IndexFlatL2(dim);
     auto index = std::make_shared<faiss::IndexIVFFlat>(coarse_quantizer, dim, build_cfg->nlist,
                                                        GetMetricType(build_cfg->metric_type));
-    index->train(rows, (float*)p_data);
+    index->train(train_rows, (float*)p_data);
 
     // TODO(linxj): override here. train return model or not.
-    return std::make_shared<IVFIndexModel>(index);
+    return std::make_shared<IVFIndexModel>(index, preprocessor_);
 }
 
 void
@@ -65,10 +88,11 @@ IVF::Add(const DatasetPtr& dataset, const Config& config) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
 
+    auto input = Preprocess(dataset);
     std::lock_guard<std::mutex> lk(mutex_);
-    GETTENSOR(dataset)
+    GETTENSOR(input)
 
-    auto p_ids = dataset->Get<const int64_t*>(meta::IDS);
+    auto p_ids = input->Get<const int64_t*>(meta::IDS);
     index_->add_with_ids(rows, (float*)p_data, p_ids);
 }
 
@@ -78,8 +102,9 @@ IVF::AddWithoutIds(const DatasetPtr& dataset, const Config& config) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
 
+    auto input = Preprocess(dataset);
     std::lock_guard<std::mutex> lk(mutex_);
-    GETTENSOR(dataset)
+    GETTENSOR(input)
 
     index_->add(rows, (float*)p_data);
 }
@@ -91,13 +116,22 @@ IVF::Serialize() {
     }
 
     std::lock_guard<std::mutex> lk(mutex_);
-    return SerializeImpl();
+    auto res_set = SerializeImpl();
+    auto rotation = std::dynamic_pointer_cast<RotationPreprocessor>(preprocessor_);
+    if (rotation != nullptr) {
+        res_set.Append(ROTATION_BINARY_NAME, rotation->Serialize());
+    }
+    return res_set;
 }
 
 void
 IVF::Load(const BinarySet& index_binary) {
     std::lock_guard<std::mutex> lk(mutex_);
     LoadImpl(index_binary);
+    quantizer_fingerprint_ = 0;
+    if (index_binary.binary_map_.count(ROTATION_BINARY_NAME) != 0) {
+        preprocessor_ = RotationPreprocessor::Load(index_binary.GetByName(ROTATION_BINARY_NAME));
+    }
 }
 
 DatasetPtr
@@ -111,7 +145,8 @@ IVF::Search(const DatasetPtr& dataset, const Config& config) {
         KNOWHERE_THROW_MSG("not support this kind of config");
     }
 
-    GETTENSOR(dataset)
+    auto input = Preprocess(dataset);
+    GETTENSOR(input)
 
     try {
         fiu_do_on("IVF.Search.throw_std_exception", throw std::exception());
@@ -149,6 +184,150 @@ IVF::Search(const DatasetPtr& dataset, const Config& config) {
     }
 }
 
+DatasetPtr
+IVF::RangeSearch(const DatasetPtr& dataset, float radius, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    auto search_cfg = std::dynamic_pointer_cast<IVFCfg>(config);
+    if (search_cfg == nullptr) {
+        KNOWHERE_THROW_MSG("not support this kind of config");
+    }
+
+    // gpu indexes don't implement range search
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        KNOWHERE_THROW_MSG("range search not supported by this index");
+    }
+
+    auto input = Preprocess(dataset);
+    GETTENSOR(input)
+
+    try {
+        auto nprobe = std::min((int64_t)ivf_index->nlist, search_cfg->nprobe);
+        std::vector<faiss::Index::idx_t> keys(rows * nprobe);
+        std::vector<float> coarse_dis(rows * nprobe);
+        ivf_index->quantizer->search(rows, (float*)p_data, nprobe, coarse_dis.data(), keys.data());
+
+        // scanning reads nprobe from the index, serialize it so concurrent range searches don't race on it
+        faiss::RangeSearchResult result(rows);
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            ivf_index->nprobe = nprobe;
+            ivf_index->range_search_preassigned(rows, (float*)p_data, radius, keys.data(), coarse_dis.data(), &result);
+        }
+        return GenRangeResult(result, search_cfg->k, index_->metric_type == faiss::METRIC_L2);
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+CoarseAssignmentPtr
+IVF::CoarseAssign(const DatasetPtr& dataset, const Config& config) {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        return nullptr;
+    }
+    return AssignLists(ivf_index->quantizer, dataset, config);
+}
+
+CoarseAssignmentPtr
+IVF::AssignLists(faiss::Index* quantizer, const DatasetPtr& dataset, const Config& config) {
+    auto search_cfg = std::dynamic_pointer_cast<IVFCfg>(config);
+    if (search_cfg == nullptr) {
+        KNOWHERE_THROW_MSG("not support this kind of config");
+    }
+
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr || !ivf_index->is_trained || quantizer == nullptr) {
+        return nullptr;
+    }
+
+    auto input = Preprocess(dataset);
+    GETTENSOR(input)
+
+    try {
+        auto coarse = std::make_shared<CoarseAssignment>();
+        coarse->nprobe = search_cfg->nprobe;
+        coarse->keys.resize(rows * coarse->nprobe);
+        coarse->distances.resize(rows * coarse->nprobe);
+        quantizer->search(rows, (float*)p_data, coarse->nprobe, coarse->distances.data(), coarse->keys.data());
+
+        // a scalar quantizer by residual encodes each query against each probed centroid, the files share these too;
+        // they are computed from the centroids kept on cpu whatever quantizer the lists were searched in
+        auto sq_index = dynamic_cast<faiss::IndexIVFScalarQuantizer*>(ivf_index);
+        auto cpu_quantizer = (ivf_index->quantizer_backup != nullptr) ? ivf_index->quantizer_backup : quantizer;
+        if (sq_index != nullptr && sq_index->by_residual && sq_index->metric_type == faiss::METRIC_L2 &&
+            rows * coarse->nprobe * dim <= MAX_SHARED_RESIDUAL_FLOATS) {
+            coarse->residuals.resize(rows * coarse->nprobe * dim);
+#pragma omp parallel for
+            for (int64_t i = 0; i < rows * coarse->nprobe; i++) {
+                auto key = coarse->keys[i];
+                auto residual = coarse->residuals.data() + i * dim;
+                if (key >= 0) {
+                    cpu_quantizer->compute_residual((float*)p_data + (i / coarse->nprobe) * dim, residual, key);
+                }
+            }
+        }
+        return coarse;
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+uint64_t
+IVF::QuantizerFingerprint() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (quantizer_fingerprint_ != 0) {
+        return quantizer_fingerprint_;
+    }
+
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        return 0;
+    }
+    quantizer_fingerprint_ = HashQuantizer(ivf_index->quantizer);
+    return quantizer_fingerprint_;
+}
+
+int64_t
+IVF::Nlist() {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    return (ivf_index == nullptr) ? 0 : ivf_index->nlist;
+}
+
+uint64_t
+IVF::HashQuantizer(const faiss::Index* quantizer) {
+    auto flat_index = dynamic_cast<const faiss::IndexFlat*>(quantizer);
+    if (flat_index == nullptr) {
+        return 0;
+    }
+
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+    uint64_t hash = FNV_OFFSET;
+    auto mix = [&](const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * FNV_PRIME;
+        }
+    };
+    int64_t header[3] = {flat_index->metric_type, flat_index->d, flat_index->ntotal};
+    mix(reinterpret_cast<const uint8_t*>(header), sizeof(header));
+    mix(reinterpret_cast<const uint8_t*>(flat_index->xb.data()), flat_index->xb.size() * sizeof(float));
+    return (hash == 0) ? 1 : hash;
+}
+
+void
+IVF::set_preprocessor(PreprocessorPtr preprocessor) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    preprocessor_ = std::move(preprocessor);
+}
+
 void
 IVF::set_index_model(IndexModelPtr model) {
     std::lock_guard<std::mutex> lk(mutex_);
@@ -157,6 +336,9 @@ IVF::set_index_model(IndexModelPtr model) {
 
     // Deep copy here.
     index_.reset(faiss::clone_index(rel_model->index_.get()));
+    quantizer_fingerprint_ = 0;
+    // a model shared by several indexes brings the rotation its quantizers were trained with
+    preprocessor_ = rel_model->preprocessor_;
 }
 
 std::shared_ptr<faiss::IVFSearchParameters>
@@ -180,6 +362,21 @@ IVF::Dimension() {
     return index_->d;
 }
 
+std::vector<std::pair<const void*, size_t>>
+IVF::MemoryRanges() {
+    // lists paged in lazily or kept on disk aren't owned by the index
+    std::vector<std::pair<const void*, size_t>> ranges;
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    auto lists = ivf_index != nullptr ? dynamic_cast<faiss::ArrayInvertedLists*>(ivf_index->invlists) : nullptr;
+    if (lists != nullptr) {
+        for (size_t i = 0; i < lists->nlist; i++) {
+            ranges.emplace_back(lists->codes[i].data(), lists->codes[i].size());
+            ranges.emplace_back(lists->ids[i].data(), lists->ids[i].size() * sizeof(faiss::InvertedLists::idx_t));
+        }
+    }
+    return ranges;
+}
+
 void
 IVF::GenGraph(const float* data, const int64_t& k, Graph& graph, const Config& config) {
     int64_t K = k + 1;
@@ -217,8 +414,34 @@ IVF::GenGraph(const float* data, const int64_t& k, Graph& graph, const Config& c
 void
 IVF::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) {
     auto params = GenParams(cfg);
+    params->sel = cfg->filter.get();
+
+    // with fewer queries than threads, a thread per query leaves the others idle; the lists of each query are
+    // scanned in parallel instead when a query probes enough of them
+    if (n < omp_get_max_threads() && (int64_t)params->nprobe >= PROBE_PARALLEL_RATIO * n) {
+        params->parallel_mode = 1;
+    }
+
+    // lists found by the quantizer of another index with the same fingerprint, for the same queries and nprobe
+    CoarseAssignmentPtr coarse = nullptr;
+    auto ivf_cfg = std::dynamic_pointer_cast<IVFCfg>(cfg);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_cfg != nullptr && ivf_cfg->coarse != nullptr && ivf_index != nullptr &&
+        ivf_cfg->coarse->nprobe == (int64_t)params->nprobe && ivf_cfg->coarse->keys.size() == n * params->nprobe) {
+        coarse = ivf_cfg->coarse;
+    }
+
+    if (coarse != nullptr && coarse->residuals.size() == coarse->keys.size() * ivf_index->d) {
+        params->residuals = coarse->residuals.data();
+    }
+
     stdclock::time_point before = stdclock::now();
-    faiss::ivflib::search_with_parameters(index_.get(), n, (float*)data, k, distances, labels, params.get());
+    if (coarse != nullptr) {
+        ivf_index->search_preassigned(n, data, k, coarse->keys.data(), coarse->distances.data(), distances, labels,
+                                      false, params.get());
+    } else {
+        faiss::ivflib::search_with_parameters(index_.get(), n, (float*)data, k, distances, labels, params.get());
+    }
     stdclock::time_point after = stdclock::now();
     double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
     KNOWHERE_LOG_DEBUG << "IVF search cost: " << search_cost
@@ -228,9 +451,56 @@ IVF::search_impl(int64_t n, const float* data, int64_t k, float* distances, int6
     faiss::indexIVF_stats.search_time = 0;
 }
 
+int64_t
+IVF::SampleTrainData(const Config& config, int64_t rows, int64_t dim, const float*& data, std::vector<float>& buffer) {
+    auto build_cfg = std::dynamic_pointer_cast<IVFCfg>(config);
+    if (build_cfg == nullptr || build_cfg->train_size <= 0 || build_cfg->train_size >= rows) {
+        return rows;
+    }
+
+    // fixed seed, a file gets the same quantizers each time it's built
+    auto sample_rows = build_cfg->train_size;
+    std::vector<int> perm(rows);
+    faiss::rand_perm(perm.data(), rows, 1234);
+    std::sort(perm.begin(), perm.begin() + sample_rows);
+
+    buffer.resize(sample_rows * dim);
+#pragma omp parallel for
+    for (int64_t i = 0; i < sample_rows; i++) {
+        memcpy(buffer.data() + i * dim, data + perm[i] * dim, sizeof(float) * dim);
+    }
+    data = buffer.data();
+
+    KNOWHERE_LOG_DEBUG << "IVF train with " << sample_rows << " sampled rows of " << rows;
+    return sample_rows;
+}
+
+PreprocessorPtr
+IVF::BuildRotation(const DatasetPtr& dataset, const Config& config, int64_t m) {
+    auto build_cfg = std::dynamic_pointer_cast<IVFCfg>(config);
+    if (build_cfg == nullptr || build_cfg->rotation == ROTATIONTYPE::NONE) {
+        return nullptr;
+    }
+
+    GETTENSOR(dataset)
+
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
+    return RotationPreprocessor::Train(build_cfg->rotation, train_rows, dim, p_data, m);
+}
+
+DatasetPtr
+IVF::Preprocess(const DatasetPtr& dataset) {
+    auto preprocessor = preprocessor_;
+    return preprocessor == nullptr ? dataset : preprocessor->Preprocess(dataset);
+}
+
 VectorIndexPtr
 IVF::CopyCpuToGpu(const int64_t& device_id, const Config& config) {
 #ifdef MILVUS_GPU_VERSION
+    if (preprocessor_ != nullptr) {
+        KNOWHERE_THROW_MSG("CopyCpuToGpu Error, a rotated index is only searched on cpu");
+    }
 
     if (auto res = FaissGpuResourceMgr::GetInstance().GetRes(device_id)) {
         ResScope rs(res, device_id, false);
@@ -248,6 +518,51 @@ IVF::CopyCpuToGpu(const int64_t& device_id, const Config& config) {
 #endif
 }
 
+VectorIndexPtr
+IVF::CopyCpuToGpuShards(const std::vector<int64_t>& device_ids, const Config& config) {
+#ifdef MILVUS_GPU_VERSION
+    if (preprocessor_ != nullptr) {
+        KNOWHERE_THROW_MSG("CopyCpuToGpuShards Error, a rotated index is only searched on cpu");
+    }
+    std::vector<int64_t> devices(device_ids);
+    std::sort(devices.begin(), devices.end());
+    devices.erase(std::unique(devices.begin(), devices.end()), devices.end());
+    if (devices.size() < 2) {
+        KNOWHERE_THROW_MSG("CopyCpuToGpuShards Error, need at least two gpus");
+    }
+
+    std::vector<ResPtr> resources;
+    for (auto device_id : devices) {
+        auto res = FaissGpuResourceMgr::GetInstance().GetRes(device_id);
+        if (res == nullptr) {
+            KNOWHERE_THROW_MSG("CopyCpuToGpuShards Error, can't get gpu_resource");
+        }
+        resources.push_back(res);
+    }
+
+    std::shared_ptr<faiss::Index> device_index;
+    {
+        std::vector<std::unique_ptr<ResScope>> scopes;
+        std::vector<faiss::gpu::GpuResources*> faiss_resources;
+        std::vector<int> faiss_devices;
+        for (size_t i = 0; i < devices.size(); ++i) {
+            scopes.emplace_back(new ResScope(resources[i], devices[i], false));
+            faiss_resources.push_back(resources[i]->faiss_res.get());
+            faiss_devices.push_back(devices[i]);
+        }
+
+        faiss::gpu::GpuMultipleClonerOptions option;
+        option.shard = true;
+        option.shard_type = 1;  // vector i goes to shard i % n, so every shard keeps a part of each list
+        device_index.reset(
+            faiss::gpu::index_cpu_to_gpu_multiple(faiss_resources, faiss_devices, index_.get(), &option));
+    }
+    return std::make_shared<GPUIVFShards>(device_index, devices, resources);
+#else
+    KNOWHERE_THROW_MSG("Calling IVF::CopyCpuToGpuShards when we are using CPU version");
+#endif
+}
+
 // VectorIndexPtr
 // IVF::Clone() {
 //    std::lock_guard<std::mutex> lk(mutex_);
@@ -271,7 +586,26 @@ IVF::Seal() {
     SealImpl();
 }
 
-IVFIndexModel::IVFIndexModel(std::shared_ptr<faiss::Index> index) : FaissBaseIndex(std::move(index)) {
+void
+IVF::Merge(const std::shared_ptr<IVF>& other) {
+    if (other.get() == this) {
+        KNOWHERE_THROW_MSG("merge an index into itself");
+    }
+
+    std::lock(mutex_, other->mutex_);
+    std::lock_guard<std::mutex> lk(mutex_, std::adopt_lock);
+    std::lock_guard<std::mutex> other_lk(other->mutex_, std::adopt_lock);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    auto other_index = dynamic_cast<faiss::IndexIVF*>(other->index_.get());
+    if (ivf_index == nullptr || other_index == nullptr) {
+        KNOWHERE_THROW_MSG("merge needs two ivf indexes on cpu");
+    }
+    // faiss checks nlist, dimension and code size, the ids were given at add so keep them as they are
+    ivf_index->merge_from(*other_index, 0);
+}
+
+IVFIndexModel::IVFIndexModel(std::shared_ptr<faiss::Index> index, PreprocessorPtr preprocessor)
+    : FaissBaseIndex(std::move(index)), preprocessor_(std::move(preprocessor)) {
 }
 
 BinarySet
@@ -38,6 +38,9 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     IndexModelPtr
     Train(const DatasetPtr& dataset, const Config& config) override;
 
+    void
+    set_preprocessor(PreprocessorPtr preprocessor) override;
+
     void
     set_index_model(IndexModelPtr model) override;
 
@@ -50,6 +53,28 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     DatasetPtr
     Search(const DatasetPtr& dataset, const Config& config) override;
 
+    DatasetPtr
+    RangeSearch(const DatasetPtr& dataset, float radius, const Config& config) override;
+
+    // lists the queries probe with the nprobe of the config, a search of any index with the same quantizer
+    // fingerprint can take them instead of searching its quantizer; nullptr if the quantizer is not on cpu
+    CoarseAssignmentPtr
+    CoarseAssign(const DatasetPtr& dataset, const Config& config);
+
+    // hash of metric and coarse centroids, indexes trained from the same model share it, 0 if quantizer not on cpu
+    virtual uint64_t
+    QuantizerFingerprint();
+
+    // number of inverted lists, 0 if the index is not an ivf one
+    virtual int64_t
+    Nlist();
+
+    // vectors are rotated before the quantizers see them, such an index can't be copied to gpu
+    bool
+    Rotated() const {
+        return preprocessor_ != nullptr;
+    }
+
     void
     GenGraph(const float* data, const int64_t& k, Graph& graph, const Config& config);
 
@@ -65,12 +90,24 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     int64_t
     Dimension() override;
 
+    std::vector<std::pair<const void*, size_t>>
+    MemoryRanges() override;
+
     void
     Seal() override;
 
+    // move the inverted lists of other into this index, both must be built on cpu from the same model;
+    // other is left empty
+    void
+    Merge(const std::shared_ptr<IVF>& other);
+
     virtual VectorIndexPtr
     CopyCpuToGpu(const int64_t& device_id, const Config& config);
 
+    // split vectors among the devices, the lists of every device share the same centroids
+    virtual VectorIndexPtr
+    CopyCpuToGpuShards(const std::vector<int64_t>& device_ids, const Config& config);
+
  protected:
     virtual std::shared_ptr<faiss::IVFSearchParameters>
     GenParams(const Config& config);
@@ -81,8 +118,32 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     virtual void
     search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg);
 
+    // point data to a random sample of train_size rows of the config when it's less than rows, the sample is
+    // kept in buffer; Return the number of rows to train with;
+    static int64_t
+    SampleTrainData(const Config& config, int64_t rows, int64_t dim, const float*& data, std::vector<float>& buffer);
+
+    // as CoarseAssign, the lists are searched in the given quantizer instead of the one of the index
+    CoarseAssignmentPtr
+    AssignLists(faiss::Index* quantizer, const DatasetPtr& dataset, const Config& config);
+
+    // rotation asked by the config trained on the rows sampled for the quantizers, nullptr if it asks for none;
+    // m is the number of pq subvectors an OPQ rotation balances
+    static PreprocessorPtr
+    BuildRotation(const DatasetPtr& dataset, const Config& config, int64_t m);
+
+    // vectors of the dataset rotated by the preprocessor of the index, the dataset itself if it has none
+    DatasetPtr
+    Preprocess(const DatasetPtr& dataset);
+
+    // FNV-1a of metric, dimension and centroids of a flat quantizer, 0 if it is not flat
+    static uint64_t
+    HashQuantizer(const faiss::Index* quantizer);
+
  protected:
     std::mutex mutex_;
+    PreprocessorPtr preprocessor_;
+    uint64_t quantizer_fingerprint_ = 0;  // computed once, reset when the index is replaced
 };
 
 using IVFIndexPtr = std::shared_ptr<IVF>;
@@ -93,7 +154,7 @@ class IVFIndexModel : public IndexModel, public FaissBaseIndex {
     friend GPUIVF;
 
  public:
-    explicit IVFIndexModel(std::shared_ptr<faiss::Index> index);
+    explicit IVFIndexModel(std::shared_ptr<faiss::Index> index, PreprocessorPtr preprocessor = nullptr);
 
     IVFIndexModel() : FaissBaseIndex(nullptr) {
     }
@@ -110,6 +171,7 @@ class IVFIndexModel : public IndexModel, public FaissBaseIndex {
 
  protected:
     std::mutex mutex_;
+    PreprocessorPtr preprocessor_;  // the quantizers are trained on vectors of this preprocessor
 };
 
 using IVFIndexModelPtr = std::shared_ptr<IVFIndexModel>;
@@ -28,6 +28,12 @@
 
 namespace knowhere {
 
+PreprocessorPtr
+IVFPQ::BuildPreprocessor(const DatasetPtr& dataset, const Config& config) {
+    auto build_cfg = std::dynamic_pointer_cast<IVFPQCfg>(config);
+    return BuildRotation(dataset, config, build_cfg == nullptr ? 0 : build_cfg->m);
+}
+
 IndexModelPtr
 IVFPQ::Train(const DatasetPtr& dataset, const Config& config) {
     auto build_cfg = std::dynamic_pointer_cast<IVFPQCfg>(config);
@@ -35,14 +41,18 @@ IVFPQ::Train(const DatasetPtr& dataset, const Config& config) {
         build_cfg->CheckValid();  // throw exception
     }
 
-    GETTENSOR(dataset)
+    auto input = Preprocess(dataset);
+    GETTENSOR(input)
+
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
 
     faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, GetMetricType(build_cfg->metric_type));
     auto index =
         std::make_shared<faiss::IndexIVFPQ>(coarse_quantizer, dim, build_cfg->nlist, build_cfg->m, build_cfg->nbits);
-    index->train(rows, (float*)p_data);
+    index->train(train_rows, (float*)p_data);
 
-    return std::make_shared<IVFIndexModel>(index);
+    return std::make_shared<IVFIndexModel>(index, preprocessor_);
 }
 
 std::shared_ptr<faiss::IVFSearchParameters>
@@ -65,6 +75,10 @@ IVFPQ::GenParams(const Config& config) {
 VectorIndexPtr
 IVFPQ::CopyCpuToGpu(const int64_t& device_id, const Config& config) {
 #ifdef MILVUS_GPU_VERSION
+    if (preprocessor_ != nullptr) {
+        KNOWHERE_THROW_MSG("CopyCpuToGpu Error, a rotated index is only searched on cpu");
+    }
+
     if (auto res = FaissGpuResourceMgr::GetInstance().GetRes(device_id)) {
         ResScope rs(res, device_id, false);
         auto gpu_index = faiss::gpu::index_cpu_to_gpu(res->faiss_res.get(), device_id, index_.get());
@@ -25,6 +25,9 @@ class IVFPQ : public IVF {
 
     IVFPQ() = default;
 
+    PreprocessorPtr
+    BuildPreprocessor(const DatasetPtr& dataset, const Config& config) override;
+
     IndexModelPtr
     Train(const DatasetPtr& dataset, const Config& config) override;
 
@@ -0,0 +1,59 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFPQFastScan.h>
+
+#include <memory>
+#include <vector>
+
+#include "knowhere/adapter/VectorAdapter.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+
+namespace knowhere {
+
+IndexModelPtr
+IVFPQFastScan::Train(const DatasetPtr& dataset, const Config& config) {
+    auto build_cfg = std::dynamic_pointer_cast<IVFPQCfg>(config);
+    if (build_cfg != nullptr) {
+        build_cfg->CheckValid();  // throw exception
+    }
+    if (build_cfg->nbits != 4 || build_cfg->m % 2 != 0) {
+        KNOWHERE_THROW_MSG("IVFPQFastScan needs 4 bits codes and an even number of pq subvectors");
+    }
+
+    auto input = Preprocess(dataset);
+    GETTENSOR(input)
+
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
+
+    auto metric_type = GetMetricType(build_cfg->metric_type);
+    faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, metric_type);
+    auto index = std::make_shared<faiss::IndexIVFPQFastScan>(coarse_quantizer, dim, build_cfg->nlist, build_cfg->m);
+    index->metric_type = metric_type;
+    index->train(train_rows, (float*)p_data);
+
+    return std::make_shared<IVFIndexModel>(index, preprocessor_);
+}
+
+VectorIndexPtr
+IVFPQFastScan::CopyCpuToGpu(const int64_t& device_id, const Config& config) {
+    KNOWHERE_THROW_MSG("CopyCpuToGpu Error, IVFPQFastScan is only searched on cpu");
+}
+
+VectorIndexPtr
+IVFPQFastScan::CopyCpuToGpuShards(const std::vector<int64_t>& device_ids, const Config& config) {
+    KNOWHERE_THROW_MSG("CopyCpuToGpuShards Error, IVFPQFastScan is only searched on cpu");
+}
+
+}  // namespace knowhere
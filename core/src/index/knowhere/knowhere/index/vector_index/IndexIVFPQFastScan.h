@@ -0,0 +1,44 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "IndexIVFPQ.h"
+
+namespace knowhere {
+
+/*
+ * IVFPQ with 4 bits codes, the lists are scanned a block of 32 codes at a time with the distance tables of the
+ * query quantized to 8 bits in SIMD registers. Only the codes which may enter the result heap get their distance
+ * from the float tables, so a search returns the results of IVFPQ with the same codes.
+ */
+class IVFPQFastScan : public IVFPQ {
+ public:
+    explicit IVFPQFastScan(std::shared_ptr<faiss::Index> index) : IVFPQ(std::move(index)) {
+    }
+
+    IVFPQFastScan() = default;
+
+    IndexModelPtr
+    Train(const DatasetPtr& dataset, const Config& config) override;
+
+    VectorIndexPtr
+    CopyCpuToGpu(const int64_t& device_id, const Config& config) override;
+
+    VectorIndexPtr
+    CopyCpuToGpuShards(const std::vector<int64_t>& device_ids, const Config& config) override;
+};
+
+}  // namespace knowhere
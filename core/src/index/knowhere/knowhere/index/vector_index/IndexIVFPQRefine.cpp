@@ -0,0 +1,216 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFPQ.h>
+#include <faiss/utils/distances.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "knowhere/adapter/VectorAdapter.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIVFPQRefine.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace knowhere {
+
+namespace {
+
+constexpr const char* REFINE_IDS_BINARY_NAME = "REFINE_IDS";
+constexpr const char* REFINE_DATA_BINARY_NAME = "REFINE_DATA";
+
+// candidates taken per result when the search config doesn't set k_factor
+constexpr int64_t DEFAULT_REFINE_K_FACTOR = 4;
+
+std::shared_ptr<uint8_t>
+AllocBuffer(size_t size) {
+    return std::shared_ptr<uint8_t>(new uint8_t[size], std::default_delete<uint8_t[]>());
+}
+
+}  // namespace
+
+IndexModelPtr
+IVFPQRefine::Train(const DatasetPtr& dataset, const Config& config) {
+    auto build_cfg = std::dynamic_pointer_cast<IVFPQCfg>(config);
+    if (build_cfg == nullptr) {
+        KNOWHERE_THROW_MSG("IVFPQ_REFINE needs a IVFPQ build config");
+    }
+    build_cfg->CheckValid();  // throw exception
+
+    auto input = Preprocess(dataset);
+    GETTENSOR(input)
+
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
+
+    // IVFPQ scans the codes by L2 whatever the metric is, here they use the metric of the table so the
+    // candidates are ranked the same way the refine step ranks them
+    auto metric_type = GetMetricType(build_cfg->metric_type);
+    faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, metric_type);
+    auto index =
+        std::make_shared<faiss::IndexIVFPQ>(coarse_quantizer, dim, build_cfg->nlist, build_cfg->m, build_cfg->nbits);
+    index->metric_type = metric_type;
+    index->train(train_rows, (float*)p_data);
+
+    return std::make_shared<IVFIndexModel>(index, preprocessor_);
+}
+
+void
+IVFPQRefine::Add(const DatasetPtr& dataset, const Config& config) {
+    IVF::Add(dataset, config);
+
+    // the queries are rotated before search_impl, so are the vectors they are refined with
+    auto input = Preprocess(dataset);
+    std::lock_guard<std::mutex> lk(mutex_);
+    GETTENSOR(input)
+    auto p_ids = input->Get<const int64_t*>(meta::IDS);
+
+    // merge with the vectors added before, then reorder all of them by id
+    auto old_ids = reinterpret_cast<const int64_t*>(refine_ids_.get());
+    auto old_data = reinterpret_cast<const float*>(refine_data_.get());
+    int64_t total = refine_count_ + rows;
+    std::vector<int64_t> order(total);
+    std::iota(order.begin(), order.end(), 0);
+    auto id_of = [&](int64_t i) { return i < refine_count_ ? old_ids[i] : p_ids[i - refine_count_]; };
+    std::sort(order.begin(), order.end(), [&](int64_t l, int64_t r) { return id_of(l) < id_of(r); });
+
+    size_t vector_size = sizeof(float) * dim;
+    auto ids = AllocBuffer(sizeof(int64_t) * total);
+    auto data = AllocBuffer(vector_size * total);
+    auto p_new_ids = reinterpret_cast<int64_t*>(ids.get());
+    for (int64_t i = 0; i < total; i++) {
+        auto src = order[i];
+        p_new_ids[i] = id_of(src);
+        auto vec = src < refine_count_ ? old_data + src * dim : p_data + (src - refine_count_) * dim;
+        memcpy(data.get() + i * vector_size, vec, vector_size);
+    }
+
+    refine_ids_ = ids;
+    refine_data_ = data;
+    refine_count_ = total;
+}
+
+BinarySet
+IVFPQRefine::Serialize() {
+    auto res_set = IVF::Serialize();
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    res_set.Append(REFINE_IDS_BINARY_NAME, refine_ids_, sizeof(int64_t) * refine_count_);
+    res_set.Append(REFINE_DATA_BINARY_NAME, refine_data_, sizeof(float) * index_->d * refine_count_);
+    return res_set;
+}
+
+void
+IVFPQRefine::Load(const BinarySet& index_binary) {
+    IVF::Load(index_binary);
+
+    try {
+        std::lock_guard<std::mutex> lk(mutex_);
+        // a file written without its refine data can't be searched, it is reported instead of read
+        auto& binaries = index_binary.binary_map_;
+        auto ids_iter = binaries.find(REFINE_IDS_BINARY_NAME);
+        auto data_iter = binaries.find(REFINE_DATA_BINARY_NAME);
+        if (ids_iter == binaries.end() || data_iter == binaries.end() || ids_iter->second == nullptr ||
+            data_iter->second == nullptr) {
+            KNOWHERE_THROW_MSG("refine data of IVFPQ_REFINE is missing");
+        }
+
+        auto ids = ids_iter->second;
+        auto data = data_iter->second;
+        if (index_->ntotal > 0 && (ids->data == nullptr || data->data == nullptr)) {
+            KNOWHERE_THROW_MSG("refine data of IVFPQ_REFINE is missing");
+        }
+        int64_t count = ids->size / sizeof(int64_t);
+        if (count != index_->ntotal || data->size != (int64_t)(sizeof(float) * index_->d * count)) {
+            KNOWHERE_THROW_MSG("refine data of IVFPQ_REFINE doesn't match the index");
+        }
+
+        // the binaries may point into a mapped file, they are kept instead of copied
+        refine_ids_ = ids->data;
+        refine_data_ = data->data;
+        refine_count_ = count;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+VectorIndexPtr
+IVFPQRefine::CopyCpuToGpu(const int64_t& device_id, const Config& config) {
+    KNOWHERE_THROW_MSG("IVFPQ_REFINE can't be copied to gpu, the raw vectors are only searched on cpu");
+}
+
+const float*
+IVFPQRefine::GetRefineVector(int64_t id) const {
+    auto ids = reinterpret_cast<const int64_t*>(refine_ids_.get());
+    auto it = std::lower_bound(ids, ids + refine_count_, id);
+    if (it == ids + refine_count_ || *it != id) {
+        return nullptr;
+    }
+    return reinterpret_cast<const float*>(refine_data_.get()) + (it - ids) * index_->d;
+}
+
+void
+IVFPQRefine::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                         const Config& cfg) {
+    auto search_cfg = std::dynamic_pointer_cast<IVFPQCfg>(cfg);
+    int64_t k_factor = DEFAULT_REFINE_K_FACTOR;
+    if (search_cfg != nullptr && search_cfg->k_factor > 0) {
+        k_factor = search_cfg->k_factor;
+    }
+
+    int64_t candidate_k = k * k_factor;
+    std::vector<float> candidate_dist(n * candidate_k);
+    std::vector<int64_t> candidate_ids(n * candidate_k);
+    IVF::search_impl(n, data, candidate_k, candidate_dist.data(), candidate_ids.data(), cfg);
+
+    auto dim = index_->d;
+    bool ip = index_->metric_type == faiss::METRIC_INNER_PRODUCT;
+#pragma omp parallel for
+    for (int64_t i = 0; i < n; i++) {
+        auto query = data + i * dim;
+        std::vector<std::pair<float, int64_t>> refined;
+        refined.reserve(candidate_k);
+        for (int64_t j = 0; j < candidate_k; j++) {
+            auto id = candidate_ids[i * candidate_k + j];
+            auto vec = id < 0 ? nullptr : GetRefineVector(id);
+            if (vec == nullptr) {
+                continue;
+            }
+            float dist = ip ? faiss::fvec_inner_product(query, vec, dim) : faiss::fvec_L2sqr(query, vec, dim);
+            refined.emplace_back(dist, id);
+        }
+
+        auto keep = std::min((int64_t)refined.size(), k);
+        auto compare = [ip](const std::pair<float, int64_t>& l, const std::pair<float, int64_t>& r) {
+            return ip ? l.first > r.first : l.first < r.first;
+        };
+        std::partial_sort(refined.begin(), refined.begin() + keep, refined.end(), compare);
+
+        auto row_dist = distances + i * k;
+        auto row_id = labels + i * k;
+        for (int64_t j = 0; j < keep; j++) {
+            row_dist[j] = refined[j].first;
+            row_id[j] = refined[j].second;
+        }
+        for (int64_t j = keep; j < k; j++) {
+            row_dist[j] = ip ? std::numeric_limits<float>::lowest() : std::numeric_limits<float>::max();
+            row_id[j] = -1;
+        }
+    }
+}
+
+}  // namespace knowhere
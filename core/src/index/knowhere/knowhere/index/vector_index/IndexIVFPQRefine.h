@@ -0,0 +1,62 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "IndexIVFPQ.h"
+
+namespace knowhere {
+
+/*
+ * IVFPQ which keeps the raw vectors next to the codes, a search takes k * k_factor candidates by PQ distance
+ * and returns the k best of them by exact distance. The raw vectors are sorted by id, an index loaded from a
+ * mapped file only pages in the vectors of the candidates.
+ */
+class IVFPQRefine : public IVFPQ {
+ public:
+    explicit IVFPQRefine(std::shared_ptr<faiss::Index> index) : IVFPQ(std::move(index)) {
+    }
+
+    IVFPQRefine() = default;
+
+    IndexModelPtr
+    Train(const DatasetPtr& dataset, const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset, const Config& config) override;
+
+    BinarySet
+    Serialize() override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    VectorIndexPtr
+    CopyCpuToGpu(const int64_t& device_id, const Config& config) override;
+
+ protected:
+    void
+    search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) override;
+
+    // raw vector of the id, nullptr if it isn't in the index
+    const float*
+    GetRefineVector(int64_t id) const;
+
+ private:
+    std::shared_ptr<uint8_t> refine_ids_;   // sorted ids
+    std::shared_ptr<uint8_t> refine_data_;  // float vectors in the order of refine_ids_
+    int64_t refine_count_ = 0;
+};
+
+}  // namespace knowhere
@@ -16,6 +16,7 @@
 #include <faiss/index_factory.h>
 
 #include <memory>
+#include <string>
 
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
@@ -28,6 +29,15 @@
 
 namespace knowhere {
 
+PreprocessorPtr
+IVFSQ::BuildPreprocessor(const DatasetPtr& dataset, const Config& config) {
+    auto build_cfg = std::dynamic_pointer_cast<IVFSQCfg>(config);
+    if (build_cfg != nullptr && build_cfg->rotation == ROTATIONTYPE::OPQ) {
+        KNOWHERE_THROW_MSG("IVFSQ only supports PCA rotation");
+    }
+    return BuildRotation(dataset, config, 0);
+}
+
 IndexModelPtr
 IVFSQ::Train(const DatasetPtr& dataset, const Config& config) {
     auto build_cfg = std::dynamic_pointer_cast<IVFSQCfg>(config);
@@ -35,17 +45,21 @@ IVFSQ::Train(const DatasetPtr& dataset, const Config& config) {
         build_cfg->CheckValid();  // throw exception
     }
 
-    GETTENSOR(dataset)
+    auto input = Preprocess(dataset);
+    GETTENSOR(input)
+
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
 
     std::stringstream index_type;
     index_type << "IVF" << build_cfg->nlist << ","
-               << "SQ" << build_cfg->nbits;
+               << "SQ" << (build_cfg->nbits == SQ_FP16_NBITS ? "fp16" : std::to_string(build_cfg->nbits));
     auto build_index = faiss::index_factory(dim, index_type.str().c_str(), GetMetricType(build_cfg->metric_type));
-    build_index->train(rows, (float*)p_data);
+    build_index->train(train_rows, (float*)p_data);
 
     std::shared_ptr<faiss::Index> ret_index;
     ret_index.reset(build_index);
-    return std::make_shared<IVFIndexModel>(ret_index);
+    return std::make_shared<IVFIndexModel>(ret_index, preprocessor_);
 }
 
 // VectorIndexPtr
@@ -56,6 +70,9 @@ IVFSQ::Train(const DatasetPtr& dataset, const Config& config) {
 VectorIndexPtr
 IVFSQ::CopyCpuToGpu(const int64_t& device_id, const Config& config) {
 #ifdef MILVUS_GPU_VERSION
+    if (preprocessor_ != nullptr) {
+        KNOWHERE_THROW_MSG("CopyCpuToGpu Error, a rotated index is only searched on cpu");
+    }
 
     if (auto res = FaissGpuResourceMgr::GetInstance().GetRes(device_id)) {
         ResScope rs(res, device_id, false);
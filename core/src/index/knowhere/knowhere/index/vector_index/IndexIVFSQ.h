@@ -25,6 +25,9 @@ class IVFSQ : public IVF {
 
     IVFSQ() = default;
 
+    PreprocessorPtr
+    BuildPreprocessor(const DatasetPtr& dataset, const Config& config) override;
+
     IndexModelPtr
     Train(const DatasetPtr& dataset, const Config& config) override;
 
@@ -15,6 +15,7 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 
+#include <faiss/IndexFlat.h>
 #include <faiss/gpu/GpuCloner.h>
 #include <faiss/gpu/GpuIndexIVF.h>
 #include <faiss/index_factory.h>
@@ -39,6 +40,9 @@ IVFSQHybrid::Train(const DatasetPtr& dataset, const Config& config) {
 
     GETTENSOR(dataset)
 
+    std::vector<float> sample;
+    auto train_rows = SampleTrainData(config, rows, dim, p_data, sample);
+
     std::stringstream index_type;
     index_type << "IVF" << build_cfg->nlist << ","
                << "SQ8Hybrid";
@@ -48,7 +52,7 @@ IVFSQHybrid::Train(const DatasetPtr& dataset, const Config& config) {
     if (temp_resource != nullptr) {
         ResScope rs(temp_resource, gpu_id_, true);
         auto device_index = faiss::gpu::index_cpu_to_gpu(temp_resource->faiss_res.get(), gpu_id_, build_index);
-        device_index->train(rows, (float*)p_data);
+        device_index->train(train_rows, (float*)p_data);
 
         std::shared_ptr<faiss::Index> host_index = nullptr;
         host_index.reset(faiss::gpu::index_gpu_to_cpu(device_index));
@@ -164,7 +168,7 @@ IVFSQHybrid::LoadQuantizer(const Config& conf) {
         q->quantizer = q_ptr;
         q->gpu_id = gpu_id;
         res_ = res;
-        gpu_mode = 1;
+        // the index keeps searching its own quantizer until this one is set, it may be shared by other searches
         return q;
     } else {
         KNOWHERE_THROW_MSG("CopyCpuToGpu Error, can't get gpu: " + std::to_string(gpu_id) + "resource");
@@ -200,8 +204,26 @@ IVFSQHybrid::UnsetQuantizer() {
         KNOWHERE_THROW_MSG("Index type error");
     }
 
-    ivf_index->quantizer = nullptr;
+    // back to the quantizer on cpu, a search of the index without a gpu quantizer still finds its lists
+    ivf_index->quantizer = ivf_index->quantizer_backup;
     quantizer_gpu_id_ = -1;
+    gpu_mode = 0;
+}
+
+CoarseAssignmentPtr
+IVFSQHybrid::CoarseAssign(const QuantizerPtr& q, const DatasetPtr& dataset, const Config& config) {
+    auto ivf_quantizer = std::dynamic_pointer_cast<FaissIVFQuantizer>(q);
+    if (ivf_quantizer == nullptr) {
+        KNOWHERE_THROW_MSG("Quantizer type error");
+    }
+
+    if (auto res = FaissGpuResourceMgr::GetInstance().GetRes(ivf_quantizer->gpu_id)) {
+        ResScope rs(res, ivf_quantizer->gpu_id, true);
+        return AssignLists(ivf_quantizer->quantizer, dataset, config);
+    } else {
+        KNOWHERE_THROW_MSG("Hybrid CoarseAssign Error, can't get gpu: " + std::to_string(ivf_quantizer->gpu_id) +
+                           "resource");
+    }
 }
 
 VectorIndexPtr
@@ -273,6 +295,22 @@ IVFSQHybrid::CopyCpuToGpuWithQuantizer(const int64_t& device_id, const Config& c
     }
 }
 
+uint64_t
+IVFSQHybrid::QuantizerFingerprint() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (quantizer_fingerprint_ != 0) {
+        return quantizer_fingerprint_;
+    }
+
+    auto* ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        return 0;
+    }
+    auto q = (ivf_index->quantizer_backup != nullptr) ? ivf_index->quantizer_backup : ivf_index->quantizer;
+    quantizer_fingerprint_ = HashQuantizer(q);
+    return quantizer_fingerprint_;
+}
+
 void
 IVFSQHybrid::set_index_model(IndexModelPtr model) {
     std::lock_guard<std::mutex> lk(mutex_);
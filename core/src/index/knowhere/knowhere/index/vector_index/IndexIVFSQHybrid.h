@@ -60,12 +60,23 @@ class IVFSQHybrid : public GPUIVFSQ {
     void
     UnsetQuantizer();
 
+    using IVF::CoarseAssign;
+
+    // as CoarseAssign, the lists are searched in a quantizer loaded on a gpu, the index itself stays on cpu and
+    // scans them with search of the assignment
+    CoarseAssignmentPtr
+    CoarseAssign(const QuantizerPtr& q, const DatasetPtr& dataset, const Config& config);
+
     VectorIndexPtr
     LoadData(const knowhere::QuantizerPtr& q, const Config& conf);
 
     std::pair<VectorIndexPtr, QuantizerPtr>
     CopyCpuToGpuWithQuantizer(const int64_t& device_id, const Config& config);
 
+    // hash of coarse centroids, indexes trained from the same model share it, 0 if quantizer not on cpu
+    uint64_t
+    QuantizerFingerprint() override;
+
     IndexModelPtr
     Train(const DatasetPtr& dataset, const Config& config) override;
 
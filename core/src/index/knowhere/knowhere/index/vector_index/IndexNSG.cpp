@@ -12,6 +12,7 @@
 #include "knowhere/index/vector_index/IndexNSG.h"
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
 #include "knowhere/common/Timer.h"
 
 #ifdef MILVUS_GPU_VERSION
@@ -91,6 +92,7 @@ NSG::Search(const DatasetPtr& dataset, const Config& config) {
 
     algo::SearchParams s_params;
     s_params.search_length = build_cfg->search_length;
+    s_params.filter = build_cfg->filter.get();
     index_->Search((float*)p_data, rows, dim, build_cfg->k, p_dist, p_id, s_params);
 
     auto ret_ds = std::make_shared<Dataset>();
@@ -107,6 +109,7 @@ NSG::Train(const DatasetPtr& dataset, const Config& config) {
         build_cfg->CheckValid();  // throw exception
     }
 
+    TimeRecorder rc("NSG::Train", 1);
     auto idmap = std::make_shared<IDMAP>();
     idmap->Train(config);
     idmap->AddWithoutId(dataset, config);
@@ -132,6 +135,7 @@ NSG::Train(const DatasetPtr& dataset, const Config& config) {
     preprocess_index->AddWithoutIds(dataset, config);
     preprocess_index->GenGraph(raw_data, build_cfg->knng, knng, config);
 #endif
+    double knng_time = rc.RecordSection("knn graph");
 
     algo::BuildParams b_params;
     b_params.candidate_pool_size = build_cfg->candidate_pool_size;
@@ -144,6 +148,10 @@ NSG::Train(const DatasetPtr& dataset, const Config& config) {
     index_ = std::make_shared<algo::NsgIndex>(dim, rows);
     index_->SetKnnGraph(knng);
     index_->Build_with_ids(rows, (float*)p_data, (int64_t*)p_ids, b_params);
+    double nsg_time = rc.RecordSection("nsg graph");
+    KNOWHERE_LOG_INFO << "NSG index of " << rows << " vectors trained, knn graph: "
+                      << TimeRecorder::GetTimeSpanStr(knng_time)
+                      << ", nsg graph: " << TimeRecorder::GetTimeSpanStr(nsg_time);
     return nullptr;  // TODO(linxj): support serialize
 }
 
@@ -13,8 +13,10 @@
 #include <SPTAG/AnnService/inc/Core/VectorSet.h>
 #include <SPTAG/AnnService/inc/Server/QueryParser.h>
 
+#include <omp.h>
 #include <array>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #undef mkdir
@@ -136,7 +138,11 @@ CPUSPTAGRNG::Train(const DatasetPtr& origin, const Config& train_config) {
 
     auto vectorset = ConvertToVectorSet(dataset);
     auto metaset = ConvertToMetadataSet(dataset);
+
+    // SPTAG sets the omp threads of the calling thread to NumberOfThreads, give them back after the build
+    auto omp_threads = omp_get_max_threads();
     index_ptr_->BuildIndex(vectorset, metaset);
+    omp_set_num_threads(omp_threads);
 
     // TODO: return IndexModelPtr
     return nullptr;
@@ -179,7 +185,6 @@ CPUSPTAGRNG::SetParameters(const Config& config) {
         Assign(refineiterations, "RefineIterations");
         Assign(cef, "CEF");
         Assign(maxcheckforrefinegraph, "MaxCheckForRefineGraph");
-        Assign(numofthreads, "NumberOfThreads");
         Assign(maxcheck, "MaxCheck");
         Assign(thresholdofnumberofcontinuousnobetterpropagation, "ThresholdOfNumberOfContinuousNoBetterPropagation");
         Assign(numberofinitialdynamicpivots, "NumberOfInitialDynamicPivots");
@@ -201,12 +206,21 @@ CPUSPTAGRNG::SetParameters(const Config& config) {
         Assign(refineiterations, "RefineIterations");
         Assign(cef, "CEF");
         Assign(maxcheckforrefinegraph, "MaxCheckForRefineGraph");
-        Assign(numofthreads, "NumberOfThreads");
         Assign(maxcheck, "MaxCheck");
         Assign(thresholdofnumberofcontinuousnobetterpropagation, "ThresholdOfNumberOfContinuousNoBetterPropagation");
         Assign(numberofinitialdynamicpivots, "NumberOfInitialDynamicPivots");
         Assign(numberofotherdynamicpivots, "NumberOfOtherDynamicPivots");
     }
+
+    // threads of the build and number of workspaces kept for concurrent queries, the omp threads of the
+    // engine if the config doesn't set it
+    auto conf = std::dynamic_pointer_cast<SPTAGCfg>(config);
+    int64_t numofthreads = omp_get_max_threads();
+    if (conf != nullptr && conf->numofthreads > 0) {
+        numofthreads = conf->numofthreads;
+    }
+    index_ptr_->SetParameter("NumberOfThreads", std::to_string(numofthreads));
+#undef Assign
 }
 
 DatasetPtr
@@ -216,19 +230,11 @@ CPUSPTAGRNG::Search(const DatasetPtr& dataset, const Config& config) {
     //        config->CheckValid();  // throw exception
     //    }
 
-    auto p_data = dataset->Get<const float*>(meta::TENSOR);
-    for (auto i = 0; i < 10; ++i) {
-        for (auto j = 0; j < 10; ++j) {
-            std::cout << p_data[i * 10 + j] << " ";
-        }
-        std::cout << std::endl;
-    }
     std::vector<SPTAG::QueryResult> query_results = ConvertToQueryResult(dataset, config);
 
-#pragma omp parallel for
-    for (auto i = 0; i < query_results.size(); ++i) {
-        auto target = (float*)query_results[i].GetTarget();
-        std::cout << target[0] << ", " << target[1] << ", " << target[2] << std::endl;
+    // each query rents a workspace from the pool of the index, so the batch is searched in parallel
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < (int64_t)query_results.size(); ++i) {
         index_ptr_->SearchIndex(query_results[i]);
     }
 
@@ -12,9 +12,12 @@
 #pragma once
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "knowhere/common/Config.h"
 #include "knowhere/common/Dataset.h"
+#include "knowhere/common/Exception.h"
 #include "knowhere/index/Index.h"
 #include "knowhere/index/preprocessor/Preprocessor.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
@@ -42,6 +45,12 @@ class VectorIndex : public Index {
     virtual void
     Seal() = 0;
 
+    // return at most config->k neighbors within radius for each query, laid out as the result of Search()
+    virtual DatasetPtr
+    RangeSearch(const DatasetPtr& dataset, float radius, const Config& config) {
+        KNOWHERE_THROW_MSG("range search not supported by this index");
+    }
+
     // TODO(linxj): Deprecated
     //    virtual VectorIndexPtr
     //    Clone() = 0;
@@ -51,6 +60,12 @@ class VectorIndex : public Index {
 
     virtual int64_t
     Dimension() = 0;
+
+    // buffers of the data searches scan, address and bytes; the cache may back them by huge pages
+    virtual std::vector<std::pair<const void*, size_t>>
+    MemoryRanges() {
+        return {};
+    }
 };
 
 }  // namespace knowhere
@@ -55,5 +55,21 @@ CopyCpuToGpu(const VectorIndexPtr& index, const int64_t& device_id, const Config
     }
 }
 
+VectorIndexPtr
+CopyCpuToGpuShards(const VectorIndexPtr& index, const std::vector<int64_t>& device_ids, const Config& config) {
+#ifdef CUSTOMIZATION
+    if (std::dynamic_pointer_cast<IVFSQHybrid>(index)) {
+        KNOWHERE_THROW_MSG("this index type not support sharding to gpus");
+    }
+#endif
+
+    if (std::dynamic_pointer_cast<GPUIndex>(index) == nullptr) {
+        if (auto cpu_index = std::dynamic_pointer_cast<IVF>(index)) {
+            return cpu_index->CopyCpuToGpuShards(device_ids, config);
+        }
+    }
+    KNOWHERE_THROW_MSG("this index type not support sharding to gpus");
+}
+
 }  // namespace cloner
 }  // namespace knowhere
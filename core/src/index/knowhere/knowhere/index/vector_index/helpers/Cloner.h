@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "knowhere/index/vector_index/VectorIndex.h"
 
 namespace knowhere {
@@ -23,5 +25,9 @@ CopyCpuToGpu(const VectorIndexPtr& index, const int64_t& device_id, const Config
 extern VectorIndexPtr
 CopyGpuToCpu(const VectorIndexPtr& index, const Config& config);
 
+// only ivf indexes on cpu can be sharded
+extern VectorIndexPtr
+CopyCpuToGpuShards(const VectorIndexPtr& index, const std::vector<int64_t>& device_ids, const Config& config);
+
 }  // namespace cloner
 }  // namespace knowhere
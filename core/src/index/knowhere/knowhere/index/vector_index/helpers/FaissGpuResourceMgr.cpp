@@ -11,11 +11,19 @@
 
 #include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
 
+#include <cuda_runtime.h>
 #include <fiu-local.h>
+#include <algorithm>
 #include <utility>
 
 namespace knowhere {
 
+namespace {
+constexpr int64_t PINNED_HOST_MIN_SIZE = 4096;
+// pinned pages can't be swapped, don't keep more of them idle than this
+constexpr int64_t PINNED_HOST_MAX_CACHED = 256 * 1024 * 1024;
+}  // namespace
+
 FaissGpuResourceMgr&
 FaissGpuResourceMgr::GetInstance() {
     static FaissGpuResourceMgr instance;
@@ -42,11 +50,38 @@ FaissGpuResourceMgr::InitDevice(int64_t device_id, int64_t pin_mem_size, int64_t
     params.temp_mem_size = temp_mem_size;
     params.resource_num = res_num;
 
-    devices_params_.emplace(device_id, params);
+    std::lock_guard<std::mutex> lock(init_mutex_);
+    if (!devices_params_.emplace(device_id, params).second) {
+        return;
+    }
+    // device added after resources initialized, e.g. by reconfiguration at runtime
+    if (is_init) {
+        init_device_resource(device_id, params);
+    }
+}
+
+void
+FaissGpuResourceMgr::init_device_resource(int64_t device_id, const DeviceParams& device_param) {
+    mutex_cache_.emplace(device_id, std::make_unique<std::mutex>());
+
+    auto& bq = idle_map_[device_id];
+    for (int64_t i = 0; i < device_param.resource_num; ++i) {
+        auto raw_resource = std::make_shared<faiss::gpu::StandardGpuResources>();
+        // pinned memory lets faiss page queries and results and overlap the copies with search
+        if (device_param.pinned_mem_size > 0) {
+            raw_resource->setPinnedMemory(device_param.pinned_mem_size);
+        }
+
+        auto res_wrapper = std::make_shared<Resource>(raw_resource);
+        AllocateTempMem(res_wrapper, device_id, 0);
+
+        bq.Put(res_wrapper);
+    }
 }
 
 void
 FaissGpuResourceMgr::InitResource() {
+    std::lock_guard<std::mutex> lock(init_mutex_);
     if (is_init)
         return;
 
@@ -54,24 +89,7 @@ FaissGpuResourceMgr::InitResource() {
 
     // std::cout << "InitResource" << std::endl;
     for (auto& device : devices_params_) {
-        auto& device_id = device.first;
-
-        mutex_cache_.emplace(device_id, std::make_unique<std::mutex>());
-
-        // std::cout << "Device Id: " << DEVICEID << std::endl;
-        auto& device_param = device.second;
-        auto& bq = idle_map_[device_id];
-
-        for (int64_t i = 0; i < device_param.resource_num; ++i) {
-            // std::cout << "Resource Id: " << i << std::endl;
-            auto raw_resource = std::make_shared<faiss::gpu::StandardGpuResources>();
-
-            // TODO(linxj): enable set pinned memory
-            auto res_wrapper = std::make_shared<Resource>(raw_resource);
-            AllocateTempMem(res_wrapper, device_id, 0);
-
-            bq.Put(res_wrapper);
-        }
+        init_device_resource(device.first, device.second);
     }
     // std::cout << "End initResource" << std::endl;
 }
@@ -81,10 +99,16 @@ FaissGpuResourceMgr::GetRes(const int64_t& device_id, const int64_t& alloc_size)
     fiu_return_on("FaissGpuResourceMgr.GetRes.ret_null", nullptr);
     InitResource();
 
-    auto finder = idle_map_.find(device_id);
-    if (finder != idle_map_.end()) {
-        auto& bq = finder->second;
-        auto&& resource = bq.Take();
+    ResBQ* bq = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(init_mutex_);
+        auto finder = idle_map_.find(device_id);
+        if (finder != idle_map_.end()) {
+            bq = &finder->second;
+        }
+    }
+    if (bq != nullptr) {
+        auto&& resource = bq->Take();
         AllocateTempMem(resource, device_id, alloc_size);
         return resource;
     }
@@ -93,13 +117,68 @@ FaissGpuResourceMgr::GetRes(const int64_t& device_id, const int64_t& alloc_size)
 
 void
 FaissGpuResourceMgr::MoveToIdle(const int64_t& device_id, const ResPtr& res) {
+    std::lock_guard<std::mutex> lock(init_mutex_);
     auto finder = idle_map_.find(device_id);
     if (finder != idle_map_.end()) {
         auto& bq = finder->second;
+        auto overflow = static_cast<int64_t>(res->faiss_res->getMemoryManager(device_id).getHighWaterCudaMalloc());
+        auto& high_water = temp_mem_overflow_[device_id];
+        high_water = std::max(high_water, overflow);
         bq.Put(res);
     }
 }
 
+int64_t
+FaissGpuResourceMgr::GetTempMemOverflow(const int64_t& device_id) {
+    std::lock_guard<std::mutex> lock(init_mutex_);
+    auto finder = temp_mem_overflow_.find(device_id);
+    return finder != temp_mem_overflow_.end() ? finder->second : 0;
+}
+
+int64_t
+FaissGpuResourceMgr::GetResNum(const int64_t& device_id) {
+    std::lock_guard<std::mutex> lock(init_mutex_);
+    auto finder = devices_params_.find(device_id);
+    return finder != devices_params_.end() ? finder->second.resource_num : 0;
+}
+
+std::shared_ptr<uint8_t>
+FaissGpuResourceMgr::AllocPinnedHost(int64_t size) {
+    fiu_return_on("FaissGpuResourceMgr.AllocPinnedHost.ret_null", nullptr);
+    int64_t bucket = PINNED_HOST_MIN_SIZE;
+    while (bucket < size) {
+        bucket <<= 1;
+    }
+
+    uint8_t* data = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pinned_mutex_);
+        auto& buffers = pinned_free_[bucket];
+        if (!buffers.empty()) {
+            data = buffers.back();
+            buffers.pop_back();
+            pinned_cached_ -= bucket;
+        }
+    }
+    if (data == nullptr && cudaHostAlloc((void**)&data, bucket, cudaHostAllocDefault) != cudaSuccess) {
+        return nullptr;
+    }
+    return std::shared_ptr<uint8_t>(data, [this, bucket](uint8_t* p) { release_pinned_host(p, bucket); });
+}
+
+void
+FaissGpuResourceMgr::release_pinned_host(uint8_t* data, int64_t size) {
+    {
+        std::lock_guard<std::mutex> lock(pinned_mutex_);
+        if (pinned_cached_ + size <= PINNED_HOST_MAX_CACHED) {
+            pinned_free_[size].push_back(data);
+            pinned_cached_ += size;
+            return;
+        }
+    }
+    cudaFreeHost(data);
+}
+
 void
 FaissGpuResourceMgr::Free() {
     for (auto& item : idle_map_) {
@@ -108,6 +187,16 @@ FaissGpuResourceMgr::Free() {
             bq.Take();
         }
     }
+    {
+        std::lock_guard<std::mutex> lock(pinned_mutex_);
+        for (auto& item : pinned_free_) {
+            for (auto data : item.second) {
+                cudaFreeHost(data);
+            }
+        }
+        pinned_free_.clear();
+        pinned_cached_ = 0;
+    }
     is_init = false;
 }
 
@@ -15,6 +15,7 @@
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 #include <faiss/gpu/StandardGpuResources.h>
 
@@ -72,15 +73,42 @@ class FaissGpuResourceMgr {
     void
     MoveToIdle(const int64_t& device_id, const ResPtr& res);
 
+    // number of resources the device gets, so the number of tasks which can search on it at once; 0 if not added
+    int64_t
+    GetResNum(const int64_t& device_id);
+
+    // host memory pinned for copies between host and gpus, freed buffers are kept by size for the next ones;
+    // nullptr if it can't be allocated
+    std::shared_ptr<uint8_t>
+    AllocPinnedHost(int64_t size);
+
+    // most memory faiss had to cudaMalloc on the device because the temp memory of a resource ran out,
+    // sampled when resources are returned; 0 if the temp memory was always enough
+    int64_t
+    GetTempMemOverflow(const int64_t& device_id);
+
     void
     Dump();
 
+ protected:
+    void
+    init_device_resource(int64_t device_id, const DeviceParams& device_param);
+
+    void
+    release_pinned_host(uint8_t* data, int64_t size);
+
  protected:
     bool is_init = false;
+    std::mutex init_mutex_;
 
     std::map<int64_t, std::unique_ptr<std::mutex>> mutex_cache_;
     std::map<int64_t, DeviceParams> devices_params_;
     std::map<int64_t, ResBQ> idle_map_;
+    std::map<int64_t, int64_t> temp_mem_overflow_;
+
+    std::mutex pinned_mutex_;
+    std::map<int64_t, std::vector<uint8_t*>> pinned_free_;  // buffers of a power of two size
+    int64_t pinned_cached_ = 0;
 };
 
 class ResScope {
@@ -96,8 +124,9 @@ class ResScope {
     }
 
     // specif for search
-    // get the ownership of gpuresource and gpu
-    ResScope(ResWPtr& res, const int64_t& device_id) : device_id(device_id), move(false), own(true) {
+    // get the ownership of gpuresource only, each resource has its own stream,
+    // so searches holding different resources run on the same gpu concurrently
+    ResScope(ResWPtr& res, const int64_t& device_id) : device_id(device_id), move(false), own(false) {
         resource = res.lock();
         Lock();
     }
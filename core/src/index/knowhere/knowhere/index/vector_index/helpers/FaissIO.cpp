@@ -9,6 +9,7 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include <cstring>
 
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
@@ -58,4 +59,15 @@ MemoryIOReader::operator()(void* ptr, size_t size, size_t nitems) {
     return nitems;
 }
 
+const uint8_t*
+MemoryIOReader::borrow(size_t size, std::shared_ptr<void>& borrower) {
+    if (!owner || size > total - std::min(rp, total)) {
+        return nullptr;
+    }
+    auto ptr = data_ + rp;
+    rp += size;
+    borrower = owner;
+    return ptr;
+}
+
 }  // namespace knowhere
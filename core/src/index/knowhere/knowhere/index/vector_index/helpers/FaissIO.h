@@ -13,6 +13,8 @@
 
 #include <faiss/impl/io.h>
 
+#include <memory>
+
 namespace knowhere {
 
 struct MemoryIOWriter : public faiss::IOWriter {
@@ -26,7 +28,7 @@ struct MemoryIOWriter : public faiss::IOWriter {
     template <typename T>
     size_t
     write(T* ptr, size_t size, size_t nitems = 1) {
-        operator()((const void*)ptr, size, nitems);
+        return operator()((const void*)ptr, size, nitems);
     }
 };
 
@@ -34,14 +36,18 @@ struct MemoryIOReader : public faiss::IOReader {
     uint8_t* data_;
     size_t rp = 0;
     size_t total = 0;
+    std::shared_ptr<void> owner;  // holder of data_, set to let faiss use the data in place
 
     size_t
     operator()(void* ptr, size_t size, size_t nitems) override;
 
+    const uint8_t*
+    borrow(size_t size, std::shared_ptr<void>& borrower) override;
+
     template <typename T>
     size_t
     read(T* ptr, size_t size, size_t nitems = 1) {
-        operator()((void*)ptr, size, nitems);
+        return operator()((void*)ptr, size, nitems);
     }
 };
 
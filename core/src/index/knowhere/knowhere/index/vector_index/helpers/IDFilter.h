@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <faiss/impl/AuxIndexStructures.h>
+
+#include <memory>
+#include <vector>
+
+#include "knowhere/common/Config.h"
+
+namespace knowhere {
+
+// Restrict a search to part of the vectors by their ids. A whitelist accepts the listed ids only, a blacklist accepts
+// all but the listed ids. Indexes evaluate it while scanning, instead of filtering an over-fetched topk.
+class IDFilter : public faiss::IDSelector {
+ public:
+    IDFilter(const std::vector<int64_t>& ids, bool blacklist)
+        : ids_(ids.size(), ids.data()), blacklist_(blacklist) {
+    }
+
+    bool
+    is_member(idx_t id) const override {
+        return ids_.is_member(id) != blacklist_;
+    }
+
+    bool
+    IsBlacklist() const {
+        return blacklist_;
+    }
+
+ private:
+    faiss::IDSelectorBatch ids_;
+    bool blacklist_;
+};
+
+}  // namespace knowhere
@@ -41,7 +41,8 @@ GetMetricType(METRICTYPE& type) {
 std::stringstream
 IVFCfg::DumpImpl() {
     auto ss = Cfg::DumpImpl();
-    ss << ", nlist: " << nlist << ", nprobe: " << nprobe;
+    ss << ", nlist: " << nlist << ", nprobe: " << nprobe << ", train_size: " << train_size
+       << ", rotation: " << int(rotation);
     return ss;
 }
 
@@ -60,4 +61,30 @@ NSGCfg::DumpImpl() {
     return ss;
 }
 
+bool
+DiskANNCfg::CheckValid() {
+    // robust prune of the graph compares l2 distances, inner product doesn't satisfy the triangle inequality
+    if (metric_type != METRICTYPE::L2) {
+        std::stringstream ss;
+        ss << "MetricType: " << int(metric_type) << " not support by DiskANN!";
+        KNOWHERE_THROW_MSG(ss.str());
+    }
+    if (max_degree <= 0 || build_list < max_degree || alpha < 1.0 || beam_width <= 0) {
+        KNOWHERE_THROW_MSG("DiskANN needs max_degree > 0, build_list >= max_degree, alpha >= 1 and beam_width > 0");
+    }
+    if (pq_m <= 0 || d % pq_m != 0) {
+        KNOWHERE_THROW_MSG("DiskANN needs a pq_m dividing the dimension");
+    }
+    return true;
+}
+
+std::stringstream
+DiskANNCfg::DumpImpl() {
+    auto ss = Cfg::DumpImpl();
+    ss << ", max_degree: " << max_degree << ", build_list: " << build_list << ", alpha: " << alpha
+       << ", search_list: " << search_list << ", beam_width: " << beam_width << ", pq_m: " << pq_m
+       << ", disk_path: " << disk_path;
+    return ss;
+}
+
 }  // namespace knowhere
@@ -13,6 +13,8 @@
 
 #include <faiss/Index.h>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "knowhere/common/Config.h"
 
@@ -29,6 +31,16 @@ constexpr int64_t DEFAULT_NBITS = INVALID_VALUE;
 constexpr int64_t DEFAULT_SCAN_TABLE_THREHOLD = INVALID_VALUE;
 constexpr int64_t DEFAULT_POLYSEMOUS_HT = INVALID_VALUE;
 constexpr int64_t DEFAULT_MAX_CODES = INVALID_VALUE;
+constexpr int64_t DEFAULT_K_FACTOR = INVALID_VALUE;
+constexpr int64_t DEFAULT_TRAIN_SIZE = INVALID_VALUE;
+constexpr int64_t SQ_FP16_NBITS = 16;  // nbits of IVFSQ keeping half floats instead of quantized codes
+
+// rotation of the vectors before an ivf index quantizes them, it keeps the distances between vectors
+enum class ROTATIONTYPE {
+    NONE = 0,
+    OPQ = 1,  // learned to balance the variance among the pq subvectors, only for IVFPQ
+    PCA = 2,  // principal axes of the vectors
+};
 
 // NSG Config
 constexpr int64_t DEFAULT_SEARCH_LENGTH = INVALID_VALUE;
@@ -66,9 +78,29 @@ constexpr int64_t DEFAULT_BKTLEAFSIZE = INVALID_VALUE;
 constexpr int64_t DEFAULT_M = INVALID_VALUE;
 constexpr int64_t DEFAULT_EF = INVALID_VALUE;
 
+// DiskANN Config
+constexpr int64_t DEFAULT_MAX_DEGREE = 64;
+constexpr int64_t DEFAULT_BUILD_LIST = 100;
+constexpr float DEFAULT_ALPHA = 1.2;
+constexpr int64_t DEFAULT_SEARCH_LIST = INVALID_VALUE;
+constexpr int64_t DEFAULT_BEAM_WIDTH = 4;
+
+// lists probed by a batch of queries, nprobe list ids and coarse distances per query, valid for every index
+// whose quantizer has the same fingerprint
+struct CoarseAssignment {
+    int64_t nprobe = 0;
+    std::vector<int64_t> keys;
+    std::vector<float> distances;
+    std::vector<float> residuals;  // query minus centroid per key, for L2 scalar quantizers by residual only
+};
+using CoarseAssignmentPtr = std::shared_ptr<CoarseAssignment>;
+
 struct IVFCfg : public Cfg {
     int64_t nlist = DEFAULT_NLIST;
     int64_t nprobe = DEFAULT_NPROBE;
+    int64_t train_size = DEFAULT_TRAIN_SIZE;     // rows sampled to train the quantizers, all rows if not positive
+    ROTATIONTYPE rotation = ROTATIONTYPE::NONE;  // trained on the same rows as the quantizers
+    CoarseAssignmentPtr coarse = nullptr;        // search only, lists of the queries so the quantizer isn't searched
 
     IVFCfg(const int64_t& dim, const int64_t& k, const int64_t& gpu_id, const int64_t& nlist, const int64_t& nprobe,
            METRICTYPE type)
@@ -126,6 +158,9 @@ struct IVFPQCfg : public IVFCfg {
     int64_t m = DEFAULT_NSUBVECTORS;  // number of subquantizers(subvector)
     int64_t nbits = DEFAULT_NBITS;    // number of bit per subvector index
 
+    // IVFPQ_REFINE re-scores k * k_factor pq candidates with exact distances
+    int64_t k_factor = DEFAULT_K_FACTOR;
+
     // TODO(linxj): not use yet
     int64_t scan_table_threhold = DEFAULT_SCAN_TABLE_THREHOLD;
     int64_t polysemous_ht = DEFAULT_POLYSEMOUS_HT;
@@ -248,4 +283,23 @@ struct HNSWCfg : public Cfg {
 };
 using HNSWConfig = std::shared_ptr<HNSWCfg>;
 
+struct DiskANNCfg : public Cfg {
+    int64_t max_degree = DEFAULT_MAX_DEGREE;    // out degree bound of every node in graph, R of vamana
+    int64_t build_list = DEFAULT_BUILD_LIST;    // candidate list of the searches building graph, L of vamana
+    float alpha = DEFAULT_ALPHA;                // prune keeps longer edges as alpha grows, so paths get shorter
+    int64_t search_list = DEFAULT_SEARCH_LIST;  // candidate list of search, not less than k
+    int64_t beam_width = DEFAULT_BEAM_WIDTH;    // nodes read from disk in one round trip of every search step
+    int64_t pq_m = DEFAULT_NSUBVECTORS;         // 8 bits pq codes that stay in memory, m bytes per vector
+    std::string disk_path;                      // file keeping the full vectors and graph, written by build
+
+    DiskANNCfg() = default;
+
+    bool
+    CheckValid() override;
+
+    std::stringstream
+    DumpImpl() override;
+};
+using DiskANNConfig = std::shared_ptr<DiskANNCfg>;
+
 }  // namespace knowhere
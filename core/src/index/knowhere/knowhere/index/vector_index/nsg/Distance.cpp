@@ -9,8 +9,6 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
-#pragma once
-
 #include <immintrin.h>
 
 #include "knowhere/index/vector_index/nsg/Distance.h"
@@ -18,88 +16,13 @@
 namespace knowhere {
 namespace algo {
 
-float
-DistanceL2::Compare(const float* a, const float* b, unsigned size) const {
-    float result = 0;
+namespace {
 
-#ifdef __GNUC__
-#ifdef __AVX__
-
-#define AVX_L2SQR(addr1, addr2, dest, tmp1, tmp2) \
-    tmp1 = _mm256_loadu_ps(addr1);                \
-    tmp2 = _mm256_loadu_ps(addr2);                \
-    tmp1 = _mm256_sub_ps(tmp1, tmp2);             \
-    tmp1 = _mm256_mul_ps(tmp1, tmp1);             \
-    dest = _mm256_add_ps(dest, tmp1);
-
-    __m256 sum;
-    __m256 l0, l1;
-    __m256 r0, r1;
-    unsigned D = (size + 7) & ~7U;
-    unsigned DR = D % 16;
-    unsigned DD = D - DR;
-    const float* l = a;
-    const float* r = b;
-    const float* e_l = l + DD;
-    const float* e_r = r + DD;
-    float unpack[8] __attribute__((aligned(32))) = {0, 0, 0, 0, 0, 0, 0, 0};
-
-    sum = _mm256_loadu_ps(unpack);
-    if (DR) {
-        AVX_L2SQR(e_l, e_r, sum, l0, r0);
-    }
-
-    for (unsigned i = 0; i < DD; i += 16, l += 16, r += 16) {
-        AVX_L2SQR(l, r, sum, l0, r0);
-        AVX_L2SQR(l + 8, r + 8, sum, l1, r1);
-    }
-    _mm256_storeu_ps(unpack, sum);
-    result = unpack[0] + unpack[1] + unpack[2] + unpack[3] + unpack[4] + unpack[5] + unpack[6] + unpack[7];
-
-#else
-#ifdef __SSE2__
-#define SSE_L2SQR(addr1, addr2, dest, tmp1, tmp2) \
-    tmp1 = _mm_load_ps(addr1);                    \
-    tmp2 = _mm_load_ps(addr2);                    \
-    tmp1 = _mm_sub_ps(tmp1, tmp2);                \
-    tmp1 = _mm_mul_ps(tmp1, tmp1);                \
-    dest = _mm_add_ps(dest, tmp1);
-
-    __m128 sum;
-    __m128 l0, l1, l2, l3;
-    __m128 r0, r1, r2, r3;
-    unsigned D = (size + 3) & ~3U;
-    unsigned DR = D % 16;
-    unsigned DD = D - DR;
-    const float* l = a;
-    const float* r = b;
-    const float* e_l = l + DD;
-    const float* e_r = r + DD;
-    float unpack[4] __attribute__((aligned(16))) = {0, 0, 0, 0};
-
-    sum = _mm_load_ps(unpack);
-    switch (DR) {
-        case 12:
-            SSE_L2SQR(e_l + 8, e_r + 8, sum, l2, r2);
-        case 8:
-            SSE_L2SQR(e_l + 4, e_r + 4, sum, l1, r1);
-        case 4:
-            SSE_L2SQR(e_l, e_r, sum, l0, r0);
-        default:
-            break;
-    }
-    for (unsigned i = 0; i < DD; i += 16, l += 16, r += 16) {
-        SSE_L2SQR(l, r, sum, l0, r0);
-        SSE_L2SQR(l + 4, r + 4, sum, l1, r1);
-        SSE_L2SQR(l + 8, r + 8, sum, l2, r2);
-        SSE_L2SQR(l + 12, r + 12, sum, l3, r3);
-    }
-    _mm_storeu_ps(unpack, sum);
-    result += unpack[0] + unpack[1] + unpack[2] + unpack[3];
-
-// nomal distance
-#else
+using DistanceFunc = float (*)(const float*, const float*, unsigned);
 
+float
+L2SqrRef(const float* a, const float* b, unsigned size) {
+    float result = 0;
     float diff0, diff1, diff2, diff3;
     const float* last = a + size;
     const float* unroll_group = last - 3;
@@ -114,94 +37,17 @@ DistanceL2::Compare(const float* a, const float* b, unsigned size) const {
         a += 4;
         b += 4;
     }
-    /* Process last 0-3 pixels.  Not needed for standard vector lengths. */
+    /* Process last 0-3 items. */
     while (a < last) {
         diff0 = *a++ - *b++;
         result += diff0 * diff0;
     }
-#endif
-#endif
-#endif
-
     return result;
 }
 
 float
-DistanceIP::Compare(const float* a, const float* b, unsigned size) const {
+InnerProductRef(const float* a, const float* b, unsigned size) {
     float result = 0;
-
-#ifdef __GNUC__
-#ifdef __AVX__
-#define AVX_DOT(addr1, addr2, dest, tmp1, tmp2) \
-    tmp1 = _mm256_loadu_ps(addr1);              \
-    tmp2 = _mm256_loadu_ps(addr2);              \
-    tmp1 = _mm256_mul_ps(tmp1, tmp2);           \
-    dest = _mm256_add_ps(dest, tmp1);
-
-    __m256 sum;
-    __m256 l0, l1;
-    __m256 r0, r1;
-    unsigned D = (size + 7) & ~7U;
-    unsigned DR = D % 16;
-    unsigned DD = D - DR;
-    const float* l = a;
-    const float* r = b;
-    const float* e_l = l + DD;
-    const float* e_r = r + DD;
-    float unpack[8] __attribute__((aligned(32))) = {0, 0, 0, 0, 0, 0, 0, 0};
-
-    sum = _mm256_loadu_ps(unpack);
-    if (DR) {
-        AVX_DOT(e_l, e_r, sum, l0, r0);
-    }
-
-    for (unsigned i = 0; i < DD; i += 16, l += 16, r += 16) {
-        AVX_DOT(l, r, sum, l0, r0);
-        AVX_DOT(l + 8, r + 8, sum, l1, r1);
-    }
-    _mm256_storeu_ps(unpack, sum);
-    result = unpack[0] + unpack[1] + unpack[2] + unpack[3] + unpack[4] + unpack[5] + unpack[6] + unpack[7];
-
-#else
-#ifdef __SSE2__
-#define SSE_DOT(addr1, addr2, dest, tmp1, tmp2) \
-    tmp1 = _mm128_loadu_ps(addr1);              \
-    tmp2 = _mm128_loadu_ps(addr2);              \
-    tmp1 = _mm128_mul_ps(tmp1, tmp2);           \
-    dest = _mm128_add_ps(dest, tmp1);
-    __m128 sum;
-    __m128 l0, l1, l2, l3;
-    __m128 r0, r1, r2, r3;
-    unsigned D = (size + 3) & ~3U;
-    unsigned DR = D % 16;
-    unsigned DD = D - DR;
-    const float* l = a;
-    const float* r = b;
-    const float* e_l = l + DD;
-    const float* e_r = r + DD;
-    float unpack[4] __attribute__((aligned(16))) = {0, 0, 0, 0};
-
-    sum = _mm_load_ps(unpack);
-    switch (DR) {
-        case 12:
-            SSE_DOT(e_l + 8, e_r + 8, sum, l2, r2);
-        case 8:
-            SSE_DOT(e_l + 4, e_r + 4, sum, l1, r1);
-        case 4:
-            SSE_DOT(e_l, e_r, sum, l0, r0);
-        default:
-            break;
-    }
-    for (unsigned i = 0; i < DD; i += 16, l += 16, r += 16) {
-        SSE_DOT(l, r, sum, l0, r0);
-        SSE_DOT(l + 4, r + 4, sum, l1, r1);
-        SSE_DOT(l + 8, r + 8, sum, l2, r2);
-        SSE_DOT(l + 12, r + 12, sum, l3, r3);
-    }
-    _mm_storeu_ps(unpack, sum);
-    result += unpack[0] + unpack[1] + unpack[2] + unpack[3];
-#else
-
     float dot0, dot1, dot2, dot3;
     const float* last = a + size;
     const float* unroll_group = last - 3;
@@ -216,26 +62,190 @@ DistanceIP::Compare(const float* a, const float* b, unsigned size) const {
         a += 4;
         b += 4;
     }
-    /* Process last 0-3 pixels.  Not needed for standard vector lengths. */
+    /* Process last 0-3 items. */
     while (a < last) {
         result += *a++ * *b++;
     }
+    return result;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KNOWHERE_DISTANCE_DISPATCH
+
+/*
+ * Kernels of each instruction set are compiled by target attribute, whatever flags the file is built with,
+ * and only called when cpu supports them. Items beyond the last full register are summed by the reference,
+ * a vector is never read past its end.
+ */
+__attribute__((target("avx"))) float
+HorizontalSum(__m256 v) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_hadd_ps(sum, sum);
+    sum = _mm_hadd_ps(sum, sum);
+    return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx"))) float
+L2SqrAVX(const float* a, const float* b, unsigned size) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    unsigned i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(d0, d0));
+        sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(d1, d1));
+    }
+    if (i + 8 <= size) {
+        __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(d0, d0));
+        i += 8;
+    }
+    return HorizontalSum(_mm256_add_ps(sum0, sum1)) + L2SqrRef(a + i, b + i, size - i);
+}
+
+__attribute__((target("avx"))) float
+InnerProductAVX(const float* a, const float* b, unsigned size) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    unsigned i = 0;
+    for (; i + 16 <= size; i += 16) {
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    if (i + 8 <= size) {
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        i += 8;
+    }
+    return HorizontalSum(_mm256_add_ps(sum0, sum1)) + InnerProductRef(a + i, b + i, size - i);
+}
+
+// fused multiply-add, four accumulators to hide its latency
+__attribute__((target("avx2,fma"))) float
+L2SqrAVX2(const float* a, const float* b, unsigned size) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+    unsigned i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        __m256 d2 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16));
+        __m256 d3 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24));
+        sum0 = _mm256_fmadd_ps(d0, d0, sum0);
+        sum1 = _mm256_fmadd_ps(d1, d1, sum1);
+        sum2 = _mm256_fmadd_ps(d2, d2, sum2);
+        sum3 = _mm256_fmadd_ps(d3, d3, sum3);
+    }
+    for (; i + 8 <= size; i += 8) {
+        __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        sum0 = _mm256_fmadd_ps(d0, d0, sum0);
+    }
+    __m256 sum = _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3));
+    return HorizontalSum(sum) + L2SqrRef(a + i, b + i, size - i);
+}
+
+__attribute__((target("avx2,fma"))) float
+InnerProductAVX2(const float* a, const float* b, unsigned size) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+    unsigned i = 0;
+    for (; i + 32 <= size; i += 32) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), sum3);
+    }
+    for (; i + 8 <= size; i += 8) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+    }
+    __m256 sum = _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3));
+    return HorizontalSum(sum) + InnerProductRef(a + i, b + i, size - i);
+}
+
+// the tail is loaded with a mask, lanes beyond size are zero
+__attribute__((target("avx512f"))) float
+L2SqrAVX512(const float* a, const float* b, unsigned size) {
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    unsigned i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m512 d0 = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+        __m512 d1 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16));
+        sum0 = _mm512_fmadd_ps(d0, d0, sum0);
+        sum1 = _mm512_fmadd_ps(d1, d1, sum1);
+    }
+    for (; i < size; i += 16) {
+        __mmask16 mask = (size - i >= 16) ? 0xFFFF : (__mmask16)((1U << (size - i)) - 1);
+        __m512 d0 = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i));
+        sum0 = _mm512_fmadd_ps(d0, d0, sum0);
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+}
+
+__attribute__((target("avx512f"))) float
+InnerProductAVX512(const float* a, const float* b, unsigned size) {
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    unsigned i = 0;
+    for (; i + 32 <= size; i += 32) {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), sum0);
+        sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), sum1);
+    }
+    for (; i < size; i += 16) {
+        __mmask16 mask = (size - i >= 16) ? 0xFFFF : (__mmask16)((1U << (size - i)) - 1);
+        sum0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), sum0);
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+}
 #endif
+
+struct DistanceKernels {
+    DistanceFunc l2;
+    DistanceFunc ip;
+    const char* instruction_set;
+};
+
+DistanceKernels
+SelectKernels() {
+#ifdef KNOWHERE_DISTANCE_DISPATCH
+    // may run before constructors of libgcc, cpu features must be initialized explicitly
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return DistanceKernels{L2SqrAVX512, InnerProductAVX512, "avx512"};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return DistanceKernels{L2SqrAVX2, InnerProductAVX2, "avx2"};
+    }
+    if (__builtin_cpu_supports("avx")) {
+        return DistanceKernels{L2SqrAVX, InnerProductAVX, "avx"};
+    }
 #endif
-#endif
-    return result;
+    return DistanceKernels{L2SqrRef, InnerProductRef, "none"};
 }
 
-//#include <faiss/utils/distances.h>
-// float
-// DistanceL2::Compare(const float* a, const float* b, unsigned size) const {
-//    return faiss::fvec_L2sqr(a,b,size);
-//}
-//
-// float
-// DistanceIP::Compare(const float* a, const float* b, unsigned size) const {
-//    return faiss::fvec_inner_product(a,b,size);
-//}
+// picked once, Compare is called in every hop of graph search
+const DistanceKernels kernels = SelectKernels();
+
+}  // namespace
+
+float
+DistanceL2::Compare(const float* a, const float* b, unsigned size) const {
+    return kernels.l2(a, b, size);
+}
+
+float
+DistanceIP::Compare(const float* a, const float* b, unsigned size) const {
+    return kernels.ip(a, b, size);
+}
+
+const char*
+DistanceInstructionSet() {
+    return kernels.instruction_set;
+}
 
 }  // namespace algo
 }  // namespace knowhere
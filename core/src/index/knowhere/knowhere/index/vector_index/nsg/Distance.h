@@ -29,5 +29,9 @@ struct DistanceIP : public Distance {
     Compare(const float* a, const float* b, unsigned size) const override;
 };
 
+// instruction set of the distance kernels, picked once at startup by cpu features: "avx512", "avx2", "avx" or "none"
+const char*
+DistanceInstructionSet();
+
 }  // namespace algo
 }  // namespace knowhere
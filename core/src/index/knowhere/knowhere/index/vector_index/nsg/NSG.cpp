@@ -19,6 +19,7 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
 #include "knowhere/common/Timer.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
 #include "knowhere/index/vector_index/nsg/NSG.h"
 #include "knowhere/index/vector_index/nsg/NSGHelper.h"
 
@@ -27,7 +28,13 @@
 namespace knowhere {
 namespace algo {
 
-unsigned int seed = 100;
+// graph is built and searched by many threads, each draws random nodes from its own seed
+thread_local unsigned int seed = 100;
+
+constexpr size_t FLAT_BLOCK_ALIGN = 64;  // cache line
+
+// how many neighbors ahead to prefetch in search
+constexpr size_t PREFETCH_DISTANCE = 2;
 
 NsgIndex::NsgIndex(const size_t& dimension, const size_t& n, METRICTYPE metric)
     : dimension(dimension), ntotal(n), metric_type(metric) {
@@ -45,6 +52,7 @@ NsgIndex::~NsgIndex() {
     delete[] ori_data_;
     delete[] ids_;
     delete distance_;
+    free(flat_graph_);
 }
 
 void
@@ -62,13 +70,13 @@ NsgIndex::Build_with_ids(size_t nb, const float* data, const int64_t* ids, const
     TimeRecorder rc("NSG", 1);
 
     InitNavigationPoint();
-    rc.RecordSection("init");
+    double init_time = rc.RecordSection("init");
 
     Link();
-    rc.RecordSection("Link");
+    double link_time = rc.RecordSection("Link");
 
     CheckConnectivity();
-    rc.RecordSection("Connect");
+    double connect_time = rc.RecordSection("Connect");
 
     int total_degree = 0;
     for (size_t i = 0; i < ntotal; ++i) {
@@ -78,6 +86,14 @@ NsgIndex::Build_with_ids(size_t nb, const float* data, const int64_t* ids, const
     KNOWHERE_LOG_DEBUG << "Graph physical size: " << total_degree * sizeof(node_t) / 1024 / 1024 << "m";
     KNOWHERE_LOG_DEBUG << "Average degree: " << total_degree / ntotal;
 
+    BuildFlatGraph();
+    double flatten_time = rc.RecordSection("Flatten");
+
+    KNOWHERE_LOG_INFO << "NSG graph of " << ntotal << " vectors built, init: "
+                      << TimeRecorder::GetTimeSpanStr(init_time) << ", link: " << TimeRecorder::GetTimeSpanStr(link_time)
+                      << ", connect: " << TimeRecorder::GetTimeSpanStr(connect_time)
+                      << ", flatten: " << TimeRecorder::GetTimeSpanStr(flatten_time);
+
     is_trained = true;
 
     // Debug code
@@ -96,9 +112,18 @@ NsgIndex::InitNavigationPoint() {
     auto center = new float[dimension];
     memset(center, 0, sizeof(float) * dimension);
 
-    for (size_t i = 0; i < ntotal; i++) {
+#pragma omp parallel
+    {
+        std::vector<float> partial(dimension, 0);
+#pragma omp for schedule(static)
+        for (size_t i = 0; i < ntotal; i++) {
+            for (size_t j = 0; j < dimension; j++) {
+                partial[j] += ori_data_[i * dimension + j];
+            }
+        }
+#pragma omp critical
         for (size_t j = 0; j < dimension; j++) {
-            center[j] += ori_data_[i * dimension + j];
+            center[j] += partial[j];
         }
     }
     for (size_t j = 0; j < dimension; j++) {
@@ -325,9 +350,18 @@ NsgIndex::GetNeighbors(const float* query, std::vector<Neighbor>& resset, std::v
 }
 
 void
-NsgIndex::GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph& graph, SearchParams* params) {
+NsgIndex::GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph& graph, SearchParams* params,
+                       std::vector<Neighbor>* filtered_set) {
     size_t buffer_size = params ? params->search_length : search_length;
 
+    // filtered out nodes are still walked through, they may lead to accepted ones
+    const IDFilter* filter = (params && filtered_set) ? params->filter : nullptr;
+    auto collect = [&](node_t id, float dist) {
+        if (filter && filter->is_member(ids_[id])) {
+            filtered_set->emplace_back(id, dist);
+        }
+    };
+
     if (buffer_size > ntotal) {
         // TODO: throw exception here.
     }
@@ -375,6 +409,7 @@ NsgIndex::GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph&
 
             float dist = distance_->Compare(ori_data_ + id * dimension, query, dimension);
             resset[i] = Neighbor(id, dist, false);
+            collect(id, dist);
         }
         std::sort(resset.begin(), resset.end());  // sort by distance
 
@@ -395,6 +430,7 @@ NsgIndex::GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph&
                     has_calculated_dist[id] = true;
 
                     float dist = distance_->Compare(query, ori_data_ + dimension * id, dimension);
+                    collect(id, dist);
 
                     if (dist >= resset[buffer_size - 1].distance)
                         continue;
@@ -427,11 +463,147 @@ NsgIndex::GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph&
     }
 }
 
+void
+NsgIndex::GetNeighborsFlat(const float* query, SearchContext& context, SearchParams* params) {
+    size_t buffer_size = params ? params->search_length : search_length;
+
+    // filtered out nodes are still walked through, they may lead to accepted ones
+    const IDFilter* filter = params ? params->filter : nullptr;
+    auto& filtered_set = context.filtered_set;
+    filtered_set.clear();
+    auto collect = [&](node_t id, float dist) {
+        if (filter && filter->is_member(ids_[id])) {
+            filtered_set.emplace_back(id, dist);
+        }
+    };
+
+    auto& init_ids = context.init_ids;
+    auto& resset = context.resset;
+    auto& has_calculated_dist = context.visited;
+    init_ids.resize(buffer_size);
+    resset.resize(buffer_size);
+    has_calculated_dist.Reset(ntotal);
+
+    {
+        // copy navigation-point neighbor, pick random node if less than buffer size
+        size_t count = 0;
+        size_t neighbor_num = 0;
+        const node_t* neighbors = NodeNeighbors(navigation_point, neighbor_num);
+        for (size_t i = 0; i < init_ids.size() && i < neighbor_num; ++i) {
+            init_ids[i] = neighbors[i];
+            has_calculated_dist.Set(init_ids[i]);
+            ++count;
+        }
+        while (count < buffer_size) {
+            node_t id = rand_r(&seed) % ntotal;
+            if (has_calculated_dist.Get(id))
+                continue;  // duplicate id
+            init_ids[count] = id;
+            ++count;
+            has_calculated_dist.Set(id);
+        }
+    }
+
+    for (size_t i = 0; i < init_ids.size(); ++i) {
+        if (i + PREFETCH_DISTANCE < init_ids.size()) {
+            __builtin_prefetch(NodeData(init_ids[i + PREFETCH_DISTANCE]));
+        }
+        node_t id = init_ids[i];
+        float dist = distance_->Compare(NodeData(id), query, dimension);
+        resset[i] = Neighbor(id, dist, false);
+        collect(id, dist);
+    }
+    std::sort(resset.begin(), resset.end());  // sort by distance
+
+    // search nearest neighbor
+    size_t cursor = 0;
+    while (cursor < buffer_size) {
+        size_t nearest_updated_pos = buffer_size;
+
+        if (!resset[cursor].has_explored) {
+            resset[cursor].has_explored = true;
+
+            size_t neighbor_num = 0;
+            const node_t* neighbors = NodeNeighbors(resset[cursor].id, neighbor_num);
+            for (size_t i = 0; i < PREFETCH_DISTANCE && i < neighbor_num; ++i) {
+                __builtin_prefetch(NodeData(neighbors[i]));
+            }
+            for (size_t i = 0; i < neighbor_num; ++i) {
+                if (i + PREFETCH_DISTANCE < neighbor_num) {
+                    __builtin_prefetch(NodeData(neighbors[i + PREFETCH_DISTANCE]));
+                }
+
+                node_t id = neighbors[i];
+                if (has_calculated_dist.Get(id))
+                    continue;
+                has_calculated_dist.Set(id);
+
+                float dist = distance_->Compare(query, NodeData(id), dimension);
+                collect(id, dist);
+
+                if (dist >= resset[buffer_size - 1].distance)
+                    continue;
+
+                Neighbor nn(id, dist, false);
+                size_t pos = InsertIntoPool(resset.data(), buffer_size, nn);  // replace with a closer node
+                if (pos < nearest_updated_pos)
+                    nearest_updated_pos = pos;
+
+                // trick: avoid search query search_length < init_ids.size() ...
+                if (buffer_size + 1 < resset.size())
+                    ++buffer_size;
+            }
+        }
+        if (cursor >= nearest_updated_pos) {
+            cursor = nearest_updated_pos;  // re-search from new pos
+        } else {
+            ++cursor;
+        }
+    }
+}
+
+void
+NsgIndex::BuildFlatGraph() {
+    flat_degree_ = 0;
+    for (size_t i = 0; i < ntotal; ++i) {
+        flat_degree_ = std::max(flat_degree_, nsg[i].size());
+    }
+
+    size_t block_size = sizeof(node_t) * (1 + flat_degree_) + sizeof(float) * dimension;
+    size_t stride = (block_size + FLAT_BLOCK_ALIGN - 1) / FLAT_BLOCK_ALIGN * FLAT_BLOCK_ALIGN;
+    auto flat_graph = static_cast<char*>(aligned_alloc(FLAT_BLOCK_ALIGN, std::max<size_t>(stride * ntotal, stride)));
+    if (flat_graph == nullptr) {
+        KNOWHERE_THROW_MSG("Failed to allocate flat graph");
+    }
+    memset(flat_graph, 0, stride * ntotal);
+
+    for (size_t i = 0; i < ntotal; ++i) {
+        char* block = flat_graph + i * stride;
+        auto neighbor_num = static_cast<node_t>(nsg[i].size());
+        memcpy(block, &neighbor_num, sizeof(node_t));
+        memcpy(block + sizeof(node_t), nsg[i].data(), sizeof(node_t) * neighbor_num);
+        memcpy(block + sizeof(node_t) * (1 + flat_degree_), ori_data_ + i * dimension, sizeof(float) * dimension);
+    }
+
+    free(flat_graph_);
+    flat_graph_ = flat_graph;
+    flat_stride_ = stride;
+
+    // search and serialize only read the flat graph from now on
+    delete[] ori_data_;
+    ori_data_ = nullptr;
+    Graph().swap(nsg);
+
+    KNOWHERE_LOG_DEBUG << "Flat graph physical size: " << flat_stride_ * ntotal / 1024 / 1024 << "m";
+}
+
 void
 NsgIndex::Link() {
     float* cut_graph_dist = new float[ntotal * out_degree];
     nsg.resize(ntotal);
 
+    TimeRecorder rc("NSG::Link", 1);
+
 #pragma omp parallel
     {
         std::vector<Neighbor> fullset;
@@ -465,12 +637,15 @@ NsgIndex::Link() {
     // }
 
     knng.clear();
+    rc.RecordSection("prune");
 
+    // one lock per node, a node is only locked while its own neighbor pool is read or written
     std::vector<std::mutex> mutex_vec(ntotal);
-#pragma omp for schedule(dynamic, 100)
+#pragma omp parallel for schedule(dynamic, 100)
     for (unsigned n = 0; n < ntotal; ++n) {
         InterInsert(n, mutex_vec, cut_graph_dist);
     }
+    rc.RecordSection("inter insert");
 
     delete[] cut_graph_dist;
 }
@@ -516,9 +691,16 @@ void
 NsgIndex::InterInsert(unsigned n, std::vector<std::mutex>& mutex_vec, float* cut_graph_dist) {
     auto& current = n;
 
-    auto& neighbor_id_pool = nsg[current];
-    float* neighbor_dist_pool = cut_graph_dist + current * out_degree;
-    for (size_t i = 0; i < out_degree; ++i) {
+    // other threads may link to current meanwhile, work on a copy of its pool
+    std::vector<node_t> neighbor_id_pool;
+    std::vector<float> neighbor_dist_pool;
+    {
+        LockGuard lk(mutex_vec[current]);
+        neighbor_id_pool = nsg[current];
+        float* dist_pool = cut_graph_dist + current * out_degree;
+        neighbor_dist_pool.assign(dist_pool, dist_pool + neighbor_id_pool.size());
+    }
+    for (size_t i = 0; i < neighbor_id_pool.size(); ++i) {
         if (neighbor_dist_pool[i] == -1)
             break;
 
@@ -565,10 +747,14 @@ NsgIndex::InterInsert(unsigned n, std::vector<std::mutex>& mutex_vec, float* cut
 
             {
                 LockGuard lk(mutex_vec[current_neighbor]);
+                nsn_id_pool.resize(result.size());
                 for (size_t j = 0; j < result.size(); ++j) {
                     nsn_id_pool[j] = result[j].id;
                     nsn_dist_pool[j] = result[j].distance;
                 }
+                if (result.size() < out_degree) {
+                    nsn_dist_pool[result.size()] = -1;
+                }
             }
         } else {
             LockGuard lk(mutex_vec[current_neighbor]);
@@ -703,43 +889,46 @@ NsgIndex::FindUnconnectedNode(boost::dynamic_bitset<>& has_linked, int64_t& root
 void
 NsgIndex::Search(const float* query, const unsigned& nq, const unsigned& dim, const unsigned& k, float* dist,
                  int64_t* ids, SearchParams& params) {
-    std::vector<std::vector<Neighbor>> resset(nq);
-
     if (k >= 45) {
         params.search_length = k;
     }
 
     TimeRecorder rc("NsgIndex::search", 1);
-    // TODO(linxj): when to use openmp
-    if (nq <= 4) {
-        GetNeighbors(query, resset[0], nsg, &params);
-    } else {
-#pragma omp parallel for
+#pragma omp parallel if (nq > 1)
+    {
+        // buffers and visited table are allocated once per thread, not per query
+        SearchContext context;
+#pragma omp for schedule(dynamic)
         for (unsigned int i = 0; i < nq; ++i) {
             const float* single_query = query + i * dim;
-            GetNeighbors(single_query, resset[i], nsg, &params);
-        }
-    }
-    rc.RecordSection("search");
-    for (unsigned int i = 0; i < nq; ++i) {
-        int64_t var = resset[i].size() - k;
-        if (var >= 0) {
-            for (unsigned int j = 0; j < k; ++j) {
-                ids[i * k + j] = ids_[resset[i][j].id];
-                dist[i * k + j] = resset[i][j].distance;
+            if (flat_graph_ != nullptr) {
+                GetNeighborsFlat(single_query, context, &params);
+            } else {
+                context.filtered_set.clear();
+                GetNeighbors(single_query, context.resset, nsg, &params,
+                             params.filter ? &context.filtered_set : nullptr);
             }
-        } else {
-            for (unsigned int j = 0; j < resset[i].size(); ++j) {
-                ids[i * k + j] = ids_[resset[i][j].id];
-                dist[i * k + j] = resset[i][j].distance;
+
+            std::vector<Neighbor>* result = &context.resset;
+            size_t count = std::min(result->size(), static_cast<size_t>(k));
+            if (params.filter != nullptr) {
+                // result comes from all the accepted nodes visited, not only from the ones left in search pool
+                result = &context.filtered_set;
+                count = std::min(result->size(), static_cast<size_t>(k));
+                std::partial_sort(result->begin(), result->begin() + count, result->end());
+            }
+
+            for (size_t j = 0; j < count; ++j) {
+                ids[i * k + j] = ids_[(*result)[j].id];
+                dist[i * k + j] = (*result)[j].distance;
             }
-            for (unsigned int j = resset[i].size(); j < k; ++j) {
+            for (size_t j = count; j < k; ++j) {
                 ids[i * k + j] = -1;
                 dist[i * k + j] = -1;
             }
         }
     }
-    rc.RecordSection("merge");
+    rc.RecordSection("search");
 
     // ProfilerStart("xx.prof");
     // std::vector<Neighbor> resset;
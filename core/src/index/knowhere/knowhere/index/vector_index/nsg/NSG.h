@@ -34,10 +34,19 @@ struct BuildParams {
 
 struct SearchParams {
     size_t search_length;
+    const IDFilter* filter = nullptr;
 };
 
 using Graph = std::vector<std::vector<node_t>>;
 
+// buffers of one search thread, reused by all the queries it runs
+struct SearchContext {
+    std::vector<node_t> init_ids;
+    std::vector<Neighbor> resset;
+    std::vector<Neighbor> filtered_set;
+    VisitedTable visited;
+};
+
 class NsgIndex {
  public:
     size_t dimension;
@@ -52,6 +61,15 @@ class NsgIndex {
 
     node_t navigation_point;  // offset of node in origin data
 
+    /*
+     * search layout, built once the graph is final, then nsg and ori_data_ are released:
+     * each node takes a block of flat_stride_ bytes aligned to cache line, holding neighbor count,
+     * neighbors padded to flat_degree_ and the vector, so a hop reads one place in memory
+     */
+    char* flat_graph_ = nullptr;
+    size_t flat_degree_ = 0;
+    size_t flat_stride_ = 0;
+
     bool is_trained = false;
 
     /*
@@ -78,6 +96,30 @@ class NsgIndex {
     Search(const float* query, const unsigned& nq, const unsigned& dim, const unsigned& k, float* dist, int64_t* ids,
            SearchParams& params);
 
+    void
+    BuildFlatGraph();
+
+    // vector of node, from flat graph if built
+    const float*
+    NodeData(node_t id) const {
+        if (flat_graph_ == nullptr) {
+            return ori_data_ + id * dimension;
+        }
+        return reinterpret_cast<const float*>(flat_graph_ + id * flat_stride_ + sizeof(node_t) * (1 + flat_degree_));
+    }
+
+    // neighbors of node, from flat graph if built
+    const node_t*
+    NodeNeighbors(node_t id, size_t& count) const {
+        if (flat_graph_ == nullptr) {
+            count = nsg[id].size();
+            return nsg[id].data();
+        }
+        auto block = reinterpret_cast<const node_t*>(flat_graph_ + id * flat_stride_);
+        count = static_cast<size_t>(block[0]);
+        return block + 1;
+    }
+
     // Not support yet.
     // virtual void Add() = 0;
     // virtual void Add_with_ids() = 0;
@@ -104,9 +146,15 @@ class NsgIndex {
     void
     GetNeighbors(const float* query, std::vector<Neighbor>& resset, std::vector<Neighbor>& fullset);
 
-    // search and navigation-point
+    // search and navigation-point, visited nodes accepted by the filter of param are collected into filtered_set
+    void
+    GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph& graph, SearchParams* param = nullptr,
+                 std::vector<Neighbor>* filtered_set = nullptr);
+
+    // search on flat graph, data of the next neighbors is prefetched while distance of one is computed,
+    // result is left in resset of context, with filter of param visited nodes accepted are in filtered_set
     void
-    GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph& graph, SearchParams* param = nullptr);
+    GetNeighborsFlat(const float* query, SearchContext& context, SearchParams* param);
 
     void
     Link();
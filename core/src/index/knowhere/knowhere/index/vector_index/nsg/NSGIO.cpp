@@ -21,13 +21,18 @@ write_index(NsgIndex* index, MemoryIOWriter& writer) {
     writer(&index->ntotal, sizeof(index->ntotal), 1);
     writer(&index->dimension, sizeof(index->dimension), 1);
     writer(&index->navigation_point, sizeof(index->navigation_point), 1);
-    writer(index->ori_data_, sizeof(float) * index->ntotal * index->dimension, 1);
+    // same format whether the graph is flattened or not
+    for (unsigned i = 0; i < index->ntotal; ++i) {
+        writer(index->NodeData(i), sizeof(float) * index->dimension, 1);
+    }
     writer(index->ids_, sizeof(int64_t) * index->ntotal, 1);
 
     for (unsigned i = 0; i < index->ntotal; ++i) {
-        auto neighbor_num = (node_t)index->nsg[i].size();
+        size_t count = 0;
+        const node_t* neighbors = index->NodeNeighbors(i, count);
+        auto neighbor_num = (node_t)count;
         writer(&neighbor_num, sizeof(node_t), 1);
-        writer(index->nsg[i].data(), neighbor_num * sizeof(node_t), 1);
+        writer(neighbors, neighbor_num * sizeof(node_t), 1);
     }
 }
 
@@ -54,6 +59,7 @@ read_index(MemoryIOReader& reader) {
         index->nsg[i].resize(neighbor_num);
         reader(index->nsg[i].data(), neighbor_num * sizeof(node_t), 1);
     }
+    index->BuildFlatGraph();
 
     index->is_trained = true;
     return index;
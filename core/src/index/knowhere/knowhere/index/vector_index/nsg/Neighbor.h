@@ -11,7 +11,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <mutex>
+#include <vector>
 
 namespace knowhere {
 namespace algo {
@@ -52,5 +55,35 @@ struct Neighbor {
 
 typedef std::lock_guard<std::mutex> LockGuard;
 
+// visited marks of nodes, reset by bumping the epoch instead of clearing, so one table serves many searches
+class VisitedTable {
+ public:
+    void
+    Reset(size_t size) {
+        if (marks_.size() != size) {
+            marks_.assign(size, 0);
+            epoch_ = 0;
+        }
+        if (++epoch_ == 0) {
+            std::fill(marks_.begin(), marks_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    bool
+    Get(size_t id) const {
+        return marks_[id] == epoch_;
+    }
+
+    void
+    Set(size_t id) {
+        marks_[id] = epoch_;
+    }
+
+ private:
+    std::vector<uint8_t> marks_;
+    uint8_t epoch_ = 0;
+};
+
 }  // namespace algo
 }  // namespace knowhere
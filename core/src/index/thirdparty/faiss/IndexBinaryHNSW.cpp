@@ -310,6 +310,8 @@ DistanceComputer *IndexBinaryHNSW::get_distance_computer() const {
       return new FlatHammingDis<HammingComputer32>(*flat_storage);
     case 64:
       return new FlatHammingDis<HammingComputer64>(*flat_storage);
+    case 128:
+      return new FlatHammingDis<HammingComputer128>(*flat_storage);
     default:
       if (code_size % 8 == 0) {
         return new FlatHammingDis<HammingComputerM8>(*flat_storage);
@@ -455,6 +455,7 @@ BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
       HANDLE_CS(20);
       HANDLE_CS(32);
       HANDLE_CS(64);
+      HANDLE_CS(128);
 #undef HANDLE_CS
     default:
         if (code_size % 8 == 0) {
@@ -482,8 +483,13 @@ BinaryInvertedListScanner *select_IVFBinaryScannerJaccard (size_t code_size) {
      HANDLE_CS(128)
 #undef HANDLE_CS
     default:
-        return new IVFBinaryScannerJaccard<JaccardComputerDefault,
-            store_pairs>(code_size);
+        if (code_size % 8 == 0) {
+            return new IVFBinaryScannerJaccard<JaccardComputerM8,
+                store_pairs>(code_size);
+        } else {
+            return new IVFBinaryScannerJaccard<JaccardComputerDefault,
+                store_pairs>(code_size);
+        }
     }
 }
 
@@ -777,6 +783,7 @@ void search_knn_hamming_count_1 (
       HANDLE_CS(20);
       HANDLE_CS(32);
       HANDLE_CS(64);
+      HANDLE_CS(128);
 #undef HANDLE_CS
     default:
         if (ivf.code_size % 8 == 0) {
@@ -327,6 +327,10 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
 {
     long nprobe = params ? params->nprobe : this->nprobe;
     long max_codes = params ? params->max_codes : this->max_codes;
+    const IDSelector *sel = params ? params->sel : nullptr;
+    const float *residuals = params ? params->residuals : nullptr;
+    int parallel_mode = params && params->parallel_mode >= 0 ?
+        params->parallel_mode : this->parallel_mode;
 
     size_t nlistv = 0, ndis = 0, nheap = 0;
 
@@ -345,6 +349,7 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
     {
         InvertedListScanner *scanner = get_InvertedListScanner(store_pairs);
         ScopeDeleter1<InvertedListScanner> del(scanner);
+        scanner->sel = sel;
 
         /*****************************************************
          * Depending on parallel_mode, there are two possible ways
@@ -373,6 +378,7 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
         // single list scan using the current scanner (with query
         // set porperly) and storing results in simi and idxi
         auto scan_one_list = [&] (idx_t key, float coarse_dis_i,
+                                  const float *residual_i,
                                   float *simi, idx_t *idxi) {
 
             if (key < 0) {
@@ -390,7 +396,11 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                 return (size_t)0;
             }
 
-            scanner->set_list (key, coarse_dis_i);
+            if (residual_i) {
+                scanner->set_list_residual (key, coarse_dis_i, residual_i);
+            } else {
+                scanner->set_list (key, coarse_dis_i);
+            }
 
             nlistv++;
 
@@ -399,7 +409,8 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
             std::unique_ptr<InvertedLists::ScopedIds> sids;
             const Index::idx_t * ids = nullptr;
 
-            if (!store_pairs)  {
+            // the selector needs the ids even if pairs are stored
+            if (!store_pairs || sel)  {
                 sids.reset (new InvertedLists::ScopedIds (invlists, key));
                 ids = sids->get();
             }
@@ -438,6 +449,8 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                     nscan += scan_one_list (
                          keys [i * nprobe + ik],
                          coarse_dis[i * nprobe + ik],
+                         residuals ? residuals + (i * nprobe + ik) * d
+                                   : nullptr,
                          simi, idxi
                     );
 
@@ -467,6 +480,8 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                     ndis += scan_one_list
                         (keys [i * nprobe + ik],
                          coarse_dis[i * nprobe + ik],
+                         residuals ? residuals + (i * nprobe + ik) * d
+                                   : nullptr,
                          local_dis.data(), local_idx.data());
 
                     // can't do the test on max_codes
@@ -65,9 +65,17 @@ struct Level1Quantizer {
 
 
 
+struct IDSelector;
+
 struct IVFSearchParameters {
     size_t nprobe;            ///< number of probes at query time
     size_t max_codes;         ///< max nb of codes to visit to do a query
+    const IDSelector *sel = nullptr; ///< if set, only ids it accepts are returned
+    /// if set, n * nprobe residuals of the queries to the preassigned
+    /// centroids, in the order of the keys (search_preassigned only)
+    const float *residuals = nullptr;
+    /// parallel_mode of the index is used if negative
+    int parallel_mode = -1;
     virtual ~IVFSearchParameters () {}
 };
 
@@ -300,12 +308,22 @@ struct InvertedListScanner {
 
     using idx_t = Index::idx_t;
 
+    /// if set, codes whose id is not accepted are skipped during the scan
+    const IDSelector *sel = nullptr;
+
     /// from now on we handle this query.
     virtual void set_query (const float *query_vector) = 0;
 
     /// following codes come from this inverted list
     virtual void set_list (idx_t list_no, float coarse_dis) = 0;
 
+    /// same as set_list, residual is the current query minus the
+    /// centroid of the list, computed beforehand
+    virtual void set_list_residual (idx_t list_no, float coarse_dis,
+                                    const float * /*residual*/) {
+        set_list (list_no, coarse_dis);
+    }
+
     /// compute a single query-to-code distance
     virtual float distance_to_code (const uint8_t *code) const = 0;
 
@@ -123,9 +123,12 @@ template<MetricType metric, class C>
 struct IVFFlatScanner: InvertedListScanner {
     size_t d;
     bool store_pairs;
+    fvec_distance_t distance;  // unrolled for d if it is a common one
 
     IVFFlatScanner(size_t d, bool store_pairs):
-        d(d), store_pairs(store_pairs) {}
+        d(d), store_pairs(store_pairs),
+        distance(metric == METRIC_INNER_PRODUCT ?
+                 fvec_inner_product_kernel (d) : fvec_L2sqr_kernel (d)) {}
 
     const float *xi;
     void set_query (const float *query) override {
@@ -139,8 +142,7 @@ struct IVFFlatScanner: InvertedListScanner {
 
     float distance_to_code (const uint8_t *code) const override {
         const float *yj = (float*)code;
-        float dis = metric == METRIC_INNER_PRODUCT ?
-            fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
+        float dis = distance (xi, yj, d);
         return dis;
     }
 
@@ -153,9 +155,11 @@ struct IVFFlatScanner: InvertedListScanner {
         const float *list_vecs = (const float*)codes;
         size_t nup = 0;
         for (size_t j = 0; j < list_size; j++) {
+            if (sel && !sel->is_member (ids[j])) {
+                continue;
+            }
             const float * yj = list_vecs + d * j;
-            float dis = metric == METRIC_INNER_PRODUCT ?
-                fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
+            float dis = distance (xi, yj, d);
             if (C::cmp (simi[0], dis)) {
                 heap_pop<C> (k, simi, idxi);
                 int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
@@ -175,8 +179,7 @@ struct IVFFlatScanner: InvertedListScanner {
         const float *list_vecs = (const float*)codes;
         for (size_t j = 0; j < list_size; j++) {
             const float * yj = list_vecs + d * j;
-            float dis = metric == METRIC_INNER_PRODUCT ?
-                fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
+            float dis = distance (xi, yj, d);
             if (C::cmp (radius, dis)) {
                 int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
                 res.add (dis, id);
@@ -799,8 +799,15 @@ struct KnnSearchResults {
 
     size_t nup;
 
+    // ids are only checked for the codes that would enter the heap
+    const IDSelector *sel;
+    const idx_t *list_ids;
+
     inline void add (idx_t j, float dis) {
         if (C::cmp (heap_sim[0], dis)) {
+            if (sel && !sel->is_member (list_ids[j])) {
+                return;
+            }
             heap_pop<C> (k, heap_sim, heap_ids);
             idx_t id = ids ? ids[j] : (key << 32 | j);
             heap_push<C> (k, heap_sim, heap_ids, dis, id);
@@ -1068,7 +1075,9 @@ struct IVFPQScanner:
             /* k */        k,
             /* heap_sim */ heap_sim,
             /* heap_ids */ heap_ids,
-            /* nup */      0
+            /* nup */      0,
+            /* sel */      this->sel,
+            /* list_ids */ ids
         };
 
         if (this->polysemous_ht > 0) {
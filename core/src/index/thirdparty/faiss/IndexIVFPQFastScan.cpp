@@ -0,0 +1,378 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#include <faiss/IndexIVFPQFastScan.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/impl/FaissAssert.h>
+#include <faiss/utils/Heap.h>
+#include <faiss/utils/utils.h>
+
+
+namespace faiss {
+
+
+
+IndexIVFPQFastScan::IndexIVFPQFastScan (Index * quantizer, size_t d,
+                                        size_t nlist, size_t M):
+    IndexIVFPQ (quantizer, d, nlist, M, 4)
+{
+    FAISS_THROW_IF_NOT_MSG (M % 2 == 0, "fast scan needs an even M");
+    // the estimates of the 8-bit tables are summed on 16 bits
+    FAISS_THROW_IF_NOT_MSG (M <= 256,
+                            "fast scan supports at most 256 sub-quantizers");
+}
+
+IndexIVFPQFastScan::IndexIVFPQFastScan ()
+{
+}
+
+void IndexIVFPQFastScan::add_with_ids (idx_t n, const float* x,
+                                       const idx_t* xids)
+{
+    IndexIVFPQ::add_with_ids (n, x, xids);
+    pack_lists ();
+}
+
+void IndexIVFPQFastScan::reset ()
+{
+    IndexIVFPQ::reset ();
+    packed_codes.clear ();
+    packed_sizes.clear ();
+}
+
+size_t IndexIVFPQFastScan::remove_ids (const IDSelector& sel)
+{
+    size_t nremove = IndexIVFPQ::remove_ids (sel);
+    // the remaining codes moved inside their lists
+    packed_sizes.assign (nlist, 0);
+    pack_lists ();
+    return nremove;
+}
+
+void IndexIVFPQFastScan::merge_from (IndexIVF &other, idx_t add_id)
+{
+    IndexIVFPQ::merge_from (other, add_id);
+    pack_lists ();
+}
+
+void IndexIVFPQFastScan::pack_lists ()
+{
+    packed_codes.resize (nlist);
+    packed_sizes.resize (nlist, 0);
+
+#pragma omp parallel for schedule(dynamic)
+    for (size_t list_no = 0; list_no < nlist; list_no++) {
+        size_t list_size = invlists->list_size (list_no);
+        if (list_size == packed_sizes[list_no]) {
+            continue;
+        }
+
+        InvertedLists::ScopedCodes codes (invlists, list_no);
+        size_t nblock = (list_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        std::vector<uint8_t> & packed = packed_codes[list_no];
+        packed.assign (nblock * BLOCK_SIZE * code_size, 0);
+
+        for (size_t i = 0; i < list_size; i++) {
+            uint8_t *block = packed.data () +
+                (i / BLOCK_SIZE) * BLOCK_SIZE * code_size + i % BLOCK_SIZE;
+            const uint8_t *code = codes.get () + i * code_size;
+            for (size_t g = 0; g < code_size; g++) {
+                block[g * BLOCK_SIZE] = code[g];
+            }
+        }
+        packed_sizes[list_no] = list_size;
+    }
+}
+
+
+namespace {
+
+typedef Index::idx_t idx_t;
+
+/* The scanner works on costs, smaller is closer: the L2 distance, or
+ * minus the inner product. cost = cost_bias + sum_m cost_table[m][code_m]
+ *
+ * The tables quantized to 8 bits verify
+ *     cost >= quant_base + (estimate - margin) / quant_scale
+ * so the exact cost of a code is only computed if its estimate is below
+ * the bound given by the worst cost in the heap. */
+template <MetricType METRIC_TYPE, class C>
+struct IVFPQFastScanScanner: InvertedListScanner {
+
+    static const size_t ksub = 16;
+
+    const IndexIVFPQFastScan & ivfpq;
+    const ProductQuantizer & pq;
+    bool store_pairs;
+
+    const float *query;
+    idx_t key;
+
+    // the L2 tables of a list are the precomputed ones minus the query
+    // inner products, as in IndexIVFPQ
+    bool precomputed;
+
+    std::vector<float> residual;
+    std::vector<float> ip_table;        // per query
+    std::vector<float> cost_table;      // M * ksub
+    std::vector<float> cost_mins;       // per sub-quantizer
+    float cost_bias;
+
+    // M * 2 * ksub, the table of each sub-quantizer repeated for both
+    // 128-bit lanes
+    std::vector<uint8_t> quant_table;
+    float quant_base;
+    float quant_scale;
+    float margin;                         // rounding error of the estimate
+
+    IVFPQFastScanScanner (const IndexIVFPQFastScan & ivfpq, bool store_pairs):
+        ivfpq (ivfpq), pq (ivfpq.pq), store_pairs (store_pairs),
+        query (nullptr), key (-1),
+        precomputed (METRIC_TYPE == METRIC_L2 && ivfpq.by_residual &&
+                     ivfpq.use_precomputed_table == 1),
+        residual (ivfpq.d), ip_table (pq.M * ksub),
+        cost_table (pq.M * ksub), cost_mins (pq.M), cost_bias (0),
+        quant_table (pq.M * 2 * ksub), quant_base (0), quant_scale (1),
+        margin (pq.M * 0.5f + 1)
+    {
+        FAISS_THROW_IF_NOT (pq.ksub == ksub);
+    }
+
+    void set_query (const float *query_vector) override {
+        query = query_vector;
+        if (METRIC_TYPE == METRIC_INNER_PRODUCT || precomputed) {
+            pq.compute_inner_prod_table (query, ip_table.data ());
+        }
+    }
+
+    void set_list (idx_t list_no, float coarse_dis) override {
+        key = list_no;
+
+        if (METRIC_TYPE == METRIC_INNER_PRODUCT) {
+            for (size_t i = 0; i < cost_table.size (); i++) {
+                cost_table[i] = -ip_table[i];
+            }
+            cost_bias = ivfpq.by_residual ? -coarse_dis : 0;
+        } else if (precomputed) {
+            // ||x - y_C - y_R||^2 = coarse_dis + (||y_R||^2 + 2 <y_C, y_R>)
+            //                       - 2 <x, y_R>
+            fvec_madd (cost_table.size (),
+                       ivfpq.precomputed_table.data () +
+                       list_no * cost_table.size (),
+                       -2.0, ip_table.data (), cost_table.data ());
+            cost_bias = coarse_dis;
+        } else {
+            const float *x = query;
+            if (ivfpq.by_residual) {
+                ivfpq.quantizer->compute_residual (query, residual.data (),
+                                                   list_no);
+                x = residual.data ();
+            }
+            pq.compute_distance_table (x, cost_table.data ());
+            cost_bias = 0;
+        }
+
+        // one scale for all sub-quantizers, each one has its own offset
+        float span = 0;
+        quant_base = cost_bias;
+        for (size_t m = 0; m < pq.M; m++) {
+            const float *tab = cost_table.data () + m * ksub;
+            float mn = tab[0], mx = tab[0];
+            for (size_t c = 1; c < ksub; c++) {
+                mn = std::min (mn, tab[c]);
+                mx = std::max (mx, tab[c]);
+            }
+            cost_mins[m] = mn;
+            quant_base += mn;
+            span = std::max (span, mx - mn);
+        }
+        quant_scale = span > 0 ? 255 / span : 1;
+
+        for (size_t m = 0; m < pq.M; m++) {
+            const float *tab = cost_table.data () + m * ksub;
+            uint8_t *qtab = quant_table.data () + m * 2 * ksub;
+            for (size_t c = 0; c < ksub; c++) {
+                // rounded, the values are in [0, 255.5)
+                int q = (int)((tab[c] - cost_mins[m]) * quant_scale + 0.5f);
+                qtab[c] = qtab[c + ksub] = (uint8_t)std::min (q, 255);
+            }
+        }
+    }
+
+    inline float exact_cost (const uint8_t *code) const {
+        float cost = cost_bias;
+        const float *tab = cost_table.data ();
+        for (size_t g = 0; g < ivfpq.code_size; g++) {
+            cost += tab[code[g] & 15] + tab[ksub + (code[g] >> 4)];
+            tab += 2 * ksub;
+        }
+        return cost;
+    }
+
+    inline float to_dis (float cost) const {
+        return METRIC_TYPE == METRIC_INNER_PRODUCT ? -cost : cost;
+    }
+
+    // estimates above the bound can't beat the heap top
+    inline float estimate_bound (float heap_top) const {
+        return (to_dis (heap_top) - quant_base) * quant_scale + margin;
+    }
+
+    float distance_to_code (const uint8_t *code) const override {
+        return to_dis (exact_cost (code));
+    }
+
+    /// estimates of the BLOCK_SIZE codes of a block, returns the smallest
+    uint16_t estimate_block (const uint8_t *block, uint16_t *est) const {
+        const size_t bs = IndexIVFPQFastScan::BLOCK_SIZE;
+        const uint8_t *qtab = quant_table.data ();
+#ifdef __AVX2__
+        const __m256i mask4 = _mm256_set1_epi8 (0x0f);
+        const __m256i mask8 = _mm256_set1_epi16 (0x00ff);
+        __m256i acc_even = _mm256_setzero_si256 ();
+        __m256i acc_odd = _mm256_setzero_si256 ();
+        for (size_t g = 0; g < ivfpq.code_size; g++) {
+            __m256i c = _mm256_loadu_si256 ((const __m256i*)(block + g * bs));
+            __m256i clo = _mm256_and_si256 (c, mask4);
+            __m256i chi = _mm256_and_si256 (_mm256_srli_epi16 (c, 4), mask4);
+            __m256i t0 = _mm256_loadu_si256 (
+                    (const __m256i*)(qtab + 2 * g * 2 * ksub));
+            __m256i t1 = _mm256_loadu_si256 (
+                    (const __m256i*)(qtab + (2 * g + 1) * 2 * ksub));
+            __m256i r0 = _mm256_shuffle_epi8 (t0, clo);
+            __m256i r1 = _mm256_shuffle_epi8 (t1, chi);
+            // 16-bit lanes: low bytes are the even codes, high bytes the odd
+            acc_even = _mm256_add_epi16 (acc_even, _mm256_and_si256 (r0, mask8));
+            acc_even = _mm256_add_epi16 (acc_even, _mm256_and_si256 (r1, mask8));
+            acc_odd = _mm256_add_epi16 (acc_odd, _mm256_srli_epi16 (r0, 8));
+            acc_odd = _mm256_add_epi16 (acc_odd, _mm256_srli_epi16 (r1, 8));
+        }
+        alignas(32) uint16_t even[bs / 2], odd[bs / 2];
+        _mm256_store_si256 ((__m256i*)even, acc_even);
+        _mm256_store_si256 ((__m256i*)odd, acc_odd);
+        __m256i accmin = _mm256_min_epu16 (acc_even, acc_odd);
+        __m128i m128 = _mm_min_epu16 (_mm256_castsi256_si128 (accmin),
+                                      _mm256_extracti128_si256 (accmin, 1));
+        uint16_t mn = (uint16_t)_mm_cvtsi128_si32 (_mm_minpos_epu16 (m128));
+        for (size_t i = 0; i < bs / 2; i++) {
+            est[2 * i] = even[i];
+            est[2 * i + 1] = odd[i];
+        }
+        return mn;
+#else
+        uint16_t mn = 0xffff;
+        for (size_t j = 0; j < bs; j++) {
+            uint16_t e = 0;
+            for (size_t g = 0; g < ivfpq.code_size; g++) {
+                uint8_t c = block[g * bs + j];
+                e += qtab[2 * g * 2 * ksub + (c & 15)] +
+                     qtab[(2 * g + 1) * 2 * ksub + (c >> 4)];
+            }
+            est[j] = e;
+            mn = std::min (mn, e);
+        }
+        return mn;
+#endif
+    }
+
+    size_t scan_codes (size_t ncode,
+                       const uint8_t *codes,
+                       const idx_t *ids,
+                       float *heap_sim, idx_t *heap_ids,
+                       size_t k) const override
+    {
+        const size_t bs = IndexIVFPQFastScan::BLOCK_SIZE;
+        size_t nup = 0;
+
+        auto add = [&] (size_t i) {
+            float dis = to_dis (exact_cost (codes + i * ivfpq.code_size));
+            if (!C::cmp (heap_sim[0], dis)) {
+                return;
+            }
+            if (sel && !sel->is_member (ids[i])) {
+                return;
+            }
+            heap_pop<C> (k, heap_sim, heap_ids);
+            idx_t id = store_pairs ? (key << 32 | i) : ids[i];
+            heap_push<C> (k, heap_sim, heap_ids, dis, id);
+            nup++;
+        };
+
+        // lists modified without being packed are scanned with float tables
+        if (key >= (idx_t)ivfpq.packed_sizes.size () ||
+            ivfpq.packed_sizes[key] != ncode) {
+            for (size_t i = 0; i < ncode; i++) {
+                add (i);
+            }
+            return nup;
+        }
+
+        const uint8_t *packed = ivfpq.packed_codes[key].data ();
+        alignas(32) uint16_t est[bs];
+        for (size_t i0 = 0; i0 < ncode; i0 += bs) {
+            uint16_t mn = estimate_block (packed + i0 * ivfpq.code_size, est);
+            float bound = estimate_bound (heap_sim[0]);
+            if (mn >= bound) {
+                continue;
+            }
+            size_t i1 = std::min (ncode, i0 + bs);
+            for (size_t i = i0; i < i1; i++) {
+                if (est[i - i0] < bound) {
+                    add (i);
+                    bound = estimate_bound (heap_sim[0]);
+                }
+            }
+        }
+        return nup;
+    }
+
+    void scan_codes_range (size_t ncode,
+                           const uint8_t *codes,
+                           const idx_t *ids,
+                           float radius,
+                           RangeQueryResult & rres) const override
+    {
+        for (size_t i = 0; i < ncode; i++) {
+            float dis = to_dis (exact_cost (codes + i * ivfpq.code_size));
+            if (C::cmp (radius, dis)) {
+                idx_t id = store_pairs ? (key << 32 | i) : ids[i];
+                rres.add (dis, id);
+            }
+        }
+    }
+
+};
+
+} // anonymous namespace
+
+
+InvertedListScanner *
+IndexIVFPQFastScan::get_InvertedListScanner (bool store_pairs) const
+{
+    if (metric_type == METRIC_INNER_PRODUCT) {
+        return new IVFPQFastScanScanner<METRIC_INNER_PRODUCT,
+                                        CMin<float, idx_t> >
+            (*this, store_pairs);
+    } else if (metric_type == METRIC_L2) {
+        return new IVFPQFastScanScanner<METRIC_L2, CMax<float, idx_t> >
+            (*this, store_pairs);
+    }
+    return nullptr;
+}
+
+
+} // namespace faiss
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#pragma once
+
+#include <vector>
+
+#include <faiss/IndexIVFPQ.h>
+
+
+namespace faiss {
+
+
+
+/** IVFPQ with 4-bit codes scanned with lookup tables held in SIMD
+ * registers.
+ *
+ * Besides the inverted lists, the codes of each list are kept
+ * transposed in blocks of BLOCK_SIZE vectors: byte g of the codes
+ * (sub-quantizers 2g and 2g+1) of the vectors of a block is
+ * contiguous. A scan quantizes the distance tables of the query to 8
+ * bits and looks them up for a whole block at a time with PSHUFB; only
+ * the codes whose estimated distance may enter the result heap get
+ * their exact distance from the float tables, so the results are the
+ * ones of a scan with float tables.
+ */
+struct IndexIVFPQFastScan: IndexIVFPQ {
+    static const size_t BLOCK_SIZE = 32;
+
+    /// per list, the codes transposed by blocks, the last block is
+    /// padded with zeros
+    std::vector<std::vector<uint8_t> > packed_codes;
+
+    /// list sizes when the lists were packed
+    std::vector<size_t> packed_sizes;
+
+    /// M must be even, 2 sub-quantizer codes make a byte, and at most 256
+    IndexIVFPQFastScan (Index * quantizer, size_t d, size_t nlist,
+                        size_t M);
+
+    IndexIVFPQFastScan ();
+
+    void add_with_ids (idx_t n, const float* x, const idx_t* xids = nullptr)
+        override;
+
+    void reset () override;
+
+    size_t remove_ids (const IDSelector& sel) override;
+
+    void merge_from (IndexIVF &other, idx_t add_id) override;
+
+    /// transpose the codes of the lists whose size changed since they
+    /// were packed, called after the lists are modified or read
+    void pack_lists ();
+
+    InvertedListScanner *get_InvertedListScanner (bool store_pairs)
+        const override;
+};
+
+
+} // namespace faiss
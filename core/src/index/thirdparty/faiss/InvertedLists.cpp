@@ -12,6 +12,14 @@
 #include <cstdio>
 #include <numeric>
 
+#ifdef USE_CPU
+#include <sys/mman.h>
+#include <unistd.h>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#endif
+
 #include <faiss/utils/utils.h>
 #include <faiss/impl/FaissAssert.h>
 
@@ -244,6 +252,147 @@ InvertedLists* ArrayInvertedLists::to_readonly() {
 ArrayInvertedLists::~ArrayInvertedLists ()
 {}
 
+/*****************************************************************
+ * Lazy list cache
+ *****************************************************************/
+
+#ifdef USE_CPU
+namespace {
+
+/* LRU over the probed lists of lazy read only lists; a list is read
+ * ahead in one go when it enters, the pages of the coldest ones are
+ * dropped beyond capacity and faulted in again from the file on the next
+ * probe, the mapping is private and never written */
+struct LazyListCache {
+    typedef std::pair<const ReadOnlyArrayInvertedLists*, size_t> Key;
+    typedef std::list<Key>::iterator Entry;
+
+    std::mutex mutex;
+    size_t capacity = 0;
+    size_t usage = 0;
+    std::list<Key> lru;
+    std::unordered_map<const ReadOnlyArrayInvertedLists*,
+                       std::unordered_map<size_t, Entry>> entries;
+
+    static LazyListCache& instance () {
+        static LazyListCache cache;
+        return cache;
+    }
+
+    static size_t bytes (const Key& key) {
+        return key.first->readonly_length[key.second] * key.first->code_size;
+    }
+
+    // advise the pages of a list, only the whole pages with advice to
+    // drop them, its ends may share pages with the neighbours
+    static void advise (const Key& key, int advice) {
+        static const uintptr_t page = sysconf (_SC_PAGESIZE);
+        uintptr_t begin = (uintptr_t)key.first->borrowed_codes[key.second];
+        uintptr_t end = begin + bytes (key);
+        if (advice == MADV_DONTNEED) {
+            begin = (begin + page - 1) / page * page;
+        } else {
+            begin = begin / page * page;
+        }
+        end = end / page * page;
+        if (begin < end) {
+            madvise ((void*)begin, end - begin, advice);
+        }
+    }
+
+    void evict () {
+        while (usage > capacity && !lru.empty()) {
+            Key key = lru.back();
+            lru.pop_back();
+            entries[key.first].erase (key.second);
+            usage -= bytes (key);
+            advise (key, MADV_DONTNEED);
+        }
+    }
+
+    void touch (const ReadOnlyArrayInvertedLists *il, size_t list_no) {
+        Key key (il, list_no);
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            if (capacity == 0) {
+                return;
+            }
+            auto& lists = entries[il];
+            auto iter = lists.find (list_no);
+            if (iter != lists.end()) {
+                lru.splice (lru.begin(), lru, iter->second);
+                return;
+            }
+            lru.push_front (key);
+            lists[list_no] = lru.begin();
+            usage += bytes (key);
+            evict ();
+        }
+        advise (key, MADV_WILLNEED);
+    }
+
+    // the pages go away with the mapping
+    void forget (const ReadOnlyArrayInvertedLists *il) {
+        std::lock_guard<std::mutex> lock (mutex);
+        auto iter = entries.find (il);
+        if (iter == entries.end()) {
+            return;
+        }
+        for (auto& entry : iter->second) {
+            usage -= bytes (*entry.second);
+            lru.erase (entry.second);
+        }
+        entries.erase (iter);
+    }
+
+    void resize (size_t new_capacity) {
+        std::lock_guard<std::mutex> lock (mutex);
+        capacity = new_capacity;
+        evict ();
+        if (capacity == 0) {
+            entries.clear ();
+        }
+    }
+};
+
+} // namespace
+#endif
+
+bool make_lists_lazy (InvertedLists *invlists) {
+#ifdef USE_CPU
+    auto ails = dynamic_cast<ReadOnlyArrayInvertedLists*> (invlists);
+    if (ails == nullptr || ails->borrowed_codes.empty()) {
+        return false;
+    }
+    // no read ahead beyond the lists probed
+    for (size_t i = 0; i < ails->nlist; i++) {
+        if (ails->readonly_length[i] > 0) {
+            LazyListCache::advise (LazyListCache::Key (ails, i), MADV_RANDOM);
+        }
+    }
+    ails->lazy = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void set_lazy_list_capacity (size_t capacity) {
+#ifdef USE_CPU
+    LazyListCache::instance().resize (capacity);
+#endif
+}
+
+size_t get_lazy_list_usage () {
+#ifdef USE_CPU
+    auto& cache = LazyListCache::instance();
+    std::lock_guard<std::mutex> lock (cache.mutex);
+    return cache.usage;
+#else
+    return 0;
+#endif
+}
+
 /*****************************************************************
  * ReadOnlyArrayInvertedLists implementations
  *****************************************************************/
@@ -257,14 +406,9 @@ ReadOnlyArrayInvertedLists::ReadOnlyArrayInvertedLists(size_t nlist,
         FAISS_THROW_MSG ("Invalid list_length");
         return;
     }
-    auto total_size = std::accumulate(readonly_length.begin(), readonly_length.end(), 0);
+    // the readers size the codes and ids, which may not be copied at all
     readonly_offset.reserve(nlist);
 
-#ifdef USE_CPU
-    readonly_codes.reserve(total_size * code_size);
-    readonly_ids.reserve(total_size);
-#endif
-
     size_t offset = 0;
     for (auto i=0; i<readonly_length.size(); ++i) {
         readonly_offset.emplace_back(offset);
@@ -330,6 +474,11 @@ ReadOnlyArrayInvertedLists::ReadOnlyArrayInvertedLists(const ArrayInvertedLists&
 //}
 
 ReadOnlyArrayInvertedLists::~ReadOnlyArrayInvertedLists() {
+#ifdef USE_CPU
+    if (lazy) {
+        LazyListCache::instance().forget (this);
+    }
+#endif
 }
 
 bool
@@ -365,6 +514,12 @@ const uint8_t * ReadOnlyArrayInvertedLists::get_codes (size_t list_no) const
 {
     FAISS_ASSERT(list_no < nlist && valid);
 #ifdef USE_CPU
+    if (!borrowed_codes.empty()) {
+        if (lazy) {
+            LazyListCache::instance().touch (this, list_no);
+        }
+        return borrowed_codes[list_no];
+    }
     return readonly_codes.data() + readonly_offset[list_no] * code_size;
 #else
     uint8_t *pcodes = (uint8_t *)(pin_readonly_codes->data);
@@ -395,7 +550,7 @@ const InvertedLists::idx_t* ReadOnlyArrayInvertedLists::get_all_ids() const {
 const uint8_t* ReadOnlyArrayInvertedLists::get_all_codes() const {
     FAISS_ASSERT(valid);
 #ifdef USE_CPU
-    return readonly_codes.data();
+    return borrowed_codes.empty() ? readonly_codes.data() : nullptr;
 #else
     return (uint8_t *)(pin_readonly_codes->data);
 #endif
@@ -238,6 +238,15 @@ struct ReadOnlyArrayInvertedLists: InvertedLists {
 #ifdef USE_CPU
     std::vector <uint8_t> readonly_codes;
     std::vector <idx_t> readonly_ids;
+
+    // codes of every list lent by the reader of the index, used instead
+    // of readonly_codes when not empty; borrowed_owner keeps them alive
+    std::vector <const uint8_t*> borrowed_codes;
+    std::shared_ptr<void> borrowed_owner;
+
+    // the borrowed codes are mapped from a file, the lists probed are
+    // tracked by the lazy list cache, see make_lists_lazy
+    bool lazy = false;
 #else
     PageLockMemoryPtr pin_readonly_codes;
     PageLockMemoryPtr pin_readonly_ids;
@@ -259,6 +268,7 @@ struct ReadOnlyArrayInvertedLists: InvertedLists {
     const uint8_t * get_codes (size_t list_no) const override;
     const idx_t * get_ids (size_t list_no) const override;
 
+    // nullptr if the codes are borrowed, they aren't contiguous then
     const uint8_t * get_all_codes() const;
     const idx_t * get_all_ids() const;
     const std::vector<size_t>& get_list_length() const;
@@ -403,6 +413,21 @@ struct MaskedInvertedLists: ReadOnlyInvertedLists {
 
 };
 
+
+/** The codes of read only lists borrowed from a file mapping may be left
+ * there: a list is faulted in from the file when it is probed, and the
+ * least recently probed lists are given back to the kernel once more than
+ * the capacity of the lazy list cache is resident, so an index much larger
+ * than the memory may be searched. Return false if the lists hold codes
+ * of their own, they aren't changed then. */
+bool make_lists_lazy (InvertedLists *invlists);
+
+/// bytes of lazy lists kept resident, 0 stops tracking and releases them
+void set_lazy_list_capacity (size_t capacity);
+
+/// bytes of lazy lists resident
+size_t get_lazy_list_usage ();
+
 } // namespace faiss
 
 
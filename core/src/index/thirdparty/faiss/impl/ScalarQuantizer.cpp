@@ -1388,6 +1388,11 @@ struct IVFSQScannerIP: InvertedListScanner {
 
         for (size_t j = 0; j < list_size; j++) {
 
+            if (sel && !sel->is_member (ids[j])) {
+                codes += code_size;
+                continue;
+            }
+
             float accu = accu0 + dc.query_to_code (codes);
 
             if (accu > simi [0]) {
@@ -1463,6 +1468,16 @@ struct IVFSQScannerL2: InvertedListScanner {
         }
     }
 
+    void set_list_residual (idx_t list_no, float coarse_dis,
+                            const float *residual) override {
+        if (by_residual) {
+            this->list_no = list_no;
+            dc.set_query (residual);
+        } else {
+            set_list (list_no, coarse_dis);
+        }
+    }
+
     float distance_to_code (const uint8_t *code) const final {
         return dc.query_to_code (code);
     }
@@ -1476,6 +1491,11 @@ struct IVFSQScannerL2: InvertedListScanner {
         size_t nup = 0;
         for (size_t j = 0; j < list_size; j++) {
 
+            if (sel && !sel->is_member (ids[j])) {
+                codes += code_size;
+                continue;
+            }
+
             float dis = dc.query_to_code (codes);
 
             if (dis < simi [0]) {
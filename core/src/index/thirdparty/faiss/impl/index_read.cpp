@@ -11,6 +11,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <numeric>
 
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -28,6 +29,7 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/IndexIVFPQR.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFSpectralHash.h>
@@ -213,14 +215,71 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
         READ1(n);
 #ifdef USE_CPU
         ails->readonly_ids.resize(n);
-        ails->readonly_codes.resize(n*code_size);
         READANDCHECK(ails->readonly_ids.data(), n);
-        READANDCHECK(ails->readonly_codes.data(), n * code_size);
+        const uint8_t *codes = f->borrow(n * code_size, ails->borrowed_owner);
+        if (codes) {
+            ails->borrowed_codes.resize(nlist);
+            for (size_t i = 0; i < nlist; i++) {
+                ails->borrowed_codes[i] = codes + ails->readonly_offset[i] * code_size;
+            }
+        } else {
+            ails->readonly_codes.resize(n*code_size);
+            READANDCHECK(ails->readonly_codes.data(), n * code_size);
+        }
 #else
         ails->pin_readonly_ids = std::make_shared<PageLockMemory>(n * sizeof(InvertedLists::idx_t));
         ails->pin_readonly_codes = std::make_shared<PageLockMemory>(n * code_size * sizeof(uint8_t));
         READANDCHECK((InvertedLists::idx_t *) ails->pin_readonly_ids->data, n);
         READANDCHECK((uint8_t *) ails->pin_readonly_codes->data, n * code_size);
+#endif
+        return ails;
+    } else if (h == fourcc ("ilar") && !(io_flags & IO_FLAG_MMAP) &&
+               (io_flags & IO_FLAG_READONLY_LISTS)) {
+        // the whole lists go to their final place, without the
+        // ArrayInvertedLists that would be copied again by to_readonly
+        size_t nlist;
+        size_t code_size;
+        READ1 (nlist);
+        READ1 (code_size);
+        std::vector<size_t> sizes (nlist);
+        read_ArrayInvertedLists_sizes (f, sizes);
+        auto ails = new ReadOnlyArrayInvertedLists (nlist, code_size, sizes);
+        size_t n = std::accumulate (sizes.begin(), sizes.end(), size_t(0));
+#ifdef USE_CPU
+        // ids are copied, they may sit unaligned in the buffer of the reader
+        ails->readonly_ids.resize (n);
+        for (size_t i = 0; i < nlist; i++) {
+            size_t len = sizes[i];
+            if (len == 0) {
+                continue;
+            }
+            const uint8_t *codes = ails->readonly_codes.empty() ?
+                f->borrow (len * code_size, ails->borrowed_owner) : nullptr;
+            if (codes) {
+                ails->borrowed_codes.resize (nlist, nullptr);
+                ails->borrowed_codes[i] = codes;
+            } else {
+                // a reader lends all the lists or none
+                FAISS_THROW_IF_NOT (ails->borrowed_codes.empty());
+                ails->readonly_codes.resize (n * code_size);
+                READANDCHECK (ails->readonly_codes.data() +
+                              ails->readonly_offset[i] * code_size,
+                              len * code_size);
+            }
+            READANDCHECK (ails->readonly_ids.data() + ails->readonly_offset[i], len);
+        }
+#else
+        ails->pin_readonly_ids = std::make_shared<PageLockMemory>(n * sizeof(InvertedLists::idx_t));
+        ails->pin_readonly_codes = std::make_shared<PageLockMemory>(n * code_size * sizeof(uint8_t));
+        auto pin_ids = (InvertedLists::idx_t *) ails->pin_readonly_ids->data;
+        auto pin_codes = (uint8_t *) ails->pin_readonly_codes->data;
+        for (size_t i = 0; i < nlist; i++) {
+            size_t len = sizes[i];
+            if (len > 0) {
+                READANDCHECK (pin_codes + ails->readonly_offset[i] * code_size, len * code_size);
+                READANDCHECK (pin_ids + ails->readonly_offset[i], len);
+            }
+        }
 #endif
         return ails;
     } else if (h == fourcc ("ilar") && !(io_flags & IO_FLAG_MMAP)) {
@@ -424,7 +483,10 @@ static IndexIVFPQ *read_ivfpq (IOReader *f, uint32_t h, int io_flags)
     IndexIVFPQR *ivfpqr =
         h == fourcc ("IvQR") || h == fourcc ("IwQR") ?
         new IndexIVFPQR () : nullptr;
-    IndexIVFPQ * ivpq = ivfpqr ? ivfpqr : new IndexIVFPQ ();
+    IndexIVFPQFastScan *ivpqfs =
+        h == fourcc ("IwP4") ? new IndexIVFPQFastScan () : nullptr;
+    IndexIVFPQ * ivpq = ivfpqr ? ivfpqr :
+        ivpqfs ? ivpqfs : new IndexIVFPQ ();
 
     std::vector<std::vector<Index::idx_t> > ids;
     read_ivf_header (ivpq, f, legacy ? &ids : nullptr);
@@ -451,6 +513,10 @@ static IndexIVFPQ *read_ivfpq (IOReader *f, uint32_t h, int io_flags)
             READ1 (ivfpqr->k_factor);
         }
     }
+    if (ivpqfs) {
+        // the packed codes aren't stored either
+        ivpqfs->pack_lists ();
+    }
     return ivpq;
 }
 
@@ -620,7 +686,8 @@ Index *read_index (IOReader *f, int io_flags) {
         read_InvertedLists (ivsp, f, io_flags);
         idx = ivsp;
     } else if(h == fourcc ("IvPQ") || h == fourcc ("IvQR") ||
-              h == fourcc ("IwPQ") || h == fourcc ("IwQR")) {
+              h == fourcc ("IwPQ") || h == fourcc ("IwQR") ||
+              h == fourcc ("IwP4")) {
 
         idx = read_ivfpq (f, h, io_flags);
 
@@ -28,6 +28,7 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/IndexIVFPQR.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFSpectralHash.h>
@@ -249,7 +250,13 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
         size_t n = oa->readonly_ids.size();
         WRITE1(n);
         WRITEANDCHECK(oa->readonly_ids.data(), n);
-        WRITEANDCHECK(oa->readonly_codes.data(), n * oa->code_size);
+        // borrowed codes aren't contiguous, they go list by list
+        for (size_t i = 0; i < oa->nlist; i++) {
+            size_t len = oa->readonly_length[i];
+            if (len > 0) {
+                WRITEANDCHECK(oa->get_codes(i), len * oa->code_size);
+            }
+        }
 #else
         size_t n = oa->pin_readonly_ids->size() / sizeof(InvertedLists::idx_t);
         WRITE1(n);
@@ -427,8 +434,11 @@ void write_index (const Index *idx, IOWriter *f) {
     } else if(const IndexIVFPQ * ivpq =
               dynamic_cast<const IndexIVFPQ *> (idx)) {
         const IndexIVFPQR * ivfpqr = dynamic_cast<const IndexIVFPQR *> (idx);
+        // the packed codes of the fast scan are rebuilt when read
+        bool fast_scan =
+            dynamic_cast<const IndexIVFPQFastScan *> (idx) != nullptr;
 
-        uint32_t h = fourcc (ivfpqr ? "IwQR" : "IwPQ");
+        uint32_t h = fourcc (ivfpqr ? "IwQR" : fast_scan ? "IwP4" : "IwPQ");
         WRITE1 (h);
         write_ivf_header (ivpq, f);
         WRITE1 (ivpq->by_residual);
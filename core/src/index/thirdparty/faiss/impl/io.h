@@ -15,6 +15,7 @@
 
 #include <string>
 #include <cstdio>
+#include <memory>
 #include <vector>
 
 #include <faiss/Index.h>
@@ -33,6 +34,11 @@ struct IOReader {
     // return a file number that can be memory-mapped
     virtual int fileno ();
 
+    // readers of data already in memory may lend the next size bytes
+    // instead of copying them out: they are skipped as if read, and
+    // owner keeps them alive. Returns nullptr if they must be read
+    virtual const uint8_t * borrow (size_t size, std::shared_ptr<void> & owner);
+
     virtual ~IOReader() {}
 };
 
@@ -47,6 +47,9 @@ const int IO_FLAG_READ_ONLY = 2;
 // strip directory component from ondisk filename, and assume it's in
 // the same directory as the index file
 const int IO_FLAG_ONDISK_SAME_DIR = 4;
+// load array inverted lists straight into ReadOnlyArrayInvertedLists,
+// using the codes in place if the reader can lend them
+const int IO_FLAG_READONLY_LISTS = 8;
 
 Index *read_index (const char *fname, int io_flags = 0);
 Index *read_index (FILE * f, int io_flags = 0);
@@ -57,7 +60,9 @@ IndexBinary *read_index_binary (FILE * f, int io_flags = 0);
 IndexBinary *read_index_binary (IOReader *reader, int io_flags = 0);
 
 void write_VectorTransform (const VectorTransform *vt, const char *fname);
+void write_VectorTransform (const VectorTransform *vt, IOWriter *f);
 VectorTransform *read_VectorTransform (const char *fname);
+VectorTransform *read_VectorTransform (IOReader *f);
 
 ProductQuantizer * read_ProductQuantizer (const char*fname);
 ProductQuantizer * read_ProductQuantizer (IOReader *reader);
@@ -13,6 +13,8 @@
 #include <cassert>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 
 #include <omp.h>
 
@@ -143,41 +145,102 @@ void fvec_renorm_L2 (size_t d, size_t nx, float * __restrict x)
 
 
 
+/* The SIMD scan is blocked: the database is scanned in blocks small enough
+ * to stay in L2 while every query of a tile is compared to them, and each
+ * distance is pushed to the heap of its query right away. Few queries would
+ * leave threads idle with a thread per query, the database is then split
+ * among the threads, each split keeping heaps of its own that are merged at
+ * the end. */
+
+// bytes of database vectors scanned per block
+static const size_t knn_block_bytes = 256 * 1024;
+// queries compared to a block before it is left
+static const size_t knn_query_tile = 8;
+
+template <class C>
+static void knn_blocked_sse (const float * x,
+                             const float * y,
+                             size_t d, size_t nx, size_t ny,
+                             HeapArray<C> * res,
+                             fvec_distance_t distance)
+{
+    size_t k = res->k;
+    size_t bs_y = std::max (knn_block_bytes / (d * sizeof(float)), size_t(1));
+    size_t n_blocks = (ny + bs_y - 1) / bs_y;
+    size_t n_tiles = (nx + knn_query_tile - 1) / knn_query_tile;
+    size_t n_threads = omp_get_max_threads();
+
+    size_t n_splits = 1;
+    if (n_tiles < n_threads && n_blocks > 1) {
+        n_splits = std::min ((n_threads + n_tiles - 1) / n_tiles, n_blocks);
+    }
+    size_t split_rows = (n_blocks + n_splits - 1) / n_splits * bs_y;
+
+    // heaps of the splits but the first, which fills the result
+    std::vector<typename C::T> split_val ((n_splits - 1) * nx * k);
+    std::vector<typename C::TI> split_ids ((n_splits - 1) * nx * k);
+    auto heap_val = [&] (size_t s, size_t i) {
+        return s == 0 ? res->get_val(i) : split_val.data() + ((s - 1) * nx + i) * k;
+    };
+    auto heap_ids = [&] (size_t s, size_t i) {
+        return s == 0 ? res->get_ids(i) : split_ids.data() + ((s - 1) * nx + i) * k;
+    };
+
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t w = 0; w < int64_t(n_tiles * n_splits); w++) {
+        size_t s = w % n_splits;
+        size_t i0 = w / n_splits * knn_query_tile;
+        size_t i1 = std::min (i0 + knn_query_tile, nx);
+        size_t j_begin = std::min (s * split_rows, ny);
+        size_t j_end = std::min (j_begin + split_rows, ny);
+
+        for (size_t i = i0; i < i1; i++) {
+            heap_heapify<C> (k, heap_val(s, i), heap_ids(s, i));
+        }
+        for (size_t j0 = j_begin; j0 < j_end; j0 += bs_y) {
+            size_t j1 = std::min (j0 + bs_y, j_end);
+            for (size_t i = i0; i < i1; i++) {
+                const float * x_i = x + i * d;
+                typename C::T * __restrict simi = heap_val(s, i);
+                typename C::TI * __restrict idxi = heap_ids(s, i);
+                const float * y_j = y + j0 * d;
+                for (size_t j = j0; j < j1; j++) {
+                    float dis = distance (x_i, y_j, d);
+                    if (C::cmp (simi[0], dis)) {
+                        heap_pop<C> (k, simi, idxi);
+                        heap_push<C> (k, simi, idxi, dis, j);
+                    }
+                    y_j += d;
+                }
+            }
+        }
+    }
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(nx); i++) {
+        typename C::T * simi = res->get_val(i);
+        typename C::TI * idxi = res->get_ids(i);
+        for (size_t s = 1; s < n_splits; s++) {
+            // empty slots hold the neutral value, which never enters a heap
+            heap_addn<C> (k, simi, idxi, heap_val(s, i), heap_ids(s, i), k);
+        }
+        heap_reorder<C> (k, simi, idxi);
+    }
+}
+
 /* Find the nearest neighbors for nx queries in a set of ny vectors */
 static void knn_inner_product_sse (const float * x,
                         const float * y,
                         size_t d, size_t nx, size_t ny,
                         float_minheap_array_t * res)
 {
-    size_t k = res->k;
     size_t check_period = InterruptCallback::get_period_hint (ny * d);
-
     check_period *= omp_get_max_threads();
 
     for (size_t i0 = 0; i0 < nx; i0 += check_period) {
         size_t i1 = std::min(i0 + check_period, nx);
-
-#pragma omp parallel for
-        for (size_t i = i0; i < i1; i++) {
-            const float * x_i = x + i * d;
-            const float * y_j = y;
-
-            float * __restrict simi = res->get_val(i);
-            int64_t * __restrict idxi = res->get_ids (i);
-
-            minheap_heapify (k, simi, idxi);
-
-            for (size_t j = 0; j < ny; j++) {
-                float ip = fvec_inner_product (x_i, y_j, d);
-
-                if (ip > simi[0]) {
-                    minheap_pop (k, simi, idxi);
-                    minheap_push (k, simi, idxi, ip, j);
-                }
-                y_j += d;
-            }
-            minheap_reorder (k, simi, idxi);
-        }
+        float_minheap_array_t res_i = {i1 - i0, res->k, res->get_ids (i0), res->get_val (i0)};
+        knn_blocked_sse (x + i0 * d, y, d, i1 - i0, ny, &res_i, fvec_inner_product_kernel (d));
         InterruptCallback::check ();
     }
 
@@ -189,34 +252,13 @@ static void knn_L2sqr_sse (
                 size_t d, size_t nx, size_t ny,
                 float_maxheap_array_t * res)
 {
-    size_t k = res->k;
-
     size_t check_period = InterruptCallback::get_period_hint (ny * d);
     check_period *= omp_get_max_threads();
 
     for (size_t i0 = 0; i0 < nx; i0 += check_period) {
         size_t i1 = std::min(i0 + check_period, nx);
-
-#pragma omp parallel for
-        for (size_t i = i0; i < i1; i++) {
-            const float * x_i = x + i * d;
-            const float * y_j = y;
-            size_t j;
-            float * simi = res->get_val(i);
-            int64_t * idxi = res->get_ids (i);
-
-            maxheap_heapify (k, simi, idxi);
-            for (j = 0; j < ny; j++) {
-                float disij = fvec_L2sqr (x_i, y_j, d);
-
-                if (disij < simi[0]) {
-                    maxheap_pop (k, simi, idxi);
-                    maxheap_push (k, simi, idxi, disij, j);
-                }
-                y_j += d;
-            }
-            maxheap_reorder (k, simi, idxi);
-        }
+        float_maxheap_array_t res_i = {i1 - i0, res->k, res->get_ids (i0), res->get_val (i0)};
+        knn_blocked_sse (x + i0 * d, y, d, i1 - i0, ny, &res_i, fvec_L2sqr_kernel (d));
         InterruptCallback::check ();
     }
 
@@ -424,13 +466,26 @@ static void knn_jaccard_blas (const float * x,
  *******************************************************/
 
 int distance_compute_blas_threshold = 20;
+BlasSelector distance_compute_blas_selector = nullptr;
+
+static bool use_blas (size_t d, size_t nx, size_t ny)
+{
+    if (d % 4 != 0) {
+        return true;
+    }
+    BlasSelector selector = distance_compute_blas_selector;
+    if (selector != nullptr) {
+        return selector (d, nx, ny);
+    }
+    return nx >= distance_compute_blas_threshold;
+}
 
 void knn_inner_product (const float * x,
         const float * y,
         size_t d, size_t nx, size_t ny,
         float_minheap_array_t * res)
 {
-    if (d % 4 == 0 && nx < distance_compute_blas_threshold) {
+    if (!use_blas (d, nx, ny)) {
         knn_inner_product_sse (x, y, d, nx, ny, res);
     } else {
         knn_inner_product_blas (x, y, d, nx, ny, res);
@@ -450,7 +505,16 @@ void knn_L2sqr (const float * x,
                 size_t d, size_t nx, size_t ny,
                 float_maxheap_array_t * res)
 {
-    if (d % 4 == 0 && nx < distance_compute_blas_threshold) {
+    knn_L2sqr_with (use_blas (d, nx, ny), x, y, d, nx, ny, res);
+}
+
+void knn_L2sqr_with (bool use_blas,
+                     const float * x,
+                     const float * y,
+                     size_t d, size_t nx, size_t ny,
+                     float_maxheap_array_t * res)
+{
+    if (!use_blas && d % 4 == 0) {
         knn_L2sqr_sse (x, y, d, nx, ny, res);
     } else {
         NopDistanceCorrection nop;
@@ -778,7 +842,7 @@ void range_search_L2sqr (
         RangeSearchResult *res)
 {
 
-    if (d % 4 == 0 && nx < distance_compute_blas_threshold) {
+    if (!use_blas (d, nx, ny)) {
         range_search_sse<true> (x, y, d, nx, ny, radius, res);
     } else {
         range_search_blas<true> (x, y, d, nx, ny, radius, res);
@@ -793,7 +857,7 @@ void range_search_inner_product (
         RangeSearchResult *res)
 {
 
-    if (d % 4 == 0 && nx < distance_compute_blas_threshold) {
+    if (!use_blas (d, nx, ny)) {
         range_search_sse<false> (x, y, d, nx, ny, radius, res);
     } else {
         range_search_blas<false> (x, y, d, nx, ny, radius, res);
@@ -36,6 +36,17 @@ float  fvec_inner_product (
         const float * y,
         size_t d);
 
+/// distance between two vectors of dimension d
+typedef float (*fvec_distance_t) (const float * x, const float * y, size_t d);
+
+/** fvec_L2sqr and fvec_inner_product unrolled for the dimension d if it
+ * is one of the common ones (128, 256, 512, 768), the generic functions
+ * otherwise. Meant to be chosen once before a scan and called for each
+ * vector of dimension d. */
+fvec_distance_t fvec_L2sqr_kernel (size_t d);
+
+fvec_distance_t fvec_inner_product_kernel (size_t d);
+
 /// L1 distance
 float fvec_L1 (
         const float * x,
@@ -159,6 +170,12 @@ void pairwise_indexed_inner_product (
 // threshold on nx above which we switch to BLAS to compute distances
 extern int distance_compute_blas_threshold;
 
+/** chooses BLAS (true) or the SIMD scan for nx queries of dimension d
+ *  against ny vectors, distance_compute_blas_threshold is used if not set.
+ *  The SIMD scan needs d % 4 == 0, BLAS is used otherwise. */
+typedef bool (*BlasSelector) (size_t d, size_t nx, size_t ny);
+extern BlasSelector distance_compute_blas_selector;
+
 /** Return the k nearest neighors of each of the nx vectors x among the ny
  *  vector y, w.r.t to max inner product
  *
@@ -179,6 +196,15 @@ void knn_L2sqr (
         size_t d, size_t nx, size_t ny,
         float_maxheap_array_t * res);
 
+/** Same as knn_L2sqr, with BLAS or the SIMD scan chosen by the caller,
+ *  e.g. to time both */
+void knn_L2sqr_with (
+        bool use_blas,
+        const float * x,
+        const float * y,
+        size_t d, size_t nx, size_t ny,
+        float_maxheap_array_t * res);
+
 void knn_jaccard (
         const float * x,
         const float * y,
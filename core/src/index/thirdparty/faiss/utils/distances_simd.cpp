@@ -649,6 +649,145 @@ void fvec_L2sqr_ny (float * dis, const float * x,
 #endif
 
 
+/*********************************************************
+ * Kernels for a dimension known at compile time
+ *
+ * D is a multiple of 32, the loop is unrolled by the compiler and
+ * the sums are split over 4 accumulators, so that the additions
+ * don't wait for each other as in the generic functions.
+ *********************************************************/
+
+#ifdef USE_AVX
+
+static inline float horizontal_sum (__m256 msum0, __m256 msum1,
+                                    __m256 msum2, __m256 msum3)
+{
+    msum0 = _mm256_add_ps (_mm256_add_ps (msum0, msum1),
+                           _mm256_add_ps (msum2, msum3));
+    __m128 msum = _mm256_extractf128_ps (msum0, 1);
+    msum = _mm_add_ps (msum, _mm256_extractf128_ps (msum0, 0));
+    msum = _mm_hadd_ps (msum, msum);
+    msum = _mm_hadd_ps (msum, msum);
+    return _mm_cvtss_f32 (msum);
+}
+
+template <size_t D>
+static float fvec_L2sqr_fixed (const float * x, const float * y, size_t)
+{
+    __m256 msum0 = _mm256_setzero_ps ();
+    __m256 msum1 = _mm256_setzero_ps ();
+    __m256 msum2 = _mm256_setzero_ps ();
+    __m256 msum3 = _mm256_setzero_ps ();
+    for (size_t i = 0; i < D; i += 32) {
+        __m256 a_m_b0 = _mm256_loadu_ps (x + i) - _mm256_loadu_ps (y + i);
+        __m256 a_m_b1 = _mm256_loadu_ps (x + i + 8) - _mm256_loadu_ps (y + i + 8);
+        __m256 a_m_b2 = _mm256_loadu_ps (x + i + 16) - _mm256_loadu_ps (y + i + 16);
+        __m256 a_m_b3 = _mm256_loadu_ps (x + i + 24) - _mm256_loadu_ps (y + i + 24);
+        msum0 += a_m_b0 * a_m_b0;
+        msum1 += a_m_b1 * a_m_b1;
+        msum2 += a_m_b2 * a_m_b2;
+        msum3 += a_m_b3 * a_m_b3;
+    }
+    return horizontal_sum (msum0, msum1, msum2, msum3);
+}
+
+template <size_t D>
+static float fvec_inner_product_fixed (const float * x, const float * y,
+                                       size_t)
+{
+    __m256 msum0 = _mm256_setzero_ps ();
+    __m256 msum1 = _mm256_setzero_ps ();
+    __m256 msum2 = _mm256_setzero_ps ();
+    __m256 msum3 = _mm256_setzero_ps ();
+    for (size_t i = 0; i < D; i += 32) {
+        msum0 += _mm256_loadu_ps (x + i) * _mm256_loadu_ps (y + i);
+        msum1 += _mm256_loadu_ps (x + i + 8) * _mm256_loadu_ps (y + i + 8);
+        msum2 += _mm256_loadu_ps (x + i + 16) * _mm256_loadu_ps (y + i + 16);
+        msum3 += _mm256_loadu_ps (x + i + 24) * _mm256_loadu_ps (y + i + 24);
+    }
+    return horizontal_sum (msum0, msum1, msum2, msum3);
+}
+
+#elif defined(__SSE__)
+
+static inline float horizontal_sum (__m128 msum0, __m128 msum1,
+                                    __m128 msum2, __m128 msum3)
+{
+    msum0 = _mm_add_ps (_mm_add_ps (msum0, msum1),
+                        _mm_add_ps (msum2, msum3));
+    msum0 = _mm_hadd_ps (msum0, msum0);
+    msum0 = _mm_hadd_ps (msum0, msum0);
+    return _mm_cvtss_f32 (msum0);
+}
+
+template <size_t D>
+static float fvec_L2sqr_fixed (const float * x, const float * y, size_t)
+{
+    __m128 msum0 = _mm_setzero_ps ();
+    __m128 msum1 = _mm_setzero_ps ();
+    __m128 msum2 = _mm_setzero_ps ();
+    __m128 msum3 = _mm_setzero_ps ();
+    for (size_t i = 0; i < D; i += 16) {
+        __m128 a_m_b0 = _mm_loadu_ps (x + i) - _mm_loadu_ps (y + i);
+        __m128 a_m_b1 = _mm_loadu_ps (x + i + 4) - _mm_loadu_ps (y + i + 4);
+        __m128 a_m_b2 = _mm_loadu_ps (x + i + 8) - _mm_loadu_ps (y + i + 8);
+        __m128 a_m_b3 = _mm_loadu_ps (x + i + 12) - _mm_loadu_ps (y + i + 12);
+        msum0 += a_m_b0 * a_m_b0;
+        msum1 += a_m_b1 * a_m_b1;
+        msum2 += a_m_b2 * a_m_b2;
+        msum3 += a_m_b3 * a_m_b3;
+    }
+    return horizontal_sum (msum0, msum1, msum2, msum3);
+}
+
+template <size_t D>
+static float fvec_inner_product_fixed (const float * x, const float * y,
+                                       size_t)
+{
+    __m128 msum0 = _mm_setzero_ps ();
+    __m128 msum1 = _mm_setzero_ps ();
+    __m128 msum2 = _mm_setzero_ps ();
+    __m128 msum3 = _mm_setzero_ps ();
+    for (size_t i = 0; i < D; i += 16) {
+        msum0 += _mm_loadu_ps (x + i) * _mm_loadu_ps (y + i);
+        msum1 += _mm_loadu_ps (x + i + 4) * _mm_loadu_ps (y + i + 4);
+        msum2 += _mm_loadu_ps (x + i + 8) * _mm_loadu_ps (y + i + 8);
+        msum3 += _mm_loadu_ps (x + i + 12) * _mm_loadu_ps (y + i + 12);
+    }
+    return horizontal_sum (msum0, msum1, msum2, msum3);
+}
+
+#endif
+
+fvec_distance_t fvec_L2sqr_kernel (size_t d)
+{
+#ifdef __SSE__
+    switch (d) {
+    case 128: return fvec_L2sqr_fixed<128>;
+    case 256: return fvec_L2sqr_fixed<256>;
+    case 512: return fvec_L2sqr_fixed<512>;
+    case 768: return fvec_L2sqr_fixed<768>;
+    default: break;
+    }
+#endif
+    return fvec_L2sqr;
+}
+
+fvec_distance_t fvec_inner_product_kernel (size_t d)
+{
+#ifdef __SSE__
+    switch (d) {
+    case 128: return fvec_inner_product_fixed<128>;
+    case 256: return fvec_inner_product_fixed<256>;
+    case 512: return fvec_inner_product_fixed<512>;
+    case 768: return fvec_inner_product_fixed<768>;
+    default: break;
+    }
+#endif
+    return fvec_inner_product;
+}
+
+
 
 
 
@@ -72,7 +72,7 @@ inline uint64_t BitstringReader::read(int nbit) {
 
 /******************************************************************
  * The HammingComputer series of classes compares a single code of
- * size 4 to 32 to incoming codes. They are intended for use as a
+ * size 4 to 128 to incoming codes. They are intended for use as a
  * template class where it would be inefficient to switch on the code
  * size in the inner loop. Hopefully the compiler will inline the
  * hamming() functions and put the a0, a1, ... in registers.
@@ -191,7 +191,7 @@ struct HammingComputer32 {
 };
 
 struct HammingComputer64 {
-    uint64_t a0, a1, a2, a3, a4, a5, a6, a7;
+    uint64_t a[8];
 
     HammingComputer64 () {}
 
@@ -201,17 +201,57 @@ struct HammingComputer64 {
 
     void set (const uint8_t *a8, int code_size) {
         assert (code_size == 64);
-        const uint64_t *a = (uint64_t *)a8;
-        a0 = a[0]; a1 = a[1]; a2 = a[2]; a3 = a[3];
-        a4 = a[4]; a5 = a[5]; a6 = a[6]; a7 = a[7];
+        memcpy (a, a8, 64);
     }
 
     inline int hamming (const uint8_t *b8) const {
+#ifdef __AVX512VPOPCNTDQ__
+        return popcount512 (_mm512_xor_si512 (_mm512_loadu_si512 (b8),
+                                              _mm512_loadu_si512 (a)));
+#else
         const uint64_t *b = (uint64_t *)b8;
-        return popcount64 (b[0] ^ a0) + popcount64 (b[1] ^ a1) +
-            popcount64 (b[2] ^ a2) + popcount64 (b[3] ^ a3) +
-            popcount64 (b[4] ^ a4) + popcount64 (b[5] ^ a5) +
-            popcount64 (b[6] ^ a6) + popcount64 (b[7] ^ a7);
+        return popcount64 (b[0] ^ a[0]) + popcount64 (b[1] ^ a[1]) +
+            popcount64 (b[2] ^ a[2]) + popcount64 (b[3] ^ a[3]) +
+            popcount64 (b[4] ^ a[4]) + popcount64 (b[5] ^ a[5]) +
+            popcount64 (b[6] ^ a[6]) + popcount64 (b[7] ^ a[7]);
+#endif
+    }
+
+};
+
+struct HammingComputer128 {
+    uint64_t a[16];
+
+    HammingComputer128 () {}
+
+    HammingComputer128 (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        assert (code_size == 128);
+        memcpy (a, a8, 128);
+    }
+
+    inline int hamming (const uint8_t *b8) const {
+#ifdef __AVX512VPOPCNTDQ__
+        __m512i x0 = _mm512_xor_si512 (_mm512_loadu_si512 (b8),
+                                       _mm512_loadu_si512 (a));
+        __m512i x1 = _mm512_xor_si512 (_mm512_loadu_si512 (b8 + 64),
+                                       _mm512_loadu_si512 (a + 8));
+        return _mm512_reduce_add_epi64 (
+            _mm512_add_epi64 (_mm512_popcnt_epi64 (x0),
+                              _mm512_popcnt_epi64 (x1)));
+#else
+        const uint64_t *b = (uint64_t *)b8;
+        // two accumulators so the popcounts of both halves can be in flight
+        int accu0 = 0, accu1 = 0;
+        for (int i = 0; i < 16; i += 2) {
+            accu0 += popcount64 (b[i] ^ a[i]);
+            accu1 += popcount64 (b[i + 1] ^ a[i + 1]);
+        }
+        return accu0 + accu1;
+#endif
     }
 
 };
@@ -318,6 +358,7 @@ SPECIALIZED_HC(16);
 SPECIALIZED_HC(20);
 SPECIALIZED_HC(32);
 SPECIALIZED_HC(64);
+SPECIALIZED_HC(128);
 
 #undef SPECIALIZED_HC
 
@@ -556,6 +556,14 @@ void hammings_knn_hc (
         hammings_knn_hc<faiss::HammingComputer32>
             (32, ha, a, b, nb, order, true);
         break;
+    case 64:
+        hammings_knn_hc<faiss::HammingComputer64>
+            (64, ha, a, b, nb, order, true);
+        break;
+    case 128:
+        hammings_knn_hc<faiss::HammingComputer128>
+            (128, ha, a, b, nb, order, true);
+        break;
     default:
         if(ncodes % 8 == 0) {
             hammings_knn_hc<faiss::HammingComputerM8>
@@ -601,6 +609,16 @@ void hammings_knn_mc(
           32, a, b, na, nb, k, distances, labels
         );
         break;
+    case 64:
+        hammings_knn_mc<faiss::HammingComputer64>(
+          64, a, b, na, nb, k, distances, labels
+        );
+        break;
+    case 128:
+        hammings_knn_mc<faiss::HammingComputer128>(
+          128, a, b, na, nb, k, distances, labels
+        );
+        break;
     default:
         if(ncodes % 8 == 0) {
             hammings_knn_mc<faiss::HammingComputerM8>(
@@ -26,6 +26,11 @@
 
 
 #include <stdint.h>
+#include <string.h>
+
+#ifdef __AVX512VPOPCNTDQ__
+#include <immintrin.h>
+#endif
 
 #include <faiss/utils/Heap.h>
 
@@ -106,6 +111,13 @@ inline int popcount64(uint64_t x) {
     return __builtin_popcountl(x);
 }
 
+#ifdef __AVX512VPOPCNTDQ__
+/* number of bits set in a 512-bit register, one VPOPCNTQ for 8 words */
+inline int popcount512(__m512i x) {
+    return _mm512_reduce_add_epi64(_mm512_popcnt_epi64(x));
+}
+#endif
+
 
 /** Compute a set of Hamming distances between na and nb binary vectors
  *
@@ -63,7 +63,7 @@ namespace faiss {
     };
 
     struct JaccardComputer64 {
-        uint64_t a0, a1, a2, a3, a4, a5, a6, a7;
+        uint64_t a[8];
 
         JaccardComputer64 () {}
 
@@ -73,23 +73,24 @@ namespace faiss {
 
         void set (const uint8_t *a8, int code_size) {
             assert (code_size == 64);
-            const uint64_t *a = (uint64_t *)a8;
-            a0 = a[0]; a1 = a[1]; a2 = a[2]; a3 = a[3];
-            a4 = a[4]; a5 = a[5]; a6 = a[6]; a7 = a[7];
+            memcpy (a, a8, 64);
         }
 
         inline float jaccard (const uint8_t *b8) const {
-            const uint64_t *b = (uint64_t *)b8;
             int accu_num = 0;
             int accu_den = 0;
-            accu_num += popcount64 (b[0] & a0) + popcount64 (b[1] & a1) +
-                        popcount64 (b[2] & a2) + popcount64 (b[3] & a3) +
-                        popcount64 (b[4] & a4) + popcount64 (b[5] & a5) +
-                        popcount64 (b[6] & a6) + popcount64 (b[7] & a7);
-            accu_den += popcount64 (b[0] | a0) + popcount64 (b[1] | a1) +
-                        popcount64 (b[2] | a2) + popcount64 (b[3] | a3) +
-                        popcount64 (b[4] | a4) + popcount64 (b[5] | a5) +
-                        popcount64 (b[6] | a6) + popcount64 (b[7] | a7);
+#ifdef __AVX512VPOPCNTDQ__
+            __m512i va = _mm512_loadu_si512 (a);
+            __m512i vb = _mm512_loadu_si512 (b8);
+            accu_num = popcount512 (_mm512_and_si512 (va, vb));
+            accu_den = popcount512 (_mm512_or_si512 (va, vb));
+#else
+            const uint64_t *b = (uint64_t *)b8;
+            for (int i = 0; i < 8; i++) {
+                accu_num += popcount64 (b[i] & a[i]);
+                accu_den += popcount64 (b[i] | a[i]);
+            }
+#endif
             if (accu_num == 0)
                 return 1.0;
             return 1.0 - (float)(accu_num) / (float)(accu_den);
@@ -98,8 +99,7 @@ namespace faiss {
     };
 
     struct JaccardComputer128 {
-        uint64_t a0, a1, a2, a3, a4, a5, a6, a7,
-                a8, a9, a10, a11, a12, a13, a14, a15;
+        uint64_t a[16];
 
         JaccardComputer128 () {}
 
@@ -109,33 +109,61 @@ namespace faiss {
 
         void set (const uint8_t *a16, int code_size) {
             assert (code_size == 128 );
-            const uint64_t *a = (uint64_t *)a16;
-            a0 = a[0]; a1 = a[1]; a2 = a[2]; a3 = a[3];
-            a4 = a[4]; a5 = a[5]; a6 = a[6]; a7 = a[7];
-            a8 = a[8]; a9 = a[9]; a10 = a[10]; a11 = a[11];
-            a12 = a[12]; a13 = a[13]; a14 = a[14]; a15 = a[15];
+            memcpy (a, a16, 128);
         }
 
         inline float jaccard (const uint8_t *b16) const {
+            int accu_num = 0;
+            int accu_den = 0;
+#ifdef __AVX512VPOPCNTDQ__
+            __m512i va0 = _mm512_loadu_si512 (a);
+            __m512i va1 = _mm512_loadu_si512 (a + 8);
+            __m512i vb0 = _mm512_loadu_si512 (b16);
+            __m512i vb1 = _mm512_loadu_si512 (b16 + 64);
+            accu_num = _mm512_reduce_add_epi64 (_mm512_add_epi64 (
+                    _mm512_popcnt_epi64 (_mm512_and_si512 (va0, vb0)),
+                    _mm512_popcnt_epi64 (_mm512_and_si512 (va1, vb1))));
+            accu_den = _mm512_reduce_add_epi64 (_mm512_add_epi64 (
+                    _mm512_popcnt_epi64 (_mm512_or_si512 (va0, vb0)),
+                    _mm512_popcnt_epi64 (_mm512_or_si512 (va1, vb1))));
+#else
             const uint64_t *b = (uint64_t *)b16;
+            for (int i = 0; i < 16; i++) {
+                accu_num += popcount64 (b[i] & a[i]);
+                accu_den += popcount64 (b[i] | a[i]);
+            }
+#endif
+            if (accu_num == 0)
+                return 1.0;
+            return 1.0 - (float)(accu_num) / (float)(accu_den);
+        }
+
+    };
+
+    struct JaccardComputerM8 {
+        const uint64_t *a;
+        int n;
+
+        JaccardComputerM8 () {}
+
+        JaccardComputerM8 (const uint8_t *a8, int code_size) {
+            set (a8, code_size);
+        }
+
+        void set (const uint8_t *a8, int code_size) {
+            assert (code_size % 8 == 0);
+            a = (uint64_t *)a8;
+            n = code_size / 8;
+        }
+
+        float jaccard (const uint8_t *b8) const {
+            const uint64_t *b = (uint64_t *)b8;
             int accu_num = 0;
             int accu_den = 0;
-            accu_num += popcount64 (b[0] & a0) + popcount64 (b[1] & a1) +
-                        popcount64 (b[2] & a2) + popcount64 (b[3] & a3) +
-                        popcount64 (b[4] & a4) + popcount64 (b[5] & a5) +
-                        popcount64 (b[6] & a6) + popcount64 (b[7] & a7) +
-                        popcount64 (b[8] & a8) + popcount64 (b[9] & a9) +
-                        popcount64 (b[10] & a10) + popcount64 (b[11] & a11) +
-                        popcount64 (b[12] & a12) + popcount64 (b[13] & a13) +
-                        popcount64 (b[14] & a14) + popcount64 (b[15] & a15);
-            accu_den += popcount64 (b[0] | a0) + popcount64 (b[1] | a1) +
-                        popcount64 (b[2] | a2) + popcount64 (b[3] | a3) +
-                        popcount64 (b[4] | a4) + popcount64 (b[5] | a5) +
-                        popcount64 (b[6] | a6) + popcount64 (b[7] | a7) +
-                        popcount64 (b[8] | a8) + popcount64 (b[9] | a9) +
-                        popcount64 (b[10] | a10) + popcount64 (b[11] | a11) +
-                        popcount64 (b[12] | a12) + popcount64 (b[13] | a13) +
-                        popcount64 (b[14] | a14) + popcount64 (b[15] | a15);
+            for (int i = 0; i < n; i++) {
+                accu_num += popcount64 (a[i] & b[i]);
+                accu_den += popcount64 (a[i] | b[i]);
+            }
             if (accu_num == 0)
                 return 1.0;
             return 1.0 - (float)(accu_num) / (float)(accu_den);
@@ -81,8 +81,13 @@ namespace faiss {
                         (128, ha, a, b, nb, order, true);
                 break;
             default:
-                jaccard_knn_hc<faiss::JaccardComputerDefault>
-                        (ncodes, ha, a, b, nb, order, true);
+                if (ncodes % 8 == 0) {
+                    jaccard_knn_hc<faiss::JaccardComputerM8>
+                            (ncodes, ha, a, b, nb, order, true);
+                } else {
+                    jaccard_knn_hc<faiss::JaccardComputerDefault>
+                            (ncodes, ha, a, b, nb, order, true);
+                }
         }
     }
 
@@ -17,7 +17,10 @@ namespace hnswlib {
     class HierarchicalNSW : public AlgorithmInterface<dist_t> {
     public:
 
-        HierarchicalNSW(SpaceInterface<dist_t> *s) {
+        // an empty index to be filled by loadIndex, destructible if the load fails
+        HierarchicalNSW(SpaceInterface<dist_t> *s)
+                : space(nullptr), cur_element_count(0), visited_list_pool_(nullptr),
+                  data_level0_memory_(nullptr), linkLists_(nullptr) {
         }
 
         HierarchicalNSW(SpaceInterface<dist_t> *s, const std::string &location, bool nmslib = false, size_t max_elements=0) {
@@ -32,6 +35,8 @@ namespace hnswlib {
                 metric_type_ = 0;
             } else if (auto x = dynamic_cast<InnerProductSpace*>(s)) {
                 metric_type_ = 1;
+            } else if (auto x = dynamic_cast<SQ8Space*>(s)) {
+                metric_type_ = x->is_ip() ? 3 : 2;
             } else {
                 metric_type_ = 100;
             }
@@ -41,6 +46,7 @@ namespace hnswlib {
             has_deletions_=false;
             data_size_ = s->get_data_size();
             fstdistfunc_ = s->get_dist_func();
+            fstqdistfunc_ = s->get_query_dist_func();
             dist_func_param_ = s->get_dist_func_param();
             M_ = M;
             maxM_ = M_;
@@ -101,7 +107,7 @@ namespace hnswlib {
 
         // linxj: use for free resource
         SpaceInterface<dist_t> *space;
-        size_t metric_type_; // 0:l2, 1:ip
+        size_t metric_type_; // 0:l2, 1:ip, 2:sq8 l2, 3:sq8 ip
 
         size_t max_elements_;
         size_t cur_element_count;
@@ -139,6 +145,8 @@ namespace hnswlib {
 
         size_t label_offset_;
         DISTFUNC<dist_t> fstdistfunc_;
+        // distance of a query to stored points, walks of search use it while build compares stored points
+        DISTFUNC<dist_t> fstqdistfunc_;
         void *dist_func_param_;
         std::unordered_map<labeltype, tableint> label_lookup_;
 
@@ -252,7 +260,8 @@ namespace hnswlib {
 
         template <bool has_deletions>
         std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-        searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef) const {
+        searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef,
+                          const BaseFilterFunctor *isIdAllowed = nullptr) const {
             VisitedList *vl = visited_list_pool_->getFreeVisitedList();
             vl_type *visited_array = vl->mass;
             vl_type visited_array_tag = vl->curV;
@@ -261,8 +270,9 @@ namespace hnswlib {
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidate_set;
 
             dist_t lowerBound;
-            if (!has_deletions || !isMarkedDeleted(ep_id)) {
-                dist_t dist = fstdistfunc_(data_point, getDataByInternalId(ep_id), dist_func_param_);
+            if ((!has_deletions || !isMarkedDeleted(ep_id)) &&
+                (!isIdAllowed || (*isIdAllowed)(getExternalLabel(ep_id)))) {
+                dist_t dist = fstqdistfunc_(data_point, getDataByInternalId(ep_id), dist_func_param_);
                 lowerBound = dist;
                 top_candidates.emplace(dist, ep_id);
                 candidate_set.emplace(-dist, ep_id);
@@ -307,7 +317,7 @@ namespace hnswlib {
                         visited_array[candidate_id] = visited_array_tag;
 
                         char *currObj1 = (getDataByInternalId(candidate_id));
-                        dist_t dist = fstdistfunc_(data_point, currObj1, dist_func_param_);
+                        dist_t dist = fstqdistfunc_(data_point, currObj1, dist_func_param_);
 
                         if (top_candidates.size() < ef || lowerBound > dist) {
                             candidate_set.emplace(-dist, candidate_id);
@@ -317,7 +327,8 @@ namespace hnswlib {
                                          _MM_HINT_T0);////////////////////////
 #endif
 
-                            if (!has_deletions || !isMarkedDeleted(candidate_id))
+                            if ((!has_deletions || !isMarkedDeleted(candidate_id)) &&
+                                (!isIdAllowed || (*isIdAllowed)(getExternalLabel(candidate_id))))
                                 top_candidates.emplace(dist, candidate_id);
 
                             if (top_candidates.size() > ef)
@@ -506,7 +517,7 @@ namespace hnswlib {
             std::priority_queue<std::pair<dist_t, tableint  >> top_candidates;
             if (cur_element_count == 0) return top_candidates;
             tableint currObj = enterpoint_node_;
-            dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
+            dist_t curdist = fstqdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
 
             for (size_t level = maxlevel_; level > 0; level--) {
                 bool changed = true;
@@ -520,7 +531,7 @@ namespace hnswlib {
                         tableint cand = datal[i];
                         if (cand < 0 || cand > max_elements_)
                             throw std::runtime_error("cand error");
-                        dist_t d = fstdistfunc_(query_data, getDataByInternalId(cand), dist_func_param_);
+                        dist_t d = fstqdistfunc_(query_data, getDataByInternalId(cand), dist_func_param_);
 
                         if (d < curdist) {
                             curdist = d;
@@ -583,6 +594,21 @@ namespace hnswlib {
 
         }
 
+        // bytes written by saveIndex(knowhere::MemoryIOWriter&), to allocate the output buffer once
+        size_t serializedSize() const {
+            size_t size = sizeof(metric_type_) + sizeof(data_size_) + sizeof(size_t);
+            size += sizeof(offsetLevel0_) + sizeof(max_elements_) + sizeof(cur_element_count);
+            size += sizeof(size_data_per_element_) + sizeof(label_offset_) + sizeof(offsetData_);
+            size += sizeof(maxlevel_) + sizeof(enterpoint_node_) + sizeof(maxM_) + sizeof(maxM0_) + sizeof(M_);
+            size += sizeof(mult_) + sizeof(ef_construction_);
+            size += cur_element_count * size_data_per_element_;
+            for (size_t i = 0; i < cur_element_count; i++) {
+                unsigned int linkListSize = element_levels_[i] > 0 ? size_links_per_element_ * element_levels_[i] : 0;
+                size += sizeof(linkListSize) + linkListSize;
+            }
+            return size;
+        }
+
         void saveIndex(knowhere::MemoryIOWriter& output) {
             // write l2/ip calculator
             writeBinaryPOD(output, metric_type_);
@@ -615,7 +641,10 @@ namespace hnswlib {
 //            output.close();
         }
 
-        void loadIndex(knowhere::MemoryIOReader& input, size_t max_elements_i = 0) {
+        // spaces holding parameters beyond the dimension, as SQ8Space, are not rebuilt from the metric type,
+        // the caller restores and passes it with s, then the index owns it
+        void loadIndex(knowhere::MemoryIOReader& input, size_t max_elements_i = 0,
+                       SpaceInterface<dist_t> *s = nullptr) {
             auto totoal_filesize = input.total;
 
             // linxj: init with metrictype
@@ -623,14 +652,19 @@ namespace hnswlib {
             readBinaryPOD(input, metric_type_);
             readBinaryPOD(input, data_size_);
             readBinaryPOD(input, dim);
-            if (metric_type_ == 0) {
+            if (s != nullptr) {
+                space = s;
+            } else if (metric_type_ == 0) {
                 space = new hnswlib::L2Space(dim);
             } else if (metric_type_ == 1) {
                 space = new hnswlib::InnerProductSpace(dim);
             } else {
-                // throw exception
+                throw std::runtime_error("Space of metric type " + std::to_string(metric_type_) + " is not given");
             }
+            if (space->get_data_size() != data_size_ || *((size_t *) space->get_dist_func_param()) != dim)
+                throw std::runtime_error("Space doesn't match the index");
             fstdistfunc_ = space->get_dist_func();
+            fstqdistfunc_ = space->get_query_dist_func();
             dist_func_param_ = space->get_dist_func_param();
 
             readBinaryPOD(input, offsetLevel0_);
@@ -805,6 +839,7 @@ namespace hnswlib {
 
             data_size_ = s->get_data_size();
             fstdistfunc_ = s->get_dist_func();
+            fstqdistfunc_ = s->get_query_dist_func();
             dist_func_param_ = s->get_dist_func_param();
 
             auto pos=input.tellg();
@@ -1084,11 +1119,16 @@ namespace hnswlib {
 
         std::priority_queue<std::pair<dist_t, labeltype >>
         searchKnn(const void *query_data, size_t k) const {
+            return searchKnn(query_data, k, static_cast<const BaseFilterFunctor*>(nullptr));
+        }
+
+        std::priority_queue<std::pair<dist_t, labeltype >>
+        searchKnn(const void *query_data, size_t k, const BaseFilterFunctor *isIdAllowed, size_t ef = 0) const {
             std::priority_queue<std::pair<dist_t, labeltype >> result;
             if (cur_element_count == 0) return result;
 
             tableint currObj = enterpoint_node_;
-            dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
+            dist_t curdist = fstqdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
 
             for (int level = maxlevel_; level > 0; level--) {
                 bool changed = true;
@@ -1103,7 +1143,7 @@ namespace hnswlib {
                         tableint cand = datal[i];
                         if (cand < 0 || cand > max_elements_)
                             throw std::runtime_error("cand error");
-                        dist_t d = fstdistfunc_(query_data, getDataByInternalId(cand), dist_func_param_);
+                        dist_t d = fstqdistfunc_(query_data, getDataByInternalId(cand), dist_func_param_);
 
                         if (d < curdist) {
                             curdist = d;
@@ -1114,15 +1154,17 @@ namespace hnswlib {
                 }
             }
 
+            // ef of the request, the one set by setEf when not given
+            if (ef == 0) ef = ef_;
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
             if (has_deletions_) {
                 std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates1=searchBaseLayerST<true>(
-                        currObj, query_data, std::max(ef_, k));
+                        currObj, query_data, std::max(ef, k), isIdAllowed);
                 top_candidates.swap(top_candidates1);
             }
             else{
                 std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates1=searchBaseLayerST<false>(
-                        currObj, query_data, std::max(ef_, k));
+                        currObj, query_data, std::max(ef, k), isIdAllowed);
                 top_candidates.swap(top_candidates1);
             }
             while (top_candidates.size() > k) {
@@ -1138,11 +1180,13 @@ namespace hnswlib {
 
         template <typename Comp>
         std::vector<std::pair<dist_t, labeltype>>
-        searchKnn(const void* query_data, size_t k, Comp comp) {
+        searchKnn(const void* query_data, size_t k, Comp comp, const BaseFilterFunctor *isIdAllowed = nullptr,
+                  size_t ef = 0) {
             std::vector<std::pair<dist_t, labeltype>> result;
             if (cur_element_count == 0) return result;
 
-            auto ret = searchKnn(query_data, k);
+            // call the const overload explicitly, this template would take the filter as Comp otherwise
+            auto ret = static_cast<const HierarchicalNSW*>(this)->searchKnn(query_data, k, isIdAllowed, ef);
 
             while (!ret.empty()) {
                 result.push_back(ret.top());
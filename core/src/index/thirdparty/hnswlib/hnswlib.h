@@ -62,6 +62,13 @@ namespace hnswlib {
     template<typename MTYPE>
     using DISTFUNC = MTYPE(*)(const void *, const void *, const void *);
 
+    // restrict search results, the points it rejects are still walked through but never returned
+    class BaseFilterFunctor {
+    public:
+        virtual bool operator()(labeltype id) const { return true; }
+        virtual ~BaseFilterFunctor() {}
+    };
+
 
     template<typename MTYPE>
     class SpaceInterface {
@@ -71,6 +78,9 @@ namespace hnswlib {
 
         virtual DISTFUNC<MTYPE> get_dist_func() = 0;
 
+        // distance from a query to a stored point, differs from get_dist_func if points are stored encoded
+        virtual DISTFUNC<MTYPE> get_query_dist_func() { return get_dist_func(); }
+
         virtual void *get_dist_func_param() = 0;
 
         virtual ~SpaceInterface() {}
@@ -94,5 +104,6 @@ namespace hnswlib {
 
 #include "space_l2.h"
 #include "space_ip.h"
+#include "space_sq8.h"
 #include "bruteforce.h"
 #include "hnswalg.h"
@@ -0,0 +1,181 @@
+#pragma once
+#include "hnswlib.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace hnswlib {
+
+    // the dimension must be the first member, HierarchicalNSW reads the param as size_t*
+    struct SQ8Param {
+        size_t dim;
+        const float *base;   // decoded value of code 0, vmin + 0.5 * step
+        const float *step;   // (vmax - vmin) / 255
+        const float *step2;  // step * step
+        const float *cross;  // base * step
+        float base2;         // sum of base * base
+    };
+
+    // code c of dimension i decodes to base[i] + c * step[i], loops are marked simd for the float sums
+    // are only vectorized when they may be reordered
+
+    static float
+    SQ8L2Sqr(const void *pVect1, const void *pVect2, const void *param_ptr) {
+        auto param = (const SQ8Param *) param_ptr;
+        auto code1 = (const uint8_t *) pVect1;
+        auto code2 = (const uint8_t *) pVect2;
+        const float *step2 = param->step2;
+        size_t dim = param->dim;
+        float res = 0;
+#pragma omp simd reduction(+ : res)
+        for (size_t i = 0; i < dim; i++) {
+            int t = (int) code1[i] - (int) code2[i];
+            res += (float) (t * t) * step2[i];
+        }
+        return res;
+    }
+
+    static float
+    SQ8L2SqrQuery(const void *pVect1, const void *pVect2, const void *param_ptr) {
+        auto param = (const SQ8Param *) param_ptr;
+        auto query = (const float *) pVect1;
+        auto code = (const uint8_t *) pVect2;
+        const float *base = param->base;
+        const float *step = param->step;
+        size_t dim = param->dim;
+        float res = 0;
+#pragma omp simd reduction(+ : res)
+        for (size_t i = 0; i < dim; i++) {
+            float t = query[i] - (base[i] + code[i] * step[i]);
+            res += t * t;
+        }
+        return res;
+    }
+
+    static float
+    SQ8InnerProduct(const void *pVect1, const void *pVect2, const void *param_ptr) {
+        // (base + a * step) * (base + b * step) = base^2 + base * step * (a + b) + step^2 * a * b
+        auto param = (const SQ8Param *) param_ptr;
+        auto code1 = (const uint8_t *) pVect1;
+        auto code2 = (const uint8_t *) pVect2;
+        const float *cross = param->cross;
+        const float *step2 = param->step2;
+        size_t dim = param->dim;
+        float res = param->base2;
+#pragma omp simd reduction(+ : res)
+        for (size_t i = 0; i < dim; i++) {
+            int a = code1[i], b = code2[i];
+            res += (float) (a + b) * cross[i] + (float) (a * b) * step2[i];
+        }
+        return (1.0f - res);
+    }
+
+    static float
+    SQ8InnerProductQuery(const void *pVect1, const void *pVect2, const void *param_ptr) {
+        auto param = (const SQ8Param *) param_ptr;
+        auto query = (const float *) pVect1;
+        auto code = (const uint8_t *) pVect2;
+        const float *base = param->base;
+        const float *step = param->step;
+        size_t dim = param->dim;
+        float res = 0;
+#pragma omp simd reduction(+ : res)
+        for (size_t i = 0; i < dim; i++) {
+            res += query[i] * (base[i] + code[i] * step[i]);
+        }
+        return (1.0f - res);
+    }
+
+    // points are stored as one byte per dimension, a quarter of float, queries stay float
+    class SQ8Space : public SpaceInterface<float> {
+
+        DISTFUNC<float> fstdistfunc_;
+        DISTFUNC<float> fstqdistfunc_;
+        bool ip_;
+        std::vector<float> vmin_;
+        std::vector<float> vmax_;
+        std::vector<float> base_;
+        std::vector<float> step_;
+        std::vector<float> step2_;
+        std::vector<float> cross_;
+        SQ8Param param_;
+    public:
+        SQ8Space(size_t dim, bool ip, const float *vmin, const float *vmax)
+                : ip_(ip), vmin_(vmin, vmin + dim), vmax_(vmax, vmax + dim), base_(dim), step_(dim), step2_(dim),
+                  cross_(dim) {
+            param_.base2 = 0;
+            for (size_t i = 0; i < dim; i++) {
+                step_[i] = (vmax_[i] - vmin_[i]) / 255.0f;
+                base_[i] = vmin_[i] + 0.5f * step_[i];
+                step2_[i] = step_[i] * step_[i];
+                cross_[i] = base_[i] * step_[i];
+                param_.base2 += base_[i] * base_[i];
+            }
+            fstdistfunc_ = ip ? SQ8InnerProduct : SQ8L2Sqr;
+            fstqdistfunc_ = ip ? SQ8InnerProductQuery : SQ8L2SqrQuery;
+            param_.dim = dim;
+            param_.base = base_.data();
+            param_.step = step_.data();
+            param_.step2 = step2_.data();
+            param_.cross = cross_.data();
+        }
+
+        // range of every dimension over the training vectors
+        static void
+        train(const float *x, size_t n, size_t dim, std::vector<float> &vmin, std::vector<float> &vmax) {
+            vmin.assign(dim, 0);
+            vmax.assign(dim, 0);
+            if (n == 0) return;
+            std::copy(x, x + dim, vmin.begin());
+            std::copy(x, x + dim, vmax.begin());
+            for (size_t i = 1; i < n; i++) {
+                const float *v = x + i * dim;
+                for (size_t j = 0; j < dim; j++) {
+                    vmin[j] = std::min(vmin[j], v[j]);
+                    vmax[j] = std::max(vmax[j], v[j]);
+                }
+            }
+        }
+
+        void encode(const float *x, uint8_t *code) const {
+            for (size_t i = 0; i < param_.dim; i++) {
+                float diff = vmax_[i] - vmin_[i];
+                float xi = diff > 0 ? (x[i] - vmin_[i]) / diff : 0;
+                xi = std::min(std::max(xi, 0.0f), 1.0f);
+                code[i] = (uint8_t) std::min(255, (int) (xi * 255.0f));
+            }
+        }
+
+        bool is_ip() const {
+            return ip_;
+        }
+
+        const std::vector<float> &vmin() const {
+            return vmin_;
+        }
+
+        const std::vector<float> &vmax() const {
+            return vmax_;
+        }
+
+        size_t get_data_size() {
+            return param_.dim * sizeof(uint8_t);
+        }
+
+        DISTFUNC<float> get_dist_func() {
+            return fstdistfunc_;
+        }
+
+        DISTFUNC<float> get_query_dist_func() {
+            return fstqdistfunc_;
+        }
+
+        void *get_dist_func_param() {
+            return &param_;
+        }
+
+        ~SQ8Space() {}
+    };
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <mutex>
 #include <string.h>
 
@@ -39,6 +40,18 @@ namespace hnswlib {
         std::mutex poolguard;
         int numelements;
 
+        struct ThreadCache {
+            VisitedList *list = nullptr;
+            bool busy = false;
+
+            ~ThreadCache() { delete list; }
+        };
+
+        static ThreadCache &threadCache() {
+            thread_local ThreadCache cache;
+            return cache;
+        }
+
     public:
         VisitedListPool(int initmaxpools, int numelements1) {
             numelements = numelements1;
@@ -47,6 +60,19 @@ namespace hnswlib {
         }
 
         VisitedList *getFreeVisitedList() {
+            // visited marks are tagged by curV, so one list of enough size serves every index searched
+            // by this thread, and the common path takes no lock
+            ThreadCache &cache = threadCache();
+            if (!cache.busy) {
+                if (cache.list == nullptr || cache.list->numelements < (unsigned int)numelements) {
+                    delete cache.list;
+                    cache.list = new VisitedList(numelements);
+                }
+                cache.busy = true;
+                cache.list->reset();
+                return cache.list;
+            }
+
             VisitedList *rez;
             {
                 std::unique_lock <std::mutex> lock(poolguard);
@@ -62,6 +88,11 @@ namespace hnswlib {
         };
 
         void releaseVisitedList(VisitedList *vl) {
+            ThreadCache &cache = threadCache();
+            if (vl == cache.list) {
+                cache.busy = false;
+                return;
+            }
             std::unique_lock <std::mutex> lock(poolguard);
             pool.push_front(vl);
         };
@@ -0,0 +1,126 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <faiss/utils/distances.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t CACHED_FLOATS = 256 * 1024;  // 1 MB of vectors, scanned again and again from the cache
+constexpr size_t DISTANCES = 1000000;
+
+const std::vector<size_t> kDims = {64, 128, 256, 512, 768};
+
+std::vector<float>
+RandomVectors(size_t n, size_t dim) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> distrib(-1.0, 1.0);
+    std::vector<float> data(n * dim);
+    for (auto& v : data) {
+        v = distrib(rng);
+    }
+    return data;
+}
+
+// nanoseconds per distance of a scan over nb vectors
+double
+ScanCost(faiss::fvec_distance_t distance, const float* xq, const float* xb, size_t nb, size_t dim, float& sum) {
+    size_t rounds = DISTANCES / nb;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < nb; i++) {
+            sum += distance(xq, xb + i * dim, dim);
+        }
+    }
+    auto span = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return span / (rounds * nb);
+}
+
+}  // namespace
+
+TEST(DistanceKernelTest, same_as_generic) {
+    for (auto dim : kDims) {
+        auto xq = RandomVectors(1, dim);
+        auto xb = RandomVectors(100, dim);
+        auto L2sqr = faiss::fvec_L2sqr_kernel(dim);
+        auto inner_product = faiss::fvec_inner_product_kernel(dim);
+        for (size_t i = 0; i < 100; i++) {
+            const float* y = xb.data() + i * dim;
+            float l2 = faiss::fvec_L2sqr(xq.data(), y, dim);
+            float ip = faiss::fvec_inner_product(xq.data(), y, dim);
+            // the sums are added in another order
+            ASSERT_NEAR(L2sqr(xq.data(), y, dim), l2, 1e-4 * l2);
+            ASSERT_NEAR(inner_product(xq.data(), y, dim), ip, 1e-4 * (std::abs(ip) + 1));
+        }
+    }
+
+    // other dimensions keep the generic functions
+    ASSERT_EQ(faiss::fvec_L2sqr_kernel(100), &faiss::fvec_L2sqr);
+    ASSERT_EQ(faiss::fvec_inner_product_kernel(100), &faiss::fvec_inner_product);
+}
+
+TEST(DistanceKernelTest, benchmark) {
+    float sum = 0;
+    for (auto dim : kDims) {
+        size_t nb = CACHED_FLOATS / dim;
+        auto xq = RandomVectors(1, dim);
+        auto xb = RandomVectors(nb, dim);
+
+        double generic_l2 = ScanCost(faiss::fvec_L2sqr, xq.data(), xb.data(), nb, dim, sum);
+        double fixed_l2 = ScanCost(faiss::fvec_L2sqr_kernel(dim), xq.data(), xb.data(), nb, dim, sum);
+        double generic_ip = ScanCost(faiss::fvec_inner_product, xq.data(), xb.data(), nb, dim, sum);
+        double fixed_ip = ScanCost(faiss::fvec_inner_product_kernel(dim), xq.data(), xb.data(), nb, dim, sum);
+        std::cout << "dim " << dim << " L2 generic " << generic_l2 << " ns, kernel " << fixed_l2 << " ns; IP generic "
+                  << generic_ip << " ns, kernel " << fixed_ip << " ns" << std::endl;
+    }
+    ASSERT_FALSE(std::isnan(sum));
+}
+
+// the blocked SIMD scan finds the same neighbors as BLAS, for fewer queries than threads too
+TEST(DistanceKernelTest, blocked_scan_same_as_blas) {
+    size_t dim = 128, nb = 20000, k = 20;
+    auto xb = RandomVectors(nb, dim);
+    auto xq = RandomVectors(20, dim);
+    for (size_t nq : {1, 3, 20}) {
+        std::vector<float> scan_dis(nq * k), blas_dis(nq * k);
+        std::vector<int64_t> scan_ids(nq * k), blas_ids(nq * k);
+        faiss::float_maxheap_array_t scan_res = {nq, k, scan_ids.data(), scan_dis.data()};
+        faiss::float_maxheap_array_t blas_res = {nq, k, blas_ids.data(), blas_dis.data()};
+        faiss::knn_L2sqr_with(false, xq.data(), xb.data(), dim, nq, nb, &scan_res);
+        faiss::knn_L2sqr_with(true, xq.data(), xb.data(), dim, nq, nb, &blas_res);
+        for (size_t i = 0; i < nq * k; i++) {
+            ASSERT_NEAR(scan_dis[i], blas_dis[i], 1e-3 * blas_dis[i]);
+        }
+    }
+}
+
+TEST(DistanceKernelTest, blocked_scan_benchmark) {
+    size_t dim = 128, nb = 200000, k = 50;
+    auto xb = RandomVectors(nb, dim);
+    auto xq = RandomVectors(64, dim);
+    for (size_t nq : {1, 8, 64}) {
+        std::vector<float> dis(nq * k);
+        std::vector<int64_t> ids(nq * k);
+        faiss::float_maxheap_array_t res = {nq, k, ids.data(), dis.data()};
+        auto start = std::chrono::steady_clock::now();
+        faiss::knn_L2sqr_with(false, xq.data(), xb.data(), dim, nq, nb, &res);
+        auto span = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "nq " << nq << " nb " << nb << " dim " << dim << " scan " << span << " ms" << std::endl;
+        ASSERT_GE(ids[0], 0);
+    }
+}
@@ -11,6 +11,14 @@
 
 #include <gtest/gtest.h>
 
+#include <faiss/utils/hamming.h>
+#include <faiss/utils/jaccard.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 
@@ -111,3 +119,63 @@ TEST_P(BinaryIDMAPTest, binaryidmap_serialize) {
         //        PrintResult(result, nq, k);
     }
 }
+
+namespace {
+
+template <typename Computer>
+double
+ScanHamming(const uint8_t* query, const uint8_t* base, int64_t code_size, int64_t n, std::vector<int>& dist) {
+    auto start = std::chrono::steady_clock::now();
+    Computer computer(query, code_size);
+    for (int64_t i = 0; i < n; i++) {
+        dist[i] = computer.hamming(base + i * code_size);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Computer>
+double
+ScanJaccard(const uint8_t* query, const uint8_t* base, int64_t code_size, int64_t n, std::vector<float>& dist) {
+    auto start = std::chrono::steady_clock::now();
+    Computer computer(query, code_size);
+    for (int64_t i = 0; i < n; i++) {
+        dist[i] = computer.jaccard(base + i * code_size);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename HammingKernel, typename JaccardKernel>
+void
+CompareBinaryKernels(const std::vector<uint8_t>& base, const std::vector<uint8_t>& query, int64_t code_size,
+                     int64_t n) {
+    std::vector<int> ham(n), ham_ref(n);
+    std::vector<float> jac(n), jac_ref(n);
+    auto ham_time = ScanHamming<HammingKernel>(query.data(), base.data(), code_size, n, ham);
+    auto ham_ref_time = ScanHamming<faiss::HammingComputerDefault>(query.data(), base.data(), code_size, n, ham_ref);
+    auto jac_time = ScanJaccard<JaccardKernel>(query.data(), base.data(), code_size, n, jac);
+    auto jac_ref_time = ScanJaccard<faiss::JaccardComputerDefault>(query.data(), base.data(), code_size, n, jac_ref);
+    EXPECT_EQ(ham, ham_ref);
+    EXPECT_EQ(jac, jac_ref);
+
+    std::cout << code_size * 8 << " bits: hamming " << ham_time << " ms (generic " << ham_ref_time << " ms), jaccard "
+              << jac_time << " ms (generic " << jac_ref_time << " ms)" << std::endl;
+}
+
+}  // namespace
+
+TEST(BinaryKernelTest, specialized_code_size) {
+    const int64_t n = 100000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t> base(n * 128), query(128);
+    for (auto& b : base) {
+        b = byte(rng);
+    }
+    for (auto& b : query) {
+        b = byte(rng);
+    }
+
+    CompareBinaryKernels<faiss::HammingComputer32, faiss::JaccardComputer32>(base, query, 32, n);
+    CompareBinaryKernels<faiss::HammingComputer64, faiss::JaccardComputer64>(base, query, 64, n);
+    CompareBinaryKernels<faiss::HammingComputer128, faiss::JaccardComputer128>(base, query, 128, n);
+}
@@ -131,6 +131,43 @@ TEST_F(SingleIndexTest, IVFSQHybrid) {
             hybrid_idx->UnsetQuantizer();
         }
     }
+
+    {
+        // lists assigned in a quantizer on gpu, scanned by the index left on cpu
+        auto cpu_idx = std::make_shared<knowhere::IVFSQHybrid>(DEVICEID);
+        cpu_idx->Load(binaryset);
+
+        auto quantizer_conf = std::make_shared<knowhere::QuantizerCfg>();
+        quantizer_conf->mode = 1;
+        quantizer_conf->gpu_id = DEVICEID;
+        auto quantization = cpu_idx->LoadQuantizer(quantizer_conf);
+
+        auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf);
+        ASSERT_NE(ivf_conf, nullptr);
+        auto coarse = cpu_idx->CoarseAssign(quantization, query_dataset, conf);
+        ASSERT_NE(coarse, nullptr);
+        ASSERT_EQ(coarse->keys.size(), (size_t)(nq * ivf_conf->nprobe));
+
+        ivf_conf->coarse = coarse;
+        auto result = cpu_idx->Search(query_dataset, conf);
+        ivf_conf->coarse = nullptr;
+        AssertAnns(result, nq, conf->k);
+    }
+
+    {
+        // indexes built from the same model share the quantizer fingerprint
+        auto shared_idx = std::make_shared<knowhere::IVFSQHybrid>(DEVICEID);
+        shared_idx->set_index_model(model);
+        shared_idx->Add(base_dataset, conf);
+        auto shared_binaryset = shared_idx->CopyGpuToCpu(conf)->Serialize();
+
+        auto cpu_idx = std::make_shared<knowhere::IVFSQHybrid>(DEVICEID);
+        cpu_idx->Load(binaryset);
+        auto shared_cpu_idx = std::make_shared<knowhere::IVFSQHybrid>(DEVICEID);
+        shared_cpu_idx->Load(shared_binaryset);
+        ASSERT_NE(cpu_idx->QuantizerFingerprint(), 0);
+        ASSERT_EQ(cpu_idx->QuantizerFingerprint(), shared_cpu_idx->QuantizerFingerprint());
+    }
 }
 
 // TEST_F(SingleIndexTest, thread_safe) {
@@ -0,0 +1,176 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <faiss/utils/distances.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "knowhere/adapter/VectorAdapter.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexDiskANN.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
+#include "unittest/utils.h"
+
+class DiskANNTest : public DataGen, public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        Generate(64, 5000, 100);
+        index_ = std::make_shared<knowhere::IndexDiskANN>();
+
+        conf_ = std::make_shared<knowhere::DiskANNCfg>();
+        conf_->d = dim;
+        conf_->k = k;
+        conf_->metric_type = knowhere::METRICTYPE::L2;
+        conf_->max_degree = 32;
+        conf_->build_list = 64;
+        conf_->search_list = 64;
+        conf_->pq_m = 16;
+        conf_->disk_path = "/tmp/diskann_test_" + std::to_string(getpid()) + ".disk";
+    }
+
+    void
+    TearDown() override {
+        unlink(conf_->disk_path.c_str());
+    }
+
+    // share of the exact topk found by the search, queries are the base vectors moved a little
+    double
+    Recall(const knowhere::VectorIndexPtr& index) {
+        std::mt19937 rng(7);
+        std::normal_distribution<float> noise(0, 0.01);
+        std::vector<float> queries(xq);
+        for (auto& v : queries) {
+            v += noise(rng);
+        }
+        auto result = index->Search(generate_query_dataset(nq, dim, queries.data()), conf_);
+        auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+
+        int64_t hit = 0;
+        for (int64_t i = 0; i < nq; i++) {
+            std::vector<std::pair<float, int64_t>> exact(nb);
+            for (int64_t j = 0; j < nb; j++) {
+                exact[j] = {faiss::fvec_L2sqr(queries.data() + i * dim, xb.data() + j * dim, dim), ids[j]};
+            }
+            std::partial_sort(exact.begin(), exact.begin() + k, exact.end());
+            for (int64_t j = 0; j < k; j++) {
+                auto begin = result_ids + i * k;
+                hit += std::count(begin, begin + k, exact[j].second);
+            }
+        }
+        return static_cast<double>(hit) / (nq * k);
+    }
+
+ protected:
+    std::shared_ptr<knowhere::IndexDiskANN> index_;
+    knowhere::DiskANNConfig conf_;
+};
+
+TEST_F(DiskANNTest, diskann_basic) {
+    // null index
+    {
+        ASSERT_ANY_THROW(index_->Serialize());
+        ASSERT_ANY_THROW(index_->Search(query_dataset, conf_));
+        ASSERT_ANY_THROW(index_->Add(base_dataset, conf_));
+        ASSERT_ANY_THROW(index_->Count());
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->Add(base_dataset, conf_);
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dimension(), dim);
+    ASSERT_ANY_THROW(index_->Add(base_dataset, conf_));
+
+    ASSERT_GT(Recall(index_), 0.95);
+}
+
+TEST_F(DiskANNTest, diskann_serialize) {
+    index_->Train(base_dataset, conf_);
+    index_->Add(base_dataset, conf_);
+    auto result = index_->Search(query_dataset, conf_);
+
+    // the loaded index reads the same disk file
+    auto binaryset = index_->Serialize();
+    auto new_index = std::make_shared<knowhere::IndexDiskANN>();
+    new_index->Load(binaryset);
+    EXPECT_EQ(new_index->Count(), nb);
+    EXPECT_EQ(new_index->Dimension(), dim);
+    auto new_result = new_index->Search(query_dataset, conf_);
+
+    auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    auto new_ids = new_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; i++) {
+        ASSERT_EQ(ids[i], new_ids[i]);
+    }
+
+    // a disk file moved along with the index file is found by the path the loader gives
+    std::string moved_path = conf_->disk_path + ".moved";
+    ASSERT_EQ(rename(conf_->disk_path.c_str(), moved_path.c_str()), 0);
+    auto moved_binaryset = binaryset;
+    std::shared_ptr<uint8_t> path_data(new uint8_t[moved_path.size()], std::default_delete<uint8_t[]>());
+    memcpy(path_data.get(), moved_path.data(), moved_path.size());
+    moved_binaryset.Append(knowhere::IndexDiskANN::DISK_PATH_BINARY_NAME, path_data, moved_path.size());
+    auto moved_index = std::make_shared<knowhere::IndexDiskANN>();
+    moved_index->Load(moved_binaryset);
+    EXPECT_EQ(moved_index->Count(), nb);
+    moved_index = nullptr;
+    ASSERT_EQ(rename(moved_path.c_str(), conf_->disk_path.c_str()), 0);
+
+    // an incomplete index fails the load
+    auto broken_binaryset = binaryset;
+    broken_binaryset.binary_map_.erase("DISKANN_PQ");
+    auto broken_index = std::make_shared<knowhere::IndexDiskANN>();
+    ASSERT_ANY_THROW(broken_index->Load(broken_binaryset));
+
+    // a missing disk file fails the load
+    unlink(conf_->disk_path.c_str());
+    auto lost_index = std::make_shared<knowhere::IndexDiskANN>();
+    ASSERT_ANY_THROW(lost_index->Load(binaryset));
+}
+
+TEST_F(DiskANNTest, diskann_filter) {
+    index_->Train(base_dataset, conf_);
+    index_->Add(base_dataset, conf_);
+
+    // queries are base vectors, filtered out they can't be their own nearest
+    std::vector<int64_t> blacklist(ids.begin(), ids.begin() + nq);
+    auto search_conf = std::make_shared<knowhere::DiskANNCfg>(*conf_);
+    search_conf->filter = std::make_shared<knowhere::IDFilter>(blacklist, true);
+    auto result = index_->Search(query_dataset, search_conf);
+    auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; i++) {
+        ASSERT_TRUE(result_ids[i] >= nq || result_ids[i] == -1);
+    }
+}
+
+TEST_F(DiskANNTest, diskann_invalid) {
+    auto ip_conf = std::make_shared<knowhere::DiskANNCfg>(*conf_);
+    ip_conf->metric_type = knowhere::METRICTYPE::IP;
+    ASSERT_ANY_THROW(index_->Train(base_dataset, ip_conf));
+
+    auto bad_m = std::make_shared<knowhere::DiskANNCfg>(*conf_);
+    bad_m->pq_m = 7;
+    ASSERT_ANY_THROW(index_->Train(base_dataset, bad_m));
+
+    auto no_path = std::make_shared<knowhere::DiskANNCfg>(*conf_);
+    no_path->disk_path.clear();
+    ASSERT_ANY_THROW(index_->Train(base_dataset, no_path));
+}
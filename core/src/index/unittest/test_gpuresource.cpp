@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <iostream>
 #include <thread>
 
@@ -181,6 +182,31 @@ TEST_F(GPURESTEST, trainandsearch) {
     }
 }
 
+TEST_F(GPURESTEST, resource_num) {
+    ASSERT_EQ(knowhere::FaissGpuResourceMgr::GetInstance().GetResNum(DEVICEID), RESNUM);
+    ASSERT_EQ(knowhere::FaissGpuResourceMgr::GetInstance().GetResNum(DEVICEID + 100), 0);
+
+    // a device is added once, the resource number it got first stays
+    knowhere::FaissGpuResourceMgr::GetInstance().InitDevice(DEVICEID, PINMEM, TEMPMEM, RESNUM + 1);
+    ASSERT_EQ(knowhere::FaissGpuResourceMgr::GetInstance().GetResNum(DEVICEID), RESNUM);
+}
+
+TEST_F(GPURESTEST, pinned_host) {
+    auto& gpu_res_mgr = knowhere::FaissGpuResourceMgr::GetInstance();
+    auto buffer = gpu_res_mgr.AllocPinnedHost(nq * dim * sizeof(float));
+    ASSERT_NE(buffer, nullptr);
+    memcpy(buffer.get(), xq.data(), nq * dim * sizeof(float));
+    ASSERT_EQ(memcmp(buffer.get(), xq.data(), nq * dim * sizeof(float)), 0);
+
+    // a released buffer is handed out again for a size of the same bucket
+    auto data = buffer.get();
+    buffer.reset();
+    auto reused = gpu_res_mgr.AllocPinnedHost(nq * dim * sizeof(float) - 1);
+    ASSERT_EQ(reused.get(), data);
+    auto other = gpu_res_mgr.AllocPinnedHost(nq * dim * sizeof(float));
+    ASSERT_NE(other.get(), data);
+}
+
 #ifdef CompareToOriFaiss
 TEST_F(GPURESTEST, gpu_ivf_resource_test) {
     assert(!xb.empty());
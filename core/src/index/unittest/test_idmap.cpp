@@ -12,10 +12,13 @@
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <iostream>
 
+#include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/IndexGPUIDMAP.h"
 #include "knowhere/index/vector_index/helpers/Cloner.h"
@@ -121,6 +124,141 @@ TEST_F(IDMAPTest, idmap_serialize) {
     }
 }
 
+TEST_F(IDMAPTest, idmap_range_search) {
+    auto conf = std::make_shared<knowhere::Cfg>();
+    conf->d = dim;
+    conf->k = k;
+    conf->metric_type = knowhere::METRICTYPE::L2;
+
+    ASSERT_ANY_THROW(index_->RangeSearch(query_dataset, 1.0, conf));
+
+    index_->Train(conf);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    auto dists = result->Get<float*>(knowhere::meta::DISTANCE);
+
+    // a tiny radius only hits the query itself
+    {
+        auto range_result = index_->RangeSearch(query_dataset, 1e-6, conf);
+        AssertAnns(range_result, nq, k);
+        auto range_ids = range_result->Get<int64_t*>(knowhere::meta::IDS);
+        for (auto i = 0; i < nq; i++) {
+            for (auto j = 1; j < k; j++) {
+                ASSERT_EQ(range_ids[i * k + j], -1);
+            }
+        }
+    }
+
+    // a radius covering top-k returns sorted top-k
+    {
+        float radius = 0;
+        for (auto i = 0; i < nq; i++) {
+            radius = std::max(radius, dists[i * k + k - 1]);
+        }
+        auto range_result = index_->RangeSearch(query_dataset, radius * 2 + 1, conf);
+        auto range_dists = range_result->Get<float*>(knowhere::meta::DISTANCE);
+        for (auto i = 0; i < nq * k; i++) {
+            ASSERT_FLOAT_EQ(range_dists[i], dists[i]);
+        }
+        AssertAnns(range_result, nq, k);
+    }
+}
+
+TEST_F(IDMAPTest, idmap_filtered_search) {
+    auto conf = std::make_shared<knowhere::Cfg>();
+    conf->d = dim;
+    conf->k = k;
+    conf->metric_type = knowhere::METRICTYPE::L2;
+
+    index_->Train(conf);
+    index_->Add(base_dataset, conf);
+
+    // queries are the first nq base vectors, exclude them from the result
+    {
+        std::vector<int64_t> excluded(ids.begin(), ids.begin() + nq);
+        conf->filter = std::make_shared<knowhere::IDFilter>(excluded, true);
+        auto result = index_->Search(query_dataset, conf);
+        auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        auto result_dists = result->Get<float*>(knowhere::meta::DISTANCE);
+        for (auto i = 0; i < nq; i++) {
+            for (auto j = 0; j < k; j++) {
+                ASSERT_GE(result_ids[i * k + j], nq);
+                if (j > 0) {
+                    ASSERT_LE(result_dists[i * k + j - 1], result_dists[i * k + j]);
+                }
+            }
+        }
+    }
+
+    // only one id is searched
+    {
+        std::vector<int64_t> accepted = {ids[nb / 2]};
+        conf->filter = std::make_shared<knowhere::IDFilter>(accepted, false);
+        auto result = index_->Search(query_dataset, conf);
+        auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        for (auto i = 0; i < nq; i++) {
+            ASSERT_EQ(result_ids[i * k], ids[nb / 2]);
+            for (auto j = 1; j < k; j++) {
+                ASSERT_EQ(result_ids[i * k + j], -1);
+            }
+        }
+    }
+
+    // whitelist covering all the ids is the same as an unfiltered search
+    {
+        conf->filter = std::make_shared<knowhere::IDFilter>(ids, false);
+        auto filtered = index_->Search(query_dataset, conf);
+        conf->filter = nullptr;
+        auto result = index_->Search(query_dataset, conf);
+        auto filtered_ids = filtered->Get<int64_t*>(knowhere::meta::IDS);
+        auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        for (auto i = 0; i < nq * k; i++) {
+            ASSERT_EQ(filtered_ids[i], result_ids[i]);
+        }
+    }
+}
+
+TEST_F(IDMAPTest, idmap_row_range_search) {
+    auto conf = std::make_shared<knowhere::Cfg>();
+    conf->d = dim;
+    conf->k = k;
+    conf->metric_type = knowhere::METRICTYPE::L2;
+
+    index_->Train(conf);
+    index_->Add(base_dataset, conf);
+
+    // queries are the first nq base vectors, the second half of the rows doesn't hold them
+    conf->row_begin = nb / 2;
+    conf->row_end = nb;
+    auto result = index_->Search(query_dataset, conf);
+    auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    auto result_dists = result->Get<float*>(knowhere::meta::DISTANCE);
+    for (auto i = 0; i < nq * k; i++) {
+        ASSERT_GE(result_ids[i], ids[nb / 2]);
+        if (i % k > 0) {
+            ASSERT_LE(result_dists[i - 1], result_dists[i]);
+        }
+    }
+
+    // the first half finds each query itself, as a search of all rows does
+    conf->row_begin = 0;
+    conf->row_end = nb / 2;
+    result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    // with a filter the range still holds
+    std::vector<int64_t> excluded(ids.begin(), ids.begin() + nq);
+    conf->filter = std::make_shared<knowhere::IDFilter>(excluded, true);
+    result = index_->Search(query_dataset, conf);
+    result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; i++) {
+        ASSERT_GE(result_ids[i], nq);
+        ASSERT_LT(result_ids[i], ids[nb / 2]);
+    }
+    conf->filter = nullptr;
+    conf->row_end = -1;
+}
+
 #ifdef MILVUS_GPU_VERSION
 TEST_F(IDMAPTest, copy_test) {
     ASSERT_TRUE(!xb.empty());
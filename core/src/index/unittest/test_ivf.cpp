@@ -14,11 +14,16 @@
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <iostream>
+#include <limits>
 #include <thread>
 
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFPQFastScan.h>
+
 #ifdef MILVUS_GPU_VERSION
 
 #include <faiss/gpu/GpuIndexIVFFlat.h>
+#include <faiss/gpu/utils/DeviceUtils.h>
 
 #endif
 
@@ -29,10 +34,12 @@
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
 
 #ifdef MILVUS_GPU_VERSION
 
 #include "knowhere/index/vector_index/IndexGPUIVF.h"
+#include "knowhere/index/vector_index/IndexGPUIVFShards.h"
 #include "knowhere/index/vector_index/IndexGPUIVFPQ.h"
 #include "knowhere/index/vector_index/IndexGPUIVFSQ.h"
 #include "knowhere/index/vector_index/IndexIVFSQHybrid.h"
@@ -90,7 +97,8 @@ INSTANTIATE_TEST_CASE_P(IVFParameters, IVFTest,
 #endif
 #endif
                             std::make_tuple("IVF", ParameterType::ivf), std::make_tuple("IVFPQ", ParameterType::ivfpq),
-                            std::make_tuple("IVFSQ", ParameterType::ivfsq)));
+                            std::make_tuple("IVFSQ", ParameterType::ivfsq),
+                            std::make_tuple("IVFPQFastScan", ParameterType::ivfpq4)));
 
 TEST_P(IVFTest, ivf_basic) {
     assert(!xb.empty());
@@ -117,6 +125,177 @@ TEST_P(IVFTest, ivf_basic) {
 #endif
 }
 
+TEST_P(IVFTest, ivf_sampled_train) {
+    auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf);
+    ASSERT_TRUE(ivf_conf != nullptr);
+    ivf_conf->train_size = nb / 2;
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    EXPECT_EQ(index_->Count(), nb);
+
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, conf->k);
+}
+
+TEST_P(IVFTest, ivf_range_search) {
+    if (index_type.find("GPU") != std::string::npos || index_type == "IVFSQHybrid") {
+        return;
+    }
+
+    ASSERT_ANY_THROW(index_->RangeSearch(query_dataset, 1.0, conf));
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    auto dists = result->Get<float*>(knowhere::meta::DISTANCE);
+
+    // every candidate is in range, range search degrades to top-k search
+    auto range_result = index_->RangeSearch(query_dataset, std::numeric_limits<float>::max(), conf);
+    AssertAnns(range_result, nq, conf->k);
+    auto range_dists = range_result->Get<float*>(knowhere::meta::DISTANCE);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_FLOAT_EQ(range_dists[i], dists[i]);
+    }
+}
+
+TEST_P(IVFTest, ivf_filtered_search) {
+    if (index_type.find("GPU") != std::string::npos || index_type == "IVFSQHybrid") {
+        return;
+    }
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+
+    // queries are the first nq base vectors, exclude them from the result
+    std::vector<int64_t> excluded(ids.begin(), ids.begin() + nq);
+    conf->filter = std::make_shared<knowhere::IDFilter>(excluded, true);
+    auto result = index_->Search(query_dataset, conf);
+    auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_TRUE(result_ids[i] >= nq || result_ids[i] == -1);
+    }
+
+    // only the odd ids are searched
+    std::vector<int64_t> accepted;
+    for (auto id : ids) {
+        if (id % 2 == 1) {
+            accepted.push_back(id);
+        }
+    }
+    conf->filter = std::make_shared<knowhere::IDFilter>(accepted, false);
+    result = index_->Search(query_dataset, conf);
+    result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_TRUE(result_ids[i] % 2 == 1 || result_ids[i] == -1);
+    }
+    for (auto i = 0; i < nq; i++) {
+        ASSERT_NE(result_ids[i * conf->k], -1);
+    }
+    conf->filter = nullptr;
+}
+
+TEST_P(IVFTest, ivf_coarse_assignment) {
+    if (index_type.find("GPU") != std::string::npos || index_type == "IVFSQHybrid") {
+        return;
+    }
+
+    // two indexes built from one model, each holds half of the vectors
+    auto model = index_->Train(base_dataset, conf);
+    auto half = nb / 2;
+    index_->set_index_model(model);
+    index_->Add(generate_dataset(half, dim, xb.data(), ids.data()), conf);
+    auto other = IndexFactory(index_type);
+    other->set_index_model(model);
+    other->Add(generate_dataset(nb - half, dim, xb.data() + half * dim, ids.data() + half), conf);
+    ASSERT_NE(index_->QuantizerFingerprint(), 0);
+    ASSERT_EQ(index_->QuantizerFingerprint(), other->QuantizerFingerprint());
+
+    auto result = other->Search(query_dataset, conf);
+    auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    auto result_dists = result->Get<float*>(knowhere::meta::DISTANCE);
+
+    // lists found by the quantizer of the first index give the results of the second one
+    auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf);
+    ivf_conf->coarse = index_->CoarseAssign(query_dataset, conf);
+    ASSERT_NE(ivf_conf->coarse, nullptr);
+    ASSERT_EQ(ivf_conf->coarse->keys.size(), nq * ivf_conf->nprobe);
+    // the scalar quantizer by residual gets the queries encoded against each centroid as well
+    if (index_type == "IVFSQ") {
+        ASSERT_EQ(ivf_conf->coarse->residuals.size(), nq * ivf_conf->nprobe * dim);
+    } else {
+        ASSERT_TRUE(ivf_conf->coarse->residuals.empty());
+    }
+    auto coarse_result = other->Search(query_dataset, conf);
+    auto coarse_ids = coarse_result->Get<int64_t*>(knowhere::meta::IDS);
+    auto coarse_dists = coarse_result->Get<float*>(knowhere::meta::DISTANCE);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_EQ(coarse_ids[i], result_ids[i]);
+        ASSERT_FLOAT_EQ(coarse_dists[i], result_dists[i]);
+    }
+    ivf_conf->coarse = nullptr;
+}
+
+TEST_P(IVFTest, ivf_single_query) {
+    if (index_type.find("GPU") != std::string::npos || index_type == "IVFSQHybrid") {
+        return;
+    }
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    auto result_dists = result->Get<float*>(knowhere::meta::DISTANCE);
+
+    // a single query scans its lists in parallel, it finds what the batch finds for it
+    for (auto i = 0; i < nq; i++) {
+        auto single = index_->Search(generate_query_dataset(1, dim, xq.data() + i * dim), conf);
+        auto single_ids = single->Get<int64_t*>(knowhere::meta::IDS);
+        auto single_dists = single->Get<float*>(knowhere::meta::DISTANCE);
+        for (auto j = 0; j < conf->k; j++) {
+            ASSERT_FLOAT_EQ(single_dists[j], result_dists[i * conf->k + j]);
+            if (j == 0) {
+                ASSERT_EQ(single_ids[j], result_ids[i * conf->k + j]);
+            }
+        }
+    }
+}
+
+TEST_P(IVFTest, ivf_merge) {
+    if (index_type.find("GPU") != std::string::npos || index_type == "IVFSQHybrid") {
+        return;
+    }
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+
+    // halves added to indexes of one model, merged in order, hold the same lists as the whole
+    auto half = nb / 2;
+    auto first = IndexFactory(index_type);
+    first->set_index_model(model);
+    first->Add(generate_dataset(half, dim, xb.data(), ids.data()), conf);
+    auto second = IndexFactory(index_type);
+    second->set_index_model(model);
+    second->Add(generate_dataset(nb - half, dim, xb.data() + half * dim, ids.data() + half), conf);
+    first->Merge(second);
+    ASSERT_EQ(first->Count(), nb);
+    ASSERT_EQ(second->Count(), 0);
+    ASSERT_ANY_THROW(first->Merge(first));
+
+    auto merged_result = first->Search(query_dataset, conf);
+    auto merged_ids = merged_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_EQ(merged_ids[i], result_ids[i]);
+    }
+}
+
 TEST_P(IVFTest, ivf_serialize) {
     fiu_init(0);
     auto serialize = [](const std::string& filename, knowhere::BinaryPtr& bin, uint8_t* ret) {
@@ -186,6 +365,146 @@ TEST_P(IVFTest, ivf_serialize) {
     }
 }
 
+TEST_P(IVFTest, ivf_rotation) {
+    if (index_type != "IVFPQ" && index_type != "IVFSQ") {
+        return;
+    }
+
+    auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf);
+    ASSERT_TRUE(ivf_conf != nullptr);
+    ivf_conf->rotation = index_type == "IVFPQ" ? knowhere::ROTATIONTYPE::OPQ : knowhere::ROTATIONTYPE::PCA;
+    ivf_conf->train_size = nb / 4;  // OPQ training is slow
+
+    auto preprocessor = index_->BuildPreprocessor(base_dataset, conf);
+    ASSERT_TRUE(preprocessor != nullptr);
+    index_->set_preprocessor(preprocessor);
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    EXPECT_EQ(index_->Count(), nb);
+
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, conf->k);
+    auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    auto dists = result->Get<float*>(knowhere::meta::DISTANCE);
+
+    // the rotation is part of the index binary
+    auto binaryset = index_->Serialize();
+    ASSERT_NE(binaryset.binary_map_.count("ROTATION"), 0);
+    auto loaded = IndexFactory(index_type);
+    loaded->Load(binaryset);
+    auto loaded_result = loaded->Search(query_dataset, conf);
+    auto loaded_ids = loaded_result->Get<int64_t*>(knowhere::meta::IDS);
+    auto loaded_dists = loaded_result->Get<float*>(knowhere::meta::DISTANCE);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_EQ(loaded_ids[i], ids[i]);
+        ASSERT_FLOAT_EQ(loaded_dists[i], dists[i]);
+    }
+
+    // an index built from the shared model rotates its vectors the same way
+    auto shared = IndexFactory(index_type);
+    shared->set_index_model(model);
+    shared->Add(base_dataset, conf);
+    auto shared_result = shared->Search(query_dataset, conf);
+    auto shared_ids = shared_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_EQ(shared_ids[i], ids[i]);
+    }
+
+#ifdef MILVUS_GPU_VERSION
+    ASSERT_ANY_THROW(index_->CopyCpuToGpu(DEVICEID, conf));
+#endif
+}
+
+TEST_P(IVFTest, ivf_load_in_place) {
+    if (index_type.find("GPU") != std::string::npos || index_type == "IVFSQHybrid") {
+        return;
+    }
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    auto ids_p = result->Get<int64_t*>(knowhere::meta::IDS);
+
+    // the codes may be used in place, the loaded index keeps them after the set is released
+    auto binaryset = index_->Serialize();
+    auto loaded = IndexFactory(index_type);
+    loaded->Load(binaryset);
+    binaryset.clear();
+    index_.reset();
+    auto loaded_result = loaded->Search(query_dataset, conf);
+    auto loaded_ids_p = loaded_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_EQ(loaded_ids_p[i], ids_p[i]);
+    }
+
+    // lists using borrowed codes are written out as well
+    auto reloaded = IndexFactory(index_type);
+    reloaded->Load(loaded->Serialize());
+    loaded.reset();
+    auto reloaded_result = reloaded->Search(query_dataset, conf);
+    auto reloaded_ids_p = reloaded_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_EQ(reloaded_ids_p[i], ids_p[i]);
+    }
+}
+
+TEST_P(IVFTest, ivfpq_fastscan) {
+    if (index_type != "IVFPQFastScan") {
+        return;
+    }
+
+    for (auto metric : {faiss::METRIC_L2, faiss::METRIC_INNER_PRODUCT}) {
+        faiss::IndexFlat quantizer(dim, metric);
+        faiss::IndexIVFPQFastScan index(&quantizer, dim, 100, 32);
+        index.metric_type = metric;
+        index.nprobe = 8;
+        index.train(nb, xb.data());
+        // the lists packed by the first add are packed again by the second one
+        index.add_with_ids(nb / 2, xb.data(), ids.data());
+        index.add_with_ids(nb - nb / 2, xb.data() + nb / 2 * dim, ids.data() + nb / 2);
+        ASSERT_EQ(index.ntotal, nb);
+
+        std::vector<float> dis(nq * k), ref_dis(nq * k);
+        std::vector<int64_t> labels(nq * k), ref_labels(nq * k);
+        index.search(nq, xq.data(), k, dis.data(), labels.data());
+        for (auto i = 0; metric == faiss::METRIC_L2 && i < nq; i++) {
+            ASSERT_EQ(labels[i * k], ids[i]);
+        }
+
+        // lists which aren't packed are scanned with the float tables
+        index.packed_sizes.assign(index.nlist, 0);
+        index.search(nq, xq.data(), k, ref_dis.data(), ref_labels.data());
+        for (auto i = 0; i < nq * k; i++) {
+            ASSERT_EQ(labels[i], ref_labels[i]);
+            ASSERT_FLOAT_EQ(dis[i], ref_dis[i]);
+        }
+    }
+
+    faiss::IndexFlatL2 quantizer(dim);
+    ASSERT_ANY_THROW(faiss::IndexIVFPQFastScan(&quantizer, dim, 100, 1));
+
+    // the codes are packed again when the index is loaded
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, conf->k);
+
+    auto binaryset = index_->Serialize();
+    auto loaded = IndexFactory(index_type);
+    loaded->Load(binaryset);
+    EXPECT_EQ(loaded->Count(), nb);
+    auto loaded_result = loaded->Search(query_dataset, conf);
+    auto ids_p = result->Get<int64_t*>(knowhere::meta::IDS);
+    auto loaded_ids_p = loaded_result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * conf->k; i++) {
+        ASSERT_EQ(loaded_ids_p[i], ids_p[i]);
+    }
+    ASSERT_ANY_THROW(index_->CopyCpuToGpu(DEVICEID, conf));
+}
+
 // TODO(linxj): deprecated
 #ifdef MILVUS_GPU_VERSION
 TEST_P(IVFTest, clone_test) {
@@ -199,6 +518,9 @@ TEST_P(IVFTest, clone_test) {
     index_->Add(base_dataset, conf);
     EXPECT_EQ(index_->Count(), nb);
     EXPECT_EQ(index_->Dimension(), dim);
+    // lists are counted wherever the index lives
+    int64_t nlist = index_->Nlist();
+    EXPECT_GT(nlist, 0);
     auto result = index_->Search(query_dataset, conf);
     AssertAnns(result, nq, conf->k);
     // PrintResult(result, nq, k);
@@ -268,6 +590,7 @@ TEST_P(IVFTest, clone_test) {
                 auto clone_index = knowhere::cloner::CopyCpuToGpu(index_, DEVICEID, knowhere::Config());
                 auto clone_result = clone_index->Search(query_dataset, conf);
                 AssertEqual(result, clone_result);
+                EXPECT_EQ(std::static_pointer_cast<knowhere::IVF>(clone_index)->Nlist(), nlist);
                 std::cout << "clone C <=> G [" << index_type << "] success" << std::endl;
             });
             EXPECT_ANY_THROW(knowhere::cloner::CopyCpuToGpu(index_, -1, knowhere::Config()));
@@ -282,6 +605,47 @@ TEST_P(IVFTest, clone_test) {
     }
 }
 
+TEST_P(IVFTest, shards_test) {
+    assert(!xb.empty());
+
+    auto preprocessor = index_->BuildPreprocessor(base_dataset, conf);
+    index_->set_preprocessor(preprocessor);
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+
+    // indexes on gpu can't be sharded, neither can an index on one device
+    std::vector<std::string> support_idx_vec{"IVF", "IVFSQ", "IVFPQ"};
+    auto finder = std::find(support_idx_vec.cbegin(), support_idx_vec.cend(), index_type);
+    if (finder == support_idx_vec.cend()) {
+        EXPECT_ANY_THROW(knowhere::cloner::CopyCpuToGpuShards(index_, {DEVICEID, DEVICEID + 1}, knowhere::Config()));
+        return;
+    }
+    EXPECT_ANY_THROW(knowhere::cloner::CopyCpuToGpuShards(index_, {DEVICEID, DEVICEID}, knowhere::Config()));
+    if (faiss::gpu::getNumDevices() < 2) {
+        return;
+    }
+
+    knowhere::FaissGpuResourceMgr::GetInstance().InitDevice(DEVICEID + 1, PINMEM, TEMPMEM, RESNUM);
+    auto shards = knowhere::cloner::CopyCpuToGpuShards(index_, {DEVICEID + 1, DEVICEID}, knowhere::Config());
+    auto shards_index = std::dynamic_pointer_cast<knowhere::GPUIVFShards>(shards);
+    ASSERT_NE(shards_index, nullptr);
+    ASSERT_EQ(shards_index->GetGpuDevices().size(), 2);
+    ASSERT_EQ(shards_index->GetGpuDevices()[0], DEVICEID);
+    EXPECT_EQ(shards->Count(), nb);
+    EXPECT_EQ(shards_index->Nlist(), index_->Nlist());
+
+    auto result = shards->Search(query_dataset, conf);
+    AssertAnns(result, nq, conf->k);
+
+    // shards are merged when copied back
+    auto cpu_index = knowhere::cloner::CopyGpuToCpu(shards, knowhere::Config());
+    EXPECT_EQ(cpu_index->Count(), nb);
+    result = cpu_index->Search(query_dataset, conf);
+    AssertAnns(result, nq, conf->k);
+}
+
 #endif
 
 #ifdef MILVUS_GPU_VERSION
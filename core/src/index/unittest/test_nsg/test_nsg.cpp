@@ -10,7 +10,10 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/FaissBaseIndex.h"
@@ -21,7 +24,9 @@
 #include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
 #endif
 
+#include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Timer.h"
+#include "knowhere/index/vector_index/helpers/IDFilter.h"
 #include "knowhere/index/vector_index/nsg/NSGIO.h"
 
 #include <fiu-control.h>
@@ -121,6 +126,34 @@ TEST_F(NSGInterfaceTest, basic_test) {
     });
 }
 
+TEST_F(NSGInterfaceTest, filtered_search_test) {
+    auto model = index_->Train(base_dataset, train_conf);
+
+    // query is the first base vector, exclude it from the result
+    std::vector<int64_t> excluded(ids.begin(), ids.begin() + nq);
+    search_conf->filter = std::make_shared<knowhere::IDFilter>(excluded, true);
+    auto result = index_->Search(query_dataset, search_conf);
+    auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; i++) {
+        ASSERT_GE(result_ids[i], nq);
+    }
+
+    // only the odd ids are searched
+    std::vector<int64_t> accepted;
+    for (auto id : ids) {
+        if (id % 2 == 1) {
+            accepted.push_back(id);
+        }
+    }
+    search_conf->filter = std::make_shared<knowhere::IDFilter>(accepted, false);
+    result = index_->Search(query_dataset, search_conf);
+    result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; i++) {
+        ASSERT_EQ(result_ids[i] % 2, 1);
+    }
+    search_conf->filter = nullptr;
+}
+
 TEST_F(NSGInterfaceTest, comparetest) {
     knowhere::algo::DistanceL2 distanceL2;
     knowhere::algo::DistanceIP distanceIP;
@@ -134,6 +167,33 @@ TEST_F(NSGInterfaceTest, comparetest) {
         distanceIP.Compare(xb.data(), xq.data(), 256);
     }
     tc.RecordSection("IP");
+
+    // kernels agree with plain loops for any dimension, tails shorter than a register included
+    std::vector<float> a(800), b(800);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = xb[i % xb.size()];
+        b[i] = xq[(i * 7) % xq.size()];
+    }
+    for (unsigned dim : {1U, 3U, 7U, 8U, 15U, 16U, 17U, 31U, 33U, 100U, 128U, 257U, 768U}) {
+        float l2 = 0, ip = 0;
+        for (unsigned i = 0; i < dim; ++i) {
+            l2 += (a[i] - b[i]) * (a[i] - b[i]);
+            ip += a[i] * b[i];
+        }
+        ASSERT_NEAR(distanceL2.Compare(a.data(), b.data(), dim), l2, 1e-3 * (1 + l2));
+        ASSERT_NEAR(distanceIP.Compare(a.data(), b.data(), dim), ip, 1e-3 * (1 + std::abs(ip)));
+    }
+
+    // 768 dim embeddings
+    knowhere::TimeRecorder tc768(std::string("Compare 768 dim, ") + knowhere::algo::DistanceInstructionSet());
+    for (int i = 0; i < 100000; ++i) {
+        distanceL2.Compare(a.data(), b.data(), 768);
+    }
+    tc768.RecordSection("L2");
+    for (int i = 0; i < 100000; ++i) {
+        distanceIP.Compare(a.data(), b.data(), 768);
+    }
+    tc768.RecordSection("IP");
 }
 
 //#include <src/index/knowhere/knowhere/index/vector_index/nsg/OriNSG.h>
@@ -83,6 +83,68 @@ class MetricsBase {
     CacheAccessTotalIncrement(double value = 1) {
     }
 
+    // cache: cpu, gpu0, gpu1..., table: table or partition the item belongs to, empty if unknown
+    virtual void
+    CacheHitTotalIncrement(const std::string& cache, const std::string& table) {
+    }
+
+    virtual void
+    CacheMissTotalIncrement(const std::string& cache, const std::string& table) {
+    }
+
+    virtual void
+    CacheLoadBytesTotalIncrement(const std::string& cache, const std::string& table, double bytes) {
+    }
+
+    virtual void
+    CacheLoadDurationHistogramObserve(const std::string& cache, double microseconds) {
+    }
+
+    virtual void
+    CacheEvictTotalIncrement(const std::string& cache, const std::string& table, double bytes) {
+    }
+
+    virtual void
+    SearchPhaseDurationHistogramObserve(const std::string& phase, const std::string& table,
+                                        const std::string& index_type, double microseconds) {
+    }
+
+    virtual void
+    QueryResourceUsageIncrement(const std::string& table, const std::string& resource, double value) {
+    }
+
+    virtual void
+    SearchRecallHistogramObserve(const std::string& table, const std::string& index_type, double recall) {
+    }
+
+    virtual void
+    InsertBufferBytesGaugeSet(const std::string& table, double bytes) {
+    }
+
+    virtual void
+    FlushDurationHistogramObserve(const std::string& table, double microseconds) {
+    }
+
+    virtual void
+    PendingFilesGaugeSet(const std::string& table, const std::string& file_type, double value) {
+    }
+
+    virtual void
+    BuildIndexWaitHistogramObserve(double microseconds) {
+    }
+
+    virtual void
+    GpuKernelTimeIncrement(const std::string& device, double microseconds) {
+    }
+
+    virtual void
+    GpuTransferIncrement(const std::string& device, double bytes, double microseconds) {
+    }
+
+    virtual void
+    GpuTempMemoryOverflowGaugeSet(const std::string& device, double bytes) {
+    }
+
     virtual void
     MemTableMergeDurationSecondsHistogramObserve(double value) {
     }
@@ -171,6 +233,10 @@ class MetricsBase {
     QueryIndexTypePerSecondSet(std::string type, double value) {
     }
 
+    virtual void
+    TaskTableQueueDepthSet(const std::string& resource, const std::string& state, double value) {
+    }
+
     virtual void
     ConnectionGaugeIncrement() {
     }
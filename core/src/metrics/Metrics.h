@@ -14,6 +14,8 @@
 #include "MetricBase.h"
 #include "db/meta/MetaTypes.h"
 
+#include <string>
+
 namespace milvus {
 namespace server {
 
@@ -145,6 +147,48 @@ class CollectExecutionEngineMetrics : CollectMetricsBase {
     double physical_size_;
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CollectCacheLoadMetrics : CollectMetricsBase {
+ public:
+    CollectCacheLoadMetrics(const std::string& cache, const std::string& table, double size)
+        : cache_(cache), table_(table), size_(size) {
+    }
+
+    ~CollectCacheLoadMetrics() {
+        auto total_time = TimeFromBegine();
+        server::Metrics::GetInstance().CacheLoadDurationHistogramObserve(cache_, total_time);
+        server::Metrics::GetInstance().CacheLoadBytesTotalIncrement(cache_, table_, size_);
+    }
+
+ private:
+    std::string cache_;
+    std::string table_;
+    double size_;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CollectSearchPhaseMetrics : CollectMetricsBase {
+ public:
+    CollectSearchPhaseMetrics(const std::string& phase, const std::string& table, int32_t index_type)
+        : phase_(phase), table_(table), index_type_(std::to_string(index_type)) {
+    }
+
+    void
+    SetIndexType(int32_t index_type) {
+        index_type_ = std::to_string(index_type);
+    }
+
+    ~CollectSearchPhaseMetrics() {
+        auto total_time = TimeFromBegine();
+        server::Metrics::GetInstance().SearchPhaseDurationHistogramObserve(phase_, table_, index_type_, total_time);
+    }
+
+ private:
+    std::string phase_;
+    std::string table_;
+    std::string index_type_;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class CollectSerializeMetrics : CollectMetricsBase {
  public:
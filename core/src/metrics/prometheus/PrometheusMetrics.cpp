@@ -134,6 +134,165 @@ PrometheusMetrics::QueryIndexTypePerSecondSet(std::string type, double value) {
     }
 }
 
+void
+PrometheusMetrics::TaskTableQueueDepthSet(const std::string& resource, const std::string& state, double value) {
+    if (!startup_) {
+        return;
+    }
+
+    prometheus::Gauge& depth = task_table_queue_depth_.Add({{"resource", resource}, {"state", state}});
+    depth.Set(value);
+}
+
+void
+PrometheusMetrics::CacheHitTotalIncrement(const std::string& cache, const std::string& table) {
+    if (!startup_) {
+        return;
+    }
+
+    cache_hit_.Add({{"cache", cache}, {"table", table}}).Increment();
+}
+
+void
+PrometheusMetrics::CacheMissTotalIncrement(const std::string& cache, const std::string& table) {
+    if (!startup_) {
+        return;
+    }
+
+    cache_miss_.Add({{"cache", cache}, {"table", table}}).Increment();
+}
+
+void
+PrometheusMetrics::CacheLoadBytesTotalIncrement(const std::string& cache, const std::string& table, double bytes) {
+    if (!startup_) {
+        return;
+    }
+
+    cache_load_bytes_.Add({{"cache", cache}, {"table", table}}).Increment(bytes);
+}
+
+void
+PrometheusMetrics::CacheLoadDurationHistogramObserve(const std::string& cache, double microseconds) {
+    if (!startup_) {
+        return;
+    }
+
+    using BucketBoundaries = std::vector<double>;
+    cache_load_duration_.Add({{"cache", cache}}, BucketBoundaries{1e3, 1e4, 1e5, 5e5, 1e6, 5e6})
+        .Observe(microseconds);
+}
+
+void
+PrometheusMetrics::CacheEvictTotalIncrement(const std::string& cache, const std::string& table, double bytes) {
+    if (!startup_) {
+        return;
+    }
+
+    cache_evict_.Add({{"cache", cache}, {"table", table}}).Increment();
+    cache_evict_bytes_.Add({{"cache", cache}, {"table", table}}).Increment(bytes);
+}
+
+void
+PrometheusMetrics::SearchPhaseDurationHistogramObserve(const std::string& phase, const std::string& table,
+                                                       const std::string& index_type, double microseconds) {
+    if (!startup_) {
+        return;
+    }
+
+    using BucketBoundaries = std::vector<double>;
+    search_phase_duration_.Add({{"phase", phase}, {"table", table}, {"index_type", index_type}},
+                               BucketBoundaries{1e2, 1e3, 1e4, 1e5, 1e6, 1e7})
+        .Observe(microseconds);
+}
+
+void
+PrometheusMetrics::QueryResourceUsageIncrement(const std::string& table, const std::string& resource, double value) {
+    if (!startup_ || value <= 0) {
+        return;
+    }
+
+    query_resource_usage_.Add({{"table", table}, {"resource", resource}}).Increment(value);
+}
+
+void
+PrometheusMetrics::SearchRecallHistogramObserve(const std::string& table, const std::string& index_type,
+                                                double recall) {
+    if (!startup_) {
+        return;
+    }
+
+    using BucketBoundaries = std::vector<double>;
+    search_recall_.Add({{"table", table}, {"index_type", index_type}},
+                       BucketBoundaries{0.5, 0.8, 0.9, 0.95, 0.98, 0.99, 1.0})
+        .Observe(recall);
+}
+
+void
+PrometheusMetrics::InsertBufferBytesGaugeSet(const std::string& table, double bytes) {
+    if (!startup_) {
+        return;
+    }
+
+    insert_buffer_bytes_.Add({{"table", table}}).Set(bytes);
+}
+
+void
+PrometheusMetrics::FlushDurationHistogramObserve(const std::string& table, double microseconds) {
+    if (!startup_) {
+        return;
+    }
+
+    using BucketBoundaries = std::vector<double>;
+    flush_duration_.Add({{"table", table}}, BucketBoundaries{1e3, 1e4, 1e5, 1e6, 5e6, 1e7, 6e7})
+        .Observe(microseconds);
+}
+
+void
+PrometheusMetrics::PendingFilesGaugeSet(const std::string& table, const std::string& file_type, double value) {
+    if (!startup_) {
+        return;
+    }
+
+    pending_files_.Add({{"table", table}, {"file_type", file_type}}).Set(value);
+}
+
+void
+PrometheusMetrics::BuildIndexWaitHistogramObserve(double microseconds) {
+    if (!startup_) {
+        return;
+    }
+
+    build_index_wait_histogram_.Observe(microseconds);
+}
+
+void
+PrometheusMetrics::GpuKernelTimeIncrement(const std::string& device, double microseconds) {
+    if (!startup_) {
+        return;
+    }
+
+    gpu_kernel_time_.Add({{"device", device}}).Increment(microseconds);
+}
+
+void
+PrometheusMetrics::GpuTransferIncrement(const std::string& device, double bytes, double microseconds) {
+    if (!startup_) {
+        return;
+    }
+
+    gpu_transfer_bytes_.Add({{"device", device}}).Increment(bytes);
+    gpu_transfer_time_.Add({{"device", device}}).Increment(microseconds);
+}
+
+void
+PrometheusMetrics::GpuTempMemoryOverflowGaugeSet(const std::string& device, double bytes) {
+    if (!startup_) {
+        return;
+    }
+
+    gpu_temp_memory_overflow_.Add({{"device", device}}).Set(bytes);
+}
+
 void
 PrometheusMetrics::ConnectionGaugeIncrement() {
     if (!startup_) {
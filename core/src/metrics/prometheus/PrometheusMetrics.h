@@ -146,6 +146,38 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    CacheHitTotalIncrement(const std::string& cache, const std::string& table) override;
+    void
+    CacheMissTotalIncrement(const std::string& cache, const std::string& table) override;
+    void
+    CacheLoadBytesTotalIncrement(const std::string& cache, const std::string& table, double bytes) override;
+    void
+    CacheLoadDurationHistogramObserve(const std::string& cache, double microseconds) override;
+    void
+    CacheEvictTotalIncrement(const std::string& cache, const std::string& table, double bytes) override;
+    void
+    SearchPhaseDurationHistogramObserve(const std::string& phase, const std::string& table,
+                                        const std::string& index_type, double microseconds) override;
+    void
+    QueryResourceUsageIncrement(const std::string& table, const std::string& resource, double value) override;
+    void
+    SearchRecallHistogramObserve(const std::string& table, const std::string& index_type, double recall) override;
+    void
+    InsertBufferBytesGaugeSet(const std::string& table, double bytes) override;
+    void
+    FlushDurationHistogramObserve(const std::string& table, double microseconds) override;
+    void
+    PendingFilesGaugeSet(const std::string& table, const std::string& file_type, double value) override;
+    void
+    BuildIndexWaitHistogramObserve(double microseconds) override;
+    void
+    GpuKernelTimeIncrement(const std::string& device, double microseconds) override;
+    void
+    GpuTransferIncrement(const std::string& device, double bytes, double microseconds) override;
+    void
+    GpuTempMemoryOverflowGaugeSet(const std::string& device, double bytes) override;
+
     void
     MemTableMergeDurationSecondsHistogramObserve(double value) override {
         if (startup_) {
@@ -270,6 +302,8 @@ class PrometheusMetrics : public MetricsBase {
     void
     QueryIndexTypePerSecondSet(std::string type, double value) override;
     void
+    TaskTableQueueDepthSet(const std::string& resource, const std::string& state, double value) override;
+    void
     ConnectionGaugeIncrement() override;
     void
     ConnectionGaugeDecrement() override;
@@ -543,6 +577,92 @@ class PrometheusMetrics : public MetricsBase {
                                                                  .Register(*registry_);
     prometheus::Counter& cache_access_total_ = cache_access_.Add({});
 
+    // record hits, misses, loads and evictions of each cache per table
+    prometheus::Family<prometheus::Counter>& cache_hit_ = prometheus::BuildCounter()
+                                                              .Name("cache_hit_total")
+                                                              .Help("the count of items found in cache")
+                                                              .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& cache_miss_ = prometheus::BuildCounter()
+                                                               .Name("cache_miss_total")
+                                                               .Help("the count of items not found in cache")
+                                                               .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& cache_load_bytes_ = prometheus::BuildCounter()
+                                                                     .Name("cache_load_bytes_total")
+                                                                     .Help("bytes loaded into cache after misses")
+                                                                     .Register(*registry_);
+    prometheus::Family<prometheus::Histogram>& cache_load_duration_ =
+        prometheus::BuildHistogram()
+            .Name("cache_load_duration_microseconds")
+            .Help("histogram of time to load an item missed in cache")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& cache_evict_ = prometheus::BuildCounter()
+                                                                .Name("cache_evict_total")
+                                                                .Help("the count of items evicted from cache")
+                                                                .Register(*registry_);
+    prometheus::Family<prometheus::Histogram>& search_phase_duration_ =
+        prometheus::BuildHistogram()
+            .Name("search_phase_duration_microseconds")
+            .Help("histogram of time spent in each phase of a search request")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& cache_evict_bytes_ = prometheus::BuildCounter()
+                                                                      .Name("cache_evict_bytes_total")
+                                                                      .Help("bytes evicted from cache")
+                                                                      .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& query_resource_usage_ =
+        prometheus::BuildCounter()
+            .Name("query_resource_usage_total")
+            .Help("resources spent by search requests: cpu and gpu microseconds, segments, vectors, bytes, misses")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Histogram>& search_recall_ =
+        prometheus::BuildHistogram()
+            .Name("search_recall")
+            .Help("histogram of recall@k of sampled searches against exact search on raw files")
+            .Register(*registry_);
+
+    // ingest pipeline: insert buffer, flush and the files waiting for merge or index build
+    prometheus::Family<prometheus::Gauge>& insert_buffer_bytes_ = prometheus::BuildGauge()
+                                                                      .Name("insert_buffer_bytes")
+                                                                      .Help("bytes buffered in memory by table")
+                                                                      .Register(*registry_);
+    prometheus::Family<prometheus::Histogram>& flush_duration_ =
+        prometheus::BuildHistogram()
+            .Name("flush_duration_microseconds")
+            .Help("histogram of time spent flushing the insert buffer of a table")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& pending_files_ =
+        prometheus::BuildGauge()
+            .Name("pending_files")
+            .Help("the number of raw files waiting for merge and to_index files waiting for build")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Histogram>& build_index_wait_ =
+        prometheus::BuildHistogram()
+            .Name("build_index_wait_microseconds")
+            .Help("histogram of time from file creation until its index build is scheduled")
+            .Register(*registry_);
+    prometheus::Histogram& build_index_wait_histogram_ =
+        build_index_wait_.Add({}, BucketBoundaries{1e6, 1e7, 6e7, 3e8, 9e8, 3.6e9, 1.44e10});
+
+    // per gpu device: search kernels, copies of indexes from host and faiss temp memory running short
+    prometheus::Family<prometheus::Counter>& gpu_kernel_time_ =
+        prometheus::BuildCounter()
+            .Name("gpu_kernel_microseconds_total")
+            .Help("time spent searching on the device")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& gpu_transfer_bytes_ = prometheus::BuildCounter()
+                                                                       .Name("gpu_transfer_bytes_total")
+                                                                       .Help("bytes of indexes copied to the device")
+                                                                       .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& gpu_transfer_time_ =
+        prometheus::BuildCounter()
+            .Name("gpu_transfer_microseconds_total")
+            .Help("time spent copying indexes to the device")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& gpu_temp_memory_overflow_ =
+        prometheus::BuildGauge()
+            .Name("gpu_temp_memory_overflow_bytes")
+            .Help("high water of memory faiss allocated on the device when its temp memory ran out")
+            .Register(*registry_);
+
     // record CPU cache usage and %
     prometheus::Family<prometheus::Gauge>& cpu_cache_usage_ =
         prometheus::BuildGauge().Name("cache_usage_bytes").Help("current cache usage by bytes").Register(*registry_);
@@ -634,6 +754,12 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Gauge& query_index_IDMAP_type_per_second_gauge_ =
         query_index_type_per_second_.Add({{"IndexType", "IDMAP"}});
 
+    // record tasks waiting in task table of each resource
+    prometheus::Family<prometheus::Gauge>& task_table_queue_depth_ = prometheus::BuildGauge()
+                                                                         .Name("task_table_queue_depth")
+                                                                         .Help("the number of tasks in each state")
+                                                                         .Register(*registry_);
+
     prometheus::Family<prometheus::Gauge>& connection_ =
         prometheus::BuildGauge().Name("connection_number").Help("the number of connections").Register(*registry_);
     prometheus::Gauge& connection_gauge_ = connection_.Add({});
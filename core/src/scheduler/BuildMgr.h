@@ -14,6 +14,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -23,12 +24,21 @@
 #include <unordered_map>
 #include <vector>
 
+#include "utils/ThreadPool.h"
+
 namespace milvus {
 namespace scheduler {
 
+/*
+ * An index build goes through three stages: loading the raw file, building the index on a cpu or gpu executor,
+ * then writing the index and updating meta; Each stage is limited on its own, so the next raw file is loaded
+ * while an index is built, and a built index is written while the executor builds the next one;
+ * Take/Put count files loaded and waiting for an executor, the executor puts the slot back when it starts the build;
+ */
 class BuildMgr {
  public:
-    explicit BuildMgr(int64_t concurrent_limit) : available_(concurrent_limit) {
+    BuildMgr(int64_t load_limit, int64_t serialize_limit)
+        : available_(load_limit), serialize_pool_(serialize_limit, serialize_limit) {
     }
 
  public:
@@ -54,9 +64,16 @@ class BuildMgr {
         return available_;
     }
 
+    // run the write of a built index in background, block while serialize_limit writes are waiting
+    void
+    Serialize(std::function<void()> job) {
+        serialize_pool_.enqueue(std::move(job));
+    }
+
  private:
     std::int64_t available_;
     std::mutex mutex_;
+    ThreadPool serialize_pool_;
 };
 
 using BuildMgrPtr = std::shared_ptr<BuildMgr>;
@@ -16,6 +16,7 @@
 #include "scheduler/Algorithm.h"
 #include "scheduler/optimizer/Optimizer.h"
 #include "scheduler/tasklabel/SpecResLabel.h"
+#include "task/SearchTask.h"
 #include "task/Task.h"
 
 #include <utility>
@@ -110,6 +111,23 @@ JobMgr::calculate_path(const ResourceMgrPtr& res_mgr, const TaskPtr& task) {
     auto spec_label = std::static_pointer_cast<SpecResLabel>(task->label());
     auto src = res_mgr->GetDiskResources()[0];
     auto dest = spec_label->resource();
+    if (dest.expired()) {
+        // the specified gpu not added or already removed by reconfiguration, fall back to cpu
+        dest = res_mgr->GetResource("cpu");
+        task->label() = std::make_shared<SpecResLabel>(dest);
+    }
+
+    // numa mode: a file is always searched by the cpu resource of one node, its cached data stays in local memory
+    auto cpu_resources = res_mgr->GetCpuResources();
+    auto dest_res = dest.lock();
+    if (task->type_ == TaskType::SearchTask && cpu_resources.size() > 1 && dest_res != nullptr &&
+        dest_res->type() == ResourceType::CPU) {
+        auto search_task = std::static_pointer_cast<XSearchTask>(task);
+        if (search_task->file_ != nullptr) {
+            dest = cpu_resources[search_task->file_->id_ % cpu_resources.size()];
+            task->label() = std::make_shared<SpecResLabel>(dest);
+        }
+    }
     ShortestPath(src.lock(), dest.lock(), res_mgr, path);
     task->path() = Path(path, path.size() - 1);
 }
@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/OmpBudget.h"
+
+#include <omp.h>
+#include <algorithm>
+
+namespace milvus {
+namespace scheduler {
+
+OmpBudget::Share::Share() : previous_threads_(omp_get_max_threads()) {
+    auto& budget = OmpBudget::GetInstance();
+    std::lock_guard<std::mutex> lock(budget.share_mutex_);
+    int64_t tasks = ++budget.tasks_;
+    int64_t threads = budget.Threads();
+    // a task started later gets a smaller share, the threads of running tasks are fixed until they finish, so
+    // the share is cut to what they leave
+    int64_t share = (threads > 0) ? std::min<int64_t>(threads / tasks, threads - budget.shared_threads_)
+                                  : previous_threads_ / tasks;
+
+    threads_ = static_cast<int32_t>(std::max<int64_t>(1, std::min<int64_t>(previous_threads_, share)));
+    budget.shared_threads_ += threads_;
+    omp_set_num_threads(threads_);
+}
+
+OmpBudget::Share::~Share() {
+    auto& budget = OmpBudget::GetInstance();
+    {
+        std::lock_guard<std::mutex> lock(budget.share_mutex_);
+        --budget.tasks_;
+        budget.shared_threads_ -= threads_;
+    }
+    omp_set_num_threads(previous_threads_);
+}
+
+}  // namespace scheduler
+}  // namespace milvus
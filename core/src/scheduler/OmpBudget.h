@@ -0,0 +1,91 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Openmp threads of the engine split among the tasks executing at the same time;
+ * Faiss runs every search and build with openmp, concurrent tasks would oversubscribe the cpu otherwise;
+ */
+class OmpBudget {
+ public:
+    static OmpBudget&
+    GetInstance() {
+        static OmpBudget budget;
+        return budget;
+    }
+
+    /*
+     * Threads shared by all tasks, engine_config.omp_thread_num resolved at start, 0 means no limit;
+     */
+    void
+    SetThreads(int64_t threads) {
+        threads_ = threads;
+    }
+
+    int64_t
+    Threads() const {
+        return threads_;
+    }
+
+    /*
+     * Number of tasks holding a share;
+     */
+    int64_t
+    NumOfTasks() const {
+        return tasks_;
+    }
+
+    /*
+     * Held by a task while it executes;
+     * The calling thread runs openmp with its share of the budget, never more than it had before or than is left by
+     * the tasks running already, but at least one thread;
+     */
+    class Share {
+     public:
+        Share();
+
+        ~Share();
+
+        Share(const Share&) = delete;
+        Share&
+        operator=(const Share&) = delete;
+
+        int32_t
+        Threads() const {
+            return threads_;
+        }
+
+     private:
+        int32_t previous_threads_;
+        int32_t threads_;
+    };
+
+ private:
+    OmpBudget() = default;
+
+ private:
+    std::atomic<int64_t> threads_{0};
+    std::atomic<int64_t> tasks_{0};
+
+    std::mutex share_mutex_;
+    int64_t shared_threads_ = 0;  // threads held by the running tasks
+};
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -13,6 +13,8 @@
 #include "scheduler/ResourceMgr.h"
 #include "utils/Log.h"
 
+#include <thread>
+
 namespace milvus {
 namespace scheduler {
 
@@ -42,8 +44,8 @@ ResourceMgr::Stop() {
     }
     worker_thread_.join();
 
-    std::lock_guard<std::mutex> lck(resources_mutex_);
-    for (auto& resource : resources_) {
+    // resource threads look up resources, don't hold the lock while joining them
+    for (auto& resource : GetAllResources()) {
         resource->Stop();
     }
 }
@@ -53,9 +55,11 @@ ResourceMgr::Add(ResourcePtr&& resource) {
     ResourceWPtr ret(resource);
 
     std::lock_guard<std::mutex> lck(resources_mutex_);
-    if (running_) {
-        ENGINE_LOG_ERROR << "ResourceMgr is running, not allow to add resource";
-        return ret;
+    for (auto& res : resources_) {
+        if (res->name() == resource->name()) {
+            ENGINE_LOG_ERROR << "Resource " << resource->name() << " already exists";
+            return ret;
+        }
     }
 
     resource->RegisterSubscriber(std::bind(&ResourceMgr::post_event, this, std::placeholders::_1));
@@ -77,9 +81,61 @@ ResourceMgr::Add(ResourcePtr&& resource) {
     }
     resources_.emplace_back(resource);
 
+    if (running_) {
+        resource->Start();
+    }
+
     return ret;
 }
 
+bool
+ResourceMgr::Remove(const std::string& name) {
+    ResourcePtr resource = nullptr;
+    std::vector<ResourcePtr> others;
+    {
+        std::lock_guard<std::mutex> lck(resources_mutex_);
+        for (auto iter = resources_.begin(); iter != resources_.end(); ++iter) {
+            if ((*iter)->name() == name) {
+                resource = *iter;
+                resources_.erase(iter);
+                break;
+            }
+        }
+        if (resource == nullptr) {
+            ENGINE_LOG_ERROR << "Resource " << name << " not found, cannot remove";
+            return false;
+        }
+        if (resource->type() != ResourceType::GPU) {
+            // disk and cpu resources are always required
+            ENGINE_LOG_ERROR << "Resource " << name << " is not a gpu resource, cannot remove";
+            resources_.emplace_back(resource);
+            return false;
+        }
+
+        for (auto iter = gpu_resources_.begin(); iter != gpu_resources_.end();) {
+            auto res = iter->lock();
+            if (res == nullptr || res == resource) {
+                iter = gpu_resources_.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+        others = resources_;
+    }
+
+    for (auto& res : others) {
+        res->DelNeighbour(std::static_pointer_cast<Node>(resource));
+    }
+
+    if (running_) {
+        // drain tasks already put into the table
+        resource->task_table().WaitIdle();
+        resource->Stop();
+    }
+    ENGINE_LOG_DEBUG << "Resource " << name << " removed";
+    return true;
+}
+
 bool
 ResourceMgr::Connect(const std::string& name1, const std::string& name2, Connection& connection) {
     auto res1 = GetResource(name1);
@@ -108,6 +164,7 @@ ResourceMgr::Clear() {
 
 std::vector<ResourcePtr>
 ResourceMgr::GetComputeResources() {
+    std::lock_guard<std::mutex> lck(resources_mutex_);
     std::vector<ResourcePtr> result;
     for (auto& resource : resources_) {
         if (resource->HasExecutor()) {
@@ -119,6 +176,7 @@ ResourceMgr::GetComputeResources() {
 
 ResourcePtr
 ResourceMgr::GetResource(ResourceType type, uint64_t device_id) {
+    std::lock_guard<std::mutex> lck(resources_mutex_);
     for (auto& resource : resources_) {
         if (resource->type() == type && resource->device_id() == device_id) {
             return resource;
@@ -129,6 +187,7 @@ ResourceMgr::GetResource(ResourceType type, uint64_t device_id) {
 
 ResourcePtr
 ResourceMgr::GetResource(const std::string& name) {
+    std::lock_guard<std::mutex> lck(resources_mutex_);
     for (auto& resource : resources_) {
         if (resource->name() == name) {
             return resource;
@@ -139,11 +198,13 @@ ResourceMgr::GetResource(const std::string& name) {
 
 uint64_t
 ResourceMgr::GetNumOfResource() const {
+    std::lock_guard<std::mutex> lck(resources_mutex_);
     return resources_.size();
 }
 
 uint64_t
 ResourceMgr::GetNumOfComputeResource() const {
+    std::lock_guard<std::mutex> lck(resources_mutex_);
     uint64_t count = 0;
     for (auto& res : resources_) {
         if (res->HasExecutor()) {
@@ -155,6 +216,7 @@ ResourceMgr::GetNumOfComputeResource() const {
 
 uint64_t
 ResourceMgr::GetNumGpuResource() const {
+    std::lock_guard<std::mutex> lck(resources_mutex_);
     uint64_t num = 0;
     for (auto& res : resources_) {
         if (res->type() == ResourceType::GPU) {
@@ -166,6 +228,7 @@ ResourceMgr::GetNumGpuResource() const {
 
 json
 ResourceMgr::Dump() const {
+    std::lock_guard<std::mutex> lck(resources_mutex_);
     json resources{};
     for (auto& res : resources_) {
         resources.push_back(res->Dump());
@@ -195,11 +258,11 @@ ResourceMgr::DumpTaskTables() {
 bool
 ResourceMgr::check_resource_valid() {
     {
-        // TODO: check one disk-resource, one cpu-resource, zero or more gpu-resource;
+        // TODO: check one disk-resource, one or more (numa) cpu-resource, zero or more gpu-resource;
         if (GetDiskResources().size() != 1) {
             return false;
         }
-        if (GetCpuResources().size() != 1) {
+        if (GetCpuResources().empty()) {
             return false;
         }
     }
@@ -38,9 +38,19 @@ class ResourceMgr : public interface::dumpable {
     void
     Stop();
 
+    /*
+     * Resources added while running are started at once;
+     */
     ResourceWPtr
     Add(ResourcePtr&& resource);
 
+    /*
+     * Take a gpu resource out of the graph, no more tasks reach it;
+     * Block until the tasks already on it are finished, then stop it;
+     */
+    bool
+    Remove(const std::string& name);
+
     bool
     Connect(const std::string& name1, const std::string& name2, Connection& connection);
 
@@ -71,6 +81,7 @@ class ResourceMgr : public interface::dumpable {
 
     inline std::vector<ResourcePtr>
     GetAllResources() {
+        std::lock_guard<std::mutex> lck(resources_mutex_);
         return resources_;
     }
 
@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/ResultBufferPool.h"
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+
+// enough for a few thousand files of nq 10 and topk 100 without holding on to huge results
+constexpr size_t MAX_POOLED_BYTES = 256UL * 1024 * 1024;
+constexpr size_t MAX_POOLED_BUFFERS = 8192;
+
+}  // namespace
+
+void
+ResultBufferPool::Acquire(size_t size, engine::ResultIds& ids, engine::ResultDistances& distances) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // released last is the most likely to fit, tasks of a search share the same size
+        for (auto iter = buffers_.rbegin(); iter != buffers_.rend(); ++iter) {
+            if (iter->first.capacity() >= size && iter->second.capacity() >= size) {
+                pooled_bytes_ -= Bytes(iter->first, iter->second);
+                ids.swap(iter->first);
+                distances.swap(iter->second);
+                buffers_.erase(std::next(iter).base());
+                break;
+            }
+        }
+    }
+
+    ids.resize(size);
+    distances.resize(size);
+}
+
+void
+ResultBufferPool::Release(engine::ResultIds&& ids, engine::ResultDistances&& distances) {
+    size_t bytes = Bytes(ids, distances);
+    if (bytes == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pooled_bytes_ + bytes > MAX_POOLED_BYTES || buffers_.size() >= MAX_POOLED_BUFFERS) {
+        return;
+    }
+    ids.clear();
+    distances.clear();
+    buffers_.emplace_back(std::move(ids), std::move(distances));
+    pooled_bytes_ += bytes;
+}
+
+size_t
+ResultBufferPool::Bytes(const engine::ResultIds& ids, const engine::ResultDistances& distances) {
+    return ids.capacity() * sizeof(engine::ResultIds::value_type) +
+           distances.capacity() * sizeof(engine::ResultDistances::value_type);
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "db/Types.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Topk buffers of nq * topk ids and distances, released by a reduce and handed to the next tasks;
+ * Every index file of a search writes its own result, a search across thousands of files would map and fault
+ * in fresh pages for each of them otherwise;
+ */
+class ResultBufferPool {
+ public:
+    static ResultBufferPool&
+    GetInstance() {
+        static ResultBufferPool pool;
+        return pool;
+    }
+
+    /*
+     * Resize ids and distances to size, with the storage of a released pair large enough if any;
+     * The content is unspecified, callers overwrite or assign it;
+     */
+    void
+    Acquire(size_t size, engine::ResultIds& ids, engine::ResultDistances& distances);
+
+    /*
+     * Keep the storage for later searches, dropped if the pool is full;
+     */
+    void
+    Release(engine::ResultIds&& ids, engine::ResultDistances&& distances);
+
+    size_t
+    PooledBytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pooled_bytes_;
+    }
+
+ private:
+    ResultBufferPool() = default;
+
+    static size_t
+    Bytes(const engine::ResultIds& ids, const engine::ResultDistances& distances);
+
+ private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<engine::ResultIds, engine::ResultDistances>> buffers_;
+    size_t pooled_bytes_ = 0;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -13,6 +13,7 @@
 #include "ResourceFactory.h"
 #include "Utils.h"
 #include "server/Config.h"
+#include "wrapper/KnowhereResource.h"
 
 #include <fiu-local.h>
 #include <set>
@@ -47,10 +48,22 @@ load_simple_config() {
     ResMgrInst::GetInstance()->Add(ResourceFactory::Create("cpu", "CPU", 0));
     ResMgrInst::GetInstance()->Connect("disk", "cpu", io);
 
+    // numa mode: "cpu" serves node 0, one more cpu resource for each other node
+    server::Config& config = server::Config::GetInstance();
+    bool numa_enable = false;
+    config.GetEngineConfigNumaEnable(numa_enable);
+    if (numa_enable) {
+        auto numa_nodes = get_numa_nodes();
+        for (uint64_t node = 1; node < numa_nodes.size(); ++node) {
+            auto name = "cpu" + std::to_string(node);
+            ResMgrInst::GetInstance()->Add(ResourceFactory::Create(name, "CPU", node));
+            ResMgrInst::GetInstance()->Connect("disk", name, io);
+        }
+    }
+
 // get resources
 #ifdef MILVUS_GPU_VERSION
     bool enable_gpu = false;
-    server::Config& config = server::Config::GetInstance();
     config.GetGpuResourceConfigEnable(enable_gpu);
     if (enable_gpu) {
         std::vector<int64_t> gpu_ids;
@@ -87,6 +100,60 @@ load_simple_config() {
 #endif
 }
 
+Status
+ReloadGpuResources() {
+#ifdef MILVUS_GPU_VERSION
+    server::Config& config = server::Config::GetInstance();
+    bool enable_gpu = false;
+    auto status = config.GetGpuResourceConfigEnable(enable_gpu);
+    if (!status.ok() || !enable_gpu) {
+        return status;
+    }
+
+    std::vector<int64_t> search_gpus, build_gpus;
+    status = config.GetGpuResourceConfigSearchResources(search_gpus);
+    if (!status.ok()) {
+        return status;
+    }
+    status = config.GetGpuResourceConfigBuildIndexResources(build_gpus);
+    if (!status.ok()) {
+        return status;
+    }
+    std::set<int64_t> gpu_ids(search_gpus.begin(), search_gpus.end());
+    gpu_ids.insert(build_gpus.begin(), build_gpus.end());
+
+    auto res_mgr = ResMgrInst::GetInstance();
+    auto pcie = Connection("pcie", 12000);
+    for (auto gpu_id : gpu_ids) {
+        auto name = std::to_string(gpu_id);
+        if (res_mgr->GetResource(name) != nullptr) {
+            continue;
+        }
+        status = engine::KnowhereResource::InitGpuDevice(gpu_id);
+        if (!status.ok()) {
+            return status;
+        }
+        res_mgr->Add(ResourceFactory::Create(name, "GPU", gpu_id));
+        res_mgr->Connect("cpu", name, pcie);
+        SERVER_LOG_INFO << "Gpu resource " << name << " added";
+    }
+
+    for (auto& resource : res_mgr->GetAllResources()) {
+        if (resource->type() == ResourceType::GPU && gpu_ids.find(resource->device_id()) == gpu_ids.end()) {
+            res_mgr->Remove(resource->name());
+            SERVER_LOG_INFO << "Gpu resource " << resource->name() << " removed";
+        }
+    }
+#endif
+    return Status::OK();
+}
+
+#ifdef MILVUS_GPU_VERSION
+namespace {
+std::string gpu_resources_identity;
+}
+#endif
+
 void
 StartSchedulerService() {
     load_simple_config();
@@ -94,10 +161,29 @@ StartSchedulerService() {
     ResMgrInst::GetInstance()->Start();
     SchedInst::GetInstance()->Start();
     JobMgrInst::GetInstance()->Start();
+
+#ifdef MILVUS_GPU_VERSION
+    // follow gpu resources changed at runtime
+    server::Config& config = server::Config::GetInstance();
+    config.GenUniqueIdentityID("ResourceMgr", gpu_resources_identity);
+    server::ConfigCallBackF lambda = [](const std::string& value) -> Status { return ReloadGpuResources(); };
+    config.RegisterCallBack(server::CONFIG_GPU_RESOURCE, server::CONFIG_GPU_RESOURCE_SEARCH_RESOURCES,
+                            gpu_resources_identity, lambda);
+    config.RegisterCallBack(server::CONFIG_GPU_RESOURCE, server::CONFIG_GPU_RESOURCE_BUILD_INDEX_RESOURCES,
+                            gpu_resources_identity, lambda);
+#endif
 }
 
 void
 StopSchedulerService() {
+#ifdef MILVUS_GPU_VERSION
+    server::Config& config = server::Config::GetInstance();
+    config.CancelCallBack(server::CONFIG_GPU_RESOURCE, server::CONFIG_GPU_RESOURCE_SEARCH_RESOURCES,
+                          gpu_resources_identity);
+    config.CancelCallBack(server::CONFIG_GPU_RESOURCE, server::CONFIG_GPU_RESOURCE_BUILD_INDEX_RESOURCES,
+                          gpu_resources_identity);
+#endif
+
     JobMgrInst::GetInstance()->Stop();
     SchedInst::GetInstance()->Stop();
     ResMgrInst::GetInstance()->Stop();
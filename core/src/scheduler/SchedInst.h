@@ -17,12 +17,14 @@
 #include "Scheduler.h"
 #include "Utils.h"
 #include "optimizer/BuildIndexPass.h"
+#include "optimizer/CostBasedSearchPass.h"
 #include "optimizer/FaissFlatPass.h"
 #include "optimizer/FaissIVFFlatPass.h"
 #include "optimizer/FaissIVFPQPass.h"
 #include "optimizer/FaissIVFSQ8HPass.h"
 #include "optimizer/FaissIVFSQ8Pass.h"
 #include "optimizer/FallbackPass.h"
+#include "optimizer/LargeTopkPass.h"
 #include "optimizer/Optimizer.h"
 #include "server/Config.h"
 
@@ -120,7 +122,17 @@ class OptimizerInst {
                     search_msg.append(". gpu_search_threshold:" + std::to_string(gpu_search_threshold));
                     SERVER_LOG_DEBUG << search_msg;
 
+                    bool cost_based_placement = false;
+                    config.GetGpuResourceConfigCostBasedPlacement(cost_based_placement);
+                    if (cost_based_placement) {
+                        SERVER_LOG_DEBUG << "Search tasks are placed by estimated cost";
+                    }
+
                     pass_list.push_back(std::make_shared<BuildIndexPass>());
+                    pass_list.push_back(std::make_shared<LargeTopkPass>());
+                    if (cost_based_placement) {
+                        pass_list.push_back(std::make_shared<CostBasedSearchPass>());
+                    }
                     pass_list.push_back(std::make_shared<FaissFlatPass>());
                     pass_list.push_back(std::make_shared<FaissIVFFlatPass>());
                     pass_list.push_back(std::make_shared<FaissIVFSQ8Pass>());
@@ -144,12 +156,16 @@ class OptimizerInst {
 
 class BuildMgrInst {
  public:
+    // raw files loaded ahead of the builds, and built indexes waiting to be written
+    static constexpr int64_t BUILD_LOAD_LIMIT = 4;
+    static constexpr int64_t BUILD_SERIALIZE_LIMIT = 2;
+
     static BuildMgrPtr
     GetInstance() {
         if (instance == nullptr) {
             std::lock_guard<std::mutex> lock(mutex_);
             if (instance == nullptr) {
-                instance = std::make_shared<BuildMgr>(4);
+                instance = std::make_shared<BuildMgr>(BUILD_LOAD_LIMIT, BUILD_SERIALIZE_LIMIT);
             }
         }
         return instance;
@@ -160,6 +176,13 @@ class BuildMgrInst {
     static std::mutex mutex_;
 };
 
+/*
+ * Add gpu resources newly configured in search_resources or build_index_resources,
+ * remove those no longer configured after their tasks finished;
+ */
+Status
+ReloadGpuResources();
+
 void
 StartSchedulerService();
 
@@ -15,6 +15,8 @@
 #include "cache/GpuCacheMgr.h"
 #include "event/LoadCompletedEvent.h"
 
+#include <chrono>
+#include <unordered_set>
 #include <utility>
 
 namespace milvus {
@@ -64,9 +66,14 @@ Scheduler::PostEvent(const EventPtr& event) {
 
 json
 Scheduler::Dump() const {
+    uint64_t event_count = event_count_;
     json ret{
         {"running", running_},
         {"event_queue_length", event_queue_.size()},
+        {"event_count", event_count},
+        {"merged_event_count", merged_event_count_.load()},
+        {"batch_count", batch_count_.load()},
+        {"average_event_cost_us", event_count ? process_time_us_ / event_count : 0},
     };
     return ret;
 }
@@ -77,19 +84,52 @@ Scheduler::process(const EventPtr& event) {
     process_event(event);
 }
 
-void
-Scheduler::worker_function() {
-    while (running_) {
-        std::unique_lock<std::mutex> lock(event_mutex_);
-        event_cv_.wait(lock, [this] { return !event_queue_.empty(); });
-        auto event = event_queue_.front();
-        event_queue_.pop();
+bool
+Scheduler::process_batch(std::queue<EventPtr>& events) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t count = 0;
+    bool stopped = false;
+    std::unordered_set<Resource*> woken;
+    for (; !events.empty(); events.pop()) {
+        auto& event = events.front();
         if (event == nullptr) {
+            stopped = true;
             break;
         }
 
+        ++count;
+        if (event->Type() != EventType::LOAD_COMPLETED && !woken.insert(event->resource_.get()).second) {
+            ++merged_event_count_;
+            continue;
+        }
         process(event);
     }
+
+    if (count > 0) {
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        event_count_ += count;
+        process_time_us_ += cost.count();
+        ++batch_count_;
+    }
+    return !stopped;
+}
+
+void
+Scheduler::worker_function() {
+    // run until the stop event, events posted before Stop() are all handled
+    while (true) {
+        // take all queued events, producers aren't blocked while they are processed
+        std::queue<EventPtr> events;
+        {
+            std::unique_lock<std::mutex> lock(event_mutex_);
+            event_cv_.wait(lock, [this] { return !event_queue_.empty(); });
+            events.swap(event_queue_);
+        }
+
+        if (!process_batch(events)) {
+            break;
+        }
+    }
 }
 
 // TODO(wxyu): refactor the function
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -64,6 +65,13 @@ class Scheduler : public interface::dumpable {
     void
     process(const EventPtr& event);
 
+    /*
+     * Process events taken from queue at once, return false if stop event met;
+     * Wakeup-only events of a resource are merged, one wakeup covers all task table changes posted before it;
+     */
+    bool
+    process_batch(std::queue<EventPtr>& events);
+
     void
     worker_function();
 
@@ -77,6 +85,12 @@ class Scheduler : public interface::dumpable {
     std::thread worker_thread_;
     std::mutex event_mutex_;
     std::condition_variable event_cv_;
+
+    // statistics of event handling
+    std::atomic<uint64_t> event_count_{0};
+    std::atomic<uint64_t> merged_event_count_{0};
+    std::atomic<uint64_t> batch_count_{0};
+    std::atomic<uint64_t> process_time_us_{0};
 };
 
 using SchedulerPtr = std::shared_ptr<Scheduler>;
@@ -10,7 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/TaskCreator.h"
+
+#include <algorithm>
+
 #include "SchedInst.h"
+#include "cache/CpuCacheMgr.h"
+#include "cache/DiskCacheMgr.h"
+#include "db/SegmentOwnership.h"
+#include "db/Utils.h"
+#include "server/Config.h"
 #include "tasklabel/BroadcastLabel.h"
 #include "tasklabel/SpecResLabel.h"
 
@@ -36,13 +44,125 @@ TaskCreator::Create(const JobPtr& job) {
     }
 }
 
+namespace {
+
+// max rows of raw files packed into one search task, 0 if the job searches them one by one
+int64_t
+RawBatchRowNum(const SearchJob& job) {
+    int64_t row_num = 0;
+#ifdef MILVUS_GPU_VERSION
+    // packing pays off only where the matrix is searched at once, on gpu
+    auto config = server::Config::GetInstance().GetSnapshot();
+    if (!config->gpu_enable_ || config->search_gpus_.empty() ||
+        static_cast<int64_t>(job.nq()) < config->gpu_search_threshold_ || job.vectors().float_data_.empty()) {
+        return 0;
+    }
+    row_num = config->raw_batch_row_num_;
+#endif
+    return row_num;
+}
+
+// a raw file is split into parts of at least this many rows
+constexpr int64_t SPLIT_MIN_ROWS = 65536;
+// queries of a smaller batch are few scans each, the cores are left idle unless the rows are split among tasks
+constexpr uint64_t SPLIT_MAX_NQ = 8;
+
+// tasks each big raw file is split into, 1 if files are searched whole; cpu executors idle for a small batch
+// searching few files are given a part of a file each, a range search takes files whole
+int64_t
+SplitParts(SearchJob& job, const TableFileSchema& file) {
+    auto executors = server::Config::GetInstance().GetSnapshot()->cpu_executor_num_;
+    auto files = static_cast<int64_t>(job.index_files().size());
+    if (job.nq() >= SPLIT_MAX_NQ || job.vectors().float_data_.empty() || job.by_range() || executors <= files) {
+        return 1;
+    }
+    return std::max<int64_t>(1, std::min<int64_t>(executors / files, file.row_count_ / SPLIT_MIN_ROWS));
+}
+
+// files on s3 not loaded yet are all downloaded to disk cache at once, their tasks then load local copies
+void
+FetchFiles(SearchJob& job) {
+    bool s3_enable = server::Config::GetInstance().GetSnapshot()->s3_enable_;
+    auto disk_cache = cache::DiskCacheMgr::GetInstance();
+    if (!s3_enable || !disk_cache->Enabled()) {
+        return;
+    }
+
+    auto cpu_cache = cache::CpuCacheMgr::GetInstance();
+    for (auto& index_file : job.index_files()) {
+        if (!cpu_cache->ItemExists(index_file.second->location_)) {
+            disk_cache->FetchFile(index_file.second->location_);
+        }
+    }
+}
+
+// a raw file with an index built on flush is searched through the index, it isn't packed
+bool
+IsRawFile(const TableFileSchema& file) {
+    if (engine::utils::HasIngestIndex(file)) {
+        return false;
+    }
+    return file.file_type_ == TableFileSchema::RAW || file.file_type_ == TableFileSchema::TO_INDEX ||
+           file.file_type_ == TableFileSchema::BACKUP;
+}
+
+}  // namespace
+
 std::vector<TaskPtr>
 TaskCreator::Create(const SearchJobPtr& job) {
     std::vector<TaskPtr> tasks;
-    for (auto& index_file : job->index_files()) {
-        auto task = std::make_shared<XSearchTask>(job->GetContext(), index_file.second, nullptr);
+    auto add_task = [&](const std::vector<TableFileSchemaPtr>& files) {
+        auto task = std::make_shared<XSearchTask>(job->GetContext(), files.front(), nullptr);
+        task->batch_files_.assign(files.begin() + 1, files.end());
         task->job_ = job;
         tasks.emplace_back(task);
+    };
+    // parts of one file share a single load of it, see LoadingIndexMgr
+    auto add_split_tasks = [&](const TableFileSchemaPtr& file, int64_t parts) {
+        job->SplitIndexFile(file->id_, parts);
+        int64_t part_rows = (file->row_count_ + parts - 1) / parts;
+        for (int64_t part = 0; part < parts; part++) {
+            auto task = std::make_shared<XSearchTask>(job->GetContext(), file, nullptr);
+            task->row_begin_ = part * part_rows;
+            task->row_end_ = std::min<int64_t>((part + 1) * part_rows, file->row_count_);
+            task->job_ = job;
+            tasks.emplace_back(task);
+        }
+    };
+
+    FetchFiles(*job);
+
+    // small raw files are many scans of few rows each, they are packed to be searched as one matrix
+    int64_t batch_row_num = RawBatchRowNum(*job);
+    std::vector<TableFileSchemaPtr> batch;
+    int64_t batch_rows = 0;
+    for (auto& index_file : job->index_files()) {
+        auto& file = index_file.second;
+        if (engine::SegmentOwnership::GetInstance().Owns(file->id_)) {
+            job->AddPrefetchFile(file);
+        }
+        if (IsRawFile(*file)) {
+            int64_t parts = SplitParts(*job, *file);
+            if (parts > 1) {
+                add_split_tasks(file, parts);
+                continue;
+            }
+        }
+        if (batch_row_num <= 0 || !IsRawFile(*file) || file->row_count_ >= batch_row_num) {
+            add_task({file});
+            continue;
+        }
+
+        if (batch_rows + file->row_count_ > batch_row_num) {
+            add_task(batch);
+            batch.clear();
+            batch_rows = 0;
+        }
+        batch.push_back(file);
+        batch_rows += file->row_count_;
+    }
+    if (!batch.empty()) {
+        add_task(batch);
     }
 
     return tasks;
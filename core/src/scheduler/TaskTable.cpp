@@ -23,6 +23,12 @@
 namespace milvus {
 namespace scheduler {
 
+namespace {
+// a resource stops loading tasks of a class when more loaded tasks than the limit wait for executing,
+// difference between the limits is the capacity reserved for higher classes
+constexpr int64_t LOADED_LIMIT[JOB_PRIORITY_NUM] = {0, 1, 2};
+}  // namespace
+
 std::string
 ToString(TaskTableItemState state) {
     switch (state) {
@@ -68,6 +74,7 @@ TaskTableItem::Load() {
         state = TaskTableItemState::LOADING;
         lock.unlock();
         timestamp.load = get_current_timestamp();
+        StateChanged(TaskTableItemState::START, TaskTableItemState::LOADING);
         return true;
     }
     return false;
@@ -80,6 +87,7 @@ TaskTableItem::Loaded() {
         state = TaskTableItemState::LOADED;
         lock.unlock();
         timestamp.loaded = get_current_timestamp();
+        StateChanged(TaskTableItemState::LOADING, TaskTableItemState::LOADED);
         return true;
     }
     return false;
@@ -92,6 +100,7 @@ TaskTableItem::Execute() {
         state = TaskTableItemState::EXECUTING;
         lock.unlock();
         timestamp.execute = get_current_timestamp();
+        StateChanged(TaskTableItemState::LOADED, TaskTableItemState::EXECUTING);
         return true;
     }
     return false;
@@ -105,6 +114,7 @@ TaskTableItem::Executed() {
         lock.unlock();
         timestamp.executed = get_current_timestamp();
         timestamp.finish = get_current_timestamp();
+        StateChanged(TaskTableItemState::EXECUTING, TaskTableItemState::EXECUTED);
         return true;
     }
     return false;
@@ -117,6 +127,7 @@ TaskTableItem::Move() {
         state = TaskTableItemState::MOVING;
         lock.unlock();
         timestamp.move = get_current_timestamp();
+        StateChanged(TaskTableItemState::LOADED, TaskTableItemState::MOVING);
         return true;
     }
     return false;
@@ -130,6 +141,20 @@ TaskTableItem::Moved() {
         lock.unlock();
         timestamp.moved = get_current_timestamp();
         timestamp.finish = get_current_timestamp();
+        StateChanged(TaskTableItemState::MOVING, TaskTableItemState::MOVED);
+        return true;
+    }
+    return false;
+}
+
+bool
+TaskTableItem::Cancel() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (state == TaskTableItemState::START) {
+        state = TaskTableItemState::EXECUTED;
+        lock.unlock();
+        timestamp.finish = get_current_timestamp();
+        StateChanged(TaskTableItemState::START, TaskTableItemState::EXECUTED);
         return true;
     }
     return false;
@@ -146,126 +171,141 @@ TaskTableItem::Dump() const {
     return ret;
 }
 
+void
+TaskTableItem::StateChanged(TaskTableItemState before, TaskTableItemState after) {
+    if (owner) {
+        owner->OnStateChanged(id, priority, before, after);
+    }
+}
+
 std::vector<uint64_t>
 TaskTable::PickToLoad(uint64_t limit) {
-#if 1
     TimeRecorder rc("");
     std::vector<uint64_t> indexes;
-    bool cross = false;
 
-    uint64_t available_begin = table_.front() + 1;
-    for (uint64_t i = 0, loaded_count = 0, pick_count = 0; i < table_.size() && pick_count < limit; ++i) {
-        auto index = available_begin + i;
-        if (not table_[index])
-            break;
-        if (index % table_.capacity() == table_.rear())
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    for (int64_t priority = JOB_PRIORITY_NUM - 1; priority >= 0 && indexes.size() < limit; --priority) {
+        // too many tasks wait for executing, stop loading
+        if (loaded_num_ > LOADED_LIMIT[priority]) {
             break;
-        if (not cross && table_[index]->IsFinish()) {
-            table_.set_front(index);
-        } else if (table_[index]->state == TaskTableItemState::LOADED) {
-            cross = true;
-            ++loaded_count;
-            if (loaded_count > 2)
-                return std::vector<uint64_t>();
-        } else if (table_[index]->state == TaskTableItemState::START) {
+        }
+
+        auto& queue = start_queue_[priority];
+        for (auto iter = queue.begin(); iter != queue.end() && indexes.size() < limit;) {
+            auto index = *iter;
+            if (not is_in_state(index, TaskTableItemState::START)) {
+                iter = queue.erase(iter);
+                continue;
+            }
+
             auto task = table_[index]->task;
 
+            // the job gave up waiting, don't waste a load on it
+            if (task->IsCancelled() && table_[index]->Cancel()) {
+                task->Cancel();
+                iter = queue.erase(iter);
+                continue;
+            }
+
             // if task is a build index task, limit it
             if (task->Type() == TaskType::BuildIndexTask && task->path().Current() == "cpu") {
                 if (BuildMgrInst::GetInstance()->NumOfAvailable() < 1) {
                     SERVER_LOG_WARNING << "BuildMgr doesnot have available place for building index";
+                    ++iter;
                     continue;
                 }
             }
-            cross = true;
             indexes.push_back(index);
-            ++pick_count;
+            ++iter;
         }
     }
     rc.ElapseFromBegin("PickToLoad ");
     return indexes;
-#else
-    size_t count = 0;
-    for (uint64_t j = last_finish_ + 1; j < table_.size(); ++j) {
-        if (not table_[j]) {
-            SERVER_LOG_WARNING << "table[" << j << "] is nullptr";
-        }
-
-        if (table_[j]->task->path().Current() == "cpu") {
-            if (table_[j]->task->Type() == TaskType::BuildIndexTask && BuildMgrInst::GetInstance()->numoftasks() < 1) {
-                return std::vector<uint64_t>();
-            }
-        }
-
-        if (table_[j]->state == TaskTableItemState::LOADED) {
-            ++count;
-            if (count > 2)
-                return std::vector<uint64_t>();
-        }
-    }
-
-    std::vector<uint64_t> indexes;
-    bool cross = false;
-    for (uint64_t i = last_finish_ + 1, count = 0; i < table_.size() && count < limit; ++i) {
-        if (not cross && table_[i]->IsFinish()) {
-            last_finish_ = i;
-        } else if (table_[i]->state == TaskTableItemState::START) {
-            auto task = table_[i]->task;
-            if (task->Type() == TaskType::BuildIndexTask && task->path().Current() == "cpu") {
-                if (BuildMgrInst::GetInstance()->numoftasks() == 0) {
-                    break;
-                } else {
-                    cross = true;
-                    indexes.push_back(i);
-                    ++count;
-                    BuildMgrInst::GetInstance()->take();
-                }
-            } else {
-                cross = true;
-                indexes.push_back(i);
-                ++count;
-            }
-        }
-    }
-    return indexes;
-#endif
 }
 
 std::vector<uint64_t>
 TaskTable::PickToExecute(uint64_t limit) {
     TimeRecorder rc("");
     std::vector<uint64_t> indexes;
-    bool cross = false;
-    uint64_t available_begin = table_.front() + 1;
-    for (uint64_t i = 0, pick_count = 0; i < table_.size() && pick_count < limit; ++i) {
-        uint64_t index = available_begin + i;
-        if (not table_[index]) {
-            break;
-        }
-        if (index % table_.capacity() == table_.rear()) {
-            break;
-        }
 
-        if (not cross && table_[index]->IsFinish()) {
-            table_.set_front(index);
-        } else if (table_[index]->state == TaskTableItemState::LOADED) {
-            cross = true;
+    // tasks of higher classes go first, a running task is never interrupted
+    std::lock_guard<std::mutex> lock(loaded_mutex_);
+    for (int64_t priority = JOB_PRIORITY_NUM - 1; priority >= 0 && indexes.size() < limit; --priority) {
+        auto& queue = loaded_queue_[priority];
+        for (auto iter = queue.begin(); iter != queue.end() && indexes.size() < limit;) {
+            auto index = *iter;
+            if (not is_in_state(index, TaskTableItemState::LOADED)) {
+                iter = queue.erase(iter);
+                continue;
+            }
             indexes.push_back(index);
-            ++pick_count;
+            ++iter;
         }
     }
     rc.ElapseFromBegin("PickToExecute ");
     return indexes;
 }
 
+uint64_t
+TaskTable::NumOfState(TaskTableItemState state) {
+    int64_t num = 0;
+    switch (state) {
+        case TaskTableItemState::START:
+            num = start_num_;
+            break;
+        case TaskTableItemState::LOADING:
+            num = loading_num_;
+            break;
+        case TaskTableItemState::LOADED:
+            num = loaded_num_;
+            break;
+        case TaskTableItemState::EXECUTING:
+            num = executing_num_;
+            break;
+        default:
+            break;
+    }
+    return num > 0 ? num : 0;
+}
+
+uint64_t
+TaskTable::NumOfExecuting(JobPriority priority) {
+    int64_t num = executing_priority_num_[static_cast<int64_t>(priority)];
+    return num > 0 ? num : 0;
+}
+
+void
+TaskTable::WaitIdle() {
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    ++idle_waiters_;
+    idle_cv_.wait(lock, [this] {
+        return NumOfState(TaskTableItemState::START) + NumOfState(TaskTableItemState::LOADING) +
+                   NumOfState(TaskTableItemState::LOADED) + NumOfState(TaskTableItemState::EXECUTING) ==
+               0;
+    });
+    --idle_waiters_;
+}
+
 void
 TaskTable::Put(TaskPtr task, TaskTableItemPtr from) {
+    advance_front();
+
     auto item = std::make_shared<TaskTableItem>(std::move(from));
     item->id = id_++;
     item->task = std::move(task);
     item->state = TaskTableItemState::START;
     item->timestamp.start = get_current_timestamp();
+    item->owner = this;
+    item->priority = item->task ? item->task->Priority() : JobPriority::NORMAL;
+    auto index = item->id;
+    auto priority = static_cast<int64_t>(item->priority);
     table_.put(std::move(item));
+    {
+        std::lock_guard<std::mutex> lock(start_mutex_);
+        start_queue_[priority].push_back(index);
+    }
+    ++start_num_;
+
     if (subscriber_) {
         subscriber_();
     }
@@ -273,20 +313,77 @@ TaskTable::Put(TaskPtr task, TaskTableItemPtr from) {
 
 size_t
 TaskTable::TaskToExecute() {
-    size_t count = 0;
-    auto begin = table_.front() + 1;
-    for (size_t i = 0; i < table_.size(); ++i) {
-        auto index = begin + i;
-        if (table_[index] && table_[index]->state == TaskTableItemState::LOADED) {
-            ++count;
+    return NumOfState(TaskTableItemState::LOADED);
+}
+
+void
+TaskTable::OnStateChanged(uint64_t index, JobPriority priority, TaskTableItemState before,
+                          TaskTableItemState after) {
+    auto counter = [this](TaskTableItemState state) -> std::atomic<int64_t>* {
+        switch (state) {
+            case TaskTableItemState::START:
+                return &start_num_;
+            case TaskTableItemState::LOADING:
+                return &loading_num_;
+            case TaskTableItemState::LOADED:
+                return &loaded_num_;
+            case TaskTableItemState::EXECUTING:
+                return &executing_num_;
+            default:
+                return nullptr;
+        }
+    };
+    if (auto num = counter(before)) {
+        --(*num);
+    }
+    if (auto num = counter(after)) {
+        ++(*num);
+    } else if (counter(before) != nullptr && idle_waiters_ > 0) {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        idle_cv_.notify_all();
+    }
+    if (before == TaskTableItemState::EXECUTING) {
+        --executing_priority_num_[static_cast<int64_t>(priority)];
+    }
+    if (after == TaskTableItemState::EXECUTING) {
+        ++executing_priority_num_[static_cast<int64_t>(priority)];
+    }
+
+    if (after == TaskTableItemState::LOADED) {
+        std::lock_guard<std::mutex> lock(loaded_mutex_);
+        loaded_queue_[static_cast<int64_t>(priority)].push_back(index);
+    }
+}
+
+void
+TaskTable::advance_front() {
+    while (true) {
+        uint64_t index = table_.front() + 1;
+        if (index % table_.capacity() == table_.rear()) {
+            break;
+        }
+        auto& item = table_[index];
+        if (not item || not item->IsFinish()) {
+            break;
         }
+        table_.set_front(index);
     }
-    return count;
+}
+
+bool
+TaskTable::is_in_state(uint64_t index, TaskTableItemState state) {
+    auto& item = table_[index];
+    return item && item->id == index && item->state == state;
 }
 
 json
 TaskTable::Dump() const {
-    json ret{{"error.message", "not support yet."}};
+    json ret{
+        {"start", start_num_.load()},
+        {"loaded", loaded_num_.load()},
+        {"executing", executing_num_.load()},
+        {"total", id_},
+    };
     return ret;
 }
 
@@ -11,8 +11,12 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <functional>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -52,12 +56,19 @@ struct TaskTimestamp : public interface::dumpable {
     Dump() const override;
 };
 
+class TaskTable;
 struct TaskTableItem;
 using TaskTableItemPtr = std::shared_ptr<TaskTableItem>;
 
 struct TaskTableItem : public interface::dumpable {
     explicit TaskTableItem(TaskTableItemPtr f = nullptr)
-        : id(0), task(nullptr), state(TaskTableItemState::INVALID), mutex(), from(std::move(f)) {
+        : id(0),
+          task(nullptr),
+          state(TaskTableItemState::INVALID),
+          mutex(),
+          from(std::move(f)),
+          owner(nullptr),
+          priority(JobPriority::NORMAL) {
     }
 
     TaskTableItem(const TaskTableItem& src) = delete;
@@ -69,6 +80,8 @@ struct TaskTableItem : public interface::dumpable {
     std::mutex mutex;
     TaskTimestamp timestamp;
     TaskTableItemPtr from;
+    TaskTable* owner;      // the table holding the item, notified on state change
+    JobPriority priority;  // priority class of the task, fixed when put into table
 
     bool
     IsFinish();
@@ -91,8 +104,16 @@ struct TaskTableItem : public interface::dumpable {
     bool
     Moved();
 
+    // drop a task not started yet, set it to a termination state directly
+    bool
+    Cancel();
+
     json
     Dump() const override;
+
+ private:
+    void
+    StateChanged(TaskTableItemState before, TaskTableItemState after);
 };
 
 class TaskTable : public interface::dumpable {
@@ -125,6 +146,25 @@ class TaskTable : public interface::dumpable {
     std::vector<uint64_t>
     PickToExecute(uint64_t limit);
 
+    /*
+     * Number of tasks in the state;
+     * Only START, LOADING, LOADED and EXECUTING are tracked, others return 0;
+     */
+    uint64_t
+    NumOfState(TaskTableItemState state);
+
+    /*
+     * Number of executing tasks of the priority class;
+     */
+    uint64_t
+    NumOfExecuting(JobPriority priority);
+
+    /*
+     * Block until no task is in START, LOADING, LOADED or EXECUTING;
+     */
+    void
+    WaitIdle();
+
  public:
     inline const TaskTableItemPtr& operator[](uint64_t index) {
         return table_[index];
@@ -210,15 +250,50 @@ class TaskTable : public interface::dumpable {
         return table_[index]->Moved();
     }
 
+ private:
+    friend struct TaskTableItem;
+
+    /*
+     * Called by item after its state changed;
+     * Keep state counters and queues up to date;
+     */
+    void
+    OnStateChanged(uint64_t index, JobPriority priority, TaskTableItemState before, TaskTableItemState after);
+
+    /*
+     * Release finished items at the front of table, their slots can be reused;
+     */
+    void
+    advance_front();
+
+    /*
+     * An index in state queue is stale if the item has left the state or the slot is reused;
+     */
+    bool
+    is_in_state(uint64_t index, TaskTableItemState state);
+
  private:
     std::uint64_t id_ = 0;
     CircleQueue<TaskTableItemPtr> table_;
     std::function<void(void)> subscriber_ = nullptr;
 
-    // cache last finish avoid Pick task from begin always
-    // pick from (last_finish_ + 1)
-    // init with -1, pick from (last_finish_ + 1) = 0
-    uint64_t last_finish_ = -1;
+    // indexes of items in START and LOADED, one queue per priority class, in the order they enter the state,
+    // stale indexes are dropped when picking, so a pick never walks the whole table
+    std::mutex start_mutex_;
+    std::array<std::list<uint64_t>, JOB_PRIORITY_NUM> start_queue_;
+    std::mutex loaded_mutex_;
+    std::array<std::list<uint64_t>, JOB_PRIORITY_NUM> loaded_queue_;
+
+    std::atomic<int64_t> start_num_{0};
+    std::atomic<int64_t> loading_num_{0};
+    std::atomic<int64_t> loaded_num_{0};
+    std::atomic<int64_t> executing_num_{0};
+    std::array<std::atomic<int64_t>, JOB_PRIORITY_NUM> executing_priority_num_{};
+
+    // a task leaving the tracked states wakes WaitIdle, the lock is only taken when someone waits
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+    std::atomic<int64_t> idle_waiters_{0};
 };
 
 }  // namespace scheduler
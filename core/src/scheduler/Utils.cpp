@@ -14,8 +14,12 @@
 #ifdef MILVUS_GPU_VERSION
 #include <cuda_runtime.h>
 #endif
+#include <pthread.h>
+#include <sched.h>
 #include <chrono>
+#include <fstream>
 #include <set>
+#include <sstream>
 #include <string>
 
 namespace milvus {
@@ -29,5 +33,50 @@ get_current_timestamp() {
     return millis;
 }
 
+std::vector<std::vector<int64_t>>
+get_numa_nodes() {
+    std::vector<std::vector<int64_t>> nodes;
+    while (true) {
+        // cpulist looks like "0-15,32-47"
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(nodes.size()) + "/cpulist");
+        std::string cpulist;
+        if (!file || !std::getline(file, cpulist)) {
+            break;
+        }
+
+        std::vector<int64_t> cpus;
+        std::stringstream ss(cpulist);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            if (range.empty()) {
+                continue;
+            }
+            auto dash = range.find('-');
+            int64_t first = std::stoll(range.substr(0, dash));
+            int64_t last = (dash == std::string::npos) ? first : std::stoll(range.substr(dash + 1));
+            for (int64_t cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        nodes.emplace_back(std::move(cpus));
+    }
+    return nodes;
+}
+
+bool
+bind_current_thread(const std::vector<int64_t>& cpus) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    if (CPU_COUNT(&cpu_set) == 0) {
+        return false;
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -18,5 +18,13 @@ namespace scheduler {
 uint64_t
 get_current_timestamp();
 
+// cpu ids of each numa node of the host, empty if the host does not report its nodes
+std::vector<std::vector<int64_t>>
+get_numa_nodes();
+
+// bind the calling thread to the cpus, memory it touches first is then allocated on their node
+bool
+bind_current_thread(const std::vector<int64_t>& cpus);
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -0,0 +1,170 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/WorkStealingPool.h"
+#include "utils/Log.h"
+
+#include <utility>
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+// the worker running in current thread, used to keep jobs enqueued by a worker local
+thread_local const WorkStealingPool* current_pool = nullptr;
+thread_local uint64_t current_worker = 0;
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(uint64_t num_of_workers, std::function<void()> worker_init)
+    : worker_init_(std::move(worker_init)) {
+    if (num_of_workers == 0) {
+        num_of_workers = 1;
+    }
+    for (uint64_t i = 0; i < num_of_workers; ++i) {
+        workers_.emplace_back(std::make_unique<Worker>());
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    Stop();
+}
+
+void
+WorkStealingPool::Start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    for (uint64_t i = 0; i < workers_.size(); ++i) {
+        threads_.emplace_back(&WorkStealingPool::worker_function, this, i);
+    }
+}
+
+void
+WorkStealingPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    job_cv_.notify_all();
+    vacancy_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+}
+
+void
+WorkStealingPool::Enqueue(Job job) {
+    {
+        // count before push, a worker never takes a job not counted
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queued_;
+        ++pending_;
+    }
+
+    uint64_t index = (current_pool == this) ? current_worker : next_worker_++ % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->jobs.push_back(std::move(job));
+    }
+    job_cv_.notify_one();
+}
+
+void
+WorkStealingPool::WaitForVacancy() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    vacancy_cv_.wait(lock, [&] { return pending_ < static_cast<int64_t>(workers_.size()) || !running_; });
+}
+
+uint64_t
+WorkStealingPool::NumOfPending() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+bool
+WorkStealingPool::pop(uint64_t index, Job& job) {
+    auto& worker = workers_[index];
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    if (worker->jobs.empty()) {
+        return false;
+    }
+    job = std::move(worker->jobs.back());
+    worker->jobs.pop_back();
+    return true;
+}
+
+bool
+WorkStealingPool::steal(uint64_t index, Job& job) {
+    for (uint64_t i = 1; i < workers_.size(); ++i) {
+        auto& victim = workers_[(index + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim->mutex);
+        if (!victim->jobs.empty()) {
+            // oldest job of the victim, the one it would run last
+            job = std::move(victim->jobs.front());
+            victim->jobs.pop_front();
+            ++stolen_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+WorkStealingPool::worker_function(uint64_t index) {
+    current_pool = this;
+    current_worker = index;
+    if (worker_init_) {
+        worker_init_();
+    }
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            job_cv_.wait(lock, [&] { return queued_ > 0 || !running_; });
+            if (queued_ == 0) {
+                // stopped and all jobs done
+                break;
+            }
+        }
+
+        Job job;
+        if (!pop(index, job) && !steal(index, job)) {
+            // counted job is not pushed yet or taken by another worker
+            std::this_thread::yield();
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --queued_;
+        }
+
+        try {
+            job();
+        } catch (std::exception& ex) {
+            SERVER_LOG_ERROR << "WorkStealingPool job encounter exception: " << ex.what();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --pending_;
+        }
+        vacancy_cv_.notify_all();
+    }
+
+    current_pool = nullptr;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,110 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Thread pool with one job deque per worker;
+ * A worker pops jobs from the back of its own deque and steals from the front of the others' when idle;
+ */
+class WorkStealingPool {
+ public:
+    using Job = std::function<void()>;
+
+    /*
+     * worker_init is called once in every worker thread before it takes any job;
+     */
+    explicit WorkStealingPool(uint64_t num_of_workers, std::function<void()> worker_init = nullptr);
+
+    ~WorkStealingPool();
+
+    void
+    Start();
+
+    /*
+     * Run out queued jobs, then join workers;
+     */
+    void
+    Stop();
+
+    /*
+     * Jobs enqueued by a worker go to its own deque, others are spread round robin;
+     */
+    void
+    Enqueue(Job job);
+
+    /*
+     * Block until the number of queued and running jobs is less than the number of workers, or the pool is stopped;
+     */
+    void
+    WaitForVacancy();
+
+ public:
+    inline uint64_t
+    NumOfWorkers() const {
+        return workers_.size();
+    }
+
+    uint64_t
+    NumOfPending();
+
+    inline uint64_t
+    NumOfStolen() const {
+        return stolen_;
+    }
+
+ private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool
+    pop(uint64_t index, Job& job);
+
+    bool
+    steal(uint64_t index, Job& job);
+
+    void
+    worker_function(uint64_t index);
+
+ private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::function<void()> worker_init_;
+
+    std::mutex mutex_;
+    std::condition_variable job_cv_;
+    std::condition_variable vacancy_cv_;
+    bool running_ = false;
+    int64_t queued_ = 0;   // jobs in deques, guard by mutex_
+    int64_t pending_ = 0;  // jobs in deques or running, guard by mutex_
+
+    std::atomic<uint64_t> next_worker_{0};
+    std::atomic<uint64_t> stolen_{0};
+};
+
+using WorkStealingPoolPtr = std::shared_ptr<WorkStealingPool>;
+
+}  // namespace scheduler
+}  // namespace milvus
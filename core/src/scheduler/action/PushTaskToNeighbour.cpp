@@ -111,6 +111,14 @@ Action::SpecifiedResourceLabelTaskScheduler(const ResourceMgrPtr& res_mgr, Resou
     } else {
         auto next_res_name = task->path().Next();
         auto next_res = res_mgr->GetResource(next_res_name);
+        if (next_res == nullptr && resource->HasExecutor()) {
+            // destination removed at runtime, execute the task here instead
+            std::vector<std::string> path{resource->name()};
+            task->path() = Path(path, 0);
+            task->label() = std::make_shared<SpecResLabel>(resource);
+            resource->WakeupExecutor();
+            return;
+        }
         //        if (event->task_table_item_->Move()) {
         //            next_res->task_table().Put(task);
         //        }
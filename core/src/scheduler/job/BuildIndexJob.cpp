@@ -22,7 +22,8 @@ BuildIndexJob::BuildIndexJob(engine::meta::MetaPtr meta_ptr, engine::DBOptions o
 }
 
 bool
-BuildIndexJob::AddToIndexFiles(const engine::meta::TableFileSchemaPtr& to_index_file) {
+BuildIndexJob::AddToIndexFiles(const engine::meta::TableFileSchemaPtr& to_index_file,
+                               const engine::meta::TableFileSchemaPtr& replaced_file) {
     std::unique_lock<std::mutex> lock(mutex_);
     if (to_index_file == nullptr || to_index_files_.find(to_index_file->id_) != to_index_files_.end()) {
         return false;
@@ -31,6 +32,17 @@ BuildIndexJob::AddToIndexFiles(const engine::meta::TableFileSchemaPtr& to_index_
     SERVER_LOG_DEBUG << "BuildIndexJob " << id() << " add to_index file: " << to_index_file->id_;
 
     to_index_files_[to_index_file->id_] = to_index_file;
+    if (replaced_file != nullptr) {
+        replaced_files_[to_index_file->id_] = replaced_file;
+    }
+    return true;
+}
+
+engine::meta::TableFileSchemaPtr
+BuildIndexJob::ReplacedFile(size_t to_index_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = replaced_files_.find(to_index_id);
+    return (iter == replaced_files_.end()) ? nullptr : iter->second;
 }
 
 Status&
@@ -38,6 +50,7 @@ BuildIndexJob::WaitBuildIndexFinish() {
     std::unique_lock<std::mutex> lock(mutex_);
     cv_.wait(lock, [this] { return to_index_files_.empty(); });
     SERVER_LOG_DEBUG << "BuildIndexJob " << id() << " all done";
+    return status_;
 }
 
 void
@@ -38,8 +38,13 @@ class BuildIndexJob : public Job {
     explicit BuildIndexJob(engine::meta::MetaPtr meta_ptr, engine::DBOptions options);
 
  public:
+    // replaced_file is an index file of the same segment searched until the new index is saved, it is deleted
+    // along when the new index replaces it
     bool
-    AddToIndexFiles(const TableFileSchemaPtr& to_index_file);
+    AddToIndexFiles(const TableFileSchemaPtr& to_index_file, const TableFileSchemaPtr& replaced_file = nullptr);
+
+    TableFileSchemaPtr
+    ReplacedFile(size_t to_index_id);
 
     Status&
     WaitBuildIndexFinish();
@@ -73,6 +78,7 @@ class BuildIndexJob : public Job {
 
  private:
     Id2ToIndexMap to_index_files_;
+    Id2ToIndexMap replaced_files_;
     engine::meta::MetaPtr meta_ptr_;
     engine::DBOptions options_;
 
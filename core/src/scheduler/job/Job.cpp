@@ -11,24 +11,52 @@
 
 #include "scheduler/job/Job.h"
 
+#include <atomic>
+
 namespace milvus {
 namespace scheduler {
 
 namespace {
 std::mutex unique_job_mutex;
 uint64_t unique_job_id = 0;
+
+constexpr size_t JOB_TYPE_NUM = static_cast<size_t>(JobType::BUILD) + 1;
+std::atomic<int64_t> alive_jobs[JOB_TYPE_NUM];
+
+JobPriority
+DefaultPriority(JobType type) {
+    switch (type) {
+        case JobType::SEARCH:
+            return JobPriority::HIGH;
+        case JobType::BUILD:
+            return JobPriority::LOW;
+        default:
+            return JobPriority::NORMAL;
+    }
+}
 }  // namespace
 
-Job::Job(JobType type) : type_(type) {
+Job::Job(JobType type) : type_(type), priority_(DefaultPriority(type)) {
+    ++alive_jobs[static_cast<size_t>(type_)];
     std::lock_guard<std::mutex> lock(unique_job_mutex);
     id_ = unique_job_id++;
 }
 
+Job::~Job() {
+    --alive_jobs[static_cast<size_t>(type_)];
+}
+
+int64_t
+Job::NumOfAlive(JobType type) {
+    return alive_jobs[static_cast<size_t>(type)];
+}
+
 json
 Job::Dump() const {
     json ret{
         {"id", id_},
         {"type", type_},
+        {"priority", priority_},
     };
     return ret;
 }
@@ -35,6 +35,18 @@ enum class JobType {
     BUILD,
 };
 
+/*
+ * Priority class of a job, tasks of a higher class waiting in a resource are picked first;
+ * Lower classes can't take the capacity reserved for higher ones;
+ */
+enum class JobPriority {
+    LOW = 0,     // background jobs, building index
+    NORMAL = 1,  // deleting
+    HIGH = 2,    // interactive jobs, searching
+};
+
+constexpr uint64_t JOB_PRIORITY_NUM = 3;
+
 using JobId = std::uint64_t;
 
 class Job : public interface::dumpable {
@@ -49,15 +61,33 @@ class Job : public interface::dumpable {
         return type_;
     }
 
+    inline JobPriority
+    priority() const {
+        return priority_;
+    }
+
+    // a cancelled job is not waited by anyone, its tasks should be skipped
+    virtual bool
+    IsCancelled() const {
+        return false;
+    }
+
     json
     Dump() const override;
 
+    // number of jobs of the type not destroyed yet, for the "perf" command
+    static int64_t
+    NumOfAlive(JobType type);
+
+    ~Job() override;
+
  protected:
     explicit Job(JobType type);
 
  private:
     JobId id_ = 0;
     JobType type_;
+    JobPriority priority_;
 };
 
 using JobPtr = std::shared_ptr<Job>;
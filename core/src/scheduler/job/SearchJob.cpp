@@ -11,11 +11,26 @@
 
 #include "scheduler/job/SearchJob.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "scheduler/ResultBufferPool.h"
+#include "scheduler/task/SearchTask.h"
 #include "utils/Log.h"
 
+#ifdef MILVUS_GPU_VERSION
+#include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
+#endif
+
 namespace milvus {
 namespace scheduler {
 
+namespace {
+// results of a topk this large are folded in batches of this many as they come
+constexpr uint64_t FOLD_MIN_TOPK = 256;
+constexpr size_t FOLD_FAN_IN = 16;
+}  // namespace
+
 SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, uint64_t nprobe,
                      const engine::VectorsData& vectors)
     : Job(JobType::SEARCH), context_(context), topk_(topk), nprobe_(nprobe), vectors_(vectors) {
@@ -36,14 +51,51 @@ SearchJob::AddIndexFile(const TableFileSchemaPtr& index_file) {
 
 void
 SearchJob::WaitResult() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    cv_.wait(lock, [this] { return index_files_.empty(); });
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return index_files_.empty(); });
+    }
+    if (IsCancelled()) {
+        // partial result is useless to a client which has gone
+        ReleaseResults(results_);
+        if (!context_->IsCancelled()) {
+            if (status_.ok()) {
+                status_ = Status(SERVER_DEADLINE_EXCEEDED, "Search deadline exceeded");
+            }
+            SERVER_LOG_WARNING << "SearchJob " << id() << " cancelled, deadline exceeded";
+        } else {
+            if (status_.ok()) {
+                status_ = Status(SERVER_REQUEST_CANCELLED, "Search cancelled by client");
+            }
+            SERVER_LOG_WARNING << "SearchJob " << id() << " cancelled by client";
+        }
+        return;
+    }
+    ReduceResults();
     SERVER_LOG_DEBUG << "SearchJob " << id() << " all done";
 }
 
+void
+SearchJob::SplitIndexFile(size_t index_id, size_t parts) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (parts <= 1 || index_files_.find(index_id) == index_files_.end()) {
+        return;
+    }
+
+    // each part adds a result of its own
+    split_parts_[index_id] = parts;
+}
+
 void
 SearchJob::SearchDone(size_t index_id) {
     std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = split_parts_.find(index_id);
+    if (iter != split_parts_.end()) {
+        if (--iter->second > 0) {
+            return;
+        }
+        split_parts_.erase(iter);
+    }
     index_files_.erase(index_id);
     if (index_files_.empty()) {
         cv_.notify_all();
@@ -52,6 +104,141 @@ SearchJob::SearchDone(size_t index_id) {
     SERVER_LOG_DEBUG << "SearchJob " << id() << " finish index file: " << index_id;
 }
 
+void
+SearchJob::AddPrefetchFile(const TableFileSchemaPtr& index_file) {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    prefetch_files_.push_back(index_file);
+}
+
+std::shared_future<void>
+SearchJob::ClaimPrefetchFile(size_t index_id) {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    prefetch_claimed_.insert(index_id);
+
+    std::shared_future<void> future;
+    auto iter = prefetch_ahead_.find(index_id);
+    if (iter != prefetch_ahead_.end()) {
+        future = iter->second;
+        prefetch_ahead_.erase(iter);
+    }
+    return future;
+}
+
+std::vector<PrefetchFile>
+SearchJob::TakePrefetchFiles(size_t depth) {
+    std::vector<PrefetchFile> files;
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    while (prefetch_ahead_.size() < depth && prefetch_cursor_ < prefetch_files_.size()) {
+        auto& file = prefetch_files_[prefetch_cursor_++];
+        if (prefetch_claimed_.find(file->id_) != prefetch_claimed_.end()) {
+            continue;
+        }
+
+        auto promise = std::make_shared<std::promise<void>>();
+        prefetch_ahead_[file->id_] = promise->get_future().share();
+        files.emplace_back(file, promise);
+    }
+    return files;
+}
+
+engine::CoarseAssignmentPtr
+SearchJob::GetCoarseAssignment(uint64_t fingerprint, const std::function<engine::CoarseAssignmentPtr()>& assign) {
+    std::shared_ptr<CoarseSlot> slot;
+    {
+        std::lock_guard<std::mutex> lock(coarse_mutex_);
+        auto& entry = coarse_slots_[fingerprint];
+        if (entry == nullptr) {
+            entry = std::make_shared<CoarseSlot>();
+        }
+        slot = entry;
+    }
+
+    std::lock_guard<std::mutex> lock(slot->mutex_);
+    if (slot->coarse_ == nullptr) {
+        slot->coarse_ = assign();
+    }
+    return slot->coarse_;
+}
+
+#ifdef MILVUS_GPU_VERSION
+const float*
+SearchJob::PinnedQueries() {
+    std::call_once(pinned_flag_, [this]() {
+        if (vectors_.float_data_.empty()) {
+            return;
+        }
+        int64_t size = vectors_.float_data_.size() * sizeof(float);
+        pinned_queries_ = knowhere::FaissGpuResourceMgr::GetInstance().AllocPinnedHost(size);
+        if (pinned_queries_ != nullptr) {
+            memcpy(pinned_queries_.get(), vectors_.float_data_.data(), size);
+        }
+    });
+    return reinterpret_cast<const float*>(pinned_queries_.get());
+}
+#endif
+
+void
+SearchJob::SetRadius(float radius) {
+    by_range_ = true;
+    radius_ = radius;
+}
+
+void
+SearchJob::AddResult(ResultIds&& ids, ResultDistances&& distances, size_t k, bool ascending) {
+    SearchResults batch;
+    {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        results_.emplace_back();
+        SearchResult& result = results_.back();
+        result.ids_ = std::move(ids);
+        result.distances_ = std::move(distances);
+        result.k_ = k;
+        ascending_ = ascending;
+
+        // a large topk of many files is folded while other files are still searched, the reduce after the last
+        // file merges a few results only, a batch is folded once it fills topk so the fold keeps the layout
+        if (topk_ >= FOLD_MIN_TOPK && results_.size() >= FOLD_FAN_IN) {
+            size_t total_k = 0;
+            for (auto& pending : results_) {
+                total_k += pending.k_;
+            }
+            if (total_k >= topk_) {
+                batch.swap(results_);
+            }
+        }
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    SearchResult folded;
+    XSearchTask::MergeTopkHeap(batch, nq(), topk_, ascending, folded.ids_, folded.distances_);
+    folded.k_ = topk_;
+    ReleaseResults(batch);
+
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    results_.emplace_back(std::move(folded));
+}
+
+void
+SearchJob::ReduceResults() {
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    if (results_.empty()) {
+        return;
+    }
+
+    XSearchTask::MergeTopkHeap(results_, nq(), topk_, ascending_, result_ids_, result_distances_);
+    ReleaseResults(results_);
+}
+
+void
+SearchJob::ReleaseResults(SearchResults& results) {
+    for (auto& result : results) {
+        ResultBufferPool::GetInstance().Release(std::move(result.ids_), std::move(result.distances_));
+    }
+    results.clear();
+}
+
 ResultIds&
 SearchJob::GetResultIds() {
     return result_ids_;
@@ -67,6 +254,11 @@ SearchJob::GetStatus() {
     return status_;
 }
 
+bool
+SearchJob::IsCancelled() const {
+    return context_ != nullptr && (context_->IsCancelled() || context_->IsExpired());
+}
+
 json
 SearchJob::Dump() const {
     json ret{
@@ -74,6 +266,9 @@ SearchJob::Dump() const {
         {"nq", vectors_.vector_count_},
         {"nprobe", nprobe_},
     };
+    if (by_range_) {
+        ret["radius"] = radius_;
+    }
     auto base = Job::Dump();
     ret.insert(base.begin(), base.end());
     return ret;
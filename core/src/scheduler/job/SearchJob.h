@@ -10,8 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -19,11 +22,13 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "Job.h"
 #include "db/Types.h"
+#include "db/engine/ExecutionEngine.h"
 #include "db/meta/MetaTypes.h"
 
 #include "server/context/Context.h"
@@ -38,6 +43,19 @@ using Id2IndexMap = std::unordered_map<size_t, TableFileSchemaPtr>;
 using ResultIds = engine::ResultIds;
 using ResultDistances = engine::ResultDistances;
 
+// topk result of one index file, a part of one or a folded batch of them, each query holds k_ valid items at a
+// stride of topk
+struct SearchResult {
+    ResultIds ids_;
+    ResultDistances distances_;
+    size_t k_ = 0;
+};
+
+using SearchResults = std::vector<SearchResult>;
+
+// a file picked to read ahead, the promise is fulfilled once the read is over
+using PrefetchFile = std::pair<TableFileSchemaPtr, std::shared_ptr<std::promise<void>>>;
+
 class SearchJob : public Job {
  public:
     SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, uint64_t nprobe,
@@ -50,9 +68,19 @@ class SearchJob : public Job {
     void
     WaitResult();
 
+    // the file is searched by parts tasks, one range of rows each, every part adds a result of its own and the file
+    // is done once all of them are, called before the tasks are created
+    void
+    SplitIndexFile(size_t index_id, size_t parts);
+
     void
     SearchDone(size_t index_id);
 
+    // add the result of one index file or part, results of a large topk are folded on the cpu in batches while other
+    // files are searched, what is left is merged on the cpu in WaitResult
+    void
+    AddResult(ResultIds&& ids, ResultDistances&& distances, size_t k, bool ascending);
+
     ResultIds&
     GetResultIds();
 
@@ -62,6 +90,46 @@ class SearchJob : public Job {
     Status&
     GetStatus();
 
+    // the client deadline is exceeded, pending tasks are dropped and running tasks stop between index files
+    bool
+    IsCancelled() const override;
+
+    // files are read ahead in the order their tasks are created
+    void
+    AddPrefetchFile(const TableFileSchemaPtr& index_file);
+
+    /*
+     * Claim the file before its task loads it, so the file won't be picked to read ahead anymore;
+     * Return the future of reading ahead if the file is picked before, the task should wait for it;
+     */
+    std::shared_future<void>
+    ClaimPrefetchFile(size_t index_id);
+
+    /*
+     * Pick next files to read ahead, until depth files are read ahead but not claimed yet;
+     */
+    std::vector<PrefetchFile>
+    TakePrefetchFiles(size_t depth);
+
+    /*
+     * Lists probed by the queries in the files whose quantizers have this fingerprint, the first task asking for
+     * them runs assign while the others with the same fingerprint wait; assign is tried again by the next task
+     * if it returns nullptr;
+     */
+    engine::CoarseAssignmentPtr
+    GetCoarseAssignment(uint64_t fingerprint, const std::function<engine::CoarseAssignmentPtr()>& assign);
+
+#ifdef MILVUS_GPU_VERSION
+    // float queries copied once into pinned host memory, gpus upload them without staging through a bounce buffer;
+    // nullptr if there are no float queries or no pinned memory
+    const float*
+    PinnedQueries();
+#endif
+
+    // the files are searched by range, hits within radius of a query are kept up to topk of them nearest first
+    void
+    SetRadius(float radius);
+
     json
     Dump() const override;
 
@@ -84,6 +152,16 @@ class SearchJob : public Job {
         return nprobe_;
     }
 
+    bool
+    by_range() const {
+        return by_range_;
+    }
+
+    float
+    radius() const {
+        return radius_;
+    }
+
     const engine::VectorsData&
     vectors() const {
         return vectors_;
@@ -99,22 +177,55 @@ class SearchJob : public Job {
         return mutex_;
     }
 
+ private:
+    void
+    ReduceResults();
+
+    // buffers of the results go back to the pool, results is left empty
+    static void
+    ReleaseResults(SearchResults& results);
+
  private:
     const std::shared_ptr<server::Context> context_;
 
     uint64_t topk_ = 0;
     uint64_t nprobe_ = 0;
+    bool by_range_ = false;
+    float radius_ = 0.0f;
     // TODO: smart pointer
     const engine::VectorsData& vectors_;
 
     Id2IndexMap index_files_;
+    // tasks left of the files split by rows
+    std::unordered_map<size_t, size_t> split_parts_;
     // TODO: column-base better ?
     ResultIds result_ids_;
     ResultDistances result_distances_;
     Status status_;
 
+    // results not reduced yet, a batch of them may have been folded into one
+    std::mutex result_mutex_;
+    SearchResults results_;
+    bool ascending_ = true;
+
     std::mutex mutex_;
     std::condition_variable cv_;
+
+    std::mutex prefetch_mutex_;
+    std::vector<TableFileSchemaPtr> prefetch_files_;
+    size_t prefetch_cursor_ = 0;
+    std::unordered_set<size_t> prefetch_claimed_;
+    std::unordered_map<size_t, std::shared_future<void>> prefetch_ahead_;
+
+    struct CoarseSlot {
+        std::mutex mutex_;
+        engine::CoarseAssignmentPtr coarse_;
+    };
+    std::mutex coarse_mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<CoarseSlot>> coarse_slots_;
+
+    std::once_flag pinned_flag_;
+    std::shared_ptr<uint8_t> pinned_queries_;
 };
 
 using SearchJobPtr = std::shared_ptr<SearchJob>;
@@ -0,0 +1,101 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#include "scheduler/optimizer/CostBasedSearchPass.h"
+#include "db/engine/ExecutionEngineImpl.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/optimizer/SearchCostEstimator.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+void
+CostBasedSearchPass::Init() {
+    server::Config& config = server::Config::GetInstance();
+    Status s = config.GetGpuResourceConfigSearchResources(search_gpus_);
+    if (!s.ok()) {
+        throw std::exception();
+    }
+
+    SetIdentity("CostBasedSearchPass");
+    AddGpuEnableListener();
+    AddGpuSearchResListener();
+}
+
+bool
+CostBasedSearchPass::Run(const TaskPtr& task) {
+    if (task->Type() != TaskType::SearchTask || !gpu_enable_ || search_gpus_.empty()) {
+        return false;
+    }
+
+    // the estimate knows single files only, FaissFlatPass places a batch or a part of raw files
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    if (!search_task->batch_files_.empty() || search_task->row_end_ >= 0) {
+        return false;
+    }
+    auto engine_type = static_cast<engine::EngineType>(search_task->file_->engine_type_);
+    if (engine_type != engine::EngineType::FAISS_IDMAP && engine_type != engine::EngineType::FAISS_IVFFLAT &&
+        engine_type != engine::EngineType::FAISS_IVFSQ8 && engine_type != engine::EngineType::FAISS_PQ) {
+        return false;
+    }
+    // a rotated index is only searched on cpu, FaissIVFPQPass places it
+    if (engine::ExecutionEngineImpl::IsRotatedIndex(search_task->file_->location_)) {
+        return false;
+    }
+
+    auto search_job = std::static_pointer_cast<SearchJob>(search_task->job_.lock());
+    if (search_job == nullptr) {
+        return false;
+    }
+
+    std::vector<ResourcePtr> candidates;
+    candidates.push_back(ResMgrInst::GetInstance()->GetResource("cpu"));
+    // gpus with the same estimate are tied to the gpu the file sticks to
+    auto affinity_gpu = PickSearchGpu(*search_task->file_);
+    candidates.push_back(ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, affinity_gpu));
+    for (auto gpu_id : search_gpus_) {
+        if (gpu_id != affinity_gpu) {
+            candidates.push_back(ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, gpu_id));
+        }
+    }
+
+    auto& estimator = SearchCostEstimator::GetInstance();
+    ResourcePtr res_ptr = nullptr;
+    double best_finish = 0;
+    for (auto& candidate : candidates) {
+        if (candidate == nullptr) {
+            continue;
+        }
+        double finish = estimator.FinishTime(candidate, *search_task->file_, search_job->nq(), search_job->topk(),
+                                             search_job->nprobe());
+        if (res_ptr == nullptr || finish < best_finish) {
+            res_ptr = candidate;
+            best_finish = finish;
+        }
+    }
+    if (res_ptr == nullptr) {
+        return false;
+    }
+
+    SERVER_LOG_DEBUG << "CostBasedSearchPass: specify " << res_ptr->name() << " to search file "
+                     << search_task->file_->id_ << ", expect to finish in " << best_finish << " ms";
+    auto label = std::make_shared<SpecResLabel>(res_ptr);
+    task->label() = label;
+    return true;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
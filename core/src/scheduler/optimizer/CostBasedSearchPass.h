@@ -0,0 +1,43 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "scheduler/optimizer/Pass.h"
+#include "scheduler/optimizer/handler/GpuSearchResHandler.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Place search tasks of faiss indexes on the resource expected to finish them first;
+ * Replace the gpu_search_threshold rule of FaissFlatPass, FaissIVFFlatPass, FaissIVFSQ8Pass and FaissIVFPQPass;
+ */
+class CostBasedSearchPass : public Pass, public GpuSearchResHandler {
+ public:
+    CostBasedSearchPass() = default;
+
+ public:
+    void
+    Init() override;
+
+    bool
+    Run(const TaskPtr& task) override;
+};
+
+using CostBasedSearchPassPtr = std::shared_ptr<CostBasedSearchPass>;
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
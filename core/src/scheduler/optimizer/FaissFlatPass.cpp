@@ -46,24 +46,28 @@ FaissFlatPass::Run(const TaskPtr& task) {
         return false;
     }
 
+    // raw files packed into one task or split among tasks are a flat index whatever the engine type of the table
     auto search_task = std::static_pointer_cast<XSearchTask>(task);
-    if (search_task->file_->engine_type_ != (int)engine::EngineType::FAISS_IDMAP) {
+    if (search_task->file_->engine_type_ != (int)engine::EngineType::FAISS_IDMAP && search_task->batch_files_.empty() &&
+        search_task->row_end_ < 0) {
         return false;
     }
 
     auto search_job = std::static_pointer_cast<SearchJob>(search_task->job_.lock());
     ResourcePtr res_ptr;
-    if (!gpu_enable_) {
+    if (search_task->row_end_ >= 0) {
+        SERVER_LOG_DEBUG << "FaissFlatPass: a part of raw file, specify cpu to search!";
+        res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
+    } else if (!gpu_enable_) {
         SERVER_LOG_DEBUG << "FaissFlatPass: gpu disable, specify cpu to search!";
         res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
     } else if (search_job->nq() < threshold_) {
         SERVER_LOG_DEBUG << "FaissFlatPass: nq < gpu_search_threshold, specify cpu to search!";
         res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
     } else {
-        auto best_device_id = count_ % search_gpus_.size();
+        auto best_device_id = PickSearchGpu(*search_task->file_);
         SERVER_LOG_DEBUG << "FaissFlatPass: nq > gpu_search_threshold, specify gpu" << best_device_id << " to search!";
-        ++count_;
-        res_ptr = ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, search_gpus_[best_device_id]);
+        res_ptr = ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, best_device_id);
     }
     auto label = std::make_shared<SpecResLabel>(res_ptr);
     task->label() = label;
@@ -40,8 +40,6 @@ class FaissFlatPass : public Pass, public GpuSearchResHandler {
     bool
     Run(const TaskPtr& task) override;
 
- private:
-    int64_t count_ = 0;
 };
 
 using FaissFlatPassPtr = std::shared_ptr<FaissFlatPass>;
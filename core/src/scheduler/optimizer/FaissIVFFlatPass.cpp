@@ -61,11 +61,10 @@ FaissIVFFlatPass::Run(const TaskPtr& task) {
         SERVER_LOG_DEBUG << "FaissIVFFlatPass: nq < gpu_search_threshold, specify cpu to search!";
         res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
     } else {
-        auto best_device_id = count_ % search_gpus_.size();
+        auto best_device_id = PickSearchGpu(*search_task->file_);
         SERVER_LOG_DEBUG << "FaissIVFFlatPass: nq > gpu_search_threshold, specify gpu" << best_device_id
                          << " to search!";
-        count_++;
-        res_ptr = ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, search_gpus_[best_device_id]);
+        res_ptr = ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, best_device_id);
     }
     auto label = std::make_shared<SpecResLabel>(res_ptr);
     task->label() = label;
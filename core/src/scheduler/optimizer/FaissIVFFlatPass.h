@@ -40,8 +40,6 @@ class FaissIVFFlatPass : public Pass, public GpuSearchResHandler {
     bool
     Run(const TaskPtr& task) override;
 
- private:
-    int64_t count_ = 0;
 };
 
 using FaissIVFFlatPassPtr = std::shared_ptr<FaissIVFFlatPass>;
@@ -11,6 +11,7 @@
 #ifdef MILVUS_GPU_VERSION
 #include "scheduler/optimizer/FaissIVFPQPass.h"
 #include "cache/GpuCacheMgr.h"
+#include "db/engine/ExecutionEngineImpl.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/Utils.h"
 #include "scheduler/task/SearchTask.h"
@@ -50,23 +51,32 @@ FaissIVFPQPass::Run(const TaskPtr& task) {
     }
 
     auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    if (search_task->file_->engine_type_ == (int)engine::EngineType::FAISS_PQ_FASTSCAN) {
+        // the 4 bits fast scan has no gpu index
+        SERVER_LOG_DEBUG << "FaissIVFPQPass: pq fast scan, specify cpu to search!";
+        auto label = std::make_shared<SpecResLabel>(ResMgrInst::GetInstance()->GetResource("cpu"));
+        task->label() = label;
+        return true;
+    }
     if (search_task->file_->engine_type_ != (int)engine::EngineType::FAISS_PQ) {
         return false;
     }
 
     auto search_job = std::static_pointer_cast<SearchJob>(search_task->job_.lock());
     ResourcePtr res_ptr;
-    if (!gpu_enable_) {
+    if (engine::ExecutionEngineImpl::IsRotatedIndex(search_task->file_->location_)) {
+        SERVER_LOG_DEBUG << "FaissIVFPQPass: rotated index, specify cpu to search!";
+        res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
+    } else if (!gpu_enable_) {
         SERVER_LOG_DEBUG << "FaissIVFPQPass: gpu disable, specify cpu to search!";
         res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
     } else if (search_job->nq() < threshold_) {
         SERVER_LOG_DEBUG << "FaissIVFPQPass: nq < gpu_search_threshold, specify cpu to search!";
         res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
     } else {
-        auto best_device_id = count_ % search_gpus_.size();
+        auto best_device_id = PickSearchGpu(*search_task->file_);
         SERVER_LOG_DEBUG << "FaissIVFPQPass: nq > gpu_search_threshold, specify gpu" << best_device_id << " to search!";
-        ++count_;
-        res_ptr = ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, search_gpus_[best_device_id]);
+        res_ptr = ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, best_device_id);
     }
     auto label = std::make_shared<SpecResLabel>(res_ptr);
     task->label() = label;
@@ -40,8 +40,6 @@ class FaissIVFPQPass : public Pass, public GpuSearchResHandler {
     bool
     Run(const TaskPtr& task) override;
 
- private:
-    int64_t count_ = 0;
 };
 
 using FaissIVFPQPassPtr = std::shared_ptr<FaissIVFPQPass>;
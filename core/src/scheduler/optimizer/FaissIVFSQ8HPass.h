@@ -40,8 +40,6 @@ class FaissIVFSQ8HPass : public Pass, public GpuSearchResHandler {
     bool
     Run(const TaskPtr& task) override;
 
- private:
-    int64_t count_ = 0;
 };
 
 using FaissIVFSQ8HPassPtr = std::shared_ptr<FaissIVFSQ8HPass>;
@@ -40,8 +40,6 @@ class FaissIVFSQ8Pass : public Pass, public GpuSearchResHandler {
     bool
     Run(const TaskPtr& task) override;
 
- private:
-    int64_t count_ = 0;
 };
 
 using FaissIVFSQ8PassPtr = std::shared_ptr<FaissIVFSQ8Pass>;
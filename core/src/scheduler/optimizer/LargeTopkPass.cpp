@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#include "scheduler/optimizer/LargeTopkPass.h"
+#include "db/engine/ExecutionEngine.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+void
+LargeTopkPass::Init() {
+}
+
+bool
+LargeTopkPass::Run(const TaskPtr& task) {
+    if (task->Type() != TaskType::SearchTask) {
+        return false;
+    }
+
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    auto search_job = std::static_pointer_cast<SearchJob>(search_task->job_.lock());
+    if (search_job == nullptr || (search_job->topk() <= engine::GPU_MAX_TOPK && !search_job->by_range())) {
+        return false;
+    }
+
+    // range search is answered by cpu indexes only
+    if (search_job->by_range()) {
+        SERVER_LOG_DEBUG << "LargeTopkPass: range search, specify cpu to search!";
+    } else {
+        SERVER_LOG_DEBUG << "LargeTopkPass: topk > " << engine::GPU_MAX_TOPK << ", specify cpu to search!";
+    }
+    auto res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
+    auto label = std::make_shared<SpecResLabel>(res_ptr);
+    task->label() = label;
+    return true;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
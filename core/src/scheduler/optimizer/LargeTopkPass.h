@@ -0,0 +1,38 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#pragma once
+
+#include <memory>
+
+#include "scheduler/optimizer/Pass.h"
+
+namespace milvus {
+namespace scheduler {
+
+// a gpu selects at most GPU_MAX_TOPK results of a query, searches asking for more run on cpu whatever the index
+class LargeTopkPass : public Pass {
+ public:
+    LargeTopkPass() = default;
+
+ public:
+    void
+    Init() override;
+
+    bool
+    Run(const TaskPtr& task) override;
+};
+
+using LargeTopkPassPtr = std::shared_ptr<LargeTopkPass>;
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
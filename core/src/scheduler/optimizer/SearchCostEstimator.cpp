@@ -0,0 +1,209 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/optimizer/SearchCostEstimator.h"
+#include "cache/CpuCacheMgr.h"
+#include "cache/GpuCacheMgr.h"
+#include "db/engine/ExecutionEngine.h"
+#include "db/engine/SegmentTombstone.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+// weight of the latest sample in learned throughput
+constexpr double THROUGHPUT_SMOOTH_FACTOR = 0.2;
+
+// files that are gone are never searched again, the coldest entry is dropped once there are this many
+constexpr size_t MAX_HOTNESS_FILES = 65536;
+
+double
+Decayed(double queries, std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    double seconds = std::chrono::duration<double>(to - from).count();
+    return queries * std::exp2(-seconds / HOTNESS_HALF_LIFE);
+}
+}  // namespace
+
+SearchCostEstimator&
+SearchCostEstimator::GetInstance() {
+    static SearchCostEstimator instance;
+    return instance;
+}
+
+double
+SearchCostEstimator::Workload(const engine::meta::TableFileSchema& file, uint64_t nq, uint64_t topk,
+                              uint64_t nprobe) {
+    // deleted vectors are skipped while scanning
+    double rows = file.row_count_;
+    if (auto tombstone = engine::SegmentTombstoneMgr::GetInstance().GetTombstone(file.location_)) {
+        rows = std::max(rows - tombstone->Count(), 0.0);
+    }
+    double dim = file.dimension_;
+    double nlist = std::max(file.nlist_, 1);
+    double scan = rows * dim;
+
+    // ivf indexes only scan nprobe lists, after comparing with all centroids
+    switch (static_cast<engine::EngineType>(file.engine_type_)) {
+        case engine::EngineType::FAISS_IDMAP:
+            break;
+        case engine::EngineType::FAISS_IVFFLAT:
+            scan = scan * std::min(nprobe / nlist, 1.0) + nlist * dim;
+            break;
+        case engine::EngineType::FAISS_IVFSQ8:
+        case engine::EngineType::FAISS_IVFSQ8H:
+            scan = scan * std::min(nprobe / nlist, 1.0) * 0.5 + nlist * dim;
+            break;
+        case engine::EngineType::FAISS_PQ:
+            scan = scan * std::min(nprobe / nlist, 1.0) * 0.25 + nlist * dim;
+            break;
+        case engine::EngineType::FAISS_PQ_FASTSCAN:
+            // a block of codes is scanned with a few simd lookups, about a quarter of the pq scan
+            scan = scan * std::min(nprobe / nlist, 1.0) * 0.0625 + nlist * dim;
+            break;
+        case engine::EngineType::FAISS_IVFFP16:
+            scan = scan * std::min(nprobe / nlist, 1.0) * 0.75 + nlist * dim;
+            break;
+        case engine::EngineType::FAISS_FLAT_FP16:
+            scan = scan * 0.75;
+            break;
+        case engine::EngineType::DISKANN:
+            // a walk of nprobe nodes whatever the rows, every node has an exact distance and pq lookups of its 64
+            // neighbors, 4 dims per code byte
+            scan = std::max<double>(nprobe, topk) * dim * 17;
+            break;
+        default:
+            break;
+    }
+
+    // keeping topk heap of every query
+    double reduce = topk * std::log2(topk + 1.0);
+    return nq * (scan + reduce);
+}
+
+double
+SearchCostEstimator::FinishTime(const ResourcePtr& resource, const engine::meta::TableFileSchema& file, uint64_t nq,
+                                uint64_t topk, uint64_t nprobe) {
+    double finish = 0;
+
+    // tasks queued or running in the resource, spread over its executors
+    auto& task_table = resource->task_table();
+    uint64_t waiting = task_table.NumOfState(TaskTableItemState::START) +
+                       task_table.NumOfState(TaskTableItemState::LOADED) +
+                       task_table.NumOfState(TaskTableItemState::EXECUTING);
+    finish += static_cast<double>(waiting) * resource->TaskAvgCost() / resource->NumOfExecutors();
+
+    // every resource reads the file into cpu cache first, gpu copies it once more
+    if (!cache::CpuCacheMgr::GetInstance()->ItemExists(file.location_)) {
+        finish += file.file_size_ / DiskBandwidth();
+    }
+    if (resource->type() == ResourceType::GPU) {
+#ifdef MILVUS_GPU_VERSION
+        if (!cache::GpuCacheMgr::GetInstance(resource->device_id())->ItemExists(file.location_)) {
+            finish += file.file_size_ / PCIE_BANDWIDTH;
+        }
+#endif
+        finish += GPU_TASK_OVERHEAD;
+    }
+
+    finish += Workload(file, nq, topk, nprobe) / Throughput(resource->type());
+    return finish;
+}
+
+void
+SearchCostEstimator::Feedback(ResourceType type, double workload, double cost) {
+    if (workload <= 0) {
+        return;
+    }
+
+    // tasks finished within a millisecond have no meaningful cost
+    double sample = workload / std::max(cost, 1.0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = throughput_.find(type);
+    if (iter == throughput_.end()) {
+        throughput_[type] = sample;
+    } else {
+        iter->second = iter->second * (1 - THROUGHPUT_SMOOTH_FACTOR) + sample * THROUGHPUT_SMOOTH_FACTOR;
+    }
+}
+
+double
+SearchCostEstimator::Throughput(ResourceType type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = throughput_.find(type);
+    if (iter != throughput_.end()) {
+        return iter->second;
+    }
+    return type == ResourceType::GPU ? GPU_THROUGHPUT_DEFAULT : CPU_THROUGHPUT_DEFAULT;
+}
+
+void
+SearchCostEstimator::DiskFeedback(double bytes, double cost) {
+    if (bytes <= 0) {
+        return;
+    }
+
+    double sample = bytes / std::max(cost, 1.0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    disk_bandwidth_ = disk_bandwidth_ * (1 - THROUGHPUT_SMOOTH_FACTOR) + sample * THROUGHPUT_SMOOTH_FACTOR;
+}
+
+double
+SearchCostEstimator::DiskBandwidth() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return disk_bandwidth_;
+}
+
+void
+SearchCostEstimator::SearchFeedback(size_t file_id, uint64_t nq) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = hotness_.find(file_id);
+    if (iter == hotness_.end()) {
+        if (hotness_.size() >= MAX_HOTNESS_FILES) {
+            hotness_.erase(hotness_rank_.begin()->second);
+            hotness_rank_.erase(hotness_rank_.begin());
+        }
+        iter = hotness_.emplace(file_id, FileHotness()).first;
+    } else {
+        hotness_rank_.erase(iter->second.rank_);
+    }
+
+    auto& hotness = iter->second;
+    hotness.queries_ = Decayed(hotness.queries_, hotness.time_, now) + nq;
+    hotness.time_ = now;
+    double seconds = std::chrono::duration<double>(now - hotness_epoch_).count();
+    hotness.rank_ = hotness_rank_.emplace(std::log2(hotness.queries_) + seconds / HOTNESS_HALF_LIFE, file_id);
+}
+
+double
+SearchCostEstimator::Hotness(size_t file_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = hotness_.find(file_id);
+    if (iter == hotness_.end()) {
+        return 0;
+    }
+    return Decayed(iter->second.queries_, iter->second.time_, std::chrono::steady_clock::now());
+}
+
+void
+SearchCostEstimator::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    throughput_.clear();
+    disk_bandwidth_ = DISK_BANDWIDTH;
+    hotness_.clear();
+    hotness_rank_.clear();
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,111 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "db/meta/MetaTypes.h"
+#include "scheduler/resource/Resource.h"
+
+namespace milvus {
+namespace scheduler {
+
+// throughput and bandwidth used before any task is observed, in workload or bytes per millisecond
+constexpr double CPU_THROUGHPUT_DEFAULT = 2.0e6;
+constexpr double GPU_THROUGHPUT_DEFAULT = 2.0e7;
+constexpr double DISK_BANDWIDTH = 5.0e5;
+constexpr double PCIE_BANDWIDTH = 6.0e6;
+constexpr double GPU_TASK_OVERHEAD = 2.0;  // ms, kernel launch and result copy of a task
+constexpr int64_t HOTNESS_HALF_LIFE = 600;  // seconds
+
+/*
+ * Estimate when a search task would finish on a resource;
+ * Throughput of each resource type is learned from executed tasks;
+ */
+class SearchCostEstimator {
+ public:
+    static SearchCostEstimator&
+    GetInstance();
+
+    /*
+     * Computation of searching nq vectors in the file, in vector dimensions scanned;
+     */
+    static double
+    Workload(const engine::meta::TableFileSchema& file, uint64_t nq, uint64_t topk, uint64_t nprobe);
+
+    /*
+     * Expected milliseconds from now until the search finishes on the resource;
+     * Sum of waiting tasks in the resource, loading the file if not cached there, and the search itself;
+     */
+    double
+    FinishTime(const ResourcePtr& resource, const engine::meta::TableFileSchema& file, uint64_t nq, uint64_t topk,
+               uint64_t nprobe);
+
+    /*
+     * Record the search time of an executed task, cost in milliseconds;
+     */
+    void
+    Feedback(ResourceType type, double workload, double cost);
+
+    double
+    Throughput(ResourceType type);
+
+    /*
+     * Record reading a file from disk, cost in milliseconds;
+     */
+    void
+    DiskFeedback(double bytes, double cost);
+
+    double
+    DiskBandwidth();
+
+    /*
+     * Record a search of nq queries on the file;
+     */
+    void
+    SearchFeedback(size_t file_id, uint64_t nq);
+
+    /*
+     * Queries searched on the file lately, each of them counts half after HOTNESS_HALF_LIFE;
+     */
+    double
+    Hotness(size_t file_id);
+
+    void
+    Reset();
+
+ private:
+    SearchCostEstimator() = default;
+
+ private:
+    std::mutex mutex_;
+    std::map<ResourceType, double> throughput_;
+    double disk_bandwidth_ = DISK_BANDWIDTH;
+
+    // every file decays at the same rate, so files ranked by log2(queries) + time / HOTNESS_HALF_LIFE keep their
+    // order over time, the first of hotness_rank_ is the coldest file
+    using HotnessRank = std::multimap<double, size_t>;
+    struct FileHotness {
+        double queries_ = 0;
+        std::chrono::steady_clock::time_point time_;
+        HotnessRank::iterator rank_;
+    };
+    std::unordered_map<size_t, FileHotness> hotness_;
+    HotnessRank hotness_rank_;
+    std::chrono::steady_clock::time_point hotness_epoch_ = std::chrono::steady_clock::now();
+};
+
+}  // namespace scheduler
+}  // namespace milvus
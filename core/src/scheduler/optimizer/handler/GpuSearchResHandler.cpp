@@ -14,6 +14,8 @@
 #include <string>
 #include <vector>
 
+#include "cache/GpuCacheMgr.h"
+#include "cache/GpuMemoryArbiter.h"
 #include "server/Config.h"
 
 namespace milvus {
@@ -83,6 +85,29 @@ GpuSearchResHandler::AddGpuSearchResListener() {
                             lambda_gpu_search_res);
 }
 
+int64_t
+GpuSearchResHandler::PickSearchGpu(const engine::meta::TableFileSchema& file) {
+    for (auto gpu_id : search_gpus_) {
+        if (cache::GpuCacheMgr::GetInstance(gpu_id)->ItemExists(file.location_)) {
+            return gpu_id;
+        }
+    }
+
+    // a file keeps to one gpu, unless that one would have to evict or wait while another has room for it
+    auto preferred = search_gpus_[file.id_ % search_gpus_.size()];
+    auto& arbiter = cache::GpuMemoryArbiter::GetInstance();
+    auto size = static_cast<int64_t>(file.file_size_);
+    auto available = arbiter.Available(preferred);
+    if (available >= 0 && available < size) {
+        for (auto gpu_id : search_gpus_) {
+            if (arbiter.Available(gpu_id) >= size) {
+                return gpu_id;
+            }
+        }
+    }
+    return preferred;
+}
+
 }  // namespace scheduler
 }  // namespace milvus
 #endif
@@ -11,6 +11,7 @@
 #ifdef MILVUS_GPU_VERSION
 #pragma once
 
+#include "db/meta/MetaTypes.h"
 #include "scheduler/optimizer/handler/GpuResourcesHandler.h"
 
 #include <limits>
@@ -39,6 +40,14 @@ class GpuSearchResHandler : virtual public GpuResourcesHandler {
     void
     AddGpuSearchResListener();
 
+    /*
+     * Pick the search gpu for a file;
+     * Prefer the gpu whose cache holds the file, otherwise a file is always mapped to the same gpu,
+     * so files are split among gpu caches instead of being copied into each of them;
+     */
+    int64_t
+    PickSearchGpu(const engine::meta::TableFileSchema& file);
+
  protected:
     int64_t threshold_ = std::numeric_limits<int64_t>::max();
     std::vector<int64_t> search_gpus_;
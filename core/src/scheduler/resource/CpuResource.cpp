@@ -10,7 +10,13 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/resource/CpuResource.h"
+#include "scheduler/OmpBudget.h"
+#include "scheduler/Utils.h"
+#include "server/Config.h"
+#include "utils/Log.h"
 
+#include <omp.h>
+#include <algorithm>
 #include <utility>
 
 namespace milvus {
@@ -24,6 +30,27 @@ operator<<(std::ostream& out, const CpuResource& resource) {
 
 CpuResource::CpuResource(std::string name, uint64_t device_id, bool enable_executor)
     : Resource(std::move(name), ResourceType::CPU, device_id, enable_executor) {
+    server::Config& config = server::Config::GetInstance();
+
+    // in numa mode the device id is the numa node, threads of the resource run on cpus of the node only
+    bool numa_enable = false;
+    config.GetEngineConfigNumaEnable(numa_enable);
+    if (numa_enable) {
+        auto nodes = get_numa_nodes();
+        if (nodes.size() > 1 && device_id < nodes.size()) {
+            cpus_ = nodes[device_id];
+            omp_thread_ = std::max(1, static_cast<int32_t>(cpus_.size()));
+            SERVER_LOG_DEBUG << name_ << " serves numa node " << device_id << " with " << cpus_.size() << " cpus";
+        }
+    }
+
+    int64_t executor_num = 1;
+    config.GetEngineConfigCpuExecutorNum(executor_num);
+    if (enable_executor && executor_num > 1) {
+        // openmp threads of workers are split by OmpBudget among the tasks running together
+        executor_pool_ = std::make_shared<WorkStealingPool>(executor_num, [this] { InitThread(); });
+        SERVER_LOG_DEBUG << name_ << " executes tasks with " << executor_num << " workers";
+    }
 }
 
 void
@@ -33,8 +60,21 @@ CpuResource::LoadFile(TaskPtr task) {
 
 void
 CpuResource::Process(TaskPtr task) {
+    OmpBudget::Share share;
     task->Execute();
 }
 
+void
+CpuResource::InitThread() {
+    if (cpus_.empty()) {
+        return;
+    }
+    // openmp threads started by this thread inherit the binding
+    if (!bind_current_thread(cpus_)) {
+        SERVER_LOG_WARNING << name_ << " fails to bind thread to numa node " << device_id_;
+    }
+    omp_set_num_threads(omp_thread_);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
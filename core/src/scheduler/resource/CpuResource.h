@@ -12,6 +12,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Resource.h"
 
@@ -31,6 +32,14 @@ class CpuResource : public Resource {
 
     void
     Process(TaskPtr task) override;
+
+    void
+    InitThread() override;
+
+ private:
+    // cpus of the numa node this resource serves, empty to run on any cpu
+    std::vector<int64_t> cpus_;
+    int32_t omp_thread_ = 0;
 };
 
 }  // namespace scheduler
@@ -10,6 +10,14 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/resource/GpuResource.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+#ifdef MILVUS_GPU_VERSION
+#include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
+#endif
+
+#include <utility>
 
 namespace milvus {
 namespace scheduler {
@@ -22,6 +30,20 @@ operator<<(std::ostream& out, const GpuResource& resource) {
 
 GpuResource::GpuResource(std::string name, uint64_t device_id, bool enable_executor)
     : Resource(std::move(name), ResourceType::GPU, device_id, enable_executor) {
+    int64_t stream_num = 1;
+#ifdef MILVUS_GPU_VERSION
+    // as many workers as faiss resources the device was given, stream_num may have changed since
+    stream_num = knowhere::FaissGpuResourceMgr::GetInstance().GetResNum(device_id);
+    if (stream_num <= 0) {
+        stream_num = 1;
+        server::Config::GetInstance().GetGpuResourceConfigStreamNum(stream_num);
+    }
+#endif
+    if (enable_executor && stream_num > 1) {
+        // a task executing per stream, the copies of one task overlap the search of another
+        executor_pool_ = std::make_shared<WorkStealingPool>(stream_num);
+        SERVER_LOG_DEBUG << name_ << " executes tasks with " << stream_num << " workers";
+    }
 }
 
 void
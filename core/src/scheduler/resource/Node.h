@@ -48,6 +48,9 @@ class Node : public interface::dumpable {
     void
     AddNeighbour(const NeighbourNodePtr& neighbour_node, Connection& connection);
 
+    void
+    DelNeighbour(const NeighbourNodePtr& neighbour_node);
+
     std::vector<Neighbour>
     GetNeighbours();
 
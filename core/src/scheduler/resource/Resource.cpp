@@ -58,6 +58,9 @@ Resource::Start() {
     running_ = true;
     loader_thread_ = std::thread(&Resource::loader_function, this);
     if (enable_executor_) {
+        if (executor_pool_) {
+            executor_pool_->Start();
+        }
         executor_thread_ = std::thread(&Resource::executor_function, this);
     }
 }
@@ -70,6 +73,9 @@ Resource::Stop() {
     if (enable_executor_) {
         WakeupExecutor();
         executor_thread_.join();
+        if (executor_pool_) {
+            executor_pool_->Stop();
+        }
     }
 }
 
@@ -98,10 +104,11 @@ Resource::Dump() const {
         {"name", name_},
         {"type", ToString(type_)},
         {"task_average_cost", TaskAvgCost()},
-        {"task_total_cost", total_cost_},
-        {"total_tasks", total_task_},
+        {"task_total_cost", total_cost_.load()},
+        {"total_tasks", total_task_.load()},
         {"running", running_},
         {"enable_executor", enable_executor_},
+        {"executor_workers", executor_pool_ ? executor_pool_->NumOfWorkers() : 1},
     };
     return ret;
 }
@@ -134,6 +141,12 @@ Resource::pick_task_execute() {
             }
         }
 
+        // background tasks never occupy all executors, one is reserved for higher classes
+        if (task_table_[index]->priority == JobPriority::LOW && NumOfExecutors() > 1 &&
+            task_table_.NumOfExecuting(JobPriority::LOW) >= NumOfExecutors() - 1) {
+            continue;
+        }
+
         if (task_table_.Execute(index)) {
             return task_table_.at(index);
         }
@@ -153,6 +166,7 @@ Resource::pick_task_execute() {
 
 void
 Resource::loader_function() {
+    InitThread();
     while (running_) {
         std::unique_lock<std::mutex> lock(load_mutex_);
         load_cv_.wait(lock, [&] { return load_flag_; });
@@ -183,6 +197,7 @@ Resource::loader_function() {
 
 void
 Resource::executor_function() {
+    InitThread();
     if (subscriber_) {
         auto event = std::make_shared<StartUpEvent>(shared_from_this());
         subscriber_(std::static_pointer_cast<Event>(event));
@@ -193,31 +208,48 @@ Resource::executor_function() {
         exec_flag_ = false;
         lock.unlock();
         while (true) {
+            if (executor_pool_) {
+                // leave tasks in table for other resources until a worker is free
+                executor_pool_->WaitForVacancy();
+                if (!running_) {
+                    break;
+                }
+            }
             auto task_item = pick_task_execute();
             if (task_item == nullptr) {
                 break;
             }
-            auto start = get_current_timestamp();
-            Process(task_item->task);
-            auto finish = get_current_timestamp();
-            ++total_task_;
-            total_cost_ += finish - start;
-
-            task_item->Executed();
-
-            if (task_item->task->Type() == TaskType::BuildIndexTask) {
-                BuildMgrInst::GetInstance()->Put();
-                ResMgrInst::GetInstance()->GetResource("cpu")->WakeupLoader();
-                ResMgrInst::GetInstance()->GetResource("disk")->WakeupLoader();
-            }
-
-            if (subscriber_) {
-                auto event = std::make_shared<FinishTaskEvent>(shared_from_this(), task_item);
-                subscriber_(std::static_pointer_cast<Event>(event));
+            if (executor_pool_) {
+                executor_pool_->Enqueue([this, task_item] { execute_task(task_item); });
+            } else {
+                execute_task(task_item);
             }
         }
     }
 }
 
+void
+Resource::execute_task(const TaskTableItemPtr& task_item) {
+    // the build leaves the load stage once it starts, the next raw file loads while this one builds
+    if (task_item->task->Type() == TaskType::BuildIndexTask) {
+        BuildMgrInst::GetInstance()->Put();
+        ResMgrInst::GetInstance()->GetResource("cpu")->WakeupLoader();
+        ResMgrInst::GetInstance()->GetResource("disk")->WakeupLoader();
+    }
+
+    auto start = get_current_timestamp();
+    Process(task_item->task);
+    auto finish = get_current_timestamp();
+    ++total_task_;
+    total_cost_ += finish - start;
+
+    task_item->Executed();
+
+    if (subscriber_) {
+        auto event = std::make_shared<FinishTaskEvent>(shared_from_this(), task_item);
+        subscriber_(std::static_pointer_cast<Event>(event));
+    }
+}
+
 }  // namespace scheduler
 }  // namespace milvus
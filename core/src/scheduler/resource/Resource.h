@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -20,6 +21,7 @@
 #include <vector>
 
 #include "../TaskTable.h"
+#include "../WorkStealingPool.h"
 #include "../event/Event.h"
 #include "../event/FinishTaskEvent.h"
 #include "../event/LoadCompletedEvent.h"
@@ -101,6 +103,11 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
         return enable_executor_;
     }
 
+    inline uint64_t
+    NumOfExecutors() const {
+        return executor_pool_ ? executor_pool_->NumOfWorkers() : 1;
+    }
+
     // TODO(wxyu): const
     uint64_t
     NumOfTaskToExec();
@@ -139,6 +146,20 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     virtual void
     Process(TaskPtr task) = 0;
 
+    /*
+     * Called first in loader and executor thread;
+     */
+    virtual void
+    InitThread() {
+    }
+
+ protected:
+    /*
+     * Set by inherit class to execute tasks in parallel;
+     * Executor thread picks tasks and hands them to the pool;
+     */
+    WorkStealingPoolPtr executor_pool_ = nullptr;
+
  private:
     /*
      * Pick one task to load;
@@ -167,6 +188,13 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     void
     executor_function();
 
+    /*
+     * Process a picked task and notify the finish;
+     * Called by executor thread or pool workers;
+     */
+    void
+    execute_task(const TaskTableItemPtr& task_item);
+
  protected:
     uint64_t device_id_;
     std::string name_;
@@ -176,8 +204,8 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
 
     TaskTable task_table_;
 
-    uint64_t total_cost_ = 0;
-    uint64_t total_task_ = 0;
+    std::atomic<uint64_t> total_cost_{0};
+    std::atomic<uint64_t> total_task_{0};
 
     std::function<void(EventPtr)> subscriber_ = nullptr;
 
@@ -10,15 +10,23 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/task/BuildIndexTask.h"
+#include "cache/CpuCacheMgr.h"
+#include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/engine/SegmentAttrs.h"
+#include "db/engine/SegmentTimeRange.h"
+#include "db/engine/SegmentTombstone.h"
 #include "metrics/Metrics.h"
+#include "scheduler/SchedInst.h"
 #include "scheduler/job/BuildIndexJob.h"
+#include "storage/IORateLimiter.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
 #include <fiu-local.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
@@ -26,6 +34,128 @@
 namespace milvus {
 namespace scheduler {
 
+namespace {
+
+// step 5 and 6 of a build, run by the serialize stage of BuildMgr while the executor builds the next index
+void
+SaveIndexFile(const BuildIndexJobPtr& build_index_job, const TableFileSchemaPtr& origin,
+              const ExecutionEnginePtr& index, engine::meta::TableFileSchema table_file) {
+    engine::meta::MetaPtr meta_ptr = build_index_job->meta();
+    Status status;
+
+    // step 5: save index file
+    try {
+        fiu_do_on("XBuildIndexTask.Execute.throw_std_exception", throw std::exception());
+        storage::BackgroundIOScope background_io;
+        status = index->Serialize();
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << status.message();
+        }
+    } catch (std::exception& ex) {
+        std::string msg = "Serialize index encounter exception: " + std::string(ex.what());
+        ENGINE_LOG_ERROR << msg;
+        status = Status(DB_ERROR, msg);
+    }
+
+    fiu_do_on("XBuildIndexTask.Execute.save_index_file_success", status = Status::OK());
+    if (!status.ok()) {
+        // if failed to serialize index file to disk
+        // typical error: out of disk space, out of memory or permition denied
+        table_file.file_type_ = engine::meta::TableFileSchema::TO_DELETE;
+        status = meta_ptr->UpdateTableFile(table_file);
+        ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << table_file.file_id_ << " to to_delete";
+
+        ENGINE_LOG_ERROR << "Failed to persist index file: " << table_file.location_
+                         << ", possible out of disk space or memory";
+
+        build_index_job->BuildIndexDone(origin->id_);
+        build_index_job->GetStatus() = status;
+        return;
+    }
+
+    // step 6: update meta
+    table_file.file_type_ = engine::meta::TableFileSchema::INDEX;
+    table_file.file_size_ = index->PhysicalSize();
+    table_file.row_count_ = index->Count();
+
+    auto origin_file = *origin;
+    origin_file.file_type_ = engine::meta::TableFileSchema::BACKUP;
+
+    engine::meta::TableFilesSchema update_files = {table_file, origin_file};
+
+    // an index of an older type, searched while its segment is rebuilt, is replaced in the same update
+    auto replaced = build_index_job->ReplacedFile(origin->id_);
+    if (replaced != nullptr) {
+        auto replaced_file = *replaced;
+        replaced_file.file_type_ = engine::meta::TableFileSchema::TO_DELETE;
+        update_files.push_back(replaced_file);
+    }
+
+    // attributes and insert time of the vectors go with them to the index file
+    auto attrs = engine::SegmentAttrsMgr::GetInstance().GetAttrs(origin_file.location_);
+    if (status.ok() && attrs != nullptr) {
+        status = attrs->Write(table_file.location_);
+    }
+    auto time_range = engine::SegmentTimeRangeMgr::GetInstance().GetTimeRange(origin_file.location_);
+    if (status.ok() && time_range != nullptr) {
+        status = time_range->Write(table_file.location_);
+    }
+    if (status.ok()) {
+        status = engine::utils::WriteIndexOrigin(table_file.location_, origin_file.file_id_);
+    }
+
+    if (status.ok()) {  // makesure index file is sucessfully serialized to disk
+        // the index is built from all vectors of the origin file, the deleted ones are deleted from it too;
+        // no deletion comes in between until it replaces the origin file
+        auto& tombstone_mgr = engine::SegmentTombstoneMgr::GetInstance();
+        std::lock_guard<std::mutex> lock(tombstone_mgr.DeleteMutex());
+        auto tombstone = tombstone_mgr.GetTombstone(origin_file.location_);
+        if (tombstone != nullptr) {
+            status = tombstone_mgr.Delete(table_file.location_, tombstone->Ids());
+        }
+        // deletions since the replaced index was built went to it only
+        if (status.ok() && replaced != nullptr) {
+            auto replaced_tombstone = tombstone_mgr.GetTombstone(replaced->location_);
+            if (replaced_tombstone != nullptr) {
+                status = tombstone_mgr.Delete(table_file.location_, replaced_tombstone->Ids());
+            }
+        }
+        if (status.ok()) {
+            status = meta_ptr->UpdateTableFiles(update_files);
+        }
+    }
+
+    fiu_do_on("XBuildIndexTask.Execute.update_table_file_fail", status = Status(SERVER_UNEXPECTED_ERROR, ""));
+    if (status.ok()) {
+        ENGINE_LOG_DEBUG << "New index file " << table_file.file_id_ << " of size " << index->PhysicalSize()
+                         << " bytes"
+                         << " from file " << origin_file.file_id_;
+        // a backup file isn't searched, an index holding the vectors as well (IDMAP, IVFFLAT) would take the
+        // cache twice for one segment, it is loaded again from disk if the index is dropped
+        cache::CpuCacheMgr::GetInstance()->EraseItem(origin_file.location_);
+        engine::utils::RemoveIngestIndex(origin_file.location_);
+        if (replaced != nullptr) {
+            cache::CpuCacheMgr::GetInstance()->EraseItem(replaced->location_);
+        }
+        if (build_index_job->options().insert_cache_immediately_) {
+            index->Cache();
+        }
+    } else {
+        // failed to update meta, mark the new file as to_delete, don't delete old file; a backup file rebuilt
+        // for a new index type stays a backup, its old index is still searched
+        origin_file.file_type_ = origin->file_type_;
+        table_file.file_type_ = engine::meta::TableFileSchema::TO_DELETE;
+        engine::meta::TableFilesSchema rollback_files = {origin_file, table_file};
+        status = meta_ptr->UpdateTableFiles(rollback_files);
+        ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << origin_file.file_id_
+                         << " to to_index, file: " << table_file.file_id_ << " to to_delete";
+    }
+
+    build_index_job->BuildIndexDone(origin->id_);
+}
+
+}  // namespace
+
 XBuildIndexTask::XBuildIndexTask(TableFileSchemaPtr file, TaskLabelPtr label)
     : Task(TaskType::BuildIndexTask, std::move(label)), file_(file) {
     if (file_) {
@@ -159,71 +289,11 @@ XBuildIndexTask::Execute() {
             return;
         }
 
-        // step 5: save index file
-        try {
-            fiu_do_on("XBuildIndexTask.Execute.throw_std_exception", throw std::exception());
-            status = index->Serialize();
-            if (!status.ok()) {
-                ENGINE_LOG_ERROR << status.message();
-            }
-        } catch (std::exception& ex) {
-            std::string msg = "Serialize index encounter exception: " + std::string(ex.what());
-            ENGINE_LOG_ERROR << msg;
-            status = Status(DB_ERROR, msg);
-        }
-
-        fiu_do_on("XBuildIndexTask.Execute.save_index_file_success", status = Status::OK());
-        if (!status.ok()) {
-            // if failed to serialize index file to disk
-            // typical error: out of disk space, out of memory or permition denied
-            table_file.file_type_ = engine::meta::TableFileSchema::TO_DELETE;
-            status = meta_ptr->UpdateTableFile(table_file);
-            ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << table_file.file_id_ << " to to_delete";
-
-            ENGINE_LOG_ERROR << "Failed to persist index file: " << table_file.location_
-                             << ", possible out of disk space or memory";
-
-            build_index_job->BuildIndexDone(to_index_id_);
-            build_index_job->GetStatus() = status;
-            to_index_engine_ = nullptr;
-            return;
-        }
-
-        // step 6: update meta
-        table_file.file_type_ = engine::meta::TableFileSchema::INDEX;
-        table_file.file_size_ = index->PhysicalSize();
-        table_file.row_count_ = index->Count();
-
-        auto origin_file = *file_;
-        origin_file.file_type_ = engine::meta::TableFileSchema::BACKUP;
-
-        engine::meta::TableFilesSchema update_files = {table_file, origin_file};
-
-        if (status.ok()) {  // makesure index file is sucessfully serialized to disk
-            status = meta_ptr->UpdateTableFiles(update_files);
-        }
-
-        fiu_do_on("XBuildIndexTask.Execute.update_table_file_fail", status = Status(SERVER_UNEXPECTED_ERROR, ""));
-        if (status.ok()) {
-            ENGINE_LOG_DEBUG << "New index file " << table_file.file_id_ << " of size " << index->PhysicalSize()
-                             << " bytes"
-                             << " from file " << origin_file.file_id_;
-            if (build_index_job->options().insert_cache_immediately_) {
-                index->Cache();
-            }
-        } else {
-            // failed to update meta, mark the new file as to_delete, don't delete old file
-            origin_file.file_type_ = engine::meta::TableFileSchema::TO_INDEX;
-            status = meta_ptr->UpdateTableFile(origin_file);
-            ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << origin_file.file_id_ << " to to_index";
-
-            table_file.file_type_ = engine::meta::TableFileSchema::TO_DELETE;
-            status = meta_ptr->UpdateTableFile(table_file);
-            ENGINE_LOG_DEBUG << "Failed to up  date file to index, mark file: " << table_file.file_id_
-                             << " to to_delete";
-        }
-
-        build_index_job->BuildIndexDone(to_index_id_);
+        // the executor is free for the next build once the index is handed over
+        auto origin = file_;
+        BuildMgrInst::GetInstance()->Serialize([build_index_job, origin, index, table_file]() {
+            SaveIndexFile(build_index_job, origin, index, table_file);
+        });
     }
 
     rc.ElapseFromBegin("totally cost");
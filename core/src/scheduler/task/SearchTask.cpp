@@ -11,67 +11,139 @@
 
 #include <fiu-local.h>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <utility>
+#include <vector>
 
+#include "cache/CpuCacheMgr.h"
+#include "db/SegmentOwnership.h"
+#include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/engine/SegmentAttrs.h"
+#include "db/engine/SegmentTombstone.h"
 #include "metrics/Metrics.h"
+#include "scheduler/ResultBufferPool.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/job/SearchJob.h"
+#include "scheduler/optimizer/SearchCostEstimator.h"
 #include "scheduler/task/SearchTask.h"
+#include "server/Config.h"
 #include "utils/Log.h"
+#include "utils/ThreadPool.h"
 #include "utils/TimeRecorder.h"
 
+#ifdef MILVUS_GPU_VERSION
+#include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
+#endif
+
 namespace milvus {
 namespace scheduler {
 
+// reduce is parallelized across queries only when nq * topk reaches the threshold
 static constexpr size_t PARALLEL_REDUCE_THRESHOLD = 10000;
-static constexpr size_t PARALLEL_REDUCE_BATCH = 1000;
-
-// TODO(wxyu): remove unused code
-// bool
-// NeedParallelReduce(uint64_t nq, uint64_t topk) {
-//    server::ServerConfig &config = server::ServerConfig::GetInstance();
-//    server::ConfigNode &db_config = config.GetConfig(server::CONFIG_DB);
-//    bool need_parallel = db_config.GetBoolValue(server::CONFIG_DB_PARALLEL_REDUCE, false);
-//    if (!need_parallel) {
-//        return false;
-//    }
-//
-//    return nq * topk >= PARALLEL_REDUCE_THRESHOLD;
-//}
-//
-// void
-// ParallelReduce(std::function<void(size_t, size_t)> &reduce_function, size_t max_index) {
-//    size_t reduce_batch = PARALLEL_REDUCE_BATCH;
-//
-//    auto thread_count = std::thread::hardware_concurrency() - 1; //not all core do this work
-//    if (thread_count > 0) {
-//        reduce_batch = max_index / thread_count + 1;
-//    }
-//    ENGINE_LOG_DEBUG << "use " << thread_count <<
-//                     " thread parallelly do reduce, each thread process " << reduce_batch << " vectors";
-//
-//    std::vector<std::shared_ptr<std::thread> > thread_array;
-//    size_t from_index = 0;
-//    while (from_index < max_index) {
-//        size_t to_index = from_index + reduce_batch;
-//        if (to_index > max_index) {
-//            to_index = max_index;
-//        }
-//
-//        auto reduce_thread = std::make_shared<std::thread>(reduce_function, from_index, to_index);
-//        thread_array.push_back(reduce_thread);
-//
-//        from_index = to_index;
-//    }
-//
-//    for (auto &thread_ptr : thread_array) {
-//        thread_ptr->join();
-//    }
-//}
+// minimal number of queries reduced by one thread
+static constexpr size_t PARALLEL_REDUCE_BATCH = 16;
+
+ThreadPool&
+GetReduceThreadPool(size_t& thread_num) {
+    static size_t reduce_thread_num = []() {
+        int64_t config_num = 0;
+        server::Config::GetInstance().GetEngineConfigReduceThreadNum(config_num);
+        size_t num = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        if (config_num > 0) {
+            num = std::min<size_t>(num, config_num);
+        }
+        ENGINE_LOG_DEBUG << "Search reduce thread num: " << num;
+        return num;
+    }();
+    static ThreadPool reduce_thread_pool(reduce_thread_num);
+
+    thread_num = reduce_thread_num;
+    return reduce_thread_pool;
+}
+
+ThreadPool&
+GetPrefetchThreadPool(int64_t& max_depth) {
+    static int64_t prefetch_depth = []() {
+        int64_t config_depth = 0;
+        server::Config::GetInstance().GetEngineConfigSearchPrefetchDepth(config_depth);
+        ENGINE_LOG_DEBUG << "Search prefetch depth: " << config_depth;
+        return config_depth;
+    }();
+    static ThreadPool prefetch_thread_pool(std::max<int64_t>(prefetch_depth, 1));
+
+    max_depth = prefetch_depth;
+    return prefetch_thread_pool;
+}
+
+// read ahead enough files to cover searching the current one, deeper when disk is slower than search
+size_t
+PrefetchDepth(const TableFileSchema& file, const SearchJob& job, int64_t max_depth) {
+    auto& estimator = SearchCostEstimator::GetInstance();
+    double read = file.file_size_ / estimator.DiskBandwidth();
+    double workload = SearchCostEstimator::Workload(file, job.nq(), job.topk(), job.nprobe());
+    double search = workload / estimator.Throughput(ResourceType::CPU);
+    auto depth = static_cast<int64_t>(std::ceil(read / std::max(search, 1.0)));
+    return std::min(std::max<int64_t>(depth, 1), max_depth);
+}
+
+// a raw file with an index built on flush is loaded and searched through the index
+std::string
+SearchLocation(const TableFileSchema& file) {
+    return engine::utils::HasIngestIndex(file) ? engine::utils::GetIngestIndexPath(file.location_) : file.location_;
+}
+
+void
+ReadAhead(const TableFileSchemaPtr& file, const JobWPtr& job) {
+    auto owner = job.lock();
+    if (owner == nullptr || owner->IsCancelled()) {
+        return;
+    }
+
+    // files read ahead never evict others from cache
+    auto cache = cache::CpuCacheMgr::GetInstance();
+    auto location = SearchLocation(*file);
+    if (cache->ItemExists(location) || cache->CacheUsage() + file->file_size_ > cache->CacheCapacity()) {
+        return;
+    }
+
+    TimeRecorder rc("");
+    auto engine = EngineFactory::Build(file->dimension_, location, (EngineType)file->engine_type_,
+                                       (MetricType)file->metric_type_, file->nlist_);
+    auto status = engine->Load(true);
+    double span = rc.ElapseFromBegin("Prefetch file id:" + std::to_string(file->id_));
+    if (status.ok()) {
+        SearchCostEstimator::GetInstance().DiskFeedback(file->file_size_, span / 1000);
+    }
+}
+
+// pick next files of the job to read ahead, while the current file is loaded and searched
+void
+IssuePrefetch(const SearchJobPtr& job, const TableFileSchema& file) {
+    int64_t max_depth = 0;
+    auto& pool = GetPrefetchThreadPool(max_depth);
+    if (max_depth <= 0) {
+        return;
+    }
+
+    JobWPtr job_wptr = job;
+    for (auto& prefetch : job->TakePrefetchFiles(PrefetchDepth(file, *job, max_depth))) {
+        pool.enqueue([prefetch, job_wptr]() {
+            try {
+                ReadAhead(prefetch.first, job_wptr);
+            } catch (std::exception& ex) {
+                ENGINE_LOG_ERROR << "Failed to prefetch file id:" << prefetch.first->id_ << ": " << ex.what();
+            }
+            prefetch.second->set_value();
+        });
+    }
+}
 
 void
 CollectFileMetrics(int file_type, size_t file_size) {
@@ -101,8 +173,9 @@ XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, TableF
         if (file_->metric_type_ == static_cast<int>(MetricType::IP)) {
             ascending_reduce = false;
         }
-        index_engine_ = EngineFactory::Build(file_->dimension_, file_->location_, (EngineType)file_->engine_type_,
-                                             (MetricType)file_->metric_type_, file_->nlist_);
+        index_engine_ = EngineFactory::Build(file_->dimension_, SearchLocation(*file_),
+                                             (EngineType)file_->engine_type_, (MetricType)file_->metric_type_,
+                                             file_->nlist_);
     }
 }
 
@@ -110,15 +183,38 @@ void
 XSearchTask::Load(LoadType type, uint8_t device_id) {
     auto load_ctx = context_->Follower("XSearchTask::Load " + std::to_string(file_->id_));
 
+    if (IsCancelled()) {
+        Cancel();
+        return;
+    }
+
+    if (type == LoadType::DISK2CPU) {
+        auto wait = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - create_time_);
+        ObservePhase("scheduler_wait", wait.count());
+    }
+
     TimeRecorder rc("");
     Status stat = Status::OK();
     std::string error_msg;
     std::string type_str;
+    bool read_disk = false;
 
     try {
         fiu_do_on("XSearchTask.Load.throw_std_exception", throw std::exception());
         if (type == LoadType::DISK2CPU) {
-            stat = index_engine_->Load();
+            if (auto job = std::static_pointer_cast<scheduler::SearchJob>(job_.lock())) {
+                auto prefetch = job->ClaimPrefetchFile(file_->id_);
+                IssuePrefetch(job, *file_);
+                if (prefetch.valid()) {
+                    prefetch.wait();
+                }
+            }
+            read_disk = !cache::CpuCacheMgr::GetInstance()->ItemExists(index_engine_->GetLocation());
+            // a file owned by another readonly node is searched here without taking cache from owned ones
+            stat = index_engine_->Load(engine::SegmentOwnership::GetInstance().Owns(file_->id_));
+            if (stat.ok() && !batch_files_.empty()) {
+                stat = PackBatch();
+            }
             type_str = "DISK2CPU";
         } else if (type == LoadType::CPU2GPU) {
             bool hybrid = false;
@@ -153,7 +249,7 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
 
         if (auto job = job_.lock()) {
             auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
-            search_job->SearchDone(file_->id_);
+            SearchDone(*search_job);
             search_job->GetStatus() = s;
         }
 
@@ -162,10 +258,27 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
 
     size_t file_size = index_engine_->PhysicalSize();
 
-    std::string info = "Search task load file id:" + std::to_string(file_->id_) + " " + type_str +
-                       " file type:" + std::to_string(file_->file_type_) + " size:" + std::to_string(file_size) +
-                       " bytes from location: " + file_->location_ + " totally cost";
+    std::string info;
+    if (rc.Enabled()) {
+        info = "Search task load file id:" + std::to_string(file_->id_) + " " + type_str +
+               " file type:" + std::to_string(file_->file_type_) + " size:" + std::to_string(file_size) +
+               " bytes from location: " + file_->location_ + " totally cost";
+    }
     double span = rc.ElapseFromBegin(info);
+    if (type == LoadType::DISK2CPU) {
+        ObservePhase("disk_load", span);
+    } else if (type == LoadType::CPU2GPU) {
+        ObservePhase("cpu2gpu", span);
+    }
+    load_us_ += static_cast<int64_t>(span);
+    if (read_disk) {
+        SearchCostEstimator::GetInstance().DiskFeedback(file_->file_size_, span / 1000);
+        context_->GetQueryCost()->bytes_loaded_ += file_size;
+        context_->GetQueryCost()->cache_misses_++;
+    }
+    if (type == LoadType::CPU2GPU) {
+        context_->GetQueryCost()->gpu_time_us_ += static_cast<int64_t>(span);
+    }
     //    for (auto &context : search_contexts_) {
     //        context->AccumLoadCost(span);
     //    }
@@ -191,7 +304,7 @@ XSearchTask::Execute() {
     //    ENGINE_LOG_DEBUG << "Searching in file id:" << index_id_ << " with "
     //                     << search_contexts_.size() << " tasks";
 
-    TimeRecorder rc("DoSearch file id:" + std::to_string(index_id_));
+    TimeRecorder rc("");
 
     server::CollectDurationMetrics metrics(index_type_);
 
@@ -200,29 +313,88 @@ XSearchTask::Execute() {
 
     if (auto job = job_.lock()) {
         auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
+        if (search_job->IsCancelled()) {
+            SearchDone(*search_job);
+            return;
+        }
+
         // step 1: allocate memory
         uint64_t nq = search_job->nq();
         uint64_t topk = search_job->topk();
         uint64_t nprobe = search_job->nprobe();
         const engine::VectorsData& vectors = search_job->vectors();
 
-        output_ids.resize(topk * nq);
-        output_distance.resize(topk * nq);
-        std::string hdr =
-            "job " + std::to_string(search_job->id()) + " nq " + std::to_string(nq) + " topk " + std::to_string(topk);
+        ResultBufferPool::GetInstance().Acquire(topk * nq, output_ids, output_distance);
+        // messages of the time records are built only if they are logged
+        std::string hdr;
+        if (rc.Enabled()) {
+            hdr = "DoSearch file id:" + std::to_string(index_id_) + ", job " + std::to_string(search_job->id()) +
+                  " nq " + std::to_string(nq) + " topk " + std::to_string(topk);
+        }
 
         try {
             fiu_do_on("XSearchTask.Execute.throw_std_exception", throw std::exception());
             // step 2: search
             bool hybrid = false;
-            if (index_engine_->IndexEngineType() == engine::EngineType::FAISS_IVFSQ8H &&
-                ResMgrInst::GetInstance()->GetResource(path().Last())->type() == ResourceType::CPU) {
+            auto executor = ResMgrInst::GetInstance()->GetResource(path().Last());
+            if (index_engine_->IndexEngineType() == engine::EngineType::FAISS_IVFSQ8H && executor != nullptr &&
+                executor->type() == ResourceType::CPU) {
                 hybrid = true;
             }
             Status s;
             if (!vectors.float_data_.empty()) {
-                s = index_engine_->Search(nq, vectors.float_data_.data(), topk, nprobe, output_distance.data(),
-                                          output_ids.data(), hybrid);
+                // files built from one shared model search their quantizer once for the whole job, hybrid files
+                // search it on the gpu it's resident on and scan their lists on cpu
+                engine::CoarseAssignmentPtr coarse = nullptr;
+                uint64_t fingerprint = index_engine_->QuantizerFingerprint();
+                if (fingerprint != 0 && !search_job->by_range()) {
+                    coarse = search_job->GetCoarseAssignment(fingerprint, [&]() {
+                        engine::CoarseAssignmentPtr assigned = nullptr;
+                        index_engine_->CoarseAssign(nq, vectors.float_data_.data(), nprobe, assigned);
+                        return assigned;
+                    });
+                }
+
+                // vectors out of the attribute predicates are rejected before any distance is computed,
+                // a batch packs the files in its engine so it takes the vectors matched in all of them
+                engine::IDFilterPtr filter = nullptr;
+                if (!vectors.predicates_.empty()) {
+                    std::vector<std::string> locations = {file_->location_};
+                    for (auto& file : batch_files_) {
+                        locations.push_back(file->location_);
+                    }
+                    filter = engine::SegmentAttrsMgr::GetInstance().Filter(locations, vectors.predicates_);
+                }
+
+                const float* queries = vectors.float_data_.data();
+                float* distances = output_distance.data();
+                int64_t* labels = output_ids.data();
+#ifdef MILVUS_GPU_VERSION
+                // a gpu uploads queries and downloads results by dma from pinned buffers, results are copied out
+                std::shared_ptr<uint8_t> pinned_distances, pinned_ids;
+                if (executor != nullptr && executor->type() == ResourceType::GPU) {
+                    auto& gpu_res_mgr = knowhere::FaissGpuResourceMgr::GetInstance();
+                    auto pinned_queries = search_job->PinnedQueries();
+                    pinned_distances = gpu_res_mgr.AllocPinnedHost(output_distance.size() * sizeof(float));
+                    pinned_ids = gpu_res_mgr.AllocPinnedHost(output_ids.size() * sizeof(int64_t));
+                    if (pinned_queries != nullptr && pinned_distances != nullptr && pinned_ids != nullptr) {
+                        queries = pinned_queries;
+                        distances = reinterpret_cast<float*>(pinned_distances.get());
+                        labels = reinterpret_cast<int64_t*>(pinned_ids.get());
+                    }
+                }
+#endif
+                if (search_job->by_range()) {
+                    s = index_engine_->SearchByRange(nq, queries, search_job->radius(), topk, nprobe, distances,
+                                                     labels);
+                } else {
+                    s = index_engine_->Search(nq, queries, topk, nprobe, distances, labels, hybrid, filter, coarse,
+                                              row_begin_, row_end_);
+                }
+                if (labels != output_ids.data()) {
+                    memcpy(output_distance.data(), distances, output_distance.size() * sizeof(float));
+                    memcpy(output_ids.data(), labels, output_ids.size() * sizeof(int64_t));
+                }
             } else if (!vectors.binary_data_.empty()) {
                 s = index_engine_->Search(nq, vectors.binary_data_.data(), topk, nprobe, output_distance.data(),
                                           output_ids.data(), hybrid);
@@ -231,22 +403,56 @@ XSearchTask::Execute() {
 
             if (!s.ok()) {
                 search_job->GetStatus() = s;
-                search_job->SearchDone(index_id_);
+                SearchDone(*search_job);
                 return;
             }
 
             double span = rc.RecordSection(hdr + ", do search");
+            ObservePhase("kernel", span);
+            auto& cost = *context_->GetQueryCost();
+            if (executor != nullptr && executor->type() == ResourceType::GPU) {
+                cost.gpu_time_us_ += static_cast<int64_t>(span);
+                auto device = "gpu" + std::to_string(executor->device_id());
+                server::Metrics::GetInstance().GpuKernelTimeIncrement(device, span);
+            } else {
+                cost.cpu_time_us_ += static_cast<int64_t>(span);
+            }
+            int64_t row_count = index_engine_->Count();
+            if (row_end_ >= 0) {
+                row_count = std::max<int64_t>(std::min<int64_t>(row_end_, row_count) - row_begin_, 0);
+            }
+            cost.segments_searched_ += (row_begin_ == 0) ? 1 + batch_files_.size() : 0;
+            cost.vectors_scanned_ += row_count;
+            // workload of a batch or a part isn't the one of file_, the estimate would be skewed
+            if (executor != nullptr && batch_files_.empty() && row_end_ < 0) {
+                SearchCostEstimator::GetInstance().Feedback(
+                    executor->type(), SearchCostEstimator::Workload(*file_, nq, topk, nprobe), span / 1000);
+            }
             //            search_job->AccumSearchCost(span);
+            SearchCostEstimator::GetInstance().SearchFeedback(file_->id_, nq);
+            for (auto& file : batch_files_) {
+                SearchCostEstimator::GetInstance().SearchFeedback(file->id_, nq);
+            }
 
             // step 3: pick up topk result
-            auto spec_k = index_engine_->Count() < topk ? index_engine_->Count() : topk;
-            {
-                std::unique_lock<std::mutex> lock(search_job->mutex());
-                XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
-                                                  search_job->GetResultIds(), search_job->GetResultDistances());
+            auto spec_k = std::min<uint64_t>(row_count, topk);
+            if (spec_k > 0) {
+                search_job->AddResult(std::move(output_ids), std::move(output_distance), spec_k, ascending_reduce);
             }
 
-            span = rc.RecordSection(hdr + ", reduce topk");
+            double reduce_span = rc.RecordSection(hdr + ", reduce topk");
+            ObservePhase("reduce", reduce_span);
+            cost.cpu_time_us_ += static_cast<int64_t>(reduce_span);
+
+            server::SegmentCost segment;
+            segment.file_id_ = file_->id_;
+            segment.engine_type_ = file_->engine_type_;
+            segment.row_count_ = row_count;
+            segment.resource_ = executor != nullptr ? executor->name() : "";
+            segment.load_us_ = load_us_;
+            segment.search_us_ = static_cast<int64_t>(span);
+            segment.reduce_us_ = static_cast<int64_t>(reduce_span);
+            cost.AddSegment(std::move(segment));
             //            search_job->AccumReduceCost(span);
         } catch (std::exception& ex) {
             ENGINE_LOG_ERROR << "SearchTask encounter exception: " << ex.what();
@@ -254,10 +460,12 @@ XSearchTask::Execute() {
         }
 
         // step 4: notify to send result to client
-        search_job->SearchDone(index_id_);
+        SearchDone(*search_job);
     }
 
-    rc.ElapseFromBegin("totally cost");
+    if (rc.Enabled()) {
+        rc.ElapseFromBegin("DoSearch file id:" + std::to_string(index_id_) + ", totally cost");
+    }
 
     // release index in resource
     index_engine_ = nullptr;
@@ -265,6 +473,79 @@ XSearchTask::Execute() {
     execute_ctx->GetTraceContext()->GetSpan()->Finish();
 }
 
+void
+XSearchTask::Cancel() {
+    // nothing is loaded, Execute() returns at once when the engine is released
+    index_engine_ = nullptr;
+    auto job = job_.lock();
+    if (job != nullptr && file_ != nullptr) {
+        auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
+        SearchDone(*search_job);
+    }
+}
+
+void
+XSearchTask::ObservePhase(const std::string& phase, double microseconds) {
+    server::Metrics::GetInstance().SearchPhaseDurationHistogramObserve(
+        phase, file_->table_id_, std::to_string(file_->engine_type_), microseconds);
+}
+
+Status
+XSearchTask::PackBatch() {
+    // files are immutable, a batch of the same files finds its matrix in gpu cache under the same location;
+    // deleted vectors are left out of the matrix, a deletion from any of the files makes it another one
+    auto deleted_count = [](const std::string& location) -> std::string {
+        auto tombstone = engine::SegmentTombstoneMgr::GetInstance().GetTombstone(location);
+        return tombstone == nullptr ? "" : "d" + std::to_string(tombstone->Count());
+    };
+    std::string location = file_->location_ + ".raw_batch" + deleted_count(file_->location_);
+    for (auto& file : batch_files_) {
+        location += "_" + std::to_string(file->id_) + deleted_count(file->location_);
+    }
+    auto packed = EngineFactory::Build(file_->dimension_, location, EngineType::FAISS_IDMAP,
+                                       (MetricType)file_->metric_type_, file_->nlist_);
+    auto status = packed->Merge(file_->location_);
+
+    auto job = std::static_pointer_cast<scheduler::SearchJob>(job_.lock());
+    for (auto& file : batch_files_) {
+        if (!status.ok()) {
+            return status;
+        }
+        if (job != nullptr) {
+            auto prefetch = job->ClaimPrefetchFile(file->id_);
+            if (prefetch.valid()) {
+                prefetch.wait();
+            }
+        }
+        // loaded like a file of its own so it stays in cache, then copied from there, a file owned by another
+        // readonly node is read from disk by the merge instead
+        if (engine::SegmentOwnership::GetInstance().Owns(file->id_)) {
+            auto engine = EngineFactory::Build(file->dimension_, file->location_, (EngineType)file->engine_type_,
+                                               (MetricType)file->metric_type_, file->nlist_);
+            status = engine->Load();
+        }
+        if (status.ok()) {
+            status = packed->Merge(file->location_);
+        }
+    }
+    if (!status.ok()) {
+        return status;
+    }
+
+    ENGINE_LOG_DEBUG << "Search task packed " << batch_files_.size() + 1 << " raw files of " << packed->Count()
+                     << " rows into " << location;
+    index_engine_ = packed;
+    return Status::OK();
+}
+
+void
+XSearchTask::SearchDone(SearchJob& search_job) {
+    search_job.SearchDone(file_->id_);
+    for (auto& file : batch_files_) {
+        search_job.SearchDone(file->id_);
+    }
+}
+
 void
 XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
                                   size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
@@ -276,8 +557,12 @@ XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const sch
     size_t tar_k = tar_ids.size() / nq;
     size_t buf_k = std::min(topk, src_k + tar_k);
 
-    scheduler::ResultIds buf_ids(nq * buf_k, -1);
-    scheduler::ResultDistances buf_distances(nq * buf_k, 0.0);
+    // merged into pooled buffers, the storage of the former target goes back to the pool
+    scheduler::ResultIds buf_ids;
+    scheduler::ResultDistances buf_distances;
+    ResultBufferPool::GetInstance().Acquire(nq * buf_k, buf_ids, buf_distances);
+    std::fill(buf_ids.begin(), buf_ids.end(), -1);
+    std::fill(buf_distances.begin(), buf_distances.end(), 0.0);
 
     for (uint64_t i = 0; i < nq; i++) {
         size_t buf_k_j = 0, src_k_j = 0, tar_k_j = 0;
@@ -329,6 +614,84 @@ XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const sch
     }
     tar_ids.swap(buf_ids);
     tar_distances.swap(buf_distances);
+    ResultBufferPool::GetInstance().Release(std::move(buf_ids), std::move(buf_distances));
+}
+
+void
+XSearchTask::MergeTopkHeap(const SearchResults& results, size_t nq, size_t topk, bool ascending,
+                           scheduler::ResultIds& tar_ids, scheduler::ResultDistances& tar_distances) {
+    size_t total_k = 0;
+    for (auto& result : results) {
+        total_k += result.k_;
+    }
+    size_t tar_k = std::min(topk, total_k);
+    if (tar_k == 0) {
+        return;
+    }
+
+    tar_ids.assign(nq * tar_k, -1);
+    tar_distances.assign(nq * tar_k, 0.0);
+    auto reduce_range = [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; i++) {
+            MergeTopkHeapOfQuery(results, i, topk, tar_k, ascending, tar_ids, tar_distances);
+        }
+    };
+
+    size_t thread_num = 1;
+    ThreadPool& pool = GetReduceThreadPool(thread_num);
+    if (thread_num <= 1 || nq * topk < PARALLEL_REDUCE_THRESHOLD || nq < 2 * PARALLEL_REDUCE_BATCH) {
+        reduce_range(0, nq);
+        return;
+    }
+
+    // queries write disjoint parts of the output, the range is split evenly among reduce threads
+    size_t batch = std::max(PARALLEL_REDUCE_BATCH, (nq + thread_num - 1) / thread_num);
+    std::vector<std::future<void>> futures;
+    for (size_t from = batch; from < nq; from += batch) {
+        futures.emplace_back(pool.enqueue(reduce_range, from, std::min(from + batch, nq)));
+    }
+    reduce_range(0, batch);
+    for (auto& future : futures) {
+        future.wait();
+    }
+}
+
+void
+XSearchTask::MergeTopkHeapOfQuery(const SearchResults& results, size_t query, size_t topk, size_t tar_k,
+                                  bool ascending, scheduler::ResultIds& tar_ids,
+                                  scheduler::ResultDistances& tar_distances) {
+    // heap item is (distance, result index, position in result), the best distance is on top
+    using HeapItem = std::tuple<float, size_t, size_t>;
+    auto compare = [ascending](const HeapItem& a, const HeapItem& b) {
+        return ascending ? std::get<0>(a) > std::get<0>(b) : std::get<0>(a) < std::get<0>(b);
+    };
+
+    std::vector<HeapItem> heap;
+    heap.reserve(results.size());
+    size_t src_offset = query * topk;
+    for (size_t r = 0; r < results.size(); r++) {
+        if (results[r].k_ > 0) {
+            heap.emplace_back(results[r].distances_[src_offset], r, 0);
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), compare);
+
+    size_t tar_offset = query * tar_k;
+    for (size_t j = 0; j < tar_k && !heap.empty(); j++) {
+        std::pop_heap(heap.begin(), heap.end(), compare);
+        HeapItem& item = heap.back();
+        const SearchResult& result = results[std::get<1>(item)];
+        size_t pos = std::get<2>(item);
+        tar_ids[tar_offset + j] = result.ids_[src_offset + pos];
+        tar_distances[tar_offset + j] = result.distances_[src_offset + pos];
+
+        if (++pos < result.k_) {
+            item = HeapItem(result.distances_[src_offset + pos], std::get<1>(item), pos);
+            std::push_heap(heap.begin(), heap.end(), compare);
+        } else {
+            heap.pop_back();
+        }
+    }
 }
 
 // void
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "Task.h"
@@ -32,12 +34,24 @@ class XSearchTask : public Task {
     void
     Execute() override;
 
+    void
+    Cancel() override;
+
  public:
     static void
     MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
                          size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
                          scheduler::ResultDistances& tar_distances);
 
+    // k-way merge of all index file results with a heap per query, the output is written once
+    static void
+    MergeTopkHeap(const SearchResults& results, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
+                  scheduler::ResultDistances& tar_distances);
+
+    static void
+    MergeTopkHeapOfQuery(const SearchResults& results, size_t query, size_t topk, size_t tar_k, bool ascending,
+                         scheduler::ResultIds& tar_ids, scheduler::ResultDistances& tar_distances);
+
     //    static void
     //    MergeTopkArray(std::vector<int64_t>& tar_ids, std::vector<float>& tar_distance, uint64_t& tar_input_k,
     //                   const std::vector<int64_t>& src_ids, const std::vector<float>& src_distance, uint64_t
@@ -55,6 +69,30 @@ class XSearchTask : public Task {
     // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
     // similarity -- infinity value means two vectors equal, descending reduce, IP
     bool ascending_reduce = true;
+
+    // raw files packed with file_ into one flat index when loaded, all of them are searched as a single matrix
+    std::vector<TableFileSchemaPtr> batch_files_;
+
+    // rows [row_begin_, row_end_) of a big raw file split among tasks, all rows of file_ if row_end_ is negative
+    int64_t row_begin_ = 0;
+    int64_t row_end_ = -1;
+
+ private:
+    // the time until the first load is observed as scheduler wait
+    std::chrono::steady_clock::time_point create_time_ = std::chrono::steady_clock::now();
+    // time spent to load the file to the executor, across disk and gpu copies
+    int64_t load_us_ = 0;
+
+    void
+    ObservePhase(const std::string& phase, double microseconds);
+
+    // read the raw files of the batch and add them behind file_ to one flat index, which becomes the engine
+    Status
+    PackBatch();
+
+    // file_ and the files of its batch are searched
+    void
+    SearchDone(SearchJob& search_job);
 };
 
 }  // namespace scheduler
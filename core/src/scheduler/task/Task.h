@@ -78,6 +78,28 @@ class Task {
     virtual void
     Execute() = 0;
 
+    /*
+     * Release a task which is dropped before loading, the job must not wait for it anymore;
+     */
+    virtual void
+    Cancel() {
+    }
+
+    inline bool
+    IsCancelled() const {
+        auto job = job_.lock();
+        return job != nullptr && job->IsCancelled();
+    }
+
+    /*
+     * Priority class of the job, NORMAL if task belongs to no job;
+     */
+    inline JobPriority
+    Priority() const {
+        auto job = job_.lock();
+        return job != nullptr ? job->priority() : JobPriority::NORMAL;
+    }
+
  public:
     Path task_path_;
     scheduler::JobWPtr job_;
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -48,6 +49,34 @@ static const char* CONFIG_SERVER_TIME_ZONE = "time_zone";
 static const char* CONFIG_SERVER_TIME_ZONE_DEFAULT = "UTC+8";
 static const char* CONFIG_SERVER_WEB_PORT = "web_port";
 static const char* CONFIG_SERVER_WEB_PORT_DEFAULT = "19121";
+static const char* CONFIG_SERVER_SEARCH_WORKER_NUM = "search_worker_num";
+static const char* CONFIG_SERVER_SEARCH_WORKER_NUM_DEFAULT = "4";
+static const char* CONFIG_SERVER_INSERT_WORKER_NUM = "insert_worker_num";
+static const char* CONFIG_SERVER_INSERT_WORKER_NUM_DEFAULT = "1";
+static const char* CONFIG_SERVER_DDL_WORKER_NUM = "ddl_worker_num";
+static const char* CONFIG_SERVER_DDL_WORKER_NUM_DEFAULT = "1";
+static const char* CONFIG_SERVER_REQUEST_QUEUE_SIZE = "request_queue_size";
+static const char* CONFIG_SERVER_REQUEST_QUEUE_SIZE_DEFAULT = "1024";
+static const char* CONFIG_SERVER_GRPC_COMPRESSION_LEVEL = "grpc_compression_level";
+static const char* CONFIG_SERVER_GRPC_COMPRESSION_LEVEL_DEFAULT = "none";
+static const char* CONFIG_SERVER_GRPC_MAX_MESSAGE_SIZE = "grpc_max_message_size";
+static const char* CONFIG_SERVER_GRPC_MAX_MESSAGE_SIZE_DEFAULT = "0";
+static const char* CONFIG_SERVER_GRPC_WINDOW_SIZE = "grpc_window_size";
+static const char* CONFIG_SERVER_GRPC_WINDOW_SIZE_DEFAULT = "0";
+static const char* CONFIG_SERVER_SLOW_QUERY_THRESHOLD = "slow_query_threshold";
+static const char* CONFIG_SERVER_SLOW_QUERY_THRESHOLD_DEFAULT = "0";
+static const char* CONFIG_SERVER_QUERY_CAPTURE_PATH = "query_capture_path";
+static const char* CONFIG_SERVER_QUERY_CAPTURE_PATH_DEFAULT = "";
+static const char* CONFIG_SERVER_QUERY_CAPTURE_RATE = "query_capture_rate";
+static const char* CONFIG_SERVER_QUERY_CAPTURE_RATE_DEFAULT = "0";
+static const char* CONFIG_SERVER_PROXY_NODES = "proxy_nodes";
+static const char* CONFIG_SERVER_PROXY_NODES_DEFAULT = "";
+static const char* CONFIG_SERVER_READONLY_NODES = "readonly_nodes";
+static const char* CONFIG_SERVER_READONLY_NODES_DEFAULT = "";
+static const char* CONFIG_SERVER_NODE_IP = "node_ip";
+static const char* CONFIG_SERVER_NODE_IP_DEFAULT = "";
+static const char* CONFIG_SERVER_WRITABLE_NODE = "writable_node";
+static const char* CONFIG_SERVER_WRITABLE_NODE_DEFAULT = "";
 
 /* db config */
 static const char* CONFIG_DB = "db_config";
@@ -57,6 +86,9 @@ static const char* CONFIG_DB_ARCHIVE_DISK_THRESHOLD = "archive_disk_threshold";
 static const char* CONFIG_DB_ARCHIVE_DISK_THRESHOLD_DEFAULT = "0";
 static const char* CONFIG_DB_ARCHIVE_DAYS_THRESHOLD = "archive_days_threshold";
 static const char* CONFIG_DB_ARCHIVE_DAYS_THRESHOLD_DEFAULT = "0";
+// delete: files older than the days threshold are deleted; compress: they are kept as pq codes only
+static const char* CONFIG_DB_ARCHIVE_TYPE = "archive_type";
+static const char* CONFIG_DB_ARCHIVE_TYPE_DEFAULT = "delete";
 static const char* CONFIG_DB_PRELOAD_TABLE = "preload_table";
 static const char* CONFIG_DB_PRELOAD_TABLE_DEFAULT = "";
 
@@ -78,6 +110,18 @@ static const char* CONFIG_STORAGE_S3_SECRET_KEY = "s3_secret_key";
 static const char* CONFIG_STORAGE_S3_SECRET_KEY_DEFAULT = "minioadmin";
 static const char* CONFIG_STORAGE_S3_BUCKET = "s3_bucket";
 static const char* CONFIG_STORAGE_S3_BUCKET_DEFAULT = "milvus-bucket";
+static const char* CONFIG_STORAGE_S3_CACHE_PATH = "s3_cache_path";
+static const char* CONFIG_STORAGE_S3_CACHE_PATH_DEFAULT = "";
+static const char* CONFIG_STORAGE_S3_CACHE_CAPACITY = "s3_cache_capacity";
+static const char* CONFIG_STORAGE_S3_CACHE_CAPACITY_DEFAULT = "0";
+static const char* CONFIG_STORAGE_FILE_COMPRESS_ENABLE = "file_compress_enable";
+static const char* CONFIG_STORAGE_FILE_COMPRESS_ENABLE_DEFAULT = "false";
+static const char* CONFIG_STORAGE_DIRECT_IO_ENABLE = "direct_io_enable";
+static const char* CONFIG_STORAGE_DIRECT_IO_ENABLE_DEFAULT = "false";
+static const char* CONFIG_STORAGE_BACKGROUND_IO_RATE = "background_io_rate";
+static const char* CONFIG_STORAGE_BACKGROUND_IO_RATE_DEFAULT = "0";
+static const char* CONFIG_STORAGE_EXPORT_PATH = "export_path";
+static const char* CONFIG_STORAGE_EXPORT_PATH_DEFAULT = "";
 
 /* cache config */
 static const char* CONFIG_CACHE = "cache_config";
@@ -89,6 +133,14 @@ static const char* CONFIG_CACHE_INSERT_BUFFER_SIZE = "insert_buffer_size";
 static const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT = "1";
 static const char* CONFIG_CACHE_CACHE_INSERT_DATA = "cache_insert_data";
 static const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT = "false";
+static const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY = "result_cache_capacity";
+static const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT = "0";
+static const char* CONFIG_CACHE_CPU_CACHE_POLICY = "cpu_cache_policy";
+static const char* CONFIG_CACHE_CPU_CACHE_POLICY_DEFAULT = "lru";
+static const char* CONFIG_CACHE_LIST_CACHE_CAPACITY = "list_cache_capacity";
+static const char* CONFIG_CACHE_LIST_CACHE_CAPACITY_DEFAULT = "0";
+static const char* CONFIG_CACHE_CPU_CACHE_HUGE_PAGE = "cpu_cache_huge_page";
+static const char* CONFIG_CACHE_CPU_CACHE_HUGE_PAGE_DEFAULT = "thp";
 
 /* metric config */
 static const char* CONFIG_METRIC = "metric_config";
@@ -105,6 +157,26 @@ static const char* CONFIG_ENGINE_USE_BLAS_THRESHOLD = "use_blas_threshold";
 static const char* CONFIG_ENGINE_USE_BLAS_THRESHOLD_DEFAULT = "1100";
 static const char* CONFIG_ENGINE_OMP_THREAD_NUM = "omp_thread_num";
 static const char* CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT = "0";
+static const char* CONFIG_ENGINE_REDUCE_THREAD_NUM = "reduce_thread_num";
+static const char* CONFIG_ENGINE_REDUCE_THREAD_NUM_DEFAULT = "0";
+static const char* CONFIG_ENGINE_SEARCH_LATENCY_BUDGET = "search_latency_budget";
+static const char* CONFIG_ENGINE_SEARCH_LATENCY_BUDGET_DEFAULT = "0";
+static const char* CONFIG_ENGINE_CPU_EXECUTOR_NUM = "cpu_executor_num";
+static const char* CONFIG_ENGINE_CPU_EXECUTOR_NUM_DEFAULT = "1";
+static const char* CONFIG_ENGINE_SEARCH_PREFETCH_DEPTH = "search_prefetch_depth";
+static const char* CONFIG_ENGINE_SEARCH_PREFETCH_DEPTH_DEFAULT = "0";
+static const char* CONFIG_ENGINE_PRELOAD_THREAD_NUM = "preload_thread_num";
+static const char* CONFIG_ENGINE_PRELOAD_THREAD_NUM_DEFAULT = "4";
+static const char* CONFIG_ENGINE_TRAIN_SAMPLE_RATIO = "train_sample_ratio";
+static const char* CONFIG_ENGINE_TRAIN_SAMPLE_RATIO_DEFAULT = "1.0";
+static const char* CONFIG_ENGINE_REUSE_TRAINED_MODEL = "reuse_trained_model";
+static const char* CONFIG_ENGINE_REUSE_TRAINED_MODEL_DEFAULT = "false";
+static const char* CONFIG_ENGINE_QUANTIZER_ROTATION = "quantizer_rotation";
+static const char* CONFIG_ENGINE_QUANTIZER_ROTATION_DEFAULT = "false";
+static const char* CONFIG_ENGINE_NUMA_ENABLE = "numa_enable";
+static const char* CONFIG_ENGINE_NUMA_ENABLE_DEFAULT = "false";
+static const char* CONFIG_ENGINE_RECALL_SAMPLE_RATE = "recall_sample_rate";
+static const char* CONFIG_ENGINE_RECALL_SAMPLE_RATE_DEFAULT = "0";
 static const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD = "gpu_search_threshold";
 static const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT = "1000";
 
@@ -120,16 +192,59 @@ static const char* CONFIG_GPU_RESOURCE_CACHE_CAPACITY = "cache_capacity";
 static const char* CONFIG_GPU_RESOURCE_CACHE_CAPACITY_DEFAULT = "1";
 static const char* CONFIG_GPU_RESOURCE_CACHE_THRESHOLD = "cache_threshold";
 static const char* CONFIG_GPU_RESOURCE_CACHE_THRESHOLD_DEFAULT = "0.85";
+static const char* CONFIG_GPU_RESOURCE_CACHE_POLICY = "cache_policy";
+static const char* CONFIG_GPU_RESOURCE_CACHE_POLICY_DEFAULT = "lru";
 static const char* CONFIG_GPU_RESOURCE_DELIMITER = ",";
 static const char* CONFIG_GPU_RESOURCE_SEARCH_RESOURCES = "search_resources";
 static const char* CONFIG_GPU_RESOURCE_SEARCH_RESOURCES_DEFAULT = "gpu0";
 static const char* CONFIG_GPU_RESOURCE_BUILD_INDEX_RESOURCES = "build_index_resources";
 static const char* CONFIG_GPU_RESOURCE_BUILD_INDEX_RESOURCES_DEFAULT = "gpu0";
+static const char* CONFIG_GPU_RESOURCE_COST_BASED_PLACEMENT = "cost_based_placement";
+static const char* CONFIG_GPU_RESOURCE_COST_BASED_PLACEMENT_DEFAULT = "false";
+static const char* CONFIG_GPU_RESOURCE_SHARD_ROW_THRESHOLD = "shard_row_threshold";
+static const char* CONFIG_GPU_RESOURCE_SHARD_ROW_THRESHOLD_DEFAULT = "0";
+static const char* CONFIG_GPU_RESOURCE_PARALLEL_BUILD_ROW_THRESHOLD = "parallel_build_row_threshold";
+static const char* CONFIG_GPU_RESOURCE_PARALLEL_BUILD_ROW_THRESHOLD_DEFAULT = "0";
+static const char* CONFIG_GPU_RESOURCE_RAW_BATCH_ROW_NUM = "raw_batch_row_num";
+static const char* CONFIG_GPU_RESOURCE_RAW_BATCH_ROW_NUM_DEFAULT = "0";
+static const char* CONFIG_GPU_RESOURCE_STREAM_NUM = "stream_num";
+static const char* CONFIG_GPU_RESOURCE_STREAM_NUM_DEFAULT = "2";
+static const int64_t CONFIG_GPU_RESOURCE_STREAM_NUM_MAX = 16;
+
+/* wal config */
+static const char* CONFIG_WAL = "wal_config";
+static const char* CONFIG_WAL_ENABLE = "enable";
+static const char* CONFIG_WAL_ENABLE_DEFAULT = "true";
+static const char* CONFIG_WAL_PATH = "wal_path";
+static const char* CONFIG_WAL_PATH_DEFAULT = "";
 
 // TODO:
 /* tracing config */
 static const char* CONFIG_TRACING = "tracing_config";
 static const char* CONFIG_TRACING_JSON_CONFIG_PATH = "json_config_path";
+static const char* CONFIG_TRACING_SAMPLE_RATE = "sample_rate";
+static const char* CONFIG_TRACING_SAMPLE_RATE_DEFAULT = "1.0";
+
+// Parsed values read for every file a search, load or build touches, taken at once without a lookup per value;
+// a snapshot is built on first use and replaced after any key is set
+struct ConfigSnapshot {
+    bool s3_enable_ = false;
+    bool reuse_trained_model_ = false;
+    float train_sample_ratio_ = 1.0;
+    bool quantizer_rotation_ = false;
+    int64_t cpu_executor_num_ = 1;
+#ifdef MILVUS_GPU_VERSION
+    bool gpu_enable_ = false;
+    int64_t gpu_search_threshold_ = 0;
+    int64_t shard_row_threshold_ = 0;
+    int64_t parallel_build_row_threshold_ = 0;
+    int64_t raw_batch_row_num_ = 0;
+    std::vector<int64_t> search_gpus_;  // empty if gpu is disabled
+    std::vector<int64_t> build_gpus_;
+#endif
+};
+
+using ConfigSnapshotPtr = std::shared_ptr<const ConfigSnapshot>;
 
 class Config {
  private:
@@ -159,6 +274,9 @@ class Config {
     Status
     CancelCallBack(const std::string& node, const std::string& sub_node, const std::string& key);
 
+    ConfigSnapshotPtr
+    GetSnapshot();
+
  private:
     ConfigNode&
     GetConfigRoot();
@@ -193,6 +311,34 @@ class Config {
     CheckServerConfigTimeZone(const std::string& value);
     Status
     CheckServerConfigWebPort(const std::string& value);
+    Status
+    CheckServerConfigSearchWorkerNum(const std::string& value);
+    Status
+    CheckServerConfigInsertWorkerNum(const std::string& value);
+    Status
+    CheckServerConfigDDLWorkerNum(const std::string& value);
+    Status
+    CheckServerConfigRequestQueueSize(const std::string& value);
+    Status
+    CheckServerConfigGrpcCompressionLevel(const std::string& value);
+    Status
+    CheckServerConfigGrpcMaxMessageSize(const std::string& value);
+    Status
+    CheckServerConfigGrpcWindowSize(const std::string& value);
+    Status
+    CheckServerConfigSlowQueryThreshold(const std::string& value);
+    Status
+    CheckServerConfigQueryCapturePath(const std::string& value);
+    Status
+    CheckServerConfigQueryCaptureRate(const std::string& value);
+    Status
+    CheckServerConfigProxyNodes(const std::string& value);
+    Status
+    CheckServerConfigReadonlyNodes(const std::string& value);
+    Status
+    CheckServerConfigNodeIp(const std::string& value);
+    Status
+    CheckServerConfigWritableNode(const std::string& value);
 
     /* db config */
     Status
@@ -201,6 +347,8 @@ class Config {
     CheckDBConfigArchiveDiskThreshold(const std::string& value);
     Status
     CheckDBConfigArchiveDaysThreshold(const std::string& value);
+    Status
+    CheckDBConfigArchiveType(const std::string& value);
 
     /* storage config */
     Status
@@ -219,6 +367,18 @@ class Config {
     CheckStorageConfigS3SecretKey(const std::string& value);
     Status
     CheckStorageConfigS3Bucket(const std::string& value);
+    Status
+    CheckStorageConfigS3CachePath(const std::string& value);
+    Status
+    CheckStorageConfigS3CacheCapacity(const std::string& value);
+    Status
+    CheckStorageConfigFileCompressEnable(const std::string& value);
+    Status
+    CheckStorageConfigDirectIOEnable(const std::string& value);
+    Status
+    CheckStorageConfigBackgroundIORate(const std::string& value);
+    Status
+    CheckStorageConfigExportPath(const std::string& value);
 
     /* metric config */
     Status
@@ -237,12 +397,40 @@ class Config {
     CheckCacheConfigInsertBufferSize(const std::string& value);
     Status
     CheckCacheConfigCacheInsertData(const std::string& value);
+    Status
+    CheckCacheConfigResultCacheCapacity(const std::string& value);
+    Status
+    CheckCacheConfigCpuCachePolicy(const std::string& value);
+    Status
+    CheckCacheConfigListCacheCapacity(const std::string& value);
+    Status
+    CheckCacheConfigCpuCacheHugePage(const std::string& value);
 
     /* engine config */
     Status
     CheckEngineConfigUseBlasThreshold(const std::string& value);
     Status
     CheckEngineConfigOmpThreadNum(const std::string& value);
+    Status
+    CheckEngineConfigReduceThreadNum(const std::string& value);
+    Status
+    CheckEngineConfigSearchLatencyBudget(const std::string& value);
+    Status
+    CheckEngineConfigCpuExecutorNum(const std::string& value);
+    Status
+    CheckEngineConfigSearchPrefetchDepth(const std::string& value);
+    Status
+    CheckEngineConfigPreloadThreadNum(const std::string& value);
+    Status
+    CheckEngineConfigTrainSampleRatio(const std::string& value);
+    Status
+    CheckEngineConfigReuseTrainedModel(const std::string& value);
+    Status
+    CheckEngineConfigQuantizerRotation(const std::string& value);
+    Status
+    CheckEngineConfigNumaEnable(const std::string& value);
+    Status
+    CheckEngineConfigRecallSampleRate(const std::string& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -256,11 +444,33 @@ class Config {
     Status
     CheckGpuResourceConfigCacheThreshold(const std::string& value);
     Status
+    CheckGpuResourceConfigCachePolicy(const std::string& value);
+    Status
     CheckGpuResourceConfigSearchResources(const std::vector<std::string>& value);
     Status
     CheckGpuResourceConfigBuildIndexResources(const std::vector<std::string>& value);
+    Status
+    CheckGpuResourceConfigCostBasedPlacement(const std::string& value);
+    Status
+    CheckGpuResourceConfigShardRowThreshold(const std::string& value);
+    Status
+    CheckGpuResourceConfigParallelBuildRowThreshold(const std::string& value);
+    Status
+    CheckGpuResourceConfigRawBatchRowNum(const std::string& value);
+    Status
+    CheckGpuResourceConfigStreamNum(const std::string& value);
 #endif
 
+    /* wal config */
+    Status
+    CheckWalConfigEnable(const std::string& value);
+    Status
+    CheckWalConfigWalPath(const std::string& value);
+
+    /* tracing config */
+    Status
+    CheckTracingConfigSampleRate(const std::string& value);
+
     std::string
     GetConfigStr(const std::string& parent_key, const std::string& child_key, const std::string& default_value = "");
     std::string
@@ -272,6 +482,16 @@ class Config {
     Status
     ExecCallBacks(const std::string& node, const std::string& sub_node, const std::string& value);
 
+    // a value read on search paths is parsed and checked once, then kept until the key is set again
+    Status
+    GetCachedInt64(const std::string& parent_key, const std::string& child_key, const std::string& default_value,
+                   Status (Config::*checker)(const std::string&), int64_t& value);
+    Status
+    GetCachedGpuIds(const std::string& parent_key, const std::string& child_key, const std::string& default_value,
+                    Status (Config::*checker)(const std::vector<std::string>&), std::vector<int64_t>& value);
+    void
+    ClearCachedValues();
+
  public:
     /* server config */
     Status
@@ -284,6 +504,34 @@ class Config {
     GetServerConfigTimeZone(std::string& value);
     Status
     GetServerConfigWebPort(std::string& value);
+    Status
+    GetServerConfigSearchWorkerNum(int64_t& value);
+    Status
+    GetServerConfigInsertWorkerNum(int64_t& value);
+    Status
+    GetServerConfigDDLWorkerNum(int64_t& value);
+    Status
+    GetServerConfigRequestQueueSize(int64_t& value);
+    Status
+    GetServerConfigGrpcCompressionLevel(std::string& value);
+    Status
+    GetServerConfigGrpcMaxMessageSize(int64_t& value);
+    Status
+    GetServerConfigGrpcWindowSize(int64_t& value);
+    Status
+    GetServerConfigSlowQueryThreshold(int64_t& value);
+    Status
+    GetServerConfigQueryCapturePath(std::string& value);
+    Status
+    GetServerConfigQueryCaptureRate(float& value);
+    Status
+    GetServerConfigProxyNodes(std::vector<std::string>& value);
+    Status
+    GetServerConfigReadonlyNodes(std::vector<std::string>& value);
+    Status
+    GetServerConfigNodeIp(std::string& value);
+    Status
+    GetServerConfigWritableNode(std::string& value);
 
     /* db config */
     Status
@@ -293,6 +541,8 @@ class Config {
     Status
     GetDBConfigArchiveDaysThreshold(int64_t& value);
     Status
+    GetDBConfigArchiveType(std::string& value);
+    Status
     GetDBConfigPreloadTable(std::string& value);
 
     /* storage config */
@@ -312,6 +562,18 @@ class Config {
     GetStorageConfigS3SecretKey(std::string& value);
     Status
     GetStorageConfigS3Bucket(std::string& value);
+    Status
+    GetStorageConfigS3CachePath(std::string& value);
+    Status
+    GetStorageConfigS3CacheCapacity(int64_t& value);
+    Status
+    GetStorageConfigFileCompressEnable(bool& value);
+    Status
+    GetStorageConfigDirectIOEnable(bool& value);
+    Status
+    GetStorageConfigBackgroundIORate(int64_t& value);
+    Status
+    GetStorageConfigExportPath(std::string& value);
 
     /* metric config */
     Status
@@ -330,12 +592,40 @@ class Config {
     GetCacheConfigInsertBufferSize(int64_t& value);
     Status
     GetCacheConfigCacheInsertData(bool& value);
+    Status
+    GetCacheConfigResultCacheCapacity(int64_t& value);
+    Status
+    GetCacheConfigCpuCachePolicy(std::string& value);
+    Status
+    GetCacheConfigListCacheCapacity(int64_t& value);
+    Status
+    GetCacheConfigCpuCacheHugePage(std::string& value);
 
     /* engine config */
     Status
     GetEngineConfigUseBlasThreshold(int64_t& value);
     Status
     GetEngineConfigOmpThreadNum(int64_t& value);
+    Status
+    GetEngineConfigReduceThreadNum(int64_t& value);
+    Status
+    GetEngineConfigSearchLatencyBudget(int64_t& value);
+    Status
+    GetEngineConfigCpuExecutorNum(int64_t& value);
+    Status
+    GetEngineConfigSearchPrefetchDepth(int64_t& value);
+    Status
+    GetEngineConfigPreloadThreadNum(int64_t& value);
+    Status
+    GetEngineConfigTrainSampleRatio(float& value);
+    Status
+    GetEngineConfigReuseTrainedModel(bool& value);
+    Status
+    GetEngineConfigQuantizerRotation(bool& value);
+    Status
+    GetEngineConfigNumaEnable(bool& value);
+    Status
+    GetEngineConfigRecallSampleRate(float& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -349,14 +639,34 @@ class Config {
     Status
     GetGpuResourceConfigCacheThreshold(float& value);
     Status
+    GetGpuResourceConfigCachePolicy(std::string& value);
+    Status
     GetGpuResourceConfigSearchResources(std::vector<int64_t>& value);
     Status
     GetGpuResourceConfigBuildIndexResources(std::vector<int64_t>& value);
+    Status
+    GetGpuResourceConfigCostBasedPlacement(bool& value);
+    Status
+    GetGpuResourceConfigShardRowThreshold(int64_t& value);
+    Status
+    GetGpuResourceConfigParallelBuildRowThreshold(int64_t& value);
+    Status
+    GetGpuResourceConfigRawBatchRowNum(int64_t& value);
+    Status
+    GetGpuResourceConfigStreamNum(int64_t& value);
 #endif
 
+    /* wal config */
+    Status
+    GetWalConfigEnable(bool& value);
+    Status
+    GetWalConfigWalPath(std::string& value);
+
     /* tracing config */
     Status
     GetTracingConfigJsonConfigPath(std::string& value);
+    Status
+    GetTracingConfigSampleRate(float& value);
 
     Status
     GetServerRestartRequired(bool& required);
@@ -373,6 +683,34 @@ class Config {
     SetServerConfigTimeZone(const std::string& value);
     Status
     SetServerConfigWebPort(const std::string& value);
+    Status
+    SetServerConfigSearchWorkerNum(const std::string& value);
+    Status
+    SetServerConfigInsertWorkerNum(const std::string& value);
+    Status
+    SetServerConfigDDLWorkerNum(const std::string& value);
+    Status
+    SetServerConfigRequestQueueSize(const std::string& value);
+    Status
+    SetServerConfigGrpcCompressionLevel(const std::string& value);
+    Status
+    SetServerConfigGrpcMaxMessageSize(const std::string& value);
+    Status
+    SetServerConfigGrpcWindowSize(const std::string& value);
+    Status
+    SetServerConfigSlowQueryThreshold(const std::string& value);
+    Status
+    SetServerConfigQueryCapturePath(const std::string& value);
+    Status
+    SetServerConfigQueryCaptureRate(const std::string& value);
+    Status
+    SetServerConfigProxyNodes(const std::string& value);
+    Status
+    SetServerConfigReadonlyNodes(const std::string& value);
+    Status
+    SetServerConfigNodeIp(const std::string& value);
+    Status
+    SetServerConfigWritableNode(const std::string& value);
 
     /* db config */
     Status
@@ -381,6 +719,8 @@ class Config {
     SetDBConfigArchiveDiskThreshold(const std::string& value);
     Status
     SetDBConfigArchiveDaysThreshold(const std::string& value);
+    Status
+    SetDBConfigArchiveType(const std::string& value);
 
     /* storage config */
     Status
@@ -399,6 +739,18 @@ class Config {
     SetStorageConfigS3SecretKey(const std::string& value);
     Status
     SetStorageConfigS3Bucket(const std::string& value);
+    Status
+    SetStorageConfigS3CachePath(const std::string& value);
+    Status
+    SetStorageConfigS3CacheCapacity(const std::string& value);
+    Status
+    SetStorageConfigFileCompressEnable(const std::string& value);
+    Status
+    SetStorageConfigDirectIOEnable(const std::string& value);
+    Status
+    SetStorageConfigBackgroundIORate(const std::string& value);
+    Status
+    SetStorageConfigExportPath(const std::string& value);
 
     /* metric config */
     Status
@@ -417,12 +769,40 @@ class Config {
     SetCacheConfigInsertBufferSize(const std::string& value);
     Status
     SetCacheConfigCacheInsertData(const std::string& value);
+    Status
+    SetCacheConfigResultCacheCapacity(const std::string& value);
+    Status
+    SetCacheConfigCpuCachePolicy(const std::string& value);
+    Status
+    SetCacheConfigListCacheCapacity(const std::string& value);
+    Status
+    SetCacheConfigCpuCacheHugePage(const std::string& value);
 
     /* engine config */
     Status
     SetEngineConfigUseBlasThreshold(const std::string& value);
     Status
     SetEngineConfigOmpThreadNum(const std::string& value);
+    Status
+    SetEngineConfigReduceThreadNum(const std::string& value);
+    Status
+    SetEngineConfigSearchLatencyBudget(const std::string& value);
+    Status
+    SetEngineConfigCpuExecutorNum(const std::string& value);
+    Status
+    SetEngineConfigSearchPrefetchDepth(const std::string& value);
+    Status
+    SetEngineConfigPreloadThreadNum(const std::string& value);
+    Status
+    SetEngineConfigTrainSampleRatio(const std::string& value);
+    Status
+    SetEngineConfigReuseTrainedModel(const std::string& value);
+    Status
+    SetEngineConfigQuantizerRotation(const std::string& value);
+    Status
+    SetEngineConfigNumaEnable(const std::string& value);
+    Status
+    SetEngineConfigRecallSampleRate(const std::string& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -436,17 +816,46 @@ class Config {
     Status
     SetGpuResourceConfigCacheThreshold(const std::string& value);
     Status
+    SetGpuResourceConfigCachePolicy(const std::string& value);
+    Status
     SetGpuResourceConfigSearchResources(const std::string& value);
     Status
     SetGpuResourceConfigBuildIndexResources(const std::string& value);
+    Status
+    SetGpuResourceConfigCostBasedPlacement(const std::string& value);
+    Status
+    SetGpuResourceConfigShardRowThreshold(const std::string& value);
+    Status
+    SetGpuResourceConfigParallelBuildRowThreshold(const std::string& value);
+    Status
+    SetGpuResourceConfigRawBatchRowNum(const std::string& value);
+    Status
+    SetGpuResourceConfigStreamNum(const std::string& value);
 #endif
 
+    /* wal config */
+    Status
+    SetWalConfigEnable(const std::string& value);
+    Status
+    SetWalConfigWalPath(const std::string& value);
+
+    /* tracing config */
+    Status
+    SetTracingConfigSampleRate(const std::string& value);
+
  private:
     bool restart_required_ = false;
     std::string config_file_;
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> config_map_;
     std::unordered_map<std::string, std::unordered_map<std::string, ConfigCallBackF>> config_callback_;
     std::mutex mutex_;
+
+    // typed values keyed by "parent.child", a value parsed across a set of its key is not kept
+    std::unordered_map<std::string, int64_t> int64_cache_;
+    std::unordered_map<std::string, std::vector<int64_t>> gpu_ids_cache_;
+    ConfigSnapshotPtr snapshot_;
+    uint64_t cache_generation_ = 0;
+    std::mutex cache_mutex_;
 };
 
 }  // namespace server
@@ -9,22 +9,48 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <faiss/InvertedLists.h>
 #include <faiss/utils/distances.h>
 #include <omp.h>
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <vector>
 
 #include "db/DBFactory.h"
+#include "db/engine/ExecutionEngine.h"
+#include "scheduler/OmpBudget.h"
 #include "server/Config.h"
 #include "server/DBWrapper.h"
+#include "storage/IORateLimiter.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
 #include "utils/StringHelpFunctions.h"
+#include "wrapper/BlasCalibration.h"
 
 namespace milvus {
 namespace server {
 
+namespace {
+
+// threads the tasks executing together share, 0 means half of the cpus
+void
+ApplyOmpThreadNum(int64_t omp_thread) {
+    if (omp_thread > 0) {
+        omp_set_num_threads(omp_thread);
+        SERVER_LOG_DEBUG << "Specify openmp thread number: " << omp_thread;
+    } else {
+        int64_t sys_thread_cnt = 8;
+        if (CommonUtil::GetSystemAvailableThreads(sys_thread_cnt)) {
+            omp_thread = static_cast<int32_t>(ceil(sys_thread_cnt * 0.5));
+            omp_set_num_threads(omp_thread);
+        }
+    }
+    scheduler::OmpBudget::GetInstance().SetThreads(omp_thread);
+}
+
+}  // namespace
+
 Status
 DBWrapper::StartService() {
     Config& config = Config::GetInstance();
@@ -90,16 +116,25 @@ DBWrapper::StartService() {
         return s;
     }
 
-    if (omp_thread > 0) {
-        omp_set_num_threads(omp_thread);
-        SERVER_LOG_DEBUG << "Specify openmp thread number: " << omp_thread;
-    } else {
-        int64_t sys_thread_cnt = 8;
-        if (CommonUtil::GetSystemAvailableThreads(sys_thread_cnt)) {
-            omp_thread = static_cast<int32_t>(ceil(sys_thread_cnt * 0.5));
-            omp_set_num_threads(omp_thread);
+    ApplyOmpThreadNum(omp_thread);
+    server::ConfigCallBackF omp_lambda = [](const std::string& value) -> Status {
+        int64_t omp_thread;
+        auto status = Config::GetInstance().GetEngineConfigOmpThreadNum(omp_thread);
+        if (status.ok()) {
+            ApplyOmpThreadNum(omp_thread);
         }
+
+        return status;
+    };
+    config.RegisterCallBack(server::CONFIG_ENGINE, server::CONFIG_ENGINE_OMP_THREAD_NUM, "DBWrapper", omp_lambda);
+
+    int64_t preload_thread_num;
+    s = config.GetEngineConfigPreloadThreadNum(preload_thread_num);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
     }
+    opt.preload_thread_num_ = preload_thread_num;
 
     // init faiss global variable
     int64_t use_blas_threshold;
@@ -121,6 +156,52 @@ DBWrapper::StartService() {
         return status;
     };
     config.RegisterCallBack(server::CONFIG_ENGINE, server::CONFIG_ENGINE_USE_BLAS_THRESHOLD, "DBWrapper", lambda);
+    engine::BlasCalibration::InstallSelector();
+
+    // inverted lists of ivf indexes loaded lazily are accounted by faiss
+    int64_t list_cache_capacity;
+    s = config.GetCacheConfigListCacheCapacity(list_cache_capacity);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    faiss::set_lazy_list_capacity(list_cache_capacity << 20);
+    server::ConfigCallBackF list_cache_lambda = [](const std::string& value) -> Status {
+        Config& config = Config::GetInstance();
+        int64_t capacity;
+        auto status = config.GetCacheConfigListCacheCapacity(capacity);
+        if (status.ok()) {
+            faiss::set_lazy_list_capacity(capacity << 20);
+        }
+
+        return status;
+    };
+    config.RegisterCallBack(server::CONFIG_CACHE, server::CONFIG_CACHE_LIST_CACHE_CAPACITY, "DBWrapper",
+                            list_cache_lambda);
+
+    // merge, index build and clean up share the disk bandwidth given to background io
+    int64_t background_io_rate;
+    s = config.GetStorageConfigBackgroundIORate(background_io_rate);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    // the config check keeps the rate small enough to shift
+    storage::IORateLimiter::GetInstance().SetRate(background_io_rate << 20);
+    server::ConfigCallBackF io_rate_lambda = [](const std::string& value) -> Status {
+        Config& config = Config::GetInstance();
+        int64_t rate;
+        auto status = config.GetStorageConfigBackgroundIORate(rate);
+        if (status.ok()) {
+            storage::IORateLimiter::GetInstance().SetRate(rate << 20);
+        }
+
+        return status;
+    };
+    config.RegisterCallBack(server::CONFIG_STORAGE, server::CONFIG_STORAGE_BACKGROUND_IO_RATE, "DBWrapper",
+                            io_rate_lambda);
 
     // set archive config
     engine::ArchiveConf::CriteriaT criterial;
@@ -144,8 +225,36 @@ DBWrapper::StartService() {
     if (days > 0) {
         criterial[engine::ARCHIVE_CONF_DAYS] = days;
     }
+
+    std::string archive_type;
+    s = config.GetDBConfigArchiveType(archive_type);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    opt.meta_.archive_conf_ = engine::ArchiveConf(archive_type);
     opt.meta_.archive_conf_.SetCriterias(criterial);
 
+    // wal config
+    s = config.GetWalConfigEnable(opt.wal_enable_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    if (opt.wal_enable_) {
+        s = config.GetWalConfigWalPath(opt.wal_path_);
+        if (!s.ok()) {
+            std::cerr << s.ToString() << std::endl;
+            return s;
+        }
+
+        if (opt.wal_path_.empty()) {
+            opt.wal_path_ = path + "/wal";
+        }
+    }
+
     // create db root folder
     s = CommonUtil::CreateDirectory(opt.meta_.path_);
     if (!s.ok()) {
@@ -175,9 +284,43 @@ DBWrapper::StartService() {
         kill(0, SIGUSR1);
     }
 
-    db_->Start();
+    s = db_->Start();
+    if (!s.ok()) {
+        std::cerr << "Error: failed to start database: " << s.message()
+                  << ". Possible reason: wal files under wal_config.wal_path are damaged." << std::endl;
+        kill(0, SIGUSR1);
+    }
+
+    // measure blas crossovers of the dims not calibrated yet, use_blas_threshold applies to them meanwhile
+    std::string calibration_path = opt.meta_.path_ + "/blas_calibration";
+    calibration_thread_ = std::thread([this, calibration_path]() {
+        std::vector<engine::meta::TableSchema> table_schema_array;
+        db_->AllTables(table_schema_array);
+
+        std::vector<int64_t> dims;
+        for (auto& schema : table_schema_array) {
+            if (schema.metric_type_ == static_cast<int32_t>(engine::MetricType::L2) ||
+                schema.metric_type_ == static_cast<int32_t>(engine::MetricType::IP)) {
+                dims.push_back(schema.dimension_);
+            }
+        }
+        std::sort(dims.begin(), dims.end());
+        dims.erase(std::unique(dims.begin(), dims.end()), dims.end());
+
+        // searches run alone with the whole budget or share it with others
+        std::vector<int64_t> threads = {1};
+        int64_t budget = scheduler::OmpBudget::GetInstance().Threads();
+        if (budget > 1) {
+            threads.push_back(budget);
+        }
 
-    // preload table
+        auto status = engine::BlasCalibration::GetInstance().Calibrate(dims, threads, calibration_path);
+        if (!status.ok()) {
+            SERVER_LOG_ERROR << "Failed to calibrate blas: " << status.message();
+        }
+    });
+
+    // preload table in background, the server takes requests meanwhile and searches load the files they miss
     std::string preload_tables;
     s = config.GetDBConfigPreloadTable(preload_tables);
     if (!s.ok()) {
@@ -185,11 +328,15 @@ DBWrapper::StartService() {
         return s;
     }
 
-    s = PreloadTables(preload_tables);
-    if (!s.ok()) {
-        std::cerr << "ERROR! Failed to preload tables: " << preload_tables << std::endl;
-        std::cerr << s.ToString() << std::endl;
-        kill(0, SIGUSR1);
+    if (!preload_tables.empty()) {
+        warming_ = true;
+        preload_thread_ = std::thread([this, preload_tables]() {
+            auto status = PreloadTables(preload_tables);
+            if (!status.ok()) {
+                SERVER_LOG_ERROR << "Failed to preload tables: " << preload_tables << ", " << status.message();
+            }
+            warming_ = false;
+        });
     }
 
     return Status::OK();
@@ -197,6 +344,14 @@ DBWrapper::StartService() {
 
 Status
 DBWrapper::StopService() {
+    if (calibration_thread_.joinable()) {
+        calibration_thread_.join();
+    }
+
+    if (preload_thread_.joinable()) {
+        preload_thread_.join();
+    }
+
     if (db_) {
         db_->Stop();
     }
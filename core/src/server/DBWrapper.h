@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <thread>
 
 #include "db/DB.h"
 #include "utils/Status.h"
@@ -46,12 +48,21 @@ class DBWrapper {
         return db_;
     }
 
+    // true while tables of preload_table are being loaded, requests are served meanwhile
+    bool
+    IsWarming() const {
+        return warming_.load();
+    }
+
  private:
     Status
     PreloadTables(const std::string& preload_tables);
 
  private:
     engine::DBPtr db_;
+    std::atomic<bool> warming_{false};
+    std::thread preload_thread_;
+    std::thread calibration_thread_;
 };
 
 }  // namespace server
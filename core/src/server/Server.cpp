@@ -14,16 +14,23 @@
 #include <fcntl.h>
 #include <string.h>
 #include <unistd.h>
+#include <future>
 
 #include "metrics/Metrics.h"
 #include "scheduler/SchedInst.h"
 #include "server/Config.h"
 #include "server/DBWrapper.h"
+#include "server/delivery/MetaChangeListener.h"
+#include "server/delivery/RecallMonitor.h"
+#include "server/delivery/ShardProxy.h"
+#include "server/delivery/SlowQueryLog.h"
 #include "server/grpc_impl/GrpcServer.h"
+#include "server/grpc_impl/QueryCapture.h"
 #include "server/web_impl/WebServer.h"
 #include "src/version.h"
 #include "storage/s3/S3ClientWrapper.h"
 #include "tracing/TracerUtil.h"
+#include "utils/LargeBuffer.h"
 #include "utils/Log.h"
 #include "utils/LogUtil.h"
 #include "utils/SignalUtil.h"
@@ -195,6 +202,7 @@ Server::Start() {
 #endif
         server::Metrics::GetInstance().Init();
         server::SystemInfo::GetInstance().Init();
+        ConfigureLargeAllocations();
 
         StartService();
         return Status::OK();
@@ -255,9 +263,17 @@ Server::LoadConfig() {
 
 void
 Server::StartService() {
-    engine::KnowhereResource::Initialize();
-    scheduler::StartSchedulerService();
+    // gpu devices come up while the db opens meta and replays wal, jobs the db puts meanwhile wait in the job queue
+    // until the scheduler, which takes the devices, starts
+    auto gpu_init = std::async(std::launch::async, &engine::KnowhereResource::Initialize);
     DBWrapper::GetInstance().StartService();
+    gpu_init.get();
+    scheduler::StartSchedulerService();
+    SlowQueryLog::GetInstance().Start();
+    RecallMonitor::GetInstance().Start();
+    ShardProxy::GetInstance().Start();
+    MetaChangeListener::GetInstance().Start();
+    grpc::QueryCapture::GetInstance().Start();
     grpc::GrpcServer::GetInstance().Start();
     web::WebServer::GetInstance().Start();
     storage::S3ClientWrapper::GetInstance().StartService();
@@ -268,6 +284,11 @@ Server::StopService() {
     storage::S3ClientWrapper::GetInstance().StopService();
     web::WebServer::GetInstance().Stop();
     grpc::GrpcServer::GetInstance().Stop();
+    grpc::QueryCapture::GetInstance().Stop();
+    MetaChangeListener::GetInstance().Stop();
+    ShardProxy::GetInstance().Stop();
+    RecallMonitor::GetInstance().Stop();
+    SlowQueryLog::GetInstance().Stop();
     DBWrapper::GetInstance().StopService();
     scheduler::StopSchedulerService();
     engine::KnowhereResource::Finalize();
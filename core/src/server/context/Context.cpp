@@ -26,17 +26,69 @@ void
 Context::SetTraceContext(const std::shared_ptr<tracing::TraceContext>& trace_context) {
     trace_context_ = trace_context;
 }
+
+bool
+Context::IsTraced() const {
+    return trace_context_ != nullptr && trace_context_->IsSampled();
+}
+
+void
+Context::SetDeadline(const std::chrono::system_clock::time_point& deadline) {
+    deadline_ = deadline;
+}
+
+const std::chrono::system_clock::time_point&
+Context::GetDeadline() const {
+    return deadline_;
+}
+
+bool
+Context::IsExpired() const {
+    return deadline_ != std::chrono::system_clock::time_point::max() && std::chrono::system_clock::now() >= deadline_;
+}
+
+void
+Context::Cancel() {
+    cancelled_->store(true);
+}
+
+bool
+Context::IsCancelled() const {
+    return cancelled_->load();
+}
+
+void
+Context::DetachCancellation() {
+    cancelled_ = std::make_shared<std::atomic<bool>>(false);
+}
+
+const QueryCostPtr&
+Context::GetQueryCost() const {
+    return query_cost_;
+}
+
+void
+Context::DetachQueryCost() {
+    query_cost_ = std::make_shared<QueryCost>();
+}
+
 std::shared_ptr<Context>
 Context::Child(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
-    new_context->SetTraceContext(trace_context_->Child(operation_name));
+    new_context->SetTraceContext(IsTraced() ? trace_context_->Child(operation_name) : trace_context_);
+    new_context->SetDeadline(deadline_);
+    new_context->cancelled_ = cancelled_;
+    new_context->query_cost_ = query_cost_;
     return new_context;
 }
 
 std::shared_ptr<Context>
 Context::Follower(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
-    new_context->SetTraceContext(trace_context_->Follower(operation_name));
+    new_context->SetTraceContext(IsTraced() ? trace_context_->Follower(operation_name) : trace_context_);
+    new_context->SetDeadline(deadline_);
+    new_context->cancelled_ = cancelled_;
+    new_context->query_cost_ = query_cost_;
     return new_context;
 }
 
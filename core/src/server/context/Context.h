@@ -11,15 +11,52 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "tracing/TraceContext.h"
 
 namespace milvus {
 namespace server {
 
+// one segment searched for a call, on the resource the optimizer placed it
+struct SegmentCost {
+    size_t file_id_ = 0;
+    int32_t engine_type_ = 0;
+    int64_t row_count_ = 0;
+    std::string resource_;
+    int64_t load_us_ = 0;
+    int64_t search_us_ = 0;
+    int64_t reduce_us_ = 0;
+};
+
+// resources spent to serve one call, accounted by the tasks working for it
+struct QueryCost {
+    std::atomic<int64_t> cpu_time_us_{0};
+    std::atomic<int64_t> gpu_time_us_{0};
+    std::atomic<int64_t> segments_searched_{0};
+    std::atomic<int64_t> vectors_scanned_{0};
+    std::atomic<int64_t> bytes_loaded_{0};
+    std::atomic<int64_t> cache_misses_{0};
+
+    std::mutex segments_mutex_;
+    std::vector<SegmentCost> segments_;
+
+    void
+    AddSegment(SegmentCost&& segment) {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        segments_.emplace_back(std::move(segment));
+    }
+};
+
+using QueryCostPtr = std::shared_ptr<QueryCost>;
+
 class Context {
  public:
     explicit Context(const std::string& request_id);
@@ -36,9 +73,45 @@ class Context {
     const std::shared_ptr<tracing::TraceContext>&
     GetTraceContext() const;
 
+    // an unsampled call shares one no-op span with all its child and follower contexts
+    bool
+    IsTraced() const;
+
+    // deadline of the client call, inherited by child and follower contexts
+    void
+    SetDeadline(const std::chrono::system_clock::time_point& deadline);
+
+    const std::chrono::system_clock::time_point&
+    GetDeadline() const;
+
+    bool
+    IsExpired() const;
+
+    // cancellation of the client call, shared by child and follower contexts
+    void
+    Cancel();
+
+    bool
+    IsCancelled() const;
+
+    // stop sharing the cancellation of the parent, for a context working for several calls
+    void
+    DetachCancellation();
+
+    // resources spent by the call, shared by child and follower contexts
+    const QueryCostPtr&
+    GetQueryCost() const;
+
+    // account into a cost of its own, for a context working for several calls
+    void
+    DetachQueryCost();
+
  private:
     std::string request_id_;
     std::shared_ptr<tracing::TraceContext> trace_context_;
+    std::chrono::system_clock::time_point deadline_ = std::chrono::system_clock::time_point::max();
+    std::shared_ptr<std::atomic<bool>> cancelled_ = std::make_shared<std::atomic<bool>>(false);
+    QueryCostPtr query_cost_ = std::make_shared<QueryCost>();
 };
 
 }  // namespace server
@@ -0,0 +1,129 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/MetaChangeListener.h"
+
+#include <grpcpp/create_channel.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "db/meta/MetaChangeFeed.h"
+#include "server/Config.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+
+namespace {
+
+// a change is seen within a poll, polls are answered from memory of the writable node
+constexpr std::chrono::milliseconds POLL_INTERVAL(100);
+constexpr std::chrono::milliseconds POLL_TIMEOUT(1000);
+
+}  // namespace
+
+void
+MetaChangeListener::Start() {
+    if (thread_.joinable()) {
+        return;
+    }
+
+    Config& config = Config::GetInstance();
+    std::string mode, writable_node;
+    config.GetServerConfigDeployMode(mode);
+    config.GetServerConfigWritableNode(writable_node);
+    if (mode != "cluster_readonly" || writable_node.empty()) {
+        return;
+    }
+
+    auto channel = ::grpc::CreateChannel(writable_node, ::grpc::InsecureChannelCredentials());
+    stub_ = ::milvus::grpc::MilvusService::NewStub(channel);
+    running_ = true;
+    thread_ = std::thread(&MetaChangeListener::Run, this);
+
+    SERVER_LOG_INFO << "Meta changes are followed from writable node " << writable_node;
+}
+
+void
+MetaChangeListener::Stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void
+MetaChangeListener::Run() {
+    bool reached = true;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, POLL_INTERVAL, [this] { return !running_; });
+            if (!running_) {
+                break;
+            }
+        }
+
+        bool ok = Poll();
+        if (ok != reached) {
+            if (ok) {
+                SERVER_LOG_INFO << "Writable node is reached again";
+            } else {
+                SERVER_LOG_WARNING << "Failed to fetch meta changes of writable node";
+            }
+            reached = ok;
+        }
+    }
+}
+
+bool
+MetaChangeListener::Poll() {
+    ::grpc::ClientContext context;
+    context.set_deadline(std::chrono::system_clock::now() + POLL_TIMEOUT);
+    ::milvus::grpc::Command command;
+    command.set_cmd("meta_changes " + std::to_string(epoch_) + " " + std::to_string(version_));
+    ::milvus::grpc::StringReply reply;
+    auto grpc_status = stub_->Cmd(&context, command, &reply);
+    if (!grpc_status.ok() || reply.status().error_code() != ::milvus::grpc::SUCCESS) {
+        return false;
+    }
+
+    uint64_t epoch = 0, version = 0;
+    bool complete = false;
+    std::vector<engine::meta::MetaChange> changes;
+    if (!engine::meta::MetaChangeFeed::Decode(reply.string_reply(), epoch, version, complete, changes)) {
+        SERVER_LOG_ERROR << "Invalid meta changes: " << reply.string_reply();
+        return false;
+    }
+
+    // changes missed, e.g. the writable node restarted, every table is refreshed
+    auto status = DBWrapper::DB()->ApplyMetaChanges(changes, complete);
+    if (!status.ok()) {
+        return true;
+    }
+    if (!complete) {
+        SERVER_LOG_INFO << "Meta changes of writable node are followed from version " << version;
+    }
+    epoch_ = epoch;
+    version_ = version;
+    return true;
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,63 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "grpc/gen-milvus/milvus.grpc.pb.h"
+
+namespace milvus {
+namespace server {
+
+// a cluster_readonly node with server_config.writable_node set follows the meta changes of the writable node:
+// files merged away are dropped from its cache and searches, new files are loaded before they are searched
+class MetaChangeListener {
+ public:
+    static MetaChangeListener&
+    GetInstance() {
+        static MetaChangeListener listener;
+        return listener;
+    }
+
+    void
+    Start();
+
+    void
+    Stop();
+
+ private:
+    MetaChangeListener() = default;
+
+    void
+    Run();
+
+    // fetch and apply the changes after the version seen, false if the writable node isn't reached
+    bool
+    Poll();
+
+ private:
+    std::unique_ptr<::milvus::grpc::MilvusService::Stub> stub_;
+    uint64_t epoch_ = 0;
+    uint64_t version_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_ = false;
+    std::thread thread_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,162 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/RecallMonitor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+#include "metrics/Metrics.h"
+#include "server/Config.h"
+#include "server/DBWrapper.h"
+#include "server/context/Context.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+
+namespace {
+// queries of a search searched again, brute force costs nq times the table size
+constexpr size_t RECALL_SAMPLE_QUERY_NUM = 10;
+// samples waiting to be searched, more are dropped
+constexpr size_t RECALL_SAMPLE_QUEUE_CAPACITY = 4;
+}  // namespace
+
+void
+RecallMonitor::Start() {
+    if (thread_.joinable()) {
+        return;
+    }
+
+    float rate = 0.0;
+    Config::GetInstance().GetEngineConfigRecallSampleRate(rate);
+    SetSampleRate(rate);
+
+    queue_.SetCapacity(RECALL_SAMPLE_QUEUE_CAPACITY);
+    thread_ = std::thread(&RecallMonitor::Run, this);
+    running_ = true;
+}
+
+void
+RecallMonitor::Stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    running_ = false;
+    queue_.Put(nullptr);
+    thread_.join();
+}
+
+void
+RecallMonitor::SetSampleRate(float rate) {
+    sample_interval_ = (rate > 0.0) ? std::max<uint64_t>(1, std::llround(1.0 / rate)) : 0;
+}
+
+bool
+RecallMonitor::ShouldSample() {
+    uint64_t interval = sample_interval_.load(std::memory_order_relaxed);
+    return interval > 0 && running_.load(std::memory_order_relaxed) &&
+           (search_count_.fetch_add(1, std::memory_order_relaxed) % interval) == 0;
+}
+
+void
+RecallMonitor::Sample(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                      int32_t engine_type, int64_t topk, const engine::VectorsData& vectors,
+                      const engine::ResultIds& result_ids) {
+    uint64_t nq = vectors.vector_count_;
+    if (nq == 0 || topk <= 0 || result_ids.empty()) {
+        return;
+    }
+
+    auto sample = std::make_shared<RecallSample>();
+    sample->table_id_ = table_id;
+    sample->partition_tags_ = partition_tags;
+    sample->engine_type_ = engine_type;
+    sample->topk_ = topk;
+
+    uint64_t sample_nq = std::min<uint64_t>(nq, RECALL_SAMPLE_QUERY_NUM);
+    size_t float_size = vectors.float_data_.size() / nq * sample_nq;
+    size_t binary_size = vectors.binary_data_.size() / nq * sample_nq;
+    size_t ids_size = result_ids.size() / nq * sample_nq;
+    sample->vectors_.vector_count_ = sample_nq;
+    sample->vectors_.float_data_.assign(vectors.float_data_.begin(), vectors.float_data_.begin() + float_size);
+    sample->vectors_.binary_data_.assign(vectors.binary_data_.begin(), vectors.binary_data_.begin() + binary_size);
+    sample->result_ids_.assign(result_ids.begin(), result_ids.begin() + ids_size);
+
+    if (!queue_.TryPut(sample)) {
+        SERVER_LOG_DEBUG << "Recall monitor is busy, a sample of table " << table_id << " is dropped";
+    }
+}
+
+double
+RecallMonitor::Recall(const engine::ResultIds& ids, size_t ids_k, const engine::ResultIds& exact_ids, size_t exact_k,
+                      size_t nq) {
+    double recall_sum = 0.0;
+    size_t counted = 0;
+    for (size_t i = 0; i < nq; i++) {
+        std::unordered_set<int64_t> found(ids.begin() + i * ids_k, ids.begin() + (i + 1) * ids_k);
+        size_t exact_num = 0, hit_num = 0;
+        for (size_t j = 0; j < exact_k; j++) {
+            int64_t id = exact_ids[i * exact_k + j];
+            if (id < 0) {
+                continue;
+            }
+            ++exact_num;
+            if (found.find(id) != found.end()) {
+                ++hit_num;
+            }
+        }
+        if (exact_num > 0) {
+            recall_sum += static_cast<double>(hit_num) / exact_num;
+            ++counted;
+        }
+    }
+    return counted > 0 ? recall_sum / counted : 1.0;
+}
+
+void
+RecallMonitor::Run() {
+    while (true) {
+        auto sample = queue_.Take();
+        if (sample == nullptr) {
+            break;
+        }
+
+        auto db = DBWrapper::DB();
+        if (db == nullptr) {
+            continue;
+        }
+
+        auto context = std::make_shared<Context>("recall_monitor");
+        engine::ResultIds exact_ids;
+        engine::ResultDistances exact_distances;
+        auto status = db->QueryExact(context, sample->table_id_, sample->partition_tags_, sample->topk_,
+                                     sample->vectors_, exact_ids, exact_distances);
+        uint64_t nq = sample->vectors_.vector_count_;
+        if (!status.ok() || exact_ids.empty()) {
+            SERVER_LOG_DEBUG << "Recall monitor failed to search table " << sample->table_id_ << " exactly: "
+                             << status.message();
+            continue;
+        }
+
+        double recall = Recall(sample->result_ids_, sample->result_ids_.size() / nq, exact_ids,
+                               exact_ids.size() / nq, nq);
+        SERVER_LOG_DEBUG << "Recall of table " << sample->table_id_ << " index " << sample->engine_type_ << ": "
+                         << recall;
+        Metrics::GetInstance().SearchRecallHistogramObserve(sample->table_id_, std::to_string(sample->engine_type_),
+                                                            recall);
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db/Types.h"
+#include "utils/BlockingQueue.h"
+
+namespace milvus {
+namespace server {
+
+// a fraction of searches are searched again by brute force on raw files in background, recall@k of their results
+// is exported per table and index type, so nprobe can be lowered safely and recall drift after merges is seen
+class RecallMonitor {
+ public:
+    static RecallMonitor&
+    GetInstance() {
+        static RecallMonitor monitor;
+        return monitor;
+    }
+
+    void
+    Start();
+
+    void
+    Stop();
+
+    // one of every 1/rate searches is sampled, 0 disables sampling
+    void
+    SetSampleRate(float rate);
+
+    // cheap enough for every search
+    bool
+    ShouldSample();
+
+    // the first queries of the search are copied with their result ids, the sample is dropped if the monitor
+    // is still busy with earlier ones
+    void
+    Sample(const std::string& table_id, const std::vector<std::string>& partition_tags, int32_t engine_type,
+           int64_t topk, const engine::VectorsData& vectors, const engine::ResultIds& result_ids);
+
+    // mean over queries of the fraction of exact neighbors found, queries are at a stride of ids_k and exact_k
+    static double
+    Recall(const engine::ResultIds& ids, size_t ids_k, const engine::ResultIds& exact_ids, size_t exact_k, size_t nq);
+
+ private:
+    RecallMonitor() = default;
+
+    struct RecallSample {
+        std::string table_id_;
+        std::vector<std::string> partition_tags_;
+        int32_t engine_type_ = 0;
+        int64_t topk_ = 0;
+        engine::VectorsData vectors_;
+        engine::ResultIds result_ids_;
+    };
+    using RecallSamplePtr = std::shared_ptr<RecallSample>;
+
+    void
+    Run();
+
+ private:
+    std::atomic<uint64_t> sample_interval_{0};
+    std::atomic<uint64_t> search_count_{0};
+    std::atomic<bool> running_{false};
+    BlockingQueue<RecallSamplePtr> queue_;
+    std::thread thread_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -23,9 +23,11 @@
 #include "server/delivery/request/DropIndexRequest.h"
 #include "server/delivery/request/DropPartitionRequest.h"
 #include "server/delivery/request/DropTableRequest.h"
+#include "server/delivery/request/GetVectorByIDRequest.h"
 #include "server/delivery/request/HasTableRequest.h"
 #include "server/delivery/request/InsertRequest.h"
 #include "server/delivery/request/PreloadTableRequest.h"
+#include "server/delivery/request/SearchBatchRequest.h"
 #include "server/delivery/request/SearchRequest.h"
 #include "server/delivery/request/ShowPartitionsRequest.h"
 #include "server/delivery/request/ShowTablesRequest.h"
@@ -33,6 +35,15 @@
 namespace milvus {
 namespace server {
 
+namespace {
+void
+ExecRequestAsync(const BaseRequestPtr& request_ptr, const RequestCallback& done) {
+    // a request failing to be queued is done by the scheduler, the callback is called then
+    request_ptr->SetCallback(done);
+    RequestScheduler::GetInstance().ExecuteRequest(request_ptr);
+}
+}  // namespace
+
 Status
 RequestHandler::CreateTable(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t dimension,
                             int64_t index_file_size, int64_t metric_type) {
@@ -77,6 +88,22 @@ RequestHandler::Insert(const std::shared_ptr<Context>& context, const std::strin
     return request_ptr->status();
 }
 
+void
+RequestHandler::InsertAsync(const std::shared_ptr<Context>& context, const std::string& table_name,
+                            engine::VectorsData& vectors, const std::string& partition_tag,
+                            const RequestCallback& done) {
+    BaseRequestPtr request_ptr = InsertRequest::Create(context, table_name, vectors, partition_tag);
+    ExecRequestAsync(request_ptr, done);
+}
+
+void
+RequestHandler::BulkInsertAsync(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                engine::VectorsData& vectors, const std::string& partition_tag,
+                                const RequestCallback& done) {
+    BaseRequestPtr request_ptr = InsertRequest::CreateBulk(context, table_name, vectors, partition_tag);
+    ExecRequestAsync(request_ptr, done);
+}
+
 Status
 RequestHandler::ShowTables(const std::shared_ptr<Context>& context, std::vector<std::string>& tables) {
     BaseRequestPtr request_ptr = ShowTablesRequest::Create(context, tables);
@@ -98,6 +125,37 @@ RequestHandler::Search(const std::shared_ptr<Context>& context, const std::strin
     return request_ptr->status();
 }
 
+void
+RequestHandler::SearchAsync(const std::shared_ptr<Context>& context, const std::string& table_name,
+                            const engine::VectorsData& vectors, const std::vector<Range>& range_list, int64_t topk,
+                            int64_t nprobe, const std::vector<std::string>& partition_list,
+                            const std::vector<std::string>& file_id_list, TopKQueryResult& result,
+                            const RequestCallback& done) {
+    BaseRequestPtr request_ptr = SearchRequest::Create(context, table_name, vectors, range_list, topk, nprobe,
+                                                       partition_list, file_id_list, result);
+    ExecRequestAsync(request_ptr, done);
+}
+
+void
+RequestHandler::SearchByRangeAsync(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                   const engine::VectorsData& vectors, const std::vector<Range>& range_list,
+                                   float radius, int64_t max_results, int64_t nprobe,
+                                   const std::vector<std::string>& partition_list, TopKQueryResult& result,
+                                   const RequestCallback& done) {
+    BaseRequestPtr request_ptr = SearchRequest::CreateByRange(context, table_name, vectors, range_list, radius,
+                                                              max_results, nprobe, partition_list, result);
+    ExecRequestAsync(request_ptr, done);
+}
+
+Status
+RequestHandler::SearchBatch(const std::shared_ptr<Context>& context, const std::string& table_name,
+                            const std::vector<SearchQueryParam>& query_params, std::vector<TopKQueryResult>& results) {
+    BaseRequestPtr request_ptr = SearchBatchRequest::Create(context, table_name, query_params, results);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
 Status
 RequestHandler::DescribeTable(const std::shared_ptr<Context>& context, const std::string& table_name,
                               TableSchema& table_schema) {
@@ -115,6 +173,15 @@ RequestHandler::CountTable(const std::shared_ptr<Context>& context, const std::s
     return request_ptr->status();
 }
 
+Status
+RequestHandler::GetVectorByID(const std::shared_ptr<Context>& context, const std::string& table_name,
+                              int64_t vector_id, engine::VectorsData& vector) {
+    BaseRequestPtr request_ptr = GetVectorByIDRequest::Create(context, table_name, vector_id, vector);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
 Status
 RequestHandler::Cmd(const std::shared_ptr<Context>& context, const std::string& cmd, std::string& reply) {
     BaseRequestPtr request_ptr = CmdRequest::Create(context, cmd, reply);
@@ -44,6 +44,16 @@ class RequestHandler {
     Insert(const std::shared_ptr<Context>& context, const std::string& table_name, engine::VectorsData& vectors,
            const std::string& partition_tag);
 
+    // queue the insert and return at once, vectors are kept by the caller until done is called
+    void
+    InsertAsync(const std::shared_ptr<Context>& context, const std::string& table_name, engine::VectorsData& vectors,
+                const std::string& partition_tag, const RequestCallback& done);
+
+    // same as InsertAsync but the vectors are written to table files directly, bypassing insert buffer
+    void
+    BulkInsertAsync(const std::shared_ptr<Context>& context, const std::string& table_name,
+                    engine::VectorsData& vectors, const std::string& partition_tag, const RequestCallback& done);
+
     Status
     ShowTables(const std::shared_ptr<Context>& context, std::vector<std::string>& tables);
 
@@ -53,12 +63,35 @@ class RequestHandler {
            const std::vector<std::string>& partition_list, const std::vector<std::string>& file_id_list,
            TopKQueryResult& result);
 
+    // queue the search and return at once, result is filled when done is called
+    void
+    SearchAsync(const std::shared_ptr<Context>& context, const std::string& table_name,
+                const engine::VectorsData& vectors, const std::vector<Range>& range_list, int64_t topk, int64_t nprobe,
+                const std::vector<std::string>& partition_list, const std::vector<std::string>& file_id_list,
+                TopKQueryResult& result, const RequestCallback& done);
+
+    // queue the range search and return at once, result is filled when done is called
+    void
+    SearchByRangeAsync(const std::shared_ptr<Context>& context, const std::string& table_name,
+                       const engine::VectorsData& vectors, const std::vector<Range>& range_list, float radius,
+                       int64_t max_results, int64_t nprobe, const std::vector<std::string>& partition_list,
+                       TopKQueryResult& result, const RequestCallback& done);
+
+    // several searches on one table, results are in the order of query_params
+    Status
+    SearchBatch(const std::shared_ptr<Context>& context, const std::string& table_name,
+                const std::vector<SearchQueryParam>& query_params, std::vector<TopKQueryResult>& results);
+
     Status
     DescribeTable(const std::shared_ptr<Context>& context, const std::string& table_name, TableSchema& table_schema);
 
     Status
     CountTable(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t& count);
 
+    Status
+    GetVectorByID(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t vector_id,
+                  engine::VectorsData& vector);
+
     Status
     Cmd(const std::shared_ptr<Context>& context, const std::string& cmd, std::string& reply);
 
@@ -0,0 +1,67 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/RequestLatency.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+namespace {
+// percentiles are taken over this many latest requests of a type
+constexpr size_t RECENT_REQUEST_NUM = 1024;
+
+double
+PercentileMs(const std::vector<int64_t>& sorted_us, double percentile) {
+    if (sorted_us.empty()) {
+        return 0.0;
+    }
+    auto index = static_cast<size_t>(percentile * (sorted_us.size() - 1) + 0.5);
+    return sorted_us[index] / 1000.0;
+}
+}  // namespace
+
+void
+RequestLatency::Record(const std::string& request_type, int64_t latency_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& latencies = latencies_[request_type];
+    ++latencies.count;
+    latencies.recent_us.push_back(latency_us);
+    if (latencies.recent_us.size() > RECENT_REQUEST_NUM) {
+        latencies.recent_us.pop_front();
+    }
+}
+
+json
+RequestLatency::Dump() {
+    std::map<std::string, Latencies> latencies;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        latencies = latencies_;
+    }
+
+    json ret = json::object();
+    for (auto& pair : latencies) {
+        std::vector<int64_t> sorted_us(pair.second.recent_us.begin(), pair.second.recent_us.end());
+        std::sort(sorted_us.begin(), sorted_us.end());
+        ret[pair.first] = {
+            {"count", pair.second.count},
+            {"p50_ms", PercentileMs(sorted_us, 0.5)},
+            {"p99_ms", PercentileMs(sorted_us, 0.99)},
+        };
+    }
+    return ret;
+}
+
+}  // namespace server
+}  // namespace milvus
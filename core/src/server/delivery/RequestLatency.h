@@ -0,0 +1,55 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "utils/Json.h"
+
+namespace milvus {
+namespace server {
+
+// latencies of the latest requests of each type, from creation to done, for the "perf" command
+class RequestLatency {
+ public:
+    static RequestLatency&
+    GetInstance() {
+        static RequestLatency latency;
+        return latency;
+    }
+
+    void
+    Record(const std::string& request_type, int64_t latency_us);
+
+    // {"SearchRequest": {"count": 10, "p50_ms": 1.2, "p99_ms": 8.5}, ...}, count is since start
+    json
+    Dump();
+
+ private:
+    RequestLatency() = default;
+
+ private:
+    struct Latencies {
+        uint64_t count = 0;
+        std::deque<int64_t> recent_us;
+    };
+
+    std::mutex mutex_;
+    std::map<std::string, Latencies> latencies_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/RequestScheduler.h"
+#include "server/Config.h"
+#include "server/delivery/request/SearchCombineRequest.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
@@ -19,6 +21,24 @@
 namespace milvus {
 namespace server {
 
+namespace {
+// workers of a request group, only searches, inserts and ddl requests take the configured numbers
+int64_t
+GroupWorkerNum(const std::string& group_name) {
+    Config& config = Config::GetInstance();
+    int64_t worker_num = 1;
+    Status status;
+    if (group_name == DQL_REQUEST_GROUP) {
+        status = config.GetServerConfigSearchWorkerNum(worker_num);
+    } else if (group_name == DML_REQUEST_GROUP) {
+        status = config.GetServerConfigInsertWorkerNum(worker_num);
+    } else if (group_name == DDL_DML_REQUEST_GROUP) {
+        status = config.GetServerConfigDDLWorkerNum(worker_num);
+    }
+    return status.ok() ? worker_num : 1;
+}
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 RequestScheduler::RequestScheduler() : stopped_(false) {
     Start();
@@ -62,7 +82,9 @@ RequestScheduler::Stop() {
         std::lock_guard<std::mutex> lock(queue_mtx_);
         for (auto& iter : request_groups_) {
             if (iter.second != nullptr) {
-                iter.second->Put(nullptr);
+                for (int64_t i = 0; i < group_workers_[iter.first]; ++i) {
+                    iter.second->Put(nullptr);
+                }
             }
         }
     }
@@ -73,11 +95,26 @@ RequestScheduler::Stop() {
         iter->join();
     }
     request_groups_.clear();
+    group_workers_.clear();
     execute_threads_.clear();
     stopped_ = true;
     SERVER_LOG_INFO << "Scheduler stopped";
 }
 
+json
+RequestScheduler::Dump() const {
+    std::lock_guard<std::mutex> lock(queue_mtx_);
+    json ret = json::object();
+    for (auto& iter : request_groups_) {
+        auto workers = group_workers_.find(iter.first);
+        ret[iter.first] = {
+            {"queued", iter.second != nullptr ? iter.second->Size() : 0},
+            {"workers", workers != group_workers_.end() ? workers->second : 0},
+        };
+    }
+    return ret;
+}
+
 Status
 RequestScheduler::ExecuteRequest(const BaseRequestPtr& request_ptr) {
     if (request_ptr == nullptr) {
@@ -88,7 +125,11 @@ RequestScheduler::ExecuteRequest(const BaseRequestPtr& request_ptr) {
     fiu_do_on("RequestScheduler.ExecuteRequest.push_queue_fail", status = Status(SERVER_INVALID_ARGUMENT, ""));
 
     if (!status.ok()) {
-        SERVER_LOG_ERROR << "Put request to queue failed with code: " << status.ToString();
+        // a rejected request is done at once, so nobody waits for it
+        if (status.code() != SERVER_REQUEST_QUEUE_FULL) {
+            SERVER_LOG_ERROR << "Put request to queue failed with code: " << status.ToString();
+        }
+        request_ptr->Done(status);
         return status;
     }
 
@@ -110,6 +151,7 @@ RequestScheduler::TakeToExecute(RequestQueuePtr request_queue) {
             SERVER_LOG_ERROR << "Take null from request queue, stop thread";
             break;  // stop the thread
         }
+        request = CombineRequests(request, request_queue);
 
         try {
             fiu_do_on("RequestScheduler.TakeToExecute.throw_std_exception1", throw std::exception());
@@ -125,25 +167,68 @@ RequestScheduler::TakeToExecute(RequestQueuePtr request_queue) {
     }
 }
 
+BaseRequestPtr
+RequestScheduler::CombineRequests(const BaseRequestPtr& request, const RequestQueuePtr& request_queue) {
+    auto search_request = std::dynamic_pointer_cast<SearchRequest>(request);
+    if (!SearchCombineRequest::CanCombine(search_request)) {
+        return request;
+    }
+
+    // other workers of the group take from the queue too, the front is checked and taken at once
+    std::shared_ptr<SearchCombineRequest> combine_request;
+    BaseRequestPtr next_request;
+    auto combine = [&](const BaseRequestPtr& front) {
+        auto next_search = std::dynamic_pointer_cast<SearchRequest>(front);
+        if (!SearchCombineRequest::CanCombine(next_search)) {
+            return false;
+        }
+        if (combine_request == nullptr) {
+            combine_request = SearchCombineRequest::Create(search_request);
+        }
+        return combine_request->Combine(next_search);
+    };
+    while (request_queue->TakeIf(combine, next_request)) {
+    }
+
+    if (combine_request == nullptr || combine_request->RequestCount() <= 1) {
+        return request;
+    }
+
+    SERVER_LOG_DEBUG << "Combine " << combine_request->RequestCount() << " search requests";
+    return combine_request;
+}
+
 Status
 RequestScheduler::PutToQueue(const BaseRequestPtr& request_ptr) {
     std::lock_guard<std::mutex> lock(queue_mtx_);
 
     std::string group_name = request_ptr->RequestGroup();
     if (request_groups_.count(group_name) > 0) {
-        request_groups_[group_name]->Put(request_ptr);
+        // requests beyond the capacity are rejected rather than piled up, the client retries later
+        if (!request_groups_[group_name]->TryPut(request_ptr)) {
+            return Status(SERVER_REQUEST_QUEUE_FULL,
+                          "Too many requests in group " + group_name + ", server is overloaded, retry later");
+        }
     } else {
+        int64_t queue_size = 0;
+        Config::GetInstance().GetServerConfigRequestQueueSize(queue_size);
+        int64_t worker_num = GroupWorkerNum(group_name);
+
         RequestQueuePtr queue = std::make_shared<RequestQueue>();
+        queue->SetCapacity(queue_size);
         queue->Put(request_ptr);
         request_groups_.insert(std::make_pair(group_name, queue));
+        group_workers_[group_name] = worker_num;
         fiu_do_on("RequestScheduler.PutToQueue.null_queue", queue = nullptr);
 
-        // start a thread
-        ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
+        // start the workers
+        for (int64_t i = 0; i < worker_num; ++i) {
+            ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
 
-        fiu_do_on("RequestScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
-        execute_threads_.push_back(thread);
-        SERVER_LOG_INFO << "Create new thread for request group: " << group_name;
+            fiu_do_on("RequestScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
+            execute_threads_.push_back(thread);
+        }
+        SERVER_LOG_INFO << "Create " << worker_num << " threads for request group: " << group_name;
     }
 
     return Status::OK();
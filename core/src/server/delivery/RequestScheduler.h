@@ -13,6 +13,7 @@
 
 #include "server/delivery/request/BaseRequest.h"
 #include "utils/BlockingQueue.h"
+#include "utils/Json.h"
 #include "utils/Status.h"
 
 #include <map>
@@ -48,6 +49,10 @@ class RequestScheduler {
     static void
     ExecRequest(BaseRequestPtr& request_ptr);
 
+    // {"dql": {"queued": 3, "workers": 4}, ...}
+    json
+    Dump() const;
+
  protected:
     RequestScheduler();
 
@@ -59,10 +64,15 @@ class RequestScheduler {
     Status
     PutToQueue(const BaseRequestPtr& request_ptr);
 
+    // merge the compatible requests waiting at the queue front into one request
+    static BaseRequestPtr
+    CombineRequests(const BaseRequestPtr& request, const RequestQueuePtr& request_queue);
+
  private:
     mutable std::mutex queue_mtx_;
 
     std::map<std::string, RequestQueuePtr> request_groups_;
+    std::map<std::string, int64_t> group_workers_;
 
     std::vector<ThreadPtr> execute_threads_;
 
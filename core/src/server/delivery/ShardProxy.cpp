@@ -0,0 +1,202 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "server/delivery/ShardProxy.h"
+
+#include <grpcpp/create_channel.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "db/engine/ExecutionEngine.h"
+#include "scheduler/task/SearchTask.h"
+#include "server/Config.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+
+namespace {
+
+// bounds searches of clients setting no deadline, a node hung up would hold the search forever
+constexpr std::chrono::seconds SEARCH_TIMEOUT(60);
+
+struct SearchInFilesCall {
+    std::string node_;
+    ::grpc::ClientContext context_;
+    ::grpc::Status grpc_status_;
+    ::milvus::grpc::TopKQueryResult reply_;
+    std::unique_ptr<::grpc::ClientAsyncResponseReader<::milvus::grpc::TopKQueryResult>> reader_;
+};
+
+void
+CopyQueryVectors(const engine::VectorsData& vectors, ::milvus::grpc::SearchParam& search_param) {
+    uint64_t nq = vectors.vector_count_;
+    if (!vectors.float_data_.empty()) {
+        size_t dim = vectors.float_data_.size() / nq;
+        for (uint64_t i = 0; i < nq; i++) {
+            auto float_data = search_param.add_query_record_array()->mutable_float_data();
+            float_data->Resize(static_cast<int>(dim), 0.0);
+            memcpy(float_data->mutable_data(), vectors.float_data_.data() + i * dim, dim * sizeof(float));
+        }
+    } else {
+        size_t bytes = vectors.binary_data_.size() / nq;
+        for (uint64_t i = 0; i < nq; i++) {
+            search_param.add_query_record_array()->set_binary_data(vectors.binary_data_.data() + i * bytes, bytes);
+        }
+    }
+}
+
+}  // namespace
+
+void
+ShardProxy::Start() {
+    std::vector<std::string> nodes;
+    Config::GetInstance().GetServerConfigProxyNodes(nodes);
+    if (nodes.empty()) {
+        return;
+    }
+
+    // a node is named by host:port on the ring, nodes sharing a host are told apart
+    std::vector<std::string> names;
+    for (auto& node : nodes) {
+        if (stubs_.find(node) != stubs_.end()) {
+            continue;
+        }
+        auto channel = ::grpc::CreateChannel(node, ::grpc::InsecureChannelCredentials());
+        stubs_[node] = ::milvus::grpc::MilvusService::NewStub(channel);
+        names.push_back(node);
+    }
+    ring_ = std::make_shared<HashRing>(names);
+    enabled_ = true;
+
+    SERVER_LOG_INFO << "Searches are proxied to " << nodes.size() << " readonly nodes";
+}
+
+void
+ShardProxy::Stop() {
+    enabled_ = false;
+}
+
+Status
+ShardProxy::Search(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                   const std::vector<std::pair<std::string, std::string>>& range_list, int64_t topk, int64_t nprobe,
+                   const engine::VectorsData& vectors, const std::chrono::system_clock::time_point& deadline,
+                   engine::ResultIds& result_ids, engine::ResultDistances& result_distances) {
+    result_ids.clear();
+    result_distances.clear();
+
+    engine::meta::TableFilesSchema files;
+    auto status = DBWrapper::DB()->GetSearchFiles(table_id, partition_tags, files);
+    if (!status.ok() || files.empty()) {
+        return status;
+    }
+    bool ascending = (files.front().metric_type_ != static_cast<int>(engine::MetricType::IP));
+
+    // step 1: find the node owning each file, files of partitions are searched under their own table ids
+    std::map<std::string, std::map<std::string, std::vector<std::string>>> routing;
+    for (auto& file : files) {
+        std::string file_id = std::to_string(file.id_);
+        routing[ring_->GetNode(file_id)][file.table_id_].push_back(file_id);
+    }
+
+    // step 2: send all searches at once
+    ::milvus::grpc::SearchParam search_param;
+    search_param.set_topk(topk);
+    search_param.set_nprobe(nprobe);
+    for (auto& range : range_list) {
+        auto grpc_range = search_param.add_query_range_array();
+        grpc_range->set_start_value(range.first);
+        grpc_range->set_end_value(range.second);
+    }
+    CopyQueryVectors(vectors, search_param);
+    auto call_deadline = std::min(deadline, std::chrono::system_clock::now() + SEARCH_TIMEOUT);
+
+    ::grpc::CompletionQueue cq;
+    std::vector<std::unique_ptr<SearchInFilesCall>> calls;
+    for (auto& node_files : routing) {
+        for (auto& table_files : node_files.second) {
+            ::milvus::grpc::SearchInFilesParam param;
+            *param.mutable_search_param() = search_param;
+            param.mutable_search_param()->set_table_name(table_files.first);
+            for (auto& file_id : table_files.second) {
+                param.add_file_id_array(file_id);
+            }
+
+            auto call = std::make_unique<SearchInFilesCall>();
+            call->node_ = node_files.first;
+            call->context_.set_deadline(call_deadline);
+            call->reader_ = stubs_[node_files.first]->PrepareAsyncSearchInFiles(&call->context_, param, &cq);
+            call->reader_->StartCall();
+            call->reader_->Finish(&call->reply_, &call->grpc_status_, call.get());
+            calls.emplace_back(std::move(call));
+        }
+    }
+
+    // step 3: merge results in the order they arrive, the slowest node is the only one waited for
+    uint64_t nq = vectors.vector_count_;
+    for (size_t i = 0; i < calls.size(); i++) {
+        void* tag = nullptr;
+        bool ok = false;
+        if (!cq.Next(&tag, &ok)) {
+            break;
+        }
+
+        auto call = static_cast<SearchInFilesCall*>(tag);
+        if (!ok || !call->grpc_status_.ok()) {
+            // an overloaded node is reported as an overloaded proxy, so clients retry
+            auto code = SERVER_UNEXPECTED_ERROR;
+            if (call->grpc_status_.error_code() == ::grpc::StatusCode::RESOURCE_EXHAUSTED) {
+                code = SERVER_REQUEST_QUEUE_FULL;
+            } else if (call->grpc_status_.error_code() == ::grpc::StatusCode::DEADLINE_EXCEEDED) {
+                code = SERVER_DEADLINE_EXCEEDED;
+            }
+            status = Status(code, "Search on node " + call->node_ + " failed: " + call->grpc_status_.error_message());
+            continue;
+        }
+        auto& reply = call->reply_;
+        if (reply.status().error_code() != ::milvus::grpc::SUCCESS) {
+            status = Status(SERVER_UNEXPECTED_ERROR, "Search on node " + call->node_ +
+                                                         " failed: " + reply.status().reason());
+            continue;
+        }
+        if (reply.row_num() == 0 || reply.ids_size() == 0) {
+            continue;
+        }
+
+        size_t src_k = std::min<size_t>(reply.ids_size() / nq, topk);
+        // merge expects the source at a stride of topk
+        engine::ResultIds src_ids(nq * topk, -1);
+        engine::ResultDistances src_distances(nq * topk, 0.0);
+        for (uint64_t q = 0; q < nq; q++) {
+            std::copy_n(reply.ids().begin() + q * src_k, src_k, src_ids.begin() + q * topk);
+            std::copy_n(reply.distances().begin() + q * src_k, src_k, src_distances.begin() + q * topk);
+        }
+        scheduler::XSearchTask::MergeTopkToResultSet(src_ids, src_distances, src_k, nq, topk, ascending, result_ids,
+                                                     result_distances);
+    }
+    cq.Shutdown();
+    void* tag = nullptr;
+    bool ok = false;
+    while (cq.Next(&tag, &ok)) {
+    }
+
+    if (!status.ok()) {
+        result_ids.clear();
+        result_distances.clear();
+    }
+    return status;
+}
+
+}  // namespace server
+}  // namespace milvus
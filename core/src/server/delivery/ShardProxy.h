@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "db/Types.h"
+#include "grpc/gen-milvus/milvus.grpc.pb.h"
+#include "utils/HashRing.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace server {
+
+// with server_config.proxy_nodes set, searches of this node are split over readonly nodes like mishards does:
+// files of the table are found in meta, each file is searched by the node owning it on the hash ring of mishards,
+// all nodes are searched at once and their results are merged as they arrive
+class ShardProxy {
+ public:
+    static ShardProxy&
+    GetInstance() {
+        static ShardProxy proxy;
+        return proxy;
+    }
+
+    void
+    Start();
+
+    void
+    Stop();
+
+    bool
+    Enabled() const {
+        return enabled_;
+    }
+
+    // vectors in insert buffer of this node are not searched, date ranges are applied by the nodes searching files,
+    // nodes not answering by the deadline fail the search
+    Status
+    Search(const std::string& table_id, const std::vector<std::string>& partition_tags,
+           const std::vector<std::pair<std::string, std::string>>& range_list, int64_t topk, int64_t nprobe,
+           const engine::VectorsData& vectors, const std::chrono::system_clock::time_point& deadline,
+           engine::ResultIds& result_ids, engine::ResultDistances& result_distances);
+
+ private:
+    ShardProxy() = default;
+
+ private:
+    std::atomic<bool> enabled_{false};
+    std::map<std::string, std::unique_ptr<::milvus::grpc::MilvusService::Stub>> stubs_;  // host:port as key
+    std::shared_ptr<HashRing> ring_;
+};
+
+}  // namespace server
+}  // namespace milvus
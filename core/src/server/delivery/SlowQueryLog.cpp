@@ -0,0 +1,70 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/SlowQueryLog.h"
+
+#include <utility>
+
+#include "server/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+
+namespace {
+// records waiting to be written, more are dropped
+constexpr size_t SLOW_QUERY_QUEUE_CAPACITY = 1024;
+}  // namespace
+
+void
+SlowQueryLog::Start() {
+    int64_t threshold_ms = 0;
+    Config::GetInstance().GetServerConfigSlowQueryThreshold(threshold_ms);
+    if (threshold_ms <= 0 || thread_.joinable()) {
+        return;
+    }
+
+    queue_.SetCapacity(SLOW_QUERY_QUEUE_CAPACITY);
+    thread_ = std::thread(&SlowQueryLog::Run, this);
+    threshold_us_ = threshold_ms * 1000;
+}
+
+void
+SlowQueryLog::Stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    threshold_us_ = 0;
+    queue_.Put(nullptr);
+    thread_.join();
+}
+
+void
+SlowQueryLog::Record(json&& record) {
+    if (!queue_.TryPut(std::make_shared<json>(std::move(record)))) {
+        SERVER_LOG_DEBUG << "Slow query log is full, a record is dropped";
+    }
+}
+
+void
+SlowQueryLog::Run() {
+    while (true) {
+        auto record = queue_.Take();
+        if (record == nullptr) {
+            break;
+        }
+        SERVER_LOG_WARNING << "Slow query: " << record->dump();
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
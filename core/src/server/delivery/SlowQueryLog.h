@@ -0,0 +1,64 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "utils/BlockingQueue.h"
+#include "utils/Json.h"
+
+namespace milvus {
+namespace server {
+
+// search requests slower than server_config.slow_query_threshold, written to the warning log by a background
+// thread, the request only pays for queueing its record
+class SlowQueryLog {
+ public:
+    static SlowQueryLog&
+    GetInstance() {
+        static SlowQueryLog log;
+        return log;
+    }
+
+    void
+    Start();
+
+    void
+    Stop();
+
+    bool
+    IsSlow(int64_t latency_us) const {
+        int64_t threshold_us = threshold_us_.load();
+        return threshold_us > 0 && latency_us >= threshold_us;
+    }
+
+    // the record is dropped if the writer falls behind
+    void
+    Record(json&& record);
+
+ private:
+    SlowQueryLog() = default;
+
+    void
+    Run();
+
+ private:
+    std::atomic<int64_t> threshold_us_{0};
+    BlockingQueue<std::shared_ptr<json>> queue_;
+    std::thread thread_;
+};
+
+}  // namespace server
+}  // namespace milvus
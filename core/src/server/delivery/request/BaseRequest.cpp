@@ -10,14 +10,41 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/BaseRequest.h"
+#include "server/delivery/RequestLatency.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
 
+#include <cxxabi.h>
+#include <algorithm>
+#include <cstdlib>
+#include <typeinfo>
+
 namespace milvus {
 namespace server {
 
 constexpr int64_t DAY_SECONDS = 24 * 60 * 60;
 
+namespace {
+// date of a time in the way db dates files
+DB_DATE
+ToDBDate(time_t time_integer) {
+    tm tm_day;
+    CommonUtil::ConvertTime(time_integer, tm_day);
+    return tm_day.tm_year * 10000 + tm_day.tm_mon * 100 + tm_day.tm_mday;
+}
+
+// class name of the request without namespace, e.g. "SearchRequest"
+std::string
+RequestType(const std::type_info& type) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    std::string name = (status == 0 && demangled != nullptr) ? demangled : type.name();
+    free(demangled);
+    auto pos = name.rfind("::");
+    return pos == std::string::npos ? name : name.substr(pos + 2);
+}
+}  // namespace
+
 Status
 ConvertTimeRangeToDBDates(const std::vector<std::pair<std::string, std::string>>& range_array,
                           std::vector<DB_DATE>& dates) {
@@ -41,20 +68,61 @@ ConvertTimeRangeToDBDates(const std::vector<std::pair<std::string, std::string>>
 
         // range: [start_day, end_day)
         for (int64_t i = 0; i < days; i++) {
-            time_t tt_day = tt_start + DAY_SECONDS * i;
-            tm tm_day;
-            CommonUtil::ConvertTime(tt_day, tm_day);
+            dates.push_back(ToDBDate(tt_start + DAY_SECONDS * i));
+        }
+    }
 
-            int64_t date = tm_day.tm_year * 10000 + tm_day.tm_mon * 100 + tm_day.tm_mday;  // according to db logic
-            dates.push_back(date);
+    return Status::OK();
+}
+
+Status
+ConvertTimeRangeToSearchRange(const std::vector<std::pair<std::string, std::string>>& range_array,
+                              std::vector<DB_DATE>& dates, engine::TimeRanges& time_ranges) {
+    dates.clear();
+    time_ranges.clear();
+    for (auto& range : range_array) {
+        time_t tt_start, tt_end;
+        tm tm_start, tm_end;
+        if (!CommonUtil::TimeStrToTime(range.first, tt_start, tm_start)) {
+            return Status(SERVER_INVALID_TIME_RANGE, "Invalid time range: " + range.first);
         }
+
+        if (!CommonUtil::TimeStrToTime(range.second, tt_end, tm_end)) {
+            return Status(SERVER_INVALID_TIME_RANGE, "Invalid time range: " + range.second);
+        }
+
+        if (tt_end <= tt_start) {
+            return Status(SERVER_INVALID_TIME_RANGE,
+                          "Invalid time range: The start-time should be smaller than end-time!");
+        }
+
+        // range: [start, end), files are dated by the day they are created
+        DB_DATE last_date = ToDBDate(tt_end - 1);
+        for (time_t tt_day = tt_start;; tt_day += DAY_SECONDS) {
+            DB_DATE date = ToDBDate(tt_day);
+            if (date > last_date) {
+                break;
+            }
+            if (std::find(dates.begin(), dates.end(), date) == dates.end()) {
+                dates.push_back(date);
+            }
+        }
+
+        engine::TimeRange time_range;
+        time_range.start_us_ = static_cast<int64_t>(tt_start) * 1000000;
+        time_range.end_us_ = static_cast<int64_t>(tt_end) * 1000000;
+        time_ranges.push_back(time_range);
     }
 
     return Status::OK();
 }
 
 BaseRequest::BaseRequest(const std::shared_ptr<Context>& context, const std::string& request_group, bool async)
-    : context_(context), request_group_(request_group), async_(async), done_(false) {
+    : context_(context),
+      create_time_(std::chrono::steady_clock::now()),
+      request_group_(request_group),
+      async_(async),
+      done_(false) {
 }
 
 BaseRequest::~BaseRequest() {
@@ -70,8 +138,28 @@ BaseRequest::Execute() {
 
 void
 BaseRequest::Done() {
+    auto latency = std::chrono::steady_clock::now() - create_time_;
+    auto latency_us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    RequestLatency::GetInstance().Record(RequestType(typeid(*this)), latency_us);
+    OnDone(latency_us);
+
     done_ = true;
     finish_cond_.notify_all();
+    if (callback_) {
+        callback_(status_);
+    }
+}
+
+void
+BaseRequest::Done(const Status& status) {
+    status_ = status;
+    Done();
+}
+
+void
+BaseRequest::SetCallback(const RequestCallback& callback) {
+    callback_ = callback;
+    async_ = true;
 }
 
 Status
@@ -19,7 +19,9 @@
 #include "server/context/Context.h"
 #include "utils/Status.h"
 
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 //#include <gperftools/profiler.h>
 #include <memory>
 #include <string>
@@ -32,14 +34,24 @@ namespace server {
 
 static const char* DQL_REQUEST_GROUP = "dql";
 static const char* DDL_DML_REQUEST_GROUP = "ddl_dml";
+static const char* DML_REQUEST_GROUP = "dml";
 static const char* INFO_REQUEST_GROUP = "info";
 
 using DB_DATE = milvus::engine::meta::DateT;
 
+// called with the request status once the request is done, on the thread finishing it
+using RequestCallback = std::function<void(const Status&)>;
+
 Status
 ConvertTimeRangeToDBDates(const std::vector<std::pair<std::string, std::string>>& range_array,
                           std::vector<DB_DATE>& dates);
 
+// dates of the days a search range touches, with the ranges in microseconds so that files inserted out of them are
+// skipped; unlike ConvertTimeRangeToDBDates, a range may be shorter than a day, e.g. the last hour
+Status
+ConvertTimeRangeToSearchRange(const std::vector<std::pair<std::string, std::string>>& range_array,
+                              std::vector<DB_DATE>& dates, engine::TimeRanges& time_ranges);
+
 struct TableSchema {
     std::string table_name_;
     int64_t dimension_;
@@ -64,6 +76,7 @@ struct TopKQueryResult {
     int64_t row_num_;
     engine::ResultIds id_list_;
     engine::ResultDistances distance_list_;
+    int32_t engine_type_ = 0;  // index type of the searched table, a label of search metrics
 
     TopKQueryResult() {
         row_num_ = 0;
@@ -80,16 +93,22 @@ struct IndexParam {
     std::string table_name_;
     int64_t index_type_;
     int64_t nlist_;
+    int64_t indexed_row_count_;
+    int64_t total_row_count_;
 
     IndexParam() {
         index_type_ = 0;
         nlist_ = 0;
+        indexed_row_count_ = 0;
+        total_row_count_ = 0;
     }
 
     IndexParam(const std::string& table_name, int64_t index_type, int64_t nlist) {
         table_name_ = table_name;
         index_type_ = index_type;
         nlist_ = nlist;
+        indexed_row_count_ = 0;
+        total_row_count_ = 0;
     }
 };
 
@@ -107,6 +126,16 @@ struct PartitionParam {
     }
 };
 
+// one search of a batch, the searches of a batch are on the same table
+struct SearchQueryParam {
+    engine::VectorsData vectors_;
+    std::vector<std::pair<std::string, std::string>> range_list_;
+    int64_t topk_ = 0;
+    int64_t nprobe_ = 0;
+    std::vector<std::string> partition_list_;
+    std::vector<std::string> file_id_list_;
+};
+
 class BaseRequest {
  protected:
     BaseRequest(const std::shared_ptr<Context>& context, const std::string& request_group, bool async = false);
@@ -120,9 +149,17 @@ class BaseRequest {
     void
     Done();
 
+    // done without being executed, e.g. it can't be queued
+    void
+    Done(const Status& status);
+
     Status
     WaitToFinish();
 
+    // nobody waits for a request with callback, the callback is called by Done instead
+    void
+    SetCallback(const RequestCallback& callback);
+
     std::string
     RequestGroup() const {
         return request_group_;
@@ -142,6 +179,11 @@ class BaseRequest {
     virtual Status
     OnExecute() = 0;
 
+    // called once the request is done, before the waiting caller or the callback sees it
+    virtual void
+    OnDone(int64_t latency_us) {
+    }
+
     Status
     SetStatus(ErrorCode error_code, const std::string& error_msg);
 
@@ -154,10 +196,12 @@ class BaseRequest {
     mutable std::mutex finish_mtx_;
     std::condition_variable finish_cond_;
 
+    std::chrono::steady_clock::time_point create_time_;
     std::string request_group_;
     bool async_;
     bool done_;
     Status status_;
+    RequestCallback callback_;
 };
 
 using BaseRequestPtr = std::shared_ptr<BaseRequest>;
@@ -10,16 +10,117 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/CmdRequest.h"
+#include "cache/CpuCacheMgr.h"
+#include "db/meta/MetaChangeFeed.h"
 #include "metrics/SystemInfo.h"
+#include "scheduler/OmpBudget.h"
 #include "scheduler/SchedInst.h"
+#include "scheduler/job/Job.h"
+#include "server/Config.h"
+#include "server/DBWrapper.h"
+#include "server/delivery/RequestLatency.h"
+#include "server/delivery/RequestScheduler.h"
+#include "server/delivery/request/CreateIndexRequest.h"
 #include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
 #include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
 
+#include <boost/filesystem.hpp>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace milvus {
 namespace server {
 
+namespace {
+// live state of queues, scheduler, cache and latencies, cheap enough to be asked for at any time
+json
+PerfSnapshot() {
+    json resources = json::object();
+    for (auto& resource : scheduler::ResMgrInst::GetInstance()->GetAllResources()) {
+        auto& task_table = resource->task_table();
+        resources[resource->name()] = {
+            {"start", task_table.NumOfState(scheduler::TaskTableItemState::START)},
+            {"loading", task_table.NumOfState(scheduler::TaskTableItemState::LOADING)},
+            {"loaded", task_table.NumOfState(scheduler::TaskTableItemState::LOADED)},
+            {"executing", task_table.NumOfState(scheduler::TaskTableItemState::EXECUTING)},
+        };
+    }
+
+    auto cpu_cache = cache::CpuCacheMgr::GetInstance();
+    uint64_t hits = cpu_cache->HitCount(), misses = cpu_cache->MissCount();
+    json cache{
+        {"usage", cpu_cache->CacheUsage()},
+        {"capacity", cpu_cache->CacheCapacity()},
+        {"items", cpu_cache->ItemCount()},
+        {"hits", hits},
+        {"misses", misses},
+        {"hit_rate", (hits + misses) > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0},
+    };
+
+    json jobs{
+        {"search", scheduler::Job::NumOfAlive(scheduler::JobType::SEARCH)},
+        {"delete", scheduler::Job::NumOfAlive(scheduler::JobType::DELETE)},
+        {"build", scheduler::Job::NumOfAlive(scheduler::JobType::BUILD)},
+    };
+
+    auto& omp_budget = scheduler::OmpBudget::GetInstance();
+    json omp{
+        {"threads", omp_budget.Threads()},
+        {"tasks", omp_budget.NumOfTasks()},
+    };
+
+    json ret{
+        {"request_queues", RequestScheduler::GetInstance().Dump()},
+        {"task_tables", resources},
+        {"cpu_cache", cache},
+        {"jobs", jobs},
+        {"omp", omp},
+        {"request_latency", RequestLatency::GetInstance().Dump()},
+    };
+    return ret;
+}
+
+// export_table and import_table read and write files of the server, they are confined to
+// storage_config.export_path, a link under it may not lead out of it either
+Status
+CheckExportPath(const std::string& path) {
+    std::string root;
+    auto status = Config::GetInstance().GetStorageConfigExportPath(root);
+    if (!status.ok()) {
+        return status;
+    }
+    if (root.empty()) {
+        return Status(SERVER_UNSUPPORTED_ERROR, "Export and import are disabled, set storage_config.export_path");
+    }
+    while (root.size() > 1 && root.back() == '/') {
+        root.pop_back();
+    }
+
+    std::string msg = "Invalid path: " + path + ", it must be a directory under " + root;
+    if (!ValidationUtil::ValidateStoragePath(path).ok() || path.compare(0, root.size() + 1, root + "/") != 0) {
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    try {
+        boost::filesystem::path existing(path);
+        while (!boost::filesystem::exists(existing) && existing.has_parent_path()) {
+            existing = existing.parent_path();
+        }
+        auto real_path = boost::filesystem::canonical(existing).string() + "/";
+        auto real_root = boost::filesystem::canonical(root).string() + "/";
+        if (real_path.compare(0, real_root.size(), real_root) != 0) {
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    } catch (std::exception& ex) {
+        return Status(SERVER_INVALID_ARGUMENT, msg + ": " + ex.what());
+    }
+    return Status::OK();
+}
+}  // namespace
+
 CmdRequest::CmdRequest(const std::shared_ptr<Context>& context, const std::string& cmd, std::string& result)
     : BaseRequest(context, INFO_REQUEST_GROUP), cmd_(cmd), result_(result) {
 }
@@ -38,9 +139,12 @@ CmdRequest::OnExecute() {
     if (cmd_ == "version") {
         result_ = MILVUS_VERSION;
     } else if (cmd_ == "status") {
-        result_ = "OK";
+        // requests are served while preload_table is loading, at the latency of a cold cache
+        result_ = DBWrapper::GetInstance().IsWarming() ? "warming" : "OK";
     } else if (cmd_ == "tasktable") {
         result_ = scheduler::ResMgrInst::GetInstance()->DumpTaskTables();
+    } else if (cmd_ == "perf") {
+        result_ = PerfSnapshot().dump();
     } else if (cmd_ == "mode") {
 #ifdef MILVUS_GPU_VERSION
         result_ = "GPU";
@@ -55,6 +159,182 @@ CmdRequest::OnExecute() {
     } else if (cmd_.substr(0, 10) == "set_config" || cmd_.substr(0, 10) == "get_config") {
         server::Config& config = server::Config::GetInstance();
         stat = config.ProcessConfigCli(result_, cmd_);
+    } else if (cmd_ == "flush" || cmd_.substr(0, 6) == "flush ") {
+        // "flush" serializes all tables, "flush table_1,table_2" serializes the given tables
+        std::vector<std::string> table_ids;
+        if (cmd_.size() > 6) {
+            StringHelpFunctions::SplitStringByDelimeter(cmd_.substr(6), ",", table_ids);
+        }
+        stat = DBWrapper::DB()->Flush(table_ids);
+        result_ = stat.ok() ? "OK" : stat.message();
+    } else if (cmd_ == "preload_progress") {
+        stat = DBWrapper::DB()->GetPreloadProgress(result_);
+    } else if (cmd_.substr(0, 16) == "set_cache_quota ") {
+        // "set_cache_quota table_1 reserved_mb max_mb [pin]", max_mb 0 means no limit
+        std::vector<std::string> params;
+        StringHelpFunctions::SplitStringByDelimeter(cmd_.substr(16), " ", params);
+        if (params.size() < 3 || params.size() > 4 || !ValidationUtil::ValidateStringIsNumber(params[1]).ok() ||
+            !ValidationUtil::ValidateStringIsNumber(params[2]).ok() || (params.size() == 4 && params[3] != "pin")) {
+            stat = Status(SERVER_INVALID_ARGUMENT, "Usage: set_cache_quota table_name reserved_mb max_mb [pin]");
+        } else {
+            const int64_t MB = 1024 * 1024;
+            stat = DBWrapper::DB()->SetTableCacheQuota(params[0], std::stoll(params[1]) * MB,
+                                                       std::stoll(params[2]) * MB, params.size() == 4);
+        }
+        result_ = stat.ok() ? "OK" : stat.message();
+    } else if (cmd_.substr(0, 13) == "create_index ") {
+        // "create_index table_1 index_type nlist" returns the table name as handle of the creation once the index
+        // is updated, progress of the handle is listed by "index_progress"
+        std::vector<std::string> params;
+        StringHelpFunctions::SplitStringByDelimeter(cmd_.substr(13), " ", params);
+        if (params.size() != 3 || !ValidationUtil::ValidateStringIsNumber(params[1]).ok() ||
+            !ValidationUtil::ValidateStringIsNumber(params[2]).ok()) {
+            stat = Status(SERVER_INVALID_ARGUMENT, "Usage: create_index table_name index_type nlist");
+        } else {
+            // runs in this request, a blocking creation may hold the ddl queue for hours
+            auto request =
+                CreateIndexRequest::Create(context_, params[0], std::stoll(params[1]), std::stoll(params[2]), true);
+            stat = request->Execute();
+        }
+        result_ = stat.ok() ? params[0] : stat.message();
+    } else if (cmd_.substr(0, 13) == "search_files ") {
+        // "search_files table_1 [tag_1,tag_2]" returns "table_id file_id" of each file a search of the table runs on,
+        // one line per file, clients route SearchInFiles of the files to readonly nodes by them
+        std::vector<std::string> params;
+        StringHelpFunctions::SplitStringByDelimeter(cmd_.substr(13), " ", params);
+        if (params.empty() || params.size() > 2) {
+            stat = Status(SERVER_INVALID_ARGUMENT, "Usage: search_files table_name [tag_1,tag_2]");
+            result_ = stat.message();
+        } else {
+            std::vector<std::string> partition_tags;
+            if (params.size() == 2) {
+                StringHelpFunctions::SplitStringByDelimeter(params[1], ",", partition_tags);
+            }
+            engine::meta::TableFilesSchema files;
+            stat = ValidationUtil::ValidateTableName(params[0]);
+            if (stat.ok()) {
+                stat = DBWrapper::DB()->GetSearchFiles(params[0], partition_tags, files);
+            }
+            std::string lines;
+            for (auto& file : files) {
+                lines += file.table_id_ + " " + std::to_string(file.id_) + "\n";
+            }
+            result_ = stat.ok() ? lines : stat.message();
+        }
+    } else if (cmd_.substr(0, 13) == "meta_changes ") {
+        // "meta_changes epoch version" returns changes of meta after the version, readonly nodes follow them
+        std::vector<std::string> params;
+        StringHelpFunctions::SplitStringByDelimeter(cmd_.substr(13), " ", params);
+        uint64_t epoch = 0, version = 0;
+        Status usage(SERVER_INVALID_ARGUMENT, "Usage: meta_changes epoch version");
+        if (params.size() != 2) {
+            stat = usage;
+        } else {
+            try {
+                epoch = std::stoull(params[0]);
+                version = std::stoull(params[1]);
+            } catch (std::exception& e) {
+                stat = usage;
+            }
+        }
+
+        if (stat.ok()) {
+            // followers start over from the latest version if changes are missing
+            auto& feed = engine::meta::MetaChangeFeed::GetInstance();
+            std::vector<engine::meta::MetaChange> changes;
+            bool complete = feed.ChangesSince(epoch, version, changes);
+            uint64_t latest = complete ? (changes.empty() ? version : changes.back().version_) : feed.Version();
+            result_ = engine::meta::MetaChangeFeed::Encode(feed.Epoch(), latest, complete, changes);
+        } else {
+            result_ = stat.message();
+        }
+    } else if (cmd_.substr(0, 13) == "advise_index ") {
+        // "advise_index table_1 [target_recall] [topk]" returns the index type, nlist and nprobe reaching the recall
+        // (0.9 by default) at topk (10 by default) fastest, and every configuration tried, as json
+        std::vector<std::string> params;
+        StringHelpFunctions::SplitStringByDelimeter(cmd_.substr(13), " ", params);
+        double target_recall = 0.9;
+        int64_t topk = 10;
+        Status usage(SERVER_INVALID_ARGUMENT, "Usage: advise_index table_name [target_recall] [topk]");
+        if (params.empty() || params.size() > 3) {
+            stat = usage;
+        } else {
+            try {
+                if (params.size() > 1) {
+                    target_recall = std::stod(params[1]);
+                }
+                if (params.size() > 2) {
+                    topk = std::stoll(params[2]);
+                }
+            } catch (std::exception& e) {
+                stat = usage;
+            }
+        }
+
+        engine::IndexAdvice advice;
+        if (stat.ok()) {
+            stat = DBWrapper::DB()->AdviseIndex(params[0], target_recall, topk, advice);
+        }
+        if (stat.ok()) {
+            auto to_json = [](const engine::IndexTrial& trial) {
+                return json{
+                    {"index_type", static_cast<int>(trial.engine_type_)},
+                    {"nlist", trial.nlist_},
+                    {"nprobe", trial.nprobe_},
+                    {"recall", trial.recall_},
+                    {"query_us", trial.query_us_},
+                    {"memory", trial.memory_},
+                    {"reached", trial.reached_},
+                };
+            };
+            json trials = json::array();
+            for (auto& trial : advice.trials_) {
+                trials.push_back(to_json(trial));
+            }
+            json ret{
+                {"target_recall", advice.target_recall_},
+                {"segment_rows", advice.segment_rows_},
+                {"sample_rows", advice.sample_rows_},
+                {"advice", to_json(advice.best_)},
+                {"trials", trials},
+            };
+            result_ = ret.dump();
+        } else {
+            result_ = stat.message();
+        }
+    } else if (cmd_ == "index_progress") {
+        stat = DBWrapper::DB()->GetIndexProgress(result_);
+    } else if (cmd_.substr(0, 13) == "export_table ") {
+        // "export_table table_1 path" links the files of the table and its partitions to path of this node, with a
+        // dump of their meta, files kept on s3 are downloaded, path is under storage_config.export_path
+        std::vector<std::string> params;
+        StringHelpFunctions::SplitStringByDelimeter(cmd_.substr(13), " ", params);
+        if (params.size() != 2) {
+            stat = Status(SERVER_INVALID_ARGUMENT, "Usage: export_table table_name path");
+        } else {
+            stat = CheckExportPath(params[1]);
+            if (stat.ok()) {
+                stat = DBWrapper::DB()->ExportTable(params[0], params[1]);
+            }
+        }
+        result_ = stat.ok() ? "OK" : stat.message();
+    } else if (cmd_.substr(0, 13) == "import_table ") {
+        // "import_table path [table_name]" creates a table of the export at path, named as exported by default,
+        // its files are searched as they are without a rebuild
+        std::vector<std::string> params;
+        StringHelpFunctions::SplitStringByDelimeter(cmd_.substr(13), " ", params);
+        if (params.empty() || params.size() > 2) {
+            stat = Status(SERVER_INVALID_ARGUMENT, "Usage: import_table path [table_name]");
+        } else {
+            stat = CheckExportPath(params[0]);
+            if (stat.ok() && params.size() == 2) {
+                stat = ValidationUtil::ValidateTableName(params[1]);
+            }
+            if (stat.ok()) {
+                stat = DBWrapper::DB()->ImportTable(params[0], params.size() == 2 ? params[1] : "");
+            }
+        }
+        result_ = stat.ok() ? "OK" : stat.message();
     } else {
         result_ = "Unknown command";
     }
@@ -24,14 +24,18 @@ namespace milvus {
 namespace server {
 
 CreateIndexRequest::CreateIndexRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
-                                       int64_t index_type, int64_t nlist)
-    : BaseRequest(context, DDL_DML_REQUEST_GROUP), table_name_(table_name), index_type_(index_type), nlist_(nlist) {
+                                       int64_t index_type, int64_t nlist, bool background)
+    : BaseRequest(context, DDL_DML_REQUEST_GROUP),
+      table_name_(table_name),
+      index_type_(index_type),
+      nlist_(nlist),
+      background_(background) {
 }
 
 BaseRequestPtr
 CreateIndexRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t index_type,
-                           int64_t nlist) {
-    return std::shared_ptr<BaseRequest>(new CreateIndexRequest(context, table_name, index_type, nlist));
+                           int64_t nlist, bool background) {
+    return std::shared_ptr<BaseRequest>(new CreateIndexRequest(context, table_name, index_type, nlist, background));
 }
 
 Status
@@ -84,6 +88,12 @@ CreateIndexRequest::OnExecute() {
             }
         }
 
+        // the graph of DISKANN is built and searched by l2 distance
+        if (adapter_index_type == static_cast<int32_t>(engine::EngineType::DISKANN) &&
+            table_info.metric_type_ != static_cast<int32_t>(engine::MetricType::L2)) {
+            return Status(SERVER_INVALID_INDEX_METRIC_TYPE, "DISKANN index supports L2 metric only");
+        }
+
 #ifdef MILVUS_GPU_VERSION
         Status s;
         bool enable_gpu = false;
@@ -102,7 +112,8 @@ CreateIndexRequest::OnExecute() {
         engine::TableIndex index;
         index.engine_type_ = adapter_index_type;
         index.nlist_ = nlist_;
-        status = DBWrapper::DB()->CreateIndex(table_name_, index);
+        status = background_ ? DBWrapper::DB()->CreateIndexAsync(table_name_, index)
+                             : DBWrapper::DB()->CreateIndex(table_name_, index);
         fiu_do_on("CreateIndexRequest.OnExecute.create_index_fail",
                   status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
         if (!status.ok()) {
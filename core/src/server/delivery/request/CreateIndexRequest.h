@@ -20,12 +20,14 @@ namespace server {
 
 class CreateIndexRequest : public BaseRequest {
  public:
+    // a background request returns once the index is updated, its files are built later
     static BaseRequestPtr
-    Create(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t index_type, int64_t nlist);
+    Create(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t index_type, int64_t nlist,
+           bool background = false);
 
  protected:
     CreateIndexRequest(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t index_type,
-                       int64_t nlist);
+                       int64_t nlist, bool background);
 
     Status
     OnExecute() override;
@@ -34,6 +36,7 @@ class CreateIndexRequest : public BaseRequest {
     const std::string table_name_;
     const int64_t index_type_;
     const int64_t nlist_;
+    const bool background_;
 };
 
 }  // namespace server
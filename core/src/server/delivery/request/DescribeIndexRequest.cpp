@@ -60,9 +60,18 @@ DescribeIndexRequest::OnExecute() {
             index.engine_type_ = (int32_t)engine::EngineType::FAISS_IVFFLAT;
         }
 
+        // step 3: get index progress
+        uint64_t indexed_rows = 0, total_rows = 0;
+        status = DBWrapper::DB()->GetIndexRowCount(table_name_, indexed_rows, total_rows);
+        if (!status.ok()) {
+            return status;
+        }
+
         index_param_.table_name_ = table_name_;
         index_param_.index_type_ = index.engine_type_;
         index_param_.nlist_ = index.nlist_;
+        index_param_.indexed_row_count_ = static_cast<int64_t>(indexed_rows);
+        index_param_.total_row_count_ = static_cast<int64_t>(total_rows);
     } catch (std::exception& ex) {
         return Status(SERVER_UNEXPECTED_ERROR, ex.what());
     }
@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/GetVectorByIDRequest.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <fiu-local.h>
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+GetVectorByIDRequest::GetVectorByIDRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                           int64_t vector_id, engine::VectorsData& vector)
+    : BaseRequest(context, DQL_REQUEST_GROUP), table_name_(table_name), vector_id_(vector_id), vector_(vector) {
+}
+
+BaseRequestPtr
+GetVectorByIDRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+                             int64_t vector_id, engine::VectorsData& vector) {
+    return std::shared_ptr<BaseRequest>(new GetVectorByIDRequest(context, table_name, vector_id, vector));
+}
+
+Status
+GetVectorByIDRequest::OnExecute() {
+    try {
+        std::string hdr = "GetVectorByIDRequest(table=" + table_name_ + ", id=" + std::to_string(vector_id_) + ")";
+        TimeRecorderAuto rc(hdr);
+
+        // step 1: check arguments
+        auto status = ValidationUtil::ValidateTableName(table_name_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // step 2: get vector, the vector is left empty if not found
+        status = DBWrapper::DB()->GetVectorByID(table_name_, vector_id_, vector_);
+        fiu_do_on("GetVectorByIDRequest.OnExecute.throw_std_exception", throw std::exception());
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+            } else {
+                return status;
+            }
+        }
+    } catch (std::exception& ex) {
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/InsertRequest.h"
+#include "db/Constants.h"
 #include "server/DBWrapper.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
@@ -17,6 +18,7 @@
 #include "utils/ValidationUtil.h"
 
 #include <fiu-local.h>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,11 +30,12 @@ namespace milvus {
 namespace server {
 
 InsertRequest::InsertRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
-                             engine::VectorsData& vectors, const std::string& partition_tag)
-    : BaseRequest(context, DDL_DML_REQUEST_GROUP),
+                             engine::VectorsData& vectors, const std::string& partition_tag, bool bulk)
+    : BaseRequest(context, DML_REQUEST_GROUP),
       table_name_(table_name),
       vectors_data_(vectors),
-      partition_tag_(partition_tag) {
+      partition_tag_(partition_tag),
+      bulk_(bulk) {
 }
 
 BaseRequestPtr
@@ -41,13 +44,19 @@ InsertRequest::Create(const std::shared_ptr<Context>& context, const std::string
     return std::shared_ptr<BaseRequest>(new InsertRequest(context, table_name, vectors, partition_tag));
 }
 
+BaseRequestPtr
+InsertRequest::CreateBulk(const std::shared_ptr<Context>& context, const std::string& table_name,
+                          engine::VectorsData& vectors, const std::string& partition_tag) {
+    return std::shared_ptr<BaseRequest>(new InsertRequest(context, table_name, vectors, partition_tag, true));
+}
+
 Status
 InsertRequest::OnExecute() {
     try {
         int64_t vector_count = vectors_data_.vector_count_;
         fiu_do_on("InsertRequest.OnExecute.throw_std_exception", throw std::exception());
         std::string hdr = "InsertRequest(table=" + table_name_ + ", n=" + std::to_string(vector_count) +
-                          ", partition_tag=" + partition_tag_ + ")";
+                          ", partition_tag=" + partition_tag_ + ", bulk=" + std::to_string(bulk_) + ")";
         TimeRecorder rc(hdr);
 
         // step 1: check arguments
@@ -68,6 +77,13 @@ InsertRequest::OnExecute() {
             }
         }
 
+        for (auto& pair : vectors_data_.attrs_) {
+            if (pair.first.empty() || pair.second.Size() != vector_count) {
+                return Status(SERVER_INVALID_ARGUMENT,
+                              "An attribute must have a name and as many values as the vectors.");
+            }
+        }
+
         // step 2: check table existence
         engine::meta::TableSchema table_info;
         table_info.table_id_ = table_name_;
@@ -108,7 +124,19 @@ InsertRequest::OnExecute() {
         std::string fname = "/tmp/insert_" + CommonUtil::GetCurrentTimeStr() + ".profiling";
         ProfilerStart(fname.c_str());
 #endif
-        // step 4: some metric type doesn't support float vectors
+        // step 4: float vectors may come packed in binary data as little endian floats, which is parsed by grpc
+        // as one buffer instead of float by float, they are moved to float data in one copy
+        if (!ValidationUtil::IsBinaryMetricType(table_info.metric_type_) && vectors_data_.float_data_.empty()) {
+            auto& binary_data = vectors_data_.binary_data_;
+            if (binary_data.size() % sizeof(float) != 0) {
+                return Status(SERVER_INVALID_ROWRECORD_ARRAY, "The size of packed float vectors must be whole floats.");
+            }
+            vectors_data_.float_data_.resize(binary_data.size() / sizeof(float));
+            memcpy(vectors_data_.float_data_.data(), binary_data.data(), binary_data.size());
+            std::vector<uint8_t>().swap(binary_data);
+        }
+
+        // some metric type doesn't support float vectors
         if (!vectors_data_.float_data_.empty()) {  // insert float vectors
             if (ValidationUtil::IsBinaryMetricType(table_info.metric_type_)) {
                 return Status(SERVER_INVALID_ROWRECORD_ARRAY, "Table metric type doesn't support float vectors.");
@@ -146,7 +174,15 @@ InsertRequest::OnExecute() {
         auto vec_count = static_cast<uint64_t>(vector_count);
 
         rc.RecordSection("prepare vectors data");
-        status = DBWrapper::DB()->InsertVectors(table_name_, partition_tag_, vectors_data_);
+        // a bulk request or a request holding a whole table file is written to disk directly, no need to go through
+        // insert buffer, index_file_size_ is described in MB
+        uint64_t data_size = vectors_data_.float_data_.size() * sizeof(float) + vectors_data_.binary_data_.size();
+        if (bulk_ || data_size >= static_cast<uint64_t>(table_info.index_file_size_) * engine::ONE_MB) {
+            status = DBWrapper::DB()->BulkLoad(table_name_, partition_tag_, vectors_data_);
+            fiu_do_on("InsertRequest.OnExecute.bulk_load", status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
+        } else {
+            status = DBWrapper::DB()->InsertVectors(table_name_, partition_tag_, vectors_data_);
+        }
         fiu_do_on("InsertRequest.OnExecute.insert_fail", status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
         if (!status.ok()) {
             return status;
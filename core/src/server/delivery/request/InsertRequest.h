@@ -26,9 +26,14 @@ class InsertRequest : public BaseRequest {
     Create(const std::shared_ptr<Context>& context, const std::string& table_name, engine::VectorsData& vectors,
            const std::string& partition_tag);
 
+    // same as Create but the vectors are always written to table files directly, bypassing insert buffer
+    static BaseRequestPtr
+    CreateBulk(const std::shared_ptr<Context>& context, const std::string& table_name, engine::VectorsData& vectors,
+               const std::string& partition_tag);
+
  protected:
     InsertRequest(const std::shared_ptr<Context>& context, const std::string& table_name, engine::VectorsData& vectors,
-                  const std::string& partition_tag);
+                  const std::string& partition_tag, bool bulk = false);
 
     Status
     OnExecute() override;
@@ -37,6 +42,7 @@ class InsertRequest : public BaseRequest {
     const std::string table_name_;
     engine::VectorsData& vectors_data_;
     const std::string partition_tag_;
+    bool bulk_ = false;
 };
 
 }  // namespace server
@@ -0,0 +1,198 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/SearchBatchRequest.h"
+#include "server/DBWrapper.h"
+#include "server/delivery/ShardProxy.h"
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "server/delivery/request/SearchRequest.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <memory>
+#include <utility>
+
+namespace milvus {
+namespace server {
+
+SearchBatchRequest::SearchBatchRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                       const std::vector<SearchQueryParam>& query_params,
+                                       std::vector<TopKQueryResult>& results)
+    : BaseRequest(context, DQL_REQUEST_GROUP), table_name_(table_name), query_params_(query_params), results_(results) {
+}
+
+BaseRequestPtr
+SearchBatchRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+                           const std::vector<SearchQueryParam>& query_params, std::vector<TopKQueryResult>& results) {
+    return std::shared_ptr<BaseRequest>(new SearchBatchRequest(context, table_name, query_params, results));
+}
+
+Status
+SearchBatchRequest::OnExecute() {
+    // searches are run by this request, they are only marked done so that they can be released
+    Status status;
+    std::vector<BaseRequestPtr> sub_requests;
+    try {
+        status = SearchBatch(sub_requests);
+    } catch (std::exception& ex) {
+        status = Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    for (auto& request : sub_requests) {
+        request->Done();
+    }
+
+    return status;
+}
+
+Status
+SearchBatchRequest::SearchBatch(std::vector<BaseRequestPtr>& sub_requests) {
+    std::string hdr = "SearchBatchRequest(table=" + table_name_ + ", searches=" + std::to_string(query_params_.size()) +
+                      ")";
+    TimeRecorder rc(hdr);
+
+    // the client may give up while the request is waiting in queue
+    if (context_ != nullptr && context_->IsCancelled()) {
+        return Status(SERVER_REQUEST_CANCELLED, "Search cancelled by client");
+    }
+    if (context_ != nullptr && context_->IsExpired()) {
+        return Status(SERVER_DEADLINE_EXCEEDED, "Search deadline exceeded");
+    }
+
+    if (query_params_.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, "The search list is empty");
+    }
+
+    // step 1: check table, it is described once for all searches
+    auto status = ValidationUtil::ValidateTableName(table_name_);
+    if (!status.ok()) {
+        return status;
+    }
+
+    engine::meta::TableSchema table_info;
+    table_info.table_id_ = table_name_;
+    status = DBWrapper::DB()->DescribeTable(table_info);
+    if (!status.ok()) {
+        if (status.code() == DB_NOT_FOUND) {
+            return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+        } else {
+            return status;
+        }
+    }
+
+    // step 2: check each search, results are written by the searches in place
+    results_.clear();
+    results_.resize(query_params_.size());
+    std::vector<SearchRequestPtr> requests;
+    for (size_t i = 0; i < query_params_.size(); i++) {
+        const SearchQueryParam& param = query_params_[i];
+        auto request = std::static_pointer_cast<SearchRequest>(
+            SearchRequest::Create(context_, table_name_, param.vectors_, param.range_list_, param.topk_, param.nprobe_,
+                                  param.partition_list_, param.file_id_list_, results_[i]));
+        sub_requests.emplace_back(request);
+
+        std::vector<DB_DATE> dates;
+        status = request->CheckSearchParam(table_info, dates);
+        if (status.ok() && param.file_id_list_.empty()) {
+            status = ValidationUtil::ValidatePartitionTags(param.partition_list_);
+        }
+        if (!status.ok()) {
+            return Status(status.code(), "Search " + std::to_string(i) + ": " + status.message());
+        }
+        requests.emplace_back(request);
+    }
+    rc.RecordSection("check validation");
+
+    // step 3: group searches on the same files, large searches are kept alone
+    std::vector<std::shared_ptr<SearchCombineRequest>> groups;
+    std::vector<std::shared_ptr<SearchCombineRequest>> open_groups;
+    std::vector<SearchRequestPtr> file_requests;
+    std::vector<SearchRequestPtr> proxy_requests;
+    bool sharded = ShardProxy::GetInstance().Enabled();
+    for (auto& request : requests) {
+        if (!request->file_id_list_.empty()) {
+            file_requests.emplace_back(request);
+            continue;
+        }
+        // groups query the local db, sharded searches go through the proxy one by one
+        if (sharded) {
+            proxy_requests.emplace_back(request);
+            continue;
+        }
+
+        bool combined = false;
+        for (auto& group : open_groups) {
+            if (group->Combine(request)) {
+                combined = true;
+                break;
+            }
+        }
+        if (combined) {
+            continue;
+        }
+
+        auto group = SearchCombineRequest::Create(request);
+        groups.emplace_back(group);
+        sub_requests.emplace_back(group);
+        if (SearchCombineRequest::CanCombine(request)) {
+            open_groups.emplace_back(group);
+        }
+    }
+
+    // step 4: search each group with one query
+    for (auto& group : groups) {
+        status = group->SearchCombined(group->requests_);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    for (auto& request : proxy_requests) {
+        status = request->OnExecute();
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    for (auto& request : file_requests) {
+        std::vector<DB_DATE> dates;
+        status = ConvertTimeRangeToSearchRange(request->range_list_, dates, request->time_ranges_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        engine::VectorsData ranged_vectors;
+        const engine::VectorsData& query_vectors = request->QueryVectors(ranged_vectors);
+
+        engine::ResultIds result_ids;
+        engine::ResultDistances result_distances;
+        status = DBWrapper::DB()->QueryByFileID(context_, table_name_, request->file_id_list_,
+                                                (size_t)request->topk_, request->nprobe_, query_vectors, dates,
+                                                result_ids, result_distances);
+        if (!status.ok()) {
+            return status;
+        }
+        if (!result_ids.empty()) {
+            request->result_.row_num_ = request->vectors_data_.vector_count_;
+            request->result_.id_list_ = std::move(result_ids);
+            request->result_.distance_list_ = std::move(result_distances);
+        }
+    }
+
+    SERVER_LOG_DEBUG << hdr << " searched with " << groups.size() + proxy_requests.size() + file_requests.size()
+                     << " queries";
+    rc.ElapseFromBegin("totally cost");
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
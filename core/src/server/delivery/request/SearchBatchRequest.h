@@ -0,0 +1,50 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+// Several searches on one table, e.g. on different partitions. The table is described once, and searches
+// sharing the same files are queried together so that each file is loaded and searched once.
+class SearchBatchRequest : public BaseRequest {
+ public:
+    static BaseRequestPtr
+    Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+           const std::vector<SearchQueryParam>& query_params, std::vector<TopKQueryResult>& results);
+
+ protected:
+    SearchBatchRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                       const std::vector<SearchQueryParam>& query_params, std::vector<TopKQueryResult>& results);
+
+    Status
+    OnExecute() override;
+
+ private:
+    Status
+    SearchBatch(std::vector<BaseRequestPtr>& sub_requests);
+
+ private:
+    const std::string table_name_;
+    const std::vector<SearchQueryParam>& query_params_;
+
+    std::vector<TopKQueryResult>& results_;
+};
+
+}  // namespace server
+}  // namespace milvus
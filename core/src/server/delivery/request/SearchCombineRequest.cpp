@@ -0,0 +1,220 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "server/DBWrapper.h"
+#include "server/delivery/ShardProxy.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+SearchCombineRequest::SearchCombineRequest(const SearchRequestPtr& request)
+    : BaseRequest(request->context_, DQL_REQUEST_GROUP) {
+    requests_.push_back(request);
+    combined_nq_ = request->vectors_data_.vector_count_;
+}
+
+std::shared_ptr<SearchCombineRequest>
+SearchCombineRequest::Create(const SearchRequestPtr& request) {
+    return std::shared_ptr<SearchCombineRequest>(new SearchCombineRequest(request));
+}
+
+bool
+SearchCombineRequest::CanCombine(const SearchRequestPtr& request) {
+    // the combined query takes one attribute filter for all vectors, and searches by topk
+    if (request == nullptr || !request->file_id_list_.empty() || !request->vectors_data_.predicates_.empty() ||
+        request->by_range_) {
+        return false;
+    }
+    // combined searches query the local db, sharded searches go through the proxy alone
+    if (ShardProxy::GetInstance().Enabled()) {
+        return false;
+    }
+
+    uint64_t nq = request->vectors_data_.vector_count_;
+    return nq > 0 && nq <= COMBINE_MAX_NQ && request->topk_ <= COMBINE_MAX_TOPK;
+}
+
+bool
+SearchCombineRequest::Combine(const SearchRequestPtr& request) {
+    if (!CanCombine(request)) {
+        return false;
+    }
+
+    // all requests must share the same files and search parameters except topk
+    const SearchRequestPtr& first = requests_.front();
+    if (request->table_name_ != first->table_name_ || request->nprobe_ != first->nprobe_ ||
+        request->partition_list_ != first->partition_list_ || request->range_list_ != first->range_list_ ||
+        request->vectors_data_.float_data_.empty() != first->vectors_data_.float_data_.empty()) {
+        return false;
+    }
+
+    uint64_t nq = request->vectors_data_.vector_count_;
+    if (combined_nq_ + nq > COMBINE_MAX_NQ) {
+        return false;
+    }
+
+    requests_.push_back(request);
+    combined_nq_ += nq;
+    return true;
+}
+
+Status
+SearchCombineRequest::OnExecute() {
+    // requests are finished only after the query, the first one owns the context used by the query
+    std::vector<Status> statuses(requests_.size());
+    std::vector<SearchRequestPtr> valid_requests;
+    try {
+        for (size_t i = 0; i < requests_.size(); i++) {
+            std::vector<DB_DATE> dates;
+            statuses[i] = requests_[i]->CheckSearchParam(dates);
+            if (statuses[i].ok()) {
+                statuses[i] = ValidationUtil::ValidatePartitionTags(requests_[i]->partition_list_);
+            }
+            if (statuses[i].ok()) {
+                valid_requests.push_back(requests_[i]);
+            }
+        }
+
+        auto status = SearchCombined(valid_requests);
+        for (size_t i = 0; i < requests_.size(); i++) {
+            if (statuses[i].ok()) {
+                statuses[i] = status;
+            }
+        }
+    } catch (std::exception& ex) {
+        for (auto& status : statuses) {
+            if (status.ok()) {
+                status = Status(SERVER_UNEXPECTED_ERROR, ex.what());
+            }
+        }
+    }
+
+    for (size_t i = 0; i < requests_.size(); i++) {
+        FinishRequest(requests_[i], statuses[i]);
+    }
+
+    return Status::OK();
+}
+
+Status
+SearchCombineRequest::SearchCombined(std::vector<SearchRequestPtr>& requests) {
+    if (requests.empty()) {
+        return Status::OK();
+    }
+
+    // step 1: concatenate query vectors, search with the largest topk
+    const SearchRequestPtr& first = requests.front();
+    int64_t topk = 0;
+    engine::VectorsData vectors;
+    for (auto& request : requests) {
+        const engine::VectorsData& request_vectors = request->vectors_data_;
+        topk = std::max(topk, request->topk_);
+        vectors.vector_count_ += request_vectors.vector_count_;
+        vectors.float_data_.insert(vectors.float_data_.end(), request_vectors.float_data_.begin(),
+                                   request_vectors.float_data_.end());
+        vectors.binary_data_.insert(vectors.binary_data_.end(), request_vectors.binary_data_.begin(),
+                                    request_vectors.binary_data_.end());
+    }
+
+    std::string hdr = "SearchCombineRequest(table=" + first->table_name_ +
+                      ", requests=" + std::to_string(requests.size()) + ", nq=" + std::to_string(vectors.vector_count_) +
+                      ", k=" + std::to_string(topk) + ", nprob=" + std::to_string(first->nprobe_) + ")";
+    TimeRecorder rc(hdr);
+
+    std::vector<DB_DATE> dates;
+    auto status = ConvertTimeRangeToSearchRange(first->range_list_, dates, vectors.time_ranges_);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // step 2: search vectors, the combined query is useful until the latest deadline of requests,
+    // and a client cancelling its own request does not cancel the others
+    auto query_ctx = context_->Child("Combined query");
+    query_ctx->DetachCancellation();
+    query_ctx->DetachQueryCost();
+    auto deadline = std::chrono::system_clock::time_point::min();
+    for (auto& request : requests) {
+        deadline = std::max(deadline, request->context_->GetDeadline());
+    }
+    query_ctx->SetDeadline(deadline);
+
+    engine::ResultIds result_ids;
+    engine::ResultDistances result_distances;
+    status = DBWrapper::DB()->Query(query_ctx, first->table_name_, first->partition_list_, (size_t)topk, first->nprobe_,
+                                    vectors, dates, result_ids, result_distances);
+    query_ctx->GetTraceContext()->GetSpan()->Finish();
+    auto query_us = static_cast<int64_t>(rc.RecordSection("search vectors from engine"));
+
+    // every request searched all the segments, time and io of the combined query are charged in proportion to
+    // the queries of each request
+    QueryCost& cost = *query_ctx->GetQueryCost();
+    for (auto& request : requests) {
+        request->query_us_ = query_us;
+        double share = static_cast<double>(request->vectors_data_.vector_count_) / vectors.vector_count_;
+        QueryCost& request_cost = *request->context_->GetQueryCost();
+        request_cost.cpu_time_us_ += static_cast<int64_t>(cost.cpu_time_us_ * share);
+        request_cost.gpu_time_us_ += static_cast<int64_t>(cost.gpu_time_us_ * share);
+        request_cost.segments_searched_ += cost.segments_searched_.load();
+        request_cost.vectors_scanned_ += cost.vectors_scanned_.load();
+        request_cost.bytes_loaded_ += static_cast<int64_t>(cost.bytes_loaded_ * share);
+        request_cost.cache_misses_ += static_cast<int64_t>(cost.cache_misses_ * share);
+        std::lock_guard<std::mutex> lock(cost.segments_mutex_);
+        for (auto& segment : cost.segments_) {
+            request_cost.AddSegment(SegmentCost(segment));
+        }
+    }
+
+    if (!status.ok()) {
+        return status;
+    }
+    if (result_ids.empty()) {
+        return Status::OK();  // empty table
+    }
+
+    // step 3: split result array, each request takes its own queries and topk
+    size_t result_k = result_ids.size() / vectors.vector_count_;
+    uint64_t offset = 0;
+    for (auto& request : requests) {
+        uint64_t nq = request->vectors_data_.vector_count_;
+        size_t k = std::min<size_t>(request->topk_, result_k);
+        TopKQueryResult& result = request->result_;
+        result.row_num_ = nq;
+        result.id_list_.resize(nq * k);
+        result.distance_list_.resize(nq * k);
+        for (uint64_t i = 0; i < nq; i++) {
+            size_t src = (offset + i) * result_k;
+            std::copy(result_ids.begin() + src, result_ids.begin() + src + k, result.id_list_.begin() + i * k);
+            std::copy(result_distances.begin() + src, result_distances.begin() + src + k,
+                      result.distance_list_.begin() + i * k);
+        }
+        offset += nq;
+    }
+
+    rc.ElapseFromBegin("totally cost");
+    return Status::OK();
+}
+
+void
+SearchCombineRequest::FinishRequest(const SearchRequestPtr& request, const Status& status) {
+    request->status_ = status;
+    request->Done();
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,70 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+#include "server/delivery/request/SearchRequest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+// requests with larger topk or nq gain little from batching
+constexpr int64_t COMBINE_MAX_TOPK = 64;
+constexpr uint64_t COMBINE_MAX_NQ = 1000;
+
+using SearchRequestPtr = std::shared_ptr<SearchRequest>;
+
+// Search requests waiting in the dql queue on the same table are executed as one query, so that every
+// file is searched once with a larger batch. Each request still gets its own result and status.
+class SearchCombineRequest : public BaseRequest {
+    friend class SearchBatchRequest;
+
+ public:
+    static std::shared_ptr<SearchCombineRequest>
+    Create(const SearchRequestPtr& request);
+
+    // return false if the request can't be searched together with the combined ones
+    bool
+    Combine(const SearchRequestPtr& request);
+
+    static bool
+    CanCombine(const SearchRequestPtr& request);
+
+    size_t
+    RequestCount() const {
+        return requests_.size();
+    }
+
+ protected:
+    explicit SearchCombineRequest(const SearchRequestPtr& request);
+
+    Status
+    OnExecute() override;
+
+ private:
+    Status
+    SearchCombined(std::vector<SearchRequestPtr>& requests);
+
+    static void
+    FinishRequest(const SearchRequestPtr& request, const Status& status);
+
+ private:
+    std::vector<SearchRequestPtr> requests_;
+    uint64_t combined_nq_ = 0;
+};
+
+}  // namespace server
+}  // namespace milvus
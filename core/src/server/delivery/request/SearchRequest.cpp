@@ -10,14 +10,21 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/SearchRequest.h"
+#include "metrics/Metrics.h"
 #include "server/DBWrapper.h"
+#include "server/delivery/RecallMonitor.h"
+#include "server/delivery/ShardProxy.h"
+#include "server/delivery/SlowQueryLog.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 #include "utils/ValidationUtil.h"
 
 #include <fiu-local.h>
+#include <chrono>
 #include <memory>
+#include <string>
+#include <utility>
 #ifdef MILVUS_ENABLE_PROFILING
 #include <gperftools/profiler.h>
 #endif
@@ -49,90 +56,152 @@ SearchRequest::Create(const std::shared_ptr<Context>& context, const std::string
                                                           partition_list, file_id_list, result));
 }
 
-Status
-SearchRequest::OnExecute() {
-    try {
-        fiu_do_on("SearchRequest.OnExecute.throw_std_exception", throw std::exception());
-        uint64_t vector_count = vectors_data_.vector_count_;
-        auto pre_query_ctx = context_->Child("Pre query");
+BaseRequestPtr
+SearchRequest::CreateByRange(const std::shared_ptr<Context>& context, const std::string& table_name,
+                             const engine::VectorsData& vectors, const std::vector<Range>& range_list, float radius,
+                             int64_t max_results, int64_t nprobe, const std::vector<std::string>& partition_list,
+                             TopKQueryResult& result) {
+    auto request = new SearchRequest(context, table_name, vectors, range_list, max_results, nprobe, partition_list,
+                                     std::vector<std::string>(), result);
+    request->by_range_ = true;
+    request->radius_ = radius;
+    return std::shared_ptr<BaseRequest>(request);
+}
 
-        std::string hdr = "SearchRequest(table=" + table_name_ + ", nq=" + std::to_string(vector_count) +
-                          ", k=" + std::to_string(topk_) + ", nprob=" + std::to_string(nprobe_) + ")";
+Status
+SearchRequest::CheckSearchParam(std::vector<DB_DATE>& dates) {
+    // the client may give up while the request is waiting in queue
+    if (context_ != nullptr && context_->IsCancelled()) {
+        return Status(SERVER_REQUEST_CANCELLED, "Search cancelled by client");
+    }
+    if (context_ != nullptr && context_->IsExpired()) {
+        return Status(SERVER_DEADLINE_EXCEEDED, "Search deadline exceeded");
+    }
 
-        TimeRecorder rc(hdr);
+    // step 1: check table name
+    auto status = ValidationUtil::ValidateTableName(table_name_);
+    if (!status.ok()) {
+        return status;
+    }
 
-        // step 1: check table name
-        auto status = ValidationUtil::ValidateTableName(table_name_);
-        if (!status.ok()) {
+    // step 2: check table existence
+    engine::meta::TableSchema table_info;
+    table_info.table_id_ = table_name_;
+    status = DBWrapper::DB()->DescribeTable(table_info);
+    fiu_do_on("SearchRequest.OnExecute.describe_table_fail", status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
+    if (!status.ok()) {
+        if (status.code() == DB_NOT_FOUND) {
+            return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+        } else {
             return status;
         }
+    }
 
-        // step 2: check table existence
-        engine::meta::TableSchema table_info;
-        table_info.table_id_ = table_name_;
-        status = DBWrapper::DB()->DescribeTable(table_info);
-        fiu_do_on("SearchRequest.OnExecute.describe_table_fail", status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
-        if (!status.ok()) {
-            if (status.code() == DB_NOT_FOUND) {
-                return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
-            } else {
-                return status;
-            }
-        }
+    return CheckSearchParam(table_info, dates);
+}
 
-        // step 3: check search parameter
-        status = ValidationUtil::ValidateSearchTopk(topk_, table_info);
-        if (!status.ok()) {
-            return status;
+Status
+SearchRequest::CheckSearchParam(const engine::meta::TableSchema& table_info, std::vector<DB_DATE>& dates) {
+    auto queued = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - create_time_);
+    Metrics::GetInstance().SearchPhaseDurationHistogramObserve("queue", table_info.table_id_,
+                                                               std::to_string(table_info.engine_type_), queued.count());
+    queue_us_ = static_cast<int64_t>(queued.count());
+    result_.engine_type_ = table_info.engine_type_;
+
+    uint64_t vector_count = vectors_data_.vector_count_;
+
+    // step 3: check search parameter
+    auto status = ValidationUtil::ValidateSearchTopk(topk_, table_info);
+    if (!status.ok()) {
+        return status;
+    }
+
+    status = ValidationUtil::ValidateSearchNprobe(nprobe_, table_info);
+    if (!status.ok()) {
+        return status;
+    }
+
+    if (vectors_data_.float_data_.empty() && vectors_data_.binary_data_.empty()) {
+        return Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                      "The vector array is empty. Make sure you have entered vector records.");
+    }
+
+    // step 4: check date range, and convert to db dates
+    status = ConvertTimeRangeToSearchRange(range_list_, dates, time_ranges_);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // range search is answered by float indexes, the attribute filter isn't applied to it
+    bool is_binary = ValidationUtil::IsBinaryMetricType(table_info.metric_type_);
+    if (by_range_ && (is_binary || !vectors_data_.predicates_.empty())) {
+        return Status(SERVER_INVALID_ARGUMENT, "Range search is not supported by binary vectors or attribute filter");
+    }
+
+    if (is_binary) {
+        if (!vectors_data_.predicates_.empty()) {
+            return Status(SERVER_INVALID_ARGUMENT, "Attribute filter is not supported by binary vectors");
         }
 
-        status = ValidationUtil::ValidateSearchNprobe(nprobe_, table_info);
-        if (!status.ok()) {
-            return status;
+        // check prepared binary data
+        if (vectors_data_.binary_data_.size() % vector_count != 0) {
+            return Status(SERVER_INVALID_ROWRECORD_ARRAY, "The vector dimension must be equal to the table dimension.");
         }
 
-        if (vectors_data_.float_data_.empty() && vectors_data_.binary_data_.empty()) {
-            return Status(SERVER_INVALID_ROWRECORD_ARRAY,
-                          "The vector array is empty. Make sure you have entered vector records.");
+        if (vectors_data_.binary_data_.size() * 8 / vector_count != table_info.dimension_) {
+            return Status(SERVER_INVALID_VECTOR_DIMENSION,
+                          "The vector dimension must be equal to the table dimension.");
+        }
+    } else {
+        // check prepared float data
+        fiu_do_on("SearchRequest.OnExecute.invalod_rowrecord_array",
+                  vector_count = vectors_data_.float_data_.size() + 1);
+        if (vectors_data_.float_data_.size() % vector_count != 0) {
+            return Status(SERVER_INVALID_ROWRECORD_ARRAY, "The vector dimension must be equal to the table dimension.");
+        }
+        int64_t dimension = table_info.dimension_;
+        fiu_do_on("SearchRequest.OnExecute.invalid_dim", dimension = -1);
+        if (vectors_data_.float_data_.size() / vector_count != dimension) {
+            return Status(SERVER_INVALID_VECTOR_DIMENSION,
+                          "The vector dimension must be equal to the table dimension.");
         }
+    }
+
+    return Status::OK();
+}
+
+const engine::VectorsData&
+SearchRequest::QueryVectors(engine::VectorsData& ranged_vectors) const {
+    if (time_ranges_.empty()) {
+        return vectors_data_;
+    }
 
-        // step 4: check date range, and convert to db dates
+    ranged_vectors = vectors_data_;
+    ranged_vectors.time_ranges_ = time_ranges_;
+    return ranged_vectors;
+}
+
+Status
+SearchRequest::OnExecute() {
+    try {
+        fiu_do_on("SearchRequest.OnExecute.throw_std_exception", throw std::exception());
+        uint64_t vector_count = vectors_data_.vector_count_;
+        auto pre_query_ctx = context_->Child("Pre query");
+
+        std::string hdr = "SearchRequest(table=" + table_name_ + ", nq=" + std::to_string(vector_count) +
+                          ", k=" + std::to_string(topk_) + ", nprob=" + std::to_string(nprobe_) + ")";
+
+        TimeRecorder rc(hdr);
+
+        // step 1 ~ 5: check table, search parameters and vector data
         std::vector<DB_DATE> dates;
-        status = ConvertTimeRangeToDBDates(range_list_, dates);
+        auto status = CheckSearchParam(dates);
         if (!status.ok()) {
             return status;
         }
 
         rc.RecordSection("check validation");
 
-        if (ValidationUtil::IsBinaryMetricType(table_info.metric_type_)) {
-            // check prepared binary data
-            if (vectors_data_.binary_data_.size() % vector_count != 0) {
-                return Status(SERVER_INVALID_ROWRECORD_ARRAY,
-                              "The vector dimension must be equal to the table dimension.");
-            }
-
-            if (vectors_data_.binary_data_.size() * 8 / vector_count != table_info.dimension_) {
-                return Status(SERVER_INVALID_VECTOR_DIMENSION,
-                              "The vector dimension must be equal to the table dimension.");
-            }
-        } else {
-            // check prepared float data
-            fiu_do_on("SearchRequest.OnExecute.invalod_rowrecord_array",
-                      vector_count = vectors_data_.float_data_.size() + 1);
-            if (vectors_data_.float_data_.size() % vector_count != 0) {
-                return Status(SERVER_INVALID_ROWRECORD_ARRAY,
-                              "The vector dimension must be equal to the table dimension.");
-            }
-            fiu_do_on("SearchRequest.OnExecute.invalid_dim", table_info.dimension_ = -1);
-            if (vectors_data_.float_data_.size() / vector_count != table_info.dimension_) {
-                return Status(SERVER_INVALID_VECTOR_DIMENSION,
-                              "The vector dimension must be equal to the table dimension.");
-            }
-        }
-
-        rc.RecordSection("prepare vector data");
-
         // step 6: search vectors
         engine::ResultIds result_ids;
         engine::ResultDistances result_distances;
@@ -144,6 +213,9 @@ SearchRequest::OnExecute() {
 
         pre_query_ctx->GetTraceContext()->GetSpan()->Finish();
 
+        engine::VectorsData ranged_vectors;
+        const engine::VectorsData& query_vectors = QueryVectors(ranged_vectors);
+
         if (file_id_list_.empty()) {
             status = ValidationUtil::ValidatePartitionTags(partition_list_);
             fiu_do_on("SearchRequest.OnExecute.invalid_partition_tags",
@@ -152,18 +224,35 @@ SearchRequest::OnExecute() {
                 return status;
             }
 
-            status = DBWrapper::DB()->Query(context_, table_name_, partition_list_, (size_t)topk_, nprobe_,
-                                            vectors_data_, dates, result_ids, result_distances);
+            if (by_range_) {
+                // range search runs on the local db, the proxy merges topk results of shards only
+                if (ShardProxy::GetInstance().Enabled()) {
+                    return Status(SERVER_INVALID_ARGUMENT, "Range search is not supported by sharded search");
+                }
+                status = DBWrapper::DB()->QueryByRange(context_, table_name_, partition_list_, radius_, (size_t)topk_,
+                                                       nprobe_, query_vectors, dates, result_ids, result_distances);
+            } else if (ShardProxy::GetInstance().Enabled()) {
+                // shards are searched through grpc, which carries no attribute filter
+                if (!vectors_data_.predicates_.empty()) {
+                    return Status(SERVER_INVALID_ARGUMENT, "Attribute filter is not supported by sharded search");
+                }
+                status = ShardProxy::GetInstance().Search(table_name_, partition_list_, range_list_, topk_, nprobe_,
+                                                          vectors_data_, context_->GetDeadline(), result_ids,
+                                                          result_distances);
+            } else {
+                status = DBWrapper::DB()->Query(context_, table_name_, partition_list_, (size_t)topk_, nprobe_,
+                                                query_vectors, dates, result_ids, result_distances);
+            }
         } else {
             status = DBWrapper::DB()->QueryByFileID(context_, table_name_, file_id_list_, (size_t)topk_, nprobe_,
-                                                    vectors_data_, dates, result_ids, result_distances);
+                                                    query_vectors, dates, result_ids, result_distances);
         }
 
 #ifdef MILVUS_ENABLE_PROFILING
         ProfilerStop();
 #endif
 
-        rc.RecordSection("search vectors from engine");
+        query_us_ = static_cast<int64_t>(rc.RecordSection("search vectors from engine"));
         fiu_do_on("SearchRequest.OnExecute.query_fail", status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
         if (!status.ok()) {
             return status;
@@ -177,8 +266,8 @@ SearchRequest::OnExecute() {
 
         // step 7: construct result array
         result_.row_num_ = vector_count;
-        result_.distance_list_ = result_distances;
-        result_.id_list_ = result_ids;
+        result_.distance_list_ = std::move(result_distances);
+        result_.id_list_ = std::move(result_ids);
 
         post_query_ctx->GetTraceContext()->GetSpan()->Finish();
 
@@ -192,5 +281,60 @@ SearchRequest::OnExecute() {
     return Status::OK();
 }
 
+void
+SearchRequest::OnDone(int64_t latency_us) {
+    auto& recall_monitor = RecallMonitor::GetInstance();
+    // the exact search recall is measured against takes no attribute filter, time range or radius
+    if (status_.ok() && !result_.id_list_.empty() && vectors_data_.predicates_.empty() && !by_range_ &&
+        time_ranges_.empty() && recall_monitor.ShouldSample()) {
+        recall_monitor.Sample(table_name_, partition_list_, result_.engine_type_, topk_, vectors_data_,
+                              result_.id_list_);
+    }
+
+    auto& slow_query_log = SlowQueryLog::GetInstance();
+    if (context_ == nullptr || !slow_query_log.IsSlow(latency_us)) {
+        return;
+    }
+
+    QueryCost& cost = *context_->GetQueryCost();
+    json segments = json::array();
+    {
+        std::lock_guard<std::mutex> lock(cost.segments_mutex_);
+        for (auto& segment : cost.segments_) {
+            segments.push_back({
+                {"file_id", segment.file_id_},
+                {"engine_type", segment.engine_type_},
+                {"row_count", segment.row_count_},
+                {"resource", segment.resource_},
+                {"load_us", segment.load_us_},
+                {"search_us", segment.search_us_},
+                {"reduce_us", segment.reduce_us_},
+            });
+        }
+    }
+
+    json record{
+        {"table", table_name_},
+        {"nq", vectors_data_.vector_count_},
+        {"topk", topk_},
+        {"nprobe", nprobe_},
+        {"partitions", partition_list_},
+        {"file_ids", file_id_list_},
+        {"status", status_.code()},
+        {"latency_us", latency_us},
+        {"phases", {{"queue_us", queue_us_}, {"query_us", query_us_}}},
+        {"cpu_time_us", cost.cpu_time_us_.load()},
+        {"gpu_time_us", cost.gpu_time_us_.load()},
+        {"bytes_loaded", cost.bytes_loaded_.load()},
+        {"cache_misses", cost.cache_misses_.load()},
+        {"segment_count", segments.size()},
+        {"segments", std::move(segments)},
+    };
+    if (by_range_) {
+        record["radius"] = radius_;
+    }
+    slow_query_log.Record(std::move(record));
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -21,6 +21,9 @@ namespace milvus {
 namespace server {
 
 class SearchRequest : public BaseRequest {
+    friend class SearchCombineRequest;
+    friend class SearchBatchRequest;
+
  public:
     static BaseRequestPtr
     Create(const std::shared_ptr<Context>& context, const std::string& table_name, const engine::VectorsData& vectors,
@@ -28,6 +31,13 @@ class SearchRequest : public BaseRequest {
            const std::vector<std::string>& partition_list, const std::vector<std::string>& file_id_list,
            TopKQueryResult& result);
 
+    // vectors within radius of the queries, at most max_results hits of each query nearest first, padded with id -1
+    static BaseRequestPtr
+    CreateByRange(const std::shared_ptr<Context>& context, const std::string& table_name,
+                  const engine::VectorsData& vectors, const std::vector<Range>& range_list, float radius,
+                  int64_t max_results, int64_t nprobe, const std::vector<std::string>& partition_list,
+                  TopKQueryResult& result);
+
  protected:
     SearchRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
                   const engine::VectorsData& vectors, const std::vector<Range>& range_list, int64_t topk,
@@ -37,6 +47,21 @@ class SearchRequest : public BaseRequest {
     Status
     OnExecute() override;
 
+    void
+    OnDone(int64_t latency_us) override;
+
+ private:
+    Status
+    CheckSearchParam(std::vector<DB_DATE>& dates);
+
+    // check the request against a table described by the caller
+    Status
+    CheckSearchParam(const engine::meta::TableSchema& table_info, std::vector<DB_DATE>& dates);
+
+    // the db takes time ranges along with the vectors, which are copied only for a search limited in time
+    const engine::VectorsData&
+    QueryVectors(engine::VectorsData& ranged_vectors) const;
+
  private:
     const std::string table_name_;
     const engine::VectorsData& vectors_data_;
@@ -45,8 +70,15 @@ class SearchRequest : public BaseRequest {
     int64_t nprobe_;
     const std::vector<std::string> partition_list_;
     const std::vector<std::string> file_id_list_;
+    engine::TimeRanges time_ranges_;  // converted from range_list_ by CheckSearchParam
+    bool by_range_ = false;
+    float radius_ = 0.0f;  // topk_ is the max hits of a query if by_range_
 
     TopKQueryResult& result_;
+
+    // phase timings for the slow query log
+    int64_t queue_us_ = 0;
+    int64_t query_us_ = 0;
 };
 
 }  // namespace server
@@ -9,14 +9,21 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #include <fiu-local.h>
+#include <opentracing/noop.h>
+#include <algorithm>
+#include <cstring>
+#include <future>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include "metrics/Metrics.h"
 #include "server/Config.h"
 #include "server/grpc_impl/GrpcRequestHandler.h"
+#include "server/grpc_impl/QueryCapture.h"
 #include "tracing/TextMapCarrier.h"
 #include "tracing/TracerUtil.h"
+#include "utils/Json.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
@@ -67,50 +74,156 @@ ErrorMap(ErrorCode code) {
 }
 
 namespace {
-void
+// resolution of the sample rate
+constexpr uint64_t SAMPLE_SCALE = 1000000;
+// a client sending this metadata key gets the resources spent by its search in the trailing metadata of same key
+constexpr char QUERY_COST_HEADER[] = "milvus-query-cost";
+
+// batches of at least so many floats are copied by rows in parallel
+constexpr int64_t PARALLEL_COPY_MIN_FLOATS = 4 * 1024 * 1024;
+
+// a search stream returns the results of so many bytes at a time, an id and a distance for each of topk per query
+constexpr int64_t SEARCH_STREAM_CHUNK_SIZE = 4 * 1024 * 1024;
+
+// a bulk insert stream loads so many bytes of vectors at a time, each batch is split into files of index_file_size
+constexpr uint64_t BULK_INSERT_BATCH_SIZE = 1024UL * 1024 * 1024;
+
+
+Status
 CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecord>& grpc_records,
                const google::protobuf::RepeatedField<google::protobuf::int64>& grpc_id_array,
                engine::VectorsData& vectors) {
-    // step 1: copy vector data
-    int64_t float_data_size = 0, binary_data_size = 0;
+    // step 1: check rows, all of them have the dimension of the first one, rows of mixed dimensions could add up
+    // to a size the dimension check of the request takes for valid
+    int64_t row_count = grpc_records.size();
+    int64_t float_dim = 0, binary_dim = 0;
+    if (row_count > 0) {
+        float_dim = grpc_records[0].float_data_size();
+        binary_dim = grpc_records[0].binary_data().size();
+    }
     for (auto& record : grpc_records) {
-        float_data_size += record.float_data_size();
-        binary_data_size += record.binary_data().size();
+        if (record.float_data_size() != float_dim || static_cast<int64_t>(record.binary_data().size()) != binary_dim) {
+            return Status(SERVER_INVALID_VECTOR_DIMENSION, "All vectors must have the same dimension.");
+        }
     }
 
-    std::vector<float> float_array(float_data_size, 0.0f);
-    std::vector<uint8_t> binary_array(binary_data_size, 0);
-    int64_t float_offset = 0, binary_offset = 0;
-    if (float_data_size > 0) {
-        for (auto& record : grpc_records) {
-            memcpy(&float_array[float_offset], record.float_data().data(), record.float_data_size() * sizeof(float));
-            float_offset += record.float_data_size();
+    // rows are appended to those already in vectors, which have the same dimension as well
+    if (row_count > 0 && vectors.vector_count_ > 0 &&
+        (static_cast<int64_t>(vectors.float_data_.size()) != float_dim * vectors.vector_count_ ||
+         static_cast<int64_t>(vectors.binary_data_.size()) != binary_dim * vectors.vector_count_)) {
+        return Status(SERVER_INVALID_VECTOR_DIMENSION, "All vectors must have the same dimension.");
+    }
+
+    // step 2: copy vector data
+    // this is the only copy of vector data on insert path, the buffer is passed down by reference afterwards
+    if (float_dim > 0) {
+        int64_t offset = vectors.float_data_.size();
+        int64_t float_data_size = float_dim * row_count;
+        if (float_data_size >= PARALLEL_COPY_MIN_FLOATS) {
+            // rows go to known offsets, so a large batch is copied by all cores, first touch of the pages included
+            vectors.float_data_.resize(offset + float_data_size);
+            float* dst = vectors.float_data_.data() + offset;
+#pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < row_count; i++) {
+                memcpy(dst + i * float_dim, grpc_records[i].float_data().data(), float_dim * sizeof(float));
+            }
+        } else {
+            // append directly into reserved buffer, avoid zero-filling memory which will be overwritten
+            vectors.float_data_.reserve(offset + float_data_size);
+            for (auto& record : grpc_records) {
+                vectors.float_data_.insert(vectors.float_data_.end(), record.float_data().begin(),
+                                           record.float_data().end());
+            }
         }
-    } else if (binary_data_size > 0) {
+    } else if (binary_dim > 0) {
+        vectors.binary_data_.reserve(vectors.binary_data_.size() + binary_dim * row_count);
         for (auto& record : grpc_records) {
-            memcpy(&binary_array[binary_offset], record.binary_data().data(), record.binary_data().size());
-            binary_offset += record.binary_data().size();
+            auto& binary_data = record.binary_data();
+            vectors.binary_data_.insert(vectors.binary_data_.end(), binary_data.begin(), binary_data.end());
         }
     }
 
-    // step 2: copy id array
-    std::vector<int64_t> id_array;
-    if (grpc_id_array.size() > 0) {
-        id_array.resize(grpc_id_array.size());
-        memcpy(id_array.data(), grpc_id_array.data(), grpc_id_array.size() * sizeof(int64_t));
+    // step 3: copy id array
+    vectors.id_array_.insert(vectors.id_array_.end(), grpc_id_array.begin(), grpc_id_array.end());
+
+    // step 4: contruct vectors
+    vectors.vector_count_ += row_count;
+    return Status::OK();
+}
+
+void
+ConstructResults(const std::string& table_name, TopKQueryResult& result, ::milvus::grpc::TopKQueryResult* response) {
+    CollectSearchPhaseMetrics metrics("serialize", table_name, result.engine_type_);
+
+    // a large result is held twice while it is copied into response, release each array once it is copied
+    // so that at most one array is duplicated at a time
+    response->set_row_num(result.row_num_);
+
+    // the fields are reserved rather than resized, so each array is written once instead of zeroed then copied
+    auto ids = response->mutable_ids();
+    ids->Reserve(static_cast<int>(result.id_list_.size()));
+    if (!result.id_list_.empty()) {
+        memcpy(ids->AddNAlreadyReserved(static_cast<int>(result.id_list_.size())), result.id_list_.data(),
+               result.id_list_.size() * sizeof(int64_t));
+    }
+    engine::ResultIds().swap(result.id_list_);
+
+    auto distances = response->mutable_distances();
+    distances->Reserve(static_cast<int>(result.distance_list_.size()));
+    if (!result.distance_list_.empty()) {
+        memcpy(distances->AddNAlreadyReserved(static_cast<int>(result.distance_list_.size())),
+               result.distance_list_.data(), result.distance_list_.size() * sizeof(float));
+    }
+    engine::ResultDistances().swap(result.distance_list_);
+}
+
+// resources spent by a search are accumulated per table, and returned to the client if it asks for them
+void
+ReportQueryCost(const std::string& table_name, const Context& context, ::grpc::ServerContext* server_context) {
+    const QueryCost& cost = *context.GetQueryCost();
+    json usage{
+        {"cpu_time_us", cost.cpu_time_us_.load()},
+        {"gpu_time_us", cost.gpu_time_us_.load()},
+        {"segments_searched", cost.segments_searched_.load()},
+        {"vectors_scanned", cost.vectors_scanned_.load()},
+        {"bytes_loaded", cost.bytes_loaded_.load()},
+        {"cache_misses", cost.cache_misses_.load()},
+    };
+    for (auto& item : usage.items()) {
+        Metrics::GetInstance().QueryResourceUsageIncrement(table_name, item.key(), item.value().get<int64_t>());
+    }
+
+    auto& client_metadata = server_context->client_metadata();
+    if (client_metadata.find(QUERY_COST_HEADER) != client_metadata.end()) {
+        server_context->AddTrailingMetadata(QUERY_COST_HEADER, usage.dump());
     }
+}
 
-    // step 3: contruct vectors
-    vectors.vector_count_ = grpc_records.size();
-    vectors.float_data_.swap(float_array);
-    vectors.binary_data_.swap(binary_array);
-    vectors.id_array_.swap(id_array);
+// a request rejected by an overloaded server fails the call with a status clients know to retry
+::grpc::Status
+GrpcStatus(const Status& status) {
+    if (status.code() == SERVER_REQUEST_QUEUE_FULL) {
+        return ::grpc::Status(::grpc::StatusCode::RESOURCE_EXHAUSTED, status.message());
+    }
+    if (status.code() == SERVER_REQUEST_CANCELLED) {
+        return ::grpc::Status(::grpc::StatusCode::CANCELLED, status.message());
+    }
+    return ::grpc::Status::OK;
+}
+
+// run an async call and wait for it to be done
+::grpc::Status
+WaitCall(const std::function<void(const GrpcCallback&)>& call) {
+    std::promise<::grpc::Status> promise;
+    auto future = promise.get_future();
+    call([&promise](const ::grpc::Status& status) { promise.set_value(status); });
+    return future.get();
 }
 
 }  // namespace
 
 GrpcRequestHandler::GrpcRequestHandler(const std::shared_ptr<opentracing::Tracer>& tracer)
-    : tracer_(tracer), random_num_generator_() {
+    : tracer_(tracer), noop_tracer_(opentracing::MakeNoopTracer()), random_num_generator_() {
     std::random_device random_device;
     random_num_generator_.seed(random_device());
 }
@@ -131,13 +244,20 @@ GrpcRequestHandler::OnPostRecvInitialMetaData(
     //        text_map["demo-debug-id"] = "debug-id";
     //    }
 
-    tracing::TextMapCarrier carrier{text_map};
-    auto span_context_maybe = tracer_->Extract(carrier);
-    if (!span_context_maybe) {
-        std::cerr << span_context_maybe.error().message() << std::endl;
-        return;
+    bool sampled = !text_map.empty() || (sample_rate_ >= 1.0) ||
+                   (sample_rate_ > 0.0 && (random_id() % SAMPLE_SCALE) < sample_rate_ * SAMPLE_SCALE);
+    std::unique_ptr<opentracing::Span> span;
+    if (sampled) {
+        tracing::TextMapCarrier carrier{text_map};
+        auto span_context_maybe = tracer_->Extract(carrier);
+        if (!span_context_maybe) {
+            std::cerr << span_context_maybe.error().message() << std::endl;
+            return;
+        }
+        span = tracer_->StartSpan(server_rpc_info->method(), {opentracing::ChildOf(span_context_maybe->get())});
+    } else {
+        span = noop_tracer_->StartSpan(server_rpc_info->method());
     }
-    auto span = tracer_->StartSpan(server_rpc_info->method(), {opentracing::ChildOf(span_context_maybe->get())});
     auto server_context = server_rpc_info->server_context();
     auto client_metadata = server_context->client_metadata();
     // TODO: request id
@@ -148,9 +268,11 @@ GrpcRequestHandler::OnPostRecvInitialMetaData(
     } else {
         request_id = std::to_string(random_id()) + std::to_string(random_id());
     }
-    auto trace_context = std::make_shared<tracing::TraceContext>(span);
+    auto trace_context = std::make_shared<tracing::TraceContext>(span, sampled);
     auto context = std::make_shared<Context>(request_id);
     context->SetTraceContext(trace_context);
+    // grpc gives time_point::max() when the client sets no deadline
+    context->SetDeadline(server_context->deadline());
     SetContext(server_rpc_info->server_context(), context);
 }
 
@@ -177,6 +299,20 @@ GrpcRequestHandler::SetContext(::grpc::ServerContext* server_context, const std:
     context_map_[server_context] = context;
 }
 
+void
+GrpcRequestHandler::CancelContext(::grpc::ServerContext* server_context) {
+    std::lock_guard<std::mutex> lock(context_map_mutex_);
+    auto iter = context_map_.find(server_context);
+    if (iter != context_map_.end() && iter->second != nullptr) {
+        iter->second->Cancel();
+    }
+}
+
+void
+GrpcRequestHandler::SetSampleRate(double rate) {
+    sample_rate_ = rate;
+}
+
 uint64_t
 GrpcRequestHandler::random_id() const {
     std::lock_guard<std::mutex> lock(random_mutex_);
@@ -198,7 +334,7 @@ GrpcRequestHandler::CreateTable(::grpc::ServerContext* context, const ::milvus::
                                                  request->index_file_size(), request->metric_type());
     SET_RESPONSE(response, status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -212,7 +348,7 @@ GrpcRequestHandler::HasTable(::grpc::ServerContext* context, const ::milvus::grp
     response->set_bool_reply(has_table);
     SET_RESPONSE(response->mutable_status(), status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -223,7 +359,7 @@ GrpcRequestHandler::DropTable(::grpc::ServerContext* context, const ::milvus::gr
     Status status = request_handler_.DropTable(context_map_[context], request->table_name());
 
     SET_RESPONSE(response, status, context);
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -235,39 +371,211 @@ GrpcRequestHandler::CreateIndex(::grpc::ServerContext* context, const ::milvus::
                                                  request->index().index_type(), request->index().nlist());
 
     SET_RESPONSE(response, status, context);
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
 GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
                            ::milvus::grpc::VectorIds* response) {
-    CHECK_NULLPTR_RETURN(request);
+    return WaitCall([&](const GrpcCallback& done) { InsertAsync(context, request, response, done); });
+}
+
+void
+GrpcRequestHandler::InsertAsync(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                                ::milvus::grpc::VectorIds* response, const GrpcCallback& done) {
+    if (nullptr == request) {
+        done(::grpc::Status::OK);
+        return;
+    }
+
+    // the request refers to the state, the state lives until the request is dropped along with its callback
+    struct InsertState {
+        std::shared_ptr<Context> context_;
+        engine::VectorsData vectors_;
+    };
+    auto state = std::make_shared<InsertState>();
+    state->context_ = GetContext(context);
 
     // step 1: copy vector data
-    engine::VectorsData vectors;
-    CopyRowRecords(request->row_record_array(), request->row_id_array(), vectors);
+    auto status = CopyRowRecords(request->row_record_array(), request->row_id_array(), state->vectors_);
+    if (!status.ok()) {
+        response->clear_vector_id_array();
+        SET_RESPONSE(response->mutable_status(), status, context);
+        done(GrpcStatus(status));
+        return;
+    }
 
     // step 2: insert vectors
-    Status status =
-        request_handler_.Insert(context_map_[context], request->table_name(), vectors, request->partition_tag());
+    request_handler_.InsertAsync(
+        state->context_, request->table_name(), state->vectors_, request->partition_tag(),
+        [this, context, response, state, done](const Status& status) {
+            // step 3: return id array
+            auto& id_array = state->vectors_.id_array_;
+            response->mutable_vector_id_array()->Resize(static_cast<int>(id_array.size()), 0);
+            memcpy(response->mutable_vector_id_array()->mutable_data(), id_array.data(),
+                   id_array.size() * sizeof(int64_t));
+
+            SET_RESPONSE(response->mutable_status(), status, context);
+            done(GrpcStatus(status));
+        });
+}
 
-    // step 3: return id array
-    response->mutable_vector_id_array()->Resize(static_cast<int>(vectors.id_array_.size()), 0);
-    memcpy(response->mutable_vector_id_array()->mutable_data(), vectors.id_array_.data(),
-           vectors.id_array_.size() * sizeof(int64_t));
+::grpc::Status
+GrpcRequestHandler::InsertStream(::grpc::ServerContext* context,
+                                 ::grpc::ServerReader<::milvus::grpc::InsertParam>* reader,
+                                 ::milvus::grpc::VectorIds* response) {
+    // the next chunk is read once the last one is inserted, a full insert buffer holds the client back by flow control
+    ::milvus::grpc::InsertParam chunk;
+    std::string table_name;
+    while (reader->Read(&chunk)) {
+        if (table_name.empty()) {
+            table_name = chunk.table_name();
+        }
+        auto grpc_status = WaitCall(
+            [&](const GrpcCallback& done) { InsertChunkAsync(context, &chunk, table_name, response, done); });
+        if (!grpc_status.ok() || response->status().error_code() != ::milvus::grpc::ErrorCode::SUCCESS) {
+            return grpc_status;
+        }
+    }
 
-    SET_RESPONSE(response->mutable_status(), status, context);
     return ::grpc::Status::OK;
 }
 
+void
+GrpcRequestHandler::InsertChunkAsync(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* chunk,
+                                     const std::string& table_name, ::milvus::grpc::VectorIds* response,
+                                     const GrpcCallback& done) {
+    if (chunk->table_name() != table_name) {
+        Status status(SERVER_INVALID_ARGUMENT, "All chunks of an insert stream must target the same table");
+        SET_RESPONSE(response->mutable_status(), status, context);
+        done(GrpcStatus(status));
+        return;
+    }
+
+    auto chunk_response = std::make_shared<::milvus::grpc::VectorIds>();
+    InsertAsync(context, chunk, chunk_response.get(),
+                [response, chunk_response, done](const ::grpc::Status& grpc_status) {
+                    response->mutable_vector_id_array()->MergeFrom(chunk_response->vector_id_array());
+                    *response->mutable_status() = chunk_response->status();
+                    done(grpc_status);
+                });
+}
+
+struct GrpcRequestHandler::BulkInsertState {
+    std::shared_ptr<Context> context_;
+    std::string table_name_;
+    std::string partition_tag_;
+    engine::VectorsData vectors_;
+};
+
+::grpc::Status
+GrpcRequestHandler::BulkInsert(::grpc::ServerContext* context,
+                               ::grpc::ServerReader<::milvus::grpc::InsertParam>* reader,
+                               ::milvus::grpc::VectorIds* response) {
+    ::milvus::grpc::InsertParam chunk;
+    BulkInsertStatePtr state;
+    while (reader->Read(&chunk)) {
+        auto grpc_status = WaitCall(
+            [&](const GrpcCallback& done) { BulkInsertChunkAsync(context, &chunk, state, response, done); });
+        if (!grpc_status.ok() || response->status().error_code() != ::milvus::grpc::ErrorCode::SUCCESS) {
+            return grpc_status;
+        }
+    }
+
+    return WaitCall(
+        [&](const GrpcCallback& done) { BulkInsertChunkAsync(context, nullptr, state, response, done); });
+}
+
+void
+GrpcRequestHandler::BulkInsertChunkAsync(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* chunk,
+                                         BulkInsertStatePtr& state, ::milvus::grpc::VectorIds* response,
+                                         const GrpcCallback& done) {
+    // step 1: gather the chunk into the batch, the first chunk decides the table and partition
+    if (state == nullptr) {
+        state = std::make_shared<BulkInsertState>();
+        state->context_ = GetContext(context);
+        if (chunk != nullptr) {
+            state->table_name_ = chunk->table_name();
+            state->partition_tag_ = chunk->partition_tag();
+        }
+    }
+
+    auto& vectors = state->vectors_;
+    if (chunk != nullptr) {
+        Status status;
+        if (chunk->table_name() != state->table_name_ || chunk->partition_tag() != state->partition_tag_) {
+            status = Status(SERVER_INVALID_ARGUMENT,
+                            "All chunks of a bulk insert stream must target the same table and partition");
+        } else {
+            status = CopyRowRecords(chunk->row_record_array(), chunk->row_id_array(), vectors);
+        }
+        if (!status.ok()) {
+            SET_RESPONSE(response->mutable_status(), status, context);
+            done(GrpcStatus(status));
+            return;
+        }
+
+        uint64_t batch_size = vectors.float_data_.size() * sizeof(float) + vectors.binary_data_.size();
+        if (batch_size < BULK_INSERT_BATCH_SIZE) {
+            done(::grpc::Status::OK);
+            return;
+        }
+    }
+
+    if (vectors.vector_count_ == 0) {
+        done(::grpc::Status::OK);
+        return;
+    }
+
+    // step 2: load the batch, the state keeps the vectors until the request is done
+    request_handler_.BulkInsertAsync(
+        state->context_, state->table_name_, vectors, state->partition_tag_,
+        [this, context, response, state, done](const Status& status) {
+            // step 3: append id array and start next batch
+            auto& id_array = state->vectors_.id_array_;
+            auto ids = response->mutable_vector_id_array();
+            int offset = ids->size();
+            ids->Resize(offset + static_cast<int>(id_array.size()), 0);
+            memcpy(ids->mutable_data() + offset, id_array.data(), id_array.size() * sizeof(int64_t));
+            state->vectors_ = engine::VectorsData();
+
+            SET_RESPONSE(response->mutable_status(), status, context);
+            done(GrpcStatus(status));
+        });
+}
+
 ::grpc::Status
 GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
                            ::milvus::grpc::TopKQueryResult* response) {
-    CHECK_NULLPTR_RETURN(request);
+    return WaitCall([&](const GrpcCallback& done) { SearchAsync(context, request, response, done); });
+}
+
+void
+GrpcRequestHandler::SearchAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                ::milvus::grpc::TopKQueryResult* response, const GrpcCallback& done) {
+    if (nullptr == request) {
+        done(::grpc::Status::OK);
+        return;
+    }
+
+    QueryCapture::GetInstance().Capture(*request);
+
+    struct SearchState {
+        std::shared_ptr<Context> context_;
+        engine::VectorsData vectors_;
+        TopKQueryResult result_;
+    };
+    auto state = std::make_shared<SearchState>();
+    state->context_ = GetContext(context);
 
     // step 1: copy vector data
-    engine::VectorsData vectors;
-    CopyRowRecords(request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(), vectors);
+    auto status = CopyRowRecords(request->query_record_array(),
+                                 google::protobuf::RepeatedField<google::protobuf::int64>(), state->vectors_);
+    if (!status.ok()) {
+        SET_RESPONSE(response->mutable_status(), status, context);
+        done(GrpcStatus(status));
+        return;
+    }
 
     // deprecated
     std::vector<Range> ranges;
@@ -283,37 +591,235 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
 
     // step 3: search vectors
     std::vector<std::string> file_ids;
-    TopKQueryResult result;
     fiu_do_on("GrpcRequestHandler.Search.not_empty_file_ids", file_ids.emplace_back("test_file_id"));
-    Status status = request_handler_.Search(context_map_[context], request->table_name(), vectors, ranges,
-                                            request->topk(), request->nprobe(), partitions, file_ids, result);
+    request_handler_.SearchAsync(state->context_, request->table_name(), state->vectors_, ranges, request->topk(),
+                                 request->nprobe(), partitions, file_ids, state->result_,
+                                 [this, context, request, response, state, done](const Status& status) {
+                                     // step 4: construct and return result
+                                     ConstructResults(request->table_name(), state->result_, response);
+                                     ReportQueryCost(request->table_name(), *state->context_, context);
+
+                                     SET_RESPONSE(response->mutable_status(), status, context);
+                                     done(GrpcStatus(status));
+                                 });
+}
 
-    // step 4: construct and return result
-    response->set_row_num(result.row_num_);
+struct GrpcRequestHandler::SearchStreamState {
+    ::grpc::ServerContext* server_context_ = nullptr;
+    const ::milvus::grpc::SearchParam* request_ = nullptr;
+    GrpcChunkWriter write_;
+    GrpcCallback done_;
+    std::shared_ptr<Context> context_;
+    engine::VectorsData vectors_;
+    std::vector<Range> ranges_;
+    std::vector<std::string> partitions_;
+    int64_t chunk_nq_ = 1;
+    int64_t offset_ = 0;
+    engine::VectorsData chunk_vectors_;
+    TopKQueryResult result_;
+    ::milvus::grpc::TopKQueryResult response_;
+};
 
-    response->mutable_ids()->Resize(static_cast<int>(result.id_list_.size()), 0);
-    memcpy(response->mutable_ids()->mutable_data(), result.id_list_.data(), result.id_list_.size() * sizeof(int64_t));
+::grpc::Status
+GrpcRequestHandler::SearchStream(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                 ::grpc::ServerWriter<::milvus::grpc::TopKQueryResult>* writer) {
+    return WaitCall([&](const GrpcCallback& done) {
+        SearchStreamAsync(
+            context, request,
+            [writer](const ::milvus::grpc::TopKQueryResult& chunk, const GrpcCallback& written) {
+                written(writer->Write(chunk) ? ::grpc::Status::OK : ::grpc::Status::CANCELLED);
+            },
+            done);
+    });
+}
 
-    response->mutable_distances()->Resize(static_cast<int>(result.distance_list_.size()), 0.0);
-    memcpy(response->mutable_distances()->mutable_data(), result.distance_list_.data(),
-           result.distance_list_.size() * sizeof(float));
+void
+GrpcRequestHandler::SearchStreamAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                      const GrpcChunkWriter& write, const GrpcCallback& done) {
+    if (nullptr == request) {
+        done(::grpc::Status::OK);
+        return;
+    }
 
-    SET_RESPONSE(response->mutable_status(), status, context);
+    QueryCapture::GetInstance().Capture(*request);
+
+    auto state = std::make_shared<SearchStreamState>();
+    state->server_context_ = context;
+    state->request_ = request;
+    state->write_ = write;
+    state->done_ = done;
+    state->context_ = GetContext(context);
+
+    // step 1: copy vector data once, each chunk takes its rows from it
+    auto status = CopyRowRecords(request->query_record_array(),
+                                 google::protobuf::RepeatedField<google::protobuf::int64>(), state->vectors_);
+    if (!status.ok()) {
+        SET_RESPONSE(state->response_.mutable_status(), status, context);
+        write(state->response_, [done, status](const ::grpc::Status& written) {
+            done(written.ok() ? GrpcStatus(status) : written);
+        });
+        return;
+    }
 
-    return ::grpc::Status::OK;
+    // deprecated
+    for (auto& range : request->query_range_array()) {
+        state->ranges_.emplace_back(range.start_value(), range.end_value());
+    }
+
+    // step 2: partition tags
+    for (auto& partition : request->partition_tag_array()) {
+        state->partitions_.emplace_back(partition);
+    }
+
+    // step 3: queries of a chunk, an invalid topk is left to the search to report
+    int64_t topk = std::max<int64_t>(request->topk(), 1);
+    state->chunk_nq_ = std::max<int64_t>(SEARCH_STREAM_CHUNK_SIZE / (topk * (sizeof(int64_t) + sizeof(float))), 1);
+    fiu_do_on("GrpcRequestHandler.SearchStream.one_query_chunk", state->chunk_nq_ = 1);
+
+    SearchStreamChunk(state);
+}
+
+void
+GrpcRequestHandler::SearchStreamChunk(const std::shared_ptr<SearchStreamState>& state) {
+    // step 4: take the rows of next chunk, a request without rows still runs one chunk for the search to reject it
+    auto& vectors = state->vectors_;
+    int64_t nq = vectors.vector_count_;
+    int64_t count = std::min(state->chunk_nq_, nq - state->offset_);
+    auto& chunk = state->chunk_vectors_;
+    chunk.vector_count_ = count;
+    if (!vectors.float_data_.empty()) {
+        int64_t dim = vectors.float_data_.size() / nq;
+        auto begin = vectors.float_data_.begin() + state->offset_ * dim;
+        chunk.float_data_.assign(begin, begin + count * dim);
+    } else if (!vectors.binary_data_.empty()) {
+        int64_t dim = vectors.binary_data_.size() / nq;
+        auto begin = vectors.binary_data_.begin() + state->offset_ * dim;
+        chunk.binary_data_.assign(begin, begin + count * dim);
+    }
+    state->offset_ += count;
+    bool last_chunk = state->offset_ >= nq;
+
+    // step 5: search the chunk, write its result and go on with the next one once written
+    auto request = state->request_;
+    std::vector<std::string> file_ids;
+    state->result_ = TopKQueryResult();
+    request_handler_.SearchAsync(
+        state->context_, request->table_name(), chunk, state->ranges_, request->topk(), request->nprobe(),
+        state->partitions_, file_ids, state->result_, [this, state, last_chunk](const Status& status) {
+            auto& table_name = state->request_->table_name();
+            state->response_.Clear();
+            ConstructResults(table_name, state->result_, &state->response_);
+            SET_RESPONSE(state->response_.mutable_status(), status, state->server_context_);
+
+            bool last = last_chunk || !status.ok();
+            if (last) {
+                ReportQueryCost(table_name, *state->context_, state->server_context_);
+            }
+            state->write_(state->response_, [this, state, status, last](const ::grpc::Status& written) {
+                if (!written.ok()) {
+                    state->done_(written);
+                } else if (last) {
+                    state->done_(GrpcStatus(status));
+                } else {
+                    SearchStreamChunk(state);
+                }
+            });
+        });
+}
+
+::grpc::Status
+GrpcRequestHandler::SearchByRange(::grpc::ServerContext* context, const ::milvus::grpc::RangeSearchParam* request,
+                                  ::milvus::grpc::TopKQueryResult* response) {
+    return WaitCall([&](const GrpcCallback& done) { SearchByRangeAsync(context, request, response, done); });
+}
+
+void
+GrpcRequestHandler::SearchByRangeAsync(::grpc::ServerContext* context,
+                                       const ::milvus::grpc::RangeSearchParam* request,
+                                       ::milvus::grpc::TopKQueryResult* response, const GrpcCallback& done) {
+    if (nullptr == request) {
+        done(::grpc::Status::OK);
+        return;
+    }
+
+    struct SearchState {
+        std::shared_ptr<Context> context_;
+        engine::VectorsData vectors_;
+        TopKQueryResult result_;
+    };
+    auto state = std::make_shared<SearchState>();
+    state->context_ = GetContext(context);
+
+    auto* search_request = &request->search_param();
+
+    // step 1: copy vector data
+    auto status = CopyRowRecords(search_request->query_record_array(),
+                                 google::protobuf::RepeatedField<google::protobuf::int64>(), state->vectors_);
+    if (!status.ok()) {
+        SET_RESPONSE(response->mutable_status(), status, context);
+        done(GrpcStatus(status));
+        return;
+    }
+
+    // deprecated
+    std::vector<Range> ranges;
+    for (auto& range : search_request->query_range_array()) {
+        ranges.emplace_back(range.start_value(), range.end_value());
+    }
+
+    // step 2: partition tags
+    std::vector<std::string> partitions;
+    for (auto& partition : search_request->partition_tag_array()) {
+        partitions.emplace_back(partition);
+    }
+
+    // step 3: search vectors, topk is the max hits of a query
+    request_handler_.SearchByRangeAsync(
+        state->context_, search_request->table_name(), state->vectors_, ranges, request->radius(),
+        search_request->topk(), search_request->nprobe(), partitions, state->result_,
+        [this, context, search_request, response, state, done](const Status& status) {
+            // step 4: construct and return result
+            ConstructResults(search_request->table_name(), state->result_, response);
+            ReportQueryCost(search_request->table_name(), *state->context_, context);
+
+            SET_RESPONSE(response->mutable_status(), status, context);
+            done(GrpcStatus(status));
+        });
 }
 
 ::grpc::Status
 GrpcRequestHandler::SearchInFiles(::grpc::ServerContext* context, const ::milvus::grpc::SearchInFilesParam* request,
                                   ::milvus::grpc::TopKQueryResult* response) {
-    CHECK_NULLPTR_RETURN(request);
+    return WaitCall([&](const GrpcCallback& done) { SearchInFilesAsync(context, request, response, done); });
+}
+
+void
+GrpcRequestHandler::SearchInFilesAsync(::grpc::ServerContext* context,
+                                       const ::milvus::grpc::SearchInFilesParam* request,
+                                       ::milvus::grpc::TopKQueryResult* response, const GrpcCallback& done) {
+    if (nullptr == request) {
+        done(::grpc::Status::OK);
+        return;
+    }
+
+    struct SearchState {
+        std::shared_ptr<Context> context_;
+        engine::VectorsData vectors_;
+        TopKQueryResult result_;
+    };
+    auto state = std::make_shared<SearchState>();
+    state->context_ = GetContext(context);
 
     auto* search_request = &request->search_param();
 
     // step 1: copy vector data
-    engine::VectorsData vectors;
-    CopyRowRecords(search_request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(),
-                   vectors);
+    auto status = CopyRowRecords(search_request->query_record_array(),
+                                 google::protobuf::RepeatedField<google::protobuf::int64>(), state->vectors_);
+    if (!status.ok()) {
+        SET_RESPONSE(response->mutable_status(), status, context);
+        done(GrpcStatus(status));
+        return;
+    }
 
     // deprecated
     std::vector<Range> ranges;
@@ -334,23 +840,17 @@ GrpcRequestHandler::SearchInFiles(::grpc::ServerContext* context, const ::milvus
     }
 
     // step 4: search vectors
-    TopKQueryResult result;
-    Status status =
-        request_handler_.Search(context_map_[context], search_request->table_name(), vectors, ranges,
-                                search_request->topk(), search_request->nprobe(), partitions, file_ids, result);
-
-    // step 5: construct and return result
-    response->set_row_num(result.row_num_);
-
-    response->mutable_ids()->Resize(static_cast<int>(result.id_list_.size()), 0);
-    memcpy(response->mutable_ids()->mutable_data(), result.id_list_.data(), result.id_list_.size() * sizeof(int64_t));
-
-    response->mutable_distances()->Resize(static_cast<int>(result.distance_list_.size()), 0.0);
-    memcpy(response->mutable_distances()->mutable_data(), result.distance_list_.data(),
-           result.distance_list_.size() * sizeof(float));
-    SET_RESPONSE(response->mutable_status(), status, context);
-
-    return ::grpc::Status::OK;
+    request_handler_.SearchAsync(state->context_, search_request->table_name(), state->vectors_, ranges,
+                                 search_request->topk(), search_request->nprobe(), partitions, file_ids,
+                                 state->result_,
+                                 [this, context, search_request, response, state, done](const Status& status) {
+                                     // step 5: construct and return result
+                                     ConstructResults(search_request->table_name(), state->result_, response);
+                                     ReportQueryCost(search_request->table_name(), *state->context_, context);
+
+                                     SET_RESPONSE(response->mutable_status(), status, context);
+                                     done(GrpcStatus(status));
+                                 });
 }
 
 ::grpc::Status
@@ -366,7 +866,7 @@ GrpcRequestHandler::DescribeTable(::grpc::ServerContext* context, const ::milvus
     response->set_metric_type(table_schema.metric_type_);
 
     SET_RESPONSE(response->mutable_status(), status, context);
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -378,7 +878,27 @@ GrpcRequestHandler::CountTable(::grpc::ServerContext* context, const ::milvus::g
     Status status = request_handler_.CountTable(context_map_[context], request->table_name(), row_count);
     response->set_table_row_count(row_count);
     SET_RESPONSE(response->mutable_status(), status, context);
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
+}
+
+::grpc::Status
+GrpcRequestHandler::GetVectorByID(::grpc::ServerContext* context, const ::milvus::grpc::VectorIdentity* request,
+                                  ::milvus::grpc::VectorData* response) {
+    CHECK_NULLPTR_RETURN(request);
+
+    engine::VectorsData vector;
+    Status status = request_handler_.GetVectorByID(context_map_[context], request->table_name(), request->id(), vector);
+
+    auto record = response->mutable_vector_data();
+    if (!vector.float_data_.empty()) {
+        record->mutable_float_data()->Resize(static_cast<int>(vector.float_data_.size()), 0.0f);
+        memcpy(record->mutable_float_data()->mutable_data(), vector.float_data_.data(),
+               vector.float_data_.size() * sizeof(float));
+    } else if (!vector.binary_data_.empty()) {
+        record->set_binary_data(vector.binary_data_.data(), vector.binary_data_.size());
+    }
+    SET_RESPONSE(response->mutable_status(), status, context);
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -393,7 +913,7 @@ GrpcRequestHandler::ShowTables(::grpc::ServerContext* context, const ::milvus::g
     }
     SET_RESPONSE(response->mutable_status(), status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -406,7 +926,7 @@ GrpcRequestHandler::Cmd(::grpc::ServerContext* context, const ::milvus::grpc::Co
     response->set_string_reply(reply);
     SET_RESPONSE(response->mutable_status(), status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -418,7 +938,7 @@ GrpcRequestHandler::DeleteByDate(::grpc::ServerContext* context, const ::milvus:
     Status status = request_handler_.DeleteByRange(context_map_[context], request->table_name(), range);
     SET_RESPONSE(response, status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -429,7 +949,7 @@ GrpcRequestHandler::PreloadTable(::grpc::ServerContext* context, const ::milvus:
     Status status = request_handler_.PreloadTable(context_map_[context], request->table_name());
     SET_RESPONSE(response, status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -442,9 +962,11 @@ GrpcRequestHandler::DescribeIndex(::grpc::ServerContext* context, const ::milvus
     response->set_table_name(param.table_name_);
     response->mutable_index()->set_index_type(param.index_type_);
     response->mutable_index()->set_nlist(param.nlist_);
+    response->set_indexed_row_count(param.indexed_row_count_);
+    response->set_total_row_count(param.total_row_count_);
     SET_RESPONSE(response->mutable_status(), status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -455,7 +977,7 @@ GrpcRequestHandler::DropIndex(::grpc::ServerContext* context, const ::milvus::gr
     Status status = request_handler_.DropIndex(context_map_[context], request->table_name());
     SET_RESPONSE(response, status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -467,7 +989,7 @@ GrpcRequestHandler::CreatePartition(::grpc::ServerContext* context, const ::milv
                                                      request->partition_name(), request->tag());
     SET_RESPONSE(response, status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -486,7 +1008,7 @@ GrpcRequestHandler::ShowPartitions(::grpc::ServerContext* context, const ::milvu
 
     SET_RESPONSE(response->mutable_status(), status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 ::grpc::Status
@@ -498,7 +1020,7 @@ GrpcRequestHandler::DropPartition(::grpc::ServerContext* context, const ::milvus
                                                    request->partition_name(), request->tag());
     SET_RESPONSE(response, status, context);
 
-    return ::grpc::Status::OK;
+    return GrpcStatus(status);
 }
 
 }  // namespace grpc
@@ -14,6 +14,7 @@
 #include <server/context/Context.h>
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <random>
@@ -56,6 +57,12 @@ namespace grpc {
 ::milvus::grpc::ErrorCode
 ErrorMap(ErrorCode code);
 
+// called once the response of a call is filled, maybe on another thread than the one taking the call
+using GrpcCallback = std::function<void(const ::grpc::Status&)>;
+// write one chunk of a stream, the chunk is kept until written is called
+using GrpcChunkWriter =
+    std::function<void(const ::milvus::grpc::TopKQueryResult& chunk, const GrpcCallback& written)>;
+
 class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service, public GrpcInterceptorHookHandler {
  public:
     explicit GrpcRequestHandler(const std::shared_ptr<opentracing::Tracer>& tracer);
@@ -74,9 +81,18 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     void
     SetContext(::grpc::ServerContext* server_context, const std::shared_ptr<Context>& context);
 
+    // the client cancelled the call, requests of the call stop as soon as they see it
+    void
+    CancelContext(::grpc::ServerContext* server_context);
+
     uint64_t
     random_id() const;
 
+    // head sampling: a call carrying a trace context of the client is always traced, the others are traced
+    // at this rate, an unsampled call starts no span beyond one no-op span
+    void
+    SetSampleRate(double rate);
+
     // *
     // @brief This method is used to create table
     //
@@ -114,6 +130,15 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     CountTable(::grpc::ServerContext* context, const ::milvus::grpc::TableName* request,
                ::milvus::grpc::TableRowCount* response) override;
     // *
+    // @brief This method is used to get vector data by id, buffered vectors are flushed first.
+    //
+    // @param VectorIdentity, target vector id.
+    //
+    // @return VectorData
+    ::grpc::Status
+    GetVectorByID(::grpc::ServerContext* context, const ::milvus::grpc::VectorIdentity* request,
+                  ::milvus::grpc::VectorData* response) override;
+    // *
     // @brief This method is used to list all tables.
     //
     // @param Command, dummy parameter.
@@ -194,6 +219,11 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     ::grpc::Status
     Insert(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
            ::milvus::grpc::VectorIds* response) override;
+
+    // same as Insert but return once the request is queued, the request and response are kept until done
+    void
+    InsertAsync(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                ::milvus::grpc::VectorIds* response, const GrpcCallback& done);
     // *
     // @brief This method is used to query vector in table.
     //
@@ -204,6 +234,11 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     Search(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
            ::milvus::grpc::TopKQueryResult* response) override;
 
+    // same as Search but return once the request is queued, the request and response are kept until done
+    void
+    SearchAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                ::milvus::grpc::TopKQueryResult* response, const GrpcCallback& done);
+
     // *
     // @brief This method is used to query vector in specified files.
     //
@@ -214,6 +249,11 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     SearchInFiles(::grpc::ServerContext* context, const ::milvus::grpc::SearchInFilesParam* request,
                   ::milvus::grpc::TopKQueryResult* response) override;
 
+    // same as SearchInFiles but return once the request is queued, the request and response are kept until done
+    void
+    SearchInFilesAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchInFilesParam* request,
+                       ::milvus::grpc::TopKQueryResult* response, const GrpcCallback& done);
+
     // *
     // @brief This method is used to give the server status.
     //
@@ -241,6 +281,77 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     ::grpc::Status
     PreloadTable(::grpc::ServerContext* context, const ::milvus::grpc::TableName* request,
                  ::milvus::grpc::Status* response) override;
+    // *
+    // @brief This method is used to add vector arrays to table as a stream,
+    //        each message is inserted as it arrives and waits while the insert buffer is full.
+    //
+    // @param InsertParam, insert parameters of one chunk, every chunk must target the same table.
+    //
+    // @return VectorIds, ids of all chunks in arrival order.
+    ::grpc::Status
+    InsertStream(::grpc::ServerContext* context, ::grpc::ServerReader<::milvus::grpc::InsertParam>* reader,
+                 ::milvus::grpc::VectorIds* response) override;
+
+    // insert one chunk of a stream into table_name and append its ids to the response, the status of the response
+    // is that of the chunk, so the stream stops at the first failed chunk with the ids of those before it
+    void
+    InsertChunkAsync(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* chunk,
+                     const std::string& table_name, ::milvus::grpc::VectorIds* response, const GrpcCallback& done);
+
+    // *
+    // @brief This method is used to load vector arrays to table as a stream, bypassing the insert buffer,
+    //        chunks are gathered into batches, and each batch is written as table files in parallel.
+    //
+    // @param InsertParam, insert parameters of one chunk, every chunk must target the same table and partition.
+    //
+    // @return VectorIds, ids of all chunks in arrival order.
+    ::grpc::Status
+    BulkInsert(::grpc::ServerContext* context, ::grpc::ServerReader<::milvus::grpc::InsertParam>* reader,
+               ::milvus::grpc::VectorIds* response) override;
+
+    // the batch of a bulk insert stream, created by its first chunk
+    struct BulkInsertState;
+    using BulkInsertStatePtr = std::shared_ptr<BulkInsertState>;
+
+    // gather one chunk of a bulk insert stream into the batch of state, a full batch, or the rest on a nullptr chunk
+    // which ends the stream, is loaded and its ids appended to the response, the status of the response is that of
+    // the chunk or the batch, so the stream stops at the first failure with the ids of the batches loaded before it
+    void
+    BulkInsertChunkAsync(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* chunk,
+                         BulkInsertStatePtr& state, ::milvus::grpc::VectorIds* response, const GrpcCallback& done);
+
+    // *
+    // @brief This method is used to query vector in table as a stream,
+    //        the result of each chunk of query records is returned once its reduce is done.
+    //
+    // @param SearchParam, search parameters.
+    //
+    // @return TopKQueryResult, result of one chunk of query records in request order.
+    ::grpc::Status
+    SearchStream(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                 ::grpc::ServerWriter<::milvus::grpc::TopKQueryResult>* writer) override;
+
+    // same as SearchStream but return once the first chunk is queued, the next chunk is searched once the result of
+    // the last one is written, a chunk that fails is written with its status and ends the stream
+    void
+    SearchStreamAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                      const GrpcChunkWriter& write, const GrpcCallback& done);
+
+    // *
+    // @brief This method is used to query vectors within a radius of the query records,
+    //        hits of a query are nearest first and padded with id -1 up to topk, tables of IDMAP and IVF indexes only.
+    //
+    // @param RangeSearchParam, search parameters and radius.
+    //
+    // @return TopKQueryResult
+    ::grpc::Status
+    SearchByRange(::grpc::ServerContext* context, const ::milvus::grpc::RangeSearchParam* request,
+                  ::milvus::grpc::TopKQueryResult* response) override;
+
+    // same as SearchByRange but return once the request is queued, the request and response are kept until done
+    void
+    SearchByRangeAsync(::grpc::ServerContext* context, const ::milvus::grpc::RangeSearchParam* request,
+                       ::milvus::grpc::TopKQueryResult* response, const GrpcCallback& done);
 
     GrpcRequestHandler&
     RegisterRequestHandler(const RequestHandler& handler) {
@@ -248,10 +359,17 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     }
 
  private:
+    struct SearchStreamState;
+
+    void
+    SearchStreamChunk(const std::shared_ptr<SearchStreamState>& state);
+
     RequestHandler request_handler_;
 
     std::unordered_map<::grpc::ServerContext*, std::shared_ptr<Context>> context_map_;
     std::shared_ptr<opentracing::Tracer> tracer_;
+    std::shared_ptr<opentracing::Tracer> noop_tracer_;
+    double sample_rate_ = 1.0;
     //    std::unordered_map<::grpc::ServerContext*, std::unique_ptr<opentracing::Span>> span_map_;
 
     mutable std::mt19937_64 random_num_generator_;
@@ -21,12 +21,14 @@
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -35,13 +37,26 @@
 #include "server/Config.h"
 #include "server/DBWrapper.h"
 #include "server/grpc_impl/interceptor/SpanInterceptor.h"
+#include "tracing/TracerUtil.h"
 #include "utils/Log.h"
+#include "utils/ThreadPool.h"
 
 namespace milvus {
 namespace server {
 namespace grpc {
 
-constexpr int64_t MESSAGE_SIZE = -1;
+constexpr int64_t NO_MESSAGE_SIZE_LIMIT = -1;
+constexpr int64_t MB = 1024 * 1024;
+
+// each polling thread has its own completion queue, they only take calls and hand them off, never wait
+constexpr int64_t POLL_THREAD_NUM = 4;
+
+// threads running the calls which still wait for their request, search and insert don't take one
+constexpr int64_t CALL_THREAD_NUM = 32;
+// calls waiting for a whole index build or load run apart, so they never hold all call threads
+constexpr int64_t SLOW_CALL_THREAD_NUM = 8;
+// calls queued for the call threads, more are rejected instead of blocking the polling thread
+constexpr int64_t CALL_QUEUE_SIZE = 1024;
 
 // this class is to check port occupation during server start
 class NoReusePortOption : public ::grpc::ServerBuilderOption {
@@ -49,7 +64,7 @@ class NoReusePortOption : public ::grpc::ServerBuilderOption {
     void
     UpdateArguments(::grpc::ChannelArguments* args) override {
         args->SetInt(GRPC_ARG_ALLOW_REUSEPORT, 0);
-        args->SetInt(GRPC_ARG_MAX_CONCURRENT_STREAMS, 20);
+        args->SetInt(GRPC_ARG_MAX_CONCURRENT_STREAMS, 1024);
     }
 
     void
@@ -57,6 +72,437 @@ class NoReusePortOption : public ::grpc::ServerBuilderOption {
     }
 };
 
+namespace {
+
+grpc_compression_level
+ToCompressionLevel(const std::string& level) {
+    static const std::unordered_map<std::string, grpc_compression_level> levels = {
+        {"none", GRPC_COMPRESS_LEVEL_NONE},
+        {"low", GRPC_COMPRESS_LEVEL_LOW},
+        {"medium", GRPC_COMPRESS_LEVEL_MED},
+        {"high", GRPC_COMPRESS_LEVEL_HIGH},
+    };
+    auto iter = levels.find(level);
+    return iter == levels.end() ? GRPC_COMPRESS_LEVEL_NONE : iter->second;
+}
+
+using AsyncService = ::milvus::grpc::MilvusService::AsyncService;
+
+// tag of a call on the completion queue
+class AsyncCall {
+ public:
+    virtual ~AsyncCall() = default;
+
+    // an event of the call completes, on the polling thread of its queue
+    virtual void
+    Proceed(bool ok) = 0;
+};
+
+// a unary call waits for the next call of its method, and deletes itself once the response is sent and
+// the call is done, a call cancelled by the client is told to the handler so its requests stop early
+template <typename Request, typename Response>
+class AsyncUnaryCall : public AsyncCall {
+ public:
+    using RequestMethod = void (AsyncService::*)(::grpc::ServerContext*, Request*,
+                                                 ::grpc::ServerAsyncResponseWriter<Response>*, ::grpc::CompletionQueue*,
+                                                 ::grpc::ServerCompletionQueue*, void*);
+    using Handler = std::function<void(::grpc::ServerContext*, const Request*, Response*, const GrpcCallback&)>;
+
+    AsyncUnaryCall(AsyncService* service, ::grpc::ServerCompletionQueue* cq, RequestMethod method,
+                   const Handler& handler, GrpcRequestHandler* request_handler)
+        : service_(service),
+          cq_(cq),
+          method_(method),
+          handler_(handler),
+          request_handler_(request_handler),
+          responder_(&context_),
+          done_event_(this) {
+        context_.AsyncNotifyWhenDone(&done_event_);
+        (service_->*method_)(&context_, &request_, &responder_, cq_, cq_, this);
+    }
+
+    void
+    Proceed(bool ok) override {
+        if (started_) {
+            // the response is sent
+            Release();
+            return;
+        }
+
+        // not ok before a call comes in means the queue is shutting down, the done event never comes then
+        if (!ok) {
+            delete this;
+            return;
+        }
+
+        started_ = true;
+        new AsyncUnaryCall(service_, cq_, method_, handler_, request_handler_);
+
+        // the response may be sent and this deleted before the handler returns
+        auto handler = handler_;
+        handler(&context_, &request_, &response_,
+                [this](const ::grpc::Status& status) { responder_.Finish(response_, status, this); });
+    }
+
+ private:
+    // the call is done, either the response is sent or the client cancelled it
+    class DoneEvent : public AsyncCall {
+     public:
+        explicit DoneEvent(AsyncUnaryCall* call) : call_(call) {
+        }
+
+        void
+        Proceed(bool ok) override {
+            if (call_->context_.IsCancelled()) {
+                call_->request_handler_->CancelContext(&call_->context_);
+            }
+            call_->Release();
+        }
+
+     private:
+        AsyncUnaryCall* call_;
+    };
+
+    void
+    Release() {
+        if (--pending_events_ == 0) {
+            delete this;
+        }
+    }
+
+    AsyncService* service_;
+    ::grpc::ServerCompletionQueue* cq_;
+    RequestMethod method_;
+    Handler handler_;
+    GrpcRequestHandler* request_handler_;
+
+    ::grpc::ServerContext context_;
+    Request request_;
+    Response response_;
+    ::grpc::ServerAsyncResponseWriter<Response> responder_;
+    DoneEvent done_event_;
+    bool started_ = false;
+    // the response sent and the call done, in any order
+    std::atomic<int> pending_events_{2};
+};
+
+template <typename Request, typename Response>
+void
+Listen(AsyncService* service, ::grpc::ServerCompletionQueue* cq,
+       typename AsyncUnaryCall<Request, Response>::RequestMethod method,
+       const typename AsyncUnaryCall<Request, Response>::Handler& handler, GrpcRequestHandler* request_handler) {
+    new AsyncUnaryCall<Request, Response>(service, cq, method, handler, request_handler);
+}
+
+// an insert stream reads its next chunk once the last one is inserted, so while the insert buffer is full the
+// chunks stay with the client under flow control, it deletes itself like a unary call,
+// a bulk insert stream is served alike, except that its chunks are gathered and loaded by batches
+class AsyncInsertStreamCall : public AsyncCall {
+ public:
+    AsyncInsertStreamCall(AsyncService* service, ::grpc::ServerCompletionQueue* cq, GrpcRequestHandler* handler,
+                          bool bulk)
+        : service_(service), cq_(cq), handler_(handler), bulk_(bulk), reader_(&context_), done_event_(this) {
+        context_.AsyncNotifyWhenDone(&done_event_);
+        if (bulk_) {
+            service_->RequestBulkInsert(&context_, &reader_, cq_, cq_, this);
+        } else {
+            service_->RequestInsertStream(&context_, &reader_, cq_, cq_, this);
+        }
+    }
+
+    void
+    Proceed(bool ok) override {
+        switch (state_) {
+            case State::WAIT_CALL:
+                // not ok before a call comes in means the queue is shutting down, the done event never comes then
+                if (!ok) {
+                    delete this;
+                    return;
+                }
+                new AsyncInsertStreamCall(service_, cq_, handler_, bulk_);
+                ReadChunk();
+                break;
+            case State::READ:
+                if (!ok) {
+                    // the client is done writing, or the call is broken and the finish fails alike,
+                    // a bulk insert loads the rest of its last batch before
+                    if (bulk_) {
+                        handler_->BulkInsertChunkAsync(&context_, nullptr, bulk_state_, &response_,
+                                                       [this](const ::grpc::Status& status) { Finish(status); });
+                    } else {
+                        Finish(::grpc::Status::OK);
+                    }
+                    break;
+                }
+                InsertChunk([this](const ::grpc::Status& status) {
+                    if (!status.ok() || response_.status().error_code() != ::milvus::grpc::ErrorCode::SUCCESS) {
+                        Finish(status);
+                    } else {
+                        ReadChunk();
+                    }
+                });
+                break;
+            case State::FINISH:
+                // the response is sent
+                Release();
+                break;
+        }
+    }
+
+ private:
+    enum class State { WAIT_CALL, READ, FINISH };
+
+    // the call is done, either the response is sent or the client cancelled it
+    class DoneEvent : public AsyncCall {
+     public:
+        explicit DoneEvent(AsyncInsertStreamCall* call) : call_(call) {
+        }
+
+        void
+        Proceed(bool ok) override {
+            if (call_->context_.IsCancelled()) {
+                call_->handler_->CancelContext(&call_->context_);
+            }
+            call_->Release();
+        }
+
+     private:
+        AsyncInsertStreamCall* call_;
+    };
+
+    void
+    ReadChunk() {
+        state_ = State::READ;
+        reader_.Read(&chunk_, this);
+    }
+
+    void
+    InsertChunk(const GrpcCallback& done) {
+        if (bulk_) {
+            handler_->BulkInsertChunkAsync(&context_, &chunk_, bulk_state_, &response_, done);
+            return;
+        }
+        if (table_name_.empty()) {
+            table_name_ = chunk_.table_name();
+        }
+        handler_->InsertChunkAsync(&context_, &chunk_, table_name_, &response_, done);
+    }
+
+    void
+    Finish(const ::grpc::Status& status) {
+        state_ = State::FINISH;
+        reader_.Finish(response_, status, this);
+    }
+
+    void
+    Release() {
+        if (--pending_events_ == 0) {
+            delete this;
+        }
+    }
+
+    AsyncService* service_;
+    ::grpc::ServerCompletionQueue* cq_;
+    GrpcRequestHandler* handler_;
+    bool bulk_;
+
+    ::grpc::ServerContext context_;
+    ::milvus::grpc::InsertParam chunk_;
+    ::milvus::grpc::VectorIds response_;
+    ::grpc::ServerAsyncReader<::milvus::grpc::VectorIds, ::milvus::grpc::InsertParam> reader_;
+    DoneEvent done_event_;
+    State state_ = State::WAIT_CALL;
+    std::string table_name_;
+    GrpcRequestHandler::BulkInsertStatePtr bulk_state_;
+    // the response sent and the call done, in any order
+    std::atomic<int> pending_events_{2};
+};
+
+// a search stream searches its next chunk of queries once the result of the last one is written, so a slow client
+// holds back the search rather than the results piling up on the server, it deletes itself like a unary call
+class AsyncSearchStreamCall : public AsyncCall {
+ public:
+    AsyncSearchStreamCall(AsyncService* service, ::grpc::ServerCompletionQueue* cq, GrpcRequestHandler* handler)
+        : service_(service), cq_(cq), handler_(handler), writer_(&context_), done_event_(this) {
+        context_.AsyncNotifyWhenDone(&done_event_);
+        service_->RequestSearchStream(&context_, &request_, &writer_, cq_, cq_, this);
+    }
+
+    void
+    Proceed(bool ok) override {
+        switch (state_) {
+            case State::WAIT_CALL:
+                // not ok before a call comes in means the queue is shutting down, the done event never comes then
+                if (!ok) {
+                    delete this;
+                    return;
+                }
+                new AsyncSearchStreamCall(service_, cq_, handler_);
+                state_ = State::SEARCH;
+                handler_->SearchStreamAsync(
+                    &context_, &request_,
+                    [this](const ::milvus::grpc::TopKQueryResult& chunk, const GrpcCallback& written) {
+                        state_ = State::WRITE;
+                        written_ = written;
+                        writer_.Write(chunk, this);
+                    },
+                    [this](const ::grpc::Status& status) {
+                        state_ = State::FINISH;
+                        writer_.Finish(status, this);
+                    });
+                break;
+            case State::WRITE: {
+                // a failed write means the call is broken, the search stops there
+                state_ = State::SEARCH;
+                GrpcCallback written;
+                written.swap(written_);
+                written(ok ? ::grpc::Status::OK : ::grpc::Status::CANCELLED);
+                break;
+            }
+            case State::SEARCH:
+                // no event is pending while a chunk is searched
+                break;
+            case State::FINISH:
+                // the last status is sent
+                Release();
+                break;
+        }
+    }
+
+ private:
+    enum class State { WAIT_CALL, SEARCH, WRITE, FINISH };
+
+    // the call is done, either the last status is sent or the client cancelled it
+    class DoneEvent : public AsyncCall {
+     public:
+        explicit DoneEvent(AsyncSearchStreamCall* call) : call_(call) {
+        }
+
+        void
+        Proceed(bool ok) override {
+            if (call_->context_.IsCancelled()) {
+                call_->handler_->CancelContext(&call_->context_);
+            }
+            call_->Release();
+        }
+
+     private:
+        AsyncSearchStreamCall* call_;
+    };
+
+    void
+    Release() {
+        if (--pending_events_ == 0) {
+            delete this;
+        }
+    }
+
+    AsyncService* service_;
+    ::grpc::ServerCompletionQueue* cq_;
+    GrpcRequestHandler* handler_;
+
+    ::grpc::ServerContext context_;
+    ::milvus::grpc::SearchParam request_;
+    ::grpc::ServerAsyncWriter<::milvus::grpc::TopKQueryResult> writer_;
+    DoneEvent done_event_;
+    State state_ = State::WAIT_CALL;
+    GrpcCallback written_;
+    // the last status sent and the call done, in any order
+    std::atomic<int> pending_events_{2};
+};
+
+// a call handled by a method waiting for its request runs on the call threads, the polling thread never waits for
+// them, a call finding the queue full is told to retry
+template <typename Request, typename Response>
+void
+ListenOnPool(AsyncService* service, ::grpc::ServerCompletionQueue* cq,
+             typename AsyncUnaryCall<Request, Response>::RequestMethod method, GrpcRequestHandler* handler,
+             ::grpc::Status (GrpcRequestHandler::*handle)(::grpc::ServerContext*, const Request*, Response*),
+             ThreadPool* pool) {
+    Listen<Request, Response>(service, cq, method,
+                              [handler, handle, pool](::grpc::ServerContext* context, const Request* request,
+                                                      Response* response, const GrpcCallback& done) {
+                                  auto task = [handler, handle, context, request, response, done]() {
+                                      done((handler->*handle)(context, request, response));
+                                  };
+                                  if (!pool->try_enqueue(task)) {
+                                      done(::grpc::Status(::grpc::StatusCode::RESOURCE_EXHAUSTED,
+                                                          "Too many calls in queue, retry later"));
+                                  }
+                              },
+                              handler);
+}
+
+void
+ListenAll(AsyncService* service, ::grpc::ServerCompletionQueue* cq, GrpcRequestHandler* handler, ThreadPool* pool,
+          ThreadPool* slow_pool) {
+    using ::milvus::grpc::InsertParam;
+    using ::milvus::grpc::RangeSearchParam;
+    using ::milvus::grpc::SearchInFilesParam;
+    using ::milvus::grpc::SearchParam;
+    using ::milvus::grpc::VectorIds;
+    using GrpcTopKQueryResult = ::milvus::grpc::TopKQueryResult;
+
+    Listen<InsertParam, VectorIds>(
+        service, cq, &AsyncService::RequestInsert,
+        [handler](::grpc::ServerContext* context, const InsertParam* request, VectorIds* response,
+                  const GrpcCallback& done) { handler->InsertAsync(context, request, response, done); },
+        handler);
+    Listen<SearchParam, GrpcTopKQueryResult>(
+        service, cq, &AsyncService::RequestSearch,
+        [handler](::grpc::ServerContext* context, const SearchParam* request, GrpcTopKQueryResult* response,
+                  const GrpcCallback& done) { handler->SearchAsync(context, request, response, done); },
+        handler);
+    Listen<SearchInFilesParam, GrpcTopKQueryResult>(
+        service, cq, &AsyncService::RequestSearchInFiles,
+        [handler](::grpc::ServerContext* context, const SearchInFilesParam* request, GrpcTopKQueryResult* response,
+                  const GrpcCallback& done) { handler->SearchInFilesAsync(context, request, response, done); },
+        handler);
+    Listen<RangeSearchParam, GrpcTopKQueryResult>(
+        service, cq, &AsyncService::RequestSearchByRange,
+        [handler](::grpc::ServerContext* context, const RangeSearchParam* request, GrpcTopKQueryResult* response,
+                  const GrpcCallback& done) { handler->SearchByRangeAsync(context, request, response, done); },
+        handler);
+    new AsyncInsertStreamCall(service, cq, handler, false);
+    new AsyncInsertStreamCall(service, cq, handler, true);
+    new AsyncSearchStreamCall(service, cq, handler);
+
+    ListenOnPool(service, cq, &AsyncService::RequestCreateTable, handler, &GrpcRequestHandler::CreateTable, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestHasTable, handler, &GrpcRequestHandler::HasTable, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestDescribeTable, handler, &GrpcRequestHandler::DescribeTable,
+                 pool);
+    ListenOnPool(service, cq, &AsyncService::RequestCountTable, handler, &GrpcRequestHandler::CountTable, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestGetVectorByID, handler, &GrpcRequestHandler::GetVectorByID, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestShowTables, handler, &GrpcRequestHandler::ShowTables, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestDropTable, handler, &GrpcRequestHandler::DropTable, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestCreateIndex, handler, &GrpcRequestHandler::CreateIndex,
+                 slow_pool);
+    ListenOnPool(service, cq, &AsyncService::RequestDescribeIndex, handler, &GrpcRequestHandler::DescribeIndex,
+                 pool);
+    ListenOnPool(service, cq, &AsyncService::RequestDropIndex, handler, &GrpcRequestHandler::DropIndex, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestCreatePartition, handler, &GrpcRequestHandler::CreatePartition,
+                 pool);
+    ListenOnPool(service, cq, &AsyncService::RequestShowPartitions, handler, &GrpcRequestHandler::ShowPartitions,
+                 pool);
+    ListenOnPool(service, cq, &AsyncService::RequestDropPartition, handler, &GrpcRequestHandler::DropPartition,
+                 pool);
+    ListenOnPool(service, cq, &AsyncService::RequestCmd, handler, &GrpcRequestHandler::Cmd, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestDeleteByDate, handler, &GrpcRequestHandler::DeleteByDate, pool);
+    ListenOnPool(service, cq, &AsyncService::RequestPreloadTable, handler, &GrpcRequestHandler::PreloadTable,
+                 slow_pool);
+}
+
+void
+Poll(::grpc::ServerCompletionQueue* cq) {
+    void* tag = nullptr;
+    bool ok = false;
+    while (cq->Next(&tag, &ok)) {
+        static_cast<AsyncCall*>(tag)->Proceed(ok);
+    }
+}
+
+}  // namespace
+
 void
 GrpcServer::Start() {
     thread_ptr_ = std::make_shared<std::thread>(&GrpcServer::StartService, this);
@@ -86,35 +532,95 @@ GrpcServer::StartService() {
         return s;
     }
 
+    std::string compression_level;
+    s = config.GetServerConfigGrpcCompressionLevel(compression_level);
+    if (!s.ok()) {
+        return s;
+    }
+    int64_t max_message_size, window_size;
+    s = config.GetServerConfigGrpcMaxMessageSize(max_message_size);
+    if (!s.ok()) {
+        return s;
+    }
+    s = config.GetServerConfigGrpcWindowSize(window_size);
+    if (!s.ok()) {
+        return s;
+    }
+    float sample_rate;
+    s = config.GetTracingConfigSampleRate(sample_rate);
+    if (!s.ok()) {
+        return s;
+    }
+
     std::string server_address(address + ":" + port);
 
     ::grpc::ServerBuilder builder;
     builder.SetOption(std::unique_ptr<::grpc::ServerBuilderOption>(new NoReusePortOption));
-    builder.SetMaxReceiveMessageSize(MESSAGE_SIZE);  // default 4 * 1024 * 1024
-    builder.SetMaxSendMessageSize(MESSAGE_SIZE);
+    int64_t message_size = (max_message_size > 0) ? max_message_size * MB : NO_MESSAGE_SIZE_LIMIT;
+    builder.SetMaxReceiveMessageSize(message_size);  // default 4 * 1024 * 1024
+    builder.SetMaxSendMessageSize(message_size);
+    if (window_size > 0) {
+        builder.AddChannelArgument(GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES, static_cast<int>(window_size * MB));
+    }
 
+    // the level is mapped to an algorithm among those the client accepts, so each channel negotiates its own
+    builder.SetCompressionAlgorithmSupportStatus(GRPC_COMPRESS_GZIP, true);
+    builder.SetCompressionAlgorithmSupportStatus(GRPC_COMPRESS_DEFLATE, true);
     builder.SetCompressionAlgorithmSupportStatus(GRPC_COMPRESS_STREAM_GZIP, true);
-    builder.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_STREAM_GZIP);
-    builder.SetDefaultCompressionLevel(GRPC_COMPRESS_LEVEL_NONE);
+    builder.SetDefaultCompressionLevel(ToCompressionLevel(compression_level));
 
-    GrpcRequestHandler service(opentracing::Tracer::Global());
-    service.RegisterRequestHandler(RequestHandler());
+    // the handler is not registered, it serves the calls taken by the async service
+    GrpcRequestHandler handler(opentracing::Tracer::Global());
+    handler.RegisterRequestHandler(RequestHandler());
+    // without a loaded tracer every span is a no-op, none of them is worth starting
+    handler.SetSampleRate(tracing::TracerUtil::IsTracerLoaded() ? sample_rate : 0.0);
+    AsyncService service;
 
     builder.AddListeningPort(server_address, ::grpc::InsecureServerCredentials());
     builder.RegisterService(&service);
 
+    std::vector<std::unique_ptr<::grpc::ServerCompletionQueue>> cqs;
+    for (int64_t i = 0; i < POLL_THREAD_NUM; ++i) {
+        cqs.emplace_back(builder.AddCompletionQueue());
+    }
+
     // Add gRPC interceptor
     using InterceptorI = ::grpc::experimental::ServerInterceptorFactoryInterface;
     using InterceptorIPtr = std::unique_ptr<InterceptorI>;
     std::vector<InterceptorIPtr> creators;
 
     creators.push_back(
-        std::unique_ptr<::grpc::experimental::ServerInterceptorFactoryInterface>(new SpanInterceptorFactory(&service)));
+        std::unique_ptr<::grpc::experimental::ServerInterceptorFactoryInterface>(new SpanInterceptorFactory(&handler)));
 
     builder.experimental().SetInterceptorCreators(std::move(creators));
 
     server_ptr_ = builder.BuildAndStart();
-    server_ptr_->Wait();
+    std::vector<std::thread> poll_threads;
+    if (server_ptr_ != nullptr) {
+        ThreadPool pool(CALL_THREAD_NUM, CALL_QUEUE_SIZE);
+        ThreadPool slow_pool(SLOW_CALL_THREAD_NUM, CALL_QUEUE_SIZE);
+        for (auto& cq : cqs) {
+            ListenAll(&service, cq.get(), &handler, &pool, &slow_pool);
+            poll_threads.emplace_back(Poll, cq.get());
+        }
+
+        // shutdown returns after the calls in flight are done, their responses are sent by the polling threads
+        server_ptr_->Wait();
+    }
+
+    // a queue is drained before it is destroyed, the calls still waiting are deleted then
+    for (auto& cq : cqs) {
+        cq->Shutdown();
+    }
+    for (auto& thread : poll_threads) {
+        thread.join();
+    }
+    if (poll_threads.empty()) {
+        for (auto& cq : cqs) {
+            Poll(cq.get());
+        }
+        return Status(SERVER_UNEXPECTED_ERROR, "Failed to start grpc server at " + server_address);
+    }
 
     return Status::OK();
 }
@@ -0,0 +1,185 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "server/grpc_impl/QueryCapture.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "server/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+namespace {
+// requests waiting to be written, more are dropped
+constexpr size_t QUERY_CAPTURE_QUEUE_CAPACITY = 1024;
+
+void
+WriteLittleEndian(std::ofstream& file, uint64_t value, size_t bytes) {
+    char buf[sizeof(uint64_t)];
+    for (size_t i = 0; i < bytes; ++i) {
+        buf[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+    file.write(buf, bytes);
+}
+
+bool
+ReadLittleEndian(std::ifstream& file, uint64_t& value, size_t bytes) {
+    unsigned char buf[sizeof(uint64_t)];
+    if (!file.read(reinterpret_cast<char*>(buf), bytes)) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(buf[i]) << (8 * i);
+    }
+    return true;
+}
+}  // namespace
+
+Status
+QueryCapture::ReadFile(const std::string& path, std::vector<CaptureRecord>& records, int64_t& valid_size) {
+    records.clear();
+    valid_size = 0;
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return Status::OK();
+    }
+
+    // a file killed before its header is complete is empty too
+    char magic[QUERY_CAPTURE_MAGIC_SIZE];
+    if (!file.read(magic, QUERY_CAPTURE_MAGIC_SIZE)) {
+        return Status::OK();
+    }
+    if (memcmp(magic, QUERY_CAPTURE_MAGIC, QUERY_CAPTURE_MAGIC_SIZE) != 0) {
+        return Status(SERVER_UNEXPECTED_ERROR, path + " is not a query capture file");
+    }
+    valid_size = QUERY_CAPTURE_MAGIC_SIZE;
+
+    ::milvus::grpc::SearchParam param;
+    while (true) {
+        uint64_t arrival_us = 0, length = 0;
+        CaptureRecord record;
+        if (!ReadLittleEndian(file, arrival_us, sizeof(int64_t)) ||
+            !ReadLittleEndian(file, length, sizeof(uint32_t))) {
+            break;
+        }
+        record.arrival_us_ = static_cast<int64_t>(arrival_us);
+        record.message_.resize(length);
+        if (!file.read(&record.message_[0], length) || !param.ParseFromString(record.message_)) {
+            break;
+        }
+        valid_size += sizeof(int64_t) + sizeof(uint32_t) + length;
+        records.emplace_back(std::move(record));
+    }
+    return Status::OK();
+}
+
+void
+QueryCapture::Start() {
+    std::string path;
+    float rate = 0.0;
+    Config& config = Config::GetInstance();
+    config.GetServerConfigQueryCapturePath(path);
+    config.GetServerConfigQueryCaptureRate(rate);
+    if (path.empty() || rate <= 0.0 || thread_.joinable()) {
+        return;
+    }
+
+    // records are appended after those of the last run, a torn one it left behind is cut off first, or it would
+    // misalign all that follow
+    std::vector<CaptureRecord> records;
+    int64_t valid_size = 0;
+    auto status = ReadFile(path, records, valid_size);
+    if (!status.ok()) {
+        SERVER_LOG_ERROR << status.message() << ", query capture is disabled";
+        return;
+    }
+    if (::truncate(path.c_str(), valid_size) != 0 && errno != ENOENT) {
+        SERVER_LOG_ERROR << "Failed to truncate query capture file " << path << ": " << strerror(errno);
+        return;
+    }
+
+    file_.open(path, std::ios::binary | std::ios::app);
+    if (!file_.is_open()) {
+        SERVER_LOG_ERROR << "Failed to open query capture file: " << path;
+        return;
+    }
+    if (valid_size == 0) {
+        file_.write(QUERY_CAPTURE_MAGIC, QUERY_CAPTURE_MAGIC_SIZE);
+    }
+
+    queue_.SetCapacity(QUERY_CAPTURE_QUEUE_CAPACITY);
+    thread_ = std::thread(&QueryCapture::Run, this);
+    capture_interval_ = std::max<uint64_t>(1, std::llround(1.0 / rate));
+    SERVER_LOG_INFO << "Capture one of every " << capture_interval_ << " search requests to " << path;
+}
+
+void
+QueryCapture::Stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    capture_interval_ = 0;
+    queue_.Put(nullptr);
+    thread_.join();
+    file_.close();
+}
+
+void
+QueryCapture::Capture(const ::milvus::grpc::SearchParam& request) {
+    uint64_t interval = capture_interval_.load(std::memory_order_relaxed);
+    if (interval == 0 || (request_count_.fetch_add(1, std::memory_order_relaxed) % interval) != 0) {
+        return;
+    }
+
+    auto record = std::make_shared<CaptureRecord>();
+    record->arrival_us_ = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+    request.SerializeToString(&record->message_);
+    if (!queue_.TryPut(record)) {
+        SERVER_LOG_DEBUG << "Query capture is behind, a request of table " << request.table_name() << " is dropped";
+    }
+}
+
+void
+QueryCapture::Run() {
+    while (true) {
+        auto record = queue_.Take();
+        if (record == nullptr) {
+            break;
+        }
+
+        WriteLittleEndian(file_, static_cast<uint64_t>(record->arrival_us_), sizeof(int64_t));
+        WriteLittleEndian(file_, record->message_.size(), sizeof(uint32_t));
+        file_.write(record->message_.data(), record->message_.size());
+
+        // records are flushed once the burst is written, a killed server loses at most the last burst
+        if (queue_.Empty()) {
+            file_.flush();
+        }
+    }
+    file_.flush();
+}
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
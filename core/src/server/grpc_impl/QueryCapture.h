@@ -0,0 +1,84 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "grpc/gen-milvus/milvus.pb.h"
+#include "utils/BlockingQueue.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+// a sample of search requests is appended to a capture file, so real traffic can be replayed against a server
+// with another configuration. The file starts with QUERY_CAPTURE_MAGIC, then each record is a little endian
+// int64 of its arrival in microseconds since epoch, a little endian uint32 length and the SearchParam message
+// serialized in that many bytes.
+constexpr char QUERY_CAPTURE_MAGIC[] = "MVQCAP01";
+constexpr size_t QUERY_CAPTURE_MAGIC_SIZE = sizeof(QUERY_CAPTURE_MAGIC) - 1;
+
+class QueryCapture {
+ public:
+    struct CaptureRecord {
+        int64_t arrival_us_ = 0;
+        std::string message_;
+    };
+    using CaptureRecordPtr = std::shared_ptr<CaptureRecord>;
+
+    static QueryCapture&
+    GetInstance() {
+        static QueryCapture capture;
+        return capture;
+    }
+
+    // read the whole records of a capture file, valid_size is the offset the last of them ends at, a record torn
+    // by a killed server and anything after it are left out, a missing file is empty
+    static Status
+    ReadFile(const std::string& path, std::vector<CaptureRecord>& records, int64_t& valid_size);
+
+    void
+    Start();
+
+    void
+    Stop();
+
+    // sampling is a counter check, the request is serialized only when it is captured, and dropped if the
+    // writer is too far behind
+    void
+    Capture(const ::milvus::grpc::SearchParam& request);
+
+ private:
+    QueryCapture() = default;
+
+    void
+    Run();
+
+ private:
+    std::atomic<uint64_t> capture_interval_{0};
+    std::atomic<uint64_t> request_count_{0};
+    std::ofstream file_;
+    BlockingQueue<CaptureRecordPtr> queue_;
+    std::thread thread_;
+};
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
@@ -31,6 +31,9 @@ static const char* CORS_VALUE_HEADERS =
     "DNT, User-Agent, X-Requested-With, If-Modified-Since, Cache-Control, Content-Type, Range, Authorization";
 static const char* CORS_VALUE_AGE = "1728000";
 
+static const char* CONTENT_TYPE_JSON = "application/json";
+static const char* CONTENT_TYPE_OCTET_STREAM = "application/octet-stream";
+
 ////////////////////////////////////////////////////
 
 static const char* NAME_ENGINE_TYPE_FLAT = "FLAT";
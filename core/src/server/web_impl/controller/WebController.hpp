@@ -530,21 +530,35 @@ class WebController : public oatpp::web::server::api::ApiController {
         return createResponse(Status::CODE_204, "No Content");
     }
 
+    // packed vectors are sent as application/octet-stream, other bodies are json
+    static bool
+    IsOctetStream(const std::shared_ptr<IncomingRequest>& request) {
+        auto content_type = request->getHeader(Header::CONTENT_TYPE);
+        return nullptr != content_type.get() && 0 == content_type->std_str().find(CONTENT_TYPE_OCTET_STREAM);
+    }
+
     ADD_CORS(Insert)
 
     ENDPOINT("POST", "/tables/{table_name}/vectors", Insert,
-             PATH(String, table_name), BODY_DTO(InsertRequestDto::ObjectWrapper, body)) {
+             PATH(String, table_name), QUERIES(const QueryParams&, query_params),
+             REQUEST(std::shared_ptr<IncomingRequest>, request), BODY_STRING(String, body)) {
         TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "POST \'/tables/" + table_name->std_str() + "/vectors\'");
         tr.RecordSection("Received request.");
 
-        auto ids_dto = VectorIdsDto::createShared();
+        String ids_str;
         WebRequestHandler handler = WebRequestHandler();
 
         std::shared_ptr<OutgoingResponse> response;
-        auto status_dto = handler.Insert(table_name, body, ids_dto);
+        StatusDto::ObjectWrapper status_dto;
+        if (IsOctetStream(request)) {
+            status_dto = handler.InsertPacked(table_name, query_params, body, ids_str);
+        } else {
+            status_dto = handler.Insert(table_name, body, ids_str);
+        }
         switch (status_dto->code->getValue()) {
             case StatusCode::SUCCESS:
-                response = createDtoResponse(Status::CODE_201, ids_dto);
+                response = createResponse(Status::CODE_201, ids_str);
+                response->putHeader(Header::CONTENT_TYPE, CONTENT_TYPE_JSON);
                 break;
             case StatusCode::TABLE_NOT_EXISTS:
                 response = createDtoResponse(Status::CODE_404, status_dto);
@@ -562,18 +576,61 @@ class WebController : public oatpp::web::server::api::ApiController {
     ADD_CORS(Search)
 
     ENDPOINT("PUT", "/tables/{table_name}/vectors", Search,
-             PATH(String, table_name), BODY_DTO(SearchRequestDto::ObjectWrapper, body)) {
+             PATH(String, table_name), QUERIES(const QueryParams&, query_params),
+             REQUEST(std::shared_ptr<IncomingRequest>, request), BODY_STRING(String, body)) {
         TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "PUT \'/tables/" + table_name->std_str() + "/vectors\'");
         tr.RecordSection("Received request.");
 
-        auto results_dto = TopkResultsDto::createShared();
+        String results_str;
+        WebRequestHandler handler = WebRequestHandler();
+
+        std::shared_ptr<OutgoingResponse> response;
+        StatusDto::ObjectWrapper status_dto;
+        if (IsOctetStream(request)) {
+            status_dto = handler.SearchPacked(table_name, query_params, body, results_str);
+        } else {
+            status_dto = handler.Search(table_name, body, results_str);
+        }
+        switch (status_dto->code->getValue()) {
+            case StatusCode::SUCCESS:
+                response = createResponse(Status::CODE_200, results_str);
+                response->putHeader(Header::CONTENT_TYPE, CONTENT_TYPE_JSON);
+                break;
+            case StatusCode::TABLE_NOT_EXISTS:
+                response = createDtoResponse(Status::CODE_404, status_dto);
+                break;
+            default:
+                response = createDtoResponse(Status::CODE_400, status_dto);
+        }
+
+        tr.ElapseFromBegin("Done. Status: code = " + std::to_string(status_dto->code->getValue())
+                           + ", reason = " + status_dto->message->std_str() + ". Total cost");
+
+        return response;
+    }
+
+    ADD_CORS(SearchBatchOptions)
+
+    ENDPOINT("OPTIONS", "/tables/{table_name}/vectors/batch", SearchBatchOptions) {
+        return createResponse(Status::CODE_204, "No Content");
+    }
+
+    ADD_CORS(SearchBatch)
+
+    ENDPOINT("PUT", "/tables/{table_name}/vectors/batch", SearchBatch,
+             PATH(String, table_name), BODY_STRING(String, body)) {
+        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "PUT \'/tables/" + table_name->std_str() + "/vectors/batch\'");
+        tr.RecordSection("Received request.");
+
+        String results_str;
         WebRequestHandler handler = WebRequestHandler();
 
         std::shared_ptr<OutgoingResponse> response;
-        auto status_dto = handler.Search(table_name, body, results_dto);
+        auto status_dto = handler.SearchBatch(table_name, body, results_str);
         switch (status_dto->code->getValue()) {
             case StatusCode::SUCCESS:
-                response = createDtoResponse(Status::CODE_200, results_dto);
+                response = createResponse(Status::CODE_200, results_str);
+                response->putHeader(Header::CONTENT_TYPE, CONTENT_TYPE_JSON);
                 break;
             case StatusCode::TABLE_NOT_EXISTS:
                 response = createDtoResponse(Status::CODE_404, status_dto);
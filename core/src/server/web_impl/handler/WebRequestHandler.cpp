@@ -12,7 +12,9 @@
 #include "server/web_impl/handler/WebRequestHandler.h"
 
 #include <cmath>
+#include <cstring>
 #include <ctime>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -741,6 +743,271 @@ WebRequestHandler::Search(const OString& table_name, const SearchRequestDto::Obj
     ASSIGN_RETURN_STATUS_DTO(status)
 }
 
+StatusDto::ObjectWrapper
+WebRequestHandler::FillVectors(const OString& table_name, VectorsBody& body, engine::VectorsData& vectors) {
+    TableSchema schema;
+    auto status = request_handler_.DescribeTable(context_ptr_, table_name->std_str(), schema);
+    if (!status.ok()) {
+        ASSIGN_RETURN_STATUS_DTO(status)
+    }
+
+    bool bin_flag = ValidationUtil::IsBinaryMetricType(schema.metric_type_);
+    if (body.has_packed_records) {
+        // a float vector takes 4 bytes per dimension, a binary vector 1 bit
+        size_t row_size = bin_flag ? schema.dimension_ / 8 : schema.dimension_ * sizeof(float);
+        if (row_size == 0 || body.packed_records.size() % row_size != 0) {
+            RETURN_STATUS_DTO(ILLEGAL_DIMENSION, "Size of packed records doesn\'t match the table dimension");
+        }
+        vectors.vector_count_ = body.packed_records.size() / row_size;
+        if (bin_flag) {
+            vectors.binary_data_.swap(body.packed_records);
+        } else {
+            vectors.float_data_.resize(body.packed_records.size() / sizeof(float));
+            memcpy(vectors.float_data_.data(), body.packed_records.data(), body.packed_records.size());
+        }
+    } else if (!bin_flag) {
+        if (!body.has_records) {
+            RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Field \'records\' is required to fill vectors");
+        }
+        vectors.vector_count_ = body.record_count;
+        vectors.float_data_.swap(body.records);
+    } else {
+        if (!body.has_records_bin) {
+            RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Field \'records_bin\' is required to fill vectors");
+        }
+        vectors.vector_count_ = body.record_bin_count;
+        vectors.binary_data_.swap(body.records_bin);
+    }
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::InsertVectors(const OString& table_name, VectorsBody& body, OString& ids_str) {
+    engine::VectorsData vectors;
+    auto status_dto = FillVectors(table_name, body, vectors);
+    if (0 != status_dto->code->getValue()) {
+        return status_dto;
+    }
+    vectors.id_array_.swap(body.ids);
+    vectors.attrs_.swap(body.attrs);
+
+    auto status = request_handler_.Insert(context_ptr_, table_name->std_str(), vectors, body.tag);
+    if (status.ok()) {
+        std::string json;
+        WriteVectorIds(vectors.id_array_, json);
+        ids_str = json.c_str();
+    }
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::SearchVectors(const OString& table_name, VectorsBody& body, OString& results_str) {
+    if (!body.has_topk) {
+        RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Field \'topk\' is required in request body")
+    }
+    if (!body.has_nprobe) {
+        RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Field \'nprobe\' is required in request body")
+    }
+
+    engine::VectorsData vectors;
+    auto status_dto = FillVectors(table_name, body, vectors);
+    if (0 != status_dto->code->getValue()) {
+        return status_dto;
+    }
+    vectors.predicates_.swap(body.predicates);
+
+    std::vector<Range> range_list;
+    TopKQueryResult result;
+    auto context_ptr = GenContextPtr("Web Handler");
+    auto status = request_handler_.Search(context_ptr, table_name->std_str(), vectors, range_list, body.topk,
+                                          body.nprobe, body.tags, body.file_ids, result);
+    if (!status.ok()) {
+        ASSIGN_RETURN_STATUS_DTO(status)
+    }
+
+    std::string json;
+    WriteTopkResults(result.row_num_, result.id_list_, result.distance_list_, json);
+    results_str = json.c_str();
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::ParsePackedParams(const OQueryParams& query_params, VectorsBody& body) {
+    for (auto& name : {"topk", "nprobe"}) {
+        auto value = query_params.get(name);
+        if (nullptr == value.get()) {
+            continue;
+        }
+        std::string value_str = value->std_str();
+        if (!ValidationUtil::ValidateStringIsNumber(value_str).ok()) {
+            RETURN_STATUS_DTO(ILLEGAL_QUERY_PARAM, ("Query param \'" + std::string(name) +
+                                                    "\' is illegal, only non-negative integer supported").c_str());
+        }
+        try {
+            if (std::string("topk") == name) {
+                body.topk = std::stol(value_str);
+                body.has_topk = true;
+            } else {
+                body.nprobe = std::stol(value_str);
+                body.has_nprobe = true;
+            }
+        } catch (std::out_of_range& e) {
+            Status status(SERVER_INVALID_ARGUMENT, "Query param \'" + std::string(name) + "\' is out of range");
+            ASSIGN_RETURN_STATUS_DTO(status)
+        }
+    }
+
+    auto tag = query_params.get("tag");
+    if (nullptr != tag.get()) {
+        body.tag = tag->std_str();
+    }
+
+    auto tags = query_params.get("tags");
+    if (nullptr != tags.get() && tags->getSize() > 0) {
+        StringHelpFunctions::SplitStringByDelimeter(tags->std_str(), ",", body.tags);
+    }
+
+    RETURN_STATUS_DTO(SUCCESS, "OK")
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::Insert(const OString& table_name, const OString& body, OString& ids_str) {
+    if (nullptr == body.get() || body->getSize() == 0) {
+        RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Request payload is required")
+    }
+
+    VectorsBody insert_body;
+    auto status = ParseVectorsBody((const char*)body->getData(), body->getSize(), insert_body);
+    if (!status.ok()) {
+        RETURN_STATUS_DTO(BODY_PARSE_FAIL, status.message().c_str())
+    }
+
+    return InsertVectors(table_name, insert_body, ids_str);
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::Search(const OString& table_name, const OString& body, OString& results_str) {
+    if (nullptr == body.get() || body->getSize() == 0) {
+        RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Request payload is required")
+    }
+
+    VectorsBody search_body;
+    auto status = ParseVectorsBody((const char*)body->getData(), body->getSize(), search_body);
+    if (!status.ok()) {
+        RETURN_STATUS_DTO(BODY_PARSE_FAIL, status.message().c_str())
+    }
+
+    return SearchVectors(table_name, search_body, results_str);
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::InsertPacked(const OString& table_name, const OQueryParams& query_params, const OString& body,
+                                OString& ids_str) {
+    if (nullptr == body.get() || body->getSize() == 0) {
+        RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Request payload is required")
+    }
+
+    VectorsBody insert_body;
+    auto status_dto = ParsePackedParams(query_params, insert_body);
+    if (0 != status_dto->code->getValue()) {
+        return status_dto;
+    }
+
+    auto data = (const uint8_t*)body->getData();
+    insert_body.has_packed_records = true;
+    insert_body.packed_records.assign(data, data + body->getSize());
+
+    return InsertVectors(table_name, insert_body, ids_str);
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::SearchPacked(const OString& table_name, const OQueryParams& query_params, const OString& body,
+                                OString& results_str) {
+    if (nullptr == body.get() || body->getSize() == 0) {
+        RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Request payload is required")
+    }
+
+    VectorsBody search_body;
+    auto status_dto = ParsePackedParams(query_params, search_body);
+    if (0 != status_dto->code->getValue()) {
+        return status_dto;
+    }
+
+    auto data = (const uint8_t*)body->getData();
+    search_body.has_packed_records = true;
+    search_body.packed_records.assign(data, data + body->getSize());
+
+    return SearchVectors(table_name, search_body, results_str);
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::SearchBatch(const OString& table_name, const OString& body, OString& results_str) {
+    if (nullptr == body.get() || body->getSize() == 0) {
+        RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Request payload is required")
+    }
+
+    nlohmann::json searches;
+    try {
+        auto data = (const char*)body->getData();
+        searches = nlohmann::json::parse(data, data + body->getSize());
+    } catch (std::exception& ex) {
+        RETURN_STATUS_DTO(BODY_PARSE_FAIL, ex.what())
+    }
+    if (!searches.is_array() || searches.empty()) {
+        RETURN_STATUS_DTO(BODY_PARSE_FAIL, "Request payload must be a non-empty array of searches")
+    }
+
+    std::vector<SearchQueryParam> query_params(searches.size());
+    for (size_t i = 0; i < searches.size(); i++) {
+        auto search_str = searches[i].dump();
+        VectorsBody search_body;
+        auto status = ParseVectorsBody(search_str.c_str(), search_str.size(), search_body);
+        if (!status.ok()) {
+            RETURN_STATUS_DTO(BODY_PARSE_FAIL, ("Search " + std::to_string(i) + ": " + status.message()).c_str())
+        }
+        if (!search_body.has_topk) {
+            RETURN_STATUS_DTO(BODY_FIELD_LOSS, ("Field \'topk\' is required in search " + std::to_string(i)).c_str())
+        }
+        if (!search_body.has_nprobe) {
+            RETURN_STATUS_DTO(BODY_FIELD_LOSS,
+                              ("Field \'nprobe\' is required in search " + std::to_string(i)).c_str())
+        }
+
+        auto& param = query_params[i];
+        auto status_dto = FillVectors(table_name, search_body, param.vectors_);
+        if (0 != status_dto->code->getValue()) {
+            return status_dto;
+        }
+        param.vectors_.predicates_.swap(search_body.predicates);
+        param.topk_ = search_body.topk;
+        param.nprobe_ = search_body.nprobe;
+        param.partition_list_.swap(search_body.tags);
+        param.file_id_list_.swap(search_body.file_ids);
+    }
+
+    std::vector<TopKQueryResult> results;
+    auto context_ptr = GenContextPtr("Web Handler");
+    auto status = request_handler_.SearchBatch(context_ptr, table_name->std_str(), query_params, results);
+    if (!status.ok()) {
+        ASSIGN_RETURN_STATUS_DTO(status)
+    }
+
+    std::string json = "[";
+    for (size_t i = 0; i < results.size(); i++) {
+        std::string result_json;
+        WriteTopkResults(results[i].row_num_, results[i].id_list_, results[i].distance_list_, result_json);
+        json += (i == 0) ? "" : ",";
+        json += result_json;
+    }
+    json += "]";
+    results_str = json.c_str();
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
 StatusDto::ObjectWrapper
 WebRequestHandler::SystemInfo(const OString& cmd, CommandDto::ObjectWrapper& cmd_dto) {
     std::string info = cmd->std_str();
@@ -29,6 +29,7 @@
 #include "server/web_impl/dto/PartitionDto.hpp"
 #include "server/web_impl/dto/TableDto.hpp"
 #include "server/web_impl/dto/VectorDto.hpp"
+#include "server/web_impl/utils/Util.h"
 
 #include "db/Types.h"
 #include "server/context/Context.h"
@@ -83,6 +84,19 @@ class WebRequestHandler {
     Status
     CommandLine(const std::string& cmd, std::string& reply);
 
+    StatusDto::ObjectWrapper
+    FillVectors(const OString& table_name, VectorsBody& body, engine::VectorsData& vectors);
+
+    StatusDto::ObjectWrapper
+    InsertVectors(const OString& table_name, VectorsBody& body, OString& ids_str);
+
+    StatusDto::ObjectWrapper
+    SearchVectors(const OString& table_name, VectorsBody& body, OString& results_str);
+
+    // topk, nprobe, tag and comma separated tags of an octet-stream request come in the query string
+    StatusDto::ObjectWrapper
+    ParsePackedParams(const OQueryParams& query_params, VectorsBody& body);
+
  public:
     WebRequestHandler() {
         context_ptr_ = GenContextPtr("Web Handler");
@@ -145,6 +159,28 @@ class WebRequestHandler {
     Search(const OString& table_name, const SearchRequestDto::ObjectWrapper& search_request,
            TopkResultsDto::ObjectWrapper& results_dto);
 
+    // same as Insert and Search, but the json body is parsed straight into vectors and the
+    // reply is written as json text, without dtos holding every element
+    StatusDto::ObjectWrapper
+    Insert(const OString& table_name, const OString& body, OString& ids_str);
+
+    StatusDto::ObjectWrapper
+    Search(const OString& table_name, const OString& body, OString& results_str);
+
+    // the body is an application/octet-stream of packed vectors, little endian floats for a float table
+    // or bytes for a binary table, the other parameters are given in the query string
+    StatusDto::ObjectWrapper
+    InsertPacked(const OString& table_name, const OQueryParams& query_params, const OString& body, OString& ids_str);
+
+    StatusDto::ObjectWrapper
+    SearchPacked(const OString& table_name, const OQueryParams& query_params, const OString& body,
+                 OString& results_str);
+
+    // the body is a json array of search bodies, they are run together so that a file searched by several of them
+    // is loaded and searched once; the reply is an array of their results
+    StatusDto::ObjectWrapper
+    SearchBatch(const OString& table_name, const OString& body, OString& results_str);
+
     StatusDto::ObjectWrapper
     SystemInfo(const OString& cmd, CommandDto::ObjectWrapper& cmd_dto);
 
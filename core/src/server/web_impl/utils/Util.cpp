@@ -11,6 +11,14 @@
 
 #include "server/web_impl/utils/Util.h"
 
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <unordered_map>
+#include <utility>
+
+#include "thirdparty/nlohmann/json.hpp"
+
 namespace milvus {
 namespace server {
 namespace web {
@@ -54,6 +62,397 @@ CopyBinRowRecords(const OList<OList<OInt64>::ObjectWrapper>::ObjectWrapper& reco
     return Status::OK();
 }
 
+Status
+DecodeBase64(const char* data, size_t length, std::vector<uint8_t>& bytes) {
+    static const auto table = [] {
+        std::array<int8_t, 256> table;
+        table.fill(-1);
+        const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int8_t i = 0; i < 64; i++) {
+            table[static_cast<uint8_t>(chars[i])] = i;
+        }
+        return table;
+    }();
+
+    while (length > 0 && data[length - 1] == '=') {
+        length--;
+    }
+    if (length % 4 == 1) {
+        return Status(SERVER_INVALID_ARGUMENT, "Invalid base64 length");
+    }
+
+    bytes.resize(length * 3 / 4);
+    uint8_t* out = bytes.data();
+    uint32_t bits = 0;
+    int bit_count = 0;
+    for (size_t i = 0; i < length; i++) {
+        int8_t value = table[static_cast<uint8_t>(data[i])];
+        if (value < 0) {
+            return Status(SERVER_INVALID_ARGUMENT, "Invalid base64 character at " + std::to_string(i));
+        }
+        bits = (bits << 6) | value;
+        bit_count += 6;
+        if (bit_count >= 8) {
+            bit_count -= 8;
+            *out++ = static_cast<uint8_t>(bits >> bit_count);
+        }
+    }
+
+    return Status::OK();
+}
+
+namespace {
+
+// reads insert and search bodies from sax events, so that vectors never become json values or dtos
+class VectorsBodyReader : public nlohmann::json_sax<nlohmann::json> {
+ public:
+    explicit VectorsBodyReader(VectorsBody& body) : body_(body) {
+    }
+
+    const std::string&
+    error() const {
+        return error_;
+    }
+
+    bool
+    null() override {
+        // a null field is taken as missing
+        return depth_ == 1 || Skip() || Fail("null");
+    }
+
+    bool
+    boolean(bool val) override {
+        return Skip() || Fail("boolean");
+    }
+
+    bool
+    number_integer(number_integer_t val) override {
+        return Integer(val);
+    }
+
+    bool
+    number_unsigned(number_unsigned_t val) override {
+        return Integer(static_cast<int64_t>(val));
+    }
+
+    bool
+    number_float(number_float_t val, const string_t& s) override {
+        if (depth_ == 3 && field_ == Field::RECORDS) {
+            body_.records.push_back(static_cast<float>(val));
+            return true;
+        }
+        if (depth_ == 3 && field_ == Field::ATTRS) {
+            auto& column = body_.attrs[attr_name_];
+            if (column.type_ == engine::AttrColumn::Type::INT64) {
+                column.double_values_.assign(column.int_values_.begin(), column.int_values_.end());
+                column.int_values_.clear();
+                column.type_ = engine::AttrColumn::Type::DOUBLE;
+            }
+            column.double_values_.push_back(val);
+            return true;
+        }
+        if (field_ == Field::FILTER) {
+            return Operand(val);
+        }
+        return Skip() || Fail("float");
+    }
+
+    bool
+    string(string_t& val) override {
+        if (depth_ == 1 && field_ == Field::TAG) {
+            body_.tag = std::move(val);
+            return true;
+        }
+        if (depth_ == 1 && field_ == Field::RECORDS_BASE64) {
+            auto status = DecodeBase64(val.data(), val.size(), body_.packed_records);
+            if (!status.ok()) {
+                error_ = "Field \'records_base64\': " + status.message();
+                return false;
+            }
+            body_.has_packed_records = true;
+            return true;
+        }
+        if (depth_ == 2 && field_ == Field::TAGS) {
+            body_.tags.emplace_back(std::move(val));
+            return true;
+        }
+        if (depth_ == 2 && field_ == Field::FILE_IDS) {
+            body_.file_ids.emplace_back(std::move(val));
+            return true;
+        }
+        return Skip() || Fail("string");
+    }
+
+    bool
+    start_object(std::size_t elements) override {
+        if (depth_ == 0 || Skip() || (depth_ == 1 && (field_ == Field::ATTRS || field_ == Field::FILTER)) ||
+            (depth_ == 2 && field_ == Field::FILTER)) {
+            depth_++;
+            return true;
+        }
+        return Fail("object");
+    }
+
+    bool
+    key(string_t& val) override {
+        if (depth_ == 1) {
+            field_ = ToField(val);
+            field_name_ = std::move(val);
+        } else if (depth_ == 2 && (field_ == Field::ATTRS || field_ == Field::FILTER)) {
+            attr_name_ = std::move(val);
+            if (field_ == Field::ATTRS && body_.attrs.count(attr_name_) > 0) {
+                error_ = "Duplicated attribute \'" + attr_name_ + "\'";
+                return false;
+            }
+        } else if (depth_ == 3 && field_ == Field::FILTER) {
+            static const std::unordered_map<std::string, engine::AttrPredicate::Op> ops = {
+                {"==", engine::AttrPredicate::Op::EQ}, {"!=", engine::AttrPredicate::Op::NE},
+                {"<", engine::AttrPredicate::Op::LT},  {"<=", engine::AttrPredicate::Op::LE},
+                {">", engine::AttrPredicate::Op::GT},  {">=", engine::AttrPredicate::Op::GE},
+                {"in", engine::AttrPredicate::Op::IN},
+            };
+            auto iter = ops.find(val);
+            if (iter == ops.end()) {
+                error_ = "Unknown operator \'" + val + "\' of attribute \'" + attr_name_ + "\' in filter";
+                return false;
+            }
+            engine::AttrPredicate predicate;
+            predicate.name_ = attr_name_;
+            predicate.op_ = iter->second;
+            body_.predicates.emplace_back(std::move(predicate));
+        }
+        return true;
+    }
+
+    bool
+    end_object() override {
+        depth_--;
+        return true;
+    }
+
+    bool
+    start_array(std::size_t elements) override {
+        if (depth_ == 0) {
+            error_ = "Request body must be a json object";
+            return false;
+        }
+
+        depth_++;
+        if (Skip()) {
+            return true;
+        }
+
+        if (depth_ == 2) {
+            if (field_ == Field::RECORDS) {
+                body_.has_records = true;
+                return true;
+            }
+            if (field_ == Field::RECORDS_BIN) {
+                body_.has_records_bin = true;
+                return true;
+            }
+            if (field_ == Field::TAGS || field_ == Field::FILE_IDS || field_ == Field::IDS) {
+                return true;
+            }
+        } else if (depth_ == 3) {
+            if (field_ == Field::RECORDS) {
+                body_.record_count++;
+                return true;
+            }
+            if (field_ == Field::RECORDS_BIN) {
+                body_.record_bin_count++;
+                return true;
+            }
+            if (field_ == Field::ATTRS) {
+                body_.attrs[attr_name_];
+                return true;
+            }
+        } else if (depth_ == 4 && field_ == Field::FILTER) {
+            if (body_.predicates.back().op_ == engine::AttrPredicate::Op::IN) {
+                return true;
+            }
+        }
+
+        depth_--;
+        return Fail("array");
+    }
+
+    bool
+    end_array() override {
+        depth_--;
+        return true;
+    }
+
+    bool
+    parse_error(std::size_t position, const std::string& last_token, const nlohmann::detail::exception& ex) override {
+        error_ = ex.what();
+        return false;
+    }
+
+ private:
+    enum class Field {
+        UNKNOWN,
+        TOPK,
+        NPROBE,
+        TAG,
+        TAGS,
+        FILE_IDS,
+        RECORDS,
+        RECORDS_BIN,
+        RECORDS_BASE64,
+        IDS,
+        ATTRS,
+        FILTER,
+    };
+
+    static Field
+    ToField(const std::string& name) {
+        static const std::unordered_map<std::string, Field> fields = {
+            {"topk", Field::TOPK},
+            {"nprobe", Field::NPROBE},
+            {"tag", Field::TAG},
+            {"tags", Field::TAGS},
+            {"file_ids", Field::FILE_IDS},
+            {"records", Field::RECORDS},
+            {"records_bin", Field::RECORDS_BIN},
+            {"records_base64", Field::RECORDS_BASE64},
+            {"ids", Field::IDS},
+            {"attrs", Field::ATTRS},
+            {"filter", Field::FILTER},
+        };
+        auto iter = fields.find(name);
+        return iter == fields.end() ? Field::UNKNOWN : iter->second;
+    }
+
+    bool
+    Integer(int64_t val) {
+        if (depth_ == 1 && field_ == Field::TOPK) {
+            body_.has_topk = true;
+            body_.topk = val;
+            return true;
+        }
+        if (depth_ == 1 && field_ == Field::NPROBE) {
+            body_.has_nprobe = true;
+            body_.nprobe = val;
+            return true;
+        }
+        if (depth_ == 2 && field_ == Field::IDS) {
+            body_.ids.push_back(val);
+            return true;
+        }
+        if (depth_ == 3 && field_ == Field::RECORDS) {
+            body_.records.push_back(static_cast<float>(val));
+            return true;
+        }
+        if (depth_ == 3 && field_ == Field::RECORDS_BIN) {
+            if (val < 0 || val > 255) {
+                error_ = "Field \'records_bin\' only accepts values in range [0, 255]";
+                return false;
+            }
+            body_.records_bin.push_back(static_cast<uint8_t>(val));
+            return true;
+        }
+        if (depth_ == 3 && field_ == Field::ATTRS) {
+            auto& column = body_.attrs[attr_name_];
+            if (column.type_ == engine::AttrColumn::Type::INT64) {
+                column.int_values_.push_back(val);
+            } else {
+                column.double_values_.push_back(val);
+            }
+            return true;
+        }
+        if (field_ == Field::FILTER) {
+            return Operand(static_cast<double>(val));
+        }
+        return Skip() || Fail("integer");
+    }
+
+    // a value compared by the last operator of the filter, only in takes more than one
+    bool
+    Operand(double val) {
+        if (depth_ < 3 || body_.predicates.empty()) {
+            return Fail("number");
+        }
+        auto& predicate = body_.predicates.back();
+        if (!predicate.values_.empty() && predicate.op_ != engine::AttrPredicate::Op::IN) {
+            return Fail("number");
+        }
+        predicate.values_.push_back(val);
+        return true;
+    }
+
+    // values of unknown fields are ignored
+    bool
+    Skip() const {
+        return depth_ > 0 && field_ == Field::UNKNOWN;
+    }
+
+    bool
+    Fail(const std::string& type) {
+        if (depth_ == 0) {
+            error_ = "Request body must be a json object";
+        } else {
+            error_ = "Unexpected " + type + " in field \'" + field_name_ + "\'";
+        }
+        return false;
+    }
+
+ private:
+    VectorsBody& body_;
+    int depth_ = 0;
+    Field field_ = Field::UNKNOWN;
+    std::string field_name_;
+    std::string attr_name_;
+    std::string error_;
+};
+
+}  // namespace
+
+Status
+ParseVectorsBody(const char* json, size_t length, VectorsBody& body) {
+    VectorsBodyReader reader(body);
+    if (!nlohmann::json::sax_parse(json, json + length, &reader)) {
+        return Status(SERVER_INVALID_ARGUMENT, reader.error());
+    }
+
+    return Status::OK();
+}
+
+void
+WriteTopkResults(int64_t row_num, const engine::ResultIds& ids, const engine::ResultDistances& distances,
+                 std::string& json) {
+    json = "{\"num\":" + std::to_string(row_num) + ",\"results\":[";
+    size_t step = row_num > 0 ? ids.size() / row_num : 0;
+    // an entry is about 48 characters
+    json.reserve(json.size() + ids.size() * 48 + row_num * 3 + 2);
+
+    char buf[64];
+    for (int64_t i = 0; i < row_num; i++) {
+        json += (i == 0) ? "[" : ",[";
+        for (size_t j = 0; j < step; j++) {
+            size_t k = i * step + j;
+            int len = snprintf(buf, sizeof(buf), "%s{\"id\":\"%" PRId64 "\",\"distance\":\"%f\"}",
+                               (j == 0) ? "" : ",", static_cast<int64_t>(ids[k]), distances[k]);
+            json.append(buf, len);
+        }
+        json += "]";
+    }
+    json += "]}";
+}
+
+void
+WriteVectorIds(const engine::IDNumbers& ids, std::string& json) {
+    json = "{\"ids\":[";
+    json.reserve(json.size() + ids.size() * 22 + 2);
+
+    char buf[32];
+    for (size_t i = 0; i < ids.size(); i++) {
+        int len = snprintf(buf, sizeof(buf), "%s\"%" PRId64 "\"", (i == 0) ? "" : ",", ids[i]);
+        json.append(buf, len);
+    }
+    json += "]}";
+}
+
 }  // namespace web
 }  // namespace server
 }  // namespace milvus
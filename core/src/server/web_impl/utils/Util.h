@@ -28,6 +28,51 @@ CopyRowRecords(const OList<OList<OFloat32>::ObjectWrapper>::ObjectWrapper& recor
 Status
 CopyBinRowRecords(const OList<OList<OInt64>::ObjectWrapper>::ObjectWrapper& records, std::vector<uint8_t>& vectors);
 
+// fields of an insert or search body, records are parsed straight into flat arrays
+struct VectorsBody {
+    bool has_topk = false;
+    int64_t topk = 0;
+    bool has_nprobe = false;
+    int64_t nprobe = 0;
+    std::string tag = VALUE_PARTITION_TAG_DEFAULT;
+    std::vector<std::string> tags;
+    std::vector<std::string> file_ids;
+
+    bool has_records = false;
+    uint64_t record_count = 0;
+    std::vector<float> records;
+    bool has_records_bin = false;
+    uint64_t record_bin_count = 0;
+    std::vector<uint8_t> records_bin;
+    engine::IDNumbers ids;
+
+    // vectors packed as little endian floats or as bytes, from records_base64 or an octet-stream body
+    bool has_packed_records = false;
+    std::vector<uint8_t> packed_records;
+
+    // {"attrs": {"name": [values]}} of an insert, a column with any float value is a double column
+    engine::AttrColumns attrs;
+    // {"filter": {"name": {"op": value}}} of a search, op is one of == != < <= > >= and in, which takes an array
+    engine::AttrPredicates predicates;
+};
+
+// decode standard base64, the padding may be omitted
+Status
+DecodeBase64(const char* data, size_t length, std::vector<uint8_t>& bytes);
+
+// parse the json body of insert or search without building dtos, unknown fields are skipped
+Status
+ParseVectorsBody(const char* json, size_t length, VectorsBody& body);
+
+// write search result as json in the layout of TopkResultsDto
+void
+WriteTopkResults(int64_t row_num, const engine::ResultIds& ids, const engine::ResultDistances& distances,
+                 std::string& json);
+
+// write vector ids as json in the layout of VectorIdsDto
+void
+WriteVectorIds(const engine::IDNumbers& ids, std::string& json);
+
 }  // namespace web
 }  // namespace server
 }  // namespace milvus
@@ -0,0 +1,170 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/Compression.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace milvus {
+namespace storage {
+
+namespace {
+constexpr size_t CHUNK_SIZE = 4UL * 1024 * 1024;
+// smaller blocks are stored as they are
+constexpr size_t MIN_BLOCK_SIZE = 64UL * 1024;
+// a block is kept compressed only if it shrinks to this ratio
+constexpr double MAX_RATIO = 0.9;
+
+// run work(i) for i in [0, num) on parallel threads, return false if any of them does
+bool
+ParallelFor(size_t num, const std::function<bool(size_t)>& work) {
+    size_t thread_num = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), num);
+    std::atomic<size_t> next(0);
+    std::atomic<bool> ok(true);
+    auto run = [&]() {
+        for (size_t i = next++; i < num && ok; i = next++) {
+            if (!work(i)) {
+                ok = false;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_num; ++i) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return ok;
+}
+}  // namespace
+
+bool
+CompressBlock(const uint8_t* data, size_t length, std::vector<uint8_t>& compressed) {
+    if (length < MIN_BLOCK_SIZE) {
+        return false;
+    }
+
+    uint64_t chunk_num = (length + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<std::vector<uint8_t>> chunks(chunk_num);
+    bool ok = ParallelFor(chunk_num, [&](size_t i) {
+        size_t chunk_length = std::min(CHUNK_SIZE, length - i * CHUNK_SIZE);
+        uLongf chunk_compressed = compressBound(chunk_length);
+        chunks[i].resize(chunk_compressed);
+        // the fastest level, loads are bound by reading the file rather than by inflating it
+        if (compress2(chunks[i].data(), &chunk_compressed, data + i * CHUNK_SIZE, chunk_length, Z_BEST_SPEED) !=
+            Z_OK) {
+            return false;
+        }
+        chunks[i].resize(chunk_compressed);
+        return true;
+    });
+    if (!ok) {
+        return false;
+    }
+
+    size_t header = sizeof(uint64_t) * (2 + chunk_num);
+    size_t total = header;
+    for (auto& chunk : chunks) {
+        total += chunk.size();
+    }
+    if (total > length * MAX_RATIO) {
+        return false;
+    }
+
+    compressed.resize(total);
+    auto lengths = reinterpret_cast<uint64_t*>(compressed.data());
+    lengths[0] = length;
+    lengths[1] = chunk_num;
+    size_t offset = header;
+    for (uint64_t i = 0; i < chunk_num; ++i) {
+        lengths[2 + i] = chunks[i].size();
+        memcpy(compressed.data() + offset, chunks[i].data(), chunks[i].size());
+        offset += chunks[i].size();
+    }
+    return true;
+}
+
+bool
+DecompressBlock(const uint8_t* compressed, size_t length, std::shared_ptr<uint8_t>& data, size_t& data_length) {
+    uint64_t values[2];
+    if (length < sizeof(values)) {
+        return false;
+    }
+    memcpy(values, compressed, sizeof(values));
+    uint64_t raw_length = values[0];
+    uint64_t chunk_num = values[1];
+    if (chunk_num != (raw_length + CHUNK_SIZE - 1) / CHUNK_SIZE ||
+        length < sizeof(uint64_t) * (2 + chunk_num)) {
+        return false;
+    }
+
+    // offsets of the chunks, checked against the block before any of them is inflated
+    std::vector<uint64_t> lengths(chunk_num);
+    memcpy(lengths.data(), compressed + sizeof(values), sizeof(uint64_t) * chunk_num);
+    std::vector<size_t> offsets(chunk_num);
+    size_t offset = sizeof(uint64_t) * (2 + chunk_num);
+    for (uint64_t i = 0; i < chunk_num; ++i) {
+        offsets[i] = offset;
+        if (lengths[i] > length - offset) {
+            return false;
+        }
+        offset += lengths[i];
+    }
+
+    std::shared_ptr<uint8_t> raw(new uint8_t[raw_length], std::default_delete<uint8_t[]>());
+    bool ok = ParallelFor(chunk_num, [&](size_t i) {
+        size_t chunk_length = std::min<size_t>(CHUNK_SIZE, raw_length - i * CHUNK_SIZE);
+        uLongf inflated = chunk_length;
+        return uncompress(raw.get() + i * CHUNK_SIZE, &inflated, compressed + offsets[i], lengths[i]) == Z_OK &&
+               inflated == chunk_length;
+    });
+    if (!ok) {
+        return false;
+    }
+
+    data = raw;
+    data_length = raw_length;
+    return true;
+}
+
+uint32_t
+BlockChecksum(const uint8_t* data, size_t length) {
+    size_t chunk_num = (length + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<uLong> sums(chunk_num);
+    ParallelFor(chunk_num, [&](size_t i) {
+        size_t chunk_length = std::min(CHUNK_SIZE, length - i * CHUNK_SIZE);
+        sums[i] = crc32(crc32(0L, Z_NULL, 0), data + i * CHUNK_SIZE, chunk_length);
+        return true;
+    });
+
+    uLong sum = crc32(0L, Z_NULL, 0);
+    for (size_t i = 0; i < chunk_num; ++i) {
+        sum = crc32_combine(sum, sums[i], std::min(CHUNK_SIZE, length - i * CHUNK_SIZE));
+    }
+    return static_cast<uint32_t>(sum);
+}
+
+uint32_t
+BlockChecksum(uint32_t checksum, const uint8_t* data, size_t length) {
+    return static_cast<uint32_t>(crc32_combine(checksum, BlockChecksum(data, length), length));
+}
+
+}  // namespace storage
+}  // namespace milvus
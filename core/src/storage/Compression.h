@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace milvus {
+namespace storage {
+
+// set in the length written before a block of a file, the block is compressed
+constexpr uint64_t COMPRESSED_BLOCK_FLAG = 1ULL << 63;
+
+/*
+ * A compressed block is split into chunks compressed apart, so chunks are compressed and decompressed by
+ * parallel threads; Layout: raw length, chunk number, compressed length of each chunk, then the chunks;
+ * Return false if the block doesn't shrink enough to pay for decompressing it, it is stored as it is then;
+ */
+bool
+CompressBlock(const uint8_t* data, size_t length, std::vector<uint8_t>& compressed);
+
+// return false if the block is broken
+bool
+DecompressBlock(const uint8_t* compressed, size_t length, std::shared_ptr<uint8_t>& data, size_t& data_length);
+
+// crc32 of a block, chunks of large blocks are summed by parallel threads
+uint32_t
+BlockChecksum(const uint8_t* data, size_t length);
+
+// checksum of a block written in parts, the one of the part before data followed by data
+uint32_t
+BlockChecksum(uint32_t checksum, const uint8_t* data, size_t length);
+
+}  // namespace storage
+}  // namespace milvus
@@ -0,0 +1,117 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/IORateLimiter.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace milvus {
+namespace storage {
+
+namespace {
+
+thread_local bool background_io = false;
+
+constexpr double MIN_RATE_FACTOR = 1.0 / 16;
+constexpr double RECOVER_RATE_FACTOR = 1.25;
+
+// the recent average follows the last few searches, the usual one hundreds of them
+constexpr double RECENT_LATENCY_WEIGHT = 0.2;
+constexpr double USUAL_LATENCY_WEIGHT = 0.01;
+constexpr double LATENCY_RISE_RATIO = 1.5;
+
+constexpr std::chrono::seconds BACKOFF_INTERVAL(1);
+
+}  // namespace
+
+void
+IORateLimiter::SetRate(int64_t rate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rate_ = std::max<int64_t>(rate, 0);
+    factor_ = 1.0;
+    tokens_ = 0.0;
+    refill_time_ = std::chrono::steady_clock::now();
+}
+
+int64_t
+IORateLimiter::CurrentRate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int64_t>(rate_ * factor_);
+}
+
+void
+IORateLimiter::Request(int64_t bytes) {
+    if (!background_io || bytes <= 0) {
+        return;
+    }
+
+    double wait = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (rate_ <= 0) {
+            return;
+        }
+
+        // tokens saved while idle make a burst of one second at most, bytes beyond them are paid by waiting
+        auto now = std::chrono::steady_clock::now();
+        double rate = rate_ * factor_;
+        double idle = std::chrono::duration<double>(now - refill_time_).count();
+        tokens_ = std::min(tokens_ + rate * idle, rate);
+        refill_time_ = now;
+        tokens_ -= bytes;
+        if (tokens_ < 0) {
+            wait = -tokens_ / rate;
+        }
+    }
+
+    if (wait > 0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+}
+
+void
+IORateLimiter::ReportSearchLatency(double latency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (usual_latency_ <= 0) {
+        recent_latency_ = usual_latency_ = latency;
+        return;
+    }
+    recent_latency_ += RECENT_LATENCY_WEIGHT * (latency - recent_latency_);
+    usual_latency_ += USUAL_LATENCY_WEIGHT * (latency - usual_latency_);
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - backoff_time_ < BACKOFF_INTERVAL) {
+        return;
+    }
+    backoff_time_ = now;
+    if (recent_latency_ > LATENCY_RISE_RATIO * usual_latency_) {
+        factor_ = std::max(factor_ / 2, MIN_RATE_FACTOR);
+    } else {
+        factor_ = std::min(factor_ * RECOVER_RATE_FACTOR, 1.0);
+    }
+}
+
+bool
+IORateLimiter::InBackground() {
+    return background_io;
+}
+
+BackgroundIOScope::BackgroundIOScope() : outer_(background_io) {
+    background_io = true;
+}
+
+BackgroundIOScope::~BackgroundIOScope() {
+    background_io = outer_;
+}
+
+}  // namespace storage
+}  // namespace milvus
@@ -0,0 +1,84 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace milvus {
+namespace storage {
+
+/*
+ * Token bucket shared by background work reading, writing and deleting files (merge, index build, cleanup), so
+ * that it leaves disk bandwidth to searches. Only threads inside a BackgroundIOScope are limited.
+ * The rate is cut by half each second search latency stays well above its usual level, and it is restored
+ * gradually once latency falls back or the higher level becomes the usual one.
+ */
+class IORateLimiter {
+ public:
+    static IORateLimiter&
+    GetInstance() {
+        static IORateLimiter limiter;
+        return limiter;
+    }
+
+    // bytes per second, 0 means no limit
+    void
+    SetRate(int64_t rate);
+
+    // the rate after backoff, 0 if there is no limit
+    int64_t
+    CurrentRate();
+
+    // block the calling thread until the bytes may go to disk, return at once out of a BackgroundIOScope
+    void
+    Request(int64_t bytes);
+
+    // latency of a search in microseconds
+    void
+    ReportSearchLatency(double latency);
+
+    static bool
+    InBackground();
+
+ private:
+    IORateLimiter() = default;
+
+ private:
+    std::mutex mutex_;
+    int64_t rate_ = 0;
+    double factor_ = 1.0;
+    double tokens_ = 0.0;
+    std::chrono::steady_clock::time_point refill_time_ = std::chrono::steady_clock::now();
+
+    // short and long moving averages of search latency
+    double recent_latency_ = 0.0;
+    double usual_latency_ = 0.0;
+    std::chrono::steady_clock::time_point backoff_time_ = std::chrono::steady_clock::now();
+};
+
+// marks the file io of the current thread as background io while it is alive
+class BackgroundIOScope {
+ public:
+    BackgroundIOScope();
+    ~BackgroundIOScope();
+
+ private:
+    bool outer_;
+};
+
+// a deleted file is charged as this many bytes, freeing the extents of a large file costs disk time too
+constexpr int64_t DELETE_FILE_IO_COST = 1024 * 1024;
+
+}  // namespace storage
+}  // namespace milvus
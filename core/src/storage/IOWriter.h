@@ -13,6 +13,8 @@
 
 #include <string>
 
+#include "utils/Status.h"
+
 namespace milvus {
 namespace storage {
 
@@ -28,6 +30,10 @@ class IOWriter {
     virtual size_t
     length() = 0;
 
+    // finish the file, its data is stored only if ok is returned, a writer not closed is finished by its destructor
+    virtual Status
+    close() = 0;
+
  public:
     std::string name_;
     size_t len_;
@@ -0,0 +1,78 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/IStorage.h"
+#include "utils/Error.h"
+#include "utils/ThreadPool.h"
+
+namespace milvus {
+namespace storage {
+
+namespace {
+// requests in flight are bounded by the threads, the queue takes the rest without blocking callers
+constexpr size_t IO_THREAD_NUM = 16;
+constexpr size_t IO_QUEUE_SIZE = 10000;
+
+ThreadPool&
+GetIOThreadPool() {
+    static ThreadPool io_thread_pool(IO_THREAD_NUM, IO_QUEUE_SIZE);
+    return io_thread_pool;
+}
+}  // namespace
+
+std::future<Status>
+IStorage::Async(const std::function<Status()>& request, const StorageCallback& callback) {
+    return GetIOThreadPool().enqueue([request, callback]() {
+        Status status;
+        try {
+            status = request();
+        } catch (std::exception& ex) {
+            status = Status(SERVER_UNEXPECTED_ERROR, ex.what());
+        }
+        if (callback) {
+            callback(status);
+        }
+        return status;
+    });
+}
+
+std::future<Status>
+IStorage::PutObjectFileAsync(const std::string& object_name, const std::string& file_path,
+                             const StorageCallback& callback) {
+    return Async([this, object_name, file_path]() { return PutObjectFile(object_name, file_path); }, callback);
+}
+
+std::future<Status>
+IStorage::PutObjectStrAsync(const std::string& object_name, const std::string& content,
+                            const StorageCallback& callback) {
+    const std::string* content_ptr = &content;
+    return Async([this, object_name, content_ptr]() { return PutObjectStr(object_name, *content_ptr); }, callback);
+}
+
+std::future<Status>
+IStorage::GetObjectFileAsync(const std::string& object_name, const std::string& file_path,
+                             const StorageCallback& callback) {
+    return Async([this, object_name, file_path]() { return GetObjectFile(object_name, file_path); }, callback);
+}
+
+std::future<Status>
+IStorage::GetObjectStrAsync(const std::string& object_name, std::string& content, const StorageCallback& callback) {
+    std::string* content_ptr = &content;
+    return Async([this, object_name, content_ptr]() { return GetObjectStr(object_name, *content_ptr); }, callback);
+}
+
+std::future<Status>
+IStorage::DeleteObjectAsync(const std::string& object_name, const StorageCallback& callback) {
+    return Async([this, object_name]() { return DeleteObject(object_name); }, callback);
+}
+
+}  // namespace storage
+}  // namespace milvus
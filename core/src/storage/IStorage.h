@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
 #include <string>
 #include <vector>
 #include "utils/Status.h"
@@ -18,6 +20,9 @@
 namespace milvus {
 namespace storage {
 
+// called on the io thread once the request is done
+using StorageCallback = std::function<void(const Status&)>;
+
 class IStorage {
  public:
     virtual Status
@@ -38,6 +43,30 @@ class IStorage {
     DeleteObject(const std::string& object_name) = 0;
     virtual Status
     DeleteObjects(const std::string& marker) = 0;
+
+    /*
+     * Asynchronous variants run the requests above on a bounded pool of io threads shared by all storages,
+     * so callers keep many requests in flight instead of blocking on each; arguments passed by reference
+     * must outlive the returned future;
+     */
+    std::future<Status>
+    PutObjectFileAsync(const std::string& object_name, const std::string& file_path,
+                       const StorageCallback& callback = nullptr);
+    std::future<Status>
+    PutObjectStrAsync(const std::string& object_name, const std::string& content,
+                      const StorageCallback& callback = nullptr);
+    std::future<Status>
+    GetObjectFileAsync(const std::string& object_name, const std::string& file_path,
+                       const StorageCallback& callback = nullptr);
+    std::future<Status>
+    GetObjectStrAsync(const std::string& object_name, std::string& content,
+                      const StorageCallback& callback = nullptr);
+    std::future<Status>
+    DeleteObjectAsync(const std::string& object_name, const StorageCallback& callback = nullptr);
+
+ private:
+    std::future<Status>
+    Async(const std::function<Status()>& request, const StorageCallback& callback);
 };
 
 }  // namespace storage
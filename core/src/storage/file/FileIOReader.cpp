@@ -11,6 +11,16 @@
 
 #include "storage/file/FileIOReader.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "storage/IORateLimiter.h"
+
 namespace milvus {
 namespace storage {
 
@@ -22,9 +32,19 @@ FileIOReader::~FileIOReader() {
     fs_.close();
 }
 
+namespace {
+// a background read is paid in pieces, so it takes the disk evenly rather than in bursts
+constexpr size_t READ_PIECE_SIZE = 4 * 1024 * 1024;
+}  // namespace
+
 void
 FileIOReader::read(void* ptr, size_t size) {
-    fs_.read(reinterpret_cast<char*>(ptr), size);
+    auto data = reinterpret_cast<char*>(ptr);
+    for (size_t done = 0; done < size && fs_; done += READ_PIECE_SIZE) {
+        size_t n = std::min(size - done, READ_PIECE_SIZE);
+        IORateLimiter::GetInstance().Request(n);
+        fs_.read(data + done, n);
+    }
 }
 
 void
@@ -35,7 +55,53 @@ FileIOReader::seekg(size_t pos) {
 size_t
 FileIOReader::length() {
     fs_.seekg(0, fs_.end);
-    return fs_.tellg();
+    // a missing file has no length rather than -1
+    auto pos = fs_.tellg();
+    return pos < 0 ? 0 : static_cast<size_t>(pos);
+}
+
+namespace {
+// smaller chunks aren't worth a thread
+constexpr size_t MIN_CHUNK_SIZE = 16UL * 1024 * 1024;
+}  // namespace
+
+bool
+FileIOReader::pread(void* ptr, size_t pos, size_t size, int64_t thread_num) {
+    int fd = open(name_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    // the chunk threads are out of the caller's background scope, the whole read is paid up front
+    IORateLimiter::GetInstance().Request(size);
+
+    size_t chunk_num = std::max<size_t>(std::min<size_t>(thread_num, size / MIN_CHUNK_SIZE), 1);
+    size_t chunk_size = (size + chunk_num - 1) / chunk_num;
+    std::atomic<bool> ok(true);
+    auto read_chunk = [&](size_t begin, size_t end) {
+        auto data = static_cast<char*>(ptr);
+        while (begin < end && ok) {
+            ssize_t n = ::pread(fd, data + begin, end - begin, pos + begin);
+            if (n <= 0) {
+                ok = false;
+                return;
+            }
+            begin += n;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t begin = chunk_size; begin < size; begin += chunk_size) {
+        threads.emplace_back(read_chunk, begin, std::min(begin + chunk_size, size));
+    }
+    read_chunk(0, std::min(chunk_size, size));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    close(fd);
+    return ok;
 }
+
 }  // namespace storage
 }  // namespace milvus
@@ -32,6 +32,11 @@ class FileIOReader : public IOReader {
     size_t
     length() override;
 
+    // read a range of the file with threads reading chunks of it at once, local disks serve parallel
+    // requests faster than one stream; return false if the range can't be read whole
+    bool
+    pread(void* ptr, size_t pos, size_t size, int64_t thread_num);
+
  public:
     std::fstream fs_;
 };
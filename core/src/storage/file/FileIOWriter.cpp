@@ -10,21 +10,143 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "storage/file/FileIOWriter.h"
+#include "storage/IORateLimiter.h"
+#include "utils/Log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 
 namespace milvus {
 namespace storage {
 
-FileIOWriter::FileIOWriter(const std::string& name) : IOWriter(name) {
+namespace {
+// O_DIRECT wants the buffer, offset and length aligned to the logical block size of the device
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+constexpr size_t DIRECT_IO_BUFFER_SIZE = 4 * 1024 * 1024;
+
+// buffered writes are passed to the stream in pieces, so background writes of a large block are paced too
+constexpr size_t WRITE_PIECE_SIZE = 4 * 1024 * 1024;
+}  // namespace
+
+FileIOWriter::FileIOWriter(const std::string& name, bool direct) : IOWriter(name) {
+    if (direct) {
+        fd_ = open(name_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        if (fd_ < 0) {
+            // e.g. tmpfs, pages of the file are still dropped once it is closed
+            fd_ = open(name_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        }
+        void* buffer = nullptr;
+        if (fd_ >= 0 && posix_memalign(&buffer, DIRECT_IO_ALIGNMENT, DIRECT_IO_BUFFER_SIZE) == 0) {
+            buffer_ = static_cast<uint8_t*>(buffer);
+            direct_ = true;
+            return;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
     fs_ = std::fstream(name_, std::ios::out | std::ios::binary);
 }
 
 FileIOWriter::~FileIOWriter() {
-    fs_.close();
+    if (!closed_) {
+        close();
+    }
+}
+
+Status
+FileIOWriter::close() {
+    closed_ = true;
+    if (!direct_) {
+        fs_.flush();
+        bool ok = fs_.good();
+        fs_.close();
+        if (!ok || fs_.fail()) {
+            std::string msg = "Failed to write " + name_;
+            STORAGE_LOG_ERROR << msg;
+            return Status(SERVER_UNEXPECTED_ERROR, msg);
+        }
+        return Status::OK();
+    }
+
+    // the tail isn't aligned, it is written through page cache
+    std::string error = error_;
+    int flags = fcntl(fd_, F_GETFL);
+    if (error.empty() && buffered_ > 0 && (flags < 0 || fcntl(fd_, F_SETFL, flags & ~O_DIRECT) < 0 || !flush(buffered_))) {
+        error = "Failed to write tail of " + name_ + ": " + strerror(errno);
+    }
+    // dirty pages aren't dropped, they are written back first
+    if (fdatasync(fd_) != 0 && error.empty()) {
+        error = "Failed to sync " + name_ + ": " + strerror(errno);
+    }
+    posix_fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd_);
+    free(buffer_);
+    buffer_ = nullptr;
+
+    if (!error.empty()) {
+        STORAGE_LOG_ERROR << error;
+        return Status(SERVER_UNEXPECTED_ERROR, error);
+    }
+    return Status::OK();
+}
+
+bool
+FileIOWriter::flush(size_t size) {
+    IORateLimiter::GetInstance().Request(size);
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = ::write(fd_, buffer_ + written, size - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        written += n;
+    }
+    buffered_ = 0;
+    return true;
 }
 
 void
 FileIOWriter::write(void* ptr, size_t size) {
-    fs_.write(reinterpret_cast<char*>(ptr), size);
+    if (!direct_) {
+        auto data = reinterpret_cast<char*>(ptr);
+        for (size_t written = 0; written < size; written += WRITE_PIECE_SIZE) {
+            size_t n = std::min(size - written, WRITE_PIECE_SIZE);
+            IORateLimiter::GetInstance().Request(n);
+            fs_.write(data + written, n);
+        }
+        len_ += size;
+        return;
+    }
+
+    // the file is broken once a flush fails, the buffer is kept and the failure is returned by close
+    if (!error_.empty()) {
+        len_ += size;
+        return;
+    }
+
+    auto data = reinterpret_cast<const uint8_t*>(ptr);
+    size_t copied = 0;
+    while (copied < size) {
+        size_t n = std::min(size - copied, DIRECT_IO_BUFFER_SIZE - buffered_);
+        memcpy(buffer_ + buffered_, data + copied, n);
+        buffered_ += n;
+        copied += n;
+        if (buffered_ == DIRECT_IO_BUFFER_SIZE && !flush(buffered_)) {
+            error_ = "Failed to write " + name_ + ": " + strerror(errno);
+            STORAGE_LOG_ERROR << error_;
+            break;
+        }
+    }
     len_ += size;
 }
 
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include "storage/IOWriter.h"
@@ -18,9 +19,14 @@
 namespace milvus {
 namespace storage {
 
+/*
+ * direct: the file is written with O_DIRECT from an aligned buffer and its pages are dropped from page
+ * cache once it is closed, so large files written once don't evict pages of the files being read;
+ * Falls back to buffered writes if the file system refuses O_DIRECT;
+ */
 class FileIOWriter : public IOWriter {
  public:
-    explicit FileIOWriter(const std::string& name);
+    explicit FileIOWriter(const std::string& name, bool direct = false);
     ~FileIOWriter();
 
     void
@@ -29,8 +35,24 @@ class FileIOWriter : public IOWriter {
     size_t
     length() override;
 
+    Status
+    close() override;
+
+ private:
+    bool
+    flush(size_t size);
+
  public:
     std::fstream fs_;
+
+ private:
+    bool direct_ = false;
+    bool closed_ = false;
+    int fd_ = -1;
+    uint8_t* buffer_ = nullptr;
+    size_t buffered_ = 0;
+    // first failure of a direct write, nothing is written after it
+    std::string error_;
 };
 
 }  // namespace storage
@@ -0,0 +1,50 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/file/MmapFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace milvus {
+namespace storage {
+
+MmapFile::MmapFile(const std::string& name) : name_(name) {
+    int fd = open(name_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* addr = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            // index files are read from head to tail once
+            madvise(addr, st.st_size, MADV_SEQUENTIAL);
+            data_ = static_cast<uint8_t*>(addr);
+            length_ = st.st_size;
+        }
+    }
+
+    // the mapping stays valid after the file is closed
+    close(fd);
+}
+
+MmapFile::~MmapFile() {
+    if (data_ != nullptr) {
+        munmap(data_, length_);
+    }
+}
+
+}  // namespace storage
+}  // namespace milvus
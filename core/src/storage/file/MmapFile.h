@@ -0,0 +1,57 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace milvus {
+namespace storage {
+
+/*
+ * Read only view of a whole file mapped into memory, pages are served from page cache;
+ * The mapping is private, writes to data() are never written back to the file.
+ */
+class MmapFile {
+ public:
+    explicit MmapFile(const std::string& name);
+    ~MmapFile();
+
+    MmapFile(const MmapFile&) = delete;
+    MmapFile&
+    operator=(const MmapFile&) = delete;
+
+    bool
+    valid() const {
+        return data_ != nullptr;
+    }
+
+    uint8_t*
+    data() const {
+        return data_;
+    }
+
+    size_t
+    length() const {
+        return length_;
+    }
+
+ public:
+    std::string name_;
+
+ private:
+    uint8_t* data_ = nullptr;
+    size_t length_ = 0;
+};
+
+}  // namespace storage
+}  // namespace milvus
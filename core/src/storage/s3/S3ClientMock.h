@@ -9,7 +9,10 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <cstdio>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <utility>
 
 #include <aws/core/Aws.h>
@@ -18,11 +21,16 @@
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/s3/S3Client.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 
 namespace milvus {
 namespace storage {
@@ -30,7 +38,8 @@ namespace storage {
 /*
  * This is a class that represents a S3 Client which is used to mimic the put/get operations of a actual s3 client.
  * During a put object, the body of the request is stored as well as the metadata of the request. This data is then
- * populated into a get object result when a get operation is called.
+ * populated into a get object result when a get operation is called. Ranged gets and multipart uploads are served
+ * the same way, requests may come from several threads.
  */
 class S3ClientMock : public Aws::S3::S3Client {
  public:
@@ -52,33 +61,115 @@ class S3ClientMock : public Aws::S3::S3Client {
 
     Aws::S3::Model::PutObjectOutcome
     PutObject(const Aws::S3::Model::PutObjectRequest& request) const override {
-        Aws::String key = request.GetKey();
-        std::shared_ptr<Aws::IOStream> body = request.GetBody();
-        aws_map_[key] = body;
+        std::lock_guard<std::mutex> lock(mutex_);
+        aws_map_[request.GetKey()] = ReadBody(request.GetBody());
 
         Aws::S3::Model::PutObjectResult result;
         return Aws::S3::Model::PutObjectOutcome(std::move(result));
     }
 
+    Aws::S3::Model::HeadObjectOutcome
+    HeadObject(const Aws::S3::Model::HeadObjectRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = aws_map_.find(request.GetKey());
+        if (iter == aws_map_.end()) {
+            return Aws::S3::Model::HeadObjectOutcome();
+        }
+
+        Aws::S3::Model::HeadObjectResult result;
+        result.SetContentLength(iter->second.length());
+        return Aws::S3::Model::HeadObjectOutcome(std::move(result));
+    }
+
     Aws::S3::Model::GetObjectOutcome
     GetObject(const Aws::S3::Model::GetObjectRequest& request) const override {
         auto factory = request.GetResponseStreamFactory();
         Aws::Utils::Stream::ResponseStream resp_stream(factory);
 
-        try {
-            std::shared_ptr<Aws::IOStream> body = aws_map_.at(request.GetKey());
-            Aws::String body_str((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+        Aws::String body_str;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto iter = aws_map_.find(request.GetKey());
+            if (iter == aws_map_.end()) {
+                return Aws::S3::Model::GetObjectOutcome();
+            }
+
+            // range is "bytes=first-last", only that part is copied
+            size_t first = 0, last = iter->second.length() - 1;
+            if (request.RangeHasBeenSet() &&
+                (sscanf(request.GetRange().c_str(), "bytes=%zu-%zu", &first, &last) != 2 || first > last ||
+                 first >= iter->second.length())) {
+                return Aws::S3::Model::GetObjectOutcome();
+            }
+            body_str = iter->second.substr(first, last - first + 1);
+        }
+
+        resp_stream.GetUnderlyingStream().write(body_str.c_str(), body_str.length());
+        resp_stream.GetUnderlyingStream().flush();
+        Aws::AmazonWebServiceResult<Aws::Utils::Stream::ResponseStream> awsStream(std::move(resp_stream),
+                                                                                 Aws::Http::HeaderValueCollection());
+
+        Aws::S3::Model::GetObjectResult result(std::move(awsStream));
+        return Aws::S3::Model::GetObjectOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::CreateMultipartUploadOutcome
+    CreateMultipartUpload(const Aws::S3::Model::CreateMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Aws::String upload_id = request.GetKey() + "#" + std::to_string(++upload_count_).c_str();
+        uploads_[upload_id].clear();
+
+        Aws::S3::Model::CreateMultipartUploadResult result;
+        result.SetUploadId(upload_id);
+        return Aws::S3::Model::CreateMultipartUploadOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::UploadPartOutcome
+    UploadPart(const Aws::S3::Model::UploadPartRequest& request) const override {
+        Aws::String body = ReadBody(request.GetBody());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = uploads_.find(request.GetUploadId());
+        if (iter == uploads_.end()) {
+            return Aws::S3::Model::UploadPartOutcome();
+        }
+        iter->second[request.GetPartNumber()] = body;
+
+        Aws::S3::Model::UploadPartResult result;
+        result.SetETag(std::to_string(request.GetPartNumber()).c_str());
+        return Aws::S3::Model::UploadPartOutcome(std::move(result));
+    }
 
-            resp_stream.GetUnderlyingStream().write(body_str.c_str(), body_str.length());
-            resp_stream.GetUnderlyingStream().flush();
-            Aws::AmazonWebServiceResult<Aws::Utils::Stream::ResponseStream> awsStream(
-                std::move(resp_stream), Aws::Http::HeaderValueCollection());
+    Aws::S3::Model::CompleteMultipartUploadOutcome
+    CompleteMultipartUpload(const Aws::S3::Model::CompleteMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = uploads_.find(request.GetUploadId());
+        if (iter == uploads_.end()) {
+            return Aws::S3::Model::CompleteMultipartUploadOutcome();
+        }
 
-            Aws::S3::Model::GetObjectResult result(std::move(awsStream));
-            return Aws::S3::Model::GetObjectOutcome(std::move(result));
-        } catch (...) {
-            return Aws::S3::Model::GetObjectOutcome();
+        Aws::String content;
+        for (auto& part : request.GetMultipartUpload().GetParts()) {
+            auto part_iter = iter->second.find(part.GetPartNumber());
+            if (part_iter == iter->second.end()) {
+                return Aws::S3::Model::CompleteMultipartUploadOutcome();
+            }
+            content += part_iter->second;
         }
+        aws_map_[request.GetKey()] = content;
+        uploads_.erase(iter);
+
+        Aws::S3::Model::CompleteMultipartUploadResult result;
+        return Aws::S3::Model::CompleteMultipartUploadOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::AbortMultipartUploadOutcome
+    AbortMultipartUpload(const Aws::S3::Model::AbortMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uploads_.erase(request.GetUploadId());
+
+        Aws::S3::Model::AbortMultipartUploadResult result;
+        return Aws::S3::Model::AbortMultipartUploadOutcome(std::move(result));
     }
 
     Aws::S3::Model::ListObjectsOutcome
@@ -91,6 +182,7 @@ class S3ClientMock : public Aws::S3::S3Client {
 
     Aws::S3::Model::DeleteObjectOutcome
     DeleteObject(const Aws::S3::Model::DeleteObjectRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
         Aws::String key = request.GetKey();
         aws_map_.erase(key);
         Aws::S3::Model::DeleteObjectResult result;
@@ -98,7 +190,16 @@ class S3ClientMock : public Aws::S3::S3Client {
         return result;
     }
 
-    mutable Aws::Map<Aws::String, std::shared_ptr<Aws::IOStream>> aws_map_;
+    static Aws::String
+    ReadBody(const std::shared_ptr<Aws::IOStream>& body) {
+        return Aws::String((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+    }
+
+    mutable std::mutex mutex_;
+    mutable Aws::Map<Aws::String, Aws::String> aws_map_;
+    // parts of each upload in flight by part number
+    mutable Aws::Map<Aws::String, Aws::Map<int, Aws::String>> uploads_;
+    mutable int64_t upload_count_ = 0;
 };
 
 }  // namespace storage
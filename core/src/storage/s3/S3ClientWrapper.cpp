@@ -10,14 +10,22 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/CompletedMultipartUpload.h>
+#include <aws/s3/model/CompletedPart.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 #include <fiu-local.h>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -269,13 +277,149 @@ S3ClientWrapper::DeleteObjects(const std::string& marker) {
         return stat;
     }
 
+    // objects are deleted by parallel requests, the first failure is returned once all are done
+    std::vector<std::future<Status>> deletes;
     for (std::string& obj_name : object_list) {
-        stat = DeleteObject(obj_name);
-        if (!stat.ok()) {
-            return stat;
+        deletes.push_back(DeleteObjectAsync(obj_name));
+    }
+
+    Status result = Status::OK();
+    for (auto& future : deletes) {
+        stat = future.get();
+        if (result.ok() && !stat.ok()) {
+            result = stat;
         }
     }
 
+    return result;
+}
+
+Status
+S3ClientWrapper::GetObjectLength(const std::string& object_name, int64_t& length) {
+    Aws::S3::Model::HeadObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->HeadObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectLength.outcome.fail", outcome = Aws::S3::Model::HeadObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: HeadObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    length = outcome.GetResult().GetContentLength();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectRange(const std::string& object_name, int64_t offset, int64_t length, char* buffer) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+    request.SetRange("bytes=" + std::to_string(offset) + "-" + std::to_string(offset + length - 1));
+
+    auto outcome = client_ptr_->GetObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectRange.outcome.fail", outcome = Aws::S3::Model::GetObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: GetObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    // the body is read straight into the buffer, no copy of it is kept
+    auto& body = outcome.GetResultWithOwnership().GetBody();
+    body.read(buffer, length);
+    if (body.gcount() != length) {
+        std::string str = "Object '" + object_name + "' is shorter than the range read";
+        STORAGE_LOG_ERROR << "ERROR: " << str;
+        return Status(SERVER_UNEXPECTED_ERROR, str);
+    }
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::CreateMultipartUpload(const std::string& object_name, std::string& upload_id) {
+    Aws::S3::Model::CreateMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->CreateMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.CreateMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::CreateMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: CreateMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    upload_id = outcome.GetResult().GetUploadId();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::UploadPart(const std::string& object_name, const std::string& upload_id, int64_t part_number,
+                            const std::string& content, std::string& etag) {
+    Aws::S3::Model::UploadPartRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id);
+    request.SetPartNumber(static_cast<int>(part_number));
+
+    const std::shared_ptr<Aws::IOStream> input_data = Aws::MakeShared<Aws::StringStream>("");
+    input_data->write(content.data(), content.length());
+    request.SetBody(input_data);
+    request.SetContentLength(content.length());
+
+    auto outcome = client_ptr_->UploadPart(request);
+
+    fiu_do_on("S3ClientWrapper.UploadPart.outcome.fail", outcome = Aws::S3::Model::UploadPartOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: UploadPart: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    etag = outcome.GetResult().GetETag();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::CompleteMultipartUpload(const std::string& object_name, const std::string& upload_id,
+                                         const std::vector<std::string>& etags) {
+    Aws::S3::Model::CompletedMultipartUpload upload;
+    for (size_t i = 0; i < etags.size(); ++i) {
+        upload.AddParts(Aws::S3::Model::CompletedPart().WithETag(etags[i]).WithPartNumber(static_cast<int>(i + 1)));
+    }
+
+    Aws::S3::Model::CompleteMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id).WithMultipartUpload(upload);
+
+    auto outcome = client_ptr_->CompleteMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.CompleteMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::CompleteMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: CompleteMultipartUpload: " << err.GetExceptionName() << ": "
+                          << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    STORAGE_LOG_DEBUG << "CompleteMultipartUpload '" << object_name << "' of " << etags.size()
+                      << " parts successfully!";
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::AbortMultipartUpload(const std::string& object_name, const std::string& upload_id) {
+    Aws::S3::Model::AbortMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id);
+
+    auto outcome = client_ptr_->AbortMultipartUpload(request);
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: AbortMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
     return Status::OK();
 }
 
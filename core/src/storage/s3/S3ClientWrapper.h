@@ -21,6 +21,10 @@
 namespace milvus {
 namespace storage {
 
+// objects larger than a part are uploaded and downloaded in parts, by parallel requests
+constexpr int64_t S3_PART_SIZE = 16L * 1024 * 1024;
+constexpr int64_t S3_PARALLEL_NUM = 8;
+
 class S3ClientWrapper : public IStorage {
  public:
     static S3ClientWrapper&
@@ -53,6 +57,24 @@ class S3ClientWrapper : public IStorage {
     Status
     DeleteObjects(const std::string& marker) override;
 
+    Status
+    GetObjectLength(const std::string& object_key, int64_t& length);
+    // read length bytes of the object from offset into buffer
+    Status
+    GetObjectRange(const std::string& object_key, int64_t offset, int64_t length, char* buffer);
+
+    // parts are numbered from 1, the object is made of them in number order once completed
+    Status
+    CreateMultipartUpload(const std::string& object_key, std::string& upload_id);
+    Status
+    UploadPart(const std::string& object_key, const std::string& upload_id, int64_t part_number,
+               const std::string& content, std::string& etag);
+    Status
+    CompleteMultipartUpload(const std::string& object_key, const std::string& upload_id,
+                            const std::vector<std::string>& etags);
+    Status
+    AbortMultipartUpload(const std::string& object_key, const std::string& upload_id);
+
  private:
     std::shared_ptr<Aws::S3::S3Client> client_ptr_;
     Aws::SDKOptions options_;
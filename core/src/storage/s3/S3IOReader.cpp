@@ -11,12 +11,59 @@
 
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 namespace milvus {
 namespace storage {
 
 S3IOReader::S3IOReader(const std::string& name) : IOReader(name), pos_(0) {
-    S3ClientWrapper::GetInstance().GetObjectStr(name_, buffer_);
+    auto& client = S3ClientWrapper::GetInstance();
+    int64_t length = 0;
+    if (client.GetObjectLength(name_, length).ok() && length > S3_PART_SIZE) {
+        if (GetParts(length)) {
+            return;
+        }
+        STORAGE_LOG_WARNING << "Failed to get '" << name_ << "' in parts, get it whole";
+    }
+    client.GetObjectStr(name_, buffer_);
+}
+
+bool
+S3IOReader::GetParts(int64_t length) {
+    // the buffer is sized once, every ranged request reads its part into place
+    buffer_.resize(length);
+    int64_t part_num = (length + S3_PART_SIZE - 1) / S3_PART_SIZE;
+    std::atomic<int64_t> next_part(0);
+    std::atomic<bool> ok(true);
+    auto get_parts = [&]() {
+        for (int64_t part = next_part++; part < part_num && ok; part = next_part++) {
+            int64_t offset = part * S3_PART_SIZE;
+            int64_t size = std::min(S3_PART_SIZE, length - offset);
+            if (!S3ClientWrapper::GetInstance().GetObjectRange(name_, offset, size, &buffer_[offset]).ok()) {
+                ok = false;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int64_t i = 1; i < std::min(S3_PARALLEL_NUM, part_num); ++i) {
+        threads.emplace_back(get_parts);
+    }
+    get_parts();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (!ok) {
+        buffer_.clear();
+    }
+    return ok;
 }
 
 S3IOReader::~S3IOReader() {
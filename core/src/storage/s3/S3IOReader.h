@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include "storage/IOReader.h"
 
@@ -31,6 +32,11 @@ class S3IOReader : public IOReader {
     size_t
     length() override;
 
+ private:
+    // large objects are got by parallel ranged requests, return false if any of them fails
+    bool
+    GetParts(int64_t length);
+
  public:
     std::string buffer_;
     size_t pos_;
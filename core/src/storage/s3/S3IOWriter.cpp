@@ -11,6 +11,9 @@
 
 #include "storage/s3/S3IOWriter.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "utils/Log.h"
+
+#include <utility>
 
 namespace milvus {
 namespace storage {
@@ -20,13 +23,97 @@ S3IOWriter::S3IOWriter(const std::string& name) : IOWriter(name) {
 }
 
 S3IOWriter::~S3IOWriter() {
-    S3ClientWrapper::GetInstance().PutObjectStr(name_, buffer_);
+    if (!closed_) {
+        close();
+    }
 }
 
 void
 S3IOWriter::write(void* ptr, size_t size) {
-    buffer_ += std::string(reinterpret_cast<char*>(ptr), size);
+    auto data = reinterpret_cast<char*>(ptr);
     len_ += size;
+    if (multipart_failed_) {
+        buffer_.append(data, size);
+        return;
+    }
+
+    // the file is streamed in parts, only the ones in flight are held in memory
+    while (buffer_.size() + size >= static_cast<size_t>(S3_PART_SIZE)) {
+        size_t fill = S3_PART_SIZE - buffer_.size();
+        buffer_.append(data, fill);
+        data += fill;
+        size -= fill;
+        UploadBuffer();
+        if (multipart_failed_) {
+            break;
+        }
+    }
+    buffer_.append(data, size);
+}
+
+void
+S3IOWriter::UploadBuffer() {
+    if (upload_id_.empty() && !S3ClientWrapper::GetInstance().CreateMultipartUpload(name_, upload_id_).ok()) {
+        STORAGE_LOG_WARNING << "Failed to upload '" << name_ << "' in parts, upload it whole";
+        multipart_failed_ = true;
+        return;
+    }
+
+    if (parts_.size() >= static_cast<size_t>(S3_PARALLEL_NUM)) {
+        parts_[parts_.size() - S3_PARALLEL_NUM].wait();
+    }
+
+    int64_t part_number = parts_.size() + 1;
+    std::string upload_id = upload_id_;
+    std::string name = name_;
+    auto upload = [name, upload_id, part_number](std::string content) {
+        std::string etag;
+        if (!S3ClientWrapper::GetInstance().UploadPart(name, upload_id, part_number, content, etag).ok()) {
+            etag.clear();
+        }
+        return etag;
+    };
+    parts_.push_back(std::async(std::launch::async, upload, std::move(buffer_)));
+    buffer_.clear();
+}
+
+Status
+S3IOWriter::Complete() {
+    auto& client = S3ClientWrapper::GetInstance();
+    if (upload_id_.empty()) {
+        auto status = client.PutObjectStr(name_, buffer_);
+        if (!status.ok()) {
+            STORAGE_LOG_ERROR << "Failed to upload '" << name_ << "': " << status.message();
+        }
+        return status;
+    }
+
+    if (!multipart_failed_ && !buffer_.empty()) {
+        UploadBuffer();
+    }
+
+    std::vector<std::string> etags;
+    for (auto& part : parts_) {
+        etags.push_back(part.get());
+        if (etags.back().empty()) {
+            multipart_failed_ = true;
+        }
+    }
+
+    // parts uploaded are dropped, the object is never written
+    if (multipart_failed_) {
+        std::string msg = "Failed to upload '" + name_ + "' in parts";
+        STORAGE_LOG_ERROR << msg;
+        client.AbortMultipartUpload(name_, upload_id_);
+        return Status(SERVER_UNEXPECTED_ERROR, msg);
+    }
+
+    auto status = client.CompleteMultipartUpload(name_, upload_id_, etags);
+    if (!status.ok()) {
+        STORAGE_LOG_ERROR << "Failed to complete upload of '" << name_ << "': " << status.message();
+        client.AbortMultipartUpload(name_, upload_id_);
+    }
+    return status;
 }
 
 size_t
@@ -34,5 +121,11 @@ S3IOWriter::length() {
     return len_;
 }
 
+Status
+S3IOWriter::close() {
+    closed_ = true;
+    return Complete();
+}
+
 }  // namespace storage
 }  // namespace milvus
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include <future>
 #include <string>
+#include <vector>
 #include "storage/IOWriter.h"
 
 namespace milvus {
@@ -28,8 +30,28 @@ class S3IOWriter : public IOWriter {
     size_t
     length() override;
 
+    Status
+    close() override;
+
+ private:
+    // upload the buffer as the next part, at most S3_PARALLEL_NUM parts are in flight
+    void
+    UploadBuffer();
+
+    // put the buffer whole, or the parts together, a failed part aborts the upload
+    Status
+    Complete();
+
  public:
+    // data not uploaded yet, a part at most unless the object can't be uploaded in parts
     std::string buffer_;
+
+ private:
+    std::string upload_id_;
+    bool multipart_failed_ = false;
+    bool closed_ = false;
+    // etag of each part, empty if the part failed
+    std::vector<std::future<std::string>> parts_;
 };
 
 }  // namespace storage
@@ -16,7 +16,8 @@
 namespace milvus {
 namespace tracing {
 
-TraceContext::TraceContext(std::unique_ptr<opentracing::Span>& span) : span_(std::move(span)) {
+TraceContext::TraceContext(std::unique_ptr<opentracing::Span>& span, bool sampled)
+    : span_(std::move(span)), sampled_(sampled) {
 }
 
 std::unique_ptr<TraceContext>
@@ -36,5 +37,10 @@ TraceContext::GetSpan() const {
     return span_;
 }
 
+bool
+TraceContext::IsSampled() const {
+    return sampled_;
+}
+
 }  // namespace tracing
 }  // namespace milvus
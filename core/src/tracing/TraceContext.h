@@ -21,7 +21,8 @@ namespace tracing {
 
 class TraceContext {
  public:
-    explicit TraceContext(std::unique_ptr<opentracing::Span>& span);
+    // an unsampled context holds a no-op span, contexts derived from it share it instead of starting spans
+    explicit TraceContext(std::unique_ptr<opentracing::Span>& span, bool sampled = true);
 
     std::unique_ptr<TraceContext>
     Child(const std::string& operation_name) const;
@@ -32,9 +33,13 @@ class TraceContext {
     const std::unique_ptr<opentracing::Span>&
     GetSpan() const;
 
+    bool
+    IsSampled() const;
+
  private:
     //    std::unique_ptr<opentracing::SpanContext> span_context_;
     std::unique_ptr<opentracing::Span> span_;
+    bool sampled_;
 };
 
 }  // namespace tracing
@@ -23,6 +23,7 @@ namespace milvus {
 namespace tracing {
 
 const char* TracerUtil::tracer_context_header_name_;
+bool TracerUtil::tracer_loaded_ = false;
 
 void
 TracerUtil::InitGlobal(const std::string& config_path) {
@@ -66,6 +67,7 @@ TracerUtil::LoadConfig(const std::string& config_path) {
     auto& tracer = *tracer_maybe;
 
     opentracing::Tracer::InitGlobal(tracer);
+    tracer_loaded_ = true;
 }
 
 std::string
@@ -73,5 +75,10 @@ TracerUtil::GetTraceContextHeaderName() {
     return tracer_context_header_name_;
 }
 
+bool
+TracerUtil::IsTracerLoaded() {
+    return tracer_loaded_;
+}
+
 }  // namespace tracing
 }  // namespace milvus
@@ -28,11 +28,16 @@ class TracerUtil {
     static std::string
     GetTraceContextHeaderName();
 
+    // false while the global tracer is the default no-op one
+    static bool
+    IsTracerLoaded();
+
  private:
     static void
     LoadConfig(const std::string& config_path);
 
     static const char* tracer_context_header_name_;
+    static bool tracer_loaded_;
 };
 
 }  // namespace tracing
@@ -13,6 +13,7 @@
 
 #include <assert.h>
 #include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <queue>
 #include <vector>
@@ -34,9 +35,17 @@ class BlockingQueue {
     void
     Put(const T& task);
 
+    // false at once if the queue is full
+    bool
+    TryPut(const T& task);
+
     T
     Take();
 
+    // take the front only if the predicate accepts it, false at once if the queue is empty
+    bool
+    TakeIf(const std::function<bool(const T&)>& pred, T& task);
+
     T
     Front();
 
@@ -24,6 +24,19 @@ BlockingQueue<T>::Put(const T& task) {
     empty_.notify_all();
 }
 
+template <typename T>
+bool
+BlockingQueue<T>::TryPut(const T& task) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (queue_.size() >= capacity_) {
+        return false;
+    }
+
+    queue_.push(task);
+    empty_.notify_all();
+    return true;
+}
+
 template <typename T>
 T
 BlockingQueue<T>::Take() {
@@ -36,6 +49,20 @@ BlockingQueue<T>::Take() {
     return front;
 }
 
+template <typename T>
+bool
+BlockingQueue<T>::TakeIf(const std::function<bool(const T&)>& pred, T& task) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (queue_.empty() || !pred(queue_.front())) {
+        return false;
+    }
+
+    task = queue_.front();
+    queue_.pop();
+    full_.notify_all();
+    return true;
+}
+
 template <typename T>
 size_t
 BlockingQueue<T>::Size() {
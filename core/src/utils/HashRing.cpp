@@ -0,0 +1,131 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "utils/HashRing.h"
+
+#include <array>
+#include <cstring>
+
+namespace milvus {
+namespace server {
+
+namespace {
+
+using Digest = std::array<uint8_t, 16>;
+
+// RFC 1321 md5, the ring has to hash keys exactly like mishards
+Digest
+Md5(const std::string& input) {
+    static const uint32_t K[64] = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+    static const uint32_t S[64] = {7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+                                   5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+                                   4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+                                   6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+    std::string message = input;
+    uint64_t bit_length = static_cast<uint64_t>(input.size()) * 8;
+    message.push_back(static_cast<char>(0x80));
+    while (message.size() % 64 != 56) {
+        message.push_back(0);
+    }
+    for (int i = 0; i < 8; ++i) {
+        message.push_back(static_cast<char>((bit_length >> (8 * i)) & 0xff));
+    }
+
+    uint32_t h[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+    for (size_t offset = 0; offset < message.size(); offset += 64) {
+        uint32_t m[16];
+        for (int i = 0; i < 16; ++i) {
+            auto p = reinterpret_cast<const uint8_t*>(message.data() + offset + i * 4);
+            m[i] = p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+        for (uint32_t i = 0; i < 64; ++i) {
+            uint32_t f, g;
+            if (i < 16) {
+                f = (b & c) | (~b & d);
+                g = i;
+            } else if (i < 32) {
+                f = (d & b) | (~d & c);
+                g = (5 * i + 1) % 16;
+            } else if (i < 48) {
+                f = b ^ c ^ d;
+                g = (3 * i + 5) % 16;
+            } else {
+                f = c ^ (b | ~d);
+                g = (7 * i) % 16;
+            }
+            uint32_t rotated = a + f + K[i] + m[g];
+            a = d;
+            d = c;
+            c = b;
+            b = b + ((rotated << S[i]) | (rotated >> (32 - S[i])));
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+    }
+
+    Digest digest;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            digest[i * 4 + j] = static_cast<uint8_t>((h[i] >> (8 * j)) & 0xff);
+        }
+    }
+    return digest;
+}
+
+uint32_t
+HashValue(const Digest& digest, int offset) {
+    return (static_cast<uint32_t>(digest[offset + 3]) << 24) | (digest[offset + 2] << 16) |
+           (digest[offset + 1] << 8) | digest[offset];
+}
+
+}  // namespace
+
+HashRing::HashRing(const std::vector<std::string>& nodes) {
+    // 40 virtual nodes per node, 3 points of each virtual node
+    for (auto& node : nodes) {
+        for (int j = 0; j < 40; ++j) {
+            Digest digest = Md5(node + "-" + std::to_string(j));
+            for (int i = 0; i < 3; ++i) {
+                ring_[HashValue(digest, i * 4)] = node;
+            }
+        }
+    }
+}
+
+const std::string&
+HashRing::GetNode(const std::string& key) const {
+    if (ring_.empty()) {
+        return none_;
+    }
+
+    auto iter = ring_.upper_bound(HashValue(Md5(key), 0));
+    if (iter == ring_.end()) {
+        iter = ring_.begin();
+    }
+    return iter->second;
+}
+
+}  // namespace server
+}  // namespace milvus
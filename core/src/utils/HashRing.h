@@ -0,0 +1,41 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+/**
+ * Consistent hash ring of nodes, the same as shards/mishards/hash_ring.py with equal weights,
+ * so that a key is owned by the node mishards routes it to.
+ */
+class HashRing {
+ public:
+    explicit HashRing(const std::vector<std::string>& nodes);
+
+    // node owning the key, empty if there is no node
+    const std::string&
+    GetNode(const std::string& key) const;
+
+ private:
+    std::map<uint32_t, std::string> ring_;
+    std::string none_;
+};
+
+}  // namespace server
+}  // namespace milvus
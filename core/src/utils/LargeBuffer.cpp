@@ -0,0 +1,129 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "utils/LargeBuffer.h"
+
+#include <sys/mman.h>
+#include <atomic>
+#include <initializer_list>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace milvus {
+
+namespace {
+
+// malloc_trim walks the whole heap, it runs once this much is released
+constexpr int64_t TRIM_RELEASED_BYTES = 256L * 1024 * 1024;
+
+std::atomic<int64_t> released_since_trim{0};
+std::atomic<HugePageMode> huge_page_mode{HugePageMode::THP};
+
+// mapping of reserved huge pages of page_size, nullptr if none is free
+void*
+MapHugeTLB(size_t size, size_t page_size) {
+#ifdef MAP_HUGETLB
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+    // log2 of the page size, 21 for 2MB and 30 for 1GB
+    int shift = 0;
+    while ((1UL << shift) < page_size) {
+        shift++;
+    }
+    flags |= shift << MAP_HUGE_SHIFT;
+#endif
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return ptr != MAP_FAILED ? ptr : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+std::shared_ptr<uint8_t>
+MappedBuffer(void* ptr, size_t length) {
+    return std::shared_ptr<uint8_t>(static_cast<uint8_t*>(ptr), [length](uint8_t* p) { munmap(p, length); });
+}
+
+}  // namespace
+
+void
+SetHugePageMode(HugePageMode mode) {
+    huge_page_mode = mode;
+}
+
+HugePageMode
+GetHugePageMode() {
+    return huge_page_mode;
+}
+
+std::shared_ptr<uint8_t>
+AllocLargeBuffer(size_t size) {
+    if (size >= LARGE_BUFFER_SIZE) {
+        HugePageMode mode = huge_page_mode;
+        if (mode == HugePageMode::HUGETLB) {
+            // a mapping of huge pages is a whole number of them, a page size wasting over 1/8 of it is skipped
+            for (size_t page_size : {GIGANTIC_PAGE_SIZE, HUGE_PAGE_SIZE}) {
+                size_t length = (size + page_size - 1) / page_size * page_size;
+                if (size < page_size || (length - size) * 8 > size) {
+                    continue;
+                }
+                void* ptr = MapHugeTLB(length, page_size);
+                if (ptr != nullptr) {
+                    return MappedBuffer(ptr, length);
+                }
+            }
+        }
+
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr != MAP_FAILED) {
+            if (mode != HugePageMode::OFF) {
+                AdviseHugePages(ptr, size);
+            }
+            return MappedBuffer(ptr, size);
+        }
+    }
+
+    return std::shared_ptr<uint8_t>(new uint8_t[size], std::default_delete<uint8_t[]>());
+}
+
+void
+AdviseHugePages(const void* ptr, size_t size) {
+#ifdef MADV_HUGEPAGE
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(HUGE_PAGE_SIZE - 1);
+    if (ptr != nullptr && begin < end) {
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+void
+ConfigureLargeAllocations() {
+#ifdef __GLIBC__
+    mallopt(M_MMAP_THRESHOLD, LARGE_BUFFER_SIZE);
+#endif
+}
+
+void
+ReleaseFreeMemory(int64_t released_bytes) {
+    if (released_since_trim.fetch_add(released_bytes) + released_bytes < TRIM_RELEASED_BYTES) {
+        return;
+    }
+
+    released_since_trim = 0;
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+}  // namespace milvus
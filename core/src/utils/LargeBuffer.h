@@ -0,0 +1,75 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace milvus {
+
+// buffers from this size on are mapped from the os directly
+constexpr size_t LARGE_BUFFER_SIZE = 4UL * 1024 * 1024;
+constexpr size_t HUGE_PAGE_SIZE = 2UL * 1024 * 1024;
+constexpr size_t GIGANTIC_PAGE_SIZE = 1024UL * 1024 * 1024;
+
+/*
+ * Pages backing index data, cache_config.cpu_cache_huge_page;
+ * Scans of tens of GB miss the TLB on nearly every 4KB page, a 2MB page covers 512 of them;
+ * OFF: 4KB pages;
+ * THP: transparent huge pages, advised on the buffers and collapsed by the kernel, no reservation needed;
+ * HUGETLB: buffers mapped from the pages reserved in /proc/sys/vm/nr_hugepages, 1GB pages for buffers of 1GB and
+ *          up if reserved too, THP if none is free; data faiss allocates itself can't be moved there, it gets THP;
+ */
+enum class HugePageMode {
+    OFF,
+    THP,
+    HUGETLB,
+};
+
+void
+SetHugePageMode(HugePageMode mode);
+
+HugePageMode
+GetHugePageMode();
+
+/*
+ * Buffer for index data read or built, a large one is an anonymous mapping backed by huge pages as the mode asks
+ * and unmapped once released, so its pages are given back to the os rather than kept by malloc in a fragmented heap;
+ * A small one or one the os can't map is allocated by new[];
+ */
+std::shared_ptr<uint8_t>
+AllocLargeBuffer(size_t size);
+
+/*
+ * Advise transparent huge pages for the 2MB pages entirely within the range, whatever allocated it;
+ * Ranges shorter than a huge page are left alone;
+ */
+void
+AdviseHugePages(const void* ptr, size_t size);
+
+/*
+ * Make glibc malloc serve large allocations by mmap whatever was freed before, faiss keeps index data in std::vector
+ * and glibc would otherwise raise its mmap threshold up to 32MB after the first large free;
+ * Called once at start, it is a no-op with jemalloc or tcmalloc, which return freed pages on their own;
+ */
+void
+ConfigureLargeAllocations();
+
+/*
+ * Account bytes released by the cpu cache, free pages of the malloc heap are given back to the os once
+ * enough of them are released since the last time;
+ */
+void
+ReleaseFreeMemory(int64_t released_bytes);
+
+}  // namespace milvus
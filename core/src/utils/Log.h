@@ -13,13 +13,42 @@
 
 #include "easyloggingpp/easylogging++.h"
 
+#include <atomic>
+
 namespace milvus {
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// trace and debug statements are checked against the levels the log config enables before they evaluate
+// anything they stream, InitLog() sets the switches, both are on until then as in easylogging
+inline std::atomic<bool>&
+LogTraceSwitch() {
+    static std::atomic<bool> s_on(true);
+    return s_on;
+}
+
+inline std::atomic<bool>&
+LogDebugSwitch() {
+    static std::atomic<bool> s_on(true);
+    return s_on;
+}
+
+// turns a log statement into void, so that it fits a branch of the conditional of MILVUS_LOG_IF
+struct LogVoidify {
+    template <typename T>
+    void
+    operator&(T&) {
+    }
+};
+
+#define MILVUS_LOG_IF(on) !(on) ? (void)0 : ::milvus::LogVoidify() &
+#define MILVUS_LOG_TRACE MILVUS_LOG_IF(::milvus::LogTraceSwitch().load(std::memory_order_relaxed)) LOG(TRACE)
+#define MILVUS_LOG_DEBUG MILVUS_LOG_IF(::milvus::LogDebugSwitch().load(std::memory_order_relaxed)) LOG(DEBUG)
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define SERVER_DOMAIN_NAME "[SERVER] "
 
-#define SERVER_LOG_TRACE LOG(TRACE) << SERVER_DOMAIN_NAME
-#define SERVER_LOG_DEBUG LOG(DEBUG) << SERVER_DOMAIN_NAME
+#define SERVER_LOG_TRACE MILVUS_LOG_TRACE << SERVER_DOMAIN_NAME
+#define SERVER_LOG_DEBUG MILVUS_LOG_DEBUG << SERVER_DOMAIN_NAME
 #define SERVER_LOG_INFO LOG(INFO) << SERVER_DOMAIN_NAME
 #define SERVER_LOG_WARNING LOG(WARNING) << SERVER_DOMAIN_NAME
 #define SERVER_LOG_ERROR LOG(ERROR) << SERVER_DOMAIN_NAME
@@ -28,8 +57,8 @@ namespace milvus {
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define ENGINE_DOMAIN_NAME "[ENGINE] "
 
-#define ENGINE_LOG_TRACE LOG(TRACE) << ENGINE_DOMAIN_NAME
-#define ENGINE_LOG_DEBUG LOG(DEBUG) << ENGINE_DOMAIN_NAME
+#define ENGINE_LOG_TRACE MILVUS_LOG_TRACE << ENGINE_DOMAIN_NAME
+#define ENGINE_LOG_DEBUG MILVUS_LOG_DEBUG << ENGINE_DOMAIN_NAME
 #define ENGINE_LOG_INFO LOG(INFO) << ENGINE_DOMAIN_NAME
 #define ENGINE_LOG_WARNING LOG(WARNING) << ENGINE_DOMAIN_NAME
 #define ENGINE_LOG_ERROR LOG(ERROR) << ENGINE_DOMAIN_NAME
@@ -38,8 +67,8 @@ namespace milvus {
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define WRAPPER_DOMAIN_NAME "[WRAPPER] "
 
-#define WRAPPER_LOG_TRACE LOG(TRACE) << WRAPPER_DOMAIN_NAME
-#define WRAPPER_LOG_DEBUG LOG(DEBUG) << WRAPPER_DOMAIN_NAME
+#define WRAPPER_LOG_TRACE MILVUS_LOG_TRACE << WRAPPER_DOMAIN_NAME
+#define WRAPPER_LOG_DEBUG MILVUS_LOG_DEBUG << WRAPPER_DOMAIN_NAME
 #define WRAPPER_LOG_INFO LOG(INFO) << WRAPPER_DOMAIN_NAME
 #define WRAPPER_LOG_WARNING LOG(WARNING) << WRAPPER_DOMAIN_NAME
 #define WRAPPER_LOG_ERROR LOG(ERROR) << WRAPPER_DOMAIN_NAME
@@ -48,8 +77,8 @@ namespace milvus {
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define STORAGE_DOMAIN_NAME "[STORAGE] "
 
-#define STORAGE_LOG_TRACE LOG(TRACE) << STORAGE_DOMAIN_NAME
-#define STORAGE_LOG_DEBUG LOG(DEBUG) << STORAGE_DOMAIN_NAME
+#define STORAGE_LOG_TRACE MILVUS_LOG_TRACE << STORAGE_DOMAIN_NAME
+#define STORAGE_LOG_DEBUG MILVUS_LOG_DEBUG << STORAGE_DOMAIN_NAME
 #define STORAGE_LOG_INFO LOG(INFO) << STORAGE_DOMAIN_NAME
 #define STORAGE_LOG_WARNING LOG(WARNING) << STORAGE_DOMAIN_NAME
 #define STORAGE_LOG_ERROR LOG(ERROR) << STORAGE_DOMAIN_NAME
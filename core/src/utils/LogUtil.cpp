@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "utils/LogUtil.h"
+#include "utils/Log.h"
 
 #include <ctype.h>
 #include <libgen.h>
@@ -79,6 +80,12 @@ InitLog(const std::string& log_config_file) {
     el::Configurations conf(log_config_file);
     el::Loggers::reconfigureAllLoggers(conf);
 
+    auto logger = el::Loggers::getLogger("default");
+    if (logger != nullptr) {
+        LogTraceSwitch() = logger->enabled(el::Level::Trace);
+        LogDebugSwitch() = logger->enabled(el::Level::Debug);
+    }
+
     el::Loggers::addFlag(el::LoggingFlag::StrictLogFileSizeCheck);
     el::Helpers::installPreRollOutCallback(RolloutHandler);
     el::Loggers::addFlag(el::LoggingFlag::DisableApplicationAbortOnFatalLog);
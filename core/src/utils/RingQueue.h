@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace milvus {
+namespace server {
+
+/*
+ * Bounded queue of many producers and many consumers, put and take claim a slot of a ring with one atomic each and
+ * never lock while the queue is neither full nor empty;
+ * A blocking put or take spins a while on a full or empty queue, then parks on a condition variable, the mutex is
+ * touched by the other side only if someone is parked;
+ * Unlike BlockingQueue, the capacity is fixed at construction, rounded up to a power of two, and there is no peek;
+ */
+template <typename T>
+class RingQueue {
+ public:
+    explicit RingQueue(size_t capacity);
+
+    RingQueue(const RingQueue& rhs) = delete;
+
+    RingQueue&
+    operator=(const RingQueue& rhs) = delete;
+
+    // wait while the queue is full, false if the queue is closed
+    bool
+    Put(T&& item);
+
+    // false at once if the queue is full or closed
+    bool
+    TryPut(T&& item);
+
+    // wait while the queue is empty, false if the queue is closed and empty
+    bool
+    Take(T& item);
+
+    // false at once if the queue is empty
+    bool
+    TryTake(T& item);
+
+    // puts fail from now on, takes drain the items left and then fail, parked callers wake up
+    void
+    Close();
+
+    // exact only while no one puts or takes
+    size_t
+    Size() const;
+
+    bool
+    Empty() const;
+
+    size_t
+    Capacity() const;
+
+ private:
+    // rounds a blocking call checks the queue again before it parks
+    static constexpr int SPIN_ROUNDS = 64;
+
+    struct Slot {
+        std::atomic<size_t> sequence_;
+        T item_;
+    };
+
+    // spin then park until ready() is true or the queue is closed
+    template <typename Ready>
+    void
+    Wait(std::atomic<int64_t>& waiters, std::condition_variable& cond, const Ready& ready);
+
+    void
+    Wake(std::atomic<int64_t>& waiters, std::condition_variable& cond);
+
+ private:
+    size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // put and take positions apart, so that producers and consumers don't share a cache line
+    alignas(64) std::atomic<size_t> put_pos_{0};
+    alignas(64) std::atomic<size_t> take_pos_{0};
+
+    alignas(64) std::atomic<bool> closed_{false};
+    std::atomic<int64_t> put_waiters_{0};
+    std::atomic<int64_t> take_waiters_{0};
+    std::mutex park_mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+}  // namespace server
+}  // namespace milvus
+
+#include "./RingQueue.inl"
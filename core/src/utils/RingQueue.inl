@@ -0,0 +1,191 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <thread>
+#include <utility>
+
+namespace milvus {
+namespace server {
+
+// a slot is free for the put of position pos once its sequence is pos, and holds the item of pos for the take once
+// its sequence is pos + 1
+template <typename T>
+RingQueue<T>::RingQueue(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    mask_ = size - 1;
+    slots_.reset(new Slot[size]);
+    for (size_t i = 0; i < size; i++) {
+        slots_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool
+RingQueue<T>::Put(T&& item) {
+    while (!closed_.load()) {
+        if (TryPut(std::move(item))) {
+            return true;
+        }
+        Wait(put_waiters_, not_full_, [this]() {
+            size_t pos = put_pos_.load(std::memory_order_relaxed);
+            auto& slot = slots_[pos & mask_];
+            return static_cast<int64_t>(slot.sequence_.load(std::memory_order_acquire) - pos) >= 0;
+        });
+    }
+    return false;
+}
+
+template <typename T>
+bool
+RingQueue<T>::TryPut(T&& item) {
+    if (closed_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    size_t pos = put_pos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence_.load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequence - pos);
+        if (diff == 0) {
+            if (put_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the slot still holds the item of a lap ago
+            return false;
+        } else {
+            pos = put_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->item_ = std::move(item);
+    slot->sequence_.store(pos + 1, std::memory_order_release);
+    Wake(take_waiters_, not_empty_);
+    return true;
+}
+
+template <typename T>
+bool
+RingQueue<T>::Take(T& item) {
+    while (true) {
+        if (TryTake(item)) {
+            return true;
+        }
+        if (closed_.load()) {
+            // an item put right before the close is still taken
+            return TryTake(item);
+        }
+        Wait(take_waiters_, not_empty_, [this]() {
+            size_t pos = take_pos_.load(std::memory_order_relaxed);
+            auto& slot = slots_[pos & mask_];
+            return static_cast<int64_t>(slot.sequence_.load(std::memory_order_acquire) - (pos + 1)) >= 0;
+        });
+    }
+}
+
+template <typename T>
+bool
+RingQueue<T>::TryTake(T& item) {
+    size_t pos = take_pos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &slots_[pos & mask_];
+        size_t sequence = slot->sequence_.load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequence - (pos + 1));
+        if (diff == 0) {
+            if (take_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = take_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    item = std::move(slot->item_);
+    slot->item_ = T();
+    slot->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+    Wake(put_waiters_, not_full_);
+    return true;
+}
+
+template <typename T>
+void
+RingQueue<T>::Close() {
+    closed_.store(true);
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    not_full_.notify_all();
+    not_empty_.notify_all();
+}
+
+template <typename T>
+size_t
+RingQueue<T>::Size() const {
+    size_t take = take_pos_.load();
+    size_t put = put_pos_.load();
+    return put > take ? put - take : 0;
+}
+
+template <typename T>
+bool
+RingQueue<T>::Empty() const {
+    return Size() == 0;
+}
+
+template <typename T>
+size_t
+RingQueue<T>::Capacity() const {
+    return mask_ + 1;
+}
+
+template <typename T>
+template <typename Ready>
+void
+RingQueue<T>::Wait(std::atomic<int64_t>& waiters, std::condition_variable& cond, const Ready& ready) {
+    for (int i = 0; i < SPIN_ROUNDS; i++) {
+        if (ready() || closed_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    // the waiter is counted before the queue is checked again, the other side checks the count after its change,
+    // so either the check here sees the change or the other side sees the waiter and notifies
+    waiters.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(park_mutex_);
+        cond.wait(lock, [&]() { return ready() || closed_.load(); });
+    }
+    waiters.fetch_sub(1);
+}
+
+template <typename T>
+void
+RingQueue<T>::Wake(std::atomic<int64_t>& waiters, std::condition_variable& cond) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) > 0) {
+        // taken so that a waiter between its check and its wait doesn't miss the notify
+        { std::lock_guard<std::mutex> lock(park_mutex_); }
+        cond.notify_one();
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -12,12 +12,21 @@
 #include "utils/StringHelpFunctions.h"
 
 #include <fiu-local.h>
+#include <mutex>
 #include <regex>
 #include <string>
+#include <unordered_map>
 
 namespace milvus {
 namespace server {
 
+namespace {
+
+// patterns come from partition tags of requests, the cache is cleared as a whole once it grows this large
+constexpr size_t MAX_CACHED_REGEX = 1024;
+
+}  // namespace
+
 void
 StringHelpFunctions::TrimStringBlank(std::string& string) {
     if (!string.empty()) {
@@ -146,13 +155,40 @@ StringHelpFunctions::IsRegexMatch(const std::string& target_str, const std::stri
     }
 
     // regex match
-    std::regex pattern(pattern_str);
-    std::smatch results;
-    if (std::regex_match(target_str, results, pattern)) {
-        return true;
-    } else {
+    auto pattern = CompileRegex(pattern_str);
+    if (pattern == nullptr) {
         return false;
     }
+    return std::regex_match(target_str, *pattern);
+}
+
+std::shared_ptr<const std::regex>
+StringHelpFunctions::CompileRegex(const std::string& pattern) {
+    static std::mutex s_mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const std::regex>> s_compiled;
+
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto iter = s_compiled.find(pattern);
+        if (iter != s_compiled.end()) {
+            return iter->second;
+        }
+    }
+
+    // compiled out of the lock, two callers of a new pattern may both compile it
+    std::shared_ptr<const std::regex> compiled;
+    try {
+        compiled = std::make_shared<const std::regex>(pattern);
+    } catch (std::regex_error&) {
+        compiled = nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (s_compiled.size() >= MAX_CACHED_REGEX) {
+        s_compiled.clear();
+    }
+    s_compiled[pattern] = compiled;
+    return compiled;
 }
 
 }  // namespace server
@@ -13,6 +13,8 @@
 
 #include "utils/Status.h"
 
+#include <memory>
+#include <regex>
 #include <string>
 #include <vector>
 
@@ -64,6 +66,10 @@ class StringHelpFunctions {
     // regex grammar reference: http://www.cplusplus.com/reference/regex/ECMAScript/
     static bool
     IsRegexMatch(const std::string& target_str, const std::string& pattern);
+
+    // compiled pattern shared by the callers of the same pattern, nullptr if the pattern is not a valid regex
+    static std::shared_ptr<const std::regex>
+    CompileRegex(const std::string& pattern);
 };
 
 }  // namespace server
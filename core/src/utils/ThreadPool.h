@@ -11,13 +11,14 @@
 
 #pragma once
 
+#include "utils/RingQueue.h"
+
 #include <fiu-local.h>
-#include <condition_variable>
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <future>
 #include <memory>
-#include <mutex>
-#include <queue>
 #include <stdexcept>
 #include <thread>
 #include <utility>
@@ -27,6 +28,8 @@
 
 namespace milvus {
 
+// workers take tasks from a lock free ring, an idle worker parks only after spinning a while, so that a burst of
+// short tasks, as the reduce and prefetch of a search, is handed over without a lock
 class ThreadPool {
  public:
     explicit ThreadPool(size_t threads, size_t queue_size = 1000);
@@ -35,43 +38,32 @@ class ThreadPool {
     auto
     enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type>;
 
+    // false at once if the queue is full or the pool is stopped, the task is not run then
+    bool
+    try_enqueue(std::function<void()> task);
+
     ~ThreadPool();
 
  private:
     // need to keep track of threads so we can join them
     std::vector<std::thread> workers_;
 
-    // the task queue
-    std::queue<std::function<void()> > tasks_;
-
-    size_t max_queue_size_;
-
-    // synchronization
-    std::mutex queue_mutex_;
-
-    std::condition_variable condition_;
+    // the task queue, enqueue waits while it holds queue_size tasks
+    server::RingQueue<std::function<void()>> tasks_;
 
-    bool stop;
+    std::atomic<bool> stop;
 };
 
 // the constructor just launches some amount of workers
-inline ThreadPool::ThreadPool(size_t threads, size_t queue_size) : max_queue_size_(queue_size), stop(false) {
+inline ThreadPool::ThreadPool(size_t threads, size_t queue_size)
+    : tasks_(std::max<size_t>(queue_size, 1)), stop(false) {
     for (size_t i = 0; i < threads; ++i)
         workers_.emplace_back([this] {
-            for (;;) {
-                std::function<void()> task;
-
-                {
-                    std::unique_lock<std::mutex> lock(this->queue_mutex_);
-                    this->condition_.wait(lock, [this] { return this->stop || !this->tasks_.empty(); });
-                    if (this->stop && this->tasks_.empty())
-                        return;
-                    task = std::move(this->tasks_.front());
-                    this->tasks_.pop();
-                }
-                this->condition_.notify_all();
-
+            std::function<void()> task;
+            // fails once the pool is stopped and no task is left
+            while (this->tasks_.Take(task)) {
                 task();
+                task = nullptr;
             }
         });
 }
@@ -86,26 +78,24 @@ ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<typename std::result_o
         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
     fiu_do_on("ThreadPool.enqueue.stop_is_true", stop = true);
     std::future<return_type> res = task->get_future();
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        this->condition_.wait(lock, [this] { return this->tasks_.size() < max_queue_size_; });
-        // don't allow enqueueing after stopping the pool
-        if (stop)
-            throw std::runtime_error("enqueue on stopped ThreadPool");
-
-        tasks_.emplace([task]() { (*task)(); });
+
+    // don't allow enqueueing after stopping the pool
+    if (stop || !tasks_.Put([task]() { (*task)(); })) {
+        throw std::runtime_error("enqueue on stopped ThreadPool");
     }
-    condition_.notify_all();
     return res;
 }
 
+// add new work item to the pool without waiting for room
+inline bool
+ThreadPool::try_enqueue(std::function<void()> task) {
+    return !stop && tasks_.TryPut(std::move(task));
+}
+
 // the destructor joins all threads
 inline ThreadPool::~ThreadPool() {
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        stop = true;
-    }
-    condition_.notify_all();
+    stop = true;
+    tasks_.Close();
     for (std::thread& worker : workers_) {
         worker.join();
     }
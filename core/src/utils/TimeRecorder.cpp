@@ -28,8 +28,24 @@ TimeRecorder::GetTimeSpanStr(double span) {
     return str_sec + " [" + str_ms + "]";
 }
 
+bool
+TimeRecorder::Enabled() const {
+    switch (log_level_) {
+        case 0:
+            return LogTraceSwitch().load(std::memory_order_relaxed);
+        case 1:
+            return LogDebugSwitch().load(std::memory_order_relaxed);
+        default:
+            return true;
+    }
+}
+
 void
 TimeRecorder::PrintTimeRecord(const std::string& msg, double span) {
+    if (!Enabled()) {
+        return;
+    }
+
     std::string str_log;
     if (!header_.empty())
         str_log += header_ + ": ";
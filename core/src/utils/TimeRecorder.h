@@ -30,6 +30,10 @@ class TimeRecorder {
     double
     ElapseFromBegin(const std::string& msg);
 
+    // whether the records are logged, a caller skips building messages nobody reads
+    bool
+    Enabled() const;
+
     static std::string
     GetTimeSpanStr(double span);
 
@@ -159,9 +159,9 @@ ValidationUtil::IsBinaryMetricType(int32_t metric_type) {
 
 Status
 ValidationUtil::ValidateSearchTopk(int64_t top_k, const engine::meta::TableSchema& table_schema) {
-    if (top_k <= 0 || top_k > 2048) {
+    if (top_k <= 0 || top_k > 16384) {
         std::string msg =
-            "Invalid topk: " + std::to_string(top_k) + ". " + "The topk must be within the range of 1 ~ 2048.";
+            "Invalid topk: " + std::to_string(top_k) + ". " + "The topk must be within the range of 1 ~ 16384.";
         SERVER_LOG_ERROR << msg;
         return Status(SERVER_INVALID_TOPK, msg);
     }
@@ -362,7 +362,8 @@ ValidationUtil::ValidateDbURI(const std::string& uri) {
     if (std::regex_match(uri, pieces_match, uriRegex)) {
         std::string dialect = pieces_match[1].str();
         std::transform(dialect.begin(), dialect.end(), dialect.begin(), ::tolower);
-        if (dialect.find("mysql") == std::string::npos && dialect.find("sqlite") == std::string::npos) {
+        if (dialect.find("mysql") == std::string::npos && dialect.find("sqlite") == std::string::npos &&
+            dialect != "kv") {
             SERVER_LOG_ERROR << "Invalid dialect in URI: dialect = " << dialect;
             okay = false;
         }
@@ -125,6 +125,20 @@ BinVecImpl::CopyToCpu(const Config& cfg) {
     throw WrapperException("errmsg");
 }
 
+Status
+BinBFIndex::Reserve(int64_t n) {
+    try {
+        std::static_pointer_cast<knowhere::BinaryIDMAP>(index_)->Reserve(n);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
 ErrorCode
 BinBFIndex::Build(const Config& cfg) {
     try {
@@ -177,5 +191,15 @@ BinBFIndex::GetRawIds() {
     return std::static_pointer_cast<knowhere::BinaryIDMAP>(index_)->GetRawIds();
 }
 
+std::string
+BinBFIndex::StreamedBlockName() {
+    return "BinaryIVF";
+}
+
+void
+BinBFIndex::SerializeTo(faiss::IOWriter* writer) {
+    std::static_pointer_cast<knowhere::BinaryIDMAP>(index_)->SerializeTo(writer);
+}
+
 }  // namespace engine
 }  // namespace milvus
@@ -59,6 +59,15 @@ class BinBFIndex : public BinVecImpl {
 
     const int64_t*
     GetRawIds();
+
+    std::string
+    StreamedBlockName() override;
+
+    void
+    SerializeTo(faiss::IOWriter* writer) override;
+
+    Status
+    Reserve(int64_t n);
 };
 
 }  // namespace engine
@@ -0,0 +1,236 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "wrapper/BlasCalibration.h"
+#include "utils/Log.h"
+
+#include <faiss/utils/Heap.h>
+#include <faiss/utils/distances.h>
+#include <omp.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <random>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr int64_t CALIBRATION_TOPK = 10;
+constexpr int64_t CALIBRATION_MAX_NQ = 1024;
+constexpr int64_t CALIBRATION_MAX_FLOATS = 8 * 1024 * 1024;
+constexpr int64_t CALIBRATION_ROWS[] = {4096, 65536};
+
+double
+TimeSearch(bool use_blas, const float* queries, int64_t nq, const float* rows, int64_t row_count, int64_t dim) {
+    std::vector<int64_t> labels(nq * CALIBRATION_TOPK);
+    std::vector<float> distances(nq * CALIBRATION_TOPK);
+    faiss::float_maxheap_array_t res = {static_cast<size_t>(nq), static_cast<size_t>(CALIBRATION_TOPK),
+                                        labels.data(), distances.data()};
+
+    // best of two, the first run may pay for page faults
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < 2; i++) {
+        auto start = std::chrono::steady_clock::now();
+        faiss::knn_L2sqr_with(use_blas, queries, rows, dim, nq, row_count, &res);
+        std::chrono::duration<double> span = std::chrono::steady_clock::now() - start;
+        best = std::min(best, span.count());
+    }
+    return best;
+}
+
+// smallest power of two nq BLAS is not slower for, twice the largest nq measured if it never wins
+int64_t
+MeasureCrossover(int64_t dim, int64_t row_count, int64_t threads) {
+    std::mt19937 random(dim);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> rows(row_count * dim);
+    std::vector<float> queries(CALIBRATION_MAX_NQ * dim);
+    std::generate(rows.begin(), rows.end(), [&]() { return dist(random); });
+    std::generate(queries.begin(), queries.end(), [&]() { return dist(random); });
+
+    // the calibration runs in a thread of its own, its openmp setting affects no search
+    omp_set_num_threads(threads);
+    for (int64_t nq = 1; nq <= CALIBRATION_MAX_NQ; nq *= 2) {
+        double simd = TimeSearch(false, queries.data(), nq, rows.data(), row_count, dim);
+        double blas = TimeSearch(true, queries.data(), nq, rows.data(), row_count, dim);
+        if (blas <= simd) {
+            return nq;
+        }
+    }
+    return CALIBRATION_MAX_NQ * 2;
+}
+
+bool
+SelectBlas(size_t d, size_t nx, size_t ny) {
+    return BlasCalibration::GetInstance().UseBlas(d, nx, ny);
+}
+
+}  // namespace
+
+BlasCalibration::BlasCalibration() : crossovers_(std::make_shared<CrossoverMap>()) {
+}
+
+BlasCalibration&
+BlasCalibration::GetInstance() {
+    static BlasCalibration s_calibration;
+    return s_calibration;
+}
+
+Status
+BlasCalibration::Calibrate(const std::vector<int64_t>& dims, const std::vector<int64_t>& threads,
+                           const std::string& path) {
+    auto status = Load(path);
+    if (!status.ok() && status.code() != SERVER_FILE_NOT_FOUND) {
+        WRAPPER_LOG_WARNING << status.message() << ", blas crossovers are measured again";
+    }
+
+    bool measured = false;
+    for (auto dim : dims) {
+        // the simd scan handles dims of multiple of 4 only, BLAS is used for the others anyway
+        if (dim <= 0 || dim % 4 != 0) {
+            continue;
+        }
+
+        for (auto row_count : CALIBRATION_ROWS) {
+            row_count = std::min(row_count, CALIBRATION_MAX_FLOATS / dim);
+            for (auto thread_num : threads) {
+                if (thread_num <= 0) {
+                    continue;
+                }
+
+                auto crossovers = Crossovers();
+                if (crossovers->find(std::make_tuple(dim, row_count, thread_num)) != crossovers->end()) {
+                    continue;
+                }
+
+                auto start = std::chrono::steady_clock::now();
+                int64_t crossover = MeasureCrossover(dim, row_count, thread_num);
+                std::chrono::duration<double, std::milli> span = std::chrono::steady_clock::now() - start;
+                WRAPPER_LOG_INFO << "BLAS crossover of dim " << dim << ", rows " << row_count << ", threads "
+                                 << thread_num << ": nq " << crossover << ", measured in " << span.count() << " ms";
+                SetCrossover(dim, row_count, thread_num, crossover);
+                measured = true;
+            }
+        }
+    }
+
+    if (measured) {
+        return Save(path);
+    }
+    return Status::OK();
+}
+
+// one line per measure: dim rows threads crossover
+Status
+BlasCalibration::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return Status(SERVER_FILE_NOT_FOUND, "BLAS calibration not found: " + path);
+    }
+
+    CrossoverMap loaded;
+    int64_t dim, rows, threads, crossover;
+    while (file >> dim >> rows >> threads >> crossover) {
+        if (dim <= 0 || rows <= 0 || threads <= 0 || crossover <= 0) {
+            return Status(SERVER_UNEXPECTED_ERROR, "Invalid BLAS calibration: " + path);
+        }
+        loaded[std::make_tuple(dim, rows, threads)] = crossover;
+    }
+    if (!file.eof()) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Invalid BLAS calibration: " + path);
+    }
+
+    Update(loaded);
+    return Status::OK();
+}
+
+Status
+BlasCalibration::Save(const std::string& path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return Status(SERVER_CANNOT_CREATE_FILE, "Failed to create BLAS calibration: " + path);
+    }
+
+    for (auto& pair : *Crossovers()) {
+        file << std::get<0>(pair.first) << " " << std::get<1>(pair.first) << " " << std::get<2>(pair.first) << " "
+             << pair.second << "\n";
+    }
+    if (!file.good()) {
+        return Status(SERVER_CANNOT_CREATE_FILE, "Failed to write BLAS calibration: " + path);
+    }
+
+    return Status::OK();
+}
+
+int64_t
+BlasCalibration::Crossover(int64_t dim, int64_t rows, int64_t threads) const {
+    auto crossovers = Crossovers();
+    int64_t crossover = -1;
+    double best_rows = std::numeric_limits<double>::max();
+    int64_t best_threads = std::numeric_limits<int64_t>::max();
+    auto iter = crossovers->lower_bound(std::make_tuple(dim, 0, 0));
+    for (; iter != crossovers->end() && std::get<0>(iter->first) == dim; ++iter) {
+        // rows compared in log scale, the cost of a scan grows with them
+        double rows_distance = std::fabs(std::log2(static_cast<double>(std::max<int64_t>(rows, 1)) /
+                                                   static_cast<double>(std::get<1>(iter->first))));
+        int64_t threads_distance = std::abs(threads - std::get<2>(iter->first));
+        if (rows_distance < best_rows || (rows_distance == best_rows && threads_distance < best_threads)) {
+            best_rows = rows_distance;
+            best_threads = threads_distance;
+            crossover = iter->second;
+        }
+    }
+    return crossover;
+}
+
+void
+BlasCalibration::SetCrossover(int64_t dim, int64_t rows, int64_t threads, int64_t crossover) {
+    CrossoverMap crossovers;
+    crossovers[std::make_tuple(dim, rows, threads)] = crossover;
+    Update(crossovers);
+}
+
+bool
+BlasCalibration::UseBlas(int64_t dim, int64_t nq, int64_t rows) const {
+    int64_t crossover = Crossover(dim, rows, omp_get_max_threads());
+    if (crossover < 0) {
+        return nq >= faiss::distance_compute_blas_threshold;
+    }
+    return nq >= crossover;
+}
+
+void
+BlasCalibration::InstallSelector() {
+    faiss::distance_compute_blas_selector = SelectBlas;
+}
+
+BlasCalibration::CrossoverMapPtr
+BlasCalibration::Crossovers() const {
+    return std::atomic_load(&crossovers_);
+}
+
+void
+BlasCalibration::Update(const CrossoverMap& crossovers) {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    auto merged = std::make_shared<CrossoverMap>(*Crossovers());
+    for (auto& pair : crossovers) {
+        (*merged)[pair.first] = pair.second;
+    }
+    std::atomic_store(&crossovers_, CrossoverMapPtr(merged));
+}
+
+}  // namespace engine
+}  // namespace milvus
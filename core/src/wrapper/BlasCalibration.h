@@ -0,0 +1,94 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "utils/Status.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Brute-force search of faiss computes distances with BLAS for nq >= use_blas_threshold and with the simd scan below
+ * it, the best crossover moves with the dimension, the rows scanned and the openmp threads of the search;
+ * Crossovers measured on this machine are kept in a file under the db path, dimensions of new tables are measured at
+ * the next start;
+ */
+class BlasCalibration {
+ public:
+    static BlasCalibration&
+    GetInstance();
+
+    /*
+     * Load the crossovers stored in path, measure those missing for the dims and threads and store them back;
+     * Takes a few seconds for each dimension not measured before;
+     */
+    Status
+    Calibrate(const std::vector<int64_t>& dims, const std::vector<int64_t>& threads, const std::string& path);
+
+    Status
+    Load(const std::string& path);
+
+    Status
+    Save(const std::string& path) const;
+
+    /*
+     * Smallest nq searched faster with BLAS, from the measure of dim nearest in rows then in threads;
+     * -1 if the dim is not measured;
+     */
+    int64_t
+    Crossover(int64_t dim, int64_t rows, int64_t threads) const;
+
+    void
+    SetCrossover(int64_t dim, int64_t rows, int64_t threads, int64_t crossover);
+
+    /*
+     * Choice for nq vectors of dim searched in rows vectors with the openmp threads of the calling thread,
+     * use_blas_threshold decides for dims not measured;
+     */
+    bool
+    UseBlas(int64_t dim, int64_t nq, int64_t rows) const;
+
+    /*
+     * Make faiss ask UseBlas() for every brute-force search;
+     */
+    static void
+    InstallSelector();
+
+ private:
+    BlasCalibration();
+
+    // dim, rows, threads -> crossover
+    using CrossoverKey = std::tuple<int64_t, int64_t, int64_t>;
+    using CrossoverMap = std::map<CrossoverKey, int64_t>;
+    using CrossoverMapPtr = std::shared_ptr<const CrossoverMap>;
+
+    CrossoverMapPtr
+    Crossovers() const;
+
+    void
+    Update(const CrossoverMap& crossovers);
+
+ private:
+    // read by every search, swapped as a whole by writers
+    CrossoverMapPtr crossovers_;
+    std::mutex update_mutex_;
+};
+
+}  // namespace engine
+}  // namespace milvus
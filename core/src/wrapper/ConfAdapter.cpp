@@ -12,6 +12,7 @@
 #include "wrapper/ConfAdapter.h"
 
 #include <fiu-local.h>
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <vector>
@@ -63,22 +64,35 @@ IVFConfAdapter::Match(const TempMetaConf& metaconf) {
     conf->d = metaconf.dim;
     conf->metric_type = metaconf.metric_type;
     conf->gpu_id = metaconf.gpu_id;
+    conf->train_size = MatchTrainSize(metaconf.train_size, conf->nlist);
     MatchBase(conf);
     return conf;
 }
 
 static constexpr float TYPICAL_COUNT = 1000000.0;
 
+// k-means leaves centroids of fewer rows poorly placed, faiss warns of them
+static constexpr int64_t MIN_ROWS_PER_LIST = 39;
+static constexpr int64_t MAX_MATCHED_NLIST = 65536;
+
 int64_t
 IVFConfAdapter::MatchNlist(const int64_t& size, const int64_t& nlist, const int64_t& per_nlist) {
-    if (size <= TYPICAL_COUNT / per_nlist + 1) {
-        // handle less row count, avoid nlist set to 0
-        return 1;
-    } else if (int(size / TYPICAL_COUNT) * nlist <= 0) {
-        // calculate a proper nlist if nlist not specified or size less than TYPICAL_COUNT
-        return int(size / TYPICAL_COUNT * per_nlist);
+    // nlist is that of a file of TYPICAL_COUNT rows, per_nlist if not specified; files of other sizes get lists of
+    // as many rows, so a search probing the same part of their lists costs and recalls the same on any of them
+    int64_t typical_nlist = (nlist > 0) ? nlist : per_nlist;
+    auto matched = static_cast<int64_t>(size / TYPICAL_COUNT * typical_nlist);
+    matched = std::min({matched, size / MIN_ROWS_PER_LIST, MAX_MATCHED_NLIST});
+    return std::max<int64_t>(matched, 1);
+}
+
+int64_t
+IVFConfAdapter::MatchTrainSize(const int64_t& train_size, const int64_t& nlist) {
+    // k-means gets unstable with few rows per cluster, the sample never goes below 64 of them
+    static constexpr int64_t MIN_TRAIN_ROWS_PER_LIST = 64;
+    if (train_size <= 0) {
+        return knowhere::DEFAULT_TRAIN_SIZE;
     }
-    return nlist;
+    return std::max(train_size, nlist * MIN_TRAIN_ROWS_PER_LIST);
 }
 
 knowhere::Config
@@ -112,11 +126,36 @@ IVFSQConfAdapter::Match(const TempMetaConf& metaconf) {
     conf->d = metaconf.dim;
     conf->metric_type = metaconf.metric_type;
     conf->gpu_id = metaconf.gpu_id;
+    conf->train_size = MatchTrainSize(metaconf.train_size, conf->nlist);
     conf->nbits = 8;
     MatchBase(conf);
     return conf;
 }
 
+knowhere::Config
+IVFFP16ConfAdapter::Match(const TempMetaConf& metaconf) {
+    auto conf = std::static_pointer_cast<knowhere::IVFSQCfg>(IVFSQConfAdapter::Match(metaconf));
+    conf->nbits = knowhere::SQ_FP16_NBITS;
+    return conf;
+}
+
+knowhere::Config
+FlatFP16ConfAdapter::Match(const TempMetaConf& metaconf) {
+    auto conf = std::static_pointer_cast<knowhere::IVFSQCfg>(IVFSQConfAdapter::Match(metaconf));
+    conf->nlist = 1;
+    conf->train_size = MatchTrainSize(metaconf.train_size, conf->nlist);
+    conf->nbits = knowhere::SQ_FP16_NBITS;
+    return conf;
+}
+
+knowhere::Config
+FlatFP16ConfAdapter::MatchSearch(const TempMetaConf& metaconf, const IndexType& type) {
+    auto conf = std::make_shared<knowhere::IVFCfg>();
+    conf->k = metaconf.k;
+    conf->nprobe = 1;  // the only list holds all vectors, the search is exhaustive whatever nprobe is
+    return conf;
+}
+
 knowhere::Config
 IVFPQConfAdapter::Match(const TempMetaConf& metaconf) {
     auto conf = std::make_shared<knowhere::IVFPQCfg>();
@@ -124,7 +163,9 @@ IVFPQConfAdapter::Match(const TempMetaConf& metaconf) {
     conf->d = metaconf.dim;
     conf->metric_type = metaconf.metric_type;
     conf->gpu_id = metaconf.gpu_id;
+    conf->train_size = MatchTrainSize(metaconf.train_size, conf->nlist);
     conf->nbits = 8;
+    conf->rotation = metaconf.quantizer_rotation ? knowhere::ROTATIONTYPE::OPQ : knowhere::ROTATIONTYPE::NONE;
     MatchBase(conf);
 
 #ifdef MILVUS_GPU_VERSION
@@ -190,14 +231,40 @@ IVFPQConfAdapter::MatchSearch(const TempMetaConf& metaconf, const IndexType& typ
 
 int64_t
 IVFPQConfAdapter::MatchNlist(const int64_t& size, const int64_t& nlist) {
-    if (size <= TYPICAL_COUNT / 16384 + 1) {
-        // handle less row count, avoid nlist set to 0
-        return 1;
-    } else if (int(size / TYPICAL_COUNT) * nlist <= 0) {
-        // calculate a proper nlist if nlist not specified or size less than TYPICAL_COUNT
-        return int(size / TYPICAL_COUNT * 16384);
+    return IVFConfAdapter::MatchNlist(size, nlist, 16384);
+}
+
+knowhere::Config
+IVFPQFastScanConfAdapter::Match(const TempMetaConf& metaconf) {
+    auto conf = std::make_shared<knowhere::IVFPQCfg>();
+    conf->nlist = MatchNlist(metaconf.size, metaconf.nlist);
+    conf->d = metaconf.dim;
+    conf->metric_type = metaconf.metric_type;
+    conf->gpu_id = metaconf.gpu_id;
+    conf->train_size = MatchTrainSize(metaconf.train_size, conf->nlist);
+    conf->nbits = 4;
+    conf->rotation = metaconf.quantizer_rotation ? knowhere::ROTATIONTYPE::OPQ : knowhere::ROTATIONTYPE::NONE;
+    MatchBase(conf);
+
+    /*
+     * Two 4 bits codes make a byte, so m must be even, and at most 256 for the 16 bits sums of the scan.
+     * 4 dims per sub-quantizer gives the code size IVFPQ picks for the same dimension.
+     */
+    static std::vector<int64_t> support_dim_per_subquantizer{4, 8, 2, 16, 32};
+    conf->m = 0;
+    for (const auto& dimperquantizer : support_dim_per_subquantizer) {
+        auto subquantzier_num = conf->d / dimperquantizer;
+        if (conf->d % dimperquantizer == 0 && subquantzier_num % 2 == 0 && subquantzier_num <= 256) {
+            conf->m = subquantzier_num;
+            break;
+        }
+    }
+    if (conf->m == 0) {
+        WRAPPER_LOG_ERROR << "The dims of PQ fast scan is wrong : the dimension must be a multiple of 4";
+        throw WrapperException("The dims of PQ fast scan is wrong : the dimension must be a multiple of 4");
     }
-    return nlist;
+    WRAPPER_LOG_DEBUG << "PQ fast scan m = " << conf->m << ", compression radio = " << conf->d / conf->m * 8;
+    return conf;
 }
 
 knowhere::Config
@@ -273,6 +340,54 @@ HNSWConfAdapter::Match(const TempMetaConf& metaconf) {
     return conf;
 }
 
+knowhere::Config
+HNSWConfAdapter::MatchSearch(const TempMetaConf& metaconf, const IndexType& type) {
+    auto conf = std::make_shared<knowhere::HNSWCfg>();
+    conf->k = metaconf.k;
+
+    // nprobe of request is taken as ef, the size of candidate list, which should not be less than k
+    if (metaconf.nprobe < metaconf.k) {
+        conf->ef = metaconf.k + 32;
+    } else {
+        conf->ef = metaconf.nprobe;
+    }
+    return conf;
+}
+
+knowhere::Config
+DiskANNConfAdapter::Match(const TempMetaConf& metaconf) {
+    auto conf = std::make_shared<knowhere::DiskANNCfg>();
+    conf->d = metaconf.dim;
+    conf->metric_type = metaconf.metric_type;
+    conf->disk_path = metaconf.disk_path;
+    MatchBase(conf);
+
+    // only the pq codes stay in memory, 4 dims per sub-quantizer keeps 32 bytes of 128 dims
+    static std::vector<int64_t> support_dim_per_subquantizer{4, 8, 2, 1};
+    for (const auto& dimperquantizer : support_dim_per_subquantizer) {
+        if (conf->d % dimperquantizer == 0) {
+            conf->pq_m = conf->d / dimperquantizer;
+            break;
+        }
+    }
+    WRAPPER_LOG_DEBUG << "DiskANN pq m = " << conf->pq_m << ", disk path = " << conf->disk_path;
+    return conf;
+}
+
+knowhere::Config
+DiskANNConfAdapter::MatchSearch(const TempMetaConf& metaconf, const IndexType& type) {
+    auto conf = std::make_shared<knowhere::DiskANNCfg>();
+    conf->k = metaconf.k;
+
+    // nprobe of request is taken as the candidate list of search like ef of hnsw, not less than k
+    if (metaconf.nprobe < metaconf.k) {
+        conf->search_list = metaconf.k + 32;
+    } else {
+        conf->search_list = metaconf.nprobe;
+    }
+    return conf;
+}
+
 knowhere::Config
 BinIDMAPConfAdapter::Match(const TempMetaConf& metaconf) {
     auto conf = std::make_shared<knowhere::BinIDMAPCfg>();
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "VecIndex.h"
 #include "knowhere/common/Config.h"
@@ -29,6 +30,9 @@ struct TempMetaConf {
     int64_t k = TEMPMETA_DEFAULT_VALUE;
     int64_t nprobe = TEMPMETA_DEFAULT_VALUE;
     int64_t search_length = TEMPMETA_DEFAULT_VALUE;
+    int64_t train_size = TEMPMETA_DEFAULT_VALUE;
+    bool quantizer_rotation = false;
+    std::string disk_path;  // file written by the indexes kept on disk
     knowhere::METRICTYPE metric_type = knowhere::DEFAULT_TYPE;
 };
 
@@ -58,6 +62,9 @@ class IVFConfAdapter : public ConfAdapter {
  protected:
     static int64_t
     MatchNlist(const int64_t& size, const int64_t& nlist, const int64_t& per_nlist);
+
+    static int64_t
+    MatchTrainSize(const int64_t& train_size, const int64_t& nlist);
 };
 
 class IVFSQConfAdapter : public IVFConfAdapter {
@@ -66,6 +73,21 @@ class IVFSQConfAdapter : public IVFConfAdapter {
     Match(const TempMetaConf& metaconf) override;
 };
 
+class IVFFP16ConfAdapter : public IVFSQConfAdapter {
+ public:
+    knowhere::Config
+    Match(const TempMetaConf& metaconf) override;
+};
+
+class FlatFP16ConfAdapter : public IVFSQConfAdapter {
+ public:
+    knowhere::Config
+    Match(const TempMetaConf& metaconf) override;
+
+    knowhere::Config
+    MatchSearch(const TempMetaConf& metaconf, const IndexType& type) override;
+};
+
 class IVFPQConfAdapter : public IVFConfAdapter {
  public:
     knowhere::Config
@@ -79,6 +101,12 @@ class IVFPQConfAdapter : public IVFConfAdapter {
     MatchNlist(const int64_t& size, const int64_t& nlist);
 };
 
+class IVFPQFastScanConfAdapter : public IVFPQConfAdapter {
+ public:
+    knowhere::Config
+    Match(const TempMetaConf& metaconf) override;
+};
+
 class NSGConfAdapter : public IVFConfAdapter {
  public:
     knowhere::Config
@@ -122,6 +150,18 @@ class HNSWConfAdapter : public ConfAdapter {
  public:
     knowhere::Config
     Match(const TempMetaConf& metaconf) override;
+
+    knowhere::Config
+    MatchSearch(const TempMetaConf& metaconf, const IndexType& type) override;
+};
+
+class DiskANNConfAdapter : public ConfAdapter {
+ public:
+    knowhere::Config
+    Match(const TempMetaConf& metaconf) override;
+
+    knowhere::Config
+    MatchSearch(const TempMetaConf& metaconf, const IndexType& type) override;
 };
 
 }  // namespace engine
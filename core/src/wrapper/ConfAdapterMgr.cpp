@@ -47,10 +47,14 @@ AdapterMgr::RegisterAdapter() {
     REGISTER_CONF_ADAPTER(IVFSQConfAdapter, IndexType::FAISS_IVFSQ8_GPU, ivfsq8_gpu);
     REGISTER_CONF_ADAPTER(IVFSQConfAdapter, IndexType::FAISS_IVFSQ8_MIX, ivfsq8_mix);
     REGISTER_CONF_ADAPTER(IVFSQConfAdapter, IndexType::FAISS_IVFSQ8_HYBRID, ivfsq8_h);
+    REGISTER_CONF_ADAPTER(IVFFP16ConfAdapter, IndexType::FAISS_IVFFP16_CPU, ivffp16_cpu);
+    REGISTER_CONF_ADAPTER(FlatFP16ConfAdapter, IndexType::FAISS_FLAT_FP16, flat_fp16);
 
     REGISTER_CONF_ADAPTER(IVFPQConfAdapter, IndexType::FAISS_IVFPQ_CPU, ivfpq_cpu);
     REGISTER_CONF_ADAPTER(IVFPQConfAdapter, IndexType::FAISS_IVFPQ_GPU, ivfpq_gpu);
     REGISTER_CONF_ADAPTER(IVFPQConfAdapter, IndexType::FAISS_IVFPQ_MIX, ivfpq_mix);
+    REGISTER_CONF_ADAPTER(IVFPQConfAdapter, IndexType::FAISS_IVFPQ_REFINE, ivfpq_refine);
+    REGISTER_CONF_ADAPTER(IVFPQFastScanConfAdapter, IndexType::FAISS_IVFPQ_FASTSCAN, ivfpq_fastscan);
 
     REGISTER_CONF_ADAPTER(NSGConfAdapter, IndexType::NSG_MIX, nsg_mix);
 
@@ -58,6 +62,9 @@ AdapterMgr::RegisterAdapter() {
     REGISTER_CONF_ADAPTER(SPTAGBKTConfAdapter, IndexType::SPTAG_BKT_RNT_CPU, sptag_bkt);
 
     REGISTER_CONF_ADAPTER(HNSWConfAdapter, IndexType::HNSW, hnsw);
+    REGISTER_CONF_ADAPTER(HNSWConfAdapter, IndexType::HNSW_SQ8, hnsw_sq8);
+
+    REGISTER_CONF_ADAPTER(DiskANNConfAdapter, IndexType::DISKANN, diskann);
 }
 
 }  // namespace engine
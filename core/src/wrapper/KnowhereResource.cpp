@@ -11,13 +11,17 @@
 
 #include "wrapper/KnowhereResource.h"
 #ifdef MILVUS_GPU_VERSION
+#include "cache/GpuCacheMgr.h"
+#include "cache/GpuMemoryArbiter.h"
 #include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
 #endif
 
 #include "scheduler/Utils.h"
 #include "server/Config.h"
+#include "utils/ValidationUtil.h"
 
 #include <fiu-local.h>
+#include <future>
 #include <map>
 #include <set>
 #include <string>
@@ -28,6 +32,10 @@ namespace milvus {
 namespace engine {
 
 constexpr int64_t M_BYTE = 1024 * 1024;
+constexpr int64_t GPU_PINNED_MEMORY = 300 * M_BYTE;
+constexpr int64_t GPU_TEMP_MEMORY = 300 * M_BYTE;
+// share of device memory given to the arbiter, the rest is left to the cuda context and allocations out of its sight
+constexpr double GPU_MEMORY_BUDGET_RATIO = 0.9;
 
 Status
 KnowhereResource::Initialize() {
@@ -42,45 +50,63 @@ KnowhereResource::Initialize() {
     if (not enable_gpu)
         return Status::OK();
 
-    struct GpuResourceSetting {
-        int64_t pinned_memory = 300 * M_BYTE;
-        int64_t temp_memory = 300 * M_BYTE;
-        int64_t resource_num = 2;
-    };
-    using GpuResourcesArray = std::map<int64_t, GpuResourceSetting>;
-    GpuResourcesArray gpu_resources;
+    std::set<int64_t> gpu_ids;
 
     // get build index gpu resource
     std::vector<int64_t> build_index_gpus;
     s = config.GetGpuResourceConfigBuildIndexResources(build_index_gpus);
     if (!s.ok())
         return s;
-
-    for (auto gpu_id : build_index_gpus) {
-        gpu_resources.insert(std::make_pair(gpu_id, GpuResourceSetting()));
-    }
+    gpu_ids.insert(build_index_gpus.begin(), build_index_gpus.end());
 
     // get search gpu resource
     std::vector<int64_t> search_gpus;
     s = config.GetGpuResourceConfigSearchResources(search_gpus);
     if (!s.ok())
         return s;
+    gpu_ids.insert(search_gpus.begin(), search_gpus.end());
 
-    for (auto& gpu_id : search_gpus) {
-        gpu_resources.insert(std::make_pair(gpu_id, GpuResourceSetting()));
+    // init gpu resources, devices are brought up in parallel since each takes seconds to answer its first call
+    std::vector<std::future<Status>> results;
+    for (auto gpu_id : gpu_ids) {
+        results.emplace_back(std::async(std::launch::async, &KnowhereResource::InitGpuDevice, gpu_id));
     }
-
-    // init gpu resources
-    for (auto iter = gpu_resources.begin(); iter != gpu_resources.end(); ++iter) {
-        knowhere::FaissGpuResourceMgr::GetInstance().InitDevice(iter->first, iter->second.pinned_memory,
-                                                                iter->second.temp_memory, iter->second.resource_num);
+    for (auto& result : results) {
+        auto status = result.get();
+        if (!status.ok())
+            s = status;
     }
+    if (!s.ok())
+        return s;
 
 #endif
 
     return Status::OK();
 }
 
+Status
+KnowhereResource::InitGpuDevice(int64_t device_id) {
+#ifdef MILVUS_GPU_VERSION
+    // one faiss resource per stream, tasks on a gpu each hold one of them
+    int64_t stream_num = 2;
+    auto s = server::Config::GetInstance().GetGpuResourceConfigStreamNum(stream_num);
+    if (!s.ok())
+        return s;
+
+    knowhere::FaissGpuResourceMgr::GetInstance().InitDevice(device_id, GPU_PINNED_MEMORY, GPU_TEMP_MEMORY, stream_num);
+
+    // temp memory of every resource is taken for the whole run, the cache and loads share the rest
+    size_t gpu_memory = 0;
+    s = server::ValidationUtil::GetGpuMemory(device_id, gpu_memory);
+    if (!s.ok())
+        return s;
+    cache::GpuMemoryArbiter::GetInstance().AddDevice(device_id, gpu_memory * GPU_MEMORY_BUDGET_RATIO,
+                                                     GPU_TEMP_MEMORY * stream_num,
+                                                     cache::GpuCacheMgr::GetInstance(device_id));
+#endif
+    return Status::OK();
+}
+
 Status
 KnowhereResource::Finalize() {
 #ifdef MILVUS_GPU_VERSION
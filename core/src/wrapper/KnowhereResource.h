@@ -21,6 +21,12 @@ class KnowhereResource {
     static Status
     Initialize();
 
+    /*
+     * Prepare a gpu for index copy and search, gpus added after Initialize() are usable once called;
+     */
+    static Status
+    InitGpuDevice(int64_t device_id);
+
     static Status
     Finalize();
 };
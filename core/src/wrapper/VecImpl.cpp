@@ -14,6 +14,7 @@
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVF.h"
 #include "utils/Log.h"
 #include "wrapper/WrapperException.h"
 #include "wrapper/gpu/GPUVecImpl.h"
@@ -44,10 +45,13 @@ VecIndexImpl::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, c
         fiu_do_on("VecIndexImpl.BuildAll.throw_knowhere_exception", throw knowhere::KnowhereException(""));
         fiu_do_on("VecIndexImpl.BuildAll.throw_std_exception", throw std::exception());
 
-        auto preprocessor = index_->BuildPreprocessor(dataset, cfg);
-        index_->set_preprocessor(preprocessor);
-        auto model = index_->Train(dataset, cfg);
-        index_->set_index_model(model);
+        // a shared model brings the preprocessor it was trained with
+        if (model_ == nullptr) {
+            auto preprocessor = index_->BuildPreprocessor(dataset, cfg);
+            index_->set_preprocessor(preprocessor);
+            model_ = index_->Train(dataset, cfg);
+        }
+        index_->set_index_model(model_);
         index_->Add(dataset, cfg);
     } catch (knowhere::KnowhereException& e) {
         WRAPPER_LOG_ERROR << e.what();
@@ -125,6 +129,77 @@ VecIndexImpl::Search(const int64_t& nq, const float* xq, float* dist, int64_t* i
     return Status::OK();
 }
 
+Status
+VecIndexImpl::RangeSearch(const int64_t& nq, const float* xq, float radius, float* dist, int64_t* ids,
+                          const Config& cfg) {
+    try {
+        auto k = cfg->k;
+        auto dataset = GenDataset(nq, dim, xq);
+
+        auto res = index_->RangeSearch(dataset, radius, cfg);
+
+        auto res_ids = res->Get<int64_t*>(knowhere::meta::IDS);
+        auto res_dist = res->Get<float*>(knowhere::meta::DISTANCE);
+        memcpy(ids, res_ids, sizeof(int64_t) * nq * k);
+        memcpy(dist, res_dist, sizeof(float) * nq * k);
+        free(res_ids);
+        free(res_dist);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+uint64_t
+VecIndexImpl::QuantizerFingerprint() {
+    auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF>(index_);
+    if (ivf_index == nullptr) {
+        return 0;
+    }
+    return ivf_index->QuantizerFingerprint();
+}
+
+int64_t
+VecIndexImpl::Nlist() {
+    auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF>(index_);
+    if (ivf_index == nullptr) {
+        return 0;
+    }
+    return ivf_index->Nlist();
+}
+
+bool
+VecIndexImpl::Rotated() {
+    auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF>(index_);
+    return ivf_index != nullptr && ivf_index->Rotated();
+}
+
+Status
+VecIndexImpl::CoarseAssign(const int64_t& nq, const float* xq, const Config& cfg,
+                           knowhere::CoarseAssignmentPtr& coarse) {
+    coarse = nullptr;
+    auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF>(index_);
+    if (ivf_index == nullptr) {
+        return Status::OK();
+    }
+
+    try {
+        auto dataset = GenDataset(nq, dim, xq);
+        coarse = ivf_index->CoarseAssign(dataset, cfg);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
 knowhere::BinarySet
 VecIndexImpl::Serialize() {
     type = ConvertToCpuIndexType(type);
@@ -133,8 +208,16 @@ VecIndexImpl::Serialize() {
 
 Status
 VecIndexImpl::Load(const knowhere::BinarySet& index_binary) {
-    index_->Load(index_binary);
-    dim = Dimension();
+    try {
+        index_->Load(index_binary);
+        dim = Dimension();
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
     return Status::OK();
 }
 
@@ -148,6 +231,11 @@ VecIndexImpl::Count() {
     return index_->Count();
 }
 
+std::vector<std::pair<const void*, size_t>>
+VecIndexImpl::MemoryRanges() {
+    return index_->MemoryRanges();
+}
+
 IndexType
 VecIndexImpl::GetType() const {
     return type;
@@ -167,6 +255,26 @@ VecIndexImpl::CopyToGpu(const int64_t& device_id, const Config& cfg) {
 #endif
 }
 
+VecIndexPtr
+VecIndexImpl::CopyToGpuShards(const std::vector<int64_t>& device_ids, const Config& cfg) {
+#ifdef MILVUS_GPU_VERSION
+    try {
+        auto gpu_index = knowhere::cloner::CopyCpuToGpuShards(index_, device_ids, cfg);
+        auto new_index = std::make_shared<VecIndexImpl>(gpu_index, ConvertToGpuIndexType(type));
+        new_index->dim = dim;
+        return new_index;
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+    }
+    return nullptr;
+#else
+    WRAPPER_LOG_ERROR << "Calling VecIndexImpl::CopyToGpuShards when we are using CPU version";
+    throw WrapperException("Calling VecIndexImpl::CopyToGpuShards when we are using CPU version");
+#endif
+}
+
 VecIndexPtr
 VecIndexImpl::CopyToCpu(const Config& cfg) {
 // TODO(linxj): exception handle
@@ -195,10 +303,8 @@ VecIndexImpl::GetDeviceId() {
     if (auto device_idx = std::dynamic_pointer_cast<knowhere::GPUIndex>(index_)) {
         return device_idx->GetGpuDevice();
     }
-#else
-    // else
-    return -1;  // -1 == cpu
 #endif
+    return -1;  // -1 == cpu
 }
 
 const float*
@@ -215,6 +321,45 @@ BFIndex::GetRawIds() {
     return std::static_pointer_cast<knowhere::IDMAP>(index_)->GetRawIds();
 }
 
+std::string
+BFIndex::StreamedBlockName() {
+    // the block Serialize() names, so the file is loaded the same way
+    return "IVF";
+}
+
+void
+BFIndex::SerializeTo(faiss::IOWriter* writer) {
+    std::static_pointer_cast<knowhere::IDMAP>(index_)->SerializeTo(writer);
+}
+
+Status
+BFIndex::Reserve(int64_t n) {
+    try {
+        std::static_pointer_cast<knowhere::IDMAP>(index_)->Reserve(n);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+Status
+BFIndex::SwapRawData(std::vector<float>& xb, std::vector<int64_t>& ids) {
+    try {
+        std::static_pointer_cast<knowhere::IDMAP>(index_)->SwapRawData(xb, ids);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
 ErrorCode
 BFIndex::Build(const Config& cfg) {
     try {
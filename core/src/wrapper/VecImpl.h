@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "VecIndex.h"
 #include "knowhere/index/vector_index/VectorIndex.h"
@@ -26,6 +27,11 @@ class VecIndexImpl : public VecIndex {
         : index_(std::move(index)), type(type) {
     }
 
+    // wraps an index already holding vectors of the dimension
+    VecIndexImpl(std::shared_ptr<knowhere::VectorIndex> index, const IndexType& type, const int64_t& dimension)
+        : dim(dimension), type(type), index_(std::move(index)) {
+    }
+
     Status
     BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg, const int64_t& nt,
              const float* xt) override;
@@ -36,6 +42,9 @@ class VecIndexImpl : public VecIndex {
     VecIndexPtr
     CopyToCpu(const Config& cfg) override;
 
+    VecIndexPtr
+    CopyToGpuShards(const std::vector<int64_t>& device_ids, const Config& cfg) override;
+
     IndexType
     GetType() const override;
 
@@ -45,6 +54,9 @@ class VecIndexImpl : public VecIndex {
     int64_t
     Count() override;
 
+    std::vector<std::pair<const void*, size_t>>
+    MemoryRanges() override;
+
     Status
     Add(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg) override;
 
@@ -63,9 +75,38 @@ class VecIndexImpl : public VecIndex {
     Status
     Search(const int64_t& nq, const float* xq, float* dist, int64_t* ids, const Config& cfg) override;
 
+    Status
+    RangeSearch(const int64_t& nq, const float* xq, float radius, float* dist, int64_t* ids,
+                const Config& cfg) override;
+
+    uint64_t
+    QuantizerFingerprint() override;
+
+    int64_t
+    Nlist() override;
+
+    bool
+    Rotated() override;
+
+    Status
+    CoarseAssign(const int64_t& nq, const float* xq, const Config& cfg, knowhere::CoarseAssignmentPtr& coarse) override;
+
+    void
+    SetTrainedModel(const knowhere::IndexModelPtr& model) override {
+        model_ = model;
+    }
+
+    knowhere::IndexModelPtr
+    TrainedModel() override {
+        return model_;
+    }
+
  protected:
     int64_t dim = 0;
 
+    // a shared model is copied into the index, it is never modified by Add
+    knowhere::IndexModelPtr model_ = nullptr;
+
     IndexType type = IndexType::INVALID;
 
     std::shared_ptr<knowhere::VectorIndex> index_ = nullptr;
@@ -89,6 +130,18 @@ class BFIndex : public VecIndexImpl {
 
     const int64_t*
     GetRawIds();
+
+    std::string
+    StreamedBlockName() override;
+
+    void
+    SerializeTo(faiss::IOWriter* writer) override;
+
+    Status
+    Reserve(int64_t n);
+
+    Status
+    SwapRawData(std::vector<float>& xb, std::vector<int64_t>& ids);
 };
 
 class ToIndexData : public cache::DataObj {
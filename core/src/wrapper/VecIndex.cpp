@@ -12,22 +12,32 @@
 #include "wrapper/VecIndex.h"
 
 #include "VecImpl.h"
+#include "cache/DiskCacheMgr.h"
+#include "db/Utils.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 #include "knowhere/index/vector_index/IndexBinaryIVF.h"
+#include "knowhere/index/vector_index/IndexDiskANN.h"
 #include "knowhere/index/vector_index/IndexHNSW.h"
+#include "knowhere/index/vector_index/IndexHNSWSQ8.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+#include "knowhere/index/vector_index/IndexIVFPQRefine.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
 #include "knowhere/index/vector_index/IndexNSG.h"
 #include "knowhere/index/vector_index/IndexSPTAG.h"
 #include "server/Config.h"
+#include "storage/Compression.h"
 #include "storage/file/FileIOReader.h"
 #include "storage/file/FileIOWriter.h"
+#include "storage/file/MmapFile.h"
+#include "storage/s3/S3ClientWrapper.h"
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3IOWriter.h"
 #include "utils/Exception.h"
+#include "utils/LargeBuffer.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 #include "wrapper/BinVecImpl.h"
@@ -43,7 +53,13 @@
 #include "wrapper/gpu/GPUVecImpl.h"
 #endif
 
+#include <faiss/impl/io.h>
 #include <fiu-local.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace milvus {
 namespace engine {
@@ -61,6 +77,16 @@ VecIndex::set_size(int64_t size) {
     size_ = size;
 }
 
+void
+VecIndex::AdviseHugePages() {
+    if (GetHugePageMode() == HugePageMode::OFF) {
+        return;
+    }
+    for (auto& range : MemoryRanges()) {
+        milvus::AdviseHugePages(range.first, range.second);
+    }
+}
+
 VecIndexPtr
 GetVecIndexFactory(const IndexType& type, const Config& cfg) {
     std::shared_ptr<knowhere::VectorIndex> index;
@@ -102,6 +128,27 @@ GetVecIndexFactory(const IndexType& type, const Config& cfg) {
             index = std::make_shared<knowhere::IndexHNSW>();
             break;
         }
+        case IndexType::HNSW_SQ8: {
+            index = std::make_shared<knowhere::IndexHNSWSQ8>();
+            break;
+        }
+        case IndexType::FAISS_IVFPQ_REFINE: {
+            index = std::make_shared<knowhere::IVFPQRefine>();
+            break;
+        }
+        case IndexType::FAISS_IVFPQ_FASTSCAN: {
+            index = std::make_shared<knowhere::IVFPQFastScan>();
+            break;
+        }
+        case IndexType::DISKANN: {
+            index = std::make_shared<knowhere::IndexDiskANN>();
+            break;
+        }
+        case IndexType::FAISS_IVFFP16_CPU:
+        case IndexType::FAISS_FLAT_FP16: {
+            index = std::make_shared<knowhere::IVFSQ>();
+            break;
+        }
 
 #ifdef MILVUS_GPU_VERSION
         case IndexType::FAISS_IVFFLAT_GPU: {
@@ -156,16 +203,285 @@ GetVecIndexFactory(const IndexType& type, const Config& cfg) {
 }
 
 VecIndexPtr
-LoadVecIndex(const IndexType& index_type, const knowhere::BinarySet& index_binary, int64_t size) {
+LoadVecIndex(const IndexType& index_type, knowhere::BinarySet& index_binary, int64_t size) {
     auto index = GetVecIndexFactory(index_type);
     if (index == nullptr)
         return nullptr;
     // else
-    index->Load(index_binary);
+    auto status = index->Load(index_binary);
+    if (!status.ok()) {
+        WRAPPER_LOG_ERROR << "Failed to load index: " << status.message();
+        return nullptr;
+    }
+    for (auto& iter : index_binary.binary_map_) {
+        // codes of lazy lists stay in the file, the lazy list cache accounts those paged in, ids are copied
+        if (iter.second->lazy) {
+            size += index->Count() * static_cast<int64_t>(sizeof(int64_t)) - iter.second->size;
+        }
+    }
+    index_binary.clear();
     index->set_size(size);
     return index;
 }
 
+namespace {
+
+// threads reading a local index file which can't be mapped
+constexpr int64_t READ_THREAD_NUM = 8;
+
+// the disk file of a DISKANN index is next to the index file, not where the index was built
+void
+AppendDiskPath(IndexType index_type, const std::string& location, knowhere::BinarySet& index_binary) {
+    if (index_type != IndexType::DISKANN) {
+        return;
+    }
+    auto path = engine::utils::GetDiskIndexPath(location);
+    std::shared_ptr<uint8_t> data(new uint8_t[path.size()], std::default_delete<uint8_t[]>());
+    memcpy(data.get(), path.data(), path.size());
+    index_binary.Append(knowhere::IndexDiskANN::DISK_PATH_BINARY_NAME, data, path.size());
+}
+
+// files smaller than it are written through page cache even with storage_config.direct_io_enable
+constexpr int64_t DIRECT_IO_MIN_SIZE = 64 * 1024 * 1024;
+
+/*
+ * Files end with a directory of their blocks, so a block is found without scanning the ones before it;
+ * Layout: index type, records of (meta length, meta, block length, block), the directory entries of
+ * (meta length, meta, offset, block length, checksum) and the tail; Files written before the directory
+ * was added have no tail, they are scanned record by record;
+ */
+constexpr uint64_t INDEX_FILE_MAGIC = 0x3156494458444e49;  // "INDXDIV1"
+constexpr uint32_t INDEX_FILE_VERSION = 1;
+
+struct IndexFileTail {
+    uint64_t directory_offset;
+    uint64_t block_num;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t magic;
+};
+
+struct IndexFileBlock {
+    std::string meta;
+    uint64_t offset;
+    // COMPRESSED_BLOCK_FLAG is kept in it
+    uint64_t length;
+    uint32_t checksum;
+};
+
+// the block of inverted lists which may be left in a mapped file, see make_lists_lazy of faiss
+constexpr const char* LAZY_BLOCK_NAME = "IVF";
+
+bool
+is_lazy_type(const IndexType& type) {
+    return type == IndexType::FAISS_IVFFLAT_CPU || type == IndexType::FAISS_IVFSQ8_CPU ||
+           type == IndexType::FAISS_IVFPQ_CPU || type == IndexType::FAISS_IVFFP16_CPU;
+}
+
+// read(offset, size, buffer) fetches a range of the file
+using RangeReader = std::function<bool(size_t, size_t, void*)>;
+
+// return false if the file has no directory or it is broken
+bool
+read_directory(size_t length, const RangeReader& read, IndexType& index_type, std::vector<IndexFileBlock>& blocks) {
+    IndexFileTail tail;
+    if (length < sizeof(index_type) + sizeof(tail) || !read(length - sizeof(tail), sizeof(tail), &tail) ||
+        tail.magic != INDEX_FILE_MAGIC || tail.version > INDEX_FILE_VERSION ||
+        tail.directory_offset > length - sizeof(tail) || !read(0, sizeof(index_type), &index_type)) {
+        return false;
+    }
+
+    size_t directory_length = length - sizeof(tail) - tail.directory_offset;
+    std::vector<uint8_t> directory(directory_length);
+    if (!read(tail.directory_offset, directory_length, directory.data())) {
+        return false;
+    }
+
+    size_t rp = 0;
+    auto read_value = [&](void* value, size_t size) -> bool {
+        if (rp + size > directory_length) {
+            return false;
+        }
+        memcpy(value, directory.data() + rp, size);
+        rp += size;
+        return true;
+    };
+    blocks.clear();
+    for (uint64_t i = 0; i < tail.block_num; ++i) {
+        IndexFileBlock block;
+        uint64_t meta_length;
+        if (!read_value(&meta_length, sizeof(meta_length)) || rp + meta_length > directory_length) {
+            return false;
+        }
+        block.meta.assign(reinterpret_cast<const char*>(directory.data() + rp), meta_length);
+        rp += meta_length;
+        if (!read_value(&block.offset, sizeof(block.offset)) || !read_value(&block.length, sizeof(block.length)) ||
+            !read_value(&block.checksum, sizeof(block.checksum))) {
+            return false;
+        }
+        uint64_t block_length = block.length & ~storage::COMPRESSED_BLOCK_FLAG;
+        if (block.offset > tail.directory_offset || block_length > tail.directory_offset - block.offset) {
+            return false;
+        }
+        blocks.push_back(block);
+    }
+    return true;
+}
+
+// check a block read as stored and append it, a compressed one is inflated into a buffer of its own;
+// lazy: the block stays in a mapped file, it isn't checked since that would read it whole
+bool
+append_block(const IndexFileBlock& block, std::shared_ptr<uint8_t> binptr, knowhere::BinarySet& binary_set,
+             bool lazy = false) {
+    size_t bin_length = block.length & ~storage::COMPRESSED_BLOCK_FLAG;
+    bool compressed = (block.length & storage::COMPRESSED_BLOCK_FLAG) != 0;
+    lazy = lazy && !compressed && block.meta == LAZY_BLOCK_NAME;
+    if (!lazy && storage::BlockChecksum(binptr.get(), bin_length) != block.checksum) {
+        return false;
+    }
+    if (compressed && !storage::DecompressBlock(binptr.get(), bin_length, binptr, bin_length)) {
+        return false;
+    }
+    binary_set.Append(block.meta, binptr, bin_length);
+    binary_set.GetByName(block.meta)->lazy = lazy;
+    return true;
+}
+
+/*
+ * Parse an index file held whole in memory, binaries point into data and keep it alive, compressed ones
+ * are inflated into buffers of their own; lazy: data is mapped from the file, inverted lists of ivf
+ * indexes may be left there; Return false if the file is broken;
+ */
+bool
+parse_index(const std::shared_ptr<uint8_t>& data, size_t length, IndexType& index_type,
+            knowhere::BinarySet& load_data_list, bool lazy = false) {
+    knowhere::BinarySet binary_set;
+    std::vector<IndexFileBlock> blocks;
+    auto read_memory = [&](size_t offset, size_t size, void* buffer) {
+        memcpy(buffer, data.get() + offset, size);
+        return true;
+    };
+    if (read_directory(length, read_memory, index_type, blocks)) {
+        for (auto& block : blocks) {
+            auto binptr = std::shared_ptr<uint8_t>(data, data.get() + block.offset);
+            if (!append_block(block, binptr, binary_set, lazy && is_lazy_type(index_type))) {
+                return false;
+            }
+        }
+        load_data_list = binary_set;
+        return true;
+    }
+
+    size_t rp = 0;
+    auto read_value = [&](void* value, size_t size) -> bool {
+        if (rp + size > length) {
+            return false;
+        }
+        memcpy(value, data.get() + rp, size);
+        rp += size;
+        return true;
+    };
+
+    if (!read_value(&index_type, sizeof(index_type))) {
+        return false;
+    }
+
+    while (rp < length) {
+        size_t meta_length;
+        if (!read_value(&meta_length, sizeof(meta_length)) || rp + meta_length > length) {
+            return false;
+        }
+        std::string meta(reinterpret_cast<const char*>(data.get() + rp), meta_length);
+        rp += meta_length;
+
+        size_t bin_length;
+        if (!read_value(&bin_length, sizeof(bin_length))) {
+            return false;
+        }
+        bool compressed = (bin_length & storage::COMPRESSED_BLOCK_FLAG) != 0;
+        bin_length &= ~storage::COMPRESSED_BLOCK_FLAG;
+        if (rp + bin_length > length) {
+            return false;
+        }
+        std::shared_ptr<uint8_t> binptr(data, data.get() + rp);
+        rp += bin_length;
+
+        if (compressed && !storage::DecompressBlock(binptr.get(), bin_length, binptr, bin_length)) {
+            return false;
+        }
+        binary_set.Append(meta, binptr, bin_length);
+        binary_set.GetByName(meta)->lazy = lazy && !compressed && meta == LAZY_BLOCK_NAME && is_lazy_type(index_type);
+    }
+
+    load_data_list = binary_set;
+    return true;
+}
+
+// bytes the binaries take in memory, more than the file if some of them were compressed
+int64_t
+binary_size(const knowhere::BinarySet& binary_set) {
+    int64_t size = 0;
+    for (auto& iter : binary_set.binary_map_) {
+        size += iter.second->size;
+    }
+    return size;
+}
+
+/*
+ * Map a local index file instead of copying it into new buffers, the file is unmapped once the last
+ * binary is released; Return false if the file can't be mapped or is broken, then it is read whole;
+ * With cache_config.list_cache_capacity set, inverted lists of ivf indexes are paged in as they're probed;
+ */
+bool
+read_index_mmap(const std::string& location, IndexType& index_type, knowhere::BinarySet& load_data_list,
+                int64_t& file_length) {
+    auto file = std::make_shared<storage::MmapFile>(location);
+    if (!file->valid()) {
+        return false;
+    }
+
+    int64_t list_cache_capacity = 0;
+    server::Config::GetInstance().GetCacheConfigListCacheCapacity(list_cache_capacity);
+    if (!parse_index(std::shared_ptr<uint8_t>(file, file->data()), file->length(), index_type, load_data_list,
+                     list_cache_capacity > 0)) {
+        return false;
+    }
+    file_length = file->length();
+    return true;
+}
+
+// counts the bytes of a block serialized to it, the length is written before the block
+struct CountingIOWriter : public faiss::IOWriter {
+    size_t
+    operator()(const void* ptr, size_t size, size_t nitems) override {
+        length_ += size * nitems;
+        return nitems;
+    }
+
+    uint64_t length_ = 0;
+};
+
+// passes a block to the file as faiss serializes it, the checksum is summed on the way
+struct BlockIOWriter : public faiss::IOWriter {
+    explicit BlockIOWriter(storage::IOWriter* writer) : writer_(writer) {
+    }
+
+    size_t
+    operator()(const void* ptr, size_t size, size_t nitems) override {
+        size_t length = size * nitems;
+        checksum_ = storage::BlockChecksum(checksum_, static_cast<const uint8_t*>(ptr), length);
+        writer_->write(const_cast<void*>(ptr), length);
+        length_ += length;
+        return nitems;
+    }
+
+    storage::IOWriter* writer_;
+    uint64_t length_ = 0;
+    uint32_t checksum_ = 0;
+};
+
+}  // namespace
+
 VecIndexPtr
 read_index(const std::string& location) {
     fiu_return_on("read_null_index", nullptr);
@@ -177,60 +493,133 @@ read_index(const std::string& location) {
     server::Config& config = server::Config::GetInstance();
     config.GetStorageConfigS3Enable(s3_enable);
 
-    std::shared_ptr<storage::IOReader> reader_ptr;
+    recorder.RecordSection("Start");
+
+    {
+        // a file on s3 may have a local copy in disk cache
+        cache::DiskFileObjPtr disk_file = nullptr;
+        if (s3_enable) {
+            disk_file = cache::DiskCacheMgr::GetInstance()->GetFile(location);
+        }
+
+        auto current_type = IndexType::INVALID;
+        int64_t length = 0;
+        if ((!s3_enable || disk_file != nullptr) &&
+            read_index_mmap((disk_file != nullptr) ? disk_file->Path() : location, current_type, load_data_list,
+                            length)) {
+            double span = recorder.RecordSection("Mapped");
+            STORAGE_LOG_DEBUG << "read_index(" << location << ") mapped " << length << " bytes in " << span << "us";
+            int64_t size = binary_size(load_data_list);
+            AppendDiskPath(current_type, location, load_data_list);
+            return LoadVecIndex(current_type, load_data_list, size);
+        }
+    }
+
+    // the file is read whole by large requests and parsed in memory, binaries point into the one buffer
+    std::shared_ptr<storage::S3IOReader> s3_reader_ptr;
+    std::shared_ptr<uint8_t> data;
+    size_t length = 0;
     if (s3_enable) {
-        reader_ptr = std::make_shared<storage::S3IOReader>(location);
+        s3_reader_ptr = std::make_shared<storage::S3IOReader>(location);
+        length = s3_reader_ptr->length();
+        if (length > 0) {
+            data = std::shared_ptr<uint8_t>(s3_reader_ptr, reinterpret_cast<uint8_t*>(&s3_reader_ptr->buffer_[0]));
+        }
     } else {
-        reader_ptr = std::make_shared<storage::FileIOReader>(location);
+        storage::FileIOReader reader(location);
+        length = reader.length();
+        if (length > 0) {
+            data = AllocLargeBuffer(length);
+            if (!reader.pread(data.get(), 0, length, READ_THREAD_NUM)) {
+                STORAGE_LOG_ERROR << "read_index(" << location << ") failed to read " << length << " bytes";
+                return nullptr;
+            }
+        }
     }
-
-    recorder.RecordSection("Start");
-
-    size_t length = reader_ptr->length();
     if (length <= 0) {
         return nullptr;
     }
 
-    size_t rp = 0;
-    reader_ptr->seekg(0);
-
     auto current_type = IndexType::INVALID;
-    reader_ptr->read(&current_type, sizeof(current_type));
-    rp += sizeof(current_type);
-    reader_ptr->seekg(rp);
+    if (!parse_index(data, length, current_type, load_data_list)) {
+        STORAGE_LOG_ERROR << "read_index(" << location << ") broken index file of " << length << " bytes";
+        return nullptr;
+    }
 
-    while (rp < length) {
-        size_t meta_length;
-        reader_ptr->read(&meta_length, sizeof(meta_length));
-        rp += sizeof(meta_length);
-        reader_ptr->seekg(rp);
+    double span = recorder.RecordSection("End");
+    double rate = length * 1000000.0 / span / 1024 / 1024;
+    STORAGE_LOG_DEBUG << "read_index(" << location << ") rate " << rate << "MB/s";
 
-        auto meta = new char[meta_length];
-        reader_ptr->read(meta, meta_length);
-        rp += meta_length;
-        reader_ptr->seekg(rp);
+    if (s3_reader_ptr != nullptr) {
+        cache::DiskCacheMgr::GetInstance()->InsertFile(location, s3_reader_ptr->buffer_);
+    }
 
-        size_t bin_length;
-        reader_ptr->read(&bin_length, sizeof(bin_length));
-        rp += sizeof(bin_length);
-        reader_ptr->seekg(rp);
+    int64_t size = binary_size(load_data_list);
+    AppendDiskPath(current_type, location, load_data_list);
+    return LoadVecIndex(current_type, load_data_list, size);
+}
 
-        auto bin = new uint8_t[bin_length];
-        reader_ptr->read(bin, bin_length);
-        rp += bin_length;
-        reader_ptr->seekg(rp);
+Status
+read_index_blocks(const std::string& location, const std::vector<std::string>& names,
+                  knowhere::BinarySet& binary_set) {
+    bool s3_enable = false;
+    server::Config::GetInstance().GetStorageConfigS3Enable(s3_enable);
 
-        auto binptr = std::make_shared<uint8_t>();
-        binptr.reset(bin);
-        load_data_list.Append(std::string(meta, meta_length), binptr, bin_length);
-        delete[] meta;
+    // a file on s3 is read from its local copy if there is one
+    cache::DiskFileObjPtr disk_file = nullptr;
+    if (s3_enable) {
+        disk_file = cache::DiskCacheMgr::GetInstance()->GetFile(location);
     }
 
-    double span = recorder.RecordSection("End");
-    double rate = length * 1000000.0 / span / 1024 / 1024;
-    STORAGE_LOG_DEBUG << "read_index(" << location << ") rate " << rate << "MB/s";
+    size_t length = 0;
+    RangeReader read;
+    std::shared_ptr<storage::FileIOReader> file_reader;
+    if (s3_enable && disk_file == nullptr) {
+        int64_t object_length = 0;
+        auto status = storage::S3ClientWrapper::GetInstance().GetObjectLength(location, object_length);
+        if (!status.ok()) {
+            return status;
+        }
+        length = object_length;
+        read = [&location](size_t offset, size_t size, void* buffer) {
+            return size == 0 || storage::S3ClientWrapper::GetInstance()
+                                    .GetObjectRange(location, offset, size, static_cast<char*>(buffer))
+                                    .ok();
+        };
+    } else {
+        file_reader = std::make_shared<storage::FileIOReader>(disk_file != nullptr ? disk_file->Path() : location);
+        length = file_reader->length();
+        read = [&file_reader](size_t offset, size_t size, void* buffer) {
+            return size == 0 || file_reader->pread(buffer, offset, size, READ_THREAD_NUM);
+        };
+    }
 
-    return LoadVecIndex(current_type, load_data_list, length);
+    auto index_type = IndexType::INVALID;
+    std::vector<IndexFileBlock> blocks;
+    if (!read_directory(length, read, index_type, blocks)) {
+        std::string msg = "Index file " + location + " has no block directory";
+        WRAPPER_LOG_ERROR << msg;
+        return Status(KNOWHERE_ERROR, msg);
+    }
+
+    for (auto& name : names) {
+        auto iter = std::find_if(blocks.begin(), blocks.end(),
+                                 [&name](const IndexFileBlock& block) { return block.meta == name; });
+        if (iter == blocks.end()) {
+            std::string msg = "Index file " + location + " has no block " + name;
+            WRAPPER_LOG_ERROR << msg;
+            return Status(KNOWHERE_ERROR, msg);
+        }
+
+        size_t stored_length = iter->length & ~storage::COMPRESSED_BLOCK_FLAG;
+        std::shared_ptr<uint8_t> binptr = AllocLargeBuffer(stored_length);
+        if (!read(iter->offset, stored_length, binptr.get()) || !append_block(*iter, binptr, binary_set)) {
+            std::string msg = "Failed to read block " + name + " of index file " + location;
+            WRAPPER_LOG_ERROR << msg;
+            return Status(KNOWHERE_ERROR, msg);
+        }
+    }
+    return Status::OK();
 }
 
 Status
@@ -238,7 +627,24 @@ write_index(VecIndexPtr index, const std::string& location) {
     try {
         TimeRecorder recorder("write_index");
 
-        auto binaryset = index->Serialize();
+        bool s3_enable = false;
+        bool compress_enable = false;
+        bool direct_io_enable = false;
+        server::Config& config = server::Config::GetInstance();
+        config.GetStorageConfigS3Enable(s3_enable);
+        config.GetStorageConfigFileCompressEnable(compress_enable);
+        config.GetStorageConfigDirectIOEnable(direct_io_enable);
+
+        // a raw index as large as a file is streamed to it, a second copy serialized in memory would double it;
+        // a block is compressed whole, so it is serialized to memory then
+        std::string streamed_name = compress_enable ? "" : index->StreamedBlockName();
+        CountingIOWriter counter;
+        knowhere::BinarySet binaryset;
+        if (!streamed_name.empty()) {
+            index->SerializeTo(&counter);
+        } else {
+            binaryset = index->Serialize();
+        }
         auto index_type = index->GetType();
 
         fiu_do_on("VecIndex.write_index.throw_knowhere_exception", throw knowhere::KnowhereException(""));
@@ -246,21 +652,20 @@ write_index(VecIndexPtr index, const std::string& location) {
         fiu_do_on("VecIndex.write_index.throw_no_space_exception",
                   throw Exception(SERVER_INVALID_ARGUMENT, "No space left on device"));
 
-        bool s3_enable = false;
-        server::Config& config = server::Config::GetInstance();
-        config.GetStorageConfigS3Enable(s3_enable);
-
         std::shared_ptr<storage::IOWriter> writer_ptr;
         if (s3_enable) {
             writer_ptr = std::make_shared<storage::S3IOWriter>(location);
         } else {
-            writer_ptr = std::make_shared<storage::FileIOWriter>(location);
+            // files are written once, they shouldn't evict pages of those being searched
+            bool direct = direct_io_enable && binary_size(binaryset) + counter.length_ >= DIRECT_IO_MIN_SIZE;
+            writer_ptr = std::make_shared<storage::FileIOWriter>(location, direct);
         }
 
         recorder.RecordSection("Start");
 
         writer_ptr->write(&index_type, sizeof(IndexType));
 
+        std::vector<IndexFileBlock> blocks;
         for (auto& iter : binaryset.binary_map_) {
             auto meta = iter.first.c_str();
             size_t meta_length = iter.first.length();
@@ -268,9 +673,53 @@ write_index(VecIndexPtr index, const std::string& location) {
             writer_ptr->write((void*)meta, meta_length);
 
             auto binary = iter.second;
-            int64_t binary_length = binary->size;
+            // a compressed block is flagged in its length, blocks which don't shrink are written as they are
+            std::vector<uint8_t> compressed;
+            const uint8_t* stored = binary->data.get();
+            uint64_t stored_length = binary->size;
+            uint64_t binary_length = stored_length;
+            if (compress_enable && storage::CompressBlock(binary->data.get(), binary->size, compressed)) {
+                stored = compressed.data();
+                stored_length = compressed.size();
+                binary_length = stored_length | storage::COMPRESSED_BLOCK_FLAG;
+            }
             writer_ptr->write(&binary_length, sizeof(binary_length));
-            writer_ptr->write((void*)binary->data.get(), binary_length);
+            blocks.push_back({iter.first, writer_ptr->length(), binary_length,
+                              storage::BlockChecksum(stored, stored_length)});
+            writer_ptr->write(const_cast<uint8_t*>(stored), stored_length);
+        }
+
+        if (!streamed_name.empty()) {
+            size_t meta_length = streamed_name.length();
+            writer_ptr->write(&meta_length, sizeof(meta_length));
+            writer_ptr->write(const_cast<char*>(streamed_name.data()), meta_length);
+
+            uint64_t binary_length = counter.length_;
+            writer_ptr->write(&binary_length, sizeof(binary_length));
+            uint64_t offset = writer_ptr->length();
+            BlockIOWriter block_writer(writer_ptr.get());
+            index->SerializeTo(&block_writer);
+            if (block_writer.length_ != binary_length) {
+                throw Exception(SERVER_UNEXPECTED_ERROR, "Index changed while it was written to " + location);
+            }
+            blocks.push_back({streamed_name, offset, binary_length, block_writer.checksum_});
+        }
+
+        IndexFileTail tail = {writer_ptr->length(), blocks.size(), INDEX_FILE_VERSION, 0, INDEX_FILE_MAGIC};
+        for (auto& block : blocks) {
+            uint64_t meta_length = block.meta.length();
+            writer_ptr->write(&meta_length, sizeof(meta_length));
+            writer_ptr->write(const_cast<char*>(block.meta.data()), meta_length);
+            writer_ptr->write(&block.offset, sizeof(block.offset));
+            writer_ptr->write(&block.length, sizeof(block.length));
+            writer_ptr->write(&block.checksum, sizeof(block.checksum));
+        }
+        writer_ptr->write(&tail, sizeof(tail));
+
+        // a failed write is known once the file is finished, e.g. a part which failed to upload
+        auto status = writer_ptr->close();
+        if (!status.ok()) {
+            throw Exception(status.code(), status.message());
         }
 
         double span = recorder.RecordSection("End");
@@ -14,14 +14,21 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cache/DataObj.h"
 #include "knowhere/common/BinarySet.h"
 #include "knowhere/common/Config.h"
+#include "knowhere/index/IndexModel.h"
 #include "knowhere/index/vector_index/Quantizer.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "utils/Log.h"
 #include "utils/Status.h"
 
+namespace faiss {
+struct IOWriter;
+}
+
 namespace milvus {
 namespace engine {
 
@@ -45,6 +52,12 @@ enum class IndexType {
     FAISS_IVFPQ_MIX,
     SPTAG_BKT_RNT_CPU,
     HNSW,
+    HNSW_SQ8,
+    FAISS_IVFPQ_REFINE,
+    FAISS_IVFFP16_CPU,
+    FAISS_FLAT_FP16,  // ivf of a single list, every search scans all half float vectors
+    FAISS_IVFPQ_FASTSCAN,
+    DISKANN,  // graph and full vectors on disk, pq codes in memory
     FAISS_BIN_IDMAP = 100,
     FAISS_BIN_IVFLAT_CPU = 101,
 };
@@ -84,12 +97,26 @@ class VecIndex : public cache::DataObj {
         return Status::OK();
     }
 
+    // search neighbors within radius, each query get cfg->k slots, unused ones are filled with -1
+    virtual Status
+    RangeSearch(const int64_t& nq, const float* xq, float radius, float* dist, int64_t* ids,
+                const Config& cfg = Config()) {
+        ENGINE_LOG_ERROR << "RangeSearch not support";
+        return Status(KNOWHERE_ERROR, "range search not supported");
+    }
+
     virtual VecIndexPtr
     CopyToGpu(const int64_t& device_id, const Config& cfg = Config()) = 0;
 
     virtual VecIndexPtr
     CopyToCpu(const Config& cfg = Config()) = 0;
 
+    // split the index among gpus, nullptr if the index type can't be split
+    virtual VecIndexPtr
+    CopyToGpuShards(const std::vector<int64_t>& device_ids, const Config& cfg = Config()) {
+        return nullptr;
+    }
+
     // TODO(linxj): Deprecated
     //    virtual VecIndexPtr
     //    Clone() = 0;
@@ -112,12 +139,33 @@ class VecIndex : public cache::DataObj {
     void
     set_size(int64_t size);
 
+    // buffers of the data searches scan, see knowhere::VectorIndex::MemoryRanges
+    virtual std::vector<std::pair<const void*, size_t>>
+    MemoryRanges() {
+        return {};
+    }
+
+    // back the buffers by huge pages as cache_config.cpu_cache_huge_page asks, for an index kept in cpu cache
+    void
+    AdviseHugePages();
+
     virtual knowhere::BinarySet
     Serialize() = 0;
 
     virtual Status
     Load(const knowhere::BinarySet& index_binary) = 0;
 
+    // name of the one block a raw index writes by SerializeTo, the block goes straight to writer without the copy
+    // made by Serialize(); empty if the index can only be serialized by Serialize()
+    virtual std::string
+    StreamedBlockName() {
+        return "";
+    }
+
+    virtual void
+    SerializeTo(faiss::IOWriter* writer) {
+    }
+
     // TODO(linxj): refactor later
     ////////////////
     virtual knowhere::QuantizerPtr
@@ -145,6 +193,64 @@ class VecIndex : public cache::DataObj {
     CopyToGpuWithQuantizer(const int64_t& device_id, const Config& cfg = Config()) {
         return std::make_pair(nullptr, nullptr);
     }
+
+    // same for indexes sharing one coarse quantizer, 0 if unknown
+    virtual uint64_t
+    QuantizerFingerprint() {
+        return 0;
+    }
+
+    // inverted lists of an ivf index, 0 for other types or if unknown
+    virtual int64_t
+    Nlist() {
+        return 0;
+    }
+
+    // vectors are rotated before they are quantized, the index is only searched on cpu
+    virtual bool
+    Rotated() {
+        return false;
+    }
+
+    // lists probed by the queries with cfg->nprobe, cfg->coarse of a search of any index with the same quantizer
+    // fingerprint; coarse is nullptr if the index can't compute them
+    virtual Status
+    CoarseAssign(const int64_t& nq, const float* xq, const Config& cfg, knowhere::CoarseAssignmentPtr& coarse) {
+        coarse = nullptr;
+        return Status::OK();
+    }
+
+    // as CoarseAssign, the lists are searched in a quantizer of LoadQuantizer while the index stays on cpu
+    virtual Status
+    CoarseAssign(const int64_t& nq, const float* xq, const Config& cfg, const knowhere::QuantizerPtr& q,
+                 knowhere::CoarseAssignmentPtr& coarse) {
+        coarse = nullptr;
+        return Status::OK();
+    }
+
+    // model trained by an index of the same type and parameters, BuildAll uses it instead of training
+    virtual void
+    SetTrainedModel(const knowhere::IndexModelPtr& model) {
+    }
+
+    // model used by the last BuildAll, nullptr if the index type can't share it
+    virtual knowhere::IndexModelPtr
+    TrainedModel() {
+        return nullptr;
+    }
+
+    // gpus adding a part of the vectors each in BuildAll, after the model is trained on cfg->gpu_id;
+    // ignored by index types built on one device
+    virtual void
+    SetBuildDevices(const std::vector<int64_t>& device_ids) {
+    }
+
+    // index left on the gpu the last BuildAll ran on, handed over once so it isn't held by the built index;
+    // nullptr if the index wasn't built on one gpu
+    virtual VecIndexPtr
+    TakeDeviceIndex() {
+        return nullptr;
+    }
     ////////////////
  private:
     int64_t size_ = 0;
@@ -159,11 +265,18 @@ read_index(const std::string& location);
 VecIndexPtr
 read_index(const std::string& location, knowhere::BinarySet& index_binary);
 
+// read only the named blocks of an index file through the directory at its end, e.g. the quantizer of ivf;
+// files written before the directory was added can't be read in part
+extern Status
+read_index_blocks(const std::string& location, const std::vector<std::string>& names,
+                  knowhere::BinarySet& binary_set);
+
 extern VecIndexPtr
 GetVecIndexFactory(const IndexType& type, const Config& cfg = Config());
 
+// index_binary is cleared once loaded, buffers the index uses in place stay alive with it, the rest is freed at once
 extern VecIndexPtr
-LoadVecIndex(const IndexType& index_type, const knowhere::BinarySet& index_binary, int64_t size);
+LoadVecIndex(const IndexType& index_type, knowhere::BinarySet& index_binary, int64_t size);
 
 extern IndexType
 ConvertToCpuIndexType(const IndexType& type);
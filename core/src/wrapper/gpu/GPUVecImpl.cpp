@@ -13,6 +13,8 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexGPUIDMAP.h"
 #include "knowhere/index/vector_index/IndexGPUIVF.h"
+#include "knowhere/index/vector_index/IndexGPUIVFPQ.h"
+#include "knowhere/index/vector_index/IndexGPUIVFSQ.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/IndexIVFSQHybrid.h"
 #include "knowhere/index/vector_index/helpers/Cloner.h"
@@ -21,6 +23,11 @@
 #include "wrapper/VecImpl.h"
 
 #include <fiu-local.h>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
 /*
  * no parameter check in this layer.
  * only responible for index combination
@@ -29,6 +36,32 @@
 namespace milvus {
 namespace engine {
 
+namespace {
+
+// index adding vectors on the device, nullptr for types built on one device only
+std::shared_ptr<knowhere::VectorIndex>
+NewDeviceIndex(const IndexType& type, const int64_t& device_id) {
+    switch (type) {
+        case IndexType::FAISS_IVFFLAT_MIX:
+            return std::make_shared<knowhere::GPUIVF>(device_id);
+        case IndexType::FAISS_IVFPQ_MIX:
+            return std::make_shared<knowhere::GPUIVFPQ>(device_id);
+        case IndexType::FAISS_IVFSQ8_MIX:
+            return std::make_shared<knowhere::GPUIVFSQ>(device_id);
+        default:
+            return nullptr;
+    }
+}
+
+// gpu index of these types is a plain ivf index, it can be built in parts and searched as built
+bool
+IsGpuIvfType(const IndexType& type) {
+    return type == IndexType::FAISS_IVFFLAT_MIX || type == IndexType::FAISS_IVFPQ_MIX ||
+           type == IndexType::FAISS_IVFSQ8_MIX;
+}
+
+}  // namespace
+
 // TODO(linxj): add lock here.
 Status
 IVFMixIndex::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg, const int64_t& nt,
@@ -41,18 +74,39 @@ IVFMixIndex::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, co
         auto dataset = GenDatasetWithIds(nb, dim, xb, ids);
         auto preprocessor = index_->BuildPreprocessor(dataset, cfg);
         index_->set_preprocessor(preprocessor);
-        auto model = index_->Train(dataset, cfg);
-        index_->set_index_model(model);
-        index_->Add(dataset, cfg);
-
-        if (auto device_index = std::dynamic_pointer_cast<knowhere::GPUIndex>(index_)) {
-            auto host_index = device_index->CopyGpuToCpu(Config());
-            index_ = host_index;
-            type = ConvertToCpuIndexType(type);
-        } else {
+        if (model_ == nullptr) {
+            model_ = index_->Train(dataset, cfg);
+        }
+
+        auto device_index = std::dynamic_pointer_cast<knowhere::GPUIndex>(index_);
+        if (device_index == nullptr) {
             WRAPPER_LOG_ERROR << "Build IVFMIXIndex Failed";
             return Status(KNOWHERE_ERROR, "Build IVFMIXIndex Failed");
         }
+        // Train picks the device from cfg, a shared model skips it
+        device_index->SetGpuDevice(cfg->gpu_id);
+
+        std::vector<int64_t> devices = {cfg->gpu_id};
+        if (IsGpuIvfType(type)) {
+            for (auto device_id : build_devices_) {
+                if (device_id != cfg->gpu_id) {
+                    devices.push_back(device_id);
+                }
+            }
+        }
+
+        if (devices.size() > 1 && nb >= static_cast<int64_t>(devices.size())) {
+            index_ = AddOnDevices(devices, nb, xb, ids, cfg, preprocessor);
+        } else {
+            index_->set_index_model(model_);
+            index_->Add(dataset, cfg);
+            // kept for the caller to cache on the gpu, the first search there then skips copying it back
+            if (IsGpuIvfType(type)) {
+                device_index_ = std::make_shared<VecIndexImpl>(index_, ConvertToGpuIndexType(type), dim);
+            }
+            index_ = device_index->CopyGpuToCpu(Config());
+        }
+        type = ConvertToCpuIndexType(type);
     } catch (knowhere::KnowhereException& e) {
         WRAPPER_LOG_ERROR << e.what();
         return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
@@ -63,10 +117,73 @@ IVFMixIndex::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, co
     return Status::OK();
 }
 
+std::shared_ptr<knowhere::VectorIndex>
+IVFMixIndex::AddOnDevices(const std::vector<int64_t>& devices, const int64_t& nb, const float* xb, const int64_t* ids,
+                          const Config& cfg, const knowhere::PreprocessorPtr& preprocessor) {
+    // consecutive slices, merged in order the lists hold the vectors as one device would have added them
+    int64_t count = devices.size();
+    int64_t slice = (nb + count - 1) / count;
+
+    // a device adding vectors without ids numbers them from 0, the ids one device would give are passed instead
+    std::vector<int64_t> default_ids;
+    if (ids == nullptr) {
+        default_ids.resize(nb);
+        std::iota(default_ids.begin(), default_ids.end(), 0);
+        ids = default_ids.data();
+    }
+
+    std::vector<std::shared_ptr<knowhere::VectorIndex>> parts(count);
+    std::vector<std::string> errors(count);
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < count; ++i) {
+        int64_t begin = i * slice;
+        int64_t rows = std::min(slice, nb - begin);
+        if (rows <= 0) {
+            break;
+        }
+        parts[i] = (i == 0) ? index_ : NewDeviceIndex(type, devices[i]);
+        threads.emplace_back([&, i, begin, rows]() {
+            try {
+                auto part = parts[i];
+                part->set_preprocessor(preprocessor);
+                part->set_index_model(model_);
+                part->Add(GenDatasetWithIds(rows, dim, xb + begin * dim, ids + begin), cfg);
+                parts[i] = std::dynamic_pointer_cast<knowhere::GPUIndex>(part)->CopyGpuToCpu(Config());
+            } catch (std::exception& e) {
+                errors[i] = "gpu" + std::to_string(devices[i]) + ": " + e.what();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& error : errors) {
+        if (!error.empty()) {
+            throw knowhere::KnowhereException("Build IVFMIXIndex Failed, " + error);
+        }
+    }
+
+    auto merged = std::static_pointer_cast<knowhere::IVF>(parts[0]);
+    for (size_t i = 1; i < threads.size(); ++i) {
+        merged->Merge(std::static_pointer_cast<knowhere::IVF>(parts[i]));
+    }
+    WRAPPER_LOG_DEBUG << "Built IVFMIXIndex of " << nb << " rows on " << threads.size() << " gpus";
+    return merged;
+}
+
 Status
 IVFMixIndex::Load(const knowhere::BinarySet& index_binary) {
-    index_->Load(index_binary);
-    dim = Dimension();
+    try {
+        index_->Load(index_binary);
+        dim = Dimension();
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
     return Status::OK();
 }
 
@@ -128,6 +245,28 @@ IVFHybridIndex::UnsetQuantizer() {
     return Status::OK();
 }
 
+Status
+IVFHybridIndex::CoarseAssign(const int64_t& nq, const float* xq, const Config& cfg, const knowhere::QuantizerPtr& q,
+                             knowhere::CoarseAssignmentPtr& coarse) {
+    coarse = nullptr;
+    try {
+        if (auto new_idx = std::dynamic_pointer_cast<knowhere::IVFSQHybrid>(index_)) {
+            auto dataset = GenDataset(nq, dim, xq);
+            coarse = new_idx->CoarseAssign(q, dataset, cfg);
+        } else {
+            WRAPPER_LOG_ERROR << "Hybrid mode not support for index type: " << int(type);
+            return Status(KNOWHERE_ERROR, "not support");
+        }
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
 VecIndexPtr
 IVFHybridIndex::LoadData(const knowhere::QuantizerPtr& q, const Config& conf) {
     try {
@@ -148,6 +287,14 @@ IVFHybridIndex::LoadData(const knowhere::QuantizerPtr& q, const Config& conf) {
     return nullptr;
 }
 
+uint64_t
+IVFHybridIndex::QuantizerFingerprint() {
+    if (auto hybrid_idx = std::dynamic_pointer_cast<knowhere::IVFSQHybrid>(index_)) {
+        return hybrid_idx->QuantizerFingerprint();
+    }
+    return 0;
+}
+
 std::pair<VecIndexPtr, knowhere::QuantizerPtr>
 IVFHybridIndex::CopyToGpuWithQuantizer(const int64_t& device_id, const Config& cfg) {
     try {
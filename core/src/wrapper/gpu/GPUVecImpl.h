@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "knowhere/index/vector_index/VectorIndex.h"
 #include "wrapper/VecImpl.h"
@@ -33,6 +34,26 @@ class IVFMixIndex : public VecIndexImpl {
 
     Status
     Load(const knowhere::BinarySet& index_binary) override;
+
+    void
+    SetBuildDevices(const std::vector<int64_t>& device_ids) override {
+        build_devices_ = device_ids;
+    }
+
+    VecIndexPtr
+    TakeDeviceIndex() override {
+        return std::move(device_index_);
+    }
+
+ protected:
+    // every device adds a slice of the vectors to an index made from model_, the lists are merged on cpu
+    std::shared_ptr<knowhere::VectorIndex>
+    AddOnDevices(const std::vector<int64_t>& devices, const int64_t& nb, const float* xb, const int64_t* ids,
+                 const Config& cfg, const knowhere::PreprocessorPtr& preprocessor);
+
+ protected:
+    std::vector<int64_t> build_devices_;
+    VecIndexPtr device_index_ = nullptr;
 };
 
 class IVFHybridIndex : public IVFMixIndex {
@@ -50,11 +71,20 @@ class IVFHybridIndex : public IVFMixIndex {
     Status
     UnsetQuantizer() override;
 
+    using IVFMixIndex::CoarseAssign;
+
+    Status
+    CoarseAssign(const int64_t& nq, const float* xq, const Config& cfg, const knowhere::QuantizerPtr& q,
+                 knowhere::CoarseAssignmentPtr& coarse) override;
+
     std::pair<VecIndexPtr, knowhere::QuantizerPtr>
     CopyToGpuWithQuantizer(const int64_t& device_id, const Config& cfg) override;
 
     VecIndexPtr
     LoadData(const knowhere::QuantizerPtr& q, const Config& conf) override;
+
+    uint64_t
+    QuantizerFingerprint() override;
 };
 
 }  // namespace engine
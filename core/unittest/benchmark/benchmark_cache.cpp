@@ -0,0 +1,103 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <string>
+
+#include "cache/CacheMgr.h"
+#include "cache/DataObj.h"
+
+namespace milvus {
+namespace cache {
+
+namespace {
+
+constexpr int64_t ITEM_SIZE = 1024 * 1024;
+constexpr int64_t CACHE_ITEMS = 1024;
+
+class BenchmarkDataObj : public DataObj {
+ public:
+    int64_t
+    Size() override {
+        return ITEM_SIZE;
+    }
+};
+
+class BenchmarkCacheMgr : public CacheMgr<DataObjPtr> {
+ public:
+    BenchmarkCacheMgr() {
+        cache_ = std::make_shared<Cache<DataObjPtr>>(CACHE_ITEMS * ITEM_SIZE, 1UL << 16);
+    }
+};
+
+BenchmarkCacheMgr&
+SharedCacheMgr() {
+    static BenchmarkCacheMgr cache_mgr;
+    return cache_mgr;
+}
+
+}  // namespace
+
+// threads look up items of a working set, a missed item is inserted as a search loading its file,
+// a working set larger than the cache keeps evicting
+void
+BM_CacheGetInsert(benchmark::State& state) {
+    auto& cache_mgr = SharedCacheMgr();
+    if (state.thread_index == 0) {
+        cache_mgr.ClearCache();
+    }
+    int64_t keys = state.range(0);
+    std::mt19937_64 rng(state.thread_index);
+    std::uniform_int_distribution<int64_t> key_dist(0, keys - 1);
+    auto data = std::make_shared<BenchmarkDataObj>();
+
+    int64_t misses = 0;
+    for (auto _ : state) {
+        std::string key = "segment_" + std::to_string(key_dist(rng));
+        if (cache_mgr.GetItem(key) == nullptr) {
+            cache_mgr.InsertItem(key, data);
+            misses++;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["miss_rate"] = benchmark::Counter(static_cast<double>(misses) / state.iterations(),
+                                                     benchmark::Counter::kAvgThreads);
+}
+BENCHMARK(BM_CacheGetInsert)->Arg(CACHE_ITEMS / 4)->Arg(CACHE_ITEMS * 4)->ThreadRange(1, 32)->UseRealTime();
+
+// threads only look up items all of which are cached
+void
+BM_CacheGet(benchmark::State& state) {
+    auto& cache_mgr = SharedCacheMgr();
+    int64_t keys = state.range(0);
+    if (state.thread_index == 0) {
+        cache_mgr.ClearCache();
+        auto data = std::make_shared<BenchmarkDataObj>();
+        for (int64_t i = 0; i < keys; i++) {
+            cache_mgr.InsertItem("segment_" + std::to_string(i), data);
+        }
+    }
+    std::mt19937_64 rng(state.thread_index);
+    std::uniform_int_distribution<int64_t> key_dist(0, keys - 1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache_mgr.GetItem("segment_" + std::to_string(key_dist(rng))));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CacheGet)->Arg(CACHE_ITEMS / 4)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace cache
+}  // namespace milvus
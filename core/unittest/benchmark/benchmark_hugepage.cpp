@@ -0,0 +1,157 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "utils/LargeBuffer.h"
+
+namespace milvus {
+
+namespace {
+
+constexpr size_t SCAN_BYTES = 1UL << 30;
+constexpr size_t ROW_BYTES = 512;  // a vector of dim 128
+
+// dTLB load misses of the calling thread, the counter reads 0 where perf events aren't allowed
+class TlbMissCounter {
+ public:
+    TlbMissCounter() {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        fd_ = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    ~TlbMissCounter() {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    void
+    Start() {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    int64_t
+    Stop() {
+        int64_t count = 0;
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+                count = 0;
+            }
+        }
+        return count;
+    }
+
+ private:
+    int fd_ = -1;
+};
+
+std::shared_ptr<uint8_t>
+AllocScanBuffer(HugePageMode mode) {
+    auto previous = GetHugePageMode();
+    SetHugePageMode(mode);
+    auto buffer = AllocLargeBuffer(SCAN_BYTES);
+    SetHugePageMode(previous);
+
+    std::mt19937 rng(0);
+    auto data = reinterpret_cast<float*>(buffer.get());
+    for (size_t i = 0; i < SCAN_BYTES / sizeof(float); i++) {
+        data[i] = static_cast<float>(rng() & 0xff);
+    }
+    return buffer;
+}
+
+}  // namespace
+
+// rows picked at random across the buffer, as probes of inverted lists and hops of a graph land
+void
+BM_RandomRowScan(benchmark::State& state) {
+    auto mode = static_cast<HugePageMode>(state.range(0));
+    auto buffer = AllocScanBuffer(mode);
+    size_t rows = SCAN_BYTES / ROW_BYTES;
+    std::mt19937_64 rng(rows);
+    std::vector<size_t> picks(1 << 20);
+    for (auto& pick : picks) {
+        pick = rng() % rows;
+    }
+
+    TlbMissCounter counter;
+    int64_t misses = 0;
+    for (auto _ : state) {
+        counter.Start();
+        float sum = 0;
+        for (auto pick : picks) {
+            auto row = reinterpret_cast<const float*>(buffer.get() + pick * ROW_BYTES);
+            for (size_t j = 0; j < ROW_BYTES / sizeof(float); j++) {
+                sum += row[j];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        misses += counter.Stop();
+    }
+    state.SetItemsProcessed(state.iterations() * picks.size());
+    state.counters["dtlb_misses_per_row"] =
+        benchmark::Counter(static_cast<double>(misses) / (state.iterations() * picks.size()));
+}
+BENCHMARK(BM_RandomRowScan)
+    ->Arg(static_cast<int64_t>(HugePageMode::OFF))
+    ->Arg(static_cast<int64_t>(HugePageMode::THP))
+    ->Arg(static_cast<int64_t>(HugePageMode::HUGETLB))
+    ->Unit(benchmark::kMillisecond);
+
+// the whole buffer read in order, as a brute-force scan of raw vectors
+void
+BM_SequentialScan(benchmark::State& state) {
+    auto mode = static_cast<HugePageMode>(state.range(0));
+    auto buffer = AllocScanBuffer(mode);
+
+    TlbMissCounter counter;
+    int64_t misses = 0;
+    for (auto _ : state) {
+        counter.Start();
+        auto data = reinterpret_cast<const float*>(buffer.get());
+        float sum = 0;
+        for (size_t i = 0; i < SCAN_BYTES / sizeof(float); i++) {
+            sum += data[i];
+        }
+        benchmark::DoNotOptimize(sum);
+        misses += counter.Stop();
+    }
+    state.SetBytesProcessed(state.iterations() * SCAN_BYTES);
+    state.counters["dtlb_misses"] = benchmark::Counter(static_cast<double>(misses) / state.iterations());
+}
+BENCHMARK(BM_SequentialScan)
+    ->Arg(static_cast<int64_t>(HugePageMode::OFF))
+    ->Arg(static_cast<int64_t>(HugePageMode::THP))
+    ->Arg(static_cast<int64_t>(HugePageMode::HUGETLB))
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace milvus
@@ -0,0 +1,190 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "utils/BlockingQueue.h"
+#include "utils/RingQueue.h"
+#include "utils/ThreadPool.h"
+
+namespace milvus {
+
+namespace {
+
+constexpr int64_t QUEUE_ITEMS = 1 << 16;
+constexpr size_t QUEUE_CAPACITY = 1024;
+
+// the pool as it was before the ring, tasks in a std::queue behind one mutex and condition variable
+class MutexThreadPool {
+ public:
+    explicit MutexThreadPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty()) {
+                            return;
+                        }
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    condition_.notify_all();
+                    task();
+                }
+            });
+        }
+    }
+
+    ~MutexThreadPool() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    std::future<void>
+    enqueue(std::function<void()> func) {
+        auto task = std::make_shared<std::packaged_task<void()>>(std::move(func));
+        auto res = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return tasks_.size() < QUEUE_CAPACITY; });
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        condition_.notify_all();
+        return res;
+    }
+
+ private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+};
+
+void
+QueueArgs(benchmark::internal::Benchmark* bench) {
+    for (int64_t threads : {1, 4, 16}) {
+        bench->Args({threads});
+    }
+}
+
+// tasks as short as a reduce of a few segments, the hand over dominates
+template <typename Pool>
+void
+RunShortTasks(benchmark::State& state) {
+    int64_t threads = state.range(0);
+    Pool pool(threads);
+    std::atomic<int64_t> done(0);
+    for (auto _ : state) {
+        std::vector<std::future<void>> futures;
+        futures.reserve(QUEUE_ITEMS);
+        for (int64_t i = 0; i < QUEUE_ITEMS; i++) {
+            futures.emplace_back(pool.enqueue([&done]() { done.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        for (auto& future : futures) {
+            future.wait();
+        }
+    }
+    benchmark::DoNotOptimize(done.load());
+    state.SetItemsProcessed(state.iterations() * QUEUE_ITEMS);
+}
+
+}  // namespace
+
+// the same number of producers and consumers passing items through a queue
+void
+BM_BlockingQueueHandover(benchmark::State& state) {
+    int64_t threads = state.range(0);
+    for (auto _ : state) {
+        server::BlockingQueue<int64_t> queue;
+        queue.SetCapacity(QUEUE_CAPACITY);
+        std::vector<std::thread> workers;
+        for (int64_t t = 0; t < threads; t++) {
+            workers.emplace_back([&]() {
+                for (int64_t i = 0; i < QUEUE_ITEMS / threads; i++) {
+                    queue.Put(i);
+                }
+            });
+            workers.emplace_back([&]() {
+                for (int64_t i = 0; i < QUEUE_ITEMS / threads; i++) {
+                    benchmark::DoNotOptimize(queue.Take());
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * QUEUE_ITEMS);
+}
+BENCHMARK(BM_BlockingQueueHandover)->Apply(QueueArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void
+BM_RingQueueHandover(benchmark::State& state) {
+    int64_t threads = state.range(0);
+    for (auto _ : state) {
+        server::RingQueue<int64_t> queue(QUEUE_CAPACITY);
+        std::vector<std::thread> workers;
+        for (int64_t t = 0; t < threads; t++) {
+            workers.emplace_back([&]() {
+                for (int64_t i = 0; i < QUEUE_ITEMS / threads; i++) {
+                    int64_t item = i;
+                    queue.Put(std::move(item));
+                }
+            });
+            workers.emplace_back([&]() {
+                int64_t item = 0;
+                for (int64_t i = 0; i < QUEUE_ITEMS / threads; i++) {
+                    queue.Take(item);
+                    benchmark::DoNotOptimize(item);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * QUEUE_ITEMS);
+}
+BENCHMARK(BM_RingQueueHandover)->Apply(QueueArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void
+BM_MutexThreadPool(benchmark::State& state) {
+    RunShortTasks<MutexThreadPool>(state);
+}
+BENCHMARK(BM_MutexThreadPool)->Apply(QueueArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void
+BM_ThreadPool(benchmark::State& state) {
+    RunShortTasks<ThreadPool>(state);
+}
+BENCHMARK(BM_ThreadPool)->Apply(QueueArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace milvus
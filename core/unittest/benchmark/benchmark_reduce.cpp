@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "scheduler/task/SearchTask.h"
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+
+// results of one segment, sorted ascending per query as a search returns them
+SearchResult
+RandomResult(size_t nq, size_t topk, std::mt19937_64& rng) {
+    std::uniform_real_distribution<float> distance(0.0, 1.0);
+    SearchResult result;
+    result.k_ = topk;
+    result.ids_.resize(nq * topk);
+    result.distances_.resize(nq * topk);
+    for (size_t i = 0; i < nq * topk; i++) {
+        result.ids_[i] = static_cast<int64_t>(rng());
+        result.distances_[i] = distance(rng);
+    }
+    for (size_t i = 0; i < nq; i++) {
+        std::sort(result.distances_.begin() + i * topk, result.distances_.begin() + (i + 1) * topk);
+    }
+    return result;
+}
+
+SearchResults
+RandomResults(int64_t segments, size_t nq, size_t topk) {
+    std::mt19937_64 rng(segments * nq * topk);
+    SearchResults results;
+    for (int64_t i = 0; i < segments; i++) {
+        results.emplace_back(RandomResult(nq, topk, rng));
+    }
+    return results;
+}
+
+void
+ReduceArgs(benchmark::internal::Benchmark* bench) {
+    for (int64_t segments : {4, 16, 64}) {
+        for (int64_t nq : {1, 100, 1000}) {
+            for (int64_t topk : {10, 100, 1000}) {
+                bench->Args({segments, nq, topk});
+            }
+        }
+    }
+}
+
+}  // namespace
+
+// segment results merged one by one into the result set, as search tasks finish
+void
+BM_MergeTopkToResultSet(benchmark::State& state) {
+    int64_t segments = state.range(0);
+    size_t nq = state.range(1);
+    size_t topk = state.range(2);
+    auto results = RandomResults(segments, nq, topk);
+
+    for (auto _ : state) {
+        ResultIds tar_ids;
+        ResultDistances tar_distances;
+        for (auto& result : results) {
+            XSearchTask::MergeTopkToResultSet(result.ids_, result.distances_, result.k_, nq, topk, true, tar_ids,
+                                              tar_distances);
+        }
+        benchmark::DoNotOptimize(tar_ids.data());
+    }
+    state.SetItemsProcessed(state.iterations() * segments * nq * topk);
+}
+BENCHMARK(BM_MergeTopkToResultSet)->Apply(ReduceArgs)->Unit(benchmark::kMicrosecond);
+
+// all segment results merged at once with a heap per query
+void
+BM_MergeTopkHeap(benchmark::State& state) {
+    int64_t segments = state.range(0);
+    size_t nq = state.range(1);
+    size_t topk = state.range(2);
+    auto results = RandomResults(segments, nq, topk);
+
+    for (auto _ : state) {
+        ResultIds tar_ids;
+        ResultDistances tar_distances;
+        XSearchTask::MergeTopkHeap(results, nq, topk, true, tar_ids, tar_distances);
+        benchmark::DoNotOptimize(tar_ids.data());
+    }
+    state.SetItemsProcessed(state.iterations() * segments * nq * topk);
+}
+BENCHMARK(BM_MergeTopkHeap)->Apply(ReduceArgs)->Unit(benchmark::kMicrosecond);
+
+}  // namespace scheduler
+}  // namespace milvus
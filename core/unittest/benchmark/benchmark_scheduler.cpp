@@ -0,0 +1,148 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "scheduler/ResourceFactory.h"
+#include "scheduler/ResourceMgr.h"
+#include "scheduler/Scheduler.h"
+#include "scheduler/TaskTable.h"
+#include "scheduler/event/TaskTableUpdatedEvent.h"
+#include "scheduler/task/TestTask.h"
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+
+void
+TaskTableArgs(benchmark::internal::Benchmark* bench) {
+    for (int64_t executors : {1, 2, 4, 8}) {
+        for (int64_t tasks : {256, 4096}) {
+            bench->Args({executors, tasks});
+        }
+    }
+}
+
+void
+EventDispatchArgs(benchmark::internal::Benchmark* bench) {
+    for (int64_t posters : {1, 4, 16}) {
+        for (int64_t events : {1 << 10, 1 << 16}) {
+            bench->Args({posters, events});
+        }
+    }
+}
+
+}  // namespace
+
+// one thread puts tasks as the scheduler does, one loader and a number of executors drive them through
+// the table, as the threads of a resource do
+void
+BM_TaskTablePick(benchmark::State& state) {
+    int64_t executors = state.range(0);
+    int64_t tasks = state.range(1);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto table = std::make_shared<TaskTable>();
+        std::vector<TaskPtr> task_list;
+        TableFileSchemaPtr dummy = nullptr;
+        for (int64_t i = 0; i < tasks; i++) {
+            task_list.emplace_back(
+                std::make_shared<TestTask>(std::make_shared<server::Context>("dummy_request_id"), dummy, nullptr));
+        }
+        std::atomic<int64_t> loaded(0), executed(0);
+        state.ResumeTiming();
+
+        std::vector<std::thread> threads;
+        threads.emplace_back([&]() {
+            for (auto& task : task_list) {
+                table->Put(task);
+            }
+        });
+        threads.emplace_back([&]() {
+            while (loaded < tasks) {
+                auto indexes = table->PickToLoad(1);
+                if (indexes.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (auto index : indexes) {
+                    if (table->Load(index) && table->Loaded(index)) {
+                        ++loaded;
+                    }
+                }
+            }
+        });
+        for (int64_t i = 0; i < executors; i++) {
+            threads.emplace_back([&]() {
+                while (executed < tasks) {
+                    auto indexes = table->PickToExecute(1);
+                    if (indexes.empty()) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (auto index : indexes) {
+                        if (table->Execute(index) && table->Executed(index)) {
+                            ++executed;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * tasks);
+}
+BENCHMARK(BM_TaskTablePick)->Apply(TaskTableArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// threads post task table updated events, the time is the one until the scheduler has handled them all
+void
+BM_SchedulerEventDispatch(benchmark::State& state) {
+    int64_t posters = state.range(0);
+    int64_t events = state.range(1);
+
+    auto res_mgr = std::make_shared<ResourceMgr>();
+    auto cpu = res_mgr->Add(ResourceFactory::Create("cpu", "CPU", 0, true)).lock();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto scheduler = std::make_shared<Scheduler>(res_mgr);
+        scheduler->Start();
+        state.ResumeTiming();
+
+        std::vector<std::thread> threads;
+        for (int64_t i = 0; i < posters; i++) {
+            threads.emplace_back([&]() {
+                for (int64_t j = 0; j < events / posters; j++) {
+                    scheduler->PostEvent(std::make_shared<TaskTableUpdatedEvent>(cpu));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        scheduler->Stop();
+    }
+    state.SetItemsProcessed(state.iterations() * events);
+}
+BENCHMARK(BM_SchedulerEventDispatch)->Apply(EventDispatchArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -22,7 +22,9 @@
 #include "db/DB.h"
 #include "db/DBFactory.h"
 #include "db/DBImpl.h"
+#include "db/Utils.h"
 #include "db/meta/MetaConsts.h"
+#include "db/meta/SqliteMetaImpl.h"
 #include "db/utils.h"
 #include "server/Config.h"
 #include "utils/CommonUtil.h"
@@ -362,11 +364,13 @@ TEST_F(DBTest, SEARCH_TEST) {
                                   result_distances);
         ASSERT_TRUE(stat.ok());
 
+        FIU_ENABLE_FIU("SnapshotMetaImpl.FilesToSearch.skip_snapshot");
         FIU_ENABLE_FIU("SqliteMetaImpl.FilesToSearch.throw_exception");
         stat = db_->QueryByFileID(dummy_context_, TABLE_NAME, file_ids, k, 10, xq, dates, result_ids,
                                   result_distances);
         ASSERT_FALSE(stat.ok());
         fiu_disable("SqliteMetaImpl.FilesToSearch.throw_exception");
+        fiu_disable("SnapshotMetaImpl.FilesToSearch.skip_snapshot");
 
         FIU_ENABLE_FIU("DBImpl.QueryByFileID.empty_files_array");
         stat = db_->QueryByFileID(dummy_context_, TABLE_NAME, file_ids, k, 10, xq, dates, result_ids,
@@ -387,10 +391,12 @@ TEST_F(DBTest, SEARCH_TEST) {
         stat = db_->Query(dummy_context_, TABLE_NAME, tags, k, 10, xq, result_ids, result_distances);
         ASSERT_TRUE(stat.ok());
 
+        FIU_ENABLE_FIU("SnapshotMetaImpl.FilesToSearch.skip_snapshot");
         FIU_ENABLE_FIU("SqliteMetaImpl.FilesToSearch.throw_exception");
         stat = db_->Query(dummy_context_, TABLE_NAME, tags, k, 10, xq, result_ids, result_distances);
         ASSERT_FALSE(stat.ok());
         fiu_disable("SqliteMetaImpl.FilesToSearch.throw_exception");
+        fiu_disable("SnapshotMetaImpl.FilesToSearch.skip_snapshot");
     }
 
 #ifdef CUSTOMIZATION
@@ -460,10 +466,27 @@ TEST_F(DBTest, PRELOADTABLE_TEST) {
     int64_t cur_cache_usage = milvus::cache::CpuCacheMgr::GetInstance()->CacheUsage();
     ASSERT_TRUE(prev_cache_usage < cur_cache_usage);
 
+    std::string progress;
+    stat = db_->GetPreloadProgress(progress);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_NE(progress.find(TABLE_NAME), std::string::npos);
+    ASSERT_NE(progress.find("finished"), std::string::npos);
+
+    // files of a pinned table stay in cache
+    stat = db_->SetTableCacheQuota(TABLE_NAME, 0, 0, true);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_GT(milvus::cache::CpuCacheMgr::GetInstance()->GroupUsage(TABLE_NAME), 0);
+    ASSERT_FALSE(db_->SetTableCacheQuota(TABLE_NAME, 100, 10, false).ok());
+    ASSERT_FALSE(db_->SetTableCacheQuota("no_such_table", 0, 0, true).ok());
+    stat = db_->SetTableCacheQuota(TABLE_NAME, 0, 0, false);
+    ASSERT_TRUE(stat.ok());
+
+    FIU_ENABLE_FIU("SnapshotMetaImpl.FilesToSearch.skip_snapshot");
     FIU_ENABLE_FIU("SqliteMetaImpl.FilesToSearch.throw_exception");
     stat = db_->PreloadTable(TABLE_NAME);
     ASSERT_FALSE(stat.ok());
     fiu_disable("SqliteMetaImpl.FilesToSearch.throw_exception");
+    fiu_disable("SnapshotMetaImpl.FilesToSearch.skip_snapshot");
 
     //create a partition
     stat = db_->CreatePartition(TABLE_NAME, "part0", "0");
@@ -487,6 +510,154 @@ TEST_F(DBTest, PRELOADTABLE_TEST) {
     fiu_disable("DBImpl.PreloadTable.engine_throw_exception");
 }
 
+TEST_F(DBTest, BACKUP_CACHE_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::VectorsData xb;
+    BuildVectors(VECTOR_COUNT, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush({TABLE_NAME});
+    ASSERT_TRUE(stat.ok());
+    stat = db_->PreloadTable(TABLE_NAME);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::TableIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    stat = db_->CreateIndex(TABLE_NAME, index);
+    ASSERT_TRUE(stat.ok());
+
+    // raw files replaced by an index leave the cache, the index holds their vectors
+    milvus::engine::meta::SqliteMetaImpl meta(GetOptions().meta_);
+    milvus::engine::meta::TableFilesSchema backup_files;
+    stat = meta.FilesByType(TABLE_NAME, {(int)milvus::engine::meta::TableFileSchema::BACKUP}, backup_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_FALSE(backup_files.empty());
+    for (auto& file : backup_files) {
+        milvus::engine::utils::GetTableFilePath(GetOptions().meta_, file);
+        ASSERT_FALSE(milvus::cache::CpuCacheMgr::GetInstance()->ItemExists(file.location_));
+    }
+}
+
+TEST_F(DBTest, REPLACE_INDEX_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::VectorsData xb;
+    BuildVectors(VECTOR_COUNT, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush({TABLE_NAME});
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::TableIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    stat = db_->CreateIndex(TABLE_NAME, index);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::meta::SqliteMetaImpl meta(GetOptions().meta_);
+    milvus::engine::meta::TableFilesSchema old_index_files, old_backup_files;
+    stat = meta.FilesByType(TABLE_NAME, {(int)milvus::engine::meta::TableFileSchema::INDEX}, old_index_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_FALSE(old_index_files.empty());
+    stat = meta.FilesByType(TABLE_NAME, {(int)milvus::engine::meta::TableFileSchema::BACKUP}, old_backup_files);
+    ASSERT_TRUE(stat.ok());
+
+    // the ivfflat files are replaced one by one, rebuilt from the same backup files
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFSQ8;
+    stat = db_->CreateIndex(TABLE_NAME, index);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::meta::TableFilesSchema index_files, backup_files;
+    stat = meta.FilesByType(TABLE_NAME, {(int)milvus::engine::meta::TableFileSchema::INDEX}, index_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(index_files.size(), old_index_files.size());
+    for (auto& file : index_files) {
+        ASSERT_EQ(file.engine_type_, index.engine_type_);
+    }
+    stat = meta.FilesByType(TABLE_NAME, {(int)milvus::engine::meta::TableFileSchema::BACKUP}, backup_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(backup_files.size(), old_backup_files.size());
+
+    uint64_t row_count = 0;
+    stat = db_->GetTableRowCount(TABLE_NAME, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, VECTOR_COUNT);
+}
+
+TEST_F(DBTest, EXPORT_IMPORT_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->CreatePartition(TABLE_NAME, "", "0");
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::VectorsData xb;
+    BuildVectors(VECTOR_COUNT, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    milvus::engine::VectorsData xp;
+    BuildVectors(VECTOR_COUNT, xp);
+    stat = db_->InsertVectors(TABLE_NAME, "0", xp);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::TableIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    stat = db_->CreateIndex(TABLE_NAME, index);
+    ASSERT_TRUE(stat.ok());
+
+    // vectors inserted into the partition are still buffered, the export flushes them
+    std::string path = std::string(CONFIG_PATH) + "/export";
+    stat = db_->ExportTable(TABLE_NAME, path);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->ExportTable(TABLE_NAME, path);
+    ASSERT_FALSE(stat.ok());
+
+    std::string import_table = std::string(TABLE_NAME) + "_import";
+    stat = db_->ImportTable(path, import_table);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t row_count = 0, import_row_count = 0;
+    stat = db_->GetTableRowCount(TABLE_NAME, row_count);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->GetTableRowCount(import_table, import_row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(import_row_count, row_count);
+
+    std::vector<milvus::engine::meta::TableSchema> partitions;
+    stat = db_->ShowPartitions(import_table, partitions);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(partitions.size(), 1);
+    ASSERT_EQ(partitions[0].partition_tag_, "0");
+
+    milvus::engine::TableIndex import_index;
+    stat = db_->DescribeIndex(import_table, import_index);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(import_index.engine_type_, index.engine_type_);
+
+    // the index files are registered as imported, not built again
+    milvus::engine::meta::SqliteMetaImpl meta(GetOptions().meta_);
+    milvus::engine::meta::TableFilesSchema index_files;
+    stat = meta.FilesByType(import_table, {(int)milvus::engine::meta::TableFileSchema::INDEX}, index_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_FALSE(index_files.empty());
+
+    // an export missing its files fails to import, the table created for it is dropped again
+    std::string broken_path = std::string(CONFIG_PATH) + "/export_broken";
+    boost::filesystem::create_directories(broken_path);
+    boost::filesystem::copy_file(path + "/meta.json", broken_path + "/meta.json");
+    std::string broken_table = std::string(TABLE_NAME) + "_broken";
+    stat = db_->ImportTable(broken_path, broken_table);
+    ASSERT_FALSE(stat.ok());
+    bool has_table = true;
+    stat = db_->HasTable(broken_table, has_table);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_FALSE(has_table);
+}
+
 TEST_F(DBTest, SHUTDOWN_TEST) {
     db_->Stop();
 
@@ -542,6 +713,12 @@ TEST_F(DBTest, SHUTDOWN_TEST) {
     stat = db_->DropIndex(TABLE_NAME);
     ASSERT_FALSE(stat.ok());
 
+    stat = db_->Flush(std::vector<std::string>());
+    ASSERT_FALSE(stat.ok());
+
+    stat = db_->BulkLoad(table_info.table_id_, "", xb);
+    ASSERT_FALSE(stat.ok());
+
     std::vector<std::string> tags;
     milvus::engine::meta::DatesT dates;
     milvus::engine::ResultIds result_ids;
@@ -727,6 +904,272 @@ TEST_F(DBTest, INDEX_TEST) {
     ASSERT_TRUE(stat.ok());
 }
 
+TEST_F(DBTest, CREATE_INDEX_ASYNC_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+
+    uint64_t nb = VECTOR_COUNT;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_EQ(xb.id_array_.size(), nb);
+
+    // the creation is kept in meta until background build is done with it
+    milvus::engine::TableIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    stat = db_->CreateIndexAsync(TABLE_NAME, index);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::meta::TableSchema table_info_get;
+    table_info_get.table_id_ = TABLE_NAME;
+    std::string progress;
+    for (int i = 0; i < 100; ++i) {
+        stat = db_->DescribeTable(table_info_get);
+        ASSERT_TRUE(stat.ok());
+        if ((table_info_get.flag_ & milvus::engine::meta::FLAG_MASK_INDEX_PENDING) == 0) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_EQ(table_info_get.flag_ & milvus::engine::meta::FLAG_MASK_INDEX_PENDING, 0);
+
+    stat = db_->GetIndexProgress(progress);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_NE(progress.find(TABLE_NAME), std::string::npos);
+    ASSERT_NE(progress.find("finished"), std::string::npos);
+
+    uint64_t indexed_rows = 0, total_rows = 0;
+    stat = db_->GetIndexRowCount(TABLE_NAME, indexed_rows, total_rows);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(indexed_rows, total_rows);
+    stat = db_->GetIndexRowCount("not_exist_table", indexed_rows, total_rows);
+    ASSERT_FALSE(stat.ok());
+
+    stat = db_->DropIndex(TABLE_NAME);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->GetIndexProgress(progress);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(progress.find(TABLE_NAME), std::string::npos);
+}
+
+TEST_F(DBTest, BULK_LOAD_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    table_info.index_file_size_ = 4 * milvus::engine::M;
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    // 1KB each vector, split into 3 files
+    uint64_t nb = 10000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->BulkLoad(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(xb.id_array_.size(), nb);
+
+    // vectors are in table files once loaded
+    uint64_t row_count = 0;
+    stat = db_->GetTableRowCount(TABLE_NAME, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, nb);
+
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = 1;
+    xq.float_data_.assign(xb.float_data_.end() - TABLE_DIM, xb.float_data_.end());
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, TABLE_NAME, tags, 5, 10, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids[0], xb.id_array_.back());
+
+    stat = db_->BulkLoad(TABLE_NAME, "notexist", xb);
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(DBTest, DELETE_BY_ID_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = 1;
+    xq.float_data_.assign(xb.float_data_.begin(), xb.float_data_.begin() + TABLE_DIM);
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, TABLE_NAME, tags, 5, 10, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids[0], xb.id_array_[0]);
+
+    // buffered vectors are deleted too, a deleted vector isn't found by itself
+    stat = db_->DeleteByID(TABLE_NAME, {xb.id_array_[0], xb.id_array_[1]});
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Query(dummy_context_, TABLE_NAME, tags, 5, 10, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    for (auto id : result_ids) {
+        ASSERT_NE(id, xb.id_array_[0]);
+        ASSERT_NE(id, xb.id_array_[1]);
+    }
+
+    stat = db_->DeleteByID("notexist", {xb.id_array_[0]});
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(DBTest, GET_VECTOR_BY_ID_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    // buffered vectors are found too
+    milvus::engine::VectorsData vector;
+    stat = db_->GetVectorByID(TABLE_NAME, xb.id_array_[10], vector);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(vector.vector_count_, 1UL);
+    ASSERT_EQ(vector.float_data_,
+              std::vector<float>(xb.float_data_.begin() + 10 * TABLE_DIM, xb.float_data_.begin() + 11 * TABLE_DIM));
+
+    stat = db_->DeleteByID(TABLE_NAME, {xb.id_array_[10]});
+    ASSERT_TRUE(stat.ok());
+    stat = db_->GetVectorByID(TABLE_NAME, xb.id_array_[10], vector);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(vector.vector_count_, 0UL);
+
+    stat = db_->GetVectorByID("notexist", xb.id_array_[0], vector);
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(DBTest, GET_SEARCH_FILES_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->CreatePartition(TABLE_NAME, "part0", "0");
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "0", xb);
+    ASSERT_TRUE(stat.ok());
+
+    // buffered vectors are in no file
+    milvus::engine::meta::TableFilesSchema files;
+    stat = db_->GetSearchFiles(TABLE_NAME, {}, files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_TRUE(files.empty());
+
+    stat = db_->Flush({TABLE_NAME});
+    ASSERT_TRUE(stat.ok());
+    stat = db_->GetSearchFiles(TABLE_NAME, {}, files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_FALSE(files.empty());
+    for (auto& file : files) {
+        ASSERT_EQ(file.table_id_, "part0");
+    }
+
+    stat = db_->GetSearchFiles(TABLE_NAME, {"1"}, files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_TRUE(files.empty());
+
+    stat = db_->GetSearchFiles("notexist", {}, files);
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(DBTest, QUERY_EXACT_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush({TABLE_NAME});
+    ASSERT_TRUE(stat.ok());
+
+    // indexed vectors are searched on the raw file kept as backup
+    milvus::engine::TableIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFSQ8;
+    stat = db_->CreateIndex(TABLE_NAME, index);
+    ASSERT_TRUE(stat.ok());
+
+    // buffered vectors are searched too
+    milvus::engine::VectorsData xb_buffered;
+    BuildVectors(nb, xb_buffered);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb_buffered);
+    ASSERT_TRUE(stat.ok());
+
+    const uint64_t nq = 5, k = 10;
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = nq;
+    xq.float_data_.assign(xb.float_data_.begin(), xb.float_data_.begin() + nq * TABLE_DIM);
+
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->QueryExact(dummy_context_, TABLE_NAME, {}, k, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), nq * k);
+    for (uint64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(result_ids[i * k], xb.id_array_[i]);
+    }
+
+    xq.float_data_.assign(xb_buffered.float_data_.begin(), xb_buffered.float_data_.begin() + nq * TABLE_DIM);
+    stat = db_->QueryExact(dummy_context_, TABLE_NAME, {}, k, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    for (uint64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(result_ids[i * k], xb_buffered.id_array_[i]);
+    }
+
+    stat = db_->QueryExact(dummy_context_, "notexist", {}, k, xq, result_ids, result_distances);
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(DBTest, LARGE_TOPK_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 5000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush({TABLE_NAME});
+    ASSERT_TRUE(stat.ok());
+
+    // more results than a gpu selects, every query gets all k of them in order
+    const uint64_t nq = 2, k = 3000, nprobe = 10;
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = nq;
+    xq.float_data_.assign(xb.float_data_.begin(), xb.float_data_.begin() + nq * TABLE_DIM);
+
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, TABLE_NAME, tags, k, nprobe, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), nq * k);
+    for (uint64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(result_ids[i * k], xb.id_array_[i]);
+        for (uint64_t j = 1; j < k; j++) {
+            ASSERT_GE(result_ids[i * k + j], 0);
+            ASSERT_LE(result_distances[i * k + j - 1], result_distances[i * k + j]);
+        }
+    }
+}
+
 TEST_F(DBTest, PARTITION_TEST) {
     milvus::engine::meta::TableSchema table_info = BuildTableSchema();
     auto stat = db_->CreateTable(table_info);
@@ -15,7 +15,9 @@
 
 #include "db/engine/EngineFactory.h"
 #include "db/engine/ExecutionEngineImpl.h"
+#include "db/engine/LoadingIndexMgr.h"
 #include "db/utils.h"
+#include "server/Config.h"
 #include <fiu-local.h>
 #include <fiu-control.h>
 
@@ -188,6 +190,93 @@ TEST_F(EngineTest, ENGINE_IMPL_TEST) {
 #endif
 }
 
+TEST_F(EngineTest, BUILD_INDEX_BY_TABLE_MODEL_TEST) {
+    milvus::server::Config::GetInstance().SetEngineConfigReuseTrainedModel("true");
+
+    uint16_t dimension = 16;
+    auto make_engine = [&](const std::string& location, int64_t row_count) {
+        auto engine = milvus::engine::EngineFactory::Build(
+            dimension, location, milvus::engine::EngineType::FAISS_IDMAP, milvus::engine::MetricType::L2, 64);
+        std::vector<float> data;
+        std::vector<int64_t> ids;
+        for (int64_t i = 0; i < row_count; i++) {
+            ids.push_back(i);
+            for (uint16_t k = 0; k < dimension; k++) {
+                data.push_back(drand48());
+            }
+        }
+        engine->AddWithIds(row_count, data.data(), ids.data());
+        return engine;
+    };
+
+    // table id of a model is taken from the file location
+    std::string table_path = "/tmp/milvus_test/tables/table_model_test/";
+    auto small_engine = make_engine(table_path + "1", 100);
+    auto index = small_engine->BuildIndexByTableModel(table_path + "1.ingest",
+                                                      milvus::engine::EngineType::FAISS_IVFFLAT);
+    ASSERT_EQ(index, nullptr);
+
+    // the small file matches another nlist, it is built with the model trained for the large one
+    auto large_engine = make_engine(table_path + "2", 100000);
+    index = large_engine->BuildIndex(table_path + "3", milvus::engine::EngineType::FAISS_IVFFLAT);
+    ASSERT_NE(index, nullptr);
+    index = small_engine->BuildIndexByTableModel(table_path + "1.ingest", milvus::engine::EngineType::FAISS_IVFFLAT);
+    ASSERT_NE(index, nullptr);
+    ASSERT_EQ(index->Count(), 100UL);
+
+    auto other_engine = make_engine("/tmp/milvus_test/tables/other_table/1", 100);
+    index = other_engine->BuildIndexByTableModel("/tmp/milvus_test/tables/other_table/1.ingest",
+                                                 milvus::engine::EngineType::FAISS_IVFFLAT);
+    ASSERT_EQ(index, nullptr);
+
+    milvus::server::Config::GetInstance().SetEngineConfigReuseTrainedModel("false");
+}
+
+TEST_F(EngineTest, ROTATED_INDEX_TEST) {
+    uint16_t dimension = 32;
+    std::string file_path = "/tmp/milvus_test/tables/rotated_index_test/1";
+    auto engine_ptr = milvus::engine::EngineFactory::Build(
+        dimension, file_path, milvus::engine::EngineType::FAISS_IDMAP, milvus::engine::MetricType::L2, 16);
+    std::vector<float> data;
+    std::vector<int64_t> ids;
+    const int64_t row_count = 2000;
+    for (int64_t i = 0; i < row_count; i++) {
+        ids.push_back(i);
+        for (uint16_t k = 0; k < dimension; k++) {
+            data.push_back(drand48());
+        }
+    }
+    ASSERT_TRUE(engine_ptr->AddWithIds(row_count, data.data(), ids.data()).ok());
+
+#ifdef MILVUS_GPU_VERSION
+    FIU_ENABLE_FIU("ExecutionEngineImpl.CreatetVecIndex.gpu_res_disabled");
+#endif
+    std::string plain_path = file_path + "_pq";
+    auto plain_index = engine_ptr->BuildIndex(plain_path, milvus::engine::EngineType::FAISS_PQ);
+    ASSERT_NE(plain_index, nullptr);
+    ASSERT_FALSE(milvus::engine::ExecutionEngineImpl::IsRotatedIndex(plain_path));
+
+    milvus::server::Config::GetInstance().SetEngineConfigQuantizerRotation("true");
+    std::string rotated_path = file_path + "_opq";
+    auto rotated_index = engine_ptr->BuildIndex(rotated_path, milvus::engine::EngineType::FAISS_PQ);
+    milvus::server::Config::GetInstance().SetEngineConfigQuantizerRotation("false");
+#ifdef MILVUS_GPU_VERSION
+    fiu_disable("ExecutionEngineImpl.CreatetVecIndex.gpu_res_disabled");
+#endif
+    ASSERT_NE(rotated_index, nullptr);
+    ASSERT_TRUE(milvus::engine::ExecutionEngineImpl::IsRotatedIndex(rotated_path));
+
+#ifdef MILVUS_GPU_VERSION
+    // a rotated index placed on gpu stays on cpu and is still searched
+    ASSERT_TRUE(rotated_index->CopyToGpu(0, false).ok());
+    std::vector<float> distances(10);
+    std::vector<int64_t> labels(10);
+    auto status = rotated_index->Search(1, data.data(), 10, 4, distances.data(), labels.data(), false);
+    ASSERT_TRUE(status.ok());
+    ASSERT_GE(labels[0], 0);
+#endif
+}
+
 TEST_F(EngineTest, ENGINE_IMPL_NULL_INDEX_TEST) {
     uint16_t dimension = 64;
     std::string file_path = "/tmp/milvus_index_1";
@@ -243,3 +332,34 @@ TEST_F(EngineTest, ENGINE_IMPL_THROW_EXCEPTION_TEST) {
 
     fiu_disable("vecIndex.throw_read_exception");
 }
+
+TEST_F(EngineTest, LOADING_INDEX_TEST) {
+    auto& mgr = milvus::engine::LoadingIndexMgr::GetInstance();
+    std::string location = "/tmp/milvus_loading_index";
+    int reads = 0;
+    auto read = [&]() {
+        reads++;
+        return milvus::engine::GetVecIndexFactory(milvus::engine::IndexType::FAISS_IDMAP);
+    };
+
+    // the index is read once while an engine holds it
+    auto index = mgr.Load(location, read);
+    ASSERT_NE(index, nullptr);
+    ASSERT_EQ(mgr.Load(location, read), index);
+    ASSERT_EQ(reads, 1);
+
+    // released by every engine, it is read again
+    index = nullptr;
+    index = mgr.Load(location, read);
+    ASSERT_NE(index, nullptr);
+    ASSERT_EQ(reads, 2);
+
+    // a failed read is not shared
+    auto fail = [&]() {
+        reads++;
+        return milvus::engine::VecIndexPtr();
+    };
+    ASSERT_EQ(mgr.Load(location + "_missing", fail), nullptr);
+    ASSERT_EQ(mgr.Load(location + "_missing", fail), nullptr);
+    ASSERT_EQ(reads, 4);
+}
@@ -22,6 +22,8 @@
 
 #include "db/Constants.h"
 #include "db/engine/EngineFactory.h"
+#include "db/insert/MemBufferPool.h"
+#include "db/insert/MemManagerImpl.h"
 #include "db/insert/MemTable.h"
 #include "db/insert/MemTableFile.h"
 #include "db/insert/VectorSource.h"
@@ -466,3 +468,298 @@ TEST_F(MemManagerTest2, VECTOR_IDS_TEST) {
         ASSERT_EQ(xb.id_array_[i], i + nb);
     }
 }
+
+TEST_F(MemManagerTest, CONCURRENT_INSERT_SERIALIZE_TEST) {
+    const int64_t table_count = 8;
+    std::vector<std::string> table_ids;
+    for (int64_t i = 0; i < table_count; i++) {
+        milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
+        table_schema.table_id_ = GetTableName() + "_" + std::to_string(i);
+        auto status = impl_->CreateTable(table_schema);
+        ASSERT_TRUE(status.ok());
+        table_ids.push_back(table_schema.table_id_);
+    }
+
+    auto options = GetOptions();
+    auto mem_mgr = std::make_shared<milvus::engine::MemManagerImpl>(impl_, options);
+
+    const int64_t insert_loop = 10;
+    const int64_t nb = 1000;
+    std::atomic<bool> inserting(true);
+    std::thread serialize_thread([&]() {
+        // serialization runs in the middle of inserting, must not lose any vector
+        while (inserting.load()) {
+            std::set<std::string> table_ids;
+            mem_mgr->Serialize(table_ids);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+
+    std::vector<std::thread> insert_threads;
+    for (auto& table_id : table_ids) {
+        insert_threads.emplace_back([&, table_id]() {
+            for (int64_t i = 0; i < insert_loop; i++) {
+                milvus::engine::VectorsData vectors;
+                BuildVectors(nb, vectors);
+                auto status = mem_mgr->InsertVectors(table_id, vectors);
+                ASSERT_TRUE(status.ok());
+                ASSERT_EQ(vectors.id_array_.size(), nb);
+            }
+        });
+    }
+    for (auto& thread : insert_threads) {
+        thread.join();
+    }
+    inserting = false;
+    serialize_thread.join();
+
+    std::set<std::string> serialized_ids;
+    mem_mgr->Serialize(serialized_ids);
+    ASSERT_EQ(mem_mgr->GetCurrentMem(), 0);
+
+    for (auto& table_id : table_ids) {
+        uint64_t row_count = 0;
+        auto status = impl_->Count(table_id, row_count);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(row_count, insert_loop * nb);
+    }
+}
+
+TEST_F(MemManagerTest, FLUSH_POLICY_TEST) {
+    milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
+    table_schema.table_id_ = GetTableName() + "_bulk";
+    auto status = impl_->CreateTable(table_schema);
+    ASSERT_TRUE(status.ok());
+    std::string bulk_table = table_schema.table_id_;
+
+    table_schema.table_id_ = GetTableName() + "_realtime";
+    status = impl_->CreateTable(table_schema);
+    ASSERT_TRUE(status.ok());
+    std::string realtime_table = table_schema.table_id_;
+
+    // the bulk table is only flushed on demand, the realtime table is flushed once it buffers anything
+    auto options = GetOptions();
+    options.flush_policy_.max_buffer_size_ = 0;
+    options.flush_policy_.max_age_ms_ = 0;
+    options.table_flush_policies_[realtime_table].max_buffer_size_ = 1;
+    auto mem_mgr = std::make_shared<milvus::engine::MemManagerImpl>(impl_, options);
+
+    const int64_t nb = 1000;
+    for (auto& table_id : {bulk_table, realtime_table}) {
+        milvus::engine::VectorsData vectors;
+        BuildVectors(nb, vectors);
+        status = mem_mgr->InsertVectors(table_id, vectors);
+        ASSERT_TRUE(status.ok());
+    }
+
+    std::set<std::string> flush_ids;
+    mem_mgr->GetTablesToFlush(flush_ids);
+    ASSERT_EQ(flush_ids, std::set<std::string>({realtime_table}));
+
+    std::set<std::string> serialized_ids;
+    status = mem_mgr->SerializeTables(flush_ids, serialized_ids);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(serialized_ids, flush_ids);
+
+    uint64_t row_count = 0;
+    impl_->Count(realtime_table, row_count);
+    ASSERT_EQ(row_count, nb);
+    impl_->Count(bulk_table, row_count);
+    ASSERT_EQ(row_count, 0);
+    ASSERT_GT(mem_mgr->GetCurrentMem(), 0);
+
+    mem_mgr->GetTablesToFlush(flush_ids);
+    ASSERT_TRUE(flush_ids.empty());
+
+    status = mem_mgr->Serialize(serialized_ids);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(serialized_ids, std::set<std::string>({bulk_table}));
+    impl_->Count(bulk_table, row_count);
+    ASSERT_EQ(row_count, nb);
+    ASSERT_EQ(mem_mgr->GetCurrentMem(), 0);
+}
+
+TEST_F(MemManagerTest, INSERT_BACKPRESSURE_TEST) {
+    milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
+    auto status = impl_->CreateTable(table_schema);
+    ASSERT_TRUE(status.ok());
+
+    // any buffered vector exceeds the insert buffer, the second insert must wait for a flush
+    auto options = GetOptions();
+    options.insert_buffer_size_ = 1;
+    auto mem_mgr = std::make_shared<milvus::engine::MemManagerImpl>(impl_, options);
+
+    const int64_t nb = 1000;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(nb, vectors);
+    status = mem_mgr->InsertVectors(table_schema.table_id_, vectors);
+    ASSERT_TRUE(status.ok());
+
+    std::atomic<bool> inserted(false);
+    std::thread insert_thread([&]() {
+        milvus::engine::VectorsData more_vectors;
+        BuildVectors(nb, more_vectors);
+        auto status = mem_mgr->InsertVectors(table_schema.table_id_, more_vectors);
+        ASSERT_TRUE(status.ok());
+        inserted = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(inserted.load());
+
+    std::set<std::string> serialized_ids;
+    mem_mgr->Serialize(serialized_ids);
+    insert_thread.join();
+    ASSERT_TRUE(inserted.load());
+
+    mem_mgr->Serialize(serialized_ids);
+    uint64_t row_count = 0;
+    impl_->Count(table_schema.table_id_, row_count);
+    ASSERT_EQ(row_count, 2 * nb);
+}
+
+TEST_F(MemManagerTest, SERIALIZE_FAIL_TEST) {
+    milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
+    auto status = impl_->CreateTable(table_schema);
+    ASSERT_TRUE(status.ok());
+
+    auto options = GetOptions();
+    auto mem_mgr = std::make_shared<milvus::engine::MemManagerImpl>(impl_, options);
+
+    const int64_t nb = 1000;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(nb, vectors);
+    status = mem_mgr->InsertVectors(GetTableName(), vectors);
+    ASSERT_TRUE(status.ok());
+
+    // a failed serialization keeps the vectors buffered and doesn't report the table as persisted
+    std::set<std::string> table_ids;
+    fiu_init(0);
+    fiu_enable("MemTableFile.Serialize.serialize_fail", 1, NULL, 0);
+    status = mem_mgr->Serialize(table_ids);
+    fiu_disable("MemTableFile.Serialize.serialize_fail");
+    ASSERT_FALSE(status.ok());
+    ASSERT_TRUE(table_ids.empty());
+    ASSERT_GT(mem_mgr->GetCurrentMem(), 0);
+
+    status = mem_mgr->Serialize(table_ids);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(table_ids.count(GetTableName()), 1);
+    ASSERT_EQ(mem_mgr->GetCurrentMem(), 0);
+
+    uint64_t row_count = 0;
+    impl_->Count(GetTableName(), row_count);
+    ASSERT_EQ(row_count, nb);
+}
+
+TEST_F(MemManagerTest, MEM_TABLE_FILE_SEARCH_TEST) {
+    milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
+    auto status = impl_->CreateTable(table_schema);
+    ASSERT_TRUE(status.ok());
+
+    auto options = GetOptions();
+    auto mem_mgr = std::make_shared<milvus::engine::MemManagerImpl>(impl_, options);
+
+    const int64_t nb = 1000;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(nb, vectors);
+    status = mem_mgr->InsertVectors(GetTableName(), vectors);
+    ASSERT_TRUE(status.ok());
+
+    std::vector<milvus::engine::MemTableFilePtr> mem_table_files;
+    mem_mgr->GetMemTableFiles({GetTableName()}, mem_table_files);
+    ASSERT_EQ(mem_table_files.size(), 1);
+
+    const int64_t nq = 10, topk = 5;
+    milvus::engine::VectorsData query;
+    query.vector_count_ = nq;
+    query.float_data_.assign(vectors.float_data_.begin(), vectors.float_data_.begin() + nq * TABLE_DIM);
+
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    size_t result_k = 0;
+    status = mem_table_files[0]->Search(query, topk, result_ids, result_distances, result_k);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(result_k, topk);
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(result_ids[i * topk], vectors.id_array_[i]);
+        ASSERT_LT(result_distances[i * topk], 1e-4);
+    }
+
+    // files are still found while being serialized, and gone once serialized
+    auto& pool = milvus::engine::MemBufferPool::GetInstance();
+    pool.Clear();
+    std::set<std::string> table_ids;
+    mem_mgr->Serialize(table_ids);
+    auto held_files = mem_table_files;
+    mem_mgr->GetMemTableFiles({GetTableName()}, mem_table_files);
+    ASSERT_TRUE(mem_table_files.empty());
+
+    // a search holding a serialized file still finds its vectors, the buffer is recycled after the search is done
+    status = held_files[0]->Search(query, topk, result_ids, result_distances, result_k);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(result_k, topk);
+    ASSERT_EQ(result_ids[0], vectors.id_array_[0]);
+    ASSERT_EQ(pool.PooledMem(), 0);
+    held_files.clear();
+    ASSERT_GT(pool.PooledMem(), 0);
+}
+
+TEST_F(MemManagerTest2, INSERT_BUFFER_SEARCH_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 10000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->InsertVectors(GetTableName(), "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    // no waiting for serialization, inserted vectors are searched in insert buffer
+    int64_t nq = 10, topk = 10, nprobe = 10;
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = nq;
+    xq.float_data_.assign(xb.float_data_.begin(), xb.float_data_.begin() + nq * TABLE_DIM);
+
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, GetTableName(), tags, topk, nprobe, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), nq * topk);
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(result_ids[i * topk], xb.id_array_[i]);
+        ASSERT_LT(result_distances[i * topk], 1e-4);
+    }
+}
+
+TEST(MemBufferPoolTest, ACQUIRE_RELEASE_TEST) {
+    auto& pool = milvus::engine::MemBufferPool::GetInstance();
+    pool.Clear();
+
+    std::vector<float> vectors;
+    milvus::engine::IDNumbers ids;
+    ASSERT_FALSE(pool.Acquire(100, TABLE_DIM, vectors, ids));
+
+    vectors.resize(1000 * TABLE_DIM);
+    ids.resize(1000);
+    pool.Release(vectors, ids);
+    ASSERT_GT(pool.PooledMem(), 0);
+
+    // too large to be held by recycled buffer
+    ASSERT_FALSE(pool.Acquire(2000, TABLE_DIM, vectors, ids));
+
+    ASSERT_TRUE(pool.Acquire(500, TABLE_DIM, vectors, ids));
+    ASSERT_TRUE(vectors.empty());
+    ASSERT_TRUE(ids.empty());
+    ASSERT_GE(vectors.capacity(), 500 * TABLE_DIM);
+    ASSERT_GE(ids.capacity(), 500);
+    ASSERT_EQ(pool.PooledMem(), 0);
+
+    // pool is bounded
+    std::vector<float> large_vectors(milvus::engine::MAX_POOLED_BUFFER_MEM / sizeof(float) + 1);
+    milvus::engine::IDNumbers large_ids(1);
+    pool.Release(large_vectors, large_ids);
+    ASSERT_EQ(pool.PooledMem(), 0);
+}
@@ -12,12 +12,16 @@
 #include "db/Constants.h"
 #include "db/Utils.h"
 #include "db/meta/MetaConsts.h"
+#include "db/meta/SnapshotMetaImpl.h"
 #include "db/meta/SqliteMetaImpl.h"
 #include "db/utils.h"
 
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <thread>
 #include <fiu-local.h>
 #include <fiu-control.h>
@@ -451,6 +455,259 @@ TEST_F(MetaTest, TABLE_FILE_TEST) {
     ASSERT_EQ(files.size(), 0UL);
 }
 
+TEST_F(MetaTest, GROUP_UPDATE_TEST) {
+    auto table_id = "meta_test_group_update";
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    table.dimension_ = 256;
+    auto status = impl_->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    // updates of concurrent callers are committed together, each one still gets its own file updated
+    const int64_t file_count = 32;
+    milvus::engine::meta::TableFilesSchema table_files(file_count);
+    std::vector<size_t> ids;
+    for (auto& table_file : table_files) {
+        table_file.table_id_ = table_id;
+        ASSERT_TRUE(impl_->CreateTableFile(table_file).ok());
+        ids.push_back(table_file.id_);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<milvus::Status> statuses(file_count);
+    for (int64_t i = 0; i < file_count; ++i) {
+        threads.emplace_back([&, i]() {
+            table_files[i].file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+            table_files[i].row_count_ = i + 1;
+            statuses[i] = impl_->UpdateTableFile(table_files[i]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& s : statuses) {
+        ASSERT_TRUE(s.ok());
+    }
+
+    milvus::engine::meta::TableFilesSchema files;
+    status = impl_->GetTableFiles(table_id, ids, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), file_count);
+    for (auto& file : files) {
+        auto index = std::find(ids.begin(), ids.end(), file.id_) - ids.begin();
+        ASSERT_EQ(file.file_type_, milvus::engine::meta::TableFileSchema::RAW);
+        ASSERT_EQ(file.row_count_, static_cast<size_t>(index + 1));
+    }
+
+    // a group whose transaction fails is committed request by request, the callers don't fail with it
+    fiu_init(0);
+    fiu_enable("SqliteMetaImpl.UpdateTableFiles.fail_group", 1, NULL, 0);
+    threads.clear();
+    for (int64_t i = 0; i < file_count; ++i) {
+        threads.emplace_back([&, i]() {
+            table_files[i].row_count_ = 2 * (i + 1);
+            statuses[i] = impl_->UpdateTableFile(table_files[i]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    fiu_disable("SqliteMetaImpl.UpdateTableFiles.fail_group");
+    for (auto& s : statuses) {
+        ASSERT_TRUE(s.ok());
+    }
+
+    status = impl_->GetTableFiles(table_id, ids, files);
+    ASSERT_TRUE(status.ok());
+    for (auto& file : files) {
+        auto index = std::find(ids.begin(), ids.end(), file.id_) - ids.begin();
+        ASSERT_EQ(file.row_count_, static_cast<size_t>(2 * (index + 1)));
+    }
+}
+
+TEST_F(MetaTest, SNAPSHOT_TEST) {
+    auto table_id = "meta_test_snapshot";
+    auto snapshot = std::make_shared<milvus::engine::meta::SnapshotMetaImpl>(impl_,
+                                                                             milvus::engine::DBOptions::MODE::SINGLE);
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    table.dimension_ = 256;
+    auto status = snapshot->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFilesSchema table_files(3);
+    for (auto& table_file : table_files) {
+        table_file.table_id_ = table_id;
+        ASSERT_TRUE(snapshot->CreateTableFile(table_file).ok());
+        // files to search are checked on disk
+        std::ofstream(table_file.location_).put('0');
+    }
+    table_files[0].file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+    table_files[1].file_type_ = milvus::engine::meta::TableFileSchema::INDEX;
+    ASSERT_TRUE(snapshot->UpdateTableFiles(table_files).ok());
+
+    std::vector<size_t> ids;
+    milvus::engine::meta::DatesT dates;
+    milvus::engine::meta::DatePartionedTableFilesSchema dated_files;
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.size(), 1UL);
+    ASSERT_EQ(dated_files[table_files[0].date_].size(), 2UL);
+
+    // ids and dates are filtered from the snapshot as the wrapped meta does
+    ids = {table_files[1].id_, table_files[2].id_};
+    dates = {table_files[1].date_};
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.size(), 1UL);
+    ASSERT_EQ(dated_files[table_files[1].date_].size(), 1UL);
+    ASSERT_EQ(dated_files[table_files[1].date_][0].id_, table_files[1].id_);
+
+    dates = {milvus::engine::utils::GetDateWithDelta(-1)};
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(dated_files.empty());
+
+    ids = {table_files[2].id_};
+    dates.clear();
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(dated_files.empty());
+
+    // writes through the snapshot meta are seen by the next search
+    table_files[2].file_type_ = milvus::engine::meta::TableFileSchema::TO_INDEX;
+    ASSERT_TRUE(snapshot->UpdateTableFile(table_files[2]).ok());
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.size(), 1UL);
+
+    // writes bypassing it aren't, until the snapshot is dropped
+    table_files[2].file_type_ = milvus::engine::meta::TableFileSchema::TO_DELETE;
+    ASSERT_TRUE(impl_->UpdateTableFile(table_files[2]).ok());
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.size(), 1UL);
+
+    ASSERT_TRUE(snapshot->UpdateTableFilesToIndex(table_id).ok());
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(dated_files.empty());
+
+    ASSERT_TRUE(snapshot->DropTable(table_id).ok());
+    ids.clear();
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(dated_files.empty());
+}
+
+TEST_F(MetaTest, PARTITION_FILES_TO_SEARCH_TEST) {
+    auto table_id = "meta_test_partition_files";
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    table.dimension_ = 256;
+    auto status = impl_->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    std::vector<std::string> table_ids = {table_id};
+    const int64_t partition_count = 40;
+    for (int64_t i = 0; i < partition_count; ++i) {
+        std::string partition = table_id + std::string("_") + std::to_string(i);
+        ASSERT_TRUE(impl_->CreatePartition(table_id, partition, std::to_string(i)).ok());
+        table_ids.push_back(partition);
+    }
+
+    std::vector<milvus::engine::meta::TableSchema> partitions_schema;
+    status = impl_->ShowPartitions(table_id, partitions_schema);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(partitions_schema.size(), partition_count);
+    for (auto& schema : partitions_schema) {
+        ASSERT_EQ(schema.owner_table_, table_id);
+        ASSERT_EQ(schema.dimension_, table.dimension_);
+    }
+
+    // one searchable file in every table, more tables than a batch of the query
+    for (auto& id : table_ids) {
+        milvus::engine::meta::TableFileSchema table_file;
+        table_file.table_id_ = id;
+        ASSERT_TRUE(impl_->CreateTableFile(table_file).ok());
+        std::ofstream(table_file.location_).put('0');
+        table_file.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+        ASSERT_TRUE(impl_->UpdateTableFile(table_file).ok());
+    }
+
+    milvus::engine::meta::DatesT dates;
+    milvus::engine::meta::DatePartionedTableFilesSchema dated_files;
+    status = impl_->FilesToSearch(table_ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.size(), 1UL);
+    auto& files = dated_files.begin()->second;
+    ASSERT_EQ(files.size(), table_ids.size());
+    for (auto& file : files) {
+        ASSERT_EQ(file.dimension_, table.dimension_);
+    }
+
+    dates = {milvus::engine::utils::GetDateWithDelta(-1)};
+    status = impl_->FilesToSearch(table_ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(dated_files.empty());
+
+    // tables not found are skipped
+    dates.clear();
+    status = impl_->FilesToSearch({table_id, "notexist"}, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.begin()->second.size(), 1UL);
+
+    status = impl_->FilesToSearch({"notexist"}, dates, dated_files);
+    ASSERT_EQ(status.code(), milvus::DB_NOT_FOUND);
+
+    // tables cached and not are searched together through the snapshot
+    auto snapshot = std::make_shared<milvus::engine::meta::SnapshotMetaImpl>(impl_,
+                                                                             milvus::engine::DBOptions::MODE::SINGLE);
+    std::vector<size_t> ids;
+    status = snapshot->FilesToSearch(table_id, ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    status = snapshot->FilesToSearch(table_ids, dates, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.begin()->second.size(), table_ids.size());
+}
+
+TEST_F(MetaTest, CLEANUP_BATCH_TEST) {
+    auto table_id = "meta_test_cleanup_batch";
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    table.dimension_ = 256;
+    auto status = impl_->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    // more files than a batch of clean up
+    const int64_t file_count = 150;
+    milvus::engine::meta::TableFilesSchema table_files(file_count);
+    std::vector<size_t> ids;
+    for (auto& table_file : table_files) {
+        table_file.table_id_ = table_id;
+        ASSERT_TRUE(impl_->CreateTableFile(table_file).ok());
+        std::ofstream(table_file.location_).put('0');
+        table_file.file_type_ = milvus::engine::meta::TableFileSchema::TO_DELETE;
+        ids.push_back(table_file.id_);
+    }
+    ASSERT_TRUE(impl_->UpdateTableFiles(table_files).ok());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    status = impl_->CleanUpFilesWithTTL(0);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFilesSchema files;
+    status = impl_->GetTableFiles(table_id, ids, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(files.empty());
+    for (auto& table_file : table_files) {
+        ASSERT_FALSE(boost::filesystem::exists(table_file.location_));
+    }
+}
+
 TEST_F(MetaTest, ARCHIVE_TEST_DAYS) {
     srand(time(0));
     milvus::engine::DBMetaOptions options;
@@ -512,6 +769,53 @@ TEST_F(MetaTest, ARCHIVE_TEST_DAYS) {
     impl.DropAll();
 }
 
+TEST_F(MetaTest, ARCHIVE_TEST_COMPRESS) {
+    milvus::engine::DBMetaOptions options;
+    options.path_ = "/tmp/milvus_test";
+    options.archive_conf_ = milvus::engine::ArchiveConf("compress", "days:1");
+
+    milvus::engine::meta::SqliteMetaImpl impl(options);
+    auto table_id = "meta_test_table";
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    auto status = impl.CreateTable(table);
+
+    // a file past the days is left to the db to compress, an archive file is searched like an index file
+    std::vector<size_t> ids;
+    int64_t ts = milvus::engine::utils::GetMicroSecTimeStamp();
+    for (auto file_type :
+         {milvus::engine::meta::TableFileSchema::RAW, milvus::engine::meta::TableFileSchema::ARCHIVE}) {
+        milvus::engine::meta::TableFileSchema table_file;
+        table_file.table_id_ = table.table_id_;
+        status = impl.CreateTableFile(table_file);
+        ASSERT_TRUE(status.ok());
+        table_file.file_type_ = file_type;
+        table_file.row_count_ = 10;
+        table_file.created_on_ = ts - 2 * milvus::engine::meta::DAY * milvus::engine::meta::US_PS;
+        status = impl.UpdateTableFile(table_file);
+        ASSERT_TRUE(status.ok());
+        ids.push_back(table_file.id_);
+    }
+
+    status = impl.Archive();
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFilesSchema files_get;
+    status = impl.GetTableFiles(table_id, ids, files_get);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files_get.size(), 2);
+    ASSERT_EQ(files_get[0].file_type_, milvus::engine::meta::TableFileSchema::RAW);
+    ASSERT_EQ(files_get[1].file_type_, milvus::engine::meta::TableFileSchema::ARCHIVE);
+
+    uint64_t row_count = 0;
+    status = impl.Count(table_id, row_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(row_count, 20);
+
+    impl.DropAll();
+}
+
 TEST_F(MetaTest, ARCHIVE_TEST_DISK) {
     milvus::engine::DBMetaOptions options;
     options.path_ = "/tmp/milvus_test";
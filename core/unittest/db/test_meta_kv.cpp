@@ -0,0 +1,318 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/Utils.h"
+#include "db/meta/KVMetaImpl.h"
+#include "db/meta/KVStore.h"
+#include "db/meta/MetaConsts.h"
+#include "db/utils.h"
+
+#include <fiu-control.h>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <thread>
+#include <boost/filesystem/operations.hpp>
+
+TEST_F(KVMetaTest, TABLE_TEST) {
+    auto table_id = "kv_meta_test_table";
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    table.dimension_ = 256;
+    auto status = impl_->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    status = impl_->CreateTable(table);
+    ASSERT_EQ(status.code(), milvus::DB_ALREADY_EXIST);
+
+    milvus::engine::meta::TableSchema described;
+    described.table_id_ = table_id;
+    status = impl_->DescribeTable(described);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(described.id_, table.id_);
+    ASSERT_EQ(described.dimension_, 256);
+
+    bool has_table = false;
+    status = impl_->HasTable(table_id, has_table);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(has_table);
+
+    status = impl_->CreatePartition(table_id, "", "tag0");
+    ASSERT_TRUE(status.ok());
+    std::string partition_name;
+    status = impl_->GetPartitionName(table_id, " tag0 ", partition_name);
+    ASSERT_TRUE(status.ok());
+    std::vector<milvus::engine::meta::TableSchema> partitions;
+    status = impl_->ShowPartitions(table_id, partitions);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(partitions.size(), 1UL);
+    ASSERT_EQ(partitions[0].table_id_, partition_name);
+
+    std::vector<milvus::engine::meta::TableSchema> tables;
+    status = impl_->AllTables(tables);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(tables.size(), 2UL);
+
+    status = impl_->DropTable(table_id);
+    ASSERT_TRUE(status.ok());
+    status = impl_->HasTable(table_id, has_table);
+    ASSERT_TRUE(status.ok());
+    ASSERT_FALSE(has_table);
+
+    status = impl_->CreateTable(table);
+    ASSERT_EQ(status.code(), milvus::DB_ERROR);
+
+    status = impl_->CleanUpFilesWithTTL(0UL);
+    ASSERT_TRUE(status.ok());
+    status = impl_->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+}
+
+TEST_F(KVMetaTest, TABLE_FILE_TEST) {
+    auto table_id = "kv_meta_test_table";
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    table.dimension_ = 256;
+    auto status = impl_->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFilesSchema files;
+    for (auto i = 0; i < 4; ++i) {
+        milvus::engine::meta::TableFileSchema table_file;
+        table_file.table_id_ = table_id;
+        status = impl_->CreateTableFile(table_file);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(table_file.file_type_, milvus::engine::meta::TableFileSchema::NEW);
+        ASSERT_EQ(table_file.dimension_, 256);
+        std::ofstream(table_file.location_).put('0');
+
+        table_file.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+        table_file.file_size_ = 1024;
+        table_file.row_count_ = milvus::engine::meta::BUILD_INDEX_THRESHOLD * i;
+        files.push_back(table_file);
+    }
+    status = impl_->UpdateTableFiles(files);
+    ASSERT_TRUE(status.ok());
+
+    uint64_t size = 0;
+    status = impl_->Size(size);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(size, 4 * 1024UL);
+
+    uint64_t count = 0;
+    status = impl_->Count(table_id, count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(count, 6 * milvus::engine::meta::BUILD_INDEX_THRESHOLD);
+
+    milvus::engine::meta::DatePartionedTableFilesSchema dated_files;
+    status = impl_->FilesToMerge(table_id, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.begin()->second.size(), 4UL);
+
+    status = impl_->UpdateTableFilesToIndex(table_id);
+    ASSERT_TRUE(status.ok());
+    milvus::engine::meta::TableFilesSchema to_index_files;
+    status = impl_->FilesToIndex(to_index_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(to_index_files.size(), 3UL);
+
+    status = impl_->FilesToSearch(table_id, {files[0].id_}, {}, dated_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(dated_files.begin()->second.size(), 1UL);
+
+    std::vector<size_t> ids = {files[1].id_, files[2].id_};
+    milvus::engine::meta::TableFilesSchema got_files;
+    status = impl_->GetTableFiles(table_id, ids, got_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(got_files.size(), 2UL);
+
+    status = impl_->DeleteTableFiles(table_id);
+    ASSERT_TRUE(status.ok());
+    status = impl_->FilesByType(table_id, {milvus::engine::meta::TableFileSchema::TO_DELETE}, got_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(got_files.size(), 4UL);
+
+    status = impl_->CleanUpFilesWithTTL(0UL);
+    ASSERT_TRUE(status.ok());
+    status = impl_->FilesByType(table_id, {milvus::engine::meta::TableFileSchema::TO_DELETE}, got_files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(got_files.empty());
+}
+
+TEST_F(KVMetaTest, REOPEN_TEST) {
+    auto table_id = "kv_meta_test_table";
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    table.dimension_ = 128;
+    auto status = impl_->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFileSchema raw_file, new_file;
+    raw_file.table_id_ = table_id;
+    new_file.table_id_ = table_id;
+    status = impl_->CreateTableFile(raw_file);
+    ASSERT_TRUE(status.ok());
+    raw_file.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+    status = impl_->UpdateTableFile(raw_file);
+    ASSERT_TRUE(status.ok());
+    status = impl_->CreateTableFile(new_file);
+    ASSERT_TRUE(status.ok());
+
+    // a record torn by a crash is dropped on open, shadow files left by the crash are cleaned
+    impl_.reset();
+    auto options = GetOptions();
+    {
+        std::ofstream log(options.meta_.path_ + "/meta.kv", std::ios::binary | std::ios::app);
+        log.write("\x10\x00\x00\x00garbage", 11);
+    }
+    impl_ = std::make_shared<milvus::engine::meta::KVMetaImpl>(options.meta_);
+
+    milvus::engine::meta::TableSchema described;
+    described.table_id_ = table_id;
+    status = impl_->DescribeTable(described);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(described.dimension_, 128);
+
+    milvus::engine::meta::TableFilesSchema files;
+    status = impl_->FilesByType(table_id,
+                                {milvus::engine::meta::TableFileSchema::RAW, milvus::engine::meta::TableFileSchema::NEW},
+                                files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 1UL);
+    ASSERT_EQ(files[0].file_id_, raw_file.file_id_);
+
+    // ids go on after reopen
+    milvus::engine::meta::TableFileSchema another_file;
+    another_file.table_id_ = table_id;
+    status = impl_->CreateTableFile(another_file);
+    ASSERT_TRUE(status.ok());
+    ASSERT_GT(another_file.id_, new_file.id_);
+}
+
+TEST(KVStoreTest, STORE_TEST) {
+    std::string path = "/tmp/milvus_kv_store_test";
+    boost::filesystem::remove(path);
+
+    {
+        milvus::engine::meta::KVStore store(path);
+        ASSERT_TRUE(store.Open().ok());
+
+        milvus::engine::meta::KVStore::WriteBatch batch;
+        batch.Put("a/1", "x");
+        batch.Put("a/2", "y");
+        batch.Put("b/1", "z");
+        ASSERT_TRUE(store.Write(batch).ok());
+        ASSERT_TRUE(store.Delete("a/2").ok());
+        ASSERT_TRUE(store.Put("a/1", "w").ok());
+
+        // old versions of the keys are garbage after compaction
+        std::string large(1024 * 1024, 'v');
+        for (auto i = 0; i < 10; ++i) {
+            ASSERT_TRUE(store.Put("c/1", large).ok());
+        }
+    }
+    // compaction runs in background, it is done once the store is closed
+    ASSERT_LT(boost::filesystem::file_size(path), 8 * 1024 * 1024UL);
+
+    milvus::engine::meta::KVStore store(path);
+    ASSERT_TRUE(store.Open().ok());
+
+    std::string value;
+    ASSERT_TRUE(store.Get("a/1", value).ok());
+    ASSERT_EQ(value, "w");
+    ASSERT_EQ(store.Get("a/2", value).code(), milvus::DB_NOT_FOUND);
+
+    milvus::engine::meta::KVStore::KVPairs pairs;
+    ASSERT_TRUE(store.Scan("a/", pairs).ok());
+    ASSERT_EQ(pairs.size(), 1UL);
+    ASSERT_TRUE(store.Scan("c/", pairs).ok());
+    ASSERT_EQ(pairs.size(), 1UL);
+    ASSERT_EQ(pairs[0].second.size(), 1024 * 1024UL);
+
+    ASSERT_TRUE(store.Clear().ok());
+    ASSERT_TRUE(store.Scan("", pairs).ok());
+    ASSERT_TRUE(pairs.empty());
+    boost::filesystem::remove(path);
+}
+
+TEST(KVStoreTest, TORN_WRITE_TEST) {
+    std::string path = "/tmp/milvus_kv_store_torn_test";
+    boost::filesystem::remove(path);
+
+    {
+        milvus::engine::meta::KVStore store(path);
+        ASSERT_TRUE(store.Open().ok());
+        ASSERT_TRUE(store.Put("a/1", "x").ok());
+
+        fiu_init(0);
+        fiu_enable("KVStore.AppendLog.torn_write", 1, NULL, 0);
+        ASSERT_FALSE(store.Put("a/2", "y").ok());
+        fiu_disable("KVStore.AppendLog.torn_write");
+
+        // the torn record is cut off, records appended after it survive a reopen
+        ASSERT_TRUE(store.Put("a/3", "z").ok());
+    }
+
+    milvus::engine::meta::KVStore store(path);
+    ASSERT_TRUE(store.Open().ok());
+
+    std::string value;
+    ASSERT_TRUE(store.Get("a/1", value).ok());
+    ASSERT_EQ(store.Get("a/2", value).code(), milvus::DB_NOT_FOUND);
+    ASSERT_TRUE(store.Get("a/3", value).ok());
+    ASSERT_EQ(value, "z");
+    boost::filesystem::remove(path);
+}
+
+TEST(KVStoreTest, CONCURRENT_WRITE_TEST) {
+    std::string path = "/tmp/milvus_kv_store_concurrent_test";
+    boost::filesystem::remove(path);
+
+    const int64_t thread_count = 8;
+    const int64_t write_count = 50;
+    {
+        milvus::engine::meta::KVStore store(path);
+        ASSERT_TRUE(store.Open().ok());
+
+        // large values get the log compacted while others are written
+        std::vector<std::thread> threads;
+        for (int64_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t]() {
+                std::string large(128 * 1024, 'v');
+                for (int64_t i = 0; i < write_count; ++i) {
+                    milvus::engine::meta::KVStore::WriteBatch batch;
+                    batch.Put("a/" + std::to_string(t), std::to_string(i));
+                    batch.Put("b/" + std::to_string(t), large);
+                    EXPECT_TRUE(store.Write(batch).ok());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        milvus::engine::meta::KVStore::KVPairs pairs;
+        ASSERT_TRUE(store.Scan("a/", pairs).ok());
+        ASSERT_EQ(pairs.size(), static_cast<size_t>(thread_count));
+    }
+    ASSERT_LT(boost::filesystem::file_size(path), thread_count * write_count * 64 * 1024UL);
+
+    milvus::engine::meta::KVStore store(path);
+    ASSERT_TRUE(store.Open().ok());
+    for (int64_t t = 0; t < thread_count; ++t) {
+        std::string value;
+        ASSERT_TRUE(store.Get("a/" + std::to_string(t), value).ok());
+        ASSERT_EQ(value, std::to_string(write_count - 1));
+    }
+    boost::filesystem::remove(path);
+}
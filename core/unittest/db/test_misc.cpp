@@ -9,17 +9,34 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include "db/IDGenerator.h"
+#include "db/IndexAdvisor.h"
 #include "db/IndexFailedChecker.h"
+#include "db/MergePolicy.h"
 #include "db/OngoingFileChecker.h"
 #include "db/Options.h"
+#include "db/SearchEffortController.h"
+#include "db/SegmentOwnership.h"
+#include "db/meta/MetaChangeFeed.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/engine/SegmentAttrs.h"
+#include "db/engine/SegmentIdIndex.h"
+#include "db/engine/SegmentSummary.h"
+#include "db/engine/SegmentTimeRange.h"
+#include "db/engine/SegmentTombstone.h"
 #include "db/meta/SqliteMetaImpl.h"
 #include "utils/Exception.h"
 #include "utils/Status.h"
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
 #include <thread>
 #include <vector>
 #include <fiu-local.h>
@@ -141,6 +158,8 @@ TEST(DBMiscTest, UTILS_TEST) {
 
     status = milvus::engine::utils::GetTableFilePath(options, file);
     ASSERT_FALSE(file.location_.empty());
+    ASSERT_EQ(milvus::engine::utils::GetTableIdByLocation(file.location_), TABLE_NAME);
+    ASSERT_TRUE(milvus::engine::utils::GetTableIdByLocation("/tmp/milvus_test/no_table").empty());
 
     FIU_ENABLE_FIU("CommonUtil.CreateDirectory.create_parent_fail");
     status = milvus::engine::utils::GetTableFilePath(options, file);
@@ -154,6 +173,43 @@ TEST(DBMiscTest, UTILS_TEST) {
 
     status = milvus::engine::utils::DeleteTableFilePath(options, file);
     ASSERT_TRUE(status.ok());
+
+    // files in a row are striped over all the paths, those without room for a segment are skipped
+    std::set<std::string> parents;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(milvus::engine::utils::CreateTableFilePath(options, file).ok());
+        parents.insert(file.location_.substr(0, file.location_.find(TABLE_NAME)));
+    }
+    ASSERT_EQ(parents.size(), 3);
+
+    FIU_ENABLE_FIU("GetTableFileParentFolder.primary_full");
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(milvus::engine::utils::CreateTableFilePath(options, file).ok());
+        ASSERT_NE(file.location_.find(options.path_), 0);
+    }
+    fiu_disable("GetTableFileParentFolder.primary_full");
+
+    milvus::engine::meta::TableFilesSchema files;
+    for (int i = 0; i < 10; ++i) {
+        file.file_id_ = std::to_string(i);
+        ASSERT_TRUE(milvus::engine::utils::CreateTableFilePath(options, file).ok());
+        std::ofstream(file.location_) << "data";
+        files.push_back(file);
+    }
+    status = milvus::engine::utils::DeleteTableFilePaths(options, files);
+    ASSERT_TRUE(status.ok());
+    for (auto& deleted : files) {
+        ASSERT_FALSE(boost::filesystem::exists(deleted.location_));
+    }
+
+    // the index built on flush goes once its raw file is replaced
+    std::string ingest_path = milvus::engine::utils::GetIngestIndexPath(file.location_);
+    std::ofstream(ingest_path) << "data";
+    milvus::engine::utils::RemoveIngestIndex(file.location_);
+    ASSERT_FALSE(boost::filesystem::exists(ingest_path));
+
+    status = milvus::engine::utils::DeleteTablePath(options, TABLE_NAME, true);
+    ASSERT_TRUE(status.ok());
 }
 
 TEST(DBMiscTest, CHECKER_TEST) {
@@ -206,10 +262,541 @@ TEST(DBMiscTest, CHECKER_TEST) {
 
         checker.UnmarkOngoingFile(schema);
         ASSERT_FALSE(checker.IsIgnored(schema));
+        ASSERT_FALSE(checker.IsTableIgnored("bbb"));
+        ASSERT_TRUE(checker.IsTableIgnored("aaa"));
 
         schema.table_id_ = "aaa";
         schema.file_id_ = "5000";
         checker.UnmarkOngoingFile(schema);
         ASSERT_FALSE(checker.IsIgnored(schema));
+        ASSERT_FALSE(checker.IsTableIgnored("aaa"));
+    }
+
+    {
+        // a file soft-deleted after a search entered is kept until the search leaves
+        milvus::engine::OngoingFileChecker checker;
+        milvus::engine::meta::TableFileSchema schema;
+        schema.table_id_ = "aaa";
+        schema.file_id_ = "5000";
+        ASSERT_EQ(checker.OldestSearchEpoch(), std::numeric_limits<int64_t>::max());
+
+        std::vector<std::shared_ptr<milvus::engine::OngoingFileChecker::SearchEpoch>> epochs;
+        epochs.push_back(std::make_shared<milvus::engine::OngoingFileChecker::SearchEpoch>(checker));
+        int64_t oldest = checker.OldestSearchEpoch();
+        ASSERT_LT(oldest, std::numeric_limits<int64_t>::max());
+
+        schema.updated_time_ = oldest - 1;
+        ASSERT_FALSE(checker.IsIgnored(schema));
+        schema.updated_time_ = oldest;
+        ASSERT_TRUE(checker.IsIgnored(schema));
+
+        // searches beyond the lock free slots are still tracked
+        for (int64_t i = 0; i < 300; ++i) {
+            epochs.push_back(std::make_shared<milvus::engine::OngoingFileChecker::SearchEpoch>(checker));
+        }
+        ASSERT_EQ(checker.OldestSearchEpoch(), oldest);
+        ASSERT_TRUE(checker.IsIgnored(schema));
+
+        epochs.clear();
+        ASSERT_EQ(checker.OldestSearchEpoch(), std::numeric_limits<int64_t>::max());
+        ASSERT_FALSE(checker.IsIgnored(schema));
+    }
+}
+
+TEST(DBMiscTest, ID_GENERATOR_TEST) {
+    std::string path = "/tmp/milvus_id_generator_test";
+    boost::filesystem::remove(path);
+
+    milvus::engine::IDNumber last_id = 0;
+    {
+        // ids never collide with clock based ones generated before
+        milvus::engine::SimpleIDGenerator simple_generator;
+        milvus::engine::IDNumber simple_id = simple_generator.GetNextIDNumber();
+
+        milvus::engine::AtomicIDGenerator generator(path);
+        ASSERT_TRUE(generator.Init().ok());
+        ASSERT_GT(generator.GetNextIDNumber(), simple_id);
+
+        const int64_t thread_count = 8;
+        const int64_t loop = 100;
+        std::vector<milvus::engine::IDNumbers> thread_ids(thread_count);
+        std::vector<std::thread> threads;
+        for (int64_t t = 0; t < thread_count; t++) {
+            threads.emplace_back([&, t]() {
+                for (int64_t i = 0; i < loop; i++) {
+                    milvus::engine::IDNumbers ids;
+                    generator.GetNextIDNumbers(1000, ids);
+                    EXPECT_EQ(ids.size(), 1000);
+                    EXPECT_EQ(ids.back() - ids.front(), 999);
+                    thread_ids[t].insert(thread_ids[t].end(), ids.begin(), ids.end());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::set<milvus::engine::IDNumber> unique_ids;
+        for (auto& ids : thread_ids) {
+            unique_ids.insert(ids.begin(), ids.end());
+        }
+        ASSERT_EQ(unique_ids.size(), thread_count * loop * 1000);
+
+        // a huge batch is a single range
+        milvus::engine::IDNumber first = generator.ReserveIDNumbers(1000000000);
+        last_id = first + 1000000000 - 1;
+    }
+
+    // restart never hands out used ids, even if the clock is behind
+    milvus::engine::AtomicIDGenerator generator(path);
+    ASSERT_TRUE(generator.Init().ok());
+    ASSERT_GT(generator.GetNextIDNumber(), last_id);
+
+    boost::filesystem::remove(path);
+}
+
+TEST(DBMiscTest, SEGMENT_SUMMARY_TEST) {
+    const int64_t count = 1000;
+    const uint16_t dimension = 16;
+    std::vector<float> vectors(count * dimension);
+    for (auto& value : vectors) {
+        value = drand48();
+    }
+
+    std::vector<int64_t> ids(count);
+    for (int64_t i = 0; i < count; i++) {
+        ids[i] = 100 + i * 2;
     }
+
+    milvus::engine::SegmentSummary summary;
+    ASSERT_FALSE(milvus::engine::SegmentSummary::Build(nullptr, ids.data(), count, dimension, summary).ok());
+    ASSERT_TRUE(milvus::engine::SegmentSummary::Build(vectors.data(), ids.data(), count, dimension, summary).ok());
+    ASSERT_EQ(summary.Dimension(), dimension);
+    ASSERT_EQ(summary.MinId(), 100);
+    ASSERT_EQ(summary.MaxId(), 100 + (count - 1) * 2);
+    ASSERT_TRUE(summary.MayContain(102));
+    ASSERT_FALSE(summary.MayContain(99));
+    ASSERT_FALSE(summary.MayContain(100 + count * 2));
+    ASSERT_LE(summary.MinNorm(), summary.MaxNorm());
+    ASSERT_GT(summary.MinNorm(), 0);
+
+    // bounds hold for every vector of the segment, the norm range bounds queries far from the origin and near it
+    for (int64_t q = 0; q < 12; q++) {
+        std::vector<float> query(dimension);
+        for (auto& value : query) {
+            value = (q < 10) ? drand48() * 2 : (q == 10) ? 0.0 : -10.0;
+        }
+        double l2_bound = summary.Bound(query.data(), milvus::engine::MetricType::L2);
+        double ip_bound = summary.Bound(query.data(), milvus::engine::MetricType::IP);
+        for (int64_t i = 0; i < count; i++) {
+            double l2 = 0.0, ip = 0.0;
+            for (uint16_t j = 0; j < dimension; j++) {
+                double diff = query[j] - vectors[i * dimension + j];
+                l2 += diff * diff;
+                ip += query[j] * vectors[i * dimension + j];
+            }
+            ASSERT_LE(l2_bound, l2 + 1e-4);
+            ASSERT_GE(ip_bound, ip - 1e-4);
+        }
+    }
+
+    std::string location = "/tmp/milvus_summary_test";
+    ASSERT_TRUE(summary.Write(location).ok());
+    milvus::engine::SegmentSummary read_summary;
+    ASSERT_TRUE(read_summary.Read(location).ok());
+    ASSERT_EQ(read_summary.Dimension(), dimension);
+    ASSERT_EQ(read_summary.Bound(vectors.data(), milvus::engine::MetricType::L2),
+              summary.Bound(vectors.data(), milvus::engine::MetricType::L2));
+    ASSERT_EQ(read_summary.MinId(), summary.MinId());
+    ASSERT_EQ(read_summary.MaxId(), summary.MaxId());
+    ASSERT_DOUBLE_EQ(read_summary.MaxNorm(), summary.MaxNorm());
+
+    auto& mgr = milvus::engine::SegmentSummaryMgr::GetInstance();
+    ASSERT_NE(mgr.GetSummary(location), nullptr);
+    ASSERT_EQ(mgr.GetSummary(location + "_not_exist"), nullptr);
+    boost::filesystem::remove(milvus::engine::SegmentSummary::GetSummaryPath(location));
+    mgr.EraseSummary(location);
+    ASSERT_EQ(mgr.GetSummary(location), nullptr);
+
+    // a file cached without summary gets the one built later
+    mgr.PutSummary(location, std::make_shared<milvus::engine::SegmentSummary>(summary));
+    ASSERT_NE(mgr.GetSummary(location), nullptr);
+    ASSERT_EQ(mgr.GetSummary(location)->MaxId(), summary.MaxId());
+    mgr.EraseSummary(location);
+}
+
+TEST(DBMiscTest, SEGMENT_TOMBSTONE_TEST) {
+    std::string location = "/tmp/milvus_tombstone_test";
+    auto path = milvus::engine::SegmentTombstone::GetTombstonePath(location);
+    boost::filesystem::remove(path);
+
+    auto& mgr = milvus::engine::SegmentTombstoneMgr::GetInstance();
+    mgr.EraseTombstone(location);
+    ASSERT_EQ(mgr.GetTombstone(location), nullptr);
+
+    // ids deleted twice count once
+    ASSERT_TRUE(mgr.Delete(location, {3, 1, 3}).ok());
+    ASSERT_TRUE(mgr.Delete(location, {1, 5}).ok());
+    auto tombstone = mgr.GetTombstone(location);
+    ASSERT_NE(tombstone, nullptr);
+    ASSERT_EQ(tombstone->Ids(), std::vector<int64_t>({3, 1, 5}));
+    ASSERT_TRUE(tombstone->IsDeleted(5));
+    ASSERT_FALSE(tombstone->IsDeleted(2));
+    ASSERT_FALSE(tombstone->Filter()->is_member(3));
+    ASSERT_TRUE(tombstone->Filter()->is_member(4));
+
+    // an id torn by a crash is dropped on read and cut off by the next append
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        file.write("\x07\x00\x00", 3);
+    }
+    mgr.EraseTombstone(location);
+    ASSERT_EQ(mgr.GetTombstone(location)->Count(), 3UL);
+    ASSERT_TRUE(mgr.Delete(location, {7}).ok());
+    std::vector<int64_t> ids;
+    ASSERT_TRUE(milvus::engine::SegmentTombstone::Read(location, ids).ok());
+    ASSERT_EQ(ids, std::vector<int64_t>({3, 1, 5, 7}));
+
+    boost::filesystem::remove(path);
+    mgr.EraseTombstone(location);
+    ASSERT_EQ(mgr.GetTombstone(location), nullptr);
+}
+
+TEST(DBMiscTest, SEGMENT_ATTRS_TEST) {
+    using milvus::engine::AttrColumn;
+    using milvus::engine::AttrPredicate;
+
+    milvus::engine::AttrColumns columns;
+    columns["price"].int_values_ = {10, 20, 30, 40};
+    columns["score"].type_ = AttrColumn::Type::DOUBLE;
+    columns["score"].double_values_ = {0.5, 1.5, 2.5, 3.5};
+    std::vector<int64_t> ids = {1, 2, 3, 4};
+
+    // the second batch has no score and gives doubles for price
+    milvus::engine::AttrColumns more_columns;
+    more_columns["price"].type_ = AttrColumn::Type::DOUBLE;
+    more_columns["price"].double_values_ = {50.5};
+    std::vector<int64_t> more_ids = {5};
+
+    milvus::engine::SegmentAttrs attrs;
+    attrs.Append(ids.data() + 1, 3, columns, 1);
+    attrs.Append(more_ids.data(), 1, more_columns, 0);
+    ASSERT_EQ(attrs.Count(), 4);
+    ASSERT_EQ(attrs.Ids(), std::vector<int64_t>({2, 3, 4, 5}));
+    ASSERT_EQ(attrs.Columns().at("price").type_, AttrColumn::Type::DOUBLE);
+    ASSERT_TRUE(std::isnan(attrs.Columns().at("score").Value(3)));
+
+    auto match = [&](const milvus::engine::AttrPredicates& predicates,
+                     const milvus::engine::SegmentTombstone* tombstone) {
+        std::vector<int64_t> matched;
+        attrs.MatchIds(predicates, tombstone, matched);
+        return matched;
+    };
+    ASSERT_EQ(match({{"price", AttrPredicate::Op::GE, {30}}}, nullptr), std::vector<int64_t>({3, 4, 5}));
+    ASSERT_EQ(match({{"price", AttrPredicate::Op::GE, {30}}, {"score", AttrPredicate::Op::LT, {3}}}, nullptr),
+              std::vector<int64_t>({3}));
+    // a vector without the attribute matches no predicate on it
+    ASSERT_EQ(match({{"score", AttrPredicate::Op::NE, {1.5}}}, nullptr), std::vector<int64_t>({3, 4}));
+    ASSERT_EQ(match({{"price", AttrPredicate::Op::IN, {20, 50.5}}}, nullptr), std::vector<int64_t>({2, 5}));
+    ASSERT_TRUE(match({{"color", AttrPredicate::Op::EQ, {1}}}, nullptr).empty());
+
+    milvus::engine::SegmentTombstone tombstone({3});
+    ASSERT_EQ(match({{"price", AttrPredicate::Op::GT, {10}}}, &tombstone), std::vector<int64_t>({2, 4, 5}));
+
+    std::string location = "/tmp/milvus_attrs_test";
+    ASSERT_TRUE(attrs.Write(location).ok());
+    auto& mgr = milvus::engine::SegmentAttrsMgr::GetInstance();
+    mgr.EraseAttrs(location);
+    auto read_attrs = mgr.GetAttrs(location);
+    ASSERT_NE(read_attrs, nullptr);
+    ASSERT_EQ(read_attrs->Ids(), attrs.Ids());
+    ASSERT_EQ(read_attrs->Columns().at("price").double_values_, attrs.Columns().at("price").double_values_);
+
+    auto filter = mgr.Filter({location}, {{"price", AttrPredicate::Op::LT, {35}}});
+    ASSERT_TRUE(filter->is_member(2));
+    ASSERT_FALSE(filter->is_member(4));
+    ASSERT_FALSE(filter->is_member(1));
+
+    boost::filesystem::remove(milvus::engine::SegmentAttrs::GetAttrsPath(location));
+    mgr.EraseAttrs(location);
+    ASSERT_EQ(mgr.GetAttrs(location), nullptr);
+}
+
+TEST(DBMiscTest, SEGMENT_TIME_RANGE_TEST) {
+    milvus::engine::SegmentTimeRange time_range;
+    ASSERT_TRUE(time_range.Empty());
+    time_range.Extend(2000);
+    time_range.Extend(1000);
+    milvus::engine::SegmentTimeRange other;
+    other.Extend(3000);
+    time_range.Extend(other);
+    ASSERT_FALSE(time_range.Empty());
+    ASSERT_EQ(time_range.MinTime(), 1000);
+    ASSERT_EQ(time_range.MaxTime(), 3000);
+
+    // ranges are half open
+    ASSERT_TRUE(time_range.Overlaps({}));
+    ASSERT_TRUE(time_range.Overlaps({{3000, 4000}}));
+    ASSERT_FALSE(time_range.Overlaps({{0, 1000}}));
+    ASSERT_FALSE(time_range.Overlaps({{0, 500}, {3001, 4000}}));
+    ASSERT_TRUE(time_range.Overlaps({{0, 500}, {1500, 1600}}));
+
+    std::string location = "/tmp/milvus_time_range_test";
+    ASSERT_TRUE(time_range.Write(location).ok());
+    auto& mgr = milvus::engine::SegmentTimeRangeMgr::GetInstance();
+    mgr.EraseTimeRange(location);
+    auto read_range = mgr.GetTimeRange(location);
+    ASSERT_NE(read_range, nullptr);
+    ASSERT_EQ(read_range->MinTime(), 1000);
+    ASSERT_EQ(read_range->MaxTime(), 3000);
+
+    // nothing was inserted into an empty range
+    milvus::engine::SegmentTimeRange empty_range;
+    ASSERT_TRUE(empty_range.Write(location).ok());
+    ASSERT_FALSE(empty_range.Read(location).ok());
+
+    boost::filesystem::remove(milvus::engine::SegmentTimeRange::GetTimeRangePath(location));
+    mgr.EraseTimeRange(location);
+    ASSERT_EQ(mgr.GetTimeRange(location), nullptr);
+}
+
+TEST(DBMiscTest, SEGMENT_ID_INDEX_TEST) {
+    std::vector<int64_t> ids = {40, 10, 30, 20};
+    milvus::engine::SegmentIdIndex id_index;
+    ASSERT_FALSE(milvus::engine::SegmentIdIndex::Build(nullptr, 0, id_index).ok());
+    ASSERT_TRUE(milvus::engine::SegmentIdIndex::Build(ids.data(), ids.size(), id_index).ok());
+    ASSERT_EQ(id_index.Count(), ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        ASSERT_EQ(id_index.Find(ids[i]), static_cast<int64_t>(i));
+    }
+    ASSERT_EQ(id_index.Find(25), -1);
+    ASSERT_EQ(id_index.Find(50), -1);
+
+    std::string location = "/tmp/milvus_id_index_test";
+    ASSERT_TRUE(id_index.Write(location).ok());
+    auto& mgr = milvus::engine::SegmentIdIndexMgr::GetInstance();
+    mgr.EraseIdIndex(location);
+    auto read_index = mgr.GetIdIndex(location);
+    ASSERT_NE(read_index, nullptr);
+    ASSERT_EQ(read_index->Find(30), 2);
+
+    boost::filesystem::remove(milvus::engine::SegmentIdIndex::GetIdIndexPath(location));
+    mgr.EraseIdIndex(location);
+    ASSERT_EQ(mgr.GetIdIndex(location), nullptr);
+}
+
+TEST(DBMiscTest, SEARCH_EFFORT_TEST) {
+    auto& controller = milvus::engine::SearchEffortController::GetInstance();
+    controller.Reset();
+
+    // disabled, nprobe is used as requested
+    controller.SetLatencyBudget(0);
+    controller.UpdateCost("tbl", 10, 32, 1000000);
+    ASSERT_EQ(controller.AdjustNprobe("tbl", 10, 32), 32);
+
+    controller.SetLatencyBudget(10);
+    ASSERT_TRUE(controller.Enabled());
+
+    // no cost learned yet
+    ASSERT_EQ(controller.AdjustNprobe("tbl", 10, 32), 32);
+
+    // 10 queries with nprobe 32 cost 32ms, ~1ms per query per 10 probes
+    controller.UpdateCost("tbl", 10, 32, 32000);
+    ASSERT_EQ(controller.AdjustNprobe("tbl", 10, 32), 10);
+    ASSERT_EQ(controller.AdjustNprobe("tbl", 1, 32), 32);
+    ASSERT_EQ(controller.AdjustNprobe("tbl", 1000, 32), 1);
+    ASSERT_EQ(controller.AdjustNprobe("other_tbl", 10, 32), 32);
+
+    // cost drops once the load is gone, nprobe recovers gradually
+    uint64_t nprobe = controller.AdjustNprobe("tbl", 10, 32);
+    for (int i = 0; i < 20; i++) {
+        controller.UpdateCost("tbl", 10, 32, 3200);
+        uint64_t adjusted = controller.AdjustNprobe("tbl", 10, 32);
+        ASSERT_GE(adjusted, nprobe);
+        nprobe = adjusted;
+    }
+    ASSERT_EQ(nprobe, 32);
+
+    controller.Reset();
+    controller.SetLatencyBudget(0);
+}
+
+TEST(DBMiscTest, SEGMENT_OWNERSHIP_TEST) {
+    auto& ownership = milvus::engine::SegmentOwnership::GetInstance();
+    std::vector<std::string> nodes = {"192.168.0.246", "192.168.0.247", "192.168.0.248", "10.0.0.1"};
+
+    // disabled, every file is owned
+    ownership.SetRing(nodes, "");
+    ASSERT_FALSE(ownership.Enabled());
+    ASSERT_TRUE(ownership.Owns(0));
+    ASSERT_TRUE(ownership.Owns(3));
+
+    // files are owned by the nodes mishards routes them to
+    ownership.SetRing(nodes, "192.168.0.247");
+    ASSERT_TRUE(ownership.Enabled());
+    ASSERT_TRUE(ownership.Owns(0));
+    ASSERT_FALSE(ownership.Owns(1));
+    ASSERT_FALSE(ownership.Owns(3));
+
+    ownership.SetRing(nodes, "192.168.0.246");
+    ASSERT_FALSE(ownership.Owns(0));
+    ASSERT_TRUE(ownership.Owns(3));
+
+    // each file is owned by exactly one node
+    for (size_t id = 0; id < 100; ++id) {
+        int owners = 0;
+        for (auto& node : nodes) {
+            ownership.SetRing(nodes, node);
+            owners += ownership.Owns(id) ? 1 : 0;
+        }
+        ASSERT_EQ(owners, 1);
+    }
+
+    std::vector<std::string> no_nodes;
+    ownership.SetRing(no_nodes, "");
+    ASSERT_FALSE(ownership.Enabled());
+}
+
+TEST(DBMiscTest, META_CHANGE_FEED_TEST) {
+    auto& feed = milvus::engine::meta::MetaChangeFeed::GetInstance();
+    uint64_t epoch = feed.Epoch();
+    uint64_t version = feed.Version();
+
+    std::vector<milvus::engine::meta::MetaChange> changes;
+    ASSERT_TRUE(feed.ChangesSince(epoch, version, changes));
+    ASSERT_TRUE(changes.empty());
+
+    feed.Publish("tbl", {1, 2}, {"/tmp/tbl/3"});
+    feed.Publish("", {}, {});
+    ASSERT_EQ(feed.Version(), version + 2);
+    ASSERT_TRUE(feed.ChangesSince(epoch, version, changes));
+    ASSERT_EQ(changes.size(), 2UL);
+    ASSERT_EQ(changes[0].table_id_, "tbl");
+    ASSERT_EQ(changes[0].added_.size(), 2UL);
+    ASSERT_EQ(changes[0].removed_[0], "/tmp/tbl/3");
+    ASSERT_TRUE(changes[1].table_id_.empty());
+    ASSERT_TRUE(feed.ChangesSince(epoch, version + 1, changes));
+    ASSERT_EQ(changes.size(), 1UL);
+
+    // another epoch or a version not reached yet can't be followed
+    ASSERT_FALSE(feed.ChangesSince(epoch + 1, version, changes));
+    ASSERT_FALSE(feed.ChangesSince(epoch, version + 3, changes));
+
+    // changes too old are dropped
+    for (int i = 0; i < 5000; ++i) {
+        feed.Publish("tbl", {}, {});
+    }
+    ASSERT_FALSE(feed.ChangesSince(epoch, version, changes));
+
+    ASSERT_TRUE(feed.ChangesSince(epoch, feed.Version() - 1, changes));
+    std::string text = milvus::engine::meta::MetaChangeFeed::Encode(epoch, feed.Version(), true, changes);
+    uint64_t decoded_epoch = 0, decoded_version = 0;
+    bool complete = false;
+    std::vector<milvus::engine::meta::MetaChange> decoded;
+    ASSERT_TRUE(milvus::engine::meta::MetaChangeFeed::Decode(text, decoded_epoch, decoded_version, complete,
+                                                             decoded));
+    ASSERT_EQ(decoded_epoch, epoch);
+    ASSERT_EQ(decoded_version, feed.Version());
+    ASSERT_TRUE(complete);
+    ASSERT_EQ(decoded.size(), 1UL);
+
+    std::vector<milvus::engine::meta::MetaChange> to_encode(2);
+    to_encode[0].table_id_ = "tbl";
+    to_encode[0].added_ = {4, 5};
+    to_encode[0].removed_ = {"/tmp/tbl/1", "/tmp/tbl/2"};
+    text = milvus::engine::meta::MetaChangeFeed::Encode(1, 7, false, to_encode);
+    ASSERT_TRUE(milvus::engine::meta::MetaChangeFeed::Decode(text, decoded_epoch, decoded_version, complete,
+                                                             decoded));
+    ASSERT_EQ(decoded_epoch, 1UL);
+    ASSERT_EQ(decoded_version, 7UL);
+    ASSERT_FALSE(complete);
+    ASSERT_EQ(decoded.size(), 2UL);
+    ASSERT_EQ(decoded[0].added_[1], 5UL);
+    ASSERT_EQ(decoded[0].removed_[1], "/tmp/tbl/2");
+    ASSERT_TRUE(decoded[1].table_id_.empty());
+    ASSERT_TRUE(decoded[1].added_.empty());
+    ASSERT_TRUE(decoded[1].removed_.empty());
+
+    ASSERT_FALSE(milvus::engine::meta::MetaChangeFeed::Decode("1 2", decoded_epoch, decoded_version, complete,
+                                                              decoded));
+    ASSERT_FALSE(milvus::engine::meta::MetaChangeFeed::Decode("1 2 1\ntbl a -", decoded_epoch, decoded_version,
+                                                              complete, decoded));
+}
+
+TEST(DBMiscTest, MERGE_POLICY_TEST) {
+    auto make_files = [](const std::vector<size_t>& sizes) {
+        milvus::engine::meta::TableFilesSchema files;
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            milvus::engine::meta::TableFileSchema file;
+            file.id_ = i;
+            file.file_size_ = sizes[i];
+            file.index_file_size_ = 1024 * milvus::engine::ONE_MB;
+            files.push_back(file);
+        }
+        return files;
+    };
+
+    // small files are merged with each other, never with the large one
+    milvus::engine::TieredMergePolicy policy(2, 16, 4, milvus::engine::ONE_MB);
+    auto groups = policy.Pick(make_files({100 * milvus::engine::ONE_MB, 1024, 2048, 4096}));
+    ASSERT_EQ(groups.size(), 1UL);
+    ASSERT_EQ(groups[0].size(), 3UL);
+    for (auto& file : groups[0]) {
+        ASSERT_NE(file.id_, 0UL);
+    }
+
+    // a lone file of a tier waits for more
+    groups = policy.Pick(make_files({1024, 100 * milvus::engine::ONE_MB}));
+    ASSERT_TRUE(groups.empty());
+
+    // fan-in is bounded, the rest of a tier is merged separately
+    std::vector<size_t> sizes(40, 1024);
+    groups = policy.Pick(make_files(sizes));
+    ASSERT_EQ(groups.size(), 3UL);
+    ASSERT_EQ(groups[0].size(), 16UL);
+    ASSERT_EQ(groups[2].size(), 8UL);
+
+    // a merge stops at index file size
+    sizes.assign(6, 400 * milvus::engine::ONE_MB);
+    groups = policy.Pick(make_files(sizes));
+    ASSERT_EQ(groups.size(), 2UL);
+    ASSERT_EQ(groups[0].size(), 3UL);
+}
+
+TEST(DBMiscTest, INDEX_ADVISOR_TEST) {
+    const int64_t dimension = 16, rows = 3000;
+    std::vector<float> samples(rows * dimension);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(-1.0, 1.0);
+    for (auto& value : samples) {
+        value = dis(gen);
+    }
+
+    milvus::engine::IndexAdvisor advisor(dimension, milvus::engine::MetricType::L2, 100000);
+    milvus::engine::IndexAdvice advice;
+    ASSERT_FALSE(advisor.Advise(samples, 1.5, 10, advice).ok());
+    std::vector<float> few(100 * dimension);
+    ASSERT_FALSE(advisor.Advise(few, 0.9, 10, advice).ok());
+
+    auto status = advisor.Advise(samples, 0.9, 10, advice);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(advice.segment_rows_, 100000);
+    ASSERT_EQ(advice.sample_rows_, rows);
+    ASSERT_GT(advice.trials_.size(), 1UL);
+
+    // the brute force search is always tried, the advice reaches the recall
+    ASSERT_EQ(advice.trials_[0].engine_type_, milvus::engine::EngineType::FAISS_IDMAP);
+    ASSERT_DOUBLE_EQ(advice.trials_[0].recall_, 1.0);
+    ASSERT_TRUE(advice.best_.reached_);
+    ASSERT_GE(advice.best_.recall_, 0.9);
+    ASSERT_GT(advice.best_.nlist_, 0);
+    for (auto& trial : advice.trials_) {
+        if (trial.engine_type_ == milvus::engine::EngineType::FAISS_IVFFLAT && trial.reached_) {
+            ASSERT_GT(trial.nprobe_, 0);
+            ASSERT_GT(trial.memory_, advice.segment_rows_ * dimension * static_cast<int64_t>(sizeof(float)));
+        }
+    }
+
+    milvus::engine::IndexAdvisor binary_advisor(dimension, milvus::engine::MetricType::HAMMING, 100000);
+    ASSERT_FALSE(binary_advisor.Advise(samples, 0.9, 10, advice).ok());
 }
@@ -162,6 +162,42 @@ TEST(DBSearchTest, MERGE_RESULT_SET_TEST) {
     MergeTopkToResultSetTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false);
 }
 
+void
+MergeTopkHeapTest(const std::vector<size_t>& input_ks, size_t nq, size_t topk, bool ascending) {
+    ms::SearchResults results(input_ks.size());
+    ms::ResultIds merge_ids;
+    ms::ResultDistances merge_distances;
+    for (size_t i = 0; i < input_ks.size(); i++) {
+        BuildResult(results[i].ids_, results[i].distances_, input_ks[i], topk, nq, ascending);
+        results[i].k_ = input_ks[i];
+        ms::XSearchTask::MergeTopkToResultSet(results[i].ids_, results[i].distances_, input_ks[i], nq, topk,
+                                              ascending, merge_ids, merge_distances);
+    }
+
+    // k-way merge must give the same distances as merging file by file
+    ms::ResultIds heap_ids;
+    ms::ResultDistances heap_distances;
+    ms::XSearchTask::MergeTopkHeap(results, nq, topk, ascending, heap_ids, heap_distances);
+    ASSERT_EQ(heap_ids.size(), merge_ids.size());
+    ASSERT_EQ(heap_distances, merge_distances);
+}
+
+TEST(DBSearchTest, MERGE_HEAP_TEST) {
+    size_t NQ = 15;
+    size_t TOP_K = 64;
+
+    MergeTopkHeapTest({TOP_K}, NQ, TOP_K, true);
+    MergeTopkHeapTest({TOP_K, TOP_K, TOP_K}, NQ, TOP_K, true);
+    MergeTopkHeapTest({TOP_K, TOP_K, TOP_K}, NQ, TOP_K, false);
+    MergeTopkHeapTest({TOP_K / 2, 0, TOP_K / 3, 1}, NQ, TOP_K, true);
+    MergeTopkHeapTest({TOP_K / 2, 0, TOP_K / 3, 1}, NQ, TOP_K, false);
+    MergeTopkHeapTest({1, 2, 3}, NQ, TOP_K, true);
+
+    /* large batch is reduced in parallel */
+    MergeTopkHeapTest({TOP_K, TOP_K / 2, TOP_K}, 1000, TOP_K, true);
+    MergeTopkHeapTest({TOP_K, TOP_K / 2, TOP_K}, 1000, TOP_K, false);
+}
+
 //void MergeTopkArrayTest(size_t topk_1, size_t topk_2, size_t nq, size_t topk, bool ascending) {
 //    std::vector<int64_t> ids1, ids2;
 //    std::vector<float> dist1, dist2;
@@ -0,0 +1,407 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <fiu-control.h>
+#include <fiu-local.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db/wal/WalManager.h"
+
+namespace {
+
+static const char* WAL_PATH = "/tmp/milvus_wal_test";
+static constexpr int64_t TABLE_DIM = 16;
+
+void
+BuildVectors(uint64_t n, int64_t id_offset, milvus::engine::VectorsData& vectors) {
+    vectors.vector_count_ = n;
+    vectors.float_data_.resize(n * TABLE_DIM);
+    vectors.id_array_.resize(n);
+    for (uint64_t i = 0; i < n; i++) {
+        for (int64_t j = 0; j < TABLE_DIM; j++) {
+            vectors.float_data_[TABLE_DIM * i + j] = drand48();
+        }
+        vectors.id_array_[i] = id_offset + i;
+    }
+}
+
+class WalTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        boost::filesystem::remove_all(WAL_PATH);
+    }
+
+    void
+    TearDown() override {
+        boost::filesystem::remove_all(WAL_PATH);
+    }
+};
+
+}  // namespace
+
+TEST_F(WalTest, APPEND_REPLAY_TEST) {
+    std::vector<uint64_t> lsns;
+    {
+        milvus::engine::wal::WalManager wal(WAL_PATH);
+        ASSERT_TRUE(wal.Init().ok());
+        ASSERT_TRUE(wal.Replay([](const std::string&, milvus::engine::VectorsData&) {
+                           return milvus::Status::OK();
+                       }).ok());
+
+        for (int64_t i = 0; i < 10; i++) {
+            milvus::engine::VectorsData vectors;
+            BuildVectors(100, i * 100, vectors);
+            uint64_t lsn = 0;
+            auto status = wal.Append("tbl_" + std::to_string(i % 2), vectors, lsn);
+            ASSERT_TRUE(status.ok());
+            wal.MarkApplied(lsn);
+            lsns.push_back(lsn);
+        }
+        ASSERT_EQ(wal.GetAppliedLsn(), lsns.back());
+    }
+
+    // nothing is checkpointed, all records are replayed in order
+    milvus::engine::wal::WalManager wal(WAL_PATH);
+    ASSERT_TRUE(wal.Init().ok());
+    int64_t replayed = 0;
+    auto handler = [&](const std::string& table_id, milvus::engine::VectorsData& vectors) {
+        EXPECT_EQ(table_id, "tbl_" + std::to_string(replayed % 2));
+        EXPECT_EQ(vectors.vector_count_, 100);
+        EXPECT_EQ(vectors.float_data_.size(), 100 * TABLE_DIM);
+        EXPECT_EQ(vectors.id_array_.front(), replayed * 100);
+        ++replayed;
+        return milvus::Status::OK();
+    };
+    ASSERT_TRUE(wal.Replay(handler).ok());
+    ASSERT_EQ(replayed, 10);
+
+    // lsn keeps growing after replay
+    milvus::engine::VectorsData vectors;
+    BuildVectors(1, 0, vectors);
+    uint64_t lsn = 0;
+    ASSERT_TRUE(wal.Append("tbl_0", vectors, lsn).ok());
+    ASSERT_GT(lsn, lsns.back());
+}
+
+TEST_F(WalTest, CHECKPOINT_TEST) {
+    uint64_t checkpoint_lsn = 0;
+    {
+        // small segment size to force rotation
+        milvus::engine::wal::WalManager wal(WAL_PATH, 4096);
+        ASSERT_TRUE(wal.Init().ok());
+        ASSERT_TRUE(wal.Replay([](const std::string&, milvus::engine::VectorsData&) {
+                           return milvus::Status::OK();
+                       }).ok());
+
+        for (int64_t i = 0; i < 20; i++) {
+            milvus::engine::VectorsData vectors;
+            BuildVectors(50, i * 50, vectors);
+            uint64_t lsn = 0;
+            ASSERT_TRUE(wal.Append("tbl", vectors, lsn).ok());
+            wal.MarkApplied(lsn);
+            if (i == 14) {
+                checkpoint_lsn = wal.GetAppliedLsn();
+            }
+        }
+
+        ASSERT_TRUE(wal.Checkpoint(checkpoint_lsn).ok());
+        ASSERT_EQ(wal.GetFlushedLsn(), checkpoint_lsn);
+    }
+
+    // old segments are removed
+    int64_t segment_count = 0;
+    boost::filesystem::directory_iterator end_iter;
+    for (boost::filesystem::directory_iterator iter(WAL_PATH); iter != end_iter; ++iter) {
+        if (iter->path().extension().string() == ".wal") {
+            ++segment_count;
+        }
+    }
+    ASSERT_LT(segment_count, 20);
+
+    // only records after checkpoint are replayed
+    milvus::engine::wal::WalManager wal(WAL_PATH, 4096);
+    ASSERT_TRUE(wal.Init().ok());
+    ASSERT_EQ(wal.GetFlushedLsn(), checkpoint_lsn);
+    int64_t replayed = 0;
+    ASSERT_TRUE(wal.Replay([&](const std::string&, milvus::engine::VectorsData& vectors) {
+                       EXPECT_EQ(vectors.id_array_.front(), (15 + replayed) * 50);
+                       ++replayed;
+                       return milvus::Status::OK();
+                   }).ok());
+    ASSERT_EQ(replayed, 5);
+}
+
+TEST_F(WalTest, CHECKPOINT_SYNC_FAIL_TEST) {
+    auto count_segments = []() {
+        int64_t count = 0;
+        boost::filesystem::directory_iterator end_iter;
+        for (boost::filesystem::directory_iterator iter(WAL_PATH); iter != end_iter; ++iter) {
+            if (iter->path().extension().string() == ".wal") {
+                ++count;
+            }
+        }
+        return count;
+    };
+
+    milvus::engine::wal::WalManager wal(WAL_PATH, 4096);
+    ASSERT_TRUE(wal.Init().ok());
+    ASSERT_TRUE(wal.Replay([](const std::string&, milvus::engine::VectorsData&) {
+                       return milvus::Status::OK();
+                   }).ok());
+
+    for (int64_t i = 0; i < 10; i++) {
+        milvus::engine::VectorsData vectors;
+        BuildVectors(50, i * 50, vectors);
+        uint64_t lsn = 0;
+        ASSERT_TRUE(wal.Append("tbl", vectors, lsn).ok());
+        wal.MarkApplied(lsn);
+    }
+    int64_t segment_count = count_segments();
+    ASSERT_GT(segment_count, 1);
+
+    // no segment is removed while the new checkpoint may not survive a crash
+    fiu_enable("WalManager.SyncDirectory.fail", 1, NULL, 0);
+    ASSERT_FALSE(wal.Checkpoint(wal.GetAppliedLsn()).ok());
+    fiu_disable("WalManager.SyncDirectory.fail");
+    ASSERT_EQ(wal.GetFlushedLsn(), 0);
+    ASSERT_EQ(count_segments(), segment_count);
+
+    ASSERT_TRUE(wal.Checkpoint(wal.GetAppliedLsn()).ok());
+    ASSERT_EQ(wal.GetFlushedLsn(), wal.GetAppliedLsn());
+    ASSERT_LT(count_segments(), segment_count);
+}
+
+TEST_F(WalTest, TORN_TAIL_TEST) {
+    {
+        milvus::engine::wal::WalManager wal(WAL_PATH);
+        ASSERT_TRUE(wal.Init().ok());
+        ASSERT_TRUE(wal.Replay([](const std::string&, milvus::engine::VectorsData&) {
+                           return milvus::Status::OK();
+                       }).ok());
+
+        for (int64_t i = 0; i < 3; i++) {
+            milvus::engine::VectorsData vectors;
+            BuildVectors(10, i * 10, vectors);
+            uint64_t lsn = 0;
+            ASSERT_TRUE(wal.Append("tbl", vectors, lsn).ok());
+        }
+    }
+
+    // simulate a crash in the middle of writing a record
+    std::string segment;
+    boost::filesystem::directory_iterator end_iter;
+    for (boost::filesystem::directory_iterator iter(WAL_PATH); iter != end_iter; ++iter) {
+        if (iter->path().extension().string() == ".wal") {
+            segment = iter->path().string();
+        }
+    }
+    ASSERT_FALSE(segment.empty());
+    {
+        std::ofstream file(segment, std::ios::out | std::ios::binary | std::ios::app);
+        const char garbage[] = "torn record";
+        file.write(garbage, sizeof(garbage));
+    }
+
+    int64_t replayed = 0;
+    auto handler = [&](const std::string&, milvus::engine::VectorsData&) {
+        ++replayed;
+        return milvus::Status::OK();
+    };
+
+    {
+        milvus::engine::wal::WalManager wal(WAL_PATH);
+        ASSERT_TRUE(wal.Init().ok());
+        ASSERT_TRUE(wal.Replay(handler).ok());
+        ASSERT_EQ(replayed, 3);
+
+        milvus::engine::VectorsData vectors;
+        BuildVectors(10, 30, vectors);
+        uint64_t lsn = 0;
+        ASSERT_TRUE(wal.Append("tbl", vectors, lsn).ok());
+    }
+
+    // record written after the torn tail must survive
+    replayed = 0;
+    milvus::engine::wal::WalManager wal(WAL_PATH);
+    ASSERT_TRUE(wal.Init().ok());
+    ASSERT_TRUE(wal.Replay(handler).ok());
+    ASSERT_EQ(replayed, 4);
+}
+
+TEST_F(WalTest, GROUP_COMMIT_TEST) {
+    milvus::engine::wal::WalManager wal(WAL_PATH);
+    ASSERT_TRUE(wal.Init().ok());
+    ASSERT_TRUE(wal.Replay([](const std::string&, milvus::engine::VectorsData&) {
+                       return milvus::Status::OK();
+                   }).ok());
+
+    const int64_t thread_count = 8;
+    const int64_t loop = 20;
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < thread_count; t++) {
+        threads.emplace_back([&, t]() {
+            for (int64_t i = 0; i < loop; i++) {
+                milvus::engine::VectorsData vectors;
+                BuildVectors(10, (t * loop + i) * 10, vectors);
+                uint64_t lsn = 0;
+                EXPECT_TRUE(wal.Append("tbl_" + std::to_string(t), vectors, lsn).ok());
+                wal.MarkApplied(lsn);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(wal.GetAppliedLsn(), thread_count * loop);
+
+    ASSERT_TRUE(wal.Checkpoint(wal.GetAppliedLsn()).ok());
+    milvus::engine::wal::WalManager wal2(WAL_PATH);
+    ASSERT_TRUE(wal2.Init().ok());
+    int64_t replayed = 0;
+    ASSERT_TRUE(wal2.Replay([&](const std::string&, milvus::engine::VectorsData&) {
+                        ++replayed;
+                        return milvus::Status::OK();
+                    }).ok());
+    ASSERT_EQ(replayed, 0);
+}
+
+TEST_F(WalTest, TABLE_CHECKPOINT_TEST) {
+    uint64_t last_lsn = 0;
+    {
+        milvus::engine::wal::WalManager wal(WAL_PATH, 4096);
+        ASSERT_TRUE(wal.Init().ok());
+        ASSERT_TRUE(wal.Replay([](const std::string&, milvus::engine::VectorsData&) {
+                           return milvus::Status::OK();
+                       }).ok());
+
+        for (int64_t i = 0; i < 20; i++) {
+            milvus::engine::VectorsData vectors;
+            BuildVectors(50, i * 50, vectors);
+            uint64_t lsn = 0;
+            ASSERT_TRUE(wal.Append("tbl_" + std::to_string(i % 2), vectors, lsn).ok());
+            wal.MarkApplied(lsn);
+        }
+        last_lsn = wal.GetAppliedLsn();
+
+        // tbl_1 is flushed alone, log is still needed by tbl_0
+        ASSERT_TRUE(wal.Checkpoint(last_lsn, {"tbl_1"}).ok());
+        ASSERT_EQ(wal.GetFlushedLsn(), 0);
+    }
+
+    // only records of tbl_0 are replayed
+    {
+        milvus::engine::wal::WalManager wal(WAL_PATH, 4096);
+        ASSERT_TRUE(wal.Init().ok());
+        int64_t replayed = 0;
+        ASSERT_TRUE(wal.Replay([&](const std::string& table_id, milvus::engine::VectorsData&) {
+                           EXPECT_EQ(table_id, "tbl_0");
+                           ++replayed;
+                           return milvus::Status::OK();
+                       }).ok());
+        ASSERT_EQ(replayed, 10);
+
+        // once tbl_0 is flushed too, the whole log is checkpointed
+        ASSERT_TRUE(wal.Checkpoint(last_lsn, {"tbl_0"}).ok());
+        ASSERT_EQ(wal.GetFlushedLsn(), last_lsn);
+    }
+
+    milvus::engine::wal::WalManager wal(WAL_PATH, 4096);
+    ASSERT_TRUE(wal.Init().ok());
+    int64_t replayed = 0;
+    ASSERT_TRUE(wal.Replay([&](const std::string&, milvus::engine::VectorsData&) {
+                       ++replayed;
+                       return milvus::Status::OK();
+                   }).ok());
+    ASSERT_EQ(replayed, 0);
+}
+
+TEST_F(WalTest, ATTRS_TEST) {
+    {
+        milvus::engine::wal::WalManager wal(WAL_PATH);
+        ASSERT_TRUE(wal.Init().ok());
+        ASSERT_TRUE(wal.Replay([](const std::string&, milvus::engine::VectorsData&) {
+                           return milvus::Status::OK();
+                       }).ok());
+
+        // a record with attributes follows one without
+        uint64_t lsn = 0;
+        milvus::engine::VectorsData vectors;
+        BuildVectors(3, 0, vectors);
+        ASSERT_TRUE(wal.Append("tbl", vectors, lsn).ok());
+        BuildVectors(3, 3, vectors);
+        vectors.attrs_["price"].int_values_ = {1, 2, 3};
+        vectors.attrs_["score"].type_ = milvus::engine::AttrColumn::Type::DOUBLE;
+        vectors.attrs_["score"].double_values_ = {0.5, 1.5, 2.5};
+        ASSERT_TRUE(wal.Append("tbl", vectors, lsn).ok());
+    }
+
+    milvus::engine::wal::WalManager wal(WAL_PATH);
+    ASSERT_TRUE(wal.Init().ok());
+    std::vector<milvus::engine::VectorsData> replayed;
+    ASSERT_TRUE(wal.Replay([&](const std::string&, milvus::engine::VectorsData& vectors) {
+                       replayed.push_back(vectors);
+                       return milvus::Status::OK();
+                   }).ok());
+    ASSERT_EQ(replayed.size(), 2UL);
+    ASSERT_TRUE(replayed[0].attrs_.empty());
+    ASSERT_EQ(replayed[1].id_array_.front(), 3);
+    ASSERT_EQ(replayed[1].attrs_.size(), 2UL);
+    ASSERT_EQ(replayed[1].attrs_["price"].int_values_, std::vector<int64_t>({1, 2, 3}));
+    ASSERT_EQ(replayed[1].attrs_["score"].type_, milvus::engine::AttrColumn::Type::DOUBLE);
+    ASSERT_EQ(replayed[1].attrs_["score"].double_values_, std::vector<double>({0.5, 1.5, 2.5}));
+}
+
+TEST_F(WalTest, INSERT_TIME_TEST) {
+    {
+        milvus::engine::wal::WalManager wal(WAL_PATH);
+        ASSERT_TRUE(wal.Init().ok());
+        ASSERT_TRUE(wal.Replay([](const std::string&, milvus::engine::VectorsData&) {
+                           return milvus::Status::OK();
+                       }).ok());
+
+        // a record without insert time, one with it only, one with attributes too
+        uint64_t lsn = 0;
+        milvus::engine::VectorsData no_time;
+        BuildVectors(3, 0, no_time);
+        ASSERT_TRUE(wal.Append("tbl", no_time, lsn).ok());
+        milvus::engine::VectorsData time_only;
+        BuildVectors(3, 3, time_only);
+        time_only.insert_time_us_ = 1000;
+        ASSERT_TRUE(wal.Append("tbl", time_only, lsn).ok());
+        milvus::engine::VectorsData time_attrs;
+        BuildVectors(3, 6, time_attrs);
+        time_attrs.insert_time_us_ = 2000;
+        time_attrs.attrs_["price"].int_values_ = {1, 2, 3};
+        ASSERT_TRUE(wal.Append("tbl", time_attrs, lsn).ok());
+    }
+
+    milvus::engine::wal::WalManager wal(WAL_PATH);
+    ASSERT_TRUE(wal.Init().ok());
+    std::vector<milvus::engine::VectorsData> replayed;
+    ASSERT_TRUE(wal.Replay([&](const std::string&, milvus::engine::VectorsData& vectors) {
+                       replayed.push_back(vectors);
+                       return milvus::Status::OK();
+                   }).ok());
+    ASSERT_EQ(replayed.size(), 3UL);
+    ASSERT_EQ(replayed[0].insert_time_us_, 0);
+    ASSERT_EQ(replayed[1].insert_time_us_, 1000);
+    ASSERT_TRUE(replayed[1].attrs_.empty());
+    ASSERT_EQ(replayed[2].insert_time_us_, 2000);
+    ASSERT_EQ(replayed[2].attrs_["price"].int_values_, std::vector<int64_t>({1, 2, 3}));
+}
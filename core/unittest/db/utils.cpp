@@ -224,6 +224,25 @@ MetaTest::TearDown() {
     boost::filesystem::remove_all(options.meta_.path_);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+KVMetaTest::SetUp() {
+    BaseTest::SetUp();
+
+    auto options = GetOptions();
+    impl_ = std::make_shared<milvus::engine::meta::KVMetaImpl>(options.meta_);
+}
+
+void
+KVMetaTest::TearDown() {
+    impl_->DropAll();
+
+    BaseTest::TearDown();
+
+    auto options = GetOptions();
+    boost::filesystem::remove_all(options.meta_.path_);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 milvus::engine::DBOptions
 MySqlDBTest:: GetOptions() {
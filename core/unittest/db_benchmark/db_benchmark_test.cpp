@@ -0,0 +1,380 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <hdf5.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db/utils.h"
+#include "utils/Json.h"
+
+/*****************************************************************************************
+ * Benchmark of the whole db stack: insert, flush, build index and concurrent search.
+ * Every measurement is appended as one json line to RESULT_FILE, so that results of two
+ * builds can be compared by a script. Datasets are the HDF5 files of ann-benchmarks,
+ * a dataset whose file is absent from the working directory is skipped.
+ *****************************************************************************************/
+
+namespace {
+
+const char HDF5_POSTFIX[] = ".hdf5";
+const char HDF5_DATASET_TRAIN[] = "train";
+const char HDF5_DATASET_TEST[] = "test";
+const char HDF5_DATASET_NEIGHBORS[] = "neighbors";
+
+const char RESULT_FILE[] = "db_benchmark_result.json";
+
+// insert throughput is measured on the first INSERT_SAMPLE_ROWS rows for each batch size
+const std::vector<int64_t> INSERT_BATCH_SIZES = {1000, 10000, 100000};
+const int64_t INSERT_SAMPLE_ROWS = 200000;
+const int64_t LOAD_BATCH_SIZE = 100000;
+
+const int32_t NLIST = 16384;
+const int64_t TOPK = 10;
+const std::vector<int64_t> NPROBES = {1, 4, 16, 64, 256};
+
+// concurrent search runs with the smallest nprobe reaching the recall
+const double TARGET_RECALL = 0.9;
+const std::vector<int64_t> CONCURRENCIES = {1, 4, 16};
+const int64_t QUERIES_PER_THREAD = 1000;
+
+using Clock = std::chrono::steady_clock;
+
+double
+SecondsFrom(const Clock::time_point& start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void
+WriteResult(const milvus::json& record) {
+    std::cout << record.dump() << std::endl;
+    std::ofstream out(RESULT_FILE, std::ios::app);
+    out << record.dump() << std::endl;
+}
+
+// ann-benchmarks names a dataset as <name>-<dimension>-<metric>
+bool
+ParseDatasetName(const std::string& name, int64_t& dim, bool& angular) {
+    size_t pos1 = name.find_first_of('-', 0);
+    if (pos1 == std::string::npos) {
+        return false;
+    }
+    size_t pos2 = name.find_first_of('-', pos1 + 1);
+    if (pos2 == std::string::npos) {
+        return false;
+    }
+
+    dim = std::stoi(name.substr(pos1 + 1, pos2 - pos1 - 1));
+    std::string metric = name.substr(pos2 + 1);
+    if (metric != "angular" && metric != "euclidean") {
+        return false;
+    }
+    angular = (metric == "angular");
+    return true;
+}
+
+template <typename T>
+bool
+ReadHDF5(const std::string& file_name, const std::string& dataset_name, hid_t mem_type, std::vector<T>& data,
+         size_t& rows, size_t& dim) {
+    hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file < 0) {
+        return false;
+    }
+    hid_t dataset = H5Dopen2(file, dataset_name.c_str(), H5P_DEFAULT);
+    if (dataset < 0) {
+        H5Fclose(file);
+        return false;
+    }
+
+    hid_t dataspace = H5Dget_space(dataset);
+    hsize_t dims[2] = {0, 0};
+    H5Sget_simple_extent_dims(dataspace, dims, nullptr);
+    rows = dims[0];
+    dim = dims[1];
+
+    data.resize(rows * dim);
+    herr_t status = H5Dread(dataset, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+
+    H5Sclose(dataspace);
+    H5Dclose(dataset);
+    H5Fclose(file);
+    return status >= 0;
+}
+
+void
+Normalize(std::vector<float>& data, size_t dim) {
+    for (size_t i = 0; i < data.size() / dim; i++) {
+        float* vector = data.data() + i * dim;
+        double length = 0.0;
+        for (size_t j = 0; j < dim; j++) {
+            length += vector[j] * vector[j];
+        }
+        double inv_length = 1.0 / std::sqrt(length);
+        for (size_t j = 0; j < dim; j++) {
+            vector[j] = static_cast<float>(vector[j] * inv_length);
+        }
+    }
+}
+
+void
+BuildVectors(const std::vector<float>& data, int64_t dim, int64_t offset, int64_t count,
+             milvus::engine::VectorsData& vectors) {
+    vectors.vector_count_ = count;
+    vectors.float_data_.assign(data.begin() + offset * dim, data.begin() + (offset + count) * dim);
+    vectors.id_array_.resize(count);
+    for (int64_t i = 0; i < count; i++) {
+        vectors.id_array_[i] = offset + i;
+    }
+}
+
+// hits of the results among the first TOPK ground truth neighbors of each query
+int64_t
+CountHits(const std::vector<int>& neighbors, size_t gt_k, int64_t first_query, int64_t nq,
+          const milvus::engine::ResultIds& result_ids) {
+    int64_t hits = 0;
+    for (int64_t i = 0; i < nq; i++) {
+        auto gt = neighbors.begin() + (first_query + i) * gt_k;
+        std::set<int64_t> ground(gt, gt + std::min<size_t>(gt_k, TOPK));
+        for (int64_t j = 0; j < TOPK && static_cast<size_t>(i * TOPK + j) < result_ids.size(); j++) {
+            hits += ground.count(result_ids[i * TOPK + j]);
+        }
+    }
+    return hits;
+}
+
+double
+Percentile(std::vector<double>& latencies, double percent) {
+    if (latencies.empty()) {
+        return 0.0;
+    }
+    size_t index = std::min(latencies.size() - 1, static_cast<size_t>(latencies.size() * percent));
+    std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+    return latencies[index];
+}
+
+milvus::engine::meta::TableSchema
+BuildTableSchema(const std::string& table_id, int64_t dim, bool angular) {
+    milvus::engine::meta::TableSchema table_info;
+    table_info.table_id_ = table_id;
+    table_info.dimension_ = dim;
+    table_info.metric_type_ = static_cast<int32_t>(angular ? milvus::engine::MetricType::IP
+                                                           : milvus::engine::MetricType::L2);
+    return table_info;
+}
+
+}  // namespace
+
+class DBBenchmarkTest : public DBTest {
+ protected:
+    void
+    BenchmarkDataset(const std::string& dataset, milvus::engine::EngineType engine_type);
+};
+
+void
+DBBenchmarkTest::BenchmarkDataset(const std::string& dataset, milvus::engine::EngineType engine_type) {
+    int64_t dim;
+    bool angular;
+    ASSERT_TRUE(ParseDatasetName(dataset, dim, angular));
+
+    std::string file_name = dataset + HDF5_POSTFIX;
+    std::vector<float> base, queries;
+    std::vector<int> neighbors;
+    size_t base_rows, query_rows, gt_rows, base_dim, query_dim, gt_k;
+    if (!ReadHDF5(file_name, HDF5_DATASET_TRAIN, H5T_NATIVE_FLOAT, base, base_rows, base_dim)) {
+        std::cout << "Skip dataset " << dataset << ", " << file_name << " is not found" << std::endl;
+        return;
+    }
+    ASSERT_TRUE(ReadHDF5(file_name, HDF5_DATASET_TEST, H5T_NATIVE_FLOAT, queries, query_rows, query_dim));
+    ASSERT_TRUE(ReadHDF5(file_name, HDF5_DATASET_NEIGHBORS, H5T_NATIVE_INT, neighbors, gt_rows, gt_k));
+    ASSERT_EQ(base_dim, static_cast<size_t>(dim));
+    ASSERT_EQ(query_dim, static_cast<size_t>(dim));
+    ASSERT_EQ(gt_rows, query_rows);
+    int64_t rows = base_rows;
+    if (angular) {
+        Normalize(base, dim);
+        Normalize(queries, dim);
+    }
+
+    milvus::json common;
+    common["dataset"] = dataset;
+    common["engine_type"] = static_cast<int32_t>(engine_type);
+    std::string table_prefix = dataset;
+    std::replace(table_prefix.begin(), table_prefix.end(), '-', '_');
+
+    // step 1: insert throughput with varying batch sizes
+    int64_t sample_rows = std::min<int64_t>(rows, INSERT_SAMPLE_ROWS);
+    for (auto batch_size : INSERT_BATCH_SIZES) {
+        auto table_info = BuildTableSchema(table_prefix + "_insert_" + std::to_string(batch_size), dim, angular);
+        ASSERT_TRUE(db_->CreateTable(table_info).ok());
+
+        auto start = Clock::now();
+        for (int64_t offset = 0; offset < sample_rows; offset += batch_size) {
+            milvus::engine::VectorsData vectors;
+            BuildVectors(base, dim, offset, std::min(batch_size, sample_rows - offset), vectors);
+            ASSERT_TRUE(db_->InsertVectors(table_info.table_id_, "", vectors).ok());
+        }
+        double seconds = SecondsFrom(start);
+
+        milvus::json record = common;
+        record["phase"] = "insert";
+        record["batch_size"] = batch_size;
+        record["rows"] = sample_rows;
+        record["seconds"] = seconds;
+        record["rows_per_second"] = sample_rows / seconds;
+        WriteResult(record);
+
+        db_->DropTable(table_info.table_id_, milvus::engine::meta::DatesT());
+    }
+
+    // step 2: load the whole base and flush it
+    auto table_info = BuildTableSchema(table_prefix, dim, angular);
+    ASSERT_TRUE(db_->CreateTable(table_info).ok());
+    auto start = Clock::now();
+    for (int64_t offset = 0; offset < rows; offset += LOAD_BATCH_SIZE) {
+        milvus::engine::VectorsData vectors;
+        BuildVectors(base, dim, offset, std::min(LOAD_BATCH_SIZE, rows - offset), vectors);
+        ASSERT_TRUE(db_->InsertVectors(table_info.table_id_, "", vectors).ok());
+    }
+    double insert_seconds = SecondsFrom(start);
+    start = Clock::now();
+    ASSERT_TRUE(db_->Flush({table_info.table_id_}).ok());
+    {
+        milvus::json record = common;
+        record["phase"] = "flush";
+        record["rows"] = rows;
+        record["insert_seconds"] = insert_seconds;
+        record["seconds"] = SecondsFrom(start);
+        WriteResult(record);
+    }
+
+    // step 3: build index, including the merge of flushed files it waits for
+    milvus::engine::TableIndex index;
+    index.engine_type_ = static_cast<int32_t>(engine_type);
+    index.nlist_ = NLIST;
+    index.metric_type_ = table_info.metric_type_;
+    start = Clock::now();
+    ASSERT_TRUE(db_->CreateIndex(table_info.table_id_, index).ok());
+    {
+        milvus::json record = common;
+        record["phase"] = "build_index";
+        record["nlist"] = NLIST;
+        record["seconds"] = SecondsFrom(start);
+        WriteResult(record);
+    }
+    ASSERT_TRUE(db_->PreloadTable(table_info.table_id_).ok());
+
+    // step 4: recall of each nprobe with all queries in one request
+    milvus::engine::VectorsData all_queries;
+    all_queries.vector_count_ = query_rows;
+    all_queries.float_data_ = queries;
+    int64_t search_nprobe = NPROBES.back();
+    for (auto nprobe : NPROBES) {
+        milvus::engine::ResultIds result_ids;
+        milvus::engine::ResultDistances result_distances;
+        start = Clock::now();
+        ASSERT_TRUE(db_->Query(dummy_context_, table_info.table_id_, {}, TOPK, nprobe, all_queries, result_ids,
+                               result_distances)
+                        .ok());
+        double seconds = SecondsFrom(start);
+        double recall = static_cast<double>(CountHits(neighbors, gt_k, 0, query_rows, result_ids)) /
+                        (query_rows * std::min<int64_t>(gt_k, TOPK));
+
+        milvus::json record = common;
+        record["phase"] = "recall";
+        record["nq"] = query_rows;
+        record["topk"] = TOPK;
+        record["nprobe"] = nprobe;
+        record["recall"] = recall;
+        record["seconds"] = seconds;
+        WriteResult(record);
+
+        if (recall >= TARGET_RECALL && search_nprobe == NPROBES.back()) {
+            search_nprobe = nprobe;
+        }
+    }
+
+    // step 5: qps and latency of single-query requests from concurrent clients at the recall
+    for (auto concurrency : CONCURRENCIES) {
+        std::vector<std::vector<double>> thread_latencies(concurrency);
+        std::vector<int64_t> thread_hits(concurrency, 0);
+        std::vector<std::thread> threads;
+        start = Clock::now();
+        for (int64_t t = 0; t < concurrency; t++) {
+            threads.emplace_back([&, t]() {
+                for (int64_t i = 0; i < QUERIES_PER_THREAD; i++) {
+                    int64_t query = (t * QUERIES_PER_THREAD + i) % query_rows;
+                    milvus::engine::VectorsData vectors;
+                    vectors.vector_count_ = 1;
+                    vectors.float_data_.assign(queries.begin() + query * dim, queries.begin() + (query + 1) * dim);
+
+                    milvus::engine::ResultIds result_ids;
+                    milvus::engine::ResultDistances result_distances;
+                    auto query_start = Clock::now();
+                    db_->Query(dummy_context_, table_info.table_id_, {}, TOPK, search_nprobe, vectors, result_ids,
+                               result_distances);
+                    thread_latencies[t].push_back(SecondsFrom(query_start) * 1000);
+                    thread_hits[t] += CountHits(neighbors, gt_k, query, 1, result_ids);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double seconds = SecondsFrom(start);
+
+        std::vector<double> latencies;
+        int64_t hits = 0;
+        for (int64_t t = 0; t < concurrency; t++) {
+            latencies.insert(latencies.end(), thread_latencies[t].begin(), thread_latencies[t].end());
+            hits += thread_hits[t];
+        }
+
+        milvus::json record = common;
+        record["phase"] = "search";
+        record["topk"] = TOPK;
+        record["nprobe"] = search_nprobe;
+        record["concurrency"] = concurrency;
+        record["queries"] = latencies.size();
+        record["recall"] = static_cast<double>(hits) / (latencies.size() * std::min<int64_t>(gt_k, TOPK));
+        record["qps"] = latencies.size() / seconds;
+        record["p50_ms"] = Percentile(latencies, 0.5);
+        record["p99_ms"] = Percentile(latencies, 0.99);
+        WriteResult(record);
+    }
+
+    db_->DropTable(table_info.table_id_, milvus::engine::meta::DatesT());
+}
+
+/*****************************************************************************************
+ * Dataset     Dimension   Base        Query       Metric
+ * SIFT        128         1,000,000   10,000      Euclidean
+ * Deep        96          9,990,000   10,000      Angular
+ * GIST        960         1,000,000   1,000       Euclidean
+ *****************************************************************************************/
+
+TEST_F(DBBenchmarkTest, BENCHMARK) {
+    H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+
+    BenchmarkDataset("sift-128-euclidean", milvus::engine::EngineType::FAISS_IVFSQ8);
+    BenchmarkDataset("deep-image-96-angular", milvus::engine::EngineType::FAISS_IVFSQ8);
+    BenchmarkDataset("gist-960-euclidean", milvus::engine::EngineType::FAISS_IVFSQ8);
+}
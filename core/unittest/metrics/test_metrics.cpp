@@ -165,6 +165,9 @@ TEST_F(MetricTest, COLLECTOR_METRICS_TEST) {
     milvus::server::CollectSearchTaskMetrics search_metrics_index(milvus::engine::meta::TableFileSchema::TO_INDEX);
     milvus::server::CollectSearchTaskMetrics search_metrics_delete(milvus::engine::meta::TableFileSchema::TO_DELETE);
 
+    milvus::server::CollectSearchPhaseMetrics phase_metrics("meta", "table_1", 0);
+    phase_metrics.SetIndexType(1);
+
     milvus::server::MetricCollector metric_collector();
 }
 
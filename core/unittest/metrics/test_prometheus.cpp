@@ -39,6 +39,21 @@ TEST(PrometheusTest, PROMETHEUS_TEST) {
     instance.FaissDiskLoadSizeBytesHistogramObserve(1.0);
     instance.FaissDiskLoadIOSpeedGaugeSet(1.0);
     instance.CacheAccessTotalIncrement();
+    instance.CacheHitTotalIncrement("cpu", "table_1");
+    instance.CacheMissTotalIncrement("cpu", "table_1");
+    instance.CacheLoadBytesTotalIncrement("cpu", "table_1", 1.0);
+    instance.CacheLoadDurationHistogramObserve("cpu", 1.0);
+    instance.CacheEvictTotalIncrement("cpu", "table_1", 1.0);
+    instance.SearchPhaseDurationHistogramObserve("kernel", "table_1", "1", 1.0);
+    instance.QueryResourceUsageIncrement("table_1", "cpu_time_us", 1.0);
+    instance.SearchRecallHistogramObserve("table_1", "1", 0.9);
+    instance.InsertBufferBytesGaugeSet("table_1", 1024.0);
+    instance.FlushDurationHistogramObserve("table_1", 1.0);
+    instance.PendingFilesGaugeSet("table_1", "to_index", 1.0);
+    instance.BuildIndexWaitHistogramObserve(1.0);
+    instance.GpuKernelTimeIncrement("gpu0", 1.0);
+    instance.GpuTransferIncrement("gpu0", 1024.0, 1.0);
+    instance.GpuTempMemoryOverflowGaugeSet("gpu0", 1024.0);
     instance.MemTableMergeDurationSecondsHistogramObserve(1.0);
     instance.SearchIndexDataDurationSecondsHistogramObserve(1.0);
     instance.SearchRawDataDurationSecondsHistogramObserve(1.0);
@@ -11,6 +11,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "scheduler/job/Job.h"
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
@@ -41,5 +46,158 @@ TEST(JobTest, TestJob) {
     search_ptr->AddIndexFile(nullptr);
 }
 
+TEST(JobTest, SearchJobDeadline) {
+    engine::VectorsData vectors;
+    auto context = std::make_shared<server::Context>("dummy_request_id");
+    auto search_ptr = std::make_shared<SearchJob>(context, 1, 1, vectors);
+    ASSERT_FALSE(search_ptr->IsCancelled());
+
+    auto file = std::make_shared<engine::meta::TableFileSchema>();
+    file->id_ = 1;
+    ASSERT_TRUE(search_ptr->AddIndexFile(file));
+
+    context->SetDeadline(std::chrono::system_clock::now() - std::chrono::seconds(1));
+    ASSERT_TRUE(context->IsExpired());
+    ASSERT_TRUE(search_ptr->IsCancelled());
+
+    search_ptr->AddResult(ResultIds(1, 0), ResultDistances(1, 0.0), 1, true);
+    search_ptr->SearchDone(file->id_);
+    search_ptr->WaitResult();
+    ASSERT_EQ(search_ptr->GetStatus().code(), SERVER_DEADLINE_EXCEEDED);
+    ASSERT_TRUE(search_ptr->GetResultIds().empty());
+}
+
+TEST(JobTest, SearchJobCancel) {
+    engine::VectorsData vectors;
+    auto context = std::make_shared<server::Context>("dummy_request_id");
+    auto search_ptr = std::make_shared<SearchJob>(context, 1, 1, vectors);
+
+    auto file = std::make_shared<engine::meta::TableFileSchema>();
+    file->id_ = 1;
+    ASSERT_TRUE(search_ptr->AddIndexFile(file));
+
+    context->Cancel();
+    ASSERT_TRUE(context->IsCancelled());
+    ASSERT_FALSE(context->IsExpired());
+    ASSERT_TRUE(search_ptr->IsCancelled());
+
+    search_ptr->AddResult(ResultIds(1, 0), ResultDistances(1, 0.0), 1, true);
+    search_ptr->SearchDone(file->id_);
+    search_ptr->WaitResult();
+    ASSERT_EQ(search_ptr->GetStatus().code(), SERVER_REQUEST_CANCELLED);
+    ASSERT_TRUE(search_ptr->GetResultIds().empty());
+}
+
+TEST(JobTest, SearchJobPrefetch) {
+    engine::VectorsData vectors;
+    auto search_ptr = std::make_shared<SearchJob>(nullptr, 1, 1, vectors);
+    for (size_t id = 0; id < 5; ++id) {
+        auto file = std::make_shared<engine::meta::TableFileSchema>();
+        file->id_ = id;
+        search_ptr->AddPrefetchFile(file);
+    }
+
+    // the file being loaded is never read ahead
+    ASSERT_FALSE(search_ptr->ClaimPrefetchFile(0).valid());
+    auto files = search_ptr->TakePrefetchFiles(2);
+    ASSERT_EQ(files.size(), 2);
+    ASSERT_EQ(files[0].first->id_, 1);
+    ASSERT_EQ(files[1].first->id_, 2);
+
+    // depth is full until a file read ahead is claimed
+    ASSERT_TRUE(search_ptr->TakePrefetchFiles(2).empty());
+    auto future = search_ptr->ClaimPrefetchFile(1);
+    ASSERT_TRUE(future.valid());
+    files[0].second->set_value();
+    future.wait();
+
+    // claimed files are skipped
+    ASSERT_FALSE(search_ptr->ClaimPrefetchFile(3).valid());
+    files = search_ptr->TakePrefetchFiles(2);
+    ASSERT_EQ(files.size(), 1);
+    ASSERT_EQ(files[0].first->id_, 4);
+    ASSERT_TRUE(search_ptr->TakePrefetchFiles(10).empty());
+}
+
+TEST(JobTest, SearchJobCoarseAssignment) {
+    engine::VectorsData vectors;
+    auto search_ptr = std::make_shared<SearchJob>(nullptr, 1, 1, vectors);
+
+    int assign_count = 0;
+    auto assign = [&]() {
+        ++assign_count;
+        return std::make_shared<knowhere::CoarseAssignment>();
+    };
+    auto coarse = search_ptr->GetCoarseAssignment(1, assign);
+    ASSERT_NE(coarse, nullptr);
+    ASSERT_EQ(search_ptr->GetCoarseAssignment(1, assign), coarse);
+    ASSERT_EQ(assign_count, 1);
+
+    // another quantizer gets its own assignment
+    ASSERT_NE(search_ptr->GetCoarseAssignment(2, assign), coarse);
+    ASSERT_EQ(assign_count, 2);
+
+    // a file that can't assign doesn't stop the next one from trying
+    ASSERT_EQ(search_ptr->GetCoarseAssignment(3, []() { return engine::CoarseAssignmentPtr(); }), nullptr);
+    ASSERT_NE(search_ptr->GetCoarseAssignment(3, assign), nullptr);
+    ASSERT_EQ(assign_count, 3);
+}
+
+TEST(JobTest, SearchJobSplitFile) {
+    engine::VectorsData vectors;
+    vectors.vector_count_ = 1;
+    auto search_ptr = std::make_shared<SearchJob>(nullptr, 2, 1, vectors);
+
+    auto file = std::make_shared<engine::meta::TableFileSchema>();
+    file->id_ = 1;
+    ASSERT_TRUE(search_ptr->AddIndexFile(file));
+    search_ptr->SplitIndexFile(file->id_, 2);
+
+    // the file is done with its last part, the topk of the parts are merged
+    search_ptr->AddResult(ResultIds{1, 2}, ResultDistances{0.1f, 0.5f}, 2, true);
+    search_ptr->SearchDone(file->id_);
+    ASSERT_EQ(search_ptr->index_files().size(), 1);
+    search_ptr->AddResult(ResultIds{3, 4}, ResultDistances{0.2f, 0.3f}, 2, true);
+    search_ptr->SearchDone(file->id_);
+    ASSERT_TRUE(search_ptr->index_files().empty());
+
+    search_ptr->WaitResult();
+    ASSERT_EQ(search_ptr->GetResultIds(), ResultIds({1, 3}));
+}
+
+TEST(JobTest, SearchJobFoldResults) {
+    engine::VectorsData vectors;
+    vectors.vector_count_ = 1;
+    const size_t topk = 256, files = 40;
+    auto search_ptr = std::make_shared<SearchJob>(nullptr, topk, 1, vectors);
+
+    // results of a large topk are folded as they come, the reduce still gets the best of all of them
+    std::vector<std::pair<float, int64_t>> all;
+    for (size_t f = 0; f < files; ++f) {
+        auto file = std::make_shared<engine::meta::TableFileSchema>();
+        file->id_ = f;
+        ASSERT_TRUE(search_ptr->AddIndexFile(file));
+    }
+    for (size_t f = 0; f < files; ++f) {
+        ResultIds ids;
+        ResultDistances distances;
+        for (size_t j = 0; j < topk; ++j) {
+            ids.push_back(f * topk + j);
+            distances.push_back(static_cast<float>(j * files + (f * 7) % files));
+            all.emplace_back(distances.back(), ids.back());
+        }
+        search_ptr->AddResult(std::move(ids), std::move(distances), topk, true);
+        search_ptr->SearchDone(f);
+    }
+    search_ptr->WaitResult();
+
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(search_ptr->GetResultIds().size(), topk);
+    for (size_t j = 0; j < topk; ++j) {
+        ASSERT_EQ(search_ptr->GetResultDistances()[j], all[j].first);
+        ASSERT_EQ(search_ptr->GetResultIds()[j], all[j].second);
+    }
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -11,6 +11,7 @@
 #include <fiu-local.h>
 #include <fiu-control.h>
 #include <gtest/gtest.h>
+#include <set>
 
 #include "scheduler/task/BuildIndexTask.h"
 #include "scheduler/task/SearchTask.h"
@@ -23,6 +24,7 @@
 #include "scheduler/optimizer/FaissIVFSQ8HPass.h"
 #include "scheduler/optimizer/FaissIVFSQ8Pass.h"
 #include "scheduler/optimizer/FallbackPass.h"
+#include "scheduler/optimizer/SearchCostEstimator.h"
 
 namespace milvus {
 namespace scheduler {
@@ -89,7 +91,100 @@ TEST(OptimizerTest, TEST_OPTIMIZER) {
     fall_back_pass.Run(task);
 }
 
+class AffinityTestPass : public GpuSearchResHandler {
+ public:
+    explicit AffinityTestPass(const std::vector<int64_t>& gpus) {
+        search_gpus_ = gpus;
+    }
+
+    using GpuSearchResHandler::PickSearchGpu;
+};
+
+TEST(OptimizerTest, PICK_SEARCH_GPU_TEST) {
+    AffinityTestPass pass({0, 1, 2});
+    engine::meta::TableFileSchema file;
+    file.location_ = "/tmp/milvus_test/pick_search_gpu_not_cached";
+
+    // uncached file always goes to the same gpu, files are spread among gpus
+    std::set<int64_t> picked;
+    for (size_t id = 0; id < 6; ++id) {
+        file.id_ = id;
+        auto gpu_id = pass.PickSearchGpu(file);
+        ASSERT_EQ(gpu_id, pass.PickSearchGpu(file));
+        picked.insert(gpu_id);
+    }
+    ASSERT_EQ(picked.size(), 3);
+}
+
 #endif
 
+TEST(OptimizerTest, SEARCH_COST_ESTIMATOR_TEST) {
+    auto& estimator = SearchCostEstimator::GetInstance();
+    estimator.Reset();
+
+    engine::meta::TableFileSchema file;
+    file.row_count_ = 100000;
+    file.dimension_ = 128;
+    file.nlist_ = 1024;
+    file.file_size_ = 51200000;
+    file.location_ = "/tmp/milvus_test/search_cost_estimator";
+
+    // ivf indexes scan a part of the file, compressed codes are cheaper
+    file.engine_type_ = (int)engine::EngineType::FAISS_IDMAP;
+    double flat_workload = SearchCostEstimator::Workload(file, 10, 10, 16);
+    file.engine_type_ = (int)engine::EngineType::FAISS_IVFFLAT;
+    double ivf_workload = SearchCostEstimator::Workload(file, 10, 10, 16);
+    file.engine_type_ = (int)engine::EngineType::FAISS_IVFSQ8;
+    double sq8_workload = SearchCostEstimator::Workload(file, 10, 10, 16);
+    ASSERT_LT(ivf_workload, flat_workload);
+    ASSERT_LT(sq8_workload, ivf_workload);
+    ASSERT_LT(SearchCostEstimator::Workload(file, 1, 10, 16), sq8_workload);
+    ASSERT_LT(SearchCostEstimator::Workload(file, 10, 10, 16), SearchCostEstimator::Workload(file, 10, 10, 64));
+
+    // throughput is learned from executed tasks
+    ASSERT_DOUBLE_EQ(estimator.Throughput(ResourceType::CPU), CPU_THROUGHPUT_DEFAULT);
+    ASSERT_GT(estimator.Throughput(ResourceType::GPU), estimator.Throughput(ResourceType::CPU));
+    estimator.Feedback(ResourceType::CPU, 1e6, 10);
+    ASSERT_DOUBLE_EQ(estimator.Throughput(ResourceType::CPU), 1e5);
+    estimator.Feedback(ResourceType::CPU, 1e6, 5);
+    ASSERT_GT(estimator.Throughput(ResourceType::CPU), 1e5);
+    ASSERT_LT(estimator.Throughput(ResourceType::CPU), 2e5);
+    estimator.Feedback(ResourceType::CPU, 0, 5);
+    ASSERT_LT(estimator.Throughput(ResourceType::CPU), 2e5);
+
+    // idle resource, file not cached: load from disk then search
+    auto cpu = std::make_shared<CpuResource>("cpu", 0, true);
+    double finish = estimator.FinishTime(cpu, file, 10, 10, 16);
+    double expect = file.file_size_ / DISK_BANDWIDTH + sq8_workload / estimator.Throughput(ResourceType::CPU);
+    ASSERT_DOUBLE_EQ(finish, expect);
+
+    // disk bandwidth is learned from files read
+    ASSERT_DOUBLE_EQ(estimator.DiskBandwidth(), DISK_BANDWIDTH);
+    estimator.DiskFeedback(DISK_BANDWIDTH * 100, 50);
+    ASSERT_GT(estimator.DiskBandwidth(), DISK_BANDWIDTH);
+    ASSERT_LT(estimator.FinishTime(cpu, file, 10, 10, 16), finish);
+
+    // queries searched on a file make it hot, they fade out with time
+    ASSERT_DOUBLE_EQ(estimator.Hotness(1), 0);
+    estimator.SearchFeedback(1, 10);
+    estimator.SearchFeedback(1, 10);
+    estimator.SearchFeedback(2, 1);
+    ASSERT_GT(estimator.Hotness(1), 19.9);
+    ASSERT_LE(estimator.Hotness(1), 20);
+    ASSERT_GT(estimator.Hotness(1), estimator.Hotness(2));
+
+    // once 65536 files are tracked the coldest one makes room for a new file
+    for (size_t id = 3; id <= 65536; id++) {
+        estimator.SearchFeedback(id, 2);
+    }
+    estimator.SearchFeedback(65537, 2);
+    ASSERT_DOUBLE_EQ(estimator.Hotness(2), 0);
+    ASSERT_GT(estimator.Hotness(1), 19.9);
+    ASSERT_GT(estimator.Hotness(65537), 1.9);
+
+    estimator.Reset();
+    ASSERT_DOUBLE_EQ(estimator.Hotness(1), 0);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -10,8 +10,13 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <omp.h>
 
+#include <thread>
+
+#include "scheduler/OmpBudget.h"
 #include "scheduler/ResourceFactory.h"
+#include "scheduler/Utils.h"
 #include "scheduler/resource/CpuResource.h"
 #include "scheduler/resource/DiskResource.h"
 #include "scheduler/resource/GpuResource.h"
@@ -20,6 +25,7 @@
 #include "scheduler/task/Task.h"
 #include "scheduler/task/TestTask.h"
 #include "scheduler/tasklabel/SpecResLabel.h"
+#include "server/Config.h"
 
 namespace milvus {
 namespace scheduler {
@@ -239,6 +245,13 @@ TEST_F(ResourceAdvanceTest, GPU_RESOURCE_TEST) {
     for (uint64_t i = 0; i < NUM; ++i) {
         ASSERT_EQ(tasks[i]->exec_count_, 1);
     }
+
+#ifdef MILVUS_GPU_VERSION
+    // a task executes on each stream
+    int64_t stream_num = 1;
+    ASSERT_TRUE(server::Config::GetInstance().GetGpuResourceConfigStreamNum(stream_num).ok());
+    ASSERT_EQ(gpu_resource_->NumOfExecutors(), stream_num);
+#endif
 }
 
 TEST_F(ResourceAdvanceTest, TEST_RESOURCE_TEST) {
@@ -283,5 +296,59 @@ TEST(Connection_Test, CONNECTION_TEST) {
     std::cout << connection.Dump() << std::endl;
 }
 
+TEST(NumaTest, BIND_THREAD_TEST) {
+    ASSERT_FALSE(bind_current_thread({}));
+
+    // hosts without numa report no node
+    auto nodes = get_numa_nodes();
+    for (auto& cpus : nodes) {
+        std::cout << "numa node with " << cpus.size() << " cpus" << std::endl;
+    }
+    if (!nodes.empty()) {
+        std::thread thread([&nodes] { ASSERT_TRUE(bind_current_thread(nodes[0])); });
+        thread.join();
+    }
+}
+
+TEST(OmpBudgetTest, SHARE_TEST) {
+    auto& budget = OmpBudget::GetInstance();
+    budget.SetThreads(8);
+    omp_set_num_threads(16);
+    {
+        OmpBudget::Share first;
+        ASSERT_EQ(first.Threads(), 8);
+        {
+            // a task started later gets what the running tasks leave, at least one thread
+            OmpBudget::Share second;
+            ASSERT_EQ(second.Threads(), 1);
+            ASSERT_EQ(omp_get_max_threads(), 1);
+            ASSERT_EQ(budget.NumOfTasks(), 2);
+        }
+        ASSERT_EQ(omp_get_max_threads(), 8);
+    }
+    ASSERT_EQ(omp_get_max_threads(), 16);
+    ASSERT_EQ(budget.NumOfTasks(), 0);
+
+    // shares of tasks running together never add up to more than the budget
+    omp_set_num_threads(3);
+    {
+        OmpBudget::Share first;
+        ASSERT_EQ(first.Threads(), 3);
+        omp_set_num_threads(16);
+        OmpBudget::Share second;
+        ASSERT_EQ(second.Threads(), 4);
+        OmpBudget::Share third;
+        ASSERT_EQ(third.Threads(), 1);
+    }
+
+    // never more than the thread had
+    omp_set_num_threads(2);
+    {
+        OmpBudget::Share share;
+        ASSERT_EQ(share.Threads(), 2);
+    }
+    budget.SetThreads(0);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -17,6 +17,7 @@
 #include "scheduler/resource/GpuResource.h"
 #include "scheduler/resource/TestResource.h"
 #include "scheduler/task/TestTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
 
 namespace milvus {
 namespace scheduler {
@@ -203,5 +204,41 @@ TEST_F(ResourceMgrAdvanceTest, REGISTER_SUBSCRIBER) {
     ASSERT_TRUE(flag);
 }
 
+TEST_F(ResourceMgrAdvanceTest, ADD_REMOVE_RUNNING) {
+    // resources join and leave a running graph
+    auto gpu = mgr1_->Add(std::make_shared<GpuResource>("gpu0", 0, true)).lock();
+    auto pcie = Connection("pcie", 12000);
+    ASSERT_TRUE(mgr1_->Connect("cpu", "gpu0", pcie));
+    ASSERT_EQ(mgr1_->GetNumGpuResource(), 1);
+    ASSERT_EQ(cpu_res->GetNeighbours().size(), 1);
+
+    mgr1_->Add(std::make_shared<CpuResource>("cpu", 1, true));
+    ASSERT_EQ(mgr1_->GetNumOfResource(), 3);
+
+    // tasks already on the resource are finished before it leaves
+    TableFileSchemaPtr dummy = nullptr;
+    auto label = std::make_shared<SpecResLabel>(gpu);
+    auto task = std::make_shared<TestTask>(std::make_shared<server::Context>("dummy_request_id"), dummy, label);
+    std::vector<std::string> path{"gpu0"};
+    task->path() = Path(path, 0);
+    gpu->task_table().Put(task);
+    gpu->WakeupLoader();
+    while (task->load_count_ == 0) {
+        usleep(1000);
+    }
+    gpu->WakeupExecutor();
+    ASSERT_TRUE(mgr1_->Remove("gpu0"));
+    ASSERT_EQ(task->exec_count_, 1);
+
+    ASSERT_EQ(mgr1_->GetResource("gpu0"), nullptr);
+    ASSERT_EQ(mgr1_->GetNumGpuResource(), 0);
+    ASSERT_TRUE(mgr1_->GetGpuResources().empty());
+    ASSERT_TRUE(cpu_res->GetNeighbours().empty());
+
+    ASSERT_FALSE(mgr1_->Remove("gpu0"));
+    ASSERT_FALSE(mgr1_->Remove("cpu"));
+    ASSERT_EQ(mgr1_->GetNumOfResource(), 2);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
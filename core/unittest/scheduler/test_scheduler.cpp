@@ -18,6 +18,7 @@
 #include "cache/GpuCacheMgr.h"
 #include "scheduler/ResourceFactory.h"
 #include "scheduler/Scheduler.h"
+#include "scheduler/event/TaskTableUpdatedEvent.h"
 #include "scheduler/resource/Resource.h"
 #include "scheduler/task/TestTask.h"
 #include "scheduler/tasklabel/SpecResLabel.h"
@@ -255,6 +256,25 @@ TEST_F(SchedulerTest, schedule) {
     scheduler_->Dump();
 }
 
+TEST(SchedulerEventTest, MERGE_WAKEUP_EVENTS) {
+    auto res_mgr = std::make_shared<ResourceMgr>();
+    auto cpu = res_mgr->Add(ResourceFactory::Create("cpu", "CPU", 0, true)).lock();
+    auto scheduler = std::make_shared<Scheduler>(res_mgr);
+
+    // events posted before start are handled in one batch, the loader of cpu is woken once
+    const uint64_t NUM = 100;
+    for (uint64_t i = 0; i < NUM; ++i) {
+        scheduler->PostEvent(std::make_shared<TaskTableUpdatedEvent>(cpu));
+    }
+    scheduler->Start();
+    scheduler->Stop();
+
+    auto dump = scheduler->Dump();
+    ASSERT_EQ(dump["event_count"].get<uint64_t>(), NUM);
+    ASSERT_EQ(dump["merged_event_count"].get<uint64_t>(), NUM - 1);
+    ASSERT_EQ(dump["batch_count"].get<uint64_t>(), 1);
+}
+
 TEST(SchedulerService, service) {
     fiu_enable("load_simple_config_mock", 1, nullptr, 0);
     StartSchedulerService();
@@ -18,6 +18,8 @@
 
 #include "db/meta/SqliteMetaImpl.h"
 #include "db/DBFactory.h"
+#include "scheduler/ResultBufferPool.h"
+#include "scheduler/TaskCreator.h"
 #include "scheduler/tasklabel/BroadcastLabel.h"
 #include "scheduler/task/BuildIndexTask.h"
 #include "scheduler/task/SearchTask.h"
@@ -88,19 +90,26 @@ TEST(TaskTest, TEST_TASK) {
     fiu_disable("XBuildIndexTask.Load.out_of_memory");
 
     build_index_task.Execute();
+
+    // the index file is written by the serialize stage of BuildMgr after Execute returns
+    auto execute_and_wait = [&]() {
+        build_index_job->AddToIndexFiles(file);
+        build_index_task.Execute();
+        build_index_job->WaitBuildIndexFinish();
+    };
+
     // always enable 'create_table_success'
     fiu_enable("XBuildIndexTask.Execute.create_table_success", 1, NULL, 0);
     build_index_task.to_index_engine_ =
         EngineFactory::Build(file->dimension_, file->location_, (EngineType)file->engine_type_,
                              (MetricType)file->metric_type_, file->nlist_);
-
-    build_index_task.Execute();
+    execute_and_wait();
 
     fiu_enable("XBuildIndexTask.Execute.build_index_fail", 1, NULL, 0);
     build_index_task.to_index_engine_ =
         EngineFactory::Build(file->dimension_, file->location_, (EngineType)file->engine_type_,
                              (MetricType)file->metric_type_, file->nlist_);
-    build_index_task.Execute();
+    execute_and_wait();
     fiu_disable("XBuildIndexTask.Execute.build_index_fail");
 
     // always enable 'has_table'
@@ -108,13 +117,13 @@ TEST(TaskTest, TEST_TASK) {
     build_index_task.to_index_engine_ =
         EngineFactory::Build(file->dimension_, file->location_, (EngineType)file->engine_type_,
                              (MetricType)file->metric_type_, file->nlist_);
-    build_index_task.Execute();
+    execute_and_wait();
 
     fiu_enable("XBuildIndexTask.Execute.throw_std_exception", 1, NULL, 0);
     build_index_task.to_index_engine_ =
         EngineFactory::Build(file->dimension_, file->location_, (EngineType)file->engine_type_,
                              (MetricType)file->metric_type_, file->nlist_);
-    build_index_task.Execute();
+    execute_and_wait();
     fiu_disable("XBuildIndexTask.Execute.throw_std_exception");
 
     // always enable 'save_index_file_success'
@@ -122,13 +131,13 @@ TEST(TaskTest, TEST_TASK) {
     build_index_task.to_index_engine_ =
         EngineFactory::Build(file->dimension_, file->location_, (EngineType)file->engine_type_,
                              (MetricType)file->metric_type_, file->nlist_);
-    build_index_task.Execute();
+    execute_and_wait();
 
     fiu_enable("XBuildIndexTask.Execute.update_table_file_fail", 1, NULL, 0);
     build_index_task.to_index_engine_ =
         EngineFactory::Build(file->dimension_, file->location_, (EngineType)file->engine_type_,
                              (MetricType)file->metric_type_, file->nlist_);
-    build_index_task.Execute();
+    execute_and_wait();
     fiu_disable("XBuildIndexTask.Execute.update_table_file_fail");
 
     fiu_disable("XBuildIndexTask.Execute.throw_std_exception");
@@ -180,6 +189,55 @@ TEST(TaskTest, TEST_TASK) {
     XSearchTask::MergeTopkToResultSet(ids, distances, 1, 1, 1, true, tar_ids, tar_distances);
 }
 
+#ifdef MILVUS_GPU_VERSION
+TEST(TaskTest, RAW_BATCH) {
+    auto dummy_context = std::make_shared<milvus::server::Context>("dummy_request_id");
+    engine::VectorsData vectors;
+    vectors.vector_count_ = 10;
+    vectors.float_data_.resize(10 * 16);
+    auto job = std::make_shared<SearchJob>(dummy_context, 10, 10, vectors);
+
+    const size_t raw_count = 5;
+    for (size_t i = 0; i < raw_count + 1; ++i) {
+        auto file = std::make_shared<TableFileSchema>();
+        file->id_ = i;
+        file->row_count_ = 100;
+        file->file_type_ = (i < raw_count) ? TableFileSchema::RAW : TableFileSchema::INDEX;
+        job->AddIndexFile(file);
+    }
+
+    server::Config& config = server::Config::GetInstance();
+    ASSERT_TRUE(config.SetGpuResourceConfigEnable("true").ok());
+    ASSERT_TRUE(config.SetEngineConfigGpuSearchThreshold("1").ok());
+    ASSERT_TRUE(config.SetGpuResourceConfigSearchResources("gpu0").ok());
+
+    // one task per file by default
+    auto tasks = TaskCreator::Create(job);
+    ASSERT_EQ(tasks.size(), raw_count + 1);
+
+    // raw files are packed up to the row number, the index file is searched alone
+    ASSERT_TRUE(config.SetGpuResourceConfigRawBatchRowNum("300").ok());
+    tasks = TaskCreator::Create(job);
+    ASSERT_EQ(tasks.size(), 3);
+    size_t file_count = 0;
+    for (auto& task : tasks) {
+        auto search_task = std::static_pointer_cast<XSearchTask>(task);
+        ASSERT_LE(search_task->batch_files_.size(), 2);
+        if (!search_task->batch_files_.empty()) {
+            ASSERT_EQ(search_task->file_->file_type_, TableFileSchema::RAW);
+        }
+        file_count += search_task->batch_files_.size() + 1;
+    }
+    ASSERT_EQ(file_count, raw_count + 1);
+
+    // small queries stay on cpu, where files are searched one by one
+    ASSERT_TRUE(config.SetEngineConfigGpuSearchThreshold("100").ok());
+    tasks = TaskCreator::Create(job);
+    ASSERT_EQ(tasks.size(), raw_count + 1);
+    ASSERT_TRUE(config.SetGpuResourceConfigRawBatchRowNum("0").ok());
+}
+#endif
+
 TEST(TaskTest, TEST_PATH) {
     Path path;
     auto empty_path = path.Current();
@@ -190,5 +248,84 @@ TEST(TaskTest, TEST_PATH) {
     ASSERT_TRUE(empty_path.empty());
 }
 
+TEST(TaskTest, UNSAMPLED_CONTEXT) {
+    opentracing::mocktracer::MockTracerOptions tracer_options;
+    auto mock_tracer =
+        std::shared_ptr<opentracing::Tracer>{new opentracing::mocktracer::MockTracer{std::move(tracer_options)}};
+
+    auto sampled_span = mock_tracer->StartSpan("sampled_span");
+    auto sampled_context = std::make_shared<milvus::server::Context>("sampled_request_id");
+    sampled_context->SetTraceContext(std::make_shared<milvus::tracing::TraceContext>(sampled_span));
+    ASSERT_TRUE(sampled_context->IsTraced());
+    auto child = sampled_context->Child("child");
+    ASSERT_NE(child->GetTraceContext(), sampled_context->GetTraceContext());
+
+    // contexts derived from an unsampled one share its span
+    auto unsampled_span = mock_tracer->StartSpan("unsampled_span");
+    auto unsampled_context = std::make_shared<milvus::server::Context>("unsampled_request_id");
+    unsampled_context->SetTraceContext(std::make_shared<milvus::tracing::TraceContext>(unsampled_span, false));
+    ASSERT_FALSE(unsampled_context->IsTraced());
+    child = unsampled_context->Child("child");
+    ASSERT_EQ(child->GetTraceContext(), unsampled_context->GetTraceContext());
+    auto follower = child->Follower("follower");
+    ASSERT_EQ(follower->GetTraceContext(), unsampled_context->GetTraceContext());
+    follower->GetTraceContext()->GetSpan()->Finish();
+}
+
+TEST(TaskTest, QUERY_COST) {
+    opentracing::mocktracer::MockTracerOptions tracer_options;
+    auto mock_tracer =
+        std::shared_ptr<opentracing::Tracer>{new opentracing::mocktracer::MockTracer{std::move(tracer_options)}};
+    auto context = std::make_shared<milvus::server::Context>("request_id");
+    context->SetTraceContext(std::make_shared<milvus::tracing::TraceContext>(mock_tracer->StartSpan("span")));
+
+    // child and follower contexts account into the cost of the call
+    auto child = context->Child("child");
+    child->GetQueryCost()->segments_searched_ += 2;
+    auto follower = child->Follower("follower");
+    follower->GetQueryCost()->bytes_loaded_ += 1024;
+    ASSERT_EQ(context->GetQueryCost()->segments_searched_, 2);
+    ASSERT_EQ(context->GetQueryCost()->bytes_loaded_, 1024);
+
+    // a detached context accounts into its own cost
+    auto detached = context->Child("detached");
+    detached->DetachQueryCost();
+    detached->GetQueryCost()->segments_searched_ += 3;
+    ASSERT_EQ(context->GetQueryCost()->segments_searched_, 2);
+    ASSERT_EQ(detached->GetQueryCost()->segments_searched_, 3);
+}
+
+TEST(TaskTest, RESULT_BUFFER_POOL) {
+    auto& pool = ResultBufferPool::GetInstance();
+    ResultIds ids;
+    ResultDistances distances;
+    pool.Acquire(1000, ids, distances);
+    ASSERT_EQ(ids.size(), 1000);
+    ASSERT_EQ(distances.size(), 1000);
+
+    // storage released is handed to the next acquire that fits
+    auto data = ids.data();
+    size_t pooled = pool.PooledBytes();
+    pool.Release(std::move(ids), std::move(distances));
+    ASSERT_GT(pool.PooledBytes(), pooled);
+
+    ResultIds reused_ids;
+    ResultDistances reused_distances;
+    pool.Acquire(500, reused_ids, reused_distances);
+    ASSERT_EQ(reused_ids.data(), data);
+    ASSERT_EQ(reused_ids.size(), 500);
+    ASSERT_EQ(pool.PooledBytes(), pooled);
+
+    // merging into pooled buffers gives the same result
+    ResultIds src_ids = {1, 3, 5, 2, 4, 6};
+    ResultDistances src_distances = {0.1, 0.3, 0.5, 0.2, 0.4, 0.6};
+    ResultIds tar_ids = {7, 8};
+    ResultDistances tar_distances = {0.2, 0.1};
+    XSearchTask::MergeTopkToResultSet(src_ids, src_distances, 3, 2, 3, true, tar_ids, tar_distances);
+    ResultIds expect_ids = {1, 7, 3, 8, 2, 4};
+    ASSERT_EQ(tar_ids, expect_ids);
+    pool.Release(std::move(reused_ids), std::move(reused_distances));
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -11,6 +11,8 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include "scheduler/TaskTable.h"
 #include "scheduler/task/TestTask.h"
 
@@ -148,6 +150,21 @@ TEST_F(TaskTableItemTest, MOVED) {
     }
 }
 
+TEST_F(TaskTableItemTest, CANCEL) {
+    for (auto& item : items_) {
+        auto before_state = item->state;
+        auto ret = item->Cancel();
+        if (before_state == milvus::scheduler::TaskTableItemState::START) {
+            ASSERT_TRUE(ret);
+            ASSERT_EQ(item->state, milvus::scheduler::TaskTableItemState::EXECUTED);
+            ASSERT_TRUE(item->IsFinish());
+        } else {
+            ASSERT_FALSE(ret);
+            ASSERT_EQ(item->state, before_state);
+        }
+    }
+}
+
 /************ TaskTableBaseTest ************/
 
 class TaskTableBaseTest : public ::testing::Test {
@@ -255,6 +272,88 @@ TEST_F(TaskTableBaseTest, PICK_TO_LOAD_CACHE) {
     ASSERT_EQ(indexes[0] % empty_table_.capacity(), 2);
 }
 
+TEST_F(TaskTableBaseTest, PICK_TO_LOAD_CANCELLED) {
+    auto context = std::make_shared<milvus::server::Context>("dummy_request_id");
+    context->SetDeadline(std::chrono::system_clock::now() - std::chrono::seconds(1));
+    milvus::engine::VectorsData vectors;
+    auto job = std::make_shared<milvus::scheduler::SearchJob>(context, 1, 1, vectors);
+
+    milvus::scheduler::TableFileSchemaPtr dummy = nullptr;
+    auto cancelled_task = std::make_shared<milvus::scheduler::TestTask>(context, dummy, nullptr);
+    cancelled_task->job_ = job;
+    ASSERT_TRUE(cancelled_task->IsCancelled());
+    ASSERT_FALSE(task1_->IsCancelled());
+
+    empty_table_.Put(cancelled_task);
+    empty_table_.Put(cancelled_task);
+    empty_table_.Put(task1_);
+
+    // tasks of the cancelled job are dropped without loading
+    auto indexes = empty_table_.PickToLoad(1);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 2);
+    ASSERT_EQ(empty_table_[0]->state, milvus::scheduler::TaskTableItemState::EXECUTED);
+    ASSERT_EQ(empty_table_[1]->state, milvus::scheduler::TaskTableItemState::EXECUTED);
+}
+
+namespace {
+class PriorityTestJob : public milvus::scheduler::Job {
+ public:
+    explicit PriorityTestJob(milvus::scheduler::JobType type) : Job(type) {
+    }
+};
+}  // namespace
+
+TEST_F(TaskTableBaseTest, PICK_BY_PRIORITY) {
+    milvus::scheduler::TableFileSchemaPtr dummy = nullptr;
+    auto build_job = std::make_shared<PriorityTestJob>(milvus::scheduler::JobType::BUILD);
+    auto build_task = std::make_shared<milvus::scheduler::TestTask>(nullptr, dummy, nullptr);
+    build_task->job_ = build_job;
+    auto search_job = std::make_shared<PriorityTestJob>(milvus::scheduler::JobType::SEARCH);
+    auto search_task = std::make_shared<milvus::scheduler::TestTask>(nullptr, dummy, nullptr);
+    search_task->job_ = search_job;
+    ASSERT_EQ(build_task->Priority(), milvus::scheduler::JobPriority::LOW);
+    ASSERT_EQ(search_task->Priority(), milvus::scheduler::JobPriority::HIGH);
+    ASSERT_EQ(task1_->Priority(), milvus::scheduler::JobPriority::NORMAL);
+
+    empty_table_.Put(build_task);
+    empty_table_.Put(task1_);
+    empty_table_.Put(search_task);
+    empty_table_.Put(search_task);
+
+    // higher classes are picked first, FIFO within a class
+    auto indexes = empty_table_.PickToLoad(4);
+    ASSERT_EQ(indexes.size(), 4);
+    ASSERT_EQ(indexes[0], 2);
+    ASSERT_EQ(indexes[1], 3);
+    ASSERT_EQ(indexes[2], 1);
+    ASSERT_EQ(indexes[3], 0);
+
+    // a loaded task takes the slot reserved for higher classes, background tasks wait
+    ASSERT_TRUE(empty_table_.Load(2));
+    ASSERT_TRUE(empty_table_.Loaded(2));
+    indexes = empty_table_.PickToLoad(4);
+    ASSERT_EQ(indexes.size(), 2);
+    ASSERT_EQ(indexes[0], 3);
+    ASSERT_EQ(indexes[1], 1);
+
+    ASSERT_TRUE(empty_table_.Load(0));
+    ASSERT_TRUE(empty_table_.Loaded(0));
+    ASSERT_TRUE(empty_table_.Load(3));
+    ASSERT_TRUE(empty_table_.Loaded(3));
+    indexes = empty_table_.PickToExecute(3);
+    ASSERT_EQ(indexes.size(), 3);
+    ASSERT_EQ(indexes[0], 2);
+    ASSERT_EQ(indexes[1], 3);
+    ASSERT_EQ(indexes[2], 0);
+
+    ASSERT_TRUE(empty_table_.Execute(0));
+    ASSERT_EQ(empty_table_.NumOfExecuting(milvus::scheduler::JobPriority::LOW), 1);
+    ASSERT_EQ(empty_table_.NumOfExecuting(milvus::scheduler::JobPriority::HIGH), 0);
+    ASSERT_TRUE(empty_table_.Executed(0));
+    ASSERT_EQ(empty_table_.NumOfExecuting(milvus::scheduler::JobPriority::LOW), 0);
+}
+
 TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE) {
     const size_t NUM_TASKS = 10;
     for (size_t i = 0; i < NUM_TASKS; ++i) {
@@ -262,7 +361,8 @@ TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE) {
     }
     empty_table_[0]->state = milvus::scheduler::TaskTableItemState::MOVED;
     empty_table_[1]->state = milvus::scheduler::TaskTableItemState::EXECUTED;
-    empty_table_[2]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    empty_table_[2]->Load();
+    empty_table_[2]->Loaded();
 
     auto indexes = empty_table_.PickToExecute(1);
     ASSERT_EQ(indexes.size(), 1);
@@ -276,8 +376,10 @@ TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE_LIMIT) {
     }
     empty_table_[0]->state = milvus::scheduler::TaskTableItemState::MOVED;
     empty_table_[1]->state = milvus::scheduler::TaskTableItemState::EXECUTED;
-    empty_table_[2]->state = milvus::scheduler::TaskTableItemState::LOADED;
-    empty_table_[3]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    empty_table_[2]->Load();
+    empty_table_[2]->Loaded();
+    empty_table_[3]->Load();
+    empty_table_[3]->Loaded();
 
     auto indexes = empty_table_.PickToExecute(3);
     ASSERT_EQ(indexes.size(), 2);
@@ -292,7 +394,8 @@ TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE_CACHE) {
     }
     empty_table_[0]->state = milvus::scheduler::TaskTableItemState::MOVED;
     empty_table_[1]->state = milvus::scheduler::TaskTableItemState::EXECUTED;
-    empty_table_[2]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    empty_table_[2]->Load();
+    empty_table_[2]->Loaded();
 
     // first pick, non-cache
     auto indexes = empty_table_.PickToExecute(1);
@@ -307,6 +410,78 @@ TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE_CACHE) {
     ASSERT_EQ(indexes[0] % empty_table_.capacity(), 2);
 }
 
+TEST_F(TaskTableBaseTest, NUM_OF_STATE) {
+    const size_t NUM_TASKS = 10;
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+        empty_table_.Put(task1_);
+    }
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::START), NUM_TASKS);
+
+    empty_table_[0]->Load();
+    empty_table_[1]->Load();
+    empty_table_[1]->Loaded();
+    empty_table_[2]->Load();
+    empty_table_[2]->Loaded();
+    empty_table_[2]->Execute();
+    empty_table_[3]->Cancel();
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::START), NUM_TASKS - 4);
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::LOADING), 1);
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::LOADED), 1);
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::EXECUTING), 1);
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::EXECUTED), 0);
+    ASSERT_EQ(empty_table_.TaskToExecute(), 1);
+
+    // items left the state are not picked
+    auto indexes = empty_table_.PickToLoad(NUM_TASKS);
+    ASSERT_EQ(indexes.size(), NUM_TASKS - 4);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 4);
+    indexes = empty_table_.PickToExecute(NUM_TASKS);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 1);
+
+    empty_table_[2]->Executed();
+    empty_table_[1]->Move();
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::LOADED), 0);
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::EXECUTING), 0);
+    ASSERT_TRUE(empty_table_.PickToExecute(NUM_TASKS).empty());
+    ASSERT_FALSE(empty_table_.Dump().empty());
+}
+
+TEST_F(TaskTableBaseTest, WAIT_IDLE) {
+    empty_table_.WaitIdle();
+
+    empty_table_.Put(task1_);
+    empty_table_.Put(task2_);
+    empty_table_[0]->Load();
+    std::thread finisher([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        empty_table_[1]->Cancel();
+        empty_table_[0]->Loaded();
+        empty_table_[0]->Execute();
+        empty_table_[0]->Executed();
+    });
+    empty_table_.WaitIdle();
+    ASSERT_TRUE(empty_table_[0]->IsFinish());
+    ASSERT_TRUE(empty_table_[1]->IsFinish());
+    finisher.join();
+}
+
+TEST_F(TaskTableBaseTest, REUSE_SLOT) {
+    // finished items at front release their slots, the table never overflows
+    const size_t NUM_TASKS = empty_table_.capacity() + 10;
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+        empty_table_.Put(task1_);
+        auto indexes = empty_table_.PickToLoad(1);
+        ASSERT_EQ(indexes.size(), 1);
+        ASSERT_EQ(indexes[0], i);
+        ASSERT_TRUE(empty_table_.Load(indexes[0]));
+        ASSERT_TRUE(empty_table_.Loaded(indexes[0]));
+        ASSERT_TRUE(empty_table_.Execute(indexes[0]));
+        ASSERT_TRUE(empty_table_.Executed(indexes[0]));
+    }
+    ASSERT_EQ(empty_table_.NumOfState(milvus::scheduler::TaskTableItemState::START), 0);
+}
+
 /************ TaskTableAdvanceTest ************/
 
 class TaskTableAdvanceTest : public ::testing::Test {
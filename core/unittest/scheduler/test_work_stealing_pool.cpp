@@ -0,0 +1,91 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "scheduler/WorkStealingPool.h"
+
+namespace milvus {
+namespace scheduler {
+
+TEST(WorkStealingPoolTest, RUN_ALL_JOBS) {
+    std::atomic<uint64_t> init_count{0};
+    WorkStealingPool pool(4, [&] { ++init_count; });
+    ASSERT_EQ(pool.NumOfWorkers(), 4);
+
+    // jobs enqueued before start are kept
+    std::atomic<uint64_t> done{0};
+    for (uint64_t i = 0; i < 10; ++i) {
+        pool.Enqueue([&] { ++done; });
+    }
+    pool.Start();
+    for (uint64_t i = 0; i < 90; ++i) {
+        pool.Enqueue([&] { ++done; });
+    }
+    pool.Stop();
+    ASSERT_EQ(done, 100);
+    ASSERT_EQ(init_count, 4);
+    ASSERT_EQ(pool.NumOfPending(), 0);
+}
+
+TEST(WorkStealingPoolTest, STEAL) {
+    WorkStealingPool pool(4);
+    pool.Start();
+
+    // all jobs land in the deque of one worker, the others have to steal them
+    std::atomic<uint64_t> done{0};
+    pool.Enqueue([&] {
+        for (uint64_t i = 0; i < 20; ++i) {
+            pool.Enqueue([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                ++done;
+            });
+        }
+    });
+    pool.Stop();
+    ASSERT_EQ(done, 20);
+    ASSERT_GT(pool.NumOfStolen(), 0);
+}
+
+TEST(WorkStealingPoolTest, VACANCY) {
+    WorkStealingPool pool(2);
+    pool.Start();
+
+    std::atomic<bool> release{false};
+    for (uint64_t i = 0; i < 2; ++i) {
+        pool.Enqueue([&] {
+            while (!release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    ASSERT_EQ(pool.NumOfPending(), 2);
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        release = true;
+    });
+    pool.WaitForVacancy();
+    ASSERT_TRUE(release);
+    ASSERT_LT(pool.NumOfPending(), 2);
+    releaser.join();
+    pool.Stop();
+
+    // a stopped pool never blocks the caller
+    pool.WaitForVacancy();
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -16,7 +16,16 @@
 #include "wrapper/VecIndex.h"
 
 #include "cache/CpuCacheMgr.h"
+#include "cache/DiskCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
+#include "cache/GpuMemoryArbiter.h"
+#include "cache/ResultCacheMgr.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -107,6 +116,20 @@ class MockVecIndex : public milvus::engine::VecIndex {
     int64_t ntotal_ = 0;
 };
 
+class MockDataObj : public milvus::cache::DataObj {
+ public:
+    explicit MockDataObj(int64_t size) : size_(size) {
+    }
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+
+ private:
+    int64_t size_;
+};
+
 }  // namespace
 
 TEST(CacheTest, DUMMY_TEST) {
@@ -187,6 +210,44 @@ TEST(CacheTest, CPU_CACHE_TEST) {
 //    delete cpu_cache_mgr;
 }
 
+TEST(CacheTest, RESULT_CACHE_TEST) {
+    auto result_mgr = milvus::cache::ResultCacheMgr::GetInstance();
+    milvus::engine::ResultIds ids = {1, 2, 3};
+    milvus::engine::ResultDistances distances = {0.1, 0.2, 0.3};
+    milvus::engine::ResultIds out_ids;
+    milvus::engine::ResultDistances out_distances;
+
+    // disabled by default
+    result_mgr->SetCapacity(0);
+    ASSERT_FALSE(result_mgr->Enabled());
+    result_mgr->InsertResult("query_0", ids, distances);
+    ASSERT_FALSE(result_mgr->GetResult("query_0", out_ids, out_distances));
+
+    result_mgr->SetCapacity(1024);
+    ASSERT_TRUE(result_mgr->Enabled());
+    result_mgr->InsertResult("query_0", ids, distances);
+    ASSERT_TRUE(result_mgr->GetResult("query_0", out_ids, out_distances));
+    ASSERT_EQ(out_ids, ids);
+    ASSERT_EQ(out_distances, distances);
+    ASSERT_FALSE(result_mgr->GetResult("query_1", out_ids, out_distances));
+
+    // result larger than capacity is not cached
+    milvus::engine::ResultIds large_ids(1024, 0);
+    milvus::engine::ResultDistances large_distances(1024, 0.0);
+    result_mgr->InsertResult("query_large", large_ids, large_distances);
+    ASSERT_FALSE(result_mgr->GetResult("query_large", out_ids, out_distances));
+
+    // old results are evicted
+    for (int i = 0; i < 100; i++) {
+        result_mgr->InsertResult("query_" + std::to_string(i + 2), ids, distances);
+    }
+    ASSERT_FALSE(result_mgr->GetResult("query_0", out_ids, out_distances));
+    ASSERT_LE(result_mgr->CacheUsage(), result_mgr->CacheCapacity());
+
+    result_mgr->ClearCache();
+    result_mgr->SetCapacity(0);
+}
+
 #ifdef MILVUS_GPU_VERSION
 TEST(CacheTest, GPU_CACHE_TEST) {
     auto gpu_mgr = milvus::cache::GpuCacheMgr::GetInstance(0);
@@ -270,3 +331,340 @@ TEST(CacheTest, PARTIAL_LRU_TEST) {
 
     ASSERT_ANY_THROW(lru.get(-1));
 }
+
+TEST(CacheTest, SHARDED_CACHE_TEST) {
+    constexpr int64_t ITEM_SIZE = 100;
+    constexpr int64_t ITEM_COUNT = 64;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * ITEM_COUNT, 1UL << 32);
+
+    for (int64_t i = 0; i < ITEM_COUNT; ++i) {
+        cache.insert("item_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE));
+    }
+    ASSERT_EQ(cache.size(), ITEM_COUNT);
+    ASSERT_EQ(cache.usage(), ITEM_SIZE * ITEM_COUNT);
+
+    // least recently used items are freed first whichever shard they are in
+    ASSERT_NE(cache.get("item_0"), nullptr);
+    cache.insert("item_new", std::make_shared<MockDataObj>(ITEM_SIZE));
+    ASSERT_LE(cache.usage(), cache.capacity());
+    ASSERT_TRUE(cache.exists("item_0"));
+    ASSERT_TRUE(cache.exists("item_new"));
+    ASSERT_FALSE(cache.exists("item_1"));
+    ASSERT_TRUE(cache.exists("item_" + std::to_string(ITEM_COUNT - 1)));
+
+    // replace item
+    cache.insert("item_new", std::make_shared<MockDataObj>(ITEM_SIZE * 2));
+    int64_t usage = 0;
+    for (int64_t i = 0; i < ITEM_COUNT; ++i) {
+        auto item = cache.get("item_" + std::to_string(i));
+        usage += (item != nullptr) ? item->Size() : 0;
+    }
+    ASSERT_EQ(cache.usage(), usage + ITEM_SIZE * 2);
+    cache.erase("item_new");
+
+    // lookups and inserts from many threads
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int64_t i = 0; i < 1000; ++i) {
+                std::string key = "item_" + std::to_string((i * (t + 1)) % (ITEM_COUNT * 2));
+                if (cache.get(key) == nullptr) {
+                    cache.insert(key, std::make_shared<MockDataObj>(ITEM_SIZE));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_LE(cache.usage(), cache.capacity());
+    ASSERT_EQ(cache.usage(), ITEM_SIZE * (int64_t)cache.size());
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.usage(), 0);
+}
+
+TEST(CacheTest, TINY_LFU_TEST) {
+    constexpr int64_t ITEM_SIZE = 100;
+    constexpr int64_t ITEM_COUNT = 10;
+
+    auto search = [&](milvus::cache::Cache<milvus::cache::DataObjPtr>& cache, const std::string& key) {
+        if (cache.get(key) == nullptr) {
+            cache.insert(key, std::make_shared<MockDataObj>(ITEM_SIZE));
+        }
+    };
+
+    for (auto policy : {milvus::cache::CachePolicy::LRU, milvus::cache::CachePolicy::TINY_LFU}) {
+        milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * ITEM_COUNT, 1UL << 32);
+        cache.set_policy(policy);
+        ASSERT_EQ(cache.policy(), policy);
+
+        // hot items are searched again and again
+        for (int64_t round = 0; round < 3; ++round) {
+            for (int64_t i = 0; i < ITEM_COUNT / 2; ++i) {
+                search(cache, "hot_" + std::to_string(i));
+            }
+        }
+
+        // a scan of other items, each searched once
+        for (int64_t i = 0; i < ITEM_COUNT * 10; ++i) {
+            search(cache, "scan_" + std::to_string(i));
+        }
+        ASSERT_LE(cache.usage(), cache.capacity());
+
+        int64_t hot_count = 0;
+        for (int64_t i = 0; i < ITEM_COUNT / 2; ++i) {
+            hot_count += cache.exists("hot_" + std::to_string(i)) ? 1 : 0;
+        }
+        if (policy == milvus::cache::CachePolicy::LRU) {
+            ASSERT_EQ(hot_count, 0);
+        } else {
+            ASSERT_EQ(hot_count, ITEM_COUNT / 2);
+            // scan items still get the room left by hot items
+            ASSERT_TRUE(cache.exists("scan_0"));
+        }
+    }
+}
+
+TEST(CacheTest, TINY_LFU_PINNED_TEST) {
+    constexpr int64_t ITEM_SIZE = 100;
+    constexpr int64_t ITEM_COUNT = 10;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * ITEM_COUNT, 1UL << 32);
+    cache.set_policy(milvus::cache::CachePolicy::TINY_LFU);
+
+    for (int64_t i = 0; i < ITEM_COUNT; ++i) {
+        std::string key = "hot_" + std::to_string(i);
+        cache.insert(key, std::make_shared<MockDataObj>(ITEM_SIZE));
+        for (int64_t round = 0; round < 3; ++round) {
+            cache.get(key);
+        }
+    }
+
+    // a pinned item is admitted though it is accessed less often than the item it evicts
+    milvus::cache::CacheQuota pinned_quota;
+    pinned_quota.pinned = true;
+    pinned_quota.max = ITEM_SIZE;
+    cache.set_quota("pinned", pinned_quota);
+    cache.insert("pinned_0", std::make_shared<MockDataObj>(ITEM_SIZE), "pinned");
+    ASSERT_TRUE(cache.exists("pinned_0"));
+    ASSERT_LE(cache.usage(), cache.capacity());
+
+    // nor is it evicted by the max of its group
+    cache.insert("pinned_1", std::make_shared<MockDataObj>(ITEM_SIZE), "pinned");
+    ASSERT_TRUE(cache.exists("pinned_0"));
+    ASSERT_TRUE(cache.exists("pinned_1"));
+
+    // an unprotected item is still rejected
+    cache.insert("cold", std::make_shared<MockDataObj>(ITEM_SIZE));
+    ASSERT_FALSE(cache.exists("cold"));
+}
+
+TEST(CacheTest, COST_AWARE_EVICTION_TEST) {
+    constexpr int64_t ITEM_SIZE = 1000000;
+    constexpr int64_t ITEM_COUNT = 10;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * ITEM_COUNT, 1UL << 32);
+    cache.set_freemem_percent(0.5);
+
+    // a full cache frees the overflow and one more item, not all items down to the threshold
+    for (int64_t i = 0; i <= ITEM_COUNT; ++i) {
+        cache.insert("item_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE));
+    }
+    ASSERT_EQ(cache.size(), ITEM_COUNT - 1);
+    ASSERT_FALSE(cache.exists("item_0"));
+    ASSERT_FALSE(cache.exists("item_1"));
+    ASSERT_TRUE(cache.exists("item_2"));
+
+    // small items cost more to reload per byte, an older small item outlives a large one
+    cache.clear();
+    cache.set_reload_cost(10.0, 5.0e5);
+    cache.insert("small", std::make_shared<MockDataObj>(ITEM_SIZE / 100));
+    for (int64_t i = 0; i < ITEM_COUNT; ++i) {
+        cache.insert("item_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE - ITEM_SIZE / 100));
+    }
+    cache.insert("large", std::make_shared<MockDataObj>(ITEM_SIZE));
+    ASSERT_LE(cache.usage(), cache.capacity());
+    ASSERT_TRUE(cache.exists("small"));
+    ASSERT_FALSE(cache.exists("item_0"));
+    ASSERT_TRUE(cache.exists("large"));
+}
+
+TEST(CacheTest, HOT_KEYS_TEST) {
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(1000, 1UL << 32);
+    for (int64_t i = 0; i < 3; ++i) {
+        cache.insert("item_" + std::to_string(i), std::make_shared<MockDataObj>(100));
+    }
+    for (int64_t i = 0; i < 3; ++i) {
+        cache.get("item_2");
+    }
+    cache.get("item_1");
+
+    // hottest first, hits survive replacement of an item
+    cache.insert("item_2", std::make_shared<MockDataObj>(100));
+    auto hot_keys = cache.hot_keys();
+    ASSERT_EQ(hot_keys.size(), 3);
+    ASSERT_EQ(hot_keys[0].first, "item_2");
+    ASSERT_EQ(hot_keys[0].second, 3);
+    ASSERT_EQ(hot_keys[1].first, "item_1");
+    ASSERT_EQ(hot_keys[2].second, 0);
+}
+
+TEST(CacheTest, QUOTA_TEST) {
+    constexpr int64_t ITEM_SIZE = 100;
+    constexpr int64_t ITEM_COUNT = 10;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * ITEM_COUNT, 1UL << 32);
+    cache.set_freemem_percent(1.0);
+
+    // a pinned group and a group with reserved size survive a scan of other items
+    milvus::cache::CacheQuota pinned_quota;
+    pinned_quota.pinned = true;
+    cache.set_quota("pinned", pinned_quota);
+    milvus::cache::CacheQuota reserved_quota;
+    reserved_quota.reserved = ITEM_SIZE * 2;
+    cache.set_quota("reserved", reserved_quota);
+    for (int64_t i = 0; i < 2; ++i) {
+        cache.insert("pinned_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE), "pinned");
+        cache.insert("reserved_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE), "reserved");
+    }
+    cache.insert("reserved_2", std::make_shared<MockDataObj>(ITEM_SIZE), "reserved");
+    ASSERT_EQ(cache.group_usage("reserved"), ITEM_SIZE * 3);
+
+    for (int64_t i = 0; i < ITEM_COUNT * 2; ++i) {
+        cache.insert("scan_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE), "scan");
+    }
+    ASSERT_LE(cache.usage(), cache.capacity());
+    ASSERT_TRUE(cache.exists("pinned_0"));
+    ASSERT_TRUE(cache.exists("pinned_1"));
+    ASSERT_EQ(cache.group_usage("reserved"), ITEM_SIZE * 2);
+    ASSERT_FALSE(cache.exists("reserved_0"));
+    ASSERT_TRUE(cache.exists("reserved_2"));
+
+    // a group never takes more than its max, it evicts its own items
+    milvus::cache::CacheQuota max_quota;
+    max_quota.max = ITEM_SIZE * 3;
+    cache.set_quota("scan", max_quota);
+    ASSERT_LE(cache.group_usage("scan"), ITEM_SIZE * 3);
+    for (int64_t i = 0; i < ITEM_COUNT; ++i) {
+        cache.insert("max_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE), "scan");
+    }
+    ASSERT_EQ(cache.group_usage("scan"), ITEM_SIZE * 3);
+    ASSERT_TRUE(cache.exists("max_" + std::to_string(ITEM_COUNT - 1)));
+    cache.insert("too_large", std::make_shared<MockDataObj>(ITEM_SIZE * 4), "scan");
+    ASSERT_FALSE(cache.exists("too_large"));
+
+    // nothing else can be evicted, an unprotected new item is rejected
+    cache.remove_quota("scan");
+    pinned_quota.reserved = ITEM_SIZE * ITEM_COUNT;
+    cache.set_quota("scan", pinned_quota);
+    cache.insert("pinned_2", std::make_shared<MockDataObj>(ITEM_SIZE), "pinned");
+    cache.insert("pinned_3", std::make_shared<MockDataObj>(ITEM_SIZE), "pinned");
+    cache.insert("other", std::make_shared<MockDataObj>(ITEM_SIZE * 2));
+    ASSERT_FALSE(cache.exists("other"));
+
+    cache.clear();
+    ASSERT_EQ(cache.group_usage("pinned"), 0);
+}
+
+TEST(CacheTest, EVICT_CALLBACK_TEST) {
+    constexpr int64_t ITEM_SIZE = 100;
+    constexpr int64_t ITEM_COUNT = 10;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * ITEM_COUNT, 1UL << 32);
+    cache.set_freemem_percent(1.0);
+
+    std::vector<std::string> evicted;
+    int64_t evicted_size = 0;
+    cache.set_evict_callback([&](const std::string& key, const std::string& group, int64_t size) {
+        ASSERT_EQ(group, "table_1");
+        evicted.push_back(key);
+        evicted_size += size;
+    });
+
+    // items evicted to make room are reported with their group
+    for (int64_t i = 0; i < ITEM_COUNT + 2; ++i) {
+        cache.insert("item_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE), "table_1");
+    }
+    ASSERT_EQ(evicted.size(), 2);
+    ASSERT_EQ(evicted[0], "item_0");
+    ASSERT_EQ(evicted_size, ITEM_SIZE * 2);
+
+    // items erased explicitly are not
+    cache.erase("item_5");
+    ASSERT_EQ(evicted.size(), 2);
+}
+
+TEST(CacheTest, GPU_MEMORY_ARBITER_TEST) {
+    constexpr int64_t DEVICE = 100;
+    constexpr int64_t ITEM_SIZE = 1000;
+    auto& arbiter = milvus::cache::GpuMemoryArbiter::GetInstance();
+    LessItemCacheMgr cache_mgr;
+    arbiter.AddDevice(DEVICE, 10000, 2000, &cache_mgr);
+    for (int i = 0; i < 3; i++) {
+        cache_mgr.InsertItem("index_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE));
+    }
+    ASSERT_EQ(arbiter.Available(DEVICE), 10000 - 2000 - 3 * ITEM_SIZE);
+
+    // cached items are evicted to make room, the least recently used first
+    ASSERT_TRUE(arbiter.Reserve(DEVICE, 4000));
+    ASSERT_TRUE(arbiter.Reserve(DEVICE, 2500));
+    ASSERT_EQ(cache_mgr.ItemCount(), 1);
+    ASSERT_TRUE(cache_mgr.ItemExists("index_2"));
+    ASSERT_EQ(arbiter.Reserved(DEVICE), 6500);
+
+    // more than the device holds, or nothing left to evict
+    ASSERT_FALSE(arbiter.Reserve(DEVICE, 9000));
+    ASSERT_FALSE(arbiter.Reserve(DEVICE, 3000));
+    ASSERT_EQ(cache_mgr.ItemCount(), 0);
+
+    // a reservation waits for others to be released
+    std::thread releaser([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        arbiter.Release(DEVICE, 4000);
+    });
+    {
+        milvus::cache::GpuMemoryReservation reservation(DEVICE, 3000, 5000);
+        ASSERT_TRUE(reservation.ok());
+        ASSERT_EQ(arbiter.Reserved(DEVICE), 5500);
+    }
+    releaser.join();
+    ASSERT_EQ(arbiter.Reserved(DEVICE), 2500);
+    arbiter.Release(DEVICE, 2500);
+    ASSERT_EQ(arbiter.Available(DEVICE), 8000);
+
+    // the cache is cut to what the device leaves it
+    LessItemCacheMgr small_mgr;
+    arbiter.AddDevice(DEVICE + 1, 3000, 1000, &small_mgr);
+    ASSERT_EQ(small_mgr.CacheCapacity(), 2000);
+
+    // devices not added have no limit
+    arbiter.RemoveDevice(DEVICE);
+    arbiter.RemoveDevice(DEVICE + 1);
+    ASSERT_TRUE(arbiter.Reserve(DEVICE, 1L << 40));
+    ASSERT_EQ(arbiter.Available(DEVICE), -1);
+}
+
+TEST(CacheTest, DISK_CACHE_TEST) {
+    // disabled by default
+    ASSERT_FALSE(milvus::cache::DiskCacheMgr::GetInstance()->Enabled());
+    milvus::cache::DiskCacheMgr::GetInstance()->InsertFile("s3_file", "content");
+    ASSERT_EQ(milvus::cache::DiskCacheMgr::GetInstance()->GetFile("s3_file"), nullptr);
+
+    // a local copy is removed once evicted and no longer read
+    auto copy_exists = [](const std::string& path) { return std::ifstream(path).good(); };
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(10, 1UL << 32);
+    std::string path_0 = "/tmp/milvus_test_disk_cache_0";
+    std::string path_1 = "/tmp/milvus_test_disk_cache_1";
+    std::ofstream(path_0) << "content";
+    std::ofstream(path_1) << "content";
+
+    cache.insert("file_0", std::make_shared<milvus::cache::DiskFileObj>(path_0, 7));
+    auto reading = std::static_pointer_cast<milvus::cache::DiskFileObj>(cache.get("file_0"));
+    cache.insert("file_1", std::make_shared<milvus::cache::DiskFileObj>(path_1, 7));
+    ASSERT_FALSE(cache.exists("file_0"));
+    ASSERT_TRUE(copy_exists(path_0));
+    reading = nullptr;
+    ASSERT_FALSE(copy_exists(path_0));
+    ASSERT_TRUE(copy_exists(path_1));
+
+    cache.clear();
+    ASSERT_FALSE(copy_exists(path_1));
+}
@@ -21,6 +21,7 @@
 #include "server/Config.h"
 #include "server/utils.h"
 #include "utils/CommonUtil.h"
+#include "utils/LargeBuffer.h"
 #include "utils/StringHelpFunctions.h"
 #include "utils/ValidationUtil.h"
 
@@ -157,6 +158,54 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetServerConfigWebPort(str_val).ok());
     ASSERT_TRUE(str_val == web_port);
 
+    ASSERT_TRUE(config.SetServerConfigSearchWorkerNum("4").ok());
+    ASSERT_TRUE(config.GetServerConfigSearchWorkerNum(int64_val).ok());
+    ASSERT_EQ(int64_val, 4);
+    ASSERT_TRUE(config.SetServerConfigRequestQueueSize("256").ok());
+    ASSERT_TRUE(config.GetServerConfigRequestQueueSize(int64_val).ok());
+    ASSERT_EQ(int64_val, 256);
+    ASSERT_TRUE(config.SetServerConfigGrpcCompressionLevel("medium").ok());
+    ASSERT_TRUE(config.GetServerConfigGrpcCompressionLevel(str_val).ok());
+    ASSERT_EQ(str_val, "medium");
+    ASSERT_TRUE(config.SetServerConfigGrpcMaxMessageSize("512").ok());
+    ASSERT_TRUE(config.GetServerConfigGrpcMaxMessageSize(int64_val).ok());
+    ASSERT_EQ(int64_val, 512);
+    ASSERT_TRUE(config.SetServerConfigGrpcWindowSize("16").ok());
+    ASSERT_TRUE(config.GetServerConfigGrpcWindowSize(int64_val).ok());
+    ASSERT_EQ(int64_val, 16);
+    ASSERT_TRUE(config.SetServerConfigSlowQueryThreshold("500").ok());
+    ASSERT_TRUE(config.GetServerConfigSlowQueryThreshold(int64_val).ok());
+    ASSERT_EQ(int64_val, 500);
+    ASSERT_TRUE(config.SetServerConfigQueryCapturePath("/tmp/milvus_query_capture.bin").ok());
+    ASSERT_TRUE(config.GetServerConfigQueryCapturePath(str_val).ok());
+    ASSERT_TRUE(str_val == "/tmp/milvus_query_capture.bin");
+    ASSERT_TRUE(config.SetServerConfigQueryCapturePath("").ok());
+    ASSERT_TRUE(config.SetServerConfigQueryCaptureRate("0.01").ok());
+    ASSERT_TRUE(config.GetServerConfigQueryCaptureRate(float_val).ok());
+    ASSERT_FLOAT_EQ(float_val, 0.01);
+    ASSERT_TRUE(config.SetServerConfigProxyNodes("192.168.1.2:19530,192.168.1.3:19530").ok());
+    std::vector<std::string> proxy_nodes;
+    ASSERT_TRUE(config.GetServerConfigProxyNodes(proxy_nodes).ok());
+    ASSERT_EQ(proxy_nodes.size(), 2UL);
+    ASSERT_EQ(proxy_nodes[1], "192.168.1.3:19530");
+    ASSERT_TRUE(config.SetServerConfigProxyNodes("").ok());
+    ASSERT_TRUE(config.SetServerConfigReadonlyNodes("192.168.1.2,192.168.1.3").ok());
+    std::vector<std::string> readonly_nodes;
+    ASSERT_TRUE(config.GetServerConfigReadonlyNodes(readonly_nodes).ok());
+    ASSERT_EQ(readonly_nodes.size(), 2UL);
+    ASSERT_EQ(readonly_nodes[1], "192.168.1.3");
+    ASSERT_TRUE(config.SetServerConfigReadonlyNodes("").ok());
+    std::string node_ip;
+    ASSERT_TRUE(config.SetServerConfigNodeIp("192.168.1.2").ok());
+    ASSERT_TRUE(config.GetServerConfigNodeIp(node_ip).ok());
+    ASSERT_EQ(node_ip, "192.168.1.2");
+    ASSERT_TRUE(config.SetServerConfigNodeIp("").ok());
+    std::string writable_node;
+    ASSERT_TRUE(config.SetServerConfigWritableNode("192.168.1.1:19530").ok());
+    ASSERT_TRUE(config.GetServerConfigWritableNode(writable_node).ok());
+    ASSERT_EQ(writable_node, "192.168.1.1:19530");
+    ASSERT_TRUE(config.SetServerConfigWritableNode("").ok());
+
     std::string server_mode = "cluster_readonly";
     ASSERT_TRUE(config.SetServerConfigDeployMode(server_mode).ok());
     ASSERT_TRUE(config.GetServerConfigDeployMode(str_val).ok());
@@ -183,6 +232,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetDBConfigArchiveDaysThreshold(int64_val).ok());
     ASSERT_TRUE(int64_val == db_archive_days_threshold);
 
+    std::string db_archive_type = "compress";
+    ASSERT_TRUE(config.SetDBConfigArchiveType(db_archive_type).ok());
+    ASSERT_TRUE(config.GetDBConfigArchiveType(str_val).ok());
+    ASSERT_TRUE(str_val == db_archive_type);
+
     /* storage config */
     std::string storage_primary_path = "/home/zilliz";
     ASSERT_TRUE(config.SetStorageConfigPrimaryPath(storage_primary_path).ok());
@@ -224,6 +278,36 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetStorageConfigS3Bucket(str_val).ok());
     ASSERT_TRUE(str_val == storage_s3_bucket);
 
+    std::string storage_s3_cache_path = "/tmp/milvus_s3_cache";
+    ASSERT_TRUE(config.SetStorageConfigS3CachePath(storage_s3_cache_path).ok());
+    ASSERT_TRUE(config.GetStorageConfigS3CachePath(str_val).ok());
+    ASSERT_TRUE(str_val == storage_s3_cache_path);
+
+    int64_t storage_s3_cache_capacity = 10;
+    ASSERT_TRUE(config.SetStorageConfigS3CacheCapacity(std::to_string(storage_s3_cache_capacity)).ok());
+    ASSERT_TRUE(config.GetStorageConfigS3CacheCapacity(int64_val).ok());
+    ASSERT_TRUE(int64_val == storage_s3_cache_capacity);
+
+    bool storage_file_compress_enable = true;
+    ASSERT_TRUE(config.SetStorageConfigFileCompressEnable(std::to_string(storage_file_compress_enable)).ok());
+    ASSERT_TRUE(config.GetStorageConfigFileCompressEnable(bool_val).ok());
+    ASSERT_TRUE(bool_val == storage_file_compress_enable);
+
+    bool storage_direct_io_enable = true;
+    ASSERT_TRUE(config.SetStorageConfigDirectIOEnable(std::to_string(storage_direct_io_enable)).ok());
+    ASSERT_TRUE(config.GetStorageConfigDirectIOEnable(bool_val).ok());
+    ASSERT_TRUE(bool_val == storage_direct_io_enable);
+
+    int64_t storage_background_io_rate = 100;
+    ASSERT_TRUE(config.SetStorageConfigBackgroundIORate(std::to_string(storage_background_io_rate)).ok());
+    ASSERT_TRUE(config.GetStorageConfigBackgroundIORate(int64_val).ok());
+    ASSERT_TRUE(int64_val == storage_background_io_rate);
+
+    std::string storage_export_path = "/tmp/milvus_export";
+    ASSERT_TRUE(config.SetStorageConfigExportPath(storage_export_path).ok());
+    ASSERT_TRUE(config.GetStorageConfigExportPath(str_val).ok());
+    ASSERT_TRUE(str_val == storage_export_path);
+
     /* metric config */
     bool metric_enable_monitor = false;
     ASSERT_TRUE(config.SetMetricConfigEnableMonitor(std::to_string(metric_enable_monitor)).ok());
@@ -261,6 +345,32 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetCacheConfigCacheInsertData(bool_val).ok());
     ASSERT_TRUE(bool_val == cache_insert_data);
 
+    int64_t cache_result_cache_capacity = 64;
+    ASSERT_TRUE(config.SetCacheConfigResultCacheCapacity(std::to_string(cache_result_cache_capacity)).ok());
+    ASSERT_TRUE(config.GetCacheConfigResultCacheCapacity(int64_val).ok());
+    ASSERT_TRUE(int64_val == cache_result_cache_capacity);
+
+    std::string cache_cpu_cache_policy = "tinylfu";
+    ASSERT_TRUE(config.SetCacheConfigCpuCachePolicy(cache_cpu_cache_policy).ok());
+    ASSERT_TRUE(config.GetCacheConfigCpuCachePolicy(str_val).ok());
+    ASSERT_TRUE(str_val == cache_cpu_cache_policy);
+    ASSERT_TRUE(config.SetCacheConfigCpuCachePolicy("lru").ok());
+
+    int64_t cache_list_cache_capacity = 256;
+    ASSERT_TRUE(config.SetCacheConfigListCacheCapacity(std::to_string(cache_list_cache_capacity)).ok());
+    ASSERT_TRUE(config.GetCacheConfigListCacheCapacity(int64_val).ok());
+    ASSERT_TRUE(int64_val == cache_list_cache_capacity);
+    ASSERT_TRUE(config.SetCacheConfigListCacheCapacity("0").ok());
+
+    std::string cache_cpu_cache_huge_page = "hugetlb";
+    ASSERT_TRUE(config.SetCacheConfigCpuCacheHugePage(cache_cpu_cache_huge_page).ok());
+    ASSERT_TRUE(config.GetCacheConfigCpuCacheHugePage(str_val).ok());
+    ASSERT_TRUE(str_val == cache_cpu_cache_huge_page);
+    ASSERT_EQ(milvus::GetHugePageMode(), milvus::HugePageMode::HUGETLB);
+    ASSERT_TRUE(config.SetCacheConfigCpuCacheHugePage("off").ok());
+    ASSERT_EQ(milvus::GetHugePageMode(), milvus::HugePageMode::OFF);
+    ASSERT_TRUE(config.SetCacheConfigCpuCacheHugePage("thp").ok());
+
     /* engine config */
     int64_t engine_use_blas_threshold = 50;
     ASSERT_TRUE(config.SetEngineConfigUseBlasThreshold(std::to_string(engine_use_blas_threshold)).ok());
@@ -272,6 +382,63 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetEngineConfigOmpThreadNum(int64_val).ok());
     ASSERT_TRUE(int64_val == engine_omp_thread_num);
 
+    int64_t engine_reduce_thread_num = 1;
+    ASSERT_TRUE(config.SetEngineConfigReduceThreadNum(std::to_string(engine_reduce_thread_num)).ok());
+    ASSERT_TRUE(config.GetEngineConfigReduceThreadNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_reduce_thread_num);
+
+    int64_t engine_search_latency_budget = 100;
+    ASSERT_TRUE(config.SetEngineConfigSearchLatencyBudget(std::to_string(engine_search_latency_budget)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchLatencyBudget(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_latency_budget);
+    ASSERT_TRUE(config.SetEngineConfigSearchLatencyBudget("0").ok());
+
+    int64_t engine_cpu_executor_num = 1;
+    ASSERT_TRUE(config.SetEngineConfigCpuExecutorNum(std::to_string(engine_cpu_executor_num)).ok());
+    ASSERT_TRUE(config.GetEngineConfigCpuExecutorNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_cpu_executor_num);
+
+    int64_t engine_search_prefetch_depth = 4;
+    ASSERT_TRUE(config.SetEngineConfigSearchPrefetchDepth(std::to_string(engine_search_prefetch_depth)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchPrefetchDepth(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_prefetch_depth);
+    ASSERT_TRUE(config.SetEngineConfigSearchPrefetchDepth("0").ok());
+
+    int64_t engine_preload_thread_num = 8;
+    ASSERT_TRUE(config.SetEngineConfigPreloadThreadNum(std::to_string(engine_preload_thread_num)).ok());
+    ASSERT_TRUE(config.GetEngineConfigPreloadThreadNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_preload_thread_num);
+
+    float engine_train_sample_ratio = 0.25;
+    ASSERT_TRUE(config.SetEngineConfigTrainSampleRatio(std::to_string(engine_train_sample_ratio)).ok());
+    ASSERT_TRUE(config.GetEngineConfigTrainSampleRatio(float_val).ok());
+    ASSERT_TRUE(float_val == engine_train_sample_ratio);
+    ASSERT_TRUE(config.SetEngineConfigTrainSampleRatio("1.0").ok());
+
+    bool engine_reuse_trained_model = true;
+    ASSERT_TRUE(config.SetEngineConfigReuseTrainedModel(std::to_string(engine_reuse_trained_model)).ok());
+    ASSERT_TRUE(config.GetEngineConfigReuseTrainedModel(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_reuse_trained_model);
+    ASSERT_TRUE(config.SetEngineConfigReuseTrainedModel("false").ok());
+
+    bool engine_quantizer_rotation = true;
+    ASSERT_TRUE(config.SetEngineConfigQuantizerRotation(std::to_string(engine_quantizer_rotation)).ok());
+    ASSERT_TRUE(config.GetEngineConfigQuantizerRotation(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_quantizer_rotation);
+    ASSERT_TRUE(config.SetEngineConfigQuantizerRotation("false").ok());
+
+    bool engine_numa_enable = true;
+    ASSERT_TRUE(config.SetEngineConfigNumaEnable(std::to_string(engine_numa_enable)).ok());
+    ASSERT_TRUE(config.GetEngineConfigNumaEnable(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_numa_enable);
+    ASSERT_TRUE(config.SetEngineConfigNumaEnable("false").ok());
+
+    float engine_recall_sample_rate = 0.5;
+    ASSERT_TRUE(config.SetEngineConfigRecallSampleRate(std::to_string(engine_recall_sample_rate)).ok());
+    ASSERT_TRUE(config.GetEngineConfigRecallSampleRate(float_val).ok());
+    ASSERT_TRUE(float_val == engine_recall_sample_rate);
+    ASSERT_TRUE(config.SetEngineConfigRecallSampleRate("0").ok());
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold = 800;
     ASSERT_TRUE(config.SetEngineConfigGpuSearchThreshold(std::to_string(engine_gpu_search_threshold)).ok());
@@ -296,6 +463,12 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetGpuResourceConfigCacheThreshold(float_val).ok());
     ASSERT_TRUE(float_val == gpu_cache_threshold);
 
+    std::string gpu_cache_policy = "tinylfu";
+    ASSERT_TRUE(config.SetGpuResourceConfigCachePolicy(gpu_cache_policy).ok());
+    ASSERT_TRUE(config.GetGpuResourceConfigCachePolicy(str_val).ok());
+    ASSERT_TRUE(str_val == gpu_cache_policy);
+    ASSERT_TRUE(config.SetGpuResourceConfigCachePolicy("lru").ok());
+
     std::vector<std::string> search_resources = {"gpu0"};
     std::vector<int64_t> search_res_vec;
     std::string search_res_str;
@@ -317,7 +490,54 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     for (size_t i = 0; i < build_index_resources.size(); i++) {
         ASSERT_TRUE(std::stoll(build_index_resources[i].substr(3)) == build_index_res_vec[i]);
     }
+
+    bool cost_based_placement = true;
+    ASSERT_TRUE(config.SetGpuResourceConfigCostBasedPlacement(std::to_string(cost_based_placement)).ok());
+    ASSERT_TRUE(config.GetGpuResourceConfigCostBasedPlacement(bool_val).ok());
+    ASSERT_TRUE(bool_val == cost_based_placement);
+    ASSERT_TRUE(config.SetGpuResourceConfigCostBasedPlacement("false").ok());
+
+    int64_t shard_row_threshold = 10000000;
+    ASSERT_TRUE(config.SetGpuResourceConfigShardRowThreshold(std::to_string(shard_row_threshold)).ok());
+    ASSERT_TRUE(config.GetGpuResourceConfigShardRowThreshold(int64_val).ok());
+    ASSERT_TRUE(int64_val == shard_row_threshold);
+    ASSERT_TRUE(config.SetGpuResourceConfigShardRowThreshold("0").ok());
+
+    int64_t parallel_build_row_threshold = 5000000;
+    ASSERT_TRUE(
+        config.SetGpuResourceConfigParallelBuildRowThreshold(std::to_string(parallel_build_row_threshold)).ok());
+    ASSERT_TRUE(config.GetGpuResourceConfigParallelBuildRowThreshold(int64_val).ok());
+    ASSERT_TRUE(int64_val == parallel_build_row_threshold);
+    ASSERT_TRUE(config.SetGpuResourceConfigParallelBuildRowThreshold("0").ok());
+
+    int64_t raw_batch_row_num = 1000000;
+    ASSERT_TRUE(config.SetGpuResourceConfigRawBatchRowNum(std::to_string(raw_batch_row_num)).ok());
+    ASSERT_TRUE(config.GetGpuResourceConfigRawBatchRowNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == raw_batch_row_num);
+    ASSERT_TRUE(config.SetGpuResourceConfigRawBatchRowNum("0").ok());
+
+    int64_t stream_num = 4;
+    ASSERT_TRUE(config.SetGpuResourceConfigStreamNum(std::to_string(stream_num)).ok());
+    ASSERT_TRUE(config.GetGpuResourceConfigStreamNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == stream_num);
 #endif
+
+    /* wal config */
+    bool wal_enable = false;
+    ASSERT_TRUE(config.SetWalConfigEnable(std::to_string(wal_enable)).ok());
+    ASSERT_TRUE(config.GetWalConfigEnable(bool_val).ok());
+    ASSERT_TRUE(bool_val == wal_enable);
+
+    std::string wal_path = "/tmp/wal";
+    ASSERT_TRUE(config.SetWalConfigWalPath(wal_path).ok());
+    ASSERT_TRUE(config.GetWalConfigWalPath(str_val).ok());
+    ASSERT_TRUE(str_val == wal_path);
+
+    /* tracing config */
+    float tracing_sample_rate = 0.01;
+    ASSERT_TRUE(config.SetTracingConfigSampleRate(std::to_string(tracing_sample_rate)).ok());
+    ASSERT_TRUE(config.GetTracingConfigSampleRate(float_val).ok());
+    ASSERT_TRUE(float_val == tracing_sample_rate);
 }
 
 std::string
@@ -519,6 +739,27 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetServerConfigWebPort("99999").ok());
     ASSERT_FALSE(config.SetServerConfigWebPort("-1").ok());
 
+    ASSERT_FALSE(config.SetServerConfigSearchWorkerNum("0").ok());
+    ASSERT_FALSE(config.SetServerConfigInsertWorkerNum("a").ok());
+    ASSERT_FALSE(config.SetServerConfigDDLWorkerNum("65").ok());
+    ASSERT_FALSE(config.SetServerConfigRequestQueueSize("-1").ok());
+    ASSERT_FALSE(config.SetServerConfigGrpcCompressionLevel("gzip").ok());
+    ASSERT_FALSE(config.SetServerConfigGrpcMaxMessageSize("2048").ok());
+    ASSERT_FALSE(config.SetServerConfigGrpcWindowSize("-1").ok());
+    ASSERT_FALSE(config.SetServerConfigSlowQueryThreshold("-1").ok());
+    ASSERT_FALSE(config.SetServerConfigSlowQueryThreshold("1.5").ok());
+    ASSERT_FALSE(config.SetServerConfigQueryCapturePath("capture.bin").ok());
+    ASSERT_FALSE(config.SetServerConfigQueryCaptureRate("1.5").ok());
+    ASSERT_FALSE(config.SetServerConfigQueryCaptureRate("abc").ok());
+    ASSERT_FALSE(config.SetServerConfigProxyNodes("192.168.1.2").ok());
+    ASSERT_FALSE(config.SetServerConfigProxyNodes("192.168.1.2:abc").ok());
+    ASSERT_FALSE(config.SetServerConfigProxyNodes("192.168.1.2:19530,").ok());
+    ASSERT_FALSE(config.SetServerConfigReadonlyNodes("192.168.1.2:19530").ok());
+    ASSERT_FALSE(config.SetServerConfigReadonlyNodes("192.168.1.2,abc").ok());
+    ASSERT_FALSE(config.SetServerConfigNodeIp("abc").ok());
+    ASSERT_FALSE(config.SetServerConfigWritableNode("192.168.1.1").ok());
+    ASSERT_FALSE(config.SetServerConfigWritableNode("192.168.1.1:abc").ok());
+
     ASSERT_FALSE(config.SetServerConfigDeployMode("cluster").ok());
 
     ASSERT_FALSE(config.SetServerConfigTimeZone("GM").ok());
@@ -534,6 +775,8 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetDBConfigArchiveDaysThreshold("0x10").ok());
 
+    ASSERT_FALSE(config.SetDBConfigArchiveType("swap").ok());
+
     /* storage config */
     ASSERT_FALSE(config.SetStorageConfigPrimaryPath("").ok());
 
@@ -552,6 +795,16 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetStorageConfigS3Bucket("").ok());
 
+    ASSERT_FALSE(config.SetStorageConfigS3CachePath("tmp/s3_cache").ok());
+    ASSERT_FALSE(config.SetStorageConfigS3CacheCapacity("-1").ok());
+    ASSERT_FALSE(config.SetStorageConfigS3CacheCapacity("a").ok());
+
+    ASSERT_FALSE(config.SetStorageConfigFileCompressEnable("10").ok());
+    ASSERT_FALSE(config.SetStorageConfigDirectIOEnable("10").ok());
+    ASSERT_FALSE(config.SetStorageConfigBackgroundIORate("-1").ok());
+    ASSERT_FALSE(config.SetStorageConfigBackgroundIORate("9223372036854775807").ok());
+    ASSERT_FALSE(config.SetStorageConfigExportPath("tmp/export").ok());
+
     /* metric config */
     ASSERT_FALSE(config.SetMetricConfigEnableMonitor("Y").ok());
 
@@ -574,6 +827,20 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("2048").ok());
     ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("-1").ok());
 
+    ASSERT_FALSE(config.SetCacheConfigResultCacheCapacity("a").ok());
+    ASSERT_FALSE(config.SetCacheConfigResultCacheCapacity("-1").ok());
+    ASSERT_FALSE(config.SetCacheConfigResultCacheCapacity("100000000").ok());
+
+    ASSERT_FALSE(config.SetCacheConfigCpuCachePolicy("lfu").ok());
+    ASSERT_FALSE(config.SetCacheConfigCpuCachePolicy("LRU").ok());
+
+    ASSERT_FALSE(config.SetCacheConfigListCacheCapacity("a").ok());
+    ASSERT_FALSE(config.SetCacheConfigListCacheCapacity("-1").ok());
+    ASSERT_FALSE(config.SetCacheConfigListCacheCapacity("100000000").ok());
+
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheHugePage("on").ok());
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheHugePage("THP").ok());
+
     ASSERT_FALSE(config.SetCacheConfigCacheInsertData("N").ok());
 
     /* engine config */
@@ -583,6 +850,39 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetEngineConfigOmpThreadNum("10000").ok());
     ASSERT_FALSE(config.SetEngineConfigOmpThreadNum("-10").ok());
 
+    ASSERT_FALSE(config.SetEngineConfigReduceThreadNum("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigReduceThreadNum("10000").ok());
+    ASSERT_FALSE(config.SetEngineConfigReduceThreadNum("-10").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigSearchLatencyBudget("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchLatencyBudget("-10").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigCpuExecutorNum("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigCpuExecutorNum("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigCpuExecutorNum("10000").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigSearchPrefetchDepth("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchPrefetchDepth("-1").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchPrefetchDepth("65").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigPreloadThreadNum("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigPreloadThreadNum("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigPreloadThreadNum("65").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigTrainSampleRatio("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigTrainSampleRatio("0.0").ok());
+    ASSERT_FALSE(config.SetEngineConfigTrainSampleRatio("1.1").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigReuseTrainedModel("ok").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigQuantizerRotation("ok").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigNumaEnable("ok").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigRecallSampleRate("-0.1").ok());
+    ASSERT_FALSE(config.SetEngineConfigRecallSampleRate("1.5").ok());
+    ASSERT_FALSE(config.SetEngineConfigRecallSampleRate("abc").ok());
+
 #ifdef MILVUS_GPU_VERSION
     ASSERT_FALSE(config.SetEngineConfigGpuSearchThreshold("-1").ok());
 #endif
@@ -599,13 +899,35 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetGpuResourceConfigCacheThreshold("1.0").ok());
     ASSERT_FALSE(config.SetGpuResourceConfigCacheThreshold("-0.1").ok());
 
+    ASSERT_FALSE(config.SetGpuResourceConfigCachePolicy("arc").ok());
+
     ASSERT_FALSE(config.SetGpuResourceConfigSearchResources("gpu10").ok());
     ASSERT_FALSE(config.SetGpuResourceConfigSearchResources("gpu0, gpu0").ok());
 
     ASSERT_FALSE(config.SetGpuResourceConfigBuildIndexResources("gup2").ok());
     ASSERT_FALSE(config.SetGpuResourceConfigBuildIndexResources("gpu16").ok());
     ASSERT_FALSE(config.SetGpuResourceConfigBuildIndexResources("gpu0, gpu0, gpu1").ok());
+
+    ASSERT_FALSE(config.SetGpuResourceConfigCostBasedPlacement("ok").ok());
+    ASSERT_FALSE(config.SetGpuResourceConfigShardRowThreshold("a").ok());
+    ASSERT_FALSE(config.SetGpuResourceConfigShardRowThreshold("-1").ok());
+    ASSERT_FALSE(config.SetGpuResourceConfigParallelBuildRowThreshold("a").ok());
+    ASSERT_FALSE(config.SetGpuResourceConfigParallelBuildRowThreshold("-1").ok());
+    ASSERT_FALSE(config.SetGpuResourceConfigRawBatchRowNum("a").ok());
+    ASSERT_FALSE(config.SetGpuResourceConfigRawBatchRowNum("-1").ok());
+
+    ASSERT_FALSE(config.SetGpuResourceConfigStreamNum("a").ok());
+    ASSERT_FALSE(config.SetGpuResourceConfigStreamNum("0").ok());
+    ASSERT_FALSE(config.SetGpuResourceConfigStreamNum("17").ok());
 #endif
+
+    /* wal config */
+    ASSERT_FALSE(config.SetWalConfigEnable("ok").ok());
+
+    /* tracing config */
+    ASSERT_FALSE(config.SetTracingConfigSampleRate("a").ok());
+    ASSERT_FALSE(config.SetTracingConfigSampleRate("-0.1").ok());
+    ASSERT_FALSE(config.SetTracingConfigSampleRate("1.5").ok());
 }
 
 TEST_F(ConfigTest, SERVER_CONFIG_TEST) {
@@ -1065,3 +1387,54 @@ TEST_F(ConfigTest, SERVER_CONFIG_UPDATE_TEST) {
     ASSERT_EQ(value, 2);
 #endif
 }
+
+TEST_F(ConfigTest, SERVER_CONFIG_CACHED_VALUE_TEST) {
+    std::string conf_file = std::string(CONFIG_PATH) + VALID_CONFIG_FILE;
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+
+    auto status = config.LoadConfigFile(conf_file);
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    // values kept parsed follow every set of their keys
+    int64_t value;
+    ASSERT_TRUE(config.SetEngineConfigReduceThreadNum("2").ok());
+    ASSERT_TRUE(config.GetEngineConfigReduceThreadNum(value).ok());
+    ASSERT_EQ(value, 2);
+    ASSERT_TRUE(config.SetEngineConfigReduceThreadNum("3").ok());
+    ASSERT_TRUE(config.GetEngineConfigReduceThreadNum(value).ok());
+    ASSERT_EQ(value, 3);
+
+    std::string result;
+    auto set_cmd = gen_set_command(ms::CONFIG_ENGINE, ms::CONFIG_ENGINE_REDUCE_THREAD_NUM, "4");
+    ASSERT_TRUE(config.ProcessConfigCli(result, set_cmd).ok());
+    ASSERT_TRUE(config.GetEngineConfigReduceThreadNum(value).ok());
+    ASSERT_EQ(value, 4);
+
+    // a failed set keeps the value
+    ASSERT_FALSE(config.SetEngineConfigReduceThreadNum("-1").ok());
+    ASSERT_TRUE(config.GetEngineConfigReduceThreadNum(value).ok());
+    ASSERT_EQ(value, 4);
+
+    // openmp threads are handed to whoever applies them at once
+    int64_t applied = 0;
+    milvus::server::ConfigCallBackF lambda = [&](const std::string& value) -> milvus::Status {
+        applied = std::stoll(value);
+        return milvus::Status::OK();
+    };
+    ASSERT_TRUE(config.RegisterCallBack(ms::CONFIG_ENGINE, ms::CONFIG_ENGINE_OMP_THREAD_NUM, "test", lambda).ok());
+    ASSERT_TRUE(config.SetEngineConfigOmpThreadNum("2").ok());
+    ASSERT_EQ(applied, 2);
+    ASSERT_TRUE(config.GetEngineConfigOmpThreadNum(value).ok());
+    ASSERT_EQ(value, 2);
+    config.CancelCallBack(ms::CONFIG_ENGINE, ms::CONFIG_ENGINE_OMP_THREAD_NUM, "test");
+
+    // a snapshot is taken until any key is set
+    ASSERT_TRUE(config.SetEngineConfigTrainSampleRatio("0.5").ok());
+    auto snapshot = config.GetSnapshot();
+    ASSERT_FLOAT_EQ(snapshot->train_sample_ratio_, 0.5);
+    ASSERT_EQ(config.GetSnapshot(), snapshot);
+    ASSERT_TRUE(config.SetEngineConfigTrainSampleRatio("0.8").ok());
+    ASSERT_NE(config.GetSnapshot(), snapshot);
+    ASSERT_FLOAT_EQ(config.GetSnapshot()->train_sample_ratio_, 0.8);
+    ASSERT_FLOAT_EQ(snapshot->train_sample_ratio_, 0.5);
+}
@@ -13,12 +13,19 @@
 #include <opentracing/mocktracer/tracer.h>
 
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "server/Server.h"
 #include "server/grpc_impl/GrpcRequestHandler.h"
 #include "server/delivery/RequestScheduler.h"
 #include "server/delivery/request/BaseRequest.h"
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "server/delivery/request/SearchRequest.h"
 #include "server/delivery/RequestHandler.h"
 #include "src/version.h"
 
@@ -29,7 +36,9 @@
 #include "server/Config.h"
 #include "server/DBWrapper.h"
 #include "utils/CommonUtil.h"
+#include "utils/Json.h"
 #include "server/grpc_impl/GrpcServer.h"
+#include "server/grpc_impl/QueryCapture.h"
 
 #include <fiu-local.h>
 #include <fiu-control.h>
@@ -237,6 +246,8 @@ TEST_F(RpcHandlerTest, INDEX_TEST) {
     handler->DescribeIndex(&context, &table_name, &index_param);
     table_name.set_table_name(TABLE_NAME);
     handler->DescribeIndex(&context, &table_name, &index_param);
+    ASSERT_EQ(index_param.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_LE(index_param.indexed_row_count(), index_param.total_row_count());
 
     fiu_init(0);
     fiu_enable("DescribeIndexRequest.OnExecute.throw_std_exception", 1, NULL, 0);
@@ -284,6 +295,36 @@ TEST_F(RpcHandlerTest, INSERT_TEST) {
     }
     handler->Insert(&context, &request, &vector_ids);
     ASSERT_EQ(vector_ids.vector_id_array_size(), VECTOR_COUNT);
+
+    // a request far smaller than a table file goes through the insert buffer
+    fiu_enable("InsertRequest.OnExecute.bulk_load", 1, NULL, 0);
+    handler->Insert(&context, &request, &vector_ids);
+    ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    fiu_disable("InsertRequest.OnExecute.bulk_load");
+
+    // float vectors packed as bytes
+    ::milvus::grpc::InsertParam packed_request;
+    packed_request.set_table_name(TABLE_NAME);
+    for (auto& record : record_array) {
+        ::milvus::grpc::RowRecord* grpc_record = packed_request.add_row_record_array();
+        grpc_record->set_binary_data(reinterpret_cast<const char*>(record.data()), record.size() * sizeof(float));
+    }
+    handler->Insert(&context, &packed_request, &vector_ids);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), VECTOR_COUNT);
+
+    packed_request.mutable_row_record_array(0)->mutable_binary_data()->push_back('0');
+    handler->Insert(&context, &packed_request, &vector_ids);
+    ASSERT_NE(vector_ids.vector_id_array_size(), VECTOR_COUNT);
+
+    // rows of mixed dimensions are rejected even if they add up to whole vectors
+    ::milvus::grpc::InsertParam mixed_request = request;
+    mixed_request.mutable_row_record_array(0)->mutable_float_data()->RemoveLast();
+    mixed_request.mutable_row_record_array(1)->add_float_data(0.5f);
+    handler->Insert(&context, &request, &vector_ids);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), VECTOR_COUNT);
+    handler->Insert(&context, &mixed_request, &vector_ids);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), 0);
+
     fiu_init(0);
     fiu_enable("InsertRequest.OnExecute.id_array_error", 1, NULL, 0);
     handler->Insert(&context, &request, &vector_ids);
@@ -336,6 +377,163 @@ TEST_F(RpcHandlerTest, INSERT_TEST) {
     ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::ILLEGAL_ROWRECORD);
 }
 
+TEST_F(RpcHandlerTest, INSERT_STREAM_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    ::milvus::grpc::InsertParam chunk;
+    chunk.set_table_name(TABLE_NAME);
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    for (auto& record : record_array) {
+        CopyRowRecord(chunk.add_row_record_array(), record);
+    }
+
+    auto insert_chunk = [&](const ::milvus::grpc::InsertParam& param, ::milvus::grpc::VectorIds& response) {
+        std::promise<::grpc::Status> promise;
+        auto future = promise.get_future();
+        handler->InsertChunkAsync(&context, &param, TABLE_NAME, &response,
+                                  [&promise](const ::grpc::Status& status) { promise.set_value(status); });
+        return future.get();
+    };
+
+    // ids of the chunks add up in the response
+    ::milvus::grpc::VectorIds vector_ids;
+    ASSERT_TRUE(insert_chunk(chunk, vector_ids).ok());
+    ASSERT_TRUE(insert_chunk(chunk, vector_ids).ok());
+    ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), 2 * VECTOR_COUNT);
+
+    // a chunk of another table fails the stream and keeps the ids inserted before it
+    ::milvus::grpc::InsertParam other_chunk = chunk;
+    other_chunk.set_table_name("other_table");
+    insert_chunk(other_chunk, vector_ids);
+    ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::ErrorCode::ILLEGAL_ARGUMENT);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), 2 * VECTOR_COUNT);
+
+    // so does a chunk the insert rejects
+    std::vector<float> record_wrong_dim(TABLE_DIM - 1, 0.5f);
+    CopyRowRecord(chunk.add_row_record_array(), record_wrong_dim);
+    insert_chunk(chunk, vector_ids);
+    ASSERT_NE(vector_ids.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), 2 * VECTOR_COUNT);
+}
+
+TEST_F(RpcHandlerTest, BULK_INSERT_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    ::milvus::grpc::InsertParam chunk;
+    chunk.set_table_name(TABLE_NAME);
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    for (auto& record : record_array) {
+        CopyRowRecord(chunk.add_row_record_array(), record);
+    }
+
+    auto insert_chunk = [&](const ::milvus::grpc::InsertParam* param,
+                            milvus::server::grpc::GrpcRequestHandler::BulkInsertStatePtr& state,
+                            ::milvus::grpc::VectorIds& response) {
+        std::promise<::grpc::Status> promise;
+        auto future = promise.get_future();
+        handler->BulkInsertChunkAsync(&context, param, state, &response,
+                                      [&promise](const ::grpc::Status& status) { promise.set_value(status); });
+        return future.get();
+    };
+
+    ::milvus::grpc::TableName table_name;
+    table_name.set_table_name(TABLE_NAME);
+    ::milvus::grpc::TableRowCount count;
+    handler->CountTable(&context, &table_name, &count);
+    int64_t row_count = count.table_row_count();
+
+    // chunks are gathered until the stream ends, then loaded to table files without a flush
+    milvus::server::grpc::GrpcRequestHandler::BulkInsertStatePtr state;
+    ::milvus::grpc::VectorIds vector_ids;
+    ASSERT_TRUE(insert_chunk(&chunk, state, vector_ids).ok());
+    ASSERT_TRUE(insert_chunk(&chunk, state, vector_ids).ok());
+    ASSERT_EQ(vector_ids.vector_id_array_size(), 0);
+    ASSERT_TRUE(insert_chunk(nullptr, state, vector_ids).ok());
+    ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), 2 * VECTOR_COUNT);
+
+    handler->CountTable(&context, &table_name, &count);
+    ASSERT_EQ(count.table_row_count(), row_count + 2 * VECTOR_COUNT);
+
+    // an empty stream loads nothing
+    milvus::server::grpc::GrpcRequestHandler::BulkInsertStatePtr empty_state;
+    ::milvus::grpc::VectorIds empty_ids;
+    ASSERT_TRUE(insert_chunk(nullptr, empty_state, empty_ids).ok());
+    ASSERT_EQ(empty_ids.vector_id_array_size(), 0);
+
+    // a chunk of another partition fails the stream
+    ::milvus::grpc::InsertParam other_chunk = chunk;
+    other_chunk.set_partition_tag("other_partition");
+    insert_chunk(&chunk, state, vector_ids);
+    insert_chunk(&other_chunk, state, vector_ids);
+    ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::ErrorCode::ILLEGAL_ARGUMENT);
+
+    // so does a chunk of another dimension than those gathered before it
+    milvus::server::grpc::GrpcRequestHandler::BulkInsertStatePtr dim_state;
+    ::milvus::grpc::VectorIds dim_ids;
+    ASSERT_TRUE(insert_chunk(&chunk, dim_state, dim_ids).ok());
+    ::milvus::grpc::InsertParam wrong_dim_chunk;
+    wrong_dim_chunk.set_table_name(TABLE_NAME);
+    std::vector<float> record_wrong_dim(TABLE_DIM - 1, 0.5f);
+    CopyRowRecord(wrong_dim_chunk.add_row_record_array(), record_wrong_dim);
+    insert_chunk(&wrong_dim_chunk, dim_state, dim_ids);
+    ASSERT_NE(dim_ids.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(dim_ids.vector_id_array_size(), 0);
+}
+
+TEST_F(RpcHandlerTest, GET_VECTOR_BY_ID_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    ::milvus::grpc::InsertParam request;
+    request.set_table_name(TABLE_NAME);
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    for (auto& record : record_array) {
+        CopyRowRecord(request.add_row_record_array(), record);
+    }
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &request, &vector_ids);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), VECTOR_COUNT);
+
+    // buffered vectors are found as well
+    ::milvus::grpc::VectorIdentity identity;
+    identity.set_table_name(TABLE_NAME);
+    identity.set_id(vector_ids.vector_id_array(10));
+    ::milvus::grpc::VectorData vector_data;
+    ::grpc::Status grpc_status = handler->GetVectorByID(&context, &identity, &vector_data);
+    ASSERT_EQ(grpc_status.error_code(), ::grpc::Status::OK.error_code());
+    ASSERT_EQ(vector_data.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(vector_data.vector_data().float_data_size(), TABLE_DIM);
+    for (int64_t i = 0; i < TABLE_DIM; i++) {
+        ASSERT_EQ(vector_data.vector_data().float_data(i), record_array[10][i]);
+    }
+
+    // an unknown id gives no vector
+    identity.set_id(-1);
+    vector_data.Clear();
+    handler->GetVectorByID(&context, &identity, &vector_data);
+    ASSERT_EQ(vector_data.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(vector_data.vector_data().float_data_size(), 0);
+
+    // so does an unknown table with an error
+    identity.set_table_name("not_exist_table");
+    handler->GetVectorByID(&context, &identity, &vector_data);
+    ASSERT_NE(vector_data.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+
+    identity.set_table_name("../a");
+    handler->GetVectorByID(&context, &identity, &vector_data);
+    ASSERT_NE(vector_data.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+}
+
 TEST_F(RpcHandlerTest, SEARCH_TEST) {
     ::grpc::ServerContext context;
     handler->SetContext(&context, dummy_context);
@@ -434,6 +632,277 @@ TEST_F(RpcHandlerTest, SEARCH_TEST) {
     handler->SearchInFiles(&context, &search_in_files_param, &response);
 }
 
+TEST_F(RpcHandlerTest, SEARCH_STREAM_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    ::milvus::grpc::InsertParam insert_param;
+    for (auto& record : record_array) {
+        CopyRowRecord(insert_param.add_row_record_array(), record);
+    }
+    insert_param.set_table_name(TABLE_NAME);
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &insert_param, &vector_ids);
+    ASSERT_TRUE(milvus::server::DBWrapper::DB()->Flush({}).ok());
+
+    const int64_t nq = 10, topk = 10;
+    ::milvus::grpc::SearchParam request;
+    request.set_table_name(TABLE_NAME);
+    request.set_topk(topk);
+    request.set_nprobe(32);
+    BuildVectors(0, nq, record_array);
+    for (auto& record : record_array) {
+        CopyRowRecord(request.add_query_record_array(), record);
+    }
+
+    std::vector<::milvus::grpc::TopKQueryResult> chunks;
+    auto search_stream = [&]() {
+        chunks.clear();
+        std::promise<::grpc::Status> promise;
+        auto future = promise.get_future();
+        handler->SearchStreamAsync(
+            &context, &request,
+            [&chunks](const ::milvus::grpc::TopKQueryResult& chunk, const milvus::server::grpc::GrpcCallback& written) {
+                chunks.push_back(chunk);
+                written(::grpc::Status::OK);
+            },
+            [&promise](const ::grpc::Status& status) { promise.set_value(status); });
+        return future.get();
+    };
+
+    // small results come in one chunk
+    ASSERT_TRUE(search_stream().ok());
+    ASSERT_EQ(chunks.size(), 1);
+    ASSERT_EQ(chunks[0].status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(chunks[0].row_num(), nq);
+
+    // results of a chunk per query add up to those of the whole request in request order
+    fiu_init(0);
+    fiu_enable("GrpcRequestHandler.SearchStream.one_query_chunk", 1, NULL, 0);
+    ASSERT_TRUE(search_stream().ok());
+    fiu_disable("GrpcRequestHandler.SearchStream.one_query_chunk");
+    ASSERT_EQ(chunks.size(), nq);
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(chunks[i].status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+        ASSERT_EQ(chunks[i].row_num(), 1);
+        ASSERT_EQ(chunks[i].ids_size(), topk);
+        ASSERT_EQ(chunks[i].ids(0), vector_ids.vector_id_array(i));
+    }
+
+    // a failed chunk is written with its status and ends the stream
+    fiu_enable("SearchRequest.OnExecute.query_fail", 1, NULL, 0);
+    search_stream();
+    fiu_disable("SearchRequest.OnExecute.query_fail");
+    ASSERT_EQ(chunks.size(), 1);
+    ASSERT_NE(chunks[0].status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+
+    // so does a request without query records
+    request.clear_query_record_array();
+    search_stream();
+    ASSERT_EQ(chunks.size(), 1);
+    ASSERT_NE(chunks[0].status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+}
+
+TEST_F(RpcHandlerTest, SEARCH_BY_RANGE_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    ::milvus::grpc::InsertParam insert_param;
+    for (auto& record : record_array) {
+        CopyRowRecord(insert_param.add_row_record_array(), record);
+    }
+    insert_param.set_table_name(TABLE_NAME);
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &insert_param, &vector_ids);
+    ASSERT_TRUE(milvus::server::DBWrapper::DB()->Flush({}).ok());
+
+    const int64_t nq = 10, topk = 10;
+    ::milvus::grpc::RangeSearchParam request;
+    auto search_param = request.mutable_search_param();
+    search_param->set_table_name(TABLE_NAME);
+    search_param->set_topk(topk);
+    search_param->set_nprobe(32);
+    BuildVectors(0, nq, record_array);
+    for (auto& record : record_array) {
+        CopyRowRecord(search_param->add_query_record_array(), record);
+    }
+
+    // other vectors are at a squared distance of 1 at least, each query hits itself only
+    ::milvus::grpc::TopKQueryResult response;
+    request.set_radius(0.5);
+    ASSERT_TRUE(handler->SearchByRange(&context, &request, &response).ok());
+    ASSERT_EQ(response.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(response.row_num(), nq);
+    ASSERT_EQ(response.ids_size(), nq * topk);
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(response.ids(i * topk), vector_ids.vector_id_array(i));
+        ASSERT_EQ(response.ids(i * topk + 1), -1);
+    }
+
+    // all vectors are in a large radius, topk of them are kept nearest first
+    response.Clear();
+    request.set_radius(1e30);
+    ASSERT_TRUE(handler->SearchByRange(&context, &request, &response).ok());
+    ASSERT_EQ(response.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    ASSERT_EQ(response.ids_size(), nq * topk);
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(response.ids(i * topk), vector_ids.vector_id_array(i));
+        for (int64_t j = 1; j < topk; j++) {
+            ASSERT_NE(response.ids(i * topk + j), -1);
+            ASSERT_LE(response.distances(i * topk + j - 1), response.distances(i * topk + j));
+        }
+    }
+
+    // vectors in insert buffer are searched too
+    BuildVectors(VECTOR_COUNT, VECTOR_COUNT + nq, record_array);
+    insert_param.clear_row_record_array();
+    for (auto& record : record_array) {
+        CopyRowRecord(insert_param.add_row_record_array(), record);
+    }
+    ::milvus::grpc::VectorIds buffered_ids;
+    handler->Insert(&context, &insert_param, &buffered_ids);
+    search_param->clear_query_record_array();
+    for (auto& record : record_array) {
+        CopyRowRecord(search_param->add_query_record_array(), record);
+    }
+    response.Clear();
+    request.set_radius(0.5);
+    ASSERT_TRUE(handler->SearchByRange(&context, &request, &response).ok());
+    ASSERT_EQ(response.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(response.ids(i * topk), buffered_ids.vector_id_array(i));
+        ASSERT_EQ(response.ids(i * topk + 1), -1);
+    }
+
+    // a table that doesn't exist
+    response.Clear();
+    search_param->set_table_name("not_exist_table");
+    handler->SearchByRange(&context, &request, &response);
+    ASSERT_NE(response.status().error_code(), ::milvus::grpc::ErrorCode::SUCCESS);
+}
+
+TEST_F(RpcHandlerTest, SEARCH_COMBINE_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    ::milvus::grpc::InsertParam insert_param;
+    for (auto& record : record_array) {
+        ::milvus::grpc::RowRecord* grpc_record = insert_param.add_row_record_array();
+        CopyRowRecord(grpc_record, record);
+    }
+    insert_param.set_table_name(TABLE_NAME);
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &insert_param, &vector_ids);
+    ASSERT_TRUE(milvus::server::DBWrapper::DB()->Flush({}).ok());
+
+    // requests with different nq and topk are searched together
+    const int64_t request_count = 4;
+    const int64_t nprobe = 32;
+    std::vector<milvus::engine::VectorsData> vectors(request_count);
+    std::vector<milvus::server::TopKQueryResult> results(request_count);
+    std::vector<milvus::server::TopKQueryResult> single_results(request_count);
+    std::vector<milvus::server::Range> range_list;
+    std::vector<std::string> partition_list, file_id_list;
+    std::shared_ptr<milvus::server::SearchCombineRequest> combine_request;
+    for (int64_t i = 0; i < request_count; i++) {
+        vectors[i].vector_count_ = i + 1;
+        for (int64_t j = 0; j <= i; j++) {
+            vectors[i].float_data_.insert(vectors[i].float_data_.end(), record_array[i * 10 + j].begin(),
+                                          record_array[i * 10 + j].end());
+        }
+
+        int64_t topk = 5 * (i + 1);
+        auto request = std::static_pointer_cast<milvus::server::SearchRequest>(milvus::server::SearchRequest::Create(
+            dummy_context, TABLE_NAME, vectors[i], range_list, topk, nprobe, partition_list, file_id_list, results[i]));
+        if (combine_request == nullptr) {
+            combine_request = milvus::server::SearchCombineRequest::Create(request);
+        } else {
+            ASSERT_TRUE(combine_request->Combine(request));
+        }
+
+        milvus::server::BaseRequestPtr single_request = milvus::server::SearchRequest::Create(
+            dummy_context, TABLE_NAME, vectors[i], range_list, topk, nprobe, partition_list, file_id_list,
+            single_results[i]);
+        ASSERT_TRUE(single_request->Execute().ok());
+    }
+    ASSERT_EQ(combine_request->RequestCount(), request_count);
+
+    // search in files can't be combined
+    milvus::server::TopKQueryResult file_result;
+    file_id_list.push_back("1");
+    auto file_request = std::static_pointer_cast<milvus::server::SearchRequest>(milvus::server::SearchRequest::Create(
+        dummy_context, TABLE_NAME, vectors[0], range_list, 1, nprobe, partition_list, file_id_list, file_result));
+    ASSERT_FALSE(combine_request->Combine(file_request));
+    file_request->Done();
+
+    ASSERT_TRUE(combine_request->Execute().ok());
+    for (int64_t i = 0; i < request_count; i++) {
+        ASSERT_EQ(results[i].row_num_, i + 1);
+        ASSERT_EQ(results[i].id_list_.size(), (i + 1) * 5 * (i + 1));
+        ASSERT_EQ(results[i].distance_list_, single_results[i].distance_list_);
+    }
+}
+
+TEST_F(RpcHandlerTest, SEARCH_BATCH_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    ::milvus::grpc::InsertParam insert_param;
+    for (auto& record : record_array) {
+        ::milvus::grpc::RowRecord* grpc_record = insert_param.add_row_record_array();
+        CopyRowRecord(grpc_record, record);
+    }
+    insert_param.set_table_name(TABLE_NAME);
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &insert_param, &vector_ids);
+    ASSERT_TRUE(milvus::server::DBWrapper::DB()->Flush({}).ok());
+
+    // the last search has a large topk and is searched alone
+    const int64_t search_count = 3;
+    std::vector<milvus::server::SearchQueryParam> query_params(search_count);
+    for (int64_t i = 0; i < search_count; i++) {
+        auto& param = query_params[i];
+        param.vectors_.vector_count_ = i + 1;
+        for (int64_t j = 0; j <= i; j++) {
+            param.vectors_.float_data_.insert(param.vectors_.float_data_.end(), record_array[i * 10 + j].begin(),
+                                              record_array[i * 10 + j].end());
+        }
+        param.topk_ = (i == search_count - 1) ? milvus::server::COMBINE_MAX_TOPK + 1 : 5 * (i + 1);
+        param.nprobe_ = 32;
+    }
+
+    milvus::server::RequestHandler request_handler;
+    std::vector<milvus::server::TopKQueryResult> results;
+    ASSERT_TRUE(request_handler.SearchBatch(dummy_context, TABLE_NAME, query_params, results).ok());
+    ASSERT_EQ(results.size(), search_count);
+    for (int64_t i = 0; i < search_count; i++) {
+        auto& param = query_params[i];
+        milvus::server::TopKQueryResult single_result;
+        ASSERT_TRUE(request_handler
+                        .Search(dummy_context, TABLE_NAME, param.vectors_, param.range_list_, param.topk_,
+                                param.nprobe_, param.partition_list_, param.file_id_list_, single_result)
+                        .ok());
+        ASSERT_EQ(results[i].row_num_, i + 1);
+        ASSERT_EQ(results[i].id_list_.size(), single_result.id_list_.size());
+        ASSERT_EQ(results[i].distance_list_, single_result.distance_list_);
+    }
+
+    // an invalid search fails the whole batch
+    query_params[1].topk_ = 0;
+    ASSERT_FALSE(request_handler.SearchBatch(dummy_context, TABLE_NAME, query_params, results).ok());
+    query_params.clear();
+    ASSERT_FALSE(request_handler.SearchBatch(dummy_context, TABLE_NAME, query_params, results).ok());
+    ASSERT_FALSE(request_handler.SearchBatch(dummy_context, "not_exist_table", query_params, results).ok());
+}
+
 TEST_F(RpcHandlerTest, TABLES_TEST) {
     ::grpc::ServerContext context;
     handler->SetContext(&context, dummy_context);
@@ -746,6 +1215,13 @@ TEST_F(RpcHandlerTest, CMD_TEST) {
 
     command.set_cmd("tasktable");
     handler->Cmd(&context, &command, &reply);
+    command.set_cmd("perf");
+    handler->Cmd(&context, &command, &reply);
+    auto perf = nlohmann::json::parse(reply.string_reply());
+    ASSERT_TRUE(perf.contains("request_queues"));
+    ASSERT_TRUE(perf.contains("task_tables"));
+    ASSERT_TRUE(perf["cpu_cache"].contains("hit_rate"));
+    ASSERT_TRUE(perf["request_latency"].contains("CmdRequest"));
     command.set_cmd("test");
     handler->Cmd(&context, &command, &reply);
 
@@ -757,6 +1233,38 @@ TEST_F(RpcHandlerTest, CMD_TEST) {
     command.set_cmd("build_commit_id");
     handler->Cmd(&context, &command, &reply);
 
+    command.set_cmd("preload_progress");
+    handler->Cmd(&context, &command, &reply);
+    command.set_cmd("index_progress");
+    handler->Cmd(&context, &command, &reply);
+    command.set_cmd(std::string("search_files ") + TABLE_NAME);
+    handler->Cmd(&context, &command, &reply);
+    ASSERT_EQ(reply.status().error_code(), ::milvus::grpc::SUCCESS);
+    command.set_cmd("search_files a b c");
+    handler->Cmd(&context, &command, &reply);
+    ASSERT_NE(reply.status().error_code(), ::milvus::grpc::SUCCESS);
+    command.set_cmd("search_files ../a");
+    handler->Cmd(&context, &command, &reply);
+    ASSERT_NE(reply.status().error_code(), ::milvus::grpc::SUCCESS);
+    command.set_cmd("meta_changes 0 0");
+    handler->Cmd(&context, &command, &reply);
+    ASSERT_EQ(reply.status().error_code(), ::milvus::grpc::SUCCESS);
+    command.set_cmd("meta_changes a 0");
+    handler->Cmd(&context, &command, &reply);
+    ASSERT_NE(reply.status().error_code(), ::milvus::grpc::SUCCESS);
+    command.set_cmd(std::string("create_index ") + TABLE_NAME + " a");
+    handler->Cmd(&context, &command, &reply);
+    command.set_cmd(std::string("advise_index ") + TABLE_NAME + " 2.0");
+    handler->Cmd(&context, &command, &reply);
+    ASSERT_NE(reply.status().error_code(), ::milvus::grpc::SUCCESS);
+    command.set_cmd(std::string("advise_index ") + TABLE_NAME + " a");
+    handler->Cmd(&context, &command, &reply);
+    ASSERT_NE(reply.status().error_code(), ::milvus::grpc::SUCCESS);
+    command.set_cmd(std::string("set_cache_quota ") + TABLE_NAME + " 0 0 pin");
+    handler->Cmd(&context, &command, &reply);
+    command.set_cmd(std::string("set_cache_quota ") + TABLE_NAME + " a");
+    handler->Cmd(&context, &command, &reply);
+
     command.set_cmd("set_config");
     handler->Cmd(&context, &command, &reply);
     command.set_cmd("get_config");
@@ -862,6 +1370,31 @@ class AsyncDummyRequest : public milvus::server::BaseRequest {
         : BaseRequest(std::make_shared<milvus::server::Context>("dummy_request_id2"), dummy, true) {
     }
 };
+
+class SlowDummyRequest : public milvus::server::BaseRequest {
+ public:
+    SlowDummyRequest(std::atomic<int>& running, std::atomic<int>& peak)
+        : BaseRequest(std::make_shared<milvus::server::Context>("slow_request_id"),
+                      milvus::server::DQL_REQUEST_GROUP),
+          running_(running),
+          peak_(peak) {
+    }
+
+    milvus::Status
+    OnExecute() override {
+        int running = ++running_;
+        int peak = peak_;
+        while (running > peak && !peak_.compare_exchange_weak(peak, running)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        --running_;
+        return milvus::Status::OK();
+    }
+
+ private:
+    std::atomic<int>& running_;
+    std::atomic<int>& peak_;
+};
 }  // namespace
 
 TEST_F(RpcSchedulerTest, BASE_TASK_TEST) {
@@ -924,6 +1457,55 @@ TEST_F(RpcSchedulerTest, BASE_TASK_TEST) {
     milvus::server::RequestScheduler::GetInstance().Stop();
 }
 
+TEST_F(RpcSchedulerTest, CALLBACK_TEST) {
+    // a request with callback is not waited for, the callback is called once it is executed
+    std::promise<milvus::Status> promise;
+    auto future = promise.get_future();
+    std::string dummy = "dql_callback";
+    milvus::server::BaseRequestPtr base_ptr = DummyRequest::Create(dummy);
+    base_ptr->SetCallback([&promise](const milvus::Status& status) { promise.set_value(status); });
+    ASSERT_TRUE(base_ptr->IsAsync());
+    milvus::server::RequestScheduler::ExecRequest(base_ptr);
+    ASSERT_TRUE(future.get().ok());
+
+    // a request done without being executed passes its status to the callback
+    std::promise<milvus::Status> fail_promise;
+    auto fail_future = fail_promise.get_future();
+    milvus::server::BaseRequestPtr fail_ptr = DummyRequest::Create(dummy);
+    fail_ptr->SetCallback([&fail_promise](const milvus::Status& status) { fail_promise.set_value(status); });
+    fail_ptr->Done(milvus::Status(milvus::SERVER_UNEXPECTED_ERROR, "not queued"));
+    ASSERT_EQ(fail_future.get().code(), milvus::SERVER_UNEXPECTED_ERROR);
+}
+
+TEST_F(RpcSchedulerTest, CONCURRENT_WORKER_TEST) {
+    // searches are executed by several workers of the group at the same time
+    auto& scheduler = milvus::server::RequestScheduler::GetInstance();
+    scheduler.Stop();
+    scheduler.Start();
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+    ASSERT_TRUE(config.SetServerConfigSearchWorkerNum("2").ok());
+
+    std::atomic<int> running(0), peak(0);
+    std::vector<std::future<milvus::Status>> futures;
+    std::vector<std::shared_ptr<std::promise<milvus::Status>>> promises;
+    for (auto i = 0; i < 2; ++i) {
+        auto promise = std::make_shared<std::promise<milvus::Status>>();
+        futures.emplace_back(promise->get_future());
+        promises.push_back(promise);
+        milvus::server::BaseRequestPtr request = std::make_shared<SlowDummyRequest>(running, peak);
+        request->SetCallback([promise](const milvus::Status& status) { promise->set_value(status); });
+        scheduler.ExecuteRequest(request);
+    }
+    for (auto& future : futures) {
+        ASSERT_TRUE(future.get().ok());
+    }
+    ASSERT_EQ(peak, 2);
+
+    scheduler.Stop();
+    scheduler.Start();
+    ASSERT_TRUE(config.SetServerConfigSearchWorkerNum(milvus::server::CONFIG_SERVER_SEARCH_WORKER_NUM_DEFAULT).ok());
+}
+
 TEST(RpcTest, RPC_SERVER_TEST) {
     using GrpcServer =  milvus::server::grpc::GrpcServer;
     GrpcServer& server = GrpcServer::GetInstance();
@@ -951,3 +1533,75 @@ TEST(RpcTest, InterceptorHookHandlerTest) {
     handler->OnPostRecvInitialMetaData(nullptr, nullptr);
     handler->OnPreSendMessage(nullptr, nullptr);
 }
+
+TEST(RpcTest, QUERY_CAPTURE_TEST) {
+    using QueryCapture = milvus::server::grpc::QueryCapture;
+    const std::string dir = "/tmp/milvus_test_capture";
+    const std::string path = dir + "/query_capture.bin";
+    boost::filesystem::remove_all(dir);
+    boost::filesystem::create_directories(dir);
+
+    auto& config = milvus::server::Config::GetInstance();
+    config.SetServerConfigQueryCapturePath(path);
+    config.SetServerConfigQueryCaptureRate("1.0");
+    auto& capture = QueryCapture::GetInstance();
+
+    auto capture_requests = [&](int64_t first, int64_t count) {
+        capture.Start();
+        for (int64_t i = first; i < first + count; ++i) {
+            ::milvus::grpc::SearchParam request;
+            request.set_table_name("table_" + std::to_string(i));
+            request.set_topk(i + 1);
+            capture.Capture(request);
+        }
+        capture.Stop();
+    };
+    auto check_records = [&](int64_t count) {
+        std::vector<QueryCapture::CaptureRecord> records;
+        int64_t valid_size = 0;
+        ASSERT_TRUE(QueryCapture::ReadFile(path, records, valid_size).ok());
+        ASSERT_EQ(static_cast<int64_t>(records.size()), count);
+        for (int64_t i = 0; i < count; ++i) {
+            ::milvus::grpc::SearchParam request;
+            ASSERT_TRUE(request.ParseFromString(records[i].message_));
+            ASSERT_EQ(request.table_name(), "table_" + std::to_string(i));
+            ASSERT_EQ(request.topk(), i + 1);
+            ASSERT_GT(records[i].arrival_us_, 0);
+        }
+        ASSERT_EQ(valid_size, static_cast<int64_t>(boost::filesystem::file_size(path)));
+    };
+
+    // requests come back as captured, a restarted server appends to them
+    capture_requests(0, 10);
+    check_records(10);
+    capture_requests(10, 5);
+    check_records(15);
+
+    // a record torn by a killed server is left out, and cut off before the next run appends
+    auto size = boost::filesystem::file_size(path);
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        const char torn[] = "\x01\x02\x03\x04\x05\x06\x07\x08\x64\x00\x00\x00partial";
+        file.write(torn, sizeof(torn) - 1);
+    }
+    std::vector<QueryCapture::CaptureRecord> records;
+    int64_t valid_size = 0;
+    ASSERT_TRUE(QueryCapture::ReadFile(path, records, valid_size).ok());
+    ASSERT_EQ(records.size(), 15u);
+    ASSERT_EQ(valid_size, static_cast<int64_t>(size));
+    capture_requests(15, 5);
+    check_records(20);
+
+    // another file is never appended to
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "not a capture file";
+    }
+    ASSERT_FALSE(QueryCapture::ReadFile(path, records, valid_size).ok());
+    capture_requests(0, 1);
+    ASSERT_EQ(boost::filesystem::file_size(path), 18u);
+
+    config.SetServerConfigQueryCapturePath("");
+    config.SetServerConfigQueryCaptureRate("0.0");
+    boost::filesystem::remove_all(dir);
+}
@@ -41,6 +41,7 @@
 #include "server/web_impl/dto/VectorDto.hpp"
 #include "server/web_impl/handler/WebRequestHandler.h"
 
+#include "thirdparty/nlohmann/json.hpp"
 #include "utils/CommonUtil.h"
 #include "wrapper/VecIndex.h"
 
@@ -399,6 +400,174 @@ TEST_F(WebHandlerTest, SEARCH) {
     ASSERT_EQ(0, status_dto->code->getValue()) << status_dto->message->std_str();
 }
 
+TEST_F(WebHandlerTest, SEARCH_BODY) {
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    auto table_name = milvus::server::web::OString(TABLE_NAME) + RandomName().c_str();
+    GenTable(table_name->std_str(), 16, 10, "L2");
+
+    std::default_random_engine e;
+    std::uniform_real_distribution<float> u(0, 1);
+    nlohmann::json records;
+    for (size_t i = 0; i < 100; i++) {
+        std::vector<float> record(16);
+        for (auto& value : record) {
+            value = u(e);
+        }
+        records.push_back(record);
+    }
+
+    nlohmann::json insert_json;
+    insert_json["records"] = records;
+    OString ids_str;
+    auto status_dto = handler->Insert(table_name, insert_json.dump().c_str(), ids_str);
+    ASSERT_EQ(0, status_dto->code->getValue()) << status_dto->message->std_str();
+    ASSERT_EQ(100, nlohmann::json::parse(ids_str->std_str())["ids"].size());
+
+    nlohmann::json search_json;
+    search_json["topk"] = 2;
+    search_json["nprobe"] = 1;
+    search_json["records"] = {records[0], records[1], records[2]};
+    search_json["unknown_field"] = {{"a", {1, 2}}};
+    OString results_str;
+    status_dto = handler->Search(table_name, search_json.dump().c_str(), results_str);
+    ASSERT_EQ(0, status_dto->code->getValue()) << status_dto->message->std_str();
+    auto results_json = nlohmann::json::parse(results_str->std_str());
+    ASSERT_EQ(3, results_json["num"].get<int64_t>());
+    ASSERT_EQ(3, results_json["results"].size());
+    ASSERT_EQ(2, results_json["results"][0].size());
+    ASSERT_TRUE(results_json["results"][0][0]["id"].is_string());
+    ASSERT_TRUE(results_json["results"][0][0]["distance"].is_string());
+
+    // missing fields, malformed body and vectors not in rows
+    search_json.erase("topk");
+    status_dto = handler->Search(table_name, search_json.dump().c_str(), results_str);
+    ASSERT_EQ(StatusCode::BODY_FIELD_LOSS, status_dto->code->getValue());
+
+    status_dto = handler->Search(table_name, "{\"topk\": 1, ", results_str);
+    ASSERT_EQ(StatusCode::BODY_PARSE_FAIL, status_dto->code->getValue());
+
+    status_dto = handler->Insert(table_name, "{\"records\": [1.0, 2.0]}", ids_str);
+    ASSERT_EQ(StatusCode::BODY_PARSE_FAIL, status_dto->code->getValue());
+}
+
+TEST_F(WebHandlerTest, SEARCH_BATCH) {
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    auto table_name = milvus::server::web::OString(TABLE_NAME) + RandomName().c_str();
+    GenTable(table_name->std_str(), 16, 10, "L2");
+
+    std::default_random_engine e;
+    std::uniform_real_distribution<float> u(0, 1);
+    nlohmann::json records;
+    for (size_t i = 0; i < 100; i++) {
+        std::vector<float> record(16);
+        for (auto& value : record) {
+            value = u(e);
+        }
+        records.push_back(record);
+    }
+
+    nlohmann::json insert_json;
+    insert_json["records"] = records;
+    OString ids_str;
+    auto status_dto = handler->Insert(table_name, insert_json.dump().c_str(), ids_str);
+    ASSERT_EQ(0, status_dto->code->getValue()) << status_dto->message->std_str();
+
+    // results are in the order of the searches
+    nlohmann::json searches;
+    searches.push_back({{"topk", 2}, {"nprobe", 1}, {"records", {records[0]}}});
+    searches.push_back({{"topk", 3}, {"nprobe", 1}, {"records", {records[1], records[2]}}});
+    OString results_str;
+    status_dto = handler->SearchBatch(table_name, searches.dump().c_str(), results_str);
+    ASSERT_EQ(0, status_dto->code->getValue()) << status_dto->message->std_str();
+    auto results_json = nlohmann::json::parse(results_str->std_str());
+    ASSERT_EQ(2, results_json.size());
+    ASSERT_EQ(1, results_json[0]["num"].get<int64_t>());
+    ASSERT_EQ(2, results_json[0]["results"][0].size());
+    ASSERT_EQ(2, results_json[1]["num"].get<int64_t>());
+    ASSERT_EQ(3, results_json[1]["results"][0].size());
+
+    // not an array, a search without topk and a table not existing
+    status_dto = handler->SearchBatch(table_name, searches[0].dump().c_str(), results_str);
+    ASSERT_EQ(StatusCode::BODY_PARSE_FAIL, status_dto->code->getValue());
+
+    searches[1].erase("topk");
+    status_dto = handler->SearchBatch(table_name, searches.dump().c_str(), results_str);
+    ASSERT_EQ(StatusCode::BODY_FIELD_LOSS, status_dto->code->getValue());
+
+    searches[1]["topk"] = 3;
+    status_dto = handler->SearchBatch(OString("not_exist_table"), searches.dump().c_str(), results_str);
+    ASSERT_EQ(StatusCode::TABLE_NOT_EXISTS, status_dto->code->getValue());
+}
+
+TEST_F(WebHandlerTest, SEARCH_PACKED) {
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    auto table_name = milvus::server::web::OString(TABLE_NAME) + RandomName().c_str();
+    GenTable(table_name->std_str(), 16, 10, "L2");
+
+    std::default_random_engine e;
+    std::uniform_real_distribution<float> u(0, 1);
+    std::vector<float> records(16 * 100);
+    for (auto& value : records) {
+        value = u(e);
+    }
+
+    // insert vectors as an octet-stream body
+    OQueryParams query_params;
+    OString body((const char*)records.data(), records.size() * sizeof(float), true);
+    OString ids_str;
+    auto status_dto = handler->InsertPacked(table_name, query_params, body, ids_str);
+    ASSERT_EQ(0, status_dto->code->getValue()) << status_dto->message->std_str();
+    ASSERT_EQ(100, nlohmann::json::parse(ids_str->std_str())["ids"].size());
+
+    OString results_str;
+    OString query_body((const char*)records.data(), 3 * 16 * sizeof(float), true);
+    status_dto = handler->SearchPacked(table_name, query_params, query_body, results_str);
+    ASSERT_EQ(StatusCode::BODY_FIELD_LOSS, status_dto->code->getValue());
+
+    query_params.put("topk", "2");
+    query_params.put("nprobe", "1");
+    status_dto = handler->SearchPacked(table_name, query_params, query_body, results_str);
+    ASSERT_EQ(0, status_dto->code->getValue()) << status_dto->message->std_str();
+    ASSERT_EQ(3, nlohmann::json::parse(results_str->std_str())["num"].get<int64_t>());
+
+    // the size must be a multiple of the vector size
+    OString bad_body((const char*)records.data(), 16 * sizeof(float) + 2, true);
+    status_dto = handler->SearchPacked(table_name, query_params, bad_body, results_str);
+    ASSERT_EQ(StatusCode::ILLEGAL_DIMENSION, status_dto->code->getValue());
+
+    // a param beyond the long range is rejected rather than thrown
+    OQueryParams huge_params;
+    huge_params.put("topk", "99999999999999999999999");
+    status_dto = handler->SearchPacked(table_name, huge_params, query_body, results_str);
+    ASSERT_EQ(StatusCode::ILLEGAL_ARGUMENT, status_dto->code->getValue());
+
+    // the same vectors in base64 within a json body
+    std::string base64;
+    const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    auto bytes = (const uint8_t*)records.data();
+    for (size_t i = 0; i < 3 * 16 * sizeof(float); i += 3) {
+        uint32_t bits = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+        for (int shift = 18; shift >= 0; shift -= 6) {
+            base64.push_back(chars[(bits >> shift) & 0x3F]);
+        }
+    }
+
+    nlohmann::json search_json;
+    search_json["topk"] = 2;
+    search_json["nprobe"] = 1;
+    search_json["records_base64"] = base64;
+    status_dto = handler->Search(table_name, search_json.dump().c_str(), results_str);
+    ASSERT_EQ(0, status_dto->code->getValue()) << status_dto->message->std_str();
+    ASSERT_EQ(3, nlohmann::json::parse(results_str->std_str())["num"].get<int64_t>());
+
+    search_json["records_base64"] = "not base64!";
+    status_dto = handler->Search(table_name, search_json.dump().c_str(), results_str);
+    ASSERT_EQ(StatusCode::BODY_PARSE_FAIL, status_dto->code->getValue());
+}
+
 TEST_F(WebHandlerTest, CMD) {
     handler->RegisterRequestHandler(milvus::server::RequestHandler());
     milvus::server::web::OString cmd;
@@ -0,0 +1,78 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "storage/Compression.h"
+
+TEST(CompressionTest, COMPRESS_BLOCK_TEST) {
+    // several chunks and a short tail, codes of few distinct values like sq8 ones
+    std::vector<uint8_t> data(10 * 1024 * 1024 + 123);
+    std::mt19937 gen(42);
+    for (auto& value : data) {
+        value = static_cast<uint8_t>(gen() % 16);
+    }
+
+    std::vector<uint8_t> compressed;
+    ASSERT_TRUE(milvus::storage::CompressBlock(data.data(), data.size(), compressed));
+    ASSERT_LT(compressed.size(), data.size());
+
+    std::shared_ptr<uint8_t> raw;
+    size_t raw_length = 0;
+    ASSERT_TRUE(milvus::storage::DecompressBlock(compressed.data(), compressed.size(), raw, raw_length));
+    ASSERT_EQ(raw_length, data.size());
+    ASSERT_EQ(memcmp(raw.get(), data.data(), data.size()), 0);
+
+    // broken blocks are refused
+    ASSERT_FALSE(milvus::storage::DecompressBlock(compressed.data(), compressed.size() / 2, raw, raw_length));
+    ASSERT_FALSE(milvus::storage::DecompressBlock(compressed.data(), 8, raw, raw_length));
+    compressed[compressed.size() - 100] ^= 0xff;
+    ASSERT_FALSE(milvus::storage::DecompressBlock(compressed.data(), compressed.size(), raw, raw_length));
+
+    // random bytes don't shrink and small blocks aren't worth it, both are stored as they are
+    for (auto& value : data) {
+        value = static_cast<uint8_t>(gen());
+    }
+    ASSERT_FALSE(milvus::storage::CompressBlock(data.data(), data.size(), compressed));
+    std::vector<uint8_t> small(1024, 0);
+    ASSERT_FALSE(milvus::storage::CompressBlock(small.data(), small.size(), compressed));
+}
+
+TEST(CompressionTest, BLOCK_CHECKSUM_TEST) {
+    // crc32 of "123456789"
+    const std::string check = "123456789";
+    ASSERT_EQ(milvus::storage::BlockChecksum(reinterpret_cast<const uint8_t*>(check.data()), check.size()),
+              0xCBF43926u);
+
+    // summed by chunks, the same as summed at once
+    std::vector<uint8_t> data(9 * 1024 * 1024 + 7);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 31 % 251);
+    }
+    uint32_t sum = milvus::storage::BlockChecksum(data.data(), data.size());
+    ASSERT_EQ(sum, static_cast<uint32_t>(crc32(0L, data.data(), data.size())));
+
+    // summed part by part as a block is written
+    size_t half = data.size() / 2 + 3;
+    uint32_t part = milvus::storage::BlockChecksum(data.data(), half);
+    ASSERT_EQ(milvus::storage::BlockChecksum(part, data.data() + half, data.size() - half), sum);
+
+    data[data.size() / 2] ^= 1;
+    ASSERT_NE(milvus::storage::BlockChecksum(data.data(), data.size()), sum);
+    ASSERT_EQ(milvus::storage::BlockChecksum(data.data(), 0), 0u);
+}
@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "storage/file/FileIOReader.h"
+
+TEST(FileIOReaderTest, PREAD_TEST) {
+    const std::string filename = "/tmp/test_file_io_reader";
+    // several chunks and a short tail
+    std::vector<char> content(40 * 1024 * 1024 + 123);
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 31 % 251);
+    }
+    {
+        std::ofstream fs(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        fs.write(content.data(), content.size());
+    }
+
+    milvus::storage::FileIOReader reader(filename);
+    ASSERT_EQ(reader.length(), content.size());
+
+    for (int64_t thread_num : {1, 4, 16}) {
+        std::vector<char> buffer(content.size());
+        ASSERT_TRUE(reader.pread(buffer.data(), 0, buffer.size(), thread_num));
+        ASSERT_EQ(buffer, content);
+    }
+
+    std::vector<char> part(1000);
+    ASSERT_TRUE(reader.pread(part.data(), 100, part.size(), 4));
+    ASSERT_TRUE(std::equal(part.begin(), part.end(), content.begin() + 100));
+
+    // the range passes the end of the file
+    ASSERT_FALSE(reader.pread(part.data(), content.size() - 10, part.size(), 4));
+
+    milvus::storage::FileIOReader missing("/tmp/test_file_io_reader_not_exist");
+    ASSERT_EQ(missing.length(), 0);
+    ASSERT_FALSE(missing.pread(part.data(), 0, part.size(), 4));
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "storage/file/FileIOWriter.h"
+
+TEST(FileIOWriterTest, DIRECT_WRITE_TEST) {
+    // several buffers and an unaligned tail, written by pieces of odd sizes
+    std::vector<char> content(9 * 1024 * 1024 + 4321);
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 31 % 251);
+    }
+
+    for (bool direct : {false, true}) {
+        const std::string filename = "/tmp/test_file_io_writer";
+        {
+            milvus::storage::FileIOWriter writer(filename, direct);
+            size_t pos = 0;
+            for (size_t piece : {size_t(1), size_t(4095), size_t(3 * 1024 * 1024 + 7)}) {
+                writer.write(content.data() + pos, piece);
+                pos += piece;
+            }
+            writer.write(content.data() + pos, content.size() - pos);
+            ASSERT_EQ(writer.length(), content.size());
+        }
+
+        std::ifstream fs(filename, std::ios::in | std::ios::binary);
+        std::vector<char> read_back((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+        ASSERT_EQ(read_back, content);
+    }
+}
+
+TEST(FileIOWriterTest, WRITE_FAIL_TEST) {
+    // every write to /dev/full fails for lack of space, the failure is returned once the file is closed, even if no
+    // tail is left to write then
+    std::vector<char> content(4 * 1024 * 1024);
+    for (bool direct : {false, true}) {
+        milvus::storage::FileIOWriter writer("/dev/full", direct);
+        writer.write(content.data(), content.size());
+        writer.write(content.data(), content.size());
+        ASSERT_EQ(writer.length(), 2 * content.size());
+        auto status = writer.close();
+        ASSERT_FALSE(status.ok());
+        if (direct) {
+            ASSERT_NE(status.message().find("No space left on device"), std::string::npos);
+        }
+    }
+
+    milvus::storage::FileIOWriter writer("/tmp/test_file_io_writer", true);
+    writer.write(content.data(), content.size());
+    ASSERT_TRUE(writer.close().ok());
+}
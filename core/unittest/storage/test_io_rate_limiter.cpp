@@ -0,0 +1,129 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/IORateLimiter.h"
+#include "storage/file/FileIOReader.h"
+
+namespace {
+
+double
+RequestSeconds(int64_t bytes) {
+    auto begin = std::chrono::steady_clock::now();
+    milvus::storage::IORateLimiter::GetInstance().Request(bytes);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+}  // namespace
+
+TEST(IORateLimiterTest, RATE_TEST) {
+    auto& limiter = milvus::storage::IORateLimiter::GetInstance();
+    const int64_t rate = 20 * 1024 * 1024;
+    limiter.SetRate(rate);
+
+    // foreground io isn't limited
+    ASSERT_FALSE(milvus::storage::IORateLimiter::InBackground());
+    ASSERT_LT(RequestSeconds(10 * rate), 0.1);
+
+    {
+        milvus::storage::BackgroundIOScope background_io;
+        ASSERT_TRUE(milvus::storage::IORateLimiter::InBackground());
+        {
+            milvus::storage::BackgroundIOScope nested_io;
+        }
+        ASSERT_TRUE(milvus::storage::IORateLimiter::InBackground());
+
+        // no tokens saved yet, a quarter of a second worth of bytes is paid by waiting
+        double seconds = RequestSeconds(rate / 4);
+        ASSERT_GT(seconds, 0.2);
+        ASSERT_LT(seconds, 1.0);
+
+        limiter.SetRate(0);
+        ASSERT_LT(RequestSeconds(10 * rate), 0.1);
+    }
+    ASSERT_FALSE(milvus::storage::IORateLimiter::InBackground());
+}
+
+TEST(IORateLimiterTest, BACKOFF_TEST) {
+    auto& limiter = milvus::storage::IORateLimiter::GetInstance();
+    const int64_t rate = 64 * 1024 * 1024;
+    limiter.SetRate(rate);
+    ASSERT_EQ(limiter.CurrentRate(), rate);
+
+    for (int i = 0; i < 100; ++i) {
+        limiter.ReportSearchLatency(1000.0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    limiter.ReportSearchLatency(1000.0);
+    ASSERT_EQ(limiter.CurrentRate(), rate);
+
+    // search latency triples, background io is cut back once a second
+    for (int i = 0; i < 20; ++i) {
+        limiter.ReportSearchLatency(3000.0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    limiter.ReportSearchLatency(3000.0);
+    ASSERT_EQ(limiter.CurrentRate(), rate / 2);
+
+    // and restored gradually once it falls back
+    for (int i = 0; i < 40; ++i) {
+        limiter.ReportSearchLatency(1000.0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    limiter.ReportSearchLatency(1000.0);
+    ASSERT_GT(limiter.CurrentRate(), rate / 2);
+
+    limiter.SetRate(0);
+    ASSERT_EQ(limiter.CurrentRate(), 0);
+}
+
+TEST(IORateLimiterTest, READ_TEST) {
+    auto& limiter = milvus::storage::IORateLimiter::GetInstance();
+    const int64_t rate = 20 * 1024 * 1024;
+
+    const std::string filename = "/tmp/test_io_rate_limiter_read";
+    std::vector<char> content(rate / 4);
+    {
+        std::ofstream fs(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        fs.write(content.data(), content.size());
+    }
+
+    auto read_seconds = [&](bool use_pread) {
+        milvus::storage::FileIOReader reader(filename);
+        std::vector<char> buffer(content.size());
+        auto begin = std::chrono::steady_clock::now();
+        if (use_pread) {
+            EXPECT_TRUE(reader.pread(buffer.data(), 0, buffer.size(), 4));
+        } else {
+            reader.read(buffer.data(), buffer.size());
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    };
+
+    // background reads are paid like writes, both sequential and parallel ones
+    for (bool use_pread : {false, true}) {
+        limiter.SetRate(rate);
+        milvus::storage::BackgroundIOScope background_io;
+        double seconds = read_seconds(use_pread);
+        ASSERT_GT(seconds, 0.2);
+        ASSERT_LT(seconds, 1.0);
+    }
+
+    limiter.SetRate(rate);
+    ASSERT_LT(read_seconds(false), 0.1);
+    limiter.SetRate(0);
+}
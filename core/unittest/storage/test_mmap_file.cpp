@@ -0,0 +1,49 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+
+#include "storage/file/MmapFile.h"
+
+TEST(MmapFileTest, MMAP_FILE_TEST) {
+    const std::string filename = "/tmp/test_mmap_file";
+    const std::string content = "abcdefghijklmnopqrstuvwxyz";
+    {
+        std::ofstream fs(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        fs << content;
+    }
+
+    {
+        milvus::storage::MmapFile file(filename);
+        ASSERT_TRUE(file.valid());
+        ASSERT_EQ(file.length(), content.size());
+        ASSERT_EQ(std::string(reinterpret_cast<char*>(file.data()), file.length()), content);
+
+        // private mapping, the file is not changed
+        file.data()[0] = 'z';
+    }
+
+    {
+        milvus::storage::MmapFile file(filename);
+        ASSERT_TRUE(file.valid());
+        ASSERT_EQ(file.data()[0], 'a');
+    }
+
+    // empty or missing file can't be mapped
+    {
+        std::ofstream fs(filename, std::ios::out | std::ios::trunc);
+    }
+    ASSERT_FALSE(milvus::storage::MmapFile(filename).valid());
+    ASSERT_FALSE(milvus::storage::MmapFile("/tmp/test_mmap_file_not_exist").valid());
+}
@@ -11,8 +11,12 @@
 
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <string>
+#include <vector>
 #include <fiu-local.h>
 #include <fiu-control.h>
 
@@ -126,6 +130,132 @@ TEST_F(StorageTest, S3_RW_TEST) {
     storage_inst.StopService();
 }
 
+TEST_F(StorageTest, S3_MULTIPART_TEST) {
+    fiu_init(0);
+
+    const std::string index_name = "/tmp/test_index_multipart";
+    // parts exceed the requests in flight, the last part is short
+    std::string content(milvus::storage::S3_PART_SIZE * (milvus::storage::S3_PARALLEL_NUM + 2) + 123, 0);
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 31 % 251);
+    }
+
+    auto& storage_inst = milvus::storage::S3ClientWrapper::GetInstance();
+    fiu_enable("S3ClientWrapper.StartService.mock_enable", 1, NULL, 0);
+    ASSERT_TRUE(storage_inst.StartService().ok());
+
+    {
+        milvus::storage::S3IOWriter writer(index_name);
+        // writes smaller and larger than a part
+        size_t half = milvus::storage::S3_PART_SIZE / 2;
+        writer.write(const_cast<char*>(content.data()), half);
+        writer.write(const_cast<char*>(content.data()) + half, content.size() - half);
+        ASSERT_EQ(writer.length(), content.size());
+        ASSERT_LT(writer.buffer_.size(), static_cast<size_t>(milvus::storage::S3_PART_SIZE));
+    }
+
+    int64_t length = 0;
+    ASSERT_TRUE(storage_inst.GetObjectLength(index_name, length).ok());
+    ASSERT_EQ(length, static_cast<int64_t>(content.size()));
+
+    {
+        milvus::storage::S3IOReader reader(index_name);
+        ASSERT_EQ(reader.length(), content.size());
+        ASSERT_TRUE(reader.buffer_ == content);
+    }
+
+    // a failed ranged get falls back to getting the object whole
+    {
+        fiu_enable("S3ClientWrapper.GetObjectRange.outcome.fail", 1, NULL, 0);
+        milvus::storage::S3IOReader reader(index_name);
+        fiu_disable("S3ClientWrapper.GetObjectRange.outcome.fail");
+        ASSERT_TRUE(reader.buffer_ == content);
+    }
+
+    // an object which can't be uploaded in parts is uploaded whole
+    {
+        fiu_enable("S3ClientWrapper.CreateMultipartUpload.outcome.fail", 1, NULL, 0);
+        {
+            milvus::storage::S3IOWriter writer(index_name);
+            writer.write(const_cast<char*>(content.data()), content.size());
+        }
+        fiu_disable("S3ClientWrapper.CreateMultipartUpload.outcome.fail");
+
+        std::string content_out;
+        ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+        ASSERT_TRUE(content_out == content);
+    }
+
+    // a failed part aborts the upload, the object isn't written and the failure is returned
+    {
+        ASSERT_TRUE(storage_inst.DeleteObject(index_name).ok());
+        fiu_enable("S3ClientWrapper.UploadPart.outcome.fail", 1, NULL, 0);
+        milvus::storage::S3IOWriter writer(index_name);
+        writer.write(const_cast<char*>(content.data()), content.size());
+        ASSERT_FALSE(writer.close().ok());
+        fiu_disable("S3ClientWrapper.UploadPart.outcome.fail");
+
+        int64_t length = 0;
+        ASSERT_FALSE(storage_inst.GetObjectLength(index_name, length).ok());
+    }
+
+    storage_inst.StopService();
+}
+
+TEST_F(StorageTest, S3_ASYNC_TEST) {
+    fiu_init(0);
+
+    auto& storage_inst = milvus::storage::S3ClientWrapper::GetInstance();
+    fiu_enable("S3ClientWrapper.StartService.mock_enable", 1, NULL, 0);
+    ASSERT_TRUE(storage_inst.StartService().ok());
+
+    const int64_t object_num = 64;
+    std::vector<std::string> contents;
+    for (int64_t i = 0; i < object_num; ++i) {
+        contents.push_back("content_" + std::to_string(i));
+    }
+
+    std::atomic<int64_t> done(0);
+    auto callback = [&done](const milvus::Status& status) {
+        if (status.ok()) {
+            ++done;
+        }
+    };
+
+    std::vector<std::future<milvus::Status>> futures;
+    for (int64_t i = 0; i < object_num; ++i) {
+        auto name = "/tmp/test_async_" + std::to_string(i);
+        futures.push_back(storage_inst.PutObjectStrAsync(name, contents[i], callback));
+    }
+    for (auto& future : futures) {
+        ASSERT_TRUE(future.get().ok());
+    }
+    ASSERT_EQ(done, object_num);
+
+    futures.clear();
+    std::vector<std::string> contents_out(object_num);
+    for (int64_t i = 0; i < object_num; ++i) {
+        futures.push_back(storage_inst.GetObjectStrAsync("/tmp/test_async_" + std::to_string(i), contents_out[i]));
+    }
+    for (auto& future : futures) {
+        ASSERT_TRUE(future.get().ok());
+    }
+    ASSERT_EQ(contents_out, contents);
+
+    // failures are returned by the future and passed to the callback
+    done = 0;
+    std::string content_out;
+    ASSERT_FALSE(storage_inst.GetObjectStrAsync("/tmp/test_async_not_exist", content_out, callback).get().ok());
+    ASSERT_EQ(done, 0);
+
+    for (int64_t i = 0; i < object_num; ++i) {
+        ASSERT_TRUE(storage_inst.DeleteObjectAsync("/tmp/test_async_" + std::to_string(i)).get().ok());
+    }
+    ASSERT_FALSE(storage_inst.GetObjectStr("/tmp/test_async_0", content_out).ok());
+
+    storage_inst.StopService();
+}
+
 TEST_F(StorageTest, S3_FAIL_TEST) {
     fiu_init(0);
 
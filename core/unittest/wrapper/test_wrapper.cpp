@@ -19,9 +19,15 @@
 #endif
 
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "server/Config.h"
 #include "wrapper/VecIndex.h"
 #include "wrapper/utils.h"
 
+#include <faiss/InvertedLists.h>
+#include <faiss/utils/distances.h>
+#include <omp.h>
+#include <cstdio>
+#include <cstring>
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <gtest/gtest.h>
@@ -52,6 +58,7 @@ class KnowhereWrapperTest
         tempconf.dim = dim;
         tempconf.k = k;
         tempconf.nprobe = 16;
+        tempconf.disk_path = "/tmp/knowhere_diskann";
 
         index_ = GetVecIndexFactory(index_type);
         conf = ParamGenerator::GetInstance().GenBuild(index_type, tempconf);
@@ -87,9 +94,15 @@ INSTANTIATE_TEST_CASE_P(
     // std::make_tuple(milvus::engine::IndexType::SPTAG_KDT_RNT_CPU, "Default", 128, 100, 10, 10),
     // std::make_tuple(milvus::engine::IndexType::SPTAG_BKT_RNT_CPU, "Default", 128, 100, 10, 10),
 	std::make_tuple(milvus::engine::IndexType::HNSW, "Default", 64, 10000, 5, 10),
+	std::make_tuple(milvus::engine::IndexType::HNSW_SQ8, "Default", 64, 10000, 5, 10),
 	std::make_tuple(milvus::engine::IndexType::FAISS_IDMAP, "Default", 64, 1000, 10, 10),
 	std::make_tuple(milvus::engine::IndexType::FAISS_IVFFLAT_CPU, "Default", 64, 1000, 10, 10),
-	std::make_tuple(milvus::engine::IndexType::FAISS_IVFSQ8_CPU, "Default", DIM, NB, 10, 10)));
+	std::make_tuple(milvus::engine::IndexType::FAISS_IVFSQ8_CPU, "Default", DIM, NB, 10, 10),
+	std::make_tuple(milvus::engine::IndexType::FAISS_IVFPQ_REFINE, "Default", 64, 1000, 10, 10),
+	std::make_tuple(milvus::engine::IndexType::FAISS_IVFFP16_CPU, "Default", 64, 1000, 10, 10),
+	std::make_tuple(milvus::engine::IndexType::FAISS_FLAT_FP16, "Default", 64, 1000, 10, 10),
+	std::make_tuple(milvus::engine::IndexType::FAISS_IVFPQ_FASTSCAN, "Default", 64, 1000, 10, 10),
+	std::make_tuple(milvus::engine::IndexType::DISKANN, "Default", 64, 1000, 10, 10)));
 
 #ifdef MILVUS_GPU_VERSION
 TEST_P(KnowhereWrapperTest, WRAPPER_EXCEPTION_TEST) {
@@ -154,7 +167,12 @@ TEST_P(KnowhereWrapperTest, BASE_TEST) {
 
 #ifdef MILVUS_GPU_VERSION
 TEST_P(KnowhereWrapperTest, TO_GPU_TEST) {
-	if (index_type == milvus::engine::IndexType::HNSW) {
+	if (index_type == milvus::engine::IndexType::HNSW || index_type == milvus::engine::IndexType::HNSW_SQ8 ||
+	    index_type == milvus::engine::IndexType::FAISS_IVFPQ_REFINE ||
+	    index_type == milvus::engine::IndexType::FAISS_IVFFP16_CPU ||
+	    index_type == milvus::engine::IndexType::FAISS_FLAT_FP16 ||
+	    index_type == milvus::engine::IndexType::FAISS_IVFPQ_FASTSCAN ||
+	    index_type == milvus::engine::IndexType::DISKANN) {
 		return;
 	}
     EXPECT_EQ(index_->GetType(), index_type);
@@ -213,6 +231,12 @@ TEST_P(KnowhereWrapperTest, SERIALIZE_TEST) {
         std::vector<float> res_dis(elems);
         new_index->Search(nq, xq.data(), res_dis.data(), res_ids.data(), searchconf);
         AssertResult(res_ids, res_dis);
+
+        // refine data is required, a binary set without it fails to load
+        if (type == milvus::engine::IndexType::FAISS_IVFPQ_REFINE) {
+            binary.binary_map_.erase("REFINE_DATA");
+            ASSERT_FALSE(GetVecIndexFactory(type)->Load(binary).ok());
+        }
     }
 
     {
@@ -227,6 +251,40 @@ TEST_P(KnowhereWrapperTest, SERIALIZE_TEST) {
         std::vector<float> res_dis(elems);
         new_index->Search(nq, xq.data(), res_dis.data(), res_ids.data(), searchconf);
         AssertResult(res_ids, res_dis);
+
+        // a single block is read through the directory at the end of the file
+        auto binary = index_->Serialize();
+        for (auto& iter : binary.binary_map_) {
+            knowhere::BinarySet blocks;
+            ASSERT_TRUE(milvus::engine::read_index_blocks(file_location, {iter.first}, blocks).ok());
+            auto block = blocks.GetByName(iter.first);
+            ASSERT_EQ(block->size, iter.second->size);
+            ASSERT_EQ(memcmp(block->data.get(), iter.second->data.get(), block->size), 0);
+        }
+        knowhere::BinarySet blocks;
+        ASSERT_FALSE(milvus::engine::read_index_blocks(file_location, {"not_exist"}, blocks).ok());
+    }
+
+    {
+        // with the list cache on, inverted lists of ivf indexes stay in the mapped file and are paged in on probe
+        std::string file_location = "/tmp/knowhere_lazy";
+        write_index(index_, file_location);
+        auto& config = milvus::server::Config::GetInstance();
+        ASSERT_TRUE(config.SetCacheConfigListCacheCapacity("1").ok());
+        faiss::set_lazy_list_capacity(1 << 20);
+
+        auto new_index = milvus::engine::read_index(file_location);
+        EXPECT_EQ(new_index->Count(), index_->Count());
+        std::vector<int64_t> res_ids(elems);
+        std::vector<float> res_dis(elems);
+        new_index->Search(nq, xq.data(), res_dis.data(), res_ids.data(), searchconf);
+        AssertResult(res_ids, res_dis);
+        EXPECT_LE(faiss::get_lazy_list_usage(), 1 << 20);
+
+        new_index = nullptr;
+        EXPECT_EQ(faiss::get_lazy_list_usage(), 0);
+        ASSERT_TRUE(config.SetCacheConfigListCacheCapacity("0").ok());
+        faiss::set_lazy_list_capacity(0);
     }
 
     {
@@ -249,6 +307,29 @@ TEST_P(KnowhereWrapperTest, SERIALIZE_TEST) {
     }
 }
 
+TEST_P(KnowhereWrapperTest, SHARED_MODEL_TEST) {
+    auto elems = nq * k;
+    std::vector<int64_t> res_ids(elems);
+    std::vector<float> res_dis(elems);
+
+    index_->BuildAll(nb, xb.data(), ids.data(), conf);
+    auto model = index_->TrainedModel();
+    if (model == nullptr) {
+        // only ivf indexes have a model to share
+        return;
+    }
+
+    // built from the model of the first index without training
+    auto new_index = GetVecIndexFactory(index_type);
+    new_index->SetTrainedModel(model);
+    ASSERT_TRUE(new_index->BuildAll(nb, xb.data(), ids.data(), conf).ok());
+    EXPECT_EQ(new_index->TrainedModel(), model);
+    EXPECT_EQ(new_index->Count(), nb);
+
+    new_index->Search(nq, xq.data(), res_dis.data(), res_ids.data(), searchconf);
+    AssertResult(res_ids, res_dis);
+}
+
 #include "wrapper/ConfAdapter.h"
 
 TEST(whatever, test_config) {
@@ -271,6 +352,26 @@ TEST(whatever, test_config) {
     bkt_conf->Match(conf);
     bkt_conf->MatchSearch(conf, milvus::engine::IndexType::SPTAG_BKT_RNT_CPU);
 
+    auto hnsw_conf = std::make_shared<milvus::engine::HNSWConfAdapter>();
+    hnsw_conf->Match(conf);
+    conf.k = 10;
+    auto hnsw_search_conf =
+        std::dynamic_pointer_cast<knowhere::HNSWCfg>(hnsw_conf->MatchSearch(conf, milvus::engine::IndexType::HNSW));
+    ASSERT_NE(hnsw_search_conf, nullptr);
+    ASSERT_EQ(hnsw_search_conf->ef, 16);
+    conf.k = 100;
+    hnsw_search_conf =
+        std::dynamic_pointer_cast<knowhere::HNSWCfg>(hnsw_conf->MatchSearch(conf, milvus::engine::IndexType::HNSW));
+    ASSERT_EQ(hnsw_search_conf->ef, 132);
+
+    auto diskann_conf = std::make_shared<milvus::engine::DiskANNConfAdapter>();
+    auto diskann_build_conf = std::dynamic_pointer_cast<knowhere::DiskANNCfg>(diskann_conf->Match(conf));
+    ASSERT_NE(diskann_build_conf, nullptr);
+    ASSERT_EQ(diskann_build_conf->pq_m, 32);
+    auto diskann_search_conf = std::dynamic_pointer_cast<knowhere::DiskANNCfg>(
+        diskann_conf->MatchSearch(conf, milvus::engine::IndexType::DISKANN));
+    ASSERT_EQ(diskann_search_conf->search_list, 132);
+
     auto config_mgr = milvus::engine::AdapterMgr::GetInstance();
     try {
         config_mgr.GetAdapter(milvus::engine::IndexType::INVALID);
@@ -282,6 +383,22 @@ TEST(whatever, test_config) {
     conf.nlist = 10;
     auto ivf_conf = std::make_shared<milvus::engine::IVFConfAdapter>();
     ivf_conf->Match(conf);
+
+    // nlist is that of a million rows, smaller files get lists of as many rows
+    conf.nlist = 16384;
+    auto ivf_build_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(ivf_conf->Match(conf));
+    ASSERT_EQ(ivf_build_conf->nlist, 16384);
+    conf.size = 100000;
+    ivf_build_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(ivf_conf->Match(conf));
+    ASSERT_EQ(ivf_build_conf->nlist, 1638);
+    conf.size = 1000;
+    ivf_build_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(ivf_conf->Match(conf));
+    ASSERT_EQ(ivf_build_conf->nlist, 16);
+    conf.nlist = 65536;
+    ivf_build_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(ivf_conf->Match(conf));
+    ASSERT_EQ(ivf_build_conf->nlist, 25);
+    conf.size = 1000000.0;
+    conf.nlist = 10;
     conf.nprobe = -1;
     ivf_conf->MatchSearch(conf, milvus::engine::IndexType::FAISS_IVFFLAT_GPU);
     conf.nprobe = 4096;
@@ -333,6 +450,84 @@ TEST(BFIndex, test_bf_index_fail) {
     fiu_disable("BFIndex.Build.throw_std_exception");
 }
 
+TEST(HNSWIndex, test_ip_distance) {
+    int dim = 64, nb = 2000, nq = 10, k = 10;
+    std::vector<float> xb, xq, gt_dis;
+    std::vector<int64_t> ids, gt_ids;
+    DataGenBase().GenData(dim, nb, nq, xb, xq, ids, k, gt_ids, gt_dis);
+
+    milvus::engine::TempMetaConf tempconf;
+    tempconf.metric_type = knowhere::METRICTYPE::IP;
+    tempconf.size = nb;
+    tempconf.dim = dim;
+    tempconf.k = k;
+    for (auto type : {milvus::engine::IndexType::HNSW, milvus::engine::IndexType::HNSW_SQ8}) {
+        auto index = GetVecIndexFactory(type);
+        auto conf = ParamGenerator::GetInstance().GenBuild(type, tempconf);
+        auto searchconf = ParamGenerator::GetInstance().GenSearchConf(type, tempconf);
+        ASSERT_TRUE(index->BuildAll(nb, xb.data(), ids.data(), conf).ok());
+
+        std::vector<int64_t> res_ids(nq * k);
+        std::vector<float> res_dis(nq * k);
+        ASSERT_TRUE(index->Search(nq, xq.data(), res_dis.data(), res_ids.data(), searchconf).ok());
+
+        // inner products of the raw vectors, in descending order as the other ip indexes return them
+        float tolerance = type == milvus::engine::IndexType::HNSW ? 1e-4 : 0.05;
+        for (int i = 0; i < nq; i++) {
+            for (int j = 0; j < k; j++) {
+                ASSERT_GE(res_ids[i * k + j], 0);
+                const float* x = xb.data() + res_ids[i * k + j] * dim;
+                float ip = 0;
+                for (int d = 0; d < dim; d++) {
+                    ip += xq[i * dim + d] * x[d];
+                }
+                ASSERT_NEAR(res_dis[i * k + j], ip, tolerance * (1 + std::abs(ip)));
+                if (j > 0) {
+                    ASSERT_GE(res_dis[i * k + j - 1], res_dis[i * k + j]);
+                }
+            }
+        }
+    }
+}
+
+#include "wrapper/BlasCalibration.h"
+
+TEST(BlasCalibration, test_crossover) {
+    auto& calibration = milvus::engine::BlasCalibration::GetInstance();
+    ASSERT_EQ(calibration.Crossover(36, 4096, 1), -1);
+
+    calibration.SetCrossover(36, 4096, 1, 8);
+    calibration.SetCrossover(36, 65536, 1, 32);
+    calibration.SetCrossover(36, 65536, 8, 64);
+    ASSERT_EQ(calibration.Crossover(36, 4096, 1), 8);
+    ASSERT_EQ(calibration.Crossover(36, 1000, 8), 8);
+    ASSERT_EQ(calibration.Crossover(36, 100000, 1), 32);
+    ASSERT_EQ(calibration.Crossover(36, 100000, 6), 64);
+    ASSERT_EQ(calibration.Crossover(40, 4096, 1), -1);
+
+    omp_set_num_threads(1);
+    ASSERT_FALSE(calibration.UseBlas(36, 4, 4096));
+    ASSERT_TRUE(calibration.UseBlas(36, 8, 4096));
+    ASSERT_FALSE(calibration.UseBlas(36, 16, 65536));
+
+    // dims not measured follow use_blas_threshold
+    faiss::distance_compute_blas_threshold = 20;
+    ASSERT_FALSE(calibration.UseBlas(40, 19, 4096));
+    ASSERT_TRUE(calibration.UseBlas(40, 20, 4096));
+
+    std::string path = "/tmp/milvus_blas_calibration";
+    ASSERT_TRUE(calibration.Calibrate({12, 13}, {1}, path).ok());
+    ASSERT_GT(calibration.Crossover(12, 4096, 1), 0);
+    ASSERT_EQ(calibration.Crossover(13, 4096, 1), -1);
+
+    // measures stored are loaded again
+    calibration.SetCrossover(12, 4096, 1, 100000);
+    ASSERT_TRUE(calibration.Load(path).ok());
+    ASSERT_NE(calibration.Crossover(12, 4096, 1), 100000);
+    ASSERT_EQ(calibration.Crossover(36, 65536, 8), 64);
+    std::remove(path.c_str());
+}
+
 // #include "knowhere/index/vector_index/IndexIDMAP.h"
 // #include "src/wrapper/VecImpl.h"
 // #include "src/index/unittest/utils.h"
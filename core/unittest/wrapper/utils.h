@@ -155,9 +155,19 @@ class ParamGenerator {
                 tempconf->metric_type = knowhere::METRICTYPE::L2;
                 return tempconf;
             }
+            case milvus::engine::IndexType::FAISS_IVFFP16_CPU:
+            case milvus::engine::IndexType::FAISS_FLAT_FP16: {
+                auto tempconf = std::make_shared<knowhere::IVFSQCfg>();
+                tempconf->nlist = type == milvus::engine::IndexType::FAISS_FLAT_FP16 ? 1 : 100;
+                tempconf->nprobe = 16;
+                tempconf->nbits = knowhere::SQ_FP16_NBITS;
+                tempconf->metric_type = knowhere::METRICTYPE::L2;
+                return tempconf;
+            }
             case milvus::engine::IndexType::FAISS_IVFPQ_CPU:
             case milvus::engine::IndexType::FAISS_IVFPQ_GPU:
-            case milvus::engine::IndexType::FAISS_IVFPQ_MIX: {
+            case milvus::engine::IndexType::FAISS_IVFPQ_MIX:
+            case milvus::engine::IndexType::FAISS_IVFPQ_REFINE: {
                 auto tempconf = std::make_shared<knowhere::IVFPQCfg>();
                 tempconf->nlist = 100;
                 tempconf->nprobe = 16;
@@ -166,6 +176,25 @@ class ParamGenerator {
                 tempconf->metric_type = knowhere::METRICTYPE::L2;
                 return tempconf;
             }
+            case milvus::engine::IndexType::FAISS_IVFPQ_FASTSCAN: {
+                auto tempconf = std::make_shared<knowhere::IVFPQCfg>();
+                tempconf->nlist = 100;
+                tempconf->nprobe = 16;
+                tempconf->nbits = 4;
+                tempconf->m = 16;
+                tempconf->metric_type = knowhere::METRICTYPE::L2;
+                return tempconf;
+            }
+            case milvus::engine::IndexType::DISKANN: {
+                auto tempconf = std::make_shared<knowhere::DiskANNCfg>();
+                tempconf->max_degree = 32;
+                tempconf->build_list = 64;
+                tempconf->search_list = 64;
+                tempconf->pq_m = 16;
+                tempconf->disk_path = "/tmp/knowhere_diskann";
+                tempconf->metric_type = knowhere::METRICTYPE::L2;
+                return tempconf;
+            }
             case milvus::engine::IndexType::NSG_MIX: {
                 auto tempconf = std::make_shared<knowhere::NSGCfg>();
                 tempconf->nlist = 100;
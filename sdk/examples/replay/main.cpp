@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <getopt.h>
+#include <libgen.h>
+#include <cstring>
+#include <string>
+
+#include "src/Replayer.h"
+
+void
+print_help(const std::string& app_name);
+
+int
+main(int argc, char* argv[]) {
+    std::string app_name = basename(argv[0]);
+    static struct option long_options[] = {{"server", optional_argument, nullptr, 's'},
+                                           {"port", optional_argument, nullptr, 'p'},
+                                           {"file", required_argument, nullptr, 'f'},
+                                           {"speed", optional_argument, nullptr, 'x'},
+                                           {"concurrency", optional_argument, nullptr, 'c'},
+                                           {"table", optional_argument, nullptr, 't'},
+                                           {"help", no_argument, nullptr, 'h'},
+                                           {nullptr, 0, nullptr, 0}};
+
+    int option_index = 0;
+    std::string address = "127.0.0.1", port = "19530", file, table_name;
+    double speed = 1.0;
+    int64_t concurrency = 8;
+
+    int value;
+    while ((value = getopt_long(argc, argv, "s:p:f:x:c:t:h", long_options, &option_index)) != -1) {
+        switch (value) {
+            case 's':
+                address = optarg;
+                break;
+            case 'p':
+                port = optarg;
+                break;
+            case 'f':
+                file = optarg;
+                break;
+            case 'x':
+                speed = std::stod(optarg);
+                break;
+            case 'c':
+                concurrency = std::stoll(optarg);
+                break;
+            case 't':
+                table_name = optarg;
+                break;
+            case 'h':
+            default:
+                print_help(app_name);
+                return EXIT_SUCCESS;
+        }
+    }
+
+    if (file.empty()) {
+        print_help(app_name);
+        return EXIT_FAILURE;
+    }
+
+    Replayer replayer;
+    if (!replayer.Load(file)) {
+        return EXIT_FAILURE;
+    }
+    replayer.Run(address, port, speed, concurrency, table_name);
+    return 0;
+}
+
+void
+print_help(const std::string& app_name) {
+    printf("\n Usage: %s [OPTIONS]\n\n", app_name.c_str());
+    printf("  Options:\n");
+    printf("   -s --server        Server address, default 127.0.0.1\n");
+    printf("   -p --port          Server port, default 19530\n");
+    printf("   -f --file          Capture file written by server_config.query_capture_path, required\n");
+    printf("   -x --speed         Pace relative to the capture, 2 is twice as fast, 0 as fast as possible, default 1\n");
+    printf("   -c --concurrency   Requests in flight at most, default 8\n");
+    printf("   -t --table         Send all requests to this table instead of the captured ones\n");
+    printf("   -h --help          Print help information\n");
+    printf("\n");
+}
@@ -0,0 +1,183 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "examples/replay/src/Replayer.h"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "grpc-gen/gen-milvus/milvus.grpc.pb.h"
+
+namespace {
+
+constexpr char QUERY_CAPTURE_MAGIC[] = "MVQCAP01";
+constexpr size_t QUERY_CAPTURE_MAGIC_SIZE = sizeof(QUERY_CAPTURE_MAGIC) - 1;
+
+bool
+ReadLittleEndian(std::ifstream& file, uint64_t& value, size_t bytes) {
+    unsigned char buf[sizeof(uint64_t)];
+    if (!file.read(reinterpret_cast<char*>(buf), bytes)) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(buf[i]) << (8 * i);
+    }
+    return true;
+}
+
+double
+Percentile(const std::vector<double>& sorted, double ratio) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(ratio * sorted.size()));
+    return sorted[index];
+}
+
+}  // namespace
+
+bool
+Replayer::Load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Failed to open capture file: " << path << std::endl;
+        return false;
+    }
+
+    char magic[QUERY_CAPTURE_MAGIC_SIZE];
+    if (!file.read(magic, QUERY_CAPTURE_MAGIC_SIZE) || memcmp(magic, QUERY_CAPTURE_MAGIC, QUERY_CAPTURE_MAGIC_SIZE)) {
+        std::cout << path << " is not a query capture file" << std::endl;
+        return false;
+    }
+
+    requests_.clear();
+    std::string message;
+    while (true) {
+        uint64_t arrival_us = 0, length = 0;
+        if (!ReadLittleEndian(file, arrival_us, sizeof(int64_t)) ||
+            !ReadLittleEndian(file, length, sizeof(uint32_t))) {
+            break;
+        }
+        message.resize(length);
+        if (!file.read(&message[0], length)) {
+            break;
+        }
+
+        // the records after a corrupted one are misaligned, the server cuts the file there before it appends
+        CapturedRequest request;
+        request.arrival_us_ = static_cast<int64_t>(arrival_us);
+        if (!request.param_.ParseFromString(message)) {
+            std::cout << "Stop at a corrupted request at record " << requests_.size() << std::endl;
+            break;
+        }
+        requests_.emplace_back(std::move(request));
+    }
+
+    // a server restarted between captures appends to the file, arrivals are replayed in order
+    std::stable_sort(requests_.begin(), requests_.end(), [](const CapturedRequest& a, const CapturedRequest& b) {
+        return a.arrival_us_ < b.arrival_us_;
+    });
+    std::cout << "Loaded " << requests_.size() << " requests from " << path << std::endl;
+    return true;
+}
+
+void
+Replayer::Run(const std::string& address, const std::string& port, double speed, int64_t concurrency,
+              const std::string& table_name) {
+    if (requests_.empty()) {
+        return;
+    }
+
+    auto channel = ::grpc::CreateChannel(address + ":" + port, ::grpc::InsecureChannelCredentials());
+    auto stub = ::milvus::grpc::MilvusService::NewStub(channel);
+
+    if (!table_name.empty()) {
+        for (auto& request : requests_) {
+            request.param_.set_table_name(table_name);
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    std::atomic<size_t> next{0};
+    std::atomic<int64_t> failed{0};
+    std::atomic<int64_t> late{0};
+    std::mutex latency_mutex;
+    std::vector<double> latencies_ms;
+    latencies_ms.reserve(requests_.size());
+
+    int64_t first_arrival_us = requests_.front().arrival_us_;
+    auto start = Clock::now();
+    auto worker = [&]() {
+        while (true) {
+            size_t index = next.fetch_add(1);
+            if (index >= requests_.size()) {
+                break;
+            }
+
+            auto& request = requests_[index];
+            if (speed > 0) {
+                auto offset_us = static_cast<int64_t>((request.arrival_us_ - first_arrival_us) / speed);
+                auto scheduled = start + std::chrono::microseconds(offset_us);
+                if (Clock::now() > scheduled + std::chrono::milliseconds(10)) {
+                    ++late;  // not enough workers to keep the pace
+                }
+                std::this_thread::sleep_until(scheduled);
+            }
+
+            ::grpc::ClientContext context;
+            ::milvus::grpc::TopKQueryResult result;
+            auto send = Clock::now();
+            ::grpc::Status status = stub->Search(&context, request.param_, &result);
+            double latency_ms = std::chrono::duration<double, std::milli>(Clock::now() - send).count();
+            if (!status.ok() || result.status().error_code() != ::milvus::grpc::SUCCESS) {
+                ++failed;
+            }
+
+            std::lock_guard<std::mutex> lock(latency_mutex);
+            latencies_ms.push_back(latency_ms);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int64_t i = 0; i < std::max<int64_t>(concurrency, 1); ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    double elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    double total_ms = 0.0;
+    for (auto latency : latencies_ms) {
+        total_ms += latency;
+    }
+
+    std::cout << "Replayed " << latencies_ms.size() << " requests in " << elapsed_s << " s, "
+              << latencies_ms.size() / std::max(elapsed_s, 1e-6) << " qps" << std::endl;
+    std::cout << "Failed: " << failed << ", sent late: " << late << std::endl;
+    std::cout << "Latency ms: avg " << total_ms / latencies_ms.size() << ", p50 " << Percentile(latencies_ms, 0.5)
+              << ", p90 " << Percentile(latencies_ms, 0.9) << ", p99 " << Percentile(latencies_ms, 0.99) << ", max "
+              << latencies_ms.back() << std::endl;
+}
@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "grpc-gen/gen-milvus/milvus.pb.h"
+
+// replays search requests captured by a server with server_config.query_capture_path, see
+// core/src/server/grpc_impl/QueryCapture.h for the file format
+class Replayer {
+ public:
+    // false if the file can't be read or isn't a capture file, reading stops at a truncated or corrupted record
+    bool
+    Load(const std::string& path);
+
+    // speed scales the captured pacing, 2 replays twice as fast, 0 sends as fast as the workers can;
+    // table_name redirects all requests to another table when not empty
+    void
+    Run(const std::string& address, const std::string& port, double speed, int64_t concurrency,
+        const std::string& table_name);
+
+ private:
+    struct CapturedRequest {
+        int64_t arrival_us_ = 0;
+        ::milvus::grpc::SearchParam param_;
+    };
+
+    std::vector<CapturedRequest> requests_;
+};
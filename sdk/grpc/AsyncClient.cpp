@@ -0,0 +1,116 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "grpc/AsyncClient.h"
+
+#include <iostream>
+#include <utility>
+
+namespace milvus {
+
+AsyncClient::AsyncClient(const std::vector<std::shared_ptr<::grpc::Channel>>& channels, int64_t max_in_flight)
+    : max_in_flight_(max_in_flight) {
+    for (auto& channel : channels) {
+        stubs_.emplace_back(::milvus::grpc::MilvusService::NewStub(channel));
+    }
+    poll_thread_ = std::thread(&AsyncClient::Poll, this);
+}
+
+AsyncClient::~AsyncClient() {
+    Wait();
+    cq_.Shutdown();
+    poll_thread_.join();
+}
+
+void
+AsyncClient::Insert(const ::milvus::grpc::InsertParam& insert_param, const InsertDone& done) {
+    Acquire();
+    auto call = new UnaryCall<::milvus::grpc::VectorIds>();
+    call->done_ = done;
+    call->reader_ = NextStub().PrepareAsyncInsert(&call->context_, insert_param, &cq_);
+    call->reader_->StartCall();
+    call->reader_->Finish(&call->reply_, &call->grpc_status_, call);
+}
+
+void
+AsyncClient::Search(const ::milvus::grpc::SearchParam& search_param, const SearchDone& done) {
+    Acquire();
+    auto call = new UnaryCall<::milvus::grpc::TopKQueryResult>();
+    call->done_ = done;
+    call->reader_ = NextStub().PrepareAsyncSearch(&call->context_, search_param, &cq_);
+    call->reader_->StartCall();
+    call->reader_->Finish(&call->reply_, &call->grpc_status_, call);
+}
+
+void
+AsyncClient::Wait() {
+    std::unique_lock<std::mutex> lock(in_flight_mutex_);
+    in_flight_cv_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+bool
+AsyncClient::InCallback() const {
+    return std::this_thread::get_id() == poll_thread_.get_id();
+}
+
+::milvus::grpc::MilvusService::Stub&
+AsyncClient::NextStub() {
+    return *stubs_[next_stub_.fetch_add(1, std::memory_order_relaxed) % stubs_.size()];
+}
+
+void
+AsyncClient::Acquire() {
+    std::unique_lock<std::mutex> lock(in_flight_mutex_);
+    // slots are freed on the polling thread, a callback waiting for one would never wake up
+    if (max_in_flight_ > 0 && !InCallback()) {
+        in_flight_cv_.wait(lock, [this] { return in_flight_ < max_in_flight_; });
+    }
+    ++in_flight_;
+    ++unfinished_;
+}
+
+void
+AsyncClient::Release() {
+    {
+        std::lock_guard<std::mutex> lock(in_flight_mutex_);
+        --in_flight_;
+    }
+    in_flight_cv_.notify_all();
+}
+
+void
+AsyncClient::Finished() {
+    {
+        std::lock_guard<std::mutex> lock(in_flight_mutex_);
+        --unfinished_;
+    }
+    in_flight_cv_.notify_all();
+}
+
+void
+AsyncClient::Poll() {
+    void* tag = nullptr;
+    bool ok = false;
+    while (cq_.Next(&tag, &ok)) {
+        std::unique_ptr<Call> call(static_cast<Call*>(tag));
+        Release();
+        try {
+            call->Finish(ok);
+        } catch (std::exception& ex) {
+            std::cerr << "Async call callback failed: " << ex.what() << std::endl;
+        }
+        call.reset();
+        Finished();
+    }
+}
+
+}  // namespace milvus
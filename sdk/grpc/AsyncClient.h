@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "MilvusApi.h"
+#include "grpc-gen/gen-milvus/milvus.grpc.pb.h"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace milvus {
+
+// Insert and Search issued without blocking, spread over a pool of channels. Completions of all calls are polled
+// from one CompletionQueue by a thread of the client, the callbacks run on that thread. A call frees its slot before
+// its callback runs, so a callback may issue new calls, it must not Wait() or destroy the client.
+class AsyncClient {
+ public:
+    using InsertDone = std::function<void(const Status& status, ::milvus::grpc::VectorIds& vector_ids)>;
+    using SearchDone = std::function<void(const Status& status, ::milvus::grpc::TopKQueryResult& result)>;
+
+    // max_in_flight bounds the calls issued and not completed yet, 0 means unbounded
+    AsyncClient(const std::vector<std::shared_ptr<::grpc::Channel>>& channels, int64_t max_in_flight);
+
+    // waits for the calls in flight
+    ~AsyncClient();
+
+    // the param is serialized before returning, blocks only while max_in_flight calls are outstanding,
+    // never blocks in a callback
+    void
+    Insert(const ::milvus::grpc::InsertParam& insert_param, const InsertDone& done);
+
+    void
+    Search(const ::milvus::grpc::SearchParam& search_param, const SearchDone& done);
+
+    // blocks until the callbacks of all calls issued so far have returned
+    void
+    Wait();
+
+    // true on the thread running the callbacks
+    bool
+    InCallback() const;
+
+ private:
+    struct Call {
+        virtual ~Call() = default;
+
+        virtual void
+        Finish(bool ok) = 0;
+
+        ::grpc::ClientContext context_;
+        ::grpc::Status grpc_status_;
+    };
+
+    template <typename Reply>
+    struct UnaryCall : public Call {
+        void
+        Finish(bool ok) override {
+            Status status = Status::OK();
+            if (ok && grpc_status_.error_code() == ::grpc::StatusCode::RESOURCE_EXHAUSTED) {
+                status = Status(StatusCode::ServerBusy, grpc_status_.error_message());
+            } else if (ok && grpc_status_.error_code() == ::grpc::StatusCode::UNAVAILABLE) {
+                status = Status(StatusCode::ServerUnavailable, grpc_status_.error_message());
+            } else if (!ok || !grpc_status_.ok()) {
+                status = Status(StatusCode::RPCFailed, grpc_status_.error_message());
+            } else if (reply_.status().error_code() != ::milvus::grpc::SUCCESS) {
+                status = Status(StatusCode::ServerFailed, reply_.status().reason());
+            }
+            done_(status, reply_);
+        }
+
+        Reply reply_;
+        std::unique_ptr<::grpc::ClientAsyncResponseReader<Reply>> reader_;
+        std::function<void(const Status&, Reply&)> done_;
+    };
+
+    ::milvus::grpc::MilvusService::Stub&
+    NextStub();
+
+    void
+    Acquire();
+
+    void
+    Release();
+
+    void
+    Finished();
+
+    void
+    Poll();
+
+ private:
+    std::vector<std::unique_ptr<::milvus::grpc::MilvusService::Stub>> stubs_;
+    std::atomic<uint64_t> next_stub_{0};
+    ::grpc::CompletionQueue cq_;
+    std::thread poll_thread_;
+
+    int64_t max_in_flight_ = 0;
+    int64_t in_flight_ = 0;
+    int64_t unfinished_ = 0;  // calls whose callback hasn't returned yet
+    std::mutex in_flight_mutex_;
+    std::condition_variable in_flight_cv_;
+};
+
+}  // namespace milvus
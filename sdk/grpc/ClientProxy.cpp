@@ -12,8 +12,10 @@
 #include "grpc/ClientProxy.h"
 #include "grpc-gen/gen-milvus/milvus.grpc.pb.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 //#define GRPC_MULTIPLE_THREAD;
@@ -39,14 +41,94 @@ CopyRowRecord(::milvus::grpc::RowRecord* target, const RowRecord& src) {
     }
 }
 
+void
+ConstructInsertParam(const std::string& table_name, const std::string& partition_tag,
+                     const std::vector<RowRecord>& record_array, const std::vector<int64_t>& id_array,
+                     ::milvus::grpc::InsertParam& insert_param) {
+    insert_param.set_table_name(table_name);
+    insert_param.set_partition_tag(partition_tag);
+
+    for (auto& record : record_array) {
+        ::milvus::grpc::RowRecord* grpc_record = insert_param.add_row_record_array();
+        CopyRowRecord(grpc_record, record);
+    }
+
+    if (!id_array.empty()) {
+        /* set user's ids */
+        auto row_ids = insert_param.mutable_row_id_array();
+        row_ids->Resize(static_cast<int>(id_array.size()), -1);
+        memcpy(row_ids->mutable_data(), id_array.data(), id_array.size() * sizeof(int64_t));
+    }
+}
+
+void
+ConstructSearchParam(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                     const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                     int64_t topk, int64_t nprobe, ::milvus::grpc::SearchParam& search_param) {
+    // step 1: convert vectors data
+    search_param.set_table_name(table_name);
+    search_param.set_topk(topk);
+    search_param.set_nprobe(nprobe);
+    for (auto& tag : partition_tags) {
+        search_param.add_partition_tag_array(tag);
+    }
+    for (auto& record : query_record_array) {
+        ::milvus::grpc::RowRecord* row_record = search_param.add_query_record_array();
+        CopyRowRecord(row_record, record);
+    }
+
+    // step 2: convert range array
+    for (auto& range : query_range_array) {
+        ::milvus::grpc::Range* grpc_range = search_param.add_query_range_array();
+        grpc_range->set_start_value(range.start_value);
+        grpc_range->set_end_value(range.end_value);
+    }
+}
+
+void
+ConstructTopKQueryResult(const ::milvus::grpc::TopKQueryResult& result, TopKQueryResult& topk_query_result) {
+    if (result.row_num() == 0) {
+        return;
+    }
+
+    topk_query_result.reserve(result.row_num());
+    int64_t nq = result.row_num();
+    int64_t topk = result.ids().size() / nq;
+    for (int64_t i = 0; i < result.row_num(); i++) {
+        milvus::QueryResult one_result;
+        one_result.ids.resize(topk);
+        one_result.distances.resize(topk);
+        memcpy(one_result.ids.data(), result.ids().data() + topk * i, topk * sizeof(int64_t));
+        memcpy(one_result.distances.data(), result.distances().data() + topk * i, topk * sizeof(float));
+        topk_query_result.emplace_back(one_result);
+    }
+}
+
 Status
 ClientProxy::Connect(const ConnectParam& param) {
+    if (async_client_ptr_ != nullptr && async_client_ptr_->InCallback()) {
+        return Status(StatusCode::NotSupported, "can't reconnect in a callback of an async request");
+    }
+
     std::string uri = param.ip_address + ":" + param.port;
 
-    channel_ = ::grpc::CreateChannel(uri, ::grpc::InsecureChannelCredentials());
-    if (channel_ != nullptr) {
+    // channels with different arguments don't share a connection, so that async requests use all of them
+    std::vector<std::shared_ptr<::grpc::Channel>> channels;
+    for (int64_t i = 0; i < std::max<int64_t>(param.channel_num, 1); ++i) {
+        ::grpc::ChannelArguments args;
+        args.SetInt("milvus.channel_index", static_cast<int>(i));
+        auto channel = ::grpc::CreateCustomChannel(uri, ::grpc::InsecureChannelCredentials(), args);
+        if (channel == nullptr) {
+            break;
+        }
+        channels.push_back(channel);
+    }
+
+    if (!channels.empty()) {
+        channel_ = channels.front();
         connected_ = true;
         client_ptr_ = std::make_shared<GrpcClient>(channel_);
+        async_client_ptr_ = std::make_shared<AsyncClient>(channels, param.max_in_flight);
         return Status::OK();
     }
 
@@ -81,7 +163,12 @@ ClientProxy::Connected() const {
 
 Status
 ClientProxy::Disconnect() {
+    if (async_client_ptr_ != nullptr && async_client_ptr_->InCallback()) {
+        return Status(StatusCode::NotSupported, "can't disconnect in a callback of an async request");
+    }
+
     try {
+        async_client_ptr_.reset();
         Status status = client_ptr_->Disconnect();
         connected_ = false;
         channel_.reset();
@@ -191,21 +278,11 @@ ClientProxy::Insert(const std::string& table_name, const std::string& partition_
         }
 #else
         ::milvus::grpc::InsertParam insert_param;
-        insert_param.set_table_name(table_name);
-        insert_param.set_partition_tag(partition_tag);
-
-        for (auto& record : record_array) {
-            ::milvus::grpc::RowRecord* grpc_record = insert_param.add_row_record_array();
-            CopyRowRecord(grpc_record, record);
-        }
+        ConstructInsertParam(table_name, partition_tag, record_array, id_array, insert_param);
 
         // Single thread
         ::milvus::grpc::VectorIds vector_ids;
         if (!id_array.empty()) {
-            /* set user's ids */
-            auto row_ids = insert_param.mutable_row_id_array();
-            row_ids->Resize(static_cast<int>(id_array.size()), -1);
-            memcpy(row_ids->mutable_data(), id_array.data(), id_array.size() * sizeof(int64_t));
             client_ptr_->Insert(vector_ids, insert_param, status);
         } else {
             client_ptr_->Insert(vector_ids, insert_param, status);
@@ -221,56 +298,152 @@ ClientProxy::Insert(const std::string& table_name, const std::string& partition_
 }
 
 Status
-ClientProxy::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
-                    const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
-                    int64_t topk, int64_t nprobe, TopKQueryResult& topk_query_result) {
+ClientProxy::Insert(const std::string& table_name, const std::string& partition_tag, const float* data,
+                    int64_t row_count, int64_t dimension, const int64_t* ids, std::vector<int64_t>& id_array) {
+    if (data == nullptr || row_count <= 0 || dimension <= 0) {
+        return Status(StatusCode::InvalidAgument, "invalid vector buffer");
+    }
+
+    Status status = Status::OK();
     try {
-        // step 1: convert vectors data
-        ::milvus::grpc::SearchParam search_param;
-        search_param.set_table_name(table_name);
-        search_param.set_topk(topk);
-        search_param.set_nprobe(nprobe);
-        for (auto& tag : partition_tags) {
-            search_param.add_partition_tag_array(tag);
+        ::milvus::grpc::InsertParam insert_param;
+        insert_param.set_table_name(table_name);
+        insert_param.set_partition_tag(partition_tag);
+
+        // each row goes as packed little endian floats, so it is copied once straight into the request
+        size_t row_bytes = dimension * sizeof(float);
+        auto records = insert_param.mutable_row_record_array();
+        records->Reserve(static_cast<int>(row_count));
+        for (int64_t i = 0; i < row_count; ++i) {
+            records->Add()->set_binary_data(reinterpret_cast<const char*>(data + i * dimension), row_bytes);
         }
-        for (auto& record : query_record_array) {
-            ::milvus::grpc::RowRecord* row_record = search_param.add_query_record_array();
-            CopyRowRecord(row_record, record);
+
+        if (ids != nullptr) {
+            auto row_ids = insert_param.mutable_row_id_array();
+            row_ids->Resize(static_cast<int>(row_count), -1);
+            memcpy(row_ids->mutable_data(), ids, row_count * sizeof(int64_t));
         }
 
-        // step 2: convert range array
-        for (auto& range : query_range_array) {
-            ::milvus::grpc::Range* grpc_range = search_param.add_query_range_array();
-            grpc_range->set_start_value(range.start_value);
-            grpc_range->set_end_value(range.end_value);
+        ::milvus::grpc::VectorIds vector_ids;
+        client_ptr_->Insert(vector_ids, insert_param, status);
+        if (ids != nullptr) {
+            id_array.assign(ids, ids + row_count);
+        } else {
+            /* return Milvus generated ids back to user */
+            id_array.assign(vector_ids.vector_id_array().begin(), vector_ids.vector_id_array().end());
         }
+    } catch (std::exception& ex) {
+        return Status(StatusCode::UnknownError, "fail to add vector: " + std::string(ex.what()));
+    }
+
+    return status;
+}
+
+Status
+ClientProxy::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                    const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                    int64_t topk, int64_t nprobe, TopKQueryResult& topk_query_result) {
+    try {
+        ::milvus::grpc::SearchParam search_param;
+        ConstructSearchParam(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe,
+                             search_param);
 
         // step 3: search vectors
         ::milvus::grpc::TopKQueryResult result;
         Status status = client_ptr_->Search(result, search_param);
-        if (result.row_num() == 0) {
-            return status;
-        }
 
         // step 4: convert result array
-        topk_query_result.reserve(result.row_num());
-        int64_t nq = result.row_num();
-        int64_t topk = result.ids().size() / nq;
-        for (int64_t i = 0; i < result.row_num(); i++) {
-            milvus::QueryResult one_result;
-            one_result.ids.resize(topk);
-            one_result.distances.resize(topk);
-            memcpy(one_result.ids.data(), result.ids().data() + topk * i, topk * sizeof(int64_t));
-            memcpy(one_result.distances.data(), result.distances().data() + topk * i, topk * sizeof(float));
-            topk_query_result.emplace_back(one_result);
-        }
+        ConstructTopKQueryResult(result, topk_query_result);
+        return status;
+    } catch (std::exception& ex) {
+        return Status(StatusCode::UnknownError, "fail to search vectors: " + std::string(ex.what()));
+    }
+}
 
+Status
+ClientProxy::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                    const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                    int64_t topk, int64_t nprobe, FlatQueryResult& flat_query_result) {
+    try {
+        ::milvus::grpc::SearchParam search_param;
+        ConstructSearchParam(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe,
+                             search_param);
+
+        ::milvus::grpc::TopKQueryResult result;
+        Status status = client_ptr_->Search(result, search_param);
+
+        // the response is already row-major, so each array is copied in one piece
+        flat_query_result.row_num = result.row_num();
+        flat_query_result.topk = (result.row_num() > 0) ? result.ids().size() / result.row_num() : 0;
+        flat_query_result.ids.assign(result.ids().begin(), result.ids().end());
+        flat_query_result.distances.assign(result.distances().begin(), result.distances().end());
         return status;
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "fail to search vectors: " + std::string(ex.what()));
     }
 }
 
+Status
+ClientProxy::InsertAsync(const std::string& table_name, const std::string& partition_tag,
+                         const std::vector<RowRecord>& record_array, const std::vector<int64_t>& id_array,
+                         const InsertCallback& callback) {
+    if (async_client_ptr_ == nullptr) {
+        return Status(StatusCode::NotConnected, "not connected to server");
+    }
+
+    try {
+        ::milvus::grpc::InsertParam insert_param;
+        ConstructInsertParam(table_name, partition_tag, record_array, id_array, insert_param);
+        async_client_ptr_->Insert(insert_param,
+                                  [callback](const Status& status, ::milvus::grpc::VectorIds& vector_ids) {
+                                      std::vector<int64_t> ids(vector_ids.vector_id_array().begin(),
+                                                               vector_ids.vector_id_array().end());
+                                      callback(status, std::move(ids));
+                                  });
+        return Status::OK();
+    } catch (std::exception& ex) {
+        return Status(StatusCode::UnknownError, "fail to add vector: " + std::string(ex.what()));
+    }
+}
+
+Status
+ClientProxy::SearchAsync(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                         const std::vector<RowRecord>& query_record_array,
+                         const std::vector<Range>& query_range_array, int64_t topk, int64_t nprobe,
+                         const SearchCallback& callback) {
+    if (async_client_ptr_ == nullptr) {
+        return Status(StatusCode::NotConnected, "not connected to server");
+    }
+
+    try {
+        ::milvus::grpc::SearchParam search_param;
+        ConstructSearchParam(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe,
+                             search_param);
+        async_client_ptr_->Search(search_param,
+                                  [callback](const Status& status, ::milvus::grpc::TopKQueryResult& result) {
+                                      TopKQueryResult topk_query_result;
+                                      ConstructTopKQueryResult(result, topk_query_result);
+                                      callback(status, std::move(topk_query_result));
+                                  });
+        return Status::OK();
+    } catch (std::exception& ex) {
+        return Status(StatusCode::UnknownError, "fail to search vectors: " + std::string(ex.what()));
+    }
+}
+
+Status
+ClientProxy::WaitAsync() {
+    if (async_client_ptr_ == nullptr) {
+        return Status(StatusCode::NotConnected, "not connected to server");
+    }
+    if (async_client_ptr_->InCallback()) {
+        return Status(StatusCode::NotSupported, "can't wait for async requests in their callback");
+    }
+
+    async_client_ptr_->Wait();
+    return Status::OK();
+}
+
 Status
 ClientProxy::DescribeTable(const std::string& table_name, TableSchema& table_schema) {
     try {
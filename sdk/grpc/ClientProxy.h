@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "AsyncClient.h"
 #include "GrpcClient.h"
 #include "MilvusApi.h"
 
@@ -20,6 +21,15 @@
 
 namespace milvus {
 
+// conversions between sdk and grpc messages, shared with the other clients built on GrpcClient
+void
+ConstructSearchParam(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                     const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                     int64_t topk, int64_t nprobe, ::milvus::grpc::SearchParam& search_param);
+
+void
+ConstructTopKQueryResult(const ::milvus::grpc::TopKQueryResult& result, TopKQueryResult& topk_query_result);
+
 class ClientProxy : public Connection {
  public:
     // Implementations of the Connection interface
@@ -51,11 +61,33 @@ class ClientProxy : public Connection {
     Insert(const std::string& table_name, const std::string& partition_tag, const std::vector<RowRecord>& record_array,
            std::vector<int64_t>& id_array) override;
 
+    Status
+    Insert(const std::string& table_name, const std::string& partition_tag, const float* data, int64_t row_count,
+           int64_t dimension, const int64_t* ids, std::vector<int64_t>& id_array) override;
+
     Status
     Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
            const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
            int64_t nprobe, TopKQueryResult& topk_query_result) override;
 
+    Status
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe, FlatQueryResult& flat_query_result) override;
+
+    Status
+    InsertAsync(const std::string& table_name, const std::string& partition_tag,
+                const std::vector<RowRecord>& record_array, const std::vector<int64_t>& id_array,
+                const InsertCallback& callback) override;
+
+    Status
+    SearchAsync(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                int64_t topk, int64_t nprobe, const SearchCallback& callback) override;
+
+    Status
+    WaitAsync() override;
+
     Status
     DescribeTable(const std::string& table_name, TableSchema& table_schema) override;
 
@@ -107,6 +139,7 @@ class ClientProxy : public Connection {
  private:
     std::shared_ptr<::grpc::Channel> channel_;
     std::shared_ptr<GrpcClient> client_ptr_;
+    std::shared_ptr<AsyncClient> async_client_ptr_;
     bool connected_ = false;
 };
 
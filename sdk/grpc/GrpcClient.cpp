@@ -115,7 +115,13 @@ GrpcClient::Insert(::milvus::grpc::VectorIds& vector_ids, const ::milvus::grpc::
 
     if (!grpc_status.ok()) {
         std::cerr << "InsertVector rpc failed!" << std::endl;
-        status = Status(StatusCode::RPCFailed, grpc_status.error_message());
+        if (grpc_status.error_code() == ::grpc::StatusCode::RESOURCE_EXHAUSTED) {
+            status = Status(StatusCode::ServerBusy, grpc_status.error_message());
+        } else if (grpc_status.error_code() == ::grpc::StatusCode::UNAVAILABLE) {
+            status = Status(StatusCode::ServerUnavailable, grpc_status.error_message());
+        } else {
+            status = Status(StatusCode::RPCFailed, grpc_status.error_message());
+        }
         return;
     }
     if (vector_ids.status().error_code() != grpc::SUCCESS) {
@@ -147,6 +153,25 @@ GrpcClient::Search(::milvus::grpc::TopKQueryResult& topk_query_result,
     return Status::OK();
 }
 
+Status
+GrpcClient::SearchInFiles(::milvus::grpc::TopKQueryResult& topk_query_result,
+                          const ::milvus::grpc::SearchInFilesParam& search_in_files_param) {
+    ClientContext context;
+    ::grpc::Status grpc_status = stub_->SearchInFiles(&context, search_in_files_param, &topk_query_result);
+
+    if (!grpc_status.ok()) {
+        std::cerr << "SearchInFiles rpc failed!" << std::endl;
+        std::cerr << grpc_status.error_message() << std::endl;
+        return Status(StatusCode::RPCFailed, grpc_status.error_message());
+    }
+    if (topk_query_result.status().error_code() != grpc::SUCCESS) {
+        std::cerr << topk_query_result.status().reason() << std::endl;
+        return Status(StatusCode::ServerFailed, topk_query_result.status().reason());
+    }
+
+    return Status::OK();
+}
+
 Status
 GrpcClient::DescribeTable(::milvus::grpc::TableSchema& grpc_schema, const std::string& table_name) {
     ClientContext context;
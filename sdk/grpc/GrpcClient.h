@@ -53,6 +53,10 @@ class GrpcClient {
     Status
     Search(::milvus::grpc::TopKQueryResult& topk_query_result, const grpc::SearchParam& search_param);
 
+    Status
+    SearchInFiles(::milvus::grpc::TopKQueryResult& topk_query_result,
+                  const grpc::SearchInFilesParam& search_in_files_param);
+
     Status
     DescribeTable(grpc::TableSchema& grpc_schema, const std::string& table_name);
 
@@ -13,6 +13,7 @@
 
 #include "Status.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -35,6 +36,12 @@ enum class IndexType {
     SPTAGKDT = 7,
     SPTAGBKT = 8,
     HNSW = 11,
+    HNSW_SQ8 = 12,
+    IVFPQ_REFINE = 13,
+    IVFFP16 = 14,
+    FLAT_FP16 = 15,
+    IVFPQ_FASTSCAN = 16,
+    DISKANN = 17,
 };
 
 enum class MetricType {
@@ -49,8 +56,10 @@ enum class MetricType {
  * @brief Connect API parameter
  */
 struct ConnectParam {
-    std::string ip_address;  ///< Server IP address
-    std::string port;        ///< Server PORT
+    std::string ip_address;     ///< Server IP address
+    std::string port;           ///< Server PORT
+    int64_t channel_num = 1;    ///< Channels opened to the server, async requests are spread over them
+    int64_t max_in_flight = 0;  ///< Async requests outstanding at most, 0 means unbounded
 };
 
 /**
@@ -89,6 +98,16 @@ struct QueryResult {
 };
 using TopKQueryResult = std::vector<QueryResult>;  ///< Topk query result
 
+/**
+ * @brief Topk query result in contiguous row-major arrays, result j of query i is at i * topk + j
+ */
+struct FlatQueryResult {
+    int64_t row_num = 0;           ///< Number of queries
+    int64_t topk = 0;              ///< Number of results of each query
+    std::vector<int64_t> ids;      ///< row_num * topk ids
+    std::vector<float> distances;  ///< row_num * topk distances
+};
+
 /**
  * @brief index parameters
  */
@@ -109,6 +128,14 @@ struct PartitionParam {
 
 using PartitionList = std::vector<PartitionParam>;
 
+/**
+ * @brief Callbacks of async requests, called on a thread of the SDK, they should return quickly
+ *
+ * A callback may send new async requests, WaitAsync(), Connect() and Disconnect() called in it return NotSupported.
+ */
+using InsertCallback = std::function<void(const Status& status, std::vector<int64_t>&& id_array)>;
+using SearchCallback = std::function<void(const Status& status, TopKQueryResult&& topk_query_result)>;
+
 /**
  * @brief SDK main class
  */
@@ -256,6 +283,26 @@ class Connection {
     Insert(const std::string& table_name, const std::string& partition_tag, const std::vector<RowRecord>& record_array,
            std::vector<int64_t>& id_array) = 0;
 
+    /**
+     * @brief Insert float vectors from a contiguous buffer
+     *
+     * This method is used to insert a row-major float matrix to table without copying it into RowRecords,
+     * each row is sent to server as packed bytes.
+     *
+     * @param table_name, target table's name.
+     * @param partition_tag, target partition's tag, keep empty if no partition.
+     * @param data, row_count * dimension floats, row-major.
+     * @param row_count, number of vectors in data.
+     * @param dimension, dimension of each vector.
+     * @param ids, row_count ids for the vectors, or nullptr to let milvus generate them.
+     * @param id_array, ids of the inserted vectors.
+     *
+     * @return Indicate if vector array are inserted successfully
+     */
+    virtual Status
+    Insert(const std::string& table_name, const std::string& partition_tag, const float* data, int64_t row_count,
+           int64_t dimension, const int64_t* ids, std::vector<int64_t>& id_array) = 0;
+
     /**
      * @brief Search vector
      *
@@ -276,6 +323,70 @@ class Connection {
            const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
            int64_t nprobe, TopKQueryResult& topk_query_result) = 0;
 
+    /**
+     * @brief Search vector into a flat result
+     *
+     * Same as Search, the result is returned in two contiguous arrays rather than one vector per query.
+     *
+     * @param flat_query_result, result of all queries.
+     *
+     * @return Indicate if query is successful.
+     */
+    virtual Status
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe, FlatQueryResult& flat_query_result) = 0;
+
+    /**
+     * @brief Insert vector to table without waiting for the server
+     *
+     * This method is used to keep many insert batches outstanding on one connection.
+     * The vectors are copied before it returns, it blocks only while max_in_flight requests are outstanding.
+     *
+     * @param table_name, target table's name.
+     * @param partition_tag, target partition's tag, keep empty if no partition.
+     * @param record_array, vector array is inserted.
+     * @param id_array, specify id for each vector, keep empty to let milvus generate them.
+     * @param callback, called with the status and the ids of the vectors once the server replies.
+     *
+     * @return Indicate if the request is sent
+     */
+    virtual Status
+    InsertAsync(const std::string& table_name, const std::string& partition_tag,
+                const std::vector<RowRecord>& record_array, const std::vector<int64_t>& id_array,
+                const InsertCallback& callback) = 0;
+
+    /**
+     * @brief Search vector without waiting for the server
+     *
+     * This method is used to keep many searches outstanding on one connection.
+     * The query vectors are copied before it returns, it blocks only while max_in_flight requests are outstanding.
+     *
+     * @param table_name, target table's name.
+     * @param partition_tags, target partitions, keep empty if no partition.
+     * @param query_record_array, all vector are going to be queried.
+     * @param query_range_array, [deprecated] time ranges, if not specified, will search in whole table
+     * @param topk, how many similarity vectors will be searched.
+     * @param nprobe, the number of centroids choose to search.
+     * @param callback, called with the status and the result once the server replies.
+     *
+     * @return Indicate if the request is sent
+     */
+    virtual Status
+    SearchAsync(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                int64_t topk, int64_t nprobe, const SearchCallback& callback) = 0;
+
+    /**
+     * @brief Wait for async requests
+     *
+     * This method is used to wait until the callbacks of all async requests sent so far have returned.
+     *
+     * @return Indicate if this operation is successful.
+     */
+    virtual Status
+    WaitAsync() = 0;
+
     /**
      * @brief Show table description
      *
@@ -471,4 +582,132 @@ class Connection {
     SetConfig(const std::string& node_name, const std::string& value) const = 0;
 };
 
+/**
+ * @brief Sharded searcher
+ *
+ * Searches a mishards style deployment without going through mishards: files of the table are listed by the
+ * writable node, each file is searched by the readonly node owning it on the same hash ring mishards uses,
+ * all nodes are searched in parallel and their results are merged here.
+ */
+class ShardedSearcher {
+ public:
+    /**
+     * @brief Create a sharded searcher
+     *
+     * @return ShardedSearcher instance pointer
+     */
+    static std::shared_ptr<ShardedSearcher>
+    Create();
+
+    virtual ~ShardedSearcher() = default;
+
+    /**
+     * @brief Connect to the nodes
+     *
+     * @param writable_node, node listing the files of tables.
+     * @param readonly_nodes, nodes searching the files, ip_address of each node is its name on the hash ring,
+     *  the same name as mishards static discovery gives it.
+     *
+     * @return Indicate if connect is successful
+     */
+    virtual Status
+    Connect(const ConnectParam& writable_node, const std::vector<ConnectParam>& readonly_nodes) = 0;
+
+    /**
+     * @brief Search vector
+     *
+     * Same as Connection::Search, vectors in insert buffer of the writable node are not searched.
+     *
+     * @param table_name, target table's name.
+     * @param partition_tags, target partitions, keep empty if no partition.
+     * @param query_record_array, all vector are going to be queried.
+     * @param topk, how many similarity vectors will be searched.
+     * @param nprobe, the number of centroids choose to search.
+     * @param topk_query_result, result array.
+     *
+     * @return Indicate if query is successful.
+     */
+    virtual Status
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, int64_t topk, int64_t nprobe,
+           TopKQueryResult& topk_query_result) = 0;
+};
+
+/**
+ * @brief batch writer parameters
+ */
+struct BatchWriterParam {
+    std::string table_name;                  ///< Table to insert into
+    std::string partition_tag;               ///< Partition to insert into, keep empty if no partition
+    int64_t max_batch_rows = 10000;          ///< Send a batch once it holds this many vectors
+    int64_t max_batch_bytes = 64 << 20;      ///< Send a batch once its vectors take this many bytes
+    int64_t flush_interval_ms = 100;         ///< Send a non-empty batch at least this often
+    int64_t max_buffered_bytes = 256 << 20;  ///< Write blocks while buffered and in-flight vectors take more
+    int64_t max_retries = 10;                ///< Retries of a batch rejected by a busy server
+    int64_t retry_backoff_ms = 100;          ///< First retry delay, doubled on every retry
+    int64_t max_retry_backoff_ms = 5000;     ///< Upper bound of the retry delay
+};
+
+/**
+ * @brief Batch writer
+ *
+ * Buffers vectors written one by one and inserts them in batches from a background thread.
+ * A batch rejected by a busy server is retried with exponential backoff, so is a batch with ids
+ * lost to an unreachable server; any other failure is kept and returned by the next Write, Flush or Close.
+ */
+class BatchWriter {
+ public:
+    /**
+     * @brief Create a batch writer on a connected connection
+     *
+     * @param connection, connection used to insert, it must outlive the writer.
+     * @param param, batching parameters.
+     *
+     * @return BatchWriter instance pointer
+     */
+    static std::shared_ptr<BatchWriter>
+    Create(const std::shared_ptr<Connection>& connection, const BatchWriterParam& param);
+
+    virtual ~BatchWriter() = default;
+
+    /**
+     * @brief Write a vector
+     *
+     * Milvus generates the id of the vector, cannot be mixed with writes specifying ids.
+     *
+     * @param record, vector to insert.
+     *
+     * @return Indicate if the vector is buffered, or the error of an earlier batch
+     */
+    virtual Status
+    Write(const RowRecord& record) = 0;
+
+    /**
+     * @brief Write a vector with id
+     *
+     * @param record, vector to insert.
+     * @param id, id of the vector.
+     *
+     * @return Indicate if the vector is buffered, or the error of an earlier batch
+     */
+    virtual Status
+    Write(const RowRecord& record, int64_t id) = 0;
+
+    /**
+     * @brief Send the buffered vectors and wait until all batches are done
+     *
+     * @return Indicate if all batches are inserted successfully
+     */
+    virtual Status
+    Flush() = 0;
+
+    /**
+     * @brief Flush and stop the background thread, later writes fail
+     *
+     * @return Indicate if all batches are inserted successfully
+     */
+    virtual Status
+    Close() = 0;
+};
+
 }  // namespace milvus
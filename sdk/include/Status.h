@@ -32,6 +32,8 @@ enum class StatusCode {
     InvalidAgument = 1000,
     RPCFailed,
     ServerFailed,
+    ServerBusy,         // rejected by an overloaded server, the request can be retried later
+    ServerUnavailable,  // the server is unreachable, the request may or may not have been executed
 };
 
 /**
@@ -0,0 +1,182 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "interface/BatchWriterImpl.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace milvus {
+
+std::shared_ptr<BatchWriter>
+BatchWriter::Create(const std::shared_ptr<Connection>& connection, const BatchWriterParam& param) {
+    return std::make_shared<BatchWriterImpl>(connection, param);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+BatchWriterImpl::BatchWriterImpl(const std::shared_ptr<Connection>& connection, const BatchWriterParam& param)
+    : connection_(connection), param_(param) {
+    thread_ = std::thread(&BatchWriterImpl::Run, this);
+}
+
+BatchWriterImpl::~BatchWriterImpl() {
+    Close();
+}
+
+Status
+BatchWriterImpl::Write(const RowRecord& record) {
+    return Append(record, nullptr);
+}
+
+Status
+BatchWriterImpl::Write(const RowRecord& record, int64_t id) {
+    return Append(record, &id);
+}
+
+Status
+BatchWriterImpl::Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    flush_requested_ = true;
+    send_cv_.notify_one();
+    space_cv_.wait(lock, [this] { return current_.records_.empty() && sealed_.empty() && !sending_; });
+    return error_;
+}
+
+Status
+BatchWriterImpl::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    send_cv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+Status
+BatchWriterImpl::Append(const RowRecord& record, const int64_t* id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        return Status(StatusCode::InvalidAgument, "batch writer is closed");
+    }
+    if (!error_.ok()) {
+        return error_;
+    }
+
+    int with_ids = (id != nullptr) ? 1 : 0;
+    if (with_ids_ == -1) {
+        with_ids_ = with_ids;
+    } else if (with_ids_ != with_ids) {
+        return Status(StatusCode::InvalidAgument, "vectors with and without ids cannot be mixed");
+    }
+
+    // bound the memory, a single vector larger than the bound is still accepted when nothing else is buffered
+    int64_t bytes = record.float_data.size() * sizeof(float) + record.binary_data.size();
+    space_cv_.wait(lock, [&] {
+        return buffered_bytes_ == 0 || buffered_bytes_ + bytes <= param_.max_buffered_bytes || !error_.ok() ||
+               closed_;
+    });
+    if (closed_) {
+        return Status(StatusCode::InvalidAgument, "batch writer is closed");
+    }
+    if (!error_.ok()) {
+        return error_;
+    }
+
+    if (current_.records_.empty()) {
+        current_start_ = std::chrono::steady_clock::now();
+    }
+    current_.records_.push_back(record);
+    if (id != nullptr) {
+        current_.ids_.push_back(*id);
+    }
+    current_.bytes_ += bytes;
+    buffered_bytes_ += bytes;
+
+    if (static_cast<int64_t>(current_.records_.size()) >= param_.max_batch_rows ||
+        current_.bytes_ >= param_.max_batch_bytes) {
+        Seal();
+        send_cv_.notify_one();
+    }
+    return Status::OK();
+}
+
+void
+BatchWriterImpl::Seal() {
+    if (!current_.records_.empty()) {
+        sealed_.emplace_back(std::move(current_));
+        current_ = Batch();
+    }
+}
+
+void
+BatchWriterImpl::Run() {
+    auto interval = std::chrono::milliseconds(std::max<int64_t>(param_.flush_interval_ms, 1));
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        send_cv_.wait_for(lock, interval, [this] { return !sealed_.empty() || flush_requested_ || closed_; });
+
+        if (flush_requested_ || closed_ || std::chrono::steady_clock::now() - current_start_ >= interval) {
+            Seal();
+        }
+        flush_requested_ = false;
+
+        if (sealed_.empty()) {
+            space_cv_.notify_all();
+            if (closed_) {
+                break;
+            }
+            continue;
+        }
+
+        Batch batch = std::move(sealed_.front());
+        sealed_.pop_front();
+        sending_ = true;
+        lock.unlock();
+
+        Status status = Send(batch);
+
+        lock.lock();
+        sending_ = false;
+        buffered_bytes_ -= batch.bytes_;
+        if (!status.ok() && error_.ok()) {
+            error_ = status;
+        }
+        space_cv_.notify_all();
+    }
+}
+
+Status
+BatchWriterImpl::Send(const Batch& batch) {
+    int64_t backoff_ms = param_.retry_backoff_ms;
+    for (int64_t retry = 0;; ++retry) {
+        std::vector<int64_t> id_array = batch.ids_;
+        Status status = connection_->Insert(param_.table_name, param_.partition_tag, batch.records_, id_array);
+        // a batch lost to an unreachable server may have been inserted, it is sent again only if it has ids of its
+        // own, the server would give the vectors new ids otherwise
+        bool retriable = (status.code() == StatusCode::ServerBusy) ||
+                         (status.code() == StatusCode::ServerUnavailable && !batch.ids_.empty());
+        if (!retriable || retry >= param_.max_retries) {
+            return status;
+        }
+
+        // the server sheds load when its request queue is full, give it time to drain
+        std::this_thread::sleep_for(std::chrono::milliseconds(backoff_ms));
+        backoff_ms = std::min(backoff_ms * 2, param_.max_retry_backoff_ms);
+    }
+}
+
+}  // namespace milvus
@@ -0,0 +1,85 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "MilvusApi.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace milvus {
+
+class BatchWriterImpl : public BatchWriter {
+ public:
+    BatchWriterImpl(const std::shared_ptr<Connection>& connection, const BatchWriterParam& param);
+
+    ~BatchWriterImpl() override;
+
+    // Implementations of the BatchWriter interface
+    Status
+    Write(const RowRecord& record) override;
+
+    Status
+    Write(const RowRecord& record, int64_t id) override;
+
+    Status
+    Flush() override;
+
+    Status
+    Close() override;
+
+ private:
+    struct Batch {
+        std::vector<RowRecord> records_;
+        std::vector<int64_t> ids_;
+        int64_t bytes_ = 0;
+    };
+
+    Status
+    Append(const RowRecord& record, const int64_t* id);
+
+    void
+    Seal();
+
+    void
+    Run();
+
+    Status
+    Send(const Batch& batch);
+
+ private:
+    std::shared_ptr<Connection> connection_;
+    BatchWriterParam param_;
+
+    std::mutex mutex_;
+    std::condition_variable send_cv_;   // wakes the background thread
+    std::condition_variable space_cv_;  // wakes writers waiting for buffer space and flushes
+    Batch current_;
+    std::chrono::steady_clock::time_point current_start_;
+    std::deque<Batch> sealed_;
+    int64_t buffered_bytes_ = 0;
+    bool sending_ = false;
+    bool flush_requested_ = false;
+    bool closed_ = false;
+    int with_ids_ = -1;  // -1 until the first write decides whether vectors come with ids
+    Status error_;
+
+    std::thread thread_;
+};
+
+}  // namespace milvus
@@ -82,6 +82,12 @@ ConnectionImpl::Insert(const std::string& table_name, const std::string& partiti
     return client_proxy_->Insert(table_name, partition_tag, record_array, id_array);
 }
 
+Status
+ConnectionImpl::Insert(const std::string& table_name, const std::string& partition_tag, const float* data,
+                       int64_t row_count, int64_t dimension, const int64_t* ids, std::vector<int64_t>& id_array) {
+    return client_proxy_->Insert(table_name, partition_tag, data, row_count, dimension, ids, id_array);
+}
+
 Status
 ConnectionImpl::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
                        const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
@@ -90,6 +96,35 @@ ConnectionImpl::Search(const std::string& table_name, const std::vector<std::str
                                  topk_query_result);
 }
 
+Status
+ConnectionImpl::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                       const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                       int64_t topk, int64_t nprobe, FlatQueryResult& flat_query_result) {
+    return client_proxy_->Search(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe,
+                                 flat_query_result);
+}
+
+Status
+ConnectionImpl::InsertAsync(const std::string& table_name, const std::string& partition_tag,
+                            const std::vector<RowRecord>& record_array, const std::vector<int64_t>& id_array,
+                            const InsertCallback& callback) {
+    return client_proxy_->InsertAsync(table_name, partition_tag, record_array, id_array, callback);
+}
+
+Status
+ConnectionImpl::SearchAsync(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                            const std::vector<RowRecord>& query_record_array,
+                            const std::vector<Range>& query_range_array, int64_t topk, int64_t nprobe,
+                            const SearchCallback& callback) {
+    return client_proxy_->SearchAsync(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe,
+                                      callback);
+}
+
+Status
+ConnectionImpl::WaitAsync() {
+    return client_proxy_->WaitAsync();
+}
+
 Status
 ConnectionImpl::DescribeTable(const std::string& table_name, TableSchema& table_schema) {
     return client_proxy_->DescribeTable(table_name, table_schema);
@@ -0,0 +1,184 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "interface/ShardedSearcherImpl.h"
+#include "grpc/ClientProxy.h"
+
+#include <algorithm>
+#include <future>
+#include <sstream>
+#include <utility>
+
+namespace milvus {
+
+namespace {
+
+std::shared_ptr<GrpcClient>
+CreateClient(const ConnectParam& param) {
+    std::string uri = param.ip_address + ":" + param.port;
+    auto channel = ::grpc::CreateChannel(uri, ::grpc::InsecureChannelCredentials());
+    if (channel == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<GrpcClient>(channel);
+}
+
+}  // namespace
+
+std::shared_ptr<ShardedSearcher>
+ShardedSearcher::Create() {
+    return std::make_shared<ShardedSearcherImpl>();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+Status
+ShardedSearcherImpl::Connect(const ConnectParam& writable_node, const std::vector<ConnectParam>& readonly_nodes) {
+    if (readonly_nodes.empty()) {
+        return Status(StatusCode::InvalidAgument, "no readonly node to search");
+    }
+
+    writable_client_ = CreateClient(writable_node);
+    if (writable_client_ == nullptr) {
+        return Status(StatusCode::NotConnected, "failed to connect writable node " + writable_node.ip_address);
+    }
+
+    std::vector<std::string> names;
+    for (auto& node : readonly_nodes) {
+        auto client = CreateClient(node);
+        if (client == nullptr) {
+            return Status(StatusCode::NotConnected, "failed to connect readonly node " + node.ip_address);
+        }
+        readonly_clients_[node.ip_address] = client;
+        names.push_back(node.ip_address);
+    }
+    ring_ = std::make_shared<HashRing>(names);
+
+    return Status::OK();
+}
+
+Status
+ShardedSearcherImpl::ListFiles(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                               std::map<std::string, std::map<std::string, std::vector<std::string>>>& routing) {
+    std::string cmd = "search_files " + table_name;
+    for (size_t i = 0; i < partition_tags.size(); ++i) {
+        cmd += (i == 0 ? " " : ",") + partition_tags[i];
+    }
+
+    std::string files;
+    Status status = writable_client_->Cmd(files, cmd);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // a line per file: "table_id file_id", partitions have their own table ids
+    std::istringstream lines(files);
+    std::string file_table_id, file_id;
+    while (lines >> file_table_id >> file_id) {
+        routing[ring_->GetNode(file_id)][file_table_id].push_back(file_id);
+    }
+    return Status::OK();
+}
+
+Status
+ShardedSearcherImpl::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                            const std::vector<RowRecord>& query_record_array, int64_t topk, int64_t nprobe,
+                            TopKQueryResult& topk_query_result) {
+    if (writable_client_ == nullptr) {
+        return Status(StatusCode::NotConnected, "not connected to server");
+    }
+
+    try {
+        ::milvus::grpc::TableSchema table_schema;
+        Status status = writable_client_->DescribeTable(table_schema, table_name);
+        if (!status.ok()) {
+            return status;
+        }
+        bool descending = (static_cast<MetricType>(table_schema.metric_type()) == MetricType::IP);
+
+        // step 1: find the node owning each file
+        std::map<std::string, std::map<std::string, std::vector<std::string>>> routing;
+        status = ListFiles(table_name, partition_tags, routing);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // step 2: search files of each node in parallel
+        ::milvus::grpc::SearchParam search_param;
+        ConstructSearchParam(table_name, {}, query_record_array, {}, topk, nprobe, search_param);
+
+        std::vector<std::future<std::pair<Status, ::milvus::grpc::TopKQueryResult>>> futures;
+        for (auto& node_files : routing) {
+            auto client = readonly_clients_[node_files.first];
+            for (auto& table_files : node_files.second) {
+                ::milvus::grpc::SearchInFilesParam param;
+                *param.mutable_search_param() = search_param;
+                param.mutable_search_param()->set_table_name(table_files.first);
+                for (auto& file_id : table_files.second) {
+                    param.add_file_id_array(file_id);
+                }
+                futures.emplace_back(std::async(std::launch::async, [client, param]() {
+                    ::milvus::grpc::TopKQueryResult result;
+                    Status status = client->SearchInFiles(result, param);
+                    return std::make_pair(status, std::move(result));
+                }));
+            }
+        }
+
+        std::vector<TopKQueryResult> node_results;
+        for (auto& future : futures) {
+            auto node_result = future.get();
+            if (!node_result.first.ok()) {
+                status = node_result.first;
+                continue;
+            }
+            TopKQueryResult result;
+            ConstructTopKQueryResult(node_result.second, result);
+            node_results.emplace_back(std::move(result));
+        }
+        if (!status.ok()) {
+            return status;
+        }
+
+        // step 3: merge topk of the nodes for each query
+        topk_query_result.clear();
+        topk_query_result.resize(query_record_array.size());
+        for (size_t i = 0; i < query_record_array.size(); ++i) {
+            std::vector<std::pair<float, int64_t>> candidates;
+            for (auto& result : node_results) {
+                if (i >= result.size()) {
+                    continue;
+                }
+                for (size_t j = 0; j < result[i].ids.size(); ++j) {
+                    if (result[i].ids[j] >= 0) {
+                        candidates.emplace_back(result[i].distances[j], result[i].ids[j]);
+                    }
+                }
+            }
+
+            auto count = std::min<size_t>(candidates.size(), topk);
+            std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                              [descending](const std::pair<float, int64_t>& a, const std::pair<float, int64_t>& b) {
+                                  return descending ? a.first > b.first : a.first < b.first;
+                              });
+            for (size_t j = 0; j < count; ++j) {
+                topk_query_result[i].distances.push_back(candidates[j].first);
+                topk_query_result[i].ids.push_back(candidates[j].second);
+            }
+        }
+
+        return Status::OK();
+    } catch (std::exception& ex) {
+        return Status(StatusCode::UnknownError, "fail to search vectors: " + std::string(ex.what()));
+    }
+}
+
+}  // namespace milvus
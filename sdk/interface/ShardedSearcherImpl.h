@@ -0,0 +1,48 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "MilvusApi.h"
+#include "grpc/GrpcClient.h"
+#include "grpc/HashRing.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+
+class ShardedSearcherImpl : public ShardedSearcher {
+ public:
+    // Implementations of the ShardedSearcher interface
+    Status
+    Connect(const ConnectParam& writable_node, const std::vector<ConnectParam>& readonly_nodes) override;
+
+    Status
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, int64_t topk, int64_t nprobe,
+           TopKQueryResult& topk_query_result) override;
+
+ private:
+    Status
+    ListFiles(const std::string& table_name, const std::vector<std::string>& partition_tags,
+              std::map<std::string, std::map<std::string, std::vector<std::string>>>& routing);
+
+ private:
+    std::shared_ptr<GrpcClient> writable_client_;
+    std::map<std::string, std::shared_ptr<GrpcClient>> readonly_clients_;
+    std::shared_ptr<HashRing> ring_;
+};
+
+}  // namespace milvus